@@ -46,6 +46,9 @@ endif()
 if (onnxruntime_ENABLE_TRAINING OR onnxruntime_ENABLE_TRAINING_OPS)
   target_include_directories(onnxruntime_session PRIVATE ${ORTTRAINING_ROOT})
 endif()
+if (onnxruntime_ENABLE_DLPACK)
+  target_include_directories(onnxruntime_session PRIVATE ${DLPACK_INCLUDE_DIR})
+endif()
 
 if (onnxruntime_ENABLE_TRAINING_TORCH_INTEROP)
   onnxruntime_add_include_to_target(onnxruntime_session Python::Module) 
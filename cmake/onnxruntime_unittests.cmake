@@ -878,6 +878,7 @@ if (NOT onnxruntime_ENABLE_TRAINING_TORCH_INTEROP)
       ${BENCHMARK_DIR}/tptest.cc
       ${BENCHMARK_DIR}/eigen.cc
       ${BENCHMARK_DIR}/copy.cc
+      ${BENCHMARK_DIR}/dispatch.cc
       ${BENCHMARK_DIR}/gelu.cc
       ${BENCHMARK_DIR}/activation.cc
       ${BENCHMARK_DIR}/quantize.cc
@@ -1049,6 +1050,23 @@ if (NOT onnxruntime_ENABLE_TRAINING_TORCH_INTEROP)
   endif()
   set_target_properties(onnxruntime_perf_test PROPERTIES FOLDER "ONNXRuntimeTest")
 
+  # Runs the models of a manifest with onnxruntime_perf_test and compares them with the stored baseline, see
+  # tools/python/perf_test_suite.py for the manifest format.
+  if (onnxruntime_PERF_TEST_SUITE_MANIFEST AND Python_EXECUTABLE)
+    set(perf_test_suite_args
+        --perf_test $<TARGET_FILE:onnxruntime_perf_test>
+        --manifest ${onnxruntime_PERF_TEST_SUITE_MANIFEST}
+        --output ${CMAKE_CURRENT_BINARY_DIR}/perf_test_suite_results.json)
+    if (onnxruntime_PERF_TEST_SUITE_BASELINE)
+      list(APPEND perf_test_suite_args --baseline ${onnxruntime_PERF_TEST_SUITE_BASELINE})
+    endif()
+    add_custom_target(onnxruntime_perf_test_suite
+        COMMAND ${Python_EXECUTABLE} ${REPO_ROOT}/tools/python/perf_test_suite.py ${perf_test_suite_args}
+        DEPENDS onnxruntime_perf_test
+        USES_TERMINAL)
+    set_target_properties(onnxruntime_perf_test_suite PROPERTIES FOLDER "ONNXRuntimeTest")
+  endif()
+
   if (onnxruntime_ENABLE_LANGUAGE_INTEROP_OPS AND NOT onnxruntime_BUILD_SHARED_LIB)
     target_link_libraries(onnxruntime_perf_test PRIVATE onnxruntime_language_interop onnxruntime_pyop)
   endif()
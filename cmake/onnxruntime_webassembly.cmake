@@ -215,6 +215,9 @@ else()
   endif()
 
   if (onnxruntime_ENABLE_WEBASSEMBLY_THREADS)
+    # Start the worker pool together with the module, sized by the numThreads value passed in the module config,
+    # so that creating the intra-op thread pool does not have to wait for new workers to be spawned.
+    set_property(TARGET onnxruntime_webassembly APPEND_STRING PROPERTY LINK_FLAGS " -s PTHREAD_POOL_SIZE=Module.numThreads")
     if (onnxruntime_ENABLE_WEBASSEMBLY_SIMD)
       set_property(TARGET onnxruntime_webassembly APPEND_STRING PROPERTY LINK_FLAGS " -s EXPORT_NAME=ortWasmSimdThreaded -s USE_PTHREADS=1")
       set_target_properties(onnxruntime_webassembly PROPERTIES OUTPUT_NAME "ort-wasm-simd-threaded")
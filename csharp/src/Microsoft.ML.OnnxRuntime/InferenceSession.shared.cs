@@ -525,6 +525,48 @@ namespace Microsoft.ML.OnnxRuntime
             }
         }
 
+        /// <summary>
+        /// Create a reusable OrtRunContext for the given input and output names. Bind buffers to it
+        /// once and pass it to Run(OrtRunContext) on every call to avoid per-call managed allocations.
+        /// </summary>
+        /// <param name="inputNames">names of the inputs to feed</param>
+        /// <param name="outputNames">names of the outputs to fetch</param>
+        /// <returns>A new instance of OrtRunContext</returns>
+        public OrtRunContext CreateRunContext(IReadOnlyCollection<string> inputNames, IReadOnlyCollection<string> outputNames)
+        {
+            return new OrtRunContext(inputNames, outputNames);
+        }
+
+        /// <summary>
+        /// Runs the loaded model on the values bound to the context. Outputs are written
+        /// into the buffers bound to the context.
+        /// </summary>
+        /// <param name="context">context with all inputs and outputs bound</param>
+        public void Run(OrtRunContext context)
+        {
+            Run(context, _builtInRunOptions);
+        }
+
+        /// <summary>
+        /// Runs the loaded model on the values bound to the context. Uses the given RunOptions for this run.
+        /// </summary>
+        /// <param name="context">context with all inputs and outputs bound</param>
+        /// <param name="options">RunOptions</param>
+        public void Run(OrtRunContext context, RunOptions options)
+        {
+            context.VerifyAllBound();
+            NativeApiStatus.VerifySuccess(NativeMethods.OrtRun(
+                                                _nativeHandle,
+                                                options.Handle,
+                                                context.InputNameHandles,
+                                                context.InputValueHandles,
+                                                (UIntPtr)context.InputNameHandles.Length,
+                                                context.OutputNameHandles,
+                                                (UIntPtr)context.OutputNameHandles.Length,
+                                                context.OutputValueHandles /* pointers to Pre-allocated OrtValue instances */
+                                                ));
+        }
+
         /// <summary>
         /// Create OrtIoBinding instance to bind pre-allocated buffers
         /// to input/output
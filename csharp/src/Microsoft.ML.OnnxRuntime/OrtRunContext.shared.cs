@@ -0,0 +1,258 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+using Microsoft.ML.OnnxRuntime.Tensors;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+
+namespace Microsoft.ML.OnnxRuntime
+{
+    /// <summary>
+    /// Holds everything InferenceSession.Run() needs for a fixed set of input and output names
+    /// so that it can be reused across calls. Names are converted to UTF-8 and pinned once, and
+    /// managed buffers bound with BindInput()/BindOutput() are pinned and wrapped into native OrtValues
+    /// once at bind time. Running the session with a bound context performs no managed allocations.
+    ///
+    /// Bound buffers are read and written in place: update the input buffers and call
+    /// InferenceSession.Run(OrtRunContext) again to run on new data. Rebind a name only when its
+    /// buffer or shape changes. Output buffers must match the shape the model produces.
+    ///
+    /// An instance must not be used by more than one Run() at a time.
+    /// </summary>
+    public class OrtRunContext : IDisposable
+    {
+        private readonly string[] _inputNames;
+        private readonly string[] _outputNames;
+        private readonly FixedBufferOnnxValue[] _inputs;
+        private readonly FixedBufferOnnxValue[] _outputs;
+        private readonly bool[] _ownsInput;
+        private readonly bool[] _ownsOutput;
+        private readonly DisposableList<IDisposable> _pinnedNames = new DisposableList<IDisposable>();
+        private bool _disposed = false;
+
+        /// <summary>
+        /// Use InferenceSession.CreateRunContext()
+        /// </summary>
+        internal OrtRunContext(IReadOnlyCollection<string> inputNames, IReadOnlyCollection<string> outputNames)
+        {
+            _inputNames = inputNames.ToArray();
+            _outputNames = outputNames.ToArray();
+            if (_inputNames.Distinct().Count() != _inputNames.Length ||
+                _outputNames.Distinct().Count() != _outputNames.Length)
+            {
+                throw new ArgumentException("Input and output names must be unique");
+            }
+
+            _inputs = new FixedBufferOnnxValue[_inputNames.Length];
+            _outputs = new FixedBufferOnnxValue[_outputNames.Length];
+            _ownsInput = new bool[_inputNames.Length];
+            _ownsOutput = new bool[_outputNames.Length];
+            InputValueHandles = new IntPtr[_inputNames.Length];
+            OutputValueHandles = new IntPtr[_outputNames.Length];
+
+            try
+            {
+                InputNameHandles = PinNames(_inputNames);
+                OutputNameHandles = PinNames(_outputNames);
+            }
+            catch (Exception)
+            {
+                _pinnedNames.Dispose();
+                throw;
+            }
+        }
+
+        internal IntPtr[] InputNameHandles { get; private set; }
+        internal IntPtr[] InputValueHandles { get; private set; }
+        internal IntPtr[] OutputNameHandles { get; private set; }
+        internal IntPtr[] OutputValueHandles { get; private set; }
+
+        /// <summary>
+        /// Input names this context was created for, in the order they are passed to the model
+        /// </summary>
+        public IReadOnlyList<string> InputNames { get { return _inputNames; } }
+
+        /// <summary>
+        /// Output names this context was created for, in the order they are fetched from the model
+        /// </summary>
+        public IReadOnlyList<string> OutputNames { get { return _outputNames; } }
+
+        /// <summary>
+        /// Pins a managed buffer and binds it to the named input. The buffer stays pinned
+        /// until it is rebound or the context is disposed.
+        /// </summary>
+        /// <typeparam name="T">element type. Must be a supported numeric type</typeparam>
+        /// <param name="name">input name</param>
+        /// <param name="buffer">input data</param>
+        /// <param name="shape">tensor shape. Its element count must not exceed the length of the buffer</param>
+        public void BindInput<T>(string name, Memory<T> buffer, long[] shape)
+        {
+            BindSlot(_inputs, _ownsInput, InputValueHandles, IndexOf(_inputNames, name),
+                     CreateFromMemory(buffer, shape), true);
+        }
+
+        /// <summary>
+        /// Binds an existing FixedBufferOnnxValue to the named input. The caller keeps ownership
+        /// of the value, which must stay alive while the context is used.
+        /// </summary>
+        /// <param name="name">input name</param>
+        /// <param name="value">input value</param>
+        public void BindInput(string name, FixedBufferOnnxValue value)
+        {
+            BindSlot(_inputs, _ownsInput, InputValueHandles, IndexOf(_inputNames, name), value, false);
+        }
+
+        /// <summary>
+        /// Pins a managed buffer and binds it to the named output. The model writes the output
+        /// directly into the buffer.
+        /// </summary>
+        /// <typeparam name="T">element type. Must be a supported numeric type</typeparam>
+        /// <param name="name">output name</param>
+        /// <param name="buffer">buffer that receives the output</param>
+        /// <param name="shape">tensor shape. Must match the shape the model produces</param>
+        public void BindOutput<T>(string name, Memory<T> buffer, long[] shape)
+        {
+            BindSlot(_outputs, _ownsOutput, OutputValueHandles, IndexOf(_outputNames, name),
+                     CreateFromMemory(buffer, shape), true);
+        }
+
+        /// <summary>
+        /// Binds an existing FixedBufferOnnxValue to the named output. The caller keeps ownership
+        /// of the value, which must stay alive while the context is used.
+        /// </summary>
+        /// <param name="name">output name</param>
+        /// <param name="value">value that receives the output</param>
+        public void BindOutput(string name, FixedBufferOnnxValue value)
+        {
+            if (value.ElementType == TensorElementType.String)
+            {
+                throw new NotSupportedException("Binding a string tensor as an output is not supported");
+            }
+            BindSlot(_outputs, _ownsOutput, OutputValueHandles, IndexOf(_outputNames, name), value, false);
+        }
+
+        /// <summary>
+        /// Makes sure every name has a value bound. Called by InferenceSession before each run.
+        /// </summary>
+        internal void VerifyAllBound()
+        {
+            if (_disposed)
+            {
+                throw new ObjectDisposedException(nameof(OrtRunContext));
+            }
+            for (int i = 0; i < _inputs.Length; ++i)
+            {
+                if (_inputs[i] == null)
+                {
+                    throw new InvalidOperationException($"Input '{_inputNames[i]}' has no value bound");
+                }
+            }
+            for (int i = 0; i < _outputs.Length; ++i)
+            {
+                if (_outputs[i] == null)
+                {
+                    throw new InvalidOperationException($"Output '{_outputNames[i]}' has no value bound");
+                }
+            }
+        }
+
+        private IntPtr[] PinNames(string[] names)
+        {
+            var result = new IntPtr[names.Length];
+            for (int i = 0; i < names.Length; ++i)
+            {
+                var utf8Name = NativeOnnxValueHelper.StringToZeroTerminatedUtf8(names[i]);
+                var pinnedHandle = new PinnedGCHandle(GCHandle.Alloc(utf8Name, GCHandleType.Pinned));
+                _pinnedNames.Add(pinnedHandle);
+                result[i] = pinnedHandle.Pointer;
+            }
+            return result;
+        }
+
+        private static int IndexOf(string[] names, string name)
+        {
+            var index = Array.IndexOf(names, name);
+            if (index < 0)
+            {
+                throw new ArgumentException($"'{name}' is not one of the names this context was created for");
+            }
+            return index;
+        }
+
+        private static FixedBufferOnnxValue CreateFromMemory<T>(Memory<T> buffer, long[] shape)
+        {
+            var typeInfo = TensorBase.GetTypeInfo(typeof(T));
+            if (typeInfo == null || typeInfo.IsString)
+            {
+                throw new NotSupportedException($"Binding a buffer of type {typeof(T)} is not supported");
+            }
+            return FixedBufferOnnxValue.CreateFromMemory(OrtMemoryInfo.DefaultInstance, buffer,
+                typeInfo.ElementType, shape, (long)buffer.Length * typeInfo.TypeSize);
+        }
+
+        private void BindSlot(FixedBufferOnnxValue[] values, bool[] owns, IntPtr[] handles, int index,
+                              FixedBufferOnnxValue value, bool owned)
+        {
+            if (_disposed)
+            {
+                if (owned)
+                {
+                    value.Dispose();
+                }
+                throw new ObjectDisposedException(nameof(OrtRunContext));
+            }
+
+            if (owns[index] && !ReferenceEquals(values[index], value))
+            {
+                values[index].Dispose();
+            }
+            values[index] = value;
+            owns[index] = owned;
+            handles[index] = value.Value.Handle;
+        }
+
+        private static void ReleaseSlots(FixedBufferOnnxValue[] values, bool[] owns, IntPtr[] handles)
+        {
+            for (int i = 0; i < values.Length; ++i)
+            {
+                if (owns[i])
+                {
+                    values[i].Dispose();
+                }
+                values[i] = null;
+                owns[i] = false;
+                handles[i] = IntPtr.Zero;
+            }
+        }
+
+        #region IDisposable Support
+
+        protected virtual void Dispose(bool disposing)
+        {
+            if (_disposed)
+            {
+                return;
+            }
+
+            if (disposing)
+            {
+                ReleaseSlots(_inputs, _ownsInput, InputValueHandles);
+                ReleaseSlots(_outputs, _ownsOutput, OutputValueHandles);
+                _pinnedNames.Dispose();
+            }
+            _disposed = true;
+        }
+
+        /// <summary>
+        /// Releases the native OrtValues, the pinned buffers and the pinned names
+        /// </summary>
+        public void Dispose()
+        {
+            Dispose(true);
+            GC.SuppressFinalize(this);
+        }
+        #endregion
+    }
+}
@@ -1005,6 +1005,43 @@ namespace Microsoft.ML.OnnxRuntime.Tests
             }
         }
 
+        [Fact(DisplayName = "TestReusingRunContext")]
+        private void TestReusingRunContext()
+        {
+            // model takes 1x5 input of fixed type, echoes back
+            var model = TestDataLoader.LoadModelFromEmbeddedResource("test_types_INT32.pb");
+            using (var session = new InferenceSession(model))
+            using (var context = session.CreateRunContext(new[] { "input" }, new[] { "output" }))
+            {
+                var shape = new long[] { 1, 5 };
+                var bufferInput = new int[5];
+                var bufferOutput = new int[5];
+
+                // nothing bound yet
+                Assert.Throws<InvalidOperationException>(() => session.Run(context));
+                Assert.Throws<ArgumentException>(() => context.BindInput("wrong_name", new Memory<int>(bufferInput), shape));
+
+                context.BindInput("input", new Memory<int>(bufferInput), shape);
+                context.BindOutput("output", new Memory<int>(bufferOutput), shape);
+
+                var rand = new Random();
+                for (var i = 0; i < 1000; i++)
+                {
+                    var inputs = Enumerable.Range(0, 5).Select(x => rand.Next()).ToArray();
+                    inputs.CopyTo(bufferInput, 0);
+
+                    session.Run(context);
+                    Assert.Equal(inputs, bufferOutput);
+                }
+
+                // rebinding replaces the previous buffer
+                var otherInput = new int[] { 1, 2, 3, 4, 5 };
+                context.BindInput("input", new Memory<int>(otherInput), shape);
+                session.Run(context);
+                Assert.Equal(otherInput, bufferOutput);
+            }
+        }
+
         [Fact(DisplayName = "TestModelInputINT32")]
         private void TestModelInputINT32()
         {
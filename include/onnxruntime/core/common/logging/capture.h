@@ -33,6 +33,21 @@ class Capture {
       : logger_{&logger}, severity_{severity}, category_{category}, data_type_{dataType}, location_{location} {
   }
 
+  /**
+     Initializes a new instance of the Capture class for a message that was captured already, e.g. to send it to
+     a sink from another thread. The message is not logged when the instance is destroyed.
+     @param severity The severity.
+     @param category The category.
+     @param dataType Type of the data.
+     @param location The file location the log message is coming from.
+     @param message The message.
+  */
+  Capture(logging::Severity severity, const char* category, logging::DataType dataType,
+          const CodeLocation& location, const std::string& message)
+      : logger_{nullptr}, severity_{severity}, category_{category}, data_type_{dataType}, location_{location} {
+    stream_ << message;
+  }
+
   /**
      The stream that can capture the message via operator<<.
      @returns Output stream.
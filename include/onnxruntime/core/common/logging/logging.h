@@ -6,6 +6,7 @@
 #include <atomic>
 #include <chrono>
 #include <climits>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -318,6 +319,28 @@ inline Timestamp LoggingManager::GetTimestamp() const noexcept {
       epochs.system + (high_res_now - epochs.high_res) + epochs.localtime_offset_from_utc);
 }
 
+/**
+   Rate limiting of the messages of a call site, see the *_EVERY_N macros.
+   Returns true for the first and then every n-th occurrence counted by the call site.
+*/
+inline bool ShouldLogEveryN(std::atomic<uint64_t>& occurrences, uint64_t n) noexcept {
+  return occurrences.fetch_add(1, std::memory_order_relaxed) % n == 0;
+}
+
+/**
+   Rate limiting of the messages of a call site, see the *_EVERY_MS macros.
+   Returns true if the call site hasn't logged for interval_ms milliseconds, and records the time in that case.
+   last_logged_ms is the steady clock time of the last message in milliseconds, or INT64_MIN if there wasn't any.
+*/
+inline bool ShouldLogEveryMs(std::atomic<int64_t>& last_logged_ms, int64_t interval_ms) noexcept {
+  const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+  int64_t last = last_logged_ms.load(std::memory_order_relaxed);
+  return (last == INT64_MIN || now - last >= interval_ms) &&
+         last_logged_ms.compare_exchange_strong(last, now, std::memory_order_relaxed);
+}
+
 /**
    Return the current thread id.
 */
@@ -223,6 +223,45 @@
   LOGF_USER_DEFAULT_CATEGORY_IF(boolean_expression, severity, ::onnxruntime::logging::Category::onnxruntime, \
                                 format_str, ##__VA_ARGS__)
 
+/*
+  Rate limited logging
+  The *_EVERY_N variants log the first and then every n-th message of the call site, and the *_EVERY_MS variants at
+  most one message of the call site every interval_ms milliseconds. Messages are only counted while their severity
+  is enabled.
+*/
+
+// The state of the call site, each expansion of the macro has its own lambda and so its own static.
+#define ORT_LOG_CALL_SITE_STATE(type, initial_value) \
+  ([]() -> std::atomic<type>& { static std::atomic<type> state{initial_value}; return state; }())
+
+#define LOGS_CATEGORY_EVERY_N(logger, severity, category, n)                                   \
+  if (!((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity,                \
+                                 ::onnxruntime::logging::DataType::SYSTEM) &&                  \
+        ::onnxruntime::logging::ShouldLogEveryN(ORT_LOG_CALL_SITE_STATE(uint64_t, 0), (n)))) { \
+    /* do nothing */                                                                           \
+  } else                                                                                       \
+    CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::SYSTEM).Stream()
+
+#define LOGS_CATEGORY_EVERY_MS(logger, severity, category, interval_ms)                                          \
+  if (!((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity,                                  \
+                                 ::onnxruntime::logging::DataType::SYSTEM) &&                                    \
+        ::onnxruntime::logging::ShouldLogEveryMs(ORT_LOG_CALL_SITE_STATE(int64_t, INT64_MIN), (interval_ms)))) { \
+    /* do nothing */                                                                                             \
+  } else                                                                                                         \
+    CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::SYSTEM).Stream()
+
+#define LOGS_EVERY_N(logger, severity, n) \
+  LOGS_CATEGORY_EVERY_N(logger, severity, ::onnxruntime::logging::Category::onnxruntime, n)
+
+#define LOGS_EVERY_MS(logger, severity, interval_ms) \
+  LOGS_CATEGORY_EVERY_MS(logger, severity, ::onnxruntime::logging::Category::onnxruntime, interval_ms)
+
+#define LOGS_DEFAULT_EVERY_N(severity, n) \
+  LOGS_EVERY_N(::onnxruntime::logging::LoggingManager::DefaultLogger(), severity, n)
+
+#define LOGS_DEFAULT_EVERY_MS(severity, interval_ms) \
+  LOGS_EVERY_MS(::onnxruntime::logging::LoggingManager::DefaultLogger(), severity, interval_ms)
+
 /*
   Debug verbose logging of caller provided level.
   Disabled in Release builds.
@@ -13,6 +13,8 @@ enum EventCategory {
   SESSION_EVENT = 0,
   NODE_EVENT,
   KERNEL_EVENT,
+  THREAD_POOL_EVENT,
+  MEMORY_EVENT,
   EVENT_CATEGORY_MAX
 };
 
@@ -20,7 +22,9 @@ enum EventCategory {
 static constexpr const char* event_categor_names_[EVENT_CATEGORY_MAX] = {
     "Session",
     "Node",
-    "Kernel"};
+    "Kernel",
+    "ThreadPool",
+    "Memory"};
 
 // Timing record for all events.
 struct EventRecord {
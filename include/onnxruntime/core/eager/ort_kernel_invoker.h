@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -20,6 +23,8 @@ namespace onnxruntime {
 #pragma GCC diagnostic push
 #endif
 
+struct CachedKernel;
+
 class ORTInvoker {
  public:
   ORTInvoker(std::shared_ptr<IExecutionProvider> execution_provider, 
@@ -31,6 +36,8 @@ class ORTInvoker {
     }
   }
 
+  ~ORTInvoker();
+
   IExecutionProvider& GetCurrentExecutionProvider() {
     return *execution_provider_;
   }
@@ -49,6 +56,10 @@ class ORTInvoker {
   // custom ops for current execution provider
   // we need the op schema to resolve the output type during invoke
   const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries_;
+  // one resolved single node graph and kernel per op name, domain, version, attributes, input types and number of
+  // outputs, so that only the first invocation of an op pays for graph resolution and kernel creation
+  std::unordered_map<std::string, std::unique_ptr<CachedKernel>> kernel_cache_;
+  std::mutex kernel_cache_mutex_;
 };
 
 #ifdef __GNUC__
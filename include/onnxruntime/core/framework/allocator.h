@@ -17,20 +17,40 @@ struct OrtArenaCfg {
                   arena_extend_strategy(-1),
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
-                  initial_growth_chunk_size_bytes(-1) {}
+                  initial_growth_chunk_size_bytes(-1),
+                  small_alloc_cache_strategy(-1),
+                  small_alloc_cache_bytes(-1),
+                  numa_node(-1),
+                  idle_shrink_ms(-1),
+                  shrink_high_water_bytes(0),
+                  use_huge_pages(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
-              int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes)
+              int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
+              int small_alloc_cache_strategy = -1, int small_alloc_cache_bytes = -1, int numa_node = -1,
+              int idle_shrink_ms = -1, size_t shrink_high_water_bytes = 0, int use_huge_pages = -1)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
-        initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes) {}
+        initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
+        small_alloc_cache_strategy(small_alloc_cache_strategy),
+        small_alloc_cache_bytes(small_alloc_cache_bytes),
+        numa_node(numa_node),
+        idle_shrink_ms(idle_shrink_ms),
+        shrink_high_water_bytes(shrink_high_water_bytes),
+        use_huge_pages(use_huge_pages) {}
 
   size_t max_mem;                       // use 0 to allow ORT to choose the default
   int arena_extend_strategy;            // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
   int initial_chunk_size_bytes;         // use -1 to allow ORT to choose the default
   int max_dead_bytes_per_chunk;         // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;  // use -1 to allow ORT to choose the default
+  int small_alloc_cache_strategy;       // use -1 to allow ORT to choose the default, 0 = kNone, 1 = kPerThreadCache
+  int small_alloc_cache_bytes;          // use -1 to allow ORT to choose the default
+  int numa_node;                        // use -1 to leave page placement to the OS, otherwise the NUMA node to place regions on
+  int idle_shrink_ms;                   // use -1 to disable, otherwise shrink the arena after being idle for this many ms
+  size_t shrink_high_water_bytes;       // use 0 to disable, otherwise free unused regions while holding more than this
+  int use_huge_pages;                   // use -1 to allow ORT to choose the default, 0 = disabled, 1 = back regions with huge pages
 };
 
 namespace onnxruntime {
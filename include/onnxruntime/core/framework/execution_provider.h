@@ -182,6 +182,17 @@ class IExecutionProvider {
    */
   virtual common::Status ReplayGraph() { return Status::OK(); }
 
+  /**
+     Select the graph that the following runs on the calling thread capture or
+     replay, so that several graphs, e.g. one per set of input shapes, can be
+     captured for the model. IsGraphCaptured() and ReplayGraph() refer to the
+     selected graph. Graph annotation id kGraphAnnotationSkip disables the
+     capture of the following runs. The default id is 0.
+     Currently only CUDA execution provider supports it.
+   */
+  static constexpr int kGraphAnnotationSkip = -1;
+  virtual void SetGraphAnnotationId(int /*graph_annotation_id*/) {}
+
   /**
      Called when session creation is complete
      This provides an opportunity for execution providers to optionally synchronize and
@@ -192,6 +203,36 @@ class IExecutionProvider {
   virtual common::Status SetComputeStream(void*) { return Status::OK(); }
   virtual void* GetComputeStream() const { return nullptr; }
 
+  /**
+     Number of compute streams the provider can run kernels on concurrently.
+     If it is more than one, the session planner assigns independent branches
+     of the graph to different streams (see SequentialExecutionPlan), and the
+     executors select the stream of each node with SetCurrentComputeStream()
+     and order dependent nodes on different streams with stream events.
+     Currently only CUDA execution provider supports it.
+   */
+  virtual int GetComputeStreamCount() const { return 1; }
+
+  /**
+     Select the compute stream used by the kernels that run on the calling
+     thread, until it is selected again. Stream 0 is the stream returned by
+     GetComputeStream() when no other stream is selected.
+   */
+  virtual common::Status SetCurrentComputeStream(int /*stream_index*/) const { return Status::OK(); }
+
+  /**
+     Record an event capturing the work queued on the given compute stream so
+     far, which other compute streams can wait for with WaitStreamEvent().
+     The event is handed back with ReleaseStreamEvent() once all the waits on
+     it have been queued.
+   */
+  virtual common::Status RecordStreamEvent(int /*stream_index*/, void** event) const {
+    *event = nullptr;
+    return Status::OK();
+  }
+  virtual common::Status WaitStreamEvent(int /*stream_index*/, void* /*event*/) const { return Status::OK(); }
+  virtual void ReleaseStreamEvent(void* /*event*/) const {}
+
   void InsertAllocator(AllocatorPtr allocator);
   void ReplaceAllocator(AllocatorPtr allocator);
   // TODO: temparary sulotion, need to unify the interface in EP and AllocatorManager
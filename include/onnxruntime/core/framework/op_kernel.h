@@ -116,6 +116,43 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to let the pre-packed weights of an input be saved in an ORT format model, so that they
+  // can be used instead of packing the input again when the model is loaded (see UseSavedPrePackedBuffers()).
+  // @param input_idx: The input index of the tensor in this kernel
+  // @returns: An identifier of the layout of the buffers PrePack() creates for the input, which must change whenever
+  //           the layout does, e.g. with the ISA the buffers are packed for. An empty string if they can't be saved.
+  virtual std::string GetPrePackedWeightsFormat(int /*input_idx*/) const {
+    return {};
+  }
+
+  // Override this function to use the pre-packed weights that PrePack() created for the same tensor in an earlier
+  // session, which saved them in an ORT format model. It is called instead of PrePack(), and only if
+  // GetPrePackedWeightsFormat() returns the format the buffers were saved with.
+  // Unlike with UseSharedPrePackedBuffers(), the kernel owns the buffers, and it must restore all the state PrePack()
+  // would have set.
+  // @param tensor: The initialized constant tensor
+  // @param prepacked_weights: The saved buffers and their sizes, in the order PrePack() stored them. The kernel
+  //                           takes the ownership of the buffers it uses.
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param used_saved_buffers: Set it to true if the kernel used the buffers, or to false to have PrePack() called.
+  virtual Status UseSavedPrePackedBuffers(const Tensor& /*tensor*/,
+                                          PrePackedWeights& /*prepacked_weights*/,
+                                          int /*input_idx*/,
+                                          /*out*/ bool& used_saved_buffers) {
+    used_saved_buffers = false;
+    return Status::OK();
+  }
+
+  // Override this function to precompute the state that depends on the shapes of the inputs and outputs.
+  // It is called once after PrePack() when the session freezes the shapes (see kOrtSessionOptionsConfigFreezeShapes).
+  // Every call to Compute() then sees these shapes, so the kernel can skip computing and validating them.
+  // @param input_shapes: The shapes of the inputs, nullptr for a missing optional input or a non-tensor input.
+  // @param output_shapes: The shapes of the outputs, nullptr for a missing optional output or a non-tensor output.
+  virtual Status PrepareForShapes(gsl::span<const TensorShape* const> /*input_shapes*/,
+                                  gsl::span<const TensorShape* const> /*output_shapes*/) {
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
@@ -209,9 +209,8 @@ class OpKernelContext {
   const OrtValue* GetImplicitInputMLValue(int index) const;
   OrtValue* GetOutputMLValue(int index);
 
-#ifdef ENABLE_TRAINING
+  // Sets the output to an existing value, e.g. one that an output of a control flow node aliases.
   Status SetOutputMLValue(int index, const OrtValue& ort_value);
-#endif
 
   // Creates the OrtValue* based on the shape, if it does not exist
   OrtValue* OutputMLValue(int index, const TensorShape& shape);
@@ -10,9 +10,10 @@
 #include "core/framework/allocator.h"
 #include "core/framework/data_types.h"
 #include "core/framework/tensor.h"
-#include "core/framework/TensorSeq.h"
 
 namespace onnxruntime {
+// TensorSeq.h is included at the end, as a TensorSeq holds its tensors in OrtValues
+class TensorSeq;
 #if !defined(DISABLE_SPARSE_TENSORS)
 class SparseTensor;
 #endif
@@ -134,3 +135,7 @@ inline onnxruntime::SparseTensor* OrtValue::GetMutable<onnxruntime::SparseTensor
   return static_cast<onnxruntime::SparseTensor*>(data_.get());
 }
 #endif
+
+#ifndef SHARED_PROVIDER
+#include "core/framework/TensorSeq.h"
+#endif
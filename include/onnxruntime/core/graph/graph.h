@@ -256,17 +256,13 @@ class Node {
   /** Gets a modifiable count of arguments for each of the Node's explicit inputs.
   @todo This should be removed in favor of a method that updates the input args and the count.
         Currently these operations are separate which is not a good setup. */
-  std::vector<int>& MutableInputArgsCount() { return definitions_.input_arg_count; }
+  std::vector<int>& MutableInputArgsCount();
 
   /** Gets a modifiable collection of the Node's input definitions. */
-  std::vector<NodeArg*>& MutableInputDefs() noexcept {
-    return definitions_.input_defs;
-  }
+  std::vector<NodeArg*>& MutableInputDefs() noexcept;
 
   /** Gets a modifiable collection of the Node's output definitions. */
-  std::vector<NodeArg*>& MutableOutputDefs() noexcept {
-    return definitions_.output_defs;
-  }
+  std::vector<NodeArg*>& MutableOutputDefs() noexcept;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
   /** Struct to provide sorting between EdgeEnd instances based on NodeIndex first, and NodeArg::Name second. */
@@ -709,6 +705,13 @@ class Graph {
   /** Removes all initializer tensors from this Graph and releases the memory they were using. */
   void CleanAllInitializedTensors() noexcept;
 
+  /** Frees the data of the initializer tensor with the provided name, once it has been copied to where it is used.
+  The initializer keeps its name, type and shape, and is expected to be removed with CleanAllInitializedTensors().
+
+  Note: This currently has linear time complexity, like ReplaceInitializedTensor().
+  */
+  void ReleaseInitializedTensorData(const std::string& tensor_name);
+
   /** Returns true if an initializer value can be overridden by a graph input with the same name. */
   bool CanOverrideInitializer() const noexcept { return ir_version_ >= 4; }
 
@@ -999,6 +1002,12 @@ class Graph {
     return *this;
   }
 
+  /** Records that the Node with the given index was added or modified, so that a Resolve with
+  ResolveOptions::only_infer_modified_nodes infers it. */
+  void SetNodeModified(NodeIndex node_index) {
+    modified_nodes_.insert(node_index);
+  }
+
   /** Gets flag indicating whether Graph::graph_proto_ needs to be synchronized with this Graph instance. */
   bool GraphProtoSyncNeeded() const noexcept {
     return graph_proto_sync_needed_;
@@ -1050,6 +1059,14 @@ class Graph {
   void KahnsTopologicalSort(const std::function<void(const Node*)>& enter,
                             const std::function<bool(const Node*, const Node*)>& comp) const;
 
+  /** Gets the value of a shape tensor, such as the output of a Shape node or a Concat of dims, as inferred by the
+  symbolic shape inference of the last Resolve. Dims computed from the free dims of other tensors are expressed with
+  their dim_param, e.g. "batch*sequence". A dim of the value is empty if that element is not known.
+  @param check_outer_scope If true and the graph is a subgraph, check ancestor graph/s for 'name' if not found.
+  @returns The value, or nullptr if it is not known.
+  */
+  const ONNX_NAMESPACE::TensorShapeProto* GetSymbolicShapeValue(const std::string& name,
+                                                               bool check_outer_scope) const;
 #endif
 
   /** Gets the map of operator domains to their opset versions. */
@@ -1234,6 +1251,10 @@ class Graph {
     // When set to true, graph resolve will be called for initialized function bodies as well. This is used
     // in case of nested model local functions.
     bool traverse_function_body = false;
+    // Whether type and shape inferencing only needs to run on the nodes modified since the last Resolve, and on the
+    // nodes downstream of them whose input types or shapes changed. Nodes containing subgraphs, and the nodes of
+    // subgraphs, are always inferred. Set by callers that only modify the Graph through the Graph and Node APIs.
+    bool only_infer_modified_nodes = false;
   };
 
   /**
@@ -1285,12 +1306,15 @@ class Graph {
 
   virtual ~Graph();
 
+  // If can_use_flatbuffer_for_initializers is true, the initializers of the graph and its subgraphs may refer to
+  // the bytes of fbs_graph in place, see fbs::utils::LoadInitializerOrtFormat.
   static common::Status LoadFromOrtFormat(
       const onnxruntime::fbs::Graph& fbs_graph, const Model& owning_model,
       const std::unordered_map<std::string, int>& domain_to_version,
 #if !defined(ORT_MINIMAL_BUILD)
       IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+      bool can_use_flatbuffer_for_initializers,
       const logging::Logger& logger, std::unique_ptr<Graph>& graph);
 
   // deserialize a subgraph
@@ -1400,6 +1424,9 @@ class Graph {
     std::unordered_set<std::string> outer_scope_node_args;
     std::unordered_map<std::string, NodeIndex> node_name_to_index;
     std::unordered_set<Node*> nodes_with_subgraphs;
+    // Whether only the nodes in nodes_to_infer are inferred. See ResolveOptions::only_infer_modified_nodes.
+    bool infer_modified_nodes_only = false;
+    std::unordered_set<NodeIndex> nodes_to_infer;
 
     void Clear() {
       output_args.clear();
@@ -1407,6 +1434,8 @@ class Graph {
       outer_scope_node_args.clear();
       node_name_to_index.clear();
       nodes_with_subgraphs.clear();
+      infer_modified_nodes_only = false;
+      nodes_to_infer.clear();
     }
 
    private:
@@ -1534,6 +1563,9 @@ class Graph {
   // GraphProto that provides storage for the ONNX proto types deserialized from a flexbuffer/flatbuffer
   ONNX_NAMESPACE::GraphProto deserialized_proto_data_;
 
+  // Whether the initializers deserialized from a flatbuffer may refer to its bytes instead of copying them
+  bool can_use_flatbuffer_for_initializers_ = false;
+
   InitializedTensorSet name_to_initial_tensor_;
 
   std::unordered_set<std::reference_wrapper<const std::string>,
@@ -1574,6 +1606,16 @@ class Graph {
   // A flag indicates whether <*this> graph needs to be resolved.
   bool graph_resolve_needed_ = false;
 
+  // Nodes added or modified since the last Resolve, and whether all nodes need type and shape inferencing instead,
+  // e.g. as the graph inputs changed.
+  std::unordered_set<NodeIndex> modified_nodes_;
+  bool infer_all_nodes_ = true;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // The values of the shape tensors inferred by the symbolic shape inference. See GetSymbolicShapeValue.
+  std::unordered_map<std::string, ONNX_NAMESPACE::TensorShapeProto> symbolic_shape_values_;
+#endif
+
   bool graph_proto_sync_needed_ = false;
 
   // The topological order of node index used to do node and op match verification temporarily.
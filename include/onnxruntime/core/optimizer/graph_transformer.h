@@ -10,6 +10,9 @@
 #include "core/optimizer/graph_transformer_level.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 
 /**
 @class GraphTransformer
@@ -42,9 +45,28 @@ class GraphTransformer {
 
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Whether the transformer only modifies the Graph through the Graph and Node APIs, and not by changing the types
+  or shapes of NodeArgs directly, so that the Resolve after it only needs to infer the modified nodes.
+  See Graph::ResolveOptions::only_infer_modified_nodes.
+  */
+  virtual bool ShouldOnlyInferModifiedNodes() const { return false; }
+
+  /** Sets the thread pool used by Apply to transform the subgraphs of the main graph concurrently.
+  nullptr, the default, transforms the graph serially.
+  */
+  void SetThreadPool(concurrency::ThreadPool* thread_pool) noexcept { thread_pool_ = thread_pool; }
+
  protected:
+  /** Thread pool for the transformation of the main graph, or nullptr. */
+  concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
+
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   common::Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
+    // the subgraphs of the main graph were already transformed concurrently by Apply
+    if (graph_level == 0 && subgraphs_of_main_graph_applied_) {
+      return Status::OK();
+    }
+
     int subgraph_level = ++graph_level;
     for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
       auto& subgraph = *entry.second;
@@ -67,7 +89,14 @@ class GraphTransformer {
   virtual common::Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger)
       const = 0;
 
+  // Applies the transformation to the subgraphs of the nodes of the main graph concurrently, then to the main graph.
+  common::Status ApplyWithConcurrentSubgraphs(Graph& graph, bool& modified, const logging::Logger& logger) const;
+
   const std::string name_;
   const InlinedHashSet<std::string_view> compatible_provider_types_;
+  concurrency::ThreadPool* thread_pool_ = nullptr;
+  // set by ApplyWithConcurrentSubgraphs while the main graph is transformed. Apply is not called concurrently on
+  // one transformer.
+  mutable bool subgraphs_of_main_graph_applied_ = false;
 };
 }  // namespace onnxruntime
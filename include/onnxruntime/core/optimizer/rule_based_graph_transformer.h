@@ -53,6 +53,9 @@ class RuleBasedGraphTransformer : public GraphTransformer {
   /** Returns the total number of rules that are registered in this transformer. */
   size_t RulesCount() const;
 
+  // the rewrite rules only modify the graph through the Graph and Node APIs
+  bool ShouldOnlyInferModifiedNodes() const override { return true; }
+
  protected:
   /** Applies the given set of rewrite rules on the Node of this Graph.
       @param[in] graph The Graph.
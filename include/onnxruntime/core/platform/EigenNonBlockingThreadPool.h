@@ -32,6 +32,8 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
@@ -44,6 +46,7 @@
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -69,6 +72,9 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   With ThreadOptions::adaptive_spinning the spin is instead bounded
+//   by a duration that follows the time workers typically wait for
+//   work (see AdaptiveSpinNs).
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -324,6 +330,22 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
                              unsigned n, std::ptrdiff_t block_size) = 0;
   virtual void StartProfiling()  = 0;
   virtual std::string StopProfiling() = 0;
+
+  // The number of NUMA nodes the workers are spread over.  This is 1
+  // unless the pool was created with per-thread NUMA information.
+  virtual unsigned NumNumaNodes() const = 0;
+
+  // The NUMA node of the calling thread as an index in
+  // [0,NumNumaNodes()), or -1 if the caller is not a worker in the pool.
+  virtual int CurrentThreadNumaNode() const = 0;
+
+  // The number of tasks waiting in the work queues of the workers.
+  // This is a snapshot that may be outdated as soon as it is returned.
+  virtual unsigned NumQueuedTasks() const = 0;
+
+  // Counters of the workers' spinning and blocking, summed over the
+  // workers.
+  virtual ThreadPoolSpinStats GetSpinStats() const = 0;
 };
 
 
@@ -659,9 +681,221 @@ class RunQueue {
   void operator=(const RunQueue&) = delete;
 };
 
+// LockFreeRunQueue is an alternative to RunQueue that does not take a
+// lock on any path.  It can be selected when the thread pool is
+// created (see ThreadOptions::use_lock_free_queues) for workloads
+// where many threads push work to the same queues concurrently, for
+// instance when the parallel executor submits a burst of inter-op
+// tasks.
+//
+// The queue is a bounded multi-producer multi-consumer ring buffer in
+// the style of Vyukov's queue: each slot carries a sequence number
+// that tells producers and consumers whether the slot is free in the
+// current lap of the ring.  Producers claim slots by a CAS on back_,
+// and consumers claim slots by a CAS on front_.  A Chase-Lev deque
+// would not fit here because work is pushed by arbitrary threads
+// rather than only by the thread owning the queue.
+//
+// In contrast to RunQueue, PopFront and PopBack both take the oldest
+// item.  The owning worker and thieves therefore compete for the same
+// end of the queue, with thieves selected at random by the pool.
+//
+// Revocation follows RunQueue: an item is replaced in-place by a
+// tombstone, and consumers discard tombstones when they reach them.
+// A consumer that has claimed a slot synchronizes with a concurrent
+// RevokeWithTag via the same kReady->kBusy CAS on the slot state.
+template <typename Work, typename Tag, unsigned kSize>
+class LockFreeRunQueue {
+ public:
+  LockFreeRunQueue() : front_(0), back_(0) {
+    // require power-of-two for fast masking
+    assert((kSize & (kSize - 1)) == 0);
+    assert(kSize > 2);
+    for (unsigned i = 0; i < kSize; i++) {
+      array_[i].seq.store(i, std::memory_order_relaxed);
+      array_[i].state.store(ElemState::kEmpty, std::memory_order_relaxed);
+    }
+  }
+
+  ~LockFreeRunQueue() {
+    assert(Size() == 0);
+  }
+
+  // PopFront removes and returns the oldest element in the queue.
+  // If the queue was empty returns default-constructed Work.
+  Work PopFront() {
+    return Pop();
+  }
+
+  // PushBack adds w at the end of the queue.
+  // If queue is full returns w, otherwise returns default-constructed Work.
+  Work PushBack(Work w) {
+    unsigned w_idx;
+    bool was_empty;
+    if (!Push(w, Tag(), w_idx, was_empty)) {
+      return w;
+    }
+    return Work();
+  }
+
+  // PushBackWithTag adds w at the end of the queue.  See
+  // RunQueue::PushBackWithTag.
+  PushResult PushBackWithTag(Work w, Tag tag, unsigned& w_idx) {
+    bool was_empty;
+    if (!Push(w, tag, w_idx, was_empty)) {
+      return PushResult::REJECTED; /* Not enqueued */
+    }
+    return was_empty ? PushResult::ACCEPTED_IDLE : PushResult::ACCEPTED_BUSY; /* Enqueued */
+  }
+
+  // PopBack removes and returns the oldest element in the queue.  It
+  // is used by threads other than the owner to steal work.
+  Work PopBack() {
+    if (Empty())
+      return Work();
+    return Pop();
+  }
+
+  // RevokeWithTag removes a work item from the queue.  See
+  // RunQueue::RevokeWithTag.  The item is always replaced by a
+  // tombstone because consumers may be concurrently claiming the
+  // slots before it.
+  bool RevokeWithTag(Tag tag, unsigned w_idx) {
+    Elem& e = array_[w_idx];
+    ElemState s = ElemState::kReady;
+    if (!e.state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire)) {
+      return false;
+    }
+    if (e.tag == tag) {
+      e.tag = Tag();
+      e.w = Work();
+      e.state.store(ElemState::kRevoked, std::memory_order_release);
+      return true;
+    }
+    // Tag mismatch, i.e. work queue slot re-used
+    e.state.store(ElemState::kReady, std::memory_order_release);
+    return false;
+  }
+
+  // Size returns current queue size, including revoked items that have
+  // not yet been drained.
+  // Can be called by any thread at any time.
+  unsigned Size() const {
+    // Read front_ first so that the size is never under-estimated
+    // because of a concurrent push.
+    unsigned front = front_.load(std::memory_order_acquire);
+    unsigned back = back_.load(std::memory_order_acquire);
+    int size = static_cast<int>(back - front);
+    if (size < 0)
+      return 0;
+    if (size > static_cast<int>(kSize))
+      return kSize;
+    return static_cast<unsigned>(size);
+  }
+
+  // Empty tests whether container is empty.
+  // Can be called by any thread at any time.
+  bool Empty() const {
+    return Size() == 0;
+  }
+
+ private:
+  static const unsigned kMask = kSize - 1;
+
+  enum class ElemState : uint8_t {
+    kEmpty,
+    kBusy,
+    kReady,
+    kRevoked,
+  };
+
+  // seq is authoritative for which lap of the ring owns the slot: it
+  // equals the position for a free slot, and position + 1 for a slot
+  // holding an item.  state synchronizes consumers with RevokeWithTag.
+  struct Elem {
+    std::atomic<unsigned> seq;
+    std::atomic<ElemState> state;
+    Tag tag;
+    Work w;
+  };
+
+  bool Push(Work& w, Tag tag, unsigned& w_idx, bool& was_empty) {
+    unsigned pos = back_.load(std::memory_order_relaxed);
+    for (;;) {
+      Elem& e = array_[pos & kMask];
+      unsigned seq = e.seq.load(std::memory_order_acquire);
+      int dif = static_cast<int>(seq - pos);
+      if (dif == 0) {
+        if (back_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          was_empty = (pos == front_.load(std::memory_order_relaxed));
+          e.w = std::move(w);
+          e.tag = tag;
+          e.state.store(ElemState::kReady, std::memory_order_relaxed);
+          e.seq.store(pos + 1, std::memory_order_release);
+          w_idx = pos & kMask;
+          return true;
+        }
+      } else if (dif < 0) {
+        // The slot still holds an item from the previous lap: the queue is full.
+        return false;
+      } else {
+        pos = back_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  Work Pop() {
+    unsigned pos = front_.load(std::memory_order_relaxed);
+    for (;;) {
+      Elem& e = array_[pos & kMask];
+      unsigned seq = e.seq.load(std::memory_order_acquire);
+      int dif = static_cast<int>(seq - (pos + 1));
+      if (dif == 0) {
+        if (front_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          // The slot is now exclusively ours with respect to other
+          // consumers.  Wait out any in-flight revocation.
+          ElemState s = ElemState::kReady;
+          while (!e.state.compare_exchange_weak(s, ElemState::kBusy, std::memory_order_acquire)) {
+            if (s == ElemState::kRevoked) {
+              break;
+            }
+            s = ElemState::kReady;
+            onnxruntime::concurrency::SpinPause();
+          }
+          bool revoked = (s == ElemState::kRevoked);
+          Work w = revoked ? Work() : std::move(e.w);
+          e.w = Work();
+          e.tag = Tag();
+          e.state.store(ElemState::kEmpty, std::memory_order_relaxed);
+          e.seq.store(pos + kSize, std::memory_order_release);
+          if (!revoked) {
+            return w;
+          }
+          // Drain the tombstone and try the next item.
+          pos = front_.load(std::memory_order_relaxed);
+        }
+      } else if (dif < 0) {
+        // The slot has not been filled in this lap: the queue is empty.
+        return Work();
+      } else {
+        pos = front_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // front_ and back_ are free-running positions; the slot index is
+  // the low log(kSize) bits.
+  ORT_ALIGN_TO_AVOID_FALSE_SHARING std::atomic<unsigned> front_;
+  ORT_ALIGN_TO_AVOID_FALSE_SHARING std::atomic<unsigned> back_;
+  ORT_ALIGN_TO_AVOID_FALSE_SHARING Elem array_[kSize];
+
+  LockFreeRunQueue(const LockFreeRunQueue&) = delete;
+  void operator=(const LockFreeRunQueue&) = delete;
+};
+
 static std::atomic<uint32_t> next_tag{1};
 
-template <typename Environment>
+template <typename Environment, template <typename, typename, unsigned> class RunQueueType = RunQueue>
 class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInterface {
 
  private:
@@ -721,7 +955,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   };
 
   typedef std::function<void()> Task;
-  typedef RunQueue<Task, Tag, 1024> Queue;
+  typedef RunQueueType<Task, Tag, 1024> Queue;
 
   ThreadPoolTempl(const CHAR_TYPE* name, int num_threads, bool allow_spinning, Environment& env,
                   const ThreadOptions& thread_options)
@@ -729,6 +963,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -746,6 +981,30 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    // Group the workers by NUMA node.  Nodes are renumbered densely
+    // in order of first appearance so they can index numa_node_workers_.
+    // With fewer than two nodes the grouping is dropped and the pool
+    // behaves as if it had no NUMA information.
+    if (thread_options.numa_nodes.size() >= num_threads_) {
+      std::vector<int> node_ids;
+      for (auto i = 0u; i < num_threads_; i++) {
+        int node_id = thread_options.numa_nodes[i];
+        auto it = std::find(node_ids.begin(), node_ids.end(), node_id);
+        if (it == node_ids.end()) {
+          node_ids.push_back(node_id);
+          numa_node_workers_.emplace_back();
+          it = node_ids.end() - 1;
+        }
+        unsigned node = static_cast<unsigned>(it - node_ids.begin());
+        worker_numa_node_.push_back(node);
+        numa_node_workers_[node].push_back(i);
+      }
+      if (numa_node_workers_.size() < 2) {
+        worker_numa_node_.clear();
+        numa_node_workers_.clear();
+      }
+    }
+
     worker_data_.resize(num_threads_);
     for (auto i = 0u; i < num_threads_; i++) {
       worker_data_[i].thread.reset(env_.CreateThread(name, i, WorkerLoop, this, thread_options));
@@ -1283,6 +1542,40 @@ int CurrentThreadId() const final {
   return -1;
 }
 
+unsigned NumNumaNodes() const final {
+  return numa_node_workers_.empty() ? 1u : static_cast<unsigned>(numa_node_workers_.size());
+}
+
+int CurrentThreadNumaNode() const final {
+  int thread_id = CurrentThreadId();
+  if (thread_id == -1) {
+    return -1;
+  }
+  return worker_numa_node_.empty() ? 0 : static_cast<int>(worker_numa_node_[thread_id]);
+}
+
+unsigned NumQueuedTasks() const final {
+  unsigned num_tasks = 0;
+  for (size_t i = 0; i < worker_data_.size(); ++i) {
+    num_tasks += worker_data_[i].queue.Size();
+  }
+  return num_tasks;
+}
+
+ThreadPoolSpinStats GetSpinStats() const final {
+  ThreadPoolSpinStats stats;
+  for (size_t i = 0; i < worker_data_.size(); ++i) {
+    stats.spin_hits += worker_data_[i].spin_hits.load(std::memory_order_relaxed);
+    stats.blocks += worker_data_[i].blocks.load(std::memory_order_relaxed);
+    stats.wakes += worker_data_[i].wakes.load(std::memory_order_relaxed);
+  }
+  if (adaptive_spinning_) {
+    stats.avg_wait_ns = avg_wait_ns_.load(std::memory_order_relaxed);
+    stats.spin_ns = AdaptiveSpinNs();
+  }
+  return stats;
+}
+
  private:
   void ComputeCoprimes(int N, Eigen::MaxSizeVector<unsigned>* coprimes) {
     for (int i = 1; i <= N; i++) {
@@ -1337,6 +1630,11 @@ int CurrentThreadId() const final {
     std::unique_ptr<Thread> thread;
     Queue queue;
 
+    // Spin and wake counters, updated only by the worker itself.
+    std::atomic<uint64_t> spin_hits{0};
+    std::atomic<uint64_t> blocks{0};
+    std::atomic<uint64_t> wakes{0};
+
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
     // purposes:
@@ -1426,12 +1724,41 @@ int CurrentThreadId() const final {
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
+  // NUMA node of each worker, and the workers on each node.  Both are
+  // empty unless the workers span at least two nodes.
+  std::vector<unsigned> worker_numa_node_;
+  std::vector<std::vector<unsigned>> numa_node_workers_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
+  // Adaptive spinning.  The workers spin for twice the moving average
+  // of the time they waited for work, which catches most of the
+  // follow-up work of back-to-back parallel sections.  If that exceeds
+  // kMaxAdaptiveSpinNs the work typically arrives too late for
+  // spinning to help, and the workers block right away instead of
+  // burning CPU.  The wait time is measured whether or not the worker
+  // spun, so the policy recovers when the gaps become shorter again.
+  // The average starts at the limit, i.e. spinning as much as allowed.
+  static constexpr uint64_t kMaxAdaptiveSpinNs = 1000 * 1000;
+  std::atomic<uint64_t> avg_wait_ns_{kMaxAdaptiveSpinNs / 2};
+
+  uint64_t AdaptiveSpinNs() const {
+    uint64_t spin_ns = 2 * avg_wait_ns_.load(std::memory_order_relaxed);
+    return spin_ns <= kMaxAdaptiveSpinNs ? spin_ns : 0;
+  }
+
+  // Exponential moving average with weight 1/8.  Concurrent updates
+  // from several workers may be lost, which only makes the average
+  // slightly less precise.
+  void RecordWaitTime(uint64_t wait_ns) {
+    uint64_t avg = avg_wait_ns_.load(std::memory_order_relaxed);
+    avg_wait_ns_.store(avg - avg / 8 + wait_ns / 8, std::memory_order_relaxed);
+  }
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1464,14 +1791,37 @@ int CurrentThreadId() const final {
     while (!should_exit) {
       Task t = q.PopFront();
       if (!t) {
+        std::chrono::steady_clock::time_point wait_begin;
+        std::chrono::steady_clock::time_point spin_end;
+        int thread_spin_count = spin_count;
+        if (adaptive_spinning_) {
+          wait_begin = std::chrono::steady_clock::now();
+          const uint64_t spin_ns = AdaptiveSpinNs();
+          spin_end = wait_begin + std::chrono::nanoseconds(spin_ns);
+          if (spin_ns == 0) {
+            thread_spin_count = 0;
+          }
+        }
+
         // Spin waiting for work.
-        for (int i = 0; i < spin_count && !t && !done_; i++) {
+        for (int i = 0; i < thread_spin_count && !t && !done_; i++) {
           if (((i+1)%steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
           } else {
             t = q.PopFront();
           }
           onnxruntime::concurrency::SpinPause();
+          // Reading the clock is much more expensive than a pause, so
+          // check the deadline only every 64 iterations.
+          if (adaptive_spinning_ && (i & 63) == 63 && std::chrono::steady_clock::now() >= spin_end) {
+            break;
+          }
+        }
+
+        if (t) {
+          td.spin_hits.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          td.blocks.fetch_add(1, std::memory_order_relaxed);
         }
 
         // Attempt to block
@@ -1531,6 +1881,7 @@ int CurrentThreadId() const final {
                         // Post-block update (executed only if we blocked)
                         [&]() {
                           blocked_--;
+                          td.wakes.fetch_add(1, std::memory_order_relaxed);
                         });
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
@@ -1538,6 +1889,12 @@ int CurrentThreadId() const final {
           if (!t) t = q.PopFront();
           if (!t) t = Steal(StealAttemptKind::TRY_ALL);
         }
+
+        if (adaptive_spinning_ && t) {
+          RecordWaitTime(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                   std::chrono::steady_clock::now() - wait_begin)
+                                                   .count()));
+        }
       }
       if (t) {
         td.SetActive();
@@ -1561,11 +1918,27 @@ int CurrentThreadId() const final {
   // "snatching" work from a thread which is just about to notice the
   // work itself.
 
+  //
+  // When the workers span several NUMA nodes, a worker first tries the
+  // other workers on its own node.  This keeps work, and the memory it
+  // touches, on the node it was pushed to.  One in four single-victim
+  // attempts still goes to the whole pool so that an idle node can
+  // pick up work from a busy one while spinning.
+
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
     unsigned size = num_threads_;
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
     unsigned r = Rand(&pt->rand);
+
+    if (!numa_node_workers_.empty() && pt->pool == this &&
+        (steal_kind == StealAttemptKind::TRY_ALL || (r & 3) != 0)) {
+      Task t = StealFromNode(worker_numa_node_[pt->thread_id], steal_kind, r);
+      if (t || steal_kind == StealAttemptKind::TRY_ONE) {
+        return t;
+      }
+    }
+
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
     
@@ -1586,6 +1959,26 @@ int CurrentThreadId() const final {
     return Task();
   }
 
+  Task StealFromNode(unsigned node, StealAttemptKind steal_kind, unsigned r) {
+    const std::vector<unsigned>& victims = numa_node_workers_[node];
+    const unsigned size = static_cast<unsigned>(victims.size());
+    const unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
+    unsigned pos = (r >> 2) % size;
+    for (unsigned i = 0; i < num_attempts; i++) {
+      WorkerData& victim = worker_data_[victims[pos]];
+      if (victim.GetStatus() == WorkerData::ThreadStatus::Active) {
+        Task t = victim.queue.PopBack();
+        if (t) {
+          return t;
+        }
+      }
+      if (++pos == size) {
+        pos = 0;
+      }
+    }
+    return Task();
+  }
+
   int NonEmptyQueueIndex() {
     PerThread* pt = GetPerThread();
     const unsigned size = static_cast<unsigned>(worker_data_.size());
@@ -16,6 +16,8 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <functional>
@@ -130,13 +132,35 @@ struct TensorOpCost {
 
 namespace concurrency {
 
-template <typename Environment>
-class ThreadPoolTempl;
-
 class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
 
+// Counters of how the threads of a pool waited for work.  See ThreadPool::GetSpinStats.
+struct ThreadPoolSpinStats {
+  uint64_t spin_hits = 0;  // times a thread found work while spinning
+  uint64_t blocks = 0;     // times a thread stopped spinning, or didn't spin, and tried to block
+  uint64_t wakes = 0;      // times a blocked thread was woken up
+
+  // Moving average of the time the threads waited for work, and the spin duration derived from it, in
+  // nanoseconds.  Only maintained if the pool uses adaptive spinning (see ThreadOptions::adaptive_spinning).
+  uint64_t avg_wait_ns = 0;
+  uint64_t spin_ns = 0;
+};
+
+// Share of the threads of a pool given to one of several users of the pool, e.g. the sessions using the global
+// thread pools of the environment.  See the ThreadPool constructor taking a shared pool.
+struct ThreadPoolQuota {
+  // Maximum number of the pool's threads a parallel loop runs on, besides the thread entering the loop.
+  // 0 for no limit.
+  int max_threads = 0;
+
+  // Weight of the user in the fair sharing of the threads.  While several users with a weight are active (see
+  // ThreadPool::ActiveScope), the threads, including the ones entering the loops, are divided between them in
+  // proportion to their weights.  0 to not take part in the fair sharing.
+  int weight = 0;
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -160,6 +184,13 @@ class ThreadPool {
              bool low_latency_hint,
              bool force_hybrid = false);
 
+  // Constructs a pool that runs its work on the threads of "shared_pool",
+  // which must outlive it, and whose parallel loops use at most the share
+  // of the threads given by "quota".  Several such pools give the users of
+  // a shared pool some isolation from each other: a heavy user can't enlist
+  // all the threads in its loops and starve the others.
+  ThreadPool(ThreadPool& shared_pool, const ThreadPoolQuota& quota);
+
   // Waits until all scheduled work has finished and then destroy the
   // set of threads.
   ~ThreadPool();
@@ -221,6 +252,63 @@ class ThreadPool {
                   "Per-thread state should be trivially destructible");
   };
 
+  // Marks the pool as active for the fair sharing of the threads of the pool
+  // it shares (see ThreadPoolQuota::weight) while the instance exists, e.g.
+  // for the duration of a session run.  Scopes may be nested or concurrent.
+  // Has no effect on pools without a weighted quota.
+  class ActiveScope {
+   public:
+    explicit ActiveScope(ThreadPool* tp);
+    ~ActiveScope();
+
+   private:
+    ThreadPool* tp_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ActiveScope);
+  };
+
+  // Cooperative termination of the work of a session run.  The executor
+  // installs a scope on the threads running the nodes of a run, with the
+  // terminate flag and the deadline of the run.  Parallel loops issued
+  // from such a thread stop handing out blocks of iterations once the run
+  // should terminate, and the executors and the control flow kernels check
+  // ShouldTerminate() between nodes and iterations, so an abandoned run
+  // releases its threads promptly instead of finishing a long loop or a
+  // large GEMM nobody waits for.  A loop cut short returns normally with
+  // partial results: the caller must check ShouldTerminate() afterwards.
+  //
+  // Scopes may be nested, the innermost one applies.
+  class RunTerminationScope {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    RunTerminationScope(const bool& terminate_flag, Clock::time_point deadline = Clock::time_point::max());
+    ~RunTerminationScope();
+
+    // Returns the scope of the current thread, or nullptr outside runs.
+    static const RunTerminationScope* Current() noexcept { return current_run_termination_scope; }
+
+    const bool& TerminateFlag() const noexcept { return terminate_flag_; }
+    Clock::time_point Deadline() const noexcept { return deadline_; }
+
+    bool DeadlineExceeded() const {
+      return deadline_ != Clock::time_point::max() && Clock::now() >= deadline_;
+    }
+
+    bool ShouldTerminate() const {
+      return terminate_flag_ || DeadlineExceeded();
+    }
+
+   private:
+    const bool& terminate_flag_;
+    const Clock::time_point deadline_;
+    const RunTerminationScope* previous_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunTerminationScope);
+
+    static thread_local const RunTerminationScope* current_run_termination_scope;
+    static_assert(std::is_trivially_destructible<decltype(current_run_termination_scope)>::value,
+                  "Per-thread state should be trivially destructible");
+  };
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -369,14 +457,29 @@ class ThreadPool {
  private:
   friend class LoopCounter;
 
-  // Returns the number of threads created in the pool.  This may be different from the
-  // value returned by DegreeOfParallelism to code using the pool.
+  // Returns the number of threads created in the pool, or the number of threads of the shared
+  // pool in the quota of this pool.  This may be different from the value returned by
+  // DegreeOfParallelism to code using the pool.
   int NumThreads() const;
 
   // Returns current thread id between 0 and NumThreads() - 1, if called from a
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
 
+  // Returns the number of NUMA nodes the pool's threads are spread over, which is 1
+  // unless the pool was created with NUMA information in its ThreadOptions.
+  unsigned NumNumaNodes() const;
+
+  // Returns the NUMA node of the current thread between 0 and NumNumaNodes() - 1, if
+  // called from a thread in the pool. Returns -1 otherwise.
+  int CurrentThreadNumaNode() const;
+
+  // Returns the number of tasks waiting in the queues of the pool's threads.
+  unsigned NumQueuedTasks() const;
+
+  // Returns the spin and wake counters of the pool's threads, summed over the threads.
+  ThreadPoolSpinStats GetSpinStats() const;
+
   // Run fn with up to n degree-of-parallelism enlisting the thread pool for
   // help.  The degree-of-parallelism includes the caller, and so if n==1
   // then the function will run directly in the caller.  The fork-join
@@ -424,10 +527,17 @@ class ThreadPool {
   ExtendedThreadPoolInterface* underlying_threadpool_ = nullptr;
 
   // If used, underlying_threadpool_ is instantiated and owned by the ThreadPool.
-  std::unique_ptr<ThreadPoolTempl<Env> > extended_eigen_threadpool_;
+  std::unique_ptr<ExtendedThreadPoolInterface> extended_eigen_threadpool_;
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Set if the pool runs its work on the threads of another pool, which then
+  // also holds the sum of the weights of its active users.
+  ThreadPool* shared_pool_ = nullptr;
+  ThreadPoolQuota quota_;
+  std::atomic<int> num_active_scopes_{0};
+  std::atomic<int> active_weight_{0};
 };
 
 }  // namespace concurrency
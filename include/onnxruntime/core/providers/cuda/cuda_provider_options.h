@@ -27,4 +27,8 @@ struct OrtCUDAProviderOptionsV2 {
   int cudnn_conv_use_max_workspace;                        // flag specifying if maximum workspace can be used in cudnn conv algo search.
   int enable_cuda_graph;                                   // flag specifying if the CUDA graph is to be captured for the model.
   int cudnn_conv1d_pad_to_nc1d;                            // flag specifying if pad Conv1D's input [N,C,D] to [N,C,1,D] or [N,C,D,1].
+  int enable_pinned_io_staging;                            // flag specifying if copies from/to pageable CPU memory are staged through pinned buffers.
+  int num_compute_streams;                                 // number of CUDA streams independent branches of the graph are spread over.
+  int use_mem_pool;                                        // flag specifying if device memory comes from the CUDA memory pool instead of the BFC Arena.
+  size_t mem_pool_release_threshold;                       // bytes the CUDA memory pool keeps when the stream synchronizes.
 };
@@ -29,4 +29,11 @@ struct OrtTensorRTProviderOptionsV2 {
   int trt_engine_decryption_enable;             // enable engine decryption. Default 0 = false, nonzero = true
   const char* trt_engine_decryption_lib_path;   // specify engine decryption library path
   int trt_force_sequential_engine_build;        // force building TensorRT engine sequentially. Default 0 = false, nonzero = true
+  int trt_timing_cache_enable;                  // enable the persisted TensorRT timing cache. Default 0 = false, nonzero = true
+  int trt_engine_build_async;                   // build engines in the background while CUDA EP runs the nodes. Default 0 = false, nonzero = true
+  const char* trt_profile_min_shapes;           // minimum shapes of dynamic inputs, e.g. "input1:1x3x224x224,input2:1x128"
+  const char* trt_profile_max_shapes;           // maximum shapes of dynamic inputs
+  const char* trt_profile_opt_shapes;           // optimal shapes of dynamic inputs
+  int trt_int8_calibration_enable;              // run in FP32 and write the activation ranges to the INT8 calibration table. Default 0 = false, nonzero = true
+  const char* trt_layer_precisions;             // per-layer precision constraints, e.g. "Conv_12:fp32,MatMul_40:fp16"
 };
@@ -10,6 +10,7 @@
 #include "core/platform/threadpool.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights_container.h"
 
 struct OrtThreadingOptions;
 namespace onnxruntime {
@@ -79,6 +80,14 @@ class Environment {
    */
   Status UnregisterAllocator(const OrtMemoryInfo& mem_info);
 
+  /**
+   * Returns the container used by default to share the pre-packed weights of constant initializers between the
+   * sessions created in this env. A pre-packed weight is freed once the last session using it is destroyed.
+   */
+  PrepackedWeightsContainer& GetPrepackedWeightsContainer() const {
+    return *prepacked_weights_container_;
+  }
+
   Environment() = default;
 
  private:
@@ -92,5 +101,7 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
   std::vector<AllocatorPtr> shared_allocators_;
+  std::unique_ptr<PrepackedWeightsContainer> prepacked_weights_container_ =
+      std::make_unique<PrepackedWeightsContainer>(/*cache_all_constant_initializers*/ true);
 };
 }  // namespace onnxruntime
@@ -281,6 +281,31 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+/** \brief Callback invoked by OrtApi::RunAsync when a run has completed
+*
+* \param[in] user_data The `user_data` passed to OrtApi::RunAsync.
+* \param[in] outputs The `output` array passed to OrtApi::RunAsync. On success it holds the outputs of the run.
+* \param[in] num_outputs Number of entries in `outputs`.
+* \param[in] status nullptr on success, otherwise the error of the run. It is owned by onnxruntime and released once
+*                   the callback returns.
+*/
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                               OrtStatusPtr status);
+
+/** \brief Work function of OrtApi::KernelContext_ParallelFor
+*
+* \param[in] user_data The `user_data` passed to OrtApi::KernelContext_ParallelFor.
+* \param[in] begin First iteration of the batch.
+* \param[in] end One past the last iteration of the batch.
+*/
+typedef void(ORT_API_CALL* OrtParallelForFn)(void* user_data, size_t begin, size_t end);
+
+/** \brief A tensor in the DLPack format, see https://github.com/dmlc/dlpack
+*
+* Only declared here so that the API doesn't depend on dlpack.h. Include dlpack.h to access its members.
+*/
+struct DLManagedTensor;
+
 /** \brief Graph optimization level
 *
 * Refer to https://www.onnxruntime.ai/docs/resources/graph-optimizations.html
@@ -1681,6 +1706,8 @@ struct OrtApi {
 
   /** \brief Used for custom operators, get an input of a kernel
   *
+  * Does not allocate: the returned ::OrtValue is owned by the session and valid for the duration of the compute call.
+  *
   * \see ::OrtCustomOp
   */
   ORT_API2_STATUS(KernelContext_GetInput, _In_ const OrtKernelContext* context, _In_ size_t index,
@@ -1688,6 +1715,9 @@ struct OrtApi {
 
   /** \brief Used for custom operators, get an output of a kernel
   *
+  * The first call for an output allocates it with the given shape, usually from the buffer the memory planner reserved
+  * for it. Later calls for the same output don't allocate and return the same ::OrtValue.
+  *
   * \see ::OrtCustomOp
   */
   ORT_API2_STATUS(KernelContext_GetOutput, _Inout_ OrtKernelContext* context, _In_ size_t index,
@@ -2610,6 +2640,23 @@ struct OrtApi {
   *  Only relevant if arena strategy is `kNextPowerOfTwo`. Use -1 to allow ORT to choose the default.
   *  Ultimately, the allocation size is determined by the allocation memory request.
   *  Further allocation sizes are governed by the arena extend strategy.
+  * "small_alloc_cache_strategy": 0 = kNone, 1 = kPerThreadCache.
+  *  With kPerThreadCache, allocations of up to 4KB are served from per-thread slab caches in front of the
+  *  arena so they do not contend on the arena lock. Use -1 to allow ORT to choose the default (kNone).
+  * "small_alloc_cache_bytes": Size of the region reserved for the small allocation cache.
+  *  Only relevant if the small allocation cache strategy is `kPerThreadCache`. Use -1 to allow ORT to choose
+  *  the default (16MB).
+  * "numa_node": NUMA node to place the memory of the arena on. Only relevant for CPU memory. Pages that are
+  *  already resident are migrated to the node. Use -1 to leave placement to the operating system, which puts
+  *  each page on the node of the thread that first touches it. Default is -1.
+  * "idle_shrink_ms": Once no memory of the arena is in use, return the unused regions to the device after this
+  *  many milliseconds without allocations, so memory is released between bursts of requests. 0 shrinks the arena
+  *  as soon as its memory is no longer in use. Use -1 to disable. Default is -1.
+  * "shrink_high_water_bytes": While the arena holds more than this many bytes, return a region to the device as
+  *  soon as none of its memory is in use. Use 0 to disable. Default is 0.
+  * "use_huge_pages": 1 = ask the operating system to back the regions of the arena with transparent huge pages,
+  *  which reduces TLB misses when large weights are read, e.g. by GEMM. Only relevant for CPU memory on Linux,
+  *  where regions are then grown in multiples of 2MB. Use 0 or -1 to disable. Default is -1.
   *
   * \param[in] arena_config_keys Keys to configure the arena
   * \param[in] arena_config_values Values to configure the arena
@@ -3303,6 +3350,249 @@ struct OrtApi {
   */
   ORT_API2_STATUS(SessionOptionsAppendExecutionProvider_MIGraphX,
                   _In_ OrtSessionOptions* options, _In_ const OrtMIGraphXProviderOptions* migraphx_options);
+
+  /** \brief Set global work queue implementation
+  *
+  * This will configure the global thread pool options to be used in the call to OrtApi::CreateEnvWithGlobalThreadPools.
+  * Selects the lock-free implementation of the per-thread work queues. This reduces contention when many threads
+  * submit work to the thread pools at the same time, for example with ExecutionMode::ORT_PARALLEL.
+  * This will set the value for both inter_op and intra_op threadpools.
+  *
+  * \param[in] tp_options
+  * \param[in] use_lock_free_queues Valid values are 0 or 1.<br>
+  *   0 = Use the default work queues<br>
+  *   1 = Use the lock-free work queues
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SetGlobalLockFreeQueues, _Inout_ OrtThreadingOptions* tp_options, int use_lock_free_queues);
+
+  /** \brief Set global NUMA awareness of the intra op thread pool
+  *
+  * This will configure the global thread pool options to be used in the call to OrtApi::CreateEnvWithGlobalThreadPools.
+  * Groups the intra op threads by NUMA node. Idle threads steal work from their own node first and parallel loops
+  * give each node a contiguous part of the iteration space. If no affinity was set, the threads are bound to
+  * processors spread evenly across the nodes. Has no effect on machines with a single NUMA node.
+  *
+  * \param[in] tp_options
+  * \param[in] numa_aware Valid values are 0 or 1.<br>
+  *   0 = Threads are not grouped by NUMA node<br>
+  *   1 = Threads are grouped by NUMA node
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SetGlobalNumaAware, _Inout_ OrtThreadingOptions* tp_options, int numa_aware);
+
+  /** \brief Get the metrics of the runs of a session
+  *
+  * Metrics are enabled by setting the session config entry "session.metrics_sampling_interval" to N > 0, see
+  * onnxruntime_session_options_config_keys.h. One in N runs is timed. The metrics can be read at any time, also while
+  * the session is running.
+  *
+  * The metrics are returned as a JSON object with the number of runs, latency histograms of the sampled runs and of
+  * each op type and node of the main graph, the memory usage of the allocators of the session and the number of
+  * tasks queued in the session thread pools. Bucket 0 of a histogram counts latencies below 1 microsecond and bucket
+  * i > 0 counts latencies in [2^(i-1), 2^i) microseconds.
+  *
+  * \param[in] sess
+  * \param[in] allocator Allocator used to allocate the returned string.
+  * \param[out] out Null terminated JSON string. Must be freed with `allocator`.
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SessionGetMetrics, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Run the model asynchronously
+  *
+  * Same as OrtApi::Run, except that the call returns as soon as the run is scheduled and the model runs on a thread
+  * of the session's intra op thread pool. `run_async_callback` is invoked on that thread when the outputs are ready
+  * or the run failed. This allows many runs to be in flight without a caller thread blocked on each of them.
+  *
+  * The intra op thread pool must have at least one thread besides the caller, i.e. the number of intra op threads
+  * must be 0 (the default) or more than 1. Releasing the session waits for the outstanding asynchronous runs to
+  * complete, so it must not be released from within the callback.
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, default run options are used. Otherwise it must stay valid until the callback
+  *   is invoked, and setting it to terminate with OrtApi::RunOptionsSetTerminate cancels the run.
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names. Copied by the call.
+  * \param[in] input Array of ::OrtValue%s of the input values. The values are referenced by the run, the caller
+  *   may release its ::OrtValue%s once the call returns but must not modify their data before the callback.
+  * \param[in] input_len Number of elements in the input_names and inputs arrays
+  * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names. Copied by the call.
+  * \param[in] output_names_len Number of elements in the output_names and outputs array
+  * \param[out] output Array of ::OrtValue%s that the outputs are stored in, passed back to the callback. It must
+  *   stay valid until the callback is invoked. As with OrtApi::Run, entries that are nullptr are filled in with
+  *   newly created ::OrtValue%s that must be freed with OrtApi::ReleaseValue.
+  * \param[in] run_async_callback Callback invoked when the run has completed.
+  * \param[in] user_data Passed to `run_async_callback`.
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * The returned status only reports errors detected before the run is scheduled. Errors of the run itself are
+  * passed to the callback.
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /** \brief Create a tensor from a DLPack tensor without copying its data
+  *
+  * The tensor uses the memory of `dlpack_tensor`, which may be on the CPU or on a CUDA device. The ::OrtValue takes
+  * ownership of `dlpack_tensor` and calls its deleter when it is released, so the producer of `dlpack_tensor` must
+  * not call the deleter itself after this call succeeded. If the call fails the ownership stays with the caller.
+  *
+  * Only contiguous (row major) tensors are supported.
+  *
+  * \param[in] dlpack_tensor
+  * \param[in] is_bool_tensor DLPack describes bool and uint8 tensors the same way. Set to 1 to create a bool tensor
+  *   and to 0 otherwise.
+  * \param[out] out Must be freed with OrtApi::ReleaseValue
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * Returns an error if this build was configured without DLPack support.
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(CreateTensorFromDLPack, _Inout_ struct DLManagedTensor* dlpack_tensor, int is_bool_tensor,
+                  _Outptr_ OrtValue** out);
+
+  /** \brief Get a DLPack tensor that shares the data of a tensor
+  *
+  * The DLPack tensor holds a reference to the tensor so `value` may be released before the DLPack tensor. The
+  * consumer of the DLPack tensor must call its `deleter` once it is done with it.
+  *
+  * \param[in] value A tensor
+  * \param[out] out
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * Returns an error if this build was configured without DLPack support.
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(GetDLPackFromValue, _In_ const OrtValue* value, _Outptr_ struct DLManagedTensor** out);
+
+  /** \brief Set global adaptive spinning of the thread pools
+  *
+  * This will configure the global thread pool options to be used in the call to OrtApi::CreateEnvWithGlobalThreadPools.
+  * Instead of spinning for a fixed number of iterations when they run out of work, the threads spin for a duration
+  * that follows a moving average of how long they wait for work, and block right away if the waits are too long for
+  * spinning to help. Has no effect if spinning is disabled with OrtApi::SetGlobalSpinControl.
+  *
+  * \param[in] tp_options
+  * \param[in] adaptive_spinning Valid values are 0 or 1.<br>
+  *   0 = Threads spin for a fixed number of iterations<br>
+  *   1 = Threads spin for an adaptive duration
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SetGlobalAdaptiveSpinning, _Inout_ OrtThreadingOptions* tp_options, int adaptive_spinning);
+
+  /** \brief Write the profile data captured so far and return its filename, without ending profiling
+  *
+  * Profiling is turned on through OrtApi::EnableProfiling. The data is written to a new file next to the profile
+  * file each time. Meant for sessions which keep profiling on in the ring buffer mode enabled by the
+  * "session.profiling_ring_buffer_events" session config entry, to capture the last events after a slow run.
+  *
+  * \param[in] session
+  * \param[in] allocator
+  * \param[out] out Null terminated string of the filename, allocated using `allocator`. Must be freed using `allocator`.
+  *   Empty if profiling is not enabled.
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SessionDumpProfiling, _In_ OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Run the model for several independent requests in one call
+  *
+  * The requests have the same input and output names. The requests run concurrently on the intra op thread pool of the
+  * session. If the "session.enable_batch_stacking" session config entry is "1" and the model gives all its inputs and
+  * outputs the same symbolic leading dimension, e.g. "batch", the inputs of the requests are instead concatenated
+  * along that dimension, the model runs once and its outputs are split between the requests. This needs the inputs
+  * to be CPU tensors whose other dimensions match across the requests, and no output to be pre-allocated.
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+  * \param[in] inputs Array of num_requests * input_len ::OrtValue%s, the inputs of the first request followed by the
+  *   inputs of the second one and so on
+  * \param[in] input_len Number of elements in the input_names array
+  * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+  * \param[in] output_names_len Number of elements in the output_names array
+  * \param[in] num_requests Number of requests
+  * \param[out] outputs Array of num_requests * output_names_len ::OrtValue%s that the outputs of the requests are
+  *   stored in, laid out like the inputs. As with OrtApi::Run, entries that are nullptr are filled in with newly
+  *   created ::OrtValue%s.
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(RunBatch, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len* num_requests) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  size_t num_requests, _Inout_updates_all_(output_names_len* num_requests) OrtValue** outputs);
+
+  /** \brief Used for custom operators, run a loop on the intra op thread pool of the session
+  *
+  * The `total` iterations are split into `num_batches` contiguous batches and `fn` is called once per batch. Returns
+  * once all the batches are done. Without an intra op thread pool, `fn` is called once for all the iterations.
+  *
+  * \param[in] context ::OrtKernelContext of the compute call
+  * \param[in] fn Function called for each batch
+  * \param[in] total Number of iterations
+  * \param[in] num_batches Number of batches. If 0, the degree of parallelism of the thread pool is used.
+  * \param[in] user_data Passed to `fn`
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \see ::OrtCustomOp
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(KernelContext_ParallelFor, _In_ const OrtKernelContext* context, _In_ OrtParallelForFn fn,
+                  size_t total, size_t num_batches, _In_opt_ void* user_data);
+
+  /** \brief Warm up a session for a set of input shapes
+  *
+  * Runs the model once with zero valued CPU inputs of the given shapes and discards the outputs, so that the first
+  * real runs with these shapes don't pay for the work done on the first run of a shape, e.g. memory pattern planning,
+  * arena growth, algorithm selection of the kernels or graph capture. Call it once per set of shapes to warm up,
+  * e.g. before a service reports that it is ready.
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the names of the inputs to give shapes for.
+  *   The other inputs of the model must have a static shape.
+  * \param[in] input_shapes Array of input_len shapes, one per input name
+  * \param[in] input_shape_lens Array of input_len numbers of dimensions, one per shape
+  * \param[in] input_len Number of elements in the input_names array
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.12.
+  */
+  ORT_API2_STATUS(SessionWarmUp, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const int64_t* const* input_shapes,
+                  _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len);
 };
 
 /*
@@ -3353,6 +3643,23 @@ struct OrtCustomOp {
   // Returns the characteristics of the input & output tensors
   OrtCustomOpInputOutputCharacteristic(ORT_API_CALL* GetInputCharacteristic)(_In_ const struct OrtCustomOp* op, _In_ size_t index);
   OrtCustomOpInputOutputCharacteristic(ORT_API_CALL* GetOutputCharacteristic)(_In_ const struct OrtCustomOp* op, _In_ size_t index);
+
+  // Optional, read since version 12. Called at session creation for each constant initializer input of the kernel so
+  // that it can keep its own packed copy instead of repacking it on every compute call. Set `is_packed` to 1 if the
+  // kernel no longer needs the input, in which case it may be absent in KernelCompute. `tensor` is only valid during
+  // the call. Not called for sessions sharing their prepacked weights through an ::OrtPrepackedWeightsContainer.
+  OrtStatusPtr(ORT_API_CALL* KernelPrePack)(_In_ void* op_kernel, _In_ const OrtValue* tensor, _In_ int input_index,
+                                            _Out_ int* is_packed);
+
+  // Optional, read since version 12. Infers the shape of an output from the shapes of the inputs at model load, so the
+  // output buffers of custom ops can be planned ahead like those of the built-in ops. An entry of `input_shapes` is
+  // nullptr when the shape of the input is unknown, unknown dimensions are -1 with their symbolic names available
+  // through OrtApi::GetSymbolicDimensions. Set the dimensions of `output_shape` with OrtApi::SetDimensions and set
+  // `is_inferred` to 1 when the shape is known.
+  OrtStatusPtr(ORT_API_CALL* InferOutputShape)(_In_ const struct OrtCustomOp* op, _In_ size_t output_index,
+                                               _In_reads_(input_count) const OrtTensorTypeAndShapeInfo* const* input_shapes,
+                                               _In_ size_t input_count, _Inout_ OrtTensorTypeAndShapeInfo* output_shape,
+                                               _Out_ int* is_inferred);
 };
 
 /*
@@ -426,6 +426,34 @@ struct Session : Base<OrtSession> {
 
   void Run(const RunOptions& run_options, const struct IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run the model asynchronously in a thread of the session's intra op thread pool
+  *
+  * Wraps OrtApi::RunAsync. `callback` is invoked with `user_data`, the outputs and the status of the run when it
+  * has completed. `run_options` and `output_values` must stay valid until then. Empty entries of `output_values` are
+  * filled in with the outputs.
+  */
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                size_t input_count, const char* const* output_names, Value* output_values, size_t output_count,
+                RunAsyncCallbackFn callback, void* user_data);
+
+  /** \brief Run the model for several requests at once
+  *
+  * Wraps OrtApi::RunBatch. `input_values` holds the `input_count` inputs of each of the `num_requests` requests one
+  * request after the other, and `output_values` their `output_count` outputs likewise. Empty entries of
+  * `output_values` are filled in with the outputs.
+  */
+  void RunBatch(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                size_t input_count, const char* const* output_names, Value* output_values, size_t output_count,
+                size_t num_requests);
+
+  /** \brief Warm up the session for a set of input shapes
+  *
+  * Wraps OrtApi::SessionWarmUp. `input_shapes` holds the shape of each of the `input_count` inputs named by
+  * `input_names`.
+  */
+  void WarmUp(const RunOptions& run_options, const char* const* input_names,
+              const std::vector<int64_t>* input_shapes, size_t input_count);
+
   size_t GetInputCount() const;                   ///< Returns the number of model inputs
   size_t GetOutputCount() const;                  ///< Returns the number of model outputs
   size_t GetOverridableInitializerCount() const;  ///< Returns the number of inputs that have defaults that can be overridden
@@ -434,6 +462,8 @@ struct Session : Base<OrtSession> {
   char* GetOutputName(size_t index, OrtAllocator* allocator) const;                  ///< Wraps OrtApi::SessionGetOutputName
   char* GetOverridableInitializerName(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
   char* EndProfiling(OrtAllocator* allocator) const;                                 ///< Wraps OrtApi::SessionEndProfiling
+  char* DumpProfiling(OrtAllocator* allocator) const;                                ///< Wraps OrtApi::SessionDumpProfiling
+  char* GetMetrics(OrtAllocator* allocator) const;                                   ///< Wraps OrtApi::SessionGetMetrics
   uint64_t GetProfilingStartTimeNs() const;                                          ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
   ModelMetadata GetModelMetadata() const;                                            ///< Wraps OrtApi::SessionGetModelMetadata
 
@@ -623,6 +653,12 @@ struct Value : Base<OrtValue> {
    */
   static Value CreateTensor(OrtAllocator* allocator, const int64_t* shape, size_t shape_len, ONNXTensorElementDataType type);
 
+  /** \brief Creates a tensor that shares the data of a DLPack tensor. Wraps OrtApi::CreateTensorFromDLPack.
+   * \param dlpack_tensor The DLPack tensor. The returned Value takes ownership of it.
+   * \param is_bool_tensor Create a bool tensor from 8 bit unsigned DLPack data.
+   */
+  static Value CreateTensorFromDLPack(DLManagedTensor* dlpack_tensor, bool is_bool_tensor = false);
+
 #if !defined(DISABLE_SPARSE_TENSORS)
   /// <summary>
   /// This is a simple forwarding method the below CreateSparseTensor.
@@ -744,6 +780,11 @@ struct Value : Base<OrtValue> {
   Value& operator=(Value&&) = default;
 
   bool IsTensor() const;  ///< Returns true if Value is a tensor, false for other types like map/sequence/etc
+
+  /** \brief Returns a DLPack tensor that shares the data of this tensor. Wraps OrtApi::GetDLPackFromValue.
+   * The caller must call the `deleter` of the returned DLPack tensor once it is done with it.
+   */
+  DLManagedTensor* GetDLPack() const;
   bool HasValue() const;  /// < Return true if OrtValue contains data and returns false if the OrtValue is a None
 
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -968,6 +1009,12 @@ struct CustomOpApi {
   size_t KernelContext_GetOutputCount(const OrtKernelContext* context);
   OrtValue* KernelContext_GetOutput(OrtKernelContext* context, _In_ size_t index, _In_ const int64_t* dim_values, size_t dim_count);
   void* KernelContext_GetGPUComputeStream(const OrtKernelContext* context);
+  void KernelContext_ParallelFor(const OrtKernelContext* context, OrtParallelForFn fn, size_t total, size_t num_batches,
+                                 void* user_data);
+
+  /// Runs `fn(begin, end)` for batches of the `total` iterations on the intra op thread pool
+  template <typename F>
+  void KernelContext_ParallelFor(const OrtKernelContext* context, size_t total, size_t num_batches, F& fn);
 
   void ThrowOnError(OrtStatus* result);
 
@@ -1001,6 +1048,10 @@ struct CustomOpBase : OrtCustomOp {
 #endif
     OrtCustomOp::GetInputCharacteristic = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetInputCharacteristic(index); };
     OrtCustomOp::GetOutputCharacteristic = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetOutputCharacteristic(index); };
+
+    // Optional callbacks, an op providing them sets them in its constructor
+    OrtCustomOp::KernelPrePack = nullptr;
+    OrtCustomOp::InferOutputShape = nullptr;
   }
 
   // Default implementation of GetExecutionProviderType that returns nullptr to default to the CPU provider
@@ -582,6 +582,37 @@ inline void Session::Run(const RunOptions& run_options, const IoBinding& io_bind
   ThrowOnError(GetApi().RunWithBinding(p_, run_options, io_binding));
 }
 
+inline void Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                              size_t input_count, const char* const* output_names, Value* output_values,
+                              size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(p_, run_options, input_names, ort_input_values, input_count, output_names,
+                                 output_count, ort_output_values, callback, user_data));
+}
+
+inline void Session::RunBatch(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                              size_t input_count, const char* const* output_names, Value* output_values,
+                              size_t output_count, size_t num_requests) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunBatch(p_, run_options, input_names, ort_input_values, input_count, output_names,
+                                 output_count, num_requests, ort_output_values));
+}
+
+inline void Session::WarmUp(const RunOptions& run_options, const char* const* input_names,
+                            const std::vector<int64_t>* input_shapes, size_t input_count) {
+  std::vector<const int64_t*> shapes(input_count);
+  std::vector<size_t> shape_lens(input_count);
+  for (size_t i = 0; i < input_count; ++i) {
+    shapes[i] = input_shapes[i].data();
+    shape_lens[i] = input_shapes[i].size();
+  }
+  ThrowOnError(GetApi().SessionWarmUp(p_, run_options, input_names, shapes.data(), shape_lens.data(), input_count));
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(GetApi().SessionGetInputCount(p_, &out));
@@ -624,6 +655,18 @@ inline char* Session::EndProfiling(OrtAllocator* allocator) const {
   return out;
 }
 
+inline char* Session::DumpProfiling(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionDumpProfiling(p_, allocator, &out));
+  return out;
+}
+
+inline char* Session::GetMetrics(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionGetMetrics(p_, allocator, &out));
+  return out;
+}
+
 inline uint64_t Session::GetProfilingStartTimeNs() const {
   uint64_t out;
   ThrowOnError(GetApi().SessionGetProfilingStartTimeNs(p_, &out));
@@ -788,6 +831,12 @@ inline Value Value::CreateTensor(const OrtMemoryInfo* info, void* p_data, size_t
   return Value{out};
 }
 
+inline Value Value::CreateTensorFromDLPack(DLManagedTensor* dlpack_tensor, bool is_bool_tensor) {
+  OrtValue* out;
+  ThrowOnError(GetApi().CreateTensorFromDLPack(dlpack_tensor, is_bool_tensor ? 1 : 0, &out));
+  return Value{out};
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 template <typename T>
 inline Value Value::CreateSparseTensor(const OrtMemoryInfo* info, T* p_data, const Shape& dense_shape,
@@ -923,6 +972,12 @@ inline bool Value::IsTensor() const {
   return out != 0;
 }
 
+inline DLManagedTensor* Value::GetDLPack() const {
+  DLManagedTensor* out;
+  ThrowOnError(GetApi().GetDLPackFromValue(p_, &out));
+  return out;
+}
+
 inline bool Value::HasValue() const {
   int out;
   ThrowOnError(GetApi().HasValue(p_, &out));
@@ -1183,6 +1238,19 @@ inline void* CustomOpApi::KernelContext_GetGPUComputeStream(const OrtKernelConte
   return out;
 }
 
+inline void CustomOpApi::KernelContext_ParallelFor(const OrtKernelContext* context, OrtParallelForFn fn, size_t total,
+                                                   size_t num_batches, void* user_data) {
+  ThrowOnError(api_.KernelContext_ParallelFor(context, fn, total, num_batches, user_data));
+}
+
+template <typename F>
+inline void CustomOpApi::KernelContext_ParallelFor(const OrtKernelContext* context, size_t total, size_t num_batches,
+                                                   F& fn) {
+  KernelContext_ParallelFor(
+      context, [](void* user_data, size_t begin, size_t end) { (*static_cast<F*>(user_data))(begin, end); }, total,
+      num_batches, &fn);
+}
+
 inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
   ThrowOnError(GetApi().DisablePerSessionThreads(p_));
   return *this;
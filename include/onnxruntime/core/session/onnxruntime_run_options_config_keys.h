@@ -25,3 +25,11 @@
 // Example usage: "cpu:0;gpu:0" (or) "gpu:0"
 // By default, the value for this key is empty (i.e.) no memory arenas are shrunk
 static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memory.enable_memory_arena_shrinkage";
+
+// Timeout of the run in milliseconds, counted from the start of the Run() call.
+// Once it expires the executors stop before the next node, the control flow kernels (Loop, Scan, BeamSearch, ...)
+// before their next iteration, and the parallel loops of the kernels running stop handing out blocks of
+// iterations, and Run() fails. The kernels check the deadline cooperatively: a kernel in the middle of a
+// computation that doesn't use the intra-op thread pool completes it first.
+// By default, the value for this key is "0" (i.e.) no timeout.
+static const char* const kOrtRunOptionsConfigRunTimeoutMs = "run.timeout_ms";
@@ -61,16 +61,72 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// How the transpose optimizer weighs the Transpose ops it would add or remove when pushing a Transpose through a node.
+// "rank": by the number of dimensions of the transposed values that aren't 1.
+// "size": by the estimated number of elements of the transposed values, so that transposes of large activations are
+// traded for transposes of small tensors.
+// The default is "rank".
+static const char* const kOrtSessionOptionsConfigTransposeOptimizerCostModel = "optimization.transpose_optimizer_cost_model";
+
+// Enable or disable regenerating dropout masks in the backward pass of a training graph. "0": disable; "1": enable.
+// If enabled, Dropout and BiasDropout nodes whose mask is only consumed by DropoutGrad output the seed and offset of
+// the random generator instead of the mask, and DropoutGrad regenerates the mask from them. This saves the memory of
+// keeping every mask alive between the forward and the backward pass at the cost of generating the random numbers
+// twice. Only applies to nodes assigned to the CUDA execution provider in training builds.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigDropoutMaskRecompute = "optimization.dropout_mask_recompute";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Keep the initializers planned to live in CUDA device memory in page-locked host memory instead. "1": enable;
+// "0": disable. The default is "0".
+// The kernels read these weights directly over the bus through unified addressing, which frees the device memory
+// they would take for models that don't otherwise fit, at the cost of the bandwidth of every read of a weight.
+// Initializers stay on the device when the CUDA execution provider has no pinned memory allocator.
+static const char* const kOrtSessionOptionsOffloadInitializersToHostMemory = "session.offload_initializers_to_host_memory";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure whether the per-session inter op and intra op thread pools use lock-free per-thread work queues.
+// "0": the default work queues are used. Pushing work to a queue from a thread other than its owner takes a lock.
+// "1": lock-free work queues are used. This reduces contention when concurrent Run() calls or the parallel
+//      executor submit many tasks at once.
+// Default is "0". Only applies if per-session thread pools are used.
+static const char* const kOrtSessionOptionsConfigUseLockFreeQueues = "session.use_lock_free_thread_pool_queues";
+
+// Configure whether the per-session intra op thread pool is aware of the NUMA topology of the machine.
+// "0": threads are not grouped by NUMA node.
+// "1": threads are grouped by NUMA node. Idle threads steal work from their own node first and parallel loops give
+//      each node a contiguous part of the iteration space. If the affinity is not set explicitly the threads are
+//      bound to processors spread evenly across the nodes.
+// Default is "0". Has no effect on machines with a single NUMA node.
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAware = "session.intra_op.numa_aware";
+
+// Configure whether the per-session intra op thread pool only uses the fastest cores of a hybrid processor, e.g.
+// the P-cores of a processor with P-cores and E-cores, for latency critical sessions.
+// "0": the threads may run on any core. Parallel loops split their work into more blocks on hybrid processors so
+//      that the threads on the faster cores take over the work of the slower ones.
+// "1": the threads are bound to the fastest cores, one per core unless the number of threads is set.
+// Default is "0". Has no effect if the affinity of the threads is set explicitly, or if the cores are all alike.
+// The thread calling Run() also computes part of the parallel loops and isn't bound by this option.
+static const char* const kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly = "session.intra_op.performance_cores_only";
+
+// Configure whether the pre-packed weights of constant initializers are shared with other sessions in the same env.
+// "0": sessions without a PrepackedWeightsContainer of their own look up and store the pre-packed weights of the
+//      constant initializers of CPU nodes in a container owned by the env. Pre-packed weights with the same content
+//      for the same kernel are only kept once, so several sessions of one model share them. A pre-packed weight is
+//      freed once the last session using it is destroyed.
+// "1": each session keeps its own pre-packed weights.
+// Default is "0". Has no effect if prepacking is disabled.
+static const char* const kOrtSessionOptionsConfigDisableEnvPrepackedWeightsSharing =
+    "session.disable_env_prepacked_weights_sharing";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -79,6 +135,29 @@ static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session
 // has to guarantee that the model bytes are valid until the ORT session using the model bytes is destroyed.
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "session.use_ort_model_bytes_directly";
 
+// Key for using the ORT format model bytes for the initializers instead of copying them.
+// Setting this option to "1" makes the initializers refer to the model bytes in place. A model loaded from a file is
+// mapped into memory, so the pages of an initializer are only read from the file when it is first used, and the
+// mapping is kept until the session is destroyed. A model loaded from a byte array must also set
+// "session.use_ort_model_bytes_directly" to "1", or the copy of the bytes is kept instead, and the caller has to
+// guarantee that the bytes are valid until the session is destroyed.
+// Only initializers of 128 bytes or more that are aligned in the model bytes are used in place. Models saved by
+// older versions of ORT may not have their initializers aligned.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
+    "session.use_ort_model_bytes_for_initializers";
+
+// Key for saving the pre-packed weights of the kernels when saving an ORT format model.
+// If the config value is set to "1", the buffers created by the kernels that support it when pre-packing a constant
+// initializer are saved in the ORT format model. When the model is loaded, a kernel uses them instead of packing the
+// initializer again, unless they were packed for a different format, e.g. for another ISA, in which case the
+// initializer is packed again. Saved pre-packed weights are not used if the pre-packed weights are shared between
+// sessions with a PrepackedWeightsContainer.
+// This grows the model by the size of the pre-packed weights, as the initializers are still saved.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigSavePrePackedWeightsInOrtFormat =
+    "session.save_prepacked_weights_in_ort_format";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -94,6 +173,153 @@ static const char* const kOrtSessionOptionsQDQIsInt8Allowed = "session.qdqisint8
 static const char* const kOrtSessionOptionsConfigMinimalBuildOptimizations =
     "optimization.minimal_build_optimizations";
 
+// Directory used to cache the optimized form of the model between sessions.
+// When set, the first session for a given model, set of execution providers and session options saves the model
+// after graph optimization and partitioning in ORT format to this directory. Later sessions with the same
+// configuration load the cached model and skip the optimizers. The directory must exist.
+// The cache is only used for ONNX models loaded from a file path or a byte array, and is not written if an execution
+// provider compiles nodes or the session has custom ops or graph transformers.
+// Default is "" (disabled).
+static const char* const kOrtSessionOptionsConfigSessionCacheDir = "session.cache_dir";
+
+// Configure whether CPU initializers with external data refer directly to a memory mapping of the external data file.
+// "0": the data is copied into memory owned by the session.
+// "1": the data is memory mapped and used in place for the lifetime of the session. The mapping is shared with the
+//      page cache, so several sessions or processes using the same file share one copy of the weights.
+//      Only initializers whose data starts at an offset that is a multiple of 4096 bytes can be mapped; others are
+//      copied. tools/python/align_external_data.py saves a model with suitably aligned external data.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigUseMmapForExternalInitializers =
+    "session.use_mmap_for_external_initializers";
+
+// Enables always-on metrics of the runs of the session, read via OrtApi::SessionGetMetrics.
+// The value is the sampling interval N: one in N runs records the latency of the run and of each node of the main
+// graph into histograms, per node and per op type. Other runs are only counted, so a large N keeps the overhead low.
+// Default is "0" (disabled).
+static const char* const kOrtSessionOptionsConfigMetricsSamplingInterval = "session.metrics_sampling_interval";
+
+// Enables a cache of captured CUDA graphs keyed by the shapes of the feeds, for sessions with the CUDA EP option
+// enable_cuda_graph. The value is the maximum number of feed shapes with a captured graph.
+// The graph for a set of feed shapes is captured automatically on the first run with those shapes and replayed by the
+// following ones. The feeds and fetches are copied through staging buffers owned by the session, so they don't need
+// to be bound to fixed addresses with IOBinding. Runs with other feed shapes once the cache is full are not captured.
+// Models with dynamic shapes should pad their feeds to a few bucket sizes, so that a few graphs serve all the runs.
+// Default is "0": a single graph is captured and replayed with the addresses bound by IOBinding.
+static const char* const kOrtSessionOptionsConfigGraphCaptureShapeCacheSize = "session.graph_capture_shape_cache_size";
+
+// Configure whether memory patterns are cached per bucket of input shapes rather than per exact input shapes.
+// "0": a memory pattern is only reused by runs with the same input shapes.
+// "1": the input dimensions are rounded up to powers of two and the runs in a bucket share one memory pattern, sized
+//      for the largest run seen in the bucket, so that inputs of varying sequence length get a single block allocation.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigMemoryPatternShapeBuckets = "session.memory_pattern_shape_buckets";
+
+// Maximum number of memory patterns cached per graph, evicting the least recently used one.
+// Default is "0" (no limit).
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Configure how the offsets of the blocks of a memory pattern are assigned.
+// "0": each block is placed at the best fitting free offset when it is allocated during the traced run.
+// "1": once the run is traced, the blocks are placed again from their lifetimes, largest block first, and the
+//      placement with the smaller peak size is used.
+// The peak size and its lower bound, the largest total size of the blocks in use at once, are logged at the
+// verbose level. Default is "0".
+static const char* const kOrtSessionOptionsConfigOfflineMemoryPatternPlanner = "session.offline_memory_pattern_planner";
+
+// Configure whether the shapes of the tensors are frozen for fixed-shape serving.
+// "0": the kernels compute the shapes of their outputs on every run.
+// "1": if shape inference gives a static shape to every tensor of the graph, the kernels are prepared for these
+//      shapes once (OpKernel::PrepareForShapes) so they can skip computing and validating them on every run, and the
+//      memory patterns are planned from the shapes instead of being traced by the first run. The inputs must be fed
+//      with the shapes of the model inputs. If some shape is not static, the session runs as with "0".
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigFreezeShapes = "session.freeze_shapes";
+
+// Set to "1" to let RunBatch concatenate the feeds of its requests along their batch dimension and run the model
+// once for all of them. The batch dimension is the symbolic leading dimension, e.g. "batch", that the model gives all
+// its inputs and outputs, and is looked up once when the session is initialized. Only enable this for models whose
+// leading dimension indexes independent samples.
+// "0": RunBatch runs the requests separately and concurrently.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigEnableBatchStacking = "session.enable_batch_stacking";
+
+// Configure whether graph optimizations use the thread pool of the session during initialization.
+// "0": the graph transformers are applied serially.
+// "1": each graph transformer is applied to the subgraphs of the control flow nodes of the main graph (If/Loop/Scan)
+//      concurrently, before the main graph, and constant folding computes the nodes that only depend on initializers
+//      concurrently. The inter-op thread pool is used if the session has one, otherwise the intra-op thread pool.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigParallelGraphOptimization = "session.parallel_graph_optimization";
+
+// Configure whether the kernels are created and pre-packed using the intra-op thread pool of the session.
+// "0": the kernels are created and pre-pack their constant initializers serially.
+// "1": the kernels of the nodes are constructed concurrently. Their constant initializers are also pre-packed
+//      concurrently, unless pre-packed weights are shared between sessions or saved to or loaded from an ORT format
+//      model. The kernels of all the execution providers of the session must support being constructed concurrently.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigParallelKernelCreation = "session.parallel_kernel_creation";
+
+// Tensor-parallel inference: shard the MatMul/Attention layers of a transformer model Megatron-style over the ranks of
+// a tensor-parallel group, one session per rank and GPU. The value is the number of ranks; the rank of the session
+// is set with kOrtSessionOptionsConfigTensorParallelRank. The first MatMul of each MLP block and the Attention nodes
+// keep 1/size of the columns (heads) of their weights, the second MatMul of the MLP block and the projection after
+// the attention keep 1/size of the rows, followed by an AllReduce of the partial results. Requires a build with
+// tensor-parallel support and the CUDA EP; the ranks are the MPI ranks of the job.
+// Default is "1" (disabled).
+static const char* const kOrtSessionOptionsConfigTensorParallelSize = "session.tensor_parallel_size";
+
+// Rank of the session in the tensor-parallel group, from 0 to kOrtSessionOptionsConfigTensorParallelSize - 1.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigTensorParallelRank = "session.tensor_parallel_rank";
+
+// Quota of the session in the intra-op thread pool of the environment, for sessions using the global thread pools
+// (DisablePerSessionThreads). Limits how much a session's parallel loops take from the sessions sharing the pool.
+// "session.global_intra_op.max_threads": maximum number of pool threads a parallel loop of the session runs on,
+//     besides the thread running the session. Default is "0" (no limit).
+// "session.global_intra_op.weight": weight of the session in the fair sharing of the pool. While sessions with a
+//     weight are running concurrently, the threads are divided between them in proportion to their weights.
+//     Default is "0" (the session takes no part in the fair sharing).
+static const char* const kOrtSessionOptionsConfigGlobalIntraOpMaxThreads = "session.global_intra_op.max_threads";
+static const char* const kOrtSessionOptionsConfigGlobalIntraOpWeight = "session.global_intra_op.weight";
+
+// Path of the kernel tuning database file. When set, kernels with several implementations of an operation (for
+// example the CPU Conv, which can run through MLAS or through im2col and a GEMM) benchmark them the first time they
+// run a shape and keep using the fastest one. The results are keyed by the machine's processor and the shapes, are
+// loaded from the file when the session is initialized and are written back to it when the session is released, so
+// later sessions on the same machine reuse them. The file may be shared between machines.
+// The CUDA Conv also records the cuDNN algorithms found by the exhaustive search (cudnn_conv_algo_search EXHAUSTIVE)
+// there, keyed by the GPU model and the cuDNN version, so the search runs once per convolution instead of once per
+// session.
+// Default is "" (no tuning).
+static const char* const kOrtSessionOptionsConfigKernelTuningFile = "session.kernel_tuning_file";
+
+// Memory budget of the session in bytes. A run fails as soon as allocating a tensor would take the memory in use in
+// an allocator of the session above the budget, instead of growing until the device runs out of memory. The memory in
+// use is reported by the arena allocators, so the budget is not enforced for the devices of EPs created without an
+// arena, and it also counts the memory of other sessions when the arena is shared through the environment.
+// Combine it with the "idle_shrink_ms" and "shrink_high_water_bytes" arena options to also limit the memory the
+// arena keeps from the device once a run completes.
+// Default is "0" (no budget).
+static const char* const kOrtSessionOptionsConfigMemoryBudgetBytes = "session.memory_budget_bytes";
+
+// Number of events kept by the profiler of the session in ring buffer mode. Once the profiler is full the oldest
+// events are overwritten, so profiling can stay on in production and the last events can be written to a file on
+// demand with OrtApi::SessionDumpProfiling, e.g. after a latency spike. The runs also record the work items their
+// parallel loops run on each thread of the intra-op thread pool and their arena allocations in this mode.
+// Only applies when profiling is enabled (OrtApi::EnableProfiling).
+// Default is "0" (events are kept up to the profiler's maximum, newer events are dropped).
+static const char* const kOrtSessionOptionsConfigProfilingRingBufferEvents = "session.profiling_ring_buffer_events";
+
+// Counts hardware events of each node when profiling is enabled, and adds them to the "_kernel_time" events of the
+// profile as a "hardware_counters" object: cycles, instructions and last level cache misses, user space only. The
+// counts include the threads of the intra-op thread pool while they run the node's parallel loops. A low
+// instructions / cycles ratio with many cache misses per instruction points to a memory-bound node, and the cache
+// misses times the cache line size approximate the memory traffic of the node.
+// Only available on Linux, through perf_event_open, which perf_event_paranoid must allow for user space events
+// (at most 2). The value is an empty string when the counters are not available.
+// "0": disabled. "1": enabled. Default is "0".
+static const char* const kOrtSessionOptionsConfigProfilingHardwareCounters = "session.profiling_hardware_counters";
+
 // Note: The options specific to an EP should be specified prior to appending that EP to the session options object in
 // order for them to take effect.
 
@@ -104,6 +330,19 @@ static const char* const kOrtSessionOptionsConfigMinimalBuildOptimizations =
 // exclusion, set the value to "".
 static const char* const kOrtSessionOptionsConfigNnapiEpPartitioningStopOps = "ep.nnapi.partitioning_stop_ops";
 
+// Specifies a directory in which NNAPI caches the compiled models of the NNAPI EP, so that creating a session for the
+// same model again does not recompile it. The directory must exist and be private to the application, e.g. the
+// code_cache directory provided by the Android runtime.
+// The cache entries are keyed by a hash of the NNAPI model built for each partition, including its weights.
+// This is only available on Android API level 29+. If not specified, compiled models are not cached.
+static const char* const kOrtSessionOptionsConfigNnapiEpCompilationCacheDir = "ep.nnapi.compilation_cache_dir";
+
+// Specifies a directory in which the CoreML EP keeps the compiled CoreML models (.mlmodelc), so that creating a
+// session for the same model again loads the compiled model instead of compiling it. The directory must exist.
+// The cache entries are keyed by a hash of the CoreML model built for each partition, including its weights.
+// If not specified, compiled models are not cached.
+static const char* const kOrtSessionOptionsConfigCoreMLEpCompiledModelCacheDir = "ep.coreml.compiled_model_cache_dir";
+
 // Enabling dynamic block-sizing for multithreading.
 // With a positive value, thread pool will split a task of N iterations to blocks of size starting from:
 // N / (num_of_threads * dynamic_block_base)
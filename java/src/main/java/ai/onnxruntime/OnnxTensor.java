@@ -13,6 +13,7 @@ import java.nio.FloatBuffer;
 import java.nio.IntBuffer;
 import java.nio.LongBuffer;
 import java.nio.ShortBuffer;
+import java.util.Optional;
 
 /**
  * A Java object wrapping an OnnxTensor. Tensors are the main input to the library, and can also be
@@ -127,6 +128,20 @@ public class OnnxTensor implements OnnxValue {
     close(OnnxRuntime.ortApiHandle, nativeHandle);
   }
 
+  /**
+   * Returns the direct buffer backing this OnnxTensor, if it was created from a Java nio buffer.
+   *
+   * <p>The native tensor reads from and writes to this buffer's memory, so it can be refilled in
+   * place before the next {@link OrtSession#run} call instead of creating a new tensor, and outputs
+   * written into a pinned tensor can be read from it without a copy. The buffer is shared with the
+   * tensor, it must not be used after the tensor is closed.
+   *
+   * @return The backing buffer, or empty if the tensor's memory is owned by native code.
+   */
+  public Optional<Buffer> getBufferRef() {
+    return Optional.ofNullable(buffer);
+  }
+
   /**
    * Returns a copy of the underlying OnnxTensor as a ByteBuffer.
    *
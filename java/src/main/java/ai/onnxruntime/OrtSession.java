@@ -254,10 +254,9 @@ public class OrtSession implements AutoCloseable {
       Map<String, OnnxTensor> inputs, Set<String> requestedOutputs, RunOptions runOptions)
       throws OrtException {
     if (!closed) {
-      if (inputs.isEmpty() || (inputs.size() > numInputs)) {
-        throw new OrtException(
-            "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
-      }
+      String[] inputNamesArray = new String[inputs.size()];
+      long[] inputHandles = new long[inputs.size()];
+      collectInputs(inputs, inputNamesArray, inputHandles);
       if (requestedOutputs.isEmpty() || (requestedOutputs.size() > numOutputs)) {
         throw new OrtException(
             "Unexpected number of requestedOutputs, expected [1,"
@@ -265,29 +264,12 @@ public class OrtSession implements AutoCloseable {
                 + ") found "
                 + requestedOutputs.size());
       }
-      String[] inputNamesArray = new String[inputs.size()];
-      long[] inputHandles = new long[inputs.size()];
-      int i = 0;
-      for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
-        if (inputNames.contains(t.getKey())) {
-          inputNamesArray[i] = t.getKey();
-          inputHandles[i] = t.getValue().getNativeHandle();
-          i++;
-        } else {
-          throw new OrtException(
-              "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
-        }
-      }
       String[] outputNamesArray = new String[requestedOutputs.size()];
-      i = 0;
+      int i = 0;
       for (String s : requestedOutputs) {
-        if (outputNames.contains(s)) {
-          outputNamesArray[i] = s;
-          i++;
-        } else {
-          throw new OrtException(
-              "Unknown output name " + s + ", expected one of " + outputNames.toString());
-        }
+        checkOutputName(s);
+        outputNamesArray[i] = s;
+        i++;
       }
       long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
 
@@ -301,6 +283,7 @@ public class OrtSession implements AutoCloseable {
               inputNamesArray.length,
               outputNamesArray,
               outputNamesArray.length,
+              null,
               runOptionsHandle);
       return new Result(outputNamesArray, outputValues);
     } else {
@@ -308,6 +291,114 @@ public class OrtSession implements AutoCloseable {
     }
   }
 
+  /**
+   * Scores an input feed dict, writing the requested outputs into the supplied tensors.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The output tensors to write into, keyed by output name.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   * @see #run(Map, Map, RunOptions)
+   */
+  public void run(Map<String, OnnxTensor> inputs, Map<String, OnnxTensor> pinnedOutputs)
+      throws OrtException {
+    run(inputs, pinnedOutputs, null);
+  }
+
+  /**
+   * Scores an input feed dict, writing the requested outputs into the supplied tensors.
+   *
+   * <p>The output tensors must be numeric, have the shape the model produces, and should be
+   * created from direct buffers (e.g. {@link OnnxTensor#createTensor(OrtEnvironment,
+   * java.nio.FloatBuffer, long[])}) so the results can be read back through {@link
+   * OnnxTensor#getBufferRef()} without a copy. Together with input tensors refilled in place this
+   * allows the same tensors to be reused across calls without allocating new {@link OnnxValue}s.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The output tensors to write into, keyed by output name.
+   * @param runOptions The RunOptions to control this run.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public void run(
+      Map<String, OnnxTensor> inputs, Map<String, OnnxTensor> pinnedOutputs, RunOptions runOptions)
+      throws OrtException {
+    if (!closed) {
+      String[] inputNamesArray = new String[inputs.size()];
+      long[] inputHandles = new long[inputs.size()];
+      collectInputs(inputs, inputNamesArray, inputHandles);
+      if (pinnedOutputs.isEmpty() || (pinnedOutputs.size() > numOutputs)) {
+        throw new OrtException(
+            "Unexpected number of pinnedOutputs, expected [1,"
+                + numOutputs
+                + ") found "
+                + pinnedOutputs.size());
+      }
+      String[] outputNamesArray = new String[pinnedOutputs.size()];
+      long[] outputHandles = new long[pinnedOutputs.size()];
+      int i = 0;
+      for (Map.Entry<String, OnnxTensor> t : pinnedOutputs.entrySet()) {
+        checkOutputName(t.getKey());
+        if (t.getValue().getInfo().type == OnnxJavaType.STRING) {
+          throw new OrtException("Pinned output " + t.getKey() + " cannot be a String tensor");
+        }
+        outputNamesArray[i] = t.getKey();
+        outputHandles[i] = t.getValue().getNativeHandle();
+        i++;
+      }
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+
+      run(
+          OnnxRuntime.ortApiHandle,
+          nativeHandle,
+          allocator.handle,
+          inputNamesArray,
+          inputHandles,
+          inputNamesArray.length,
+          outputNamesArray,
+          outputNamesArray.length,
+          outputHandles,
+          runOptionsHandle);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Validates the input feed dict and unpacks it into the name and native handle arrays.
+   *
+   * @param inputs The inputs to score.
+   * @param inputNamesArray The array to write the input names into.
+   * @param inputHandles The array to write the input tensor handles into.
+   * @throws OrtException If there are zero or too many inputs, or an input name is invalid.
+   */
+  private void collectInputs(
+      Map<String, OnnxTensor> inputs, String[] inputNamesArray, long[] inputHandles)
+      throws OrtException {
+    if (inputs.isEmpty() || (inputs.size() > numInputs)) {
+      throw new OrtException(
+          "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
+    }
+    int i = 0;
+    for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
+      if (inputNames.contains(t.getKey())) {
+        inputNamesArray[i] = t.getKey();
+        inputHandles[i] = t.getValue().getNativeHandle();
+        i++;
+      } else {
+        throw new OrtException(
+            "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
+      }
+    }
+  }
+
+  private void checkOutputName(String name) throws OrtException {
+    if (!outputNames.contains(name)) {
+      throw new OrtException(
+          "Unknown output name " + name + ", expected one of " + outputNames.toString());
+    }
+  }
+
   /**
    * Gets the metadata for the currently loaded model.
    *
@@ -414,8 +505,10 @@ public class OrtSession implements AutoCloseable {
    * @param numInputs The number of inputs.
    * @param outputNamesArray The requested output names.
    * @param numOutputs The number of requested outputs.
+   * @param outputs The (possibly null) preallocated output tensors. If supplied the outputs are
+   *     written into them and the returned array is null.
    * @param runOptionsHandle The (possibly null) pointer to the run options.
-   * @return The OnnxValues produced by this run.
+   * @return The OnnxValues produced by this run, or null if the outputs were preallocated.
    * @throws OrtException If the native call failed in some way.
    */
   private native OnnxValue[] run(
@@ -427,6 +520,7 @@ public class OrtSession implements AutoCloseable {
       long numInputs,
       String[] outputNamesArray,
       long numOutputs,
+      long[] outputs,
       long runOptionsHandle)
       throws OrtException;
 
@@ -239,11 +239,11 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_getOutputInfo
 /*
  * Class:     ai_onnxruntime_OrtSession
  * Method:    run
- * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;JJ)[Lai/onnxruntime/OnnxValue;
- * private native OnnxValue[] run(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs)
+ * Signature: (JJJ[Ljava/lang/String;[JJ[Ljava/lang/String;J[JJ)[Lai/onnxruntime/OnnxValue;
+ * private native OnnxValue[] run(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs, long[] outputs, long runOptionsHandle)
  */
 JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
-  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlong numOutputs, jlong runOptionsHandle) {
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlong numOutputs, jlongArray outputTensorArr, jlong runOptionsHandle) {
     (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
     const OrtApi* api = (const OrtApi*) apiHandle;
     OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
@@ -274,12 +274,14 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
     }
 
     // Extract the names of the output values, and allocate their output array.
+    // If the caller supplied preallocated outputs, ORT writes into those tensors directly.
+    jlong* outputTensors = outputTensorArr == NULL ? NULL : (*jniEnv)->GetLongArrayElements(jniEnv,outputTensorArr,NULL);
     OrtValue** outputValues;
     checkOrtStatus(jniEnv,api,api->AllocatorAlloc(allocator,sizeof(OrtValue*)*numOutputs,(void**)&outputValues));
     for (int i = 0; i < numOutputs; i++) {
         javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,outputNamesArr,i);
         outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaOutputStrings[i],NULL);
-        outputValues[i] = NULL;
+        outputValues[i] = outputTensors == NULL ? NULL : (OrtValue*)outputTensors[i];
     }
 
     // Actually score the inputs.
@@ -289,14 +291,20 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
     // Release the C array of pointers to the tensors.
     (*jniEnv)->ReleaseLongArrayElements(jniEnv,tensorArr,inputTensors,JNI_ABORT);
 
-    // Construct the output array of ONNXValues
-    char *onnxValueClassName = "ai/onnxruntime/OnnxValue";
-    jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
-    jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv,safecast_int64_to_jsize(numOutputs), onnxValueClass, NULL);
+    // Construct the output array of ONNXValues, unless the outputs were preallocated by the caller
+    // in which case they already own the output tensors.
+    jobjectArray outputArray = NULL;
+    if (outputTensors == NULL) {
+        char *onnxValueClassName = "ai/onnxruntime/OnnxValue";
+        jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
+        outputArray = (*jniEnv)->NewObjectArray(jniEnv,safecast_int64_to_jsize(numOutputs), onnxValueClass, NULL);
+    } else {
+        (*jniEnv)->ReleaseLongArrayElements(jniEnv,outputTensorArr,outputTensors,JNI_ABORT);
+    }
 
     // Convert the output tensors into ONNXValues and release the output strings.
     for (int i = 0; i < numOutputs; i++) {
-        if (outputValues[i] != NULL) {
+        if (outputArray != NULL && outputValues[i] != NULL) {
             jobject onnxValue = convertOrtValueToONNXValue(jniEnv,api,allocator,outputValues[i]);
             (*jniEnv)->SetObjectArrayElement(jniEnv,outputArray,i,onnxValue);
         }
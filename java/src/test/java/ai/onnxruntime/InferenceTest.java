@@ -896,6 +896,46 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void testPinnedOutputsAndReusedInputs() throws OrtException {
+    // model takes 1x5 input of fixed type, echoes back
+    String modelPath = TestHelpers.getResourcePath("/test_types_FLOAT.pb").toString();
+
+    try (SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options)) {
+      String inputName = session.getInputNames().iterator().next();
+      String outputName = session.getOutputNames().iterator().next();
+      long[] shape = new long[] {1, 5};
+      FloatBuffer inputBuffer =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+      FloatBuffer outputBuffer =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+
+      try (OnnxTensor input = OnnxTensor.createTensor(env, inputBuffer, shape);
+          OnnxTensor output = OnnxTensor.createTensor(env, outputBuffer, shape)) {
+        assertSame(inputBuffer, input.getBufferRef().get());
+        Map<String, OnnxTensor> inputs = new HashMap<>();
+        inputs.put(inputName, input);
+        Map<String, OnnxTensor> outputs = new HashMap<>();
+        outputs.put(outputName, output);
+
+        float[] expected = new float[5];
+        float[] actual = new float[5];
+        for (int i = 0; i < 3; i++) {
+          // Refill the input in place, the tensor sees the new values without being recreated.
+          for (int j = 0; j < expected.length; j++) {
+            expected[j] = i * 10.0f + j;
+            inputBuffer.put(j, expected[j]);
+          }
+          session.run(inputs, outputs);
+          outputBuffer.get(actual);
+          outputBuffer.rewind();
+          assertArrayEquals(expected, actual, 1e-6f);
+        }
+      }
+    }
+  }
+
   @Test
   public void testRunOptions() throws OrtException {
     // model takes 1x5 input of fixed type, echoes back
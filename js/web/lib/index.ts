@@ -13,6 +13,10 @@ if (!BUILD_DEFS.DISABLE_WEBGL) {
   const onnxjsBackend = require('./backend-onnxjs').onnxjsBackend;
   registerBackend('webgl', onnxjsBackend, -1);
 }
+if (!BUILD_DEFS.DISABLE_WEBGPU) {
+  const onnxjsBackend = require('./backend-onnxjs').onnxjsBackend;
+  registerBackend('webgpu', onnxjsBackend, -1);
+}
 if (!BUILD_DEFS.DISABLE_WASM) {
   const wasmBackend = require('./backend-wasm').wasmBackend;
   registerBackend('wasm', wasmBackend, 0);
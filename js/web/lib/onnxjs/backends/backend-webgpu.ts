@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+/// <reference types="@webgpu/types" />
+
+import {env} from 'onnxruntime-common';
+import {Backend, SessionHandler} from '../backend';
+import {Logger} from '../instrument';
+import {Session} from '../session';
+
+import {WebGpuSessionHandler} from './webgpu/session-handler';
+
+/**
+ * WebGpuBackend is the entry point for all WebGPU operations.
+ * When it starts it requests the GPUAdapter and GPUDevice. All programs of all sessions are recorded into a single
+ * shared command encoder, which is submitted to the device queue when data needs to be read back or overwritten.
+ */
+export class WebGpuBackend implements Backend {
+  device: GPUDevice;
+
+  private commandEncoder: GPUCommandEncoder|null = null;
+
+  async initialize(): Promise<boolean> {
+    try {
+      if (typeof navigator === 'undefined' || !navigator.gpu) {
+        throw new Error('WebGPU is not supported in current environment');
+      }
+      const adapter = await navigator.gpu.requestAdapter();
+      if (!adapter) {
+        throw new Error('no GPUAdapter is available');
+      }
+      this.device = await adapter.requestDevice();
+
+      Logger.setWithEnv(env);
+
+      Logger.verbose('WebGpuBackend', 'Created GPUDevice.');
+      return true;
+    } catch (e) {
+      Logger.warning('WebGpuBackend', `Unable to initialize WebGpuBackend. ${e}`);
+      return false;
+    }
+  }
+  createSessionHandler(context: Session.Context): SessionHandler {
+    return new WebGpuSessionHandler(this, context);
+  }
+  dispose(): void {
+    this.flush();
+    this.device.destroy();
+  }
+
+  /**
+   * get the command encoder to record GPU commands into. A new one is created if the previous one is flushed.
+   */
+  getCommandEncoder(): GPUCommandEncoder {
+    if (!this.commandEncoder) {
+      this.commandEncoder = this.device.createCommandEncoder();
+    }
+    return this.commandEncoder;
+  }
+
+  /**
+   * submit all recorded commands to the device queue.
+   */
+  flush(): void {
+    if (this.commandEncoder) {
+      this.device.queue.submit([this.commandEncoder.finish()]);
+      this.commandEncoder = null;
+    }
+  }
+}
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Logger, Profiler} from '../../instrument';
+import {Tensor} from '../../tensor';
+import {ShapeUtil} from '../../util';
+import {WebGpuBackend} from '../backend-webgpu';
+
+import {GpuData} from './types';
+
+/**
+ * buffer sizes are rounded up to a multiple of this value so that buffers of similar size can be reused.
+ */
+const BUFFER_SIZE_ALIGNMENT = 16;
+
+const calcBufferSize = (size: number) => Math.ceil(size / BUFFER_SIZE_ALIGNMENT) * BUFFER_SIZE_ALIGNMENT;
+
+const getBytesPerElement = (type: Tensor.DataType): number => {
+  switch (type) {
+    case 'float32':
+    case 'int32':
+    case 'uint32':
+      return 4;
+    default:
+      throw new Error(`WebGPU backend does not support data type: ${type}`);
+  }
+};
+
+const createTypedArray = (type: Tensor.DataType, buffer: ArrayBuffer, size: number): Tensor.NumberType => {
+  switch (type) {
+    case 'float32':
+      return new Float32Array(buffer, 0, size);
+    case 'int32':
+      return new Int32Array(buffer, 0, size);
+    case 'uint32':
+      return new Uint32Array(buffer, 0, size);
+    default:
+      throw new Error(`WebGPU backend does not support data type: ${type}`);
+  }
+};
+
+/**
+ * GpuDataManager is responsible for creating, uploading, downloading and recycling GPU storage buffers.
+ *
+ * Released buffers are kept in a free list keyed by their (aligned) size and handed out again by later create()
+ * calls, so a model that is run repeatedly with the same input shapes does not allocate any new buffer after the
+ * first run.
+ */
+export class GpuDataManager {
+  private freeBuffers: Map<number, GPUBuffer[]>;
+
+  constructor(private backend: WebGpuBackend, private profiler: Readonly<Profiler>) {
+    this.freeBuffers = new Map();
+  }
+
+  /**
+   * create a buffer for a tensor of the given type and shape. the content of the buffer is undefined.
+   */
+  create(type: Tensor.DataType, dims: readonly number[]): GpuData {
+    const bufferSize = calcBufferSize(Math.max(ShapeUtil.size(dims), 1) * getBytesPerElement(type));
+    const freeList = this.freeBuffers.get(bufferSize);
+    let buffer = freeList ? freeList.pop() : undefined;
+    if (!buffer) {
+      Logger.verbose('GpuDataManager', `Creating GPUBuffer of ${bufferSize} bytes`);
+      buffer = this.backend.device.createBuffer({
+        size: bufferSize,
+        // eslint-disable-next-line no-bitwise
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST
+      });
+    }
+    return {type, dims, buffer, bufferSize};
+  }
+
+  /**
+   * create a buffer for the tensor and upload the tensor data into it.
+   */
+  upload(tensor: Tensor): GpuData {
+    return this.profiler.event('backend', 'GpuDataManager.upload', () => {
+      const gpuData = this.create(tensor.type, tensor.dims);
+      const data = tensor.numberData;
+      // a reused buffer may still be read by commands that are recorded but not submitted yet. writeBuffer() is
+      // executed before any command buffer submitted after it, so flush them first.
+      this.backend.flush();
+      this.backend.device.queue.writeBuffer(gpuData.buffer, 0, data.buffer, data.byteOffset, data.byteLength);
+      return gpuData;
+    });
+  }
+
+  /**
+   * read the content of the buffer back to CPU.
+   */
+  async download(gpuData: GpuData): Promise<Tensor.NumberType> {
+    return this.profiler.event('backend', 'GpuDataManager.download', async () => {
+      const size = ShapeUtil.size(gpuData.dims);
+      const staging = this.backend.device.createBuffer(
+          // eslint-disable-next-line no-bitwise
+          {size: gpuData.bufferSize, usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST});
+      try {
+        this.backend.getCommandEncoder().copyBufferToBuffer(gpuData.buffer, 0, staging, 0, gpuData.bufferSize);
+        this.backend.flush();
+
+        await staging.mapAsync(GPUMapMode.READ);
+        const copy = staging.getMappedRange().slice(0);
+        staging.unmap();
+        return createTypedArray(gpuData.type, copy, size);
+      } finally {
+        staging.destroy();
+      }
+    });
+  }
+
+  /**
+   * return the buffer to the free list so that it can be reused by a later create() call.
+   */
+  release(gpuData: GpuData): void {
+    let freeList = this.freeBuffers.get(gpuData.bufferSize);
+    if (!freeList) {
+      freeList = [];
+      this.freeBuffers.set(gpuData.bufferSize, freeList);
+    }
+    freeList.push(gpuData.buffer);
+  }
+
+  dispose(): void {
+    this.freeBuffers.forEach(freeList => freeList.forEach(buffer => buffer.destroy()));
+    this.freeBuffers = new Map();
+  }
+}
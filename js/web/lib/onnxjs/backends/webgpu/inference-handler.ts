@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {InferenceHandler} from '../../backend';
+import {Tensor} from '../../tensor';
+
+import {WebGpuSessionHandler} from './session-handler';
+import {GpuData, ProgramInfoLoader} from './types';
+
+const getProgramInfoUniqueKey = (programInfo: ProgramInfoLoader, inputs: readonly Tensor[]): string => {
+  const shapes = inputs.map(tensor => `${tensor.type}[${tensor.dims.join(',')}]`).join('_');
+  let key = programInfo.name;
+  if (programInfo.cacheHint) {
+    key += '[' + programInfo.cacheHint + ']';
+  }
+  key += ':' + shapes;
+  return key;
+};
+
+export class WebGpuInferenceHandler implements InferenceHandler {
+  /**
+   * GPU data created during this run. released to the data manager in dispose().
+   */
+  private dataCache: Map<Tensor.Id, GpuData>;
+  /**
+   * tensors that share the GPU data of another tensor (eg. the output of Reshape). not released in dispose().
+   */
+  private aliasCache: Map<Tensor.Id, GpuData>;
+
+  constructor(public session: WebGpuSessionHandler) {
+    this.dataCache = new Map();
+    this.aliasCache = new Map();
+  }
+
+  /**
+   * run a program on the given inputs. the returned tensors hold their data on GPU; their data can only be read by
+   * getData().
+   */
+  run(program: ProgramInfoLoader, inputs: readonly Tensor[]): Tensor[] {
+    const inputDatas = inputs.map(tensor => this.getOrCreateGpuData(tensor));
+
+    const key = getProgramInfoUniqueKey(program, inputs);
+    let artifact = this.session.programManager.getArtifact(key);
+    const programInfo = artifact ? artifact.programInfo : program.get();
+
+    const outputTensors: Tensor[] = [];
+    const outputDatas: GpuData[] = [];
+    for (const output of programInfo.outputs) {
+      const gpuData = this.session.dataManager.create(output.type, output.dims);
+      const tensor = this.createTensorFromGpuData(gpuData);
+      this.dataCache.set(tensor.dataId, gpuData);
+      outputTensors.push(tensor);
+      outputDatas.push(gpuData);
+    }
+
+    if (!artifact) {
+      artifact = this.session.programManager.build(programInfo);
+      this.session.programManager.setArtifact(key, artifact);
+    }
+
+    this.session.programManager.run(artifact, inputDatas, outputDatas);
+    return outputTensors;
+  }
+
+  /**
+   * create a tensor with new dims that shares the GPU data of the input. no GPU work is recorded.
+   */
+  reshape(input: Tensor, reshapedDims: readonly number[]): Tensor {
+    const inputData = this.getOrCreateGpuData(input);
+    const gpuData = {...inputData, dims: reshapedDims};
+    const tensor = this.createTensorFromGpuData(gpuData);
+    this.aliasCache.set(tensor.dataId, gpuData);
+    return tensor;
+  }
+
+  dispose(): void {
+    this.dataCache.forEach(gpuData => this.session.dataManager.release(gpuData));
+    this.dataCache = new Map();
+    this.aliasCache = new Map();
+  }
+
+  private getOrCreateGpuData(tensor: Tensor): GpuData {
+    const isInitializer = this.session.isInitializer(tensor.dataId);
+    let gpuData = isInitializer ? this.session.getGpuData(tensor.dataId) :
+                                  this.dataCache.get(tensor.dataId) || this.aliasCache.get(tensor.dataId);
+    if (!gpuData) {
+      gpuData = this.session.dataManager.upload(tensor);
+      if (isInitializer) {
+        this.session.setGpuData(tensor.dataId, gpuData);
+      } else {
+        this.dataCache.set(tensor.dataId, gpuData);
+      }
+    }
+    return gpuData;
+  }
+
+  private createTensorFromGpuData(gpuData: GpuData): Tensor {
+    return new Tensor(
+        gpuData.dims, gpuData.type,
+        (_id: Tensor.Id) => {
+          throw new Error('data of a tensor on WebGPU can only be read asynchronously by getData()');
+        },
+        async (_id: Tensor.Id) => this.session.dataManager.download(gpuData));
+  }
+}
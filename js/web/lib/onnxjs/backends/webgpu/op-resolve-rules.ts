@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {OpSet} from '../../opset';
+
+import * as binaryOps from './ops/binary-op';
+import {matMul} from './ops/matmul';
+import {flatten, identity, parseAxesAttributes, parseFlattenAttributes, reshape, squeeze, squeezeV13, unsqueeze, unsqueezeV13} from './ops/reshape';
+import {parseSoftmaxAttributes, parseSoftmaxAttributesV13, softmax, softmaxV13} from './ops/softmax';
+import {parseTransposeAttributes, transpose} from './ops/transpose';
+import * as unaryOps from './ops/unary-op';
+
+export const WEBGPU_OP_RESOLVE_RULES: readonly OpSet.ResolveRule[] = [
+  ['Abs', '', '6+', unaryOps.abs],
+  ['Acos', '', '7+', unaryOps.acos],
+  ['Add', '', '7+', binaryOps.add],
+  ['Asin', '', '7+', unaryOps.asin],
+  ['Atan', '', '7+', unaryOps.atan],
+  ['Ceil', '', '6+', unaryOps.ceil],
+  ['Clip', '', '6-10', unaryOps.clip, unaryOps.parseClipAttributes],
+  ['Clip', '', '11+', unaryOps.clipV11],
+  ['Cos', '', '7+', unaryOps.cos],
+  ['Div', '', '7+', binaryOps.div],
+  ['Dropout', '', '7+', identity],
+  ['Elu', '', '6+', unaryOps.elu, unaryOps.parseEluAttributes],
+  ['Exp', '', '6+', unaryOps.exp],
+  ['Flatten', '', '1+', flatten, parseFlattenAttributes],
+  ['Floor', '', '6+', unaryOps.floor],
+  ['Identity', '', '1+', identity],
+  ['LeakyRelu', '', '6+', unaryOps.leakyRelu, unaryOps.parseLeakyReluAttributes],
+  ['Log', '', '6+', unaryOps.log],
+  ['MatMul', '', '1+', matMul],
+  ['Mul', '', '7+', binaryOps.mul],
+  ['Neg', '', '6+', unaryOps.neg],
+  ['Pow', '', '7+', binaryOps.pow],
+  ['PRelu', '', '7+', binaryOps.pRelu],
+  ['Reciprocal', '', '6+', unaryOps.reciprocal],
+  ['Relu', '', '6+', unaryOps.relu],
+  ['Reshape', '', '5+', reshape],
+  ['Sigmoid', '', '6+', unaryOps.sigmoid],
+  ['Sin', '', '7+', unaryOps.sin],
+  // The "semantic" meaning of axis has changed in opset-13.
+  ['Softmax', '', '1-12', softmax, parseSoftmaxAttributes],
+  ['Softmax', '', '13+', softmaxV13, parseSoftmaxAttributesV13],
+  ['Sqrt', '', '6+', unaryOps.sqrt],
+  ['Squeeze', '', '1-12', squeeze, parseAxesAttributes],
+  ['Squeeze', '', '13+', squeezeV13],
+  ['Sub', '', '7+', binaryOps.sub],
+  ['Tan', '', '7+', unaryOps.tan],
+  ['Tanh', '', '6+', unaryOps.tanh],
+  ['Transpose', '', '1+', transpose, parseTransposeAttributes],
+  ['Unsqueeze', '', '1-12', unsqueeze, parseAxesAttributes],
+  ['Unsqueeze', '', '13+', unsqueezeV13],
+];
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../../tensor';
+import {BroadcastUtil, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader, ProgramMetadata} from '../types';
+
+import {createDispatchGroup, indicesToOffsets, mainWithGlobalIndex, validateFloat32Inputs} from './common';
+
+/**
+ * generate the WGSL expression of an element-wise function. `a` and `b` are the input values and `T` is their type,
+ * which is either `f32` or `vec4<f32>`.
+ */
+type ExpressionGenerator = (a: string, b: string, T: string) => string;
+
+/**
+ * get the strides to read an input of shape `dims` when iterating over the broadcasted `outputDims`. dimensions of
+ * size 1 and the missing leading dimensions get a stride of 0.
+ */
+const getBroadcastStrides = (dims: readonly number[], outputDims: readonly number[]): number[] => {
+  const strides = ShapeUtil.computeStrides(dims);
+  const rankDiff = outputDims.length - dims.length;
+  return outputDims.map((_, i) => (i < rankDiff || dims[i - rankDiff] === 1) ? 0 : strides[i - rankDiff]);
+};
+
+const createBinaryProgramInfo =
+    (metadata: ProgramMetadata, a: Tensor, b: Tensor, expression: ExpressionGenerator): ProgramInfo => {
+      const isBroadcast = !ShapeUtil.areEqual(a.dims, b.dims);
+      const outputDims = isBroadcast ? BroadcastUtil.calcShape(a.dims, b.dims, false) : a.dims;
+      if (!outputDims) {
+        throw new Error('Can\'t perform binary op on the given tensors');
+      }
+      const outputSize = ShapeUtil.size(outputDims);
+
+      let T: string;
+      let size: number;
+      let body: string;
+      if (!isBroadcast && outputSize % 4 === 0) {
+        // same shape: process 4 elements per invocation
+        T = 'vec4<f32>';
+        size = outputSize / 4;
+        body = `outputData[global_idx] = ${expression('aData[global_idx]', 'bData[global_idx]', T)};`;
+      } else if (!isBroadcast) {
+        T = 'f32';
+        size = outputSize;
+        body = `outputData[global_idx] = ${expression('aData[global_idx]', 'bData[global_idx]', T)};`;
+      } else {
+        T = 'f32';
+        size = outputSize;
+        body = `${indicesToOffsets(outputDims, [
+          {name: 'offsetA', strides: getBroadcastStrides(a.dims, outputDims)},
+          {name: 'offsetB', strides: getBroadcastStrides(b.dims, outputDims)}
+        ])}
+  outputData[global_idx] = ${expression('aData[offsetA]', 'bData[offsetB]', T)};`;
+      }
+
+      return {
+        ...metadata,
+        outputs: [{dims: outputDims, type: a.type}],
+        shaderSource: `
+  @group(0) @binding(0) var<storage, read> aData : array<${T}>;
+  @group(0) @binding(1) var<storage, read> bData : array<${T}>;
+  @group(0) @binding(2) var<storage, read_write> outputData : array<${T}>;
+  ${mainWithGlobalIndex(size, body)}`,
+        dispatchGroup: createDispatchGroup(size)
+      };
+    };
+
+const runBinary =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], name: string, expression: ExpressionGenerator): Tensor[] => {
+      validateFloat32Inputs(inputs, 2, name);
+      const metadata = {name};
+      const loader: ProgramInfoLoader =
+          {...metadata, get: () => createBinaryProgramInfo(metadata, inputs[0], inputs[1], expression)};
+      return handler.run(loader, [inputs[0], inputs[1]]);
+    };
+
+export const add = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runBinary(handler, inputs, 'Add', (a, b) => `${a} + ${b}`);
+
+export const div = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runBinary(handler, inputs, 'Div', (a, b) => `${a} / ${b}`);
+
+export const mul = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runBinary(handler, inputs, 'Mul', (a, b) => `${a} * ${b}`);
+
+export const pow = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runBinary(handler, inputs, 'Pow', (a, b) => `pow(${a}, ${b})`);
+
+export const pRelu = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runBinary(handler, inputs, 'PRelu', (a, b, T) => `select(${a} * ${b}, ${a}, ${a} >= ${T}(0.0))`);
+
+export const sub = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runBinary(handler, inputs, 'Sub', (a, b) => `${a} - ${b}`);
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../../tensor';
+import {DispatchGroup} from '../types';
+
+/**
+ * the workgroup size of all 1D element-wise programs
+ */
+export const WORKGROUP_SIZE = 64;
+
+const MAX_WORKGROUPS_PER_DIMENSION = 65535;
+
+/**
+ * get the dispatch group of a program in which each invocation handles one of `size` elements. The workgroups are
+ * spread to the Y dimension when there are too many of them for a single dimension.
+ */
+export const createDispatchGroup = (size: number): DispatchGroup => {
+  const workgroups = Math.ceil(size / WORKGROUP_SIZE);
+  if (workgroups <= MAX_WORKGROUPS_PER_DIMENSION) {
+    return {x: workgroups};
+  }
+  const y = Math.ceil(workgroups / MAX_WORKGROUPS_PER_DIMENSION);
+  return {x: Math.ceil(workgroups / y), y};
+};
+
+/**
+ * generate the entry point of a program created with createDispatchGroup(). `global_idx` is the index of the element
+ * to handle in `body`.
+ */
+export const mainWithGlobalIndex = (size: number, body: string): string => `
+@compute @workgroup_size(${WORKGROUP_SIZE})
+fn main(@builtin(global_invocation_id) global_id : vec3<u32>,
+        @builtin(num_workgroups) num_workgroups : vec3<u32>) {
+  let global_idx = global_id.y * num_workgroups.x * ${WORKGROUP_SIZE}u + global_id.x;
+  if (global_idx >= ${size}u) {
+    return;
+  }
+  ${body}
+}`;
+
+/**
+ * generate WGSL statements that split the flat index `index` into the indices of `dims` and accumulate into each
+ * variable of `offsets` the sum of index multiplied by the corresponding stride. A stride of 0 means the dimension is
+ * broadcasted.
+ */
+export const indicesToOffsets =
+    (dims: readonly number[], offsets: ReadonlyArray<{name: string; strides: readonly number[]}>,
+     index = 'global_idx'): string => {
+      const lines = [`var remainder = ${index};`];
+      for (const offset of offsets) {
+        lines.push(`var ${offset.name} = 0u;`);
+      }
+      let pitch = 1;
+      const pitches = new Array<number>(dims.length);
+      for (let i = dims.length - 1; i >= 0; i--) {
+        pitches[i] = pitch;
+        pitch *= dims[i];
+      }
+      for (let i = 0; i < dims.length; i++) {
+        lines.push(`let index${i} = remainder / ${pitches[i]}u;`);
+        lines.push(`remainder = remainder - index${i} * ${pitches[i]}u;`);
+        for (const offset of offsets) {
+          if (offset.strides[i] !== 0) {
+            lines.push(`${offset.name} = ${offset.name} + index${i} * ${offset.strides[i]}u;`);
+          }
+        }
+      }
+      return lines.join('\n  ');
+    };
+
+export const validateFloat32Inputs = (inputs: readonly Tensor[], count: number, name: string): void => {
+  if (!inputs || inputs.length < count) {
+    throw new Error(`${name} requires ${count} input(s).`);
+  }
+  for (let i = 0; i < count; i++) {
+    if (inputs[i].type !== 'float32') {
+      throw new Error(`${name} on WebGPU supports float32 only.`);
+    }
+  }
+};
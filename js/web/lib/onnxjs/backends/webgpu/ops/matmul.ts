@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../../tensor';
+import {BroadcastUtil, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader, ProgramMetadata} from '../types';
+
+import {indicesToOffsets, validateFloat32Inputs} from './common';
+
+/**
+ * the size of the square tile of A and B that a workgroup loads into workgroup memory. each invocation computes one
+ * element of the output.
+ */
+const TILE_SIZE = 8;
+
+const matMulProgramMetadata = {
+  name: 'MatMul'
+};
+
+export const matMul = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+  validateInputs(inputs);
+  const loader: ProgramInfoLoader = {
+    ...matMulProgramMetadata,
+    get: () => createMatMulProgramInfo(matMulProgramMetadata, inputs[0], inputs[1])
+  };
+  return handler.run(loader, [inputs[0], inputs[1]]);
+};
+
+/**
+ * get the strides of the batch dimensions of `dims` when iterating over the broadcasted `outputBatchDims`.
+ */
+const getBatchStrides = (dims: readonly number[], outputBatchDims: readonly number[]): number[] => {
+  const strides = ShapeUtil.computeStrides(dims);
+  const batchRank = dims.length - 2;
+  const rankDiff = outputBatchDims.length - batchRank;
+  return outputBatchDims.map((_, i) => (i < rankDiff || dims[i - rankDiff] === 1) ? 0 : strides[i - rankDiff]);
+};
+
+const createMatMulProgramInfo = (metadata: ProgramMetadata, a: Tensor, b: Tensor): ProgramInfo => {
+  const outputDims = BroadcastUtil.calcShape(a.dims, b.dims, true);
+  if (!outputDims) {
+    throw new Error('Can\'t use matmul on the given tensors');
+  }
+  const M = a.dims[a.dims.length - 2];
+  const K = a.dims[a.dims.length - 1];
+  const N = b.dims[b.dims.length - 1];
+  const outputBatchDims = outputDims.slice(0, -2);
+  const batchSize = ShapeUtil.size(outputBatchDims);
+
+  return {
+    ...metadata,
+    outputs: [{dims: outputDims, type: a.type}],
+    shaderSource: `
+  @group(0) @binding(0) var<storage, read> aData : array<f32>;
+  @group(0) @binding(1) var<storage, read> bData : array<f32>;
+  @group(0) @binding(2) var<storage, read_write> outputData : array<f32>;
+
+  var<workgroup> tileA : array<array<f32, ${TILE_SIZE}>, ${TILE_SIZE}>;
+  var<workgroup> tileB : array<array<f32, ${TILE_SIZE}>, ${TILE_SIZE}>;
+
+  @compute @workgroup_size(${TILE_SIZE}, ${TILE_SIZE}, 1)
+  fn main(@builtin(global_invocation_id) global_id : vec3<u32>,
+          @builtin(local_invocation_id) local_id : vec3<u32>) {
+    let row = global_id.y;
+    let col = global_id.x;
+    let batch = global_id.z;
+    ${indicesToOffsets(outputBatchDims, [
+    {name: 'offsetA', strides: getBatchStrides(a.dims, outputBatchDims)},
+    {name: 'offsetB', strides: getBatchStrides(b.dims, outputBatchDims)}
+  ], 'batch')}
+
+    var value = 0.0;
+    for (var t = 0u; t < ${Math.ceil(K / TILE_SIZE)}u; t = t + 1u) {
+      let aCol = t * ${TILE_SIZE}u + local_id.x;
+      let bRow = t * ${TILE_SIZE}u + local_id.y;
+      if (row < ${M}u && aCol < ${K}u) {
+        tileA[local_id.y][local_id.x] = aData[offsetA + row * ${K}u + aCol];
+      } else {
+        tileA[local_id.y][local_id.x] = 0.0;
+      }
+      if (bRow < ${K}u && col < ${N}u) {
+        tileB[local_id.y][local_id.x] = bData[offsetB + bRow * ${N}u + col];
+      } else {
+        tileB[local_id.y][local_id.x] = 0.0;
+      }
+      workgroupBarrier();
+
+      for (var k = 0u; k < ${TILE_SIZE}u; k = k + 1u) {
+        value = value + tileA[local_id.y][k] * tileB[k][local_id.x];
+      }
+      workgroupBarrier();
+    }
+
+    if (row < ${M}u && col < ${N}u) {
+      outputData[batch * ${M * N}u + row * ${N}u + col] = value;
+    }
+  }`,
+    dispatchGroup: {x: Math.ceil(N / TILE_SIZE), y: Math.ceil(M / TILE_SIZE), z: batchSize}
+  };
+};
+
+const validateInputs = (inputs: Tensor[]): void => {
+  validateFloat32Inputs(inputs, 2, 'MatMul');
+  if (inputs[0].dims.length < 2 || inputs[1].dims.length < 2) {
+    throw new Error('MatMul on WebGPU requires inputs of rank 2 or higher.');
+  }
+  if (inputs[0].dims[inputs[0].dims.length - 1] !== inputs[1].dims[inputs[1].dims.length - 2]) {
+    throw new Error('shared dimension does not match.');
+  }
+};
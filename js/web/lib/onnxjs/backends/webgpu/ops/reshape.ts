@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Operators in this file only change the shape of the input. The output shares the GPU buffer of the input and no
+// program is run.
+
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+
+export const reshape = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+  const reshapedDims = ShapeUtil.calculateReshapedDims(inputs[0].dims, inputs[1].integerData);
+  return [handler.reshape(inputs[0], reshapedDims)];
+};
+
+export const identity = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    [handler.reshape(inputs[0], inputs[0].dims)];
+
+export const flatten: OperatorImplementation<number> =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], axis: number): Tensor[] => {
+      const r = inputs[0].dims.length;
+      if (r === 0) {
+        throw new Error('scalar tensor is not supported.');
+      }
+      if (axis < -r || axis > r) {
+        throw new Error('Invalid axis');
+      }
+      return [handler.reshape(inputs[0], ShapeUtil.flattenShape(inputs[0].dims, axis < 0 ? axis + r : axis))];
+    };
+
+export const parseFlattenAttributes: OperatorInitialization<number> = (node: Graph.Node): number =>
+    node.attributes.getInt('axis', 1);  // default axis is 1
+
+export const squeeze: OperatorImplementation<number[]> =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], axes: number[]): Tensor[] =>
+        [handler.reshape(inputs[0], ShapeUtil.squeezeShape(inputs[0].dims, axes))];
+
+export const squeezeV13 = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    squeeze(handler, [inputs[0]], inputs.length > 1 ? Array.from(inputs[1].integerData) : []);
+
+export const unsqueeze: OperatorImplementation<number[]> =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], axes: number[]): Tensor[] =>
+        [handler.reshape(inputs[0], ShapeUtil.unsqueezeShape(inputs[0].dims, axes))];
+
+export const unsqueezeV13 = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    unsqueeze(handler, [inputs[0]], Array.from(inputs[1].integerData));
+
+export const parseAxesAttributes: OperatorInitialization<number[]> = (node: Graph.Node): number[] =>
+    node.attributes.getInts('axes', []);
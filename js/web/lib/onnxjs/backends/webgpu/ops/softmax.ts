@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramMetadata} from '../types';
+
+import {createDispatchGroup, mainWithGlobalIndex, validateFloat32Inputs} from './common';
+
+export interface SoftmaxAttributes extends AttributeWithCacheKey {
+  readonly axis: number;
+}
+
+export const softmax: OperatorImplementation<SoftmaxAttributes> =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: SoftmaxAttributes): Tensor[] => {
+      validateFloat32Inputs(inputs, 1, 'Softmax');
+      const dims = inputs[0].dims;
+      const axis = ShapeUtil.normalizeAxis(attributes.axis, dims.length);
+      // opset 1-12: the input is coerced into 2D [N, D] at axis
+      const outer = ShapeUtil.sizeToDimension(dims, axis);
+      return computeSoftmax(handler, inputs[0], attributes, outer, ShapeUtil.sizeFromDimension(dims, axis), 1);
+    };
+
+export const softmaxV13: OperatorImplementation<SoftmaxAttributes> =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: SoftmaxAttributes): Tensor[] => {
+      validateFloat32Inputs(inputs, 1, 'Softmax');
+      const dims = inputs[0].dims;
+      const axis = ShapeUtil.normalizeAxis(attributes.axis, dims.length);
+      // opset 13+: the softmax is computed along the given axis only
+      return computeSoftmax(
+          handler, inputs[0], attributes, ShapeUtil.sizeToDimension(dims, axis), dims[axis],
+          ShapeUtil.sizeFromDimension(dims, axis + 1));
+    };
+
+export const parseSoftmaxAttributes: OperatorInitialization<SoftmaxAttributes> =
+    (node: Graph.Node): SoftmaxAttributes => createAttributeWithCacheKey({axis: node.attributes.getInt('axis', 1)});
+
+export const parseSoftmaxAttributesV13: OperatorInitialization<SoftmaxAttributes> =
+    (node: Graph.Node): SoftmaxAttributes => createAttributeWithCacheKey({axis: node.attributes.getInt('axis', -1)});
+
+/**
+ * the input is viewed as [outer, featureCount, inner] and the softmax is computed along the middle dimension. each
+ * invocation handles one of the outer * inner rows.
+ */
+const computeSoftmax =
+    (handler: WebGpuInferenceHandler, input: Tensor, attributes: SoftmaxAttributes, outer: number,
+     featureCount: number, inner: number): Tensor[] => {
+      const metadata = {name: 'Softmax', cacheHint: attributes.cacheKey};
+      return handler.run(
+          {...metadata, get: () => createSoftmaxProgramInfo(metadata, input, outer, featureCount, inner)}, [input]);
+    };
+
+const createSoftmaxProgramInfo =
+    (metadata: ProgramMetadata, input: Tensor, outer: number, featureCount: number, inner: number): ProgramInfo => {
+      const rowCount = outer * inner;
+      return {
+        ...metadata,
+        outputs: [{dims: input.dims, type: input.type}],
+        shaderSource: `
+  @group(0) @binding(0) var<storage, read> inputData : array<f32>;
+  @group(0) @binding(1) var<storage, read_write> outputData : array<f32>;
+  ${mainWithGlobalIndex(rowCount, `
+  let outerIndex = global_idx / ${inner}u;
+  let innerIndex = global_idx - outerIndex * ${inner}u;
+  let offset = outerIndex * ${featureCount * inner}u + innerIndex;
+
+  var maxValue = inputData[offset];
+  for (var i = 1u; i < ${featureCount}u; i = i + 1u) {
+    maxValue = max(maxValue, inputData[offset + i * ${inner}u]);
+  }
+  var sum = 0.0;
+  for (var i = 0u; i < ${featureCount}u; i = i + 1u) {
+    let value = exp(inputData[offset + i * ${inner}u] - maxValue);
+    outputData[offset + i * ${inner}u] = value;
+    sum = sum + value;
+  }
+  for (var i = 0u; i < ${featureCount}u; i = i + 1u) {
+    outputData[offset + i * ${inner}u] = outputData[offset + i * ${inner}u] / sum;
+  }`)}`,
+        dispatchGroup: createDispatchGroup(rowCount)
+      };
+    };
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {OperatorImplementation, OperatorInitialization} from '../../../operators';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramMetadata} from '../types';
+
+import {createDispatchGroup, indicesToOffsets, mainWithGlobalIndex} from './common';
+
+export interface TransposeAttributes extends AttributeWithCacheKey {
+  readonly perm: number[];
+}
+
+export const transpose: OperatorImplementation<TransposeAttributes> =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: TransposeAttributes): Tensor[] => {
+      if (!inputs || inputs.length !== 1) {
+        throw new Error('Transpose requires 1 input.');
+      }
+      const metadata = {name: 'Transpose', cacheHint: attributes.cacheKey};
+      return handler.run(
+          {...metadata, get: () => createTransposeProgramInfo(metadata, inputs[0], attributes.perm)}, [inputs[0]]);
+    };
+
+export const parseTransposeAttributes: OperatorInitialization<TransposeAttributes> =
+    (node: Graph.Node): TransposeAttributes => createAttributeWithCacheKey({perm: node.attributes.getInts('perm', [])});
+
+const createTransposeProgramInfo = (metadata: ProgramMetadata, input: Tensor, perm: number[]): ProgramInfo => {
+  const inputDims = input.dims;
+  if (perm.length !== inputDims.length) {
+    perm = [...(inputDims.keys())].reverse();
+  }
+  const outputDims = ShapeUtil.sortBasedOnPerm(inputDims, perm);
+  const inputStrides = ShapeUtil.computeStrides(inputDims);
+  // output dimension i iterates over input dimension perm[i]
+  const strides = perm.map(p => inputStrides[p]);
+  const T = input.type === 'float32' ? 'f32' : input.type === 'int32' ? 'i32' : 'u32';
+  return {
+    ...metadata,
+    outputs: [{dims: outputDims, type: input.type}],
+    shaderSource: `
+  @group(0) @binding(0) var<storage, read> inputData : array<${T}>;
+  @group(0) @binding(1) var<storage, read_write> outputData : array<${T}>;
+  ${mainWithGlobalIndex(input.size, `
+  ${indicesToOffsets(outputDims, [{name: 'offset', strides}])}
+  outputData[global_idx] = inputData[offset];`)}`,
+    dispatchGroup: createDispatchGroup(input.size)
+  };
+};
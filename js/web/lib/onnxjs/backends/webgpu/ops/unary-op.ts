@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {Tensor} from '../../../tensor';
+import {MAX_CLIP, MIN_CLIP} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo, ProgramInfoLoader, ProgramMetadata} from '../types';
+
+import {createDispatchGroup, mainWithGlobalIndex, validateFloat32Inputs} from './common';
+
+/**
+ * generate the WGSL expression of an element-wise function. `a` is the input value and `T` is its type, which is
+ * either `f32` or `vec4<f32>`.
+ */
+type ExpressionGenerator = (a: string, T: string) => string;
+
+const builtinUnary = (name: string): ExpressionGenerator => (a: string) => `${name}(${a})`;
+
+const createElementwiseProgramInfo =
+    (metadata: ProgramMetadata, input: Tensor, expression: ExpressionGenerator): ProgramInfo => {
+      // process 4 elements per invocation when possible
+      const vectorized = input.size % 4 === 0;
+      const T = vectorized ? 'vec4<f32>' : 'f32';
+      const size = vectorized ? input.size / 4 : input.size;
+      return {
+        ...metadata,
+        outputs: [{dims: input.dims, type: input.type}],
+        shaderSource: `
+  @group(0) @binding(0) var<storage, read> inputData : array<${T}>;
+  @group(0) @binding(1) var<storage, read_write> outputData : array<${T}>;
+  ${mainWithGlobalIndex(size, `
+  let a = inputData[global_idx];
+  outputData[global_idx] = ${expression('a', T)};`)}`,
+        dispatchGroup: createDispatchGroup(size)
+      };
+    };
+
+const createElementwiseProgramInfoLoader =
+    (input: Tensor, name: string, expression: ExpressionGenerator, cacheKey?: string): ProgramInfoLoader => {
+      const metadata = {name, cacheHint: cacheKey};
+      return {...metadata, get: () => createElementwiseProgramInfo(metadata, input, expression)};
+    };
+
+const runElementwise =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], name: string, expression: ExpressionGenerator,
+     cacheKey?: string): Tensor[] => {
+      validateFloat32Inputs(inputs, 1, name);
+      return handler.run(createElementwiseProgramInfoLoader(inputs[0], name, expression, cacheKey), [inputs[0]]);
+    };
+
+export const abs = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Abs', builtinUnary('abs'));
+
+export const acos = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Acos', builtinUnary('acos'));
+
+export const asin = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Asin', builtinUnary('asin'));
+
+export const atan = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Atan', builtinUnary('atan'));
+
+export const ceil = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Ceil', builtinUnary('ceil'));
+
+export interface ClipAttributes extends AttributeWithCacheKey {
+  readonly min: number;
+  readonly max: number;
+}
+
+export const clip = (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: ClipAttributes): Tensor[] =>
+    runElementwise(
+        handler, inputs, 'Clip',
+        (a, T) => `clamp(${a}, ${T}(${attributes.min.toExponential()}), ${T}(${attributes.max.toExponential()}))`,
+        attributes.cacheKey);
+
+export const parseClipAttributes = (node: Graph.Node): ClipAttributes => createAttributeWithCacheKey(
+    {min: node.attributes.getFloat('min', MIN_CLIP), max: node.attributes.getFloat('max', MAX_CLIP)});
+
+export const clipV11 = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+  const attributes = generateClipAttributesFromInputs(handler, inputs);
+  return clip(handler, [inputs[0]], attributes);
+};
+
+const generateClipAttributesFromInputs = (handler: WebGpuInferenceHandler, inputs: Tensor[]): ClipAttributes => {
+  if (inputs.length >= 3 &&
+      (!handler.session.isInitializer(inputs[1].dataId) || !handler.session.isInitializer(inputs[2].dataId))) {
+    throw new Error('dynamic clip attributes are not allowed');
+  }
+
+  const min = (inputs.length >= 3) ? inputs[1].numberData[0] : MIN_CLIP;
+  const max = (inputs.length >= 3) ? inputs[2].numberData[0] : MAX_CLIP;
+  return createAttributeWithCacheKey({min, max});
+};
+
+export const cos = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Cos', builtinUnary('cos'));
+
+export interface AlphaAttributes extends AttributeWithCacheKey {
+  readonly alpha: number;
+}
+
+export const elu = (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: AlphaAttributes): Tensor[] =>
+    runElementwise(
+        handler, inputs, 'Elu',
+        (a, T) => `select((exp(${a}) - ${T}(1.0)) * ${T}(${attributes.alpha.toExponential()}), ${a}, ${a} >= ${
+            T}(0.0))`,
+        attributes.cacheKey);
+
+export const parseEluAttributes = (node: Graph.Node): AlphaAttributes =>
+    createAttributeWithCacheKey({alpha: node.attributes.getFloat('alpha', 1.0)});
+
+export const exp = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Exp', builtinUnary('exp'));
+
+export const floor = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Floor', builtinUnary('floor'));
+
+export const leakyRelu = (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: AlphaAttributes):
+    Tensor[] => runElementwise(
+        handler, inputs, 'LeakyRelu',
+        (a, T) => `select(${a} * ${T}(${attributes.alpha.toExponential()}), ${a}, ${a} >= ${T}(0.0))`,
+        attributes.cacheKey);
+
+export const parseLeakyReluAttributes = (node: Graph.Node): AlphaAttributes =>
+    createAttributeWithCacheKey({alpha: node.attributes.getFloat('alpha', 0.01)});
+
+export const log = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Log', builtinUnary('log'));
+
+export const neg = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Neg', a => `-${a}`);
+
+export const reciprocal = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Reciprocal', (a, T) => `${T}(1.0) / ${a}`);
+
+export const relu = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Relu', (a, T) => `max(${a}, ${T}(0.0))`);
+
+export const sigmoid = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Sigmoid', (a, T) => `${T}(1.0) / (${T}(1.0) + exp(-${a}))`);
+
+export const sin = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Sin', builtinUnary('sin'));
+
+export const sqrt = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Sqrt', builtinUnary('sqrt'));
+
+export const tan = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    runElementwise(handler, inputs, 'Tan', builtinUnary('tan'));
+
+// clamp the input so that exp() does not overflow, the same way as the WebGL backend does
+export const tanh = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => runElementwise(
+    handler, inputs, 'Tanh',
+    (a, T) => `(exp(${T}(2.0) * clamp(${a}, ${T}(-10.0), ${T}(10.0))) - ${T}(1.0)) / (exp(${T}(2.0) * clamp(${a}, ${
+        T}(-10.0), ${T}(10.0))) + ${T}(1.0))`);
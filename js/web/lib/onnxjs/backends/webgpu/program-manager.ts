@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Logger, Profiler} from '../../instrument';
+import {WebGpuBackend} from '../backend-webgpu';
+
+import {Artifact, GpuData, ProgramInfo} from './types';
+
+/**
+ * ProgramManager compiles ProgramInfo's into compute pipelines (cached as Artifacts) and records the dispatch of an
+ * artifact into the backend's command encoder.
+ */
+export class ProgramManager {
+  repo: Map<unknown, Artifact>;  // this should be per-session object
+
+  constructor(private backend: WebGpuBackend, public profiler: Readonly<Profiler>) {
+    this.repo = new Map();
+  }
+  getArtifact(key: unknown): Artifact|undefined {
+    return this.repo.get(key);
+  }
+  setArtifact(key: unknown, artifact: Artifact): void {
+    this.repo.set(key, artifact);
+  }
+  run(buildArtifact: Artifact, inputs: readonly GpuData[], outputs: readonly GpuData[]): void {
+    this.profiler.event('op', `ProgramManager.run ${buildArtifact.programInfo.name}`, () => {
+      const device = this.backend.device;
+      const entries: GPUBindGroupEntry[] = [];
+      for (const gpuData of inputs.concat(outputs)) {
+        entries.push({binding: entries.length, resource: {buffer: gpuData.buffer}});
+      }
+      const bindGroup =
+          device.createBindGroup({layout: buildArtifact.computePipeline.getBindGroupLayout(0), entries});
+
+      const {x, y, z} = buildArtifact.programInfo.dispatchGroup;
+      const pass = this.backend.getCommandEncoder().beginComputePass();
+      pass.setPipeline(buildArtifact.computePipeline);
+      pass.setBindGroup(0, bindGroup);
+      pass.dispatchWorkgroups(x, y ?? 1, z ?? 1);
+      pass.end();
+    });
+  }
+  dispose(): void {
+    // compute pipelines are garbage collected with the device. nothing to release explicitly.
+    this.repo = new Map();
+  }
+  build(programInfo: ProgramInfo): Artifact {
+    return this.profiler.event('backend', 'ProgramManager.build', () => {
+      const device = this.backend.device;
+      Logger.verbose('ProgramManager', `Compiling shader of ${programInfo.name}:\n${programInfo.shaderSource}`);
+      const module = device.createShaderModule({code: programInfo.shaderSource});
+      const computePipeline = device.createComputePipeline({layout: 'auto', compute: {module, entryPoint: 'main'}});
+      return {programInfo, computePipeline};
+    });
+  }
+}
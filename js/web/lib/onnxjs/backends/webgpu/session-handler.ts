@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {SessionHandler} from '../../backend';
+import {Graph} from '../../graph';
+import {Operator} from '../../operators';
+import {OpSet, resolveOperator} from '../../opset';
+import {Session} from '../../session';
+import {Tensor} from '../../tensor';
+import {WebGpuBackend} from '../backend-webgpu';
+
+import {GpuDataManager} from './gpu-data-manager';
+import {WebGpuInferenceHandler} from './inference-handler';
+import {WEBGPU_OP_RESOLVE_RULES} from './op-resolve-rules';
+import {ProgramManager} from './program-manager';
+import {GpuData} from './types';
+
+export class WebGpuSessionHandler implements SessionHandler {
+  programManager: ProgramManager;
+  dataManager: GpuDataManager;
+  initializerDataCache: Map<Tensor.Id, GpuData>;
+  initializers: Set<Tensor.Id>;
+
+  constructor(public readonly backend: WebGpuBackend, public readonly context: Session.Context) {
+    this.programManager = new ProgramManager(backend, this.context.profiler);
+    this.dataManager = new GpuDataManager(backend, this.context.profiler);
+    this.initializerDataCache = new Map();
+  }
+
+  createInferenceHandler() {
+    return new WebGpuInferenceHandler(this);
+  }
+  onGraphInitialized(graph: Graph): void {
+    const initializers = graph.getValues().filter(v => v.from === -1 && v.tensor).map(v => v.tensor!.dataId);
+    this.initializers = new Set(initializers);
+  }
+  isInitializer(tensorId: Tensor.Id): boolean {
+    return this.initializers ? this.initializers.has(tensorId) : false;
+  }
+  getGpuData(tensorId: Tensor.Id): GpuData|undefined {
+    return this.initializerDataCache.get(tensorId);
+  }
+  setGpuData(tensorId: Tensor.Id, gpuData: GpuData): void {
+    this.initializerDataCache.set(tensorId, gpuData);
+  }
+  dispose(): void {
+    this.backend.flush();
+    this.programManager.dispose();
+    this.initializerDataCache.forEach(gpuData => gpuData.buffer.destroy());
+    this.initializerDataCache = new Map();
+    this.dataManager.dispose();
+  }
+  resolve(node: Graph.Node, opsets: readonly OpSet[], graph: Graph): Operator {
+    const op = resolveOperator(node, opsets, WEBGPU_OP_RESOLVE_RULES);
+    return {impl: op.opImpl, context: op.opInit ? op.opInit(node, graph) : node};
+  }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../tensor';
+
+/**
+ * GpuData is a GPU storage buffer that holds the data of a tensor.
+ */
+export interface GpuData {
+  type: Tensor.DataType;
+  dims: readonly number[];
+  buffer: GPUBuffer;
+  /**
+   * the size of the buffer in bytes. It may be larger than the tensor data because of alignment and pooling.
+   */
+  bufferSize: number;
+}
+
+export interface TensorInfo {
+  dims: readonly number[];
+  type: Tensor.DataType;
+}
+
+/**
+ * the number of workgroups to dispatch in each dimension
+ */
+export interface DispatchGroup {
+  x: number;
+  y?: number;
+  z?: number;
+}
+
+export interface ProgramMetadata {
+  /**
+   * the name of the program. used for debugging and profiling
+   */
+  name: string;
+  /**
+   * a string representing the program's attributes. programs with the same name, input shapes and cache hint share the
+   * same compute pipeline.
+   */
+  cacheHint?: string;
+}
+
+/**
+ * A set of data that represent a compute shader program.
+ *
+ * The inputs are bound as read-only storage buffers at binding 0..N-1 of group 0, and the outputs are bound as
+ * read-write storage buffers at binding N..N+M-1, in the same order as they are declared.
+ */
+export interface ProgramInfo extends ProgramMetadata {
+  /**
+   * information of the output tensors
+   */
+  outputs: readonly TensorInfo[];
+  /**
+   * the WGSL source of the compute shader. entry point must be `main`.
+   */
+  shaderSource: string;
+  /**
+   * the workgroups to dispatch
+   */
+  dispatchGroup: DispatchGroup;
+}
+
+export interface ProgramInfoLoader extends ProgramMetadata {
+  /**
+   * a function to get the program info
+   */
+  get(): ProgramInfo;
+}
+
+export interface Artifact {
+  programInfo: ProgramInfo;
+  computePipeline: GPUComputePipeline;
+}
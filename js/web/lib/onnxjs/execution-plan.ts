@@ -140,12 +140,7 @@ export class ExecutionPlan {
         if (outputTensor === undefined) {
           throw new Error(`required output [${outputIndex}] does not have value`);
         }
-        if (outputIndex === 0) {
-          await outputTensor.getData();
-        } else {
-          // eslint-disable-next-line no-unused-expressions
-          outputTensor.data;
-        }
+        await outputTensor.getData();
         output.push(outputTensor);
       }
       Logger.verbose('ExecPlan', 'disposing of inferenceHandler');
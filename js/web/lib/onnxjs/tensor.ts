@@ -132,7 +132,10 @@ export class Tensor {
    */
   async getData(): Promise<TensorData> {
     if (this.cache === undefined) {
-      this.cache = await this.asyncDataProvider!(this.dataId);
+      if (!this.asyncDataProvider) {
+        return this.data;
+      }
+      this.cache = await this.asyncDataProvider(this.dataId);
     }
     return this.cache;
   }
@@ -49,6 +49,11 @@ export interface OrtWasmModule extends EmscriptenModule {
 
   //#region config
   mainScriptUrlOrBlob?: string|Blob;
+  /**
+   * number of Web Workers to start together with the module. Read by the threaded build as its
+   * PTHREAD_POOL_SIZE, so the intra-op thread pool never waits for a worker to be spawned.
+   */
+  numThreads?: number;
   //#endregion
 }
 
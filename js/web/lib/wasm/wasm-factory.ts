@@ -139,6 +139,10 @@ export const initializeWebAssembly = async(flags: Env.WebAssemblyFlags): Promise
     };
 
     if (!BUILD_DEFS.DISABLE_WASM_THREAD && useThreads) {
+      // Pre-spawn one worker per thread. Workers stay alive for the lifetime of the module and are reused by
+      // the intra-op thread pool created in OrtInit(), which shares the module memory via SharedArrayBuffer.
+      config.numThreads = numThreads;
+
       if (typeof Blob === 'undefined') {
         config.mainScriptUrlOrBlob = path.join(__dirname, 'ort-wasm-threaded.js');
       } else {
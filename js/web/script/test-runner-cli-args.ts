@@ -34,6 +34,7 @@ Options:
  -b=<...>, --backend=<...>     Specify one or more backend(s) to run the test upon.
                                  Backends can be one or more of the following, splitted by comma:
                                    webgl
+                                   webgpu     (experimental, not run by default)
                                    wasm
  -e=<...>, --env=<...>         Specify the environment to run the test. Should be one of the following:
                                  chrome     (default)
@@ -97,7 +98,7 @@ Examples:
 
 export declare namespace TestRunnerCliArgs {
   type Mode = 'suite0'|'suite1'|'model'|'unittest'|'op';
-  type Backend = 'cpu'|'webgl'|'wasm'|'onnxruntime';
+  type Backend = 'cpu'|'webgl'|'webgpu'|'wasm'|'onnxruntime';
   type Environment = 'chrome'|'edge'|'firefox'|'electron'|'safari'|'node'|'bs';
   type BundleMode = 'prod'|'dev'|'perf';
 }
@@ -335,11 +336,14 @@ export function parseTestRunnerCliArgs(cmdlineArgs: string[]): TestRunnerCliArgs
   // Option: -b=<...>, --backend=<...>
   const browserBackends = ['webgl', 'wasm'];
   const nodejsBackends = ['cpu', 'wasm'];
+  // backends that are only tested when explicitly specified
+  const optionalBrowserBackends = ['webgpu'];
   const backendArgs = args.backend || args.b;
   const backend =
       (typeof backendArgs !== 'string') ? (env === 'node' ? nodejsBackends : browserBackends) : backendArgs.split(',');
   for (const b of backend) {
-    if ((env !== 'node' && browserBackends.indexOf(b) === -1) || (env === 'node' && nodejsBackends.indexOf(b) === -1)) {
+    if ((env !== 'node' && browserBackends.indexOf(b) === -1 && optionalBrowserBackends.indexOf(b) === -1) ||
+        (env === 'node' && nodejsBackends.indexOf(b) === -1)) {
       throw new Error(`backend ${b} is not supported in env ${env}`);
     }
   }
@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 //TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
@@ -47,6 +48,30 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: S* = S' + S
     const int all_sequence_length = past_sequence_length + sequence_length;
 
+    bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
+
+    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
+    gsl::span<const int64_t> mask_index_dims = mask_index != nullptr ? mask_index->Shape().GetDims() : gsl::span<const int64_t>{};
+    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
+    T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
+
+    const T* extra_add_qk_data = nullptr;
+    if (extra_add_qk != nullptr) {
+      extra_add_qk_data = extra_add_qk->template Data<T>();
+    }
+
+    // For long sequences, the attention probs of BxNxSxS* dominate the memory traffic. The fused kernel computes
+    // the softmax block by block and never materializes them. Only one additive bias is supported by the kernel.
+    if constexpr (std::is_same<T, float>::value) {
+      if (all_sequence_length >= kMinSequenceLengthForFusedAttention &&
+          !(extra_add_qk_data != nullptr && mask_index != nullptr)) {
+        return ApplyFusedAttention(Q, K, V, mask_index_data, mask_index_dims, has_unidirectional, past_data, present_data,
+                                   output->template MutableData<T>(), batch_size, sequence_length, past_sequence_length,
+                                   qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size,
+                                   extra_add_qk_data, allocator, tp);
+      }
+    }
+
     // Compute the attention score. It does 2 things:
     //         I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
     //                                           1 x mask_data(B, N, S, S*)
@@ -55,8 +80,6 @@ class AttentionCPUBase : public AttentionBase {
     auto attention_probs = allocator->Alloc(attention_probs_bytes);
     BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
 
-    bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
-
     void* mask_data = nullptr;
     if (mask_index != nullptr || has_unidirectional) {
       size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * all_sequence_length * sizeof(T);
@@ -65,16 +88,6 @@ class AttentionCPUBase : public AttentionBase {
     }
     BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
 
-    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
-    gsl::span<const int64_t> mask_index_dims = mask_index != nullptr ? mask_index->Shape().GetDims() : gsl::span<const int64_t>{};
-    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
-    T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
-
-    const T* extra_add_qk_data = nullptr;
-    if (extra_add_qk != nullptr) {
-      extra_add_qk_data = extra_add_qk->template Data<T>();
-    }
-
     ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, K,
                              mask_index_data, mask_index_dims, static_cast<T*>(mask_data), has_unidirectional,
                              batch_size, sequence_length, past_sequence_length, qk_head_size == 0 ? v_head_size : qk_head_size,
@@ -93,6 +106,101 @@ class AttentionCPUBase : public AttentionBase {
   }
 
  private:
+  // Total sequence length from which the fused attention kernel of MLAS is used for float.
+  static constexpr int kMinSequenceLengthForFusedAttention = 1024;
+
+  // Computes the attention with MlasFlashAttention:
+  //   output(B, S, N, H) = Softmax(1/sqrt(H) x Q x K' + mask_data or extra_add_qk) x V
+  // Past and current K and V are concatenated into present first, since the kernel reads the whole K and V.
+  Status ApplyFusedAttention(const float* Q,                             // Q data. Its size is BxNxSxH
+                             const float* K,                             // K data. Its size is BxNxSxH
+                             const float* V,                             // V value with size BxNxSxH
+                             const int32_t* mask_index,                  // mask index. nullptr if no mask
+                             gsl::span<const int64_t> mask_index_dims,   // mask index shape
+                             bool has_unidirectional,                    // has unidirectional mask
+                             const float* past,                          // past state
+                             float* present,                             // present state
+                             float* output,                              // output with size BxSxNxH
+                             int batch_size,                             // batch size
+                             int sequence_length,                        // sequence length
+                             int past_sequence_length,                   // sequence length of past state
+                             int qk_head_size,                           // head size of Q and K
+                             int v_head_size,                            // head size of V
+                             const float* extra_add_qk_data,             // extra add matrix with shape BxNxSxS*
+                             AllocatorPtr allocator,                     // allocator for temp buffers
+                             ThreadPool* tp) const {
+    const int all_sequence_length = past_sequence_length + sequence_length;  // S* = S' + S
+
+    if (nullptr != present) {
+      const size_t k_past_chunk_length = static_cast<size_t>(past_sequence_length) * qk_head_size;
+      const size_t k_present_chunk_length = static_cast<size_t>(all_sequence_length) * qk_head_size;
+      const size_t v_past_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+      const size_t v_present_chunk_length = static_cast<size_t>(all_sequence_length) * v_head_size;
+      const float* past_v = past != nullptr ? past + batch_size * num_heads_ * k_past_chunk_length : nullptr;
+      float* present_v = present + batch_size * num_heads_ * k_present_chunk_length;
+
+      const double cost = static_cast<double>(k_present_chunk_length + v_present_chunk_length);
+      ThreadPool::TryParallelFor(tp, batch_size * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          ConcatStateChunk(past, K + (k_present_chunk_length - k_past_chunk_length) * i, present,
+                           k_past_chunk_length, k_present_chunk_length, i);
+          ConcatStateChunk(past_v, V + (v_present_chunk_length - v_past_chunk_length) * i, present_v,
+                           v_past_chunk_length, v_present_chunk_length, i);
+        }
+      });
+
+      K = present;
+      V = present_v;
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMETERS parameters;
+    parameters.BatchSize = static_cast<size_t>(batch_size);
+    parameters.NumHeads = static_cast<size_t>(num_heads_);
+    parameters.QSequenceLength = static_cast<size_t>(sequence_length);
+    parameters.KvSequenceLength = static_cast<size_t>(all_sequence_length);
+    parameters.QkHeadSize = static_cast<size_t>(qk_head_size);
+    parameters.VHeadSize = static_cast<size_t>(v_head_size);
+    parameters.Scale = 1.0f / sqrt(static_cast<float>(qk_head_size));
+    parameters.Causal = has_unidirectional;
+    parameters.Query = Q;
+    parameters.Key = K;
+    parameters.Value = V;
+    parameters.Bias = nullptr;
+    parameters.BiasBatchStride = 0;
+    parameters.BiasHeadStride = 0;
+    parameters.BiasRowStride = 0;
+    parameters.Output = output;
+
+    // The unidirectional mask is applied by the kernel, so mask data is only needed for mask_index.
+    // It is broadcast to all heads: (Bx)SxS* -> (BxNx)SxS*
+    void* mask_data = nullptr;
+    if (mask_index != nullptr) {
+      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * all_sequence_length * sizeof(float);
+      mask_data = allocator->Alloc(mask_data_bytes);
+      memset(mask_data, 0, mask_data_bytes);
+      PrepareMask(mask_index, mask_index_dims, static_cast<float*>(mask_data), has_unidirectional,
+                  batch_size, sequence_length, past_sequence_length);
+
+      parameters.Bias = static_cast<const float*>(mask_data);
+      parameters.BiasBatchStride = static_cast<size_t>(sequence_length) * all_sequence_length;
+      parameters.BiasRowStride = static_cast<size_t>(all_sequence_length);
+    } else if (extra_add_qk_data != nullptr) {
+      parameters.Bias = extra_add_qk_data;
+      parameters.BiasHeadStride = static_cast<size_t>(sequence_length) * all_sequence_length;
+      parameters.BiasBatchStride = num_heads_ * parameters.BiasHeadStride;
+      parameters.BiasRowStride = static_cast<size_t>(all_sequence_length);
+    }
+    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+
+    size_t workspace_bytes = SafeInt<size_t>(MlasFlashAttentionGetWorkspaceSize(&parameters, tp)) * sizeof(float);
+    auto workspace = allocator->Alloc(workspace_bytes);
+    BufferUniquePtr workspace_buffer(workspace, BufferDeleter(allocator));
+
+    MlasFlashAttention(&parameters, static_cast<float*>(workspace), tp);
+
+    return Status::OK();
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
   //                                    1 x mask_data(B, N, S, S*)
@@ -122,15 +230,13 @@ class AttentionCPUBase : public AttentionBase {
     {
       if (mask_data != nullptr) {
         PrepareMask(mask_index, mask_index_dims, mask_data, has_unidirectional, batch_size, sequence_length, past_sequence_length);
-      } else {  // no any mask
-        memset(attention_probs, 0, static_cast<size_t>(batch_size) * num_heads_ * sequence_length * all_sequence_length * sizeof(T));
       }
 
       const int loop_len = batch_size * num_heads_;
       const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
 
-      // The cost of Gemm
-      const double cost = static_cast<double>(head_size) * sequence_length * all_sequence_length;
+      // The cost of Gemm and Softmax
+      const double cost = static_cast<double>(head_size + 4) * sequence_length * all_sequence_length;
 
       ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
         for (std::ptrdiff_t i = begin; i != end; ++i) {
@@ -140,51 +246,36 @@ class AttentionCPUBase : public AttentionBase {
           const int mask_offset = batch_index * sequence_length * all_sequence_length;
           T* output = attention_probs + output_offset;
 
-          // Broadcast mask data: (Bx)SxS* -> (BxNx)SxS*
-          if (mask_data != nullptr) {
-            memcpy(output, mask_data + mask_offset, sequence_length * all_sequence_length * sizeof(T));
-          }
-
           const T* k = K + input_chunk_length * i;
           if (nullptr != present) {
             // Concatenate past_K and K : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
             k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
           }
 
-          // Compute Q*K' + AttentionMask
+          // Compute Q*K'
           //                     original                 transposed             each iteration
           // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
           // B: K'               (B x N x) S* x H         (B x N x) H x S*       H x S*
           // C: attention_probs  (B x N x) S x S*         (B x N x) S x S*       S x S*
           math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, all_sequence_length, head_size, alpha,
-                                    Q + input_chunk_length * i, k, 1.0,
+                                    Q + input_chunk_length * i, k, 0.0,
                                     output, nullptr);
 
-          // Fix unidirectional mask to be parity with huggingface implementation.
-          if (has_unidirectional && mask_data != nullptr) {
-            for (int s_i = 0; s_i < sequence_length - 1; s_i++) {
-              for (int m_i = past_sequence_length + s_i + 1; m_i < all_sequence_length; m_i++) {
-                int j = s_i * all_sequence_length + m_i;
-                output[j] = mask_data[mask_offset + j];
-              }
-            }
-          }
-
           if (extra_add_qk_data != nullptr) {
             for (int j = 0; j < sequence_length * all_sequence_length; j++) {
               output[j] += extra_add_qk_data[output_offset + j];
             }
           }
+
+          // attention_probs(B, N, S, S*) = Softmax(attention_probs + AttentionMask), with the mask data broadcast
+          // from (Bx)SxS* to (BxNx)SxS*. The unidirectional mask excludes the future positions, which matches the
+          // huggingface implementation that overwrites their scores with the mask value.
+          const T* mask = (mask_data != nullptr) ? mask_data + mask_offset : nullptr;
+          ComputeAttentionSoftmaxMaskedInplace(output, mask, sequence_length, all_sequence_length,
+                                               has_unidirectional, past_sequence_length, nullptr);
         }
       });
     }
-
-    //  attention_probs(B, N, S, S*) = Softmax(attention_probs)
-    {
-      const int N = batch_size * num_heads_ * sequence_length;
-      const int D = all_sequence_length;
-      ComputeAttentionSoftmaxInplace(attention_probs, N, D, tp);
-    }
   }
 
   template <typename T>
@@ -60,6 +60,31 @@ inline void ComputeAttentionSoftmaxInplace(float* score, int N, int D, ThreadPoo
   MlasComputeSoftmax(score, score, N, D, false, tp);
 }
 
+// Adds the mask (NxD, or nullptr) to the score and computes its softmax in place, where row i only attends to
+// the columns up to i + causal_offset if causal. The masked columns of a causal row have a probability of 0.
+template <typename T>
+void ComputeAttentionSoftmaxMaskedInplace(T* score, const T* mask, int N, int D, bool causal, int causal_offset,
+                                          ThreadPool* tp) {
+  for (int i = 0; i < N; i++) {
+    T* x = score + static_cast<size_t>(i) * D;
+    const int valid_length = causal ? std::min(D, i + causal_offset + 1) : D;
+    for (int j = 0; j < D; j++) {
+      if (j >= valid_length) {
+        x[j] = static_cast<T>(-std::numeric_limits<float>::infinity());
+      } else if (mask != nullptr) {
+        x[j] += mask[static_cast<size_t>(i) * D + j];
+      }
+    }
+  }
+  ComputeAttentionSoftmaxInplace(score, N, D, tp);
+}
+
+template <>
+inline void ComputeAttentionSoftmaxMaskedInplace(float* score, const float* mask, int N, int D, bool causal,
+                                                 int causal_offset, ThreadPool* tp) {
+  MlasComputeSoftmaxMasked(score, score, N, D, 1.0f, mask, N, causal, causal_offset, false, tp);
+}
+
 template <typename T>
 void PrepareMask(const int32_t* mask_index,
                  gsl::span<const int64_t> mask_index_dims,
@@ -5,11 +5,32 @@
 #include "embed_layer_norm_helper.h"
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
 
+#include <algorithm>
 #include <atomic>
 
 namespace onnxruntime {
 namespace contrib {
+
+// Number of tokens ahead of the normalized one whose word embedding row is prefetched.
+static constexpr ptrdiff_t kEmbedPrefetchDistance = 2;
+
+// Starts loading the first cache lines of an embedding row, the hardware prefetcher follows with the rest.
+template <typename T>
+static inline void PrefetchRow(const T* row, int64_t row_size) {
+#if defined(__GNUC__)
+  const auto* bytes = reinterpret_cast<const char*>(row);
+  const int64_t prefetch_bytes = std::min<int64_t>(row_size * static_cast<int64_t>(sizeof(T)), 512);
+  for (int64_t offset = 0; offset < prefetch_bytes; offset += 64) {
+    __builtin_prefetch(bytes + offset);
+  }
+#else
+  ORT_UNUSED_PARAMETER(row);
+  ORT_UNUSED_PARAMETER(row_size);
+#endif
+}
+
 // These ops are internal-only, so register outside of onnx
 #define REGISTER_KERNEL_TYPED(T)                                  \
   ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
@@ -81,19 +102,47 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
   T* output_data = output->template MutableData<T>();
   T* embedding_sum_data = (embedding_sum != nullptr) ? embedding_sum->template MutableData<T>() : nullptr;
 
-  // Calculate output
+  const int32_t* mask_data = (nullptr == mask) ? nullptr : mask->template Data<int32_t>();
+  int32_t* mask_index_data = mask_index->template MutableData<int32_t>();
+  if (sequence_length == 0) {
+    memset(mask_index_data, 0, batch_size * sizeof(int32_t));
+  }
+
+  // Gather, sum and normalize the embeddings of each token in a single vectorized pass over the rows, the mask index
+  // of a sequence is counted with its first token.
   {
     std::atomic_bool failed{false};
 
     int n = batch_size * sequence_length;
     concurrency::ThreadPool::TryBatchParallelFor(context->GetOperatorThreadPool(), n, [=, &failed](ptrdiff_t index) {
+      if (index % sequence_length == 0) {
+        int32_t cur_sum = 0;
+        if (nullptr != mask_data) {
+          const int32_t* cur_mask_data = mask_data + index;
+          for (int s = 0; s < sequence_length; ++s) {
+            if (cur_mask_data[s] == 1) {
+              cur_sum += cur_mask_data[s];
+            }
+          }
+        }
+        mask_index_data[index / sequence_length] = cur_sum;
+      }
+
+      // The word embedding rows are picked at random from a large table, start loading the row of a next token.
+      if (index + kEmbedPrefetchDistance < n) {
+        int next_word_col_index = input_ids_data[index + kEmbedPrefetchDistance];
+        if (next_word_col_index >= 0 && next_word_col_index < word_embedding_length) {
+          PrefetchRow(word_embedding_data + static_cast<int64_t>(next_word_col_index) * hidden_size, hidden_size);
+        }
+      }
+
       int word_col_index = input_ids_data[index];
       if (word_col_index < 0 || word_col_index >= word_embedding_length) {
         failed.store(true, std::memory_order_release);
         return;
       }
       int position_col_index = (position_ids_data == nullptr) ? index % sequence_length : position_ids_data[index];
-      if (position_col_index >= position_embedding_length) {
+      if (position_col_index < 0 || position_col_index >= position_embedding_length) {
         failed.store(true, std::memory_order_release);
         return;
       }
@@ -107,35 +156,26 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
       }
 
       T* y = output_data + index * hidden_size;
-      T* y1 = nullptr;
-      if (embedding_sum_data != nullptr) {
-        y1 = embedding_sum_data + index * hidden_size;
-      }
       const T* input_word_embedding = word_embedding_data + word_col_index * hidden_size;
       const T* input_position_embedding = position_embedding_data + position_col_index * hidden_size;
       const T* input_segment_embedding = (nullptr == segment_embedding_data) ? nullptr : segment_embedding_data + segment_col_index * hidden_size;
 
-      T sum = static_cast<T>(0);
-      for (int i = 0; i < hidden_size; i++) {
-        T subtotal = input_word_embedding[i] + input_position_embedding[i];
-        if (nullptr != segment_embedding_data)
-          subtotal += input_segment_embedding[i];
-        y[i] = subtotal;
-        if (y1 != nullptr) {
-          y1[i] = subtotal;
+      if (embedding_sum_data != nullptr) {
+        // The sum is an output too, normalize from it.
+        T* y1 = embedding_sum_data + index * hidden_size;
+        auto sum = EigenVectorArrayMap<T>(y1, hidden_size);
+        sum = ConstEigenVectorArrayMap<T>(input_word_embedding, hidden_size) +
+              ConstEigenVectorArrayMap<T>(input_position_embedding, hidden_size);
+        if (nullptr != input_segment_embedding) {
+          sum += ConstEigenVectorArrayMap<T>(input_segment_embedding, hidden_size);
         }
-        sum += subtotal;
-      }
-      T mean = sum / hidden_size;
-      sum = 0;
-      for (int i = 0; i < hidden_size; i++) {
-        T a = y[i] - mean;
-        y[i] = a;
-        sum += a * a;
-      }
-      T e = sqrt(sum / hidden_size + static_cast<T>(epsilon()));
-      for (int i = 0; i < hidden_size; i++) {
-        y[i] = y[i] / e * gamma_data[i] + beta_data[i];
+        MlasLayerNormalization(y1, nullptr, nullptr, gamma_data, beta_data, y, nullptr, nullptr,
+                               1, static_cast<size_t>(hidden_size), epsilon(), false, nullptr);
+      } else {
+        // The position and segment rows are added as the skip and bias of the normalization.
+        MlasLayerNormalization(input_word_embedding, input_position_embedding, input_segment_embedding,
+                               gamma_data, beta_data, y, nullptr, nullptr,
+                               1, static_cast<size_t>(hidden_size), epsilon(), false, nullptr);
       }
     }, 0);
 
@@ -144,24 +184,6 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
     }
   }
 
-  // Calculate mask
-  if (nullptr != mask) {
-    const int32_t* mask_data = mask->template Data<int32_t>();
-    int32_t* mask_index_data = mask_index->template MutableData<int32_t>();
-    for (int b = 0; b < batch_size; b++) {
-      int32_t cur_sum = 0;
-      const int32_t* cur_mask_data = mask_data + (static_cast<int64_t>(b) * sequence_length);
-      for (int s = 0; s < sequence_length; ++s) {
-        if (cur_mask_data[s] == 1) {
-          cur_sum += cur_mask_data[s];
-        }
-      }
-      mask_index_data[b] = cur_sum;
-    }
-  } else {
-    memset(mask_index->template MutableData<int32_t>(), 0, batch_size * sizeof(int32_t));
-  }
-
   return Status::OK();
 }
 
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "packed_attention_helper.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class PackedAttention final : public OpKernel {
+ public:
+  explicit PackedAttention(const OpKernelInfo& info) : OpKernel(info) {
+    int64_t num_heads = 0;
+    ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+    num_heads_ = static_cast<int>(num_heads);
+    is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int num_heads_;
+  bool is_unidirectional_;
+};
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    PackedAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    PackedAttention<float>);
+
+template <typename T>
+Status PackedAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* cumulative_sequence_length = context->Input<Tensor>(3);
+
+  ORT_RETURN_IF_ERROR(packed_attention_helper::CheckInputs(input->Shape(), weights->Shape(), bias->Shape(),
+                                                           cumulative_sequence_length->Shape(), num_heads_));
+
+  const int token_count = static_cast<int>(input->Shape()[0]);
+  const int input_hidden_size = static_cast<int>(input->Shape()[1]);
+  const int hidden_size = static_cast<int>(bias->Shape()[0]) / 3;
+  const int head_size = hidden_size / num_heads_;
+  const int batch_size = static_cast<int>(cumulative_sequence_length->Shape()[0]) - 1;
+
+  const int32_t* cumulative_data = cumulative_sequence_length->template Data<int32_t>();
+  int max_sequence_length = 0;
+  ORT_RETURN_IF_ERROR(packed_attention_helper::CheckCumulativeSequenceLength(
+      cumulative_data, batch_size, token_count, max_sequence_length));
+
+  Tensor* output = context->Output(0, {token_count, hidden_size});
+  if (token_count == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  // Compute Q, K, V of all the tokens with a single GEMM, as they do not depend on the sequence:
+  //   qkv(T, 3NH) = input(T, D) x weights(D, 3NH) + bias(3NH)
+  const int qkv_size = 3 * hidden_size;
+  auto qkv_data = allocator->Alloc(SafeInt<size_t>(token_count) * qkv_size * sizeof(T));
+  BufferUniquePtr qkv_buffer(qkv_data, BufferDeleter(allocator));
+  T* qkv = reinterpret_cast<T*>(qkv_data);
+
+  const T* bias_data = bias->template Data<T>();
+  for (int t = 0; t < token_count; t++) {
+    memcpy(qkv + static_cast<size_t>(t) * qkv_size, bias_data, qkv_size * sizeof(T));
+  }
+
+  math::Gemm<T, ThreadPool>(CblasNoTrans, CblasNoTrans, token_count, qkv_size, input_hidden_size, 1.0f,
+                            input->template Data<T>(), weights->template Data<T>(), 1.0f, qkv, tp);
+
+  // The scores of each sequence and head are S_b x S_b, so no space is spent on padding either.
+  std::vector<size_t> scores_offsets(batch_size + 1, 0);
+  for (int b = 0; b < batch_size; b++) {
+    const size_t sequence_length = static_cast<size_t>(cumulative_data[b + 1] - cumulative_data[b]);
+    scores_offsets[b + 1] = scores_offsets[b] + SafeInt<size_t>(num_heads_) * sequence_length * sequence_length;
+  }
+
+  auto scores_data = allocator->Alloc(SafeInt<size_t>(scores_offsets[batch_size]) * sizeof(T));
+  BufferUniquePtr scores_buffer(scores_data, BufferDeleter(allocator));
+  T* scores = reinterpret_cast<T*>(scores_data);
+
+  T* output_data = output->template MutableData<T>();
+  const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+  const double cost = static_cast<double>(max_sequence_length) * max_sequence_length * head_size;
+
+  ThreadPool::TryParallelFor(tp, static_cast<std::ptrdiff_t>(batch_size) * num_heads_, cost,
+                             [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i / num_heads_);
+      const int head_index = static_cast<int>(i % num_heads_);
+      const int token_start = cumulative_data[batch_index];
+      const int sequence_length = cumulative_data[batch_index + 1] - token_start;
+      if (sequence_length == 0) {
+        continue;
+      }
+
+      const T* q = qkv + static_cast<size_t>(token_start) * qkv_size + head_index * head_size;
+      const T* k = q + hidden_size;
+      const T* v = k + hidden_size;
+      T* probs = scores + scores_offsets[batch_index] +
+                 static_cast<size_t>(head_index) * sequence_length * sequence_length;
+
+      // probs(S, S) = 1/sqrt(H) x Q(S, H) x K'(H, S), where the rows of Q and K are strided by 3NH.
+      MlasGemm(CblasNoTrans, CblasTrans, sequence_length, sequence_length, head_size, alpha,
+               q, qkv_size, k, qkv_size, 0.0f, probs, sequence_length, nullptr);
+
+      if (is_unidirectional_) {
+        for (int s = 0; s < sequence_length - 1; s++) {
+          std::fill_n(probs + static_cast<size_t>(s) * sequence_length + s + 1, sequence_length - s - 1, -10000.0f);
+        }
+      }
+
+      MlasComputeSoftmax(probs, probs, sequence_length, sequence_length, false, nullptr);
+
+      // output(S, H) = probs(S, S) x V(S, H), written to the columns of the head in the (T, NH) output.
+      MlasGemm(CblasNoTrans, CblasNoTrans, sequence_length, head_size, sequence_length, 1.0f,
+               probs, sequence_length, v, qkv_size, 0.0f,
+               output_data + static_cast<size_t>(token_start) * hidden_size + head_index * head_size, hidden_size,
+               nullptr);
+    }
+  });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifndef SHARED_PROVIDER
+#include "core/common/common.h"
+#include "core/framework/tensor_shape.h"
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+namespace packed_attention_helper {
+
+// Checks the shapes of the inputs of PackedAttention.
+inline Status CheckInputs(const TensorShape& input_shape,
+                          const TensorShape& weights_shape,
+                          const TensorShape& bias_shape,
+                          const TensorShape& cumulative_sequence_length_shape,
+                          int num_heads) {
+  // Input shapes:
+  //   input                      : (token_count, input_hidden_size)
+  //   weights                    : (input_hidden_size, 3 * hidden_size)
+  //   bias                       : (3 * hidden_size)
+  //   cumulative_sequence_length : (batch_size + 1)
+  const auto& dims = input_shape.GetDims();
+  if (dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'input' is expected to have 2 dimensions, got ",
+                           dims.size());
+  }
+
+  const auto& weights_dims = weights_shape.GetDims();
+  if (weights_dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'weights' is expected to have 2 dimensions, got ",
+                           weights_dims.size());
+  }
+  if (weights_dims[0] != dims[1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 1 dimension 0 should have same length as dimension 1 of input 0");
+  }
+
+  const auto& bias_dims = bias_shape.GetDims();
+  if (bias_dims.size() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'bias' is expected to have 1 dimension, got ",
+                           bias_dims.size());
+  }
+  if (bias_dims[0] != weights_dims[1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'bias' dimension 0 should have same length as dimension 1 of input 'weights'");
+  }
+  if (bias_dims[0] % 3 != 0 || (bias_dims[0] / 3) % num_heads != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'bias' dimension 0 should be 3 times of hidden size, which is divisible by num_heads");
+  }
+
+  const auto& cumulative_dims = cumulative_sequence_length_shape.GetDims();
+  if (cumulative_dims.size() != 1 || cumulative_dims[0] < 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'cumulative_sequence_length' is expected to have shape (batch_size + 1)");
+  }
+
+  return Status::OK();
+}
+
+// Checks that the sequences cover the tokens in order, and returns the length of the longest one.
+inline Status CheckCumulativeSequenceLength(const int32_t* cumulative_sequence_length,
+                                            int batch_size,
+                                            int64_t token_count,
+                                            int& max_sequence_length) {
+  if (cumulative_sequence_length[0] != 0 || cumulative_sequence_length[batch_size] != token_count) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'cumulative_sequence_length' shall start with 0 and end with the token count ",
+                           token_count);
+  }
+
+  max_sequence_length = 0;
+  for (int b = 0; b < batch_size; b++) {
+    const int sequence_length = cumulative_sequence_length[b + 1] - cumulative_sequence_length[b];
+    if (sequence_length < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'cumulative_sequence_length' shall be non-decreasing");
+    }
+    max_sequence_length = std::max(max_sequence_length, sequence_length);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace packed_attention_helper
+}  // namespace contrib
+}  // namespace onnxruntime
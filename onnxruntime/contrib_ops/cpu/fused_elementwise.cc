@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace contrib {
+
+// Runs a chain of element-wise operations tile by tile. The first operation reads the input of the chain and writes
+// the tile of the output, the next ones update that tile in place while it is in the cache, so the tensor is read
+// and written once whatever the length of the chain.
+class FusedElementwise final : public OpKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK());
+    ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK());
+    std::vector<int64_t> operand_first = info.GetAttrsOrDefault<int64_t>("operand_first",
+                                                                         std::vector<int64_t>(ops.size(), 0));
+    ORT_ENFORCE(operands.size() == ops.size() && operand_first.size() == ops.size(),
+                "ops, operands and operand_first must have the same size");
+
+    const int64_t input_count = static_cast<int64_t>(info.GetInputCount());
+
+    for (size_t i = 0; i < ops.size(); i++) {
+      Step step{};
+      step.operand = static_cast<int>(operands[i]);
+      step.operand_first = operand_first[i] != 0;
+
+      if (ops[i] == "Add") {
+        step.kind = MlasEltwiseAdd;
+      } else if (ops[i] == "Sub") {
+        step.kind = MlasEltwiseSub;
+      } else if (ops[i] == "Mul") {
+        step.kind = MlasEltwiseMul;
+      } else if (ops[i] == "Div") {
+        step.kind = MlasEltwiseDiv;
+      } else if (ops[i] == "Relu") {
+        step.activation.ActivationKind = MlasReluActivation;
+      } else if (ops[i] == "Sigmoid") {
+        step.activation.ActivationKind = MlasLogisticActivation;
+      } else if (ops[i] == "Tanh") {
+        step.activation.ActivationKind = MlasTanhActivation;
+      } else {
+        ORT_THROW("FusedElementwise: unsupported operation ", ops[i]);
+      }
+
+      const bool is_binary = ops[i] == "Add" || ops[i] == "Sub" || ops[i] == "Mul" || ops[i] == "Div";
+      if (is_binary) {
+        ORT_ENFORCE(operands[i] >= 0 && operands[i] < input_count, "FusedElementwise: invalid operand ", operands[i]);
+      } else {
+        ORT_ENFORCE(operands[i] == -1, "FusedElementwise: ", ops[i], " takes no operand");
+      }
+
+      steps_.push_back(step);
+    }
+
+    ORT_ENFORCE(!steps_.empty(), "FusedElementwise: ops must not be empty");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Step {
+    int operand;  // -1 for unary operations
+    bool operand_first;
+    MLAS_ELTWISE_KIND kind;
+    MLAS_ACTIVATION activation;
+  };
+
+  // Number of elements of a tile, small enough for the tile to stay in the L1 cache.
+  static constexpr size_t kTileSize = 2048;
+
+  std::vector<Step> steps_;
+};
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const TensorShape& shape = X->Shape();
+  const size_t count = static_cast<size_t>(shape.Size());
+
+  // The operands either have the shape of the input or are broadcast from a single element.
+  const int input_count = context->InputCount();
+  std::vector<const float*> operand_data(input_count);
+  std::vector<bool> operand_is_scalar(input_count);
+  for (int i = 0; i < input_count; i++) {
+    const Tensor* operand = context->Input<Tensor>(i);
+    const size_t operand_count = static_cast<size_t>(operand->Shape().Size());
+    ORT_RETURN_IF_NOT(operand_count == count || operand_count == 1,
+                      "FusedElementwise: input ", i, " with shape ", operand->Shape(),
+                      " must have the shape of input 0 ", shape, " or a single element");
+    operand_data[i] = operand->Data<float>();
+    operand_is_scalar[i] = operand_count == 1 && count != 1;
+  }
+
+  Tensor* Y = context->Output(0, shape);
+  if (count == 0) {
+    return Status::OK();
+  }
+
+  const float* x_data = X->Data<float>();
+  float* y_data = Y->MutableData<float>();
+
+  const std::ptrdiff_t tile_count = static_cast<std::ptrdiff_t>((count + kTileSize - 1) / kTileSize);
+  const TensorOpCost cost{static_cast<double>(kTileSize * sizeof(float) * input_count),
+                          static_cast<double>(kTileSize * sizeof(float)),
+                          static_cast<double>(kTileSize * steps_.size())};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), tile_count, cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t tile = first; tile < last; tile++) {
+          const size_t start = static_cast<size_t>(tile) * kTileSize;
+          const size_t n = std::min(kTileSize, count - start);
+
+          const float* x = x_data + start;
+          float* y = y_data + start;
+
+          for (const Step& step : steps_) {
+            if (step.operand >= 0) {
+              // a single element is broadcast like the values of one channel, a full operand like one value per
+              // channel with the elements as the channels
+              const float* operand = operand_data[step.operand];
+              if (operand_is_scalar[step.operand]) {
+                MlasEltwiseChannelBroadcast(step.kind, x, operand, y, 1, 1, n, step.operand_first, nullptr);
+              } else {
+                MlasEltwiseChannelBroadcast(step.kind, x, operand + start, y, 1, n, 1, step.operand_first, nullptr);
+              }
+            } else {
+              if (x != y) {
+                std::copy_n(x, n, y);
+              }
+              MlasActivation(&step.activation, y, nullptr, 1, n, n);
+            }
+            x = y;
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+#include "core/platform/threadpool.h"
+#include "layer_norm.h"
+#include "group_norm.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                        \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
+      GroupNorm,                                                        \
+      kMSDomain,                                                        \
+      1,                                                                \
+      T,                                                                \
+      kCpuExecutionProvider,                                            \
+      KernelDefBuilder()                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<float>()),   \
+      GroupNorm<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+GroupNorm<T>::GroupNorm(const OpKernelInfo& op_kernel_info)
+    : OpKernel(op_kernel_info) {
+  epsilon_ = op_kernel_info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+  ORT_ENFORCE(epsilon_ >= 0);
+  ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("groups", &groups_).IsOK());
+  ORT_ENFORCE(groups_ > 0);
+
+  const int64_t activation = op_kernel_info.GetAttrOrDefault<int64_t>("activation", 0);
+  ORT_ENFORCE(activation == 0 || activation == 1, "activation is expected to be 0 or 1, got ", activation);
+  use_swish_activation_ = (activation == 1);
+
+  channels_last_ = (op_kernel_info.GetAttrOrDefault<int64_t>("channels_last", 1) != 0);
+}
+
+template <typename T>
+Status GroupNorm<T>::Compute(OpKernelContext* p_ctx) const {
+  const Tensor* input = p_ctx->Input<Tensor>(0);
+  const Tensor* gamma = p_ctx->Input<Tensor>(1);
+  const Tensor* beta = p_ctx->Input<Tensor>(2);
+  Tensor* output = p_ctx->Output(0, input->Shape());
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 4 dimensions, got ", input_dims.size());
+  }
+
+  const int64_t batch_size = input_dims[0];
+  const int64_t num_channels = channels_last_ ? input_dims[3] : input_dims[1];
+  const int64_t image_size = channels_last_ ? input_dims[1] * input_dims[2] : input_dims[2] * input_dims[3];
+
+  if (num_channels % groups_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "number of channels ", num_channels, " is expected to be a multiple of groups ", groups_);
+  }
+
+  if (gamma->Shape().NumDimensions() != 1 || gamma->Shape()[0] != num_channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "gamma is expected to have shape (", num_channels, "), got ", gamma->Shape());
+  }
+
+  if (beta->Shape().NumDimensions() != 1 || beta->Shape()[0] != num_channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "beta is expected to have shape (", num_channels, "), got ", beta->Shape());
+  }
+
+  if (input->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* thread_pool = p_ctx->GetOperatorThreadPool();
+
+  if constexpr (std::is_same<T, float>::value) {
+    MlasGroupNormalization(input->Data<float>(), gamma->Data<float>(), beta->Data<float>(),
+                           output->MutableData<float>(), static_cast<size_t>(batch_size),
+                           static_cast<size_t>(num_channels), static_cast<size_t>(image_size),
+                           static_cast<size_t>(groups_), epsilon_, channels_last_, use_swish_activation_,
+                           thread_pool);
+  } else {
+    // Normalize a single precision copy of the input.
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
+
+    auto input_float = ConvertHalfTensorToFloat(input, alloc, thread_pool);
+    MlasGroupNormalization(input_float.get(), gamma->Data<float>(), beta->Data<float>(), input_float.get(),
+                           static_cast<size_t>(batch_size), static_cast<size_t>(num_channels),
+                           static_cast<size_t>(image_size), static_cast<size_t>(groups_), epsilon_,
+                           channels_last_, use_swish_activation_, thread_pool);
+    MlasConvertFloatToHalf(MlasHalfGemmFloat16, input_float.get(),
+                           reinterpret_cast<uint16_t*>(output->MutableData<MLFloat16>()),
+                           static_cast<size_t>(input->Shape().Size()), thread_pool);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class GroupNorm final : public OpKernel {
+ public:
+  GroupNorm(const OpKernelInfo& op_kernel_info);
+  Status Compute(OpKernelContext* p_op_kernel_context) const override;
+
+ private:
+  float epsilon_;
+  int64_t groups_;
+  bool use_swish_activation_;
+  bool channels_last_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -12,22 +13,38 @@
 namespace onnxruntime {
 namespace contrib {
 
-#define REGISTER_KERNEL_TYPED(T)                                                                        \
+#define REGISTER_KERNEL_TYPED(T, U)                                                                     \
   ONNX_OPERATOR_TYPED_KERNEL_EX(LayerNormalization, kOnnxDomain, 1, T, kCpuExecutionProvider,           \
                                 KernelDefBuilder()                                                      \
+                                    .MayInplace(0, 0)                                                   \
                                     .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())              \
-                                    .TypeConstraint("U", DataTypeImpl::GetTensorType<T>())              \
+                                    .TypeConstraint("U", DataTypeImpl::GetTensorType<U>())              \
                                     .TypeConstraint("V", DataTypeImpl::GetTensorType<T>()),             \
                                 LayerNorm<T, false>);                                                   \
   ONNX_OPERATOR_TYPED_KERNEL_EX(SimplifiedLayerNormalization, kOnnxDomain, 1, T, kCpuExecutionProvider, \
                                 KernelDefBuilder()                                                      \
+                                    .MayInplace(0, 0)                                                   \
                                     .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())              \
-                                    .TypeConstraint("U", DataTypeImpl::GetTensorType<T>())              \
+                                    .TypeConstraint("U", DataTypeImpl::GetTensorType<U>())              \
                                     .TypeConstraint("V", DataTypeImpl::GetTensorType<T>()),             \
                                 LayerNorm<T, true>);
 
-REGISTER_KERNEL_TYPED(float)
-REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(float, float)
+REGISTER_KERNEL_TYPED(double, double)
+REGISTER_KERNEL_TYPED(MLFloat16, float)
+
+IAllocatorUniquePtr<float> ConvertHalfTensorToFloat(const Tensor* tensor, const AllocatorPtr& alloc,
+                                                    concurrency::ThreadPool* thread_pool) {
+  if (tensor == nullptr) {
+    return IAllocatorUniquePtr<float>{};
+  }
+
+  const size_t count = static_cast<size_t>(tensor->Shape().Size());
+  auto buffer = IAllocator::MakeUniquePtr<float>(alloc, count);
+  MlasConvertHalfToFloat(MlasHalfGemmFloat16, reinterpret_cast<const uint16_t*>(tensor->Data<MLFloat16>()),
+                         buffer.get(), count, thread_pool);
+  return buffer;
+}
 
 template <typename T, bool simplified>
 LayerNorm<T, simplified>::LayerNorm(const OpKernelInfo& op_kernel_info)
@@ -38,6 +55,9 @@ LayerNorm<T, simplified>::LayerNorm(const OpKernelInfo& op_kernel_info)
 
 template <typename T, bool simplified>
 Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
+  // the mean and the inverse standard deviation are float for MLFloat16 inputs
+  using U = typename std::conditional<std::is_same<T, MLFloat16>::value, float, T>::type;
+
   // Inputs
   const Tensor* X = p_ctx->Input<Tensor>(0);
   const Tensor* scale = p_ctx->Input<Tensor>(1);
@@ -67,7 +87,7 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
 
-  T* mean_data = nullptr;
+  U* mean_data = nullptr;
   BufferUniquePtr mean_data_buf_ptr;
 
   int output_index = 1;
@@ -75,63 +95,81 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   if (!simplified) {
     Tensor* mean = p_ctx->Output(output_index++, TensorShape(mean_inv_std_dev_dim));
     if (mean != nullptr) {
-      mean_data = mean->template MutableData<T>();
+      mean_data = mean->template MutableData<U>();
     } else {
-      auto mean_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * norm_count);
+      auto mean_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(U)) * norm_count);
       mean_data_buf_ptr = BufferUniquePtr(mean_data_buf, BufferDeleter(alloc));
-      mean_data = static_cast<T*>(mean_data_buf_ptr.get());
+      mean_data = static_cast<U*>(mean_data_buf_ptr.get());
     }
   }
 
-  T* inv_std_dev_data = nullptr;
+  U* inv_std_dev_data = nullptr;
   BufferUniquePtr inv_std_dev_data_buf_ptr;
 
   Tensor* inv_std_dev = p_ctx->Output(output_index, TensorShape(mean_inv_std_dev_dim));
   if (inv_std_dev != nullptr) {
-    inv_std_dev_data = inv_std_dev->template MutableData<T>();
+    inv_std_dev_data = inv_std_dev->template MutableData<U>();
   } else {
-    auto inv_std_dev_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * norm_count);
+    auto inv_std_dev_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(U)) * norm_count);
     inv_std_dev_data_buf_ptr = BufferUniquePtr(inv_std_dev_data_buf, BufferDeleter(alloc));
-    inv_std_dev_data = static_cast<T*>(inv_std_dev_data_buf_ptr.get());
+    inv_std_dev_data = static_cast<U*>(inv_std_dev_data_buf_ptr.get());
   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
-      [&](ptrdiff_t task_idx) {
-        const T* p_input = X_data + task_idx * norm_size;
-        T* p_output = Y_data + task_idx * norm_size;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
-
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon_);
-        } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
-        }
+  if constexpr (std::is_same<T, float>::value) {
+    MlasLayerNormalization(X_data, nullptr, nullptr, scale_data, bias_data, Y_data, mean_data, inv_std_dev_data,
+                           static_cast<size_t>(norm_count), static_cast<size_t>(norm_size), epsilon_, simplified,
+                           p_ctx->GetOperatorThreadPool());
+  } else if constexpr (std::is_same<T, MLFloat16>::value) {
+    // normalize in float, the conversions are vectorized and the output is converted in place
+    concurrency::ThreadPool* thread_pool = p_ctx->GetOperatorThreadPool();
+    auto X_float = ConvertHalfTensorToFloat(X, alloc, thread_pool);
+    auto scale_float = ConvertHalfTensorToFloat(scale, alloc, thread_pool);
+    auto bias_float = ConvertHalfTensorToFloat(simplified ? nullptr : bias, alloc, thread_pool);
+
+    MlasLayerNormalization(X_float.get(), nullptr, nullptr, scale_float.get(), bias_float.get(), X_float.get(),
+                           mean_data, inv_std_dev_data, static_cast<size_t>(norm_count),
+                           static_cast<size_t>(norm_size), epsilon_, simplified, thread_pool);
+    MlasConvertFloatToHalf(MlasHalfGemmFloat16, X_float.get(), reinterpret_cast<uint16_t*>(Y_data),
+                           static_cast<size_t>(x_shape.Size()), thread_pool);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
+        [&](ptrdiff_t task_idx) {
+          const T* p_input = X_data + task_idx * norm_size;
+          T* p_output = Y_data + task_idx * norm_size;
+
+          T mean = 0;
+          T mean_square = 0;
+
+          for (int64_t h = 0; h < norm_size; h++) {
+            mean += p_input[h];
+            mean_square += p_input[h] * p_input[h];
+          }
 
-        for (int64_t h = 0; h < norm_size; h++) {
+          mean = mean / norm_size;
           if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            mean_square = sqrt(mean_square / norm_size + epsilon_);
           } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
+          }
+
+          for (int64_t h = 0; h < norm_size; h++) {
+            if (simplified) {
+              p_output[h] = p_input[h] / mean_square * scale_data[h];
+            } else if (nullptr == bias) {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            } else {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            }
           }
-        }
-
-        if (mean_data != nullptr) {
-          mean_data[task_idx] = mean;
-        }
-        inv_std_dev_data[task_idx] = 1 / mean_square;
-      },
-      0);
+
+          if (mean_data != nullptr) {
+            mean_data[task_idx] = mean;
+          }
+          inv_std_dev_data[task_idx] = 1 / mean_square;
+        },
+        0);
+  }
 
   return Status::OK();
 }
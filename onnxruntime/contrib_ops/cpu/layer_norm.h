@@ -10,6 +10,11 @@
 namespace onnxruntime {
 namespace contrib {
 
+// Returns the values of an optional MLFloat16 tensor converted to float in a buffer allocated from `alloc`,
+// or nullptr if the tensor is missing.
+IAllocatorUniquePtr<float> ConvertHalfTensorToFloat(const Tensor* tensor, const AllocatorPtr& alloc,
+                                                    concurrency::ThreadPool* thread_pool);
+
 template <typename T, bool simplified>
 class LayerNorm final : public OpKernel {
  public:
@@ -0,0 +1,427 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using ConvPadVector = ConvAttributes::ConvPadVector;
+
+// Single precision convolution that consumes and produces channels last (NHWC)
+// tensors. The filter tensor keeps the ONNX OIHW layout and is reordered to
+// HWIO (and packed for MlasGemm where possible) when the weights are constant.
+class NhwcConv final : public OpKernel {
+ public:
+  explicit NhwcConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  enum InputTensors : int {
+    IN_X = 0,
+    IN_W = 1,
+    IN_BIAS = 2
+  };
+
+  // Reorder filter storage format from MCK1..Kn to K1...KnCM
+  static void ReorderFilter(const float* input,
+                            float* output,
+                            size_t output_channels,
+                            size_t input_channels,
+                            size_t kernel_size) {
+    for (size_t k = 0; k < kernel_size; k++) {
+      for (size_t ic = 0; ic < input_channels; ic++) {
+        for (size_t oc = 0; oc < output_channels; oc++) {
+          size_t index = (oc * input_channels * kernel_size) + (ic * kernel_size) + k;
+          *output++ = input[index];
+        }
+      }
+    }
+  }
+
+  ConvAttributes conv_attrs_;
+  TensorShape W_shape_;
+  BufferUniquePtr packed_W_buffer_;
+  size_t packed_W_size_{0};
+  BufferUniquePtr reordered_W_buffer_;
+  bool is_W_packed_{false};
+};
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcConv,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcConv);
+
+Status NhwcConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                         /*out*/ bool& is_packed,
+                         /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // Support packing the weight matrix.
+  if (input_idx != InputTensors::IN_W) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape().GetDims();
+  size_t rank = shape.size();
+  if (rank <= 2) {
+    return Status::OK();
+  }
+
+  const int64_t M = shape[0];
+  const int64_t C = shape[1];
+
+  // Verify that the total number of output channels is a multiple of the group count.
+  if (M % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  // Note: The tensor has already been allocated with this tensor shape, so all
+  // shape indices are guaranteed to fit inside size_t.
+  const size_t output_channels = static_cast<size_t>(M);
+  const size_t group_input_channels = static_cast<size_t>(C);
+  const size_t kernel_size =
+      static_cast<size_t>(std::accumulate(shape.data() + 2, shape.data() + rank, 1LL, std::multiplies<int64_t>()));
+
+  const auto* Wdata = tensor.Data<float>();
+  W_shape_ = shape;
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t group_output_channels = output_channels / group_count;
+  const size_t kernel_dim = group_input_channels * kernel_size;
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+
+  // Don't pack the filter buffer if the MlasConvDepthwise path is used.
+  if (group_input_channels != 1 || group_output_channels != 1) {
+    packed_W_size_ = MlasGemmPackBSize(group_output_channels, kernel_dim);
+    if (packed_W_size_ != 0) {
+      size_t packed_W_data_size = SafeInt<size_t>(group_count) * packed_W_size_;
+      auto* packed_W = static_cast<uint8_t*>(alloc->Alloc(packed_W_data_size));
+
+      // Initialize memory to 0 as there could be some padding associated with pre-packed
+      // buffer memory and we don not want it uninitialized and generate different hashes
+      // if and when we try to cache this pre-packed buffer for sharing between sessions.
+      memset(packed_W, 0, packed_W_data_size);
+
+      packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(alloc));
+
+      // Allocate a temporary buffer to hold the reordered oihw->hwio filter for
+      // a single group.
+      auto* group_reordered_W = static_cast<float*>(
+          alloc->Alloc(SafeInt<size_t>(sizeof(float)) * group_output_channels * kernel_dim));
+      BufferUniquePtr group_reordered_W_buffer(group_reordered_W, BufferDeleter(alloc));
+
+      const size_t W_offset = group_output_channels * kernel_dim;
+
+      for (int64_t group_id = 0; group_id < conv_attrs_.group; ++group_id) {
+        ReorderFilter(Wdata, group_reordered_W, group_output_channels, group_input_channels, kernel_size);
+        MlasGemmPackB(CblasNoTrans,
+                      group_output_channels,
+                      kernel_dim,
+                      group_reordered_W,
+                      group_output_channels,
+                      packed_W);
+        packed_W += packed_W_size_;
+        Wdata += W_offset;
+      }
+
+      if (share_prepacked_weights) {
+        prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_W_data_size);
+      }
+
+      is_W_packed_ = true;
+      is_packed = true;
+      return Status::OK();
+    }
+  }
+
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(nullptr);  // packed_W_buffer_ is nullptr
+    prepacked_weights->buffer_sizes_.push_back(0);
+  }
+
+  size_t reordered_w_data_size = SafeInt<size_t>(sizeof(float)) * output_channels * kernel_dim;
+  auto* reordered_W = static_cast<float*>(alloc->Alloc(reordered_w_data_size));
+  memset(reordered_W, 0, reordered_w_data_size);
+
+  reordered_W_buffer_ = BufferUniquePtr(reordered_W, BufferDeleter(alloc));
+
+  ReorderFilter(Wdata, reordered_W, output_channels, group_input_channels, kernel_size);
+
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(reordered_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(reordered_w_data_size);
+  }
+
+  is_W_packed_ = true;
+  is_packed = true;
+  return Status::OK();
+}
+
+Status NhwcConv::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                           int input_idx,
+                                           /*out*/ bool& used_shared_buffers) {
+  if (input_idx != InputTensors::IN_W) {
+    return Status::OK();
+  }
+
+  used_shared_buffers = true;
+
+  if (prepacked_buffers.size() == 1) {  // This means that only packed_W_ exists
+    packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  } else if (prepacked_buffers.size() == 2) {  // This means that only reordered_W_ exists
+    // Enforce that the first "placeholder" buffer is nullptr
+    ORT_ENFORCE(prepacked_buffers[0].get() == nullptr);
+    reordered_W_buffer_ = std::move(prepacked_buffers[1]);
+  }
+
+  return Status::OK();
+}
+
+Status NhwcConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(InputTensors::IN_X);
+  const Tensor* W = is_W_packed_ ? nullptr : context->Input<Tensor>(InputTensors::IN_W);
+  const Tensor* B = context->Input<Tensor>(InputTensors::IN_BIAS);
+  const auto& W_shape = W ? W->Shape() : W_shape_;
+
+  const int64_t N = X->Shape()[0];
+  const int64_t M = W_shape[0];
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, true));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+
+  const size_t kernel_rank = kernel_shape.size();
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t C = X->Shape()[1 + kernel_rank];
+
+  TensorShapeVector Y_dims({N});
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Handle the case of a dynamic weight filter.
+  BufferUniquePtr reordered_W_buffer;
+  const float* reordered_W = nullptr;
+  if (!packed_W_buffer_) {
+    if (W == nullptr) {
+      // Weight was constant and reordered.
+      reordered_W = static_cast<const float*>(reordered_W_buffer_.get());
+    } else {
+      // Weight tensor was not constant or prepacking is disabled.
+      auto* W_data = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * W_shape.Size()));
+      reordered_W_buffer = BufferUniquePtr(W_data, BufferDeleter(alloc));
+      ReorderFilter(
+          W->Data<float>(),
+          W_data,
+          static_cast<size_t>(M),
+          static_cast<size_t>(W_shape[1]),
+          static_cast<size_t>(kernel_size));
+      reordered_W = W_data;
+    }
+  }
+
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = W_shape[1];
+  const int64_t group_output_channels = M / group_count;
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+
+  const auto* Xdata = X->Data<float>();
+  const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+  auto* Ydata = Y->MutableData<float>();
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // Depthwise convolutions read the input through an indirection buffer and
+  // apply the filter and bias in a single pass over the output.
+  if (reordered_W != nullptr && group_input_channels == 1 && group_output_channels == 1) {
+    auto* indirection_data = alloc->Alloc(SafeInt<size_t>(sizeof(const float*)) * kernel_size * output_image_size);
+    BufferUniquePtr indirection_buffer(indirection_data, BufferDeleter(alloc));
+    std::vector<float> padding_data(static_cast<size_t>(C), 0.0f);
+
+    const int32_t task_count = static_cast<int32_t>(
+        std::min<int64_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool), output_image_size));
+
+    for (int64_t image_id = 0; image_id < N; ++image_id) {
+      auto conv_worker = [&](ptrdiff_t batch) {
+        auto work = concurrency::ThreadPool::PartitionWork(batch, task_count, static_cast<ptrdiff_t>(output_image_size));
+        int64_t output_start = static_cast<int64_t>(work.start);
+        int64_t output_count = static_cast<int64_t>(work.end) - work.start;
+
+        auto* worker_indirection_buffer = static_cast<float const**>(indirection_buffer.get()) + output_start * kernel_size;
+        math::Im2col<float, StorageOrder::NHWC>()(
+            Xdata,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<ptrdiff_t>(kernel_rank),
+            output_start,
+            output_count,
+            worker_indirection_buffer,
+            padding_data.data());
+        MlasConvDepthwise(
+            worker_indirection_buffer,
+            reordered_W,
+            Bdata,
+            Ydata + output_start * M,
+            static_cast<size_t>(M),
+            static_cast<size_t>(output_count),
+            static_cast<size_t>(kernel_size));
+      };
+
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, task_count, conv_worker);
+
+      Xdata += input_image_size * C;
+      Ydata += output_image_size * M;
+    }
+
+    return Status::OK();
+  }
+
+  // Pointwise convolutions can use the original input tensor in place,
+  // otherwise a temporary buffer is required for the im2col transform.
+  const bool is_pointwise = kernel_size == 1 && conv_attrs_.HasStridesOneAndNoPadding();
+  BufferUniquePtr col_buffer;
+  if (!is_pointwise) {
+    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * kernel_dim * output_image_size);
+    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+  }
+  auto* col_data = static_cast<float*>(col_buffer.get());
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    // The bias is broadcast into the output rows and accumulated by the GEMM.
+    if (Bdata != nullptr) {
+      for (int64_t i = 0; i < output_image_size; ++i) {
+        std::copy_n(Bdata, M, Ydata + i * M);
+      }
+    }
+
+    for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+      const float* A = Xdata + group_id * group_input_channels;
+      size_t lda = static_cast<size_t>(C);
+
+      if (!is_pointwise) {
+        if (kernel_rank == 2) {
+          math::Im2col<float, StorageOrder::NHWC>()(
+              A,
+              group_input_channels,
+              C,
+              input_shape[0],
+              input_shape[1],
+              kernel_shape[0],
+              kernel_shape[1],
+              dilations[0],
+              dilations[1],
+              pads[0],
+              pads[1],
+              strides[0],
+              strides[1],
+              output_shape[1],
+              0,
+              output_image_size,
+              col_data);
+        } else {
+          math::Im2col<float, StorageOrder::NHWC>()(
+              A,
+              group_input_channels,
+              C,
+              input_shape.GetDims().data(),
+              output_shape.GetDims().data(),
+              kernel_shape.data(),
+              strides.data(),
+              dilations.data(),
+              pads.data(),
+              static_cast<ptrdiff_t>(kernel_rank),
+              col_data);
+        }
+        A = col_data;
+        lda = static_cast<size_t>(kernel_dim);
+      }
+
+      MLAS_SGEMM_DATA_PARAMS gemm_params;
+      gemm_params.A = A;
+      gemm_params.lda = lda;
+      if (packed_W_buffer_) {
+        gemm_params.B = reinterpret_cast<const float*>(
+            static_cast<const uint8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_);
+        gemm_params.BIsPacked = true;
+      } else {
+        gemm_params.B = reordered_W + group_id * group_output_channels;
+        gemm_params.ldb = static_cast<size_t>(M);
+      }
+      gemm_params.C = Ydata + group_id * group_output_channels;
+      gemm_params.ldc = static_cast<size_t>(M);
+      gemm_params.beta = Bdata != nullptr ? 1.0f : 0.0f;
+
+      MlasGemm(CblasNoTrans,
+               CblasNoTrans,
+               static_cast<size_t>(output_image_size),
+               static_cast<size_t>(group_output_channels),
+               static_cast<size_t>(kernel_dim),
+               gemm_params,
+               thread_pool);
+    }
+
+    Xdata += input_image_size * C;
+    Ydata += output_image_size * M;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
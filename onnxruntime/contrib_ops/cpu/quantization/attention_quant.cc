@@ -32,10 +32,26 @@ class QAttention : public OpKernel, public AttentionCPUBase {
                                    /*out*/ bool& used_shared_buffers) override;
 
  private:
+  // Computes the attention from Q, K and V with 8-bit integer GEMMs:
+  //   output(B, S, N, H) = Softmax(1/sqrt(H) x quant(Q) x quant(K)' + mask) x quant(V)
+  // Q, K and V are quantized per head with their own range and the softmax output is quantized to uint8.
+  Status ApplyQuantizedAttention(const float* Q,               // Q data. Its size is BxNxSxH
+                                 const float* K,               // K data. Its size is BxNxSxH
+                                 const float* V,               // V data. Its size is BxNxSxH
+                                 const Tensor* mask_index,     // mask index. nullptr if no mask
+                                 Tensor* output,               // output tensor
+                                 int batch_size,               // batch size
+                                 int sequence_length,          // sequence length
+                                 int head_size,                // head size
+                                 int hidden_size,              // hidden size
+                                 OpKernelContext* context) const;
+
   BufferUniquePtr packed_weights_;
   size_t packed_weights_size_;
   TensorShape weight_shape_;
   bool weights_is_signed_;
+  // Q x K' and the attention probs x V are computed with integer GEMMs, only used without past and present.
+  bool quantize_attention_scores_;
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -53,7 +69,11 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
     QAttention<float>);
 
 template <typename T>
-QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {}
+QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {
+  const auto& output_defs = info.node().OutputDefs();
+  const bool has_present = output_defs.size() > 1 && output_defs[1]->Exists();
+  quantize_attention_scores_ = info.GetAttrOrDefault<int64_t>("quantize_attention_scores", 0) != 0 && !has_present;
+}
 
 template <typename T>
 Status QAttention<T>::PrePack(const Tensor& weights, int input_idx, AllocatorPtr alloc,
@@ -284,11 +304,169 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
     MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
   }
 
+  if (quantize_attention_scores_ && past_tensor == nullptr) {
+    return ApplyQuantizedAttention(Q, K, V, mask_index, output, batch_size, sequence_length, head_size, hidden_size,
+                                   context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past_tensor, output,
                         batch_size, sequence_length,
                         head_size, head_size, hidden_size, nullptr, context);
 }
 
+template <typename T>
+Status QAttention<T>::ApplyQuantizedAttention(const float* Q,
+                                              const float* K,
+                                              const float* V,
+                                              const Tensor* mask_index,
+                                              Tensor* output,
+                                              int batch_size,
+                                              int sequence_length,
+                                              int head_size,
+                                              int hidden_size,
+                                              OpKernelContext* context) const {
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  const int loop_len = batch_size * num_heads_;
+  const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;       // S x H
+  const size_t probs_chunk_length = static_cast<size_t>(sequence_length) * sequence_length;  // S x S
+  const bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
+
+  // quantized Q, K' and V: 3 x BxNxSxH
+  auto quantized_qkv_data = allocator->Alloc(SafeInt<size_t>(loop_len) * input_chunk_length * 3);
+  BufferUniquePtr quantized_qkv_buffer(quantized_qkv_data, BufferDeleter(allocator));
+  uint8_t* quantized_q = static_cast<uint8_t*>(quantized_qkv_data);
+  uint8_t* quantized_k_transposed = quantized_q + loop_len * input_chunk_length;
+  uint8_t* quantized_v = quantized_k_transposed + loop_len * input_chunk_length;
+
+  // attention scores in float and quantized attention probs: BxNxSxS each
+  auto scores_data = allocator->Alloc(SafeInt<size_t>(loop_len) * probs_chunk_length * sizeof(float));
+  BufferUniquePtr scores_buffer(scores_data, BufferDeleter(allocator));
+  auto probs_data = allocator->Alloc(SafeInt<size_t>(loop_len) * probs_chunk_length);
+  BufferUniquePtr probs_buffer(probs_data, BufferDeleter(allocator));
+
+  // mask data: BxSxS
+  void* mask_data = nullptr;
+  if (mask_index != nullptr || has_unidirectional) {
+    size_t mask_data_bytes = SafeInt<size_t>(batch_size) * probs_chunk_length * sizeof(float);
+    mask_data = allocator->Alloc(mask_data_bytes);
+    memset(mask_data, 0, mask_data_bytes);
+    PrepareMask(mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr,
+                mask_index != nullptr ? mask_index->Shape().GetDims() : gsl::span<const int64_t>{},
+                static_cast<float*>(mask_data), has_unidirectional, batch_size, sequence_length, 0);
+  }
+  BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+  const float* mask = static_cast<const float*>(mask_data);
+
+  const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+  float* output_data = output->template MutableData<float>();
+
+  // The cost of the two Gemms
+  const double cost = 2.0 * static_cast<double>(head_size) * sequence_length * sequence_length;
+
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    std::vector<uint8_t> k_row(head_size);
+
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i) / num_heads_;
+      const int head_index = static_cast<int>(i) % num_heads_;
+
+      // quantize Q, K and V of the head, K being transposed to H x S
+      const float* q = Q + input_chunk_length * i;
+      const float* k = K + input_chunk_length * i;
+      const float* v = V + input_chunk_length * i;
+      uint8_t* q_quant = quantized_q + input_chunk_length * i;
+      uint8_t* k_quant = quantized_k_transposed + input_chunk_length * i;
+      uint8_t* v_quant = quantized_v + input_chunk_length * i;
+
+      float q_scale, k_scale, v_scale;
+      uint8_t q_zero_point, k_zero_point, v_zero_point;
+      GetQuantizationParameter(q, static_cast<int64_t>(input_chunk_length), q_scale, q_zero_point, nullptr);
+      GetQuantizationParameter(k, static_cast<int64_t>(input_chunk_length), k_scale, k_zero_point, nullptr);
+      GetQuantizationParameter(v, static_cast<int64_t>(input_chunk_length), v_scale, v_zero_point, nullptr);
+      MlasQuantizeLinear(q, q_quant, input_chunk_length, q_scale, q_zero_point);
+      MlasQuantizeLinear(v, v_quant, input_chunk_length, v_scale, v_zero_point);
+      for (int s = 0; s < sequence_length; s++) {
+        MlasQuantizeLinear(k + s * head_size, k_row.data(), head_size, k_scale, k_zero_point);
+        for (int h = 0; h < head_size; h++) {
+          k_quant[h * sequence_length + s] = k_row[h];
+        }
+      }
+
+      // scores(S, S) = alpha x Q(S, H) x K'(H, S), converted to float in place
+      float* scores = static_cast<float*>(scores_data) + probs_chunk_length * i;
+      const float scores_scale = alpha * q_scale * k_scale;
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR scores_processor(scores, sequence_length, &scores_scale, nullptr);
+
+      MLAS_GEMM_QUANT_SHAPE_PARAMS scores_shape;
+      scores_shape.M = sequence_length;
+      scores_shape.N = sequence_length;
+      scores_shape.K = head_size;
+
+      MLAS_GEMM_QUANT_DATA_PARAMS scores_params;
+      scores_params.A = q_quant;
+      scores_params.lda = head_size;
+      scores_params.ZeroPointA = q_zero_point;
+      scores_params.B = k_quant;
+      scores_params.ldb = sequence_length;
+      scores_params.ZeroPointB = &k_zero_point;
+      scores_params.C = reinterpret_cast<int32_t*>(scores);
+      scores_params.ldc = sequence_length;
+      scores_params.OutputProcessor = &scores_processor;
+      MlasGemm(scores_shape, scores_params, nullptr);
+
+      if (mask != nullptr) {
+        // Broadcast mask data: (Bx)SxS -> (BxNx)SxS
+        const float* head_mask = mask + probs_chunk_length * batch_index;
+        for (size_t j = 0; j < probs_chunk_length; j++) {
+          scores[j] += head_mask[j];
+        }
+
+        // Fix unidirectional mask to be parity with huggingface implementation.
+        if (has_unidirectional) {
+          for (int s_i = 0; s_i < sequence_length - 1; s_i++) {
+            for (int m_i = s_i + 1; m_i < sequence_length; m_i++) {
+              const int j = s_i * sequence_length + m_i;
+              scores[j] = head_mask[j];
+            }
+          }
+        }
+      }
+
+      // probs(S, S) = quant(Softmax(scores)) with a scale of 1/255
+      uint8_t* probs = static_cast<uint8_t*>(probs_data) + probs_chunk_length * i;
+      MlasComputeSoftmaxQuantized(scores, probs, sequence_length, sequence_length, nullptr);
+
+      // out(S, H) = probs(S, S) x V(S, H), written to output(B, S, N, H) in place
+      float* out = output_data + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+      const float out_scale = v_scale / 255.0f;
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR out_processor(out, hidden_size, &out_scale, nullptr);
+
+      MLAS_GEMM_QUANT_SHAPE_PARAMS out_shape;
+      out_shape.M = sequence_length;
+      out_shape.N = head_size;
+      out_shape.K = sequence_length;
+
+      MLAS_GEMM_QUANT_DATA_PARAMS out_params;
+      out_params.A = probs;
+      out_params.lda = sequence_length;
+      out_params.ZeroPointA = 0;
+      out_params.B = v_quant;
+      out_params.ldb = head_size;
+      out_params.ZeroPointB = &v_zero_point;
+      out_params.C = reinterpret_cast<int32_t*>(out);
+      out_params.ldc = hidden_size;
+      out_params.OutputProcessor = &out_processor;
+      MlasGemm(out_shape, out_params, nullptr);
+    }
+  });
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
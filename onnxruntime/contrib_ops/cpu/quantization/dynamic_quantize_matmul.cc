@@ -156,7 +156,9 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+    quantize_a_per_row_ = info.GetAttrOrDefault<int64_t>("quantize_a_per_row", 0) != 0;
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -170,6 +172,14 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  // Quantizes each row of A with its own scale and zero point. The integer GEMM runs with a zero point of 0 for A,
+  // the zero point of each row is then applied with the column sums of B:
+  //   sum_k (a_mk - za_m) x (b_kn - zb_n) = sum_k a_mk x (b_kn - zb_n) - za_m x sum_k (b_kn - zb_n)
+  Status ComputePerRow(OpKernelContext* ctx, const Tensor* a, const Tensor* b) const;
+
+  bool quantize_a_per_row_;
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -204,6 +214,13 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
   const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
 
+  // a single row has the same quantization per row and per tensor
+  const auto& a_shape = a->Shape();
+  if (quantize_a_per_row_ && a_shape.NumDimensions() > 0 && a_shape[a_shape.NumDimensions() - 1] > 0 &&
+      a_shape.Size() > a_shape[a_shape.NumDimensions() - 1]) {
+    return ComputePerRow(ctx, a, b);
+  }
+
   // calculate quantization parameter of a
   const float* a_data = a->template Data<float>();
   int64_t num_of_elements = a->Shape().Size();
@@ -239,6 +256,136 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+Status DynamicQuantizeMatMul::ComputePerRow(OpKernelContext* ctx, const Tensor* a, const Tensor* b) const {
+  const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
+  const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
+  const Tensor* bias_tensor = ctx->Input<Tensor>(IN_BIAS);
+  const TensorShape& b_shape = b ? b->Shape() : b_shape_;
+
+  const bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b_shape);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(),
+                                     b_shape,
+                                     is_b_scale_supported ? &b_scale_tensor->Shape() : nullptr,
+                                     b_zp_tensor ? &b_zp_tensor->Shape() : nullptr));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  auto* tp = ctx->GetOperatorThreadPool();
+  float* y_data = y->template MutableData<float>();
+  const float* bias_data = bias_tensor != nullptr ? bias_tensor->Data<float>() : nullptr;
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t a_rows = static_cast<size_t>(a->Shape().Size()) / K;
+  const size_t num_gemms = helper.OutputOffsets().size();
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+
+  auto a_quant_data = IAllocator::MakeUniquePtr<uint8_t>(allocator, SafeInt<size_t>(a_rows) * K);
+  auto a_scales = IAllocator::MakeUniquePtr<float>(allocator, a_rows);
+  auto a_zero_points = IAllocator::MakeUniquePtr<uint8_t>(allocator, a_rows);
+  auto b_column_sums = IAllocator::MakeUniquePtr<int32_t>(allocator, SafeInt<size_t>(num_gemms) * N);
+
+  MlasDynamicQuantizeLinearPerRow(a->template Data<float>(), a_quant_data.get(), a_rows, K,
+                                  a_scales.get(), a_zero_points.get(), tp);
+
+  // process zero point of b
+  bool is_b_zp_per_column = false;
+  uint8_t b_zp_default = 0;
+  const uint8_t* b_zp_ptr = &b_zp_default;
+  if (nullptr != b_zp_tensor) {
+    ORT_ENFORCE(IsBQuantParamSupported(b_zp_tensor->Shape(), b_shape),
+                "MatmulInteger : b zero point is not valid");
+
+    is_b_zp_per_column = !IsScalarOr1ElementVector(b_zp_tensor);
+    b_zp_ptr = static_cast<const uint8_t*>(b_zp_tensor->DataRaw());
+  }
+
+  // process scale of b, applied with the scale of each row of a once the GEMM is done
+  bool is_b_scale_per_column = false;
+  float b_scale_default = 1.0f;
+  const float* b_scale_data = &b_scale_default;
+  if (is_b_scale_supported) {
+    is_b_scale_per_column = !IsScalarOr1ElementVector(b_scale_tensor);
+    b_scale_data = b_scale_tensor->Data<float>();
+  }
+
+  MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+  gemm_shape.M = M;
+  gemm_shape.N = N;
+  gemm_shape.K = K;
+  gemm_shape.AIsSigned = false;
+  gemm_shape.BIsSigned = b ? b->IsDataType<int8_t>() : b_is_signed_;
+
+  // A x (B - zb) in int32, and a row of ones x (B - zb) for the column sums of B
+  std::vector<uint8_t> ones(K, 1);
+  std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(num_gemms);
+  std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> column_sums_data_vec(num_gemms);
+
+  for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
+    auto& params = gemm_data_vec[gemm_idx];
+    params.A = a_quant_data.get() + helper.LeftOffsets()[gemm_idx];
+    params.lda = K;
+    params.ZeroPointA = 0;
+    params.BIsPacked = bool(packed_b_);
+    params.B = b ? static_cast<const uint8_t*>(b->DataRaw()) + helper.RightOffsets()[gemm_idx] : packed_b_.get();
+    params.ldb = N;
+    params.ZeroPointB = b_zp_ptr + helper.RightZeroPointOffsets()[gemm_idx];
+    params.PerColumnZeroPoints = is_b_zp_per_column;
+    params.C = reinterpret_cast<int32_t*>(y_data + helper.OutputOffsets()[gemm_idx]);
+    params.ldc = N;
+
+    auto& column_sums_params = column_sums_data_vec[gemm_idx];
+    column_sums_params = params;
+    column_sums_params.A = ones.data();
+    column_sums_params.C = b_column_sums.get() + gemm_idx * N;
+  }
+
+  MlasGemmBatch(gemm_shape, gemm_data_vec.data(), num_gemms, tp);
+
+  MLAS_GEMM_QUANT_SHAPE_PARAMS column_sums_shape = gemm_shape;
+  column_sums_shape.M = 1;
+  MlasGemmBatch(column_sums_shape, column_sums_data_vec.data(), num_gemms, tp);
+
+  // apply the zero point and scale of each row of a, the scale of b and the bias in place
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_gemms * M),
+      TensorOpCost{static_cast<double>(N) * sizeof(int32_t), static_cast<double>(N) * sizeof(float), 4.0 * N},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; row++) {
+          const size_t gemm_idx = static_cast<size_t>(row) / M;
+          const size_t m = static_cast<size_t>(row) % M;
+          const size_t a_row = helper.LeftOffsets()[gemm_idx] / K + m;
+
+          const int32_t a_zp = a_zero_points.get()[a_row];
+          const float a_scale = a_scales.get()[a_row];
+          const int32_t* column_sums = b_column_sums.get() + gemm_idx * N;
+          const float* b_scale = b_scale_data + helper.RightScaleOffsets()[gemm_idx];
+          float* y_row = y_data + helper.OutputOffsets()[gemm_idx] + m * N;
+          const int32_t* acc_row = reinterpret_cast<const int32_t*>(y_row);
+
+          for (size_t n = 0; n < N; n++) {
+            const int32_t acc = acc_row[n] - a_zp * column_sums[n];
+            const float scale = a_scale * (is_b_scale_per_column ? b_scale[n] : b_scale[0]);
+            y_row[n] = static_cast<float>(acc) * scale + (bias_data != nullptr ? bias_data[n] : 0.0f);
+          }
+        }
+      });
+
+  if (!is_b_scale_supported) {
+    ScaleOutput(*b_scale_tensor, *y);
+  }
+
+  return Status::OK();
+}
+
 void MatMulIntegerToFloat::FixupScaleTensor(const Tensor*& a_scale_tensor, const Tensor*& b_scale_tensor) {
   const TensorShape a_scale_shape = a_scale_tensor->Shape();
   const TensorShape b_scale_shape = b_scale_tensor->Shape();
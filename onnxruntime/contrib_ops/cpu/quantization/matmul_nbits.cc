@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class MatMulNBits final : public OpKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info) : OpKernel(info) {
+    int64_t K, N, block_size;
+    ORT_ENFORCE(info.GetAttr<int64_t>("K", &K).IsOK(), "MatMulNBits: attribute K is required");
+    ORT_ENFORCE(info.GetAttr<int64_t>("N", &N).IsOK(), "MatMulNBits: attribute N is required");
+    ORT_ENFORCE(info.GetAttr<int64_t>("block_size", &block_size).IsOK(), "MatMulNBits: attribute block_size is required");
+    K_ = gsl::narrow<size_t>(K);
+    N_ = gsl::narrow<size_t>(N);
+    block_size_ = gsl::narrow<size_t>(block_size);
+    bits_ = gsl::narrow<size_t>(info.GetAttrOrDefault<int64_t>("bits", 4));
+
+    ORT_ENFORCE(MlasIsBlkQuantGemmAvailable(bits_, block_size_),
+                "MatMulNBits: unsupported bits ", bits_, " and block_size ", block_size_);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  size_t K_;
+  size_t N_;
+  size_t bits_;
+  size_t block_size_;
+};
+
+Status MatMulNBits::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+  const Tensor* bias = ctx->Input<Tensor>(4);
+
+  const auto& a_shape = a->Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 1 && static_cast<size_t>(a_shape[a_shape.NumDimensions() - 1]) == K_,
+                    "MatMulNBits: the last dimension of A must be K (", K_, "), got ", a_shape);
+
+  const size_t block_count_k = (K_ + block_size_ - 1) / block_size_;
+  const size_t blob_size = block_size_ * bits_ / 8;
+  ORT_RETURN_IF_NOT(static_cast<size_t>(b->Shape().Size()) == N_ * block_count_k * blob_size,
+                    "MatMulNBits: B must have N x ceil(K / block_size) x block_size * bits / 8 elements");
+  ORT_RETURN_IF_NOT(static_cast<size_t>(scales->Shape().Size()) == N_ * block_count_k,
+                    "MatMulNBits: scales must have N x ceil(K / block_size) elements");
+  ORT_RETURN_IF_NOT(zero_points == nullptr ||
+                        static_cast<size_t>(zero_points->Shape().Size()) == N_ * ((block_count_k * bits_ + 7) / 8),
+                    "MatMulNBits: zero_points must have N x ceil(ceil(K / block_size) * bits / 8) elements");
+  ORT_RETURN_IF_NOT(bias == nullptr || static_cast<size_t>(bias->Shape().Size()) == N_,
+                    "MatMulNBits: bias must have N elements");
+
+  TensorShapeVector y_dims = a_shape.AsShapeVector();
+  y_dims.back() = static_cast<int64_t>(N_);
+  Tensor* y = ctx->Output(0, TensorShape(y_dims));
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const size_t M = static_cast<size_t>(a_shape.SizeToDimension(a_shape.NumDimensions() - 1));
+
+  MLAS_BLKQUANT_GEMM_DATA_PARAMS data;
+  data.A = a->Data<float>();
+  data.lda = K_;
+  data.QuantBData = b->Data<uint8_t>();
+  data.QuantBScale = scales->Data<float>();
+  data.QuantBZeroPoint = zero_points == nullptr ? nullptr : zero_points->Data<uint8_t>();
+  data.Bias = bias == nullptr ? nullptr : bias->Data<float>();
+  data.C = y->MutableData<float>();
+  data.ldc = N_;
+
+  MlasBlkQuantGemm(M, N_, K_, bits_, block_size_, &data, ctx->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulNBits,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    MatMulNBits);
+
+}  // namespace contrib
+}  // namespace onnxruntime
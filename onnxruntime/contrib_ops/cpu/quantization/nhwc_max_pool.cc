@@ -11,7 +11,7 @@
 namespace onnxruntime {
 namespace contrib {
 
-template <typename T8Bits>
+template <typename T>
 class NhwcMaxPool : public OpKernel {
  public:
   explicit NhwcMaxPool(const OpKernelInfo& info) : OpKernel(info),
@@ -24,8 +24,8 @@ class NhwcMaxPool : public OpKernel {
   PoolAttributes pool_attrs_;
 };
 
-template <typename T8Bits>
-Status NhwcMaxPool<T8Bits>::Compute(OpKernelContext* context) const {
+template <typename T>
+Status NhwcMaxPool<T>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const TensorShape& input_shape = X->Shape();
 
@@ -75,17 +75,17 @@ Status NhwcMaxPool<T8Bits>::Compute(OpKernelContext* context) const {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
   int64_t col_buffer_batch_count = std::min(output_image_size, output_batch_count);
-  auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const T8Bits*)) * kernel_size * col_buffer_batch_count);
+  auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(const T*)) * kernel_size * col_buffer_batch_count);
   BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  std::vector<T8Bits> padding_data(static_cast<size_t>(C), std::numeric_limits<T8Bits>::lowest());
+  std::vector<T> padding_data(static_cast<size_t>(C), std::numeric_limits<T>::lowest());
 
-  const auto* Xdata = X->template Data<T8Bits>();
-  auto* Ydata = Y->template MutableData<T8Bits>();
+  const auto* Xdata = X->template Data<T>();
+  auto* Ydata = Y->template MutableData<T>();
 
   for (int64_t image_id = 0; image_id < N; ++image_id) {
     for (int64_t output_start = 0; output_start < output_image_size;) {
       int64_t output_count = std::min(output_image_size - output_start, output_batch_count);
-      math::Im2col<T8Bits, StorageOrder::NHWC>()(
+      math::Im2col<T, StorageOrder::NHWC>()(
           Xdata,
           C,
           input_shape.GetDims().data() + 1,
@@ -97,10 +97,10 @@ Status NhwcMaxPool<T8Bits>::Compute(OpKernelContext* context) const {
           static_cast<ptrdiff_t>(spatial_dims),
           output_start,
           output_count,
-          static_cast<T8Bits const**>(col_buffer.get()),
+          static_cast<T const**>(col_buffer.get()),
           padding_data.data());
       MlasMaximumPool(
-          static_cast<T8Bits const**>(col_buffer.get()),
+          static_cast<T const**>(col_buffer.get()),
           Ydata,
           static_cast<size_t>(C),
           static_cast<size_t>(output_count),
@@ -129,6 +129,7 @@ Status NhwcMaxPool<T8Bits>::Compute(OpKernelContext* context) const {
 
 REGISTER_NHWCMAXPOOL_TYPED_KERNEL(int8_t);
 REGISTER_NHWCMAXPOOL_TYPED_KERNEL(uint8_t);
+REGISTER_NHWCMAXPOOL_TYPED_KERNEL(float);
 
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "qlinear_binary_op.h"
+#include "qlinear_lookup_table.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/common.h"
 #include "core/mlas/inc/mlas.h"
@@ -19,14 +20,16 @@ struct QLinearBroadcastHelper : public BroadcastHelper {
                          ThreadPool* threadpool,
                          double unit_cost,
                          float A_scale_in, float B_scale_in, float C_scale_in,
-                         uint8_t A_zero_point_in, uint8_t B_zero_point_in, uint8_t C_zero_point_in)
+                         uint8_t A_zero_point_in, uint8_t B_zero_point_in, uint8_t C_zero_point_in,
+                         const uint8_t* activation_table_in)
       : BroadcastHelper{input_broadcaster, output_broadcaster, nullptr, threadpool, unit_cost},
         A_scale{A_scale_in},
         B_scale{B_scale_in},
         C_scale{C_scale_in},
         A_zero_point{A_zero_point_in},
         B_zero_point{B_zero_point_in},
-        C_zero_point{C_zero_point_in} {
+        C_zero_point{C_zero_point_in},
+        activation_table{activation_table_in} {
   }
 
   QLinearBroadcastHelper(const QLinearBroadcastHelper& rhs, size_t offset, size_t num_elements)
@@ -36,7 +39,8 @@ struct QLinearBroadcastHelper : public BroadcastHelper {
         C_scale{rhs.C_scale},
         A_zero_point{rhs.A_zero_point},
         B_zero_point{rhs.B_zero_point},
-        C_zero_point{rhs.C_zero_point} {
+        C_zero_point{rhs.C_zero_point},
+        activation_table{rhs.activation_table} {
   }
 
   float A_scale;
@@ -47,10 +51,155 @@ struct QLinearBroadcastHelper : public BroadcastHelper {
   uint8_t A_zero_point;
   uint8_t B_zero_point;
   uint8_t C_zero_point;
+  const uint8_t* activation_table;
 };
 
 template <typename T>
-void QLinearImpl(OpKernelContext& context, double unit_cost, const ProcessBroadcastSpanFuncs& functors) {
+using QLinearBinaryKernel = void(MLASCALL*)(const T* InputA, float ScaleA, int32_t ZeroPointA,
+                                            const T* InputB, float ScaleB, int32_t ZeroPointB,
+                                            float ScaleC, int32_t ZeroPointC,
+                                            T* OutputC, size_t N, bool IsScalarB);
+
+// Applies the fused activation to a block of output while it is still in cache.
+template <typename T>
+inline void ApplyActivation(const uint8_t* activation_table, T* output, size_t count) {
+  if (activation_table != nullptr) {
+    auto* output_bytes = reinterpret_cast<uint8_t*>(output);
+    QLinearLookupTableTransform(output_bytes, activation_table, output_bytes, count);
+  }
+}
+
+// Both operations are commutative, so a scalar input0 is passed to the kernel as its scalar B.
+template <typename T, QLinearBinaryKernel<T> Kernel>
+ProcessBroadcastSpanFuncs QLinearBinaryFunctors() {
+  return {
+      [](BroadcastHelper& per_iter_bh) {
+        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
+        const T input0 = per_iter_bh.ScalarInput0<T>();
+        auto input1 = per_iter_bh.SpanInput1<T>();
+        auto output = per_iter_bh.OutputSpan<T>();
+
+        Kernel(input1.data(),
+               qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
+               &input0,
+               qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
+               qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
+               output.data(), output.size(), true);
+        ApplyActivation(qlbh.activation_table, output.data(), output.size());
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
+        auto input0 = per_iter_bh.SpanInput0<T>();
+        const T input1 = per_iter_bh.ScalarInput1<T>();
+        auto output = per_iter_bh.OutputSpan<T>();
+
+        Kernel(input0.data(),
+               qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
+               &input1,
+               qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
+               qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
+               output.data(), output.size(), true);
+        ApplyActivation(qlbh.activation_table, output.data(), output.size());
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
+        auto input0 = per_iter_bh.SpanInput0<T>();
+        auto input1 = per_iter_bh.SpanInput1<T>();
+        auto output = per_iter_bh.OutputSpan<T>();
+
+        Kernel(input0.data(),
+               qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
+               input1.data(),
+               qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
+               qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
+               output.data(), output.size(), false);
+        ApplyActivation(qlbh.activation_table, output.data(), output.size());
+      }};
+}
+
+// Returns true if `channel_shape` only differs from `full_shape` by being broadcast outside of one contiguous run
+// of dimensions, e.g. [C, 1, 1] against [N, C, H, W] or [C] against [N, H, W, C]. The element counts of the
+// dimensions before, within and after that run are returned in outer, channels and inner.
+bool IsChannelBroadcast(const TensorShape& full_shape, const TensorShape& channel_shape,
+                        size_t& outer, size_t& channels, size_t& inner) {
+  const size_t rank = full_shape.NumDimensions();
+  const size_t channel_rank = channel_shape.NumDimensions();
+  if (channel_rank > rank) {
+    return false;
+  }
+
+  const size_t offset = rank - channel_rank;
+  size_t first = rank;
+  size_t last = 0;
+  for (size_t i = 0; i < channel_rank; ++i) {
+    if (channel_shape[i] != 1) {
+      first = std::min(first, offset + i);
+      last = offset + i;
+    }
+  }
+
+  // a scalar channel input already runs as a single span
+  if (first == rank) {
+    return false;
+  }
+
+  for (size_t i = first; i <= last; ++i) {
+    if (channel_shape[i - offset] != full_shape[i]) {
+      return false;
+    }
+  }
+
+  outer = static_cast<size_t>(full_shape.SizeToDimension(first));
+  channels = static_cast<size_t>(full_shape.SizeHelper(first, last + 1));
+  inner = static_cast<size_t>(full_shape.SizeFromDimension(last + 1));
+
+  // inputs of the same shape already run as a single span
+  return outer * inner > 1;
+}
+
+// The generic broadcast loop walks a channel broadcast one span at a time on the calling thread. Instead, run the
+// vectorized kernel over whole rows and parallelize across them.
+template <typename T, QLinearBinaryKernel<T> Kernel>
+void QLinearChannelBroadcast(const T* full, float full_scale, T full_zero_point,
+                             const T* channel, float channel_scale, T channel_zero_point,
+                             float C_scale, T C_zero_point, T* output,
+                             size_t outer, size_t channels, size_t inner,
+                             const uint8_t* activation_table, ThreadPool* tp) {
+  if (inner == 1) {
+    // channels last: each row of the full input is combined with the whole channel vector
+    const double row_size = static_cast<double>(channels);
+    ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(outer), TensorOpCost{2.0 * row_size, row_size, row_size},
+        [=](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t o = begin; o < end; ++o) {
+            const size_t row_offset = static_cast<size_t>(o) * channels;
+            Kernel(full + row_offset, full_scale, full_zero_point,
+                   channel, channel_scale, channel_zero_point,
+                   C_scale, C_zero_point,
+                   output + row_offset, channels, false);
+            ApplyActivation(activation_table, output + row_offset, channels);
+          }
+        });
+  } else {
+    // channels first: each row of the full input is combined with a single channel value
+    const double row_size = static_cast<double>(inner);
+    ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(outer * channels), TensorOpCost{row_size, row_size, row_size},
+        [=](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t r = begin; r < end; ++r) {
+            const size_t row_offset = static_cast<size_t>(r) * inner;
+            Kernel(full + row_offset, full_scale, full_zero_point,
+                   channel + static_cast<size_t>(r) % channels, channel_scale, channel_zero_point,
+                   C_scale, C_zero_point,
+                   output + row_offset, inner, true);
+            ApplyActivation(activation_table, output + row_offset, inner);
+          }
+        });
+  }
+}
+
+template <typename T, QLinearBinaryKernel<T> Kernel>
+void QLinearImpl(OpKernelContext& context, double unit_cost, const uint8_t* activation_table) {
   auto tensor_a_scale = context.Input<Tensor>(1);
   auto tensor_a_zero_point = context.Input<Tensor>(2);
   auto tensor_b_scale = context.Input<Tensor>(4);
@@ -78,7 +227,28 @@ void QLinearImpl(OpKernelContext& context, double unit_cost, const ProcessBroadc
   const float C_scale = *(tensor_c_scale->Data<float>());
   const T C_zero_point = (nullptr == tensor_c_zero_point) ? T{} : *(tensor_c_zero_point->template Data<T>());
 
-  InputBroadcaster input_broadcaster{*context.Input<Tensor>(0), *context.Input<Tensor>(3)};
+  const Tensor& tensor_a = *context.Input<Tensor>(0);
+  const Tensor& tensor_b = *context.Input<Tensor>(3);
+
+  size_t outer, channels, inner;
+  if (IsChannelBroadcast(tensor_a.Shape(), tensor_b.Shape(), outer, channels, inner)) {
+    Tensor& tensor_c = *context.Output(0, tensor_a.Shape());
+    QLinearChannelBroadcast<T, Kernel>(tensor_a.template Data<T>(), A_scale, A_zero_point,
+                                       tensor_b.template Data<T>(), B_scale, B_zero_point,
+                                       C_scale, C_zero_point, tensor_c.template MutableData<T>(),
+                                       outer, channels, inner, activation_table, context.GetOperatorThreadPool());
+    return;
+  }
+  if (IsChannelBroadcast(tensor_b.Shape(), tensor_a.Shape(), outer, channels, inner)) {
+    Tensor& tensor_c = *context.Output(0, tensor_b.Shape());
+    QLinearChannelBroadcast<T, Kernel>(tensor_b.template Data<T>(), B_scale, B_zero_point,
+                                       tensor_a.template Data<T>(), A_scale, A_zero_point,
+                                       C_scale, C_zero_point, tensor_c.template MutableData<T>(),
+                                       outer, channels, inner, activation_table, context.GetOperatorThreadPool());
+    return;
+  }
+
+  InputBroadcaster input_broadcaster{tensor_a, tensor_b};
   OutputBroadcaster output_broadcaster{input_broadcaster.GetSpanSize(),
                                        *context.Output(0, input_broadcaster.GetOutputShape())};
 
@@ -87,102 +257,88 @@ void QLinearImpl(OpKernelContext& context, double unit_cost, const ProcessBroadc
                                           A_scale, B_scale, C_scale,
                                           static_cast<uint8_t>(A_zero_point),
                                           static_cast<uint8_t>(B_zero_point),
-                                          static_cast<uint8_t>(C_zero_point));
+                                          static_cast<uint8_t>(C_zero_point),
+                                          activation_table);
 
-  BroadcastLooper(broadcast_helper, functors);
+  BroadcastLooper(broadcast_helper, QLinearBinaryFunctors<T, Kernel>());
 }
 }  // namespace
 
 template <typename T>
-Status QLinearAdd<T>::Compute(OpKernelContext* context) const {
-  const ProcessBroadcastSpanFuncs functors = {
-      [](BroadcastHelper& per_iter_bh) {
-        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
-        const T input0 = per_iter_bh.ScalarInput0<T>();
-        auto input1 = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-
-        MlasQLinearAdd(input1.data(),
-                       qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
-                       &input0,
-                       qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
-                       qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
-                       output.data(), output.size(), true);
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
-        auto input0 = per_iter_bh.SpanInput0<T>();
-        const T input1 = per_iter_bh.ScalarInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        MlasQLinearAdd(input0.data(),
-                       qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
-                       &input1,
-                       qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
-                       qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
-                       output.data(), output.size(), true);
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
-        auto input0 = per_iter_bh.SpanInput0<T>();
-        auto input1 = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
+QLinearBinaryBase<T>::QLinearBinaryBase(const OpKernelInfo& info)
+    : OpKernel(info),
+      activation_(info.GetAttrOrDefault<std::string>("activation", "")),
+      activation_alpha_(info.GetAttrOrDefault("activation_alpha", 0.01f)) {
+  ORT_ENFORCE(activation_.empty() || activation_ == "Sigmoid" || activation_ == "LeakyRelu",
+              "Unsupported fused activation: ", activation_);
+  if (activation_.empty()) {
+    return;
+  }
 
-        MlasQLinearAdd(input0.data(),
-                       qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
-                       input1.data(),
-                       qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
-                       qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
-                       output.data(), output.size(), false);
-      }};
+  const auto& input_defs = info.node().InputDefs();
+  const Tensor* tensor_c_scale = nullptr;
+  const Tensor* tensor_c_zero_point = nullptr;
+  const Tensor* tensor_y_scale = nullptr;
+  const Tensor* tensor_y_zero_point = nullptr;
+  bool get_c_scale = info.TryGetConstantInput(6, &tensor_c_scale);
+  bool get_c_zero_point = input_defs.size() <= 7 || !input_defs[7]->Exists() ||
+                          info.TryGetConstantInput(7, &tensor_c_zero_point);
+  bool get_y_scale = input_defs.size() > 8 && info.TryGetConstantInput(8, &tensor_y_scale);
+  bool get_y_zero_point = input_defs.size() <= 9 || !input_defs[9]->Exists() ||
+                          info.TryGetConstantInput(9, &tensor_y_zero_point);
 
-  QLinearImpl<T>(*context, 1.0, functors);
+  if (get_c_scale && get_c_zero_point && get_y_scale && get_y_zero_point) {
+    fixed_activation_table_.resize(256);
+    BuildActivationTable(fixed_activation_table_.data(),
+                         tensor_c_scale, tensor_c_zero_point, tensor_y_scale, tensor_y_zero_point);
+  }
+}
 
-  return Status::OK();
+template <typename T>
+void QLinearBinaryBase<T>::BuildActivationTable(uint8_t* table,
+                                                const Tensor* tensor_c_scale, const Tensor* tensor_c_zero_point,
+                                                const Tensor* tensor_y_scale, const Tensor* tensor_y_zero_point) const {
+  ORT_ENFORCE(tensor_y_scale != nullptr, "Y_scale is required when an activation is fused");
+  if (activation_ == "Sigmoid") {
+    QlinearBuildLookupTable<T>(table, tensor_c_scale, tensor_c_zero_point, tensor_y_scale, tensor_y_zero_point,
+                               LookupTableArrayTransformer([](const float* input, float* output, size_t length) {
+                                 MlasComputeLogistic(input, output, length);
+                               }));
+  } else {
+    const float alpha = activation_alpha_;
+    QlinearBuildLookupTable<T>(table, tensor_c_scale, tensor_c_zero_point, tensor_y_scale, tensor_y_zero_point,
+                               LookupTableScalarTransformer([alpha](float v) -> float {
+                                 return v >= 0.0f ? v : alpha * v;
+                               }));
+  }
 }
 
 template <typename T>
-Status QLinearMul<T>::Compute(OpKernelContext* context) const {
-  const ProcessBroadcastSpanFuncs functors = {
-      [](BroadcastHelper& per_iter_bh) {
-        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
-        const T input0 = per_iter_bh.ScalarInput0<T>();
-        auto input1 = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
+const uint8_t* QLinearBinaryBase<T>::GetActivationTable(OpKernelContext& context, uint8_t* table) const {
+  if (activation_.empty()) {
+    return nullptr;
+  }
+  if (!fixed_activation_table_.empty()) {
+    return fixed_activation_table_.data();
+  }
 
-        MlasQLinearMul(input1.data(),
-                       qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
-                       &input0,
-                       qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
-                       qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
-                       output.data(), output.size(), true);
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
-        auto input0 = per_iter_bh.SpanInput0<T>();
-        const T input1 = per_iter_bh.ScalarInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        MlasQLinearMul(input0.data(),
-                       qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
-                       &input1,
-                       qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
-                       qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
-                       output.data(), output.size(), true);
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        QLinearBroadcastHelper& qlbh = static_cast<QLinearBroadcastHelper&>(per_iter_bh);
-        auto input0 = per_iter_bh.SpanInput0<T>();
-        auto input1 = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
+  BuildActivationTable(table, context.Input<Tensor>(6), context.Input<Tensor>(7),
+                       context.Input<Tensor>(8), context.Input<Tensor>(9));
+  return table;
+}
 
-        MlasQLinearMul(input0.data(),
-                       qlbh.A_scale, static_cast<T>(qlbh.A_zero_point),
-                       input1.data(),
-                       qlbh.B_scale, static_cast<T>(qlbh.B_zero_point),
-                       qlbh.C_scale, static_cast<T>(qlbh.C_zero_point),
-                       output.data(), output.size(), false);
-      }};
+template <typename T>
+Status QLinearAdd<T>::Compute(OpKernelContext* context) const {
+  uint8_t table[256];
+  QLinearImpl<T, MlasQLinearAdd<T>>(*context, 1.0, this->GetActivationTable(*context, table));
+
+  return Status::OK();
+}
 
-  QLinearImpl<T>(*context, 1.0, functors);
+template <typename T>
+Status QLinearMul<T>::Compute(OpKernelContext* context) const {
+  uint8_t table[256];
+  QLinearImpl<T, MlasQLinearMul<T>>(*context, 1.0, this->GetActivationTable(*context, table));
 
   return Status::OK();
 }
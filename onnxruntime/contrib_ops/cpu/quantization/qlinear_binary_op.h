@@ -11,17 +11,38 @@ namespace onnxruntime {
 namespace contrib {
 
 template <typename T>
-class QLinearAdd final : public OpKernel {
+class QLinearBinaryBase : public OpKernel {
  public:
-  QLinearAdd(const OpKernelInfo& info) : OpKernel(info) {}
+  QLinearBinaryBase(const OpKernelInfo& info);
+
+ protected:
+  // Returns the lookup table of the activation fused into this node, which maps C to the final output quantized
+  // with Y_scale and Y_zero_point, or nullptr when no activation is fused. The table is built into `table` unless
+  // the quantization parameters are constant, in which case it is pre-computed at construction.
+  const uint8_t* GetActivationTable(OpKernelContext& context, uint8_t* table) const;
+
+ private:
+  void BuildActivationTable(uint8_t* table,
+                            const Tensor* tensor_c_scale, const Tensor* tensor_c_zero_point,
+                            const Tensor* tensor_y_scale, const Tensor* tensor_y_zero_point) const;
+
+  std::string activation_;
+  float activation_alpha_;
+  std::vector<uint8_t> fixed_activation_table_;
+};
+
+template <typename T>
+class QLinearAdd final : public QLinearBinaryBase<T> {
+ public:
+  QLinearAdd(const OpKernelInfo& info) : QLinearBinaryBase<T>(info) {}
 
   Status Compute(OpKernelContext* context) const override;
 };
 
 template <typename T>
-class QLinearMul final : public OpKernel {
+class QLinearMul final : public QLinearBinaryBase<T> {
  public:
-  QLinearMul(const OpKernelInfo& info) : OpKernel(info) {}
+  QLinearMul(const OpKernelInfo& info) : QLinearBinaryBase<T>(info) {}
 
   Status Compute(OpKernelContext* context) const override;
 };
@@ -88,6 +88,20 @@ void QlinearBuildLookupTable(uint8_t* table,
                                     tensor_y_scale, tensor_y_zero_point, array_values_transformer);
 }
 
+template void QlinearBuildLookupTable<uint8_t>(uint8_t* table,
+                                               const Tensor* tensor_x_scale,
+                                               const Tensor* tensor_x_zero_point,
+                                               const Tensor* tensor_y_scale,
+                                               const Tensor* tensor_y_zero_point,
+                                               const LookupTableArrayTransformer& array_values_transformer);
+
+template void QlinearBuildLookupTable<int8_t>(uint8_t* table,
+                                              const Tensor* tensor_x_scale,
+                                              const Tensor* tensor_x_zero_point,
+                                              const Tensor* tensor_y_scale,
+                                              const Tensor* tensor_y_zero_point,
+                                              const LookupTableArrayTransformer& array_values_transformer);
+
 template void QlinearBuildLookupTable<uint8_t>(uint8_t* table,
                                                const Tensor* tensor_x_scale,
                                                const Tensor* tensor_x_zero_point,
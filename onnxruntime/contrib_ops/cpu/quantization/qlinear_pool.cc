@@ -217,10 +217,15 @@ struct QLinearPool2DTask final {
   }
 };
 
-template <typename T8Bits, typename PoolType>
-struct QLinearPoolNhwc2DTask final {
-  const float* X_data;
+// Average pooling of a channels last 2D image on the quantized values themselves. The sums of the window are
+// accumulated per channel in int32 by a loop over contiguous channels, and each pooled pixel is requantized with a
+// single vectorized MlasRequantizeOutput call, so the input is never dequantized to float.
+template <typename T8Bits>
+struct QLinearAveragePoolNhwc2DTask final {
+  const T8Bits* X_data;
   T8Bits* Y_data;
+  float x_scale;
+  T8Bits x_zero_point;
   float y_scale;
   T8Bits y_zero_point;
   int64_t x_image_size;
@@ -235,12 +240,11 @@ struct QLinearPoolNhwc2DTask final {
   int64_t width;
   const TensorShapeVector& kernel_shape;
   const TensorShapeVector& pads;
-  const PoolProcessContext& pool_context_;
   const PoolAttributes& pool_attrs_;
 
   TensorOpCost Cost() {
     double loop_count = static_cast<double>(channels * kernel_size);
-    return TensorOpCost{loop_count, loop_count, loop_count};
+    return TensorOpCost{loop_count, static_cast<double>(channels), loop_count};
   }
 
   void operator()(std::ptrdiff_t begin, std::ptrdiff_t end) const {
@@ -259,17 +263,16 @@ struct QLinearPoolNhwc2DTask final {
   }
 
   void operator()(std::ptrdiff_t batch, std::ptrdiff_t begin, std::ptrdiff_t end) const {
-    const float* x_d = X_data + batch * x_image_size * channels;
+    const T8Bits* x_d = X_data + batch * x_image_size * channels;
     T8Bits* y_d = Y_data + batch * y_image_size * channels;
 
-    // Calculate starting pooled_h, pooled_w, pooled_d
     int64_t start_pw = begin;
     int64_t start_ph = start_pw / pooled_width;
     start_pw -= (start_ph * pooled_width);
 
     int64_t pool_index = channels * begin;
     std::ptrdiff_t remains = end - begin;
-    std::vector<float> Yh(channels);
+    std::vector<int32_t> acc(static_cast<size_t>(channels));
 
     for (int64_t ph = start_ph; remains > 0 && ph < pooled_height; ++ph) {
       int64_t hstart = ph * stride_h - pads[0];
@@ -280,25 +283,24 @@ struct QLinearPoolNhwc2DTask final {
         int64_t wend = std::min(wstart + kernel_shape[1], width);
         wstart = std::max(wstart, static_cast<int64_t>(0));
 
-        // do the pooling here
-        constexpr float pool_init_value = PoolType::Initialize();
-        std::fill(Yh.data(), Yh.data() + channels, pool_init_value);
+        // Padding contributes zero after the zero point is subtracted, so only the valid pixels are summed.
+        const int64_t valid_count = (hend - hstart) * (wend - wstart);
+        std::fill(acc.begin(), acc.end(), static_cast<int32_t>(-valid_count * x_zero_point));
+        int32_t* acc_d = acc.data();
         for (int64_t h = hstart; h < hend; ++h) {
-          int64_t input_index = channels * (h * width + wstart);
+          const T8Bits* x_row = x_d + channels * (h * width + wstart);
           for (int64_t w = wstart; w < wend; ++w) {
             for (int64_t c = 0; c < channels; c++) {
-              PoolType::Process(x_d[input_index + c], Yh[c], pool_context_);
+              acc_d[c] += x_row[c];
             }
-            input_index += channels;
+            x_row += channels;
           }
         }
 
-        int64_t elements_count = (pool_attrs_.count_include_pad) ? kernel_size : (hend - hstart) * (wend - wstart);
-        for (int64_t c = 0; c < channels; c++) {
-          PoolType::Finalize(elements_count, Yh[c], pool_context_);
-          auto y_value = quantize_value(Yh[c], y_scale, y_zero_point);
-          y_d[pool_index + c] = y_value;
-        }
+        const int64_t elements_count = pool_attrs_.count_include_pad ? kernel_size : valid_count;
+        const float scale = x_scale / (static_cast<float>(std::max(elements_count, static_cast<int64_t>(1))) * y_scale);
+        MlasRequantizeOutput(acc_d, static_cast<size_t>(channels), y_d + pool_index, static_cast<size_t>(channels),
+                             nullptr, &scale, false, y_zero_point, 0, 0, 1, static_cast<size_t>(channels));
 
         pool_index += channels;
         remains--;
@@ -577,6 +579,14 @@ Status QLinearAveragePool::ComputeImpl(OpKernelContext* context) const {
                                        batch_count, channels, kernel_size, channels_last_, tp);
   }
 
+  if (channels_last_ && kernel_shape.size() == 2) {
+    QLinearAveragePoolNhwc2DTask<T8Bits> avg_pool_task_2d = {
+        X_data, Y_data, x_scale, x_zero_point, y_scale, y_zero_point, x_image_size, y_image_size, kernel_size,
+        channels, pooled_height, pooled_width, strides[0], strides[1], height, width, kernel_shape, pads, pool_attrs_};
+    ThreadPool::TryParallelFor(tp, y_image_size * batch_count, avg_pool_task_2d.Cost(), avg_pool_task_2d);
+    return Status::OK();
+  }
+
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
   float* x_data_fp32 = nullptr;
@@ -604,18 +614,10 @@ Status QLinearAveragePool::ComputeImpl(OpKernelContext* context) const {
     }
 
     case 2: {
-      if (channels_last_) {
-        QLinearPoolNhwc2DTask<T8Bits, onnxruntime::AveragePool> avg_pool_task_2d = {
-            x_data_fp32, Y_data, y_scale, y_zero_point, x_image_size, y_image_size, kernel_size, channels,
-            pooled_height, pooled_width, strides[0], strides[1], height, width, kernel_shape, pads, pool_context_, pool_attrs_};
-        ThreadPool::TryParallelFor(tp, y_image_size * batch_count, avg_pool_task_2d.Cost(), avg_pool_task_2d);
-
-      } else {
-        QLinearPool2DTask<T8Bits, onnxruntime::AveragePool> avg_pool_task_2d = {
-            x_data_fp32, Y_data, y_scale, y_zero_point, x_image_size, y_image_size,
-            pooled_height, pooled_width, strides[0], strides[1], height, width, kernel_shape, pads, pool_context_, pool_attrs_};
-        ThreadPool::TryParallelFor(tp, total_channels, avg_pool_task_2d.Cost(), avg_pool_task_2d);
-      }
+      QLinearPool2DTask<T8Bits, onnxruntime::AveragePool> avg_pool_task_2d = {
+          x_data_fp32, Y_data, y_scale, y_zero_point, x_image_size, y_image_size,
+          pooled_height, pooled_width, strides[0], strides[1], height, width, kernel_shape, pads, pool_context_, pool_attrs_};
+      ThreadPool::TryParallelFor(tp, total_channels, avg_pool_task_2d.Cost(), avg_pool_task_2d);
       break;
     }
 
@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "qlinear_softmax.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+void BuildExpTable(float x_scale, float* table) {
+  for (int d = 0; d < 256; ++d) {
+    table[d] = std::exp(-x_scale * static_cast<float>(d));
+  }
+}
+
+// Softmax of `count` values of `x` that are `stride` elements apart.
+// As softmax(x) = exp(x - max) / sum(exp(x - max)), the zero point of X cancels out and exp only needs to be
+// evaluated for the 256 possible differences between a value and the maximum of its row.
+template <typename T>
+void ComputeQLinearSoftmaxRow(const T* x, T* y, int64_t count, int64_t stride, const float* exp_table,
+                              float y_scale, T y_zero_point, float* buffer, T* quantized_buffer) {
+  int max_value = static_cast<int>(x[0]);
+  for (int64_t i = 1; i < count; ++i) {
+    max_value = std::max(max_value, static_cast<int>(x[i * stride]));
+  }
+
+  float sum = 0.0f;
+  for (int64_t i = 0; i < count; ++i) {
+    buffer[i] = exp_table[max_value - static_cast<int>(x[i * stride])];
+    sum += buffer[i];
+  }
+
+  const float inverse_sum = 1.0f / sum;
+  for (int64_t i = 0; i < count; ++i) {
+    buffer[i] *= inverse_sum;
+  }
+
+  if (stride == 1) {
+    MlasQuantizeLinear(buffer, y, static_cast<size_t>(count), y_scale, y_zero_point);
+  } else {
+    MlasQuantizeLinear(buffer, quantized_buffer, static_cast<size_t>(count), y_scale, y_zero_point);
+    for (int64_t i = 0; i < count; ++i) {
+      y[i * stride] = quantized_buffer[i];
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+QLinearSoftmax<T>::QLinearSoftmax(const OpKernelInfo& info) : OpKernel(info) {
+  opset_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("opset", 13));
+  axis_ = info.GetAttrOrDefault<int64_t>("axis", opset_ < 13 ? 1 : -1);
+
+  const Tensor* tensor_x_scale = nullptr;
+  if (info.TryGetConstantInput(1, &tensor_x_scale)) {
+    ORT_ENFORCE(IsScalarOr1ElementVector(tensor_x_scale),
+                "QLinearSoftmax : input X_scale must be a scalar or 1D tensor of size 1");
+    fixed_exp_table_.resize(256);
+    BuildExpTable(*tensor_x_scale->Data<float>(), fixed_exp_table_.data());
+  }
+}
+
+template <typename T>
+Status QLinearSoftmax<T>::Compute(OpKernelContext* context) const {
+  const auto& X = *context->Input<Tensor>(0);
+  const auto* tensor_x_scale = context->Input<Tensor>(1);
+  const auto* tensor_y_scale = context->Input<Tensor>(3);
+  const auto* tensor_y_zero_point = context->Input<Tensor>(4);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_x_scale),
+                    "QLinearSoftmax : input X_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_y_scale),
+                    "QLinearSoftmax : input Y_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(tensor_y_zero_point == nullptr || IsScalarOr1ElementVector(tensor_y_zero_point),
+                    "QLinearSoftmax : input Y_zero_point must be a scalar or 1D tensor of size 1");
+
+  const float y_scale = *tensor_y_scale->Data<float>();
+  const T y_zero_point = tensor_y_zero_point == nullptr ? static_cast<T>(0) : *tensor_y_zero_point->Data<T>();
+
+  const auto& input_shape = X.Shape();
+  auto& Y = *context->Output(0, input_shape);
+  if (input_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const size_t axis = gsl::narrow<size_t>(HandleNegativeAxis(axis_, static_cast<int64_t>(input_shape.NumDimensions())));
+
+  // view the input as [outer, count, inner] and reduce along count
+  const int64_t outer = input_shape.SizeToDimension(axis);
+  int64_t count = input_shape.SizeFromDimension(axis);
+  int64_t inner = 1;
+  if (opset_ >= 13) {
+    count = input_shape[axis];
+    inner = input_shape.SizeFromDimension(axis + 1);
+  }
+
+  float exp_table[256];
+  const float* table = fixed_exp_table_.data();
+  if (fixed_exp_table_.empty()) {
+    BuildExpTable(*tensor_x_scale->Data<float>(), exp_table);
+    table = exp_table;
+  }
+
+  const T* x_data = X.Data<T>();
+  T* y_data = Y.MutableData<T>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), outer * inner,
+      TensorOpCost{static_cast<double>(count), static_cast<double>(count), 8.0 * count},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> buffer(static_cast<size_t>(count));
+        std::vector<T> quantized_buffer(inner == 1 ? 0 : static_cast<size_t>(count));
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t offset = (row / inner) * count * inner + row % inner;
+          ComputeQLinearSoftmaxRow(x_data + offset, y_data + offset, count, inner, table,
+                                   y_scale, y_zero_point, buffer.data(), quantized_buffer.data());
+        }
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(data_type)                  \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                      \
+      QLinearSoftmax, 1, data_type,                                       \
+      KernelDefBuilder()                                                  \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      QLinearSoftmax<data_type>);
+
+REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_SOFTMAX_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class QLinearSoftmax final : public OpKernel {
+ public:
+  QLinearSoftmax(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  // Softmax before opset 13 coerces the input to 2D at axis instead of reducing along the axis only
+  int opset_;
+
+  // exp(-X_scale * d) for every difference d between the maximum of a row and one of its values.
+  // Non-empty if X_scale is constant.
+  std::vector<float> fixed_exp_table_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
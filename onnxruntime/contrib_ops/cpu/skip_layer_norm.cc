@@ -2,9 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
+#include "layer_norm.h"
 #include "skip_layer_norm.h"
 
 namespace onnxruntime {
@@ -23,6 +25,7 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
 
 template <typename T>
 SkipLayerNorm<T>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
@@ -90,46 +93,72 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   int64_t hidden_size = input_dims[2];
   int64_t task_count = batch_size * sequence_length;
 
-  const T* input_data = input->Data<T>();
-  const T* skip_data = skip->Data<T>();
-  const T* gamma_data = gamma->Data<T>();
-  const T* beta_data = beta == nullptr ? nullptr : beta->Data<T>();
-  const T* bias_data = bias == nullptr ? nullptr : bias->Data<T>();
-
-  T* output_data = output->MutableData<T>();
-
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-      [&](ptrdiff_t task_idx) {
-        const T* p_input = input_data + task_idx * hidden_size;
-        const T* p_skip = skip_data + task_idx * hidden_size;
-        T* p_output = output_data + task_idx * hidden_size;
+  if constexpr (std::is_same<T, float>::value) {
+    MlasLayerNormalization(input->Data<float>(), skip->Data<float>(),
+                           bias == nullptr ? nullptr : bias->Data<float>(), gamma->Data<float>(),
+                           beta == nullptr ? nullptr : beta->Data<float>(), output->MutableData<float>(),
+                           nullptr, nullptr, static_cast<size_t>(task_count), static_cast<size_t>(hidden_size),
+                           epsilon_, false, p_ctx->GetOperatorThreadPool());
+  } else if constexpr (std::is_same<T, MLFloat16>::value) {
+    // normalize in float, the conversions are vectorized and the output is converted in place
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
+    concurrency::ThreadPool* thread_pool = p_ctx->GetOperatorThreadPool();
+
+    auto input_float = ConvertHalfTensorToFloat(input, alloc, thread_pool);
+    auto skip_float = ConvertHalfTensorToFloat(skip, alloc, thread_pool);
+    auto gamma_float = ConvertHalfTensorToFloat(gamma, alloc, thread_pool);
+    auto beta_float = ConvertHalfTensorToFloat(beta, alloc, thread_pool);
+    auto bias_float = ConvertHalfTensorToFloat(bias, alloc, thread_pool);
+
+    const size_t element_count = static_cast<size_t>(task_count * hidden_size);
+    MlasLayerNormalization(input_float.get(), skip_float.get(), bias_float.get(), gamma_float.get(), beta_float.get(),
+                           input_float.get(), nullptr, nullptr, static_cast<size_t>(task_count),
+                           static_cast<size_t>(hidden_size), epsilon_, false, thread_pool);
+    MlasConvertFloatToHalf(MlasHalfGemmFloat16, input_float.get(),
+                           reinterpret_cast<uint16_t*>(output->MutableData<MLFloat16>()), element_count, thread_pool);
+  } else {
+    const T* input_data = input->Data<T>();
+    const T* skip_data = skip->Data<T>();
+    const T* gamma_data = gamma->Data<T>();
+    const T* beta_data = beta == nullptr ? nullptr : beta->Data<T>();
+    const T* bias_data = bias == nullptr ? nullptr : bias->Data<T>();
+
+    T* output_data = output->MutableData<T>();
+
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+        [&](ptrdiff_t task_idx) {
+          const T* p_input = input_data + task_idx * hidden_size;
+          const T* p_skip = skip_data + task_idx * hidden_size;
+          T* p_output = output_data + task_idx * hidden_size;
+
+          T mean = 0;
+          T mean_square = 0;
+
+          for (int64_t h = 0; h < hidden_size; h++) {
+            T value = p_input[h] + p_skip[h];
+            if (nullptr != bias_data) {
+              value += bias_data[h];
+            }
+            p_output[h] = value;
+            mean += value;
+            mean_square += value * value;
+          }
 
-        T mean = 0;
-        T mean_square = 0;
+          mean = mean / hidden_size;
+          mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
 
-        for (int64_t h = 0; h < hidden_size; h++) {
-          T value = p_input[h] + p_skip[h];
-          if (nullptr != bias_data) {
-            value += bias_data[h];
+          for (int64_t h = 0; h < hidden_size; h++) {
+            if (nullptr == beta_data) {
+              p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
+            } else {
+              p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+            }
           }
-          p_output[h] = value;
-          mean += value;
-          mean_square += value * value;
-        }
-
-        mean = mean / hidden_size;
-        mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
-
-        for (int64_t h = 0; h < hidden_size; h++) {
-          if (nullptr == beta_data) {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
-          } else {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-          }
-        }
-      },
-      0);
+        },
+        0);
+  }
 
   return Status::OK();
 }
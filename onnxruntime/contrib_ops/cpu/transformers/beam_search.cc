@@ -53,26 +53,6 @@ REGISTER_KERNEL_TYPED(float)
 
 namespace transformers {
 
-template <typename T>
-gsl::span<T> AllocateBuffer(AllocatorPtr allocator,
-                            BufferUniquePtr& buffer,
-                            size_t elements,
-                            bool fill = false,
-                            T fill_value = T{}) {
-  size_t bytes = SafeInt<size_t>(sizeof(T)) * elements;
-  void* data = allocator->Alloc(bytes);
-  BufferUniquePtr temp_buffer(data, BufferDeleter(allocator));
-  buffer = std::move(temp_buffer);
-  T* first = reinterpret_cast<T*>(buffer.get());
-  auto span = gsl::make_span(first, elements);
-
-  if (fill) {
-    std::fill_n(first, elements, fill_value);
-  }
-
-  return span;
-}
-
 template <typename T>
 struct BeamSearchState : public IBeamSearchState<T> {
   void Init(AllocatorPtr allocator,
@@ -430,7 +410,7 @@ template <typename T>
 Status BeamSearchImpl<T>::CreateInitialFeeds(gsl::span<int32_t>& sequence_lengths, OrtValue& expanded_input_ids, std::vector<OrtValue>& feeds, IAllocatorUniquePtr<char>& buffer) {
   const OrtValue* input_ids_value = context_.GetInputOrtValue(0);
   const Tensor& input_ids = input_ids_value->Get<Tensor>();
-  return gpt_subgraph_.CreateInitialFeeds(input_ids, implicit_inputs_, parameters_->num_beams, parameters_->pad_token_id, sequence_lengths, expanded_input_ids, feeds, create_inputs_func_, add_to_feeds_func_, buffer);
+  return gpt_subgraph_.CreateInitialFeeds(input_ids, implicit_inputs_, parameters_->num_beams, parameters_->pad_token_id, parameters_->max_length, sequence_lengths, expanded_input_ids, feeds, create_inputs_func_, add_to_feeds_func_, buffer);
 }
 
 template <typename T>
@@ -587,10 +567,17 @@ Status BeamSearchImpl<T>::Execute(const FeedsFetchesManager& feeds_fetches_manag
     dumper->Print("***CurrentLength", cur_len, true);
 #endif
 
+    if (gpt_subgraph_.IsPastPresentShareBuffer()) {
+      // The first run has the whole prompt and no past state, and later runs have one new token.
+      gpt_subgraph_.PrepareSharedPastState(iteration_counter == 1 ? 0 : current_length - 1, feeds, fetches);
+    }
+
     status = utils::ExecuteSubgraph(session_state_, feeds_fetches_manager, feeds, fetches, {},
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
 
     ORT_RETURN_IF_ERROR(status);
+    // the subgraph may have been cut short by the termination of the run, stop before using its outputs
+    ORT_RETURN_IF_ERROR(utils::CheckRunTermination(context_.GetTerminateFlag(), context_.Logger()));
 
     const OrtValue& logits = fetches[0];
     gsl::span<int32_t> beam_next_tokens;
@@ -4,6 +4,7 @@
 #include "gsl/gsl"
 #include "sequences.h"
 #include "beam_search_scorer.h"
+#include "sampling.h"
 #include "beam_search_device_helper.h"
 
 namespace onnxruntime {
@@ -332,40 +333,41 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, void* /*stream
 }
 
 template <typename T>
-void PickPastState(const std::vector<OrtValue>& last_outputs,
-                   std::vector<OrtValue>& next_inputs,
-                   gsl::span<const int32_t>& beam_indices,
-                   AllocatorPtr allocator,
-                   void* /*stream*/) {
-
+Status PickPastState(const std::vector<OrtValue>& last_outputs,
+                     std::vector<OrtValue>& next_inputs,
+                     gsl::span<const int32_t>& beam_indices,
+                     AllocatorPtr allocator,
+                     void* /*stream*/) {
+  // The present state is reordered in place and fed to the next iteration as past state,
+  // so there is no allocation of past state per layer, and beams that are not moved are not copied.
+  transformers::InPlaceBeamReorder reorder(beam_indices);
+
+  BufferUniquePtr scratch_buffer;
+  T* scratch = nullptr;
   for (size_t i = 1; i < last_outputs.size(); ++i) {
-    const OrtValue& present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
-
-    // Create a tensor with same shape.
-    // TODO: allocate one buffer for all layers
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
-    auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
-    auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), past_shape.Size());
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), past_shape.Size());
-    for (gsl::index j = 0; j < beam_indices.length(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * block_size_per_beam, block_size_per_beam);
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * block_size_per_beam, block_size_per_beam);
-
-      gsl::span<T> past_key = past_span.subspan(j * block_size_per_beam, block_size_per_beam);
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * block_size_per_beam, block_size_per_beam);
-      gsl::copy(present_key, past_key);
-      gsl::copy(present_value, past_value);
+    OrtValue present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
+    if (!reorder.IsIdentity()) {
+      const TensorShape& past_shape = present.Get<Tensor>().Shape();
+      size_t block_size_per_beam = SafeInt<size_t>(past_shape[2]) * past_shape[3] * past_shape[4];
+
+      // All layers have the same shape, so the scratch buffer is allocated once.
+      if (scratch_buffer == nullptr && reorder.ScratchSize(block_size_per_beam) > 0) {
+        void* data = allocator->Alloc(SafeInt<size_t>(sizeof(T)) * reorder.ScratchSize(block_size_per_beam));
+        scratch_buffer = BufferUniquePtr(data, BufferDeleter(allocator));
+        scratch = reinterpret_cast<T*>(data);
+      }
+
+      ORT_RETURN_IF_ERROR(reorder.Apply(present.GetMutable<Tensor>()->MutableData<T>(), block_size_per_beam, scratch,
+                                        [](T* target, const T* source, size_t elements) {
+                                          memcpy(target, source, elements * sizeof(T));
+                                          return Status::OK();
+                                        }));
     }
 
-    next_inputs[i + 2] = past;
+    next_inputs[i + 2] = present;
   }
+
+  return Status::OK();
 }
 
 template <typename T>
@@ -437,8 +439,85 @@ Status UpdateFeeds(
       next_inputs[i + 2] = last_outputs[i];
     }
   } else {
-    PickPastState<T>(last_outputs, next_inputs, beam_indices, allocator, stream);
+    ORT_RETURN_IF_ERROR(PickPastState<T>(last_outputs, next_inputs, beam_indices, allocator, stream));
+  }
+  return Status::OK();
+}
+
+template <typename T>
+void InitGreedyState(transformers::IGreedySearchState<T>* greedy_state,
+                     gsl::span<int32_t>& sequence_lengths,
+                     void* /*stream*/) {
+  memset(greedy_state->next_token_logits.data(), 0, greedy_state->next_token_logits.size_bytes());
+  memset(greedy_state->next_token_scores.data(), 0, greedy_state->next_token_scores.size_bytes());
+  memset(greedy_state->next_tokens.data(), 0, greedy_state->next_tokens.size_bytes());
+
+  gsl::copy(sequence_lengths, greedy_state->next_positions);
+}
+
+template <typename T>
+Status GreedySearchProcessLogits(const OrtValue& logits,                                   // logits output of subgraph
+                                 transformers::IGreedySearchState<T>* greedy_state,        // state
+                                 transformers::ISequences* sequences,                      // sequences
+                                 AllocatorPtr& /*allocator*/,                              // default allocator
+                                 onnxruntime::concurrency::ThreadPool* thread_pool,        // thread pool (for CPU only)
+                                 transformers::ILogitsProcessorList* logits_processors,    // logits processors
+                                 const transformers::IGreedySearchParameters* parameters,  // parameters
+                                 std::default_random_engine& generator,                    // random number generator
+                                 int step,                                                 // iteration counter
+                                 void* /*stream*/,                                         // cuda stream (for CUDA only)
+                                 const transformers::IConsoleDumper* dumper) {             // tensor dumper
+#ifndef DEBUG_BEAM_SEARCH
+  ORT_UNUSED_PARAMETER(dumper);
+#endif
+
+  int batch_size = parameters->batch_size;
+  int vocab_size = parameters->vocab_size;
+  const T* logits_data = logits.Get<Tensor>().Data<T>();
+
+  // Logits has shape (batch_size, input_length, vocab_size),
+  // where input_length equals to parameters_->sequence_length for first subgraph call, and 1 for the remaining calls.
+  const TensorShape& logits_shape = logits.Get<Tensor>().Shape();
+  ORT_ENFORCE(logits_shape.NumDimensions() == 3);
+  auto input_length = logits_shape[1];
+
+  // Get logits for the last token:
+  //    next_token_logits = logits[:, -1, :], and the result shape is (batch_size, vocab_size)
+  // When input_length == 1, use logits directly in SoftmaxCPU below so it only need for input_length > 1.
+  gsl::span<T>& next_token_logits = greedy_state->next_token_logits;
+  if (input_length > 1) {
+    const T* current_logits = logits_data + (input_length - 1) * vocab_size;
+    for (int i = 0; i < batch_size; i++) {
+      gsl::span<const T> source(current_logits, vocab_size);
+      gsl::span<T> target = next_token_logits.subspan(SafeInt<gsl::index>(i) * vocab_size, static_cast<gsl::index>(vocab_size));
+      gsl::copy(source, target);
+      current_logits += input_length * vocab_size;
+    }
+  }
+
+  // Get scores for candidates of next token: next_token_scores = log_softmax(next_token_logits, dim=-1)
+  gsl::span<float>& next_token_scores = greedy_state->next_token_scores;
+  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(batch_size,  // rows
+                                    vocab_size,  // elements per row
+                                    input_length > 1 ? next_token_logits.data() : logits_data,
+                                    next_token_scores.data(),
+                                    true,
+                                    thread_pool));
+
+  // Apply all score processors that updates scores
+  logits_processors->Process(sequences, next_token_scores, step);
+
+#ifdef DEBUG_BEAM_SEARCH
+  dumper->Print("next_token_scores after logits processor", next_token_scores.data(), batch_size, 1, vocab_size);
+#endif
+
+  // Select next token of each sequence: the one with highest score, or a sample when do_sample is true.
+  transformers::TokenSampler sampler(*parameters);
+  for (int i = 0; i < batch_size; i++) {
+    gsl::span<const float> scores(next_token_scores.data() + SafeInt<gsl::index>(i) * vocab_size, vocab_size);
+    greedy_state->next_tokens[i] = sampler.Select(scores, generator);
   }
+
   return Status::OK();
 }
 
@@ -486,6 +565,24 @@ template Status UpdateFeeds<float>(
     int num_beams,
     const transformers::IConsoleDumper* dumper);
 
+template void InitGreedyState<float>(
+    transformers::IGreedySearchState<float>* greedy_state,
+    gsl::span<int32_t>& sequence_lengths,
+    void* stream);
+
+template Status GreedySearchProcessLogits<float>(
+    const OrtValue& logits,
+    transformers::IGreedySearchState<float>* greedy_state,
+    transformers::ISequences* sequences,
+    AllocatorPtr& allocator,
+    onnxruntime::concurrency::ThreadPool* thread_pool,
+    transformers::ILogitsProcessorList* logits_processors,
+    const transformers::IGreedySearchParameters* parameters,
+    std::default_random_engine& generator,
+    int step,
+    void* stream,
+    const transformers::IConsoleDumper* dumper);
+
 }  // namespace BeamSearchCpuDeviceHelper
 }  // namespace contrib
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
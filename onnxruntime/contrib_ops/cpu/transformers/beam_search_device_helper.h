@@ -6,6 +6,7 @@
 #include "core/framework/allocator.h"
 #endif
 
+#include <random>
 #include "gsl/gsl"
 #include "logits_processor.h"
 #include "beam_search_shared.h"
@@ -102,6 +103,26 @@ using UpdateFeedsFunc = std::function<Status(
     int num_beams,
     const transformers::IConsoleDumper* dumper)>;
 
+template <typename T>
+using InitGreedyStateFunc = std::function<void(
+    transformers::IGreedySearchState<T>* greedy_state,
+    gsl::span<int32_t>& sequence_lengths,
+    void* stream)>;
+
+template <typename T>
+using GreedySearchProcessLogitsFunc = std::function<Status(
+    const OrtValue& logits,                                   // logits output of subgraph
+    transformers::IGreedySearchState<T>* greedy_state,        // state
+    transformers::ISequences* sequences,                      // sequences
+    AllocatorPtr& allocator,                                  // default allocator
+    onnxruntime::concurrency::ThreadPool* thread_pool,        // thread pool (for CPU only)
+    transformers::ILogitsProcessorList* logits_processors,    // logits processors
+    const transformers::IGreedySearchParameters* parameters,  // parameters
+    std::default_random_engine& generator,                    // random number generator for sampling
+    int step,                                                 // iteration counter
+    void* stream,                                             // cuda stream (for CUDA only)
+    const transformers::IConsoleDumper* dumper)>;             // tensor dumper
+
 }  // namespace BeamSearchDeviceHelper
 
 // These are CPU specific device helper implementations
@@ -176,6 +197,24 @@ Status UpdateFeeds(
     int num_beams,
     const transformers::IConsoleDumper* dumper);
 
+template <typename T>
+void InitGreedyState(transformers::IGreedySearchState<T>* greedy_state,
+                     gsl::span<int32_t>& sequence_lengths,
+                     void* stream);
+
+template <typename T>
+Status GreedySearchProcessLogits(const OrtValue& logits,                                   // logits output of subgraph
+                                 transformers::IGreedySearchState<T>* greedy_state,        // state
+                                 transformers::ISequences* sequences,                      // sequences
+                                 AllocatorPtr& allocator,                                  // default allocator
+                                 onnxruntime::concurrency::ThreadPool* thread_pool,        // thread pool (for CPU only)
+                                 transformers::ILogitsProcessorList* logits_processors,    // logits processors
+                                 const transformers::IGreedySearchParameters* parameters,  // parameters
+                                 std::default_random_engine& generator,                    // random number generator
+                                 int step,                                                 // iteration counter
+                                 void* stream,                                             // cuda stream (for CUDA only)
+                                 const transformers::IConsoleDumper* dumper);              // tensor dumper
+
 }  // namespace BeamSearchCpuDeviceHelper
 }  // namespace contrib
 }  // namespace onnxruntime
\ No newline at end of file
@@ -6,7 +6,6 @@ namespace onnxruntime {
 namespace contrib {
 namespace transformers {
 
-constexpr int kMaxSequenceLength = 4096;
 constexpr int kMaxNumBeams = 128;
 
 Status BeamSearchParameters::Validate() const {
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
 #include "gsl/gsl"
 #include "core/framework/allocator.h"
 #include "core/framework/ort_value.h"
+#include "core/common/safeint.h"
 
 #ifndef NDEBUG
 //#define DEBUG_BEAM_SEARCH 1  // uncomment it for debugging beam search
@@ -17,6 +20,28 @@ class ThreadPool;
 namespace contrib {
 namespace transformers {
 
+constexpr int kMaxSequenceLength = 4096;
+
+template <typename T>
+gsl::span<T> AllocateBuffer(AllocatorPtr allocator,
+                            BufferUniquePtr& buffer,
+                            size_t elements,
+                            bool fill = false,
+                            T fill_value = T{}) {
+  size_t bytes = SafeInt<size_t>(sizeof(T)) * elements;
+  void* data = allocator->Alloc(bytes);
+  BufferUniquePtr temp_buffer(data, BufferDeleter(allocator));
+  buffer = std::move(temp_buffer);
+  T* first = reinterpret_cast<T*>(buffer.get());
+  auto span = gsl::make_span(first, elements);
+
+  if (fill) {
+    std::fill_n(first, elements, fill_value);
+  }
+
+  return span;
+}
+
 template <typename T>
 struct IBeamSearchState {
   gsl::span<T> next_token_logits;      // shape (batch_size * num_beams, vocab_size)
@@ -29,6 +54,17 @@ struct IBeamSearchState {
   gsl::span<float> remaining_scores;   // portion of scores that is avaiable for appending next token scores.
 };
 
+template <typename T>
+struct IGreedySearchState {
+  gsl::span<T> next_token_logits;             // shape (batch_size, vocab_size)
+  gsl::span<float> next_token_scores;         // shape (batch_size, vocab_size)
+  gsl::span<int32_t> next_tokens;             // shape (batch_size), in CPU
+  gsl::span<int32_t> next_positions;          // shape (batch_size). Next position value for position_ids.
+  gsl::span<int32_t> sequence_lengths;        // shape (batch_size), initial sequence length, in CPU
+  gsl::span<int32_t> sequences_space;         // shape (2, batch_size, max_seq_length), in CPU
+  gsl::span<float> next_token_scores_in_cpu;  // shape (batch_size, vocab_size). Used by CUDA operator for sampling.
+};
+
 struct IBeamSearchCpuState {
   gsl::span<int32_t> sequence_lengths;  // shape (batch_size, num_beams), initial sequence length
   gsl::span<int32_t> sequences_space;   // shape (2, batch_size, num_beams, max_seq_length)
@@ -103,6 +139,18 @@ struct IBeamSearchParameters {
   int num_layers;
 };
 
+struct IGreedySearchParameters : public IBeamSearchParameters {
+  // Parameters from node attributes
+  bool do_sample;  // sample next token from the distribution of scores instead of choosing the most likely one
+
+  // Parameters from inputs, used only when do_sample is true
+  int top_k;    // 0 means no top-k filtering
+  float top_p;  // 1.0 means no top-p (nucleus) filtering
+
+  // Parameters from node attributes, used only when there is a draft decoder
+  int num_draft_tokens;  // number of tokens the draft decoder proposes for the decoder to verify in each step
+};
+
 class IConsoleDumper {
  public:
   IConsoleDumper() : is_enabled_(true) {}
@@ -126,6 +174,75 @@ class IConsoleDumper {
   bool is_enabled_;
 };
 
+// Reorders the beams of past state in place, so that beam j of the next past state is beam beam_indices[j] of the
+// present state. Only beams whose source differs from themselves are copied, and a beam that would be overwritten
+// before it is read by another beam is saved to a scratch buffer first. This avoids allocating a new past state and
+// copying every beam in each iteration.
+class InPlaceBeamReorder {
+ public:
+  explicit InPlaceBeamReorder(gsl::span<const int32_t> beam_indices) : beam_indices_(beam_indices) {
+    scratch_slots_.assign(beam_indices.size(), -1);
+    for (size_t j = 0; j < beam_indices.size(); ++j) {
+      const int32_t source = beam_indices[j];
+      if (source != static_cast<int32_t>(j)) {
+        num_moved_beams_++;
+        // The source beam is read by another beam and is also overwritten itself.
+        if (beam_indices[source] != source && scratch_slots_[source] < 0) {
+          scratch_slots_[source] = static_cast<int>(saved_beams_.size());
+          saved_beams_.push_back(source);
+        }
+      }
+    }
+  }
+
+  // Returns true if no beam needs to be copied.
+  bool IsIdentity() const { return num_moved_beams_ == 0; }
+
+  // Number of elements of the scratch buffer needed for a past state with `block_size_per_beam` elements per beam
+  // in each of key and value.
+  size_t ScratchSize(size_t block_size_per_beam) const {
+    return saved_beams_.size() * 2 * block_size_per_beam;
+  }
+
+  // Reorders a past state of shape (2, batch_beam_size, num_heads, past_seq_len, head_size) in place.
+  // copy_func(T* target, const T* source, size_t elements) copies on the device of the state and returns a Status.
+  template <typename T, typename CopyFunc>
+  Status Apply(T* state, size_t block_size_per_beam, T* scratch, CopyFunc copy_func) const {
+    const size_t past_key_size = beam_indices_.size() * block_size_per_beam;
+    for (size_t slot = 0; slot < saved_beams_.size(); slot++) {
+      for (size_t part = 0; part < 2; part++) {
+        ORT_RETURN_IF_ERROR(copy_func(scratch + (2 * slot + part) * block_size_per_beam,
+                                      state + part * past_key_size + saved_beams_[slot] * block_size_per_beam,
+                                      block_size_per_beam));
+      }
+    }
+
+    for (size_t j = 0; j < beam_indices_.size(); j++) {
+      const int32_t source = beam_indices_[j];
+      if (source == static_cast<int32_t>(j)) {
+        continue;
+      }
+
+      const int slot = scratch_slots_[source];
+      for (size_t part = 0; part < 2; part++) {
+        const T* source_data = slot >= 0 ? scratch + (2 * slot + part) * block_size_per_beam
+                                         : state + part * past_key_size + source * block_size_per_beam;
+        ORT_RETURN_IF_ERROR(copy_func(state + part * past_key_size + j * block_size_per_beam,
+                                      source_data,
+                                      block_size_per_beam));
+      }
+    }
+
+    return Status::OK();
+  }
+
+ private:
+  gsl::span<const int32_t> beam_indices_;
+  std::vector<int32_t> saved_beams_;  // beams saved to scratch before any beam is overwritten
+  std::vector<int> scratch_slots_;    // index in saved_beams_ of each beam, or -1 if it is not saved
+  size_t num_moved_beams_ = 0;
+};
+
 }  // namespace transformers
 }  // namespace contrib
 }  // namespace onnxruntime
\ No newline at end of file
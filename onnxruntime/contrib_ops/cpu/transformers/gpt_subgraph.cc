@@ -21,16 +21,18 @@ GptSubgraph::GptSubgraph(
     const onnxruntime::Node& node_in,
     const std::string& attribute_name,
     const GraphViewer& subgraph_in)
-    : node(node_in), attribute(attribute_name), subgraph(subgraph_in), allocator_(nullptr), is_output_float16_(false) {
+    : node(node_in), attribute(attribute_name), subgraph(subgraph_in), allocator_(nullptr), is_output_float16_(false), past_present_share_buffer_(false) {
   num_implicit_inputs = static_cast<int>(node.ImplicitInputDefs().size());
 
   auto& subgraph_inputs = subgraph.GetInputs();
   auto& subgraph_outputs = subgraph.GetOutputs();
 
-  // inputs: input_ids, position_ids, attention_mask, past_0, past_1, ...
+  // inputs: input_ids, position_ids, attention_mask, past_0, past_1, ..., and optional past_sequence_length
   // outputs: logits, present_0, present_1, ...
   num_subgraph_inputs = static_cast<int>(subgraph_inputs.size());
   num_subgraph_outputs = static_cast<int>(subgraph_outputs.size());
+  past_present_share_buffer_ = (num_subgraph_inputs == num_subgraph_outputs + 3 &&
+                                subgraph_inputs.back()->Name() == "past_sequence_length");
 
   // CheckSubgraph will verify inputs and outputs later.
   subgraph_input_names.reserve(num_subgraph_inputs);
@@ -49,8 +51,9 @@ Status GptSubgraph::Validate(const std::vector<const NodeArg*>& subgraph_inputs,
   ORT_RETURN_IF(num_subgraph_outputs <= 1,
                 "Invalid GPT-2 subgraph: number of outputs shall be larger than 1 (Need past state in inputs and outputs).");
 
-  ORT_RETURN_IF(num_subgraph_inputs != num_subgraph_outputs + 2,
-                "Invalid GPT-2 subgraph: number of inputs shall be number of outputs plus 2");
+  ORT_RETURN_IF(num_subgraph_inputs != num_subgraph_outputs + (past_present_share_buffer_ ? 3 : 2),
+                "Invalid GPT-2 subgraph: number of inputs shall be number of outputs plus 2, "
+                "or plus 3 when the last input is past_sequence_length");
 
   ORT_RETURN_IF(subgraph_inputs[0]->Name() != "input_ids", "subgraph input 0 shall be named as input_ids, got: ",
                 subgraph_inputs[0]->Name());
@@ -102,6 +105,9 @@ Status GptSubgraph::Validate(const std::vector<const NodeArg*>& subgraph_inputs,
                 "subgraph input 1 (position_ids) shall have int32 type");
   ORT_RETURN_IF(subgraph_inputs[2]->TypeAsProto()->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT32,
                 "subgraph input 2 (attention_mask) shall have int32 type");
+  ORT_RETURN_IF(past_present_share_buffer_ &&
+                    subgraph_inputs.back()->TypeAsProto()->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT32,
+                "subgraph input past_sequence_length shall have int32 type");
 
   auto output_type = subgraph_outputs[0]->TypeAsProto()->tensor_type().elem_type();
   ORT_RETURN_IF(output_type != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT && output_type != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT16,
@@ -143,6 +149,9 @@ Status GptSubgraph::Setup(const SessionState& session_state,
     if (i >= subgraph_input_names.size()) {  // implicit inputs
       const auto& location = utils::FindMemoryInfoForValue(session_state, feed_names[i]);
       feed_locations[i] = location.device;
+    } else if (past_present_share_buffer_ && i == subgraph_input_names.size() - 1) {
+      // past_sequence_length is a scalar that kernels read on CPU.
+      feed_locations[i] = OrtDevice();
     } else {
       feed_locations[i] = default_location.device;
     }
@@ -187,6 +196,7 @@ Status GptSubgraph::CreateInitialFeeds(
     const std::vector<const OrtValue*>& implicit_inputs,
     int num_beams,
     int pad_token_id,
+    int max_length,
     gsl::span<int32_t>& sequence_lengths,
     OrtValue& expanded_input_ids,
     std::vector<OrtValue>& feeds,
@@ -231,8 +241,27 @@ Status GptSubgraph::CreateInitialFeeds(
   ORT_RETURN_IF_ERROR(add_to_feeds_func(provider, expanded_input_ids, expanded_position_ids, expanded_attention_mask, feeds, buffer));
 
   // The remaing inputs are past state.
-  for (int i = 3; i < num_subgraph_inputs; ++i) {
-    feeds.push_back(empty_past);
+  if (past_present_share_buffer_) {
+    // Each layer has its own buffer for max_length, which the subgraph appends to in place.
+    past_state_dims[3] = max_length;
+    TensorShape shared_past_shape(&past_state_dims[0], 5);
+    for (int i = 3; i < num_subgraph_inputs - 1; ++i) {
+      OrtValue past;
+      Tensor::InitOrtValue(past_type, shared_past_shape, default_allocator, past);
+      feeds.push_back(past);
+    }
+
+    int64_t past_sequence_length_dims[] = {1};
+    TensorShape past_sequence_length_shape(&past_sequence_length_dims[0], 1);
+    OrtValue past_sequence_length;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), past_sequence_length_shape, cpu_alloactor,
+                         past_sequence_length);
+    *past_sequence_length.GetMutable<Tensor>()->MutableData<int32_t>() = 0;
+    feeds.push_back(past_sequence_length);
+  } else {
+    for (int i = 3; i < num_subgraph_inputs; ++i) {
+      feeds.push_back(empty_past);
+    }
   }
 
   // pass in implicit inputs
@@ -243,6 +272,19 @@ Status GptSubgraph::CreateInitialFeeds(
   return Status::OK();
 }
 
+void GptSubgraph::PrepareSharedPastState(int past_sequence_length,
+                                         std::vector<OrtValue>& feeds,
+                                         std::vector<OrtValue>& fetches) const {
+  ORT_ENFORCE(past_present_share_buffer_);
+  *feeds[num_subgraph_inputs - 1].GetMutable<Tensor>()->MutableData<int32_t>() = past_sequence_length;
+
+  // Logits are allocated by the subgraph, and the present state is written to the past state buffers.
+  fetches.assign(num_subgraph_outputs, OrtValue());
+  for (int i = 1; i < num_subgraph_outputs; ++i) {
+    fetches[i] = feeds[i + 2];
+  }
+}
+
 }  // namespace transformers
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -50,6 +50,7 @@ struct GptSubgraph {
       const std::vector<const OrtValue*>& implicit_inputs,
       int num_beams,
       int pad_token_id,
+      int max_length,
       gsl::span<int32_t>& sequence_lengths,
       OrtValue& expanded_input_ids,
       std::vector<OrtValue>& feeds,
@@ -63,6 +64,16 @@ struct GptSubgraph {
 
   bool IsOutputFloat16() const { return is_output_float16_; }
 
+  // Whether the subgraph has a past_sequence_length input after the past state. Such a subgraph writes the present
+  // state into the past state buffers, which are allocated for max_length, instead of concatenating them.
+  bool IsPastPresentShareBuffer() const { return past_present_share_buffer_; }
+
+  // For a subgraph that shares the past and present buffers, sets the past_sequence_length feed, and makes the
+  // present outputs of the next run write to the buffers of the past feeds.
+  void PrepareSharedPastState(int past_sequence_length,
+                              std::vector<OrtValue>& feeds,
+                              std::vector<OrtValue>& fetches) const;
+
  protected:
   Status Validate(const std::vector<const NodeArg*>& subgraph_inputs,
                   const std::vector<const NodeArg*>& subgraph_outputs);
@@ -72,6 +83,7 @@ struct GptSubgraph {
   const SessionState* subgraph_session_state_;
   std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
   bool is_output_float16_;
+  bool past_present_share_buffer_;
 };
 
 }  // namespace transformers
@@ -0,0 +1,825 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// there's no way to use a raw pointer as the copy destination with std::copy_n
+// (which gsl::copy uses with span::data() which returns a raw pointer) with the 14.11 toolset
+// without generating a 4996 warning. going through an iterator is way too much overhead so turn off the warning.
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/random_seed.h"
+#include "core/framework/session_state.h"
+#include "core/framework/utils.h"
+#include "core/framework/ort_value.h"
+#include "gsl/gsl"
+#include "greedy_search.h"
+#include "logits_processor.h"
+#include "sequences.h"
+#include "dump_tensor.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      GreedySearch,                                               \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCpuExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      transformers::GreedySearch);
+
+REGISTER_KERNEL_TYPED(float)
+
+namespace transformers {
+
+template <typename T>
+struct GreedySearchState : public IGreedySearchState<T> {
+  Sequences sequences;
+
+  void Init(AllocatorPtr cpu_allocator,
+            AllocatorPtr allocator,
+            int batch_size,
+            int vocab_size,
+            int sequence_length,
+            int max_length,
+            bool need_scores_in_cpu) {
+    size_t next_token_size = SafeInt<size_t>(batch_size) * vocab_size;
+    this->next_token_logits = AllocateBuffer<T>(allocator, next_token_logits_buffer_, next_token_size);
+    this->next_token_scores = AllocateBuffer<float>(allocator, next_token_scores_buffer_, next_token_size);
+    this->next_positions = AllocateBuffer<int32_t>(allocator, next_positions_buffer_, batch_size);
+
+    this->next_tokens = AllocateBuffer<int32_t>(cpu_allocator, next_tokens_buffer_, batch_size);
+    this->sequence_lengths = AllocateBuffer<int32_t>(cpu_allocator, sequence_lengths_buffer_, batch_size);
+    this->sequences_space = AllocateBuffer<int32_t>(cpu_allocator, sequences_space_buffer_,
+                                                    SafeInt<size_t>(2) * batch_size * max_length, true, 0);
+    if (need_scores_in_cpu) {
+      this->next_token_scores_in_cpu = AllocateBuffer<float>(cpu_allocator, next_token_scores_in_cpu_buffer_,
+                                                             next_token_size);
+    }
+
+    sequences.Init(this->sequences_space, batch_size, sequence_length, max_length);
+  }
+
+ private:
+  BufferUniquePtr next_token_logits_buffer_;
+  BufferUniquePtr next_token_scores_buffer_;
+  BufferUniquePtr next_positions_buffer_;
+  BufferUniquePtr next_tokens_buffer_;
+  BufferUniquePtr sequence_lengths_buffer_;
+  BufferUniquePtr sequences_space_buffer_;
+  BufferUniquePtr next_token_scores_in_cpu_buffer_;
+};
+
+template <typename T>
+class GreedySearchImpl {
+ public:
+  GreedySearchImpl(OpKernelContextInternal& context,
+                   const SessionState& session_state,
+                   GptSubgraph& gpt_subgraph,
+                   GptSubgraph* draft_subgraph,
+                   const SessionState* draft_session_state,
+                   concurrency::ThreadPool* thread_pool,
+                   void* cuda_stream,
+                   IConsoleDumper* cuda_dumper,
+                   GreedySearchParameters& params,
+                   std::default_random_engine& generator,
+                   const BeamSearchDeviceHelper::CreateInputsFunc& create_inputs_func,
+                   const BeamSearchDeviceHelper::AddToFeedsFunc& add_to_feeds_func,
+                   const BeamSearchDeviceHelper::GreedySearchProcessLogitsFunc<T>& process_logits_func,
+                   const BeamSearchDeviceHelper::InitGreedyStateFunc<T>& init_greedy_state_func,
+                   const BeamSearchDeviceHelper::UpdateFeedsFunc<T>& update_feeds_func)
+      : context_(context),
+        session_state_(session_state),
+        gpt_subgraph_(gpt_subgraph),
+        draft_subgraph_(draft_subgraph),
+        draft_session_state_(draft_session_state),
+        thread_pool_(thread_pool),
+        implicit_inputs_(context_.GetImplicitInputs()),
+        cuda_stream_(cuda_stream),
+        cuda_dumper_(cuda_dumper),
+        parameters_(&params),
+        generator_(generator),
+        cpu_allocator_(nullptr),
+        temp_space_allocator_(nullptr),
+        create_inputs_func_(create_inputs_func),
+        add_to_feeds_func_(add_to_feeds_func),
+        process_logits_func_(process_logits_func),
+        init_greedy_state_func_(init_greedy_state_func),
+        update_feeds_func_(update_feeds_func) {
+    parameters_->ParseFromInputs(&context);
+
+    cpu_allocator_ = session_state.GetExecutionProviders()
+                         .Get(onnxruntime::kCpuExecutionProvider)
+                         ->GetAllocator(0, OrtMemTypeDefault);
+  }
+
+  // Initialize by validating all the inputs, and allocating the output tensors.
+  Status Initialize();
+
+  // Execute greedy search in iterations util stopping criteria is reached.
+  // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
+  // With a draft decoder, several tokens may be generated in each iteration instead.
+  Status Execute(const FeedsFetchesManager& feeds_fetches_manager,
+                 const FeedsFetchesManager* draft_feeds_fetches_manager);
+
+ private:
+  bool IsCuda() const { return cuda_stream_ != nullptr; }
+
+  // Speculative decoding: in each step the draft decoder proposes tokens one by one, then the decoder runs once over
+  // the proposed tokens, and the next token of each position is selected from its logits exactly like Execute does
+  // for one position, until a selected token differs from the proposed one. The sequences are therefore the same as
+  // without the draft decoder, and the past state of both decoders is cut back to the tokens that were kept.
+  Status ExecuteSpeculative(const FeedsFetchesManager& feeds_fetches_manager,
+                            const FeedsFetchesManager& draft_feeds_fetches_manager,
+                            GreedySearchState<T>& greedy_state,
+                            std::vector<OrtValue>& feeds,
+                            gsl::span<int32_t>& sequence_indices);
+
+  void CopySequencesToOutput(const Sequences& sequences, Tensor* output_sequences) const;
+
+  // Runs a decoder over the tokens at positions [past_length, end_length) of the sequences, with the first
+  // past_length positions of the present state of its previous run as past state. Positions from
+  // current_length on are taken from draft_tokens.
+  Status RunDecoder(const GptSubgraph& subgraph,
+                    const SessionState& session_state,
+                    const FeedsFetchesManager& feeds_fetches_manager,
+                    std::vector<OrtValue>& feeds,
+                    std::vector<OrtValue>& fetches,
+                    int past_length,
+                    int end_length,
+                    int current_length,
+                    const GreedySearchState<T>& greedy_state,
+                    gsl::span<const int32_t> draft_tokens,
+                    gsl::span<const int32_t> prompt_position_ids,
+                    gsl::span<const int32_t> prompt_attention_mask);
+
+  // Validate inputs.
+  Status CheckInputs(const OpKernelContextInternal& context);
+
+  const IConsoleDumper* GetConsoleDumper() const { return IsCuda() ? cuda_dumper_ : &(cpu_dumper_); }
+
+  OpKernelContextInternal& context_;
+
+  const SessionState& session_state_;
+
+  GptSubgraph& gpt_subgraph_;
+
+  GptSubgraph* draft_subgraph_;
+  const SessionState* draft_session_state_;
+
+  concurrency::ThreadPool* thread_pool_;
+
+  const std::vector<const OrtValue*>& implicit_inputs_;
+
+  void* cuda_stream_;
+
+  IConsoleDumper* cuda_dumper_;
+  CpuTensorConsoleDumper cpu_dumper_;
+
+  GreedySearchParameters* parameters_;
+
+  std::default_random_engine& generator_;
+
+  LogitsProcessorList logits_processors_;
+
+  AllocatorPtr cpu_allocator_;
+  AllocatorPtr temp_space_allocator_;
+
+  // Device specific functions
+  BeamSearchDeviceHelper::CreateInputsFunc create_inputs_func_;
+  BeamSearchDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
+  BeamSearchDeviceHelper::GreedySearchProcessLogitsFunc<T> process_logits_func_;
+  BeamSearchDeviceHelper::InitGreedyStateFunc<T> init_greedy_state_func_;
+  BeamSearchDeviceHelper::UpdateFeedsFunc<T> update_feeds_func_;
+};
+
+void GreedySearch::Init(const OpKernelInfo& info) {
+  // Make sure the decoder attribute was present even though we don't need it here.
+  ONNX_NAMESPACE::GraphProto proto;
+  ORT_ENFORCE(info.GetAttr<ONNX_NAMESPACE::GraphProto>("decoder", &proto).IsOK());
+  ORT_IGNORE_RETURN_VALUE(proto);
+
+  parameters_.ParseFromAttributes(info);
+
+  // read optional seed attribute and generate if not provided
+  int64_t seed = 0;
+  if (info.GetAttr<int64_t>("seed", &seed).IsOK()) {
+    generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+  } else {
+    // node index is added to the global seed to avoid two nodes generating the same sequence of random data
+    generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
+  }
+}
+
+Status GreedySearch::SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                                const std::string& attribute_name,
+                                                const SessionState& subgraph_session_state) {
+  const auto& node = Node();
+  if (attribute_name == "decoder") {
+    ORT_ENFORCE(gpt_subgraph_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+    gpt_subgraph_ = std::make_unique<GptSubgraph>(node, attribute_name, subgraph_session_state.GetGraphViewer());
+    ORT_RETURN_IF_ERROR(gpt_subgraph_->Setup(session_state, subgraph_session_state));
+    feeds_fetches_manager_ = gpt_subgraph_->GetFeedsFetchesManager();
+    parameters_.SetSubgraphParameters(gpt_subgraph_->vocab_size,
+                                      gpt_subgraph_->num_heads,
+                                      gpt_subgraph_->head_size,
+                                      gpt_subgraph_->num_layers);
+  } else if (attribute_name == "draft_decoder") {
+    ORT_ENFORCE(draft_subgraph_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+    draft_subgraph_ = std::make_unique<GptSubgraph>(node, attribute_name, subgraph_session_state.GetGraphViewer());
+    ORT_RETURN_IF_ERROR(draft_subgraph_->Setup(session_state, subgraph_session_state));
+    draft_feeds_fetches_manager_ = draft_subgraph_->GetFeedsFetchesManager();
+  }
+  return Status::OK();
+}
+
+Status GreedySearch::Compute(OpKernelContext* ctx) const {
+  if (parameters_.model_type != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Support of 'model_type' != 0 is not implemented");
+  }
+
+  auto* ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
+  auto* session_state = ctx_internal->SubgraphSessionState("decoder");
+  ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'decoder' attribute.");
+  ORT_ENFORCE(feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
+  const SessionState* draft_session_state = nullptr;
+  if (draft_subgraph_ != nullptr) {
+    draft_session_state = ctx_internal->SubgraphSessionState("draft_decoder");
+    ORT_ENFORCE(draft_session_state, "Subgraph SessionState was not found for 'draft_decoder' attribute.");
+    ORT_ENFORCE(draft_feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+  }
+
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  GreedySearchParameters parameters = parameters_;  // make a copy since we will update the parameters based on inputs later
+
+  // Each call gets its own generator so that the generation does not hold generator_mutex_.
+  std::default_random_engine generator;
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
+    generator.seed(generator_());
+  }
+
+  // Subgraph has constraint that the output is either float or float16
+  if (!gpt_subgraph_->IsOutputFloat16()) {
+    GreedySearchImpl<float> impl{*ctx_internal, *session_state, *gpt_subgraph_, draft_subgraph_.get(), draft_session_state, thread_pool, cuda_stream_, dumper_, parameters, generator,
+                                 BeamSearchCpuDeviceHelper::CreateInputs,
+                                 add_to_feeds_func_ ? add_to_feeds_func_ : BeamSearchCpuDeviceHelper::AddToFeeds,
+                                 process_logits_func_ ? process_logits_func_ : BeamSearchCpuDeviceHelper::GreedySearchProcessLogits<float>,
+                                 init_greedy_state_func_ ? init_greedy_state_func_ : BeamSearchCpuDeviceHelper::InitGreedyState<float>,
+                                 update_feeds_func_ ? update_feeds_func_ : BeamSearchCpuDeviceHelper::UpdateFeeds<float>};
+    ORT_RETURN_IF_ERROR(impl.Initialize());
+
+    return impl.Execute(*feeds_fetches_manager_, draft_feeds_fetches_manager_);
+  } else {
+    GreedySearchImpl<MLFloat16> impl{*ctx_internal, *session_state, *gpt_subgraph_, draft_subgraph_.get(), draft_session_state, thread_pool, cuda_stream_, dumper_, parameters, generator,
+                                     BeamSearchCpuDeviceHelper::CreateInputs,
+                                     add_to_feeds_func_ ? add_to_feeds_func_ : BeamSearchCpuDeviceHelper::AddToFeeds,
+                                     process_logits_fp16_func_,
+                                     init_greedy_state_fp16_func_,
+                                     update_feeds_fp16_func_};
+    ORT_RETURN_IF_ERROR(impl.Initialize());
+
+    return impl.Execute(*feeds_fetches_manager_, draft_feeds_fetches_manager_);
+  }
+}
+
+template <typename T>
+Status GreedySearchImpl<T>::CheckInputs(const OpKernelContextInternal& context) {
+  // Input shapes:
+  //   input_ids  : (batch_size, sequence_length)
+  //   vocab_mask : (vocab_size) or nullptr
+
+  const Tensor* input_ids = context.Input<Tensor>(0);
+  const auto& dims = input_ids->Shape().GetDims();
+  if (dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'input_ids' is expected to have 2 dimensions, got ",
+                           dims.size());
+  }
+
+  const Tensor* vocab_mask = context.Input<Tensor>(4);
+  if (vocab_mask != nullptr) {  // vocab_mask is optional
+    const auto& vocab_mask_dims = vocab_mask->Shape().GetDims();
+    if (vocab_mask_dims.size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'vocab_mask' is expected to have 1 dimension, got ",
+                             vocab_mask_dims.size());
+    }
+
+    // There is dependency on vocab_size parameter, which shall be set before calling this function.
+    if (static_cast<int>(vocab_mask_dims[0]) != parameters_->vocab_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'vocab_mask' shape does not match with vocab_size, got ",
+                             vocab_mask_dims[0]);
+    }
+
+    // store vocab mask in parameters.
+    parameters_->vocab_mask = vocab_mask->DataAsSpan<int32_t>();
+  }
+
+  const Tensor* prefix_vocab_mask = context.Input<Tensor>(5);
+  if (prefix_vocab_mask != nullptr) {
+    // prefix_vocab_mask is optional
+    const auto& vocab_mask_dims = prefix_vocab_mask->Shape().GetDims();
+    if (vocab_mask_dims.size() != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'prefix_vocab_mask' is expected to have 2 dimensions, got ",
+                             vocab_mask_dims.size());
+    }
+
+    // prefix_vocab_mask first dimension should be same as the first dimension of input_ids
+    if (static_cast<int>(vocab_mask_dims[0]) != static_cast<int>(dims[0])) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input_ids and prefix_vocab_mask must have the same batch_size");
+    }
+
+    // There is dependency on vocab_size parameter, which shall be set before calling this function.
+    if (static_cast<int>(vocab_mask_dims[1]) != parameters_->vocab_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'prefix_vocab_mask' shape does not match with vocab_size, got ",
+                             vocab_mask_dims[1]);
+    }
+
+    // store prefix vocab mask in parameters.
+    parameters_->prefix_vocab_mask = prefix_vocab_mask->DataAsSpan<int32_t>();
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status GreedySearchImpl<T>::Initialize() {
+  ORT_RETURN_IF_ERROR(context_.GetTempSpaceAllocator(&temp_space_allocator_));
+
+#define CHECK_SCALAR_INPUT(name, index, required)                                                                   \
+  auto* name##_tensor = context_.Input<Tensor>(index);                                                              \
+  if (name##_tensor) {                                                                                              \
+    if (!name##_tensor->Shape().IsScalar()) {                                                                       \
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "'GreedySearch' input " #name " should be a scalar. Got shape of ", \
+                             name##_tensor->Shape());                                                               \
+    }                                                                                                               \
+  } else if (required) {                                                                                            \
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "'GreedySearch' input " #name " is required");                        \
+  }
+
+  CHECK_SCALAR_INPUT(max_length, 1, true);
+
+  CHECK_SCALAR_INPUT(min_length, 2, false);
+
+  CHECK_SCALAR_INPUT(repetition_penalty, 3, false);
+
+  CHECK_SCALAR_INPUT(temperature, 6, false);
+
+  CHECK_SCALAR_INPUT(top_k, 7, false);
+
+  CHECK_SCALAR_INPUT(top_p, 8, false);
+
+  ORT_RETURN_IF_ERROR(CheckInputs(context_));
+
+  // Scores of each step are not an output of greedy search.
+  parameters_->output_scores = false;
+
+  if (draft_subgraph_ != nullptr) {
+    if (IsCuda()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "'GreedySearch' with a draft_decoder is only supported on CPU");
+    }
+
+    // Verifying several tokens in one run needs the present state to be the concatenation of the past state and
+    // the new tokens, so that it can be cut back to the tokens that are kept.
+    if (gpt_subgraph_.IsPastPresentShareBuffer() || draft_subgraph_->IsPastPresentShareBuffer()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "'GreedySearch' with a draft_decoder does not support subgraphs with past_sequence_length");
+    }
+
+    if (draft_subgraph_->vocab_size != gpt_subgraph_.vocab_size ||
+        draft_subgraph_->IsOutputFloat16() != gpt_subgraph_.IsOutputFloat16()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "'GreedySearch' draft_decoder shall have the same vocabulary size and logits type as decoder");
+    }
+  }
+
+  if (!IsCuda()) {
+    // Logits processor is used in CPU only. In CUDA, cuda kernels are used instead.
+    // Initialize processsors after CheckInputs so that parameters_->vocab_mask is ready.
+    logits_processors_.Init(*parameters_);
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status GreedySearchImpl<T>::Execute(const FeedsFetchesManager& feeds_fetches_manager,
+                                    const FeedsFetchesManager* draft_feeds_fetches_manager) {
+  auto status = Status::OK();
+  int64_t sequences_dims[] = {parameters_->batch_size, parameters_->max_length};
+  TensorShape sequences_shape(&sequences_dims[0], sizeof(sequences_dims) / sizeof(sequences_dims[0]));
+  Tensor* output_sequences = context_.Output(0, sequences_shape);
+
+  std::vector<OrtValue> feeds;
+  std::vector<OrtValue> fetches;
+
+  GreedySearchState<T> greedy_state;
+  greedy_state.Init(cpu_allocator_,
+                    temp_space_allocator_,
+                    parameters_->batch_size,
+                    parameters_->vocab_size,
+                    parameters_->sequence_length,
+                    parameters_->max_length,
+                    IsCuda() && parameters_->do_sample);
+
+  IAllocatorUniquePtr<char> buffer;
+  OrtValue expanded_input_ids_in_cpu;
+  const OrtValue* input_ids_value = context_.GetInputOrtValue(0);
+  ORT_RETURN_IF_ERROR(gpt_subgraph_.CreateInitialFeeds(input_ids_value->Get<Tensor>(), implicit_inputs_,
+                                                       1,  // num_beams
+                                                       parameters_->pad_token_id, parameters_->max_length,
+                                                       greedy_state.sequence_lengths,
+                                                       expanded_input_ids_in_cpu, feeds,
+                                                       create_inputs_func_, add_to_feeds_func_, buffer));
+
+  init_greedy_state_func_(&greedy_state, greedy_state.sequence_lengths, cuda_stream_);
+
+  // Copy input_ids to sequences.
+  gsl::span<const int32_t> input_ids = expanded_input_ids_in_cpu.Get<Tensor>().DataAsSpan<int32_t>();
+  for (int i = 0; i < parameters_->batch_size; i++) {
+    for (int j = 0; j < parameters_->sequence_length; j++) {
+      greedy_state.sequences_space[SafeInt<gsl::index>(i) * parameters_->max_length + j] =
+          input_ids[SafeInt<gsl::index>(i) * parameters_->sequence_length + j];
+    }
+  }
+
+#ifdef DEBUG_BEAM_SEARCH
+  const IConsoleDumper* dumper = GetConsoleDumper();
+  dumper->Print("input_ids", feeds[0]);
+  dumper->Print("position_ids", feeds[1]);
+  dumper->Print("attention_mask", feeds[2]);
+#endif
+
+  // position ids for all iterations except the first. It uses memory buffer owned by next_positions.
+  OrtValue position_ids;
+  int64_t dims[] = {parameters_->batch_size, 1};
+  TensorShape shape(&dims[0], 2);
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), shape, greedy_state.next_positions.data(), temp_space_allocator_->Info(), position_ids);
+
+  // There is one sequence per batch, so sequences are never reordered.
+  std::vector<int32_t> sequence_indices(parameters_->batch_size);
+  std::iota(sequence_indices.begin(), sequence_indices.end(), 0);
+  gsl::span<int32_t> sequence_indices_span = gsl::make_span(sequence_indices);
+
+  if (draft_subgraph_ != nullptr) {
+    ORT_RETURN_IF_ERROR(ExecuteSpeculative(feeds_fetches_manager, *draft_feeds_fetches_manager, greedy_state, feeds,
+                                           sequence_indices_span));
+    CopySequencesToOutput(greedy_state.sequences, output_sequences);
+    return status;
+  }
+
+  // A sequence is finished once it generates eos_token_id, and pad_token_id is appended to it afterwards.
+  std::vector<bool> eos_meet(parameters_->batch_size, false);
+  int num_finished = 0;
+
+  int current_length = parameters_->sequence_length;
+  int iteration_counter = 0;
+  while (current_length < parameters_->max_length) {
+    iteration_counter++;
+#ifdef DEBUG_BEAM_SEARCH
+    auto cur_len = std::to_string(current_length);
+    dumper->Print("***CurrentLength", cur_len, true);
+#endif
+
+    if (gpt_subgraph_.IsPastPresentShareBuffer()) {
+      // The first run has the whole prompt and no past state, and later runs have one new token.
+      gpt_subgraph_.PrepareSharedPastState(iteration_counter == 1 ? 0 : current_length - 1, feeds, fetches);
+    }
+
+    status = utils::ExecuteSubgraph(session_state_, feeds_fetches_manager, feeds, fetches, {},
+                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+
+    ORT_RETURN_IF_ERROR(status);
+    // the subgraph may have been cut short by the termination of the run, stop before using its outputs
+    ORT_RETURN_IF_ERROR(utils::CheckRunTermination(context_.GetTerminateFlag(), context_.Logger()));
+
+    const OrtValue& logits = fetches[0];
+    ORT_RETURN_IF_ERROR(process_logits_func_(logits, &greedy_state, &(greedy_state.sequences), temp_space_allocator_,
+                                             thread_pool_, &logits_processors_, parameters_, generator_,
+                                             iteration_counter, cuda_stream_, GetConsoleDumper()));
+
+    gsl::span<int32_t>& next_tokens = greedy_state.next_tokens;
+    for (int i = 0; i < parameters_->batch_size; i++) {
+      if (eos_meet[i]) {
+        next_tokens[i] = parameters_->pad_token_id;
+      } else if (next_tokens[i] == parameters_->eos_token_id) {
+        eos_meet[i] = true;
+        num_finished++;
+      }
+    }
+
+    greedy_state.sequences.AppendNextTokenToSequences(sequence_indices_span, next_tokens);
+
+#ifdef DEBUG_BEAM_SEARCH
+    greedy_state.sequences.PrintSequences(&cpu_dumper_);
+#endif
+
+    // When all batches are finished, stop earlier to avoid wasting computation.
+    if (num_finished == parameters_->batch_size) {
+      break;
+    }
+
+    // Increase sequence length after a new token is generated.
+    ++current_length;
+
+    // Prepare inputs for next round of subgraph call.
+    if (current_length < parameters_->max_length) {
+      ORT_RETURN_IF_ERROR(update_feeds_func_(temp_space_allocator_, cuda_stream_, fetches, feeds, current_length,
+                                             position_ids,
+                                             next_tokens.as_span<const int32_t>(),
+                                             sequence_indices_span.as_span<const int32_t>(),
+                                             1,  // num_beams
+                                             GetConsoleDumper()));
+    }
+    fetches.clear();
+  }
+
+  CopySequencesToOutput(greedy_state.sequences, output_sequences);
+
+  return status;
+}
+
+// Copies the first past_length positions of a present state of shape (2, batch_size, num_heads, present_length,
+// head_size) to a past state, or uses the present state as is when it has past_length positions.
+static void SlicePastState(const OrtValue& present, int past_length, AllocatorPtr allocator, OrtValue& past) {
+  const Tensor& present_tensor = present.Get<Tensor>();
+  const TensorShape& present_shape = present_tensor.Shape();
+  if (present_shape[3] == past_length) {
+    past = present;
+    return;
+  }
+
+  TensorShape past_shape = present_shape;
+  past_shape[3] = past_length;
+  Tensor::InitOrtValue(present_tensor.DataType(), past_shape, allocator, past);
+
+  const size_t element_size = present_tensor.DataType()->Size();
+  const size_t num_blocks = SafeInt<size_t>(present_shape[0]) * present_shape[1] * present_shape[2];
+  const size_t present_block_bytes = SafeInt<size_t>(present_shape[3]) * present_shape[4] * element_size;
+  const size_t past_block_bytes = SafeInt<size_t>(past_length) * present_shape[4] * element_size;
+  const char* source = static_cast<const char*>(present_tensor.DataRaw());
+  char* target = static_cast<char*>(past.GetMutable<Tensor>()->MutableDataRaw());
+  for (size_t i = 0; i < num_blocks; i++) {
+    memcpy(target + i * past_block_bytes, source + i * present_block_bytes, past_block_bytes);
+  }
+}
+
+template <typename T>
+Status GreedySearchImpl<T>::RunDecoder(const GptSubgraph& subgraph,
+                                       const SessionState& session_state,
+                                       const FeedsFetchesManager& feeds_fetches_manager,
+                                       std::vector<OrtValue>& feeds,
+                                       std::vector<OrtValue>& fetches,
+                                       int past_length,
+                                       int end_length,
+                                       int current_length,
+                                       const GreedySearchState<T>& greedy_state,
+                                       gsl::span<const int32_t> draft_tokens,
+                                       gsl::span<const int32_t> prompt_position_ids,
+                                       gsl::span<const int32_t> prompt_attention_mask) {
+  const int batch_size = parameters_->batch_size;
+  const int prompt_length = parameters_->sequence_length;
+  const int num_draft_tokens = parameters_->num_draft_tokens;
+  const int input_length = end_length - past_length;
+
+  // input_ids and position_ids have shape (batch_size, input_length), and attention_mask (batch_size, end_length).
+  auto int32_type = DataTypeImpl::GetType<int32_t>();
+  int64_t input_dims[] = {batch_size, input_length};
+  int64_t mask_dims[] = {batch_size, end_length};
+  OrtValue input_ids;
+  OrtValue position_ids;
+  OrtValue attention_mask;
+  Tensor::InitOrtValue(int32_type, TensorShape(&input_dims[0], 2), temp_space_allocator_, input_ids);
+  Tensor::InitOrtValue(int32_type, TensorShape(&input_dims[0], 2), temp_space_allocator_, position_ids);
+  Tensor::InitOrtValue(int32_type, TensorShape(&mask_dims[0], 2), temp_space_allocator_, attention_mask);
+  int32_t* input_ids_data = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* position_data = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* mask_data = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+
+  for (int i = 0; i < batch_size; i++) {
+    gsl::span<const int32_t> sequence = greedy_state.sequences.GetSequence(i);
+    for (int j = 0; j < end_length; j++) {
+      const bool in_prompt = j < prompt_length;
+      mask_data[SafeInt<gsl::index>(i) * end_length + j] =
+          in_prompt ? prompt_attention_mask[SafeInt<gsl::index>(i) * prompt_length + j] : 1;
+
+      if (j >= past_length) {
+        const gsl::index index = SafeInt<gsl::index>(i) * input_length + j - past_length;
+        input_ids_data[index] = j < current_length
+                                    ? sequence[j]
+                                    : draft_tokens[SafeInt<gsl::index>(i) * num_draft_tokens + j - current_length];
+
+        // The positions of generated tokens are the ones UpdateFeeds gives them.
+        position_data[index] = in_prompt ? prompt_position_ids[SafeInt<gsl::index>(i) * prompt_length + j]
+                                         : greedy_state.sequence_lengths[i] + (j - prompt_length) + 1;
+      }
+    }
+  }
+
+  feeds[0] = input_ids;
+  feeds[1] = position_ids;
+  feeds[2] = attention_mask;
+
+  // The past state is the present state of the previous run, without the positions that were not kept.
+  if (!fetches.empty()) {
+    for (int i = 1; i < subgraph.num_subgraph_outputs; ++i) {
+      SlicePastState(fetches[i], past_length, temp_space_allocator_, feeds[i + 2]);
+    }
+  }
+
+  fetches.clear();
+  ORT_RETURN_IF_ERROR(utils::ExecuteSubgraph(session_state, feeds_fetches_manager, feeds, fetches, {},
+                                             ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(),
+                                             context_.Logger()));
+
+  // the subgraph may have been cut short by the termination of the run, stop before using its outputs
+  return utils::CheckRunTermination(context_.GetTerminateFlag(), context_.Logger());
+}
+
+template <typename T>
+Status GreedySearchImpl<T>::ExecuteSpeculative(const FeedsFetchesManager& feeds_fetches_manager,
+                                               const FeedsFetchesManager& draft_feeds_fetches_manager,
+                                               GreedySearchState<T>& greedy_state,
+                                               std::vector<OrtValue>& feeds,
+                                               gsl::span<int32_t>& sequence_indices) {
+  const int batch_size = parameters_->batch_size;
+  const int vocab_size = parameters_->vocab_size;
+  const int max_length = parameters_->max_length;
+  const int num_draft_tokens = parameters_->num_draft_tokens;
+
+  // The position ids and attention mask of the prompt are the start of the feeds of both decoders.
+  gsl::span<const int32_t> initial_position_ids = feeds[1].Get<Tensor>().DataAsSpan<int32_t>();
+  gsl::span<const int32_t> initial_attention_mask = feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  std::vector<int32_t> prompt_position_ids(initial_position_ids.begin(), initial_position_ids.end());
+  std::vector<int32_t> prompt_attention_mask(initial_attention_mask.begin(), initial_attention_mask.end());
+
+  // The draft decoder starts from the same prompt with its own empty past state.
+  std::vector<OrtValue> draft_feeds;
+  std::vector<int32_t> draft_sequence_lengths(batch_size);
+  gsl::span<int32_t> draft_sequence_lengths_span = gsl::make_span(draft_sequence_lengths);
+  OrtValue draft_input_ids;
+  IAllocatorUniquePtr<char> draft_buffer;
+  ORT_RETURN_IF_ERROR(draft_subgraph_->CreateInitialFeeds(context_.GetInputOrtValue(0)->Get<Tensor>(),
+                                                          implicit_inputs_,
+                                                          1,  // num_beams
+                                                          parameters_->pad_token_id, max_length,
+                                                          draft_sequence_lengths_span,
+                                                          draft_input_ids, draft_feeds,
+                                                          create_inputs_func_, add_to_feeds_func_, draft_buffer));
+
+  std::vector<OrtValue> fetches;
+  std::vector<OrtValue> draft_fetches;
+  int past_length = 0;        // positions in the past state of the decoder
+  int draft_past_length = 0;  // positions in the past state of the draft decoder
+
+  // Tokens proposed by the draft decoder in the current step, with shape (batch_size, num_draft_tokens).
+  std::vector<int32_t> draft_tokens(SafeInt<size_t>(batch_size) * num_draft_tokens);
+
+  // The logits of one position of the decoder, from which the next token is selected like from a run of one token.
+  int64_t position_logits_dims[] = {batch_size, 1, vocab_size};
+  TensorShape position_logits_shape(&position_logits_dims[0], 3);
+
+  std::vector<bool> eos_meet(batch_size, false);
+  int num_finished = 0;
+
+  int current_length = parameters_->sequence_length;
+  int iteration_counter = 0;
+  while (current_length < max_length) {
+    // The decoder selects up to one more token than the draft decoder proposes.
+    const int num_drafts = std::min(num_draft_tokens, max_length - current_length - 1);
+
+    for (int i = 0; i < num_drafts; i++) {
+      ORT_RETURN_IF_ERROR(RunDecoder(*draft_subgraph_, *draft_session_state_, draft_feeds_fetches_manager,
+                                     draft_feeds, draft_fetches, draft_past_length, current_length + i,
+                                     current_length, greedy_state, draft_tokens, prompt_position_ids,
+                                     prompt_attention_mask));
+      draft_past_length = current_length + i;
+
+      // The draft decoder proposes its most likely next token.
+      const Tensor& draft_logits = draft_fetches[0].Get<Tensor>();
+      const int64_t draft_input_length = draft_logits.Shape()[1];
+      for (int b = 0; b < batch_size; b++) {
+        const T* row = draft_logits.Data<T>() +
+                       (SafeInt<size_t>(b) * draft_input_length + draft_input_length - 1) * vocab_size;
+        int32_t best = 0;
+        for (int v = 1; v < vocab_size; v++) {
+          if (static_cast<float>(row[v]) > static_cast<float>(row[best])) {
+            best = v;
+          }
+        }
+        draft_tokens[SafeInt<size_t>(b) * num_draft_tokens + i] = best;
+      }
+    }
+
+    // The decoder runs once over the last selected token and the proposed tokens.
+    ORT_RETURN_IF_ERROR(RunDecoder(gpt_subgraph_, session_state_, feeds_fetches_manager, feeds, fetches,
+                                   past_length, current_length + num_drafts, current_length, greedy_state,
+                                   draft_tokens, prompt_position_ids, prompt_attention_mask));
+
+    const Tensor& logits = fetches[0].Get<Tensor>();
+    const int64_t input_length = logits.Shape()[1];
+    const int step_start = current_length;
+    for (int j = 0; j <= num_drafts; j++) {
+      iteration_counter++;
+
+      // The logits of position step_start + j - 1 are the ones for the token at position step_start + j.
+      OrtValue position_logits;
+      if (input_length == 1) {
+        position_logits = fetches[0];
+      } else {
+        Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), position_logits_shape, temp_space_allocator_,
+                             position_logits);
+        const int64_t position = step_start + j - 1 - past_length;
+        T* target = position_logits.GetMutable<Tensor>()->MutableData<T>();
+        for (int b = 0; b < batch_size; b++) {
+          memcpy(target + SafeInt<size_t>(b) * vocab_size,
+                 logits.Data<T>() + (SafeInt<size_t>(b) * input_length + position) * vocab_size,
+                 sizeof(T) * vocab_size);
+        }
+      }
+
+      ORT_RETURN_IF_ERROR(process_logits_func_(position_logits, &greedy_state, &(greedy_state.sequences),
+                                               temp_space_allocator_, thread_pool_, &logits_processors_,
+                                               parameters_, generator_, iteration_counter, cuda_stream_,
+                                               GetConsoleDumper()));
+
+      // The next position is verified only if every unfinished sequence selected the proposed token.
+      bool accepted = j < num_drafts;
+      gsl::span<int32_t>& next_tokens = greedy_state.next_tokens;
+      for (int b = 0; b < batch_size; b++) {
+        if (eos_meet[b]) {
+          next_tokens[b] = parameters_->pad_token_id;
+          continue;
+        }
+
+        if (accepted && next_tokens[b] != draft_tokens[SafeInt<size_t>(b) * num_draft_tokens + j]) {
+          accepted = false;
+        }
+
+        if (next_tokens[b] == parameters_->eos_token_id) {
+          eos_meet[b] = true;
+          num_finished++;
+        }
+      }
+
+      greedy_state.sequences.AppendNextTokenToSequences(sequence_indices, next_tokens);
+      ++current_length;
+
+      if (num_finished == batch_size || !accepted) {
+        break;
+      }
+    }
+
+#ifdef DEBUG_BEAM_SEARCH
+    greedy_state.sequences.PrintSequences(&cpu_dumper_);
+#endif
+
+    // When all batches are finished, stop earlier to avoid wasting computation.
+    if (num_finished == batch_size) {
+      break;
+    }
+
+    // Only the kept positions stay in the past states. The last selected token is fed to both decoders next.
+    past_length = current_length - 1;
+    draft_past_length = std::min(draft_past_length, current_length - 1);
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+void GreedySearchImpl<T>::CopySequencesToOutput(const Sequences& sequences, Tensor* output_sequences) const {
+  // Copy the sequences to output, and fill the remaining with pad_token_id.
+  gsl::span<int32_t> output = output_sequences->MutableDataAsSpan<int32_t>();
+  std::fill(output.begin(), output.end(), parameters_->pad_token_id);
+  for (int i = 0; i < parameters_->batch_size; i++) {
+    gsl::span<const int32_t> sequence = sequences.GetSequence(i);
+    gsl::span<int32_t> target = output.subspan(SafeInt<gsl::index>(i) * parameters_->max_length, sequence.size());
+    gsl::copy(sequence, target);
+  }
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
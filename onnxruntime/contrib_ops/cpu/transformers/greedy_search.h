@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <random>
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/cpu/controlflow/utils.h"
+#include "greedy_search_parameters.h"
+#include "gpt_subgraph.h"
+#include "beam_search_device_helper.h"
+
+namespace onnxruntime {
+class FeedsFetchesManager;
+
+namespace contrib {
+namespace transformers {
+
+using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
+
+// Greedy search and sampling for text generation. It is much cheaper than BeamSearch since there is only one
+// sequence per batch: no beam scorer, no reordering of past state, and no top-k over num_beams * vocab_size.
+class GreedySearch : public IControlFlowKernel {
+ public:
+  GreedySearch(const OpKernelInfo& info)
+      : IControlFlowKernel(info),
+        feeds_fetches_manager_(nullptr),
+        draft_feeds_fetches_manager_(nullptr),
+        cuda_stream_(nullptr),
+        dumper_(nullptr) {
+    Init(info);
+  }
+
+  void Init(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  Status SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                    const std::string& attribute_name,
+                                    const SessionState& subgraph_session_state) override;
+
+ protected:
+  void SetComputeStream(void* stream) { cuda_stream_ = stream; }
+  void SetConsoleDumper(IConsoleDumper* dumper) { dumper_ = dumper; }
+
+  void SetDeviceHelpers(const BeamSearchDeviceHelper::AddToFeedsFunc& add_to_feeds_func) {
+    add_to_feeds_func_ = add_to_feeds_func;
+  }
+
+  // Type dependent helpers: float
+  void SetDeviceHelpers(
+      const BeamSearchDeviceHelper::GreedySearchProcessLogitsFunc<float>& process_logits_func,
+      const BeamSearchDeviceHelper::InitGreedyStateFunc<float>& init_greedy_state_func,
+      const BeamSearchDeviceHelper::UpdateFeedsFunc<float>& update_feeds_func) {
+    process_logits_func_ = process_logits_func;
+    init_greedy_state_func_ = init_greedy_state_func;
+    update_feeds_func_ = update_feeds_func;
+  }
+
+  // Type dependent helpers: MLFloat16
+  void SetDeviceHelpers(
+      const BeamSearchDeviceHelper::GreedySearchProcessLogitsFunc<MLFloat16>& process_logits_func,
+      const BeamSearchDeviceHelper::InitGreedyStateFunc<MLFloat16>& init_greedy_state_func,
+      const BeamSearchDeviceHelper::UpdateFeedsFunc<MLFloat16>& update_feeds_func) {
+    process_logits_fp16_func_ = process_logits_func;
+    init_greedy_state_fp16_func_ = init_greedy_state_func;
+    update_feeds_fp16_func_ = update_feeds_func;
+  }
+
+ private:
+  // Device specific functions
+  BeamSearchDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
+  BeamSearchDeviceHelper::GreedySearchProcessLogitsFunc<float> process_logits_func_;
+  BeamSearchDeviceHelper::InitGreedyStateFunc<float> init_greedy_state_func_;
+  BeamSearchDeviceHelper::UpdateFeedsFunc<float> update_feeds_func_;
+
+  BeamSearchDeviceHelper::GreedySearchProcessLogitsFunc<MLFloat16> process_logits_fp16_func_;
+  BeamSearchDeviceHelper::InitGreedyStateFunc<MLFloat16> init_greedy_state_fp16_func_;
+  BeamSearchDeviceHelper::UpdateFeedsFunc<MLFloat16> update_feeds_fp16_func_;
+
+  // Subgraph and FeedsFetchesManager re-used for each subgraph execution.
+  std::unique_ptr<GptSubgraph> gpt_subgraph_;
+  FeedsFetchesManager* feeds_fetches_manager_;
+
+  // Optional draft decoder for speculative decoding.
+  std::unique_ptr<GptSubgraph> draft_subgraph_;
+  FeedsFetchesManager* draft_feeds_fetches_manager_;
+
+  void* cuda_stream_;
+
+  IConsoleDumper* dumper_;
+
+  GreedySearchParameters parameters_;
+
+  // generator_ seeds the random number generator of each call to Compute() when sampling.
+  // use generator_mutex_ to ensure Compute() can be called concurrently.
+  mutable std::default_random_engine generator_;
+  mutable onnxruntime::OrtMutex generator_mutex_;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
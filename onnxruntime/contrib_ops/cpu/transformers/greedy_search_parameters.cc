@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "greedy_search_parameters.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+void GreedySearchParameters::ParseFromAttributes(const OpKernelInfo& info) {
+  model_type = static_cast<int>(info.GetAttrOrDefault<int64_t>("model_type", 0));
+  eos_token_id = static_cast<int>(info.GetAttrOrDefault<int64_t>("eos_token_id", -1));
+  pad_token_id = static_cast<int>(info.GetAttrOrDefault<int64_t>("pad_token_id", -1));
+  no_repeat_ngram_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("no_repeat_ngram_size", 0));
+  do_sample = info.GetAttrOrDefault<int64_t>("do_sample", 0) == 1;
+  num_draft_tokens = static_cast<int>(info.GetAttrOrDefault<int64_t>("num_draft_tokens", 4));
+  ORT_ENFORCE(num_draft_tokens > 0, "num_draft_tokens shall be a positive integer, got ", num_draft_tokens);
+  early_stopping = false;
+}
+
+void GreedySearchParameters::ParseFromInputs(OpKernelContext* context) {
+  ORT_ENFORCE(context != nullptr);
+  const Tensor* input_ids = context->Input<Tensor>(0);
+  const auto& dims = input_ids->Shape().GetDims();
+  ORT_ENFORCE(dims.size() == 2, "input_ids shall have 2 dimensions. Got ", dims.size());
+  batch_size = static_cast<int>(dims[0]);
+  sequence_length = static_cast<int>(dims[1]);
+
+  auto* max_length_tensor = context->Input<Tensor>(1);
+  max_length = max_length_tensor ? static_cast<int>(*max_length_tensor->Data<int32_t>()) : kMaxSequenceLength;
+  ORT_ENFORCE(max_length > sequence_length, "max_length (", max_length, ") shall be greater than input sequence length (", sequence_length, ")");
+  ORT_ENFORCE(max_length <= kMaxSequenceLength, "max_length (", max_length, ") shall be no more than ", kMaxSequenceLength);
+
+  auto* min_length_tensor = context->Input<Tensor>(2);
+  min_length = min_length_tensor ? static_cast<int>(*min_length_tensor->Data<int32_t>()) : 0;
+
+  auto* repetition_penalty_tensor = context->Input<Tensor>(3);
+  repetition_penalty = repetition_penalty_tensor ? static_cast<float>(*repetition_penalty_tensor->Data<float>()) : 1.0f;
+  ORT_ENFORCE(repetition_penalty > 0.0f, "repetition_penalty shall be greater than 0, got ", repetition_penalty);
+
+  auto* temperature_tensor = context->Input<Tensor>(6);
+  temperature = temperature_tensor ? static_cast<float>(*temperature_tensor->Data<float>()) : 1.0f;
+  ORT_ENFORCE(temperature > 0.0f, "temperature shall be greater than 0, got ", temperature);
+
+  auto* top_k_tensor = context->Input<Tensor>(7);
+  top_k = top_k_tensor ? static_cast<int>(*top_k_tensor->Data<int32_t>()) : 0;
+  ORT_ENFORCE(top_k >= 0, "top_k shall not be negative, got ", top_k);
+
+  auto* top_p_tensor = context->Input<Tensor>(8);
+  top_p = top_p_tensor ? static_cast<float>(*top_p_tensor->Data<float>()) : 1.0f;
+  ORT_ENFORCE(top_p > 0.0f && top_p <= 1.0f, "top_p shall be in range (0, 1], got ", top_p);
+
+  // Greedy search is beam search with one beam, which the logits processors and subgraph helpers rely on.
+  num_beams = 1;
+  num_return_sequences = 1;
+  length_penalty = 1.0f;
+}
+
+void GreedySearchParameters::SetSubgraphParameters(int vocabulary_size, int heads, int hidden_size_per_head, int layers) {
+  vocab_size = vocabulary_size;
+  num_heads = heads;
+  head_size = hidden_size_per_head;
+  num_layers = layers;
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
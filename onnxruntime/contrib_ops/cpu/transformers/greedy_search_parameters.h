@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "beam_search_shared.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+struct GreedySearchParameters : public IGreedySearchParameters {
+  int BatchBeamSize() const { return batch_size; }
+
+  void ParseFromAttributes(const OpKernelInfo& info);
+
+  void ParseFromInputs(OpKernelContext* context);
+
+  void SetSubgraphParameters(int vocab_size, int num_heads, int head_size, int num_layers);
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -177,7 +177,7 @@ void PrefixVocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
 #endif
 }
 
-void LogitsProcessorList::Init(const BeamSearchParameters& parameters) {
+void LogitsProcessorList::Init(const IBeamSearchParameters& parameters) {
   processor_list_.clear();
 
   if (parameters.repetition_penalty != 1.0f) {  // 1.0 means no penalty
@@ -205,7 +205,7 @@ void LogitsProcessorList::Init(const BeamSearchParameters& parameters) {
     processor_list_.push_back(min_length_processor_.get());
   }
 
-  batch_beam_size_ = parameters.BatchBeamSize();
+  batch_beam_size_ = parameters.batch_size * parameters.num_beams;
   vocab_size_ = parameters.vocab_size;
 }
 
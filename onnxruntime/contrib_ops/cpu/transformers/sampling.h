@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+#include "gsl/gsl"
+#include "beam_search_shared.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Selects the next token of a sequence from the scores (log probabilities after logits processors) of the
+// vocabulary. It is used by GreedySearch for both CPU and CUDA, so it is implemented in this header.
+//
+// Top-k and top-p filtering are fused into the selection so that the vocabulary is never fully sorted:
+// top-k candidates are found with a partial selection in O(vocab_size), and without top-k the candidates of
+// top-p are popped from a heap of the vocabulary in descending order until their probability mass reaches top_p.
+class TokenSampler {
+ public:
+  explicit TokenSampler(const IGreedySearchParameters& parameters)
+      : do_sample_(parameters.do_sample),
+        top_k_(parameters.top_k),
+        top_p_(parameters.top_p),
+        temperature_(parameters.temperature) {}
+
+  // Returns the token with the highest score.
+  static int32_t ArgMax(gsl::span<const float> scores) {
+    return static_cast<int32_t>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+  }
+
+  // Selects the next token from the scores of the whole vocabulary.
+  int32_t Select(gsl::span<const float> scores, std::default_random_engine& generator) {
+    if (!do_sample_) {
+      return ArgMax(scores);
+    }
+
+    const auto vocab_size = static_cast<size_t>(scores.size());
+    candidates_.clear();
+    candidates_.reserve(vocab_size);
+    for (size_t i = 0; i < vocab_size; i++) {
+      candidates_.emplace_back(scores[i], static_cast<int32_t>(i));
+    }
+
+    if (top_k_ > 0 && static_cast<size_t>(top_k_) < vocab_size) {
+      std::nth_element(candidates_.begin(), candidates_.begin() + (top_k_ - 1), candidates_.end(), Greater);
+      candidates_.resize(static_cast<size_t>(top_k_));
+      std::sort(candidates_.begin(), candidates_.end(), Greater);
+      return SampleSortedCandidates(generator);
+    }
+
+    if (top_p_ < 1.0f) {
+      const float max_score = *std::max_element(scores.begin(), scores.end());
+      float total = 0.0f;
+      for (const auto& candidate : candidates_) {
+        total += Weight(candidate.first, max_score);
+      }
+
+      // Heap is ordered by the greater score, and the popped candidates are moved to the end of candidates_.
+      std::make_heap(candidates_.begin(), candidates_.end(), Less);
+      auto heap_end = candidates_.end();
+      float mass = 0.0f;
+      while (heap_end != candidates_.begin() && mass < top_p_ * total) {
+        std::pop_heap(candidates_.begin(), heap_end, Less);
+        --heap_end;
+        mass += Weight(heap_end->first, max_score);
+      }
+
+      // Candidates in [heap_end, end) are in ascending order of score.
+      return Sample(candidates_.rbegin(), std::make_reverse_iterator(heap_end), max_score, mass, generator);
+    }
+
+    const float max_score = *std::max_element(scores.begin(), scores.end());
+    float total = 0.0f;
+    for (const auto& candidate : candidates_) {
+      total += Weight(candidate.first, max_score);
+    }
+    return Sample(candidates_.begin(), candidates_.end(), max_score, total, generator);
+  }
+
+  // Selects the next token from candidates sorted in descending order of score, like the output of TopK with
+  // k equal to top_k. It only applies top-p filtering and sampling.
+  int32_t SelectFromTopK(gsl::span<const float> scores, gsl::span<const int32_t> token_ids,
+                         std::default_random_engine& generator) {
+    if (!do_sample_) {
+      return token_ids[0];
+    }
+
+    candidates_.clear();
+    for (size_t i = 0; i < static_cast<size_t>(scores.size()); i++) {
+      candidates_.emplace_back(scores[i], token_ids[i]);
+    }
+    return SampleSortedCandidates(generator);
+  }
+
+ private:
+  using Candidate = std::pair<float, int32_t>;  // score and token id
+
+  static bool Greater(const Candidate& a, const Candidate& b) { return a.first > b.first; }
+  static bool Less(const Candidate& a, const Candidate& b) { return a.first < b.first; }
+
+  // Unnormalized probability of a score with temperature.
+  float Weight(float score, float max_score) const { return std::exp((score - max_score) / temperature_); }
+
+  // Samples from candidates_ sorted in descending order of score, after top-p filtering.
+  int32_t SampleSortedCandidates(std::default_random_engine& generator) {
+    const float max_score = candidates_.front().first;
+    float total = 0.0f;
+    for (const auto& candidate : candidates_) {
+      total += Weight(candidate.first, max_score);
+    }
+
+    auto end = candidates_.begin();
+    float mass = 0.0f;
+    // Keep at least one candidate.
+    do {
+      mass += Weight(end->first, max_score);
+      ++end;
+    } while (end != candidates_.end() && mass < top_p_ * total);
+
+    return Sample(candidates_.begin(), end, max_score, mass, generator);
+  }
+
+  // Samples a token from candidates in [begin, end) with probability proportional to their weights.
+  template <typename Iterator>
+  int32_t Sample(Iterator begin, Iterator end, float max_score, float total, std::default_random_engine& generator) {
+    std::uniform_real_distribution<float> distribution(0.0f, total);
+    float r = distribution(generator);
+    int32_t token_id = begin->second;
+    for (Iterator it = begin; it != end; ++it) {
+      token_id = it->second;
+      r -= Weight(it->first, max_score);
+      if (r < 0.0f) {
+        break;
+      }
+    }
+
+    return token_id;
+  }
+
+  bool do_sample_;
+  int top_k_;
+  float top_p_;
+  float temperature_;
+
+  std::vector<Candidate> candidates_;  // reused for all sequences
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
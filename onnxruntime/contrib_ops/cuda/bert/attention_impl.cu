@@ -54,14 +54,44 @@ size_t GetAttentionScratchSize(size_t element_size, int batch_size, int num_head
   return bytesAligned;
 }
 
+// Total sequence length from which the memory efficient kernel is used. Shorter sequences are faster with the
+// batched GEMMs, and the single pass softmax kernels are limited to 1024 elements.
+constexpr int kMemoryEfficientAttentionMinSequenceLength = 1025;
+
+bool UseMemoryEfficientAttention(
+    const cudaDeviceProp& prop,
+    size_t element_size,
+    int head_size,
+    int all_sequence_length,
+    gsl::span<const int64_t> mask_index_dims,
+    bool has_extra_add_qk) {
+  const TransformerOptions* options = TransformerOptions::GetInstance();
+  if (options->DisableMemoryEfficientAttention()) {
+    return false;
+  }
+
+  const bool is_mask_supported = mask_index_dims.size() <= 1 ||
+                                 (mask_index_dims.size() == 2 && mask_index_dims[1] == all_sequence_length);
+  return element_size == 2 &&
+         prop.major >= 7 &&
+         head_size <= kMemoryEfficientAttentionMaxHeadSize &&
+         all_sequence_length >= kMemoryEfficientAttentionMinSequenceLength &&
+         is_mask_supported &&
+         !has_extra_add_qk;
+}
+
 size_t GetAttentionWorkspaceSize(
     size_t element_size,
     int batch_size,
     int num_heads,
     int head_size,
     int sequence_length,
-    int past_sequence_length) {
+    int past_sequence_length,
+    bool use_memory_efficient_attention) {
   size_t qkv_size = 3 * batch_size * sequence_length * num_heads * head_size * element_size;
+  if (use_memory_efficient_attention) {
+    return qkv_size;
+  }
   return qkv_size + 2 * GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, past_sequence_length + sequence_length);
 }
 
@@ -69,19 +99,25 @@ template <typename T>
 bool QkvToContext(
     const cudaDeviceProp& prop, cublasHandle_t& cublas, cudaStream_t stream,
     const int batch_size, const int sequence_length, const int num_heads, const int head_size, const size_t element_size,
-    const T* input, T* output, T* workspace,
+    const T* input, const T* bias, T* output, T* workspace,
     const int* mask_index, gsl::span<const int64_t> mask_index_dims,
     bool is_unidirectional, int past_sequence_length, const T* past, const T* extra_add_qk, T* present, bool use_persistent_softmax) {
   const int all_sequence_length = past_sequence_length + sequence_length;
-  const size_t bytes = GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, all_sequence_length);
+  const bool use_memory_efficient_attention = UseMemoryEfficientAttention(
+      prop, element_size, head_size, all_sequence_length, mask_index_dims, nullptr != extra_add_qk);
+
+  // The memory efficient kernel only needs the QKV buffer, which is placed at the start of the workspace.
+  const size_t bytes = use_memory_efficient_attention
+                           ? 0
+                           : GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, all_sequence_length);
   T* scratch1 = workspace;
   T* scratch2 = scratch1 + (bytes / element_size);
   T* scratch3 = scratch2 + (bytes / element_size);
 
   const int max_threads_per_block = prop.maxThreadsPerBlock;
 
-  // input should be BxSx3xNxH => scratch3: 3xBxNxSxH
-  if (!LaunchTransQkv(stream, 3, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, false, input, scratch3)) {
+  // input should be BxSx3xNxH => scratch3: 3xBxNxSxH, adding the bias if the GEMM did not
+  if (!LaunchTransQkv(stream, 3, sequence_length, batch_size, head_size, num_heads, max_threads_per_block, false, input, scratch3, bias)) {
     return false;
   }
 
@@ -110,6 +146,11 @@ bool QkvToContext(
     v = present + batches * present_size_per_batch;
   }
 
+  if (use_memory_efficient_attention) {
+    return LaunchMemoryEfficientAttention(stream, batch_size, sequence_length, all_sequence_length, num_heads, head_size,
+                                          q, k, v, mask_index, mask_index_dims, is_unidirectional, output);
+  }
+
   // Raw attention mask could be 2D (BxS) or 3D (BxSxS*) or 4D(Bx1xMxM), where M is the max sequence length.
   bool use_raw_attention_mask = (nullptr != mask_index && mask_index_dims.size() >= 2);
 
@@ -183,6 +224,31 @@ bool LaunchAttentionKernel(
     const void* past,
     const void* extra_add_qk,
     void* present) {
+  return LaunchAttentionKernel(prop, stream, input, nullptr, mask_index, mask_index_dims, output,
+                               batch_size, sequence_length, num_heads, head_size, workspace, cublas, element_size,
+                               is_unidirectional, past_sequence_length, past, extra_add_qk, present);
+}
+
+bool LaunchAttentionKernel(
+    const cudaDeviceProp& prop,
+    cudaStream_t stream,
+    const void* input,
+    const void* bias,
+    const int* mask_index,
+    gsl::span<const int64_t> mask_index_dims,
+    void* output,
+    const int batch_size,
+    const int sequence_length,
+    const int num_heads,
+    const int head_size,
+    void* workspace,
+    cublasHandle_t& cublas,
+    const size_t element_size,
+    bool is_unidirectional,
+    int past_sequence_length,
+    const void* past,
+    const void* extra_add_qk,
+    void* present) {
 
   // For testing, environment variable ORT_TRANSFORMER_OPTIONS=1 could enable persistent softmax
   const TransformerOptions* options = TransformerOptions::GetInstance();
@@ -191,14 +257,16 @@ bool LaunchAttentionKernel(
   if (element_size == 2) {
     return QkvToContext(prop, cublas, stream,
                         batch_size, sequence_length, num_heads, head_size, element_size,
-                        reinterpret_cast<const half*>(input), reinterpret_cast<half*>(output), reinterpret_cast<half*>(workspace),
+                        reinterpret_cast<const half*>(input), reinterpret_cast<const half*>(bias),
+                        reinterpret_cast<half*>(output), reinterpret_cast<half*>(workspace),
                         mask_index, mask_index_dims, is_unidirectional,
                         past_sequence_length, reinterpret_cast<const half*>(past), reinterpret_cast<const half*>(extra_add_qk),
                         reinterpret_cast<half*>(present), use_persistent_softmax);
   } else {
     return QkvToContext(prop, cublas, stream,
                         batch_size, sequence_length, num_heads, head_size, element_size,
-                        reinterpret_cast<const float*>(input), reinterpret_cast<float*>(output), reinterpret_cast<float*>(workspace),
+                        reinterpret_cast<const float*>(input), reinterpret_cast<const float*>(bias),
+                        reinterpret_cast<float*>(output), reinterpret_cast<float*>(workspace),
                         mask_index, mask_index_dims, is_unidirectional,
                         past_sequence_length, reinterpret_cast<const float*>(past), reinterpret_cast<const float*>(extra_add_qk),
                         reinterpret_cast<float*>(present), use_persistent_softmax);
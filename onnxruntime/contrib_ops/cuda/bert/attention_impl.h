@@ -10,13 +10,28 @@ namespace contrib {
 namespace cuda {
 size_t GetAttentionScratchSize(size_t element_size, int batch_size, int num_heads, int sequence_length, int all_sequence_length);
 
+// Largest head size supported by the memory efficient attention kernel.
+constexpr int kMemoryEfficientAttentionMaxHeadSize = 128;
+
+// Returns whether attention is computed by the memory efficient kernel, which does not need the workspace for the
+// BxNxSxS* scores. It is used for half precision on sm70+ when the total sequence length is over 1024, with no mask,
+// a 1D mask index or a 2D raw mask, and without extra_add_qk.
+bool UseMemoryEfficientAttention(
+    const cudaDeviceProp& prop,
+    size_t element_size,
+    int head_size,
+    int all_sequence_length,
+    gsl::span<const int64_t> mask_index_dims,
+    bool has_extra_add_qk);
+
 size_t GetAttentionWorkspaceSize(
     size_t element_size,
     int batchsize,
     int num_heads,
     int head_size,
     int sequence_length,
-    int past_sequence_length);
+    int past_sequence_length,
+    bool use_memory_efficient_attention = false);
 
 bool LaunchAttentionKernel(
     const cudaDeviceProp& prop,                   // Device Properties
@@ -39,6 +54,30 @@ bool LaunchAttentionKernel(
     void* present                                 // Present state output
 );
 
+// Same as above, with the bias of the QKV GEMM added when transposing its output, so that the GEMM does not need
+// to broadcast the bias into its output buffer first.
+bool LaunchAttentionKernel(
+    const cudaDeviceProp& prop,                   // Device Properties
+    cudaStream_t stream,                          // cuda stream
+    const void* input,                            // Input tensor, the output of the QKV GEMM without bias
+    const void* bias,                             // Bias of the QKV GEMM with shape (3 * hidden_size)
+    const int* mask_index,                        // Attention mask raw data or index. NULL means no mask.
+    gsl::span<const int64_t> mask_index_dims,     // Mask index shape
+    void* output,                                 // Output tensor
+    int batch_size,                               // Batch size (B)
+    int sequence_length,                          // Sequence length (S)
+    int num_heads,                                // Number of attention heads (N)
+    int head_size,                                // Hidden layer size per head (H)
+    void* workspace,                              // Temporary buffer
+    cublasHandle_t& cublas,                       // Cublas handle
+    const size_t element_size,                    // Element size of input tensor
+    bool is_unidirectional,                       // Whether there is unidirecitonal mask.
+    int past_sequence_length,                     // Sequence length in past state
+    const void* past,                             // Past state input
+    const void* extra_add_qk,                     // Additional Add
+    void* present                                 // Present state output
+);
+
 bool LaunchDecoderAttentionKernel(
     const cudaDeviceProp& prop,                   // Device Properties
     cudaStream_t stream,                          // Cuda stream
@@ -65,6 +104,31 @@ bool LaunchDecoderAttentionKernel(
     void* new_value_cache                         // New_value_cache tensor
 );
 
+// Computes the attention of Q (BxNxSxH) over K and V (BxNxS*xH) without materializing the scores, and writes the
+// output as BxSxNxH.
+bool LaunchMemoryEfficientAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int all_sequence_length,
+    const int num_heads, const int head_size, const float* q, const float* k, const float* v,
+    const int* mask_index, gsl::span<const int64_t> mask_index_dims, bool is_unidirectional, float* output);
+
+bool LaunchMemoryEfficientAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int all_sequence_length,
+    const int num_heads, const int head_size, const half* q, const half* k, const half* v,
+    const int* mask_index, gsl::span<const int64_t> mask_index_dims, bool is_unidirectional, half* output);
+
+// Computes the attention of sequences packed without padding. qkv is the output of the QKV GEMM without bias with
+// shape Tx3xNxH, where T is the token count. Sequence b has the tokens [cumulative_sequence_length[b],
+// cumulative_sequence_length[b + 1]) and only attends to itself. The output has shape TxNxH.
+bool LaunchPackedAttention(
+    cudaStream_t stream, const int batch_size, const int max_sequence_length, const int num_heads, const int head_size,
+    const float* qkv, const float* bias, const int* cumulative_sequence_length, bool is_unidirectional,
+    float* output);
+
+bool LaunchPackedAttention(
+    cudaStream_t stream, const int batch_size, const int max_sequence_length, const int num_heads, const int head_size,
+    const half* qkv, const half* bias, const int* cumulative_sequence_length, bool is_unidirectional,
+    half* output);
+
 bool LaunchTransCtx(cudaStream_t stream,
                     const int sequence_length, const int batch_size, const int head_size, const int num_heads,
                     const int max_threads_per_block, const bool reversed_bs, const float* input, float* output);
@@ -73,13 +137,16 @@ bool LaunchTransCtx(cudaStream_t stream,
                     const int sequence_length, const int batch_size, const int head_size, const int num_heads,
                     const int max_threads_per_block, const bool reversed_bs, const half* input, half* output);
 
+// Transposes Q, K and V to KxBxNxSxH. If bias is not nullptr, it is added to them on the way.
 bool LaunchTransQkv(cudaStream_t stream, const int matrix_num,
                     const int sequence_length, const int batch_size, const int head_size, const int num_heads,
-                    const int max_threads_per_block, const bool reversed_bs, const float* input, float* output);
+                    const int max_threads_per_block, const bool reversed_bs, const float* input, float* output,
+                    const float* bias = nullptr);
 
 bool LaunchTransQkv(cudaStream_t stream, const int matrix_num,
                     const int sequence_length, const int batch_size, const int head_size, const int num_heads,
-                    const int max_threads_per_block, const bool reversed_bs, const half* input, half* output);
+                    const int max_threads_per_block, const bool reversed_bs, const half* input, half* output,
+                    const half* bias = nullptr);
 
 bool LaunchConcatTensorToTensor(cudaStream_t stream,
                                 const int all_sequence_length,
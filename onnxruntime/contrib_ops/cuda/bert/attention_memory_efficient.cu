@@ -0,0 +1,344 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Attention that does not materialize the BxNxSxS* matrix of scores. Keys and values are processed in tiles, and the
+// softmax is computed online: each query keeps the running maximum and sum of its exponentials, and rescales the
+// partial output when a later tile raises the maximum. The workspace is only the QKV buffer, and the scores never
+// leave the chip, so long sequences fit in memory and the kernel reads K and V once per block of queries.
+
+#include <cuda_fp16.h>
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cuda_common.h"
+#include "attention_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+// Each warp computes one query. Each lane scores one key of a tile, and owns head_size / 32 dimensions of the output.
+constexpr int kWarpsPerBlock = 4;
+constexpr int kKeysPerTile = GPU_WARP_SIZE;
+constexpr int kMaxElementsPerLane = kMemoryEfficientAttentionMaxHeadSize / GPU_WARP_SIZE;
+
+__device__ __forceinline__ float WarpReduceMax(float value) {
+#pragma unroll
+  for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+    value = fmaxf(value, WARP_SHFL_XOR(value, offset));
+  }
+  return value;
+}
+
+__device__ __forceinline__ float WarpReduceSum(float value) {
+#pragma unroll
+  for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+    value += WARP_SHFL_XOR(value, offset);
+  }
+  return value;
+}
+
+// Q: BxNxSxH, K and V: BxNxS*xH, output: BxSxNxH. The grid is (ceil(S / kWarpsPerBlock), B x N).
+// Masks follow the unfused path: keys outside of [mask_start, mask_end) are skipped, while the raw 2D mask and the
+// unidirectional mask combined with it add -10000 to the scores.
+//
+// If cumulative_sequence_length is not nullptr, the batch is packed without padding: sequence b has the tokens
+// [cumulative_sequence_length[b], cumulative_sequence_length[b + 1]), q is the output of the QKV GEMM with shape
+// Tx3xNxH, where T is the token count, and the output has shape TxNxH. The bias of the GEMM is added to Q, K and V
+// when they are loaded, and sequence_length is the maximum sequence length.
+template <typename T>
+__global__ void MemoryEfficientAttentionKernel(const int sequence_length,
+                                               const int all_sequence_length,
+                                               const int num_heads,
+                                               const int head_size,
+                                               const float scale,
+                                               const T* q,
+                                               const T* k,
+                                               const T* v,
+                                               const T* bias,
+                                               const int* cumulative_sequence_length,
+                                               const int* mask_end,
+                                               const int* mask_start,
+                                               const int* raw_mask,
+                                               const bool is_unidirectional,
+                                               T* output) {
+  __shared__ float q_shared[kWarpsPerBlock][kMemoryEfficientAttentionMaxHeadSize];
+  // The padding of K rows makes the lanes, which read one key each, hit different banks.
+  __shared__ float k_shared[kKeysPerTile][kMemoryEfficientAttentionMaxHeadSize + 1];
+  __shared__ float v_shared[kKeysPerTile][kMemoryEfficientAttentionMaxHeadSize];
+
+  const int warp = threadIdx.x / GPU_WARP_SIZE;
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+  const int batch_head = blockIdx.y;
+  const int batch = batch_head / num_heads;
+  const int head = batch_head % num_heads;
+  const int query = blockIdx.x * kWarpsPerBlock + warp;
+
+  // Rows of Q, K, V and output of this batch and head, and the distance between consecutive rows.
+  const T* q_head;
+  const T* k_head;
+  const T* v_head;
+  T* output_head;
+  int64_t qkv_row_stride = head_size;
+  int64_t output_row_stride = static_cast<int64_t>(num_heads) * head_size;
+  int query_count = sequence_length;
+  int key_count = all_sequence_length;
+  if (cumulative_sequence_length != nullptr) {
+    const int token_start = cumulative_sequence_length[batch];
+    query_count = cumulative_sequence_length[batch + 1] - token_start;
+    key_count = query_count;
+
+    // The whole block has no query, which is uniform across the block.
+    if (blockIdx.x * kWarpsPerBlock >= query_count) {
+      return;
+    }
+
+    const int hidden_size = num_heads * head_size;
+    qkv_row_stride = 3 * hidden_size;
+    q_head = q + static_cast<int64_t>(token_start) * qkv_row_stride + head * head_size;
+    k_head = q_head + hidden_size;
+    v_head = q_head + 2 * hidden_size;
+    output_head = output + static_cast<int64_t>(token_start) * hidden_size + head * head_size;
+  } else {
+    q_head = q + static_cast<int64_t>(batch_head) * sequence_length * head_size;
+    const int64_t kv_offset = static_cast<int64_t>(batch_head) * all_sequence_length * head_size;
+    k_head = k + kv_offset;
+    v_head = v + kv_offset;
+    output_head = output + static_cast<int64_t>(batch) * sequence_length * output_row_stride + head * head_size;
+  }
+
+  const T* q_bias = nullptr;
+  const T* k_bias = nullptr;
+  const T* v_bias = nullptr;
+  if (bias != nullptr) {
+    q_bias = bias + head * head_size;
+    k_bias = q_bias + num_heads * head_size;
+    v_bias = k_bias + num_heads * head_size;
+  }
+
+  const bool has_query = query < query_count;
+
+  // Offset of the query in the whole sequence, which includes the past.
+  const int past_sequence_length = key_count - query_count;
+  const int from_index = past_sequence_length + query;
+
+  if (has_query) {
+    const T* q_row = q_head + query * qkv_row_stride;
+    for (int i = lane; i < head_size; i += GPU_WARP_SIZE) {
+      const float q_value = static_cast<float>(q_row[i]) + (q_bias != nullptr ? static_cast<float>(q_bias[i]) : 0.f);
+      q_shared[warp][i] = q_value * scale;
+    }
+  }
+
+  // Range of keys that are attended when there is no raw mask. Keys in [0, prefix_end) are attended too, which
+  // matches the unfused softmax when the unidirectional mask ends before the 1D mask starts.
+  int valid_start = 0;
+  int valid_end = key_count;
+  int prefix_end = 0;
+  if (raw_mask == nullptr) {
+    if (mask_end != nullptr) {
+      valid_start = mask_start != nullptr ? max(0, mask_start[batch]) : 0;
+      valid_end = min(key_count, mask_end[batch]);
+
+      // Attend to no word has same effect as attend to all words.
+      if (valid_start >= valid_end) {
+        valid_start = 0;
+        valid_end = key_count;
+      }
+    }
+
+    if (is_unidirectional) {
+      const int end_unidirectional = from_index + 1;
+      if (end_unidirectional <= valid_start) {
+        prefix_end = end_unidirectional;
+      } else {
+        valid_end = min(valid_end, end_unidirectional);
+      }
+    }
+  }
+
+  // Queries of this block do not attend to keys after the last one of them, so those tiles are not loaded.
+  int block_key_end = key_count;
+  if (is_unidirectional && raw_mask == nullptr && mask_end == nullptr) {
+    block_key_end = min(key_count, past_sequence_length + (blockIdx.x + 1) * kWarpsPerBlock);
+  }
+
+  float running_max = -CUDART_INF_F;
+  float running_sum = 0.f;
+  float accumulator[kMaxElementsPerLane];
+#pragma unroll
+  for (int i = 0; i < kMaxElementsPerLane; i++) {
+    accumulator[i] = 0.f;
+  }
+
+  for (int tile_start = 0; tile_start < block_key_end; tile_start += kKeysPerTile) {
+    __syncthreads();
+    for (int index = threadIdx.x; index < kKeysPerTile * head_size; index += blockDim.x) {
+      const int key = index / head_size;
+      const int i = index % head_size;
+      const int key_index = tile_start + key;
+      float k_value = 0.f;
+      float v_value = 0.f;
+      if (key_index < key_count) {
+        const int64_t offset = key_index * qkv_row_stride + i;
+        k_value = static_cast<float>(k_head[offset]) + (k_bias != nullptr ? static_cast<float>(k_bias[i]) : 0.f);
+        v_value = static_cast<float>(v_head[offset]) + (v_bias != nullptr ? static_cast<float>(v_bias[i]) : 0.f);
+      }
+      k_shared[key][i] = k_value;
+      v_shared[key][i] = v_value;
+    }
+    __syncthreads();
+
+    if (!has_query) {
+      continue;
+    }
+
+    const int key_index = tile_start + lane;
+    float score = -CUDART_INF_F;
+    if (key_index < key_count) {
+      const bool is_valid = raw_mask != nullptr ||
+                            (key_index >= valid_start && key_index < valid_end) ||
+                            key_index < prefix_end;
+      if (is_valid) {
+        score = 0.f;
+        for (int i = 0; i < head_size; i++) {
+          score += q_shared[warp][i] * k_shared[lane][i];
+        }
+
+        if (raw_mask != nullptr) {
+          if (is_unidirectional && key_index > from_index) {
+            score = -10000.0f;
+          }
+          if (raw_mask[batch * all_sequence_length + key_index] == 0) {
+            score += -10000.0f;
+          }
+        }
+      }
+    }
+
+    const float new_max = fmaxf(running_max, WarpReduceMax(score));
+    if (new_max == -CUDART_INF_F) {
+      // No key has been attended so far.
+      continue;
+    }
+
+    const float probability = score == -CUDART_INF_F ? 0.f : expf(score - new_max);
+    const float correction = expf(running_max - new_max);
+    running_sum = running_sum * correction + WarpReduceSum(probability);
+    running_max = new_max;
+
+#pragma unroll
+    for (int i = 0; i < kMaxElementsPerLane; i++) {
+      accumulator[i] *= correction;
+    }
+
+    for (int key = 0; key < kKeysPerTile; key++) {
+      const float p = __shfl_sync(0xffffffff, probability, key);
+      if (p != 0.f) {
+#pragma unroll
+        for (int i = 0; i < kMaxElementsPerLane; i++) {
+          const int dimension = lane + i * GPU_WARP_SIZE;
+          if (dimension < head_size) {
+            accumulator[i] += p * v_shared[key][dimension];
+          }
+        }
+      }
+    }
+  }
+
+  if (has_query) {
+    const float sum_reverse = running_sum > 0.f ? 1.f / running_sum : 0.f;
+    T* output_row = output_head + query * output_row_stride;
+#pragma unroll
+    for (int i = 0; i < kMaxElementsPerLane; i++) {
+      const int dimension = lane + i * GPU_WARP_SIZE;
+      if (dimension < head_size) {
+        output_row[dimension] = T(accumulator[i] * sum_reverse);
+      }
+    }
+  }
+}
+
+template <typename T>
+bool LaunchMemoryEfficientAttentionKernel(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int all_sequence_length,
+    const int num_heads, const int head_size, const T* q, const T* k, const T* v,
+    const int* mask_index, gsl::span<const int64_t> mask_index_dims, bool is_unidirectional, T* output) {
+  const int* mask_end = nullptr;
+  const int* mask_start = nullptr;
+  const int* raw_mask = nullptr;
+  if (nullptr != mask_index) {
+    if (mask_index_dims.size() == 1) {
+      // mask_index has 1D shape: either (batch_size) or (2*batch_size). Only the later one has start postions.
+      mask_end = mask_index;
+      mask_start = (mask_index_dims[0] > batch_size) ? mask_index + batch_size : nullptr;
+    } else {
+      raw_mask = mask_index;
+    }
+  }
+
+  const float scale = 1.f / sqrt(static_cast<float>(head_size));
+  const dim3 grid(CeilDiv(sequence_length, kWarpsPerBlock), batch_size * num_heads, 1);
+  const dim3 block(kWarpsPerBlock * GPU_WARP_SIZE, 1, 1);
+  MemoryEfficientAttentionKernel<T><<<grid, block, 0, stream>>>(
+      sequence_length, all_sequence_length, num_heads, head_size, scale, q, k, v, nullptr, nullptr,
+      mask_end, mask_start, raw_mask, is_unidirectional, output);
+
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+template <typename T>
+bool LaunchPackedAttentionKernel(
+    cudaStream_t stream, const int batch_size, const int max_sequence_length, const int num_heads, const int head_size,
+    const T* qkv, const T* bias, const int* cumulative_sequence_length, bool is_unidirectional, T* output) {
+  const float scale = 1.f / sqrt(static_cast<float>(head_size));
+  const dim3 grid(CeilDiv(max_sequence_length, kWarpsPerBlock), batch_size * num_heads, 1);
+  const dim3 block(kWarpsPerBlock * GPU_WARP_SIZE, 1, 1);
+  MemoryEfficientAttentionKernel<T><<<grid, block, 0, stream>>>(
+      max_sequence_length, max_sequence_length, num_heads, head_size, scale, qkv, nullptr, nullptr, bias,
+      cumulative_sequence_length, nullptr, nullptr, nullptr, is_unidirectional, output);
+
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+}  // namespace
+
+bool LaunchMemoryEfficientAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int all_sequence_length,
+    const int num_heads, const int head_size, const float* q, const float* k, const float* v,
+    const int* mask_index, gsl::span<const int64_t> mask_index_dims, bool is_unidirectional, float* output) {
+  return LaunchMemoryEfficientAttentionKernel(stream, batch_size, sequence_length, all_sequence_length,
+                                              num_heads, head_size, q, k, v,
+                                              mask_index, mask_index_dims, is_unidirectional, output);
+}
+
+bool LaunchMemoryEfficientAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int all_sequence_length,
+    const int num_heads, const int head_size, const half* q, const half* k, const half* v,
+    const int* mask_index, gsl::span<const int64_t> mask_index_dims, bool is_unidirectional, half* output) {
+  return LaunchMemoryEfficientAttentionKernel(stream, batch_size, sequence_length, all_sequence_length,
+                                              num_heads, head_size, q, k, v,
+                                              mask_index, mask_index_dims, is_unidirectional, output);
+}
+
+bool LaunchPackedAttention(
+    cudaStream_t stream, const int batch_size, const int max_sequence_length, const int num_heads, const int head_size,
+    const float* qkv, const float* bias, const int* cumulative_sequence_length, bool is_unidirectional,
+    float* output) {
+  return LaunchPackedAttentionKernel(stream, batch_size, max_sequence_length, num_heads, head_size,
+                                     qkv, bias, cumulative_sequence_length, is_unidirectional, output);
+}
+
+bool LaunchPackedAttention(
+    cudaStream_t stream, const int batch_size, const int max_sequence_length, const int num_heads, const int head_size,
+    const half* qkv, const half* bias, const int* cumulative_sequence_length, bool is_unidirectional,
+    half* output) {
+  return LaunchPackedAttentionKernel(stream, batch_size, max_sequence_length, num_heads, head_size,
+                                     qkv, bias, cumulative_sequence_length, is_unidirectional, output);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
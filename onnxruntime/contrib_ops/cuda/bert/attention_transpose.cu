@@ -158,9 +158,26 @@ bool LaunchTransCtx(cudaStream_t stream,
   return CUDA_CALL(cudaPeekAtLastError());
 }
 
+__device__ inline float AddBias(const float a, const float b) {
+  return a + b;
+}
+
+__device__ inline float2 AddBias(const float2 a, const float2 b) {
+  return make_float2(a.x + b.x, a.y + b.y);
+}
+
+__device__ inline half AddBias(const half a, const half b) {
+  return __float2half(__half2float(a) + __half2float(b));
+}
+
+__device__ inline half2 AddBias(const half2 a, const half2 b) {
+  return __floats2half2_rn(__low2float(a) + __low2float(b), __high2float(a) + __high2float(b));
+}
+
 template <typename T>
-__global__ void TransposeQKV(const int H, const bool reversed_bs, const T* input, T* output) {
+__global__ void TransposeQKV(const int H, const bool reversed_bs, const T* input, const T* bias, T* output) {
   // Input:  BxSxKxNxH or SxBxKxNxH
+  // Bias:   KxNxH, or nullptr
   // Output: KxBxNxSxH
   // K is the number of identical matrix
 
@@ -188,15 +205,20 @@ __global__ void TransposeQKV(const int H, const bool reversed_bs, const T* input
 
   const int i = threadIdx.x;
   if (i < H) {
-    output[out_offset + i] = input[in_offset + i];
+    if (bias == nullptr) {
+      output[out_offset + i] = input[in_offset + i];
+    } else {
+      output[out_offset + i] = AddBias(input[in_offset + i], bias[m * NH + n * H + i]);
+    }
   }
 }
 
 template <typename T>
-__global__ void TransposeQKVLarge(const int H, const bool reversed_bs, const T* input, T* output) {
+__global__ void TransposeQKVLarge(const int H, const bool reversed_bs, const T* input, const T* bias, T* output) {
   // Use when (H*)*num_heads > 1024
 
   // Input:  BxSxKxNxH or SxBxKxNxH
+  // Bias:   KxNxH, or nullptr
   // Output: KxBxNxSxH
   // K is the number of identical matrix
 
@@ -224,33 +246,39 @@ __global__ void TransposeQKVLarge(const int H, const bool reversed_bs, const T*
 
   int i = threadIdx.x;
   while (i < H) {
-    output[out_offset + i] = input[in_offset + i];
+    if (bias == nullptr) {
+      output[out_offset + i] = input[in_offset + i];
+    } else {
+      output[out_offset + i] = AddBias(input[in_offset + i], bias[m * NH + n * H + i]);
+    }
     i += stride;
   }
 }
 
 bool LaunchTransQkv(cudaStream_t stream, const int matrix_num,
                     const int sequence_length, const int batch_size, const int head_size, const int num_heads,
-                    const int max_threads_per_block, const bool reversed_bs, const float* input, float* output) {
+                    const int max_threads_per_block, const bool reversed_bs, const float* input, float* output,
+                    const float* bias) {
   const dim3 grid(sequence_length, batch_size, matrix_num);
   if (0 == (head_size & 1)) {
     const int H = head_size / 2;
     const float2* input2 = reinterpret_cast<const float2*>(input);
+    const float2* bias2 = reinterpret_cast<const float2*>(bias);
     float2* output2 = reinterpret_cast<float2*>(output);
     if (H * num_heads <= max_threads_per_block) {
       const dim3 block(H, num_heads, 1);
-      TransposeQKV<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+      TransposeQKV<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, bias2, output2);
     } else {
       const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
-      TransposeQKVLarge<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+      TransposeQKVLarge<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, bias2, output2);
     }
   } else {
     if (head_size * num_heads <= max_threads_per_block) {
       const dim3 block(head_size, num_heads, 1);
-      TransposeQKV<float><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, output);
+      TransposeQKV<float><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, bias, output);
     } else {
       const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
-      TransposeQKVLarge<float><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, output);
+      TransposeQKVLarge<float><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, bias, output);
     }
 
   }
@@ -259,37 +287,40 @@ bool LaunchTransQkv(cudaStream_t stream, const int matrix_num,
 
 bool LaunchTransQkv(cudaStream_t stream, const int matrix_num,
                     const int sequence_length, const int batch_size, const int head_size, const int num_heads,
-                    const int max_threads_per_block, const bool reversed_bs, const half* input, half* output) {
+                    const int max_threads_per_block, const bool reversed_bs, const half* input, half* output,
+                    const half* bias) {
   const dim3 grid(sequence_length, batch_size, matrix_num);
-  if (0 == (head_size % 4)) {
+  // 4 halves are moved as a float2 when there is no bias to add.
+  if (0 == (head_size % 4) && bias == nullptr) {
     const int H = head_size / 4;
     const float2* input2 = reinterpret_cast<const float2*>(input);
     float2* output2 = reinterpret_cast<float2*>(output);
     if (H * num_heads <= max_threads_per_block) {
       const dim3 block(H, num_heads, 1);
-      TransposeQKV<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+      TransposeQKV<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, nullptr, output2);
     } else {
       const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
-      TransposeQKVLarge<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+      TransposeQKVLarge<float2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, nullptr, output2);
     }
   } else if (0 == (head_size & 1)) {
     const int H = head_size / 2;
     const half2* input2 = reinterpret_cast<const half2*>(input);
+    const half2* bias2 = reinterpret_cast<const half2*>(bias);
     half2* output2 = reinterpret_cast<half2*>(output);
     if (H * num_heads <= max_threads_per_block) {
       const dim3 block(H, num_heads, 1);
-      TransposeQKV<half2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+      TransposeQKV<half2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, bias2, output2);
     } else {
       const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
-      TransposeQKVLarge<half2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+      TransposeQKVLarge<half2><<<grid, block, 0, stream>>>(H, reversed_bs, input2, bias2, output2);
     }
   } else {  // this should be an "odd" case. probably not worth catching it in the half2 kernel..
     if (head_size * num_heads <= max_threads_per_block) {
       const dim3 block(head_size, num_heads, 1);
-      TransposeQKV<half><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, output);
+      TransposeQKV<half><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, bias, output);
     } else {
       const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
-      TransposeQKVLarge<half><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, output);
+      TransposeQKVLarge<half><<<grid, block, 0, stream>>>(head_size, reversed_bs, input, bias, output);
     }
   }
   return CUDA_CALL(cudaPeekAtLastError());
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "decoder_masked_self_attention.h"
+#include "decoder_masked_self_attention_impl.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+
+using namespace onnxruntime::cuda;
+using namespace ::onnxruntime::common;
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      DecoderMaskedSelfAttention,                                 \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      (*KernelDefBuilder::Create())                               \
+          .MayInplace(4, 1)                                       \
+          .InputMemoryType(OrtMemTypeCPUInput, 5)                 \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      DecoderMaskedSelfAttention<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+DecoderMaskedSelfAttention<T>::DecoderMaskedSelfAttention(const OpKernelInfo& info) : CudaKernel(info) {
+  int64_t num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  num_heads_ = static_cast<int>(num_heads);
+}
+
+template <typename T>
+Status DecoderMaskedSelfAttention<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* mask_index = context->Input<Tensor>(3);
+  const Tensor* past = context->Input<Tensor>(4);
+  const Tensor* past_sequence_length_tensor = context->Input<Tensor>(5);
+
+  // input shape (batch_size, sequence_length, input_hidden_size)
+  const auto& dims = input->Shape().GetDims();
+  if (dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'input' is expected to have 3 dimensions, got ",
+                           dims.size());
+  }
+  const int batch_size = static_cast<int>(dims[0]);
+  const int sequence_length = static_cast<int>(dims[1]);
+  const int input_hidden_size = static_cast<int>(dims[2]);
+
+  const auto& weights_dims = weights->Shape().GetDims();
+  if (weights_dims.size() != 2 || weights_dims[0] != dims[2]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'weights' is expected to have shape (input_hidden_size, 3 * hidden_size)");
+  }
+
+  const auto& bias_dims = bias->Shape().GetDims();
+  if (bias_dims.size() != 1 || bias_dims[0] != weights_dims[1] ||
+      bias_dims[0] % 3 != 0 || (bias_dims[0] / 3) % num_heads_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'bias' is expected to have shape (3 * hidden_size), where hidden_size is divisible "
+                           "by num_heads");
+  }
+  const int hidden_size = static_cast<int>(bias_dims[0]) / 3;
+  const int head_size = hidden_size / num_heads_;
+  if (head_size > kDecoderMaskedSelfAttentionMaxHeadSize) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "DecoderMaskedSelfAttention only supports head size up to ",
+                           kDecoderMaskedSelfAttentionMaxHeadSize, ", got ", head_size);
+  }
+
+  // past shape (2, batch_size, num_heads, max_sequence_length, head_size)
+  const auto& past_dims = past->Shape().GetDims();
+  if (past_dims.size() != 5 || past_dims[0] != 2 || past_dims[1] != dims[0] || past_dims[2] != num_heads_ ||
+      past_dims[4] != head_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past' is expected to have shape (2, batch_size, num_heads, max_sequence_length, "
+                           "head_size), got ", past->Shape());
+  }
+  const int max_sequence_length = static_cast<int>(past_dims[3]);
+
+  if (past_sequence_length_tensor->Shape().Size() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'past_sequence_length' is expected to be a scalar");
+  }
+  const int past_sequence_length = *past_sequence_length_tensor->template Data<int32_t>();
+  if (past_sequence_length < 0 || past_sequence_length + sequence_length > max_sequence_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "past_sequence_length (", past_sequence_length,
+                           ") plus sequence_length (", sequence_length, ") exceeds the length of the cache (",
+                           max_sequence_length, ")");
+  }
+
+  int mask_sequence_length = 0;
+  if (nullptr != mask_index) {
+    const auto& mask_dims = mask_index->Shape().GetDims();
+    if (mask_dims.size() != 2 || mask_dims[0] != dims[0] ||
+        mask_dims[1] < static_cast<int64_t>(past_sequence_length) + sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'mask_index' is expected to have shape (batch_size, past_sequence_length + "
+                             "sequence_length) or (batch_size, max_sequence_length), got ", mask_index->Shape());
+    }
+    mask_sequence_length = static_cast<int>(mask_dims[1]);
+  }
+
+  TensorShapeVector output_shape{dims[0], dims[1], static_cast<int64_t>(hidden_size)};
+  Tensor* output = context->Output(0, output_shape);
+  Tensor* present = context->Output(1, past->Shape());
+
+  // The cache is appended in place when present shares the buffer of past. Otherwise, which happens when the planner
+  // could not reuse past, the cache is copied first.
+  if (present->MutableDataRaw() != past->DataRaw()) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(present->MutableDataRaw(), past->DataRaw(), past->SizeInBytes(),
+                                         cudaMemcpyDeviceToDevice, Stream()));
+  }
+
+  if (sequence_length == 0) {
+    return Status::OK();
+  }
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  CudaT one = ToCudaType<T>::FromFloat(1.0f);
+  CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+
+  // Gemm, note that CUDA assumes col-major, so result(N, M) = 1 * weights x input.
+  // The bias is added when the new keys and values are appended, and when the queries are loaded.
+  int m = batch_size * sequence_length;
+  int n = 3 * hidden_size;
+  int k = input_hidden_size;
+  auto gemm_buffer = GetScratchBuffer<T>(static_cast<size_t>(m) * n);
+  CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+      CublasHandle(), CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &one,
+      reinterpret_cast<const CudaT*>(weights->template Data<T>()), n,
+      reinterpret_cast<const CudaT*>(input->template Data<T>()), k,
+      &zero, reinterpret_cast<CudaT*>(gemm_buffer.get()), n, GetDeviceProp()));
+
+  if (!LaunchDecoderMaskedSelfAttention(
+          Stream(),
+          batch_size,
+          sequence_length,
+          num_heads_,
+          head_size,
+          past_sequence_length,
+          max_sequence_length,
+          reinterpret_cast<const CudaT*>(gemm_buffer.get()),
+          reinterpret_cast<const CudaT*>(bias->template Data<T>()),
+          nullptr == mask_index ? nullptr : mask_index->template Data<int>(),
+          mask_sequence_length,
+          reinterpret_cast<CudaT*>(present->template MutableData<T>()),
+          reinterpret_cast<CudaT*>(output->template MutableData<T>()))) {
+    // Get last error to reset it to cudaSuccess.
+    CUDA_CALL(cudaGetLastError());
+    return Status(common::ONNXRUNTIME, common::FAIL);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Decoding attention over a key and value cache allocated for the maximum sequence length. The new keys and values
+// are written to the cache in place, and then each query reads the cache once: the warps of a block split the keys,
+// each warp keeps a running softmax over its keys, and the partial results of the warps are merged at the end. For
+// a query length of 1, which is the case of every step after the prompt, there is no workspace and no second pass.
+
+#include <cfloat>
+#include <cuda_fp16.h>
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cuda_common.h"
+#include "decoder_masked_self_attention_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kWarpsPerBlock = 4;
+constexpr int kMaxElementsPerLane = kDecoderMaskedSelfAttentionMaxHeadSize / GPU_WARP_SIZE;
+
+__device__ __forceinline__ float WarpReduceSum(float value) {
+#pragma unroll
+  for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+    value += WARP_SHFL_XOR(value, offset);
+  }
+  return value;
+}
+
+// The grid is (sequence_length, batch_size). Adds the bias to the key and value of a new token, and writes them to
+// the cache in present.
+template <typename T>
+__global__ void AppendKeyValueKernel(const int num_heads,
+                                     const int head_size,
+                                     const int past_sequence_length,
+                                     const int max_sequence_length,
+                                     const T* qkv,
+                                     const T* bias,
+                                     T* present) {
+  const int token = blockIdx.x;
+  const int batch = blockIdx.y;
+  const int sequence_length = gridDim.x;
+  const int batch_size = gridDim.y;
+  const int hidden_size = num_heads * head_size;
+
+  const T* qkv_row = qkv + (static_cast<int64_t>(batch) * sequence_length + token) * 3 * hidden_size;
+  const int64_t value_offset = static_cast<int64_t>(batch_size) * hidden_size * max_sequence_length;
+  for (int i = threadIdx.x; i < hidden_size; i += blockDim.x) {
+    const int head = i / head_size;
+    const int dimension = i % head_size;
+    const int64_t cache_index = ((static_cast<int64_t>(batch) * num_heads + head) * max_sequence_length +
+                                 past_sequence_length + token) *
+                                    head_size +
+                                dimension;
+    present[cache_index] = T(static_cast<float>(qkv_row[hidden_size + i]) +
+                             static_cast<float>(bias[hidden_size + i]));
+    present[value_offset + cache_index] = T(static_cast<float>(qkv_row[2 * hidden_size + i]) +
+                                            static_cast<float>(bias[2 * hidden_size + i]));
+  }
+}
+
+// The grid is (sequence_length, num_heads, batch_size), and each block computes one query of one head. Query s
+// attends to the keys [0, past_sequence_length + s] of the cache. Keys masked by the raw mask get -10000 added to
+// their scores like in the unfused Attention.
+template <typename T>
+__global__ void DecoderMaskedSelfAttentionKernel(const int num_heads,
+                                                 const int head_size,
+                                                 const int past_sequence_length,
+                                                 const int max_sequence_length,
+                                                 const float scale,
+                                                 const T* qkv,
+                                                 const T* bias,
+                                                 const int* mask,
+                                                 const int mask_sequence_length,
+                                                 const T* present,
+                                                 T* output) {
+  __shared__ float max_shared[kWarpsPerBlock];
+  __shared__ float sum_shared[kWarpsPerBlock];
+  __shared__ float accumulator_shared[kWarpsPerBlock][kDecoderMaskedSelfAttentionMaxHeadSize];
+
+  const int token = blockIdx.x;
+  const int head = blockIdx.y;
+  const int batch = blockIdx.z;
+  const int sequence_length = gridDim.x;
+  const int batch_size = gridDim.z;
+  const int warp = threadIdx.x / GPU_WARP_SIZE;
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+  const int hidden_size = num_heads * head_size;
+
+  // Each lane owns the dimensions lane, lane + 32, ... of the query and of the output.
+  const int64_t row = static_cast<int64_t>(batch) * sequence_length + token;
+  const T* q_row = qkv + row * 3 * hidden_size + head * head_size;
+  const T* q_bias = bias + head * head_size;
+  float query[kMaxElementsPerLane];
+#pragma unroll
+  for (int i = 0; i < kMaxElementsPerLane; i++) {
+    const int dimension = lane + i * GPU_WARP_SIZE;
+    query[i] = dimension < head_size
+                   ? (static_cast<float>(q_row[dimension]) + static_cast<float>(q_bias[dimension])) * scale
+                   : 0.f;
+  }
+
+  const int64_t cache_offset = (static_cast<int64_t>(batch) * num_heads + head) * max_sequence_length * head_size;
+  const T* key_cache = present + cache_offset;
+  const T* value_cache = present + static_cast<int64_t>(batch_size) * hidden_size * max_sequence_length + cache_offset;
+  const int* mask_row = mask != nullptr ? mask + static_cast<int64_t>(batch) * mask_sequence_length : nullptr;
+
+  float max_score = -FLT_MAX;
+  float sum = 0.f;
+  float accumulator[kMaxElementsPerLane];
+#pragma unroll
+  for (int i = 0; i < kMaxElementsPerLane; i++) {
+    accumulator[i] = 0.f;
+  }
+
+  const int key_count = past_sequence_length + token + 1;
+  for (int key = warp; key < key_count; key += kWarpsPerBlock) {
+    const T* key_row = key_cache + static_cast<int64_t>(key) * head_size;
+    float partial = 0.f;
+#pragma unroll
+    for (int i = 0; i < kMaxElementsPerLane; i++) {
+      const int dimension = lane + i * GPU_WARP_SIZE;
+      if (dimension < head_size) {
+        partial += query[i] * static_cast<float>(key_row[dimension]);
+      }
+    }
+
+    float score = WarpReduceSum(partial);
+    if (mask_row != nullptr && mask_row[key] == 0) {
+      score += -10000.f;
+    }
+
+    const float new_max = fmaxf(max_score, score);
+    const float correction = expf(max_score - new_max);
+    const float probability = expf(score - new_max);
+    sum = sum * correction + probability;
+
+    const T* value_row = value_cache + static_cast<int64_t>(key) * head_size;
+#pragma unroll
+    for (int i = 0; i < kMaxElementsPerLane; i++) {
+      const int dimension = lane + i * GPU_WARP_SIZE;
+      if (dimension < head_size) {
+        accumulator[i] = accumulator[i] * correction + probability * static_cast<float>(value_row[dimension]);
+      }
+    }
+    max_score = new_max;
+  }
+
+  if (lane == 0) {
+    max_shared[warp] = max_score;
+    sum_shared[warp] = sum;
+  }
+#pragma unroll
+  for (int i = 0; i < kMaxElementsPerLane; i++) {
+    const int dimension = lane + i * GPU_WARP_SIZE;
+    if (dimension < head_size) {
+      accumulator_shared[warp][dimension] = accumulator[i];
+    }
+  }
+  __syncthreads();
+
+  // Merge the running softmax of the warps. A warp without keys has a sum and an accumulator of 0.
+  float block_max = max_shared[0];
+#pragma unroll
+  for (int w = 1; w < kWarpsPerBlock; w++) {
+    block_max = fmaxf(block_max, max_shared[w]);
+  }
+
+  float scales[kWarpsPerBlock];
+  float block_sum = 0.f;
+#pragma unroll
+  for (int w = 0; w < kWarpsPerBlock; w++) {
+    scales[w] = expf(max_shared[w] - block_max);
+    block_sum += sum_shared[w] * scales[w];
+  }
+
+  T* output_row = output + row * hidden_size + head * head_size;
+  for (int dimension = threadIdx.x; dimension < head_size; dimension += blockDim.x) {
+    float value = 0.f;
+#pragma unroll
+    for (int w = 0; w < kWarpsPerBlock; w++) {
+      value += accumulator_shared[w][dimension] * scales[w];
+    }
+    output_row[dimension] = T(value / block_sum);
+  }
+}
+
+template <typename T>
+bool LaunchDecoderMaskedSelfAttentionKernel(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int num_heads, const int head_size,
+    const int past_sequence_length, const int max_sequence_length, const T* qkv, const T* bias,
+    const int* mask, const int mask_sequence_length, T* present, T* output) {
+  const int hidden_size = num_heads * head_size;
+  const dim3 append_grid(sequence_length, batch_size, 1);
+  const dim3 append_block(std::min(hidden_size, static_cast<int>(GridDim::maxThreadsPerBlock)), 1, 1);
+  AppendKeyValueKernel<T><<<append_grid, append_block, 0, stream>>>(
+      num_heads, head_size, past_sequence_length, max_sequence_length, qkv, bias, present);
+
+  const float scale = 1.f / sqrt(static_cast<float>(head_size));
+  const dim3 grid(sequence_length, num_heads, batch_size);
+  const dim3 block(kWarpsPerBlock * GPU_WARP_SIZE, 1, 1);
+  DecoderMaskedSelfAttentionKernel<T><<<grid, block, 0, stream>>>(
+      num_heads, head_size, past_sequence_length, max_sequence_length, scale, qkv, bias,
+      mask, mask_sequence_length, present, output);
+
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+}  // namespace
+
+bool LaunchDecoderMaskedSelfAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int num_heads, const int head_size,
+    const int past_sequence_length, const int max_sequence_length, const float* qkv, const float* bias,
+    const int* mask, const int mask_sequence_length, float* present, float* output) {
+  return LaunchDecoderMaskedSelfAttentionKernel(stream, batch_size, sequence_length, num_heads, head_size,
+                                                past_sequence_length, max_sequence_length, qkv, bias,
+                                                mask, mask_sequence_length, present, output);
+}
+
+bool LaunchDecoderMaskedSelfAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int num_heads, const int head_size,
+    const int past_sequence_length, const int max_sequence_length, const half* qkv, const half* bias,
+    const int* mask, const int mask_sequence_length, half* present, half* output) {
+  return LaunchDecoderMaskedSelfAttentionKernel(stream, batch_size, sequence_length, num_heads, head_size,
+                                                past_sequence_length, max_sequence_length, qkv, bias,
+                                                mask, mask_sequence_length, present, output);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+#include <cuda_fp16.h>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Largest head size supported by the decoder masked self attention kernel.
+constexpr int kDecoderMaskedSelfAttentionMaxHeadSize = 128;
+
+// Appends the key and value of the new tokens to the cache in present, at positions [past_sequence_length,
+// past_sequence_length + sequence_length), then computes unidirectional attention of the new tokens over the cache.
+//   qkv: output of the QKV GEMM without bias, with shape (batch_size, sequence_length, 3, num_heads, head_size)
+//   mask: optional raw mask with shape (batch_size, mask_sequence_length), where 0 masks a key
+//   present: (2, batch_size, num_heads, max_sequence_length, head_size)
+//   output: (batch_size, sequence_length, num_heads, head_size)
+bool LaunchDecoderMaskedSelfAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int num_heads, const int head_size,
+    const int past_sequence_length, const int max_sequence_length, const float* qkv, const float* bias,
+    const int* mask, const int mask_sequence_length, float* present, float* output);
+
+bool LaunchDecoderMaskedSelfAttention(
+    cudaStream_t stream, const int batch_size, const int sequence_length, const int num_heads, const int head_size,
+    const int past_sequence_length, const int max_sequence_length, const half* qkv, const half* bias,
+    const int* mask, const int mask_sequence_length, half* present, half* output);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
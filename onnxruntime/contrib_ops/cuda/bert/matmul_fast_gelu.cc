@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/bert/matmul_fast_gelu.h"
+
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/math/cublas_lt_gemm.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+#include "fast_gelu_impl.h"
+#include "transformer_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      MatMulFastGelu,                                             \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      (*KernelDefBuilder::Create())                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      MatMulFastGelu<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+using namespace ONNX_NAMESPACE;
+
+template <typename T>
+MatMulFastGelu<T>::MatMulFastGelu(const OpKernelInfo& op_kernel_info) : CudaKernel(op_kernel_info) {
+  const TransformerOptions* options = TransformerOptions::GetInstance();
+  use_half2_ = !options->DisableHalf2();
+}
+
+template <typename T>
+Status MatMulFastGelu<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* A = context->Input<Tensor>(0);
+  const Tensor* B = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+
+  ORT_RETURN_IF_NOT(B->Shape().NumDimensions() == 2, "MatMulFastGelu: B must be a 2D matrix. Got ", B->Shape());
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(A->Shape(), B->Shape()));
+
+  Tensor* Y = context->Output(0, helper.OutputShape());
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // B is 2D, so the leading dimensions of A are flattened into the rows of a single GEMM.
+  const int k = static_cast<int>(B->Shape()[0]);
+  const int n = static_cast<int>(B->Shape()[1]);
+  const int m = static_cast<int>(Y->Shape().Size() / n);
+
+  if (bias != nullptr) {
+    ORT_RETURN_IF_NOT(bias->Shape().NumDimensions() == 1 && bias->Shape()[0] == n,
+                      "MatMulFastGelu: bias must be a 1D tensor of size ", n, ". Got ", bias->Shape());
+  }
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  const CudaT* a_data = reinterpret_cast<const CudaT*>(A->template Data<T>());
+  const CudaT* b_data = reinterpret_cast<const CudaT*>(B->template Data<T>());
+  const CudaT* bias_data = bias != nullptr ? reinterpret_cast<const CudaT*>(bias->template Data<T>()) : nullptr;
+  CudaT* y_data = reinterpret_cast<CudaT*>(Y->template MutableData<T>());
+
+#if CUDART_VERSION >= 11040
+  // Column major Y(n, m) = GELU(B(n, k) x A(k, m) + bias(n)) in a single cuBLASLt GEMM with a GELU epilogue.
+  const cudaDataType_t data_type = std::is_same<T, MLFloat16>::value ? CUDA_R_16F : CUDA_R_32F;
+  auto workspace = GetScratchBuffer<void>(kCublasLtGemmWorkspaceSize);
+  auto lt_status = CublasLtGemmWithEpilogue(CublasHandle(), Stream(), GetDeviceId(), data_type,
+                                            CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, 1.0f, b_data, n, a_data, k,
+                                            bias_data, y_data, n, GemmEpilogueActivation::Gelu,
+                                            workspace.get(), kCublasLtGemmWorkspaceSize);
+  if (lt_status == CUBLAS_STATUS_SUCCESS) {
+    return Status::OK();
+  }
+  if (lt_status != CUBLAS_STATUS_NOT_SUPPORTED) {
+    CUBLAS_RETURN_IF_ERROR(lt_status);
+  }
+#endif
+
+  // Column major Y(n, m) = B(n, k) x A(k, m), then the bias and FastGelu in place.
+  const CudaT one = ToCudaType<T>::FromFloat(1.0f);
+  const CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+  CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+      CublasHandle(), CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &one,
+      b_data, n, a_data, k, &zero, y_data, n, GetDeviceProp()));
+
+  if (!LaunchFastGeluKernel<CudaT>(GetDeviceProp(),
+                                   Stream(),
+                                   static_cast<int>(Y->Shape().Size()),
+                                   bias != nullptr ? n : 0,
+                                   y_data,
+                                   bias_data,
+                                   y_data,
+                                   use_half2_)) {
+    CUDA_CALL(cudaGetLastError());
+    return Status(common::ONNXRUNTIME, common::FAIL);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+// MatMul with a 2D B followed by FastGelu with an optional bias.
+// The bias and the GELU approximation run in the epilogue of a cuBLASLt GEMM when it supports them, and in a
+// FastGelu kernel after a cuBLAS GEMM otherwise.
+template <typename T>
+class MatMulFastGelu final : public CudaKernel {
+ public:
+  MatMulFastGelu(const OpKernelInfo& op_kernel_info);
+  Status ComputeInternal(OpKernelContext* ctx) const override;
+
+ private:
+  bool use_half2_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
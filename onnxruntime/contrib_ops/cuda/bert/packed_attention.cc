@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "packed_attention.h"
+#include "attention_impl.h"
+#include "contrib_ops/cpu/bert/packed_attention_helper.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+
+using namespace onnxruntime::cuda;
+using namespace ::onnxruntime::common;
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      PackedAttention,                                            \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      (*KernelDefBuilder::Create())                               \
+          .InputMemoryType(OrtMemTypeCPUInput, 3)                 \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      PackedAttention<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+PackedAttention<T>::PackedAttention(const OpKernelInfo& info) : CudaKernel(info) {
+  int64_t num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  num_heads_ = static_cast<int>(num_heads);
+  is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
+}
+
+template <typename T>
+Status PackedAttention<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* cumulative_sequence_length = context->Input<Tensor>(3);
+
+  ORT_RETURN_IF_ERROR(packed_attention_helper::CheckInputs(input->Shape(), weights->Shape(), bias->Shape(),
+                                                           cumulative_sequence_length->Shape(), num_heads_));
+
+  const int token_count = static_cast<int>(input->Shape()[0]);
+  const int input_hidden_size = static_cast<int>(input->Shape()[1]);
+  const int hidden_size = static_cast<int>(bias->Shape()[0]) / 3;
+  const int head_size = hidden_size / num_heads_;
+  const int batch_size = static_cast<int>(cumulative_sequence_length->Shape()[0]) - 1;
+
+  // The cumulative sequence length is a CPU input, so that it can be validated before any kernel reads it.
+  const int32_t* cumulative_data = cumulative_sequence_length->template Data<int32_t>();
+  int max_sequence_length = 0;
+  ORT_RETURN_IF_ERROR(packed_attention_helper::CheckCumulativeSequenceLength(
+      cumulative_data, batch_size, token_count, max_sequence_length));
+
+  if (head_size > kMemoryEfficientAttentionMaxHeadSize) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "PackedAttention only supports head size up to ", kMemoryEfficientAttentionMaxHeadSize,
+                           ", got ", head_size);
+  }
+
+  Tensor* output = context->Output(0, {token_count, hidden_size});
+  if (token_count == 0 || batch_size == 0) {
+    return Status::OK();
+  }
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  CudaT one = ToCudaType<T>::FromFloat(1.0f);
+  CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+
+  // Gemm over all the tokens, note that CUDA assumes col-major, so qkv(3NH, T) = 1 * weights x input.
+  // The bias is added by the attention kernel when it loads Q, K and V.
+  int m = token_count;
+  int n = 3 * hidden_size;
+  int k = input_hidden_size;
+  auto gemm_buffer = GetScratchBuffer<T>(static_cast<size_t>(m) * n);
+  CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+      CublasHandle(), CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &one,
+      reinterpret_cast<const CudaT*>(weights->template Data<T>()), n,
+      reinterpret_cast<const CudaT*>(input->template Data<T>()), k,
+      &zero, reinterpret_cast<CudaT*>(gemm_buffer.get()), n, GetDeviceProp()));
+
+  CudaAsyncBuffer<int> cumulative_sequence_length_gpu(this, batch_size + 1);
+  memcpy(cumulative_sequence_length_gpu.CpuPtr(), cumulative_data, (batch_size + 1) * sizeof(int));
+  ORT_RETURN_IF_ERROR(cumulative_sequence_length_gpu.CopyToGpu());
+
+  if (!LaunchPackedAttention(
+          Stream(),
+          batch_size,
+          max_sequence_length,
+          num_heads_,
+          head_size,
+          reinterpret_cast<const CudaT*>(gemm_buffer.get()),
+          reinterpret_cast<const CudaT*>(bias->template Data<T>()),
+          cumulative_sequence_length_gpu.GpuPtr(),
+          is_unidirectional_,
+          reinterpret_cast<CudaT*>(output->template MutableData<T>()))) {
+    // Get last error to reset it to cudaSuccess.
+    CUDA_CALL(cudaGetLastError());
+    return Status(common::ONNXRUNTIME, common::FAIL);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -19,10 +19,13 @@ class TransformerOptions {
 
   bool DisableHalf2() const { return disable_half2_; }
 
+  bool DisableMemoryEfficientAttention() const { return disable_memory_efficient_attention_; }
+
   void Initialize(int value) {
     is_precision_mode_ = (value & 0x01) > 0;
     disable_persistent_softmax_ = (value & 0x02) > 0;
     disable_half2_ = (value & 0x04) > 0;
+    disable_memory_efficient_attention_ = (value & 0x08) > 0;
     initialized_ = true;
   }
 
@@ -36,6 +39,9 @@ class TransformerOptions {
   // Disable half2 kernel.
   bool disable_half2_{false};
 
+  // Disable the attention kernel that does not materialize the scores for long sequences.
+  bool disable_memory_efficient_attention_{false};
+
   bool initialized_{false};
 
   static TransformerOptions instance;
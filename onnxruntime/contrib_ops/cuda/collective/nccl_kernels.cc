@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/collective/nccl_kernels.h"
+
+#include <mpi.h>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+ncclDataType_t GetNcclDataType(MLDataType type) {
+  if (type == DataTypeImpl::GetType<MLFloat16>()) {
+    return ncclFloat16;
+  } else if (type == DataTypeImpl::GetType<float>()) {
+    return ncclFloat32;
+  } else if (type == DataTypeImpl::GetType<double>()) {
+    return ncclFloat64;
+  }
+
+  ORT_THROW("Tensor type not supported in NCCL.");
+}
+
+}  // namespace
+
+NcclContext::NcclContext(int device_id) {
+  int is_mpi_initialized = 0;
+  MPI_Initialized(&is_mpi_initialized);
+  if (!is_mpi_initialized) {
+    int mpi_threads_provided = 0;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &mpi_threads_provided);
+  }
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+  MPI_Comm_size(MPI_COMM_WORLD, &size_);
+
+  ncclUniqueId nccl_id;
+  if (rank_ == 0) {
+    NCCL_CALL_THROW(ncclGetUniqueId(&nccl_id));
+  }
+  ORT_ENFORCE(MPI_Bcast(&nccl_id, sizeof(nccl_id), MPI_BYTE, 0, MPI_COMM_WORLD) == MPI_SUCCESS,
+              "Failed to broadcast the NCCL id of the tensor-parallel group.");
+
+  // the communicator is bound to the current device
+  CUDA_CALL_THROW(cudaSetDevice(device_id));
+  NCCL_CALL_THROW(ncclCommInitRank(&comm_, size_, nccl_id, rank_));
+}
+
+NcclContext::~NcclContext() {
+  if (comm_ != nullptr) {
+    ncclCommDestroy(comm_);
+  }
+
+  int is_mpi_finalized = 0;
+  MPI_Finalized(&is_mpi_finalized);
+  if (!is_mpi_finalized) {
+    MPI_Finalize();
+  }
+}
+
+NcclKernel::NcclKernel(const OpKernelInfo& info) : CudaKernel(info) {
+  // all the sessions of a process share the communicator, see the comment of NcclContext
+  static NcclContext context(provider_->GetDeviceId());
+  nccl_ = &context;
+}
+
+AllReduce::AllReduce(const OpKernelInfo& info) : NcclKernel(info) {
+  const int64_t group_size = info.GetAttrOrDefault<int64_t>("group_size", 0);
+  ORT_ENFORCE(group_size == nccl_->Size(), "The model was sharded for ", group_size,
+              " ranks but the tensor-parallel group has ", nccl_->Size(), " ranks.");
+}
+
+Status AllReduce::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  Tensor* output = context->Output(0, input->Shape());
+  if (input->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // in place if the allocation planner let the output share the buffer of the input
+  NCCL_RETURN_IF_ERROR(ncclAllReduce(input->DataRaw(), output->MutableDataRaw(), input->Shape().Size(),
+                                     GetNcclDataType(input->DataType()), ncclSum, nccl_->Comm(), Stream()));
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    AllReduce,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::AllIEEEFloatTensorTypes()),
+    AllReduce);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
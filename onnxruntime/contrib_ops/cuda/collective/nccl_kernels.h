@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+#include <nccl.h>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define NCCL_RETURN_IF_ERROR(expr) ORT_RETURN_IF_ERROR(NCCL_CALL(expr) ? common::Status::OK() : common::Status(common::ONNXRUNTIME, common::FAIL))
+
+// Communicator of the tensor-parallel group used for inference. The group spans all the MPI ranks of the job,
+// each rank runs its own session with the CUDA EP on its own device.
+class NcclContext final {
+ public:
+  explicit NcclContext(int device_id);
+  ~NcclContext();
+
+  ncclComm_t Comm() const { return comm_; }
+  int Rank() const { return rank_; }
+  int Size() const { return size_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NcclContext);
+
+  ncclComm_t comm_ = nullptr;
+  int rank_ = 0;
+  int size_ = 1;
+};
+
+// -----------------------------------------------------------------------
+// Base class for the collective kernels of tensor-parallel inference
+// -----------------------------------------------------------------------
+class NcclKernel : public ::onnxruntime::cuda::CudaKernel {
+ public:
+  explicit NcclKernel(const OpKernelInfo& info);
+
+ protected:
+  NcclContext* nccl_ = nullptr;
+};
+
+class AllReduce final : public NcclKernel {
+ public:
+  explicit AllReduce(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
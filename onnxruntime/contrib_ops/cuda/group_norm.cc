@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "group_norm.h"
+#include "group_norm_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                      \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                      \
+      GroupNorm,                                                      \
+      kMSDomain,                                                      \
+      1,                                                              \
+      T,                                                              \
+      kCudaExecutionProvider,                                         \
+      (*KernelDefBuilder::Create())                                   \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())      \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<float>()), \
+      GroupNorm<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+GroupNorm<T>::GroupNorm(const OpKernelInfo& info) : CudaKernel(info) {
+  epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+  ORT_ENFORCE(epsilon_ >= 0);
+  ORT_ENFORCE(info.GetAttr<int64_t>("groups", &groups_).IsOK());
+  ORT_ENFORCE(groups_ > 0);
+
+  const int64_t activation = info.GetAttrOrDefault<int64_t>("activation", 0);
+  ORT_ENFORCE(activation == 0 || activation == 1, "activation is expected to be 0 or 1, got ", activation);
+  use_swish_activation_ = (activation == 1);
+
+  channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", 1) != 0);
+}
+
+template <typename T>
+Status GroupNorm<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* gamma = context->Input<Tensor>(1);
+  const Tensor* beta = context->Input<Tensor>(2);
+  Tensor* output = context->Output(0, input->Shape());
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 4 dimensions, got ", input_dims.size());
+  }
+
+  const int64_t batch_size = input_dims[0];
+  const int64_t num_channels = channels_last_ ? input_dims[3] : input_dims[1];
+  const int64_t image_size = channels_last_ ? input_dims[1] * input_dims[2] : input_dims[2] * input_dims[3];
+
+  if (num_channels % groups_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "number of channels ", num_channels, " is expected to be a multiple of groups ", groups_);
+  }
+
+  if (gamma->Shape().NumDimensions() != 1 || gamma->Shape()[0] != num_channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "gamma is expected to have shape (", num_channels, "), got ", gamma->Shape());
+  }
+
+  if (beta->Shape().NumDimensions() != 1 || beta->Shape()[0] != num_channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "beta is expected to have shape (", num_channels, "), got ", beta->Shape());
+  }
+
+  if (input->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  auto workspace = GetScratchBuffer<float>(static_cast<size_t>(2 * batch_size * groups_));
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  return LaunchGroupNormKernel<CudaT>(
+      Stream(),
+      reinterpret_cast<CudaT*>(output->MutableData<T>()),
+      reinterpret_cast<const CudaT*>(input->Data<T>()),
+      gamma->Data<float>(),
+      beta->Data<float>(),
+      workspace.get(),
+      epsilon_,
+      static_cast<int>(batch_size),
+      static_cast<int>(num_channels),
+      static_cast<int>(image_size),
+      static_cast<int>(groups_),
+      channels_last_,
+      use_swish_activation_);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
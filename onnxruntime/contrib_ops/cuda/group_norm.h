@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+template <typename T>
+class GroupNorm final : public CudaKernel {
+ public:
+  explicit GroupNorm(const OpKernelInfo& info);
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+  int64_t groups_;
+  bool use_swish_activation_;
+  bool channels_last_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
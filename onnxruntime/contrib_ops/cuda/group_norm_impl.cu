@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cub/cub.cuh>
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "group_norm_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kThreadsPerBlock = 256;
+constexpr int kElementsPerThread = 16;
+constexpr int kElementsPerBlock = kThreadsPerBlock * kElementsPerThread;
+
+// Offset of the element at index e of group g of image n. The channels of a
+// group are contiguous in NCHW, and interleaved with the other groups in NHWC.
+__device__ __forceinline__ int64_t GroupElementOffset(int n, int g, int e, int num_channels, int image_size,
+                                                      int group_channels, bool channels_last) {
+  if (channels_last) {
+    const int pixel = e / group_channels;
+    const int c = e - pixel * group_channels;
+    return (static_cast<int64_t>(n) * image_size + pixel) * num_channels + g * group_channels + c;
+  }
+  return (static_cast<int64_t>(n) * num_channels + g * group_channels) * image_size + e;
+}
+
+// Accumulates the sum and the sum of squares of a slice of every group, the
+// slices are spread over grid.x so that large images fill the device.
+template <typename T>
+__global__ void GroupNormSumKernel(const T* input, float* sums, int num_channels, int image_size, int num_groups,
+                                   int group_channels, bool channels_last) {
+  using BlockReduce = cub::BlockReduce<float, kThreadsPerBlock>;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+
+  const int bg = blockIdx.y;
+  const int n = bg / num_groups;
+  const int g = bg - n * num_groups;
+  const int group_size = group_channels * image_size;
+  const int begin = blockIdx.x * kElementsPerBlock;
+  const int end = min(begin + kElementsPerBlock, group_size);
+
+  float sum = 0.0f;
+  float sum_square = 0.0f;
+  for (int e = begin + threadIdx.x; e < end; e += kThreadsPerBlock) {
+    const float value = static_cast<float>(
+        input[GroupElementOffset(n, g, e, num_channels, image_size, group_channels, channels_last)]);
+    sum += value;
+    sum_square += value * value;
+  }
+
+  sum = BlockReduce(temp_storage).Sum(sum);
+  __syncthreads();
+  sum_square = BlockReduce(temp_storage).Sum(sum_square);
+
+  if (threadIdx.x == 0) {
+    atomicAdd(&sums[2 * bg], sum);
+    atomicAdd(&sums[2 * bg + 1], sum_square);
+  }
+}
+
+// Normalizes every element with the statistics of its group, then applies the
+// per channel scale and bias and the optional swish activation.
+template <typename T>
+__global__ void GroupNormScaleKernel(T* output, const T* input, const float* gamma, const float* beta,
+                                     const float* sums, float epsilon, int num_channels, int image_size,
+                                     int num_groups, int group_channels, bool channels_last,
+                                     bool use_swish_activation, int64_t total) {
+  const int64_t index = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (index >= total) {
+    return;
+  }
+
+  int n;
+  int c;
+  if (channels_last) {
+    c = static_cast<int>(index % num_channels);
+    n = static_cast<int>(index / (static_cast<int64_t>(image_size) * num_channels));
+  } else {
+    const int64_t nc = index / image_size;
+    c = static_cast<int>(nc % num_channels);
+    n = static_cast<int>(nc / num_channels);
+  }
+
+  const int bg = n * num_groups + c / group_channels;
+  const float inverse_group_size = 1.0f / (static_cast<float>(group_channels) * image_size);
+  const float mean = sums[2 * bg] * inverse_group_size;
+  const float variance = fmaxf(sums[2 * bg + 1] * inverse_group_size - mean * mean, 0.0f);
+  const float scale = gamma[c] * rsqrtf(variance + epsilon);
+
+  float value = (static_cast<float>(input[index]) - mean) * scale + beta[c];
+  if (use_swish_activation) {
+    value = value / (1.0f + __expf(-value));
+  }
+  output[index] = static_cast<T>(value);
+}
+
+}  // namespace
+
+template <typename T>
+Status LaunchGroupNormKernel(
+    cudaStream_t stream,
+    T* output,
+    const T* input,
+    const float* gamma,
+    const float* beta,
+    float* workspace,
+    float epsilon,
+    int batch_size,
+    int num_channels,
+    int image_size,
+    int num_groups,
+    bool channels_last,
+    bool use_swish_activation) {
+  const int group_channels = num_channels / num_groups;
+  const int group_size = group_channels * image_size;
+  const int64_t total = static_cast<int64_t>(batch_size) * num_channels * image_size;
+
+  CUDA_RETURN_IF_ERROR(cudaMemsetAsync(workspace, 0, 2 * batch_size * num_groups * sizeof(float), stream));
+
+  const dim3 sum_grid(CeilDiv(group_size, kElementsPerBlock), batch_size * num_groups);
+  GroupNormSumKernel<T><<<sum_grid, kThreadsPerBlock, 0, stream>>>(
+      input, workspace, num_channels, image_size, num_groups, group_channels, channels_last);
+
+  const int scale_blocks = static_cast<int>(CeilDiv(total, static_cast<int64_t>(kThreadsPerBlock)));
+  GroupNormScaleKernel<T><<<scale_blocks, kThreadsPerBlock, 0, stream>>>(
+      output, input, gamma, beta, workspace, epsilon, num_channels, image_size, num_groups, group_channels,
+      channels_last, use_swish_activation, total);
+
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+#define SPECIALIZED_IMPL(T)                                                                                   \
+  template Status LaunchGroupNormKernel<T>(cudaStream_t stream, T * output, const T* input, const float* gamma, \
+                                           const float* beta, float* workspace, float epsilon, int batch_size,  \
+                                           int num_channels, int image_size, int num_groups, bool channels_last, \
+                                           bool use_swish_activation);
+
+SPECIALIZED_IMPL(float)
+SPECIALIZED_IMPL(half)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Normalizes the groups of channels of a batch of NCHW or NHWC images. The
+// workspace holds 2 * batch_size * num_groups floats for the group sums.
+template <typename T>
+Status LaunchGroupNormKernel(
+    cudaStream_t stream,
+    T* output,
+    const T* input,
+    const float* gamma,
+    const float* beta,
+    float* workspace,
+    float epsilon,
+    int batch_size,
+    int num_channels,
+    int image_size,
+    int num_groups,
+    bool channels_last,
+    bool use_swish_activation);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -21,7 +21,8 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T1", BuildKernelDefConstraints<MLFloat16, float, double, BFloat16>())
         .TypeConstraint("T2", DataTypeImpl::GetTensorType<bool>())
         .InputMemoryType(OrtMemTypeCPUInput, 3)
-        .InputMemoryType(OrtMemTypeCPUInput, 4),
+        .InputMemoryType(OrtMemTypeCPUInput, 4)
+        .OutputMemoryType(OrtMemTypeCPUOutput, 2),
     BiasDropout);
 
 template <typename T>
@@ -33,15 +34,16 @@ struct BiasDropoutComputeImpl {
                     const float ratio_data,
                     PhiloxGenerator& generator,
                     const Tensor& X,
-                    const Tensor& bias,
+                    const Tensor* bias,
                     const Tensor* residual,
                     Tensor& Y,
                     bool* mask_data,
-                    bool has_same_shape_bias) const {
+                    bool has_same_shape_bias,
+                    std::pair<uint64_t, uint64_t>& seeds) const {
     typedef typename ToCudaType<T>::MappedType CudaT;
 
     const CudaT* X_data = reinterpret_cast<const CudaT*>(X.template Data<T>());
-    const CudaT* bias_data = reinterpret_cast<const CudaT*>(bias.template Data<T>());
+    const CudaT* bias_data = bias ? reinterpret_cast<const CudaT*>(bias->template Data<T>()) : nullptr;
 
     const CudaT* residual_data = nullptr;
     if (residual) {
@@ -53,7 +55,7 @@ struct BiasDropoutComputeImpl {
 
     CudaT* Y_data = reinterpret_cast<CudaT*>(Y.template MutableData<T>());
 
-    BiasDropoutKernelImpl<CudaT>(prop, stream, N, fdm_dim, ratio_data, generator, X_data, bias_data, residual_data, Y_data, mask_data, has_same_shape_bias);
+    seeds = BiasDropoutKernelImpl<CudaT>(prop, stream, N, fdm_dim, ratio_data, generator, X_data, bias_data, residual_data, Y_data, mask_data, has_same_shape_bias);
 
     return Status::OK();
   }
@@ -67,19 +69,22 @@ Status BiasDropout::ComputeInternal(OpKernelContext* context) const {
   const TensorShape& x_shape = X->Shape();
   const int64_t N = x_shape.Size();
 
-  //Get bias_data
+  //Get bias_data, which is optional so that a plain Dropout can also use this kernel.
   const Tensor* bias = context->Input<Tensor>(1);
-  if (bias == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "Bias input of BiasDropout is not available.");
-  const TensorShape& bias_shape = bias->Shape();
-  const int64_t dim = bias_shape.GetDims().back();
-  bool has_same_shape_bias = (bias_shape == x_shape);
-  if (!has_same_shape_bias) {
-    if (bias_shape.NumDimensions() != 1) {
-      return Status(common::ONNXRUNTIME, common::FAIL, "Bias input is not a 1D tensor.");
-    }
+  int64_t dim = 1;
+  bool has_same_shape_bias = false;
+  if (bias) {
+    const TensorShape& bias_shape = bias->Shape();
+    dim = bias_shape.GetDims().back();
+    has_same_shape_bias = (bias_shape == x_shape);
+    if (!has_same_shape_bias) {
+      if (bias_shape.NumDimensions() != 1) {
+        return Status(common::ONNXRUNTIME, common::FAIL, "Bias input is not a 1D tensor.");
+      }
 
-    if (dim != x_shape.GetDims().back()) {
-      return Status(common::ONNXRUNTIME, common::FAIL, "Bias' dimension doesn't match input's last dimension.");
+      if (dim != x_shape.GetDims().back()) {
+        return Status(common::ONNXRUNTIME, common::FAIL, "Bias' dimension doesn't match input's last dimension.");
+      }
     }
   }
 
@@ -107,19 +112,28 @@ Status BiasDropout::ComputeInternal(OpKernelContext* context) const {
     ratio_data = 0.0f;
   }
 
-  IAllocatorUniquePtr<bool> temp_mask_buffer{};  // buffer to use if mask is not provided
-  bool* const mask_data = [this, N, mask, &temp_mask_buffer]() {
-    if (mask) return mask->MutableData<bool>();
-    temp_mask_buffer = GetScratchBuffer<bool>(N);
-    return temp_mask_buffer.get();
-  }();
+  // The kernels skip the mask writes if the mask is not requested.
+  bool* const mask_data = mask ? mask->MutableData<bool>() : nullptr;
 
   const fast_divmod fdm_dim(gsl::narrow_cast<int>(dim));
   PhiloxGenerator& generator = generator_ ? *generator_ : PhiloxGenerator::Default();
 
+  std::pair<uint64_t, uint64_t> seeds;
   utils::MLTypeCallDispatcher<float, MLFloat16, double, BFloat16> t_disp(X->GetElementType());
-  return t_disp.InvokeRet<Status, BiasDropoutComputeImpl>(
-      GetDeviceProp(), Stream(), N, fdm_dim, ratio_data, generator, *X, *bias, residual, *Y, mask_data, has_same_shape_bias);
+  ORT_RETURN_IF_ERROR((t_disp.InvokeRet<Status, BiasDropoutComputeImpl>(
+      GetDeviceProp(), Stream(), N, fdm_dim, ratio_data, generator, *X, bias, residual, *Y, mask_data,
+      has_same_shape_bias, seeds)));
+
+  // The Philox seed and offset the mask was generated from, so that DropoutGrad can regenerate the mask
+  // instead of the mask being kept alive until the backward pass.
+  Tensor* philox_state = context->Output(2, {2});
+  if (philox_state) {
+    int64_t* philox_state_data = philox_state->MutableData<int64_t>();
+    philox_state_data[0] = static_cast<int64_t>(seeds.first);
+    philox_state_data[1] = static_cast<int64_t>(seeds.second);
+  }
+
+  return Status::OK();
 }
 
 }  // namespace cuda
@@ -14,8 +14,9 @@ namespace onnxruntime {
 namespace contrib {
 namespace cuda {
 
+// Returns the Philox seed and offset the mask was generated from.
 template <typename T>
-void BiasDropoutKernelImpl(
+std::pair<uint64_t, uint64_t> BiasDropoutKernelImpl(
     const cudaDeviceProp& prop,
     cudaStream_t stream,
     const int64_t N,
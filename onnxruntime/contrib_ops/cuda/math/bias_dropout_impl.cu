@@ -18,6 +18,7 @@
 
 #include "core/providers/cuda/cu_inc/common.cuh"
 #include "contrib_ops/cuda/math/bias_dropout.h"
+#include "core/providers/cuda/nn/dropout_impl.h"
 
 #include <curand_kernel.h>
 #include <algorithm>
@@ -26,9 +27,9 @@ namespace onnxruntime {
 namespace contrib {
 namespace cuda {
 
-constexpr int UNROLL = 4;
+constexpr int UNROLL = kDropoutUnroll;
 
-template <typename T, bool has_same_shape_bias, bool has_residual>
+template <typename T, bool has_bias, bool has_same_shape_bias, bool has_residual>
 __global__ void BiasDropoutKernel(
     const int64_t N,
     const fast_divmod fdm_dim,
@@ -64,16 +65,21 @@ __global__ void BiasDropoutKernel(
     for (int i = 0; i < UNROLL; i++) {
       CUDA_LONG li = id + i;
       if (li < N) {
-        float bias;
-        if (has_same_shape_bias) {
-          bias = float(bias_data[li]);
-        } else {
-          int offset = fdm_dim.mod(li);
-          bias = float(bias_data[offset]);
+        float bias = 0.0f;
+        if (has_bias) {
+          if (has_same_shape_bias) {
+            bias = float(bias_data[li]);
+          } else {
+            int offset = fdm_dim.mod(li);
+            bias = float(bias_data[offset]);
+          }
         }
 
-        mask_data[li] = (&rand.x)[i] < p;
-        float output_data = (float(X_data[li]) + bias) * mask_data[li] * scale;
+        const bool mask = (&rand.x)[i] < p;
+        if (mask_data) {
+          mask_data[li] = mask;
+        }
+        float output_data = (float(X_data[li]) + bias) * mask * scale;
         if (has_residual) {
           output_data += float(residual_data[li]);
         }
@@ -88,7 +94,7 @@ __global__ void BiasDropoutKernel(
 }
 
 
-template <typename T, bool has_same_shape_bias, bool has_residual>
+template <typename T, bool has_bias, bool has_same_shape_bias, bool has_residual>
 __global__ void BiasDropoutVectorizedKernel(
     const int64_t N,
     const fast_divmod fdm_dim,
@@ -121,7 +127,7 @@ __global__ void BiasDropoutVectorizedKernel(
 
     // vectorized load into storage
     T bias_vec[UNROLL];
-    if (has_same_shape_bias) {
+    if (has_bias && has_same_shape_bias) {
       LoadT *value0 = reinterpret_cast<LoadT*>(&bias_vec);
       *value0 = *reinterpret_cast<const LoadT*>(&bias_data[id]);
     }
@@ -142,12 +148,14 @@ __global__ void BiasDropoutVectorizedKernel(
     // actual computation
     #pragma unroll
     for (int ii = 0; ii < UNROLL; ii++) {
-      float bias;
-      if (has_same_shape_bias) {
-        bias = float(bias_vec[ii]);
-      } else {
-        int offset = fdm_dim.mod(id + ii);
-        bias = float(bias_data[offset]);
+      float bias = 0.0f;
+      if (has_bias) {
+        if (has_same_shape_bias) {
+          bias = float(bias_vec[ii]);
+        } else {
+          int offset = fdm_dim.mod(id + ii);
+          bias = float(bias_data[offset]);
+        }
       }
 
       mask[ii] = (&rand.x)[ii] < p;
@@ -159,15 +167,39 @@ __global__ void BiasDropoutVectorizedKernel(
     }
     // Vectorized writes for mask_data & Y_data
     *(reinterpret_cast<LoadT*>(&Y_data[id])) = *reinterpret_cast<LoadT*>(&r[0]);
-    *(reinterpret_cast<MaskLoadT*>(&mask_data[id])) = *reinterpret_cast<MaskLoadT*>(&mask[0]);
+    if (mask_data) {
+      *(reinterpret_cast<MaskLoadT*>(&mask_data[id])) = *reinterpret_cast<MaskLoadT*>(&mask[0]);
+    }
 
     __syncthreads();
   }
 
 }
 
+template <typename T, bool has_bias, bool has_same_shape_bias, bool has_residual>
+void LaunchBiasDropoutKernel(
+    cudaStream_t stream,
+    const int grid_size,
+    const int64_t N,
+    const fast_divmod fdm_dim,
+    const float ratio,
+    const std::pair<uint64_t, uint64_t>& seeds,
+    const T* X_data,
+    const T* bias_data,
+    const T* residual_data,
+    T* Y_data,
+    bool* mask_data) {
+  if (N % UNROLL != 0) {
+    BiasDropoutKernel<T, has_bias, has_same_shape_bias, has_residual><<<grid_size, kDropoutBlockSize, 0, stream>>>(
+        N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
+  } else {
+    BiasDropoutVectorizedKernel<T, has_bias, has_same_shape_bias, has_residual><<<grid_size, kDropoutBlockSize, 0, stream>>>(
+        N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
+  }
+}
+
 template <typename T>
-void BiasDropoutKernelImpl(
+std::pair<uint64_t, uint64_t> BiasDropoutKernelImpl(
     const cudaDeviceProp& prop,
     cudaStream_t stream,
     const int64_t N,
@@ -180,47 +212,43 @@ void BiasDropoutKernelImpl(
     T* Y_data,
     bool* mask_data,
     bool has_same_shape_bias) {
-  const int block_size = 256;
-  const int blocks_per_sm = prop.maxThreadsPerMultiProcessor / block_size;
-  const int grid_size = std::min(prop.multiProcessorCount * blocks_per_sm, static_cast<int>(CeilDiv(N, block_size * UNROLL)));
+  const int grid_size = DropoutGridSize(prop, N);
 
   // Compute the number of random numbers generated by each thread, and increment philox generator offset by that amount.
-  const uint64_t counter_offset = static_cast<uint64_t>(((N - 1) / (block_size * grid_size * UNROLL) + 1) * UNROLL);
+  const uint64_t counter_offset = DropoutCounterOffset(grid_size, N);
   auto seeds = generator.NextPhiloxSeeds(counter_offset);
 
-  if (N % UNROLL != 0) {
-    if (has_same_shape_bias) {
-      if (residual_data == nullptr) {
-        BiasDropoutKernel<T, true, false><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      } else {
-        BiasDropoutKernel<T, true, true><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      }
+#define LAUNCH_BIAS_DROPOUT_KERNEL(has_bias, has_same_shape_bias, has_residual)            \
+  LaunchBiasDropoutKernel<T, has_bias, has_same_shape_bias, has_residual>(                 \
+      stream, grid_size, N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data)
+
+  if (bias_data == nullptr) {
+    if (residual_data == nullptr) {
+      LAUNCH_BIAS_DROPOUT_KERNEL(false, false, false);
     } else {
-      if (residual_data == nullptr) {
-        BiasDropoutKernel<T, false, false><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      } else {
-        BiasDropoutKernel<T, false, true><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      }
+      LAUNCH_BIAS_DROPOUT_KERNEL(false, false, true);
+    }
+  } else if (has_same_shape_bias) {
+    if (residual_data == nullptr) {
+      LAUNCH_BIAS_DROPOUT_KERNEL(true, true, false);
+    } else {
+      LAUNCH_BIAS_DROPOUT_KERNEL(true, true, true);
     }
   } else {
-    if (has_same_shape_bias) {
-      if (residual_data == nullptr) {
-        BiasDropoutVectorizedKernel<T, true, false><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      } else {
-        BiasDropoutVectorizedKernel<T, true, true><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      }
+    if (residual_data == nullptr) {
+      LAUNCH_BIAS_DROPOUT_KERNEL(true, false, false);
     } else {
-      if (residual_data == nullptr) {
-        BiasDropoutVectorizedKernel<T, false, false><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      } else {
-        BiasDropoutVectorizedKernel<T, false, true><<<grid_size, block_size, 0, stream>>>(N, fdm_dim, ratio, seeds, X_data, bias_data, residual_data, Y_data, mask_data);
-      }
+      LAUNCH_BIAS_DROPOUT_KERNEL(true, false, true);
     }
   }
+
+#undef LAUNCH_BIAS_DROPOUT_KERNEL
+
+  return seeds;
 }
 
-#define SPECIALIZED_BIAS_DROPOUT_IMPL(T) \
-  template void BiasDropoutKernelImpl(  \
+#define SPECIALIZED_BIAS_DROPOUT_IMPL(T)                              \
+  template std::pair<uint64_t, uint64_t> BiasDropoutKernelImpl(  \
       const cudaDeviceProp& prop,   \
       cudaStream_t stream,          \
       const int64_t N,              \
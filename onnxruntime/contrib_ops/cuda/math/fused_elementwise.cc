@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "fused_elementwise.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                 \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                 \
+      FusedElementwise,                                          \
+      kMSDomain,                                                 \
+      1,                                                         \
+      T,                                                         \
+      kCudaExecutionProvider,                                    \
+      (*KernelDefBuilder::Create())                              \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),\
+      FusedElementwise<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+FusedElementwise<T>::FusedElementwise(const OpKernelInfo& info) : CudaKernel(info) {
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK());
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK());
+  std::vector<int64_t> operand_first = info.GetAttrsOrDefault<int64_t>("operand_first",
+                                                                       std::vector<int64_t>(ops.size(), 0));
+  ORT_ENFORCE(operands.size() == ops.size() && operand_first.size() == ops.size(),
+              "ops, operands and operand_first must have the same size");
+  ORT_ENFORCE(!ops.empty() && ops.size() <= static_cast<size_t>(kMaxFusedElementwiseSteps),
+              "FusedElementwise: the number of ops must be between 1 and ", kMaxFusedElementwiseSteps);
+
+  const int64_t input_count = static_cast<int64_t>(info.GetInputCount());
+  ORT_ENFORCE(input_count <= FusedElementwiseInputs<T>::Capacity(),
+              "FusedElementwise: at most ", FusedElementwiseInputs<T>::Capacity(), " inputs are supported");
+
+  steps_.SetSize(static_cast<int32_t>(ops.size()));
+  for (size_t i = 0; i < ops.size(); i++) {
+    FusedElementwiseStep& step = steps_[static_cast<int32_t>(i)];
+    step.operand = static_cast<int>(operands[i]);
+    step.operand_first = operand_first[i] != 0;
+
+    if (ops[i] == "Add") {
+      step.op = FusedElementwiseOp::Add;
+    } else if (ops[i] == "Sub") {
+      step.op = FusedElementwiseOp::Sub;
+    } else if (ops[i] == "Mul") {
+      step.op = FusedElementwiseOp::Mul;
+    } else if (ops[i] == "Div") {
+      step.op = FusedElementwiseOp::Div;
+    } else if (ops[i] == "Relu") {
+      step.op = FusedElementwiseOp::Relu;
+    } else if (ops[i] == "Sigmoid") {
+      step.op = FusedElementwiseOp::Sigmoid;
+    } else if (ops[i] == "Tanh") {
+      step.op = FusedElementwiseOp::Tanh;
+    } else {
+      ORT_THROW("FusedElementwise: unsupported operation ", ops[i]);
+    }
+
+    const bool is_binary = ops[i] == "Add" || ops[i] == "Sub" || ops[i] == "Mul" || ops[i] == "Div";
+    if (is_binary) {
+      ORT_ENFORCE(operands[i] >= 0 && operands[i] < input_count, "FusedElementwise: invalid operand ", operands[i]);
+    } else {
+      ORT_ENFORCE(operands[i] == -1, "FusedElementwise: ", ops[i], " takes no operand");
+    }
+  }
+}
+
+template <typename T>
+Status FusedElementwise<T>::ComputeInternal(OpKernelContext* context) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor* X = context->Input<Tensor>(0);
+  const TensorShape& shape = X->Shape();
+  const size_t count = static_cast<size_t>(shape.Size());
+
+  // The operands either have the shape of the input or are broadcast from a single element.
+  const int input_count = context->InputCount();
+  FusedElementwiseInputs<CudaT> inputs(input_count);
+  FusedElementwiseScalars input_is_scalar(input_count);
+  for (int i = 0; i < input_count; i++) {
+    const Tensor* operand = context->Input<Tensor>(i);
+    const size_t operand_count = static_cast<size_t>(operand->Shape().Size());
+    ORT_RETURN_IF_NOT(operand_count == count || operand_count == 1,
+                      "FusedElementwise: input ", i, " with shape ", operand->Shape(),
+                      " must have the shape of input 0 ", shape, " or a single element");
+    inputs[i] = reinterpret_cast<const CudaT*>(operand->Data<T>());
+    input_is_scalar[i] = operand_count == 1 && count != 1;
+  }
+
+  Tensor* Y = context->Output(0, shape);
+
+  return LaunchFusedElementwiseKernel<CudaT>(Stream(), reinterpret_cast<CudaT*>(Y->MutableData<T>()), inputs,
+                                             input_is_scalar, steps_, count);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/cuda/cuda_kernel.h"
+#include "fused_elementwise_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+// Runs a chain of element-wise operations in one kernel, reading the tensor and writing the result once instead of
+// once per operation.
+template <typename T>
+class FusedElementwise final : public CudaKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  FusedElementwiseSteps steps_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "fused_elementwise_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kElementsPerThread = 4;
+constexpr int kThreadsPerBlock = GridDim::maxThreadsPerBlock;
+
+template <typename T>
+__device__ __forceinline__ float LoadInput(const T* input, bool is_scalar, CUDA_LONG index) {
+  return static_cast<float>(input[is_scalar ? 0 : index]);
+}
+
+// The operations of the chain are the same for every thread, so the switch does not diverge.
+template <typename T>
+__device__ __forceinline__ float RunChain(const FusedElementwiseInputs<T>& inputs,
+                                          const FusedElementwiseScalars& input_is_scalar,
+                                          const FusedElementwiseSteps& steps,
+                                          CUDA_LONG index) {
+  float value = LoadInput(inputs[0], input_is_scalar[0], index);
+
+  for (int i = 0; i < steps.Size(); i++) {
+    const FusedElementwiseStep& step = steps[i];
+    float a = value;
+    float b = 0.0f;
+    if (step.operand >= 0) {
+      b = LoadInput(inputs[step.operand], input_is_scalar[step.operand], index);
+      if (step.operand_first) {
+        a = b;
+        b = value;
+      }
+    }
+
+    switch (step.op) {
+      case FusedElementwiseOp::Add:
+        value = a + b;
+        break;
+      case FusedElementwiseOp::Sub:
+        value = a - b;
+        break;
+      case FusedElementwiseOp::Mul:
+        value = a * b;
+        break;
+      case FusedElementwiseOp::Div:
+        value = a / b;
+        break;
+      case FusedElementwiseOp::Relu:
+        value = fmaxf(a, 0.0f);
+        break;
+      case FusedElementwiseOp::Sigmoid:
+        value = 1.0f / (1.0f + expf(-a));
+        break;
+      case FusedElementwiseOp::Tanh:
+        value = tanhf(a);
+        break;
+    }
+  }
+
+  return value;
+}
+
+template <typename T>
+__global__ void FusedElementwiseKernel(T* output,
+                                       const FusedElementwiseInputs<T> inputs,
+                                       const FusedElementwiseScalars input_is_scalar,
+                                       const FusedElementwiseSteps steps,
+                                       CUDA_LONG count) {
+  CUDA_LONG start = kElementsPerThread * kThreadsPerBlock * blockIdx.x + threadIdx.x;
+
+#pragma unroll
+  for (int i = 0; i < kElementsPerThread; i++) {
+    const CUDA_LONG index = start + i * kThreadsPerBlock;
+    if (index < count) {
+      output[index] = static_cast<T>(RunChain(inputs, input_is_scalar, steps, index));
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+Status LaunchFusedElementwiseKernel(
+    cudaStream_t stream,
+    T* output,
+    const FusedElementwiseInputs<T>& inputs,
+    const FusedElementwiseScalars& input_is_scalar,
+    const FusedElementwiseSteps& steps,
+    size_t count) {
+  if (count == 0) {
+    return Status::OK();
+  }
+
+  const int blocks = static_cast<int>(CeilDiv(count, static_cast<size_t>(kElementsPerThread * kThreadsPerBlock)));
+  FusedElementwiseKernel<T><<<blocks, kThreadsPerBlock, 0, stream>>>(
+      output, inputs, input_is_scalar, steps, static_cast<CUDA_LONG>(count));
+
+  return CUDA_CALL(cudaPeekAtLastError());
+}
+
+template Status LaunchFusedElementwiseKernel<float>(cudaStream_t, float*, const FusedElementwiseInputs<float>&,
+                                                    const FusedElementwiseScalars&, const FusedElementwiseSteps&,
+                                                    size_t);
+template Status LaunchFusedElementwiseKernel<half>(cudaStream_t, half*, const FusedElementwiseInputs<half>&,
+                                                   const FusedElementwiseScalars&, const FusedElementwiseSteps&,
+                                                   size_t);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
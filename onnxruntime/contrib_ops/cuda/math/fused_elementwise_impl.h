@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The longest chain run by one launch, the operations and operand pointers are passed as kernel arguments.
+constexpr int kMaxFusedElementwiseSteps = 16;
+
+enum class FusedElementwiseOp : int {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Relu,
+  Sigmoid,
+  Tanh,
+};
+
+struct FusedElementwiseStep {
+  FusedElementwiseOp op;
+  int operand;  // -1 for unary operations
+  bool operand_first;
+};
+
+using FusedElementwiseSteps = onnxruntime::cuda::TArray<FusedElementwiseStep, kMaxFusedElementwiseSteps>;
+
+// The input of the chain and the other operands, followed by whether each of them is a single broadcast element.
+template <typename T>
+using FusedElementwiseInputs = onnxruntime::cuda::TArray<const T*, kMaxFusedElementwiseSteps + 1>;
+using FusedElementwiseScalars = onnxruntime::cuda::TArray<bool, kMaxFusedElementwiseSteps + 1>;
+
+// Runs the chain on count elements, with the intermediate values kept in registers in single precision.
+template <typename T>
+Status LaunchFusedElementwiseKernel(
+    cudaStream_t stream,
+    T* output,
+    const FusedElementwiseInputs<T>& inputs,
+    const FusedElementwiseScalars& input_is_scalar,
+    const FusedElementwiseSteps& steps,
+    size_t count);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
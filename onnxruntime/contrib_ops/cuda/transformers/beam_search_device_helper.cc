@@ -1,12 +1,12 @@
 #include "core/providers/shared_library/provider_api.h"
 #include "core/providers/cuda/math/topk_impl.h"
-#include "core/providers/cuda/math/softmax.h"
 #include "core/providers/cuda/shared_inc/accumulation_type.h"
 #include "core/framework/ort_value.h"
 #include "contrib_ops/cuda/bert/transformer_cuda_common.h"
 #include "beam_search_impl.h"
 #include <cuda_runtime.h>
 #include "dump_cuda_tensor.h"
+#include "contrib_ops/cpu/transformers/sampling.h"
 
 #ifdef DEBUG_BEAM_SEARCH
 using namespace onnxruntime::contrib::cuda::transformers;
@@ -191,6 +191,7 @@ Status ProcessLogits(const OrtValue& logits,                                 //
                      void* stream,                                           // cuda stream (for CUDA only)
                      const transformers::IConsoleDumper* dumper) {           // tensor dumper
 
+  ORT_UNUSED_PARAMETER(thread_pool);
   ORT_UNUSED_PARAMETER(logits_processors);
 
 #ifndef DEBUG_BEAM_SEARCH
@@ -215,38 +216,8 @@ Status ProcessLogits(const OrtValue& logits,                                 //
 
   cudaStream_t cuda_stream = reinterpret_cast<cudaStream_t>(stream);
 
-  // Get logits for the last token:
-  //    next_token_logits = logits[:, -1, :], and the result shape is (batch_size * num_beams, vocab_size)
-  // When input_length == 1, use logits directly in SoftmaxCPU below so it only need for input_length > 1.
-  gsl::span<T>& next_token_logits = beam_state->next_token_logits;
-  if (input_length > 1) {
-    // TODO: use one kernel to replace a loop of memory copy.
-    const CudaT* current_logits = logits_data + (input_length - 1) * vocab_size;
-    for (int i = 0; i < batch_beam_size; i++) {
-      gsl::span<const T> source(reinterpret_cast<const T*>(current_logits), vocab_size);
-      gsl::span<T> target = next_token_logits.subspan(i * vocab_size, vocab_size);
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(target.data(), source.data(), sizeof(T) * vocab_size, cudaMemcpyDeviceToDevice, cuda_stream));
-      current_logits += input_length * vocab_size;
-    }
-  }
-
 #ifdef DEBUG_BEAM_SEARCH
   dumper->Print("logits", logits);
-  dumper->Print("next_token_logits", next_token_logits.data(), batch_size, num_beams, vocab_size);
-#endif
-
-  // Get scores for candidates of next token: next_token_scores = log_softmax(next_token_logits, dim=-1)
-  gsl::span<float>& next_token_scores = beam_state->next_token_scores;
-
-  // The output will be float for consideration of precision and easy integration with remaining parts.
-  float* Y_data = next_token_scores.data();
-  const CudaT* X_data = input_length > 1 ? reinterpret_cast<const CudaT*>(next_token_logits.data()) : logits_data;
-
-  dispatch_blockwise_softmax_forward<CudaT, float, float, true>(
-      cuda_stream, Y_data, X_data, vocab_size, vocab_size, batch_size * num_beams);
-
-#ifdef DEBUG_BEAM_SEARCH
-  dumper->Print("next_token_scores after softmax", next_token_scores.data(), batch_size, num_beams, vocab_size);
 #endif
 
   // Sequences generated by beam scorer is currently stored in CPU.
@@ -261,13 +232,22 @@ Status ProcessLogits(const OrtValue& logits,                                 //
     CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(sequences_buffer.get(), sequences->GetSequence(0).data(), bytes, cudaMemcpyHostToDevice, cuda_stream));
   }
 
-  cuda::LaunchLogitsProcessKernel<float>(
+  // Get scores for candidates of next token with one kernel that reads the logits of the last token in place:
+  //    next_token_logits = logits[:, -1, :]
+  //    next_token_scores = log_softmax(next_token_logits, dim=-1), processed by the logits processors
+  //    next_token_scores = next_token_scores + beam_scores[:, None].expand_as(next_token_scores)
+  // The output will be float for consideration of precision and easy integration with remaining parts.
+  gsl::span<float>& next_token_scores = beam_state->next_token_scores;
+  cuda::LaunchLogSoftmaxScoresKernel<CudaT>(
       next_token_scores.data(),
+      logits_data,
+      static_cast<int>(input_length),
+      beam_state->beam_scores.data(),
       parameters->vocab_mask.data(),
       step > 1 ? nullptr : parameters->prefix_vocab_mask.data(),  // prefix vocab mask is applied to first step only.
-      parameters->batch_size,
-      parameters->num_beams,
-      parameters->vocab_size,
+      batch_size,
+      num_beams,
+      vocab_size,
       (parameters->min_length > 0 && current_sequence_length < parameters->min_length) ? parameters->eos_token_id : -1,
       reinterpret_cast<int32_t*>(sequences_buffer.get()),
       parameters->max_length,
@@ -276,14 +256,6 @@ Status ProcessLogits(const OrtValue& logits,                                 //
       parameters->no_repeat_ngram_size,
       cuda_stream);
 
-#ifdef DEBUG_BEAM_SEARCH
-  dumper->Print("next_token_scores after logits processor", next_token_scores.data(), batch_size, num_beams, vocab_size);
-#endif
-
-  // Add beam score to next token scores. Corresponding python code is like:
-  //    next_token_scores = next_token_scores + beam_scores[:, None].expand_as(next_token_scores)
-  cuda::LaunchAddProbsKernel(next_token_scores.data(), beam_state->beam_scores.data(), batch_size, num_beams, vocab_size, cuda_stream);
-
 #ifdef DEBUG_BEAM_SEARCH
   dumper->Print("next_token_scores after adding beam_scores", next_token_scores.data(), batch_size, num_beams, vocab_size);
 #endif
@@ -297,47 +269,32 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   // Apply top-k selection like the following:
   //   next_token_scores = next_token_scores.view(batch_size, num_beams * vocab_size)
   //   next_token_scores, next_tokens = torch.topk(next_token_scores, 2 * num_beams, dim=1, largest=True, sorted=True)
-  int64_t next_token_scores_dims[] = {batch_size, num_beams * vocab_size};
-  TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
-  auto element_type = DataTypeImpl::GetType<float>();
-  OrtValue next_token_scores_value;
-  Tensor::InitOrtValue(element_type, next_token_scores_shape, next_token_scores.data(), allocator->Info(), next_token_scores_value);
-  const Tensor& input = next_token_scores_value.Get<Tensor>();
-
-  constexpr int axis = 1;
-  const unsigned top_k = static_cast<unsigned>(2 * num_beams);
-  constexpr bool largest = true;
-  constexpr bool sorted = true;  // results returned in sorted order.
-
-  std::unique_ptr<Tensor> topk_scores;
-  std::unique_ptr<Tensor> topk_indices;
-  ORT_RETURN_IF_ERROR(TopK(&input, axis, top_k, largest, sorted, allocator, stream, thread_pool, topk_scores, topk_indices));
-
-#ifdef DEBUG_BEAM_SEARCH
-  dumper->Print("topk_scores", *(topk_scores.get()));
-  dumper->Print("topk_indices", *(topk_indices.get()));
-#endif
-
-  // Convert indices in range [0, num_beams * vocab_size) to token ID of range [0, vocab_size) like the following:
   //   next_indices = (next_tokens / vocab_size).long()
   //   next_tokens = next_tokens % vocab_size
-  const int64_t* next_token_indices = topk_indices->Data<int64_t>();
-  cuda::LaunchNextTokenKernel(next_token_indices, beam_state->next_indices.data(), beam_state->next_tokens.data(), batch_size, top_k, vocab_size, cuda_stream);
-
-  const float* data = topk_scores->Data<float>();
+  // Only these 2 * num_beams candidates of each batch are copied to CPU for the beam scorer.
+  const int top_k = 2 * num_beams;
+  const size_t topk_scores_bytes = SafeInt<size_t>(sizeof(float)) * batch_size * top_k;
+  void* topk_data = allocator->Alloc(topk_scores_bytes + cuda::GetBeamTopKBufferSize(batch_beam_size, top_k));
+  BufferUniquePtr topk_buffer(topk_data, BufferDeleter(allocator));
+  float* topk_scores = reinterpret_cast<float*>(topk_data);
+
+  cuda::LaunchBeamTopKKernel(next_token_scores.data(), batch_size, num_beams, vocab_size, top_k,
+                             reinterpret_cast<char*>(topk_data) + topk_scores_bytes,
+                             topk_scores, beam_state->next_tokens.data(), beam_state->next_indices.data(),
+                             cuda_stream);
 
 #ifdef DEBUG_BEAM_SEARCH
-  dumper->Print("next_scores before scorer", data, batch_size, top_k);
+  dumper->Print("next_scores before scorer", topk_scores, batch_size, top_k);
   dumper->Print("next_tokens before scorer", beam_state->next_tokens.data(), batch_size, top_k);
   dumper->Print("next_indices before scorer", beam_state->next_indices.data(), batch_size, top_k);
 #endif
 
-  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(cpu_state->topk_scores.data(), data, topk_scores->Shape().Size() * sizeof(float), cudaMemcpyDeviceToHost, cuda_stream));
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(cpu_state->topk_scores.data(), topk_scores, topk_scores_bytes, cudaMemcpyDeviceToHost, cuda_stream));
   CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(cpu_state->topk_tokens.data(), beam_state->next_tokens.data(), beam_state->next_tokens.size_bytes(), cudaMemcpyDeviceToHost, cuda_stream));
   CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(cpu_state->topk_indices.data(), beam_state->next_indices.data(), beam_state->next_indices.size_bytes(), cudaMemcpyDeviceToHost, cuda_stream));
   CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
 
-  gsl::span<const float> next_scores = gsl::make_span(cpu_state->topk_scores.data(), static_cast<typename gsl::span<float>::index_type>(topk_scores->Shape().Size()));
+  gsl::span<const float> next_scores = gsl::make_span(cpu_state->topk_scores.data(), static_cast<typename gsl::span<float>::index_type>(batch_size) * top_k);
   gsl::span<const int32_t> next_tokens(cpu_state->topk_tokens.data(), beam_state->next_tokens.size());
   gsl::span<const int32_t> next_indices(cpu_state->topk_indices.data(), beam_state->next_indices.size());
 
@@ -366,36 +323,59 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, void* stream,
 template <typename T>
 Status PickPastState(const std::vector<OrtValue>& last_outputs,
                      std::vector<OrtValue>& next_inputs,
+                     int current_length,
                      gsl::span<const int32_t>& beam_indices,
                      AllocatorPtr allocator,
                      void* stream) {
+  // Reorder the present state in place and feed it as past state. See InPlaceBeamReorder for details.
+  transformers::InPlaceBeamReorder reorder(beam_indices);
+  cudaStream_t cuda_stream = reinterpret_cast<cudaStream_t>(stream);
+
+  BufferUniquePtr scratch_buffer;
+  T* scratch = nullptr;
   for (size_t i = 1; i < last_outputs.size(); ++i) {
-    const OrtValue& present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
-
-    // Create a tensor with same shape.
-    // TODO: allocate one buffer for all layers, and use a CUDA kernel to copy key/value cache data.
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
-    auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
-    auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), past_shape.Size());
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), past_shape.Size());
-    for (gsl::index j = 0; j < beam_indices.length(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * block_size_per_beam, block_size_per_beam);
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * block_size_per_beam, block_size_per_beam);
-
-      gsl::span<T> past_key = past_span.subspan(j * block_size_per_beam, block_size_per_beam);
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * block_size_per_beam, block_size_per_beam);
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(past_key.data(), present_key.data(), present_key.size_bytes(), cudaMemcpyDeviceToDevice, reinterpret_cast<cudaStream_t>(stream)));
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(past_value.data(), present_value.data(), present_value.size_bytes(), cudaMemcpyDeviceToDevice, reinterpret_cast<cudaStream_t>(stream)));
+    OrtValue present = last_outputs[i];  // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
+    if (!reorder.IsIdentity()) {
+      const TensorShape& past_shape = present.Get<Tensor>().Shape();
+      size_t block_size_per_beam = SafeInt<size_t>(past_shape[2]) * past_shape[3] * past_shape[4];
+
+      // A present state that shares the buffer of the past state is allocated for max_length, and only its first
+      // current_length - 1 positions of each head are valid, so the copies skip the rest of each head.
+      const size_t head_elements = SafeInt<size_t>(past_shape[3]) * past_shape[4];
+      const size_t valid_head_elements = SafeInt<size_t>(std::min<int64_t>(past_shape[3], current_length - 1)) *
+                                         past_shape[4];
+
+      // All layers have the same shape, so the scratch buffer is allocated once.
+      if (scratch_buffer == nullptr && reorder.ScratchSize(block_size_per_beam) > 0) {
+        void* data = allocator->Alloc(SafeInt<size_t>(sizeof(T)) * reorder.ScratchSize(block_size_per_beam));
+        scratch_buffer = BufferUniquePtr(data, BufferDeleter(allocator));
+        scratch = reinterpret_cast<T*>(data);
+      }
+
+      ORT_RETURN_IF_ERROR(reorder.Apply(present.GetMutable<Tensor>()->MutableData<T>(), block_size_per_beam, scratch,
+                                        [cuda_stream, head_elements, valid_head_elements](T* target, const T* source,
+                                                                                          size_t elements) {
+                                          if (valid_head_elements == head_elements) {
+                                            CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(target, source, elements * sizeof(T),
+                                                                                 cudaMemcpyDeviceToDevice, cuda_stream));
+                                          } else {
+                                            CUDA_RETURN_IF_ERROR(cudaMemcpy2DAsync(target, head_elements * sizeof(T),
+                                                                                   source, head_elements * sizeof(T),
+                                                                                   valid_head_elements * sizeof(T),
+                                                                                   elements / head_elements,
+                                                                                   cudaMemcpyDeviceToDevice,
+                                                                                   cuda_stream));
+                                          }
+                                          return Status::OK();
+                                        }));
     }
 
-    next_inputs[i + 2] = past;
+    next_inputs[i + 2] = present;
+  }
+
+  // The scratch buffer is released when this function returns, so wait for the copies from it.
+  if (scratch_buffer != nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
   }
 
   return Status::OK();
@@ -458,7 +438,7 @@ Status UpdateFeeds(
       next_inputs[i + 2] = last_outputs[i];
     }
   } else {
-    ORT_RETURN_IF_ERROR(PickPastState<T>(last_outputs, next_inputs, beam_indices, allocator, stream));
+    ORT_RETURN_IF_ERROR(PickPastState<T>(last_outputs, next_inputs, current_length, beam_indices, allocator, stream));
   }
 
   // Make sure data is ready before next subgraph execution.
@@ -466,6 +446,143 @@ Status UpdateFeeds(
   return Status::OK();
 }
 
+template <typename T>
+void InitGreedyState(transformers::IGreedySearchState<T>* greedy_state,
+                     gsl::span<int32_t>& sequence_lengths,
+                     void* stream) {
+  cudaStream_t cuda_stream = reinterpret_cast<cudaStream_t>(stream);
+  cudaMemsetAsync(greedy_state->next_token_logits.data(), 0, greedy_state->next_token_logits.size_bytes(), cuda_stream);
+  cudaMemsetAsync(greedy_state->next_token_scores.data(), 0, greedy_state->next_token_scores.size_bytes(), cuda_stream);
+  memset(greedy_state->next_tokens.data(), 0, greedy_state->next_tokens.size_bytes());
+
+  // copy sequence lengths to GPU
+  // since next_positions is only needed to update feeds after subgraph execution, so it is fine to use Async here.
+  cudaMemcpyAsync(greedy_state->next_positions.data(), sequence_lengths.data(), sequence_lengths.size_bytes(), cudaMemcpyHostToDevice, cuda_stream);
+}
+
+template <typename T>
+Status GreedySearchProcessLogits(const OrtValue& logits,                                   // logits output of subgraph
+                                 transformers::IGreedySearchState<T>* greedy_state,        // state
+                                 transformers::ISequences* sequences,                      // sequences
+                                 AllocatorPtr& allocator,                                  // default allocator
+                                 onnxruntime::concurrency::ThreadPool* thread_pool,        // thread pool (for CPU only)
+                                 transformers::ILogitsProcessorList* logits_processors,    // logits processors
+                                 const transformers::IGreedySearchParameters* parameters,  // parameters
+                                 std::default_random_engine& generator,                    // random number generator
+                                 int step,                                                 // iteration counter
+                                 void* stream,                                             // cuda stream (for CUDA only)
+                                 const transformers::IConsoleDumper* dumper) {             // tensor dumper
+  ORT_UNUSED_PARAMETER(logits_processors);
+
+#ifndef DEBUG_BEAM_SEARCH
+  ORT_UNUSED_PARAMETER(dumper);
+#endif
+
+  int batch_size = parameters->batch_size;
+  int vocab_size = parameters->vocab_size;
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  const CudaT* logits_data = reinterpret_cast<const CudaT*>(logits.Get<Tensor>().Data<T>());
+
+  // Logits has shape (batch_size, input_length, vocab_size),
+  // where input_length equals to parameters_->sequence_length for first subgraph call, and 1 for the remaining calls.
+  const TensorShape& logits_shape = logits.Get<Tensor>().Shape();
+  ORT_ENFORCE(logits_shape.NumDimensions() == 3);
+  auto input_length = logits_shape[1];
+
+  cudaStream_t cuda_stream = reinterpret_cast<cudaStream_t>(stream);
+
+  // Copy sequences to device only when repetition penalty or no repeat ngram is used in kernel
+  BufferUniquePtr sequences_buffer;
+  int current_sequence_length = sequences->GetSequenceLength();
+  if (parameters->repetition_penalty != 1.0f || (parameters->no_repeat_ngram_size > 0 && current_sequence_length >= parameters->no_repeat_ngram_size)) {
+    size_t bytes = SafeInt<size_t>(sizeof(int32_t)) * batch_size * parameters->max_length;
+    void* data = allocator->Alloc(bytes);
+    BufferUniquePtr temp_buffer(data, BufferDeleter(allocator));
+    sequences_buffer = std::move(temp_buffer);
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(sequences_buffer.get(), sequences->GetSequence(0).data(), bytes, cudaMemcpyHostToDevice, cuda_stream));
+  }
+
+  // Get scores for candidates of next token with the logits processors applied:
+  //    next_token_scores = log_softmax(logits[:, -1, :], dim=-1)
+  gsl::span<float>& next_token_scores = greedy_state->next_token_scores;
+  cuda::LaunchLogSoftmaxScoresKernel<CudaT>(
+      next_token_scores.data(),
+      logits_data,
+      static_cast<int>(input_length),
+      nullptr,  // beam_scores
+      parameters->vocab_mask.data(),
+      step > 1 ? nullptr : parameters->prefix_vocab_mask.data(),  // prefix vocab mask is applied to first step only.
+      batch_size,
+      1,  // num_beams
+      vocab_size,
+      (parameters->min_length > 0 && current_sequence_length < parameters->min_length) ? parameters->eos_token_id : -1,
+      reinterpret_cast<int32_t*>(sequences_buffer.get()),
+      parameters->max_length,
+      current_sequence_length,
+      parameters->repetition_penalty,
+      parameters->no_repeat_ngram_size,
+      cuda_stream);
+
+#ifdef DEBUG_BEAM_SEARCH
+  dumper->Print("next_token_scores after logits processor", next_token_scores.data(), batch_size, 1, vocab_size);
+#endif
+
+  transformers::TokenSampler sampler(*parameters);
+  gsl::span<int32_t>& next_tokens = greedy_state->next_tokens;
+
+  // TopK is called without a kernel for scratch buffers, which limits k to 16 * GridDim::maxThreadsPerBlock.
+  constexpr int max_top_k = 4096;
+  if (parameters->do_sample && (parameters->top_k <= 0 || parameters->top_k > max_top_k)) {
+    // Sampling without top-k needs the whole distribution, which is sampled in CPU.
+    gsl::span<float>& scores_in_cpu = greedy_state->next_token_scores_in_cpu;
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(scores_in_cpu.data(), next_token_scores.data(), next_token_scores.size_bytes(), cudaMemcpyDeviceToHost, cuda_stream));
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
+    for (int i = 0; i < batch_size; i++) {
+      gsl::span<const float> scores(scores_in_cpu.data() + SafeInt<gsl::index>(i) * vocab_size, vocab_size);
+      next_tokens[i] = sampler.Select(scores, generator);
+    }
+    return Status::OK();
+  }
+
+  // Otherwise only the top-k candidates (k = 1 without sampling) are copied to CPU:
+  //   next_token_scores, next_tokens = torch.topk(next_token_scores, top_k, dim=1, largest=True, sorted=True)
+  int64_t next_token_scores_dims[] = {batch_size, vocab_size};
+  TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
+  auto element_type = DataTypeImpl::GetType<float>();
+  OrtValue next_token_scores_value;
+  Tensor::InitOrtValue(element_type, next_token_scores_shape, next_token_scores.data(), allocator->Info(), next_token_scores_value);
+  const Tensor& input = next_token_scores_value.Get<Tensor>();
+
+  constexpr int axis = 1;
+  const unsigned top_k = parameters->do_sample ? static_cast<unsigned>(std::min(parameters->top_k, vocab_size)) : 1;
+  constexpr bool largest = true;
+  constexpr bool sorted = true;  // results returned in sorted order.
+
+  std::unique_ptr<Tensor> topk_scores;
+  std::unique_ptr<Tensor> topk_indices;
+  ORT_RETURN_IF_ERROR(TopK(&input, axis, top_k, largest, sorted, allocator, stream, thread_pool, topk_scores, topk_indices));
+
+  const size_t topk_size = SafeInt<size_t>(batch_size) * top_k;
+  std::vector<float> topk_scores_in_cpu(topk_size);
+  std::vector<int64_t> topk_indices_in_cpu(topk_size);
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(topk_scores_in_cpu.data(), topk_scores->Data<float>(), topk_size * sizeof(float), cudaMemcpyDeviceToHost, cuda_stream));
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(topk_indices_in_cpu.data(), topk_indices->Data<int64_t>(), topk_size * sizeof(int64_t), cudaMemcpyDeviceToHost, cuda_stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(cuda_stream));
+
+  std::vector<int32_t> token_ids(top_k);
+  for (int i = 0; i < batch_size; i++) {
+    const size_t offset = SafeInt<size_t>(i) * top_k;
+    for (unsigned j = 0; j < top_k; j++) {
+      token_ids[j] = static_cast<int32_t>(topk_indices_in_cpu[offset + j]);
+    }
+    gsl::span<const float> scores(topk_scores_in_cpu.data() + offset, top_k);
+    next_tokens[i] = sampler.SelectFromTopK(scores, token_ids, generator);
+  }
+
+  return Status::OK();
+}
+
 // Explicit template instantiations of functions
 template void InitBeamState<float>(transformers::IBeamSearchState<float>* beam_state,
                                    transformers::IBeamSearchCpuState* cpu_state,
@@ -508,6 +625,22 @@ template Status UpdateFeeds<float>(
     int num_beams,
     const transformers::IConsoleDumper* dumper);
 
+template void InitGreedyState<float>(transformers::IGreedySearchState<float>* greedy_state,
+                                     gsl::span<int32_t>& sequence_lengths,
+                                     void* stream);
+
+template Status GreedySearchProcessLogits<float>(const OrtValue& logits,
+                                                 transformers::IGreedySearchState<float>* greedy_state,
+                                                 transformers::ISequences* sequences,
+                                                 AllocatorPtr& allocator,
+                                                 onnxruntime::concurrency::ThreadPool* thread_pool,
+                                                 transformers::ILogitsProcessorList* logits_processors,
+                                                 const transformers::IGreedySearchParameters* parameters,
+                                                 std::default_random_engine& generator,
+                                                 int step,
+                                                 void* stream,
+                                                 const transformers::IConsoleDumper* dumper);
+
 // Float16
 template void InitBeamState<MLFloat16>(transformers::IBeamSearchState<MLFloat16>* beam_state,
                                        transformers::IBeamSearchCpuState* cpu_state,
@@ -544,6 +677,22 @@ template Status UpdateFeeds<MLFloat16>(
     int num_beams,
     const transformers::IConsoleDumper* dumper);
 
+template void InitGreedyState<MLFloat16>(transformers::IGreedySearchState<MLFloat16>* greedy_state,
+                                         gsl::span<int32_t>& sequence_lengths,
+                                         void* stream);
+
+template Status GreedySearchProcessLogits<MLFloat16>(const OrtValue& logits,
+                                                     transformers::IGreedySearchState<MLFloat16>* greedy_state,
+                                                     transformers::ISequences* sequences,
+                                                     AllocatorPtr& allocator,
+                                                     onnxruntime::concurrency::ThreadPool* thread_pool,
+                                                     transformers::ILogitsProcessorList* logits_processors,
+                                                     const transformers::IGreedySearchParameters* parameters,
+                                                     std::default_random_engine& generator,
+                                                     int step,
+                                                     void* stream,
+                                                     const transformers::IConsoleDumper* dumper);
+
 }  // namespace BeamSearchCudaDeviceHelper
 }  // namespace contrib
 }  // namespace onnxruntime
\ No newline at end of file
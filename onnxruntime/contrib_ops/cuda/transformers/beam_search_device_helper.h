@@ -4,6 +4,7 @@
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/cuda/cuda_common.h"
 
+#include <random>
 #include "gsl/gsl"
 #include "contrib_ops/cpu/transformers/beam_search_shared.h"
 
@@ -76,6 +77,24 @@ Status UpdateFeeds(
     int num_beams,
     const transformers::IConsoleDumper* dumper);
 
+template <typename T>
+void InitGreedyState(transformers::IGreedySearchState<T>* greedy_state,
+                     gsl::span<int32_t>& sequence_lengths,
+                     void* stream);
+
+template <typename T>
+Status GreedySearchProcessLogits(const OrtValue& logits,                                   // logits output of subgraph
+                                 transformers::IGreedySearchState<T>* greedy_state,        // state
+                                 transformers::ISequences* sequences,                      // sequences
+                                 AllocatorPtr& allocator,                                  // default allocator
+                                 onnxruntime::concurrency::ThreadPool* thread_pool,        // thread pool (for CPU only)
+                                 transformers::ILogitsProcessorList* logits_processors,    // logits processors
+                                 const transformers::IGreedySearchParameters* parameters,  // parameters
+                                 std::default_random_engine& generator,                    // random number generator
+                                 int step,                                                 // iteration counter
+                                 void* stream,                                             // cuda stream (for CUDA only)
+                                 const transformers::IConsoleDumper* dumper);              // tensor dumper
+
 }  // namespace BeamSearchCudaDeviceHelper
 }  // namespace contrib
 }  // namespace onnxruntime
\ No newline at end of file
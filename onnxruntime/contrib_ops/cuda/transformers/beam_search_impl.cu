@@ -4,7 +4,8 @@
 #include "beam_search_impl.h"
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
-#include "cub/util_type.cuh"
+#include <algorithm>
+#include <cub/cub.cuh>
 
 namespace onnxruntime {
 namespace contrib {
@@ -30,195 +31,343 @@ void LaunchInitKernel(
   InitKernel<<<gridSize, blockSize, 0, stream>>>(beam_scores, num_beams, total_elements);
 }
 
-__global__ void NextTokenKernel(const int64_t* next_token_indices,
-                                int32_t* next_indices,
-                                int32_t* next_tokens,
-                                int vocab_size,
-                                int total_elements) {
-  int index = blockIdx.x * blockDim.x + threadIdx.x;
-  if (index < total_elements) {
-    next_indices[index] = next_token_indices[index] / vocab_size;
-    next_tokens[index] = next_token_indices[index] % vocab_size;
-  }
-}
-
-void LaunchNextTokenKernel(const int64_t* next_token_indices,
-                           int32_t* next_indices,
-                           int32_t* next_tokens,
-                           int batch_size,
-                           int top_k,
-                           int vocab_size,
-                           cudaStream_t stream) {
-  int total_elements = batch_size * top_k;
-  constexpr int blockSize = 256;
-  const int gridSize = (total_elements + blockSize - 1) / blockSize;
-  NextTokenKernel<<<gridSize, blockSize, 0, stream>>>(next_token_indices, next_indices, next_tokens, vocab_size, total_elements);
-}
-
-template <typename T>
-__global__ void LogitsProcessKernel(
-    T* next_token_scores,
+// Applies the logits processors to the score of one word of one beam, and returns the processed score.
+__device__ inline float ProcessLogit(
+    float score,
+    int batch_beam_index,
+    int word_id,
     const int* vocab_mask,
     const int* prefix_vocab_mask,
     int num_beams,
     int vocab_size,
-    int total_elements,
     int demote_token_id,
-    int32_t* sequences,
+    const int32_t* sequences,
     int max_sequence_length,
     int current_sequence_length,
     float repetition_penalty,
     int no_repeat_ngram_size) {
-  int index = blockIdx.x * blockDim.x + threadIdx.x;
-  if (index < total_elements) {
-    int batch_beam_index = index / vocab_size;
-    int word_id = index % vocab_size;
-
-    // RepetitionPenaltyLogitsProcessor
-    if (repetition_penalty != 1.0f) {
-      int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
-      bool found = false;
-      for (int i = 0; i < current_sequence_length; i++) {
-        if (current_sequence[i] == word_id) {
-          found = true;
-          break;
-        }
-      }
-      if (found) {
-        float score = (float)next_token_scores[index];
-        next_token_scores[index] = (T)(score < 0 ? score * repetition_penalty : score / repetition_penalty);
+  // RepetitionPenaltyLogitsProcessor
+  if (repetition_penalty != 1.0f) {
+    const int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
+    bool found = false;
+    for (int i = 0; i < current_sequence_length; i++) {
+      if (current_sequence[i] == word_id) {
+        found = true;
+        break;
       }
     }
+    if (found) {
+      score = score < 0 ? score * repetition_penalty : score / repetition_penalty;
+    }
+  }
 
-    // NoRepeatNGramLogitsProcessor
-    if (no_repeat_ngram_size > 0 && current_sequence_length >= no_repeat_ngram_size) {
-      int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
-      bool found = false;
-      for (int i = no_repeat_ngram_size - 1; i < current_sequence_length; i++) {
-        if (current_sequence[i] == word_id) {  // last token of n-gram matched
-          found = true;
-          for (int j = 0; j < no_repeat_ngram_size - 1; j++) {  // match the remaining N-1 tokens
-            if (current_sequence[i - j - 1] != current_sequence[current_sequence_length - 1 - j]) {
-              found = false;
-              break;
-            }
-          }
-          if (found) {
+  // NoRepeatNGramLogitsProcessor
+  if (no_repeat_ngram_size > 0 && current_sequence_length >= no_repeat_ngram_size) {
+    const int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
+    bool found = false;
+    for (int i = no_repeat_ngram_size - 1; i < current_sequence_length; i++) {
+      if (current_sequence[i] == word_id) {  // last token of n-gram matched
+        found = true;
+        for (int j = 0; j < no_repeat_ngram_size - 1; j++) {  // match the remaining N-1 tokens
+          if (current_sequence[i - j - 1] != current_sequence[current_sequence_length - 1 - j]) {
+            found = false;
             break;
           }
         }
-      }
-
-      if (found) {
-        next_token_scores[index] = cub::FpLimits<T>::Lowest();
-        return;
+        if (found) {
+          break;
+        }
       }
     }
 
-    // VocabMaskLogitsProcessor
-    if (vocab_mask != nullptr && vocab_mask[word_id] == 0) {
-      next_token_scores[index] = cub::FpLimits<T>::Lowest();
-      return;
+    if (found) {
+      return cub::FpLimits<float>::Lowest();
     }
+  }
 
-    // PrefixVocabMaskLogitsProcessor
-    int batch_id = batch_beam_index / num_beams;
-    if (prefix_vocab_mask != nullptr && prefix_vocab_mask[batch_id * vocab_size + word_id] == 0) {
-      next_token_scores[index] = cub::FpLimits<T>::Lowest();
-      return;
-    }
+  // VocabMaskLogitsProcessor
+  if (vocab_mask != nullptr && vocab_mask[word_id] == 0) {
+    return cub::FpLimits<float>::Lowest();
+  }
 
-    // MinLengthLogitsProcessor
-    if (word_id == demote_token_id) {
-      next_token_scores[index] = cub::FpLimits<T>::Lowest();
-    }
+  // PrefixVocabMaskLogitsProcessor
+  int batch_id = batch_beam_index / num_beams;
+  if (prefix_vocab_mask != nullptr && prefix_vocab_mask[batch_id * vocab_size + word_id] == 0) {
+    return cub::FpLimits<float>::Lowest();
+  }
+
+  // MinLengthLogitsProcessor
+  if (word_id == demote_token_id) {
+    return cub::FpLimits<float>::Lowest();
+  }
+
+  return score;
+}
+
+// One block per beam computes the log-softmax of the logits of the last token, applies the logits processors and
+// adds the beam score, so that the logits are read twice and the scores written once.
+template <typename T, int TPB>
+__global__ void LogSoftmaxScoresKernel(
+    float* next_token_scores,
+    const T* logits,
+    int input_length,
+    const float* beam_scores,
+    const int* vocab_mask,
+    const int* prefix_vocab_mask,
+    int num_beams,
+    int vocab_size,
+    int demote_token_id,
+    const int32_t* sequences,
+    int max_sequence_length,
+    int current_sequence_length,
+    float repetition_penalty,
+    int no_repeat_ngram_size) {
+  using BlockReduce = cub::BlockReduce<float, TPB>;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  __shared__ float row_max;
+  __shared__ float row_log_sum;
+
+  const int batch_beam_index = blockIdx.x;
+  const T* row_logits = logits + (static_cast<int64_t>(batch_beam_index) * input_length + input_length - 1) * vocab_size;
+  float* row_scores = next_token_scores + static_cast<int64_t>(batch_beam_index) * vocab_size;
+
+  float thread_max = cub::FpLimits<float>::Lowest();
+  for (int i = threadIdx.x; i < vocab_size; i += TPB) {
+    thread_max = max(thread_max, static_cast<float>(row_logits[i]));
+  }
+  const float block_max = BlockReduce(temp_storage).Reduce(thread_max, cub::Max());
+  if (threadIdx.x == 0) {
+    row_max = block_max;
+  }
+  __syncthreads();
+
+  float thread_sum = 0.0f;
+  for (int i = threadIdx.x; i < vocab_size; i += TPB) {
+    thread_sum += expf(static_cast<float>(row_logits[i]) - row_max);
+  }
+  const float block_sum = BlockReduce(temp_storage).Sum(thread_sum);
+  if (threadIdx.x == 0) {
+    row_log_sum = row_max + logf(block_sum);
+  }
+  __syncthreads();
+
+  const float beam_score = beam_scores != nullptr ? beam_scores[batch_beam_index] : 0.0f;
+  for (int i = threadIdx.x; i < vocab_size; i += TPB) {
+    const float score = ProcessLogit(static_cast<float>(row_logits[i]) - row_log_sum, batch_beam_index, i,
+                                     vocab_mask, prefix_vocab_mask, num_beams, vocab_size, demote_token_id,
+                                     sequences, max_sequence_length, current_sequence_length,
+                                     repetition_penalty, no_repeat_ngram_size);
+    row_scores[i] = score + beam_score;
   }
 }
 
 template <typename T>
-void LaunchLogitsProcessKernel(
-    T* next_token_scores,
+void LaunchLogSoftmaxScoresKernel(
+    float* next_token_scores,
+    const T* logits,
+    int input_length,
+    const float* beam_scores,
     const int* vocab_mask,
     const int* prefix_vocab_mask,
     int batch_size,
     int num_beams,
     int vocab_size,
     int demote_token_id,
-    int32_t* sequences,
+    const int32_t* sequences,
     int max_sequence_length,
     int current_sequence_length,
     float repetition_penalty,
     int no_repeat_ngram_size,
     cudaStream_t stream) {
-  int total_elements = batch_size * num_beams * vocab_size;
   constexpr int blockSize = 256;
-  const int gridSize = (total_elements + blockSize - 1) / blockSize;
-  LogitsProcessKernel<T><<<gridSize, blockSize, 0, stream>>>(next_token_scores, vocab_mask, prefix_vocab_mask, num_beams, vocab_size, total_elements, demote_token_id,
-                                                             sequences, max_sequence_length, current_sequence_length, repetition_penalty, no_repeat_ngram_size);
+  const int gridSize = batch_size * num_beams;
+  LogSoftmaxScoresKernel<T, blockSize><<<gridSize, blockSize, 0, stream>>>(
+      next_token_scores, logits, input_length, beam_scores, vocab_mask, prefix_vocab_mask, num_beams, vocab_size,
+      demote_token_id, sequences, max_sequence_length, current_sequence_length, repetition_penalty,
+      no_repeat_ngram_size);
 }
 
-// Instantiation
-template void LaunchLogitsProcessKernel(
+template void LaunchLogSoftmaxScoresKernel(
     float* next_token_scores,
+    const float* logits,
+    int input_length,
+    const float* beam_scores,
     const int* vocab_mask,
     const int* prefix_vocab_mask,
     int batch_size,
     int num_beams,
     int vocab_size,
     int demote_token_id,
-    int32_t* sequences,
+    const int32_t* sequences,
     int max_sequence_length,
     int current_sequence_length,
     float repetition_penalty,
     int no_repeat_ngram_size,
     cudaStream_t stream);
 
-template void LaunchLogitsProcessKernel(
-    half* next_token_scores,
+template void LaunchLogSoftmaxScoresKernel(
+    float* next_token_scores,
+    const half* logits,
+    int input_length,
+    const float* beam_scores,
     const int* vocab_mask,
     const int* prefix_vocab_mask,
     int batch_size,
     int num_beams,
     int vocab_size,
     int demote_token_id,
-    int32_t* sequences,
+    const int32_t* sequences,
     int max_sequence_length,
     int current_sequence_length,
     float repetition_penalty,
     int no_repeat_ngram_size,
     cudaStream_t stream);
 
-__global__ void AddProbsKernel(float* log_probs,
-                               float* cum_log_probs,
-                               const int vocab_size,
-                               const int total_elements) {
-  int index = blockIdx.x * blockDim.x + threadIdx.x;
-  int batch_beam_index = index / vocab_size;
+// A candidate of the top-k selection. The index is in the range [0, num_beams * vocab_size), or -1 for no candidate.
+struct TopKCandidate {
+  float score;
+  int index;
+};
 
-  if (index < total_elements)
-    log_probs[index] += cum_log_probs[batch_beam_index];
+// Returns true if candidate a ranks before candidate b: a higher score first, and the lower index first on a tie, so
+// that every round of the selection has a unique successor.
+__device__ inline bool Precedes(const TopKCandidate& a, const TopKCandidate& b) {
+  return a.index >= 0 && (b.index < 0 || a.score > b.score || (a.score == b.score && a.index < b.index));
 }
 
-template <typename T>
-void LaunchAddProbsKernel(T* log_probs,
-                          T* cum_log_probs,
-                          const int batch_size,
-                          const int num_beams,
-                          const int vocab_size,
+struct TopKCandidateMax {
+  __device__ inline TopKCandidate operator()(const TopKCandidate& a, const TopKCandidate& b) const {
+    return Precedes(b, a) ? b : a;
+  }
+};
+
+// Selects the k best of count candidates in order with one block. Each round finds the best candidate ranking after
+// the one selected by the previous round, so the candidates are only read and k stays small (2 * num_beams).
+template <int TPB, typename LoadFn, typename StoreFn>
+__device__ void BlockTopK(int count, int k, LoadFn load, StoreFn store) {
+  using BlockReduce = cub::BlockReduce<TopKCandidate, TPB>;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  __shared__ TopKCandidate selected;
+
+  TopKCandidate previous{0.0f, -1};
+  for (int r = 0; r < k; r++) {
+    TopKCandidate best{0.0f, -1};
+    for (int i = threadIdx.x; i < count; i += TPB) {
+      const TopKCandidate candidate = load(i);
+      if ((r == 0 || Precedes(previous, candidate)) && Precedes(candidate, best)) {
+        best = candidate;
+      }
+    }
+
+    best = BlockReduce(temp_storage).Reduce(best, TopKCandidateMax());
+    if (threadIdx.x == 0) {
+      selected = best;
+    }
+    __syncthreads();
+    previous = selected;
+    __syncthreads();
+
+    if (previous.index < 0) {
+      // fewer than k candidates
+      if (threadIdx.x == 0) {
+        for (int j = r; j < k; j++) {
+          store(j, previous);
+        }
+      }
+      return;
+    }
+
+    if (threadIdx.x == 0) {
+      store(r, previous);
+    }
+  }
+}
+
+// Stage 1: each block selects the top k scores of a part of the vocabulary of one beam.
+template <int TPB>
+__global__ void BeamTopKStage1Kernel(const float* next_token_scores,
+                                     int num_beams,
+                                     int vocab_size,
+                                     int k,
+                                     TopKCandidate* candidates) {
+  const int batch_beam_index = blockIdx.x;
+  const int part = blockIdx.y;
+  const int part_size = (vocab_size + gridDim.y - 1) / gridDim.y;
+  const int begin = min(part * part_size, vocab_size);
+  const int count = min(part_size, vocab_size - begin);
+
+  const float* scores = next_token_scores + static_cast<int64_t>(batch_beam_index) * vocab_size + begin;
+  const int offset = (batch_beam_index % num_beams) * vocab_size + begin;
+  TopKCandidate* output = candidates + (static_cast<int64_t>(batch_beam_index) * gridDim.y + part) * k;
+
+  BlockTopK<TPB>(
+      count, k,
+      [=](int i) { return TopKCandidate{scores[i], offset + i}; },
+      [=](int r, const TopKCandidate& candidate) { output[r] = candidate; });
+}
+
+// Stage 2: each block selects the top k of the candidates of all beams of one batch, and splits their indices into
+// beam indices and token IDs.
+template <int TPB>
+__global__ void BeamTopKStage2Kernel(const TopKCandidate* candidates,
+                                     int candidates_per_batch,
+                                     int vocab_size,
+                                     int k,
+                                     float* topk_scores,
+                                     int32_t* next_tokens,
+                                     int32_t* next_indices) {
+  const int batch = blockIdx.x;
+  const TopKCandidate* input = candidates + static_cast<int64_t>(batch) * candidates_per_batch;
+
+  BlockTopK<TPB>(
+      candidates_per_batch, k,
+      [=](int i) { return input[i]; },
+      [=](int r, const TopKCandidate& candidate) {
+        const int index = batch * k + r;
+        if (candidate.index >= 0) {
+          topk_scores[index] = candidate.score;
+          next_tokens[index] = candidate.index % vocab_size;
+          next_indices[index] = candidate.index / vocab_size;
+        } else {
+          topk_scores[index] = cub::FpLimits<float>::Lowest();
+          next_tokens[index] = 0;
+          next_indices[index] = 0;
+        }
+      });
+}
+
+// Number of parts the vocabulary of a beam is split into in stage 1. Each part needs at least k scores to be useful.
+constexpr int kMaxTopKPartsPerBeam = 8;
+
+static int GetTopKPartsPerBeam(int vocab_size, int k) {
+  return std::max(1, std::min(kMaxTopKPartsPerBeam, vocab_size / k));
+}
+
+size_t GetBeamTopKBufferSize(int batch_beam_size, int k) {
+  return sizeof(TopKCandidate) * batch_beam_size * kMaxTopKPartsPerBeam * k;
+}
+
+void LaunchBeamTopKKernel(const float* next_token_scores,
+                          int batch_size,
+                          int num_beams,
+                          int vocab_size,
+                          int k,
+                          void* buffer,
+                          float* topk_scores,
+                          int32_t* next_tokens,
+                          int32_t* next_indices,
                           cudaStream_t stream) {
-  int total_elements = batch_size * num_beams * vocab_size;
   constexpr int blockSize = 256;
-  const int gridSize = (total_elements + blockSize - 1) / blockSize;
-  AddProbsKernel<<<gridSize, blockSize, 0, stream>>>(log_probs, cum_log_probs, vocab_size, total_elements);
-}
+  const int parts = GetTopKPartsPerBeam(vocab_size, k);
+  TopKCandidate* candidates = reinterpret_cast<TopKCandidate*>(buffer);
 
-template void LaunchAddProbsKernel(
-    float* log_probs,
-    float* cum_log_probs,
-    const int batch_size,
-    const int num_beams,
-    const int vocab_size,
-    cudaStream_t stream);
+  const dim3 stage1_grid(batch_size * num_beams, parts);
+  BeamTopKStage1Kernel<blockSize><<<stage1_grid, blockSize, 0, stream>>>(
+      next_token_scores, num_beams, vocab_size, k, candidates);
+
+  BeamTopKStage2Kernel<blockSize><<<batch_size, blockSize, 0, stream>>>(
+      candidates, num_beams * parts * k, vocab_size, k, topk_scores, next_tokens, next_indices);
+}
 
 template <typename T>
 __global__ void UpdateInputsKernel(const T* old_mask_data,
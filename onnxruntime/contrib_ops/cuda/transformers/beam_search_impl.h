@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 #include <cuda_fp16.h>
 namespace onnxruntime {
@@ -14,37 +15,42 @@ void LaunchInitKernel(
     int num_beams,
     cudaStream_t stream);
 
+// Computes next_token_scores = log_softmax(logits[:, -1, :]) with the logits processors applied, plus the beam score
+// of each beam when beam_scores is not null.
 template <typename T>
-void LaunchAddProbsKernel(T* log_probs,
-                          T* cum_log_probs,
-                          const int batch_size,
-                          const int num_beams,
-                          const int vocab_size,
-                          cudaStream_t stream);
-
-template <typename T>
-void LaunchLogitsProcessKernel(
-    T* next_token_scores,
+void LaunchLogSoftmaxScoresKernel(
+    float* next_token_scores,
+    const T* logits,
+    int input_length,
+    const float* beam_scores,
     const int* vocab_mask,
     const int* prefix_vocab_mask,
     int batch_size,
     int num_beams,
     int vocab_size,
     int demote_token_id,
-    int32_t* sequences,
+    const int32_t* sequences,
     int max_sequence_length,
     int current_sequence_length,
     float repetition_penalty,
     int no_repeat_ngram_size,
     cudaStream_t stream);
 
-void LaunchNextTokenKernel(const int64_t* next_token_indices,
-                           int32_t* next_indices,
-                           int32_t* next_tokens,
-                           int batch_size,
-                           int top_k,
-                           int vocab_size,
-                           cudaStream_t stream);
+// Size of the scratch buffer of LaunchBeamTopKKernel.
+size_t GetBeamTopKBufferSize(int batch_beam_size, int k);
+
+// Selects the top k scores of each batch over num_beams * vocab_size in sorted order, and outputs their scores,
+// token IDs and beam indices.
+void LaunchBeamTopKKernel(const float* next_token_scores,
+                          int batch_size,
+                          int num_beams,
+                          int vocab_size,
+                          int k,
+                          void* buffer,
+                          float* topk_scores,
+                          int32_t* next_tokens,
+                          int32_t* next_indices,
+                          cudaStream_t stream);
 
 void LaunchUpdateKernel(const int32_t* old_mask_data,
                         int32_t* mask_data,
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cuda_execution_provider.h"
+#include "contrib_ops/cuda/transformers/greedy_search.h"
+#include "beam_search_device_helper.h"
+#include "dump_cuda_tensor.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    GreedySearch,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .InputMemoryType(OrtMemTypeCPUInput, 0)    // 'input_ids' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 1)    // 'max_length' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 2)    // 'min_length' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 3)    // 'repetition_penalty' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 6)    // 'temperature' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 7)    // 'top_k' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 8)    // 'top_p' needs to be on CPU
+        .OutputMemoryType(OrtMemTypeCPUOutput, 0)  // 'sequences' output on CPU
+        .TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(),
+                              DataTypeImpl::GetTensorType<MLFloat16>()}),
+    GreedySearch);
+
+transformers::CudaTensorConsoleDumper g_cuda_dumper_greedy;
+
+GreedySearch::GreedySearch(const OpKernelInfo& info)
+    : onnxruntime::contrib::transformers::GreedySearch(info) {
+  SetComputeStream(static_cast<void*>(info.GetExecutionProvider()->GetComputeStream()));
+
+  SetDeviceHelpers(BeamSearchCudaDeviceHelper::AddToFeeds);
+
+  SetDeviceHelpers(BeamSearchCudaDeviceHelper::GreedySearchProcessLogits<float>,
+                   BeamSearchCudaDeviceHelper::InitGreedyState<float>,
+                   BeamSearchCudaDeviceHelper::UpdateFeeds<float>);
+
+  SetDeviceHelpers(BeamSearchCudaDeviceHelper::GreedySearchProcessLogits<MLFloat16>,
+                   BeamSearchCudaDeviceHelper::InitGreedyState<MLFloat16>,
+                   BeamSearchCudaDeviceHelper::UpdateFeeds<MLFloat16>);
+
+  SetConsoleDumper(&g_cuda_dumper_greedy);
+}
+
+Status GreedySearch::ComputeInternal(OpKernelContext* context) const {
+  return onnxruntime::contrib::transformers::GreedySearch::Compute(context);
+}
+
+Status GreedySearch::Compute(OpKernelContext* context) const {
+  auto s = ComputeInternal(context);
+
+  if (s.IsOK()) {
+    auto err = cudaGetLastError();
+    if (err != cudaSuccess) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CUDA error ", cudaGetErrorName(err), ":", cudaGetErrorString(err));
+    }
+  }
+
+  return s;
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -25,6 +25,7 @@
 
 #endif
 
+#include <cstring>
 #include <mutex>
 
 #if _WIN32
@@ -97,6 +98,20 @@ CPUIDInfo::CPUIDInfo() {
         }
       }
     }
+
+    // The processor brand string is returned by the extended leaves 0x80000002 to 0x80000004.
+    GetCPUID(static_cast<int>(0x80000000), data);
+    if (static_cast<unsigned int>(data[0]) >= 0x80000004) {
+      char brand[49] = {};
+      for (int i = 0; i < 3; i++) {
+        GetCPUID(static_cast<int>(0x80000002 + i), data);
+        memcpy(brand + i * 16, data, 16);
+      }
+      model_name_ = brand;
+      // Trim the padding that some processors put around the brand string.
+      model_name_.erase(0, model_name_.find_first_not_of(' '));
+      model_name_.erase(model_name_.find_last_not_of(' ') + 1);
+    }
 #endif
 
 #if defined(CPUIDINFO_ARCH_ARM)
@@ -105,6 +120,7 @@ CPUIDInfo::CPUIDInfo() {
     // only works on ARM linux or android, does not work on Windows
     if (pytorch_cpuinfo_init_) {
       is_hybrid_ = cpuinfo_get_uarchs_count() > 1;
+      model_name_ = cpuinfo_get_package(0)->name;
       has_arm_neon_dot_ = cpuinfo_has_arm_neon_dot();
     } else {
       has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0);
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "core/common/common.h"
 
 #if defined(_M_IX86) || (defined(_M_X64) && !defined(_M_ARM64EC)) || defined(__i386__) || defined(__x86_64__)
@@ -34,6 +36,11 @@ class CPUIDInfo {
   // ARM 
   bool HasArmNeonDot() const { return has_arm_neon_dot_; }
 
+  /**
+   * @return CPU model name reported by the processor, or an empty string if it is not available
+  */
+  const std::string& GetCPUModelName() const { return model_name_; }
+
   /**
    * @return CPU core micro-architecture running the current thread
   */
@@ -54,6 +61,7 @@ class CPUIDInfo {
   bool pytorch_cpuinfo_init_{false};
 #endif
   bool has_arm_neon_dot_{false};
+  std::string model_name_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+#if defined(__linux__)
+namespace {
+
+// The counters of a thread, opened as a group so that they count over the same periods.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    leader_fd_ = Open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader_fd_ < 0) {
+      return;
+    }
+    instructions_fd_ = Open(PERF_COUNT_HW_INSTRUCTIONS, leader_fd_);
+    llc_misses_fd_ = Open(PERF_COUNT_HW_CACHE_MISSES, leader_fd_);
+    if (instructions_fd_ < 0 || llc_misses_fd_ < 0) {
+      Close();
+      return;
+    }
+    ioctl(leader_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~ThreadCounters() {
+    Close();
+  }
+
+  bool Read(HardwareCounterValues& values) const {
+    if (leader_fd_ < 0) {
+      return false;
+    }
+
+    // number of counters, time enabled, time running, then the values in the order the counters were opened
+    uint64_t data[3 + 3];
+    if (read(leader_fd_, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+      return false;
+    }
+
+    // the values are extrapolated if the kernel multiplexed the counters with other events
+    const uint64_t time_enabled = data[1];
+    const uint64_t time_running = data[2];
+    auto scale = [time_enabled, time_running](uint64_t value) {
+      return time_running >= time_enabled
+                 ? value
+                 : static_cast<uint64_t>(static_cast<double>(value) * time_enabled / time_running);
+    };
+    values.cycles = scale(data[3]);
+    values.instructions = scale(data[4]);
+    values.llc_misses = scale(data[5]);
+    return true;
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadCounters);
+
+  static int Open(uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    // the group starts counting once all its counters are open
+    attr.disabled = group_fd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0 /* calling thread */, -1 /* any cpu */,
+                                    group_fd, PERF_FLAG_FD_CLOEXEC));
+  }
+
+  void Close() {
+    for (int* fd : {&llc_misses_fd_, &instructions_fd_, &leader_fd_}) {
+      if (*fd >= 0) {
+        close(*fd);
+        *fd = -1;
+      }
+    }
+  }
+
+  int leader_fd_ = -1;
+  int instructions_fd_ = -1;
+  int llc_misses_fd_ = -1;
+};
+
+}  // namespace
+
+bool HardwareCounters::Read(HardwareCounterValues& values) {
+  static thread_local ThreadCounters thread_counters;
+  return thread_counters.Read(values);
+}
+#else
+bool HardwareCounters::Read(HardwareCounterValues& /*values*/) {
+  return false;
+}
+#endif
+
+static thread_local HardwareCounters::Scope* current_hardware_counters_scope{nullptr};
+
+HardwareCounters::Scope::Scope() : previous_(current_hardware_counters_scope) {
+  available_ = Read(start_);
+  current_hardware_counters_scope = this;
+}
+
+HardwareCounters::Scope::~Scope() {
+  current_hardware_counters_scope = previous_;
+}
+
+void HardwareCounters::Scope::Add(const HardwareCounterValues& values) {
+  cycles_.fetch_add(values.cycles, std::memory_order_relaxed);
+  instructions_.fetch_add(values.instructions, std::memory_order_relaxed);
+  llc_misses_.fetch_add(values.llc_misses, std::memory_order_relaxed);
+}
+
+std::string HardwareCounters::Scope::Stop() {
+  HardwareCounterValues end;
+  if (!available_ || !Read(end)) {
+    return std::string();
+  }
+
+  const uint64_t cycles = end.cycles - start_.cycles + cycles_.load(std::memory_order_relaxed);
+  const uint64_t instructions = end.instructions - start_.instructions + instructions_.load(std::memory_order_relaxed);
+  const uint64_t llc_misses = end.llc_misses - start_.llc_misses + llc_misses_.load(std::memory_order_relaxed);
+  return "{\"cycles\" : " + std::to_string(cycles) +
+         ", \"instructions\" : " + std::to_string(instructions) +
+         ", \"llc_misses\" : " + std::to_string(llc_misses) + "}";
+}
+
+HardwareCounters::Scope* HardwareCounters::Scope::Current() {
+  return current_hardware_counters_scope;
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+// Values of the hardware performance counters of one or more threads.
+struct HardwareCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;  // last level cache misses, each one reads a cache line from memory
+};
+
+/**
+ * Hardware performance counters of the threads, read with perf_event_open on Linux. The counters of a thread are
+ * opened the first time it reads them and only count user space. They are not available on the other platforms,
+ * when perf_event_paranoid forbids them, or when the machine doesn't expose its PMU, e.g. in many VMs.
+ */
+class HardwareCounters {
+ public:
+  /*
+  Reads the counters of the calling thread. Returns false if they are not available.
+  */
+  static bool Read(HardwareCounterValues& values);
+
+  /*
+  Counts the events of a node: the ones of the thread running the kernel between the construction of the scope and
+  the call to Stop, plus the ones of the thread pool threads running work items of the parallel loops the kernel
+  issues meanwhile.
+  */
+  class Scope {
+   public:
+    Scope();
+    ~Scope();
+
+    /*
+    Adds the events of a work item run for the scope by another thread.
+    */
+    void Add(const HardwareCounterValues& values);
+
+    /*
+    Returns the events counted so far as a JSON object, or an empty string if the counters are not available.
+    */
+    std::string Stop();
+
+    /*
+    Returns the innermost scope of the calling thread, or nullptr.
+    */
+    static Scope* Current();
+
+   private:
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Scope);
+
+    bool available_;
+    HardwareCounterValues start_;
+    std::atomic<uint64_t> cycles_{0};
+    std::atomic<uint64_t> instructions_{0};
+    std::atomic<uint64_t> llc_misses_{0};
+    Scope* previous_;
+  };
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -43,7 +43,7 @@ void Capture::ProcessPrintf(msvc_printf_check const char* format, va_list args)
   const int nbrcharacters = vsnprintf(message.data(), message.size(), format, args);
 #endif
   error = nbrcharacters < 0;
-  truncated = (nbrcharacters >= 0 && static_cast<gsl::index>(nbrcharacters) > message.size());
+  truncated = (nbrcharacters >= 0 && static_cast<gsl::index>(nbrcharacters) >= message.size());
 #endif
 
   if (error) {
@@ -52,7 +52,8 @@ void Capture::ProcessPrintf(msvc_printf_check const char* format, va_list args)
   } else if (truncated) {
     stream_ << message.data() << kTruncatedWarningText;
   } else {
-    stream_ << message.data();
+    // the length is known, no need for the stream to scan the buffer for the terminating null
+    stream_.write(message.data(), nbrcharacters);
   }
 }
 
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/async_sink.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace logging {
+
+static size_t RoundUpToPowerOf2(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+AsyncSink::AsyncSink(std::unique_ptr<ISink> sink, size_t capacity, std::chrono::milliseconds flush_interval)
+    : sink_{std::move(sink)},
+      flush_interval_{flush_interval},
+      entries_{new Entry[RoundUpToPowerOf2(std::max<size_t>(capacity, 2))]},
+      mask_{RoundUpToPowerOf2(std::max<size_t>(capacity, 2)) - 1} {
+  for (size_t i = 0; i <= mask_; ++i) {
+    entries_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  thread_ = std::thread([this]() { Run(); });
+}
+
+AsyncSink::~AsyncSink() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+void AsyncSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  // claim an entry: it is free for position pos once the background thread has set its sequence to pos
+  Entry* entry;
+  size_t pos = tail_.load(std::memory_order_relaxed);
+  for (;;) {
+    entry = &entries_[pos & mask_];
+    const size_t sequence = entry->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0) {
+      if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // the background thread hasn't read the entry of the previous round yet, i.e. the buffer is full
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      pos = tail_.load(std::memory_order_relaxed);
+    }
+  }
+
+  const CodeLocation& location = message.Location();
+  const Severity severity = message.Severity();
+  entry->timestamp = timestamp;
+  entry->logger_id = logger_id;
+  entry->severity = severity;
+  entry->category = message.Category();
+  entry->data_type = message.DataType();
+  entry->file_and_path = location.file_and_path;
+  entry->line_num = location.line_num;
+  entry->function = location.function;
+  entry->stacktrace = location.stacktrace;
+  entry->message = message.Message();
+
+  // publish the entry to the background thread, which owns it from now on
+  entry->sequence.store(pos + 1, std::memory_order_release);
+
+  if (severity >= Severity::kERROR) {
+    wake_.notify_one();
+  }
+}
+
+size_t AsyncSink::Drain() {
+  size_t num_sent = 0;
+  size_t pos = head_.load(std::memory_order_relaxed);
+  for (;;) {
+    Entry& entry = entries_[pos & mask_];
+    if (entry.sequence.load(std::memory_order_acquire) != pos + 1) {
+      break;
+    }
+
+    {
+      CodeLocation location{entry.file_and_path.c_str(), entry.line_num, entry.function.c_str(), entry.stacktrace};
+      Capture message{entry.severity, entry.category, entry.data_type, location, entry.message};
+      sink_->Send(entry.timestamp, entry.logger_id, message);
+    }
+
+    // hand the entry back to the producers for the next round
+    entry.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    ++pos;
+    ++num_sent;
+  }
+  head_.store(pos, std::memory_order_release);
+
+  const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped != dropped_reported_) {
+    const std::string text = std::to_string(dropped - dropped_reported_) +
+                             " log messages were dropped because the asynchronous log sink was full.";
+    Capture message{Severity::kWARNING, Category::onnxruntime, DataType::SYSTEM, ORT_WHERE, text};
+    sink_->Send(std::chrono::system_clock::now(), "AsyncSink", message);
+    dropped_reported_ = dropped;
+  }
+
+  return num_sent;
+}
+
+void AsyncSink::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    const bool stop = stop_;
+    lock.unlock();
+    Drain();
+    lock.lock();
+    drained_.notify_all();
+    if (stop) {
+      break;
+    }
+    // the producers only wake the thread up for errors, the other messages wait for the next interval
+    wake_.wait_for(lock, flush_interval_);
+  }
+}
+
+void AsyncSink::Flush() {
+  const size_t target = tail_.load(std::memory_order_relaxed);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (head_.load(std::memory_order_acquire) < target) {
+    wake_.notify_one();
+    drained_.wait_for(lock, flush_interval_);
+  }
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/logging/isink.h"
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// ISink that hands the messages to a background thread which sends them to another sink.
+/// The logging thread only copies the message into a lock-free ring buffer; the formatting and the output of the
+/// message (timestamp, location, stream writes and flushes) happen on the background thread.
+/// If the ring buffer is full the message is dropped, and the number of dropped messages is reported later.
+/// </summary>
+/// <seealso cref="ISink" />
+class AsyncSink : public ISink {
+ public:
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink" /> class.
+  /// </summary>
+  /// <param name="sink">The sink the messages are sent to. Only the background thread uses it.</param>
+  /// <param name="capacity">Number of messages the ring buffer holds, rounded up to a power of 2.</param>
+  /// <param name="flush_interval">Interval at which the background thread checks for new messages.
+  /// Messages of severity ERROR and above wake it up right away.</param>
+  explicit AsyncSink(std::unique_ptr<ISink> sink, size_t capacity = 4096,
+                     std::chrono::milliseconds flush_interval = std::chrono::milliseconds(10));
+
+  /// <summary>
+  /// Sends the queued messages and stops the background thread.
+  /// </summary>
+  ~AsyncSink() override;
+
+  /// <summary>
+  /// Waits until the messages queued before the call have been sent.
+  /// </summary>
+  void Flush();
+
+  /// <summary>
+  /// Number of messages dropped because the ring buffer was full.
+  /// </summary>
+  uint64_t DroppedMessages() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+  void SendProfileEvent(profiling::EventRecord& event_record) const override {
+    sink_->SendProfileEvent(event_record);
+  }
+
+ private:
+  // A captured message. The strings keep their capacity when the entry is reused.
+  struct Entry {
+    std::atomic<size_t> sequence{0};
+    Timestamp timestamp;
+    std::string logger_id;
+    Severity severity = Severity::kVERBOSE;
+    const char* category = nullptr;
+    DataType data_type = DataType::SYSTEM;
+    std::string file_and_path;
+    int line_num = 0;
+    std::string function;
+    std::vector<std::string> stacktrace;
+    std::string message;
+  };
+
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  // Sends the published messages to sink_, returns the number of messages sent. Only called by the background thread.
+  size_t Drain();
+
+  void Run();
+
+  std::unique_ptr<ISink> sink_;
+  const std::chrono::milliseconds flush_interval_;
+
+  std::unique_ptr<Entry[]> entries_;
+  const size_t mask_;
+
+  // Next entry claimed by the producers, bounded multi-producer queue with a sequence number per entry.
+  alignas(64) std::atomic<size_t> tail_{0};
+  // Next entry read by the background thread.
+  alignas(64) std::atomic<size_t> head_{0};
+  std::atomic<uint64_t> dropped_{0};
+  uint64_t dropped_reported_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable drained_;
+  bool stop_ = false;  // protected by mutex_
+  std::thread thread_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncSink);
+};
+}  // namespace logging
+}  // namespace onnxruntime
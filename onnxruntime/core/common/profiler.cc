@@ -3,6 +3,10 @@
 
 #include "profiler.h"
 
+#include <algorithm>
+
+#include "core/common/path_string.h"
+
 namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
@@ -19,6 +23,20 @@ profiling::Profiler::~Profiler() {
 profiling::Profiler::~Profiler() {}
 #endif
 
+static thread_local Profiler* current_profiler{nullptr};
+
+Profiler::ThreadScope::ThreadScope(Profiler* profiler) : previous_(current_profiler) {
+  current_profiler = profiler;
+}
+
+Profiler::ThreadScope::~ThreadScope() {
+  current_profiler = previous_;
+}
+
+Profiler* Profiler::Current() {
+  return current_profiler;
+}
+
 ::onnxruntime::TimePoint profiling::Profiler::Start() {
   ORT_ENFORCE(enabled_);
   auto start_time = std::chrono::high_resolution_clock::now();
@@ -79,27 +97,130 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
-  EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  //TODO: sync_gpu if needed.
+  AddEvent(EventRecord(category, logging::GetProcessId(),
+                       logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()}));
+
+  for (const auto& ep_profiler : ep_profilers_) {
+    ep_profiler->Stop(ts);
+  }
+}
+
+void Profiler::RecordEvent(EventCategory category,
+                           const std::string& event_name,
+                           const TimePoint& start_time,
+                           const std::initializer_list<std::pair<std::string, std::string>>& event_args) {
+  long long dur = TimeDiffMicroSeconds(start_time);
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
+
+  AddEvent(EventRecord(category, logging::GetProcessId(),
+                       logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()}));
+}
+
+void Profiler::AddEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (ring_buffer_size_ > 0) {
+    if (events_.size() < ring_buffer_size_) {
+      events_.emplace_back(std::move(event));
+    } else {
+      events_[ring_buffer_next_] = std::move(event);
+    }
+    ring_buffer_next_ = (ring_buffer_next_ + 1) % ring_buffer_size_;
+  } else if (events_.size() < max_num_events_) {
+    events_.emplace_back(std::move(event));
   } else {
-    //TODO: sync_gpu if needed.
+    if (session_logger_ && !max_events_reached) {
+      LOGS(*session_logger_, ERROR)
+          << "Maximum number of events reached, could not record profile event.";
+      max_events_reached = true;
+    }
+  }
+}
+
+void Profiler::EnableRingBuffer(size_t num_events) {
+  ORT_ENFORCE(!enabled_, "The ring buffer must be enabled before profiling starts.");
+  ORT_ENFORCE(num_events > 0, "The ring buffer must hold at least one event.");
+  ring_buffer_size_ = num_events;
+  events_.reserve(num_events);
+}
+
+std::string Profiler::DumpProfiling() {
+  if (!enabled_ || profile_with_logger_) {
+    return std::string();
+  }
+
+  Events events;
+  std::string file_name;
+  {
     std::lock_guard<OrtMutex> lock(mutex_);
-    if (events_.size() < max_num_events_) {
-      events_.emplace_back(event);
-    } else {
-      if (session_logger_ && !max_events_reached) {
-        LOGS(*session_logger_, ERROR)
-            << "Maximum number of events reached, could not record profile event.";
-        max_events_reached = true;
-      }
+    // oldest first, ring_buffer_next_ stays 0 unless the ring buffer has wrapped around
+    events.reserve(events_.size());
+    events.insert(events.end(), events_.begin() + ring_buffer_next_, events_.end());
+    events.insert(events.end(), events_.begin(), events_.begin() + ring_buffer_next_);
+
+    for (const auto& ep_profiler : ep_profilers_) {
+      ep_profiler->EndProfiling(profiling_start_time_, events);
+      ep_profiler->StartProfiling();
+    }
+
+    const std::string suffix = ".json";
+    file_name = profile_stream_file_;
+    if (file_name.size() >= suffix.size() &&
+        file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+      file_name.resize(file_name.size() - suffix.size());
     }
+    file_name += "_dump" + std::to_string(++num_dumps_) + suffix;
   }
 
-  for (const auto& ep_profiler : ep_profilers_) {
-    ep_profiler->Stop(ts);
+  if (session_logger_) {
+    LOGS(*session_logger_, INFO) << "Writing " << events.size() << " profiler events to file " << file_name;
+  }
+
+#if defined(__wasm__)
+  WriteEvents(profile_stream_, events);
+#else
+  std::ofstream dump_stream(ToPathString(file_name), std::ios::out | std::ios::trunc);
+  WriteEvents(dump_stream, events);
+#endif
+  return file_name;
+}
+
+void Profiler::WriteEvents(std::ostream& stream, const Events& events) {
+  stream << "[\n";
+
+  for (size_t i = 0; i < events.size(); ++i) {
+    auto& rec = events[i];
+    stream << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
+    stream << "\"pid\" :" << rec.pid << ",";
+    stream << "\"tid\" :" << rec.tid << ",";
+    stream << "\"dur\" :" << rec.dur << ",";
+    stream << "\"ts\" :" << rec.ts << ",";
+    stream << R"("ph" : "X",)";
+    stream << R"("name" :")" << rec.name << "\",";
+    stream << "\"args\" : {";
+    bool is_first_arg = true;
+    for (std::pair<std::string, std::string> event_arg : rec.args) {
+      if (!is_first_arg) stream << ",";
+      if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
+        stream << "\"" << event_arg.first << "\" : " << event_arg.second << "";
+      } else {
+        stream << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
+      }
+      is_first_arg = false;
+    }
+    stream << "}";
+    if (i == events.size() - 1) {
+      stream << "}\n";
+    } else {
+      stream << "},\n";
+    }
   }
+  stream << "]\n";
 }
 
 std::string Profiler::EndProfiling() {
@@ -116,40 +237,15 @@ std::string Profiler::EndProfiling() {
   }
 
   std::lock_guard<OrtMutex> lock(mutex_);
-  profile_stream_ << "[\n";
+  // oldest first, ring_buffer_next_ stays 0 unless the ring buffer has wrapped around
+  std::rotate(events_.begin(), events_.begin() + ring_buffer_next_, events_.end());
+  ring_buffer_next_ = 0;
 
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->EndProfiling(profiling_start_time_, events_);
   }
 
-  for (size_t i = 0; i < events_.size(); ++i) {
-    auto& rec = events_[i];
-    profile_stream_ << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
-    profile_stream_ << "\"pid\" :" << rec.pid << ",";
-    profile_stream_ << "\"tid\" :" << rec.tid << ",";
-    profile_stream_ << "\"dur\" :" << rec.dur << ",";
-    profile_stream_ << "\"ts\" :" << rec.ts << ",";
-    profile_stream_ << R"("ph" : "X",)";
-    profile_stream_ << R"("name" :")" << rec.name << "\",";
-    profile_stream_ << "\"args\" : {";
-    bool is_first_arg = true;
-    for (std::pair<std::string, std::string> event_arg : rec.args) {
-      if (!is_first_arg) profile_stream_ << ",";
-      if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
-        profile_stream_ << "\"" << event_arg.first << "\" : " << event_arg.second << "";
-      } else {
-        profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
-      }
-      is_first_arg = false;
-    }
-    profile_stream_ << "}";
-    if (i == events_.size() - 1) {
-      profile_stream_ << "}\n";
-    } else {
-      profile_stream_ << "},\n";
-    }
-  }
-  profile_stream_ << "]\n";
+  WriteEvents(profile_stream_, events_);
 #if !defined(__wasm__)
   profile_stream_.close();
 #endif
@@ -79,6 +79,47 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Record a single event which doesn't belong to an operator, i.e. without notifying the EP profilers.
+  Time is measured till the call of this function from the start_time.
+  */
+  void RecordEvent(EventCategory category,
+                   const std::string& event_name,
+                   const TimePoint& start_time,
+                   const std::initializer_list<std::pair<std::string, std::string>>& event_args = {});
+
+  /*
+  Keep only the last num_events events, overwriting the oldest ones once the profiler is full instead of dropping
+  the new ones, so that profiling can stay on and the recent events can be written by DumpProfiling at any time.
+  The runs also record the work items of their parallel loops and their arena allocations in this mode.
+  Must be called before profiling starts.
+  */
+  void EnableRingBuffer(size_t num_events);
+
+  bool IsRingBufferEnabled() const {
+    return ring_buffer_size_ > 0;
+  }
+
+  /*
+  Count the hardware events (cycles, instructions, last level cache misses) of each kernel, including the ones of
+  the thread pool threads running its parallel loops, and add them to its "_kernel_time" event.
+  See HardwareCounters for the platforms supporting it.
+  */
+  void EnableHardwareCounters(bool enable) {
+    hardware_counters_ = enable;
+  }
+
+  bool IsHardwareCountersEnabled() const {
+    return hardware_counters_;
+  }
+
+  /*
+  Write the events recorded so far to a new file next to the profile file, in the same format, without ending
+  profiling. The events of the EP profilers are collected and their profiling is restarted.
+  Return the name of the file, or an empty string if profiling is disabled or sends the events to a logger.
+  */
+  std::string DumpProfiling();
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -109,6 +150,26 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
   
+  /*
+  Makes a profiler record the events of the calling thread which have no access to it, namely the work items that
+  the thread pools run for the thread's parallel loops and the allocations of the arenas, until the scope is
+  destroyed. Scopes nest, a scope with a null profiler stops the recording.
+  */
+  class ThreadScope {
+   public:
+    explicit ThreadScope(Profiler* profiler);
+    ~ThreadScope();
+
+   private:
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadScope);
+    Profiler* previous_;
+  };
+
+  /*
+  Return the profiler of the innermost ThreadScope of the calling thread, or nullptr.
+  */
+  static Profiler* Current();
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -121,6 +182,10 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  void AddEvent(EventRecord&& event);
+
+  static void WriteEvents(std::ostream& stream, const Events& events);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -149,6 +214,11 @@ class Profiler {
   bool max_events_reached{false};
   bool profile_with_logger_{false};
   const size_t max_num_events_{global_max_num_events_.load()};
+  // In ring buffer mode, events_ is full once it holds ring_buffer_size_ events and the oldest is at ring_buffer_next_.
+  size_t ring_buffer_size_{0};
+  bool hardware_counters_{false};
+  size_t ring_buffer_next_{0};
+  size_t num_dumps_{0};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
   static Profiler* instance_;
@@ -18,6 +18,8 @@ limitations under the License.
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
+#include "core/common/hardware_counters.h"
+#include "core/common/profiler.h"
 #include "core/common/eigen_common_wrapper.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
@@ -301,6 +303,23 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
     return idx % _num_shards;
   }
 
+  // When the pool's workers span several NUMA nodes the shards are
+  // split into one contiguous group per node, and a worker takes its
+  // home shard from its own node's group.  Each node then works on its
+  // own part of the iteration space, and successive loops over the
+  // same data keep that part on the same node.  Threads outside the
+  // pool (numa_node == -1) fall back to the default allocation.
+
+  unsigned GetHomeShard(unsigned idx, int numa_node, unsigned num_numa_nodes) const {
+    if (numa_node < 0 || num_numa_nodes < 2 || _num_shards < num_numa_nodes) {
+      return GetHomeShard(idx);
+    }
+    unsigned node = static_cast<unsigned>(numa_node);
+    unsigned group_begin = node * _num_shards / num_numa_nodes;
+    unsigned group_end = (node + 1) * _num_shards / num_numa_nodes;
+    return group_begin + idx % (group_end - group_begin);
+  }
+
   // Attempt to claim iterations from the sharded counter.  The function either
   // returns true, along with a block of exactly block_size iterations, or it returns false
   // if all of the iterations have been claimed.
@@ -377,18 +396,110 @@ ThreadPool::ThreadPool(Env* env,
   assert(degree_of_parallelism >= 1);
   if (degree_of_parallelism >= 2) {
     int threads_to_create = degree_of_parallelism - 1;
-    extended_eigen_threadpool_ =
-        std::make_unique<ThreadPoolTempl<Env> >(name,
-                                                threads_to_create,
-                                                low_latency_hint,
-                                                *env,
-                                                thread_options_);
+    if (thread_options_.use_lock_free_queues) {
+      extended_eigen_threadpool_ =
+          std::make_unique<ThreadPoolTempl<Env, LockFreeRunQueue> >(name,
+                                                                    threads_to_create,
+                                                                    low_latency_hint,
+                                                                    *env,
+                                                                    thread_options_);
+    } else {
+      extended_eigen_threadpool_ =
+          std::make_unique<ThreadPoolTempl<Env> >(name,
+                                                  threads_to_create,
+                                                  low_latency_hint,
+                                                  *env,
+                                                  thread_options_);
+    }
     underlying_threadpool_ = extended_eigen_threadpool_.get();
   }
 }
 
+ThreadPool::ThreadPool(ThreadPool& shared_pool, const ThreadPoolQuota& quota)
+    : thread_options_(shared_pool.thread_options_),
+      underlying_threadpool_(shared_pool.underlying_threadpool_),
+      force_hybrid_(shared_pool.force_hybrid_),
+      shared_pool_(&shared_pool),
+      quota_(quota) {
+  ORT_ENFORCE(shared_pool.shared_pool_ == nullptr, "A pool sharing the threads of another pool can't be shared");
+  ORT_ENFORCE(quota.max_threads >= 0 && quota.weight >= 0, "Invalid thread pool quota");
+}
+
 ThreadPool::~ThreadPool() = default;
 
+ThreadPool::ActiveScope::ActiveScope(ThreadPool* tp) : tp_(tp) {
+  if (tp_ && tp_->shared_pool_ && tp_->quota_.weight > 0) {
+    if (tp_->num_active_scopes_.fetch_add(1, std::memory_order_relaxed) == 0) {
+      tp_->shared_pool_->active_weight_.fetch_add(tp_->quota_.weight, std::memory_order_relaxed);
+    }
+  } else {
+    tp_ = nullptr;
+  }
+}
+
+ThreadPool::ActiveScope::~ActiveScope() {
+  if (tp_) {
+    if (tp_->num_active_scopes_.fetch_sub(1, std::memory_order_relaxed) == 1) {
+      tp_->shared_pool_->active_weight_.fetch_sub(tp_->quota_.weight, std::memory_order_relaxed);
+    }
+  }
+}
+
+thread_local const ThreadPool::RunTerminationScope* ThreadPool::RunTerminationScope::current_run_termination_scope{nullptr};
+
+ThreadPool::RunTerminationScope::RunTerminationScope(const bool& terminate_flag, Clock::time_point deadline)
+    : terminate_flag_(terminate_flag), deadline_(deadline), previous_(current_run_termination_scope) {
+  current_run_termination_scope = this;
+}
+
+ThreadPool::RunTerminationScope::~RunTerminationScope() {
+  current_run_termination_scope = previous_;
+}
+
+namespace {
+// Records a work item of a parallel loop on the thread which runs it, for the profiler and the hardware counters
+// scope of the thread which issued the loop, if any.
+class WorkItemRecorder {
+ public:
+  WorkItemRecorder(profiling::Profiler* profiler, profiling::HardwareCounters::Scope* counters, unsigned idx)
+      : profiler_(profiler), idx_(idx) {
+    if (profiler_ != nullptr) {
+      start_time_ = std::chrono::high_resolution_clock::now();
+    }
+    // the events of the work items run by the issuing thread itself already count for its scope
+    if (counters != nullptr && counters != profiling::HardwareCounters::Scope::Current() &&
+        profiling::HardwareCounters::Read(start_counters_)) {
+      counters_ = counters;
+    }
+  }
+
+  ~WorkItemRecorder() {
+    profiling::HardwareCounterValues end_counters;
+    if (counters_ != nullptr && profiling::HardwareCounters::Read(end_counters)) {
+      counters_->Add({end_counters.cycles - start_counters_.cycles,
+                      end_counters.instructions - start_counters_.instructions,
+                      end_counters.llc_misses - start_counters_.llc_misses});
+    }
+    if (profiler_ != nullptr) {
+      profiler_->RecordEvent(profiling::THREAD_POOL_EVENT, "parallel_for_work_item", start_time_,
+                             {{"work_item", std::to_string(idx_)}, {"iterations", std::to_string(num_iterations_)}});
+    }
+  }
+
+  void AddIterations(uint64_t num_iterations) {
+    num_iterations_ += num_iterations;
+  }
+
+ private:
+  profiling::Profiler* const profiler_;
+  profiling::HardwareCounters::Scope* counters_ = nullptr;
+  const unsigned idx_;
+  TimePoint start_time_;
+  profiling::HardwareCounterValues start_counters_;
+  uint64_t num_iterations_ = 0;
+};
+}  // namespace
+
 // Base case for parallel loops, running iterations 0..total, divided into blocks
 // of block_size iterations, and calling into a function that takes a start..end
 // range of indices to run.
@@ -404,6 +515,16 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   }
 
   auto d_of_p = DegreeOfParallelism(this);
+  const unsigned num_numa_nodes = NumNumaNodes();
+  // The scope of the run issuing the loop, the helping threads stop claiming blocks once it should terminate.
+  const RunTerminationScope* run_termination = RunTerminationScope::Current();
+  auto should_terminate = [run_termination]() {
+    return run_termination != nullptr && run_termination->ShouldTerminate();
+  };
+  // The profiler and the hardware counters of the thread issuing the loop, if any, record the work items on the
+  // threads running them.
+  profiling::Profiler* profiler = profiling::Profiler::Current();
+  profiling::HardwareCounters::Scope* counters = profiling::HardwareCounters::Scope::Current();
   if (thread_options_.dynamic_block_base_ <= 0) {
     // Split the work across threads in the pool.  Each work item will run a loop claiming iterations,
     // hence we need at most one for each thread, even if the number of blocks of iterations is larger.
@@ -414,12 +535,15 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
 
     LoopCounter lc(total, d_of_p, block_size);
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
-      unsigned my_home_shard = lc.GetHomeShard(idx);
+      WorkItemRecorder recorder(profiler, counters, idx);
+      unsigned my_home_shard = lc.GetHomeShard(idx, CurrentThreadNumaNode(), num_numa_nodes);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
-      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
+      while (!should_terminate() &&
+             lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
+        recorder.AddIterations(my_iter_end - my_iter_start);
       }
     };
     // Run the work in the thread pool (and in the current thread).  Synchronization with helping
@@ -432,13 +556,15 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     alignas(CACHE_LINE_BYTES) std::atomic<std::ptrdiff_t> left{total};
     LoopCounter lc(total, d_of_p, base_block_size);
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
+      WorkItemRecorder recorder(profiler, counters, idx);
       std::ptrdiff_t b = base_block_size;
-      unsigned my_home_shard = lc.GetHomeShard(idx);
+      unsigned my_home_shard = lc.GetHomeShard(idx, CurrentThreadNumaNode(), num_numa_nodes);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
-      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
+      while (!should_terminate() && lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
+        recorder.AddIterations(my_iter_end - my_iter_start);
         auto todo = left.fetch_sub(static_cast<std::ptrdiff_t>(my_iter_end - my_iter_start), std::memory_order_relaxed);
         if (b > 1) {
           b = static_cast<std::ptrdiff_t>(std::max(1LL, std::llroundl(static_cast<long double>(todo) / num_of_blocks)));
@@ -503,6 +629,10 @@ ThreadPool::ParallelSection::~ParallelSection() {
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
+  if (shared_pool_) {
+    // fn may run with a lower degree of parallelism than requested, see ExtendedThreadPoolInterface
+    n = std::min(n, static_cast<unsigned>(NumThreads() + 1));
+  }
   if (underlying_threadpool_) {
     if (ThreadPool::ParallelSection::current_parallel_section) {
       underlying_threadpool_->RunInParallelSection(*(ThreadPool::ParallelSection::current_parallel_section->ps_.get()),
@@ -626,7 +756,10 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // When not using OpenMP, we parallelise over the N threads created by the pool
   // tp, plus 1 for the thread entering a loop.
   if (tp) {
-    if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
+    // the threads of a hybrid processor progress at different speeds unless they are all on the fastest cores, so
+    // the work is split into more blocks for the faster threads to take over the blocks of the slower ones
+    if (tp->force_hybrid_ ||
+        (CPUIDInfo::GetCPUIDInfo().IsHybrid() && !tp->thread_options_.performance_cores_only)) {
       return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
     } else {
       return ((tp->NumThreads() + 1));
@@ -652,11 +785,23 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
 
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
-  if (underlying_threadpool_) {
-    return underlying_threadpool_->NumThreads();
-  } else {
+  if (!underlying_threadpool_) {
     return 0;
   }
+
+  int num_threads = underlying_threadpool_->NumThreads();
+  if (shared_pool_) {
+    const int active_weight = shared_pool_->active_weight_.load(std::memory_order_relaxed);
+    if (quota_.weight > 0 && active_weight > quota_.weight) {
+      // the share includes the thread entering the loop, which always takes part
+      const int64_t share = static_cast<int64_t>(num_threads + 1) * quota_.weight / active_weight;
+      num_threads = static_cast<int>(std::max<int64_t>(share, 1)) - 1;
+    }
+    if (quota_.max_threads > 0) {
+      num_threads = std::min(num_threads, quota_.max_threads);
+    }
+  }
+  return num_threads;
 }
 
 // Return ID of the current thread within this pool.  Returns -1 for a thread outside the
@@ -669,6 +814,38 @@ int ThreadPool::CurrentThreadId() const {
   }
 }
 
+unsigned ThreadPool::NumNumaNodes() const {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->NumNumaNodes();
+  } else {
+    return 1;
+  }
+}
+
+int ThreadPool::CurrentThreadNumaNode() const {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->CurrentThreadNumaNode();
+  } else {
+    return -1;
+  }
+}
+
+unsigned ThreadPool::NumQueuedTasks() const {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->NumQueuedTasks();
+  } else {
+    return 0;
+  }
+}
+
+ThreadPoolSpinStats ThreadPool::GetSpinStats() const {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->GetSpinStats();
+  } else {
+    return {};
+  }
+}
+
 void ThreadPool::TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                                 const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
   if (tp == nullptr) {
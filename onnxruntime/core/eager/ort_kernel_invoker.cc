@@ -9,50 +9,93 @@
 #include "core/session/ort_env.h"
 #include "core/graph/constants.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 
 #define ORT_EAGER_ONNX_OPSET_VERSION 14
 
-common::Status ORTInvoker::Invoke(const std::string& op_name,
-                                  //optional inputs / outputs?
-                                  const std::vector<OrtValue>& inputs,
-                                  std::vector<OrtValue>& outputs,
-                                  const NodeAttributes* attributes,
-                                  const std::string& domain,
-                                  const int version) {
+// The node inputs are graph inputs rather than initializers, so nothing in the kernel depends on the input values
+// and the kernel can be reused for every invocation with the same key.
+struct CachedKernel {
+  std::unique_ptr<Model> model;
+  std::function<bool(const std::string&)> is_sparse_initializer_func;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  std::unique_ptr<const OpKernel> kernel;
+  const KernelCreateInfo* kernel_create_info{nullptr};
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<int> fetch_mlvalue_idxs;
+};
+
+ORTInvoker::~ORTInvoker() = default;
+
+static std::string GetKernelCacheKey(const std::string& op_name,
+                                     const std::vector<OrtValue>& inputs,
+                                     size_t num_outputs,
+                                     const NodeAttributes* attributes,
+                                     const std::string& domain,
+                                     const int version) {
+  std::string key = domain + ":" + op_name + ":" + std::to_string(version) + ":" + std::to_string(num_outputs);
+  for (const auto& input : inputs) {
+    key += ":" + std::to_string(input.Get<Tensor>().GetElementType());
+  }
+  if (attributes) {
+    // attributes are unordered
+    std::vector<const std::string*> names;
+    names.reserve(attributes->size());
+    for (const auto& attr : *attributes) {
+      names.push_back(&attr.first);
+    }
+    std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+    for (const auto* name : names) {
+      key += "|" + *name + "=" + attributes->at(*name).SerializeAsString();
+    }
+  }
+  return key;
+}
+
+static Status CreateCachedKernel(const std::string& op_name,
+                                 const std::vector<OrtValue>& inputs,
+                                 size_t num_outputs,
+                                 const NodeAttributes* attributes,
+                                 const std::string& domain,
+                                 const int version,
+                                 const IExecutionProvider& execution_provider,
+                                 const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries,
+                                 const logging::Logger& logger,
+                                 std::unique_ptr<CachedKernel>& cached) {
   std::unordered_map<std::string, int> domain_version_map = {{kOnnxDomain, ORT_EAGER_ONNX_OPSET_VERSION},
                                                              {kMSDomain, 1}};
+  auto entry = std::make_unique<CachedKernel>();
   //create a graph
-  Model model("test", 
-              false, 
-              ModelMetaData(),
-              ORT_TSTR(""),
-              custom_op_registries_,
-              domain_version_map,
-              {},
-              logger_);
+  entry->model = std::make_unique<Model>("test",
+                                         false,
+                                         ModelMetaData(),
+                                         ORT_TSTR(""),
+                                         custom_op_registries,
+                                         domain_version_map,
+                                         std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                         logger);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(num_outputs);
 
-  Graph& graph = model.MainGraph();
-  std::unordered_map<std::string, OrtValue> initializer_map;
+  Graph& graph = entry->model->MainGraph();
   size_t i = 0;
 
-  for (auto input : inputs) {
+  for (const auto& input : inputs) {
     std::string name = "I" + std::to_string(i++);
     const Tensor& input_tensor = input.Get<Tensor>();
     ONNX_NAMESPACE::TypeProto input_tensor_type;
     input_tensor_type.mutable_tensor_type()->set_elem_type(input_tensor.GetElementType());
     auto& arg = graph.GetOrCreateNodeArg(name, &input_tensor_type);
     input_args.push_back(&arg);
-    initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < num_outputs; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
@@ -60,37 +103,70 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
   auto& node = graph.AddNode("node1", op_name, "eager mode node", input_args, output_args, attributes, domain);
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
-  node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
+  node.SetExecutionProviderType(execution_provider.Type());
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_, [](std::string const& ) { return false; });
-  const KernelCreateInfo* kernel_create_info = nullptr;
-  ORT_RETURN_IF_ERROR(info.TryFindKernel(&node, &kernel_create_info));
-  if (!kernel_create_info) {
+  entry->is_sparse_initializer_func = [](const std::string&) { return false; };
+  entry->info = std::make_unique<OptimizerExecutionFrame::Info>(std::vector<const Node*>{&node},
+                                                                std::unordered_map<std::string, OrtValue>(),
+                                                                graph.ModelPath(), execution_provider,
+                                                                entry->is_sparse_initializer_func);
+  ORT_RETURN_IF_ERROR(entry->info->TryFindKernel(&node, &entry->kernel_create_info));
+  if (!entry->kernel_create_info) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
-  // check whether the inputs are contiguous tensor
-  const auto& may_strided_inputs = kernel_create_info->kernel_def->MayStridedInput();
-  for (i = 0; i < inputs.size(); ++i) {
-    const Tensor& input_tensor = inputs[i].Get<Tensor>();
-    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
-                                                  static_cast<int>(i)) == may_strided_inputs.end())
-      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
-  }
 
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
+  entry->kernel = entry->info->CreateKernel(&node);
+  if (!entry->kernel) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
 
-  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_in : node.InputDefs()) {
+    entry->feed_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_in->Name()));
+  }
   for (const auto* node_out : node.OutputDefs()) {
-    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+    entry->fetch_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_out->Name()));
+  }
+
+  cached = std::move(entry);
+  return Status::OK();
+}
+
+common::Status ORTInvoker::Invoke(const std::string& op_name,
+                                  //optional inputs / outputs?
+                                  const std::vector<OrtValue>& inputs,
+                                  std::vector<OrtValue>& outputs,
+                                  const NodeAttributes* attributes,
+                                  const std::string& domain,
+                                  const int version) {
+  const CachedKernel* cached = nullptr;
+  {
+    const std::string key = GetKernelCacheKey(op_name, inputs, outputs.size(), attributes, domain, version);
+    std::lock_guard<std::mutex> lock(kernel_cache_mutex_);
+    auto& entry = kernel_cache_[key];
+    if (!entry) {
+      Status status = CreateCachedKernel(op_name, inputs, outputs.size(), attributes, domain, version,
+                                         *execution_provider_, custom_op_registries_, logger_, entry);
+      if (!status.IsOK()) {
+        kernel_cache_.erase(key);
+        return status;
+      }
+    }
+    cached = entry.get();
+  }
+
+  // check whether the inputs are contiguous tensor
+  const auto& may_strided_inputs = cached->kernel_create_info->kernel_def->MayStridedInput();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const Tensor& input_tensor = inputs[i].Get<Tensor>();
+    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
+                                                  static_cast<int>(i)) == may_strided_inputs.end())
+      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
   }
 
-  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  // outputs that are already allocated by the caller are written in place, the rest are allocated by the kernel
+  OptimizerExecutionFrame frame(*cached->info, cached->feed_mlvalue_idxs, inputs, cached->fetch_mlvalue_idxs, outputs);
+  OpKernelContext op_kernel_context(&frame, cached->kernel.get(), nullptr, logger_);
+  ORT_RETURN_IF_ERROR(cached->kernel->Compute(&op_kernel_context));
 
   return frame.GetOutputs(outputs);
 }
@@ -60,8 +60,35 @@ class SessionState(object):
         o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
         return o == 0
 
-def SessionStateStart(builder): builder.StartObject(2)
+    # SessionState
+    def PrepackedWeights(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from ort_flatbuffers_py.fbs.PrePackedWeights import PrePackedWeights
+            obj = PrePackedWeights()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # SessionState
+    def PrepackedWeightsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # SessionState
+    def PrepackedWeightsIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        return o == 0
+
+def SessionStateStart(builder): builder.StartObject(3)
 def SessionStateAddKernels(builder, kernels): builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(kernels), 0)
 def SessionStateAddSubGraphSessionStates(builder, subGraphSessionStates): builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(subGraphSessionStates), 0)
 def SessionStateStartSubGraphSessionStatesVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def SessionStateAddPrepackedWeights(builder, prepackedWeights): builder.PrependUOffsetTRelativeSlot(2, flatbuffers.number_types.UOffsetTFlags.py_type(prepackedWeights), 0)
+def SessionStateStartPrepackedWeightsVector(builder, numElems): return builder.StartVector(4, numElems, 4)
 def SessionStateEnd(builder): return builder.EndObject()
@@ -4,12 +4,16 @@
 #pragma once
 
 #include "core/framework/tensor.h"
+#include "core/framework/ort_value.h"
+#include <iterator>
 #include <vector>
 #include <utility>
 
 namespace onnxruntime {
 // Put this in a separate file to avoid circular dependency between tensor.h and data_types.h
 // Data type to represent a sequence of tensors of the same type
+// The tensors are held in OrtValues and are never modified once they are in a sequence, so sequences can share them:
+// a sequence built from another one, e.g. by SequenceInsert, copies the OrtValues rather than the tensor data.
 class TensorSeq {
  public:
   TensorSeq() = default;
@@ -17,7 +21,29 @@ class TensorSeq {
     SetType(elem_type);
   }
 
-  using const_iterator = std::vector<Tensor>::const_iterator;
+  // Iterates over the tensors of the sequence.
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Tensor;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Tensor*;
+    using reference = const Tensor&;
+
+    explicit const_iterator(std::vector<OrtValue>::const_iterator it) noexcept : it_(it) {}
+
+    reference operator*() const { return it_->Get<Tensor>(); }
+    pointer operator->() const { return &it_->Get<Tensor>(); }
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const noexcept { return it_ == other.it_; }
+    bool operator!=(const const_iterator& other) const noexcept { return it_ != other.it_; }
+
+   private:
+    std::vector<OrtValue>::const_iterator it_;
+  };
 
   // Sets the element type after construction.
   // Expects sequence to be empty at the time.
@@ -31,6 +57,15 @@ class TensorSeq {
     // The caller of this method ensures that :
     // (1) `elem_type` is set before invoking this method
     // (2) All tensors contain elements of the same primitive data type
+    assert(tensors_.empty());
+    tensors_.reserve(tensors.size());
+    for (auto& tensor : tensors) {
+      tensors_.push_back(ToOrtValue(std::move(tensor)));
+    }
+  }
+
+  // Same as above for tensors that are held in OrtValues, e.g. those of another sequence, which are then shared.
+  void SetElements(std::vector<OrtValue>&& tensors) {
     assert(tensors_.empty());
     tensors_ = std::move(tensors);
   }
@@ -49,15 +84,21 @@ class TensorSeq {
 
   // Suitable for for range loop
   const_iterator begin() const noexcept {
-    return tensors_.cbegin();
+    return const_iterator(tensors_.cbegin());
   }
 
   const_iterator end() const noexcept {
-    return tensors_.cend();
+    return const_iterator(tensors_.cend());
   }
 
   // Get by index
   const Tensor& Get(size_t i) const {
+    ORT_ENFORCE(i < tensors_.size());
+    return tensors_[i].Get<Tensor>();
+  }
+
+  // Get the OrtValue holding the tensor at index i, to share it with another sequence.
+  const OrtValue& GetOrtValue(size_t i) const {
     ORT_ENFORCE(i < tensors_.size());
     return tensors_[i];
   }
@@ -65,7 +106,14 @@ class TensorSeq {
   void Add(Tensor&& tensor) {
     ORT_ENFORCE(IsSameDataType(tensor),
                 "TensorSeq: tensor to be added has a different data type.");
-    tensors_.push_back(std::move(tensor));
+    tensors_.push_back(ToOrtValue(std::move(tensor)));
+  }
+
+  // Adds a tensor that is held in an OrtValue. The tensor is shared, so it must not be modified afterwards.
+  void Add(const OrtValue& tensor) {
+    ORT_ENFORCE(IsSameDataType(tensor.Get<Tensor>()),
+                "TensorSeq: tensor to be added has a different data type.");
+    tensors_.push_back(tensor);
   }
 
   void Reserve(size_t capacity) {
@@ -73,6 +121,11 @@ class TensorSeq {
   }
 
  private:
+  static OrtValue ToOrtValue(Tensor&& tensor) {
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    return OrtValue(std::make_unique<Tensor>(std::move(tensor)).release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  }
+
   // A sequence must be associated with only one data type and all tensors in the seq must be of that type
   // One other alternative of storing the data type of a seq is to templatize the TensorSeq class.
   // The current design follows the Tensor methodology.
@@ -82,7 +135,7 @@ class TensorSeq {
 
   // TODO: optimization opportunity - if all tensors in the seq are scalars, we can potentially represent them
   // as vector<primitive type>
-  std::vector<Tensor> tensors_;
+  std::vector<OrtValue> tensors_;
 };
 
 }  // namespace onnxruntime
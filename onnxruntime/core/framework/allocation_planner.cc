@@ -104,6 +104,9 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
     out << std::endl;
   }
 
+  out << "Outputs written in place: " << plan.num_inplace_outputs
+      << ", outputs reusing a freed buffer: " << plan.num_reused_outputs << std::endl;
+
   out << "\nExecution Plan:\n";
   for (size_t i = 0; i < plan.execution_plan.size(); ++i) {
     auto& step = plan.execution_plan[i];
@@ -209,6 +212,11 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // Values used by nodes on different compute streams, indexed by OrtValueIndex. They are kept until the end of
+  // the execution as the memory freed after the last use on one stream could be reused on another while the
+  // other stream is still using it.
+  std::vector<bool> cross_stream_values_;
+
   OrtValueIndex Index(const OrtValueName& name) {
     OrtValueIndex result;
     auto status = ort_value_name_idx_map_.GetIdx(name, result);
@@ -396,14 +404,26 @@ class PlannerImpl {
     return false;
   }
 
+  // Leading dimensions of 1 change neither the size nor the layout of a tensor, so shapes that only differ in them,
+  // like the shapes of an input and the output of a broadcasting op often do, are treated as the same.
+  static int FirstNonUnitDim(const TensorShapeProto& shape) {
+    int i = 0;
+    while (i < shape.dim_size() && utils::HasDimValue(shape.dim(i)) && shape.dim(i).dim_value() == 1) {
+      ++i;
+    }
+    return i;
+  }
+
   static bool SameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
     // TODO: This should probably be defined to be the equality operator on TensorShapeProto.
     namespace on = ONNX_NAMESPACE;
-    int rank1 = shape1.dim_size();
-    if (shape2.dim_size() != rank1) return false;
+    const int first1 = FirstNonUnitDim(shape1);
+    const int first2 = FirstNonUnitDim(shape2);
+    int rank1 = shape1.dim_size() - first1;
+    if (shape2.dim_size() - first2 != rank1) return false;
     for (int i = 0; i < rank1; i++) {
-      const auto& val1 = shape1.dim(i);
-      const auto& val2 = shape2.dim(i);
+      const auto& val1 = shape1.dim(first1 + i);
+      const auto& val2 = shape2.dim(first2 + i);
       if (utils::HasDimValue(val1) && utils::HasDimValue(val2) &&
           (val1.dim_value() == val2.dim_value()))
         continue;  // same known dimension
@@ -521,6 +541,110 @@ class PlannerImpl {
 
     // Initialize allocation plan:
     plan_.allocation_plan.resize(num_ml_values);
+
+    cross_stream_values_.assign(num_ml_values, false);
+  }
+
+  // Spreads the nodes of a provider with several compute streams over its streams so that independent branches
+  // of the graph run concurrently: a node continues the stream of its first producer that no other consumer
+  // continues yet, and the nodes starting a new branch take the streams round robin.
+  // Nested subgraphs, and nodes with subgraphs, run on stream 0.
+  Status ComputeStreamAssignment() {
+    if (parent_node_ != nullptr) {
+      return Status::OK();
+    }
+
+    const IExecutionProvider* stream_provider = nullptr;
+    for (const auto& provider : execution_providers_) {
+      if (provider->GetComputeStreamCount() > 1) {
+        stream_provider = provider.get();
+        break;
+      }
+    }
+
+    if (stream_provider == nullptr) {
+      return Status::OK();
+    }
+
+    const int num_streams = stream_provider->GetComputeStreamCount();
+    const auto& provider_type = stream_provider->Type();
+    const size_t num_nodes = graph_viewer_.MaxNodeIndex();
+    plan_.compute_stream_provider = provider_type;
+    plan_.num_compute_streams = num_streams;
+    plan_.node_compute_stream.assign(num_nodes, 0);
+    plan_.node_stream_dependencies.assign(num_nodes, {});
+    plan_.node_signals_stream_event.assign(num_nodes, false);
+
+    std::vector<bool> stream_continued(num_nodes, false);
+    int next_stream = 0;
+    for (const auto& step : plan_.execution_plan) {
+      const auto* pnode = graph_viewer_.GetNode(step.node_index);
+      if (pnode->GetExecutionProviderType() != provider_type) {
+        continue;
+      }
+
+      int stream = -1;
+      if (pnode->ContainsSubgraph()) {
+        stream = 0;
+      } else {
+        for (auto it = pnode->InputEdgesBegin(), end = pnode->InputEdgesEnd(); it != end; ++it) {
+          const Node& producer = it->GetNode();
+          if (producer.GetExecutionProviderType() == provider_type && !stream_continued[producer.Index()]) {
+            stream = plan_.node_compute_stream[producer.Index()];
+            stream_continued[producer.Index()] = true;
+            break;
+          }
+        }
+
+        if (stream == -1) {
+          stream = next_stream;
+          next_stream = (next_stream + 1) % num_streams;
+        }
+      }
+
+      plan_.node_compute_stream[step.node_index] = stream;
+
+      auto& dependencies = plan_.node_stream_dependencies[step.node_index];
+      for (auto it = pnode->InputEdgesBegin(), end = pnode->InputEdgesEnd(); it != end; ++it) {
+        const Node& producer = it->GetNode();
+        if (producer.GetExecutionProviderType() == provider_type &&
+            plan_.node_compute_stream[producer.Index()] != stream &&
+            std::find(dependencies.begin(), dependencies.end(), producer.Index()) == dependencies.end()) {
+          dependencies.push_back(producer.Index());
+          plan_.node_signals_stream_event[producer.Index()] = true;
+        }
+      }
+    }
+
+    // Find the values that are used on more than one stream
+    std::vector<int> value_stream(ort_value_info_.size(), -1);
+    auto mark_value = [&](const NodeArg* def, int stream) {
+      if (!def->Exists()) {
+        return;
+      }
+      auto index = Index(def->Name());
+      if (index < 0) {
+        return;
+      }
+      if (value_stream[index] == -1) {
+        value_stream[index] = stream;
+      } else if (value_stream[index] != stream) {
+        cross_stream_values_[index] = true;
+      }
+    };
+
+    for (const auto& step : plan_.execution_plan) {
+      const auto* pnode = graph_viewer_.GetNode(step.node_index);
+      if (pnode->GetExecutionProviderType() != provider_type) {
+        continue;
+      }
+      const int stream = plan_.node_compute_stream[step.node_index];
+      for (const auto* def : pnode->InputDefs()) mark_value(def, stream);
+      for (const auto* def : pnode->ImplicitInputDefs()) mark_value(def, stream);
+      for (const auto* def : pnode->OutputDefs()) mark_value(def, stream);
+    }
+
+    return Status::OK();
   }
 
   bool HasExternalOutputs(const Node& node) const {
@@ -943,22 +1067,24 @@ class PlannerImpl {
               }
             }
           }
-        } else if (!context_.IsParallelExecutionEnabled() &&
+        } else if (!context_.IsParallelExecutionEnabled() && !plan_.HasMultipleComputeStreams() &&
                    FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
           // and optional types if the kernel has marked certain inputs as
           // possible candidates for re-use
           Reuse(reused, current, AllocKind::kReuse);
+          ++plan_.num_inplace_outputs;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
           InplaceReuse(reused, current);
 #endif
         } else if (IsNonTensor(*node_output)) {
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
           AllocPlan(current).program_counter.AddStart(program_counter);
-        } else if (!context_.IsParallelExecutionEnabled() &&
+        } else if (!context_.IsParallelExecutionEnabled() && !plan_.HasMultipleComputeStreams() &&
                    FindReusableTensor(*node_output, &reused)) {
-          // Reuse an available (dead) buffer for this output, this is only for sequential execution.
+          // Reuse an available (dead) buffer for this output, this is only for sequential execution on one stream.
           Reuse(reused, current, AllocKind::kReuse);
+          ++plan_.num_reused_outputs;
           OrtValueIndex original = Buffer(reused);
           if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
             AllocPlan(original).program_counter.AddStart(program_counter);
@@ -985,7 +1111,9 @@ class PlannerImpl {
           }
 #endif
           if ((original != -1) && (0 == DecrementUseCount(original))) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
+            if (!cross_stream_values_[original]) {
+              freelist_.push_front(FreeBufferInfo(original, program_counter));
+            }
             if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
               AllocPlan(original).program_counter.AddEnd(program_counter);
             }
@@ -1007,7 +1135,9 @@ class PlannerImpl {
           }
 #endif
           if ((original != -1) && (0 == DecrementUseCount(original))) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
+            if (!cross_stream_values_[original]) {
+              freelist_.push_front(FreeBufferInfo(original, program_counter));
+            }
             if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
               AllocPlan(original).program_counter.AddEnd(program_counter);
             }
@@ -1029,7 +1159,9 @@ class PlannerImpl {
           }
 #endif
           if (0 == DecrementUseCount(original)) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
+            if (!cross_stream_values_[original]) {
+              freelist_.push_front(FreeBufferInfo(original, program_counter));
+            }
             if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
               AllocPlan(original).program_counter.AddEnd(program_counter);
             }
@@ -1240,6 +1372,9 @@ Status PlannerImpl::CreatePlan() {
   // compute use counts for all ml-values
   ORT_RETURN_IF_ERROR(ComputeUseCounts());
 
+  // assign the nodes of a provider with several compute streams to its streams
+  ORT_RETURN_IF_ERROR(ComputeStreamAssignment());
+
   // determine sharing/reuse among ml-values
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
 
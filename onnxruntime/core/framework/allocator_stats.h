@@ -22,6 +22,10 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_small_alloc_cache_hits;    // Number of allocations served by the small allocation cache.
+  int64_t num_small_alloc_cache_misses;  // Number of small allocations that fell back to the arena.
+  int64_t bytes_reserved;                // Bytes the memory pool holds from the device (Relevant only for pool based allocators)
+  int64_t max_bytes_reserved;            // The maximum bytes held by the memory pool.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +39,10 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_small_alloc_cache_hits = 0;
+    this->num_small_alloc_cache_misses = 0;
+    this->bytes_reserved = 0;
+    this->max_bytes_reserved = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +55,11 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumSmallAllocCacheHits:   " << this->num_small_alloc_cache_hits << "\n"
+       << "NumSmallAllocCacheMisses: " << this->num_small_alloc_cache_misses << "\n"
+       << "Reserved:                 " << this->bytes_reserved << "\n"
+       << "MaxReserved:              " << this->max_bytes_reserved << "\n";
     return ss.str();
   }
 };
@@ -47,13 +47,37 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
         return nullptr;
     }
 
+    ArenaSmallAllocCacheStrategy small_alloc_cache_str;
+    switch (info.arena_cfg.small_alloc_cache_strategy) {
+      case static_cast<int>(ArenaSmallAllocCacheStrategy::kPerThreadCache):
+        small_alloc_cache_str = ArenaSmallAllocCacheStrategy::kPerThreadCache;
+        break;
+      case -1:  // default value supplied by user
+      case static_cast<int>(ArenaSmallAllocCacheStrategy::kNone):
+        small_alloc_cache_str = BFCArena::DEFAULT_SMALL_ALLOC_CACHE_STRATEGY;
+        break;
+      default:
+        LOGS_DEFAULT(ERROR) << "Received invalid value of small_alloc_cache_strategy "
+                            << info.arena_cfg.small_alloc_cache_strategy;
+        return nullptr;
+    }
+    int small_alloc_cache_bytes = info.arena_cfg.small_alloc_cache_bytes == -1
+                                      ? BFCArena::DEFAULT_SMALL_ALLOC_CACHE_BYTES
+                                      : info.arena_cfg.small_alloc_cache_bytes;
+
     return AllocatorPtr(
         std::make_unique<BFCArena>(std::move(device_allocator),
                                    max_mem,
                                    arena_extend_str,
                                    initial_chunk_size_bytes,
                                    max_dead_bytes_per_chunk,
-                                   initial_growth_chunk_size_bytes));
+                                   initial_growth_chunk_size_bytes,
+                                   small_alloc_cache_str,
+                                   small_alloc_cache_bytes,
+                                   info.arena_cfg.numa_node,
+                                   info.arena_cfg.idle_shrink_ms,
+                                   info.arena_cfg.shrink_high_water_bytes,
+                                   info.arena_cfg.use_huge_pages == 1));
   } else {
     return device_allocator;
   }
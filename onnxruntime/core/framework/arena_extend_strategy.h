@@ -12,4 +12,13 @@ enum class ArenaExtendStrategy : int32_t {
   kSameAsRequested,
 };
 
+// Controls whether small allocations are served by a front-end cache that sits in front of the arena.
+enum class ArenaSmallAllocCacheStrategy : int32_t {
+  kNone = 0,
+  // Small size classes are carved out of a dedicated slab region and served from per-thread free lists
+  // without taking the arena-wide lock. Blocks move between the per-thread lists and a shared per-class
+  // depot in batches.
+  kPerThreadCache,
+};
+
 }  // namespace onnxruntime
@@ -3,6 +3,9 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include "core/common/profiler.h"
+#include "core/platform/probes.h"
+#include "core/platform/env.h"
 #include <type_traits>
 
 namespace onnxruntime {
@@ -11,7 +14,13 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
-                   int initial_growth_chunk_size_bytes)
+                   int initial_growth_chunk_size_bytes,
+                   ArenaSmallAllocCacheStrategy small_alloc_cache_strategy,
+                   int small_alloc_cache_bytes,
+                   int numa_node,
+                   int idle_shrink_ms,
+                   size_t shrink_high_water_bytes,
+                   bool use_huge_pages)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -22,13 +31,31 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
-      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes) {
+      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
+      // round the cache region down to whole slabs
+      small_alloc_cache_bytes_((static_cast<size_t>(std::max(small_alloc_cache_bytes, 0)) / SmallAllocCache::kSlabSize) *
+                               SmallAllocCache::kSlabSize),
+      // only CPU memory can be placed on a NUMA node
+      numa_node_(device_allocator_->Info().device.Type() == OrtDevice::CPU ? numa_node : -1),
+      use_huge_pages_(device_allocator_->Info().device.Type() == OrtDevice::CPU && use_huge_pages),
+      idle_shrink_ms_(idle_shrink_ms),
+      shrink_high_water_bytes_(shrink_high_water_bytes) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy)
+                     << " small_alloc_cache_strategy: " << static_cast<int32_t>(small_alloc_cache_strategy)
+                     << " small_alloc_cache_bytes: " << small_alloc_cache_bytes_
+                     << " numa_node: " << numa_node_
+                     << " use_huge_pages: " << use_huge_pages_
+                     << " idle_shrink_ms: " << idle_shrink_ms_
+                     << " shrink_high_water_bytes: " << shrink_high_water_bytes_;
+
+  if (small_alloc_cache_strategy == ArenaSmallAllocCacheStrategy::kPerThreadCache && small_alloc_cache_bytes_ > 0) {
+    small_alloc_cache_ = std::make_unique<SmallAllocCache>();
+  }
 
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
@@ -71,9 +98,23 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  // An idle period of 0 shrinks the arena right away in Free() and needs no thread.
+  if (idle_shrink_ms_ > 0) {
+    idle_shrink_thread_ = std::thread([this]() { IdleShrinkLoop(); });
+  }
 }
 
 BFCArena::~BFCArena() {
+  if (idle_shrink_thread_.joinable()) {
+    {
+      std::lock_guard<OrtMutex> lock(lock_);
+      stop_idle_shrink_ = true;
+    }
+    idle_shrink_cv_.notify_one();
+    idle_shrink_thread_.join();
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -82,6 +123,10 @@ BFCArena::~BFCArena() {
     device_allocator_->Free(reserve_chunk.first);
   }
 
+  if (small_alloc_cache_ && small_alloc_cache_->IsInitialized()) {
+    device_allocator_->Free(small_alloc_cache_->Region());
+  }
+
   for (BinNum b = 0; b < kNumBins; b++) {
     BinFromIndex(b)->~Bin();
   }
@@ -158,6 +203,13 @@ Status BFCArena::Extend(size_t rounded_bytes) {
   };
 
   size_t bytes = get_extend_bytes(rounded_bytes);
+  if (use_huge_pages_) {
+    // a region smaller than a huge page can't be backed by one
+    const size_t huge_page_bytes = (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    if (huge_page_bytes <= available_bytes) {
+      bytes = huge_page_bytes;
+    }
+  }
   // Try allocating.
   void* mem_addr = safe_alloc(bytes);
 
@@ -195,6 +247,7 @@ Status BFCArena::Extend(size_t rounded_bytes) {
   }
 
   LOGS_DEFAULT(INFO) << "Extended allocation by " << bytes << " bytes.";
+  PlaceOnNumaNode(mem_addr, bytes);
 
   stats_.total_allocated_bytes += bytes;
   LOGS_DEFAULT(INFO) << "Total allocated bytes: "
@@ -255,7 +308,20 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
-  return AllocateRawInternal(size, false);
+  // record the allocations of the runs profiled in ring buffer mode, a slow one usually means the arena was extended
+  profiling::Profiler* profiler = profiling::Profiler::Current();
+  if (profiler == nullptr) {
+    void* ptr = AllocateRawInternal(size, false);
+    ORT_PROBE3(alloc, device_allocator_->Info().name, ptr, size);
+    return ptr;
+  }
+
+  const auto start_time = std::chrono::high_resolution_clock::now();
+  void* ptr = AllocateRawInternal(size, false);
+  profiler->RecordEvent(profiling::MEMORY_EVENT, "arena_alloc", start_time,
+                        {{"allocator", device_allocator_->Info().name}, {"size", std::to_string(size)}});
+  ORT_PROBE3(alloc, device_allocator_->Info().name, ptr, size);
+  return ptr;
 }
 
 void* BFCArena::Reserve(size_t size) {
@@ -267,6 +333,7 @@ void* BFCArena::Reserve(size_t size) {
   LOGS_DEFAULT(INFO) << "Reserving memory in BFCArena for " << device_allocator_->Info().name << " size: " << size;
 
   void* ptr = device_allocator_->Alloc(size);
+  PlaceOnNumaNode(ptr, size);
   ORT_ENFORCE(reserved_chunks_.find(ptr) == reserved_chunks_.end());
   reserved_chunks_.insert(std::pair<void*, size_t>(ptr, size));
   stats_.bytes_in_use += size;
@@ -279,6 +346,11 @@ void* BFCArena::Reserve(size_t size) {
 }
 
 size_t BFCArena::RequestedSize(const void* ptr) {
+  // the small allocation cache does not track the requested size so report the size of the block
+  if (small_alloc_cache_ && small_alloc_cache_->Contains(ptr)) {
+    return small_alloc_cache_->BlockSize(ptr);
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -287,6 +359,10 @@ size_t BFCArena::RequestedSize(const void* ptr) {
 }
 
 size_t BFCArena::AllocatedSize(const void* ptr) {
+  if (small_alloc_cache_ && small_alloc_cache_->Contains(ptr)) {
+    return small_alloc_cache_->BlockSize(ptr);
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -305,10 +381,23 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  // Small allocations are served by the front-end cache without taking lock_ if it is enabled.
+  // If the cache has run out of slabs we fall through to the regular arena.
+  if (small_alloc_cache_ && SmallAllocCache::IsSmall(rounded_bytes)) {
+    std::call_once(small_alloc_cache_init_flag_, [this]() { InitializeSmallAllocCache(); });
+    if (small_alloc_cache_->IsInitialized()) {
+      void* ptr = small_alloc_cache_->Alloc(rounded_bytes);
+      if (ptr != nullptr) {
+        return ptr;
+      }
+    }
+  }
+
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+  idle_shrink_pending_ = false;
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
     return ptr;
@@ -342,9 +431,69 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   ORT_THROW(status.ErrorMessage());
 }
 
+void BFCArena::PlaceOnNumaNode(void* region, size_t bytes) {
+  if (region == nullptr) {
+    return;
+  }
+
+  // both are performance hints, so a failure only costs locality or TLB misses
+  if (use_huge_pages_) {
+    auto status = Env::Default().AdviseHugePages(region, bytes);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to back BFCArena region for " << device_allocator_->Info().name
+                            << " with huge pages: " << status.ErrorMessage();
+    }
+  }
+
+  if (numa_node_ < 0) {
+    return;
+  }
+
+  auto status = Env::Default().BindMemoryToNumaNode(region, bytes, numa_node_);
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Failed to place BFCArena region for " << device_allocator_->Info().name
+                          << " on NUMA node " << numa_node_ << ": " << status.ErrorMessage();
+  }
+}
+
+void BFCArena::InitializeSmallAllocCache() {
+  std::lock_guard<OrtMutex> lock(lock_);
+
+  // the cache region counts against the memory limit like any other region
+  size_t available_bytes = memory_limit_ - static_cast<size_t>(stats_.total_allocated_bytes);
+  if (small_alloc_cache_bytes_ > available_bytes) {
+    LOGS_DEFAULT(WARNING) << "Not enough memory left in BFCArena for " << device_allocator_->Info().name
+                          << " to create the small allocation cache of " << small_alloc_cache_bytes_
+                          << " bytes. Small allocations will be served by the arena.";
+    return;
+  }
+
+  void* region = device_allocator_->Alloc(small_alloc_cache_bytes_);
+  if (region == nullptr) {
+    LOGS_DEFAULT(WARNING) << "Failed to allocate the small allocation cache for BFCArena for "
+                          << device_allocator_->Info().name << ". Small allocations will be served by the arena.";
+    return;
+  }
+
+  PlaceOnNumaNode(region, small_alloc_cache_bytes_);
+  small_alloc_cache_->Initialize(region, small_alloc_cache_bytes_);
+  stats_.total_allocated_bytes += small_alloc_cache_bytes_;
+
+  LOGS_DEFAULT(INFO) << "Created small allocation cache of " << small_alloc_cache_bytes_
+                     << " bytes for BFCArena for " << device_allocator_->Info().name;
+}
+
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+
+  if (small_alloc_cache_) {
+    stats->num_small_alloc_cache_hits = small_alloc_cache_->NumHits();
+    stats->num_small_alloc_cache_misses = small_alloc_cache_->NumMisses();
+    stats->num_allocs += stats->num_small_alloc_cache_hits;
+    stats->bytes_in_use += small_alloc_cache_->BytesInUse();
+    stats->max_bytes_in_use = std::max(stats->max_bytes_in_use, stats->bytes_in_use);
+  }
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -432,6 +581,14 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  ORT_PROBE2(free, device_allocator_->Info().name, p);
+
+  if (small_alloc_cache_ && small_alloc_cache_->Contains(p)) {
+    small_alloc_cache_->Free(p);
+    return;
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -439,13 +596,72 @@ void BFCArena::Free(void* p) {
     stats_.bytes_in_use -= it->second;
     stats_.total_allocated_bytes -= it->second;
     reserved_chunks_.erase(it);
+    ShrinkAfterFree(p, true);
   } else {
     DeallocateRawInternal(p);
+    ShrinkAfterFree(p, false);
+  }
+}
+
+void BFCArena::ShrinkAfterFree(const void* p, bool is_reserved_chunk) {
+  // Above the high-water mark, free the region of p if p was the last chunk in use in it.
+  // The freed chunk was coalesced with its free neighbors, so the region is unused if its first chunk spans all of it.
+  if (!is_reserved_chunk && shrink_high_water_bytes_ > 0 &&
+      static_cast<size_t>(stats_.total_allocated_bytes) > shrink_high_water_bytes_) {
+    const AllocationRegion* region = region_manager_.region_for(p);
+    if (consider_first_allocation_region_for_shrinkage_ || region->id() != 0) {
+      void* region_ptr = region->ptr();
+      size_t region_size = region->memory_size();
+      const Chunk* c = ChunkFromHandle(region_manager_.get_handle(region_ptr));
+      if (!c->in_use() && c->size == region_size) {
+        FreeRegion(region_ptr, region_size);
+        curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+      }
+    }
+  }
+
+  if (idle_shrink_ms_ >= 0 && stats_.bytes_in_use == 0) {
+    if (idle_shrink_ms_ == 0) {
+      ShrinkInternal();
+    } else {
+      idle_shrink_pending_ = true;
+      idle_since_ = std::chrono::steady_clock::now();
+      idle_shrink_cv_.notify_one();
+    }
+  }
+}
+
+void BFCArena::IdleShrinkLoop() {
+  std::unique_lock<OrtMutex> lock(lock_);
+  while (!stop_idle_shrink_) {
+    if (!idle_shrink_pending_) {
+      idle_shrink_cv_.wait(lock);
+      continue;
+    }
+
+    // An allocation during the wait clears idle_shrink_pending_, and a later Free() that leaves the arena idle
+    // again moves idle_since_, so the deadline is recomputed after every wake up.
+    const auto deadline = idle_since_ + std::chrono::milliseconds(idle_shrink_ms_);
+    const auto now = std::chrono::steady_clock::now();
+    if (now < deadline) {
+      idle_shrink_cv_.wait_for(lock, deadline - now);
+      continue;
+    }
+
+    idle_shrink_pending_ = false;
+    LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena was idle for " << idle_shrink_ms_
+                          << " ms. Shrinking it.";
+    ShrinkInternal();
   }
 }
 
 Status BFCArena::Shrink() {
   std::lock_guard<OrtMutex> lock(lock_);
+  ShrinkInternal();
+  return Status::OK();
+}
+
+void BFCArena::ShrinkInternal() {
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
@@ -461,41 +677,8 @@ Status BFCArena::Shrink() {
 
   size_t i = 0;
   for (void* region_ptr : region_ptrs) {
-    bool deallocate_region = true;
-    ChunkHandle region_begin_chunk = region_manager_.get_handle(region_ptr);
-    ChunkHandle h = region_begin_chunk;
-    while (h != kInvalidChunkHandle) {
-      const Chunk* c = ChunkFromHandle(h);
-      if (c->in_use()) {
-        // at-least one used chunk found in the allocation region -
-        // so we cannot deallocate it
-        deallocate_region = false;
-        break;
-      }
-      h = c->next;
-    }
-
-    if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
-      stats_.num_arena_shrinkages += 1;
-      stats_.total_allocated_bytes -= shrink_size;
-
-      LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
-                            << shrink_size << " bytes. "
-                            << " The total allocated bytes is now " << stats_.total_allocated_bytes;
-
-      h = region_begin_chunk;
-      ChunkHandle temp = region_begin_chunk;
-      while (h != kInvalidChunkHandle) {
-        const Chunk* c = ChunkFromHandle(h);
-        temp = c->next;
-        RemoveFreeChunkFromBin(h);
-        DeleteChunk(h);
-        h = temp;
-      }
-
-      device_allocator_->Free(region_ptr);
-      region_manager_.RemoveAllocationRegion(region_ptr);
+    if (IsRegionUnused(region_ptr)) {
+      FreeRegion(region_ptr, region_sizes[i]);
     }
 
     ++i;
@@ -504,8 +687,43 @@ Status BFCArena::Shrink() {
   // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
   // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
   curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+}
 
-  return Status::OK();
+bool BFCArena::IsRegionUnused(void* region_ptr) {
+  ChunkHandle h = region_manager_.get_handle(region_ptr);
+  while (h != kInvalidChunkHandle) {
+    const Chunk* c = ChunkFromHandle(h);
+    if (c->in_use()) {
+      // at-least one used chunk found in the allocation region -
+      // so we cannot deallocate it
+      return false;
+    }
+    h = c->next;
+  }
+
+  return true;
+}
+
+void BFCArena::FreeRegion(void* region_ptr, size_t region_size) {
+  stats_.num_arena_shrinkages += 1;
+  stats_.total_allocated_bytes -= region_size;
+
+  LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
+                        << region_size << " bytes. "
+                        << " The total allocated bytes is now " << stats_.total_allocated_bytes;
+
+  ChunkHandle h = region_manager_.get_handle(region_ptr);
+  ChunkHandle temp = h;
+  while (h != kInvalidChunkHandle) {
+    const Chunk* c = ChunkFromHandle(h);
+    temp = c->next;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    h = temp;
+  }
+
+  device_allocator_->Free(region_ptr);
+  region_manager_.RemoveAllocationRegion(region_ptr);
 }
 
 void BFCArena::DeallocateRawInternal(void* ptr) {
@@ -16,9 +16,11 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "onnxruntime_config.h"
 
@@ -30,6 +32,7 @@ limitations under the License.
 #include "core/platform/ort_mutex.h"
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/allocator.h"
+#include "core/framework/small_alloc_cache.h"
 
 #if defined(PLATFORM_WINDOWS)
 #include <intrin.h>
@@ -57,13 +60,27 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const ArenaSmallAllocCacheStrategy DEFAULT_SMALL_ALLOC_CACHE_STRATEGY = ArenaSmallAllocCacheStrategy::kNone;
+  static const int DEFAULT_SMALL_ALLOC_CACHE_BYTES = static_cast<int>(SmallAllocCache::kDefaultRegionBytes);
+  static const int DEFAULT_NUMA_NODE = -1;
+  static const int DEFAULT_IDLE_SHRINK_MS = -1;
+  static const size_t DEFAULT_SHRINK_HIGH_WATER_BYTES = 0;
+  static const bool DEFAULT_USE_HUGE_PAGES = false;
+  // regions are grown in multiples of this when huge pages are used, so that most of each region can be backed by them
+  static const size_t kHugePageSize = 2 * 1024 * 1024;
 
   BFCArena(std::unique_ptr<IAllocator> resource_allocator,
            size_t total_memory,
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
-           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES);
+           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+           ArenaSmallAllocCacheStrategy small_alloc_cache_strategy = DEFAULT_SMALL_ALLOC_CACHE_STRATEGY,
+           int small_alloc_cache_bytes = DEFAULT_SMALL_ALLOC_CACHE_BYTES,
+           int numa_node = DEFAULT_NUMA_NODE,
+           int idle_shrink_ms = DEFAULT_IDLE_SHRINK_MS,
+           size_t shrink_high_water_bytes = DEFAULT_SHRINK_HIGH_WATER_BYTES,
+           bool use_huge_pages = DEFAULT_USE_HUGE_PAGES);
 
   ~BFCArena() override;
 
@@ -83,6 +100,12 @@ class BFCArena : public IAllocator {
   // and the allocation request.
   Status Shrink();
 
+  // The arena also shrinks on its own if configured to:
+  // - idle_shrink_ms >= 0: once no memory is in use, the unused regions are freed after idle_shrink_ms milliseconds
+  //   without allocations, so that memory goes back to the device between bursts of requests.
+  // - shrink_high_water_bytes > 0: while more than shrink_high_water_bytes are allocated from the device, a region is
+  //   freed as soon as its last chunk is.
+
   void* Reserve(size_t size) override;
 
   FencePtr CreateFence(const SessionState* session_state) override {
@@ -100,6 +123,29 @@ class BFCArena : public IAllocator {
   void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
   void DeallocateRawInternal(void* ptr);
 
+  // Places the pages of a newly allocated region on numa_node_, if one was requested, and asks for them to be backed
+  // by huge pages if use_huge_pages_ is set.
+  void PlaceOnNumaNode(void* region, size_t bytes);
+
+  // Frees the allocation regions in which no chunk is in use. lock_ must be held.
+  void ShrinkInternal();
+
+  // True if no chunk in the region starting at region_ptr is in use. lock_ must be held.
+  bool IsRegionUnused(void* region_ptr);
+
+  // Returns an unused region to the device allocator. lock_ must be held.
+  void FreeRegion(void* region_ptr, size_t region_size);
+
+  // Applies the automatic shrink policies after `p` was freed. lock_ must be held.
+  void ShrinkAfterFree(const void* p, bool is_reserved_chunk);
+
+  // Body of idle_shrink_thread_, which shrinks the arena once it has been idle for idle_shrink_ms_.
+  void IdleShrinkLoop();
+
+  // Allocates the slab region backing small_alloc_cache_ from the device allocator.
+  // Called once, on the first small allocation.
+  void InitializeSmallAllocCache();
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -308,6 +354,8 @@ class BFCArena : public IAllocator {
 
     const std::vector<AllocationRegion>& regions() const { return regions_; }
 
+    const AllocationRegion* region_for(const void* p) const { return RegionFor(p); }
+
    private:
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RegionManager);
 
@@ -469,11 +517,33 @@ class BFCArena : public IAllocator {
   const int max_dead_bytes_per_chunk_;
   const int initial_growth_chunk_size_bytes_;
 
+  // Front-end for small allocations. nullptr unless the kPerThreadCache strategy is selected.
+  std::unique_ptr<SmallAllocCache> small_alloc_cache_;
+  const size_t small_alloc_cache_bytes_;
+  std::once_flag small_alloc_cache_init_flag_;
+
+  // NUMA node the regions are placed on, or -1 to leave placement to the OS.
+  const int numa_node_;
+
+  // Whether to back the regions with huge pages. Only set for CPU memory.
+  const bool use_huge_pages_;
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
   bool consider_first_allocation_region_for_shrinkage_;
 
+  // Automatic shrink policies. See the comment of Shrink().
+  const int idle_shrink_ms_;
+  const size_t shrink_high_water_bytes_;
+
+  // Set when the last chunk in use is freed and cleared by the next allocation.
+  bool idle_shrink_pending_ = false;
+  std::chrono::steady_clock::time_point idle_since_;
+  bool stop_idle_shrink_ = false;
+  OrtCondVar idle_shrink_cv_;
+  std::thread idle_shrink_thread_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/compute_stream_scheduler.h"
+
+#include "core/framework/execution_providers.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+
+ComputeStreamScheduler::ComputeStreamScheduler(const SessionState& session_state)
+    : plan_(*session_state.GetExecutionPlan()) {
+  if (plan_.HasMultipleComputeStreams()) {
+    provider_ = session_state.GetExecutionProviders().Get(plan_.compute_stream_provider);
+    node_events_.assign(plan_.node_compute_stream.size(), nullptr);
+  }
+}
+
+ComputeStreamScheduler::~ComputeStreamScheduler() {
+  if (provider_ == nullptr) {
+    return;
+  }
+
+  // the execution failed before End(), don't leave work of the other streams unordered with the next execution
+  if (begun_) {
+    ORT_IGNORE_RETURN_VALUE(End());
+  }
+
+  for (void* event : node_events_) {
+    if (event != nullptr) {
+      provider_->ReleaseStreamEvent(event);
+    }
+  }
+}
+
+Status ComputeStreamScheduler::Begin() {
+  if (provider_ == nullptr) {
+    return Status::OK();
+  }
+
+  void* event = nullptr;
+  ORT_RETURN_IF_ERROR(provider_->RecordStreamEvent(0, &event));
+  Status status;
+  for (int stream = 1; stream < plan_.num_compute_streams && status.IsOK(); ++stream) {
+    status = provider_->WaitStreamEvent(stream, event);
+  }
+  provider_->ReleaseStreamEvent(event);
+  begun_ = status.IsOK();
+  return status;
+}
+
+Status ComputeStreamScheduler::BeforeCompute(NodeIndex node_index) {
+  if (provider_ == nullptr) {
+    return Status::OK();
+  }
+
+  // nodes of other providers have no stream and don't wait as their kernels synchronize with the host
+  const int stream = plan_.node_compute_stream[node_index];
+  for (NodeIndex dependency : plan_.node_stream_dependencies[node_index]) {
+    ORT_RETURN_IF_ERROR(provider_->WaitStreamEvent(stream, node_events_[dependency]));
+  }
+
+  if (UsesStream(node_index)) {
+    ORT_RETURN_IF_ERROR(provider_->SetCurrentComputeStream(stream));
+  }
+
+  return Status::OK();
+}
+
+Status ComputeStreamScheduler::AfterCompute(NodeIndex node_index) {
+  if (provider_ == nullptr) {
+    return Status::OK();
+  }
+
+  if (plan_.node_signals_stream_event[node_index]) {
+    ORT_RETURN_IF_ERROR(provider_->RecordStreamEvent(plan_.node_compute_stream[node_index],
+                                                     &node_events_[node_index]));
+  }
+
+  if (UsesStream(node_index)) {
+    ORT_RETURN_IF_ERROR(provider_->SetCurrentComputeStream(0));
+  }
+
+  return Status::OK();
+}
+
+void ComputeStreamScheduler::ResetStream() {
+  if (provider_ != nullptr) {
+    ORT_IGNORE_RETURN_VALUE(provider_->SetCurrentComputeStream(0));
+  }
+}
+
+Status ComputeStreamScheduler::End() {
+  if (provider_ == nullptr || !begun_) {
+    return Status::OK();
+  }
+
+  begun_ = false;
+  for (int stream = 1; stream < plan_.num_compute_streams; ++stream) {
+    void* event = nullptr;
+    ORT_RETURN_IF_ERROR(provider_->RecordStreamEvent(stream, &event));
+    Status status = provider_->WaitStreamEvent(0, event);
+    provider_->ReleaseStreamEvent(event);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
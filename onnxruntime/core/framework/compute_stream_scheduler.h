@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/sequential_execution_plan.h"
+
+namespace onnxruntime {
+
+class IExecutionProvider;
+class SessionState;
+
+// Runs the nodes of an execution plan with several compute streams on their streams
+// (see SequentialExecutionPlan::node_compute_stream) and orders dependent nodes on different streams with
+// stream events. An instance holds the events of one execution of the plan and may be used from several threads
+// as long as the nodes it is called for run in an order that respects their dependencies.
+// All the methods are no-ops if the plan uses a single stream.
+class ComputeStreamScheduler {
+ public:
+  explicit ComputeStreamScheduler(const SessionState& session_state);
+  ~ComputeStreamScheduler();
+
+  // Orders the work of all the streams after the work queued on stream 0 so far, e.g. the copies of the feeds.
+  Status Begin();
+
+  // Selects the stream of the node for the calling thread and waits for the nodes it depends on.
+  Status BeforeCompute(NodeIndex node_index);
+
+  // Records the event of the node if a node on another stream waits for it, and selects stream 0 again.
+  Status AfterCompute(NodeIndex node_index);
+
+  // Selects stream 0 again for the calling thread, e.g. when a node failed.
+  void ResetStream();
+
+  // Orders the work queued on stream 0 after this point, e.g. the copies of the fetches, after the work of all
+  // the streams.
+  Status End();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ComputeStreamScheduler);
+
+  bool UsesStream(NodeIndex node_index) const {
+    return provider_ != nullptr && plan_.node_compute_stream[node_index] != 0;
+  }
+
+  const SequentialExecutionPlan& plan_;
+  const IExecutionProvider* provider_{nullptr};
+  std::vector<void*> node_events_;
+  bool begun_{false};
+};
+
+}  // namespace onnxruntime
@@ -6,6 +6,10 @@
 namespace onnxruntime {
 
 TensorShapeVector StridesForTensor(const Tensor& tensor) {
+#ifdef ENABLE_TRAINING
+  // the tensor may be a strided view of the buffer of another tensor
+  return ToShapeVector(tensor.Strides());
+#else
   const auto& shape = tensor.Shape();
   TensorShapeVector strides(shape.NumDimensions());
   int64_t running_size = 1;
@@ -15,6 +19,7 @@ TensorShapeVector StridesForTensor(const Tensor& tensor) {
   }
 
   return strides;
+#endif
 }
 
 namespace {
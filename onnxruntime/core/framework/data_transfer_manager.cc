@@ -4,6 +4,7 @@
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/tensor.h"
 #include "core/framework/sparse_tensor.h"
+#include "core/platform/probes.h"
 
 namespace onnxruntime {
 using namespace common;
@@ -47,6 +48,7 @@ Status DataTransferManager::CopyTensor(const Tensor& src, Tensor& dst, int exec_
       continue;
     }
 
+    ORT_PROBE3(memcpy, src.Location().device.Type(), dst.Location().device.Type(), src.SizeInBytes());
     return data_transfer->CopyTensor(src, dst, exec_queue_id);
   }
 
@@ -115,6 +117,9 @@ common::Status DataTransferManager::CopyTensors(const std::vector<IDataTransfer:
 
   // all copies are between the same devices so we can do them all at once
   if (all_same) {
+    for (const auto& pair : src_dst_pairs) {
+      ORT_PROBE3(memcpy, src_device.Type(), dst_device.Type(), pair.src.get().SizeInBytes());
+    }
     return first_dt->CopyTensors(src_dst_pairs);
   }
 
@@ -123,6 +128,7 @@ common::Status DataTransferManager::CopyTensors(const std::vector<IDataTransfer:
   // batch as much as possible.
 
   // copy the first one as we already did the IDataTransfer lookup
+  ORT_PROBE3(memcpy, src_device.Type(), dst_device.Type(), first_pair.src.get().SizeInBytes());
   ORT_RETURN_IF_ERROR(first_dt->CopyTensor(first_pair.src.get(), first_pair.dst.get(), first_pair.exec_queue_id));
 
   for (auto cur_pair = src_dst_pairs.cbegin() + 1, end_pair = src_dst_pairs.cend(); cur_pair != end_pair; ++cur_pair) {
@@ -3,6 +3,7 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
@@ -38,7 +39,6 @@ IExecutionFrame::IExecutionFrame(const OrtValueNameIdxMap& ort_value_idx_map,
 
 IExecutionFrame::~IExecutionFrame() = default;
 
-#ifdef ENABLE_TRAINING
 Status IExecutionFrame::SetOutputMLValue(int index, const OrtValue& ort_value) {
   int ort_value_idx = GetNodeIdxToMLValueIdx(index);
   if (ort_value_idx == NodeIndexInfo::kInvalidEntry || static_cast<size_t>(ort_value_idx) >= all_values_size_) {
@@ -50,6 +50,7 @@ Status IExecutionFrame::SetOutputMLValue(int index, const OrtValue& ort_value) {
   return Status::OK();
 }
 
+#ifdef ENABLE_TRAINING
 void IExecutionFrame::UpdateFeeds(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds) {
   ORT_ENFORCE(feed_mlvalue_idxs.size() == feeds.size());
 
@@ -370,7 +371,10 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
-  if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
+  // The patterns assume the nodes run one after the other, so they can't be used if nodes run on several
+  // compute streams.
+  if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan() &&
+      !session_state.GetExecutionPlan()->HasMultipleComputeStreams()) {
     bool all_tensors = true;
     // Reserve mem to avoid re-allocation.
     for (const auto& feed : feeds) {
@@ -382,10 +386,12 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
 
     //if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_,
+                                                          min_mem_pattern_block_sizes_);
       // if no existing patterns, generate one in this executionframe
       if (!mem_patterns_) {
-        planner_ = std::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan());
+        planner_ = std::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan(), false,
+                                                            session_state.GetUseOfflineMemoryPatternPlanner());
       } else {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
@@ -414,7 +420,13 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
               // Memory dynamically allocated when executing kernels is not recorded using this field.
               static_activation_memory_sizes_in_byte_[location.name] = peak_size;
 #endif
-              buffer = alloc->Alloc(peak_size);
+              // leave the pattern blocks to the per-tensor allocations, which fail the run, if over budget.
+              auto budget_status = CheckMemoryBudget(alloc, peak_size);
+              if (budget_status.IsOK()) {
+                buffer = alloc->Alloc(peak_size);
+              } else {
+                LOGS(session_state_.Logger(), INFO) << budget_status.ErrorMessage();
+              }
               // handle allocator that doesn't throw
               if (buffer == nullptr) {
                 // INFO level as this may fire on every run and there may not be much a user can do
@@ -513,8 +525,9 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // with shape buckets the pattern is sized for the largest run seen in the bucket.
+          if (block->size_ == size || (session_state_.GetEnableMemoryPatternShapeBuckets() && size < block->size_)) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
@@ -529,6 +542,9 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
                                                    << ", block in memory pattern size is: " << block->size_
                                                    << " but the actually size is: " << size
                                                    << ", fall back to default allocation behavior";
+            if (session_state_.GetEnableMemoryPatternShapeBuckets() && size > block->size_) {
+              session_state_.MarkMemoryPatternGroupOutgrown(mem_patterns_.get(), ort_value_index, size);
+            }
           }
         }
         // else { we couldn't allocate the large block for the buffer so we didn't insert an entry }
@@ -538,6 +554,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
 
   //no memory pattern, or the pattern is not correct.
   if (!alloc) alloc = GetAllocator(location);
+  ORT_RETURN_IF_ERROR(CheckMemoryBudget(alloc, size));
   Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
 
   // trace the memory allocation.
@@ -561,6 +578,25 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   return Status::OK();
 }
 
+Status ExecutionFrame::CheckMemoryBudget(const AllocatorPtr& alloc, size_t size) const {
+  const size_t memory_budget = session_state_.GetMemoryBudget();
+  if (memory_budget == 0) {
+    return Status::OK();
+  }
+
+  // only allocators that keep statistics, i.e. the arenas, report the memory in use.
+  AllocatorStats stats;
+  alloc->GetStats(&stats);
+  const size_t bytes_in_use = static_cast<size_t>(std::max<int64_t>(stats.bytes_in_use, 0));
+  if (bytes_in_use + size > memory_budget) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Allocating ", size, " bytes on ", alloc->Info().name,
+                           " would exceed the session memory budget of ", memory_budget, " bytes. ", bytes_in_use,
+                           " bytes are in use.");
+  }
+
+  return Status::OK();
+}
+
 Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_value, int ort_value_index_reuse,
                                                               MLDataType element_type, const OrtMemoryInfo& location,
                                                               const TensorShape& shape, bool create_fence) {
@@ -830,6 +866,11 @@ void ExecutionFrame::TraceAllocate(int ort_value_idx, size_t size) {
         allocation_plan.alloc_kind == AllocKind::kAllocatedExternally) {
       return;
     }
+    // replacing an outgrown pattern, the blocks must fit the runs it served and the runs that outgrew it
+    auto min_size = min_mem_pattern_block_sizes_.find(ort_value_idx);
+    if (min_size != min_mem_pattern_block_sizes_.end()) {
+      size = std::max(size, min_size->second);
+    }
     auto status = planner_->TraceAllocation(ort_value_idx, size);
     if (!status.IsOK()) {
       LOGS(session_state_.Logger(), WARNING) << "TraceAllocation for ort_value_idx=" << ort_value_idx
@@ -870,7 +911,18 @@ Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup* out) const {
     return Status(ONNXRUNTIME, FAIL, "Memory pattern planner is not enabled on this execution framework.");
   }
 
-  return planner_->GeneratePatterns(out);
+  ORT_RETURN_IF_ERROR(planner_->GeneratePatterns(out));
+
+  for (size_t i = 0; i < out->locations.size(); i++) {
+    const auto& pattern = out->patterns[i];
+    if (pattern.PeakSize() > 0) {
+      LOGS(session_state_.Logger(), VERBOSE) << "Memory pattern for " << out->locations[i].ToString()
+                                             << ": peak size " << pattern.PeakSize() << " bytes, lower bound "
+                                             << pattern.LowerBoundSize() << " bytes";
+    }
+  }
+
+  return Status::OK();
 }
 
 bool ExecutionFrame::TryGetInferredShape(int index, TensorShape& shape) const {
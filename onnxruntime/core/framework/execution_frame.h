@@ -51,9 +51,10 @@ class IExecutionFrame {
   const OrtValue* GetNodeInputOrOutputMLValue(int index) const;
   OrtValue* GetMutableNodeInputOrOutputMLValue(int index);
 
-#ifdef ENABLE_TRAINING
   // Override the index-th output with ort_value
   Status SetOutputMLValue(int index, const OrtValue& ort_value);
+
+#ifdef ENABLE_TRAINING
   void UpdateFeeds(const std::vector<int>& feed_mlvalue_idxs, const std::vector<OrtValue>& feeds);
   void UpdateFetches(const std::vector<int>& fetch_mlvalue_idxs, const std::vector<OrtValue>& fetches,
                      const std::unordered_map<int, OrtValue>& initializers);
@@ -198,6 +199,9 @@ class ExecutionFrame final : public IExecutionFrame {
                                                   const OrtMemoryInfo& location, const TensorShape& shape,
                                                   bool create_fence);
 
+  // Fails if allocating `size` bytes from `alloc` would take its memory in use above the memory budget of the session.
+  Status CheckMemoryBudget(const AllocatorPtr& alloc, size_t size) const;
+
   Status AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer, MLDataType element_type,
                                                    const OrtMemoryInfo& location, const TensorShape& shape);
 
@@ -214,7 +218,11 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
+
+  // With memory pattern shape buckets, if a previous run outgrew the pattern of the bucket of the input shapes, the
+  // minimum size of each block of the new pattern traced by this frame by OrtValue index.
+  std::unordered_map<int, size_t> min_mem_pattern_block_sizes_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -5,6 +5,7 @@
 #include "core/common/inlined_containers.h"
 
 #include <queue>
+#include <string_view>
 
 #include "onnx/defs/data_type_utils.h"
 
@@ -36,8 +37,242 @@ static bool IsSmallInitializer(const onnxruntime::GraphViewer& graph, const Node
 
   return size <= kSmallInitializerThreshold;
 }
+
+// Fixed cost of a copy between the devices, i.e. the launch of the copy and the synchronization of the stream,
+// expressed in bytes copied.
+constexpr int64_t kCopyOverheadBytes = 16 * 1024;
+
+// Value assumed for a symbolic dimension when estimating the size of a tensor. The pass below targets the small
+// tensors around shape computations and unsupported nodes, where the overhead of the copy dominates.
+constexpr int64_t kSymbolicDimValue = 16;
+
+// Data movement operators the CPU EP implements for all the tensor types.
+const InlinedHashSet<std::string_view> kCheapDataMovementOps = {
+    "Cast", "Concat", "Expand", "Flatten", "Gather", "Identity", "Reshape", "Slice", "Squeeze", "Transpose",
+    "Unsqueeze"};
+
+// Element-wise operators the CPU EP implements for float.
+const InlinedHashSet<std::string_view> kCheapElementwiseOps = {
+    "Abs", "Add", "Div", "Mul", "Neg", "Relu", "Sigmoid", "Sqrt", "Sub", "Tanh"};
+
+int64_t ElementSize(int32_t elem_type) {
+  switch (elem_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+      return 1;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      return 2;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+      return 8;
+    default:
+      return 4;
+  }
+}
+
+int64_t EstimateBytes(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  const int64_t element_size = type != nullptr && type->has_tensor_type()
+                                   ? ElementSize(type->tensor_type().elem_type())
+                                   : 4;
+  int64_t num_elements = 1;
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    num_elements = kSymbolicDimValue;
+  } else {
+    for (const auto& dim : shape->dim()) {
+      num_elements *= dim.has_dim_value() && dim.dim_value() >= 0 ? dim.dim_value() : kSymbolicDimValue;
+    }
+  }
+  return num_elements * element_size;
+}
+
+// Moves the cheap tentative nodes to CPU as long as it lowers the estimated cost of the copies between the devices
+// by more than the cost of running them on CPU. This mainly saves the copies around a single node that runs on
+// CPU in the middle of the graph.
+void PlaceCheapNodesToAvoidCopies(const GraphViewer& graph,
+                                  const InlinedHashSet<NodeIndex>& provider_nodes,
+                                  const InlinedHashMap<NodeIndex, const KernelCreateInfo*>& node_to_kernel,
+                                  std::unordered_set<NodeIndex>& cpu_nodes) {
+  auto node_on_cpu = [&](const Node& node) {
+    if (cpu_nodes.count(node.Index()) > 0) {
+      return true;
+    }
+    if (provider_nodes.count(node.Index()) > 0) {
+      return false;
+    }
+    // unassigned nodes the target EP can't run fall back to CPU
+    const auto& node_provider = node.GetExecutionProviderType();
+    return node_provider.empty() || node_provider == kCpuExecutionProvider;
+  };
+
+  // number of copies of `arg` that are inserted if `moved` runs on CPU or not
+  auto count_copies = [&](const NodeArg& arg, const Node& moved, bool moved_on_cpu) {
+    const Node* producer = graph.GetProducerNode(arg.Name());
+    if (producer == nullptr) {
+      // graph inputs and initializers are copied where they are needed regardless of the placement
+      return 0;
+    }
+
+    auto is_on_cpu = [&](const Node& node) { return node.Index() == moved.Index() ? moved_on_cpu : node_on_cpu(node); };
+    auto kernel_it = node_to_kernel.find(producer->Index());
+    bool produced_on_cpu = is_on_cpu(*producer);
+    const auto& producer_outputs = producer->OutputDefs();
+    for (size_t i = 0; !produced_on_cpu && i < producer_outputs.size(); ++i) {
+      if (producer_outputs[i] == &arg && kernel_it != node_to_kernel.end()) {
+        produced_on_cpu = kernel_it->second->kernel_def->IsOutputOnCpu(i);
+      }
+    }
+
+    for (const Node* consumer : graph.GetConsumerNodes(arg.Name())) {
+      const bool consumer_on_cpu = is_on_cpu(*consumer);
+      kernel_it = node_to_kernel.find(consumer->Index());
+      const auto& consumer_inputs = consumer->InputDefs();
+      for (size_t i = 0; i < consumer_inputs.size(); ++i) {
+        if (consumer_inputs[i] != &arg) {
+          continue;
+        }
+        const bool consumed_on_cpu = consumer_on_cpu || (kernel_it != node_to_kernel.end() &&
+                                                         kernel_it->second->kernel_def->IsInputOnCpu(i));
+        if (consumed_on_cpu != produced_on_cpu) {
+          // transformer_memcpy inserts a single copy per value and direction
+          return 1;
+        }
+      }
+    }
+    return 0;
+  };
+
+  size_t num_moved = 0;
+  int64_t copies_avoided = 0;
+  int64_t bytes_avoided = 0;
+  const auto& ordered_nodes = graph.GetNodesInTopologicalOrder();
+  // a node only ever moves to CPU, so this reaches a fixed point
+  for (bool moved_any = true; moved_any;) {
+    moved_any = false;
+    for (NodeIndex node_index : ordered_nodes) {
+      if (provider_nodes.count(node_index) == 0 || cpu_nodes.count(node_index) > 0) {
+        continue;
+      }
+
+      const Node& node = *graph.GetNode(node_index);
+      const auto& kernel_def = *node_to_kernel.at(node_index)->kernel_def;
+      if (!IsCheapOnCpu(node)) {
+        continue;
+      }
+      bool has_cpu_output = false;
+      for (size_t i = 0; i < node.OutputDefs().size(); ++i) {
+        has_cpu_output = has_cpu_output || kernel_def.IsOutputOnCpu(i);
+      }
+      if (has_cpu_output) {
+        // the kernel already produces its CPU outputs without a copy
+        continue;
+      }
+
+      int copies_on_device = 0, copies_on_cpu = 0;
+      int64_t cost_on_device = 0, cost_on_cpu = EstimateCpuCost(node);
+      InlinedHashSet<const NodeArg*> args;
+      auto add_copies = [&](const NodeArg* arg) {
+        if (!arg->Exists() || !args.insert(arg).second) {
+          return;
+        }
+        const int64_t copy_cost = EstimateCopyCost(*arg);
+        const int device_copies = count_copies(*arg, node, false);
+        const int cpu_copies = count_copies(*arg, node, true);
+        copies_on_device += device_copies;
+        copies_on_cpu += cpu_copies;
+        cost_on_device += device_copies * copy_cost;
+        cost_on_cpu += cpu_copies * copy_cost;
+      };
+      for (const NodeArg* arg : node.InputDefs()) {
+        add_copies(arg);
+      }
+      for (const NodeArg* arg : node.OutputDefs()) {
+        add_copies(arg);
+      }
+
+      if (cost_on_cpu < cost_on_device) {
+        cpu_nodes.insert(node_index);
+        moved_any = true;
+        ++num_moved;
+        copies_avoided += copies_on_device - copies_on_cpu;
+        bytes_avoided += cost_on_device - cost_on_cpu;
+        LOGS_DEFAULT(VERBOSE) << "Placing node " << node.Name() << " (" << node.OpType() << ") on CPU saves "
+                              << copies_on_device - copies_on_cpu << " copies between the devices";
+      }
+    }
+  }
+
+  if (num_moved > 0) {
+    LOGS_DEFAULT(INFO) << "Transfer-aware placement moved " << num_moved << " nodes to CPU, avoiding "
+                       << copies_avoided << " copies between the devices (estimated saving: "
+                       << bytes_avoided << " bytes)";
+  }
+}
 }  // namespace
 
+bool IsCheapOnCpu(const Node& node) {
+  if (node.Domain() != kOnnxDomain) {
+    return false;
+  }
+  const bool is_data_movement = kCheapDataMovementOps.count(node.OpType()) > 0;
+  if (!is_data_movement && kCheapElementwiseOps.count(node.OpType()) == 0) {
+    return false;
+  }
+  if (node.ContainsSubgraph()) {
+    return false;
+  }
+
+  auto is_supported = [is_data_movement](const NodeArg* arg) {
+    if (!arg->Exists()) {
+      return true;
+    }
+    const auto* type = arg->TypeAsProto();
+    if (type == nullptr || !type->has_tensor_type()) {
+      return false;
+    }
+    const auto elem_type = type->tensor_type().elem_type();
+    if (elem_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16 ||
+        elem_type == ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16 ||
+        elem_type == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+      return false;
+    }
+    return is_data_movement || elem_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+  };
+
+  for (const NodeArg* arg : node.InputDefs()) {
+    if (!is_supported(arg)) {
+      return false;
+    }
+  }
+  for (const NodeArg* arg : node.OutputDefs()) {
+    if (!is_supported(arg)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t EstimateCopyCost(const NodeArg& arg) {
+  return kCopyOverheadBytes + EstimateBytes(arg);
+}
+
+int64_t EstimateCpuCost(const Node& node) {
+  // cheap nodes touch each output element about once
+  int64_t cost = 0;
+  for (const NodeArg* output : node.OutputDefs()) {
+    if (output->Exists()) {
+      cost += EstimateBytes(*output);
+    }
+  }
+  return cost;
+}
+
 std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewer& graph,
                                                    const std::string& provider_type,
                                                    gsl::span<const KernelRegistry* const> kernel_registries,
@@ -161,6 +396,8 @@ std::unordered_set<NodeIndex> GetCpuPreferredNodes(const onnxruntime::GraphViewe
     }
   }
 
+  PlaceCheapNodesToAvoidCopies(graph, provider_nodes, node_to_kernel, cpu_nodes);
+
   return cpu_nodes;
 }
 
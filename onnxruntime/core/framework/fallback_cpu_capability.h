@@ -12,7 +12,8 @@ namespace onnxruntime {
 
 /**
   Returns a list of nodes that are preferred on CPU.
-  They are commonly shape-related computation subgraphs.
+  They are commonly shape-related computation subgraphs, and cheap nodes next to nodes that run on CPU anyway
+  when running them on CPU saves more copies between the devices than it costs.
   @param graph Graph viewer
   @param provider_type The target execution provider type
   @param kernel_registries Kernel registries for the target EP
@@ -23,4 +24,21 @@ namespace onnxruntime {
                                                     gsl::span<const KernelRegistry* const> kernel_registries,
                                                     gsl::span<const NodeIndex> tentative_nodes);
 
+/**
+  Returns true if the node is a cheap element-wise or data movement operator that the CPU EP implements for the
+  types of the node, so it can be run on CPU instead of copying its inputs or outputs between the devices.
+  */
+bool IsCheapOnCpu(const Node& node);
+
+/**
+  Estimated cost of copying the value between the devices, in bytes. It includes a fixed overhead per copy
+  for the launch and synchronization of the copy.
+  */
+int64_t EstimateCopyCost(const NodeArg& arg);
+
+/**
+  Estimated cost of running a cheap node on CPU, in the same unit as EstimateCopyCost.
+  */
+int64_t EstimateCpuCost(const Node& node);
+
 }  // namespace onnxruntime
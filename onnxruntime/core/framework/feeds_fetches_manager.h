@@ -74,6 +74,8 @@ class FeedsFetchesManager {
 
   const DeviceCopyChecks& GetDeviceCopyChecks() const { return device_copy_checks_; }
   void SetDeviceCopyChecks(DeviceCopyCheck input_copy_needed, DeviceCopyCheck output_copy_needed);
+  // forget the copy checks of the previous execution, e.g. when the feeds may be on other devices now
+  void ResetDeviceCopyChecks() { device_copy_checks_ = {}; }
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(FeedsFetchesManager);
@@ -41,6 +41,9 @@ Status KernelRegistryManager::RegisterKernels(const ExecutionProviders& executio
 
     provider_type_to_registry_.insert(std::make_pair(provider->Type(), registry));
   }
+#if !defined(ORT_MINIMAL_BUILD)
+  kernel_lookup_cache_.clear();
+#endif
   return Status::OK();
 }
 
@@ -50,10 +53,29 @@ void KernelRegistryManager::RegisterKernelRegistry(std::shared_ptr<KernelRegistr
     return;
   }
   custom_kernel_registries_.push_front(kernel_registry);
+#if !defined(ORT_MINIMAL_BUILD)
+  kernel_lookup_cache_.clear();
+#endif
 }
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD)
+size_t KernelRegistryManager::KernelLookupKeyHash::operator()(const KernelLookupKey& key) const {
+  size_t hash = std::hash<std::string>{}(key.op_type);
+  auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+  combine(std::hash<std::string>{}(key.domain));
+  combine(std::hash<std::string>{}(key.provider));
+  combine(std::hash<int>{}(key.since_version));
+  combine(std::hash<const void*>{}(key.schema));
+  for (int count : key.arg_counts) {
+    combine(std::hash<int>{}(count));
+  }
+  for (const std::string* type : key.arg_types) {
+    combine(std::hash<const std::string*>{}(type));
+  }
+  return hash;
+}
+
 bool KernelRegistryManager::HasImplementationOf(const KernelRegistryManager& r, const Node& node, const std::string& provider_type) {
   std::vector<const KernelRegistry*> kernel_registries = r.GetKernelRegistriesByProviderType(provider_type);
   return std::any_of(kernel_registries.begin(), kernel_registries.end(), [&](const KernelRegistry* kernel_registry) {
@@ -79,9 +101,33 @@ Status KernelRegistryManager::SearchKernelRegistry(const onnxruntime::Node& node
     return Status(ONNXRUNTIME, FAIL, create_error_message("The node is not placed on any Execution Provider. "));
   }
 
+  // the data types are interned, so comparing their pointers compares the types
+  KernelLookupKey key{node.OpType(), node.Domain(), ptype, node.SinceVersion(), node.Op(), {}, {}};
+  key.arg_counts.reserve(node.InputArgCount().size() + 1);
+  key.arg_counts.insert(key.arg_counts.end(), node.InputArgCount().begin(), node.InputArgCount().end());
+  key.arg_counts.push_back(static_cast<int>(node.OutputDefs().size()));
+  key.arg_types.reserve(node.InputDefs().size() + node.OutputDefs().size());
+  for (const auto* def : node.InputDefs()) {
+    key.arg_types.push_back(def->Exists() ? def->Type() : nullptr);
+  }
+  for (const auto* def : node.OutputDefs()) {
+    key.arg_types.push_back(def->Exists() ? def->Type() : nullptr);
+  }
+
+  auto cached = kernel_lookup_cache_.find(key);
+  if (cached != kernel_lookup_cache_.end()) {
+    *kernel_create_info = cached->second;
+    return Status::OK();
+  }
+
+  auto cache_result = [this, &key, kernel_create_info]() {
+    kernel_lookup_cache_.emplace(std::move(key), *kernel_create_info);
+  };
+
   for (auto& registry : custom_kernel_registries_) {
     status = registry->TryFindKernel(node, std::string(), kernel_create_info);
     if (status.IsOK()) {
+      cache_result();
       return status;
     }
   }
@@ -95,6 +141,7 @@ Status KernelRegistryManager::SearchKernelRegistry(const onnxruntime::Node& node
   if (p != nullptr) {
     status = p->TryFindKernel(node, std::string(), kernel_create_info);
     if (status.IsOK()) {
+      cache_result();
       return status;
     }
   }
@@ -6,6 +6,7 @@
 #include <vector>
 #include <list>
 #include <unordered_map>
+#include "core/common/inlined_containers.h"
 #include "core/common/status.h"
 #include "core/graph/graph_viewer.h"
 #include "core/platform/ort_mutex.h"
@@ -62,6 +63,8 @@ class KernelRegistryManager {
 #if !defined(ORT_MINIMAL_BUILD)
   // This function assumes the node is already assigned to an execution provider
   // Don't call this function before graph partition is done
+  // The result is cached per node signature (op, provider, since version, schema, input and output types), so only
+  // the first node of each signature is matched against the kernel defs of the registries.
   Status SearchKernelRegistry(const onnxruntime::Node& node,
                               /*out*/ const KernelCreateInfo** kernel_create_info) const;
 
@@ -90,5 +93,31 @@ class KernelRegistryManager {
   // Each kernel registry may contain kernels from many different providers.
   // in order to search kernels from a specific provider, we have to iterate all its elements
   std::list<std::shared_ptr<KernelRegistry>> custom_kernel_registries_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Everything the kernel found by SearchKernelRegistry for a node depends on.
+  struct KernelLookupKey {
+    std::string op_type;
+    std::string domain;
+    std::string provider;
+    int since_version;
+    const void* schema;
+    InlinedVector<int> arg_counts;
+    InlinedVector<const std::string*> arg_types;
+
+    bool operator==(const KernelLookupKey& other) const {
+      return since_version == other.since_version && schema == other.schema && op_type == other.op_type &&
+             domain == other.domain && provider == other.provider && arg_counts == other.arg_counts &&
+             arg_types == other.arg_types;
+    }
+  };
+
+  struct KernelLookupKeyHash {
+    size_t operator()(const KernelLookupKey& key) const;
+  };
+
+  // Cleared when registries are added, as they take priority over the kernels found so far.
+  mutable std::unordered_map<KernelLookupKey, const KernelCreateInfo*, KernelLookupKeyHash> kernel_lookup_cache_;
+#endif
 };
 }  // namespace onnxruntime
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/kernel_tuning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+
+namespace {
+// Number of timed runs of each variant. The fastest run is kept to filter out preemptions.
+constexpr int kTuningIterations = 3;
+}  // namespace
+
+KernelTuningDatabase& KernelTuningDatabase::Instance() {
+  static KernelTuningDatabase database;
+  return database;
+}
+
+const std::string& KernelTuningDatabase::CpuDeviceKey() {
+  static const std::string key = [] {
+    std::ostringstream ss;
+    const auto& model_name = CPUIDInfo::GetCPUIDInfo().GetCPUModelName();
+    ss << "cpu:" << (model_name.empty() ? "unknown" : model_name) << ":" << std::thread::hardware_concurrency();
+    return ss.str();
+  }();
+  return key;
+}
+
+std::string KernelTuningDatabase::MakeEntryKey(const std::string& device, const std::string& key) {
+  return device + '\t' + key;
+}
+
+Status KernelTuningDatabase::Open(const std::string& path) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  if (path == path_) {
+    return Status::OK();
+  }
+
+  // Results recorded for a previously opened file go to that file.
+  if (!path_.empty()) {
+    ORT_RETURN_IF_ERROR(FlushLocked());
+  }
+
+  path_ = path;
+
+  std::ifstream file(path);
+  if (!file) {
+    return Status::OK();
+  }
+
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    if (line.empty()) {
+      continue;
+    }
+
+    const auto separator = line.rfind('\t');
+    ORT_RETURN_IF(separator == std::string::npos || line.find('\t') == separator,
+                  "Invalid entry in kernel tuning file ", path, " at line ", line_number);
+
+    int variant = -1;
+    std::istringstream variant_stream(line.substr(separator + 1));
+    ORT_RETURN_IF(!(variant_stream >> variant) || variant < 0,
+                  "Invalid variant in kernel tuning file ", path, " at line ", line_number);
+
+    entries_.emplace(line.substr(0, separator), variant);
+  }
+
+  return Status::OK();
+}
+
+Status KernelTuningDatabase::Flush() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return FlushLocked();
+}
+
+Status KernelTuningDatabase::FlushLocked() {
+  if (path_.empty() || !dirty_) {
+    return Status::OK();
+  }
+
+  // Entries of other devices that share the file are loaded with it and written back unchanged.
+  std::ofstream file(path_, std::ios::trunc);
+  ORT_RETURN_IF(!file, "Failed to open kernel tuning file ", path_, " for writing");
+
+  for (const auto& entry : entries_) {
+    file << entry.first << '\t' << entry.second << '\n';
+  }
+
+  ORT_RETURN_IF(!file, "Failed to write kernel tuning file ", path_);
+  dirty_ = false;
+
+  return Status::OK();
+}
+
+bool KernelTuningDatabase::IsEnabled() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return !path_.empty();
+}
+
+bool KernelTuningDatabase::Lookup(const std::string& device, const std::string& key, int& variant) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(MakeEntryKey(device, key));
+  if (it == entries_.end()) {
+    return false;
+  }
+  variant = it->second;
+  return true;
+}
+
+void KernelTuningDatabase::Record(const std::string& device, const std::string& key, int variant) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  entries_[MakeEntryKey(device, key)] = variant;
+  dirty_ = true;
+}
+
+Status KernelTuningDatabase::Tune(const std::string& device, const std::string& key, int variant_count,
+                                  const std::function<Status(int)>& run_variant, int& variant) {
+  if (Lookup(device, key, variant) && variant < variant_count) {
+    return Status::OK();
+  }
+
+  // The lock is not held while benchmarking. Concurrent runs of the same key may both tune it, which only costs
+  // time, and the last one to finish records its result.
+  using clock = std::chrono::steady_clock;
+  auto best_time = clock::duration::max();
+  int best_variant = 0;
+
+  for (int v = 0; v < variant_count; ++v) {
+    // The first run warms up the caches and the buffers of the variant and is not timed.
+    ORT_RETURN_IF_ERROR(run_variant(v));
+
+    auto variant_time = clock::duration::max();
+    for (int i = 0; i < kTuningIterations; ++i) {
+      const auto start = clock::now();
+      ORT_RETURN_IF_ERROR(run_variant(v));
+      variant_time = std::min(variant_time, clock::now() - start);
+    }
+
+    if (variant_time < best_time) {
+      best_time = variant_time;
+      best_variant = v;
+    }
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "Kernel tuning selected variant " << best_variant << " of " << variant_count
+                        << " for " << key;
+
+  Record(device, key, best_variant);
+  variant = best_variant;
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Database of the fastest variant of kernels that implement an operation with several algorithms.
+ *
+ * Entries are keyed by the device the kernel runs on and by a kernel specific string that describes the operation
+ * and its shapes. A kernel benchmarks its variants the first time it runs a key and records the fastest one, which
+ * later runs reuse. The database is shared by the sessions of the process and is persisted to the file given by
+ * kOrtSessionOptionsConfigKernelTuningFile, so that later sessions on the same machine skip the benchmarking.
+ * Tuning is disabled until a file is opened.
+ */
+class KernelTuningDatabase {
+ public:
+  KernelTuningDatabase() = default;
+
+  // Returns the database used by the kernels.
+  static KernelTuningDatabase& Instance();
+
+  // Returns the device key of the CPU of this machine.
+  static const std::string& CpuDeviceKey();
+
+  // Loads the entries of the file at `path`, which is written back by Flush(), and enables tuning.
+  // A missing file is not an error: it is created by the first Flush() that has new entries.
+  Status Open(const std::string& path);
+
+  // Writes the database to the opened file if entries were recorded since it was loaded.
+  Status Flush();
+
+  bool IsEnabled() const;
+
+  bool Lookup(const std::string& device, const std::string& key, int& variant) const;
+
+  void Record(const std::string& device, const std::string& key, int variant);
+
+  // Sets `variant` to the recorded variant for `key`. If there is none, each of the `variant_count` variants is run
+  // with `run_variant` and the fastest one is recorded.
+  Status Tune(const std::string& device, const std::string& key, int variant_count,
+              const std::function<Status(int)>& run_variant, int& variant);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelTuningDatabase);
+
+  static std::string MakeEntryKey(const std::string& device, const std::string& key);
+
+  Status FlushLocked();
+
+  mutable OrtMutex mutex_;
+  std::string path_;
+  // Keyed by the device and kernel keys separated by a tab, which is also how the file stores them.
+  std::unordered_map<std::string, int> entries_;
+  bool dirty_{false};
+};
+
+}  // namespace onnxruntime
@@ -16,7 +16,9 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
 #include <list>
+#include <numeric>
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/allocation_planner.h"
@@ -26,11 +28,15 @@ namespace onnxruntime {
 // MemPatternPlanner is used to trace allocation/free steps
 // in a single iteration, record the pattern and cached for
 // future request if they have the same input shape.
+// The offsets are assigned as the allocations are traced (best fit). In offline mode, which doesn't support
+// counters, they are assigned again once the whole trace is known from the lifetimes of the blocks, largest
+// block first, and the assignment with the smaller peak is used.
 // Thread-safe.
 class MemPatternPlanner {
  public:
   // only the Training code currently uses the program counter based logic
-  MemPatternPlanner(bool using_counters) : using_counters_{using_counters} {}
+  MemPatternPlanner(bool using_counters, bool offline = false)
+      : using_counters_{using_counters}, offline_{offline && !using_counters} {}
 
 #ifdef ENABLE_TRAINING
   // TODO: OverlappingTimeSchedules should be private
@@ -135,6 +141,8 @@ class MemPatternPlanner {
 
     std::lock_guard<OrtMutex> lock(lock_);
 
+    lifetimes_.emplace_back(trace_step_++, kNotFreed);
+
     if (size == 0) {
       allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0));
       return;
@@ -198,6 +206,17 @@ class MemPatternPlanner {
         break;
       }
     }
+
+    if (!using_counters_) {
+      for (size_t i = allocs_.size(); i > 0; i--) {
+        if (allocs_[i - 1].index_ == ml_value_index) {
+          if (lifetimes_[i - 1].second == kNotFreed) {
+            lifetimes_[i - 1].second = trace_step_++;
+          }
+          break;
+        }
+      }
+    }
   }
 
   MemoryPattern GenerateMemPattern() const {
@@ -239,6 +258,21 @@ class MemPatternPlanner {
       pattern.patterns_[alloc.index_] = alloc.block_;
     }
 
+    if (!using_counters_) {
+      pattern.lower_bound_size_ = ComputeLowerBoundSize();
+    }
+
+    if (offline_) {
+      std::vector<MemoryBlock> blocks;
+      const size_t peak_size = PlanOffline(blocks);
+      if (peak_size < pattern.peak_size_) {
+        pattern.peak_size_ = peak_size;
+        for (size_t i = 0; i < allocs_.size(); i++) {
+          pattern.patterns_[allocs_[i].index_] = blocks[i];
+        }
+      }
+    }
+
     return pattern;
   }
 
@@ -255,11 +289,97 @@ class MemPatternPlanner {
     }
   };
 
+  static constexpr size_t kNotFreed = std::numeric_limits<size_t>::max();
+
+  bool OverlappingLifetimes(size_t alloc_1, size_t alloc_2) const {
+    return lifetimes_[alloc_1].first < lifetimes_[alloc_2].second &&
+           lifetimes_[alloc_2].first < lifetimes_[alloc_1].second;
+  }
+
+  // Returns the largest total size of the blocks that are allocated at the same step of the trace.
+  size_t ComputeLowerBoundSize() const {
+    std::vector<std::pair<size_t, ptrdiff_t>> steps;
+    for (size_t i = 0; i < allocs_.size(); i++) {
+      const auto size = static_cast<ptrdiff_t>(allocs_[i].block_.size_);
+      steps.emplace_back(lifetimes_[i].first, size);
+      if (lifetimes_[i].second != kNotFreed) {
+        steps.emplace_back(lifetimes_[i].second, -size);
+      }
+    }
+    std::sort(steps.begin(), steps.end());
+
+    ptrdiff_t in_use = 0;
+    ptrdiff_t max_in_use = 0;
+    for (const auto& step : steps) {
+      in_use += step.second;
+      max_in_use = std::max(max_in_use, in_use);
+    }
+    return static_cast<size_t>(max_in_use);
+  }
+
+  // Assigns the offsets of all the traced blocks, largest block first, at the best fitting gap between the blocks
+  // already assigned whose lifetime overlaps. Returns the peak size.
+  size_t PlanOffline(std::vector<MemoryBlock>& blocks) const {
+    std::vector<size_t> order(allocs_.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+      return allocs_[lhs].block_.size_ > allocs_[rhs].block_.size_;
+    });
+
+    blocks.assign(allocs_.size(), MemoryBlock(0, 0));
+    // assigned blocks, sorted in order of their offset
+    std::vector<size_t> assigned;
+    SafeInt<size_t> peak_size{0};
+
+    for (size_t i : order) {
+      const size_t size = allocs_[i].block_.size_;
+      if (size == 0) {
+        continue;
+      }
+
+      size_t current = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      size_t best_offset = 0;
+      bool best_offset_found = false;
+      for (size_t j : assigned) {
+        if (!OverlappingLifetimes(i, j)) {
+          continue;
+        }
+
+        if (blocks[j].offset_ >= current) {
+          auto gap = blocks[j].offset_ - current;
+          if (gap >= size && (gap - size) < waste_bytes) {
+            waste_bytes = gap - size;
+            best_offset = current;
+            best_offset_found = true;
+          }
+        }
+        current = std::max(current, blocks[j].offset_ + blocks[j].size_);
+      }
+
+      if (!best_offset_found) {
+        best_offset = current;
+      }
+
+      peak_size = std::max(peak_size, SafeInt<size_t>(best_offset) + size);
+      blocks[i] = MemoryBlock(best_offset, size);
+      auto it = std::upper_bound(assigned.begin(), assigned.end(), best_offset,
+                                 [&blocks](size_t offset, size_t j) { return offset < blocks[j].offset_; });
+      assigned.insert(it, i);
+    }
+
+    return peak_size;
+  }
+
   std::vector<OrtValueAllocationBlock> allocs_;
   // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
   std::list<int> blocks_;
+  // step of the trace at which each of allocs_ is allocated and freed, if not using counters
+  std::vector<std::pair<size_t, size_t>> lifetimes_;
+  size_t trace_step_{0};
   SafeInt<size_t> buffer_size_{0};
   bool using_counters_;
+  bool offline_;
   mutable OrtMutex lock_;
 };
 
@@ -6,10 +6,11 @@
 #include "core/framework/execution_plan_base.h"
 
 namespace onnxruntime {
-OrtValuePatternPlanner::OrtValuePatternPlanner(const ExecutionPlanBase& execution_plan, bool trace_using_counters)
+OrtValuePatternPlanner::OrtValuePatternPlanner(const ExecutionPlanBase& execution_plan, bool trace_using_counters,
+                                               bool offline)
     : execution_planner_(execution_plan) {
   for (auto& location : execution_plan.GetAllLocations()) {
-    planner_map_.emplace(location, std::make_unique<MemPatternPlanner>(trace_using_counters));
+    planner_map_.emplace(location, std::make_unique<MemPatternPlanner>(trace_using_counters, offline));
   }
 }
 
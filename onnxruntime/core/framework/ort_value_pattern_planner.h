@@ -20,7 +20,9 @@ class OrtValuePatternPlanner {
  public:
   // trace_using_counters should be true if the TraceAllocation with ProgramCounter is used. Only one
   // variant of the TraceAllocation calls may be used.
-  explicit OrtValuePatternPlanner(const ExecutionPlanBase& execution_plan, bool trace_using_counters = false);
+  // offline selects the offline mode of MemPatternPlanner, it is ignored if trace_using_counters is true.
+  explicit OrtValuePatternPlanner(const ExecutionPlanBase& execution_plan, bool trace_using_counters = false,
+                                  bool offline = false);
 #ifdef ENABLE_TRAINING
   common::Status TraceAllocation(int ort_value_idx, const AllocPlanPerValue::ProgramCounter& counter, size_t size);
 #endif
@@ -4,27 +4,77 @@
 #include "core/framework/parallel_executor.h"
 
 #include <chrono>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 #include "core/common/common.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/compute_stream_scheduler.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
+#include "core/platform/probes.h"
 #include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
+    : node_priorities_(session_state.GetNodePriorities()),
+      heavy_nodes_(session_state.GetIntraOpHeavyNodes()),
+      out_standings_(0),
+      terminate_flag_(terminate_flag),
+      executor_pool_(session_state.GetInterOpThreadPool()) {
   const auto& graph_viewer = session_state.GetGraphViewer();
   node_refs_.resize(graph_viewer.MaxNodeIndex());
   for (auto& node : graph_viewer.Nodes()) {
     node_refs_[node.Index()] = node.GetInputEdgesCount();
   }
+
+  ORT_ENFORCE(node_priorities_.size() == node_refs_.size(),
+              "Node priorities are computed when the session state of a parallel execution is finalized.");
+
+  // without intra op threads the heavy kernels run on the thread of their node and don't compete for cores
+  max_running_heavy_nodes_ = concurrency::ThreadPool::DegreeOfParallelism(session_state.GetThreadPool()) > 1
+                                 ? 1
+                                 : std::numeric_limits<int>::max();
+}
+
+void ParallelExecutor::PushReadyNode(NodeIndex node_index) {
+  ReadyNode ready_node{node_priorities_[node_index], node_index};
+  if (heavy_nodes_[node_index]) {
+    ready_heavy_nodes_.push(ready_node);
+  } else {
+    ready_light_nodes_.push(ready_node);
+  }
+}
+
+NodeIndex ParallelExecutor::PopReadyNode() {
+  // There is always a ready node, each node is popped by the task scheduled or the thread continuing after it was
+  // pushed. A heavy node is taken if it has the higher priority, unless the cores are busy with another heavy node
+  // and there are light nodes to run meanwhile.
+  bool take_heavy;
+  if (ready_light_nodes_.empty()) {
+    take_heavy = true;
+  } else if (ready_heavy_nodes_.empty() || running_heavy_nodes_ >= max_running_heavy_nodes_) {
+    take_heavy = false;
+  } else {
+    take_heavy = ready_light_nodes_.top() < ready_heavy_nodes_.top();
+  }
+
+  auto& ready_nodes = take_heavy ? ready_heavy_nodes_ : ready_light_nodes_;
+  ORT_ENFORCE(!ready_nodes.empty(), "No ready node to run.");
+  NodeIndex node_index = ready_nodes.top().node_index;
+  ready_nodes.pop();
+  if (take_heavy) {
+    ++running_heavy_nodes_;
+  }
+
+  return node_index;
 }
 
 Status ParallelExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
@@ -38,16 +88,37 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
     tp = session_state.Profiler().Start();
   }
 
+  SessionMetrics* const metrics = session_state.GetMetrics();
+  record_metrics_ = metrics != nullptr && metrics->ShouldSampleRun();
+  std::chrono::steady_clock::time_point run_begin_time;
+  if (record_metrics_) {
+    run_begin_time = std::chrono::steady_clock::now();
+  }
+
+  const auto* run_termination = concurrency::ThreadPool::RunTerminationScope::Current();
+  run_deadline_ = run_termination != nullptr ? run_termination->Deadline()
+                                             : concurrency::ThreadPool::RunTerminationScope::Clock::time_point::max();
+  run_profiler_ = profiling::Profiler::Current();
+
   root_frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                          fetch_allocators, session_state);
-  //std::cout << "start nodes:" << std::endl;
-  for (auto node_index : session_state.GetGraphViewer().GetRootNodes()) {
-    auto p_op_kernel = session_state.GetKernel(node_index);
-    if (!p_op_kernel)
-      continue;
-
-    //std::cout << "\t" << p_op_kernel->Node().Name() << std::endl;
-    EnqueueNode(node_index, session_state, logger);
+  stream_scheduler_ = std::make_unique<ComputeStreamScheduler>(session_state);
+  ORT_RETURN_IF_ERROR(stream_scheduler_->Begin());
+  size_t num_root_nodes = 0;
+  {
+    std::lock_guard<OrtMutex> lock(ref_mutex_);
+    for (auto node_index : session_state.GetGraphViewer().GetRootNodes()) {
+      auto p_op_kernel = session_state.GetKernel(node_index);
+      if (!p_op_kernel)
+        continue;
+
+      PushReadyNode(node_index);
+      ++num_root_nodes;
+    }
+  }
+
+  for (size_t i = 0; i < num_root_nodes; ++i) {
+    EnqueueNode(session_state, logger);
   }
 
   // Wait for finish.
@@ -76,6 +147,8 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
     return status;
   }
 
+  ORT_RETURN_IF_ERROR(stream_scheduler_->End());
+
   VLOGS(logger, 1) << "Fetching output.";
   // ExecutionFrame::Finalize will update 'fetches' with the final output
   ORT_RETURN_IF_ERROR(root_frame_->GetOutputs(fetches));
@@ -97,6 +170,12 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
     }
   }
 
+  if (record_metrics_) {
+    metrics->RecordRun(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - run_begin_time)
+                           .count());
+  }
+
   if (is_profiler_enabled) {
     session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp);
   }
@@ -123,10 +202,7 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   while (keep_running) {
     // TODO: Convert RunNodeAsync return Status.
     // to also handle exception propagation
-    if (terminate_flag_) {
-      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
-      ORT_THROW("Exiting due to terminate flag being set to true.");
-    }
+    ORT_THROW_IF_ERROR(utils::CheckRunTermination(terminate_flag_, logger));
 
     const auto* p_op_kernel = session_state.GetKernel(node_index);
     const auto& node = *graph_viewer.GetNode(node_index);
@@ -141,6 +217,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     if (f_profiler_enabled) {
       sync_time_begin = session_state.Profiler().Start();
     }
+    status = stream_scheduler_->BeforeCompute(node_index);
+    if (!status.IsOK()) {
+      break;
+    }
+
     // sync before compute
     int queue_id = p_op_kernel->KernelDef().ExecQueueId();
     if (exec_plan.NodeHasFence(node_index)) {
@@ -186,7 +267,18 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     // call compute on the kernel
     VLOGS(logger, 1) << "Computing kernel: " << node.Name();
 
+    std::chrono::steady_clock::time_point node_begin_time;
+    if (record_metrics_) {
+      node_begin_time = std::chrono::steady_clock::now();
+    }
+
+    std::optional<profiling::HardwareCounters::Scope> hardware_counters;
+    if (f_profiler_enabled && session_state.Profiler().IsHardwareCountersEnabled()) {
+      hardware_counters.emplace();
+    }
+
     // Execute the kernel.
+    ORT_PROBE3(node__start, node_index, node.OpType().c_str(), node.Name().c_str());
     ORT_TRY {
 #ifdef ENABLE_TRAINING
       if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
@@ -201,8 +293,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
         status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
       });
     }
+    ORT_PROBE3(node__end, node_index, node.OpType().c_str(), status.Code());
+    const std::string hardware_counter_values = hardware_counters ? hardware_counters->Stop() : std::string();
 
     if (!status.IsOK()) {
+      stream_scheduler_->ResetStream();
       std::ostringstream ss;
       ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
          << "' Status Message: " << status.ErrorMessage();
@@ -212,13 +307,20 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       break;
     }
 
+    if (record_metrics_) {
+      session_state.GetMetrics()->RecordNode(node_index, std::chrono::duration_cast<std::chrono::microseconds>(
+                                                             std::chrono::steady_clock::now() - node_begin_time)
+                                                             .count());
+    }
+
     if (f_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      node.Name() + "_kernel_time",
                                                      kernel_begin_time,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()},
                                                       {"provider", p_op_kernel->KernelDef().Provider()},
-                                                      {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())}});
+                                                      {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())},
+                                                      {"hardware_counters", hardware_counter_values}});
 
       sync_time_begin = session_state.Profiler().Start();
     }
@@ -245,6 +347,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
         }
       }
     }
+    status = stream_scheduler_->AfterCompute(node_index);
+    if (!status.IsOK()) {
+      break;
+    }
+
     if (f_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      node.Name() + "_fence_after",
@@ -257,33 +364,43 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     keep_running = false;
 
     // Checking which output nodes ready for running.
+    // This thread continues with the ready node of the highest priority and a task is scheduled for each of the
+    // others. The tasks are scheduled after the lock is released as they may run inline without a thread pool.
+    size_t num_tasks = 0;
     {
       auto begin = node.OutputEdgesBegin();
       auto end = node.OutputEdgesEnd();
 
       std::lock_guard<OrtMutex> lock(ref_mutex_);
+      if (heavy_nodes_[node_index]) {
+        --running_heavy_nodes_;
+      }
+
+      size_t num_ready_nodes = 0;
       for (auto it = begin; it != end; it++) {
         auto idx = (*it).GetNode().Index();
         if ((--node_refs_[idx]) == 0) {
-          if (!keep_running) {
-            node_index = idx;
-            keep_running = true;
-          } else {
-            EnqueueNode(idx, session_state, logger);
-          }
+          PushReadyNode(idx);
+          ++num_ready_nodes;
         }
+      }
 
-        // std::cout << "handle output, current name: " << node.Name() << ", current index: "
-        // << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: "
-        // << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
+      if (num_ready_nodes > 0) {
+        node_index = PopReadyNode();
+        keep_running = true;
+        num_tasks = num_ready_nodes - 1;
       }
     }
+
+    for (size_t i = 0; i < num_tasks; ++i) {
+      EnqueueNode(session_state, logger);
+    }
   }
 
   return status;
 }
 
-void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
+void ParallelExecutor::EnqueueNode(const SessionState& session_state, const logging::Logger& logger) {
   {
     std::unique_lock<OrtMutex> lock(complete_mutex_);
     // if there are errors there's no point queuing more work
@@ -293,18 +410,27 @@ void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& sess
     out_standings_++;
   }
 
-  onnxruntime::concurrency::ThreadPool::Schedule(executor_pool_, [this, p_node_index, &session_state, &logger]() {
-    auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
-      const auto* node = session_state.GetGraphViewer().GetNode(p_node_index);
+  onnxruntime::concurrency::ThreadPool::Schedule(executor_pool_, [this, &session_state, &logger]() {
+    NodeIndex node_index;
+    {
+      std::lock_guard<OrtMutex> lock(ref_mutex_);
+      node_index = PopReadyNode();
+    }
+
+    auto create_exception_message = [node_index, &session_state](const std::exception* ex) {
+      const auto* node = session_state.GetGraphViewer().GetNode(node_index);
 
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
                              " node '", node->Name(), "'. ",
                              ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
     };
 
+    concurrency::ThreadPool::RunTerminationScope run_termination(terminate_flag_, run_deadline_);
+    profiling::Profiler::ThreadScope profiler_scope(run_profiler_);
+
     Status status;
     ORT_TRY {
-      status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
+      status = ParallelExecutor::RunNodeAsync(node_index, std::cref(session_state), std::cref(logger));
     }
     ORT_CATCH(const std::exception& ex) {
       ORT_HANDLE_EXCEPTION([&]() {
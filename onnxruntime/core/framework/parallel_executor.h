@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <queue>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
 #include "core/common/logging/logging.h"
+#include "core/framework/compute_stream_scheduler.h"
 #include "core/framework/iexecutor.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/ort_value.h"
@@ -33,8 +35,13 @@ class ParallelExecutor : public IExecutor {
 
   Status RunNodeAsync(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
-  void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
+  // Schedules a task that runs the ready node with the highest priority at the time the task starts.
+  // Must be called once for each node added by PushReadyNode that isn't run by a task already running.
+  void EnqueueNode(const SessionState& session_state, const logging::Logger& logger);
 
+  // Ready nodes are protected by ref_mutex_.
+  void PushReadyNode(NodeIndex node_index);
+  NodeIndex PopReadyNode();
   void FinishNodeRun(const Status& status) {
     bool finished = false;
     {
@@ -51,15 +58,40 @@ class ParallelExecutor : public IExecutor {
     }
   }
 
+  struct ReadyNode {
+    double priority;
+    NodeIndex node_index;
+    bool operator<(const ReadyNode& other) const { return priority < other.priority; }
+  };
+
   std::unique_ptr<ExecutionFrame> root_frame_;
+  std::unique_ptr<ComputeStreamScheduler> stream_scheduler_;
   std::vector<size_t> node_refs_;
   OrtMutex ref_mutex_;
+
+  // computed once by the session state, see SessionState::GetNodePriorities
+  const std::vector<double>& node_priorities_;
+  // Nodes whose kernels parallelize over the intra op thread pool. Running several of them at the same time
+  // oversubscribes the cores, so while one is running, ready nodes with light kernels are preferred.
+  const std::vector<bool>& heavy_nodes_;
+  std::priority_queue<ReadyNode> ready_heavy_nodes_;  // protected by ref_mutex_
+  std::priority_queue<ReadyNode> ready_light_nodes_;  // protected by ref_mutex_
+  int running_heavy_nodes_ = 0;                       // protected by ref_mutex_
+  int max_running_heavy_nodes_;
   int out_standings_;  //protected by complete_mutex_
   OrtMutex complete_mutex_;
   OrtCondVar complete_cv_;
   std::vector<Status> errors_;
 
+  // true if the current run is sampled for the session metrics
+  bool record_metrics_ = false;
+
   const bool& terminate_flag_;
+  // deadline of the run, applied to the nodes running on the executor pool threads
+  concurrency::ThreadPool::RunTerminationScope::Clock::time_point run_deadline_ =
+      concurrency::ThreadPool::RunTerminationScope::Clock::time_point::max();
+  // profiler recording the thread pool and arena events of the run, installed on the executor pool threads too
+  profiling::Profiler* run_profiler_ = nullptr;
   // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
   onnxruntime::concurrency::ThreadPool* const executor_pool_{};
 };
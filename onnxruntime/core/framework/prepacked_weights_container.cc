@@ -49,4 +49,20 @@ size_t PrepackedWeightsContainer::GetNumberOfElements() const {
   return prepacked_weights_map_.size();
 }
 
+void PrepackedWeightsContainer::AddRefToWeight(const std::string& key) {
+  ++weight_ref_counts_[key];
+}
+
+void PrepackedWeightsContainer::ReleaseWeight(const std::string& key) {
+  auto iter = weight_ref_counts_.find(key);
+  ORT_ENFORCE(iter != weight_ref_counts_.end() && iter->second > 0, "Pre-packed weight ", key, " is not in use");
+
+  if (--iter->second == 0) {
+    weight_ref_counts_.erase(iter);
+    if (cache_all_constant_initializers_) {
+      prepacked_weights_map_.erase(key);
+    }
+  }
+}
+
 }  // namespace onnxruntime
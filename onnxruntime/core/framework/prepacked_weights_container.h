@@ -18,7 +18,13 @@ namespace onnxruntime {
 
 class PrepackedWeightsContainer final {
  public:
-  PrepackedWeightsContainer() {
+  // By default the container is only used for the pre-packed weights of initializers shared between sessions via
+  // AddInitializer, and weights are kept for the lifetime of the container.
+  // If `cache_all_constant_initializers` is true the container is used for the pre-packed weights of all constant
+  // initializers of CPU nodes, and a weight is freed once no session uses it anymore. This is how the container
+  // owned by the Environment is set up, so that sessions loaded from the same model share pre-packed weights.
+  explicit PrepackedWeightsContainer(bool cache_all_constant_initializers = false)
+      : cache_all_constant_initializers_(cache_all_constant_initializers) {
   }
 
   ~PrepackedWeightsContainer() = default;
@@ -47,6 +53,15 @@ class PrepackedWeightsContainer final {
   // Returns the number of elements in the container
   size_t GetNumberOfElements() const;
 
+  bool CachesAllConstantInitializers() const { return cache_all_constant_initializers_; }
+
+  // Records that a session uses the PrePackedWeights instance pertaining to the provided key.
+  void AddRefToWeight(const std::string& key);
+
+  // Records that a session no longer uses the PrePackedWeights instance pertaining to the provided key.
+  // If the container caches all constant initializers the instance is freed once it is unused.
+  void ReleaseWeight(const std::string& key);
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
 
   // Resource to be acquired by the method that is going to invoke calls to the kernels'
@@ -64,6 +79,12 @@ class PrepackedWeightsContainer final {
   // to PrePackedWeights instances.
   // The key is : op_type + "+" + hash_of_prepacked_buffers_in_the_PrepackedWeights_instance.
   std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+
+  // Number of kernels using each PrePackedWeights instance.
+  std::unordered_map<std::string, size_t> weight_ref_counts_;
+
+ private:
+  const bool cache_all_constant_initializers_;
 };
 
 }  // namespace onnxruntime
@@ -118,6 +118,24 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
+  // Number of node outputs planned to be written in place into the buffer of an input of the node (see
+  // KernelDefBuilder::MayInplace), and of node outputs planned to reuse the buffer of a value that is no longer used.
+  size_t num_inplace_outputs{0};
+  size_t num_reused_outputs{0};
+
+  // Multi-stream execution: the nodes of `compute_stream_provider` are spread over its compute streams,
+  // see IExecutionProvider::GetComputeStreamCount(). All other nodes, and all nodes if num_compute_streams is 1,
+  // run on stream 0. The following vectors are indexed by node index and empty if num_compute_streams is 1.
+  std::string compute_stream_provider;
+  int num_compute_streams{1};
+  std::vector<int> node_compute_stream;
+  // Nodes on other compute streams whose work must complete before the node runs
+  std::vector<std::vector<NodeIndex>> node_stream_dependencies;
+  // Whether a node on another compute stream waits for the node, i.e. whether an event is recorded after it
+  std::vector<bool> node_signals_stream_event;
+
+  bool HasMultipleComputeStreams() const { return num_compute_streams > 1; }
+
   const OrtMemoryInfo& GetLocation(size_t ort_value_index) const override {
     return allocation_plan[ort_value_index].location;
   }
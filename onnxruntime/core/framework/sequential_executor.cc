@@ -4,16 +4,20 @@
 #include "core/framework/sequential_executor.h"
 
 #include <chrono>
+#include <optional>
 #include <thread>
 #include <vector>
 #include <sstream>
 #include "core/common/common.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/compute_stream_scheduler.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
+#include "core/platform/probes.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
 #include "core/framework/debug_node_inputs_outputs_utils.h"
@@ -141,6 +145,63 @@ static Status ReleaseNodeMLValues(ExecutionFrame& frame,
                                   const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
                                   const logging::Logger& logger);
 
+// The per-node tracing, profiling and synchronization of Execute are compiled out of the lean loop. Builds that
+// instrument every node always use the full loop.
+#if defined(DEBUG_NODE_INPUTS_OUTPUTS) || defined(ENABLE_NVTX_PROFILE) || defined(CONCURRENCY_VISUALIZER) || \
+    defined(ONNXRUNTIME_ENABLE_INSTRUMENT) || defined(TRACE_EXECUTION) || defined(ORT_MEMORY_PROFILE)
+#define ORT_SEQUENTIAL_EXECUTOR_NO_LEAN_LOOP
+#endif
+
+#if !defined(ORT_SEQUENTIAL_EXECUTOR_NO_LEAN_LOOP)
+// Runs the nodes of the execution plan without profiling, metrics, fences or compute streams.
+// The kernels are resolved by the SessionState ahead of time.
+static Status ExecuteNodesLean(const SessionState& session_state, ExecutionFrame& frame,
+                               const InlinedHashSet<NodeIndex>* to_be_executed_nodes,
+                               const bool& terminate_flag, const logging::Logger& logger) {
+  const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
+  const auto& exec_plan_vec = seq_exec_plan.execution_plan;
+  const auto& kernels = session_state.GetExecutionPlanKernels();
+
+  for (size_t step = 0, num_steps = exec_plan_vec.size(); step < num_steps; ++step) {
+    ORT_RETURN_IF_ERROR(utils::CheckRunTermination(terminate_flag, logger));
+
+    const auto& node_exec_plan = exec_plan_vec[step];
+    if (to_be_executed_nodes != nullptr && to_be_executed_nodes->count(node_exec_plan.node_index) == 0) {
+      continue;
+    }
+
+    const OpKernel& op_kernel = *kernels[step];
+    OpKernelContextInternal op_kernel_context(session_state, frame, op_kernel, logger, terminate_flag);
+
+    ORT_PROBE3(node__start, node_exec_plan.node_index, op_kernel.Node().OpType().c_str(),
+               op_kernel.Node().Name().c_str());
+    Status compute_status;
+    ORT_TRY {
+      compute_status = op_kernel.Compute(&op_kernel_context);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_PROBE3(node__end, node_exec_plan.node_index, op_kernel.Node().OpType().c_str(), compute_status.Code());
+
+    if (!compute_status.IsOK()) {
+      const Node& node = op_kernel.Node();
+      const auto msg_string = MakeString("Non-zero status code returned while running ", node.OpType(),
+                                         " node. Name:'", node.Name(),
+                                         "' Status Message: ", compute_status.ErrorMessage());
+      LOGS(logger, ERROR) << msg_string;
+      return Status(compute_status.Category(), compute_status.Code(), msg_string);
+    }
+
+    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+  }
+
+  return Status::OK();
+}
+#endif
+
 Status SequentialExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
                                    const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -160,7 +221,16 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     tp = session_state.Profiler().Start();
   }
 
+  SessionMetrics* const metrics = session_state.GetMetrics();
+  const bool record_metrics = metrics != nullptr && metrics->ShouldSampleRun();
+  std::chrono::steady_clock::time_point run_begin_time;
+  std::chrono::steady_clock::time_point node_begin_time;
+  if (record_metrics) {
+    run_begin_time = std::chrono::steady_clock::now();
+  }
+
   ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
+  ComputeStreamScheduler stream_scheduler{session_state};
 
 #if !defined(ORT_MINIMAL_BUILD)
   const auto* const to_be_executed_nodes = session_state.GetToBeExecutedNodes(fetch_mlvalue_idxs);
@@ -212,249 +282,289 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     utils::NodeDumpContext dump_context { session_state.GetGraphExecutionCounter(), program_counter };
 #endif
 
+  ORT_RETURN_IF_ERROR(stream_scheduler.Begin());
 
-  for (const auto& node_exec_plan : exec_plan_vec) {
-    if (terminate_flag_) {
-      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
-    }
+  // everything the full loop does per node besides running the kernel is decided here, once per run
+#if !defined(ORT_SEQUENTIAL_EXECUTOR_NO_LEAN_LOOP)
+  const bool use_lean_loop = !is_profiler_enabled && !record_metrics && session_state.CanUseLeanExecution();
+#else
+  const bool use_lean_loop = false;
+#endif
 
-    auto node_index = node_exec_plan.node_index;
+  if (use_lean_loop) {
+#if !defined(ORT_SEQUENTIAL_EXECUTOR_NO_LEAN_LOOP)
+#if !defined(ORT_MINIMAL_BUILD)
+    const auto* nodes_to_execute = only_execute_path_to_fetches ? to_be_executed_nodes : nullptr;
+#else
+    const InlinedHashSet<NodeIndex>* nodes_to_execute = nullptr;
+#endif
+    ORT_RETURN_IF_ERROR(ExecuteNodesLean(session_state, frame, nodes_to_execute, terminate_flag_, logger));
+#endif
+  } else {
+    for (const auto& node_exec_plan : exec_plan_vec) {
+      ORT_RETURN_IF_ERROR(utils::CheckRunTermination(terminate_flag_, logger));
+
+      auto node_index = node_exec_plan.node_index;
 
 #if !defined(ORT_MINIMAL_BUILD)
-    // If it is not necessary to execute the node.
-    if (only_execute_path_to_fetches && to_be_executed_nodes->count(node_index) == 0) {
-      continue;
-    }
+      // If it is not necessary to execute the node.
+      if (only_execute_path_to_fetches && to_be_executed_nodes->count(node_index) == 0) {
+        continue;
+      }
 #endif
 
-    const auto& node = *graph_viewer.GetNode(node_exec_plan.node_index);
+      const auto& node = *graph_viewer.GetNode(node_exec_plan.node_index);
 
 #ifdef CONCURRENCY_VISUALIZER
-    series.write_flag(node.Name().c_str());
+      series.write_flag(node.Name().c_str());
 #endif
 
 #ifdef ENABLE_NVTX_PROFILE
-    if (node.Description() != "Backward pass" && !forward_range.IsBeginCalled()) {
-      // Start timing forward pass when encountering the first forward node.
-      forward_range.Begin();
-    } else if (node.Description() == "Backward pass" && !backward_range.IsBeginCalled() && forward_range.IsBeginCalled()) {
-      // Start timing backward pass when encountering the first backward node.
-      // In the meanwhile, forward range ends.
-      forward_range.End();
-      backward_range.Begin();
-    }
+      if (node.Description() != "Backward pass" && !forward_range.IsBeginCalled()) {
+        // Start timing forward pass when encountering the first forward node.
+        forward_range.Begin();
+      } else if (node.Description() == "Backward pass" && !backward_range.IsBeginCalled() && forward_range.IsBeginCalled()) {
+        // Start timing backward pass when encountering the first backward node.
+        // In the meanwhile, forward range ends.
+        forward_range.End();
+        backward_range.Begin();
+      }
 #endif
 
-    auto p_op_kernel = session_state.GetKernel(node_index);
+      auto p_op_kernel = session_state.GetKernel(node_index);
 
-    // if a kernel has been added in the session state, it better be NON-null.
-    if (p_op_kernel == nullptr)
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
-                             node.Name());
+      // if a kernel has been added in the session state, it better be NON-null.
+      if (p_op_kernel == nullptr)
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
+                               node.Name());
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-    LARGE_INTEGER kernel_start;
-    QueryPerformanceCounter(&kernel_start);
-#endif
-    // construct OpKernelContext
-    // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
-    // TODO: log kernel outputs?
-    if (is_profiler_enabled) {
-      sync_time_begin = session_state.Profiler().Start();
-    }
+      LARGE_INTEGER kernel_start;
+      QueryPerformanceCounter(&kernel_start);
+#endif
+      // construct OpKernelContext
+      // TODO: log kernel inputs?
+      OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
+      // TODO: log kernel outputs?
+      if (is_profiler_enabled) {
+        sync_time_begin = session_state.Profiler().Start();
+      }
 
-    // sync before compute
-    int queue_id = p_op_kernel->KernelDef().ExecQueueId();
-    if (seq_exec_plan.NodeHasFence(node_index)) {
-      for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.InputFence(input_index);
-        if (fence) {
-          auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
-          if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
-            execution_provider_type = kCpuExecutionProvider;
+      ORT_RETURN_IF_ERROR(stream_scheduler.BeforeCompute(node_index));
+
+      // sync before compute
+      int queue_id = p_op_kernel->KernelDef().ExecQueueId();
+      if (seq_exec_plan.NodeHasFence(node_index)) {
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
+            if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+              execution_provider_type = kCpuExecutionProvider;
+            }
+            fence->BeforeUsingAsInput(execution_provider_type, queue_id);
           }
-          fence->BeforeUsingAsInput(execution_provider_type, queue_id);
         }
-      }
 
-      for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
-        if (fence) {
-          auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
-          if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
-            execution_provider_type = kCpuExecutionProvider;
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            auto execution_provider_type = p_op_kernel->Node().GetExecutionProviderType();
+            if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+              execution_provider_type = kCpuExecutionProvider;
+            }
+            fence->BeforeUsingAsInput(execution_provider_type, queue_id);
           }
-          fence->BeforeUsingAsInput(execution_provider_type, queue_id);
         }
-      }
 
-      for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
-        Fence_t fence = op_kernel_context.OutputFence(output_index);
-        if (fence) {
-          fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
         }
       }
-    }
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
-    dump_context.program_counter = program_counter++;
-    utils::DumpNodeInputs(dump_context, op_kernel_context, p_op_kernel->Node(), session_state);
-#endif
-
-    const std::string node_name_for_profiling = [&]() -> std::string {
-      if (!is_profiler_enabled) return {};
-      // Derive something meaningful for profile traces and logs if node name field is blank in execution graph
-      return node.Name().empty() ? MakeString(node.OpType(), "_", node_index) : node.Name();
-    }();
-
-    if (is_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node_name_for_profiling + "_fence_before",
-                                                     sync_time_begin,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}});
-      concurrency::ThreadPool::StartProfiling(session_state.GetThreadPool());
-      // call compute on the kernel
-      VLOGS(logger, 1) << "Computing kernel: " << node_name_for_profiling;
-
-      kernel_begin_time = session_state.Profiler().Start();
-
-      // Calculate total input sizes for this operation.
-      CalculateTotalInputSizes(&op_kernel_context, p_op_kernel,
-                               input_activation_sizes, input_parameter_sizes,
-                               node_name_for_profiling, input_type_shape);
-    }
+      dump_context.program_counter = program_counter++;
+      utils::DumpNodeInputs(dump_context, op_kernel_context, p_op_kernel->Node(), session_state);
+#endif
 
-    Status compute_status;
-    {
+      const std::string node_name_for_profiling = [&]() -> std::string {
+        if (!is_profiler_enabled) return {};
+        // Derive something meaningful for profile traces and logs if node name field is blank in execution graph
+        return node.Name().empty() ? MakeString(node.OpType(), "_", node_index) : node.Name();
+      }();
+
+      if (is_profiler_enabled) {
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name_for_profiling + "_fence_before",
+                                                       sync_time_begin,
+                                                       {{"op_name", p_op_kernel->KernelDef().OpName()}});
+        concurrency::ThreadPool::StartProfiling(session_state.GetThreadPool());
+        // call compute on the kernel
+        VLOGS(logger, 1) << "Computing kernel: " << node_name_for_profiling;
+
+        kernel_begin_time = session_state.Profiler().Start();
+
+        // Calculate total input sizes for this operation.
+        CalculateTotalInputSizes(&op_kernel_context, p_op_kernel,
+                                 input_activation_sizes, input_parameter_sizes,
+                                 node_name_for_profiling, input_type_shape);
+      }
+
+      if (record_metrics) {
+        node_begin_time = std::chrono::steady_clock::now();
+      }
+
+      std::optional<profiling::HardwareCounters::Scope> hardware_counters;
+      if (is_profiler_enabled && session_state.Profiler().IsHardwareCountersEnabled()) {
+        hardware_counters.emplace();
+      }
+
+      Status compute_status;
+      {
 #ifdef CONCURRENCY_VISUALIZER
-      diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
+        diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
 #endif
 #ifdef ENABLE_NVTX_PROFILE
-      profile::NvtxRangeCreator node_compute_range(
-          MakeString(node.OpType(), ".", node.Index(), "(", node.Name(), ")"), profile::Color::Yellow);
-      node_compute_range.Begin();
+        profile::NvtxRangeCreator node_compute_range(
+            MakeString(node.OpType(), ".", node.Index(), "(", node.Name(), ")"), profile::Color::Yellow);
+        node_compute_range.Begin();
 #endif
-      ORT_TRY {
+        ORT_PROBE3(node__start, node_index, node.OpType().c_str(), node.Name().c_str());
+        ORT_TRY {
 #ifdef ENABLE_TRAINING
-        if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
-          ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
-        }
+          if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
+            ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
+          }
 #endif
 
-        compute_status = p_op_kernel->Compute(&op_kernel_context);
-      }
-      ORT_CATCH(const std::exception& ex) {
-        ORT_HANDLE_EXCEPTION([&]() {
-          compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
-        });
-      }
+          compute_status = p_op_kernel->Compute(&op_kernel_context);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+          });
+        }
 
+        ORT_PROBE3(node__end, node_index, node.OpType().c_str(), compute_status.Code());
 #ifdef ENABLE_NVTX_PROFILE
-      node_compute_range.End();
+        node_compute_range.End();
 #endif
-    }
-
-    if (!compute_status.IsOK()) {
-      std::ostringstream ss;
-      ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
-         << "' Status Message: " << compute_status.ErrorMessage();
-      //If the computation failed, we still can record the memory consumption
+      }
+      const std::string hardware_counter_values = hardware_counters ? hardware_counters->Stop() : std::string();
+
+      if (!compute_status.IsOK()) {
+        stream_scheduler.ResetStream();
+        std::ostringstream ss;
+        ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
+           << "' Status Message: " << compute_status.ErrorMessage();
+        //If the computation failed, we still can record the memory consumption
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
-      MemoryInfo::MemoryInfoProfile::CreateEvents("dynamic activations_" + std::to_string(MemoryInfo::GetIteration()),
-                                                  MemoryInfo::MemoryInfoProfile::GetAndIncreasePid(), MemoryInfo::MapType::DynamicActivation, "", 0);
+        MemoryInfo::MemoryInfoProfile::CreateEvents("dynamic activations_" + std::to_string(MemoryInfo::GetIteration()),
+                                                    MemoryInfo::MemoryInfoProfile::GetAndIncreasePid(), MemoryInfo::MapType::DynamicActivation, "", 0);
 #endif
-      const auto msg_string = ss.str();
-      LOGS(logger, ERROR) << msg_string;
-      return Status(compute_status.Category(), compute_status.Code(), msg_string);
-    }
+        const auto msg_string = ss.str();
+        LOGS(logger, ERROR) << msg_string;
+        return Status(compute_status.Category(), compute_status.Code(), msg_string);
+      }
+
+      if (record_metrics) {
+        metrics->RecordNode(node.Index(), std::chrono::duration_cast<std::chrono::microseconds>(
+                                              std::chrono::steady_clock::now() - node_begin_time)
+                                              .count());
+      }
 
-    if (is_profiler_enabled) {
-      // Calculate total output sizes for this operation.
-      CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling, output_type_shape);
+      if (is_profiler_enabled) {
+        // Calculate total output sizes for this operation.
+        CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling, output_type_shape);
 
 #if defined(TRACE_EXECUTION)
-      // Trace execution step.
-      const Node& node = p_op_kernel->Node();
-      std::cout << "Executed op kernel node " << node_name_for_profiling
-                << " Index=" << node.Index()
-                << " OpType=" << node.OpType()
-                << " Name=" << node.Name()
-                << " Activation_Size=" << input_activation_sizes
-                << " Parameter_Size=" << input_parameter_sizes
-                << " Output_Size=" << total_output_sizes
-                << "\n";
-#endif
-
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node_name_for_profiling + "_kernel_time",
-                                                     kernel_begin_time,
-                                                     // Log additional operation args / info.
-                                                     {
-                                                         {"op_name", p_op_kernel->KernelDef().OpName()},
-                                                         {"provider", p_op_kernel->KernelDef().Provider()},
-                                                         {"graph_index", std::to_string(p_op_kernel->Node().Index())},
-                                                         {"exec_plan_index", std::to_string(node_index)},
-                                                         {"activation_size", std::to_string(input_activation_sizes)},
-                                                         {"parameter_size", std::to_string(input_parameter_sizes)},
-                                                         {"output_size", std::to_string(total_output_sizes)},
-                                                         {"input_type_shape", input_type_shape},
-                                                         {"output_type_shape", output_type_shape},
-                                                         {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())},
-                                                     });
-      sync_time_begin = session_state.Profiler().Start();
-    }
+        // Trace execution step.
+        const Node& node = p_op_kernel->Node();
+        std::cout << "Executed op kernel node " << node_name_for_profiling
+                  << " Index=" << node.Index()
+                  << " OpType=" << node.OpType()
+                  << " Name=" << node.Name()
+                  << " Activation_Size=" << input_activation_sizes
+                  << " Parameter_Size=" << input_parameter_sizes
+                  << " Output_Size=" << total_output_sizes
+                  << "\n";
+#endif
 
-    // sync after compute for outputs
-    if (seq_exec_plan.NodeHasFence(node_index)) {
-      for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.InputFence(input_index);
-        if (fence) {
-          fence->AfterUsedAsInput(queue_id);
-        }
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name_for_profiling + "_kernel_time",
+                                                       kernel_begin_time,
+                                                       // Log additional operation args / info.
+                                                       {
+                                                           {"op_name", p_op_kernel->KernelDef().OpName()},
+                                                           {"provider", p_op_kernel->KernelDef().Provider()},
+                                                           {"graph_index", std::to_string(p_op_kernel->Node().Index())},
+                                                           {"exec_plan_index", std::to_string(node_index)},
+                                                           {"activation_size", std::to_string(input_activation_sizes)},
+                                                           {"parameter_size", std::to_string(input_parameter_sizes)},
+                                                           {"output_size", std::to_string(total_output_sizes)},
+                                                           {"input_type_shape", input_type_shape},
+                                                           {"output_type_shape", output_type_shape},
+                                                           {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state.GetThreadPool())},
+                                                           {"hardware_counters", hardware_counter_values},
+                                                       });
+        sync_time_begin = session_state.Profiler().Start();
       }
 
-      for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
-        Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
-        if (fence) {
-          fence->AfterUsedAsInput(queue_id);
+      // sync after compute for outputs
+      if (seq_exec_plan.NodeHasFence(node_index)) {
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
         }
-      }
 
-      for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
-        Fence_t fence = op_kernel_context.OutputFence(output_index);
-        if (fence) {
-          fence->AfterUsedAsOutput(queue_id);
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
+        }
+
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->AfterUsedAsOutput(queue_id);
+          }
         }
       }
-    }
+
+      ORT_RETURN_IF_ERROR(stream_scheduler.AfterCompute(node_index));
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
-    LARGE_INTEGER kernel_stop;
-    QueryPerformanceCounter(&kernel_stop);
-    LARGE_INTEGER elapsed;
-    elapsed.QuadPart = kernel_stop.QuadPart - kernel_start.QuadPart;
-    elapsed.QuadPart *= 1000000;
-    elapsed.QuadPart /= perf_freq.QuadPart;
-    // Log an event
-    TraceLoggingWrite(telemetry_provider_handle,  // handle to my provider
-                      "OpEnd",                    // Event Name that should uniquely identify your event.
-                      TraceLoggingValue(p_op_kernel->KernelDef().OpName().c_str(), "op_name"),
-                      TraceLoggingValue(elapsed.QuadPart, "time"));
-#endif
-    if (is_profiler_enabled) {
-      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                     node_name_for_profiling + "_fence_after",
-                                                     sync_time_begin,
-                                                     {{"op_name", p_op_kernel->KernelDef().OpName()}});
-    }
+      LARGE_INTEGER kernel_stop;
+      QueryPerformanceCounter(&kernel_stop);
+      LARGE_INTEGER elapsed;
+      elapsed.QuadPart = kernel_stop.QuadPart - kernel_start.QuadPart;
+      elapsed.QuadPart *= 1000000;
+      elapsed.QuadPart /= perf_freq.QuadPart;
+      // Log an event
+      TraceLoggingWrite(telemetry_provider_handle,  // handle to my provider
+                        "OpEnd",                    // Event Name that should uniquely identify your event.
+                        TraceLoggingValue(p_op_kernel->KernelDef().OpName().c_str(), "op_name"),
+                        TraceLoggingValue(elapsed.QuadPart, "time"));
+#endif
+      if (is_profiler_enabled) {
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name_for_profiling + "_fence_after",
+                                                       sync_time_begin,
+                                                       {{"op_name", p_op_kernel->KernelDef().OpName()}});
+      }
 
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
-    utils::DumpNodeOutputs(dump_context, op_kernel_context, p_op_kernel->Node(), session_state);
+      utils::DumpNodeOutputs(dump_context, op_kernel_context, p_op_kernel->Node(), session_state);
 #endif
 
-    // free ml-values corresponding to this node
-    VLOGS(logger, 1) << "Releasing node ML values.";
-    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+      // free ml-values corresponding to this node
+      VLOGS(logger, 1) << "Releasing node ML values.";
+      ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+    }
   }
 
 #ifdef ENABLE_NVTX_PROFILE
@@ -474,6 +584,8 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   }
 #endif
 
+  ORT_RETURN_IF_ERROR(stream_scheduler.End());
+
   VLOGS(logger, 1) << "Fetching output.";
   // ExecutionFrame::Finalize will update 'fetches' with the final output
   ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
@@ -501,6 +613,12 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     }
   }
 
+  if (record_metrics) {
+    metrics->RecordRun(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - run_begin_time)
+                           .count());
+  }
+
   if (is_profiler_enabled) {
     session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
   }
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/session_metrics.h"
+
+#include <map>
+#include <sstream>
+
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+void LatencyHistogram::Record(int64_t latency_us) {
+  size_t bucket = 0;
+  if (latency_us > 0) {
+    auto value = static_cast<uint64_t>(latency_us);
+    while (value != 0 && bucket < kNumBuckets - 1) {
+      value >>= 1;
+      ++bucket;
+    }
+  }
+
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_us_.fetch_add(latency_us > 0 ? static_cast<uint64_t>(latency_us) : 0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    buckets_[i].fetch_add(other.BucketCount(i), std::memory_order_relaxed);
+  }
+  count_.fetch_add(other.Count(), std::memory_order_relaxed);
+  total_us_.fetch_add(other.TotalMicroseconds(), std::memory_order_relaxed);
+}
+
+SessionMetrics::SessionMetrics(const GraphViewer& graph, uint64_t sampling_interval)
+    : sampling_interval_(sampling_interval == 0 ? 1 : sampling_interval) {
+  nodes_.resize(graph.MaxNodeIndex());
+  for (const auto& node : graph.Nodes()) {
+    auto node_metrics = std::make_unique<NodeMetrics>();
+    node_metrics->name = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+    node_metrics->op_type = node.OpType();
+    nodes_[node.Index()] = std::move(node_metrics);
+  }
+}
+
+static void WriteJsonString(std::ostringstream& ss, const std::string& value) {
+  ss << '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        ss << "\\\"";
+        break;
+      case '\\':
+        ss << "\\\\";
+        break;
+      case '\n':
+        ss << "\\n";
+        break;
+      case '\t':
+        ss << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          static const char* const hex = "0123456789abcdef";
+          ss << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+        } else {
+          ss << c;
+        }
+    }
+  }
+  ss << '"';
+}
+
+// Writes the count, the total and the bucket counts up to the last non-empty bucket.
+static void WriteHistogram(std::ostringstream& ss, const LatencyHistogram& histogram) {
+  size_t num_buckets = LatencyHistogram::kNumBuckets;
+  while (num_buckets > 0 && histogram.BucketCount(num_buckets - 1) == 0) {
+    --num_buckets;
+  }
+
+  ss << "\"count\":" << histogram.Count() << ",\"total_us\":" << histogram.TotalMicroseconds() << ",\"buckets\":[";
+  for (size_t i = 0; i < num_buckets; ++i) {
+    ss << (i == 0 ? "" : ",") << histogram.BucketCount(i);
+  }
+  ss << "]";
+}
+
+std::string SessionMetrics::ToJson(const ResourceUsage& resource_usage) const {
+  std::ostringstream ss;
+  ss << "{\"runs\":" << num_runs_.load(std::memory_order_relaxed)
+     << ",\"sampling_interval\":" << sampling_interval_
+     << ",\"run_latency\":{";
+  WriteHistogram(ss, run_latency_);
+  ss << "}";
+
+  // aggregate per op type. std::map keeps the output ordered.
+  std::map<std::string, LatencyHistogram> op_types;
+  for (const auto& node : nodes_) {
+    if (node != nullptr) {
+      op_types[node->op_type].Merge(node->latency);
+    }
+  }
+
+  ss << ",\"op_types\":{";
+  bool first = true;
+  for (const auto& entry : op_types) {
+    ss << (first ? "" : ",");
+    first = false;
+    WriteJsonString(ss, entry.first);
+    ss << ":{";
+    WriteHistogram(ss, entry.second);
+    ss << "}";
+  }
+
+  ss << "},\"nodes\":{";
+  first = true;
+  for (const auto& node : nodes_) {
+    if (node == nullptr) {
+      continue;
+    }
+    ss << (first ? "" : ",");
+    first = false;
+    WriteJsonString(ss, node->name);
+    ss << ":{\"op_type\":";
+    WriteJsonString(ss, node->op_type);
+    ss << ",";
+    WriteHistogram(ss, node->latency);
+    ss << "}";
+  }
+
+  ss << "},\"allocators\":{";
+  first = true;
+  for (const auto& entry : resource_usage.allocator_stats) {
+    const AllocatorStats& stats = entry.second;
+    ss << (first ? "" : ",");
+    first = false;
+    WriteJsonString(ss, entry.first);
+    ss << ":{\"bytes_in_use\":" << stats.bytes_in_use
+       << ",\"max_bytes_in_use\":" << stats.max_bytes_in_use
+       << ",\"total_allocated_bytes\":" << stats.total_allocated_bytes
+       << ",\"num_allocs\":" << stats.num_allocs << "}";
+  }
+
+  ss << "},\"intra_op_queued_tasks\":" << resource_usage.intra_op_queued_tasks
+     << ",\"inter_op_queued_tasks\":" << resource_usage.inter_op_queued_tasks << "}";
+
+  return ss.str();
+}
+
+}  // namespace onnxruntime
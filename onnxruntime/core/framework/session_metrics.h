@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator_stats.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+class GraphViewer;
+
+// Histogram of latencies with exponentially sized buckets.
+// Bucket 0 counts latencies below 1 microsecond, bucket i > 0 counts latencies in [2^(i-1), 2^i) microseconds and
+// the last bucket also counts everything above. Recording is lock free.
+class LatencyHistogram {
+ public:
+  static constexpr size_t kNumBuckets = 32;
+
+  LatencyHistogram() = default;
+
+  void Record(int64_t latency_us);
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t TotalMicroseconds() const { return total_us_.load(std::memory_order_relaxed); }
+  uint64_t BucketCount(size_t bucket) const { return buckets_[bucket].load(std::memory_order_relaxed); }
+
+  // Adds the counts of `other` to this histogram.
+  void Merge(const LatencyHistogram& other);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LatencyHistogram);
+
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> total_us_{0};
+};
+
+// Low overhead metrics of the runs of a session, enabled via kOrtSessionOptionsConfigMetricsSamplingInterval.
+// Unlike the profiler, which records every event of every run to a trace, only one in `sampling_interval` runs is
+// timed and the latencies are aggregated into histograms per node, so the metrics can be left on in production.
+class SessionMetrics {
+ public:
+  // Resource usage at the time the metrics are read, included in the JSON output.
+  struct ResourceUsage {
+    std::vector<std::pair<std::string, AllocatorStats>> allocator_stats;  // by allocator name
+    unsigned intra_op_queued_tasks = 0;
+    unsigned inter_op_queued_tasks = 0;
+  };
+
+  // `graph` is the main graph of the session. Subgraphs are not timed on their own, their time is part of the
+  // latency of the control flow node they belong to.
+  SessionMetrics(const GraphViewer& graph, uint64_t sampling_interval);
+
+  // Called at the start of a run. Returns true if the run should be timed.
+  bool ShouldSampleRun() {
+    auto run = num_runs_.fetch_add(1, std::memory_order_relaxed);
+    return run % sampling_interval_ == 0;
+  }
+
+  void RecordRun(int64_t latency_us) { run_latency_.Record(latency_us); }
+
+  void RecordNode(NodeIndex node_index, int64_t latency_us) {
+    if (node_index < nodes_.size() && nodes_[node_index] != nullptr) {
+      nodes_[node_index]->latency.Record(latency_us);
+    }
+  }
+
+  // Returns the metrics as a JSON object.
+  std::string ToJson(const ResourceUsage& resource_usage) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionMetrics);
+
+  struct NodeMetrics {
+    std::string name;
+    std::string op_type;
+    LatencyHistogram latency;
+  };
+
+  const uint64_t sampling_interval_;
+  std::atomic<uint64_t> num_runs_{0};
+  LatencyHistogram run_latency_;
+  // indexed by NodeIndex, nullptr for removed nodes
+  std::vector<std::unique_ptr<NodeMetrics>> nodes_;
+};
+
+}  // namespace onnxruntime
@@ -3,7 +3,11 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <sstream>
+#include <unordered_set>
 
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
@@ -157,7 +161,7 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager, bool parallel) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -166,6 +170,33 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
+
+    if (parallel && concurrency::ThreadPool::DegreeOfParallelism(thread_pool_) > 1) {
+      std::vector<const Node*> nodes_to_create;
+      nodes_to_create.reserve(graph_viewer_->NumberOfNodes());
+      for (const auto& node : nodes) {
+        nodes_to_create.push_back(&node);
+      }
+
+      // each kernel is written to its own slot of session_kernels_, the lookups only read the session state
+      std::vector<Status> statuses(nodes_to_create.size());
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          thread_pool_, static_cast<std::ptrdiff_t>(nodes_to_create.size()), [&](std::ptrdiff_t i) {
+            const Node& node = *nodes_to_create[i];
+            const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
+            const IExecutionProvider& exec_provider = *execution_providers_.Get(node.GetExecutionProviderType());
+            statuses[i] = kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci,
+                                                               session_kernels_[node.Index()]);
+          });
+
+      for (const auto& status : statuses) {
+        ORT_RETURN_IF_ERROR(status);
+      }
+
+      node_index_info_ = std::make_unique<NodeIndexInfo>(*graph_viewer_, ort_value_name_idx_map_);
+      return Status::OK();
+    }
+
     for (const auto& node : nodes) {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
@@ -287,19 +318,63 @@ static Status KernelUseSharedPrePackedBuffers(OpKernel& kernel, int input_idx,
 }
 
 static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
+                                                     HashValue kernel_def_hash,
                                                      const PrePackedWeights& pre_packed_weights) {
   std::ostringstream ss_1;
   ss_1 << op_type;
   ss_1 << "+";
+  ss_1 << std::to_string(kernel_def_hash);
+  ss_1 << "+";
   ss_1 << std::to_string(pre_packed_weights.GetHash());
 
   return ss_1.str();
 }
 
+Status SessionState::UseSavedPrePackedWeights(const Node& node, OpKernel& kernel, int input_idx, const Tensor& tensor,
+                                              const AllocatorPtr& alloc,
+                                              /*out*/ bool& used_saved_prepacked_weights) {
+  used_saved_prepacked_weights = false;
+
+  const auto entry = saved_prepacked_weights_.find({node.Index(), input_idx});
+  if (entry == saved_prepacked_weights_.end()) {
+    return Status::OK();
+  }
+
+  const fbs::PrePackedWeights& fbs_prepacked_weights = *entry->second;
+  const auto* fbs_format = fbs_prepacked_weights.format();
+  const auto* fbs_buffers = fbs_prepacked_weights.buffers();
+  ORT_RETURN_IF(nullptr == fbs_format || nullptr == fbs_buffers,
+                "Missing format or buffers of pre-packed weights. Invalid ORT format model.");
+
+  HashValue kernel_def_hash = fbs_prepacked_weights.kernel_def_hash();
+  utils::UpdateHashForBackwardsCompatibility(kernel_def_hash);
+  const std::string format = kernel.GetPrePackedWeightsFormat(input_idx);
+  if (format != fbs_format->str() ||
+      kernel_def_hash != GetNodeKernelCreateInfo(node.Index()).kernel_def->GetHash()) {
+    LOGS(logger_, INFO) << "Pre-packing input " << input_idx << " of node " << node.Name()
+                        << " as its saved pre-packed weights are of format '" << fbs_format->str()
+                        << "' instead of '" << format << "'";
+    return Status::OK();
+  }
+
+  PrePackedWeights prepacked_weights;
+  for (const auto* fbs_buffer : *fbs_buffers) {
+    const auto* data = fbs_buffer->data();
+    ORT_RETURN_IF(nullptr == data, "Missing data of pre-packed buffer. Invalid ORT format model.");
+
+    void* buffer = alloc->Alloc(data->size());
+    prepacked_weights.buffers_.emplace_back(buffer, BufferDeleter(alloc));
+    prepacked_weights.buffer_sizes_.push_back(data->size());
+    memcpy(buffer, data->Data(), data->size());
+  }
+
+  return kernel.UseSavedPrePackedBuffers(tensor, prepacked_weights, input_idx, used_saved_prepacked_weights);
+}
+
 Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count,
                                                        const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
   auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+                                        bool should_cache_prepacked_weights) -> Status {
     for (auto& node : GetGraphViewer().Nodes()) {
       auto kernel = GetMutableKernel(node.Index());
       int input_idx = 0;
@@ -321,8 +396,12 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
                 auto iter = initializers_to_share_map.find(input_name);
                 bool is_shared_initializer = (iter != initializers_to_share_map.end());
 
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                // Caching pre-packed weights is limited to initializers associated with the CPU EP for now.
+                // Unless the container caches all constant initializers, only shared initializers are cached.
+                bool cache_all_constant_initializers =
+                    should_cache_prepacked_weights && prepacked_weights_container_->CachesAllConstantInitializers();
+
+                if ((is_shared_initializer || cache_all_constant_initializers) && should_cache_prepacked_weights &&
                     node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
 
                   AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
@@ -338,7 +417,10 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
                                                       is_packed,
                                                       &weights_to_be_filled_in));
 
-                  if (is_packed) {
+                  if (is_packed && weights_to_be_filled_in.buffers_.empty() && !is_shared_initializer) {
+                    // The kernel keeps the pre-packed weight itself. That is fine for an initializer that isn't shared,
+                    // the weight then just isn't cached.
+                  } else if (is_packed) {
                     // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
                     ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
                                 " doesn't have an implementation that can cache computed pre-packed weights");
@@ -349,11 +431,14 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
                     // TODO: Check if some version of the ONNX IR allows op_type to be empty
                     ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
 
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
-                                                                                                           weights_to_be_filled_in);
+                    // The key for the pre-packed weights container lookup is the op_type + hash of the kernel def +
+                    // hash of the prepacked-weight that we just got by invoking PrePack() on this kernel.
+                    // The hash of the kernel def makes sure that only kernels of the same implementation share a
+                    // pre-packed weight, as the layout of pre-packed weights is specific to the kernel.
+                    const std::string& prepacked_weights_container_key =
+                        GenerateKeyForPrepackedWeightsMap(op_type,
+                                                          GetNodeKernelCreateInfo(node.Index()).kernel_def->GetHash(),
+                                                          weights_to_be_filled_in);
 
                     bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
 
@@ -376,15 +461,41 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
                                                                           prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
                                                                           node.Name()));
                     }
+
+                    prepacked_weights_container_->AddRefToWeight(prepacked_weights_container_key);
+                    used_prepacked_weights_keys_.push_back(prepacked_weights_container_key);
                   }
 
                 } else {  // caching of pre-packed weights' turned OFF
                   AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
-                                                      session_cpu_alloc,  // use allocator tied to this session
-                                                      is_packed,
-                                                      nullptr  // no caching required
-                                                      ));
+                  ORT_RETURN_IF_ERROR(UseSavedPrePackedWeights(node, *kernel, input_idx, const_initialized_tensor,
+                                                               session_cpu_alloc, is_packed));
+                  if (is_packed) {
+                    ++used_saved_pre_packed_weights_counter_;
+                  }
+#if !defined(ORT_MINIMAL_BUILD)
+                  else if (save_prepacked_weights_ && !kernel->GetPrePackedWeightsFormat(input_idx).empty()) {
+                    // keep the pre-packed buffers for SaveToOrtFormat(), and let the kernel use them
+                    PrePackedWeights weights_to_save;
+                    ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
+                                                        is_packed, &weights_to_save));
+                    if (is_packed && !weights_to_save.buffers_.empty()) {
+                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx, weights_to_save,
+                                                                          node.Name()));
+                      prepacked_weights_to_save_[{node.Index(), input_idx}] = {
+                          kernel->GetPrePackedWeightsFormat(input_idx),
+                          GetNodeKernelCreateInfo(node.Index()).kernel_def->GetHash(),
+                          std::move(weights_to_save)};
+                    }
+                  }
+#endif
+                  else {
+                    ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                                        session_cpu_alloc,  // use allocator tied to this session
+                                                        is_packed,
+                                                        nullptr  // no caching required
+                                                        ));
+                  }
                 }
                 if (is_packed) {
                   ++number_of_prepacks_counter_;
@@ -413,9 +524,9 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
     return Status::OK();
   };
 
-  bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
+  bool should_cache_prepacked_weights = (prepacked_weights_container_ != nullptr);
 
-  if (should_cache_prepacked_weights_for_shared_initializers) {
+  if (should_cache_prepacked_weights) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<onnxruntime::OrtMutex> l(prepacked_weights_container_->mutex_);
@@ -425,15 +536,117 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
+Status SessionState::ParallelPrepackConstantInitializedTensors(
+    std::unordered_map<std::string, size_t>& constant_initializers_use_count) {
+  struct PrepackInput {
+    SessionState* session_state;
+    const std::string* name;
+    int ort_value_idx;
+    int input_idx;
+    bool is_packed;
+  };
+
+  // collect the constant initialized inputs of every node, looking them up in the outer scopes like
+  // PrepackConstantInitializedTensors does. the inputs of a node are prepacked by the same thread.
+  std::vector<OpKernel*> kernels;
+  std::vector<size_t> node_input_starts;
+  std::vector<PrepackInput> inputs;
+  for (auto& node : GetGraphViewer().Nodes()) {
+    const size_t node_input_start = inputs.size();
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            if (st->constant_initialized_tensors_.count(ort_value_idx)) {
+              inputs.push_back({st, &input_name, ort_value_idx, input_idx, false});
+            }
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+        } while (st);
+      }
+      input_idx++;
+    }
+
+    if (inputs.size() > node_input_start) {
+      kernels.push_back(GetMutableKernel(node.Index()));
+      node_input_starts.push_back(node_input_start);
+    }
+  }
+  node_input_starts.push_back(inputs.size());
+
+  std::vector<Status> statuses(kernels.size());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(kernels.size()), [&](std::ptrdiff_t i) {
+        OpKernel& kernel = *kernels[i];
+        AllocatorPtr session_cpu_alloc = kernel.Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
+        for (size_t j = node_input_starts[i]; j < node_input_starts[i + 1]; ++j) {
+          auto& input = inputs[j];
+          const Tensor& tensor = input.session_state->constant_initialized_tensors_.at(input.ort_value_idx).Get<Tensor>();
+          statuses[i] = kernel.PrePack(tensor, input.input_idx, session_cpu_alloc, input.is_packed,
+                                       nullptr  // no caching required
+          );
+          if (!statuses[i].IsOK()) {
+            return;
+          }
+        }
+      });
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  // release the initializers once all the kernels using them have packed them
+  for (const auto& input : inputs) {
+    if (input.is_packed) {
+      ++number_of_prepacks_counter_;
+
+      if (constant_initializers_use_count.count(*input.name) && --constant_initializers_use_count[*input.name] == 0) {
+        input.session_state->initialized_tensors_.erase(input.ort_value_idx);
+        input.session_state->constant_initialized_tensors_.erase(input.ort_value_idx);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+static int64_t RoundUpToPowerOfTwo(int64_t dim) {
+  int64_t bucket = 1;
+  while (bucket < dim && bucket <= std::numeric_limits<int64_t>::max() / 2) {
+    bucket <<= 1;
+  }
+  return bucket < dim ? dim : bucket;
+}
+
+static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs, bool use_shape_buckets) {
+  if (!use_shape_buckets) {
+    int64_t key = 0;
+    for (const auto& input : tensor_inputs) {
+      for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    }
+    return key;
+  }
+
+  // Few buckets are used, so combine the dimensions in order rather than xor them, to avoid collisions of buckets
+  // that would make the pattern grow for both.
+  uint64_t key = 0;
   for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    key = key * 1000003 + dims.size();
+    for (auto dim : dims) {
+      key = key * 1000003 + static_cast<uint64_t>(RoundUpToPowerOfTwo(dim));
+    }
   }
-  return key;
+  return static_cast<int64_t>(key);
 }
 
-#ifdef ENABLE_TRAINING
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
                         const std::map<std::string, TensorShape>& feeds,
@@ -650,34 +863,219 @@ Status SessionState::GeneratePatternGroupCache(const gsl::span<const OrtValue>&
   }
   return Status::OK();
 }
-#endif
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const gsl::span<const OrtValue>& tensor_inputs,
-                                                              const std::vector<int>& feed_mlvalue_idxs,
-                                                              std::unordered_map<int, TensorShape>& inferred_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const gsl::span<const OrtValue>& tensor_inputs,
+    const std::vector<int>& feed_mlvalue_idxs,
+    std::unordered_map<int, TensorShape>& inferred_shapes,
+    std::unordered_map<int, size_t>& min_block_sizes) const {
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, mem_pattern_shape_buckets_);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) {
+    // plan the pattern from the shapes if they are known, otherwise the caller traces it during the run
 #ifdef ENABLE_TRAINING
-    auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns.get(), inferred_shapes).IsOK()) {
-      key = CalculateMemoryPatternsKey(tensor_inputs);
-      auto ptr = mem_patterns.get();
-      mem_patterns_[key] = std::move(mem_patterns);
-      shape_patterns_[key] = inferred_shapes;
-      return ptr;
+    const bool plan_from_shapes = true;
+#else
+    const bool plan_from_shapes = shapes_frozen_;
+#endif
+    if (plan_from_shapes) {
+      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+      if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns.get(), inferred_shapes).IsOK()) {
+        std::shared_ptr<const MemoryPatternGroup> ptr = std::move(mem_patterns);
+        CacheMemoryPatternGroup(key, ptr);
+        shape_patterns_[key] = inferred_shapes;
+        return ptr;
+      }
     }
     return nullptr;
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
+  }
+
+  if (it->second.outgrown) {
+    // the new pattern must fit the runs the outgrown pattern served and the runs that outgrew it
+    min_block_sizes = it->second.outgrown_sizes;
+    for (const auto& pattern : it->second.mem_patterns->patterns) {
+      for (const auto& block : pattern.GetPatternsMap()) {
+        auto& min_size = min_block_sizes[block.first];
+        min_size = std::max(min_size, block.second.size_);
+      }
+    }
     return nullptr;
+  }
+
+  mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+  auto shapes = shape_patterns_.find(key);
+  if (shapes != shape_patterns_.end()) {
+    inferred_shapes = shapes->second;
+  }
+  return it->second.mem_patterns;
+}
+
+// Op types of the CPU kernels that parallelize their computation over the intra op thread pool.
+static bool IsIntraOpHeavyOpType(const std::string& op_type) {
+  static const std::unordered_set<std::string> heavy_op_types{
+      "Attention", "Conv", "ConvInteger", "ConvTranspose", "DynamicQuantizeLSTM", "DynamicQuantizeMatMul",
+      "Einsum", "FusedConv", "FusedGemm", "FusedMatMul", "GRU", "Gemm", "LSTM", "MatMul", "MatMulInteger",
+      "MatMulIntegerToFloat", "NhwcMaxPool", "QAttention", "QLinearConv", "QLinearMatMul", "RNN",
+      "TreeEnsembleClassifier", "TreeEnsembleRegressor"};
+  return heavy_op_types.count(op_type) > 0;
+}
+
+// Estimated cost of a node with a heavy kernel relative to other nodes.
+static constexpr double kHeavyNodeCost = 10.0;
+
+void SessionState::ComputeNodePriorities() {
+  node_priorities_.assign(graph_viewer_->MaxNodeIndex(), 0.0);
+  intra_op_heavy_nodes_.assign(graph_viewer_->MaxNodeIndex(), false);
+
+  const auto& order = graph_viewer_->GetNodesInTopologicalOrder();
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    const Node& node = *graph_viewer_->GetNode(*it);
+    const bool is_heavy = node.GetExecutionProviderType() == kCpuExecutionProvider &&
+                          IsIntraOpHeavyOpType(node.OpType());
+    intra_op_heavy_nodes_[node.Index()] = is_heavy;
+
+    double successors_priority = 0.0;
+    for (auto output_node = node.OutputNodesBegin(); output_node != node.OutputNodesEnd(); ++output_node) {
+      successors_priority = std::max(successors_priority, node_priorities_[output_node->Index()]);
+    }
+
+    node_priorities_[node.Index()] = (is_heavy ? kHeavyNodeCost : 1.0) + successors_priority;
+  }
+}
+
+Status SessionState::PrepareExecutionPlanKernels() {
+  const auto& plan = *p_seq_exec_plan_;
+  execution_plan_kernels_.clear();
+  execution_plan_kernels_.reserve(plan.execution_plan.size());
+  can_use_lean_execution_ = !plan.HasMultipleComputeStreams();
+
+  for (const auto& node_exec_plan : plan.execution_plan) {
+    const OpKernel* kernel = GetKernel(node_exec_plan.node_index);
+    ORT_RETURN_IF(kernel == nullptr, "No kernel for node with index ", node_exec_plan.node_index);
+    execution_plan_kernels_.push_back(kernel);
+
+    if (plan.NodeHasFence(node_exec_plan.node_index)) {
+      can_use_lean_execution_ = false;
+    }
+#ifdef ENABLE_TRAINING
+    if (kernel->KernelDef().AllocateInputsContiguously()) {
+      can_use_lean_execution_ = false;
+    }
 #endif
   }
 
-  inferred_shapes = shape_patterns_[key];
-  return it->second.get();
+  return Status::OK();
+}
+
+Status SessionState::FreezeShapes() {
+  // shapes of the tensors by OrtValue index. the kernels get pointers to the elements, which stay valid on insertion
+  std::unordered_map<int, TensorShape> shapes;
+
+  // adds the shape of `arg` to `arg_shapes`, nullptr if it's not a tensor. returns false if the shape isn't static.
+  auto add_shape = [this, &shapes](const NodeArg& arg, std::vector<const TensorShape*>& arg_shapes) {
+    const auto* type = arg.TypeAsProto();
+    if (!arg.Exists() || type == nullptr || !type->has_tensor_type()) {
+      arg_shapes.push_back(nullptr);
+      return true;
+    }
+
+    int ort_value_idx;
+    ORT_THROW_IF_ERROR(ort_value_name_idx_map_.GetIdx(arg.Name(), ort_value_idx));
+    auto it = shapes.find(ort_value_idx);
+    if (it == shapes.end()) {
+      const auto* shape = arg.Shape();
+      if (shape == nullptr) {
+        return false;
+      }
+      TensorShapeVector dims;
+      dims.reserve(shape->dim_size());
+      for (const auto& dim : shape->dim()) {
+        if (!dim.has_dim_value() || dim.dim_value() < 0) {
+          return false;
+        }
+        dims.push_back(dim.dim_value());
+      }
+      it = shapes.emplace(ort_value_idx, TensorShape(dims)).first;
+    }
+    arg_shapes.push_back(&it->second);
+    return true;
+  };
+
+  struct KernelShapes {
+    OpKernel* kernel;
+    std::vector<const TensorShape*> input_shapes;
+    std::vector<const TensorShape*> output_shapes;
+  };
+  std::vector<KernelShapes> kernel_shapes;
+  kernel_shapes.reserve(graph_viewer_->NumberOfNodes());
+
+  for (const auto& node : graph_viewer_->Nodes()) {
+    KernelShapes entry{GetMutableKernel(node.Index()), {}, {}};
+    ORT_RETURN_IF(entry.kernel == nullptr, "No kernel for node ", node.Name());
+
+    for (const auto* arg : node.InputDefs()) {
+      if (!add_shape(*arg, entry.input_shapes)) {
+        LOGS(logger_, INFO) << "Shapes are not frozen as " << arg->Name() << " has no static shape";
+        return Status::OK();
+      }
+    }
+    for (const auto* arg : node.OutputDefs()) {
+      if (!add_shape(*arg, entry.output_shapes)) {
+        LOGS(logger_, INFO) << "Shapes are not frozen as " << arg->Name() << " has no static shape";
+        return Status::OK();
+      }
+    }
+    kernel_shapes.push_back(std::move(entry));
+  }
+
+  for (const auto& entry : kernel_shapes) {
+    ORT_RETURN_IF_ERROR(entry.kernel->PrepareForShapes(entry.input_shapes, entry.output_shapes));
+  }
+
+  shapes_frozen_ = true;
+  LOGS(logger_, INFO) << "Froze the shapes of " << shapes.size() << " tensors";
+  return Status::OK();
+}
+
+void SessionState::MarkMemoryPatternGroupOutgrown(const MemoryPatternGroup* mem_patterns, int ort_value_idx,
+                                                  size_t size) const {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  for (auto& entry : mem_patterns_) {
+    if (entry.second.mem_patterns.get() == mem_patterns) {
+      entry.second.outgrown = true;
+      auto& outgrown_size = entry.second.outgrown_sizes[ort_value_idx];
+      outgrown_size = std::max(outgrown_size, size);
+      break;
+    }
+  }
+}
+
+void SessionState::CacheMemoryPatternGroup(int64_t key, std::shared_ptr<const MemoryPatternGroup> mem_patterns) const {
+  auto it = mem_patterns_.find(key);
+  if (it != mem_patterns_.end()) {
+    // only an outgrown pattern is replaced, another run may have cached a pattern for the key concurrently
+    if (it->second.outgrown) {
+      it->second.mem_patterns = std::move(mem_patterns);
+      it->second.outgrown = false;
+      it->second.outgrown_sizes.clear();
+      mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+    }
+    return;
+  }
+
+  if (max_cached_mem_patterns_ > 0 && mem_patterns_.size() >= max_cached_mem_patterns_) {
+    const int64_t evicted_key = mem_patterns_lru_.back();
+    mem_patterns_lru_.pop_back();
+    mem_patterns_.erase(evicted_key);
+    shape_patterns_.erase(evicted_key);
+  }
+
+  mem_patterns_lru_.push_front(key);
+  auto& entry = mem_patterns_[key];
+  entry.mem_patterns = std::move(mem_patterns);
+  entry.lru_position = mem_patterns_lru_.begin();
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -706,13 +1104,10 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(const gsl::span<const OrtValue>& tensor_inputs,
                                                    std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, mem_pattern_shape_buckets_);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
-  }
+  CacheMemoryPatternGroup(key, std::move(mem_patterns));
 
   return Status::OK();
 }
@@ -927,7 +1322,34 @@ Status SessionState::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   ORT_RETURN_IF_ERROR(
       GetSubGraphSessionStatesOrtFormat(builder, subgraph_session_states_, sub_graph_session_states));
 
-  fbs_session_state = fbs::CreateSessionStateDirect(builder, kernels, &sub_graph_session_states);
+  // Pre-packed weights
+  std::vector<flatbuffers::Offset<fbs::PrePackedWeights>> prepacked_weights;
+  for (const auto& [key, to_save] : prepacked_weights_to_save_) {
+    const auto& buffers = to_save.weights.buffers_;
+    const auto& buffer_sizes = to_save.weights.buffer_sizes_;
+    bool can_save = buffers.size() == buffer_sizes.size();
+    for (size_t i = 0; can_save && i < buffers.size(); ++i) {
+      can_save = buffers[i] != nullptr && buffer_sizes[i] > 0;
+    }
+
+    if (!can_save) {
+      continue;
+    }
+
+    std::vector<flatbuffers::Offset<fbs::PrePackedBuffer>> fbs_buffers;
+    fbs_buffers.reserve(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      auto data = builder.CreateVector(static_cast<const uint8_t*>(buffers[i].get()), buffer_sizes[i]);
+      fbs_buffers.push_back(fbs::CreatePrePackedBuffer(builder, data));
+    }
+
+    prepacked_weights.push_back(
+        fbs::CreatePrePackedWeightsDirect(builder, gsl::narrow<uint32_t>(key.first), gsl::narrow<uint32_t>(key.second),
+                                          to_save.kernel_def_hash, to_save.format.c_str(), &fbs_buffers));
+  }
+
+  fbs_session_state = fbs::CreateSessionStateDirect(builder, kernels, &sub_graph_session_states,
+                                                    prepacked_weights.empty() ? nullptr : &prepacked_weights);
   return Status::OK();
 }
 
@@ -951,6 +1373,10 @@ Status SessionState::CreateSubgraphSessionState() {
           std::make_unique<SessionState>(*subgraph, execution_providers_, enable_mem_pattern_,
                                          thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
                                          logger_, profiler_);
+      subgraph_session_state->SetMemoryPatternCacheOptions(mem_pattern_shape_buckets_, max_cached_mem_patterns_);
+      subgraph_session_state->SetUseOfflineMemoryPatternPlanner(mem_pattern_offline_planner_);
+      subgraph_session_state->SetFreezeShapes(freeze_shapes_);
+      subgraph_session_state->SetMemoryBudget(memory_budget_bytes_);
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
@@ -973,6 +1399,15 @@ Status SessionState::LoadFromOrtFormat(const fbs::SessionState& fbs_session_stat
   const FbsSessionStateViewer fbs_session_state_viewer{fbs_session_state};
   ORT_RETURN_IF_ERROR(fbs_session_state_viewer.Validate());
 
+  // the pre-packed weights point into the ORT format model bytes, so they are only used until the kernels are
+  // prepacked in FinalizeSessionStateImpl()
+  if (const auto* fbs_prepacked_weights = fbs_session_state.prepacked_weights(); fbs_prepacked_weights != nullptr) {
+    for (const auto* fbs_entry : *fbs_prepacked_weights) {
+      ORT_RETURN_IF(nullptr == fbs_entry, "PrePackedWeights is null. Invalid ORT format model.");
+      saved_prepacked_weights_[{fbs_entry->node_index(), gsl::narrow<int>(fbs_entry->input_index())}] = fbs_entry;
+    }
+  }
+
   // look up KernelCreateInfo with hash and
   // - add KernelCreateInfo for node
   // - set node's EP from KernelCreateInfo if unset
@@ -1182,6 +1617,13 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
   // so also do it recursively when calling PopulateKernelCreateInfo for consistency.
   ORT_RETURN_IF_ERROR(CreateSubgraphSessionState());
 
+#if !defined(ORT_MINIMAL_BUILD)
+  save_prepacked_weights_ =
+      saving_ort_format &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSavePrePackedWeightsInOrtFormat,
+                                                        "0") == "1";
+#endif
+
   if (serialized_session_state) {
     ORT_RETURN_IF_ERROR(LoadFromOrtFormat(*serialized_session_state, kernel_registry_manager));
     // LoadFromOrtFormat() may assign node EPs so check afterwards
@@ -1389,6 +1831,9 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                                     outer_scope_node_arg_to_location_map,
                                                     ort_value_name_idx_map_, context, p_seq_exec_plan_));
   // Record the allocation plan
+  LOGS(logger_, INFO) << "Allocation plan of " << (parent_node ? "subgraph of " + parent_node->Name() : "main graph")
+                      << ": " << p_seq_exec_plan_->num_inplace_outputs << " node outputs written in place, "
+                      << p_seq_exec_plan_->num_reused_outputs << " reusing a freed buffer";
 
   // Uncomment the below to dump the allocation plan to std::cout
   // LOGS(logger_, VERBOSE) << std::make_pair(p_seq_exec_plan_.get(), this);
@@ -1429,7 +1874,16 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
           [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant, bool sparse) -> Status {
             return AddInitializedTensor(idx, value, &d, constant, sparse);
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options,
+          [this, remove_initializers](const std::string& name) {
+            if (remove_initializers) {
+              graph_.ReleaseInitializedTensorData(name);
+            }
+          },
+          [this](const OrtMemoryInfo& device_location) -> AllocatorPtr {
+            // CUDA pinned memory is mapped into the address space of every device with unified addressing
+            return GetAllocator(OrtDevice(OrtDevice::CPU, OrtDevice::MemType::CUDA_PINNED, device_location.device.Id()));
+          }));
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
   MemoryInfo::RecordInitializerAllocInfo(GetInitializedTensors());
@@ -1442,18 +1896,44 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  const bool parallel_kernel_creation =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelKernelCreation, "0") == "1";
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, parallel_kernel_creation));
 
 #ifndef ENABLE_TRAINING
   const auto disable_prepacking =
       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0");
 
   if (disable_prepacking != "1") {
-    ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+    // the pre-packed weights container, and the pre-packed weights of ORT format models, are shared by all the
+    // kernels, so prepacking only runs in parallel without them
+    bool parallel_prepacking = parallel_kernel_creation && prepacked_weights_container_ == nullptr &&
+                               saved_prepacked_weights_.empty() &&
+                               concurrency::ThreadPool::DegreeOfParallelism(thread_pool_) > 1;
+#if !defined(ORT_MINIMAL_BUILD)
+    parallel_prepacking = parallel_prepacking && !save_prepacked_weights_;
+#endif
+    if (parallel_prepacking) {
+      ORT_RETURN_IF_ERROR(ParallelPrepackConstantInitializedTensors(constant_initializers_use_count));
+    } else {
+      ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
+                                                            session_options.initializers_to_share_map));
+    }
   }
 #endif
 
+  saved_prepacked_weights_.clear();
+
+  if (freeze_shapes_) {
+    ORT_RETURN_IF_ERROR(FreezeShapes());
+  }
+
+  ORT_RETURN_IF_ERROR(PrepareExecutionPlanKernels());
+
+  if (session_options.execution_mode == ExecutionMode::ORT_PARALLEL) {
+    ComputeNodePriorities();
+  }
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInputOutputNamesToNodeMapping(*graph_viewer_, *this, valid_outer_scope_node_args));
 
@@ -1476,6 +1956,9 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                   "' OpType:", node.OpType(), " Index:", node.Index(), " Attribute:", attr_name);
 
       SessionState& subgraph_session_state = *entry->second;
+#if !defined(ORT_MINIMAL_BUILD)
+      subgraph_session_state.save_prepacked_weights_ = save_prepacked_weights_;
+#endif
 
       // recurse
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -21,6 +22,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/session_metrics.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -46,6 +48,7 @@ struct Offset;
 namespace onnxruntime {
 
 namespace fbs {
+struct PrePackedWeights;
 struct SessionState;
 }  // namespace fbs
 
@@ -113,6 +116,13 @@ class SessionState {
     for (auto& kvp : deleter_for_initialized_tensors_) {
       kvp.second.f(kvp.second.param);
     }
+
+    if (!used_prepacked_weights_keys_.empty()) {
+      std::lock_guard<onnxruntime::OrtMutex> l(prepacked_weights_container_->mutex_);
+      for (const auto& key : used_prepacked_weights_keys_) {
+        prepacked_weights_container_->ReleaseWeight(key);
+      }
+    }
   }
 
   // Graph viewer. CreateGraphInfo must have been called previously.
@@ -129,6 +139,22 @@ class SessionState {
     return (node_id < session_kernels_.size()) ? session_kernels_[node_id].get() : nullptr;
   }
 
+  // Kernels of the steps of the execution plan, in execution order, so the executor doesn't look them up per node.
+  const std::vector<const OpKernel*>& GetExecutionPlanKernels() const noexcept { return execution_plan_kernels_; }
+
+  // True if no node of the execution plan needs fences, a separate compute stream or contiguous inputs, so the
+  // SequentialExecutor may run the plan without the per-node synchronization and tracing.
+  bool CanUseLeanExecution() const noexcept { return can_use_lean_execution_; }
+
+  // Priority of each node for the ParallelExecutor, indexed by node index. It is the estimated cost of the longest
+  // path from the node to the end of the graph, so the nodes on the critical path run first.
+  // Only computed for sessions with the parallel execution mode.
+  const std::vector<double>& GetNodePriorities() const noexcept { return node_priorities_; }
+
+  // True for the nodes whose kernels parallelize over the intra op thread pool, indexed by node index.
+  // Only computed for sessions with the parallel execution mode.
+  const std::vector<bool>& GetIntraOpHeavyNodes() const noexcept { return intra_op_heavy_nodes_; }
+
   const ExecutionProviders& GetExecutionProviders() const noexcept { return execution_providers_; }
 
   /**
@@ -206,11 +232,62 @@ class SessionState {
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
+  If memory pattern shape buckets are enabled and the pattern of the bucket of the input shapes was outgrown,
+  nullptr is returned and min_block_sizes is set to the size each block of the new pattern needs by OrtValue index,
+  i.e. the larger of its block in the outgrown pattern and the largest allocation that outgrew it, so that the caller
+  traces a new pattern that fits all the runs seen in the bucket.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const gsl::span<const OrtValue>& tensor_inputs,
       const std::vector<int>& feed_mlvalue_idxs,
-      std::unordered_map<int, TensorShape>& inferred_shapes) const;
+      std::unordered_map<int, TensorShape>& inferred_shapes,
+      std::unordered_map<int, size_t>& min_block_sizes) const;
+
+  /**
+  Mark a cached memory pattern as too small for an allocation of size bytes for the OrtValue in a run in its bucket
+  of input shapes. The next run in the bucket traces a new pattern with a block of at least that size.
+  */
+  void MarkMemoryPatternGroupOutgrown(const MemoryPatternGroup* mem_patterns, int ort_value_idx, size_t size) const;
+
+  /**
+  Configure the cache of memory patterns.
+  If use_shape_buckets is true, the input dimensions are rounded up to powers of two and one pattern is cached
+  per bucket, with blocks large enough for all the runs seen in the bucket.
+  At most max_cached_patterns patterns are cached, evicting the least recently used one. 0 means no limit.
+  Applies to the subgraph session states created after the call.
+  */
+  void SetMemoryPatternCacheOptions(bool use_shape_buckets, size_t max_cached_patterns) {
+    mem_pattern_shape_buckets_ = use_shape_buckets;
+    max_cached_mem_patterns_ = max_cached_patterns;
+  }
+
+  bool GetEnableMemoryPatternShapeBuckets() const { return mem_pattern_shape_buckets_; }
+
+  // Use the offline mode of MemPatternPlanner, which assigns the offsets of a memory pattern from the lifetimes of
+  // all the blocks of the traced run instead of in the order in which they were allocated.
+  void SetUseOfflineMemoryPatternPlanner(bool offline) { mem_pattern_offline_planner_ = offline; }
+
+  bool GetUseOfflineMemoryPatternPlanner() const { return mem_pattern_offline_planner_; }
+
+  /**
+  Freeze the shapes of the tensors to the static shapes given by shape inference, if all of them have one.
+  The kernels are then prepared for these shapes (see OpKernel::PrepareForShapes) and the memory patterns are planned
+  from them instead of being traced.
+  Applies to the subgraph session states created after the call.
+  */
+  void SetFreezeShapes(bool freeze_shapes) { freeze_shapes_ = freeze_shapes; }
+
+  /**
+  Set the memory budget of the session in bytes. Allocating a tensor fails if it would take the memory in use in the
+  allocator above the budget. 0 means no budget.
+  Applies to the subgraph session states created after the call.
+  */
+  void SetMemoryBudget(size_t memory_budget_bytes) { memory_budget_bytes_ = memory_budget_bytes; }
+
+  size_t GetMemoryBudget() const { return memory_budget_bytes_; }
+
+  // True if the shapes were frozen, i.e. freezing them was requested and all of them are static.
+  bool HasFrozenShapes() const { return shapes_frozen_; }
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -321,6 +398,20 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedSavedPrePackedWeightCounter() const {
+    return used_saved_pre_packed_weights_counter_;
+  }
+
+  // Metrics of the runs of the session, or nullptr if metrics are disabled.
+  // Only set for the session state of the main graph.
+  SessionMetrics* GetMetrics() const {
+    return metrics_;
+  }
+
+  void SetMetrics(SessionMetrics* metrics) {
+    metrics_ = metrics;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -347,8 +438,9 @@ class SessionState {
   // Populate OrtValueNameIdxMap and create the graph viewer.
   void CreateGraphInfo();
 
-  // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  // create kernels using info in kernel_create_info_map_. if parallel is true the kernels are constructed
+  // concurrently on the intra-op thread pool.
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager, bool parallel);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -358,9 +450,20 @@ class SessionState {
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
    */
+  // Lets the kernel use the pre-packed weights saved in the ORT format model for the input if there are any,
+  // and they are of the format the kernel packs to.
+  Status UseSavedPrePackedWeights(const Node& node, OpKernel& kernel, int input_idx, const Tensor& tensor,
+                                  const AllocatorPtr& alloc, /*out*/ bool& used_saved_prepacked_weights);
+
   Status PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count,
                                            const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
 
+  // Prepacks the constant initialized tensors of different nodes concurrently on the intra-op thread pool.
+  // Only valid when the pre-packed weights are neither shared through a container nor loaded from or saved to an
+  // ORT format model, so that every PrePack call only modifies its own kernel.
+  Status ParallelPrepackConstantInitializedTensors(
+      std::unordered_map<std::string, size_t>& constant_initializers_use_count);
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -381,13 +484,20 @@ class SessionState {
                                   const std::unordered_map<OrtValueName, OrtMemoryInfo>& outer_scope_node_arg_to_location_map = {},
                                   bool graph_info_already_created = false);
 
-#ifdef ENABLE_TRAINING
   Status GeneratePatternGroupCache(
       const gsl::span<const OrtValue>& inputs,
       const std::vector<int>& feed_mlvalue_idxs,
       MemoryPatternGroup* output,
       std::unordered_map<int, TensorShape>& inferred_shapes) const;
-#endif
+
+  // Prepares the kernels for the static shapes of the tensors if they all have one. See SetFreezeShapes.
+  Status FreezeShapes();
+
+  // Resolves the kernels of the execution plan steps and checks if the plan can use the lean execution loop.
+  Status PrepareExecutionPlanKernels();
+
+  // Computes the node priorities and intra op heavy nodes used by the ParallelExecutor.
+  void ComputeNodePriorities();
 
   // the SessionState for the main Graph contains the compiled kernel hashes for the entire model
   const std::unordered_map<std::string, HashValue>& GetCompiledKernelHashes() const {
@@ -406,6 +516,10 @@ class SessionState {
 
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
+  std::vector<const OpKernel*> execution_plan_kernels_;
+  bool can_use_lean_execution_ = false;
+  std::vector<double> node_priorities_;
+  std::vector<bool> intra_op_heavy_nodes_;
   Graph& graph_;
   std::unique_ptr<GraphViewer> graph_viewer_;  // GraphViewer for const access to Graph
 
@@ -475,9 +589,33 @@ class SessionState {
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
 
+  struct CachedMemoryPatternGroup {
+    // shared with the execution frames using it, so that it can be evicted during their run
+    std::shared_ptr<const MemoryPatternGroup> mem_patterns;
+    bool outgrown = false;
+    // largest size of the allocations that outgrew the pattern by OrtValue index
+    std::unordered_map<int, size_t> outgrown_sizes;
+    std::list<int64_t>::iterator lru_position;
+  };
+
+  // Add a pattern to the cache, or replace an outgrown one, and evict the least recently used pattern if needed.
+  // mem_patterns_lock_ must be held.
+  void CacheMemoryPatternGroup(int64_t key, std::shared_ptr<const MemoryPatternGroup> mem_patterns) const;
+
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  mutable std::map<int64_t, CachedMemoryPatternGroup> mem_patterns_;
   mutable std::map<int64_t, std::unordered_map<int, TensorShape>> shape_patterns_;
+  // keys of mem_patterns_, most recently used first
+  mutable std::list<int64_t> mem_patterns_lru_;
+
+  bool mem_pattern_shape_buckets_ = false;
+  bool mem_pattern_offline_planner_ = false;
+  size_t max_cached_mem_patterns_ = 0;
+
+  bool freeze_shapes_ = false;
+  bool shapes_frozen_ = false;
+
+  size_t memory_budget_bytes_ = 0;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -502,6 +640,30 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // Keys of the weights in prepacked_weights_container_ used by the kernels of this session state.
+  // They are released when the session state is destroyed.
+  std::vector<std::string> used_prepacked_weights_keys_;
+
+  // Pre-packed weights saved in the ORT format model, by node index and input index.
+  // Set by LoadFromOrtFormat, and cleared once the kernels are pre-packed as they point into the model bytes.
+  std::map<std::pair<NodeIndex, int>, const fbs::PrePackedWeights*> saved_prepacked_weights_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Whether the pre-packed weights of the kernels are kept for SaveToOrtFormat,
+  // see kOrtSessionOptionsConfigSavePrePackedWeightsInOrtFormat.
+  bool save_prepacked_weights_ = false;
+
+  struct PrePackedWeightsToSave {
+    std::string format;
+    HashValue kernel_def_hash;
+    PrePackedWeights weights;
+  };
+
+  // Pre-packed weights to save in the ORT format model, by node index and input index.
+  // The kernels use the buffers without owning them.
+  std::map<std::pair<NodeIndex, int>, PrePackedWeightsToSave> prepacked_weights_to_save_;
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD)
   InlinedHashMap<InlinedVector<int>, InlinedHashSet<NodeIndex>> to_be_executed_nodes_;
 #endif
@@ -527,6 +689,12 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times pre-packed weights saved in the ORT format model were used instead of pre-packing
+  size_t used_saved_pre_packed_weights_counter_ = 0;
+
+  // owned by the InferenceSession
+  SessionMetrics* metrics_ = nullptr;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
@@ -127,6 +127,45 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   return common::Status::OK();
 }
 
+namespace {
+// Buffer of an initializer offloaded to host memory, which is released with the session state
+struct HostInitializerBuffer {
+  AllocatorPtr allocator;
+  void* buffer;
+};
+
+void FreeHostInitializerBuffer(void* param) noexcept {
+  auto* host_buffer = static_cast<HostInitializerBuffer*>(param);
+  host_buffer->allocator->Free(host_buffer->buffer);
+  delete host_buffer;
+}
+}  // namespace
+
+// Deserialize an initializer planned for device_location into host memory that the device reads directly.
+static common::Status DeserializeTensorProtoToHostMemory(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                                         const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                         const OrtMemoryInfo& device_location,
+                                                         const AllocatorPtr& host_alloc,
+                                                         OrtValue& ort_value, OrtCallback& deleter) {
+  TensorShape tensor_shape{utils::GetTensorShapeFromTensorProto(tensor_proto)};
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  void* tensor_buffer = nullptr;
+  ORT_RETURN_IF_ERROR(AllocateBufferUsingDeviceAllocatorFromShapeAndType(tensor_shape, type, host_alloc, tensor_buffer));
+  deleter = OrtCallback{FreeHostInitializerBuffer, new HostInitializerBuffer{host_alloc, tensor_buffer}};
+
+  auto p_tensor = std::make_unique<Tensor>(type, tensor_shape, tensor_buffer, device_location);
+  Status status = utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor);
+  if (!status.IsOK()) {
+    OrtRunCallback(&deleter);
+    deleter = OrtCallback{nullptr, nullptr};
+    return status;
+  }
+
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return Status::OK();
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -136,7 +175,9 @@ common::Status SaveInitializedTensors(
     const SaveTensorFunction& save_tensor_func,
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
-    const SessionOptions& session_options) {
+    const SessionOptions& session_options,
+    const ReleaseTensorProtoFunction& release_tensor_proto_func,
+    const GetHostAllocatorFunction& get_host_allocator_func) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -169,15 +210,76 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // Determine if an initializer can use its external data in place, either from a memory mapping of the file or
+  // from memory the data is already in. This requires that the initializer is planned to live in default CPU memory,
+  // and that data in a file is suitably aligned.
+  const bool use_mmap_for_external_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseMmapForExternalInitializers,
+                                                        "0") == "1";
+  auto can_map_external_initializer =
+      [&exec_plan, &default_cpu_alloc, &logger, use_mmap_for_external_initializers](
+          int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) -> bool {
+    if (!utils::HasExternalData(tensor_proto) ||
+        tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        !(exec_plan.GetLocation(ort_value_index).device == default_cpu_alloc->Info().device)) {
+      return false;
+    }
+
+    std::unique_ptr<ExternalDataInfo> external_data_info;
+    if (!ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info).IsOK()) {
+      return false;
+    }
+
+    if (external_data_info->GetRelPath() == utils::kTensorProtoMemoryAddressTag) {
+      return true;
+    }
+
+    if (!use_mmap_for_external_initializers) {
+      return false;
+    }
+
+    if (external_data_info->GetOffset() % static_cast<FileOffsetType>(utils::kMappedExternalDataAlignment) != 0) {
+      LOGS(logger, INFO) << "Copying external data of initializer " << tensor_proto.name()
+                         << " as its offset is not a multiple of " << utils::kMappedExternalDataAlignment;
+      return false;
+    }
+
+    return true;
+  };
+
+  // Determine if an initializer planned for CUDA device memory is kept in host memory the device can read instead.
+  const bool offload_initializers_to_host =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsOffloadInitializersToHostMemory, "0") == "1";
+  auto get_offload_allocator = [&exec_plan, &get_host_allocator_func, offload_initializers_to_host](
+                                   int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) -> AllocatorPtr {
+    if (!offload_initializers_to_host || !get_host_allocator_func ||
+        tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return nullptr;
+    }
+
+    const auto& location = exec_plan.GetLocation(ort_value_index);
+    if (location.device.Type() != OrtDevice::GPU || strcmp(location.name, CUDA) != 0) {
+      return nullptr;
+    }
+
+    return get_host_allocator_func(location);
+  };
+
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   std::set<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  std::set<int> mapped_initializer_ids;         // set containing the ort value ids of all mapped initializers
+  std::unordered_map<int, AllocatorPtr> offloaded_initializer_allocators;  // initializers kept in host memory
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (can_map_external_initializer(ort_value_index, *entry.second)) {
+      mapped_initializer_ids.insert(ort_value_index);
+    } else if (auto host_alloc = get_offload_allocator(ort_value_index, *entry.second)) {
+      offloaded_initializer_allocators[ort_value_index] = std::move(host_alloc);
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -185,6 +287,9 @@ common::Status SaveInitializedTensors(
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
   auto initialized_tensors_to_allocate = id_to_initialized_tensor;
   for (int ort_value_index : initializer_allocation_order) {
+    // the order can only be honored for memory allocated by the planner
+    mapped_initializer_ids.erase(ort_value_index);
+    offloaded_initializer_allocators.erase(ort_value_index);
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     // can not trace string tensor
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end() && entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING);
@@ -197,6 +302,14 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       continue;
     }
+    // Nor mapped initializers since their memory is the file mapping, or the memory their data is already in
+    if (mapped_initializer_ids.find(entry.first) != mapped_initializer_ids.end()) {
+      continue;
+    }
+    // Nor offloaded initializers since their memory is allocated in host memory
+    if (offloaded_initializer_allocators.find(entry.first) != offloaded_initializer_allocators.end()) {
+      continue;
+    }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
       // do not trace string tensor
       continue;
@@ -220,17 +333,44 @@ common::Status SaveInitializedTensors(
                        << i.second << " bytes for " << i.first << std::endl;
   }
 
-  OrtCallback deleter{nullptr, nullptr};
-
   //3. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const char* name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
     OrtValue ort_value;
+    OrtCallback deleter{nullptr, nullptr};
 
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (mapped_initializer_ids.find(entry.first) != mapped_initializer_ids.end()) {
+      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
+      Status st = utils::MapExternalDataTensorProtoToMLValue(env, graph_loc.c_str(), tensor_proto,
+                                                             default_cpu_alloc->Info(), ort_value, deleter);
+      if (!st.IsOK()) {
+        // it wasn't traced by the planner, so fall back to allocating the memory directly
+        LOGS(logger, WARNING) << "Failed to map external data of initializer " << name << ". Copying it instead. "
+                              << st.ErrorMessage();
+        st = DeserializeTensorProto(env, graph_loc, tensor_proto, nullptr, default_cpu_alloc, default_cpu_alloc,
+                                    ort_value, data_transfer_mgr);
+      }
+
+      if (!st.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
+      }
+    } else if (offloaded_initializer_allocators.find(entry.first) != offloaded_initializer_allocators.end()) {
+      const AllocatorPtr& host_alloc = offloaded_initializer_allocators.at(entry.first);
+      Status st = DeserializeTensorProtoToHostMemory(env, graph_loc, *(entry.second), exec_plan.GetLocation(ort_value_index),
+                                                     host_alloc, ort_value, deleter);
+      if (!st.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " to host memory failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
+      }
+      LOGS(logger, INFO) << "Initializer " << name << " of " << exec_plan.GetLocation(ort_value_index).ToString()
+                         << " is kept in " << host_alloc->Info().ToString();
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
@@ -261,6 +401,11 @@ common::Status SaveInitializedTensors(
 #endif
 
     VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
+
+    // free the data of each TensorProto as soon as it is copied, so that a model's weights are not held twice
+    if (release_tensor_proto_func) {
+      release_tensor_proto_func(entry.second->name());
+    }
   }
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
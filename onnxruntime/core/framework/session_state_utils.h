@@ -32,6 +32,10 @@ class Logger;
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(int idx, const OrtValue& value, const OrtCallback& d,
                                                 bool constant, bool sparse)>;
+// Called with the name of an initializer once its TensorProto is no longer needed.
+using ReleaseTensorProtoFunction = std::function<void(const std::string& name)>;
+// Returns the allocator for host memory that the given device can access directly, or nullptr if there is none.
+using GetHostAllocatorFunction = std::function<AllocatorPtr(const OrtMemoryInfo& device_location)>;
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -41,7 +45,9 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger,
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
-    const SessionOptions& session_options);
+    const SessionOptions& session_options,
+    const ReleaseTensorProtoFunction& release_tensor_proto_func = {},
+    const GetHostAllocatorFunction& get_host_allocator_func = {});
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
                                                  const std::vector<const NodeArg*>& implicit_inputs);
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/small_alloc_cache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+namespace onnxruntime {
+
+namespace {
+size_t ComputeNumShards() {
+  // round up to a power of 2 so the shard can be selected with a mask
+  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  size_t num_shards = 1;
+  while (num_shards < num_threads && num_shards < 64) {
+    num_shards <<= 1;
+  }
+  return num_shards;
+}
+
+// Each thread is assigned a stable index the first time it touches any cache.
+size_t CurrentThreadIndex() {
+  static std::atomic<size_t> next_thread_index{0};
+  thread_local size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return thread_index;
+}
+}  // namespace
+
+SmallAllocCache::SmallAllocCache()
+    : num_shards_(ComputeNumShards()),
+      shards_(std::make_unique<Shard[]>(num_shards_)) {
+}
+
+void SmallAllocCache::Initialize(void* region, size_t region_bytes) {
+  ORT_ENFORCE(!IsInitialized(), "SmallAllocCache is already initialized");
+  ORT_ENFORCE(region != nullptr && region_bytes >= kSlabSize && region_bytes % kSlabSize == 0,
+              "Invalid region for SmallAllocCache. Size: ", region_bytes);
+
+  region_bytes_ = region_bytes;
+  num_slabs_ = region_bytes / kSlabSize;
+  slab_classes_ = std::make_unique<std::atomic<uint8_t>[]>(num_slabs_);
+  for (size_t i = 0; i < num_slabs_; ++i) {
+    slab_classes_[i].store(kUnassignedSlab, std::memory_order_relaxed);
+  }
+
+  // publish the region last so Contains() never sees a partially initialized cache
+  base_.store(static_cast<char*>(region), std::memory_order_release);
+}
+
+SmallAllocCache::Shard& SmallAllocCache::CurrentShard() {
+  return shards_[CurrentThreadIndex() & (num_shards_ - 1)];
+}
+
+bool SmallAllocCache::Refill(size_t size_class, std::vector<void*>& blocks) {
+  {
+    Depot& depot = depots_[size_class];
+    std::lock_guard<OrtMutex> lock(depot.mutex);
+    if (!depot.free_blocks.empty()) {
+      size_t num_to_move = std::min(kBatchSize, depot.free_blocks.size());
+      auto begin = depot.free_blocks.end() - num_to_move;
+      blocks.insert(blocks.end(), begin, depot.free_blocks.end());
+      depot.free_blocks.erase(begin, depot.free_blocks.end());
+      return true;
+    }
+  }
+
+  // carve a new slab for this class. slabs are never returned to the unassigned pool.
+  size_t slab = next_slab_.fetch_add(1, std::memory_order_relaxed);
+  if (slab >= num_slabs_) {
+    return false;
+  }
+
+  slab_classes_[slab].store(static_cast<uint8_t>(size_class), std::memory_order_release);
+
+  const size_t block_size = ClassBlockSize(size_class);
+  const size_t num_blocks = kSlabSize / block_size;
+  char* slab_begin = base_.load(std::memory_order_relaxed) + slab * kSlabSize;
+
+  // the blocks beyond the first batch go to the depot so other threads can pick them up
+  size_t num_local = std::min(kBatchSize, num_blocks);
+  for (size_t i = 0; i < num_local; ++i) {
+    blocks.push_back(slab_begin + i * block_size);
+  }
+
+  if (num_local < num_blocks) {
+    Depot& depot = depots_[size_class];
+    std::lock_guard<OrtMutex> lock(depot.mutex);
+    for (size_t i = num_local; i < num_blocks; ++i) {
+      depot.free_blocks.push_back(slab_begin + i * block_size);
+    }
+  }
+
+  return true;
+}
+
+void* SmallAllocCache::Alloc(size_t size) {
+  const size_t size_class = ClassForSize(size);
+  Shard& shard = CurrentShard();
+
+  void* p = nullptr;
+  {
+    std::lock_guard<OrtMutex> lock(shard.mutex);
+    auto& blocks = shard.free_blocks[size_class];
+    if (blocks.empty() && !Refill(size_class, blocks)) {
+      num_misses_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    p = blocks.back();
+    blocks.pop_back();
+  }
+
+  num_hits_.fetch_add(1, std::memory_order_relaxed);
+  bytes_in_use_.fetch_add(static_cast<int64_t>(ClassBlockSize(size_class)), std::memory_order_relaxed);
+  return p;
+}
+
+void SmallAllocCache::Free(void* p) {
+  const size_t block_size = BlockSize(p);
+  const size_t size_class = ClassForSize(block_size);
+  Shard& shard = CurrentShard();
+
+  {
+    std::lock_guard<OrtMutex> lock(shard.mutex);
+    auto& blocks = shard.free_blocks[size_class];
+    blocks.push_back(p);
+
+    // return a batch to the depot so memory freed on one thread can be reused by allocations on another
+    if (blocks.size() > kMaxBlocksPerShardClass) {
+      Depot& depot = depots_[size_class];
+      std::lock_guard<OrtMutex> depot_lock(depot.mutex);
+      auto begin = blocks.end() - kBatchSize;
+      depot.free_blocks.insert(depot.free_blocks.end(), begin, blocks.end());
+      blocks.erase(begin, blocks.end());
+    }
+  }
+
+  bytes_in_use_.fetch_sub(static_cast<int64_t>(block_size), std::memory_order_relaxed);
+}
+
+size_t SmallAllocCache::BlockSize(const void* p) const {
+  const char* base = base_.load(std::memory_order_acquire);
+  const size_t slab = static_cast<size_t>(static_cast<const char*>(p) - base) / kSlabSize;
+  const uint8_t size_class = slab_classes_[slab].load(std::memory_order_acquire);
+  ORT_ENFORCE(size_class != kUnassignedSlab, "Pointer ", p, " was not allocated by the SmallAllocCache");
+  return ClassBlockSize(size_class);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// A slab based front-end for small allocations.
+//
+// The cache owns a single contiguous region (handed to it by the owning arena) that is split into fixed size
+// slabs. A slab is bound to one size class the first time it is needed and carved into equally sized blocks.
+// Free blocks live in per-thread shards and in a per-class depot. Allocating from or freeing to a shard only
+// takes the shard lock, which is uncontended as long as there are at least as many shards as threads using
+// the arena. Blocks move between a shard and the depot in batches so the depot lock is taken rarely.
+//
+// Because the region is contiguous, `Contains` can tell whether a pointer belongs to the cache without any
+// lock, and the size class of a block is found from the slab it lives in.
+//
+// No memory is written inside the blocks, so the cache can front allocators of non-CPU memory as well.
+class SmallAllocCache {
+ public:
+  static constexpr size_t kBlockGranularity = 256;
+  static constexpr size_t kMaxBlockSize = 4096;
+  static constexpr size_t kNumClasses = kMaxBlockSize / kBlockGranularity;
+  static constexpr size_t kSlabSize = 64 * 1024;
+  static constexpr size_t kDefaultRegionBytes = 16 * 1024 * 1024;
+
+  SmallAllocCache();
+  ~SmallAllocCache() = default;
+
+  // Hands the backing region to the cache. `region_bytes` must be a multiple of kSlabSize. Block offsets are
+  // multiples of kBlockGranularity so blocks have the same alignment as the region. May only be called once.
+  void Initialize(void* region, size_t region_bytes);
+
+  bool IsInitialized() const { return base_.load(std::memory_order_acquire) != nullptr; }
+
+  void* Region() const { return base_.load(std::memory_order_acquire); }
+  size_t RegionBytes() const { return region_bytes_; }
+
+  static bool IsSmall(size_t size) { return size != 0 && size <= kMaxBlockSize; }
+
+  // Returns a block of at least `size` bytes, or nullptr if the cache ran out of slabs for the size class.
+  // `size` must satisfy IsSmall().
+  void* Alloc(size_t size);
+
+  // Returns true if `p` was allocated by this cache.
+  bool Contains(const void* p) const {
+    const char* base = base_.load(std::memory_order_acquire);
+    const char* c = static_cast<const char*>(p);
+    return base != nullptr && c >= base && c < base + region_bytes_;
+  }
+
+  // Returns a block to the cache. `p` must satisfy Contains().
+  void Free(void* p);
+
+  // The usable size of a block allocated by this cache.
+  size_t BlockSize(const void* p) const;
+
+  int64_t NumHits() const { return num_hits_.load(std::memory_order_relaxed); }
+  int64_t NumMisses() const { return num_misses_.load(std::memory_order_relaxed); }
+  int64_t BytesInUse() const { return bytes_in_use_.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr size_t kBatchSize = 32;
+  static constexpr size_t kMaxBlocksPerShardClass = 2 * kBatchSize;
+  static constexpr uint8_t kUnassignedSlab = 0xFF;
+
+  static size_t ClassForSize(size_t size) { return (size - 1) / kBlockGranularity; }
+  static size_t ClassBlockSize(size_t size_class) { return (size_class + 1) * kBlockGranularity; }
+
+  struct alignas(64) Shard {
+    OrtMutex mutex;
+    std::array<std::vector<void*>, kNumClasses> free_blocks;
+  };
+
+  struct alignas(64) Depot {
+    OrtMutex mutex;
+    std::vector<void*> free_blocks;
+  };
+
+  Shard& CurrentShard();
+
+  // Moves up to kBatchSize blocks of `size_class` into `blocks`, carving a new slab if the depot is empty.
+  // Returns false if no blocks could be provided.
+  bool Refill(size_t size_class, std::vector<void*>& blocks);
+
+  std::atomic<char*> base_{nullptr};
+  size_t region_bytes_ = 0;
+  size_t num_slabs_ = 0;
+  std::atomic<size_t> next_slab_{0};
+  std::unique_ptr<std::atomic<uint8_t>[]> slab_classes_;
+
+  size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
+  std::array<Depot, kNumClasses> depots_;
+
+  std::atomic<int64_t> num_hits_{0};
+  std::atomic<int64_t> num_misses_{0};
+  std::atomic<int64_t> bytes_in_use_{0};
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SmallAllocCache);
+};
+
+}  // namespace onnxruntime
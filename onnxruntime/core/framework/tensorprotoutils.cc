@@ -149,6 +149,25 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
   return Status::OK();
 }
 
+// Returns true and the data of a tensor proto whose external data is in memory rather than in a file,
+// see kTensorProtoMemoryAddressTag.
+static bool GetExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                    const void*& data, size_t& length) {
+  if (!onnxruntime::utils::HasExternalData(tensor_proto)) {
+    return false;
+  }
+
+  std::unique_ptr<onnxruntime::ExternalDataInfo> external_data_info;
+  if (!onnxruntime::ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info).IsOK() ||
+      external_data_info->GetRelPath() != onnxruntime::utils::kTensorProtoMemoryAddressTag) {
+    return false;
+  }
+
+  data = reinterpret_cast<const void*>(static_cast<intptr_t>(external_data_info->GetOffset()));
+  length = external_data_info->GetLength();
+  return true;
+}
+
 // Read external data for tensor in unint8_t* form and return Status::OK() if the data is read successfully.
 // Uses the tensor_proto_dir to construct the full path for external data. If tensor_proto_dir == nullptr
 // then uses the current directory instead.
@@ -156,6 +175,14 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
 static Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                         const ORTCHAR_T* tensor_proto_dir,
                                         std::vector<uint8_t>& unpacked_tensor) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    const auto* data_begin = static_cast<const uint8_t*>(data_in_memory);
+    unpacked_tensor.assign(data_begin, data_begin + data_in_memory_length);
+    return Status::OK();
+  }
+
   std::basic_string<ORTCHAR_T> external_file_path;
   onnxruntime::FileOffsetType file_offset;
   SafeInt<size_t> tensor_byte_size;
@@ -401,6 +428,12 @@ Status UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, const void* raw_d
 template <typename T>
 Status UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, const Path& model_path,
                     /*out*/ T* p_data, size_t expected_num_elements) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (GetExternalDataInMemory(tensor, data_in_memory, data_in_memory_length)) {
+    return UnpackTensor(tensor, data_in_memory, data_in_memory_length, p_data, expected_num_elements);
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
   if (HasExternalData(tensor)) {
     return UnpackTensorWithExternalData(
@@ -615,8 +648,14 @@ Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
   void* raw_data = nullptr;
   SafeInt<size_t> raw_data_len = 0;
   AutoDelete deleter_for_file_data;
-
-  if (utils::HasExternalData(tensor_proto)) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+
+  if (GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    // the data is only read, as for raw data below
+    raw_data = const_cast<void*>(data_in_memory);
+    raw_data_len = data_in_memory_length;
+  } else if (utils::HasExternalData(tensor_proto)) {
     // Get the external data info
     std::basic_string<ORTCHAR_T> external_data_file_path;
     FileOffsetType file_offset;
@@ -692,6 +731,69 @@ Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
   return Status::OK();
 }
 
+Status MapExternalDataTensorProtoToMLValue(const Env& env, const ORTCHAR_T* model_path,
+                                           const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                           const OrtMemoryInfo& memory_info,
+                                           OrtValue& value, OrtCallback& deleter) {
+  deleter = OrtCallback{nullptr, nullptr};
+
+  // the data is used as is, so it must not need byte swapping
+  ORT_IF_CONSTEXPR(endian::native != endian::little) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Mapping external data requires a little-endian machine.");
+  }
+
+  // data that is already in memory is used in place without any mapping
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    TensorShape tensor_shape{GetTensorShapeFromTensorProto(tensor_proto)};
+    const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+    auto tensor = std::make_unique<Tensor>(type, tensor_shape, const_cast<void*>(data_in_memory), memory_info);
+    ORT_RETURN_IF_NOT(tensor->SizeInBytes() == data_in_memory_length, "External data size mismatch for ",
+                      tensor_proto.name());
+
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    value.Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    return Status::OK();
+  }
+
+  std::basic_string<ORTCHAR_T> tensor_proto_dir;
+  if (model_path != nullptr) {
+    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_path, tensor_proto_dir));
+  }
+
+  std::basic_string<ORTCHAR_T> external_data_file_path;
+  FileOffsetType file_offset;
+  SafeInt<size_t> raw_data_len = 0;
+  ORT_RETURN_IF_ERROR(GetExternalDataInfo(
+      tensor_proto,
+      tensor_proto_dir.size() == 0 ? nullptr : tensor_proto_dir.c_str(),
+      external_data_file_path, file_offset, raw_data_len));
+
+  ORT_RETURN_IF_NOT(file_offset % static_cast<FileOffsetType>(kMappedExternalDataAlignment) == 0,
+                    "External data offset ", file_offset, " of ", tensor_proto.name(), " is not a multiple of ",
+                    kMappedExternalDataAlignment, ". Use tools/python/align_external_data.py to re-save the model.");
+
+  TensorShape tensor_shape{GetTensorShapeFromTensorProto(tensor_proto)};
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+
+  Env::MappedMemoryPtr mapped_memory{};
+  if (raw_data_len > 0) {
+    ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(external_data_file_path.c_str(), file_offset, raw_data_len,
+                                              mapped_memory));
+  }
+
+  auto tensor = std::make_unique<Tensor>(type, tensor_shape, mapped_memory.get(), memory_info);
+  ORT_RETURN_IF_NOT(tensor->SizeInBytes() == raw_data_len, "External data size mismatch for ", tensor_proto.name());
+
+  deleter = mapped_memory.get_deleter().callback;
+  mapped_memory.release();
+
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value.Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  return Status::OK();
+}
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 6239)
@@ -1303,7 +1405,10 @@ Status UnpackInitializerData(const onnx::TensorProto& initializer,
 
 Status UnpackInitializerData(const ONNX_NAMESPACE::TensorProto& initializer,
                              std::vector<uint8_t>& unpacked_tensor) {
-  ORT_RETURN_IF(initializer.data_location() == TensorProto_DataLocation_EXTERNAL,
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  ORT_RETURN_IF(initializer.data_location() == TensorProto_DataLocation_EXTERNAL &&
+                    !GetExternalDataInMemory(initializer, data_in_memory, data_in_memory_length),
                 "The given initializer contains external data");
   return UnpackInitializerData(initializer, Path(), unpacked_tensor);
 }
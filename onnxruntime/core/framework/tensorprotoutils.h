@@ -57,6 +57,36 @@ common::Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
                                    const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                    Tensor& tensor);
 
+// Location of the external data of a TensorProto whose data is in memory, at the address given by its offset, rather
+// than in a file. fbs::utils::LoadInitializerOrtFormat creates such tensor protos to refer to the bytes of an ORT
+// format model without copying them. The memory must outlive the tensor proto and anything created from it.
+// Models loaded from ONNX protos are rejected if they use it, see Model::Model.
+constexpr const ORTCHAR_T* kTensorProtoMemoryAddressTag = ORT_TSTR("*/_ORT_MEM_ADDR_/*");
+
+// External data must start at a multiple of this offset to be used in place by MapExternalDataTensorProtoToMLValue.
+// tools/python/align_external_data.py saves models that satisfy this.
+constexpr size_t kMappedExternalDataAlignment = 4096;
+
+/**
+ * @brief Create a CPU tensor that refers directly to a memory mapping of the external data of a TensorProto,
+ *        instead of copying the data into an allocated buffer. The mapping is copy-on-write, so the physical
+ *        memory is shared with the page cache, and with any other session or process that maps the same file,
+ *        as long as the tensor is not written to.
+ * @param env
+ * @param model_path    path of the model the tensor proto comes from. Can be NULL, see TensorProtoToMLValue.
+ * @param tensor_proto  tensor proto with external data. The data offset must be a multiple of
+ *                      kMappedExternalDataAlignment, and the data can't be of type string. Data in memory, see
+ *                      kTensorProtoMemoryAddressTag, is used in place without any mapping or alignment requirement.
+ * @param memory_info   memory info of the CPU allocator the tensor is reported as belonging to.
+ * @param value         receives the tensor.
+ * @param deleter       receives the callback that releases the mapping. It must be called once the tensor is no
+ *                      longer used. Set to nullptr if no mapping was needed.
+ */
+common::Status MapExternalDataTensorProtoToMLValue(const Env& env, const ORTCHAR_T* model_path,
+                                                   const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                   const OrtMemoryInfo& memory_info,
+                                                   OrtValue& value, OrtCallback& deleter);
+
 /** Creates a TensorProto from a Tensor.
     @param[in] tensor the Tensor whose data and shape will be used to create the TensorProto.
     @param[in] tensor_proto_name the name of the TensorProto.
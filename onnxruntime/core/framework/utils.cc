@@ -709,6 +709,21 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
   return status;
 }
 
+common::Status CheckRunTermination(const bool& terminate_flag, const logging::Logger& logger) {
+  if (terminate_flag) {
+    LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+  }
+
+  const auto* run_termination = concurrency::ThreadPool::RunTerminationScope::Current();
+  if (run_termination != nullptr && run_termination->DeadlineExceeded()) {
+    LOGS(logger, WARNING) << "Exiting due to the run deadline being exceeded.";
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to the run deadline being exceeded.");
+  }
+
+  return Status::OK();
+}
+
 int32_t ONNXTensorElementDataTypeToProtoTensorType(ONNXTensorElementDataType onnx_enum) {
   switch (onnx_enum) {
     case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
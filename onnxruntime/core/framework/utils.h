@@ -105,6 +105,11 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger);
 
+// Returns a failed status if the run should stop: its terminate flag is set, or the deadline of the
+// concurrency::ThreadPool::RunTerminationScope of the current thread has passed. Checked by the executors between
+// nodes and by the control flow kernels between iterations.
+common::Status CheckRunTermination(const bool& terminate_flag, const logging::Logger& logger);
+
 bool IsInputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
 
 template <typename T>
@@ -90,6 +90,53 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Attention, 1,
                                   AttentionTypeAndShapeInference(ctx, past_input_index);
                                 }));
 
+constexpr const char* PackedAttention_ver1_doc = R"DOC(
+Multi-Head Self Attention over a batch of sequences that are packed without padding.
+The tokens of all the sequences are concatenated in input, which has shape (token_count, input_hidden_size), and
+cumulative_sequence_length has shape (batch_size + 1) with the offset of the first token of each sequence followed by
+token_count. Sequence b has the tokens [cumulative_sequence_length[b], cumulative_sequence_length[b + 1]) and only
+attends to itself. The QKV projection runs over token_count rows, so no computation is spent on padding.
+EmbedLayerNormalization can produce the packed input from input_ids with shape (1, token_count) and position_ids that
+restart at 0 for each sequence, and the other operators of an encoder layer work on the tokens independently.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(PackedAttention, 1,
+                            OpSchema()
+                                .SetDoc(PackedAttention_ver1_doc)
+                                .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+                                .Attr("unidirectional",
+                                      "Whether every token can only attend to previous tokens of its sequence. Default value is 0.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(0))
+                                .Input(0, "input", "2D input tensor with shape (token_count, input_hidden_size)", "T")
+                                .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
+                                .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
+                                .Input(3, "cumulative_sequence_length", "1D tensor with shape (batch_size + 1). It starts with 0 and ends with token_count.", "M")
+                                .Output(0, "output", "2D output tensor with shape (token_count, hidden_size)", "T")
+                                .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("M", {"tensor(int32)"}, "Constrain cumulative sequence length to integer types")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  if (hasInputShape(ctx, 0) && hasInputShape(ctx, 2)) {
+                                    auto& input_shape = getInputShape(ctx, 0);
+                                    auto& bias_shape = getInputShape(ctx, 2);
+                                    if (input_shape.dim_size() != 2) {
+                                      fail_shape_inference("Inputs 0 shall be 2 dimensions");
+                                    }
+                                    if (bias_shape.dim_size() != 1) {
+                                      fail_shape_inference("Inputs 2 shall be 1 dimension");
+                                    }
+
+                                    ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                    *output_shape.add_dim() = input_shape.dim(0);
+                                    auto* hidden_dim = output_shape.add_dim();
+                                    if (bias_shape.dim(0).has_dim_value()) {
+                                      hidden_dim->set_dim_value(bias_shape.dim(0).dim_value() / 3);
+                                    }
+                                    updateOutputShape(ctx, 0, output_shape);
+                                  }
+                                }));
+
 constexpr const char* Longformer_Attention_doc = R"DOC(
 Longformer Self Attention with a local context and a global context. Tokens attend locally: Each token
 attends to its W previous tokens and W succeding tokens with W being the window length. A selected few tokens
@@ -150,6 +197,57 @@ ONNX_MS_OPERATOR_SET_SCHEMA(DecoderAttention, 1,
                                   DecoderAttentionTypeAndShapeInference(ctx);
                                 }));
 
+constexpr const char* DecoderMaskedSelfAttention_ver1_doc = R"DOC(
+Unidirectional self attention of a decoder that keeps its key and value cache in a buffer allocated for the maximum
+sequence length. past has shape (2, batch_size, num_heads, max_sequence_length, head_size), and only its first
+past_sequence_length positions are valid. The key and value of the new tokens are written to positions
+[past_sequence_length, past_sequence_length + sequence_length) of present, which shares its buffer with past,
+so the cache is appended in place instead of being concatenated into a new tensor at every step.
+The mask has shape (batch_size, past_sequence_length + sequence_length) or (batch_size, max_sequence_length), with 1
+for the tokens that are attended and 0 for padding.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(DecoderMaskedSelfAttention, 1,
+                            OpSchema()
+                                .SetDoc(DecoderMaskedSelfAttention_ver1_doc)
+                                .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+                                .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, input_hidden_size)", "T")
+                                .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
+                                .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
+                                .Input(3, "mask_index", "Attention mask with shape (batch_size, past_sequence_length + sequence_length) or (batch_size, max_sequence_length)", "M", OpSchema::Optional)
+                                .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, max_sequence_length, head_size)", "T")
+                                .Input(5, "past_sequence_length", "Scalar with the number of valid positions of past", "M")
+                                .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+                                .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, max_sequence_length, head_size). It shares the buffer of past.", "T")
+                                .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask index and past sequence length to integer types")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
+                                  if (hasInputShape(ctx, 0) && hasInputShape(ctx, 2)) {
+                                    auto& input_shape = getInputShape(ctx, 0);
+                                    auto& bias_shape = getInputShape(ctx, 2);
+                                    if (input_shape.dim_size() != 3) {
+                                      fail_shape_inference("Inputs 0 shall be 3 dimensions");
+                                    }
+                                    if (bias_shape.dim_size() != 1) {
+                                      fail_shape_inference("Inputs 2 shall be 1 dimension");
+                                    }
+
+                                    ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                    *output_shape.add_dim() = input_shape.dim(0);
+                                    *output_shape.add_dim() = input_shape.dim(1);
+                                    auto* hidden_dim = output_shape.add_dim();
+                                    if (bias_shape.dim(0).has_dim_value()) {
+                                      hidden_dim->set_dim_value(bias_shape.dim(0).dim_value() / 3);
+                                    }
+                                    updateOutputShape(ctx, 0, output_shape);
+                                  }
+                                  if (hasInputShape(ctx, 4)) {
+                                    propagateShapeFromInputToOutput(ctx, 4, 1);
+                                  }
+                                }));
+
 constexpr const char* EmbedLayerNormalization_ver1_doc = R"DOC(
 EmbedLayerNormalization is the fusion of embedding layer in BERT model, with optional mask processing.
 The embedding layer takes input_ids (word IDs) and segment_ids (sentence IDs) to look up word_embedding, position_embedding,
@@ -237,6 +335,35 @@ ONNX_MS_OPERATOR_SET_SCHEMA(SkipLayerNormalization, 1,
                                 .TypeConstraint("U", {"tensor(float)"}, "Constrain mean and inv_std_var to float tensors.")
                                 .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+constexpr const char* GroupNorm_ver1_doc = R"DOC(
+Applies Group Normalization over a mini-batch of inputs as described in the paper Group Normalization (https://arxiv.org/abs/1803.08494).
+
+This operator transforms input according to
+  y = gamma * (x - mean) / sqrt(variance + epsilon) + beta
+
+The input channels are separated into groups, each containing C / groups consecutive channels, where C must be
+divisible by groups. The mean and variance are calculated separately over each group of each image. gamma and beta
+are per-channel affine transform parameter vectors of size C.
+
+The activation attribute enables the Swish activation x * sigmoid(x) after the group normalization, as in the
+resnet blocks of diffusion models.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(GroupNorm, 1,
+                            OpSchema()
+                                .SetDoc(GroupNorm_ver1_doc)
+                                .Attr("epsilon", "The epsilon value to use to avoid division by zero", AttributeProto::FLOAT, kDefaultGroupNormEpsilon)
+                                .Attr("groups", "The number of groups of channels. It should be a divisor of the number of channels C", AttributeProto::INT)
+                                .Attr("activation", "Activation after group normalization: 0 for None, 1 for Swish", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("channels_last", "1 if the input and output are in the NHWC layout, 0 if they are in the NCHW layout", AttributeProto::INT, static_cast<int64_t>(1))
+                                .Input(0, "X", "Input data tensor with shape (N, H, W, C) if channels_last is 1, else (N, C, H, W), where N is the batch size, C is the number of channels, and H and W are the height and width of the data", "T")
+                                .Input(1, "gamma", "1D gamma tensor for normalization with shape (C), where C is number of channels", "M")
+                                .Input(2, "beta", "1D beta tensor for normalization with shape (C), where C is number of channels", "M")
+                                .Output(0, "Y", "The output tensor of the same shape as X", "T")
+                                .TypeConstraint("T", {"tensor(float16)", "tensor(float)"}, "Constrain input X and output Y types to float tensors.")
+                                .TypeConstraint("M", {"tensor(float)"}, "Constrain gamma and beta to float tensors.")
+                                .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 constexpr const char* NGramRepeatBlock_ver1_doc = R"DOC(
 Enforce no repetition of n-grams. Scores are set to `-inf` for tokens that form a repeated n-gram if added to the back of the input_ids.
 )DOC";
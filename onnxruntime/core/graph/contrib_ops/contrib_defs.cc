@@ -463,6 +463,43 @@ void BeamSearchShapeInference(ONNX_NAMESPACE::InferenceContext& ctx) {
   }
 }
 
+void GreedySearchShapeInference(ONNX_NAMESPACE::InferenceContext& ctx) {
+  // Type inference
+  ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+  // Shape inference
+  // input 0 (input_ids) shape: (batch_size, sequence_length)
+  // output 0 (sequences) shape: (batch_size, max_length)
+  if (!hasInputShape(ctx, 0)) {
+    return;
+  }
+  auto& input_ids_shape = getInputShape(ctx, 0);
+  auto& input_ids_dims = input_ids_shape.dim();
+  if (input_ids_dims.size() != 2) {
+    fail_shape_inference("Inputs 0 shall be 2 dimensions");
+  }
+  if (!input_ids_dims[0].has_dim_value()) {
+    return;
+  }
+
+  int64_t batch_size = input_ids_dims[0].dim_value();
+
+  const auto max_length = ctx.getInputData(1);
+  if (max_length == nullptr) {  // not initializer
+    return;
+  }
+
+  int max_length_value = 0;
+  if (!ParseScalar(max_length, max_length_value) || max_length_value <= 0) {
+    fail_shape_inference("Failed to parse max_length or it is not positive integer scalar");
+  }
+
+  ONNX_NAMESPACE::TensorShapeProto sequences_shape;
+  sequences_shape.add_dim()->set_dim_value(batch_size);
+  sequences_shape.add_dim()->set_dim_value(max_length_value);
+  updateOutputShape(ctx, 0, sequences_shape);
+}
+
 constexpr const char* Gelu_ver1_doc =
     R"DOC(Gaussian Error Linear Unit.
 A high-performing neural network activation function.The GELU nonlinearity is
@@ -576,6 +613,27 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Inverse, 1,
                                   }
                                 }));
 
+constexpr const char* AllReduce_ver1_doc = R"DOC(
+Sums the input tensor element-wise over all the ranks of a tensor-parallel group and returns the result on every
+rank. Inserted by the tensor-parallel sharding transformer after the layers whose weights are split along the
+reduction dimension.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(AllReduce, 1,
+                            OpSchema()
+                                .SetDoc(AllReduce_ver1_doc)
+                                .Attr("group_size",
+                                      "Number of ranks in the tensor-parallel group. Must match the size of the "
+                                      "communicator the kernel runs with.",
+                                      AttributeProto::INT)
+                                .Input(0, "input", "Partial result of this rank.", "T")
+                                .Output(0, "output", "Sum of the partial results of all the ranks.", "T")
+                                .TypeConstraint(
+                                    "T",
+                                    {"tensor(float16)", "tensor(float)", "tensor(double)"},
+                                    "Constrain input and output types to float tensors.")
+                                .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 constexpr const char* TorchEmbedding_ver1_doc = R"DOC(
       Based on Torch operator Embedding, creates a lookup table of embedding vectors of fixed size,
        for a dictionary of fixed size.
@@ -744,7 +802,8 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BiasDropout, 1,
                                 .Attr("seed", "(Optional) Seed to the random generator, if not specified we will auto generate one.", AttributeProto::INT, OPTIONAL_VALUE)
                                 .AllowUncheckedAttributes()
                                 .Input(0, "data", "The input data as Tensor.", "T")
-                                .Input(1, "bias", "The bias input, a vector with the same shape as last dim of data OR same shape with data", "T")
+                                .Input(1, "bias", "The bias input, a vector with the same shape as last dim of data OR same shape with data. "
+                                       "If it is not set, no bias is added.", "T", OpSchema::Optional)
                                 .Input(2, "residual", "The residual input, must have the same shape as data", "T", OpSchema::Optional)
                                 .Input(3, "ratio",
                                        "The ratio of random dropout, with value in [0, 1). If this input was not set, "
@@ -763,6 +822,11 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BiasDropout, 1,
                                        OpSchema::Optional)
                                 .Output(0, "output", "The output.", "T")
                                 .Output(1, "mask", "The output mask of dropout.", "T2", OpSchema::Optional)
+                                .Output(2, "philox_state",
+                                        "The seed and offset of the Philox generator the mask was generated from, "
+                                        "a 1D tensor of 2 elements. DropoutGrad can regenerate the mask from it, so the "
+                                        "mask output does not need to be kept for the backward pass.",
+                                        "tensor(int64)", OpSchema::Optional)
                                 .TypeConstraint(
                                     "T",
                                     {"tensor(float16)", "tensor(float)", "tensor(double)", "tensor(bfloat16)"},
@@ -777,12 +841,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BiasDropout, 1,
                                     "Constrain output 'mask' types to boolean tensors.")
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
                                   propagateShapeAndTypeFromFirstInput(ctx);
-                                  if (ctx.getNumOutputs() == 2) {
+                                  if (ctx.hasOutput(1)) {
                                     updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::BOOL);
                                     if (hasNInputShapes(ctx, 1)) {
                                       propagateShapeFromInputToOutput(ctx, 0, 1);
                                     }
                                   }
+                                  if (ctx.hasOutput(2)) {
+                                    updateOutputElemType(ctx, 2, ONNX_NAMESPACE::TensorProto::INT64);
+                                    ONNX_NAMESPACE::TensorShapeProto philox_state_shape;
+                                    philox_state_shape.add_dim()->set_dim_value(2);
+                                    updateOutputShape(ctx, 2, philox_state_shape);
+                                  }
                                 }));
 
 ONNX_MS_OPERATOR_SET_SCHEMA(IsAllFinite, 1,
@@ -950,6 +1020,35 @@ ONNX_MS_OPERATOR_SET_SCHEMA(BeamSearch, 1,
                                   BeamSearchShapeInference(ctx);
                                 }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
+                            OpSchema()
+                                .SetDoc("Greedy Search and sampling for text generation. Supports GPT-2 decoder.")
+                                .Attr("eos_token_id", "The id of the end-of-sequence token", AttributeProto::INT)
+                                .Attr("pad_token_id", "The id of the padding token", AttributeProto::INT)
+                                .Attr("no_repeat_ngram_size", "no repeat ngrams size", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("model_type", "model type: 0 for GPT-2", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("do_sample", "Sample the next token from the top_k and top_p filtered distribution instead of choosing the most probable one", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("seed", "Seed of the random generator used for sampling. A random seed is used when it is not specified.", AttributeProto::INT, OPTIONAL_VALUE)
+                                .Attr("decoder", "Decoder subgraph to execute in a loop.", AttributeProto::GRAPH)
+                                .Attr("draft_decoder", "Optional smaller decoder subgraph with the same inputs, outputs and vocabulary as the decoder. It proposes num_draft_tokens tokens greedily, which the decoder verifies in one run. The generated sequences are the same as without it.", AttributeProto::GRAPH, OPTIONAL_VALUE)
+                                .Attr("num_draft_tokens", "The number of tokens the draft decoder proposes in each step", AttributeProto::INT, static_cast<int64_t>(4))
+                                .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
+                                .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
+                                .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
+                                .Input(3, "repetition_penalty", "The parameter for repetition penalty. Default value 1.0 means no penalty. Accepts value > 0.0. Shape is (1)", "T", OpSchema::Optional)
+                                .Input(4, "vocab_mask", "Mask of vocabulary. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (vacab_size)", "M", OpSchema::Optional)
+                                .Input(5, "prefix_vocab_mask", "Mask of vocabulary for first step. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (batch_size, vocab_size)", "M", OpSchema::Optional)
+                                .Input(6, "temperature", "The value used to module the next token probabilities when sampling. Default value 1.0. Accepts value > 0.0. Shape is (1)", "T", OpSchema::Optional)
+                                .Input(7, "top_k", "The number of most probable tokens kept for sampling. Default value 0 means no top-k filtering. Shape is (1)", "I", OpSchema::Optional)
+                                .Input(8, "top_p", "The smallest set of most probable tokens with probabilities that add up to top_p or higher are kept for sampling. Default value 1.0 means no top-p filtering. Shape is (1)", "T", OpSchema::Optional)
+                                .Output(0, "sequences", "Word IDs of generated sequences. Shape is (batch_size, max_sequence_length)", "I")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeConstraint("I", {"tensor(int32)"}, "Constrain to integer types")
+                                .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to integer types")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  GreedySearchShapeInference(ctx);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SampleOp, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -1267,6 +1366,30 @@ activation and leaky_relu_alpha.)DOC")
                                   }
                                 }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedElementwise, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+Runs a chain of element-wise operations in a single pass over the tensor. The value of the chain starts as the
+first input and each entry of `ops` replaces it with `value op inputs[operands[i]]`, or
+`inputs[operands[i]] op value` if operand_first[i] is set, for the binary operations Add, Sub, Mul and Div, or with
+`op(value)` for Relu, Sigmoid and Tanh, whose operand is -1. The other inputs must have the shape of the first
+input or a single element.)DOC")
+                                .Attr("ops", "The operations of the chain.", AttributeProto::STRINGS)
+                                .Attr("operands",
+                                      "For each operation, the index of the input used as its other operand, "
+                                      "-1 for unary operations.",
+                                      AttributeProto::INTS)
+                                .Attr("operand_first",
+                                      "For each operation, 1 if the input is the left operand of the operation.",
+                                      AttributeProto::INTS,
+                                      OPTIONAL_VALUE)
+                                .Input(0, "inputs", "The input of the chain followed by the other operands.", "T",
+                                       OpSchema::Variadic)
+                                .Output(0, "Y", "The output, of the shape of the first input.", "T")
+                                .TypeConstraint("T", {"tensor(float)", "tensor(float16)"},
+                                                "Constrain input and output types to float tensors.")
+                                .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(ExpandDims, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -1510,6 +1633,22 @@ ONNX_MS_OPERATOR_SET_SCHEMA(FusedMatMul, 1,
                                 .SetDoc(FusedMatMul_doc)
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) { FusedMatMulShapeInference(ctx); }));
 
+constexpr const char* MatMulFastGelu_doc = R"DOC(
+Matrix product of A and the 2D matrix B, followed by FastGelu with an optional bias: Y = FastGelu(MatMul(A, B) + bias).
+The CUDA kernel applies the bias and the GELU approximation in the epilogue of the GEMM instead of launching
+another kernel that reads the product back from memory.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(MatMulFastGelu, 1,
+                            OpSchema()
+                                .Input(0, "A", "N-dimensional matrix A", "T")
+                                .Input(1, "B", "2-dimensional matrix B", "T")
+                                .Input(2, "bias", "1D bias tensor with the size of the last dimension of B", "T", OpSchema::Optional)
+                                .Output(0, "Y", "Matrix multiply results after FastGelu", "T")
+                                .TypeConstraint("T", {"tensor(float16)", "tensor(float)"},
+                                                "Constrain input and output types to float or half tensors.")
+                                .SetDoc(MatMulFastGelu_doc)
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) { FusedMatMulShapeInference(ctx); }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                             OpSchema()
                                 .Input(0, "A", "2-dimensional sparse matrix A. Either COO or CSR format", "T")
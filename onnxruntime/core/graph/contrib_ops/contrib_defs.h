@@ -55,5 +55,6 @@ void RegisterQuantizationSchemas();
 
 constexpr const float kDefaultSkipLayerNormEpsilon = 1e-12f;
 constexpr const float kDefaultEmbedLayerNormEpsilon = 1e-12f;
+constexpr const float kDefaultGroupNormEpsilon = 1e-5f;
 }  // namespace contrib
 }  // namespace onnxruntime
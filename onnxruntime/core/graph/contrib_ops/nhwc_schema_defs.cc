@@ -112,7 +112,7 @@ ONNX_MS_OPERATOR_SET_SCHEMA(NhwcMaxPool, 1,
                             OpSchema()
                                 .Input(0, "x", "", "T")
                                 .Output(0, "y", "", "T")
-                                .TypeConstraint("T", {"tensor(int8)", "tensor(uint8)"}, "")
+                                .TypeConstraint("T", {"tensor(int8)", "tensor(uint8)", "tensor(float)"}, "")
                                 .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
                                 .Attr("kernel_shape", "", AttributeProto::INTS)
                                 .Attr("dilations", "", AttributeProto::INTS, OPTIONAL_VALUE)
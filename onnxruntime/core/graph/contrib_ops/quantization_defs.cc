@@ -108,6 +108,25 @@ Performs element-wise binary {name} on 8 bit data types (with Numpy-style broadc
         "Output zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
         "T",
         OpSchema::Optional);
+    schema.Input(
+        8,
+        "Y_scale",
+        "Scale of the output when an activation is fused. It's a scalar, which means a per-tensor/layer quantization.",
+        "tensor(float)",
+        OpSchema::Optional);
+    schema.Input(
+        9,
+        "Y_zero_point",
+        "Zero point of the output when an activation is fused. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+        "T",
+        OpSchema::Optional);
+    schema.Attr(
+        "activation",
+        "Activation applied to the result, either Sigmoid or LeakyRelu. When set, the output is the activation of C "
+        "quantized with Y_scale and Y_zero_point. It is only set by the graph optimizer.",
+        AttributeProto::STRING,
+        OPTIONAL_VALUE);
+    schema.Attr("activation_alpha", "Alpha of the LeakyRelu activation.", AttributeProto::FLOAT, 0.01f);
     schema.Output(0, "C", "Result, has same element type as two inputs", "T");
     schema.TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit signed and unsigned tensors.");
     schema.TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -129,6 +148,12 @@ Performs element-wise binary {name} on 8 bit data types (with Numpy-style broadc
       ValidateTypeAndShapeForScaleAndZP(ctx, 5, b_type->tensor_type().elem_type(), true);
       ValidateTypeAndShapeForScaleAndZP(ctx, 6, ONNX_NAMESPACE::TensorProto::FLOAT, true);
       ValidateTypeAndShapeForScaleAndZP(ctx, 7, a_type->tensor_type().elem_type(), true);
+      if (ctx.getNumInputs() > 8 && ctx.getInputType(8) != nullptr) {
+        ValidateTypeAndShapeForScaleAndZP(ctx, 8, ONNX_NAMESPACE::TensorProto::FLOAT, true);
+      }
+      if (ctx.getNumInputs() > 9 && ctx.getInputType(9) != nullptr) {
+        ValidateTypeAndShapeForScaleAndZP(ctx, 9, a_type->tensor_type().elem_type(), true);
+      }
 
       if (hasInputShape(ctx, 0) && hasInputShape(ctx, 3))
         bidirectionalBroadcastShapeInference(
@@ -324,6 +349,10 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
       }));
 
   ONNX_MS_OPERATOR_SET_SCHEMA(DynamicQuantizeMatMul, 1, OpSchema()
+      .Attr("quantize_a_per_row",
+            "If 1, each row of A, i.e. each vector along its last dimension, is quantized with its own scale and "
+            "zero point instead of a single scale and zero point for the whole tensor.",
+            AttributeProto::INT, static_cast<int64_t>(0))
       .Input(0, "A", "N-dimensional matrix A", "T1")
       .Input(1, "B", "N-dimensional matrix B", "T2")
       .Input(
@@ -360,6 +389,55 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
         ONNX_NAMESPACE::matmulShapeInference(ctx, 0, 1);
       }));
 
+  const char* MatMulNBitsDoc_ver1 = R"DOC(
+MatMulNBits performs a matrix multiplication where the right-hand-side matrix (weight) is quantized to N bits
+(weight-only quantization). The weight is quantized along its K dimension in blocks of `block_size` elements, each
+block having its own scale and, optionally, its own zero point:
+  Y = A x dequantize(B) + bias, with dequantize(b) = (b - zero_point) x scale
+
+Input B is stored column by column as [N, ceil(K / block_size), block_size * bits / 8] bytes. With 4 bits, two
+values are packed in a byte, the lower nibble holding the first one. The scales are stored as
+[N * ceil(K / block_size)]. The zero points are stored as [N * ceil(ceil(K / block_size) * bits / 8)] bytes, packed
+like B for 4 bits with every column starting on a byte boundary. Without zero points, 2^(bits - 1) is used.
+)DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(MatMulNBits, 1, OpSchema()
+      .SetDoc(MatMulNBitsDoc_ver1)
+      .Attr("K", "Size of each input feature, i.e. the number of rows of the weight.", AttributeProto::INT)
+      .Attr("N", "Size of each output feature, i.e. the number of columns of the weight.", AttributeProto::INT)
+      .Attr("bits", "Number of bits of a quantized weight, 4 or 8.", AttributeProto::INT, static_cast<int64_t>(4))
+      .Attr("block_size",
+            "Number of weights sharing a scale and zero point. It must be a power of 2 and not smaller than 16, "
+            "e.g. 32, 64 or 128.",
+            AttributeProto::INT)
+      .Input(0, "A", "The input tensor, not quantized. Its last dimension is K.", "T1")
+      .Input(1, "B", "The quantized weight of shape [N, ceil(K / block_size), block_size * bits / 8].", "T2")
+      .Input(2, "scales", "The scales of the quantization blocks, of shape [N * ceil(K / block_size)].", "T1")
+      .Input(3, "zero_points", "The zero points of the quantization blocks, packed as described above.", "T2",
+             OpSchema::Optional)
+      .Input(4, "bias", "1D input tensor of shape [N].", "T1", OpSchema::Optional)
+      .Output(0, "Y", "Tensor with the same shape as A but with N as its last dimension.", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input A, scales, bias and output Y to float tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight and zero points to uint8 tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        const auto& a_shape = getInputShape(ctx, 0);
+        if (a_shape.dim_size() == 0) {
+          fail_shape_inference("Input A must have at least one dimension.");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        for (int i = 0; i < a_shape.dim_size() - 1; ++i) {
+          *output_shape.add_dim() = a_shape.dim(i);
+        }
+        output_shape.add_dim()->set_dim_value(getAttribute(ctx, "N", 0));
+        updateOutputShape(ctx, 0, output_shape);
+      }));
+
   ONNX_MS_OPERATOR_SET_SCHEMA(MatMulIntegerToFloat, 1, OpSchema()
       .Input(0, "A", "N-dimensional matrix A", "T1")
       .Input(1, "B", "N-dimensional matrix B", "T2")
@@ -585,6 +663,41 @@ Wwhere the function `Sigmoid(x) = 1 / (1 + exp(-x))` )DOC";
           "Constrain input and output types to 8 bit tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+  const char* QLinearSoftmaxDoc_ver1 = R"DOC(
+QLinearSoftmax computes the normalized exponential values for the given quantized input:
+`Y = quantize(Softmax(dequantize(X)))`. The `axis` and `opset` attributes follow the semantics of the
+ONNX Softmax operator of version `opset`: before opset 13 the input is coerced to a 2D tensor at `axis`,
+from opset 13 the normalization is done along `axis` only.
+)DOC";
+
+  ONNX_MS_OPERATOR_SET_SCHEMA(QLinearSoftmax, 1, OpSchema()
+      .SetDoc(QLinearSoftmaxDoc_ver1)
+      .Attr("axis",
+            "The axis along which to compute the softmax. Defaults to 1 before opset 13 and to -1 from opset 13.",
+            AttributeProto::INT,
+            OPTIONAL_VALUE)
+      .Attr("opset", "The opset version of the Softmax operator whose semantics are followed.",
+            AttributeProto::INT, static_cast<int64_t>(13))
+      .Input(0, "X", "Input tensor", "T")
+      .Input(1, "X_scale",
+             "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(2, "X_zero_point",
+             "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Input(3, "Y_scale",
+             "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+             "tensor(float)")
+      .Input(4, "Y_zero_point",
+             "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a per-tensor/layer quantization.",
+             "T", OpSchema::Optional)
+      .Output(0, "Y", "Output tensor", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(uint8)", "tensor(int8)"},
+          "Constrain input and output types to 8 bit tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
   ONNX_MS_OPERATOR_SET_SCHEMA(DynamicQuantizeLSTM, 1, OpSchema()
       .Attr(
           "direction",
@@ -967,6 +1080,12 @@ Wwhere the function `Sigmoid(x) = 1 / (1 + exp(-x))` )DOC";
                                         "Whether every token can only attend to previous tokens. Default value is 0.",
                                         AttributeProto::INT,
                                         static_cast<int64_t>(0))
+                                  .Attr("quantize_attention_scores",
+                                        "Whether Q x K' and the attention probabilities x V are computed with 8-bit integer "
+                                        "products. Q, K and V are quantized per head and the softmax output is quantized "
+                                        "to uint8. Ignored when past is given or present is requested. Default value is 0.",
+                                        AttributeProto::INT,
+                                        static_cast<int64_t>(0))
                                   .Input(
                                       0,
                                       "input",
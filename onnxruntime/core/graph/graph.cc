@@ -30,6 +30,7 @@
 #include "core/graph/function.h"
 #include "core/graph/function_impl.h"
 #include "core/graph/schema_registry.h"
+#include "core/graph/symbolic_shape_inference.h"
 #include "onnx/checker.h"
 using namespace ONNX_NAMESPACE::checker;
 #endif
@@ -844,9 +845,25 @@ void Node::Init(const std::string& name,
   }
 }
 
+std::vector<int>& Node::MutableInputArgsCount() {
+  graph_->SetNodeModified(index_);
+  return definitions_.input_arg_count;
+}
+
+std::vector<NodeArg*>& Node::MutableInputDefs() noexcept {
+  graph_->SetNodeModified(index_);
+  return definitions_.input_defs;
+}
+
+std::vector<NodeArg*>& Node::MutableOutputDefs() noexcept {
+  graph_->SetNodeModified(index_);
+  return definitions_.output_defs;
+}
+
 Node::Definitions& Node::MutableDefinitions() noexcept {
   // someone fetching these is going to change something
   graph_->SetGraphResolveNeeded();
+  graph_->SetNodeModified(index_);
   graph_->SetGraphProtoSyncNeeded();
   return definitions_;
 }
@@ -877,6 +894,7 @@ void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
 
   graph_->SetGraphResolveNeeded();
+  graph_->SetNodeModified(index_);
   graph_->SetGraphProtoSyncNeeded();
 }
 
@@ -923,6 +941,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
+  graph_->SetNodeModified(index_);
   graph_->SetGraphProtoSyncNeeded();
   return attributes_.erase(attr_name) > 0;
 }
@@ -1001,6 +1020,7 @@ const Graph* Node::GetGraphAttribute(const std::string& attr_name) const {
 }
 
 void Node::ReplaceDefs(const std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*>& replacements) {
+  graph_->SetNodeModified(index_);
   std::vector<std::vector<NodeArg*>*> all_defs = {&definitions_.input_defs, &definitions_.output_defs};
 
   for (auto pair : replacements)
@@ -1108,14 +1128,20 @@ Graph::Graph(const Model& owning_model,
 
   // Process 'Constant' nodes
   // Put the 'TensorProto' stored in the 'Constant' nodes attribute into the graphs initializer list
-  for (auto& node : graph_proto_->node()) {
+  for (auto& node : *graph_proto_->mutable_node()) {
     if (node.op_type() != kConstant) {
       continue;
     }
 
     const gsl::not_null<TensorProto*> tensor{graph_proto_->add_initializer()};
-    auto status = utils::ConstantNodeProtoToTensorProto(node, model_path, *tensor);
-    ORT_ENFORCE(status.IsOK(), status.ToString());
+    if (node.attribute_size() > 0 && node.attribute(0).type() == AttributeProto_AttributeType_TENSOR) {
+      // the Constant node is removed below, so take its tensor instead of copying the data
+      tensor->Swap(node.mutable_attribute(0)->mutable_t());
+      *(tensor->mutable_name()) = node.output(0);
+    } else {
+      auto status = utils::ConstantNodeProtoToTensorProto(node, model_path, *tensor);
+      ORT_ENFORCE(status.IsOK(), status.ToString());
+    }
     // Ensure initializers are also graph inputs.
     if (ir_version_ < 4) {
       TypeProto t{TypeProtoFromTensorProto(*tensor)};
@@ -1311,6 +1337,12 @@ void Graph::InitializeStateFromModelFileGraphProto() {
         // Graph output is not found as any initializer.
         auto iter3 = graph_inputs.find(graph_output_name);
         if (graph_inputs.end() == iter3) {
+          // A subgraph output may be a value from the outer scope, e.g. an If branch returning an outer scope value.
+          if (parent_graph_ != nullptr && parent_graph_->GetNodeArgIncludingParentGraphs(graph_output_name)) {
+            graph_outputs_.push_back(GetNodeArg(graph_output_name));
+            continue;
+          }
+
           // Graph output is not found as any graph input.
           ORT_THROW(
               "This is an invalid model. Graph output (", graph_output_name,
@@ -1650,6 +1682,20 @@ Status Graph::BuildConnections(std::unordered_set<std::string>& outer_scope_node
     }
   }
 
+  // a subgraph output can also be an outer scope value that is returned as is. it has to be provided by the
+  // execution frame like an outer scope value consumed by a node, so pass the name back up as well.
+  if (parent_graph_ != nullptr) {
+    for (const auto* output : graph_outputs_) {
+      const auto& output_name = output->Name();
+      if (resolve_context_.output_args.find(output_name) == resolve_context_.output_args.cend() &&
+          resolve_context_.inputs_and_initializers.find(output_name) ==
+              resolve_context_.inputs_and_initializers.cend() &&
+          outer_scope_node_args.find(output_name) != outer_scope_node_args.cend()) {
+        ORT_IGNORE_RETURN_VALUE(outer_scope_node_args_consumed.insert(output_name));
+      }
+    }
+  }
+
   ORT_RETURN_IF_ERROR(PopulateNodeArgToProducerConsumerLookupsFromNodes());
 
   // finally check any node args consumed by subgraphs to see if they're available locally.
@@ -2027,9 +2073,13 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
     return initializer;
   }
 
-  // ORT does not implement partial data propagation yet so just return nullptr.
-  const TensorShapeProto* getSymbolicInput(size_t) const override {
-    return nullptr;
+  // the value of a shape tensor input inferred by the symbolic shape inference of Resolve.
+  const TensorShapeProto* getSymbolicInput(size_t index) const override {
+    auto def = node_.InputDefs()[index];
+    if (!def || !def->Exists())
+      return nullptr;
+
+    return graph_.GetSymbolicShapeValue(def->Name(), true);
   }
 
   GraphInferencer* getGraphAttributeInferencer(const std::string& attribute_name) override {
@@ -2269,7 +2319,11 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
     ORT_RETURN_IF_ERROR(status);
   }
 
-  const auto& onnx_inferred_types(context.InferredOutputTypes());
+  auto onnx_inferred_types(context.InferredOutputTypes());
+
+  // fill in the dims that ONNX could not infer from the shape values of the inputs, e.g. for a Reshape whose shape
+  // input is computed from a Shape node.
+  symbolic_shape_inference::RefineOutputShapes(*this, node, onnx_inferred_types);
 
   // Infer and verify node output arg type information.
   int i = -1;
@@ -2378,6 +2432,15 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
     }
   }
 
+  if (!node.OutputDefs().empty()) {
+    TensorShapeProto shape_value;
+    if (symbolic_shape_inference::InferShapeValue(*this, node, shape_value)) {
+      symbolic_shape_values_[node.OutputDefs()[0]->Name()] = std::move(shape_value);
+    } else {
+      symbolic_shape_values_.erase(node.OutputDefs()[0]->Name());
+    }
+  }
+
   return Status::OK();
 }
 
@@ -2472,16 +2535,36 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   // and need to call Resolve
   lsc.output_names.insert(outer_scope_node_arg_names_.cbegin(), outer_scope_node_arg_names_.cend());
 
+  // the output types and shape value of a node, to find out whether inferencing changed them
+  auto get_output_types = [this](const Node& node) {
+    std::vector<std::string> output_types;
+    output_types.reserve(node.OutputDefs().size() + 1);
+    for (const auto* output_def : node.OutputDefs()) {
+      const auto* type = output_def->TypeAsProto();
+      output_types.push_back(type != nullptr ? type->SerializeAsString() : std::string{});
+    }
+    if (!node.OutputDefs().empty()) {
+      const auto* shape_value = GetSymbolicShapeValue(node.OutputDefs()[0]->Name(), false);
+      output_types.push_back(shape_value != nullptr ? shape_value->SerializeAsString() : std::string{});
+    }
+    return output_types;
+  };
+
+  // the shape values are kept for the nodes that are not inferred again
+  if (!resolve_context_.infer_modified_nodes_only) {
+    symbolic_shape_values_.clear();
+  }
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
-    NodeProto node_proto;
-    node.ToProto(node_proto);
     const auto& node_name = node.Name();
 
     if (!node.Op()) {
       {
+        NodeProto node_proto;
+        node.ToProto(node_proto);
         auto status = Status::OK();
         ORT_TRY {
           checker::check_node(node_proto, ctx, lsc);
@@ -2551,11 +2634,25 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
-    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    // a node that was not modified, and whose inputs did not change, keeps the types and shapes of its outputs.
+    // a node with subgraphs is always inferred, as that is what infers its subgraphs.
+    if (!resolve_context_.infer_modified_nodes_only || node.ContainsSubgraph()) {
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    } else if (resolve_context_.nodes_to_infer.count(node_index) > 0) {
+      const auto output_types = get_output_types(node);
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+
+      // the downstream nodes come later in topological order
+      if (get_output_types(node) != output_types) {
+        for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+          resolve_context_.nodes_to_infer.insert(it->Index());
+        }
+      }
+    }
 
     // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
+    for (const auto* output_def : node.OutputDefs()) {
+      lsc.output_names.insert(output_def->Name());
     }
   }
 
@@ -2741,10 +2838,21 @@ Status Graph::Resolve(const ResolveOptions& options) {
     return Status::OK();
   }
 
+  // InitInputsInitializersOutputs() modifies the definitions of all the nodes, so take the nodes modified since the
+  // last Resolve first. if this Resolve fails, the next one infers all the nodes.
+  std::unordered_set<NodeIndex> modified_nodes;
+  modified_nodes.swap(modified_nodes_);
+  const bool infer_modified_nodes_only = options.only_infer_modified_nodes && !options.override_types &&
+                                         !infer_all_nodes_;
+  infer_all_nodes_ = true;
+
   // init all graph/subgraphs. non-recursive.
   auto init_func = [](Graph& graph) { return graph.InitInputsInitializersOutputs(); };
   ORT_RETURN_IF_ERROR(ForThisAndAllSubgraphs(all_subgraphs, init_func));
 
+  resolve_context_.infer_modified_nodes_only = infer_modified_nodes_only;
+  resolve_context_.nodes_to_infer = std::move(modified_nodes);
+
   // recursively set the outer scope node args.
   ORT_RETURN_IF_ERROR(SetOuterScopeNodeArgs(resolve_context_.outer_scope_node_args));
 
@@ -2768,6 +2876,8 @@ Status Graph::Resolve(const ResolveOptions& options) {
   auto finalize_func = [&options](Graph& graph) {
             graph.CleanUnusedInitializersAndNodeArgs(options.initializer_names_to_preserve);
             graph.GraphResolveNeeded(false);
+            graph.modified_nodes_.clear();
+            graph.infer_all_nodes_ = false;
 
             // if we are resolving immediately after loading from a GraphProto, we don't need to
             // do a proto sync
@@ -2807,7 +2917,10 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
   SetGraphResolveNeeded();
-  if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
+  if (GetNodeArg(tensor.name()) != nullptr) {
+    // the consumers of an existing NodeArg may see a different type or shape once it is an initializer
+    infer_all_nodes_ = true;
+  } else if (!is_loaded_from_model_file_) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
     // the shape will be set to the correct value in TypeCheckInputsAndInitializers as we don't yet know whether there
     // will be a matching graph input for this initializer (we prefer shape info from the graph input).
@@ -2949,6 +3062,47 @@ void Graph::CleanAllInitializedTensors() noexcept {
   }
 }
 
+void Graph::ReleaseInitializedTensorData(const std::string& tensor_name) {
+  auto iter = name_to_initial_tensor_.find(tensor_name);
+  if (name_to_initial_tensor_.end() == iter) {
+    return;
+  }
+
+  auto& mutable_initializers = *(graph_proto_->mutable_initializer());
+  // use cheaper pointer comparison to find the entry
+  auto entry = std::find(mutable_initializers.pointer_begin(), mutable_initializers.pointer_end(), iter->second);
+  ORT_ENFORCE(entry != mutable_initializers.pointer_end(),
+              "graph_proto_ is not in sync with name_to_initial_tensor_");
+
+  // Clearing a field does not free its memory, so swap the data into a TensorProto that is destroyed on return.
+  TensorProto& tensor = **entry;
+  TensorProto data;
+  data.mutable_raw_data()->swap(*tensor.mutable_raw_data());
+  tensor.clear_raw_data();
+  data.mutable_float_data()->Swap(tensor.mutable_float_data());
+  data.mutable_int32_data()->Swap(tensor.mutable_int32_data());
+  data.mutable_string_data()->Swap(tensor.mutable_string_data());
+  data.mutable_int64_data()->Swap(tensor.mutable_int64_data());
+  data.mutable_double_data()->Swap(tensor.mutable_double_data());
+  data.mutable_uint64_data()->Swap(tensor.mutable_uint64_data());
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+const ONNX_NAMESPACE::TensorShapeProto* Graph::GetSymbolicShapeValue(const std::string& name,
+                                                                    bool check_outer_scope) const {
+  auto it = symbolic_shape_values_.find(name);
+  if (it != symbolic_shape_values_.end()) {
+    return &it->second;
+  }
+
+  if (check_outer_scope && IsSubgraph() && IsOuterScopeValue(name)) {
+    return parent_graph_->GetSymbolicShapeValue(name, check_outer_scope);
+  }
+
+  return nullptr;
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 const ONNX_NAMESPACE::TensorProto* Graph::GetConstantInitializer(const std::string& initializer_name,
                                                                  bool check_outer_scope) const {
   const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
@@ -3800,6 +3954,7 @@ gsl::not_null<Node*> Graph::AllocateNode() {
   nodes_.push_back(std::move(new_node));
   ++num_of_nodes_;
   GraphResolveNeeded(true);
+  SetNodeModified(node->Index());
 
   return gsl::not_null<Node*>{node};
 }
@@ -4105,6 +4260,7 @@ void Graph::SetInputs(gsl::span<const NodeArg* const> inputs) {
   graph_inputs_manually_set_ = true;
   GraphProtoSyncNeeded(true);
   GraphResolveNeeded(true);
+  infer_all_nodes_ = true;
 }
 
 void Graph::SetOutputs(gsl::span<const NodeArg* const> outputs) {
@@ -4114,6 +4270,7 @@ void Graph::SetOutputs(gsl::span<const NodeArg* const> outputs) {
   graph_outputs_manually_set_ = true;
   GraphProtoSyncNeeded(true);
   GraphResolveNeeded(true);
+  infer_all_nodes_ = true;
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -4122,6 +4279,7 @@ void Graph::SetOutputs(gsl::span<const NodeArg* const> outputs) {
 void Graph::SetNodeArgType(NodeArg& arg, const ONNX_NAMESPACE::TypeProto& type_proto) {
   arg.SetType(type_proto);
   GraphResolveNeeded(true);
+  infer_all_nodes_ = true;
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -4208,12 +4366,14 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph,
 #if !defined(ORT_MINIMAL_BUILD)
                                 IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+                                bool can_use_flatbuffer_for_initializers,
                                 const logging::Logger& logger, std::unique_ptr<Graph>& graph) {
   graph = std::make_unique<Graph>(owning_model, domain_to_version,
 #if !defined(ORT_MINIMAL_BUILD)
                                   schema_registry,
 #endif
                                   nullptr, nullptr, logger);
+  graph->can_use_flatbuffer_for_initializers_ = can_use_flatbuffer_for_initializers;
 
   ORT_RETURN_IF_ERROR(graph->LoadFromOrtFormat(fbs_graph));
 
@@ -4239,6 +4399,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph,
 #endif
                                   &parent_graph, &parent_node,
                                   logger);
+  graph->can_use_flatbuffer_for_initializers_ = parent_graph.can_use_flatbuffer_for_initializers_;
 
   return graph->LoadFromOrtFormat(fbs_graph);
 }
@@ -4297,7 +4458,8 @@ common::Status Graph::LoadFromOrtFormat(const onnxruntime::fbs::Graph& fbs_graph
     for (const auto* fbs_tensor : *fbs_initializers) {
       ORT_RETURN_IF(nullptr == fbs_tensor, "Initializer tensor is missing. Invalid ORT format model.");
       TensorProto* initializer = deserialized_proto_data_.add_initializer();
-      ORT_RETURN_IF_ERROR(fbs::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer));
+      ORT_RETURN_IF_ERROR(fbs::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer,
+                                                               can_use_flatbuffer_for_initializers_));
       auto p = name_to_initial_tensor_.emplace(initializer->name(), initializer);
       if (!p.second) {
         LOGS(logger_, WARNING) << "Duplicate initializer (dense or ConstantNode): '" << initializer->name()
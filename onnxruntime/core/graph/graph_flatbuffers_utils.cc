@@ -44,6 +44,8 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     std::vector<uint8_t> unpacked_tensor;
     ORT_RETURN_IF_ERROR(
         onnxruntime::utils::UnpackInitializerData(initializer, model_path, unpacked_tensor));
+    // align the data so that it can be used in place when the model is loaded, see LoadInitializerOrtFormat
+    builder.ForceVectorAlignment(unpacked_tensor.size(), sizeof(uint8_t), kInitializerRawDataAlignment);
     raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
   }
 
@@ -172,7 +174,8 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
 #endif
 
 Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
-                                TensorProto& initializer) {
+                                TensorProto& initializer,
+                                bool can_use_flatbuffer_for_initializers) {
   initializer.Clear();
 
   LOAD_STR_FROM_ORT_FORMAT(initializer, name, fbs_tensor.name());
@@ -196,8 +199,24 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
-    // fbs_raw_data is uint8_t vector, so the size is byte size
-    initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    const uint8_t* data = fbs_raw_data->Data();
+    const size_t size = fbs_raw_data->size();
+    if (can_use_flatbuffer_for_initializers && size >= kMinInitializerRawDataSizeToUseInPlace &&
+        reinterpret_cast<uintptr_t>(data) % kInitializerRawDataAlignment == 0) {
+      // refer to the data in place rather than copying it
+      auto add_external_data = [&initializer](const std::string& key, const std::string& value) {
+        auto* kvp = initializer.add_external_data();
+        kvp->set_key(key);
+        kvp->set_value(value);
+      };
+      add_external_data("location", ToUTF8String(onnxruntime::utils::kTensorProtoMemoryAddressTag));
+      add_external_data("offset", std::to_string(reinterpret_cast<intptr_t>(data)));
+      add_external_data("length", std::to_string(size));
+      initializer.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+    } else {
+      // fbs_raw_data is uint8_t vector, so the size is byte size
+      initializer.set_raw_data(data, size);
+    }
   }
 
   return Status::OK();
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace ONNX_NAMESPACE {
 class TensorProto;
 class SparseTensorProto;
@@ -49,8 +51,19 @@ onnxruntime::common::Status SaveAttributeOrtFormat(
     flatbuffers::Offset<fbs::Attribute>& fbs_attr, const Path& model_path,
     const onnxruntime::Graph* subgraph);
 
+// The raw data of initializers is aligned to this many bytes in an ORT format model, so that it can be used in place.
+constexpr size_t kInitializerRawDataAlignment = 64;
+
+// Initializers with less raw data than this are always copied, as referring to the model bytes saves little.
+constexpr size_t kMinInitializerRawDataSizeToUseInPlace = 128;
+
+// Load a given fbs::Tensor into TensorProto.
+// If can_use_flatbuffer_for_initializers is true, the TensorProto refers to the raw data of fbs_tensor in place
+// with utils::kTensorProtoMemoryAddressTag when it is large and aligned enough, instead of copying it. The bytes
+// of the ORT format model must then outlive the TensorProto and anything created from it.
 onnxruntime::common::Status LoadInitializerOrtFormat(
-    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer);
+    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer,
+    bool can_use_flatbuffer_for_initializers = false);
 
 onnxruntime::common::Status LoadSparseInitializerOrtFormat(const fbs::SparseTensor& fbs_sparse_tensor,
                                                            ONNX_NAMESPACE::SparseTensorProto& initializer);
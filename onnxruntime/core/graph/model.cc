@@ -106,6 +106,62 @@ Model::Model(const ModelProto& model_proto, const PathString& model_path,
     : Model(ModelProto(model_proto), model_path, local_registries, logger, allow_released_opsets_only) {
 }
 
+// utils::kTensorProtoMemoryAddressTag is only valid in the tensor protos ORT creates itself when loading an ORT format
+// model, where the offset is the address of the data in the model bytes. A model file using it could read arbitrary
+// process memory, so any tensor that claims its data is in memory is rejected.
+static void ValidateTensorDataLocation(const TensorProto& tensor) {
+  if (!utils::HasExternalData(tensor)) {
+    return;
+  }
+
+  static const std::string memory_address_tag = ToUTF8String(utils::kTensorProtoMemoryAddressTag);
+  for (const auto& entry : tensor.external_data()) {
+    if (entry.key() == "location" && entry.value() == memory_address_tag) {
+      ORT_THROW("Tensor '", tensor.name(), "' has an invalid external data location: ", entry.value());
+    }
+  }
+}
+
+static void ValidateTensorDataLocations(const GraphProto& graph);
+
+static void ValidateTensorDataLocations(const NodeProto& node) {
+  for (const auto& attr : node.attribute()) {
+    if (attr.has_t()) {
+      ValidateTensorDataLocation(attr.t());
+    }
+    for (const auto& tensor : attr.tensors()) {
+      ValidateTensorDataLocation(tensor);
+    }
+    if (attr.has_sparse_tensor()) {
+      ValidateTensorDataLocation(attr.sparse_tensor().values());
+      ValidateTensorDataLocation(attr.sparse_tensor().indices());
+    }
+    for (const auto& sparse_tensor : attr.sparse_tensors()) {
+      ValidateTensorDataLocation(sparse_tensor.values());
+      ValidateTensorDataLocation(sparse_tensor.indices());
+    }
+    if (attr.has_g()) {
+      ValidateTensorDataLocations(attr.g());
+    }
+    for (const auto& subgraph : attr.graphs()) {
+      ValidateTensorDataLocations(subgraph);
+    }
+  }
+}
+
+static void ValidateTensorDataLocations(const GraphProto& graph) {
+  for (const auto& initializer : graph.initializer()) {
+    ValidateTensorDataLocation(initializer);
+  }
+  for (const auto& sparse_initializer : graph.sparse_initializer()) {
+    ValidateTensorDataLocation(sparse_initializer.values());
+    ValidateTensorDataLocation(sparse_initializer.indices());
+  }
+  for (const auto& node : graph.node()) {
+    ValidateTensorDataLocations(node);
+  }
+}
+
 Model::Model(ModelProto&& model_proto, const PathString& model_path,
              const IOnnxRuntimeOpSchemaRegistryList* local_registries,
              const logging::Logger& logger, bool allow_released_opsets_only)
@@ -114,6 +170,13 @@ Model::Model(ModelProto&& model_proto, const PathString& model_path,
     ORT_THROW("ModelProto does not have a graph.");
   }
 
+  ValidateTensorDataLocations(model_proto.graph());
+  for (const auto& function : model_proto.functions()) {
+    for (const auto& node : function.node()) {
+      ValidateTensorDataLocations(node);
+    }
+  }
+
   if (model_proto.opset_import_size() == 0) {
     ORT_THROW(
         "Missing opset in the model. All ModelProtos MUST have at least one entry that"
@@ -728,6 +791,7 @@ common::Status Model::LoadFromOrtFormat(const fbs::Model& fbs_model,
 #if !defined(ORT_MINIMAL_BUILD)
                                         const IOnnxRuntimeOpSchemaRegistryList* local_registries,
 #endif
+                                        bool can_use_flatbuffer_for_initializers,
                                         const logging::Logger& logger,
                                         std::unique_ptr<Model>& model) {
   model = std::make_unique<Model>();
@@ -785,10 +849,11 @@ common::Status Model::LoadFromOrtFormat(const fbs::Model& fbs_model,
   ORT_RETURN_IF(nullptr == fbs_graph, "Graph is null. Invalid ORT format model.");
 
 #if !defined(ORT_MINIMAL_BUILD)
-  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, schema_registry, logger,
-                                               model->graph_));
+  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, schema_registry,
+                                               can_use_flatbuffer_for_initializers, logger, model->graph_));
 #else
-  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version, logger, model->graph_));
+  ORT_RETURN_IF_ERROR(Graph::LoadFromOrtFormat(*fbs_graph, *model, domain_to_version,
+                                               can_use_flatbuffer_for_initializers, logger, model->graph_));
 #endif
   return Status::OK();
 }
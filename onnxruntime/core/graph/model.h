@@ -265,10 +265,13 @@ class Model {
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+  // If can_use_flatbuffer_for_initializers is true, the initializers may refer to the bytes of fbs_model in place,
+  // so those must outlive the model and any session state created from it.
   static common::Status LoadFromOrtFormat(const onnxruntime::fbs::Model& fbs_model,
 #if !defined(ORT_MINIMAL_BUILD)
                                           const IOnnxRuntimeOpSchemaRegistryList* local_registries,
 #endif
+                                          bool can_use_flatbuffer_for_initializers,
                                           const logging::Logger& logger,
                                           std::unique_ptr<Model>& model);
 
@@ -0,0 +1,492 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/graph/symbolic_shape_inference.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <optional>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace symbolic_shape_inference {
+
+namespace {
+
+// The value of a shape tensor. A scalar is a value with one element.
+using ShapeValue = std::vector<SymbolicDim>;
+
+// Larger constant initializers are not shapes.
+constexpr int64_t kMaxShapeValueSize = 64;
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  return it != attributes.end() && it->second.has_i() ? it->second.i() : default_value;
+}
+
+ShapeValue FromShapeProto(const TensorShapeProto& shape) {
+  ShapeValue value;
+  value.reserve(shape.dim_size());
+  for (const auto& dim : shape.dim()) {
+    value.push_back(SymbolicDim::FromProto(dim));
+  }
+  return value;
+}
+
+bool GetConstantValue(const TensorProto& initializer, ShapeValue& value) {
+  const auto data_type = initializer.data_type();
+  if ((data_type != TensorProto_DataType_INT64 && data_type != TensorProto_DataType_INT32) ||
+      initializer.dims_size() > 1 || (initializer.dims_size() == 1 && initializer.dims(0) > kMaxShapeValueSize)) {
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  if (!utils::UnpackInitializerData(initializer, data).IsOK()) {
+    return false;
+  }
+
+  const size_t element_size = data_type == TensorProto_DataType_INT64 ? sizeof(int64_t) : sizeof(int32_t);
+  const size_t count = data.size() / element_size;
+  value.clear();
+  value.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (data_type == TensorProto_DataType_INT64) {
+      int64_t element;
+      memcpy(&element, data.data() + i * element_size, element_size);
+      value.emplace_back(element);
+    } else {
+      int32_t element;
+      memcpy(&element, data.data() + i * element_size, element_size);
+      value.emplace_back(static_cast<int64_t>(element));
+    }
+  }
+
+  return true;
+}
+
+// Gets the value of an input from a constant initializer, or from the symbolic shape inference of its producer.
+bool GetInputValue(const Graph& graph, const Node& node, size_t index, ShapeValue& value) {
+  const auto& input_defs = node.InputDefs();
+  if (index >= input_defs.size() || !input_defs[index]->Exists()) {
+    return false;
+  }
+
+  const auto& name = input_defs[index]->Name();
+  if (const TensorProto* initializer = graph.GetConstantInitializer(name, true)) {
+    return GetConstantValue(*initializer, value);
+  }
+
+  if (const TensorShapeProto* shape_value = graph.GetSymbolicShapeValue(name, true)) {
+    value = FromShapeProto(*shape_value);
+    return true;
+  }
+
+  return false;
+}
+
+// Gets the values of an input whose elements must all be known values, like the indices of Gather.
+bool GetInputInts(const Graph& graph, const Node& node, size_t index, std::vector<int64_t>& ints) {
+  ShapeValue value;
+  if (!GetInputValue(graph, node, index, value) ||
+      !std::all_of(value.begin(), value.end(), [](const SymbolicDim& dim) { return dim.IsValue(); })) {
+    return false;
+  }
+
+  ints.clear();
+  for (const auto& dim : value) {
+    ints.push_back(dim.Value());
+  }
+  return true;
+}
+
+SymbolicDim Product(const ShapeValue& dims) {
+  SymbolicDim product(1);
+  for (const auto& dim : dims) {
+    product = product * dim;
+  }
+  return product;
+}
+
+bool InferShape(const Node& node, ShapeValue& value) {
+  const TensorShapeProto* shape = node.InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  const int64_t rank = shape->dim_size();
+  auto clamp = [rank](int64_t i) { return std::clamp(i < 0 ? i + rank : i, int64_t{0}, rank); };
+  const int64_t start = clamp(GetIntAttribute(node, "start", 0));
+  const int64_t end = clamp(GetIntAttribute(node, "end", rank));
+
+  value.clear();
+  for (int64_t i = start; i < end; ++i) {
+    value.push_back(SymbolicDim::FromProto(shape->dim(static_cast<int>(i))));
+  }
+  return true;
+}
+
+bool InferGather(const Graph& graph, const Node& node, ShapeValue& value) {
+  ShapeValue data;
+  std::vector<int64_t> indices;
+  if (GetIntAttribute(node, "axis", 0) != 0 ||
+      !GetInputValue(graph, node, 0, data) || !GetInputInts(graph, node, 1, indices)) {
+    return false;
+  }
+
+  const int64_t size = static_cast<int64_t>(data.size());
+  value.clear();
+  for (int64_t index : indices) {
+    if (index < -size || index >= size) {
+      return false;
+    }
+    value.push_back(data[static_cast<size_t>(index < 0 ? index + size : index)]);
+  }
+  return true;
+}
+
+bool InferSlice(const Graph& graph, const Node& node, ShapeValue& value) {
+  ShapeValue data;
+  std::vector<int64_t> starts, ends, axes{0}, steps{1};
+  if (!GetInputValue(graph, node, 0, data) ||
+      !GetInputInts(graph, node, 1, starts) || !GetInputInts(graph, node, 2, ends) ||
+      (node.InputDefs().size() > 3 && node.InputDefs()[3]->Exists() && !GetInputInts(graph, node, 3, axes)) ||
+      (node.InputDefs().size() > 4 && node.InputDefs()[4]->Exists() && !GetInputInts(graph, node, 4, steps))) {
+    return false;
+  }
+
+  if (starts.size() != 1 || ends.size() != 1 || axes.size() != 1 || steps.size() != 1 ||
+      (axes[0] != 0 && axes[0] != -1) || steps[0] == 0) {
+    return false;
+  }
+
+  const int64_t size = static_cast<int64_t>(data.size());
+  const int64_t step = steps[0];
+  int64_t start = starts[0] < 0 ? starts[0] + size : starts[0];
+  int64_t end = ends[0] < 0 ? ends[0] + size : ends[0];
+  if (step > 0) {
+    start = std::clamp(start, int64_t{0}, size);
+    end = std::clamp(end, int64_t{0}, size);
+  } else {
+    start = std::clamp(start, int64_t{0}, size - 1);
+    end = std::clamp(end, int64_t{-1}, size - 1);
+  }
+
+  value.clear();
+  for (int64_t i = start; step > 0 ? i < end : i > end; i += step) {
+    value.push_back(data[static_cast<size_t>(i)]);
+  }
+  return true;
+}
+
+bool InferBinary(const Graph& graph, const Node& node, ShapeValue& value) {
+  ShapeValue a, b;
+  if (!GetInputValue(graph, node, 0, a) || !GetInputValue(graph, node, 1, b) || a.empty() || b.empty() ||
+      (a.size() != b.size() && a.size() != 1 && b.size() != 1)) {
+    return false;
+  }
+
+  const auto& op_type = node.OpType();
+  const size_t size = std::max(a.size(), b.size());
+  value.clear();
+  for (size_t i = 0; i < size; ++i) {
+    const SymbolicDim& x = a[a.size() == 1 ? 0 : i];
+    const SymbolicDim& y = b[b.size() == 1 ? 0 : i];
+    if (op_type == "Mul") {
+      value.push_back(x * y);
+    } else if (op_type == "Div") {
+      // integer division truncates, which the exact quotient of two symbolic dims cannot express
+      value.push_back(x.IsValue() && y.IsValue() && y.Value() != 0 ? SymbolicDim(x.Value() / y.Value()) : x / y);
+    } else if (x.IsValue() && y.IsValue()) {
+      value.emplace_back(op_type == "Add" ? x.Value() + y.Value() : x.Value() - y.Value());
+    } else {
+      value.emplace_back();
+    }
+  }
+  return true;
+}
+
+ShapeValue GetInputShape(const Node& node, size_t index) {
+  const TensorShapeProto* shape = node.InputDefs()[index]->Shape();
+  return shape != nullptr ? FromShapeProto(*shape) : ShapeValue{};
+}
+
+// Sets the dims of the output type that are not known yet.
+void FillShape(const ShapeValue& dims, TypeProto& output_type) {
+  if (!output_type.has_tensor_type()) {
+    return;
+  }
+
+  auto& tensor_type = *output_type.mutable_tensor_type();
+  if (!tensor_type.has_shape()) {
+    auto& shape = *tensor_type.mutable_shape();
+    for (const auto& dim : dims) {
+      dim.ToProto(*shape.add_dim());
+    }
+    return;
+  }
+
+  auto& shape = *tensor_type.mutable_shape();
+  if (shape.dim_size() != static_cast<int>(dims.size())) {
+    return;
+  }
+
+  for (int i = 0; i < shape.dim_size(); ++i) {
+    auto& dim = *shape.mutable_dim(i);
+    if (!dim.has_dim_value() && !(dim.has_dim_param() && !dim.dim_param().empty())) {
+      dims[i].ToProto(dim);
+    }
+  }
+}
+
+void RefineReshape(const Graph& graph, const Node& node, TypeProto& output_type) {
+  ShapeValue target;
+  if (!GetInputValue(graph, node, 1, target)) {
+    return;
+  }
+
+  const ShapeValue input = GetInputShape(node, 0);
+  const bool allow_zero = GetIntAttribute(node, "allowzero", 0) != 0;
+  ShapeValue dims(target.size());
+  std::optional<size_t> infer_index;
+  for (size_t i = 0; i < target.size(); ++i) {
+    if (target[i].IsValue() && target[i].Value() == 0 && !allow_zero) {
+      dims[i] = i < input.size() ? input[i] : SymbolicDim{};
+    } else if (target[i].IsValue() && target[i].Value() == -1) {
+      infer_index = i;
+    } else {
+      dims[i] = target[i];
+    }
+  }
+
+  // the inferred dim is the number of elements of the input divided by the product of the other dims
+  if (infer_index.has_value() && node.InputDefs()[0]->Shape() != nullptr) {
+    ShapeValue others = dims;
+    others.erase(others.begin() + static_cast<std::ptrdiff_t>(*infer_index));
+    dims[*infer_index] = Product(input) / Product(others);
+  }
+
+  FillShape(dims, output_type);
+}
+
+void RefineExpand(const Graph& graph, const Node& node, TypeProto& output_type) {
+  ShapeValue target;
+  const TensorShapeProto* input_shape = node.InputDefs()[0]->Shape();
+  if (input_shape == nullptr || !GetInputValue(graph, node, 1, target)) {
+    return;
+  }
+
+  const ShapeValue input = FromShapeProto(*input_shape);
+  const size_t rank = std::max(input.size(), target.size());
+  ShapeValue dims(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    const SymbolicDim a = i + input.size() >= rank ? input[i + input.size() - rank] : SymbolicDim(1);
+    const SymbolicDim b = i + target.size() >= rank ? target[i + target.size() - rank] : SymbolicDim(1);
+    const bool a_is_one = a.IsValue() && a.Value() == 1;
+    const bool b_is_one = b.IsValue() && b.Value() == 1;
+    if (a_is_one || a == b) {
+      dims[i] = b;
+    } else if (b_is_one) {
+      dims[i] = a;
+    } else if (a.IsValue() && !b.IsValue()) {
+      // b is either 1 or equal to a
+      dims[i] = a;
+    } else if (b.IsValue() && !a.IsValue()) {
+      dims[i] = b;
+    }
+  }
+
+  FillShape(dims, output_type);
+}
+
+}  // namespace
+
+SymbolicDim SymbolicDim::FromProto(const TensorShapeProto_Dimension& dim) {
+  if (dim.has_dim_value()) {
+    return SymbolicDim(dim.dim_value());
+  }
+
+  if (!dim.has_dim_param() || dim.dim_param().empty()) {
+    return SymbolicDim{};
+  }
+
+  const std::string& param = dim.dim_param();
+  SymbolicDim result(1);
+
+  // a dim_param that is not a product of names and numbers, e.g. "sequence+1", is a single symbol.
+  const bool is_product = std::all_of(param.begin(), param.end(), [](char c) {
+                            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '*';
+                          }) &&
+                          param.front() != '*' && param.back() != '*' && param.find("**") == std::string::npos;
+  if (!is_product) {
+    result.symbols_[param] = 1;
+    return result;
+  }
+
+  size_t begin = 0;
+  while (begin <= param.size()) {
+    size_t end = param.find('*', begin);
+    if (end == std::string::npos) {
+      end = param.size();
+    }
+
+    std::string factor = param.substr(begin, end - begin);
+    if (factor.size() < 19 && std::all_of(factor.begin(), factor.end(),
+                                          [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+      result.coefficient_ *= std::stoll(factor);
+    } else {
+      ++result.symbols_[factor];
+    }
+
+    begin = end + 1;
+  }
+
+  return result;
+}
+
+void SymbolicDim::ToProto(TensorShapeProto_Dimension& dim) const {
+  if (!known_) {
+    dim.clear_dim_value();
+    dim.clear_dim_param();
+    return;
+  }
+
+  if (symbols_.empty()) {
+    dim.set_dim_value(coefficient_);
+    return;
+  }
+
+  std::string param = coefficient_ != 1 ? std::to_string(coefficient_) : std::string{};
+  for (const auto& symbol : symbols_) {
+    for (int i = 0; i < symbol.second; ++i) {
+      if (!param.empty()) {
+        param += '*';
+      }
+      param += symbol.first;
+    }
+  }
+  dim.set_dim_param(param);
+}
+
+SymbolicDim SymbolicDim::operator*(const SymbolicDim& other) const {
+  if (!known_ || !other.known_) {
+    return SymbolicDim{};
+  }
+
+  if (coefficient_ == 0 || other.coefficient_ == 0) {
+    return SymbolicDim(0);
+  }
+
+  SymbolicDim result(coefficient_ * other.coefficient_);
+  result.symbols_ = symbols_;
+  for (const auto& symbol : other.symbols_) {
+    result.symbols_[symbol.first] += symbol.second;
+  }
+  return result;
+}
+
+SymbolicDim SymbolicDim::operator/(const SymbolicDim& other) const {
+  if (!known_ || !other.known_ || other.coefficient_ == 0 || coefficient_ % other.coefficient_ != 0) {
+    return SymbolicDim{};
+  }
+
+  SymbolicDim result(coefficient_ / other.coefficient_);
+  result.symbols_ = symbols_;
+  for (const auto& symbol : other.symbols_) {
+    auto it = result.symbols_.find(symbol.first);
+    if (it == result.symbols_.end() || it->second < symbol.second) {
+      return SymbolicDim{};
+    }
+
+    it->second -= symbol.second;
+    if (it->second == 0) {
+      result.symbols_.erase(it);
+    }
+  }
+  return result;
+}
+
+bool InferShapeValue(const Graph& graph, const Node& node, TensorShapeProto& value) {
+  if (node.Domain() != kOnnxDomain || node.OutputDefs().empty()) {
+    return false;
+  }
+
+  const auto& op_type = node.OpType();
+  ShapeValue result;
+  bool inferred = false;
+  if (op_type == "Shape") {
+    inferred = InferShape(node, result);
+  } else if (op_type == "Size") {
+    const TensorShapeProto* shape = node.InputDefs()[0]->Shape();
+    if (shape != nullptr) {
+      result = {Product(FromShapeProto(*shape))};
+      inferred = true;
+    }
+  } else if (op_type == "Identity") {
+    inferred = GetInputValue(graph, node, 0, result);
+  } else if (op_type == "Cast") {
+    const int64_t to = GetIntAttribute(node, "to", TensorProto_DataType_UNDEFINED);
+    inferred = (to == TensorProto_DataType_INT64 || to == TensorProto_DataType_INT32) &&
+               GetInputValue(graph, node, 0, result);
+  } else if (op_type == "Squeeze" || op_type == "Unsqueeze") {
+    // only a scalar and a tensor of one element are shape values
+    inferred = GetInputValue(graph, node, 0, result) && result.size() == 1;
+  } else if (op_type == "Concat") {
+    for (size_t i = 0; i < node.InputDefs().size(); ++i) {
+      ShapeValue input;
+      if (!GetInputValue(graph, node, i, input)) {
+        return false;
+      }
+      result.insert(result.end(), input.begin(), input.end());
+    }
+    inferred = true;
+  } else if (op_type == "Gather") {
+    inferred = InferGather(graph, node, result);
+  } else if (op_type == "Slice") {
+    inferred = InferSlice(graph, node, result);
+  } else if (op_type == "Mul" || op_type == "Div" || op_type == "Add" || op_type == "Sub") {
+    inferred = InferBinary(graph, node, result);
+  }
+
+  if (!inferred || result.size() > kMaxShapeValueSize ||
+      std::none_of(result.begin(), result.end(), [](const SymbolicDim& dim) { return dim.IsKnown(); })) {
+    return false;
+  }
+
+  value.Clear();
+  for (const auto& dim : result) {
+    dim.ToProto(*value.add_dim());
+  }
+  return true;
+}
+
+void RefineOutputShapes(const Graph& graph, const Node& node, std::vector<TypeProto>& output_types) {
+  if (node.Domain() != kOnnxDomain || output_types.empty()) {
+    return;
+  }
+
+  const auto& op_type = node.OpType();
+  if (op_type == "Reshape") {
+    RefineReshape(graph, node, output_types[0]);
+  } else if (op_type == "Expand") {
+    RefineExpand(graph, node, output_types[0]);
+  } else if (op_type == "ConstantOfShape") {
+    ShapeValue dims;
+    if (GetInputValue(graph, node, 0, dims)) {
+      FillShape(dims, output_types[0]);
+    }
+  }
+}
+
+}  // namespace symbolic_shape_inference
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "onnx/onnx_pb.h"
+
+namespace onnxruntime {
+
+class Graph;
+class Node;
+
+namespace symbolic_shape_inference {
+
+/**
+A dim of the form coefficient * s1 * s2 * ..., where s1, s2, ... are the dim_param of free dims.
+
+This is the small expression engine used to keep the relationships between dims through the shape computations of a
+graph, e.g. the first dim of Reshape(X, Concat(Mul(Gather(Shape(X), 0), Gather(Shape(X), 1)), 768)) is
+"batch*sequence" when X has shape [batch, sequence, 768]. A product is written as the dim_param of its factors
+joined by '*', so that it can be read back from a TensorShapeProto.
+*/
+class SymbolicDim {
+ public:
+  // An unknown dim.
+  SymbolicDim() = default;
+
+  explicit SymbolicDim(int64_t value) : known_{true}, coefficient_{value} {}
+
+  // Reads a dim of a TensorShapeProto. A dim without dim_value or dim_param is unknown.
+  static SymbolicDim FromProto(const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim);
+
+  // Writes the dim to a TensorShapeProto dim, which is left empty if the dim is unknown.
+  void ToProto(ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) const;
+
+  bool IsKnown() const { return known_; }
+  bool IsValue() const { return known_ && symbols_.empty(); }
+  int64_t Value() const { return coefficient_; }
+
+  SymbolicDim operator*(const SymbolicDim& other) const;
+
+  // Returns the exact quotient, or an unknown dim if other does not divide this dim.
+  SymbolicDim operator/(const SymbolicDim& other) const;
+
+  bool operator==(const SymbolicDim& other) const {
+    return known_ && other.known_ && coefficient_ == other.coefficient_ && symbols_ == other.symbols_;
+  }
+
+ private:
+  bool known_ = false;
+  int64_t coefficient_ = 1;
+  // Exponent of each symbol.
+  std::map<std::string, int> symbols_;
+};
+
+/**
+Infers the value of the first output of the node when it is a shape tensor, i.e. an int64 or int32 tensor with at
+most one dim computed from the shapes of other tensors, such as the output of Shape, Gather, Concat or Slice.
+The values of the inputs come from the constant initializers of the graph and Graph::GetSymbolicShapeValue.
+@returns true if the value was inferred. A dim of the value is empty if that element is not known.
+*/
+bool InferShapeValue(const Graph& graph, const Node& node, ONNX_NAMESPACE::TensorShapeProto& value);
+
+/**
+Refines the output shapes inferred by ONNX for the node with the shape values of its inputs, e.g. the shape of the
+output of Reshape when its shape input is computed from a Shape node. Only dims without dim_value or dim_param are
+filled in.
+*/
+void RefineOutputShapes(const Graph& graph, const Node& node, std::vector<ONNX_NAMESPACE::TypeProto>& output_types);
+
+}  // namespace symbolic_shape_inference
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
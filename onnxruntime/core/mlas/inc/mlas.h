@@ -114,6 +114,12 @@ MlasGetPreferredBufferAlignment(
     void
     );
 
+const char*
+MLASCALL
+MlasGetPackedBufferFormat(
+    void
+    );
+
 //
 // Activation routines.
 //
@@ -718,7 +724,9 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
-#if defined(MLAS_TARGET_WASM_SCALAR)
+    MlasConvAlgorithmWinograd,
+    MlasConvAlgorithmGroupedDirect,
+#if defined(MLAS_TARGET_WASM)
     MlasConvAlgorithmDepthwise,
 #endif
 };
@@ -750,6 +758,11 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileCountH;
+            size_t TileCountW;
+            const float* TransformedFilter;
+        } Winograd;
     } u;
 };
 
@@ -783,6 +796,38 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(2x2, 3x3) filter transform. MlasConvPrepare selects the Winograd
+// algorithm for suitable 3x3 convolutions. The caller may then supply a filter
+// transformed ahead of time through Parameters->u.Winograd.TransformedFilter,
+// otherwise MlasConv transforms the filter into the working buffer.
+//
+// MlasConvWinogradFilterSize returns the number of elements of the transformed
+// filter or zero if the Winograd algorithm is never used for these parameters.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvWinogradTransformFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* TransformedFilter
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -798,6 +843,18 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Symmetric quantized integer convolution routines.
 //
@@ -892,6 +949,17 @@ MlasMaximumPool(
     size_t KernelSize
     );
 
+template<>
+void
+MLASCALL
+MlasMaximumPool<float>(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -931,6 +999,56 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Computes the softmax or log softmax of the rows of Scale x Input + Mask in a single pass over each
+ *        row, as in the attention probabilities. Supports in place updates of the output buffer.
+ *
+ * @param Input         Supplies the N x D input matrix.
+ * @param Output        Supplies the N x D output matrix.
+ * @param N             Supplies the number of rows.
+ * @param D             Supplies the number of columns.
+ * @param Scale         Supplies the scale applied to the input before the mask is added.
+ * @param Mask          Optionally supplies the MaskRowCount x D additive mask, row n of the input uses the
+ *                      mask row n % MaskRowCount, e.g. 1 to broadcast a single row over the input.
+ * @param MaskRowCount  Supplies the number of rows of the mask, ignored if Mask is nullptr.
+ * @param Causal        Supplies true if row n only attends to the columns up to n + CausalOffset. The other
+ *                      columns are excluded from the softmax and are set to 0, or to -infinity for log softmax.
+ * @param CausalOffset  Supplies the offset of the causal mask, e.g. the past sequence length.
+ * @param LogSoftmax    Supplies true to compute the log softmax.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if the base library threading
+ *                      support should be used.
+ */
+void
+MLASCALL
+MlasComputeSoftmaxMasked(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    float Scale,
+    const float* Mask,
+    size_t MaskRowCount,
+    bool Causal,
+    size_t CausalOffset,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Computes softmax and quantizes the output to uint8 with a scale of 1/255 and
+// a zero point of 0. Input is overwritten with intermediate values.
+//
+
+void
+MLASCALL
+MlasComputeSoftmaxQuantized(
+    float* Input,
+    uint8_t* Output,
+    size_t N,
+    size_t D,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -939,6 +1057,326 @@ MlasComputeTanh(
     size_t N
     );
 
+//
+// Element-wise binary operations with a broadcast vector of channel values.
+//
+
+enum MLAS_ELTWISE_KIND {
+    MlasEltwiseAdd,
+    MlasEltwiseSub,
+    MlasEltwiseMul,
+    MlasEltwiseDiv,
+};
+
+/**
+ * @brief Computes Output[o, c, i] = Input[o, c, i] op Channels[c], the broadcast of a bias or a scale over a
+ *        tensor, e.g. [N, C, H, W] op [C, 1, 1] or [N, H, W, C] op [C], in a single vectorized pass.
+ *
+ * @param Kind          Supplies the operation.
+ * @param Input         Supplies the OuterCount x ChannelCount x InnerCount input tensor.
+ * @param Channels      Supplies the ChannelCount channel values.
+ * @param Output        Supplies the output tensor, which may be the same as Input.
+ * @param OuterCount    Supplies the number of elements of the dimensions before the channels.
+ * @param ChannelCount  Supplies the number of channels.
+ * @param InnerCount    Supplies the number of elements of the dimensions after the channels.
+ * @param ChannelsFirst Supplies true to compute Channels[c] op Input[o, c, i] instead.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasEltwiseChannelBroadcast(
+    MLAS_ELTWISE_KIND Kind,
+    const float* Input,
+    const float* Channels,
+    float* Output,
+    size_t OuterCount,
+    size_t ChannelCount,
+    size_t InnerCount,
+    bool ChannelsFirst,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Layer normalization.
+//
+
+/**
+ * @brief Normalizes each row of a RowCount x N matrix to a zero mean and a unit variance, then applies Scale and
+ *        Shift. The residual and bias additions of SkipLayerNormalization are fused into the pass that computes
+ *        the statistics of the row.
+ *
+ * @param Input         Supplies the RowCount x N input matrix.
+ * @param Skip          Supplies an optional RowCount x N matrix added to the input, else nullptr.
+ * @param Bias          Supplies an optional N vector added to the input, else nullptr.
+ * @param Scale         Supplies the N scale vector.
+ * @param Shift         Supplies an optional N shift vector, else nullptr. Not used if Simplified.
+ * @param Output        Supplies the RowCount x N output matrix, which may be the same as Input.
+ * @param Mean          Supplies an optional RowCount buffer that receives the mean of each row, else nullptr.
+ * @param InverseStdDev Supplies an optional RowCount buffer that receives the inverse standard deviation of
+ *                      each row, else nullptr.
+ * @param RowCount      Supplies the number of rows.
+ * @param N             Supplies the number of elements of a row.
+ * @param Epsilon       Supplies the value added to the variance.
+ * @param Simplified    Supplies true to normalize with the root mean square of the values instead of centering
+ *                      them, as SimplifiedLayerNormalization does.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* Mean,
+    float* InverseStdDev,
+    size_t RowCount,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Normalizes each group of channels of a batch of images to a zero mean and a unit variance, then applies
+ *        the per channel Scale and Bias and optionally the swish activation x * sigmoid(x).
+ *
+ * @param Input         Supplies the BatchCount x ChannelCount x ImageSize input, or BatchCount x ImageSize x
+ *                      ChannelCount if ChannelsLast.
+ * @param Scale         Supplies the ChannelCount scale vector.
+ * @param Bias          Supplies the ChannelCount bias vector.
+ * @param Output        Supplies the output in the layout of the input, which may be the same as Input.
+ * @param BatchCount    Supplies the number of images.
+ * @param ChannelCount  Supplies the number of channels, a multiple of GroupCount.
+ * @param ImageSize     Supplies the number of pixels of an image.
+ * @param GroupCount    Supplies the number of groups of consecutive channels.
+ * @param Epsilon       Supplies the value added to the variance.
+ * @param ChannelsLast  Supplies true if the channels are the innermost dimension.
+ * @param Swish         Supplies true to apply the swish activation to the output.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasGroupNormalization(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t ImageSize,
+    size_t GroupCount,
+    float Epsilon,
+    bool ChannelsLast,
+    bool Swish,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Reductions along contiguous dimensions.
+//
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceSumSquare,
+    MlasReduceMaximum,
+    MlasReduceMinimum,
+    MlasReduceLogSumExp,
+};
+
+/**
+ * @brief Computes Output[o] = reduce(Input[o, r]) over r, the reduction of the innermost dimensions of a
+ *        tensor. Rows are split between threads when there are fewer rows than threads.
+ *
+ * @param Kind          Supplies the reduction.
+ * @param Input         Supplies the OuterCount x ReduceCount input tensor.
+ * @param Output        Supplies the OuterCount output values.
+ * @param OuterCount    Supplies the number of rows.
+ * @param ReduceCount   Supplies the number of elements of each row, greater than zero.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasReduceInnermost(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Computes Output[o, i] = reduce(Input[o, r, i]) over r, the reduction of the outermost (OuterCount
+ *        is 1) or of the middle dimensions of a tensor.
+ *
+ * @param Kind          Supplies the reduction.
+ * @param Input         Supplies the OuterCount x ReduceCount x InnerCount input tensor.
+ * @param Output        Supplies the OuterCount x InnerCount output tensor.
+ * @param OuterCount    Supplies the number of elements of the dimensions before the reduced dimensions.
+ * @param ReduceCount   Supplies the number of elements of the reduced dimensions, greater than zero.
+ * @param InnerCount    Supplies the number of elements of the dimensions after the reduced dimensions.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasReduceStrided(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Computes Output[o, s, i] = sum(Input[o, t, i]) over t <= s, the prefix sum of a tensor along its middle
+ *        dimension. Independent rows and blocks of columns are partitioned between the threads, and the scanned
+ *        dimension is split in chunks when there are fewer of them than threads.
+ *
+ * @param Input         Supplies the OuterCount x ScanCount x InnerCount input tensor.
+ * @param Output        Supplies the output tensor, which may be the same as Input.
+ * @param OuterCount    Supplies the number of elements of the dimensions before the scanned dimension.
+ * @param ScanCount     Supplies the number of elements of the scanned dimension.
+ * @param InnerCount    Supplies the number of elements of the dimensions after the scanned dimension, 1 for a
+ *                      scan of the rows of an OuterCount x ScanCount matrix.
+ * @param Exclusive     Supplies true to sum over t < s instead.
+ * @param Reverse       Supplies true to sum over t >= s (t > s if Exclusive) instead.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasPrefixSum(
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ScanCount,
+    size_t InnerCount,
+    bool Exclusive,
+    bool Reverse,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Fused attention routines.
+//
+
+/**
+ * @brief Parameters of the fused multi-head attention Softmax(Scale x Q x K' + Bias) x V.
+ *
+ * Q, K and V are laid out as BatchSize x NumHeads x SequenceLength x HeadSize and the output as
+ * BatchSize x QSequenceLength x NumHeads x VHeadSize.
+ */
+struct MLAS_FLASH_ATTENTION_PARAMETERS {
+    size_t BatchSize;
+    size_t NumHeads;
+    size_t QSequenceLength;
+    size_t KvSequenceLength;        /**< including the past sequence, if any */
+    size_t QkHeadSize;
+    size_t VHeadSize;
+    float Scale;
+    bool Causal;                    /**< query i attends to the keys up to i + KvSequenceLength - QSequenceLength */
+    const float* Query;
+    const float* Key;
+    const float* Value;
+    const float* Bias;              /**< optional additive bias, nullptr if none */
+    size_t BiasBatchStride;         /**< element (b, n, i, j) of the bias is at */
+    size_t BiasHeadStride;          /**< Bias[b * BiasBatchStride + n * BiasHeadStride + */
+    size_t BiasRowStride;           /**<      i * BiasRowStride + j] */
+    float* Output;
+};
+
+/**
+ * @brief Returns the size in floats of the workspace required by MlasFlashAttention.
+ *
+ * @param Parameters  Supplies the attention parameters.
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr.
+ */
+size_t
+MLASCALL
+MlasFlashAttentionGetWorkspaceSize(
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Computes the multi-head attention in blocks of queries and keys with an online softmax, so that the
+ *        QSequenceLength x KvSequenceLength matrix of attention probabilities is never materialized.
+ *
+ * @param Parameters  Supplies the attention parameters.
+ * @param Workspace   Supplies a buffer of MlasFlashAttentionGetWorkspaceSize floats.
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr. Must be the same as the one passed to
+ *                    MlasFlashAttentionGetWorkspaceSize.
+ */
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters,
+    float* Workspace,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Block-wise quantized weight GEMM routines.
+//
+// B is a K x N matrix quantized along K in blocks of BlkLen elements. Each
+// column of B is stored as ceil(K / BlkLen) consecutive blobs of
+// BlkLen * BlkBitWidth / 8 bytes. Within a blob, 4-bit values are packed two
+// per byte with the lower nibble holding the even element. Each block has its
+// own scale and an optional zero point. Scales are stored column by column,
+// ceil(K / BlkLen) per column. Zero points are stored the same way but, for 4
+// bits, packed two per byte with each column starting on a byte boundary.
+// Without zero points, 2^(BlkBitWidth - 1) is used.
+//
+
+struct MLAS_BLKQUANT_GEMM_DATA_PARAMS {
+    const float* A = nullptr;               /**< address of A (float32 matrix)*/
+    size_t lda = 0;                         /**< leading dimension of A */
+    const uint8_t* QuantBData = nullptr;    /**< address of the quantized blobs of B */
+    const float* QuantBScale = nullptr;     /**< address of the block scales of B */
+    const uint8_t* QuantBZeroPoint = nullptr; /**< address of the block zero points of B, optional */
+    const float* Bias = nullptr;            /**< optional address of the N bias values */
+    float* C = nullptr;                     /**< address of result matrix */
+    size_t ldc = 0;                         /**< leading dimension of C*/
+};
+
+/**
+ * @brief Returns whether MlasBlkQuantGemm supports the given bit width and block length.
+ */
+bool
+MLASCALL
+MlasIsBlkQuantGemmAvailable(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    );
+
+/**
+ * @brief Computes C = A x dequantize(B) + Bias for a block-wise quantized B. B is dequantized in small tiles that
+ *        are consumed by SGEMM right away, so only the quantized weights are read from memory.
+ *
+ * @param M           Supplies the number of rows of A and C.
+ * @param N           Supplies the number of columns of B and C.
+ * @param K           Supplies the number of columns of A and rows of B.
+ * @param BlkBitWidth Supplies the bit width of the quantized values of B, 4 or 8.
+ * @param BlkLen      Supplies the number of values of B in a quantization block.
+ * @param Data        Supplies the matrices.
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasBlkQuantGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const MLAS_BLKQUANT_GEMM_DATA_PARAMS* Data,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -952,6 +1390,194 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+/**
+ * @brief Supplies the element type of a half precision GEMM.
+ */
+enum MLAS_HALF_GEMM_TYPE {
+    MlasHalfGemmFloat16,            /**< IEEE 754 binary16 */
+    MlasHalfGemmBFloat16,           /**< bfloat16, the upper 16 bits of a float */
+};
+
+/**
+ * @brief Converts half precision values to single precision.
+ *
+ * @param Type          Supplies the half precision format of the source values.
+ * @param Source        Supplies the half precision values.
+ * @param Destination   Supplies the buffer to receive the single precision values.
+ * @param Count         Supplies the number of values to convert.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if
+ *                      the conversion runs on the calling thread.
+ */
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    MLAS_HALF_GEMM_TYPE Type,
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Converts single precision values to half precision, rounding to the
+ *        nearest even value.
+ *
+ * @param Type          Supplies the half precision format of the destination values.
+ * @param Source        Supplies the single precision values.
+ * @param Destination   Supplies the buffer to receive the half precision values.
+ * @param Count         Supplies the number of values to convert.
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if
+ *                      the conversion runs on the calling thread.
+ */
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    MLAS_HALF_GEMM_TYPE Type,
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Data parameters for half precision GEMM routine
+ *        C := alpha * op(A) * op(B) + beta * C
+ *        A, B and C are half precision values. The products are accumulated
+ *        in single precision.
+ */
+struct MLAS_HALF_GEMM_DATA_PARAMS {
+    const uint16_t* A = nullptr;    /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    const void* B = nullptr;        /**< Supplies the address of matrix B, or the packed matrix B */
+    size_t ldb = 0;                 /**< Supplies the first dimension of matrix B. Ignored if B is packed */
+    uint16_t* C = nullptr;          /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;             /**< Supplies the scalar alpha multiplier */
+    float beta = 0.0f;              /**< Supplies the scalar beta multiplier */
+    bool BIsPacked = false;         /**< Whether B is pre-packed by MlasHalfGemmPackB */
+};
+
+/**
+ * @brief  Batched half precision matrix/matrix multiply operation
+ *
+ * @param Type       Supplies the element type of the matrices.
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param TransB     Supplies the transpose operation for matrix B. Ignored
+ *                   if B is packed.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+ *                   of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if
+ *                   the base library threading support should be used.
+ */
+void
+MLASCALL
+MlasHalfGemmBatch(
+    MLAS_HALF_GEMM_TYPE Type,
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Returns the size in bytes of the buffer for MlasHalfGemmPackB.
+ *
+ * The packed matrix keeps the half precision values, so it is half the size
+ * of a packed single precision matrix.
+ */
+size_t
+MLASCALL
+MlasHalfGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasHalfGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const uint16_t* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+//
+// Sparse single precision matrix/matrix multiply routines, for the weights of
+// pruned models.
+//
+
+enum MLAS_SPARSE_GEMM_FORMAT {
+    MlasSparseGemmBlockCsr,     /**< Nonzero 1x16 blocks of B in CSR order */
+    MlasSparseGemmStructured,   /**< N nonzero values per group of 8 rows of a column of B */
+};
+
+/**
+ * @brief Analyzes matrix B and returns the size in bytes of the buffer for
+ *        MlasSparseGemmPackB.
+ *
+ * @param TransB   Supplies the transpose operation for matrix B.
+ * @param N        Supplies the number of columns of matrix B.
+ * @param K        Supplies the number of rows of matrix B.
+ * @param B        Supplies the address of matrix B.
+ * @param ldb      Supplies the first dimension of matrix B.
+ * @param Format   Receives the packed format that fits the sparsity of B.
+ * @return Size of the packed buffer, 0 if B is not sparse enough for
+ *         MlasSparseGemm to be faster than MlasGemm.
+ */
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    MLAS_SPARSE_GEMM_FORMAT* Format
+    );
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    MLAS_SPARSE_GEMM_FORMAT Format,
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Single precision matrix/matrix multiply operation with matrix B
+ *        packed by MlasSparseGemmPackB, C = alpha * op(A) * B + beta * C.
+ */
+void
+MLASCALL
+MlasSparseGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Transpose routines.
 //
@@ -1224,6 +1850,31 @@ MlasFindMinMaxElement(
     size_t N
     );
 
+/**
+ * @brief Quantizes each row of a matrix to uint8 with its own scale and zero point, the range of a row being found
+ *        and the row quantized in a single pass while it is in the cache. The range of a row is extended to include
+ *        zero, like the per-tensor dynamic quantization.
+ *
+ * @param Input       Supplies the Rows x Columns input matrix.
+ * @param Output      Supplies the Rows x Columns output matrix.
+ * @param Rows        Supplies the number of rows.
+ * @param Columns     Supplies the number of columns.
+ * @param Scales      Returns the scale of each row.
+ * @param ZeroPoints  Returns the zero point of each row.
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr.
+ */
+void
+MLASCALL
+MlasDynamicQuantizeLinearPerRow(
+    const float* Input,
+    uint8_t* Output,
+    size_t Rows,
+    size_t Columns,
+    float* Scales,
+    uint8_t* ZeroPoints,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 size_t
 MLASCALL
 MlasQLinearSafePaddingElementCount(
@@ -0,0 +1,331 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    blkq_gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a block-wise quantized B (weight-only quantization).
+
+    The columns of B are processed in tiles. A tile of B is dequantized into
+    a small buffer that stays in the cache, one chunk of K at a time, and is
+    consumed right away by SGEMM. Only the quantized B is read from memory,
+    which is what matters for the memory bound M = 1 case of token by token
+    decoding.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of columns of B in a tile and number of rows of B dequantized at a
+// time. The chunk of K must be a multiple of the supported block lengths.
+//
+
+constexpr size_t MLAS_BLKQUANT_N_TILE = 16;
+constexpr size_t MLAS_BLKQUANT_K_CHUNK = 256;
+
+struct MLAS_BLKQUANT_GEMM_WORK_BLOCK {
+    const MLAS_BLKQUANT_GEMM_DATA_PARAMS* Data;
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t BlkBitWidth;
+    size_t BlkLen;
+    ptrdiff_t ThreadCount;
+};
+
+template<size_t BlkBitWidth>
+void
+MlasBlkQuantDequantizeTile(
+    const MLAS_BLKQUANT_GEMM_DATA_PARAMS* Data,
+    size_t K,
+    size_t BlkLen,
+    size_t StartN,
+    size_t CountN,
+    size_t StartK,
+    size_t CountK,
+    float* Tile
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a CountK x CountN tile of B, storing each column
+    of the tile as a row of MLAS_BLKQUANT_K_CHUNK elements.
+
+Arguments:
+
+    Data - Supplies the matrices.
+
+    K - Supplies the number of rows of B.
+
+    BlkLen - Supplies the number of values of B in a quantization block.
+
+    StartN - Supplies the first column of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+    StartK - Supplies the first row of the tile, a multiple of BlkLen.
+
+    CountK - Supplies the number of rows of the tile.
+
+    Tile - Supplies the output buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t BlobSize = BlkLen * BlkBitWidth / 8;
+    const size_t ZeroPointColumnBytes = MlasDivRoundup(BlockCountK * BlkBitWidth, 8);
+    const float DefaultZeroPoint = float(1 << (BlkBitWidth - 1));
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const size_t Column = StartN + n;
+        float* TileRow = Tile + n * MLAS_BLKQUANT_K_CHUNK;
+
+        for (size_t k = 0; k < CountK; k += BlkLen) {
+
+            const size_t Block = (StartK + k) / BlkLen;
+            const size_t BlockLength = std::min(BlkLen, CountK - k);
+
+            const float Scale = Data->QuantBScale[Column * BlockCountK + Block];
+
+            float ZeroPoint = DefaultZeroPoint;
+
+            if (Data->QuantBZeroPoint != nullptr) {
+                const uint8_t* ZeroPoints = Data->QuantBZeroPoint + Column * ZeroPointColumnBytes;
+                if (BlkBitWidth == 4) {
+                    const uint8_t Packed = ZeroPoints[Block / 2];
+                    ZeroPoint = float((Block & 1) ? (Packed >> 4) : (Packed & 0x0F));
+                } else {
+                    ZeroPoint = float(ZeroPoints[Block]);
+                }
+            }
+
+            //
+            // (q - ZeroPoint) x Scale = q x Scale + Offset
+            //
+
+            const float Offset = -ZeroPoint * Scale;
+            const uint8_t* Blob = Data->QuantBData + (Column * BlockCountK + Block) * BlobSize;
+            float* Output = TileRow + k;
+
+            if (BlkBitWidth == 4) {
+
+                size_t j = 0;
+
+                for (; j + 2 <= BlockLength; j += 2) {
+                    const uint8_t Packed = Blob[j / 2];
+                    Output[j] = float(Packed & 0x0F) * Scale + Offset;
+                    Output[j + 1] = float(Packed >> 4) * Scale + Offset;
+                }
+
+                if (j < BlockLength) {
+                    Output[j] = float(Blob[j / 2] & 0x0F) * Scale + Offset;
+                }
+
+            } else {
+
+                for (size_t j = 0; j < BlockLength; j++) {
+                    Output[j] = float(Blob[j]) * Scale + Offset;
+                }
+            }
+        }
+    }
+}
+
+void
+MlasBlkQuantGemmThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    block-wise quantized GEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_BLKQUANT_GEMM_WORK_BLOCK*)Context;
+    const MLAS_BLKQUANT_GEMM_DATA_PARAMS* Data = WorkBlock->Data;
+
+    const size_t M = WorkBlock->M;
+    const size_t N = WorkBlock->N;
+    const size_t K = WorkBlock->K;
+
+    const size_t TileCountN = MlasDivRoundup(N, MLAS_BLKQUANT_N_TILE);
+
+    size_t TileIndex;
+    size_t TileRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, TileCountN, &TileIndex, &TileRemaining);
+
+    MLAS_DECLSPEC_ALIGN(float Tile[MLAS_BLKQUANT_N_TILE * MLAS_BLKQUANT_K_CHUNK], 16 * sizeof(float));
+
+    for (; TileRemaining > 0; TileIndex++, TileRemaining--) {
+
+        const size_t StartN = TileIndex * MLAS_BLKQUANT_N_TILE;
+        const size_t CountN = std::min(MLAS_BLKQUANT_N_TILE, N - StartN);
+
+        float* C = Data->C + StartN;
+
+        if (K == 0) {
+            for (size_t m = 0; m < M; m++) {
+                std::fill_n(C + m * Data->ldc, CountN, 0.0f);
+            }
+        }
+
+        for (size_t StartK = 0; StartK < K; StartK += MLAS_BLKQUANT_K_CHUNK) {
+
+            const size_t CountK = std::min(MLAS_BLKQUANT_K_CHUNK, K - StartK);
+
+            if (WorkBlock->BlkBitWidth == 4) {
+                MlasBlkQuantDequantizeTile<4>(Data, K, WorkBlock->BlkLen, StartN, CountN, StartK, CountK, Tile);
+            } else {
+                MlasBlkQuantDequantizeTile<8>(Data, K, WorkBlock->BlkLen, StartN, CountN, StartK, CountK, Tile);
+            }
+
+            MlasGemm(CblasNoTrans, CblasTrans, M, CountN, CountK, 1.0f,
+                     Data->A + StartK, Data->lda, Tile, MLAS_BLKQUANT_K_CHUNK,
+                     StartK == 0 ? 0.0f : 1.0f, C, Data->ldc, nullptr);
+        }
+
+        if (Data->Bias != nullptr) {
+            for (size_t m = 0; m < M; m++) {
+                float* CRow = C + m * Data->ldc;
+                for (size_t n = 0; n < CountN; n++) {
+                    CRow[n] += Data->Bias[StartN + n];
+                }
+            }
+        }
+    }
+}
+
+bool
+MLASCALL
+MlasIsBlkQuantGemmAvailable(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether MlasBlkQuantGemm supports a quantization.
+
+Arguments:
+
+    BlkBitWidth - Supplies the bit width of the quantized values.
+
+    BlkLen - Supplies the number of values in a quantization block.
+
+Return Value:
+
+    Returns true if the quantization is supported.
+
+--*/
+{
+    if (BlkBitWidth != 4 && BlkBitWidth != 8) {
+        return false;
+    }
+
+    //
+    // The block length must be a power of two that divides the chunk of K.
+    //
+
+    return BlkLen >= 16 && BlkLen <= MLAS_BLKQUANT_K_CHUNK && (BlkLen & (BlkLen - 1)) == 0;
+}
+
+void
+MLASCALL
+MlasBlkQuantGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const MLAS_BLKQUANT_GEMM_DATA_PARAMS* Data,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes C = A x dequantize(B) + Bias for a block-wise
+    quantized B.
+
+Arguments:
+
+    M - Supplies the number of rows of A and C.
+
+    N - Supplies the number of columns of B and C.
+
+    K - Supplies the number of columns of A and rows of B.
+
+    BlkBitWidth - Supplies the bit width of the quantized values of B.
+
+    BlkLen - Supplies the number of values of B in a quantization block.
+
+    Data - Supplies the matrices.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_BLKQUANT_GEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Data = Data;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.BlkBitWidth = BlkBitWidth;
+    WorkBlock.BlkLen = BlkLen;
+
+    //
+    // Split the columns of B across the threads, each tile being dequantized
+    // exactly once.
+    //
+
+    const size_t TileCountN = MlasDivRoundup(N, MLAS_BLKQUANT_N_TILE);
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > TileCountN) {
+        ThreadCount = ptrdiff_t(TileCountN);
+    }
+
+    WorkBlock.ThreadCount = ThreadCount;
+
+    MlasExecuteThreaded(MlasBlkQuantGemmThreaded, &WorkBlock, ThreadCount, ThreadPool);
+}
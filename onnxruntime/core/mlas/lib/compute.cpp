@@ -73,8 +73,14 @@ struct MLAS_SOFTMAX_WORK_BLOCK {
     bool LogSoftmax;
     const float* Input;
     float* Output;
+    uint8_t* QuantizedOutput;
     size_t N;
     size_t D;
+    float Scale;
+    const float* Mask;
+    size_t MaskRowCount;
+    bool Causal;
+    size_t CausalOffset;
 };
 
 MLAS_FORCEINLINE
@@ -798,6 +804,75 @@ Return Value:
     }
 }
 
+void
+MlasComputeSoftmaxScaleAddMask(
+    const float* Input,
+    const float* Mask,
+    float* Output,
+    size_t N,
+    float Scale
+    )
+/*++
+
+Routine Description:
+
+    This routine scales a row of values and adds the additive mask to the
+    results, before the softmax of the row is computed in place.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Mask - Optionally supplies the mask row.
+
+    Output - Supplies the output row, which may be the same as Input.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the scale applied to the input values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    size_t n = 0;
+
+    if (Mask != nullptr) {
+
+        for (; n + 8 <= N; n += 8) {
+
+            MLAS_FLOAT32X4 Vector0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input + n), ScaleVector, MlasLoadFloat32x4(Mask + n));
+            MLAS_FLOAT32X4 Vector1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input + n + 4), ScaleVector, MlasLoadFloat32x4(Mask + n + 4));
+
+            MlasStoreFloat32x4(Output + n, Vector0);
+            MlasStoreFloat32x4(Output + n + 4, Vector1);
+        }
+
+        for (; n < N; n++) {
+            Output[n] = Input[n] * Scale + Mask[n];
+        }
+
+    } else {
+
+        for (; n + 8 <= N; n += 8) {
+
+            MLAS_FLOAT32X4 Vector0 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Input + n), ScaleVector);
+            MLAS_FLOAT32X4 Vector1 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Input + n + 4), ScaleVector);
+
+            MlasStoreFloat32x4(Output + n, Vector0);
+            MlasStoreFloat32x4(Output + n + 4, Vector1);
+        }
+
+        for (; n < N; n++) {
+            Output[n] = Input[n] * Scale;
+        }
+    }
+}
+
 void
 MlasComputeSoftmaxThreaded(
     void* Context,
@@ -839,20 +914,50 @@ Return Value:
 
     const size_t D = WorkBlock->D;
     const bool LogSoftmax = WorkBlock->LogSoftmax;
+    const bool ScaleOrMask = WorkBlock->Scale != 1.0f || WorkBlock->Mask != nullptr;
 
     const float* Input = WorkBlock->Input + n * D;
     float* Output = WorkBlock->Output + n * D;
+    uint8_t* QuantizedOutput = WorkBlock->QuantizedOutput != nullptr ? WorkBlock->QuantizedOutput + n * D : nullptr;
 
     while (CountN > 0) {
 
+        //
+        // Columns past the causal limit of the row are excluded from the
+        // softmax and are written after the row is computed.
+        //
+
+        size_t RowD = D;
+
+        if (WorkBlock->Causal) {
+            RowD = std::min(D, n + WorkBlock->CausalOffset + 1);
+        }
+
+        //
+        // Scale the row and add the mask in the output buffer, which is then
+        // the input of the softmax of the row while it is still in the cache.
+        //
+
+        const float* RowInput = Input;
+
+        if (ScaleOrMask) {
+
+            const float* MaskRow = (WorkBlock->Mask != nullptr) ?
+                WorkBlock->Mask + (n % WorkBlock->MaskRowCount) * D : nullptr;
+
+            MlasComputeSoftmaxScaleAddMask(Input, MaskRow, Output, RowD, WorkBlock->Scale);
+
+            RowInput = Output;
+        }
+
         //
         // Find the maximum value for the row.
         //
 
 #if defined(MLAS_TARGET_AMD64)
-        float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Input, D);
+        float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(RowInput, RowD);
 #else
-        float Maximum = MlasReduceMaximumF32Kernel(Input, D);
+        float Maximum = MlasReduceMaximumF32Kernel(RowInput, RowD);
 #endif
         float NegativeMaximum = -Maximum;
 
@@ -863,9 +968,9 @@ Return Value:
             //
 
 #if defined(MLAS_TARGET_AMD64)
-            float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Input, nullptr, D, &NegativeMaximum);
+            float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(RowInput, nullptr, RowD, &NegativeMaximum);
 #else
-            float Accumulation = MlasComputeSumExpF32Kernel(Input, nullptr, D, &NegativeMaximum);
+            float Accumulation = MlasComputeSumExpF32Kernel(RowInput, nullptr, RowD, &NegativeMaximum);
 #endif
 
             //
@@ -875,11 +980,13 @@ Return Value:
             float Parameters[] = { NegativeMaximum, std::log(Accumulation)};
 
 #if defined(MLAS_TARGET_AMD64)
-            GetMlasPlatform().ComputeLogSoftmaxOutputF32Kernel(Input, Output, D, Parameters);
+            GetMlasPlatform().ComputeLogSoftmaxOutputF32Kernel(RowInput, Output, RowD, Parameters);
 #else
-            MlasComputeLogSoftmaxOutputF32Kernel(Input, Output, D, Parameters);
+            MlasComputeLogSoftmaxOutputF32Kernel(RowInput, Output, RowD, Parameters);
 #endif
 
+            std::fill_n(Output + RowD, D - RowD, -std::numeric_limits<float>::infinity());
+
         } else {
 
             //
@@ -888,26 +995,43 @@ Return Value:
             //
 
 #if defined(MLAS_TARGET_AMD64)
-            float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Input, Output, D, &NegativeMaximum);
+            float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(RowInput, Output, RowD, &NegativeMaximum);
 #else
-            float Accumulation = MlasComputeSumExpF32Kernel(Input, Output, D, &NegativeMaximum);
+            float Accumulation = MlasComputeSumExpF32Kernel(RowInput, Output, RowD, &NegativeMaximum);
 #endif
 
-            //
-            // Normalize the softmax output.
-            //
+            if (QuantizedOutput != nullptr) {
+
+                //
+                // Normalize and quantize the softmax output in a single pass by
+                // folding the normalization into the quantization scale.
+                //
+
+                MlasQuantizeLinear(Output, QuantizedOutput, D, Accumulation / 255.0f, uint8_t(0));
 
-            float Parameters[] = { 1.0f / Accumulation };
+                QuantizedOutput += D;
+
+            } else {
+
+                //
+                // Normalize the softmax output.
+                //
+
+                float Parameters[] = { 1.0f / Accumulation };
 
 #if defined(MLAS_TARGET_AMD64)
-            GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
+                GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, RowD, Parameters);
 #else
-            MlasComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
+                MlasComputeSoftmaxOutputF32Kernel(Output, RowD, Parameters);
 #endif
+
+                std::fill_n(Output + RowD, D - RowD, 0.0f);
+            }
         }
 
         Input += D;
         Output += D;
+        n++;
         CountN--;
     }
 }
@@ -950,6 +1074,36 @@ Return Value:
 
     None.
 
+--*/
+{
+    MlasComputeSoftmaxMasked(Input, Output, N, D, 1.0f, nullptr, 0, false, 0, LogSoftmax, ThreadPool);
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxMasked(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    float Scale,
+    const float* Mask,
+    size_t MaskRowCount,
+    bool Causal,
+    size_t CausalOffset,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function of the scaled
+    and masked rows, see the declaration in mlas.h for the description of
+    the arguments.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
 --*/
 {
     MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
@@ -961,8 +1115,14 @@ Return Value:
     WorkBlock.LogSoftmax = LogSoftmax;
     WorkBlock.Input = Input;
     WorkBlock.Output = Output;
+    WorkBlock.QuantizedOutput = nullptr;
     WorkBlock.N = N;
     WorkBlock.D = D;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Mask = Mask;
+    WorkBlock.MaskRowCount = MaskRowCount;
+    WorkBlock.Causal = Causal;
+    WorkBlock.CausalOffset = CausalOffset;
 
     //
     // Compute the number of target threads given the complexity of the softmax
@@ -989,3 +1149,75 @@ Return Value:
 
     MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
 }
+
+void
+MLASCALL
+MlasComputeSoftmaxQuantized(
+    float* Input,
+    uint8_t* Output,
+    size_t N,
+    size_t D,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax function and quantizes the output to
+    uint8 with a scale of 1/255 and a zero point of 0, so that probabilities of
+    0 and 1 are exactly representable.
+
+    N.B. The input buffer is overwritten with the exponential values, which
+    avoids a separate float output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the quantized output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    WorkBlock.LogSoftmax = false;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Input;
+    WorkBlock.QuantizedOutput = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Scale = 1.0f;
+    WorkBlock.Mask = nullptr;
+    WorkBlock.MaskRowCount = 0;
+    WorkBlock.Causal = false;
+    WorkBlock.CausalOffset = 0;
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -23,6 +23,34 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the minimum number of input and output channels for the Winograd
+// algorithm. The transforms are only amortized if the GEMMs are large enough.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS 32
+
+//
+// Define the minimum output height and width for the Winograd algorithm.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SHAPE 4
+
+//
+// Define the number of 4x4 input tiles transformed per block of GEMMs. This
+// bounds the size of the working buffer for large images.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_BLOCK 128
+
+//
+// Define the maximum number of input channels per group for the direct
+// grouped algorithm. Depthwise and narrow grouped convolutions do too little
+// work per expanded column for the GEMM to amortize the expansion.
+//
+
+#define MLAS_CONV_GROUPED_DIRECT_MAXIMUM_CHANNELS 16
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -728,6 +756,239 @@ Return Value:
     }
 }
 
+void
+MlasConvGroupedDirectPlane(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine computes an output channel of a two dimensional convolution
+    directly from the input channels of its group.
+
+    Each output row is accumulated in place from the filter taps multiplied by
+    the matching input rows, so the output row stays in the cache and no
+    expanded matrix is built.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input channels of the group.
+
+    Filter - Supplies the filter of the output channel.
+
+    Output - Supplies the output channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+
+    //
+    // Initialize the output with the scaled existing contents.
+    //
+
+    const float Beta = Parameters->Beta;
+
+    if (Beta == 0.0f) {
+        std::fill_n(Output, OutputSize, 0.0f);
+    } else if (Beta != 1.0f) {
+        for (size_t i = 0; i < OutputSize; i++) {
+            Output[i] *= Beta;
+        }
+    }
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+
+        float* output = Output + oh * OutputWidth;
+
+        for (size_t ic = 0; ic < InputChannels; ic++) {
+
+            const float* input = Input + ic * InputSize;
+            const float* filter = Filter + ic * KernelHeight * KernelWidth;
+
+            for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                //
+                // Skip the filter rows that read the padding.
+                //
+
+                const size_t ih = oh * StrideHeight + kh * DilationHeight - PaddingTop;
+
+                if (ih >= InputHeight) {
+                    continue;
+                }
+
+                const float* row = input + ih * InputWidth;
+
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                    //
+                    // Compute the range of output columns that read the input
+                    // row and not the padding.
+                    //
+
+                    const size_t Offset = kw * DilationWidth;
+                    size_t OutputBegin = 0;
+
+                    if (Offset < PaddingLeft) {
+                        OutputBegin = (PaddingLeft - Offset + StrideWidth - 1) / StrideWidth;
+                    }
+
+                    if (InputWidth + PaddingLeft <= Offset) {
+                        continue;
+                    }
+
+                    const size_t OutputEnd =
+                        std::min(OutputWidth, (InputWidth + PaddingLeft - Offset - 1) / StrideWidth + 1);
+
+                    if (OutputBegin >= OutputEnd) {
+                        continue;
+                    }
+
+                    const float FilterValue = filter[kh * KernelWidth + kw];
+                    const float* in = row + OutputBegin * StrideWidth + Offset - PaddingLeft;
+                    float* out = output + OutputBegin;
+                    size_t CountW = OutputEnd - OutputBegin;
+
+                    if (StrideWidth == 1) {
+
+                        const MLAS_FLOAT32X4 FilterVector = MlasBroadcastFloat32x4(FilterValue);
+
+                        while (CountW >= 8) {
+
+                            MLAS_FLOAT32X4 Vector0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(in), FilterVector, MlasLoadFloat32x4(out));
+                            MLAS_FLOAT32X4 Vector1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(in + 4), FilterVector, MlasLoadFloat32x4(out + 4));
+
+                            MlasStoreFloat32x4(out, Vector0);
+                            MlasStoreFloat32x4(out + 4, Vector1);
+
+                            in += 8;
+                            out += 8;
+                            CountW -= 8;
+                        }
+
+                        while (CountW >= 4) {
+
+                            MlasStoreFloat32x4(out, MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(in), FilterVector, MlasLoadFloat32x4(out)));
+
+                            in += 4;
+                            out += 4;
+                            CountW -= 4;
+                        }
+                    }
+
+                    while (CountW > 0) {
+
+                        *out += FilterValue * *in;
+
+                        in += StrideWidth;
+                        out += 1;
+                        CountW -= 1;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvGroupedDirectThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    direct grouped convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Compute the range of output channels over all batches to use for this
+    // thread.
+    //
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t ChannelCount = Parameters->BatchCount * GroupCount * FilterCount;
+
+    size_t ChannelStart;
+    size_t ChannelRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, ChannelCount,
+        &ChannelStart, &ChannelRemaining);
+
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+
+    for (size_t channel = ChannelStart; channel < ChannelStart + ChannelRemaining; channel++) {
+
+        const size_t bg = channel / FilterCount;
+        const size_t FilterIndex = channel % FilterCount;
+        const size_t group = bg % GroupCount;
+
+        const float* input = WorkBlock->Input + bg * InputGroupSize;
+        const float* filter = WorkBlock->Filter + (group * FilterCount + FilterIndex) * K;
+        float* output = WorkBlock->Output + channel * OutputSize;
+
+        MlasConvGroupedDirectPlane(Parameters, input, filter, output);
+
+        //
+        // Apply the activation with optional bias.
+        //
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount + FilterIndex;
+        }
+
+        MlasActivation(Parameters->Activation, output, bias, 1, OutputSize, OutputSize);
+    }
+}
+
 inline
 bool
 MlasConvTryMultithread(
@@ -818,6 +1079,356 @@ Return Value:
     return true;
 }
 
+template<typename ShapeType>
+bool
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t InputChannels,
+    const ShapeType* KernelShape,
+    const ShapeType* DilationShape,
+    const ShapeType* StrideShape,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine tests if the Winograd F(2x2, 3x3) algorithm can be used for
+    the supplied convolution parameters.
+
+--*/
+{
+    if (Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    return InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS;
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* TransformedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation for a single batch and
+    group using the Winograd F(2x2, 3x3) algorithm.
+
+    Blocks of 4x4 input tiles are transformed to sixteen C x T matrices, which
+    are multiplied with the sixteen K x C transformed filter matrices. The
+    K x T products are then transformed back to 2x2 output tiles.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    TransformedFilter - Supplies the transformed filter tensor for this group.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer for the transformed input and
+        the GEMM products.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+
+    const size_t TileCountW = Parameters->u.Winograd.TileCountW;
+    const size_t TileCount = Parameters->u.Winograd.TileCountH * TileCountW;
+
+    const float Beta = Parameters->Beta;
+
+    size_t TileBlockCount;
+
+    for (size_t TileStart = 0; TileStart < TileCount; TileStart += TileBlockCount) {
+
+        TileBlockCount = std::min(TileCount - TileStart, size_t(MLAS_CONV_WINOGRAD_TILE_BLOCK));
+
+        float* TransformedInput = WorkingBuffer;
+        float* Product = WorkingBuffer + 16 * InputChannels * TileBlockCount;
+
+        //
+        // Transform the input tiles: V = B^T * d * B.
+        //
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* input = Input + c * InputHeight * InputWidth;
+
+            for (size_t tb = 0; tb < TileBlockCount; tb++) {
+
+                const size_t tile = TileStart + tb;
+                const ptrdiff_t ih0 = ptrdiff_t((tile / TileCountW) * 2) - ptrdiff_t(PaddingTop);
+                const ptrdiff_t iw0 = ptrdiff_t((tile % TileCountW) * 2) - ptrdiff_t(PaddingLeft);
+
+                float d[4][4];
+
+                for (size_t i = 0; i < 4; i++) {
+                    const ptrdiff_t ih = ih0 + ptrdiff_t(i);
+                    for (size_t j = 0; j < 4; j++) {
+                        const ptrdiff_t iw = iw0 + ptrdiff_t(j);
+                        if (size_t(ih) < InputHeight && size_t(iw) < InputWidth) {
+                            d[i][j] = input[size_t(ih) * InputWidth + size_t(iw)];
+                        } else {
+                            d[i][j] = 0.0f;
+                        }
+                    }
+                }
+
+                float t[4][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    t[0][j] = d[0][j] - d[2][j];
+                    t[1][j] = d[1][j] + d[2][j];
+                    t[2][j] = d[2][j] - d[1][j];
+                    t[3][j] = d[1][j] - d[3][j];
+                }
+
+                float* v = TransformedInput + c * TileBlockCount + tb;
+                const size_t VStride = InputChannels * TileBlockCount;
+
+                for (size_t i = 0; i < 4; i++) {
+                    v[(i * 4 + 0) * VStride] = t[i][0] - t[i][2];
+                    v[(i * 4 + 1) * VStride] = t[i][1] + t[i][2];
+                    v[(i * 4 + 2) * VStride] = t[i][2] - t[i][1];
+                    v[(i * 4 + 3) * VStride] = t[i][1] - t[i][3];
+                }
+            }
+        }
+
+        //
+        // Multiply each of the sixteen transformed filter matrices with the
+        // corresponding transformed input matrix.
+        //
+
+        MLAS_SGEMM_DATA_PARAMS Data[16];
+
+        for (size_t xi = 0; xi < 16; xi++) {
+            Data[xi].A = TransformedFilter + xi * FilterCount * InputChannels;
+            Data[xi].lda = InputChannels;
+            Data[xi].B = TransformedInput + xi * InputChannels * TileBlockCount;
+            Data[xi].ldb = TileBlockCount;
+            Data[xi].C = Product + xi * FilterCount * TileBlockCount;
+            Data[xi].ldc = TileBlockCount;
+        }
+
+        MlasGemmBatch(CblasNoTrans, CblasNoTrans, FilterCount, TileBlockCount, InputChannels,
+            Data, 16, ThreadPool);
+
+        //
+        // Transform the products to output tiles: Y = A^T * m * A.
+        //
+
+        const size_t MStride = FilterCount * TileBlockCount;
+
+        for (size_t k = 0; k < FilterCount; k++) {
+
+            float* output = Output + k * OutputHeight * OutputWidth;
+
+            for (size_t tb = 0; tb < TileBlockCount; tb++) {
+
+                const size_t tile = TileStart + tb;
+                const size_t oh0 = (tile / TileCountW) * 2;
+                const size_t ow0 = (tile % TileCountW) * 2;
+
+                const float* m = Product + k * TileBlockCount + tb;
+
+                float t[2][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    const float m0 = m[(0 * 4 + j) * MStride];
+                    const float m1 = m[(1 * 4 + j) * MStride];
+                    const float m2 = m[(2 * 4 + j) * MStride];
+                    const float m3 = m[(3 * 4 + j) * MStride];
+                    t[0][j] = m0 + m1 + m2;
+                    t[1][j] = m1 - m2 - m3;
+                }
+
+                for (size_t i = 0; i < 2; i++) {
+
+                    const size_t oh = oh0 + i;
+
+                    if (oh >= OutputHeight) {
+                        break;
+                    }
+
+                    float y[2];
+                    y[0] = t[i][0] + t[i][1] + t[i][2];
+                    y[1] = t[i][1] - t[i][2] - t[i][3];
+
+                    for (size_t j = 0; j < 2 && ow0 + j < OutputWidth; j++) {
+                        float* out = &output[oh * OutputWidth + ow0 + j];
+                        *out = (Beta == 0.0f) ? y[j] : y[j] + Beta * *out;
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // Apply the activation with optional bias.
+    //
+
+    MlasActivation(Parameters->Activation, Output, Bias, FilterCount,
+        Parameters->OutputSize, Parameters->OutputSize);
+}
+
+size_t
+MLASCALL
+MlasConvWinogradFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements required to store the filter
+    transformed by MlasConvWinogradTransformFilter.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+    FilterCount - Supplies the number of rows of the filter matrix per group.
+
+Return Value:
+
+    Returns the number of elements of the transformed filter, else zero if
+    the Winograd algorithm is not used for these parameters.
+
+--*/
+{
+    if (!MlasConvWinogradIsSupported(Dimensions, InputChannels, KernelShape,
+            DilationShape, StrideShape, FilterCount)) {
+        return 0;
+    }
+
+    return GroupCount * 16 * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradTransformFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filter tensor for the Winograd F(2x2, 3x3)
+    algorithm: U = G * g * G^T.
+
+    The transformed filter is stored as sixteen row major FilterCount x
+    InputChannels matrices per group.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of rows of the filter matrix per group.
+
+    Filter - Supplies the filter tensor in OIHW format.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t UStride = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t k = 0; k < FilterCount; k++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter + (k * InputChannels + c) * 9;
+
+                float t[4][3];
+
+                for (size_t j = 0; j < 3; j++) {
+                    t[0][j] = g[0 * 3 + j];
+                    t[1][j] = 0.5f * (g[0 * 3 + j] + g[1 * 3 + j] + g[2 * 3 + j]);
+                    t[2][j] = 0.5f * (g[0 * 3 + j] - g[1 * 3 + j] + g[2 * 3 + j]);
+                    t[3][j] = g[2 * 3 + j];
+                }
+
+                float* u = TransformedFilter + k * InputChannels + c;
+
+                for (size_t i = 0; i < 4; i++) {
+                    u[(i * 4 + 0) * UStride] = t[i][0];
+                    u[(i * 4 + 1) * UStride] = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+                    u[(i * 4 + 2) * UStride] = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+                    u[(i * 4 + 3) * UStride] = t[i][2];
+                }
+            }
+        }
+
+        Filter += FilterCount * InputChannels * 9;
+        TransformedFilter += 16 * UStride;
+    }
+}
+
 void
 MLASCALL
 MlasConv(
@@ -902,7 +1513,29 @@ Return Value:
         return;
     }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+    //
+    // Schedule the output channels of the direct grouped convolution across
+    // multiple threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmGroupedDirect) {
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+        MlasExecuteThreaded(MlasConvGroupedDirectThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+
+        return;
+    }
+
+#if defined(MLAS_TARGET_WASM)
 
     if (Algorithm == MlasConvAlgorithmDepthwise) {
         // Fill the Working Buffer with Zero for use by the depthwise kernel.
@@ -912,6 +1545,26 @@ Return Value:
 
 #endif
 
+    //
+    // Transform the filter for the Winograd algorithm if the caller has not
+    // supplied a transformed filter.
+    //
+
+    const float* WinogradFilter = nullptr;
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        WinogradFilter = Parameters->u.Winograd.TransformedFilter;
+
+        if (WinogradFilter == nullptr) {
+            MlasConvWinogradTransformFilter(GroupCount, Parameters->InputChannels, FilterCount,
+                Filter, WorkingBuffer);
+            WinogradFilter = WorkingBuffer;
+        }
+
+        WorkingBuffer += GroupCount * 16 * FilterCount * Parameters->InputChannels;
+    }
+
     //
     // Iterate over each batch and group.
     //
@@ -919,6 +1572,7 @@ Return Value:
 
         const float* filter = Filter;
         const float* bias = Bias;
+        const float* winograd_filter = WinogradFilter;
 
         for (size_t group = 0; group < GroupCount; group++) {
 
@@ -975,7 +1629,7 @@ Return Value:
                     break;
                 }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_TARGET_WASM)
 
                 case MlasConvAlgorithmDepthwise:
                 {
@@ -986,6 +1640,16 @@ Return Value:
 
 #endif
 
+                case MlasConvAlgorithmWinograd:
+                {
+                    MlasConvWinograd(Parameters, Input, winograd_filter, bias, WorkingBuffer,
+                        Output, ThreadPool);
+
+                    winograd_filter += 16 * FilterCount * Parameters->InputChannels;
+
+                    break;
+                }
+
                 case MlasConvAlgorithmExpandThenGemmSegmented:
                 {
                     //
@@ -1001,6 +1665,15 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmGroupedDirect:
+                {
+                    //
+                    // Scheduled above across all batches and groups.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1210,6 +1883,78 @@ Return Value:
         }
     }
 
+#if defined(MLAS_TARGET_WASM)
+
+    // Direct conv for depthwise convolution on WebAssembly (scalar or SIMD kernel).
+    // Currently only support 3x3 kernel with padding <=1 and dilations = 1.
+    // TODO: support more general depthwise convolution.
+
+    if (Dimensions == 2
+            && Parameters->FilterCount == 1 && Parameters->InputChannels == 1
+            && Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3
+            && Parameters->Padding[0] <= 1 && Parameters->Padding[1] <= 1
+            && Parameters->Padding[2] <= 1 && Parameters->Padding[3] <= 1
+            && Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1) {
+
+        *WorkingBufferSize = Parameters->InputShape[1] + 2;
+        Parameters->Algorithm = MlasConvAlgorithmDepthwise;
+        return;
+    }
+
+#endif
+
+    //
+    // Compute depthwise and narrow grouped convolutions directly, threaded
+    // across the output channels of all batches and groups.
+    //
+
+    if (Dimensions == 2 && GroupCount > 1 && InputChannels <= MLAS_CONV_GROUPED_DIRECT_MAXIMUM_CHANNELS) {
+
+        const size_t ChannelCount = BatchCount * GroupCount * FilterCount;
+        const double Complexity = double(ChannelCount) * double(OutputSize) * double(K);
+
+        ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (TargetThreadCount >= MaximumThreadCount) {
+            TargetThreadCount = MaximumThreadCount;
+        }
+
+        if (size_t(TargetThreadCount) >= ChannelCount) {
+            TargetThreadCount = ptrdiff_t(ChannelCount);
+        }
+
+        Parameters->ThreadCount = TargetThreadCount;
+        Parameters->Algorithm = MlasConvAlgorithmGroupedDirect;
+
+        return;
+    }
+
+    //
+    // Use the Winograd algorithm for 3x3 convolutions with enough channels and
+    // output tiles to amortize the transforms.
+    //
+
+    if (MlasConvWinogradIsSupported(Dimensions, InputChannels, Parameters->KernelShape,
+            Parameters->DilationShape, Parameters->StrideShape, FilterCount) &&
+        Parameters->OutputShape[0] >= MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SHAPE &&
+        Parameters->OutputShape[1] >= MLAS_CONV_WINOGRAD_MINIMUM_OUTPUT_SHAPE) {
+
+        const size_t TileCountH = (Parameters->OutputShape[0] + 1) / 2;
+        const size_t TileCountW = (Parameters->OutputShape[1] + 1) / 2;
+        const size_t TileBlockCount = std::min(TileCountH * TileCountW, size_t(MLAS_CONV_WINOGRAD_TILE_BLOCK));
+
+        Parameters->Algorithm = MlasConvAlgorithmWinograd;
+        Parameters->u.Winograd.TileCountH = TileCountH;
+        Parameters->u.Winograd.TileCountW = TileCountW;
+        Parameters->u.Winograd.TransformedFilter = nullptr;
+
+        *WorkingBufferSize = GroupCount * 16 * FilterCount * InputChannels +
+            16 * (InputChannels + FilterCount) * TileBlockCount;
+
+        return;
+    }
+
     if (FilterCount > OutputSize) {
 
         //
@@ -1223,26 +1968,6 @@ Return Value:
 
     } else {
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
-
-        // Scalar direct conv for depthwise convolution.
-        // Currently only support 3x3 kernel with padding <=1 and dilations = 1.
-        // TODO: support more general depthwise convolution.
-
-        if (Dimensions == 2
-                && Parameters->FilterCount == 1 && Parameters->InputChannels == 1
-                && Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3
-                && Parameters->Padding[0] <= 1 && Parameters->Padding[1] <= 1
-                && Parameters->Padding[2] <= 1 && Parameters->Padding[3] <= 1
-                && Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1) {
-
-            *WorkingBufferSize = Parameters->InputShape[1] + 2;
-            Parameters->Algorithm = MlasConvAlgorithmDepthwise;
-            return;
-        }
-
-#endif
-
         //
         // Segment the operation across multiple threads by slicing the N
         // dimension (see MlasSgemmTryMultithread).
@@ -0,0 +1,398 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    eltwise.cpp
+
+Abstract:
+
+    This module implements routines to compute element-wise binary operations
+    between a tensor and a vector of channel values broadcast over it.
+
+    The tensor is viewed as [OuterCount, ChannelCount, InnerCount], which covers
+    the common broadcasts of a bias or a scale: [N, C, H, W] op [C, 1, 1] for
+    NCHW tensors and [N, H, W, C] op [C] for channels last tensors.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements to process per thread.
+//
+
+constexpr size_t MLAS_ELTWISE_THREAD_COMPLEXITY = 16 * 1024;
+
+//
+// Number of elements per unit of partitioned work, so that threads do not
+// share the cache lines of the output.
+//
+
+constexpr size_t MLAS_ELTWISE_BLOCK_SIZE = 16;
+
+//
+// Operation functors, the first operand is the tensor value and the second
+// operand is the channel value.
+//
+
+struct MLAS_ELTWISE_ADD_OP {
+    static MLAS_FORCEINLINE float Apply(float x, float c) { return x + c; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 x, MLAS_FLOAT32X4 c) { return MlasAddFloat32x4(x, c); }
+};
+
+struct MLAS_ELTWISE_SUB_OP {
+    static MLAS_FORCEINLINE float Apply(float x, float c) { return x - c; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 x, MLAS_FLOAT32X4 c) { return MlasSubtractFloat32x4(x, c); }
+};
+
+struct MLAS_ELTWISE_SUB_REVERSED_OP {
+    static MLAS_FORCEINLINE float Apply(float x, float c) { return c - x; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 x, MLAS_FLOAT32X4 c) { return MlasSubtractFloat32x4(c, x); }
+};
+
+struct MLAS_ELTWISE_MUL_OP {
+    static MLAS_FORCEINLINE float Apply(float x, float c) { return x * c; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 x, MLAS_FLOAT32X4 c) { return MlasMultiplyFloat32x4(x, c); }
+};
+
+struct MLAS_ELTWISE_DIV_OP {
+    static MLAS_FORCEINLINE float Apply(float x, float c) { return x / c; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 x, MLAS_FLOAT32X4 c) { return MlasDivideFloat32x4(x, c); }
+};
+
+struct MLAS_ELTWISE_DIV_REVERSED_OP {
+    static MLAS_FORCEINLINE float Apply(float x, float c) { return c / x; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 x, MLAS_FLOAT32X4 c) { return MlasDivideFloat32x4(c, x); }
+};
+
+template<typename OpType>
+void
+MlasEltwiseScalarKernel(
+    const float* Input,
+    float Value,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the operation between a run of tensor values and a
+    single channel value.
+
+Arguments:
+
+    Input - Supplies the tensor values.
+
+    Value - Supplies the channel value.
+
+    Output - Supplies the output buffer, which may be the same as Input.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ValueVector = MlasBroadcastFloat32x4(Value);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 v0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 v1 = MlasLoadFloat32x4(Input + 4);
+        MLAS_FLOAT32X4 v2 = MlasLoadFloat32x4(Input + 8);
+        MLAS_FLOAT32X4 v3 = MlasLoadFloat32x4(Input + 12);
+
+        MlasStoreFloat32x4(Output, OpType::Apply(v0, ValueVector));
+        MlasStoreFloat32x4(Output + 4, OpType::Apply(v1, ValueVector));
+        MlasStoreFloat32x4(Output + 8, OpType::Apply(v2, ValueVector));
+        MlasStoreFloat32x4(Output + 12, OpType::Apply(v3, ValueVector));
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, OpType::Apply(MlasLoadFloat32x4(Input), ValueVector));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = OpType::Apply(*Input++, Value);
+        N -= 1;
+    }
+}
+
+template<typename OpType>
+void
+MlasEltwiseVectorKernel(
+    const float* Input,
+    const float* Values,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the operation between a run of tensor values and the
+    same number of channel values, used when the channels are the innermost
+    dimension.
+
+Arguments:
+
+    Input - Supplies the tensor values.
+
+    Values - Supplies the channel values.
+
+    Output - Supplies the output buffer, which may be the same as Input.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 v0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 v1 = MlasLoadFloat32x4(Input + 4);
+
+        MlasStoreFloat32x4(Output, OpType::Apply(v0, MlasLoadFloat32x4(Values)));
+        MlasStoreFloat32x4(Output + 4, OpType::Apply(v1, MlasLoadFloat32x4(Values + 4)));
+
+        Input += 8;
+        Values += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, OpType::Apply(MlasLoadFloat32x4(Input), MlasLoadFloat32x4(Values)));
+
+        Input += 4;
+        Values += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = OpType::Apply(*Input++, *Values++);
+        N -= 1;
+    }
+}
+
+template<typename OpType>
+void
+MlasEltwiseChannelBroadcastRange(
+    const float* Input,
+    const float* Channels,
+    float* Output,
+    size_t ChannelCount,
+    size_t InnerCount,
+    size_t Begin,
+    size_t End
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the operation to the range [Begin, End) of the
+    flattened tensor.
+
+Arguments:
+
+    Input - Supplies the tensor.
+
+    Channels - Supplies the ChannelCount channel values.
+
+    Output - Supplies the output tensor.
+
+    ChannelCount - Supplies the number of channels.
+
+    InnerCount - Supplies the number of elements that share a channel value.
+
+    Begin - Supplies the index of the first element to process.
+
+    End - Supplies the index after the last element to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (InnerCount == 1) {
+
+        size_t ChannelIndex = Begin % ChannelCount;
+
+        while (Begin < End) {
+
+            const size_t Count = std::min(ChannelCount - ChannelIndex, End - Begin);
+
+            MlasEltwiseVectorKernel<OpType>(Input + Begin, Channels + ChannelIndex, Output + Begin, Count);
+
+            Begin += Count;
+            ChannelIndex = 0;
+        }
+
+    } else {
+
+        size_t RowIndex = Begin / InnerCount;
+        size_t RowOffset = Begin % InnerCount;
+
+        while (Begin < End) {
+
+            const size_t Count = std::min(InnerCount - RowOffset, End - Begin);
+
+            MlasEltwiseScalarKernel<OpType>(Input + Begin, Channels[RowIndex % ChannelCount], Output + Begin, Count);
+
+            Begin += Count;
+            RowIndex++;
+            RowOffset = 0;
+        }
+    }
+}
+
+template<typename OpType>
+void
+MlasEltwiseChannelBroadcastThreaded(
+    const float* Input,
+    const float* Channels,
+    float* Output,
+    size_t OuterCount,
+    size_t ChannelCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const size_t TotalCount = OuterCount * ChannelCount * InnerCount;
+    const size_t BlockCount = (TotalCount + MLAS_ELTWISE_BLOCK_SIZE - 1) / MLAS_ELTWISE_BLOCK_SIZE;
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(TotalCount / MLAS_ELTWISE_THREAD_COMPLEXITY) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > BlockCount) {
+        TargetThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t BlockIndex;
+        size_t BlockRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, BlockCount, &BlockIndex, &BlockRemaining);
+
+        const size_t Begin = BlockIndex * MLAS_ELTWISE_BLOCK_SIZE;
+        const size_t End = std::min(TotalCount, (BlockIndex + BlockRemaining) * MLAS_ELTWISE_BLOCK_SIZE);
+
+        MlasEltwiseChannelBroadcastRange<OpType>(Input, Channels, Output, ChannelCount, InnerCount, Begin, End);
+    });
+}
+
+void
+MLASCALL
+MlasEltwiseChannelBroadcast(
+    MLAS_ELTWISE_KIND Kind,
+    const float* Input,
+    const float* Channels,
+    float* Output,
+    size_t OuterCount,
+    size_t ChannelCount,
+    size_t InnerCount,
+    bool ChannelsFirst,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output[o, c, i] = Input[o, c, i] op Channels[c], or
+    Channels[c] op Input[o, c, i] if ChannelsFirst is set.
+
+Arguments:
+
+    Kind - Supplies the operation.
+
+    Input - Supplies the input tensor of OuterCount x ChannelCount x InnerCount
+        elements.
+
+    Channels - Supplies the ChannelCount channel values.
+
+    Output - Supplies the output tensor, which may be the same as Input.
+
+    OuterCount - Supplies the number of elements of the dimensions before the
+        channels.
+
+    ChannelCount - Supplies the number of channels.
+
+    InnerCount - Supplies the number of elements of the dimensions after the
+        channels.
+
+    ChannelsFirst - Supplies true if the channel values are the left operand
+        of the operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (OuterCount == 0 || ChannelCount == 0 || InnerCount == 0) {
+        return;
+    }
+
+    switch (Kind) {
+
+        case MlasEltwiseAdd:
+            MlasEltwiseChannelBroadcastThreaded<MLAS_ELTWISE_ADD_OP>(
+                Input, Channels, Output, OuterCount, ChannelCount, InnerCount, ThreadPool);
+            break;
+
+        case MlasEltwiseSub:
+            if (ChannelsFirst) {
+                MlasEltwiseChannelBroadcastThreaded<MLAS_ELTWISE_SUB_REVERSED_OP>(
+                    Input, Channels, Output, OuterCount, ChannelCount, InnerCount, ThreadPool);
+            } else {
+                MlasEltwiseChannelBroadcastThreaded<MLAS_ELTWISE_SUB_OP>(
+                    Input, Channels, Output, OuterCount, ChannelCount, InnerCount, ThreadPool);
+            }
+            break;
+
+        case MlasEltwiseMul:
+            MlasEltwiseChannelBroadcastThreaded<MLAS_ELTWISE_MUL_OP>(
+                Input, Channels, Output, OuterCount, ChannelCount, InnerCount, ThreadPool);
+            break;
+
+        case MlasEltwiseDiv:
+            if (ChannelsFirst) {
+                MlasEltwiseChannelBroadcastThreaded<MLAS_ELTWISE_DIV_REVERSED_OP>(
+                    Input, Channels, Output, OuterCount, ChannelCount, InnerCount, ThreadPool);
+            } else {
+                MlasEltwiseChannelBroadcastThreaded<MLAS_ELTWISE_DIV_OP>(
+                    Input, Channels, Output, OuterCount, ChannelCount, InnerCount, ThreadPool);
+            }
+            break;
+    }
+}
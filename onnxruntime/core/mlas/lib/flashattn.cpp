@@ -0,0 +1,371 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements a fused multi-head attention operation.
+
+    The queries of a head are processed in blocks. For each block of queries,
+    the scores of a block of keys are computed with SGEMM, turned into
+    unnormalized probabilities relative to the running maximum of each row and
+    multiplied with the block of values into an accumulator. When the running
+    maximum of a row grows, the accumulator and the sum of the row are rescaled
+    (online softmax). Only a block of scores is live at any time, instead of the
+    full matrix of attention probabilities.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of queries and of keys processed by a block.
+//
+
+constexpr size_t MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE = 32;
+constexpr size_t MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE = 128;
+
+struct MLAS_FLASH_ATTENTION_WORK_BLOCK {
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters;
+    float* Workspace;
+    size_t WorkspaceSizePerThread;
+    size_t QBlockCount;
+    ptrdiff_t ThreadCount;
+};
+
+MLAS_FORCEINLINE
+size_t
+MlasFlashAttentionWorkspaceSizePerThread(
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters
+    )
+{
+    //
+    // The block of scores, the accumulator of the output and the running
+    // maximum and sum of each query.
+    //
+
+    return MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE * MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE +
+           MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE * Parameters->VHeadSize +
+           2 * MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE;
+}
+
+ptrdiff_t
+MlasFlashAttentionGetThreadCount(
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool,
+    size_t* QBlockCount
+    )
+{
+    *QBlockCount = MlasDivRoundup(Parameters->QSequenceLength, MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE);
+
+    const size_t WorkCount = Parameters->BatchSize * Parameters->NumHeads * (*QBlockCount);
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > WorkCount) {
+        ThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    return ThreadCount > 0 ? ThreadCount : 1;
+}
+
+void
+MlasFlashAttentionBlock(
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters,
+    size_t BatchIndex,
+    size_t HeadIndex,
+    size_t QStart,
+    size_t QCount,
+    float* Workspace
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the attention of a block of queries of one head.
+
+Arguments:
+
+    Parameters - Supplies the attention parameters.
+
+    BatchIndex - Supplies the batch of the block.
+
+    HeadIndex - Supplies the head of the block.
+
+    QStart - Supplies the index of the first query of the block.
+
+    QCount - Supplies the number of queries of the block.
+
+    Workspace - Supplies the workspace of the current thread.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t QSequenceLength = Parameters->QSequenceLength;
+    const size_t KvSequenceLength = Parameters->KvSequenceLength;
+    const size_t QkHeadSize = Parameters->QkHeadSize;
+    const size_t VHeadSize = Parameters->VHeadSize;
+    const size_t NumHeads = Parameters->NumHeads;
+    const size_t Head = BatchIndex * NumHeads + HeadIndex;
+
+    const float* Query = Parameters->Query + (Head * QSequenceLength + QStart) * QkHeadSize;
+    const float* Key = Parameters->Key + Head * KvSequenceLength * QkHeadSize;
+    const float* Value = Parameters->Value + Head * KvSequenceLength * VHeadSize;
+
+    const float* Bias = nullptr;
+    if (Parameters->Bias != nullptr) {
+        Bias = Parameters->Bias + BatchIndex * Parameters->BiasBatchStride +
+               HeadIndex * Parameters->BiasHeadStride + QStart * Parameters->BiasRowStride;
+    }
+
+    float* Scores = Workspace;
+    float* Accumulator = Scores + MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE * MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE;
+    float* RowMaximum = Accumulator + MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE * VHeadSize;
+    float* RowSum = RowMaximum + MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE;
+
+    std::fill_n(Accumulator, QCount * VHeadSize, 0.0f);
+    std::fill_n(RowMaximum, QCount, std::numeric_limits<float>::lowest());
+    std::fill_n(RowSum, QCount, 0.0f);
+
+    //
+    // With a causal mask, query i attends to the keys up to i + CausalOffset.
+    //
+
+    const size_t CausalOffset = KvSequenceLength - QSequenceLength;
+    size_t KvEnd = KvSequenceLength;
+
+    if (Parameters->Causal) {
+        KvEnd = std::min(KvEnd, QStart + QCount + CausalOffset);
+    }
+
+    for (size_t KvStart = 0; KvStart < KvEnd; KvStart += MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE) {
+
+        const size_t KvCount = std::min(MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE, KvEnd - KvStart);
+
+        //
+        // Scores(QCount, KvCount) = Scale x Q x K'
+        //
+
+        MlasGemm(CblasNoTrans, CblasTrans, QCount, KvCount, QkHeadSize, Parameters->Scale,
+                 Query, QkHeadSize, Key + KvStart * QkHeadSize, QkHeadSize, 0.0f,
+                 Scores, MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE, nullptr);
+
+        for (size_t q = 0; q < QCount; q++) {
+
+            float* Row = Scores + q * MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE;
+            size_t RowCount = KvCount;
+
+            if (Parameters->Causal) {
+                const size_t RowEnd = QStart + q + CausalOffset + 1;
+                RowCount = RowEnd > KvStart ? std::min(KvCount, RowEnd - KvStart) : 0;
+
+                //
+                // The masked keys contribute zero probability.
+                //
+
+                std::fill(Row + RowCount, Row + KvCount, 0.0f);
+
+                if (RowCount == 0) {
+                    continue;
+                }
+            }
+
+            if (Bias != nullptr) {
+                const float* BiasRow = Bias + q * Parameters->BiasRowStride + KvStart;
+                for (size_t k = 0; k < RowCount; k++) {
+                    Row[k] += BiasRow[k];
+                }
+            }
+
+#if defined(MLAS_TARGET_AMD64)
+            float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Row, RowCount);
+#else
+            float Maximum = MlasReduceMaximumF32Kernel(Row, RowCount);
+#endif
+
+            //
+            // Rescale the accumulated output and sum if the maximum grows.
+            //
+
+            if (Maximum > RowMaximum[q]) {
+                const float Correction = std::exp(RowMaximum[q] - Maximum);
+                float* AccumulatorRow = Accumulator + q * VHeadSize;
+                for (size_t v = 0; v < VHeadSize; v++) {
+                    AccumulatorRow[v] *= Correction;
+                }
+                RowSum[q] *= Correction;
+                RowMaximum[q] = Maximum;
+            }
+
+            float NegativeMaximum = -RowMaximum[q];
+
+#if defined(MLAS_TARGET_AMD64)
+            RowSum[q] += GetMlasPlatform().ComputeSumExpF32Kernel(Row, Row, RowCount, &NegativeMaximum);
+#else
+            RowSum[q] += MlasComputeSumExpF32Kernel(Row, Row, RowCount, &NegativeMaximum);
+#endif
+        }
+
+        //
+        // Accumulator(QCount, VHeadSize) += Probabilities x V
+        //
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, QCount, VHeadSize, KvCount, 1.0f,
+                 Scores, MLAS_FLASH_ATTENTION_KV_BLOCK_SIZE, Value + KvStart * VHeadSize, VHeadSize, 1.0f,
+                 Accumulator, VHeadSize, nullptr);
+    }
+
+    //
+    // Normalize and store the output in BxSxNxH layout.
+    //
+
+    for (size_t q = 0; q < QCount; q++) {
+
+        const float Scale = RowSum[q] > 0.0f ? 1.0f / RowSum[q] : 0.0f;
+        const float* AccumulatorRow = Accumulator + q * VHeadSize;
+        float* Output = Parameters->Output +
+                        ((BatchIndex * QSequenceLength + QStart + q) * NumHeads + HeadIndex) * VHeadSize;
+
+        for (size_t v = 0; v < VHeadSize; v++) {
+            Output[v] = AccumulatorRow[v] * Scale;
+        }
+    }
+}
+
+void
+MlasFlashAttentionThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    fused attention operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_FLASH_ATTENTION_WORK_BLOCK*)Context;
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Partition the operation along the blocks of queries of all heads.
+    //
+
+    const size_t QBlockCount = WorkBlock->QBlockCount;
+    const size_t WorkCount = Parameters->BatchSize * Parameters->NumHeads * QBlockCount;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+    float* Workspace = WorkBlock->Workspace + Index * WorkBlock->WorkspaceSizePerThread;
+
+    while (WorkRemaining > 0) {
+
+        const size_t Head = WorkIndex / QBlockCount;
+        const size_t QStart = (WorkIndex % QBlockCount) * MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE;
+        const size_t QCount = std::min(MLAS_FLASH_ATTENTION_Q_BLOCK_SIZE, Parameters->QSequenceLength - QStart);
+
+        MlasFlashAttentionBlock(Parameters, Head / Parameters->NumHeads, Head % Parameters->NumHeads,
+                                QStart, QCount, Workspace);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+size_t
+MLASCALL
+MlasFlashAttentionGetWorkspaceSize(
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the size in floats of the workspace required by
+    MlasFlashAttention.
+
+Arguments:
+
+    Parameters - Supplies the attention parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr.
+
+Return Value:
+
+    Returns the size of the workspace.
+
+--*/
+{
+    size_t QBlockCount;
+    const ptrdiff_t ThreadCount = MlasFlashAttentionGetThreadCount(Parameters, ThreadPool, &QBlockCount);
+
+    return size_t(ThreadCount) * MlasFlashAttentionWorkspaceSizePerThread(Parameters);
+}
+
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMETERS* Parameters,
+    float* Workspace,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the multi-head attention
+    Softmax(Scale x Q x K' + Bias) x V without materializing the matrix of
+    attention probabilities.
+
+Arguments:
+
+    Parameters - Supplies the attention parameters.
+
+    Workspace - Supplies the workspace, see MlasFlashAttentionGetWorkspaceSize.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Parameters->QSequenceLength == 0) {
+        return;
+    }
+
+    MLAS_FLASH_ATTENTION_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Workspace = Workspace;
+    WorkBlock.WorkspaceSizePerThread = MlasFlashAttentionWorkspaceSizePerThread(Parameters);
+    WorkBlock.ThreadCount = MlasFlashAttentionGetThreadCount(Parameters, ThreadPool, &WorkBlock.QBlockCount);
+
+    MlasExecuteThreaded(MlasFlashAttentionThreaded, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+}
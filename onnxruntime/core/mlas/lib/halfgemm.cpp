@@ -0,0 +1,755 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the half precision (float16 and bfloat16) matrix/
+    matrix multiply operation.
+
+    The matrices stay in half precision in memory, so that the weights of a
+    model are read with half the memory bandwidth of the single precision
+    operation. Blocks of the matrices are converted to single precision into
+    buffers on the stack and multiplied with the single precision kernels,
+    which accumulate in single precision.
+
+    This module also implements the conversions of buffers between half
+    precision and single precision.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the block sizes of the operation. The packed matrix B is stored as
+// panels of MLAS_HALF_GEMM_STRIDEN columns.
+//
+
+constexpr size_t MLAS_HALF_GEMM_STRIDEM = 32;
+constexpr size_t MLAS_HALF_GEMM_STRIDEN = 64;
+constexpr size_t MLAS_HALF_GEMM_STRIDEK = 128;
+
+struct MLAS_HALF_GEMM_WORK_BLOCK {
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data;
+    size_t BatchSize;
+    ptrdiff_t ThreadCount;
+};
+
+MLAS_FORCEINLINE
+float
+MlasBitsToFloat(
+    uint32_t Bits
+    )
+{
+    float Value;
+    memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+MLAS_FORCEINLINE
+uint32_t
+MlasFloatToBits(
+    float Value
+    )
+{
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+}
+
+template<MLAS_HALF_GEMM_TYPE Type>
+struct MLAS_HALF_CONVERTER;
+
+template<>
+struct MLAS_HALF_CONVERTER<MlasHalfGemmFloat16>
+{
+    static
+    MLAS_FORCEINLINE
+    float
+    ToFloat(
+        uint16_t Half
+        )
+    {
+        //
+        // Scale the exponent of normal values into the single precision range
+        // and build denormal values from the mantissa with a magic bias.
+        //
+
+        const uint32_t Word = uint32_t(Half) << 16;
+        const uint32_t Sign = Word & 0x80000000u;
+        const uint32_t TwoWord = Word + Word;
+
+        const float Normalized = MlasBitsToFloat((TwoWord >> 4) + (0xE0u << 23)) * 0x1.0p-112f;
+        const float Denormalized = MlasBitsToFloat((TwoWord >> 17) | (126u << 23)) - 0.5f;
+
+        const uint32_t Bits = Sign |
+            (TwoWord < (1u << 27) ? MlasFloatToBits(Denormalized) : MlasFloatToBits(Normalized));
+
+        return MlasBitsToFloat(Bits);
+    }
+
+    static
+    MLAS_FORCEINLINE
+    uint16_t
+    FromFloat(
+        float Value
+        )
+    {
+        //
+        // Round to nearest even through the single precision addition of a
+        // bias that aligns the mantissa to the half precision mantissa.
+        //
+
+        float Base = (std::fabs(Value) * 0x1.0p+112f) * 0x1.0p-110f;
+
+        const uint32_t Word = MlasFloatToBits(Value);
+        const uint32_t ShiftedWord = Word + Word;
+        const uint32_t Sign = Word & 0x80000000u;
+        uint32_t Bias = ShiftedWord & 0xFF000000u;
+
+        if (Bias < 0x71000000u) {
+            Bias = 0x71000000u;
+        }
+
+        Base = MlasBitsToFloat((Bias >> 1) + 0x07800000u) + Base;
+
+        const uint32_t Bits = MlasFloatToBits(Base);
+        const uint32_t NonSign = ((Bits >> 13) & 0x00007C00u) + (Bits & 0x00000FFFu);
+
+        return uint16_t((Sign >> 16) | (ShiftedWord > 0xFF000000u ? 0x7E00u : NonSign));
+    }
+};
+
+template<>
+struct MLAS_HALF_CONVERTER<MlasHalfGemmBFloat16>
+{
+    static
+    MLAS_FORCEINLINE
+    float
+    ToFloat(
+        uint16_t Half
+        )
+    {
+        return MlasBitsToFloat(uint32_t(Half) << 16);
+    }
+
+    static
+    MLAS_FORCEINLINE
+    uint16_t
+    FromFloat(
+        float Value
+        )
+    {
+        uint32_t Bits = MlasFloatToBits(Value);
+
+        if ((Bits & 0x7FFFFFFFu) > 0x7F800000u) {
+            return uint16_t((Bits >> 16) | 0x0040u);
+        }
+
+        Bits += 0x7FFFu + ((Bits >> 16) & 1);
+
+        return uint16_t(Bits >> 16);
+    }
+};
+
+//
+// Define the number of values to convert per thread and the number of values
+// per unit of partitioned work, so that threads do not share cache lines.
+//
+
+constexpr size_t MLAS_HALF_CONVERT_THREAD_COMPLEXITY = 64 * 1024;
+constexpr size_t MLAS_HALF_CONVERT_BLOCK_SIZE = 64;
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts float16 values to single precision.
+
+Arguments:
+
+    Source - Supplies the float16 values.
+
+    Destination - Supplies the buffer to receive the single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    while (Count >= 8) {
+
+        float16x4_t HalfVector0 = vreinterpret_f16_u16(vld1_u16(&Source[0]));
+        float16x4_t HalfVector1 = vreinterpret_f16_u16(vld1_u16(&Source[4]));
+
+        vst1q_f32(&Destination[0], vcvt_f32_f16(HalfVector0));
+        vst1q_f32(&Destination[4], vcvt_f32_f16(HalfVector1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_HALF_CONVERTER<MlasHalfGemmFloat16>::ToFloat(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts single precision values to float16, rounding to the
+    nearest even value.
+
+Arguments:
+
+    Source - Supplies the single precision values.
+
+    Destination - Supplies the buffer to receive the float16 values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    while (Count >= 8) {
+
+        float16x4_t HalfVector0 = vcvt_f16_f32(vld1q_f32(&Source[0]));
+        float16x4_t HalfVector1 = vcvt_f16_f32(vld1q_f32(&Source[4]));
+
+        vst1_u16(&Destination[0], vreinterpret_u16_f16(HalfVector0));
+        vst1_u16(&Destination[4], vreinterpret_u16_f16(HalfVector1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_HALF_CONVERTER<MlasHalfGemmFloat16>::FromFloat(Source[i]);
+    }
+}
+
+template<MLAS_HALF_GEMM_TYPE Type>
+MLAS_FORCEINLINE
+void
+MlasConvertHalfToFloatRange(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    if (Type == MlasHalfGemmFloat16) {
+#if defined(MLAS_TARGET_AMD64)
+        GetMlasPlatform().ConvertHalfToFloatKernel(Source, Destination, Count);
+#else
+        MlasConvertHalfToFloatKernel(Source, Destination, Count);
+#endif
+    } else {
+        for (size_t i = 0; i < Count; i++) {
+            Destination[i] = MLAS_HALF_CONVERTER<Type>::ToFloat(Source[i]);
+        }
+    }
+}
+
+template<MLAS_HALF_GEMM_TYPE Type>
+MLAS_FORCEINLINE
+void
+MlasConvertFloatToHalfRange(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    if (Type == MlasHalfGemmFloat16) {
+#if defined(MLAS_TARGET_AMD64)
+        GetMlasPlatform().ConvertFloatToHalfKernel(Source, Destination, Count);
+#else
+        MlasConvertFloatToHalfKernel(Source, Destination, Count);
+#endif
+    } else {
+        for (size_t i = 0; i < Count; i++) {
+            Destination[i] = MLAS_HALF_CONVERTER<Type>::FromFloat(Source[i]);
+        }
+    }
+}
+
+template<typename Routine>
+void
+MlasConvertHalfThreaded(
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool,
+    Routine ConvertRange
+    )
+{
+    const size_t BlockCount = MlasDivRoundup(Count, MLAS_HALF_CONVERT_BLOCK_SIZE);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Count / MLAS_HALF_CONVERT_THREAD_COMPLEXITY) + 1;
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > BlockCount) {
+        TargetThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t BlockIndex;
+        size_t BlockRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, BlockCount, &BlockIndex, &BlockRemaining);
+
+        const size_t Begin = BlockIndex * MLAS_HALF_CONVERT_BLOCK_SIZE;
+        const size_t End = std::min(Count, (BlockIndex + BlockRemaining) * MLAS_HALF_CONVERT_BLOCK_SIZE);
+
+        ConvertRange(Begin, End - Begin);
+    });
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    MLAS_HALF_GEMM_TYPE Type,
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (Count == 0) {
+        return;
+    }
+
+    MlasConvertHalfThreaded(Count, ThreadPool, [=](size_t Begin, size_t CountRange) {
+        if (Type == MlasHalfGemmFloat16) {
+            MlasConvertHalfToFloatRange<MlasHalfGemmFloat16>(Source + Begin, Destination + Begin, CountRange);
+        } else {
+            MlasConvertHalfToFloatRange<MlasHalfGemmBFloat16>(Source + Begin, Destination + Begin, CountRange);
+        }
+    });
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    MLAS_HALF_GEMM_TYPE Type,
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (Count == 0) {
+        return;
+    }
+
+    MlasConvertHalfThreaded(Count, ThreadPool, [=](size_t Begin, size_t CountRange) {
+        if (Type == MlasHalfGemmFloat16) {
+            MlasConvertFloatToHalfRange<MlasHalfGemmFloat16>(Source + Begin, Destination + Begin, CountRange);
+        } else {
+            MlasConvertFloatToHalfRange<MlasHalfGemmBFloat16>(Source + Begin, Destination + Begin, CountRange);
+        }
+    });
+}
+
+template<MLAS_HALF_GEMM_TYPE Type>
+void
+MlasHalfGemmConvertMatrix(
+    const uint16_t* Source,
+    size_t ldsource,
+    bool Transpose,
+    size_t Rows,
+    size_t Columns,
+    float* Destination
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of a half precision matrix to a row major
+    block of single precision values with a leading dimension of Columns.
+
+Arguments:
+
+    Source - Supplies the address of the first element of the block.
+
+    ldsource - Supplies the first dimension of the source matrix.
+
+    Transpose - Supplies true if the source is stored transposed, that is
+        element (r, c) is at Source[c * ldsource + r].
+
+    Rows - Supplies the number of rows of the block.
+
+    Columns - Supplies the number of columns of the block.
+
+    Destination - Supplies the address of the single precision block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t r = 0; r < Rows; r++) {
+        if (Transpose) {
+            for (size_t c = 0; c < Columns; c++) {
+                Destination[c] = MLAS_HALF_CONVERTER<Type>::ToFloat(Source[c * ldsource + r]);
+            }
+        } else {
+            MlasConvertHalfToFloatRange<Type>(Source + r * ldsource, Destination, Columns);
+        }
+        Destination += Columns;
+    }
+}
+
+template<MLAS_HALF_GEMM_TYPE Type>
+void
+MlasHalfGemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of at most MLAS_HALF_GEMM_STRIDEM rows and
+    MLAS_HALF_GEMM_STRIDEN columns of the output matrix. The block of columns
+    starts at a panel of the packed matrix B, if B is packed.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies the matrices data parameters.
+
+    RangeStartM - Supplies the starting row index of the output matrix.
+
+    RangeCountM - Supplies the number of rows of the output matrix.
+
+    RangeStartN - Supplies the starting column index of the output matrix.
+
+    RangeCountN - Supplies the number of columns of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelA[MLAS_HALF_GEMM_STRIDEM * MLAS_HALF_GEMM_STRIDEK], 16 * sizeof(float));
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_HALF_GEMM_STRIDEK * MLAS_HALF_GEMM_STRIDEN], 16 * sizeof(float));
+    MLAS_DECLSPEC_ALIGN(float PanelC[MLAS_HALF_GEMM_STRIDEM * MLAS_HALF_GEMM_STRIDEN], 16 * sizeof(float));
+
+    uint16_t* C = Data->C + RangeStartM * Data->ldc + RangeStartN;
+
+    if (Data->beta == 0.0f) {
+        std::fill_n(PanelC, RangeCountM * RangeCountN, 0.0f);
+    } else {
+        MlasHalfGemmConvertMatrix<Type>(C, Data->ldc, false, RangeCountM, RangeCountN, PanelC);
+        for (size_t i = 0; i < RangeCountM * RangeCountN; i++) {
+            PanelC[i] *= Data->beta;
+        }
+    }
+
+    for (size_t k = 0; k < K; k += MLAS_HALF_GEMM_STRIDEK) {
+
+        const size_t CountK = std::min(K - k, MLAS_HALF_GEMM_STRIDEK);
+
+        if (TransA == CblasNoTrans) {
+            MlasHalfGemmConvertMatrix<Type>(Data->A + RangeStartM * Data->lda + k, Data->lda, false,
+                                            RangeCountM, CountK, PanelA);
+        } else {
+            MlasHalfGemmConvertMatrix<Type>(Data->A + k * Data->lda + RangeStartM, Data->lda, true,
+                                            RangeCountM, CountK, PanelA);
+        }
+
+        const uint16_t* B = static_cast<const uint16_t*>(Data->B);
+
+        if (Data->BIsPacked) {
+            MlasHalfGemmConvertMatrix<Type>(B + RangeStartN * K + k * RangeCountN, RangeCountN, false,
+                                            CountK, RangeCountN, PanelB);
+        } else if (TransB == CblasNoTrans) {
+            MlasHalfGemmConvertMatrix<Type>(B + k * Data->ldb + RangeStartN, Data->ldb, false,
+                                            CountK, RangeCountN, PanelB);
+        } else {
+            MlasHalfGemmConvertMatrix<Type>(B + RangeStartN * Data->ldb + k, Data->ldb, true,
+                                            CountK, RangeCountN, PanelB);
+        }
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, RangeCountM, RangeCountN, CountK, Data->alpha,
+                 PanelA, CountK, PanelB, RangeCountN, 1.0f, PanelC, RangeCountN, nullptr);
+    }
+
+    const float* c = PanelC;
+
+    for (size_t m = 0; m < RangeCountM; m++) {
+        MlasConvertFloatToHalfRange<Type>(c, C, RangeCountN);
+        C += Data->ldc;
+        c += RangeCountN;
+    }
+}
+
+template<MLAS_HALF_GEMM_TYPE Type>
+void
+MlasHalfGemmThreaded(
+    void* Context,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    half precision GEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_HALF_GEMM_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the blocks of rows of all batches, then
+    // along the panels of columns.
+    //
+
+    const size_t BlockCountM = MlasDivRoundup(WorkBlock->M, MLAS_HALF_GEMM_STRIDEM);
+    const size_t BlockCountN = MlasDivRoundup(WorkBlock->N, MLAS_HALF_GEMM_STRIDEN);
+    const size_t WorkCount = WorkBlock->BatchSize * BlockCountM * BlockCountN;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(ThreadId, WorkBlock->ThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t BlockN = WorkIndex % BlockCountN;
+        const size_t BlockM = (WorkIndex / BlockCountN) % BlockCountM;
+        const size_t Batch = WorkIndex / (BlockCountN * BlockCountM);
+
+        const size_t RangeStartM = BlockM * MLAS_HALF_GEMM_STRIDEM;
+        const size_t RangeStartN = BlockN * MLAS_HALF_GEMM_STRIDEN;
+
+        MlasHalfGemmOperation<Type>(WorkBlock->TransA, WorkBlock->TransB, WorkBlock->K,
+                                    &WorkBlock->Data[Batch], RangeStartM,
+                                    std::min(WorkBlock->M - RangeStartM, MLAS_HALF_GEMM_STRIDEM), RangeStartN,
+                                    std::min(WorkBlock->N - RangeStartN, MLAS_HALF_GEMM_STRIDEN));
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MLASCALL
+MlasHalfGemmBatch(
+    MLAS_HALF_GEMM_TYPE Type,
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    const size_t WorkCount = BatchSize * MlasDivRoundup(M, MLAS_HALF_GEMM_STRIDEM) *
+                             MlasDivRoundup(N, MLAS_HALF_GEMM_STRIDEN);
+
+    if (size_t(TargetThreadCount) > WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    MLAS_HALF_GEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.Data = Data;
+    WorkBlock.BatchSize = BatchSize;
+    WorkBlock.ThreadCount = TargetThreadCount;
+
+    if (Type == MlasHalfGemmFloat16) {
+        MlasExecuteThreaded(MlasHalfGemmThreaded<MlasHalfGemmFloat16>, &WorkBlock, TargetThreadCount, ThreadPool);
+    } else {
+        MlasExecuteThreaded(MlasHalfGemmThreaded<MlasHalfGemmBFloat16>, &WorkBlock, TargetThreadCount, ThreadPool);
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    //
+    // The panels are not padded, so the packed matrix has exactly the
+    // elements of matrix B. Align the size to the preferred buffer alignment
+    // like the other packed matrices.
+    //
+
+    const size_t BytesRequired = N * K * sizeof(uint16_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired = (BytesRequired + BufferAlignment - 1) &
+        ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasHalfGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const uint16_t* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the destination buffer. The
+    destination buffer should be sized based on MlasHalfGemmPackBSize(). The
+    layout is shared by float16 and bfloat16, as the values are only moved.
+
+    The packed matrix is a sequence of panels of MLAS_HALF_GEMM_STRIDEN
+    columns, each stored as K rows of the columns of the panel.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    uint16_t* D = static_cast<uint16_t*>(PackedB);
+
+    for (size_t n = 0; n < N; n += MLAS_HALF_GEMM_STRIDEN) {
+
+        const size_t CountN = std::min(N - n, MLAS_HALF_GEMM_STRIDEN);
+
+        for (size_t k = 0; k < K; k++) {
+            if (TransB == CblasNoTrans) {
+                std::copy_n(B + k * ldb + n, CountN, D);
+            } else {
+                for (size_t nn = 0; nn < CountN; nn++) {
+                    D[nn] = B[(n + nn) * ldb + k];
+                }
+            }
+            D += CountN;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cvtfp16_avx2.cpp
+
+Abstract:
+
+    This module implements the conversions between half precision and single
+    precision floating point values with the F16C instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernelF16C(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m128i HalfVector0 = _mm_loadu_si128((const __m128i*)&Source[0]);
+        __m128i HalfVector1 = _mm_loadu_si128((const __m128i*)&Source[8]);
+
+        _mm256_storeu_ps(&Destination[0], _mm256_cvtph_ps(HalfVector0));
+        _mm256_storeu_ps(&Destination[8], _mm256_cvtph_ps(HalfVector1));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        __m128i HalfVector = _mm_loadu_si128((const __m128i*)Source);
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(HalfVector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+
+        uint16_t HalfBuffer[8] = { 0 };
+        float FloatBuffer[8];
+
+        std::copy_n(Source, Count, HalfBuffer);
+        _mm256_storeu_ps(FloatBuffer, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)HalfBuffer)));
+        std::copy_n(FloatBuffer, Count, Destination);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernelF16C(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m256 FloatVector0 = _mm256_loadu_ps(&Source[0]);
+        __m256 FloatVector1 = _mm256_loadu_ps(&Source[8]);
+
+        _mm_storeu_si128((__m128i*)&Destination[0], _mm256_cvtps_ph(FloatVector0, _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128((__m128i*)&Destination[8], _mm256_cvtps_ph(FloatVector1, _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        __m256 FloatVector = _mm256_loadu_ps(Source);
+        _mm_storeu_si128((__m128i*)Destination, _mm256_cvtps_ph(FloatVector, _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+
+        float FloatBuffer[8] = { 0 };
+        uint16_t HalfBuffer[8];
+
+        std::copy_n(Source, Count, FloatBuffer);
+        _mm_storeu_si128((__m128i*)HalfBuffer, _mm256_cvtps_ph(_mm256_loadu_ps(FloatBuffer), _MM_FROUND_TO_NEAREST_INT));
+        std::copy_n(HalfBuffer, Count, Destination);
+    }
+}
@@ -0,0 +1,583 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements the layer normalization of the rows of a matrix,
+    with the optional residual and bias additions of the skip variant fused
+    into the pass that computes the statistics of the row, and the group
+    normalization of images in the channels first or channels last layouts.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements to process per thread.
+//
+
+constexpr size_t MLAS_LAYER_NORM_THREAD_COMPLEXITY = 16 * 1024;
+
+template<bool HasSkip, bool HasBias>
+float
+MlasLayerNormSumRow(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* SumSquare
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the skip and bias values to a row of input values and
+    accumulates the sum and the sum of squares of the shifted results.
+
+    The values are shifted by an element of the row so that the variance is
+    computed from values centered close to the mean, which avoids the loss of
+    precision of the sum of squares when the mean is large compared to the
+    standard deviation, while keeping a single pass over the row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Supplies the skip row, used if HasSkip.
+
+    Bias - Supplies the bias vector, used if HasBias.
+
+    Output - Supplies the output row that receives the sums of the input,
+        skip and bias values, used if HasSkip or HasBias.
+
+    N - Supplies the number of elements of the row.
+
+    Shift - Supplies the value subtracted from the values before they are
+        accumulated.
+
+    SumSquare - Receives the sum of squares of the shifted values.
+
+Return Value:
+
+    Returns the sum of the shifted values.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    MLAS_FLOAT32X4 Sum0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Sum1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquare0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquare1 = MlasZeroFloat32x4();
+
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+
+        MLAS_FLOAT32X4 v0 = MlasLoadFloat32x4(Input + n);
+        MLAS_FLOAT32X4 v1 = MlasLoadFloat32x4(Input + n + 4);
+
+        if (HasSkip) {
+            v0 = MlasAddFloat32x4(v0, MlasLoadFloat32x4(Skip + n));
+            v1 = MlasAddFloat32x4(v1, MlasLoadFloat32x4(Skip + n + 4));
+        }
+
+        if (HasBias) {
+            v0 = MlasAddFloat32x4(v0, MlasLoadFloat32x4(Bias + n));
+            v1 = MlasAddFloat32x4(v1, MlasLoadFloat32x4(Bias + n + 4));
+        }
+
+        if (HasSkip || HasBias) {
+            MlasStoreFloat32x4(Output + n, v0);
+            MlasStoreFloat32x4(Output + n + 4, v1);
+        }
+
+        v0 = MlasSubtractFloat32x4(v0, ShiftVector);
+        v1 = MlasSubtractFloat32x4(v1, ShiftVector);
+
+        Sum0 = MlasAddFloat32x4(Sum0, v0);
+        Sum1 = MlasAddFloat32x4(Sum1, v1);
+        SumSquare0 = MlasMultiplyAddFloat32x4(v0, v0, SumSquare0);
+        SumSquare1 = MlasMultiplyAddFloat32x4(v1, v1, SumSquare1);
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(Sum0, Sum1));
+    float SumSquareValue = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquare0, SumSquare1));
+
+    for (; n < N; n++) {
+
+        float Value = Input[n];
+
+        if (HasSkip) {
+            Value += Skip[n];
+        }
+
+        if (HasBias) {
+            Value += Bias[n];
+        }
+
+        if (HasSkip || HasBias) {
+            Output[n] = Value;
+        }
+
+        Value -= Shift;
+
+        Sum += Value;
+        SumSquareValue += Value * Value;
+    }
+
+    *SumSquare = SumSquareValue;
+
+    return Sum;
+}
+
+template<bool HasShift>
+void
+MlasLayerNormScaleRow(
+    const float* Input,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InverseStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a row of values with the statistics of the row
+    and applies the scale and shift vectors.
+
+Arguments:
+
+    Input - Supplies the row of values, which may be the same as Output.
+
+    Scale - Supplies the scale vector.
+
+    Shift - Supplies the shift vector, used if HasShift.
+
+    Output - Supplies the output row.
+
+    N - Supplies the number of elements of the row.
+
+    Mean - Supplies the mean of the row.
+
+    InverseStdDev - Supplies the inverse of the standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    const MLAS_FLOAT32X4 InverseStdDevVector = MlasBroadcastFloat32x4(InverseStdDev);
+
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+
+        MLAS_FLOAT32X4 v = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n), MeanVector);
+        v = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(v, InverseStdDevVector), MlasLoadFloat32x4(Scale + n));
+
+        if (HasShift) {
+            v = MlasAddFloat32x4(v, MlasLoadFloat32x4(Shift + n));
+        }
+
+        MlasStoreFloat32x4(Output + n, v);
+    }
+
+    for (; n < N; n++) {
+
+        float Value = (Input[n] - Mean) * InverseStdDev * Scale[n];
+
+        if (HasShift) {
+            Value += Shift[n];
+        }
+
+        Output[n] = Value;
+    }
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* Mean,
+    float* InverseStdDev,
+    size_t RowCount,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes the rows of a matrix, see the declaration in
+    mlas.h for the description of the arguments.
+
+--*/
+{
+    if (RowCount == 0 || N == 0) {
+        return;
+    }
+
+    const size_t ThreadCountRows = (RowCount * N) / MLAS_LAYER_NORM_THREAD_COMPLEXITY;
+    const ptrdiff_t TargetThreadCount = ptrdiff_t(std::max<size_t>(std::min(ThreadCountRows, RowCount), 1));
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+
+        size_t RowIndex;
+        size_t RowsThisThread;
+
+        MlasPartitionWork(tid, TargetThreadCount, RowCount, &RowIndex, &RowsThisThread);
+
+        for (size_t row = RowIndex; row < RowIndex + RowsThisThread; row++) {
+
+            const float* InputRow = Input + row * N;
+            const float* SkipRow = Skip != nullptr ? Skip + row * N : nullptr;
+            float* OutputRow = Output + row * N;
+
+            //
+            // The simplified normalization uses the root mean square of the
+            // values, which are not centered.
+            //
+
+            const float ShiftValue = Simplified ? 0.0f : InputRow[0] + (SkipRow != nullptr ? SkipRow[0] : 0.0f) +
+                                                         (Bias != nullptr ? Bias[0] : 0.0f);
+
+            float SumSquare;
+            float Sum;
+
+            if (SkipRow != nullptr) {
+                Sum = (Bias != nullptr)
+                          ? MlasLayerNormSumRow<true, true>(InputRow, SkipRow, Bias, OutputRow, N, ShiftValue, &SumSquare)
+                          : MlasLayerNormSumRow<true, false>(InputRow, SkipRow, Bias, OutputRow, N, ShiftValue, &SumSquare);
+            } else {
+                Sum = (Bias != nullptr)
+                          ? MlasLayerNormSumRow<false, true>(InputRow, SkipRow, Bias, OutputRow, N, ShiftValue, &SumSquare)
+                          : MlasLayerNormSumRow<false, false>(InputRow, SkipRow, Bias, OutputRow, N, ShiftValue, &SumSquare);
+            }
+
+            //
+            // The sums of the input, skip and bias values are in the output
+            // if any were added.
+            //
+
+            const float* ValueRow = (SkipRow != nullptr || Bias != nullptr) ? OutputRow : InputRow;
+
+            const float ShiftedMean = Sum / float(N);
+            const float Variance = Simplified ? SumSquare / float(N)
+                                              : std::max(SumSquare / float(N) - ShiftedMean * ShiftedMean, 0.0f);
+            const float InverseStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+            const float MeanValue = Simplified ? 0.0f : ShiftValue + ShiftedMean;
+
+            if (Simplified || Shift == nullptr) {
+                MlasLayerNormScaleRow<false>(ValueRow, Scale, nullptr, OutputRow, N, MeanValue, InverseStdDevValue);
+            } else {
+                MlasLayerNormScaleRow<true>(ValueRow, Scale, Shift, OutputRow, N, MeanValue, InverseStdDevValue);
+            }
+
+            if (Mean != nullptr) {
+                Mean[row] = MeanValue;
+            }
+
+            if (InverseStdDev != nullptr) {
+                InverseStdDev[row] = InverseStdDevValue;
+            }
+        }
+    });
+}
+
+void
+MlasGroupNormSwish(
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the swish activation x * sigmoid(x) in place.
+
+Arguments:
+
+    Output - Supplies the values to update.
+
+    N - Supplies the number of values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 64;
+    float Logistic[BlockSize];
+
+    while (N > 0) {
+
+        const size_t Count = std::min(N, BlockSize);
+
+        MlasComputeLogistic(Output, Logistic, Count);
+
+        size_t n = 0;
+
+        for (; n + 4 <= Count; n += 4) {
+            MlasStoreFloat32x4(Output + n, MlasMultiplyFloat32x4(MlasLoadFloat32x4(Output + n), MlasLoadFloat32x4(Logistic + n)));
+        }
+
+        for (; n < Count; n++) {
+            Output[n] *= Logistic[n];
+        }
+
+        Output += Count;
+        N -= Count;
+    }
+}
+
+void
+MlasGroupNormAffine(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    float Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = Input * Scale + Shift for a channel of a
+    channels first image.
+
+Arguments:
+
+    Input - Supplies the input values.
+
+    Output - Supplies the output values, which may be the same as Input.
+
+    N - Supplies the number of values.
+
+    Scale - Supplies the scale of the channel.
+
+    Shift - Supplies the shift of the channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    const MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input + n), ScaleVector, ShiftVector);
+        MLAS_FLOAT32X4 Vector1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input + n + 4), ScaleVector, ShiftVector);
+
+        MlasStoreFloat32x4(Output + n, Vector0);
+        MlasStoreFloat32x4(Output + n + 4, Vector1);
+    }
+
+    for (; n < N; n++) {
+        Output[n] = Input[n] * Scale + Shift;
+    }
+}
+
+void
+MlasGroupNormChannelsLast(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t ChannelCount,
+    size_t ImageSize,
+    size_t GroupChannels,
+    float Epsilon,
+    bool Swish
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a group of channels of a channels last image. The
+    channels of the group are GroupChannels consecutive values of each pixel.
+
+Arguments:
+
+    Input - Supplies the first channel of the group in the first pixel.
+
+    Scale - Supplies the scale vector of the channels of the group.
+
+    Bias - Supplies the bias vector of the channels of the group.
+
+    Output - Supplies the first channel of the group in the first pixel of
+        the output.
+
+    ChannelCount - Supplies the number of channels of a pixel.
+
+    ImageSize - Supplies the number of pixels.
+
+    GroupChannels - Supplies the number of channels of the group.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Swish - Supplies true to apply the swish activation to the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Accumulate the values shifted by the first value of the group, see
+    // MlasLayerNormSumRow.
+    //
+
+    const float ShiftValue = Input[0];
+
+    float Sum = 0.0f;
+    float SumSquare = 0.0f;
+
+    for (size_t i = 0; i < ImageSize; i++) {
+
+        float SumSquarePixel;
+
+        Sum += MlasLayerNormSumRow<false, false>(Input + i * ChannelCount, nullptr, nullptr, nullptr,
+            GroupChannels, ShiftValue, &SumSquarePixel);
+        SumSquare += SumSquarePixel;
+    }
+
+    const float ElementCount = float(ImageSize * GroupChannels);
+    const float ShiftedMean = Sum / ElementCount;
+    const float Variance = std::max(SumSquare / ElementCount - ShiftedMean * ShiftedMean, 0.0f);
+    const float InverseStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+    const float Mean = ShiftValue + ShiftedMean;
+
+    for (size_t i = 0; i < ImageSize; i++) {
+
+        float* OutputPixel = Output + i * ChannelCount;
+
+        MlasLayerNormScaleRow<true>(Input + i * ChannelCount, Scale, Bias, OutputPixel, GroupChannels, Mean,
+            InverseStdDev);
+
+        if (Swish) {
+            MlasGroupNormSwish(OutputPixel, GroupChannels);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasGroupNormalization(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t ImageSize,
+    size_t GroupCount,
+    float Epsilon,
+    bool ChannelsLast,
+    bool Swish,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes the groups of channels of a batch of images, see
+    the declaration in mlas.h for the description of the arguments.
+
+--*/
+{
+    const size_t GroupChannels = ChannelCount / GroupCount;
+    const size_t GroupSize = GroupChannels * ImageSize;
+    const size_t BatchGroupCount = BatchCount * GroupCount;
+
+    if (BatchGroupCount == 0 || GroupSize == 0) {
+        return;
+    }
+
+    const size_t ThreadCountGroups = (BatchGroupCount * GroupSize) / MLAS_LAYER_NORM_THREAD_COMPLEXITY;
+    const ptrdiff_t TargetThreadCount = ptrdiff_t(std::max<size_t>(std::min(ThreadCountGroups, BatchGroupCount), 1));
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+
+        size_t GroupIndex;
+        size_t GroupsThisThread;
+
+        MlasPartitionWork(tid, TargetThreadCount, BatchGroupCount, &GroupIndex, &GroupsThisThread);
+
+        for (size_t bg = GroupIndex; bg < GroupIndex + GroupsThisThread; bg++) {
+
+            const size_t batch = bg / GroupCount;
+            const size_t FirstChannel = (bg % GroupCount) * GroupChannels;
+
+            if (ChannelsLast) {
+
+                const size_t Offset = batch * ImageSize * ChannelCount + FirstChannel;
+
+                MlasGroupNormChannelsLast(Input + Offset, Scale + FirstChannel, Bias + FirstChannel,
+                    Output + Offset, ChannelCount, ImageSize, GroupChannels, Epsilon, Swish);
+
+                continue;
+            }
+
+            //
+            // The channels of the group are contiguous in the channels first
+            // layout, so the statistics are those of a single row.
+            //
+
+            const float* InputGroup = Input + bg * GroupSize;
+            float* OutputGroup = Output + bg * GroupSize;
+
+            const float ShiftValue = InputGroup[0];
+
+            float SumSquare;
+            const float Sum = MlasLayerNormSumRow<false, false>(InputGroup, nullptr, nullptr, nullptr, GroupSize,
+                ShiftValue, &SumSquare);
+
+            const float ShiftedMean = Sum / float(GroupSize);
+            const float Variance = std::max(SumSquare / float(GroupSize) - ShiftedMean * ShiftedMean, 0.0f);
+            const float InverseStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+            const float Mean = ShiftValue + ShiftedMean;
+
+            for (size_t c = 0; c < GroupChannels; c++) {
+
+                const float ChannelScale = Scale[FirstChannel + c] * InverseStdDev;
+                const float ChannelShift = Bias[FirstChannel + c] - Mean * ChannelScale;
+
+                MlasGroupNormAffine(InputGroup + c * ImageSize, OutputGroup + c * ImageSize, ImageSize,
+                    ChannelScale, ChannelShift);
+
+                if (Swish) {
+                    MlasGroupNormSwish(OutputGroup + c * ImageSize, ImageSize);
+                }
+            }
+        }
+    });
+}
@@ -24,6 +24,11 @@ Abstract:
 #include <sys/auxv.h>
 #endif
 
+#if defined(MLAS_AMX_SUPPORTED) && defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #if defined(MLAS_TARGET_ARM64)
 #if defined(_WIN32)
 // N.B. Support building with downlevel versions of the Windows SDK.
@@ -38,6 +43,9 @@ Abstract:
 #ifndef HWCAP_ASIMDDP
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
+#ifndef HWCAP2_I8MM
+#define HWCAP2_I8MM (1 << 13)
+#endif
 
 #if defined(BUILD_MLAS_NO_ONNXRUNTIME)
 MLASCPUIDInfo::MLASCPUIDInfo() { has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0); }
@@ -103,6 +111,110 @@ MlasReadExtendedControlRegister(
 #endif
 }
 
+#if defined(MLAS_AMX_SUPPORTED)
+
+//
+// Requests permission from the operating system to use the AMX tile data
+// state, which is disabled by default for each process on Linux.
+//
+
+#define MLAS_ARCH_REQ_XCOMP_PERM 0x1023
+#define MLAS_XFEATURE_XTILEDATA 18
+
+inline
+bool
+MlasAmxRequestPermission(
+    void
+    )
+{
+#if defined(__linux__)
+    return syscall(SYS_arch_prctl, MLAS_ARCH_REQ_XCOMP_PERM, MLAS_XFEATURE_XTILEDATA) == 0;
+#else
+    return false;
+#endif
+}
+
+#endif // MLAS_AMX_SUPPORTED
+
+//
+// Instruction set levels that the MLAS_MAXIMUM_ISA environment variable can
+// cap the kernel selection to, so that the kernels of an older processor can
+// be benchmarked or tested on a newer one.
+//
+
+enum MLAS_ISA_LEVEL {
+    MlasIsaSse2,
+    MlasIsaAvx,
+    MlasIsaAvx2,
+    MlasIsaAvxVnni,
+    MlasIsaAvx512F,
+    MlasIsaAvx512Core,
+    MlasIsaAvx512Vnni,
+    MlasIsaAmx,
+};
+
+static
+MLAS_ISA_LEVEL
+MlasGetMaximumIsaLevel(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine reads the MLAS_MAXIMUM_ISA environment variable, one of
+    "sse2", "avx", "avx2", "avxvnni", "avx512f", "avx512core", "avx512vnni"
+    or "amx".
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the highest instruction set level that kernels may be selected
+    for, MlasIsaAmx if the variable is not set or not recognized.
+
+--*/
+{
+    char Value[16];
+
+#if defined(_WIN32)
+    DWORD Length = GetEnvironmentVariableA("MLAS_MAXIMUM_ISA", Value, sizeof(Value));
+    if (Length == 0 || Length >= sizeof(Value)) {
+        return MlasIsaAmx;
+    }
+#else
+    const char* Variable = getenv("MLAS_MAXIMUM_ISA");
+    if (Variable == nullptr || strlen(Variable) >= sizeof(Value)) {
+        return MlasIsaAmx;
+    }
+    strcpy(Value, Variable);
+#endif
+
+    static const struct {
+        const char* Name;
+        MLAS_ISA_LEVEL Level;
+    } IsaLevels[] = {
+        { "sse2", MlasIsaSse2 },
+        { "avx", MlasIsaAvx },
+        { "avx2", MlasIsaAvx2 },
+        { "avxvnni", MlasIsaAvxVnni },
+        { "avx512f", MlasIsaAvx512F },
+        { "avx512core", MlasIsaAvx512Core },
+        { "avx512vnni", MlasIsaAvx512Vnni },
+        { "amx", MlasIsaAmx },
+    };
+
+    for (const auto& IsaLevel : IsaLevels) {
+        if (strcmp(Value, IsaLevel.Name) == 0) {
+            return IsaLevel.Level;
+        }
+    }
+
+    return MlasIsaAmx;
+}
+
 #endif
 
 MLAS_PLATFORM::MLAS_PLATFORM(
@@ -125,6 +237,8 @@ Return Value:
 --*/
 {
 
+    this->PackedBufferFormat = "default";
+
     this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernel<uint8_t, int8_t>;
     this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t, uint8_t>;
     this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernel<int8_t, int8_t>;
@@ -139,6 +253,7 @@ Return Value:
     this->GemmFloatKernel = MlasGemmFloatKernelSse;
     this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchSse;
     this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchSse;
+    this->PackedBufferFormat = "x86-sse2";
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -160,6 +275,8 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -172,6 +289,8 @@ Return Value:
 
 #endif
 
+    const MLAS_ISA_LEVEL MaximumIsaLevel = MlasGetMaximumIsaLevel();
+
     unsigned Cpuid1[4];
 #if defined(_WIN32)
     __cpuid((int*)Cpuid1, 1);
@@ -187,6 +306,7 @@ Return Value:
 
     if ((Cpuid1[2] & 0x80000) != 0) {
         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchSse41;
+        this->PackedBufferFormat = "x86-sse41";
     }
 
 #endif
@@ -195,7 +315,7 @@ Return Value:
     // Check if the processor supports the AVX and OSXSAVE features.
     //
 
-    if ((Cpuid1[2] & 0x18000000) == 0x18000000) {
+    if ((Cpuid1[2] & 0x18000000) == 0x18000000 && MaximumIsaLevel >= MlasIsaAvx) {
 
         //
         // Check if the operating system supports saving SSE and AVX states.
@@ -206,6 +326,7 @@ Return Value:
         if ((xcr0 & 0x6) == 0x6) {
 
             this->GemmFloatKernel = MlasGemmFloatKernelAvx;
+            this->PackedBufferFormat = "x86-avx";
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -236,9 +357,10 @@ Return Value:
             __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
 #endif
 
-            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
+            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0) && MaximumIsaLevel >= MlasIsaAvx2) {
 
                 this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
+                this->PackedBufferFormat = "x86-avx2";
                 this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx2;
                 this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx2;
                 this->GemmU8U8Dispatch = &MlasGemmU8U8DispatchAvx2;
@@ -263,6 +385,16 @@ Return Value:
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
 
+                //
+                // Check if the processor supports the F16C half precision
+                // conversion instructions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernelF16C;
+                    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernelF16C;
+                }
+
                 //
                 // Check if the processor supports Hybrid core architecture.
                 //
@@ -282,9 +414,10 @@ Return Value:
                 __cpuid_count(7, 1, Cpuid7_1[0], Cpuid7_1[1], Cpuid7_1[2], Cpuid7_1[3]);
 #endif
 
-                if ((Cpuid7_1[0] & 0x10) != 0) {
+                if ((Cpuid7_1[0] & 0x10) != 0 && MaximumIsaLevel >= MlasIsaAvxVnni) {
 
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
+                    this->PackedBufferFormat = "x86-avxvnni";
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
                     this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvxVnni;
@@ -297,9 +430,10 @@ Return Value:
                 // operating system supports saving AVX512F state.
                 //
 
-                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0) && MaximumIsaLevel >= MlasIsaAvx512F) {
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
+                    this->PackedBufferFormat = "x86-avx512f";
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
                     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelAvx512F;
                     this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelAvx512F;
@@ -320,9 +454,10 @@ Return Value:
                     // (AVX512BW/AVX512DQ/AVX512VL).
                     //
 
-                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000) {
+                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000 && MaximumIsaLevel >= MlasIsaAvx512Core) {
 
                         this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
+                        this->PackedBufferFormat = "x86-avx512core";
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
                         this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
                         this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Core;
@@ -331,12 +466,33 @@ Return Value:
                         // Check if the processor supports AVX512VNNI.
                         //
 
-                        if ((Cpuid7[2] & 0x800) != 0) {
+                        if ((Cpuid7[2] & 0x800) != 0 && MaximumIsaLevel >= MlasIsaAvx512Vnni) {
 
                             this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
+                            this->PackedBufferFormat = "x86-avx512vnni";
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
+
+#if defined(MLAS_AMX_SUPPORTED)
+
+                            //
+                            // Check if the processor supports AMX-TILE and
+                            // AMX-INT8 and the operating system supports
+                            // saving the tile state.
+                            //
+
+                            if (((Cpuid7[3] & 0x3000000) == 0x3000000) &&
+                                ((xcr0 & 0x60000) == 0x60000) &&
+                                MaximumIsaLevel >= MlasIsaAmx &&
+                                MlasAmxRequestPermission()) {
+
+                                this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                                this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchAmx;
+                                this->PackedBufferFormat = "x86-amx";
+                            }
+
+#endif // MLAS_AMX_SUPPORTED
                         }
                     }
                 }
@@ -355,6 +511,7 @@ Return Value:
 #if defined(MLAS_TARGET_ARM64)
 
     this->GemmU8X8Dispatch = &MlasGemmU8X8DispatchNeon;
+    this->PackedBufferFormat = "arm64-neon";
     this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchNeon;
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
@@ -375,15 +532,30 @@ Return Value:
 
     if (HasDotProductInstructions) {
         this->GemmU8X8Dispatch = &MlasGemmU8X8DispatchUdot;
+        this->PackedBufferFormat = "arm64-dot";
         this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchSdot;
         this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchDot;
         this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchDot;
     }
 
+    //
+    // Check if the processor supports the int8 matrix multiply instructions,
+    // which do twice the work of the dot product instructions for QGEMM. The
+    // symmetric QGEMM and the convolutions keep using the dot product kernels.
+    //
+
+#if defined(MLAS_I8MM_SUPPORTED) && defined(__linux__)
+    if (HasDotProductInstructions && (getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0) {
+        this->GemmU8X8Dispatch = &MlasGemmU8X8DispatchUmmla;
+        this->PackedBufferFormat = "arm64-i8mm";
+    }
+#endif
+
 #endif // MLAS_TARGET_ARM64
 #if defined(MLAS_TARGET_POWER)
     this->GemmFloatKernel = MlasSgemmKernel;
     this->GemmDoubleKernel = MlasDgemmKernel;
+    this->PackedBufferFormat = "power";
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8Kernel;
 
@@ -404,6 +576,7 @@ Return Value:
         this->GemmFloatKernel = MlasSgemmKernelPOWER10;
         this->GemmDoubleKernel = MlasDgemmKernelPOWER10;
         this->GemmU8X8Dispatch = &MlasGemm8X8DispatchPOWER10;
+        this->PackedBufferFormat = "power10";
     }
 #endif
 #endif
@@ -450,3 +623,31 @@ Return Value:
     return MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
 #endif
 }
+
+const char*
+MLASCALL
+MlasGetPackedBufferFormat(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns an identifier of the layout of the buffers packed by
+    this library on this platform, e.g. by MlasGemmPackB, MlasSymmQgemmPackB
+    or MlasConvSymPackW. The layout depends on the kernels that are selected
+    for the processor, so buffers packed under another identifier, e.g. on
+    another processor, must be packed again.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the identifier of the layout of packed buffers.
+
+--*/
+{
+    return GetMlasPlatform().PackedBufferFormat;
+}
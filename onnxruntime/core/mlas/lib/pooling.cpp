@@ -605,6 +605,9 @@ Return Value:
 #if defined(MLAS_SSE2_INTRINSICS)
                     Reduction = _mm_shuffle_ps(Reduction, Reduction, _MM_SHUFFLE(2, 0, 2, 0));
                     MlasStoreLowHalfFloat32x4(Output, Reduction);
+#elif defined(MLAS_WASM_SIMD_INTRINSICS)
+                    Reduction = wasm_i32x4_shuffle(Reduction, Reduction, 0, 2, 0, 2);
+                    MlasStoreLowHalfFloat32x4(Output, Reduction);
 #else
                     MlasStoreLaneFloat32x4<0>(Output, Reduction);
                     MlasStoreLaneFloat32x4<2>(Output + 1, Reduction);
@@ -975,6 +978,9 @@ Return Value:
 #if defined(MLAS_SSE2_INTRINSICS)
                         Reduction = _mm_shuffle_ps(Reduction, Reduction, _MM_SHUFFLE(2, 0, 2, 0));
                         MlasStoreLowHalfFloat32x4(Output, Reduction);
+#elif defined(MLAS_WASM_SIMD_INTRINSICS)
+                        Reduction = wasm_i32x4_shuffle(Reduction, Reduction, 0, 2, 0, 2);
+                        MlasStoreLowHalfFloat32x4(Output, Reduction);
 #else
                         MlasStoreLaneFloat32x4<0>(Output, Reduction);
                         MlasStoreLaneFloat32x4<2>(Output + 1, Reduction);
@@ -1538,6 +1544,81 @@ Return Value:
             c -= 8;
         }
 
+#elif defined(MLAS_WASM_SIMD_INTRINSICS)
+
+        const v128_t LowestVector = wasm_i8x16_splat(int8_t(std::numeric_limits<T8Bits>::lowest()));
+
+        while (c >= 32) {
+
+            v128_t MaximumVector0 = LowestVector;
+            v128_t MaximumVector1 = LowestVector;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                v128_t InputVector0 = wasm_v128_load(&Input[k][ChannelOffset]);
+                v128_t InputVector1 = wasm_v128_load(&Input[k][ChannelOffset + 16]);
+
+                if constexpr (std::is_signed<T8Bits>::value) {
+                    MaximumVector0 = wasm_i8x16_max(MaximumVector0, InputVector0);
+                    MaximumVector1 = wasm_i8x16_max(MaximumVector1, InputVector1);
+                } else {
+                    MaximumVector0 = wasm_u8x16_max(MaximumVector0, InputVector0);
+                    MaximumVector1 = wasm_u8x16_max(MaximumVector1, InputVector1);
+                }
+            }
+
+            wasm_v128_store(&Output[0], MaximumVector0);
+            wasm_v128_store(&Output[16], MaximumVector1);
+            Output += 32;
+
+            ChannelOffset += 32;
+            c -= 32;
+        }
+
+        while (c >= 16) {
+
+            v128_t MaximumVector0 = LowestVector;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                v128_t InputVector0 = wasm_v128_load(&Input[k][ChannelOffset]);
+
+                if constexpr (std::is_signed<T8Bits>::value) {
+                    MaximumVector0 = wasm_i8x16_max(MaximumVector0, InputVector0);
+                } else {
+                    MaximumVector0 = wasm_u8x16_max(MaximumVector0, InputVector0);
+                }
+            }
+
+            wasm_v128_store(&Output[0], MaximumVector0);
+            Output += 16;
+
+            ChannelOffset += 16;
+            c -= 16;
+        }
+
+        if (c >= 8) {
+
+            v128_t MaximumVector0 = LowestVector;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                v128_t InputVector0 = wasm_v128_load64_zero(&Input[k][ChannelOffset]);
+
+                if constexpr (std::is_signed<T8Bits>::value) {
+                    MaximumVector0 = wasm_i8x16_max(MaximumVector0, InputVector0);
+                } else {
+                    MaximumVector0 = wasm_u8x16_max(MaximumVector0, InputVector0);
+                }
+            }
+
+            wasm_v128_store64_lane(&Output[0], MaximumVector0, 0);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
 #endif
 
         while (c > 0) {
@@ -1580,3 +1661,107 @@ MlasMaximumPool<uint8_t>(
     size_t OutputCount,
     size_t KernelSize
     );
+
+template<>
+void
+MLASCALL
+MlasMaximumPool<float>(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the maximum pooling operation for single precision
+    floating point tensors in channels last format.
+
+    The input is supplied as an indirection buffer in the same layout as the
+    8-bit variant above.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (OutputCount > 0) {
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 8) {
+
+            MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+                MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(&Input[k][ChannelOffset + 4]);
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, InputVector0);
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, InputVector1);
+            }
+
+            MlasStoreFloat32x4(&Output[0], MaximumVector0);
+            MlasStoreFloat32x4(&Output[4], MaximumVector1);
+            Output += 8;
+
+            ChannelOffset += 8;
+            c -= 8;
+        }
+
+        if (c >= 4) {
+
+            MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][ChannelOffset]);
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, InputVector0);
+            }
+
+            MlasStoreFloat32x4(&Output[0], MaximumVector0);
+            Output += 4;
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float MaximumValue = std::numeric_limits<float>::lowest();
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                MaximumValue = std::max(MaximumValue, Input[k][ChannelOffset]);
+            }
+
+            *Output++ = MaximumValue;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
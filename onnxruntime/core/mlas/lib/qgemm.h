@@ -830,11 +830,17 @@ MlasGemmQuantGetDispatch(
         else {
             GemmQuantDispatch = GetMlasPlatform().GemmU8U8Dispatch;
         }
+    } else if (BIsSigned && GetMlasPlatform().GemmS8S8Dispatch != nullptr) {
+        GemmQuantDispatch = GetMlasPlatform().GemmS8S8Dispatch;
     }
 #elif defined(MLAS_TARGET_ARM64)
     if(BIsSigned) {
         if(GetMlasPlatform().GemmU8X8Dispatch == &MlasGemmU8X8DispatchNeon) {
             GemmQuantDispatch = &MlasGemmX8S8DispatchNeon;
+#if defined(MLAS_I8MM_SUPPORTED)
+        } else if(GetMlasPlatform().GemmU8X8Dispatch == &MlasGemmU8X8DispatchUmmla) {
+            GemmQuantDispatch = AIsSigned? &MlasGemmS8S8DispatchSmmla : &MlasGemmU8X8DispatchUmmla;
+#endif
         } else {
             GemmQuantDispatch = AIsSigned? &MlasGemmS8S8DispatchSdot : &MlasGemmU8X8DispatchUdot;
         }
@@ -0,0 +1,563 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements QGEMM kernels for AMX-INT8.
+
+    The kernels use the tile registers as 2x2 blocks of 16x16 int32 output
+    tiles. Matrix A is packed as rows of 64 byte blocks along K, which are
+    loaded as 16x64 byte tiles. Matrix B is packed in groups of 16 columns,
+    with each 64 byte block along K stored as 16 rows of 4 bytes of the 16
+    columns, which is the layout expected by the TDPB*D instructions.
+
+--*/
+
+#include "mlasi.h"
+#include "qgemm.h"
+
+#include <immintrin.h>
+
+//
+// Define the tile configuration loaded by LDTILECFG.
+//
+
+struct MLAS_AMX_TILE_CONFIG {
+    uint8_t PaletteId;
+    uint8_t StartRow;
+    uint8_t Reserved[14];
+    uint16_t ColumnBytes[16];
+    uint8_t Rows[16];
+};
+
+constexpr size_t MLAS_AMX_TILE_ROWS = 16;
+constexpr size_t MLAS_AMX_TILE_COLUMN_BYTES = 64;
+constexpr size_t MLAS_AMX_TILE_COLUMNS = MLAS_AMX_TILE_COLUMN_BYTES / sizeof(int32_t);
+
+//
+// Size in bytes of a block of packed matrix B: one tile of 16 columns and 64
+// values along K.
+//
+
+constexpr size_t MLAS_AMX_PACKED_B_BLOCK_SIZE = MLAS_AMX_TILE_ROWS * MLAS_AMX_TILE_COLUMN_BYTES;
+
+template<bool AIsSigned>
+struct MLAS_GEMM_X8S8_KERNEL_AMX
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef typename std::conditional<AIsSigned, int8_t, uint8_t>::type OffsetAType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = MLAS_AMX_TILE_COLUMN_BYTES;
+    static constexpr MLAS_GEMM_QUANT_STRIDES Strides{ 32, 128, 256 };
+    static constexpr MLAS_GEMM_QUANT_STRIDES PackedStrides{ 32, 256, 1024 };
+};
+
+template<bool AIsSigned>
+constexpr size_t MLAS_GEMM_X8S8_KERNEL_AMX<AIsSigned>::PackedK;
+template<bool AIsSigned>
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_X8S8_KERNEL_AMX<AIsSigned>::Strides;
+template<bool AIsSigned>
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_X8S8_KERNEL_AMX<AIsSigned>::PackedStrides;
+
+typedef MLAS_GEMM_X8S8_KERNEL_AMX<false> MLAS_GEMM_U8S8_KERNEL_AMX;
+typedef MLAS_GEMM_X8S8_KERNEL_AMX<true> MLAS_GEMM_S8S8_KERNEL_AMX;
+
+template<>
+MLAS_FORCEINLINE constexpr
+int32_t
+MlasGemmQuantFixupZeroPointB<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    if (!BIsSigned) {
+        ZeroPointB = MLAS_GEMM_U8S8_KERNEL_AMX::OffsetBType(ZeroPointB ^ 0x80);
+    }
+
+    return ZeroPointB;
+}
+
+template<>
+MLAS_FORCEINLINE constexpr
+int32_t
+MlasGemmQuantFixupZeroPointB<MLAS_GEMM_S8S8_KERNEL_AMX>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    if (!BIsSigned) {
+        ZeroPointB = MLAS_GEMM_S8S8_KERNEL_AMX::OffsetBType(ZeroPointB ^ 0x80);
+    }
+
+    return ZeroPointB;
+}
+
+template<bool AIsSigned>
+void
+MlasGemmX8S8CopyPackAAmx(
+    uint8_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine copies rows of matrix A to the packed buffer, padding each
+    row with zeros to a multiple of 64 bytes, and computes the sums of the
+    rows.
+
+--*/
+{
+    const size_t AlignedCountK = (CountK + MLAS_AMX_TILE_COLUMN_BYTES - 1) & ~(MLAS_AMX_TILE_COLUMN_BYTES - 1);
+
+    while (CountM-- > 0) {
+
+        int32_t RowSum = 0;
+
+        for (size_t k = 0; k < CountK; k++) {
+            D[k] = A[k];
+            RowSum += AIsSigned ? int32_t(int8_t(A[k])) : int32_t(A[k]);
+        }
+
+        std::fill(D + CountK, D + AlignedCountK, uint8_t(0));
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
+
+void
+MlasGemmX8S8CopyPackBAmx(
+    uint8_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine copies columns of matrix B to the packed buffer in groups of
+    16 columns and computes the sums of the columns. The groups are padded
+    with zero columns and zero rows.
+
+--*/
+{
+    const size_t AlignedCountK = (CountK + MLAS_AMX_TILE_COLUMN_BYTES - 1) & ~(MLAS_AMX_TILE_COLUMN_BYTES - 1);
+    const uint8_t BitFlipValue = (BIsSigned ? 0 : 0x80);
+
+    for (size_t n = 0; n < CountN; n += MLAS_AMX_TILE_COLUMNS) {
+
+        const size_t CountColumns = std::min(CountN - n, MLAS_AMX_TILE_COLUMNS);
+
+        for (size_t nn = 0; nn < MLAS_AMX_TILE_COLUMNS; nn++) {
+
+            int32_t ColumnSum = 0;
+
+            for (size_t k = 0; k < AlignedCountK; k++) {
+
+                //
+                // Element (k, nn) of the group is at row k / 4, column nn and
+                // byte k % 4 of the blocks of 16x64 bytes.
+                //
+
+                uint8_t b = 0;
+
+                if (nn < CountColumns && k < CountK) {
+                    b = B[k * ldb + n + nn] ^ BitFlipValue;
+                    ColumnSum += int32_t(int8_t(b));
+                }
+
+                D[(k / 4) * MLAS_AMX_TILE_COLUMN_BYTES + nn * 4 + (k % 4)] = b;
+            }
+
+            if (nn < CountColumns) {
+                *ColumnSumBuffer++ = ColumnSum;
+            }
+        }
+
+        D += MLAS_AMX_TILE_COLUMNS * AlignedCountK;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmQuantCopyPackA<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(AIsSigned);
+    MlasGemmX8S8CopyPackAAmx<false>(D, A, lda, CountM, CountK, RowSumBuffer);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmQuantCopyPackA<MLAS_GEMM_S8S8_KERNEL_AMX>(
+    MLAS_GEMM_S8S8_KERNEL_AMX::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(AIsSigned);
+    MlasGemmX8S8CopyPackAAmx<true>(D, A, lda, CountM, CountK, RowSumBuffer);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmQuantCopyPackB<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MlasGemmX8S8CopyPackBAmx(D, B, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_AMX>(
+    MLAS_GEMM_S8S8_KERNEL_AMX::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MlasGemmX8S8CopyPackBAmx(D, B, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned);
+}
+
+//
+// The tile register numbers below are immediates of the instructions:
+//
+//     tmm0-tmm3: 2x2 blocks of 16x16 int32 output
+//     tmm4-tmm5: 2 blocks of 16 rows of matrix A
+//     tmm6-tmm7: 2 blocks of 16 columns of matrix B
+//
+
+template<bool AIsSigned, bool TwoRowBlocks, bool TwoColumnBlocks>
+MLAS_FORCEINLINE
+void
+MlasGemmX8S8KernelAmxBlock(
+    const uint8_t* A,
+    size_t lda,
+    const uint8_t* B,
+    size_t ldbgroup,
+    size_t PackedCountK
+    )
+{
+    _tile_zero(0);
+    if (TwoColumnBlocks) {
+        _tile_zero(1);
+    }
+    if (TwoRowBlocks) {
+        _tile_zero(2);
+        if (TwoColumnBlocks) {
+            _tile_zero(3);
+        }
+    }
+
+    for (size_t k = 0; k < PackedCountK; k++) {
+
+        _tile_loadd(4, A, int(lda));
+        _tile_loadd(6, B, int(MLAS_AMX_TILE_COLUMN_BYTES));
+
+        if (AIsSigned) {
+            _tile_dpbssd(0, 4, 6);
+        } else {
+            _tile_dpbusd(0, 4, 6);
+        }
+
+        if (TwoColumnBlocks) {
+            _tile_loadd(7, B + ldbgroup, int(MLAS_AMX_TILE_COLUMN_BYTES));
+            if (AIsSigned) {
+                _tile_dpbssd(1, 4, 7);
+            } else {
+                _tile_dpbusd(1, 4, 7);
+            }
+        }
+
+        if (TwoRowBlocks) {
+            _tile_loadd(5, A + MLAS_AMX_TILE_ROWS * lda, int(lda));
+            if (AIsSigned) {
+                _tile_dpbssd(2, 5, 6);
+            } else {
+                _tile_dpbusd(2, 5, 6);
+            }
+            if (TwoColumnBlocks) {
+                if (AIsSigned) {
+                    _tile_dpbssd(3, 5, 7);
+                } else {
+                    _tile_dpbusd(3, 5, 7);
+                }
+            }
+        }
+
+        A += MLAS_AMX_TILE_COLUMN_BYTES;
+        B += MLAS_AMX_PACKED_B_BLOCK_SIZE;
+    }
+}
+
+template<bool AIsSigned>
+size_t
+MlasGemmX8S8KernelAmx(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for up to
+    32 rows of the output matrix.
+
+Arguments:
+
+    A - Supplies the address of matrix A. The matrix data has been packed
+        using MlasGemmX8S8CopyPackAAmx.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasGemmX8S8CopyPackBAmx.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed blocks of 64 columns of
+        matrix A and rows of matrix B.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    RowSumBuffer - Supplies the sum of each row from matrix A. These values
+        have been pre-scaled by the zero point offset of matrix B if the offset
+        is per-tensor (ZeroPointB is nullptr). Otherwise, these values must be
+        scaled by the per-column zero point offsets of matrix B. These values
+        are accumulated into every row of matrix C.
+
+    ColumnSumBuffer - Supplies the sum of each column from matrix B multiplied
+        by the zero point offset of matrix A. These values are accumulated into
+        every column of matrix C.
+
+    ZeroPointB - Optionally supplies the per-column zero point offsets of
+        matrix B, else nullptr if the matrix B is using per-tensor quantization.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    constexpr size_t MaximumRows = 2 * MLAS_AMX_TILE_ROWS;
+    constexpr size_t MaximumColumns = 2 * MLAS_AMX_TILE_COLUMNS;
+    constexpr size_t MaximumPackedCountK =
+        MLAS_GEMM_X8S8_KERNEL_AMX<AIsSigned>::PackedStrides.K / MLAS_AMX_TILE_COLUMN_BYTES;
+
+    MLAS_DECLSPEC_ALIGN(int32_t Accumulators[MaximumRows * MaximumColumns], 64);
+
+    const size_t lda = PackedCountK * MLAS_AMX_TILE_COLUMN_BYTES;
+    const size_t ldbgroup = PackedCountK * MLAS_AMX_PACKED_B_BLOCK_SIZE;
+    const size_t RowsHandled = std::min(CountM, MaximumRows);
+
+    //
+    // Tiles always load 16 rows of matrix A, so a partial block of rows is
+    // copied to a zero padded buffer to stay within the packed buffer.
+    //
+
+    MLAS_DECLSPEC_ALIGN(uint8_t PaddedA[MaximumRows * MaximumPackedCountK * MLAS_AMX_TILE_COLUMN_BYTES], 64);
+
+    const size_t RowBlocks = (RowsHandled + MLAS_AMX_TILE_ROWS - 1) / MLAS_AMX_TILE_ROWS;
+
+    if (RowsHandled < RowBlocks * MLAS_AMX_TILE_ROWS) {
+        std::copy_n(A, RowsHandled * lda, PaddedA);
+        std::fill_n(PaddedA + RowsHandled * lda, (RowBlocks * MLAS_AMX_TILE_ROWS - RowsHandled) * lda, uint8_t(0));
+        A = PaddedA;
+    }
+
+    MLAS_DECLSPEC_ALIGN(MLAS_AMX_TILE_CONFIG TileConfig, 64) = {};
+
+    TileConfig.PaletteId = 1;
+    for (int t = 0; t < 8; t++) {
+        TileConfig.Rows[t] = uint8_t(MLAS_AMX_TILE_ROWS);
+        TileConfig.ColumnBytes[t] = uint16_t(MLAS_AMX_TILE_COLUMN_BYTES);
+    }
+
+    _tile_loadconfig(&TileConfig);
+
+    for (size_t n = 0; n < CountN; n += MaximumColumns) {
+
+        const size_t CountColumns = std::min(CountN - n, MaximumColumns);
+        const bool TwoColumnBlocks = CountColumns > MLAS_AMX_TILE_COLUMNS;
+
+        const uint8_t* b = B + (n / MLAS_AMX_TILE_COLUMNS) * ldbgroup;
+
+        if (RowBlocks == 2) {
+            if (TwoColumnBlocks) {
+                MlasGemmX8S8KernelAmxBlock<AIsSigned, true, true>(A, lda, b, ldbgroup, PackedCountK);
+            } else {
+                MlasGemmX8S8KernelAmxBlock<AIsSigned, true, false>(A, lda, b, ldbgroup, PackedCountK);
+            }
+        } else {
+            if (TwoColumnBlocks) {
+                MlasGemmX8S8KernelAmxBlock<AIsSigned, false, true>(A, lda, b, ldbgroup, PackedCountK);
+            } else {
+                MlasGemmX8S8KernelAmxBlock<AIsSigned, false, false>(A, lda, b, ldbgroup, PackedCountK);
+            }
+        }
+
+        constexpr int StrideAccumulators = int(MaximumColumns * sizeof(int32_t));
+
+        _tile_stored(0, Accumulators, StrideAccumulators);
+        if (TwoColumnBlocks) {
+            _tile_stored(1, Accumulators + MLAS_AMX_TILE_COLUMNS, StrideAccumulators);
+        }
+        if (RowBlocks == 2) {
+            _tile_stored(2, Accumulators + MLAS_AMX_TILE_ROWS * MaximumColumns, StrideAccumulators);
+            if (TwoColumnBlocks) {
+                _tile_stored(3, Accumulators + MLAS_AMX_TILE_ROWS * MaximumColumns + MLAS_AMX_TILE_COLUMNS,
+                             StrideAccumulators);
+            }
+        }
+
+        //
+        // Apply the row and column sums and store the block of matrix C.
+        //
+
+        for (size_t m = 0; m < RowsHandled; m++) {
+
+            const int32_t* acc = Accumulators + m * MaximumColumns;
+            int32_t* c = C + m * ldc + n;
+
+            for (size_t nn = 0; nn < CountColumns; nn++) {
+
+                int32_t RowSum = RowSumBuffer[m];
+
+                if (ZeroPointB != nullptr) {
+                    RowSum *= ZeroPointB[n + nn];
+                }
+
+                int32_t Value = acc[nn] + RowSum + ColumnSumBuffer[n + nn];
+
+                if (!ZeroMode) {
+                    Value += c[nn];
+                }
+
+                c[nn] = Value;
+            }
+        }
+    }
+
+    _tile_release();
+
+    return RowsHandled;
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmQuantKernel<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    const MLAS_GEMM_U8S8_KERNEL_AMX::PackedAType* A,
+    const MLAS_GEMM_U8S8_KERNEL_AMX::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasGemmX8S8KernelAmx<false>(A, B, C, PackedCountK, CountM, CountN, ldc,
+                                        RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmQuantKernel<MLAS_GEMM_S8S8_KERNEL_AMX>(
+    const MLAS_GEMM_S8S8_KERNEL_AMX::PackedAType* A,
+    const MLAS_GEMM_S8S8_KERNEL_AMX::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasGemmX8S8KernelAmx<true>(A, B, C, PackedCountK, CountM, CountN, ldc,
+                                       RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchAmx = {
+    MlasGemmQuantOperation<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedK,
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedStrides.K,
+};
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchAmx = {
+    MlasGemmQuantOperation<MLAS_GEMM_S8S8_KERNEL_AMX>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_S8S8_KERNEL_AMX>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_AMX>,
+    MLAS_GEMM_S8S8_KERNEL_AMX::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_AMX::PackedStrides.K,
+};
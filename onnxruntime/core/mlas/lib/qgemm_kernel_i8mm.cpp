@@ -0,0 +1,800 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_i8mm.cpp
+
+Abstract:
+
+    This module implements the QGEMM kernels using the ARMv8.6 int8 matrix
+    multiply instructions (UMMLA/SMMLA).
+
+    Each instruction multiplies a 2x8 block of matrix A with an 8x2 block of
+    matrix B and accumulates the 2x2 block of results, so it does twice the
+    work of the dot product instructions per instruction. Matrix A is packed
+    as pairs of rows and matrix B as pairs of columns, interleaved in blocks
+    of 8 along the K dimension.
+
+--*/
+
+#include "mlasi.h"
+#include "qgemm.h"
+
+struct MLAS_GEMM_U8X8_KERNEL_UMMLA
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef uint8_t OffsetAType;
+    typedef uint8_t OffsetBType;
+
+    static constexpr size_t PackedK = 8;
+    static constexpr MLAS_GEMM_QUANT_STRIDES Strides{ 24, 128, 256 };
+    static constexpr MLAS_GEMM_QUANT_STRIDES PackedStrides{ 24, 128, 384 };
+};
+
+constexpr size_t MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedK;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_U8X8_KERNEL_UMMLA::Strides;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedStrides;
+
+struct MLAS_GEMM_S8S8_KERNEL_SMMLA
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef int8_t OffsetAType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = 8;
+    static constexpr MLAS_GEMM_QUANT_STRIDES Strides{ 24, 128, 256 };
+    static constexpr MLAS_GEMM_QUANT_STRIDES PackedStrides{ 24, 128, 384 };
+};
+
+constexpr size_t MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedK;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_S8S8_KERNEL_SMMLA::Strides;
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedStrides;
+
+//
+// Number of rows of matrix A processed by one invocation of the kernel. The
+// kernel keeps a 4x8 block of the output in eight 2x2 accumulators.
+//
+
+constexpr size_t MLAS_GEMM_I8MM_KERNEL_STRIDEM = 4;
+
+template<bool IsSigned>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmI8MMSumBytes(
+    uint8x8_t Bytes
+    );
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmI8MMSumBytes<true>(
+    uint8x8_t Bytes
+    )
+{
+    return int32_t(vaddlv_s8(vreinterpret_s8_u8(Bytes)));
+}
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmI8MMSumBytes<false>(
+    uint8x8_t Bytes
+    )
+{
+    return int32_t(vaddlv_u8(Bytes));
+}
+
+template<bool IsSigned>
+MLAS_FORCEINLINE
+int32x4_t
+MlasGemmI8MMPairwiseSum(
+    uint8x16_t Bytes
+    );
+
+template<>
+MLAS_FORCEINLINE
+int32x4_t
+MlasGemmI8MMPairwiseSum<true>(
+    uint8x16_t Bytes
+    )
+{
+    return vpaddlq_s16(vpaddlq_s8(vreinterpretq_s8_u8(Bytes)));
+}
+
+template<>
+MLAS_FORCEINLINE
+int32x4_t
+MlasGemmI8MMPairwiseSum<false>(
+    uint8x16_t Bytes
+    )
+{
+    return vreinterpretq_s32_u32(vpaddlq_u16(vpaddlq_u8(Bytes)));
+}
+
+template<bool IsSigned>
+MLAS_FORCEINLINE
+int32x4_t
+MlasGemmI8MMMultiplyAccumulate(
+    int32x4_t Accumulator,
+    uint8x16_t ABlock,
+    uint8x16_t BBlock
+    );
+
+template<>
+MLAS_FORCEINLINE
+int32x4_t
+MlasGemmI8MMMultiplyAccumulate<true>(
+    int32x4_t Accumulator,
+    uint8x16_t ABlock,
+    uint8x16_t BBlock
+    )
+{
+    return vmmlaq_s32(Accumulator, vreinterpretq_s8_u8(ABlock), vreinterpretq_s8_u8(BBlock));
+}
+
+template<>
+MLAS_FORCEINLINE
+int32x4_t
+MlasGemmI8MMMultiplyAccumulate<false>(
+    int32x4_t Accumulator,
+    uint8x16_t ABlock,
+    uint8x16_t BBlock
+    )
+{
+    return vreinterpretq_s32_u32(vmmlaq_u32(vreinterpretq_u32_s32(Accumulator), ABlock, BBlock));
+}
+
+MLAS_FORCEINLINE
+uint8x8_t
+MlasGemmI8MMLoadRowA(
+    const uint8_t* A,
+    size_t CountK
+    )
+{
+    if (CountK >= 8) {
+        return vld1_u8(A);
+    }
+
+    uint8_t PaddedMatrixAData[8] = { 0 };
+    std::copy_n(A, CountK, PaddedMatrixAData);
+    return vld1_u8(PaddedMatrixAData);
+}
+
+template<bool AIsSigned>
+void
+MlasGemmI8MMCopyPackA(
+    uint8_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer.
+
+    The rows are packed in pairs. For each block of 8 columns, the 8 bytes of
+    the first row of the pair are followed by the 8 bytes of the second row,
+    which is the 2x8 layout of the first operand of UMMLA/SMMLA. An odd row
+    is paired with a row of zeros and the columns are zero padded to a
+    multiple of PackedK.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+    RowSumBuffer - Supplies the address of the buffer to receive the sums of
+        the elements along each of the rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const uint8x8_t ZeroVector = vmov_n_u8(0);
+
+    for (size_t m = 0; m < CountM; m += 2) {
+
+        const bool HasSecondRow = (m + 1 < CountM);
+        const uint8_t* a0 = A + m * lda;
+        const uint8_t* a1 = a0 + lda;
+
+        int32_t RowSum0 = 0;
+        int32_t RowSum1 = 0;
+
+        for (size_t k = 0; k < CountK; k += 8) {
+
+            uint8x8_t Row0 = MlasGemmI8MMLoadRowA(a0 + k, CountK - k);
+            uint8x8_t Row1 = HasSecondRow ? MlasGemmI8MMLoadRowA(a1 + k, CountK - k) : ZeroVector;
+
+            RowSum0 += MlasGemmI8MMSumBytes<AIsSigned>(Row0);
+            RowSum1 += MlasGemmI8MMSumBytes<AIsSigned>(Row1);
+
+            vst1q_u8(D, vcombine_u8(Row0, Row1));
+            D += 16;
+        }
+
+        RowSumBuffer[m] = RowSum0;
+
+        if (HasSecondRow) {
+            RowSumBuffer[m + 1] = RowSum1;
+        }
+    }
+}
+
+template<bool BIsSigned>
+void
+MlasGemmI8MMCopyPackB(
+    uint8_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    uint8_t BitFlip
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer.
+
+    The columns are packed in blocks of 8. For each block of 8 rows, the
+    block stores the 8 bytes of each column in order, so that each pair of
+    columns is the 8x2 layout of the second operand of UMMLA/SMMLA. The
+    columns and the rows are zero padded to a multiple of 8 and PackedK.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    ColumnSumBuffer - Supplies the address of the buffer to receive the sums
+        of the elements along each of the columns.
+
+    BitFlip - Supplies the value to exclusive or with each element to change
+        its signedness to the format of the kernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const uint8x8_t BitFlipVector = vdup_n_u8(BitFlip);
+    const uint8x8_t ZeroVector = vmov_n_u8(0);
+
+    while (CountN > 0) {
+
+        const size_t CountNBlock = std::min(CountN, size_t{8});
+
+        int32x4_t ColumnSums[4];
+        ColumnSums[0] = vmovq_n_s32(0);
+        ColumnSums[1] = vmovq_n_s32(0);
+        ColumnSums[2] = vmovq_n_s32(0);
+        ColumnSums[3] = vmovq_n_s32(0);
+
+        const uint8_t* b = B;
+
+        for (size_t k = 0; k < CountK; k += 8) {
+
+            const size_t CountKBlock = std::min(CountK - k, size_t{8});
+
+            //
+            // Load the 8x8 block of the source matrix, zero padding the
+            // missing rows and columns.
+            //
+
+            uint8x8_t Rows[8];
+
+            if (CountNBlock == 8) {
+
+                for (size_t kk = 0; kk < 8; kk++) {
+                    Rows[kk] = (kk < CountKBlock) ?
+                        veor_u8(vld1_u8(&b[ldb * kk]), BitFlipVector) : ZeroVector;
+                }
+
+            } else {
+
+                uint8_t PaddedMatrixBData[64] = { 0 };
+
+                for (size_t kk = 0; kk < CountKBlock; kk++) {
+                    for (size_t nn = 0; nn < CountNBlock; nn++) {
+                        PaddedMatrixBData[kk * 8 + nn] = uint8_t(b[ldb * kk + nn] ^ BitFlip);
+                    }
+                }
+
+                for (size_t kk = 0; kk < 8; kk++) {
+                    Rows[kk] = vld1_u8(&PaddedMatrixBData[kk * 8]);
+                }
+            }
+
+            //
+            // Transpose the block so that each vector holds 8 rows of a column.
+            //
+
+            uint8x8_t t0 = vtrn1_u8(Rows[0], Rows[1]);
+            uint8x8_t t1 = vtrn2_u8(Rows[0], Rows[1]);
+            uint8x8_t t2 = vtrn1_u8(Rows[2], Rows[3]);
+            uint8x8_t t3 = vtrn2_u8(Rows[2], Rows[3]);
+            uint8x8_t t4 = vtrn1_u8(Rows[4], Rows[5]);
+            uint8x8_t t5 = vtrn2_u8(Rows[4], Rows[5]);
+            uint8x8_t t6 = vtrn1_u8(Rows[6], Rows[7]);
+            uint8x8_t t7 = vtrn2_u8(Rows[6], Rows[7]);
+
+            uint16x4_t u0 = vtrn1_u16(vreinterpret_u16_u8(t0), vreinterpret_u16_u8(t2));
+            uint16x4_t u1 = vtrn1_u16(vreinterpret_u16_u8(t1), vreinterpret_u16_u8(t3));
+            uint16x4_t u2 = vtrn2_u16(vreinterpret_u16_u8(t0), vreinterpret_u16_u8(t2));
+            uint16x4_t u3 = vtrn2_u16(vreinterpret_u16_u8(t1), vreinterpret_u16_u8(t3));
+            uint16x4_t u4 = vtrn1_u16(vreinterpret_u16_u8(t4), vreinterpret_u16_u8(t6));
+            uint16x4_t u5 = vtrn1_u16(vreinterpret_u16_u8(t5), vreinterpret_u16_u8(t7));
+            uint16x4_t u6 = vtrn2_u16(vreinterpret_u16_u8(t4), vreinterpret_u16_u8(t6));
+            uint16x4_t u7 = vtrn2_u16(vreinterpret_u16_u8(t5), vreinterpret_u16_u8(t7));
+
+            uint32x2_t c0 = vtrn1_u32(vreinterpret_u32_u16(u0), vreinterpret_u32_u16(u4));
+            uint32x2_t c1 = vtrn1_u32(vreinterpret_u32_u16(u1), vreinterpret_u32_u16(u5));
+            uint32x2_t c2 = vtrn1_u32(vreinterpret_u32_u16(u2), vreinterpret_u32_u16(u6));
+            uint32x2_t c3 = vtrn1_u32(vreinterpret_u32_u16(u3), vreinterpret_u32_u16(u7));
+            uint32x2_t c4 = vtrn2_u32(vreinterpret_u32_u16(u0), vreinterpret_u32_u16(u4));
+            uint32x2_t c5 = vtrn2_u32(vreinterpret_u32_u16(u1), vreinterpret_u32_u16(u5));
+            uint32x2_t c6 = vtrn2_u32(vreinterpret_u32_u16(u2), vreinterpret_u32_u16(u6));
+            uint32x2_t c7 = vtrn2_u32(vreinterpret_u32_u16(u3), vreinterpret_u32_u16(u7));
+
+            uint8x16_t Columns01 = vreinterpretq_u8_u32(vcombine_u32(c0, c1));
+            uint8x16_t Columns23 = vreinterpretq_u8_u32(vcombine_u32(c2, c3));
+            uint8x16_t Columns45 = vreinterpretq_u8_u32(vcombine_u32(c4, c5));
+            uint8x16_t Columns67 = vreinterpretq_u8_u32(vcombine_u32(c6, c7));
+
+            vst1q_u8(&D[0], Columns01);
+            vst1q_u8(&D[16], Columns23);
+            vst1q_u8(&D[32], Columns45);
+            vst1q_u8(&D[48], Columns67);
+
+            ColumnSums[0] = vaddq_s32(ColumnSums[0], MlasGemmI8MMPairwiseSum<BIsSigned>(Columns01));
+            ColumnSums[1] = vaddq_s32(ColumnSums[1], MlasGemmI8MMPairwiseSum<BIsSigned>(Columns23));
+            ColumnSums[2] = vaddq_s32(ColumnSums[2], MlasGemmI8MMPairwiseSum<BIsSigned>(Columns45));
+            ColumnSums[3] = vaddq_s32(ColumnSums[3], MlasGemmI8MMPairwiseSum<BIsSigned>(Columns67));
+
+            D += 64;
+            b += ldb * 8;
+        }
+
+        //
+        // Each vector holds two partial sums per column, reduce them to the
+        // sums of the 8 columns.
+        //
+
+        int32x4_t ColumnSums0123 = vpaddq_s32(ColumnSums[0], ColumnSums[1]);
+        int32x4_t ColumnSums4567 = vpaddq_s32(ColumnSums[2], ColumnSums[3]);
+
+        if (CountNBlock == 8) {
+
+            vst1q_s32(&ColumnSumBuffer[0], ColumnSums0123);
+            vst1q_s32(&ColumnSumBuffer[4], ColumnSums4567);
+
+        } else {
+
+            int32_t PaddedColumnSums[8];
+            vst1q_s32(&PaddedColumnSums[0], ColumnSums0123);
+            vst1q_s32(&PaddedColumnSums[4], ColumnSums4567);
+            std::copy_n(PaddedColumnSums, CountNBlock, ColumnSumBuffer);
+        }
+
+        B += CountNBlock;
+        CountN -= CountNBlock;
+        ColumnSumBuffer += 8;
+    }
+}
+
+template<bool IsSigned, size_t PairCount>
+MLAS_FORCEINLINE
+void
+MlasGemmI8MMComputeBlock(
+    const uint8_t* A,
+    const uint8_t* B,
+    size_t PackedCountK,
+    int32x4_t Accumulators[2][4]
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies one or two pairs of rows of the packed matrix A
+    with a block of 8 columns of the packed matrix B.
+
+    Accumulators[p][q] receives the 2x2 block of the rows of pair p and the
+    columns of pair q, laid out as {r0c0, r0c1, r1c0, r1c1}.
+
+--*/
+{
+    for (size_t p = 0; p < PairCount; p++) {
+        for (size_t q = 0; q < 4; q++) {
+            Accumulators[p][q] = vmovq_n_s32(0);
+        }
+    }
+
+    const uint8_t* a = A;
+    const size_t StrideAPair = PackedCountK * 16;
+
+    for (size_t k = 0; k < PackedCountK; k++) {
+
+        uint8x16_t BBlocks[4];
+        BBlocks[0] = vld1q_u8(&B[0]);
+        BBlocks[1] = vld1q_u8(&B[16]);
+        BBlocks[2] = vld1q_u8(&B[32]);
+        BBlocks[3] = vld1q_u8(&B[48]);
+
+        for (size_t p = 0; p < PairCount; p++) {
+
+            uint8x16_t ABlock = vld1q_u8(&a[StrideAPair * p]);
+
+            for (size_t q = 0; q < 4; q++) {
+                Accumulators[p][q] = MlasGemmI8MMMultiplyAccumulate<IsSigned>(Accumulators[p][q], ABlock, BBlocks[q]);
+            }
+        }
+
+        a += 16;
+        B += 64;
+    }
+}
+
+template<bool IsSigned>
+size_t
+MlasGemmI8MMKernel(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A. The matrix data has been packed
+        using MlasGemmI8MMCopyPackA.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasGemmI8MMCopyPackB.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns from matrix A and
+        the number of packed rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    RowSumBuffer - Supplies the sum of each row from matrix A. These values
+        have been pre-scaled by the zero point offset of matrix B if the offset
+        is per-tensor (ZeroPointB is nullptr). Otherwise, these values must be
+        scaled by the per-column zero point offsets of matrix B.
+
+    ColumnSumBuffer - Supplies the sum of each column from matrix B multiplied
+        by the zero point offset of matrix A.
+
+    ZeroPointB - Optionally supplies the per-column zero point offsets of
+        matrix B, else nullptr if the matrix B is using per-tensor quantization.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t RowsHandled = std::min(CountM, MLAS_GEMM_I8MM_KERNEL_STRIDEM);
+
+    while (CountN > 0) {
+
+        int32x4_t Accumulators[2][4];
+
+        if (RowsHandled > 2) {
+            MlasGemmI8MMComputeBlock<IsSigned, 2>(A, B, PackedCountK, Accumulators);
+        } else {
+            MlasGemmI8MMComputeBlock<IsSigned, 1>(A, B, PackedCountK, Accumulators);
+        }
+
+        B += PackedCountK * 64;
+
+        //
+        // Rearrange the 2x2 blocks to rows of 8 columns and add the row and
+        // column sums.
+        //
+
+        int32x4_t ColumnSums0 = vld1q_s32(&ColumnSumBuffer[0]);
+        int32x4_t ColumnSums1 = vld1q_s32(&ColumnSumBuffer[4]);
+
+        int32x4_t ZeroPointB0 = vmovq_n_s32(0);
+        int32x4_t ZeroPointB1 = vmovq_n_s32(0);
+
+        if (ZeroPointB != nullptr) {
+            ZeroPointB0 = vld1q_s32(&ZeroPointB[0]);
+            ZeroPointB1 = vld1q_s32(&ZeroPointB[4]);
+        }
+
+        int32x4_t Rows[MLAS_GEMM_I8MM_KERNEL_STRIDEM][2];
+
+        for (size_t r = 0; r < RowsHandled; r++) {
+
+            const int32x4_t* Pair = Accumulators[r / 2];
+            int64x2_t Columns0 = vreinterpretq_s64_s32(Pair[0]);
+            int64x2_t Columns1 = vreinterpretq_s64_s32(Pair[1]);
+            int64x2_t Columns2 = vreinterpretq_s64_s32(Pair[2]);
+            int64x2_t Columns3 = vreinterpretq_s64_s32(Pair[3]);
+
+            if ((r & 1) == 0) {
+                Rows[r][0] = vreinterpretq_s32_s64(vtrn1q_s64(Columns0, Columns1));
+                Rows[r][1] = vreinterpretq_s32_s64(vtrn1q_s64(Columns2, Columns3));
+            } else {
+                Rows[r][0] = vreinterpretq_s32_s64(vtrn2q_s64(Columns0, Columns1));
+                Rows[r][1] = vreinterpretq_s32_s64(vtrn2q_s64(Columns2, Columns3));
+            }
+
+            if (ZeroPointB != nullptr) {
+                Rows[r][0] = vaddq_s32(Rows[r][0], vmlaq_n_s32(ColumnSums0, ZeroPointB0, RowSumBuffer[r]));
+                Rows[r][1] = vaddq_s32(Rows[r][1], vmlaq_n_s32(ColumnSums1, ZeroPointB1, RowSumBuffer[r]));
+            } else {
+                int32x4_t RowSums = vdupq_n_s32(RowSumBuffer[r]);
+                Rows[r][0] = vaddq_s32(Rows[r][0], vaddq_s32(ColumnSums0, RowSums));
+                Rows[r][1] = vaddq_s32(Rows[r][1], vaddq_s32(ColumnSums1, RowSums));
+            }
+        }
+
+        //
+        // Output the accumulator block after optionally accumulating the values
+        // from matrix C.
+        //
+
+        if (CountN >= 8) {
+
+            for (size_t r = 0; r < RowsHandled; r++) {
+
+                int32_t* c = C + ldc * r;
+
+                if (!ZeroMode) {
+                    Rows[r][0] = vaddq_s32(Rows[r][0], vld1q_s32(&c[0]));
+                    Rows[r][1] = vaddq_s32(Rows[r][1], vld1q_s32(&c[4]));
+                }
+
+                vst1q_s32(&c[0], Rows[r][0]);
+                vst1q_s32(&c[4], Rows[r][1]);
+            }
+
+            C += 8;
+            CountN -= 8;
+
+        } else {
+
+            //
+            // Output the remaining partial output block.
+            //
+
+            for (size_t r = 0; r < RowsHandled; r++) {
+
+                int32_t* c = C + ldc * r;
+                int32_t Row[8];
+
+                vst1q_s32(&Row[0], Rows[r][0]);
+                vst1q_s32(&Row[4], Rows[r][1]);
+
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = ZeroMode ? Row[n] : c[n] + Row[n];
+                }
+            }
+
+            CountN = 0;
+        }
+
+        ColumnSumBuffer += 8;
+
+        if (ZeroPointB != nullptr) {
+            ZeroPointB += 8;
+        }
+    }
+
+    return RowsHandled;
+}
+
+//
+// U8X8 kernel: both matrices are unsigned, a signed matrix B is converted by
+// flipping the sign bit of its elements and of its zero point.
+//
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmQuantFixupZeroPointB<MLAS_GEMM_U8X8_KERNEL_UMMLA>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    if (BIsSigned) {
+        ZeroPointB = MLAS_GEMM_U8X8_KERNEL_UMMLA::OffsetBType(ZeroPointB ^ 0x80);
+    }
+
+    return ZeroPointB;
+}
+
+template<>
+void
+MlasGemmQuantCopyPackA<MLAS_GEMM_U8X8_KERNEL_UMMLA>(
+    MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(AIsSigned);
+    MlasGemmI8MMCopyPackA<false>(D, A, lda, CountM, CountK, RowSumBuffer);
+}
+
+template<>
+void
+MlasGemmQuantCopyPackB<MLAS_GEMM_U8X8_KERNEL_UMMLA>(
+    MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MlasGemmI8MMCopyPackB<false>(D, B, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned ? 0x80 : 0);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmQuantKernel<MLAS_GEMM_U8X8_KERNEL_UMMLA>(
+    const MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedAType* A,
+    const MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasGemmI8MMKernel<false>(A, B, C, PackedCountK, CountM, CountN, ldc,
+        RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchUmmla = {
+    MlasGemmQuantOperation<MLAS_GEMM_U8X8_KERNEL_UMMLA>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_U8X8_KERNEL_UMMLA>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_U8X8_KERNEL_UMMLA>,
+    MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedK,
+    MLAS_GEMM_U8X8_KERNEL_UMMLA::PackedStrides.K,
+};
+
+//
+// S8S8 kernel: both matrices are signed.
+//
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmQuantFixupZeroPointB<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    int32_t ZeroPointB,
+    bool BIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+    return ZeroPointB;
+}
+
+template<>
+void
+MlasGemmQuantCopyPackA<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(AIsSigned);
+    MlasGemmI8MMCopyPackA<true>(D, A, lda, CountM, CountK, RowSumBuffer);
+}
+
+template<>
+void
+MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+    MlasGemmI8MMCopyPackB<true>(D, B, ldb, CountN, CountK, ColumnSumBuffer, 0);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmQuantKernel<MLAS_GEMM_S8S8_KERNEL_SMMLA>(
+    const MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedAType* A,
+    const MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasGemmI8MMKernel<true>(A, B, C, PackedCountK, CountM, CountN, ldc,
+        RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchSmmla = {
+    MlasGemmQuantOperation<MLAS_GEMM_S8S8_KERNEL_SMMLA>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_S8S8_KERNEL_SMMLA>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_SMMLA>,
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_SMMLA::PackedStrides.K,
+};
@@ -1029,3 +1029,135 @@ Return Value:
     MlasReduceMinimumMaximumF32Kernel(Input, Min, Max, N);
 #endif
 }
+
+//
+// Number of elements to quantize per thread for MlasDynamicQuantizeLinearPerRow.
+//
+
+constexpr size_t MLAS_DYNAMIC_QUANTIZE_THREAD_COMPLEXITY = 16 * 1024;
+
+void
+MlasDynamicQuantizeLinearRow(
+    const float* Input,
+    uint8_t* Output,
+    size_t N,
+    float* Scale,
+    uint8_t* ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes a row to uint8 with the range of the row. The
+    row is quantized right after its minimum and maximum have been found,
+    while it is still in the cache.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Output - Supplies the output row.
+
+    N - Supplies the number of elements of the row.
+
+    Scale - Returns the scale of the row.
+
+    ZeroPoint - Returns the zero point of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Minimum = std::numeric_limits<float>::max();
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    MlasFindMinMaxElement(Input, &Minimum, &Maximum, N);
+
+    //
+    // The range must include zero so that zero is exactly representable.
+    //
+
+    Minimum = std::min(Minimum, 0.0f);
+    Maximum = std::max(Maximum, 0.0f);
+
+    const float RowScale = (Maximum == Minimum) ? 1.0f : (Maximum - Minimum) / 255.0f;
+    const float RowZeroPoint = std::nearbyint(std::max(0.0f, std::min(255.0f, -Minimum / RowScale)));
+
+    *Scale = RowScale;
+    *ZeroPoint = uint8_t(RowZeroPoint);
+
+    MlasQuantizeLinear(Input, Output, N, RowScale, uint8_t(RowZeroPoint));
+}
+
+void
+MLASCALL
+MlasDynamicQuantizeLinearPerRow(
+    const float* Input,
+    uint8_t* Output,
+    size_t Rows,
+    size_t Columns,
+    float* Scales,
+    uint8_t* ZeroPoints,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes each row of a matrix to uint8 with its own scale
+    and zero point, computed from the range of the row in a single pass over
+    the input.
+
+Arguments:
+
+    Input - Supplies the input matrix of Rows x Columns elements.
+
+    Output - Supplies the output matrix.
+
+    Rows - Supplies the number of rows.
+
+    Columns - Supplies the number of columns.
+
+    Scales - Returns the Rows scales.
+
+    ZeroPoints - Returns the Rows zero points.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Rows == 0 || Columns == 0) {
+        return;
+    }
+
+    const double Complexity = double(Rows) * double(Columns);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_DYNAMIC_QUANTIZE_THREAD_COMPLEXITY)) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > Rows) {
+        TargetThreadCount = ptrdiff_t(Rows);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t RowIndex;
+        size_t RowRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, Rows, &RowIndex, &RowRemaining);
+
+        for (; RowRemaining > 0; RowIndex++, RowRemaining--) {
+            MlasDynamicQuantizeLinearRow(Input + RowIndex * Columns, Output + RowIndex * Columns, Columns,
+                                         Scales + RowIndex, ZeroPoints + RowIndex);
+        }
+    });
+}
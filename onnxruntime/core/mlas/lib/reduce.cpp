@@ -0,0 +1,785 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements routines to reduce a tensor along contiguous
+    dimensions.
+
+    The tensor is viewed as [OuterCount, ReduceCount] when the innermost
+    dimensions are reduced and as [OuterCount, ReduceCount, InnerCount]
+    otherwise, which covers the reductions of the last axes, of the first
+    axes and of the middle axes of a tensor.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements to process per thread.
+//
+
+constexpr size_t MLAS_REDUCE_THREAD_COMPLEXITY = 64 * 1024;
+
+//
+// Number of columns reduced at once by the strided kernel, so that the
+// accumulators of a block stay in registers.
+//
+
+constexpr size_t MLAS_REDUCE_COLUMN_BLOCK_SIZE = 16;
+
+//
+// Maximum number of partial results when the reduced dimension is split
+// between threads: partial rows of the innermost reduction and partial
+// columns of the strided reduction.
+//
+
+constexpr size_t MLAS_REDUCE_MAXIMUM_PARTIAL_ROWS = 256;
+
+constexpr size_t MLAS_REDUCE_MAXIMUM_PARTIAL_COLUMNS = 4096;
+
+//
+// Operation functors. Apply accumulates a value, Combine merges two partial
+// results and Reduce merges the lanes of a vector of partial results.
+//
+
+struct MLAS_REDUCE_SUM_OP {
+    static constexpr float Identity() { return 0.0f; }
+    static MLAS_FORCEINLINE float Apply(float a, float x) { return a + x; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 x) { return MlasAddFloat32x4(a, x); }
+    static MLAS_FORCEINLINE float Combine(float a, float b) { return a + b; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasAddFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Reduce(MLAS_FLOAT32X4 a) { return MlasReduceAddFloat32x4(a); }
+};
+
+struct MLAS_REDUCE_SUM_SQUARE_OP {
+    static constexpr float Identity() { return 0.0f; }
+    static MLAS_FORCEINLINE float Apply(float a, float x) { return a + x * x; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 x) { return MlasMultiplyAddFloat32x4(x, x, a); }
+    static MLAS_FORCEINLINE float Combine(float a, float b) { return a + b; }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasAddFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Reduce(MLAS_FLOAT32X4 a) { return MlasReduceAddFloat32x4(a); }
+};
+
+struct MLAS_REDUCE_MAXIMUM_OP {
+    static constexpr float Identity() { return -std::numeric_limits<float>::infinity(); }
+    static MLAS_FORCEINLINE float Apply(float a, float x) { return std::max(a, x); }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 x) { return MlasMaximumFloat32x4(a, x); }
+    static MLAS_FORCEINLINE float Combine(float a, float b) { return std::max(a, b); }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasMaximumFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Reduce(MLAS_FLOAT32X4 a) { return MlasReduceMaximumFloat32x4(a); }
+};
+
+struct MLAS_REDUCE_MINIMUM_OP {
+    static constexpr float Identity() { return std::numeric_limits<float>::infinity(); }
+    static MLAS_FORCEINLINE float Apply(float a, float x) { return std::min(a, x); }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Apply(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 x) { return MlasMinimumFloat32x4(a, x); }
+    static MLAS_FORCEINLINE float Combine(float a, float b) { return std::min(a, b); }
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasMinimumFloat32x4(a, b); }
+    static MLAS_FORCEINLINE float Reduce(MLAS_FLOAT32X4 a) { return MlasReduceMinimumFloat32x4(a); }
+};
+
+//
+// Partial result of the reduction of a row. LogSumExp keeps the maximum of
+// the row in Value and the sum of exp(x - Value) in SumExp.
+//
+
+struct MLAS_REDUCE_PARTIAL {
+    float Value;
+    float SumExp;
+};
+
+template<typename OpType>
+float
+MlasReduceRowKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a contiguous row of elements.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    N - Supplies the number of elements of the row.
+
+Return Value:
+
+    Returns the reduction of the row.
+
+--*/
+{
+    float Accumulator = OpType::Identity();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasBroadcastFloat32x4(OpType::Identity());
+        MLAS_FLOAT32X4 Accumulator1 = Accumulator0;
+        MLAS_FLOAT32X4 Accumulator2 = Accumulator0;
+        MLAS_FLOAT32X4 Accumulator3 = Accumulator0;
+
+        while (N >= 16) {
+
+            Accumulator0 = OpType::Apply(Accumulator0, MlasLoadFloat32x4(Input));
+            Accumulator1 = OpType::Apply(Accumulator1, MlasLoadFloat32x4(Input + 4));
+            Accumulator2 = OpType::Apply(Accumulator2, MlasLoadFloat32x4(Input + 8));
+            Accumulator3 = OpType::Apply(Accumulator3, MlasLoadFloat32x4(Input + 12));
+
+            Input += 16;
+            N -= 16;
+        }
+
+        while (N >= 4) {
+
+            Accumulator0 = OpType::Apply(Accumulator0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Accumulator0 = OpType::Combine(OpType::Combine(Accumulator0, Accumulator1),
+                                       OpType::Combine(Accumulator2, Accumulator3));
+        Accumulator = OpType::Reduce(Accumulator0);
+    }
+
+    while (N > 0) {
+
+        Accumulator = OpType::Apply(Accumulator, *Input++);
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+template<typename OpType>
+void
+MlasReduceColumnsKernel(
+    const float* Input,
+    float* Output,
+    size_t RowCount,
+    size_t ColumnCount,
+    size_t RowStride
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the columns of a block of rows, the rows being
+    RowStride elements apart.
+
+Arguments:
+
+    Input - Supplies the first element of the first row.
+
+    Output - Supplies the ColumnCount reduced values.
+
+    RowCount - Supplies the number of rows to reduce.
+
+    ColumnCount - Supplies the number of columns to reduce.
+
+    RowStride - Supplies the number of elements between two rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (ColumnCount >= MLAS_REDUCE_COLUMN_BLOCK_SIZE) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasBroadcastFloat32x4(OpType::Identity());
+        MLAS_FLOAT32X4 Accumulator1 = Accumulator0;
+        MLAS_FLOAT32X4 Accumulator2 = Accumulator0;
+        MLAS_FLOAT32X4 Accumulator3 = Accumulator0;
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            Accumulator0 = OpType::Apply(Accumulator0, MlasLoadFloat32x4(Row));
+            Accumulator1 = OpType::Apply(Accumulator1, MlasLoadFloat32x4(Row + 4));
+            Accumulator2 = OpType::Apply(Accumulator2, MlasLoadFloat32x4(Row + 8));
+            Accumulator3 = OpType::Apply(Accumulator3, MlasLoadFloat32x4(Row + 12));
+
+            Row += RowStride;
+        }
+
+        MlasStoreFloat32x4(Output, Accumulator0);
+        MlasStoreFloat32x4(Output + 4, Accumulator1);
+        MlasStoreFloat32x4(Output + 8, Accumulator2);
+        MlasStoreFloat32x4(Output + 12, Accumulator3);
+
+        Input += MLAS_REDUCE_COLUMN_BLOCK_SIZE;
+        Output += MLAS_REDUCE_COLUMN_BLOCK_SIZE;
+        ColumnCount -= MLAS_REDUCE_COLUMN_BLOCK_SIZE;
+    }
+
+    while (ColumnCount >= 4) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasBroadcastFloat32x4(OpType::Identity());
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulator = OpType::Apply(Accumulator, MlasLoadFloat32x4(Row));
+            Row += RowStride;
+        }
+
+        MlasStoreFloat32x4(Output, Accumulator);
+
+        Input += 4;
+        Output += 4;
+        ColumnCount -= 4;
+    }
+
+    while (ColumnCount > 0) {
+
+        float Accumulator = OpType::Identity();
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulator = OpType::Apply(Accumulator, *Row);
+            Row += RowStride;
+        }
+
+        *Output = Accumulator;
+
+        Input += 1;
+        Output += 1;
+        ColumnCount -= 1;
+    }
+}
+
+void
+MlasReduceLogSumExpColumns(
+    const float* Input,
+    float* Output,
+    size_t RowCount,
+    size_t ColumnCount,
+    size_t RowStride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the LogSumExp of the columns of a block of rows,
+    the rows being RowStride elements apart.
+
+    The maximum of each column is computed first and is subtracted from the
+    values before the exponential is applied. A column whose maximum is
+    infinite reduces to its maximum.
+
+Arguments:
+
+    Input - Supplies the first element of the first row.
+
+    Output - Supplies the ColumnCount reduced values.
+
+    RowCount - Supplies the number of rows to reduce.
+
+    ColumnCount - Supplies the number of columns to reduce.
+
+    RowStride - Supplies the number of elements between two rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasReduceColumnsKernel<MLAS_REDUCE_MAXIMUM_OP>(Input, Output, RowCount, ColumnCount, RowStride);
+
+    constexpr size_t BlockSize = 4 * MLAS_REDUCE_COLUMN_BLOCK_SIZE;
+
+    MLAS_DECLSPEC_ALIGN(float Buffer[BlockSize], 64);
+    MLAS_DECLSPEC_ALIGN(float Accumulation[BlockSize], 64);
+
+    for (size_t c = 0; c < ColumnCount; c += BlockSize) {
+
+        const size_t Count = std::min(BlockSize, ColumnCount - c);
+        const float* Maximum = Output + c;
+
+        std::fill_n(Accumulation, Count, 0.0f);
+
+        const float* Row = Input + c;
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            for (size_t j = 0; j < Count; j++) {
+                Buffer[j] = Row[j] - Maximum[j];
+            }
+
+            MlasComputeExp(Buffer, Buffer, Count);
+
+            for (size_t j = 0; j < Count; j++) {
+                Accumulation[j] += Buffer[j];
+            }
+
+            Row += RowStride;
+        }
+
+        for (size_t j = 0; j < Count; j++) {
+            if (!std::isinf(Maximum[j])) {
+                Output[c + j] += std::log(Accumulation[j]);
+            }
+        }
+    }
+}
+
+MLAS_REDUCE_PARTIAL
+MlasReduceRowPartial(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the partial result of the reduction of a
+    contiguous row of elements.
+
+Arguments:
+
+    Kind - Supplies the reduction.
+
+    Input - Supplies the input row.
+
+    N - Supplies the number of elements of the row, greater than zero.
+
+Return Value:
+
+    Returns the partial result.
+
+--*/
+{
+    switch (Kind) {
+
+        case MlasReduceSum:
+            return {MlasReduceRowKernel<MLAS_REDUCE_SUM_OP>(Input, N), 0.0f};
+
+        case MlasReduceSumSquare:
+            return {MlasReduceRowKernel<MLAS_REDUCE_SUM_SQUARE_OP>(Input, N), 0.0f};
+
+        case MlasReduceMaximum:
+            return {MlasReduceRowKernel<MLAS_REDUCE_MAXIMUM_OP>(Input, N), 0.0f};
+
+        case MlasReduceMinimum:
+            return {MlasReduceRowKernel<MLAS_REDUCE_MINIMUM_OP>(Input, N), 0.0f};
+
+        case MlasReduceLogSumExp:
+        default: {
+
+#if defined(MLAS_TARGET_AMD64)
+            float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+            float Maximum = MlasReduceMaximumF32Kernel(Input, N);
+#endif
+
+            //
+            // An infinite maximum is the result of the reduction: +inf
+            // dominates and -inf means that all the values are -inf.
+            //
+
+            if (std::isinf(Maximum)) {
+                return {Maximum, 1.0f};
+            }
+
+            float NegativeMaximum = -Maximum;
+
+#if defined(MLAS_TARGET_AMD64)
+            float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#else
+            float Accumulation = MlasComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#endif
+
+            return {Maximum, Accumulation};
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+MLAS_REDUCE_PARTIAL
+MlasReduceCombinePartial(
+    MLAS_REDUCE_KIND Kind,
+    MLAS_REDUCE_PARTIAL Partial,
+    MLAS_REDUCE_PARTIAL Other
+    )
+{
+    switch (Kind) {
+
+        case MlasReduceSum:
+        case MlasReduceSumSquare:
+            return {Partial.Value + Other.Value, 0.0f};
+
+        case MlasReduceMaximum:
+            return {std::max(Partial.Value, Other.Value), 0.0f};
+
+        case MlasReduceMinimum:
+            return {std::min(Partial.Value, Other.Value), 0.0f};
+
+        case MlasReduceLogSumExp:
+        default: {
+            if (Partial.Value < Other.Value) {
+                std::swap(Partial, Other);
+            }
+            if (std::isinf(Partial.Value)) {
+                return Partial;
+            }
+            return {Partial.Value, Partial.SumExp + Other.SumExp * std::exp(Other.Value - Partial.Value)};
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceFinalizePartial(
+    MLAS_REDUCE_KIND Kind,
+    MLAS_REDUCE_PARTIAL Partial
+    )
+{
+    if (Kind == MlasReduceLogSumExp) {
+        return Partial.Value + std::log(Partial.SumExp);
+    }
+
+    return Partial.Value;
+}
+
+void
+MlasReduceColumns(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t RowCount,
+    size_t ColumnCount,
+    size_t RowStride
+    )
+{
+    switch (Kind) {
+
+        case MlasReduceSum:
+            MlasReduceColumnsKernel<MLAS_REDUCE_SUM_OP>(Input, Output, RowCount, ColumnCount, RowStride);
+            break;
+
+        case MlasReduceSumSquare:
+            MlasReduceColumnsKernel<MLAS_REDUCE_SUM_SQUARE_OP>(Input, Output, RowCount, ColumnCount, RowStride);
+            break;
+
+        case MlasReduceMaximum:
+            MlasReduceColumnsKernel<MLAS_REDUCE_MAXIMUM_OP>(Input, Output, RowCount, ColumnCount, RowStride);
+            break;
+
+        case MlasReduceMinimum:
+            MlasReduceColumnsKernel<MLAS_REDUCE_MINIMUM_OP>(Input, Output, RowCount, ColumnCount, RowStride);
+            break;
+
+        case MlasReduceLogSumExp:
+            MlasReduceLogSumExpColumns(Input, Output, RowCount, ColumnCount, RowStride);
+            break;
+    }
+}
+
+ptrdiff_t
+MlasReduceGetThreadCount(
+    size_t ElementCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    ptrdiff_t TargetThreadCount = ptrdiff_t(ElementCount / MLAS_REDUCE_THREAD_COMPLEXITY) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    return TargetThreadCount;
+}
+
+void
+MLASCALL
+MlasReduceInnermost(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output[o] = reduce(Input[o, r]) over r, the
+    reduction of the innermost dimensions of a tensor.
+
+    The rows are partitioned between the threads. If there are fewer rows
+    than threads, the rows are also split in chunks whose partial results
+    are combined once all the threads are done.
+
+Arguments:
+
+    Kind - Supplies the reduction.
+
+    Input - Supplies the OuterCount x ReduceCount input tensor.
+
+    Output - Supplies the OuterCount output values.
+
+    OuterCount - Supplies the number of rows.
+
+    ReduceCount - Supplies the number of elements of each row, greater than
+        zero.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (OuterCount == 0) {
+        return;
+    }
+
+    ptrdiff_t TargetThreadCount = MlasReduceGetThreadCount(OuterCount * ReduceCount, ThreadPool);
+
+    if (size_t(TargetThreadCount) <= OuterCount) {
+
+        MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+            size_t RowIndex;
+            size_t RowCount;
+
+            MlasPartitionWork(tid, TargetThreadCount, OuterCount, &RowIndex, &RowCount);
+
+            for (size_t r = RowIndex; r < RowIndex + RowCount; r++) {
+                MLAS_REDUCE_PARTIAL Partial = MlasReduceRowPartial(Kind, Input + r * ReduceCount, ReduceCount);
+                Output[r] = MlasReduceFinalizePartial(Kind, Partial);
+            }
+        });
+
+        return;
+    }
+
+    //
+    // Split each row in chunks of whole vectors so that every thread has
+    // work. The number of partial results is bounded by twice the number of
+    // threads.
+    //
+
+    if (size_t(TargetThreadCount) > MLAS_REDUCE_MAXIMUM_PARTIAL_ROWS / 2) {
+        TargetThreadCount = ptrdiff_t(MLAS_REDUCE_MAXIMUM_PARTIAL_ROWS / 2);
+    }
+
+    size_t ChunkCount = (size_t(TargetThreadCount) + OuterCount - 1) / OuterCount;
+    size_t ChunkSize = (ReduceCount + ChunkCount - 1) / ChunkCount;
+    ChunkSize = (ChunkSize + MLAS_REDUCE_COLUMN_BLOCK_SIZE - 1) & ~(MLAS_REDUCE_COLUMN_BLOCK_SIZE - 1);
+    ChunkCount = (ReduceCount + ChunkSize - 1) / ChunkSize;
+
+    const size_t WorkCount = OuterCount * ChunkCount;
+
+    if (size_t(TargetThreadCount) > WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    MLAS_REDUCE_PARTIAL Partials[MLAS_REDUCE_MAXIMUM_PARTIAL_ROWS];
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+        for (size_t w = WorkIndex; w < WorkIndex + WorkRemaining; w++) {
+            const size_t Row = w / ChunkCount;
+            const size_t Offset = (w % ChunkCount) * ChunkSize;
+            Partials[w] = MlasReduceRowPartial(Kind, Input + Row * ReduceCount + Offset,
+                                               std::min(ChunkSize, ReduceCount - Offset));
+        }
+    });
+
+    for (size_t r = 0; r < OuterCount; r++) {
+
+        MLAS_REDUCE_PARTIAL Partial = Partials[r * ChunkCount];
+
+        for (size_t c = 1; c < ChunkCount; c++) {
+            Partial = MlasReduceCombinePartial(Kind, Partial, Partials[r * ChunkCount + c]);
+        }
+
+        Output[r] = MlasReduceFinalizePartial(Kind, Partial);
+    }
+}
+
+void
+MLASCALL
+MlasReduceStrided(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output[o, i] = reduce(Input[o, r, i]) over r, the
+    reduction of the outermost dimensions (OuterCount is one) or of the
+    middle dimensions of a tensor.
+
+    Blocks of output columns are partitioned between the threads and each
+    block is reduced with its accumulators in registers while the rows are
+    streamed. If there are too few blocks for the threads, the reduced rows
+    are also split in chunks whose partial results are combined once all the
+    threads are done.
+
+Arguments:
+
+    Kind - Supplies the reduction.
+
+    Input - Supplies the OuterCount x ReduceCount x InnerCount input tensor.
+
+    Output - Supplies the OuterCount x InnerCount output tensor.
+
+    OuterCount - Supplies the number of elements of the dimensions before the
+        reduced dimensions.
+
+    ReduceCount - Supplies the number of elements of the reduced dimensions,
+        greater than zero.
+
+    InnerCount - Supplies the number of elements of the dimensions after the
+        reduced dimensions.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (InnerCount == 1) {
+        MlasReduceInnermost(Kind, Input, Output, OuterCount, ReduceCount, ThreadPool);
+        return;
+    }
+
+    if (OuterCount == 0 || InnerCount == 0) {
+        return;
+    }
+
+    const size_t BlockCount = (InnerCount + MLAS_REDUCE_COLUMN_BLOCK_SIZE - 1) / MLAS_REDUCE_COLUMN_BLOCK_SIZE;
+    const size_t WorkCount = OuterCount * BlockCount;
+    const size_t KeptCount = OuterCount * InnerCount;
+
+    ptrdiff_t TargetThreadCount = MlasReduceGetThreadCount(KeptCount * ReduceCount, ThreadPool);
+
+    //
+    // Reduces the rows [RowIndex, RowIndex + RowCount) of the blocks of columns
+    // [WorkIndex, WorkIndex + WorkRemaining) to Output, merging the blocks that
+    // belong to the same outer index.
+    //
+
+    auto ReduceBlocks = [&](size_t WorkIndex, size_t WorkRemaining, size_t RowIndex, size_t RowCount,
+                            float* BlockOutput) {
+        while (WorkRemaining > 0) {
+
+            const size_t o = WorkIndex / BlockCount;
+            const size_t b = WorkIndex % BlockCount;
+            const size_t Blocks = std::min(WorkRemaining, BlockCount - b);
+            const size_t Column = b * MLAS_REDUCE_COLUMN_BLOCK_SIZE;
+            const size_t ColumnCount = std::min(Blocks * MLAS_REDUCE_COLUMN_BLOCK_SIZE, InnerCount - Column);
+
+            MlasReduceColumns(Kind, Input + (o * ReduceCount + RowIndex) * InnerCount + Column,
+                              BlockOutput + o * InnerCount + Column, RowCount, ColumnCount, InnerCount);
+
+            WorkIndex += Blocks;
+            WorkRemaining -= Blocks;
+        }
+    };
+
+    if (size_t(TargetThreadCount) <= WorkCount || Kind == MlasReduceLogSumExp ||
+        KeptCount * 2 > MLAS_REDUCE_MAXIMUM_PARTIAL_COLUMNS) {
+
+        if (size_t(TargetThreadCount) > WorkCount) {
+            TargetThreadCount = ptrdiff_t(WorkCount);
+        }
+
+        MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+            size_t WorkIndex;
+            size_t WorkRemaining;
+
+            MlasPartitionWork(tid, TargetThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+            ReduceBlocks(WorkIndex, WorkRemaining, 0, ReduceCount, Output);
+        });
+
+        return;
+    }
+
+    //
+    // Few output values and many rows: split the rows in chunks, each chunk
+    // writing its partial results to its own slice of a buffer.
+    //
+
+    size_t ChunkCount = (size_t(TargetThreadCount) + WorkCount - 1) / WorkCount;
+    ChunkCount = std::min(ChunkCount, MLAS_REDUCE_MAXIMUM_PARTIAL_COLUMNS / KeptCount);
+    ChunkCount = std::min(ChunkCount, ReduceCount);
+
+    const size_t ChunkSize = (ReduceCount + ChunkCount - 1) / ChunkCount;
+    ChunkCount = (ReduceCount + ChunkSize - 1) / ChunkSize;
+
+    const size_t TotalWorkCount = WorkCount * ChunkCount;
+
+    if (size_t(TargetThreadCount) > TotalWorkCount) {
+        TargetThreadCount = ptrdiff_t(TotalWorkCount);
+    }
+
+    MLAS_DECLSPEC_ALIGN(float Partials[MLAS_REDUCE_MAXIMUM_PARTIAL_COLUMNS], 64);
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, TotalWorkCount, &WorkIndex, &WorkRemaining);
+
+        while (WorkRemaining > 0) {
+
+            const size_t Chunk = WorkIndex / WorkCount;
+            const size_t ChunkWorkIndex = WorkIndex % WorkCount;
+            const size_t ChunkWorkCount = std::min(WorkRemaining, WorkCount - ChunkWorkIndex);
+            const size_t RowIndex = Chunk * ChunkSize;
+
+            ReduceBlocks(ChunkWorkIndex, ChunkWorkCount, RowIndex, std::min(ChunkSize, ReduceCount - RowIndex),
+                         Partials + Chunk * KeptCount);
+
+            WorkIndex += ChunkWorkCount;
+            WorkRemaining -= ChunkWorkCount;
+        }
+    });
+
+    for (size_t k = 0; k < KeptCount; k++) {
+
+        MLAS_REDUCE_PARTIAL Partial{Partials[k], 0.0f};
+
+        for (size_t c = 1; c < ChunkCount; c++) {
+            Partial = MlasReduceCombinePartial(Kind, Partial, {Partials[c * KeptCount + k], 0.0f});
+        }
+
+        Output[k] = Partial.Value;
+    }
+}
@@ -0,0 +1,618 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    scan.cpp
+
+Abstract:
+
+    This module implements the prefix sum of a tensor along one of its
+    dimensions.
+
+    The tensor is viewed as [OuterCount, ScanCount, InnerCount]. Rows of the
+    innermost scan and blocks of columns of the strided scan are independent
+    and are partitioned between the threads. When there are too few of them
+    for the threads, the scanned dimension is also split in chunks: the sums
+    of the chunks are computed in parallel, scanned serially, and then used
+    as the initial values of the parallel scans of the chunks.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements to process per thread.
+//
+
+constexpr size_t MLAS_SCAN_THREAD_COMPLEXITY = 64 * 1024;
+
+//
+// Number of columns scanned at once by the strided kernel, so that the
+// accumulators of a block stay in registers.
+//
+
+constexpr size_t MLAS_SCAN_COLUMN_BLOCK_SIZE = 16;
+
+//
+// Minimum number of elements of a row before the innermost kernel splits it
+// in independent segments.
+//
+
+constexpr size_t MLAS_SCAN_MINIMUM_SEGMENTED_ROW = 64;
+
+//
+// Maximum number of partial sums when the scanned dimension is split between
+// threads.
+//
+
+constexpr size_t MLAS_SCAN_MAXIMUM_PARTIALS = 4096;
+
+float
+MlasScanSumRow(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sum of a contiguous row of values.
+
+Arguments:
+
+    Input - Supplies the row.
+
+    N - Supplies the number of elements of the row.
+
+Return Value:
+
+    Returns the sum of the row.
+
+--*/
+{
+    MLAS_FLOAT32X4 Sum0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Sum1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Sum2 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Sum3 = MlasZeroFloat32x4();
+
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+        Sum0 = MlasAddFloat32x4(Sum0, MlasLoadFloat32x4(Input + n));
+        Sum1 = MlasAddFloat32x4(Sum1, MlasLoadFloat32x4(Input + n + 4));
+        Sum2 = MlasAddFloat32x4(Sum2, MlasLoadFloat32x4(Input + n + 8));
+        Sum3 = MlasAddFloat32x4(Sum3, MlasLoadFloat32x4(Input + n + 12));
+    }
+
+    for (; n + 4 <= N; n += 4) {
+        Sum0 = MlasAddFloat32x4(Sum0, MlasLoadFloat32x4(Input + n));
+    }
+
+    float Sum = MlasReduceAddFloat32x4(
+        MlasAddFloat32x4(MlasAddFloat32x4(Sum0, Sum1), MlasAddFloat32x4(Sum2, Sum3)));
+
+    for (; n < N; n++) {
+        Sum += Input[n];
+    }
+
+    return Sum;
+}
+
+void
+MlasScanSumColumns(
+    const float* Input,
+    float* Sum,
+    size_t RowCount,
+    size_t ColumnCount,
+    size_t InnerCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sums of the columns of a block of rows.
+
+Arguments:
+
+    Input - Supplies the first row of the block.
+
+    Sum - Receives the ColumnCount sums.
+
+    RowCount - Supplies the number of rows of the block.
+
+    ColumnCount - Supplies the number of columns.
+
+    InnerCount - Supplies the distance between two rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (ColumnCount == 1) {
+
+        if (InnerCount == 1) {
+            *Sum = MlasScanSumRow(Input, RowCount);
+            return;
+        }
+
+        float Value = 0.0f;
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Value += Input[r * InnerCount];
+        }
+
+        *Sum = Value;
+        return;
+    }
+
+    size_t c = 0;
+
+    for (; c + 4 <= ColumnCount; c += 4) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulator = MlasAddFloat32x4(Accumulator, MlasLoadFloat32x4(Input + r * InnerCount + c));
+        }
+
+        MlasStoreFloat32x4(Sum + c, Accumulator);
+    }
+
+    for (; c < ColumnCount; c++) {
+
+        float Value = 0.0f;
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Value += Input[r * InnerCount + c];
+        }
+
+        Sum[c] = Value;
+    }
+}
+
+void
+MlasScanRow(
+    const float* Input,
+    float* Output,
+    ptrdiff_t Stride,
+    size_t N,
+    float Carry,
+    bool Exclusive
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the prefix sum of a row of values.
+
+    The dependency between consecutive sums bounds a single scan to one
+    addition per add latency, so long rows are split in four segments: the
+    sums of the first three segments are computed first, with vector
+    instructions for a contiguous row, and the four segments are then scanned
+    as independent chains.
+
+Arguments:
+
+    Input - Supplies the first element of the row in scan order.
+
+    Output - Supplies the first element of the output row in scan order,
+        which may be the same as Input.
+
+    Stride - Supplies the distance between two consecutive elements in scan
+        order, negative for a reverse scan.
+
+    N - Supplies the number of elements of the row.
+
+    Carry - Supplies the value the sums start from.
+
+    Exclusive - Supplies true to exclude each element from its own sum.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = 0;
+
+    if (N >= MLAS_SCAN_MINIMUM_SEGMENTED_ROW) {
+
+        const size_t SegmentSize = N / 4;
+        const ptrdiff_t SegmentStride = Stride * ptrdiff_t(SegmentSize);
+
+        //
+        // The sums of the segments do not depend on the scan order, so they
+        // are computed from the lowest address of each segment.
+        //
+
+        const float* Segment1 = Input + SegmentStride;
+        const float* Segment2 = Input + 2 * SegmentStride;
+
+        auto SegmentSum = [&](const float* Segment) {
+            float Sum;
+            MlasScanSumColumns(Stride > 0 ? Segment : Segment + ptrdiff_t(SegmentSize - 1) * Stride, &Sum,
+                               SegmentSize, 1, size_t(Stride > 0 ? Stride : -Stride));
+            return Sum;
+        };
+
+        float Accumulator0 = Carry;
+        float Accumulator1 = Accumulator0 + SegmentSum(Input);
+        float Accumulator2 = Accumulator1 + SegmentSum(Segment1);
+        float Accumulator3 = Accumulator2 + SegmentSum(Segment2);
+
+        const float* Input0 = Input;
+        float* Output0 = Output;
+
+        for (size_t s = 0; s < SegmentSize; s++) {
+
+            const float Value0 = Input0[0];
+            const float Value1 = Input0[SegmentStride];
+            const float Value2 = Input0[2 * SegmentStride];
+            const float Value3 = Input0[3 * SegmentStride];
+
+            if (Exclusive) {
+                Output0[0] = Accumulator0;
+                Output0[SegmentStride] = Accumulator1;
+                Output0[2 * SegmentStride] = Accumulator2;
+                Output0[3 * SegmentStride] = Accumulator3;
+            }
+
+            Accumulator0 += Value0;
+            Accumulator1 += Value1;
+            Accumulator2 += Value2;
+            Accumulator3 += Value3;
+
+            if (!Exclusive) {
+                Output0[0] = Accumulator0;
+                Output0[SegmentStride] = Accumulator1;
+                Output0[2 * SegmentStride] = Accumulator2;
+                Output0[3 * SegmentStride] = Accumulator3;
+            }
+
+            Input0 += Stride;
+            Output0 += Stride;
+        }
+
+        Carry = Accumulator3;
+        n = 4 * SegmentSize;
+    }
+
+    for (; n < N; n++) {
+
+        const float Value = Input[ptrdiff_t(n) * Stride];
+
+        if (Exclusive) {
+            Output[ptrdiff_t(n) * Stride] = Carry;
+        }
+
+        Carry += Value;
+
+        if (!Exclusive) {
+            Output[ptrdiff_t(n) * Stride] = Carry;
+        }
+    }
+}
+
+void
+MlasScanColumns(
+    const float* Input,
+    float* Output,
+    ptrdiff_t Stride,
+    size_t RowCount,
+    size_t ColumnCount,
+    const float* Carry,
+    bool Exclusive
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the prefix sums of the columns of a block of rows.
+    The sums of a block of columns are kept in registers while the rows are
+    streamed.
+
+Arguments:
+
+    Input - Supplies the first row of the block in scan order.
+
+    Output - Supplies the first output row of the block in scan order, which
+        may be the same as Input.
+
+    Stride - Supplies the distance between two consecutive rows in scan
+        order, negative for a reverse scan.
+
+    RowCount - Supplies the number of rows of the block.
+
+    ColumnCount - Supplies the number of columns.
+
+    Carry - Supplies the ColumnCount values the sums start from, else nullptr
+        to start from zero.
+
+    Exclusive - Supplies true to exclude each row from its own sums.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t c = 0;
+
+    for (; c + 16 <= ColumnCount; c += 16) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+        if (Carry != nullptr) {
+            Accumulator0 = MlasLoadFloat32x4(Carry + c);
+            Accumulator1 = MlasLoadFloat32x4(Carry + c + 4);
+            Accumulator2 = MlasLoadFloat32x4(Carry + c + 8);
+            Accumulator3 = MlasLoadFloat32x4(Carry + c + 12);
+        }
+
+        const float* InputRow = Input + c;
+        float* OutputRow = Output + c;
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            MLAS_FLOAT32X4 Value0 = MlasLoadFloat32x4(InputRow);
+            MLAS_FLOAT32X4 Value1 = MlasLoadFloat32x4(InputRow + 4);
+            MLAS_FLOAT32X4 Value2 = MlasLoadFloat32x4(InputRow + 8);
+            MLAS_FLOAT32X4 Value3 = MlasLoadFloat32x4(InputRow + 12);
+
+            if (Exclusive) {
+                MlasStoreFloat32x4(OutputRow, Accumulator0);
+                MlasStoreFloat32x4(OutputRow + 4, Accumulator1);
+                MlasStoreFloat32x4(OutputRow + 8, Accumulator2);
+                MlasStoreFloat32x4(OutputRow + 12, Accumulator3);
+            }
+
+            Accumulator0 = MlasAddFloat32x4(Accumulator0, Value0);
+            Accumulator1 = MlasAddFloat32x4(Accumulator1, Value1);
+            Accumulator2 = MlasAddFloat32x4(Accumulator2, Value2);
+            Accumulator3 = MlasAddFloat32x4(Accumulator3, Value3);
+
+            if (!Exclusive) {
+                MlasStoreFloat32x4(OutputRow, Accumulator0);
+                MlasStoreFloat32x4(OutputRow + 4, Accumulator1);
+                MlasStoreFloat32x4(OutputRow + 8, Accumulator2);
+                MlasStoreFloat32x4(OutputRow + 12, Accumulator3);
+            }
+
+            InputRow += Stride;
+            OutputRow += Stride;
+        }
+    }
+
+    for (; c + 4 <= ColumnCount; c += 4) {
+
+        MLAS_FLOAT32X4 Accumulator = (Carry != nullptr) ? MlasLoadFloat32x4(Carry + c) : MlasZeroFloat32x4();
+
+        const float* InputRow = Input + c;
+        float* OutputRow = Output + c;
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(InputRow);
+
+            if (Exclusive) {
+                MlasStoreFloat32x4(OutputRow, Accumulator);
+            }
+
+            Accumulator = MlasAddFloat32x4(Accumulator, Value);
+
+            if (!Exclusive) {
+                MlasStoreFloat32x4(OutputRow, Accumulator);
+            }
+
+            InputRow += Stride;
+            OutputRow += Stride;
+        }
+    }
+
+    for (; c < ColumnCount; c++) {
+        MlasScanRow(Input + c, Output + c, Stride, RowCount, (Carry != nullptr) ? Carry[c] : 0.0f, Exclusive);
+    }
+}
+
+void
+MLASCALL
+MlasPrefixSum(
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ScanCount,
+    size_t InnerCount,
+    bool Exclusive,
+    bool Reverse,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output[o, s, i] = sum(Input[o, t, i]) over t <= s,
+    the prefix sum of a tensor along its middle dimension.
+
+Arguments:
+
+    Input - Supplies the OuterCount x ScanCount x InnerCount input tensor.
+
+    Output - Supplies the output tensor, which may be the same as Input.
+
+    OuterCount - Supplies the number of elements of the dimensions before the
+        scanned dimension.
+
+    ScanCount - Supplies the number of elements of the scanned dimension.
+
+    InnerCount - Supplies the number of elements of the dimensions after the
+        scanned dimension.
+
+    Exclusive - Supplies true to sum over t < s instead.
+
+    Reverse - Supplies true to sum over t >= s (t > s if Exclusive) instead.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (OuterCount == 0 || ScanCount == 0 || InnerCount == 0) {
+        return;
+    }
+
+    //
+    // The scan walks the rows from the first one in scan order, which is the
+    // last one of the tensor for a reverse scan.
+    //
+
+    const ptrdiff_t Stride = Reverse ? -ptrdiff_t(InnerCount) : ptrdiff_t(InnerCount);
+    const size_t FirstRow = Reverse ? ScanCount - 1 : 0;
+
+    auto ScanBlock = [&](size_t o, size_t RowIndex, size_t RowCount, size_t Column, size_t ColumnCount,
+                         const float* Carry) {
+        const size_t Row = Reverse ? FirstRow - RowIndex : RowIndex;
+        const size_t Offset = (o * ScanCount + Row) * InnerCount + Column;
+
+        if (InnerCount == 1) {
+            MlasScanRow(Input + Offset, Output + Offset, Stride, RowCount, (Carry != nullptr) ? *Carry : 0.0f,
+                        Exclusive);
+        } else {
+            MlasScanColumns(Input + Offset, Output + Offset, Stride, RowCount, ColumnCount, Carry, Exclusive);
+        }
+    };
+
+    const size_t BlockCount = (InnerCount + MLAS_SCAN_COLUMN_BLOCK_SIZE - 1) / MLAS_SCAN_COLUMN_BLOCK_SIZE;
+    const size_t WorkCount = OuterCount * BlockCount;
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(OuterCount * ScanCount * InnerCount / MLAS_SCAN_THREAD_COMPLEXITY) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Split the scanned dimension in chunks if there are fewer independent
+    // blocks than threads. Every chunk is read twice, so this is only done
+    // when the threads would otherwise be idle.
+    //
+
+    size_t ChunkCount = 1;
+
+    if (size_t(TargetThreadCount) > WorkCount) {
+        ChunkCount = (size_t(TargetThreadCount) + WorkCount - 1) / WorkCount;
+        ChunkCount = std::min(ChunkCount, MLAS_SCAN_MAXIMUM_PARTIALS / (OuterCount * InnerCount));
+        ChunkCount = std::min(ChunkCount, ScanCount);
+    }
+
+    if (ChunkCount <= 1) {
+
+        if (size_t(TargetThreadCount) > WorkCount) {
+            TargetThreadCount = ptrdiff_t(WorkCount);
+        }
+
+        MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+            size_t WorkIndex;
+            size_t WorkRemaining;
+
+            MlasPartitionWork(tid, TargetThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+            for (size_t w = WorkIndex; w < WorkIndex + WorkRemaining; w++) {
+                const size_t o = w / BlockCount;
+                const size_t Column = (w % BlockCount) * MLAS_SCAN_COLUMN_BLOCK_SIZE;
+                ScanBlock(o, 0, ScanCount, Column, std::min(MLAS_SCAN_COLUMN_BLOCK_SIZE, InnerCount - Column),
+                          nullptr);
+            }
+        });
+
+        return;
+    }
+
+    const size_t ChunkSize = (ScanCount + ChunkCount - 1) / ChunkCount;
+    ChunkCount = (ScanCount + ChunkSize - 1) / ChunkSize;
+
+    const size_t ChunkWorkCount = OuterCount * ChunkCount;
+
+    if (size_t(TargetThreadCount) > ChunkWorkCount) {
+        TargetThreadCount = ptrdiff_t(ChunkWorkCount);
+    }
+
+    //
+    // Partials[o, c, i] receives the sum of chunk c, except for the last
+    // chunk that does not need it, and is then scanned to the sum of the
+    // chunks before c.
+    //
+
+    float Partials[MLAS_SCAN_MAXIMUM_PARTIALS];
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, ChunkWorkCount, &WorkIndex, &WorkRemaining);
+
+        for (size_t w = WorkIndex; w < WorkIndex + WorkRemaining; w++) {
+            const size_t o = w / ChunkCount;
+            const size_t c = w % ChunkCount;
+
+            if (c + 1 == ChunkCount) {
+                continue;
+            }
+
+            //
+            // The sums do not depend on the scan order, so they are computed
+            // from the lowest row of the chunk.
+            //
+
+            const size_t Row = Reverse ? ScanCount - (c + 1) * ChunkSize : c * ChunkSize;
+
+            MlasScanSumColumns(Input + (o * ScanCount + Row) * InnerCount, Partials + w * InnerCount, ChunkSize,
+                               InnerCount, InnerCount);
+        }
+    });
+
+    for (size_t o = 0; o < OuterCount; o++) {
+
+        float* Carry = Partials + o * ChunkCount * InnerCount;
+
+        for (size_t i = 0; i < InnerCount; i++) {
+
+            float Sum = 0.0f;
+
+            for (size_t c = 0; c + 1 < ChunkCount; c++) {
+                const float Value = Carry[c * InnerCount + i];
+                Carry[c * InnerCount + i] = Sum;
+                Sum += Value;
+            }
+
+            Carry[(ChunkCount - 1) * InnerCount + i] = Sum;
+        }
+    }
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, ChunkWorkCount, &WorkIndex, &WorkRemaining);
+
+        for (size_t w = WorkIndex; w < WorkIndex + WorkRemaining; w++) {
+            const size_t o = w / ChunkCount;
+            const size_t RowIndex = (w % ChunkCount) * ChunkSize;
+            ScanBlock(o, RowIndex, std::min(ChunkSize, ScanCount - RowIndex), 0, InnerCount,
+                      Partials + w * InnerCount);
+        }
+    });
+}
@@ -17,6 +17,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <memory>
+
 //
 // Define the number of rows from matrix A to transpose to a local buffer.
 //
@@ -26,6 +28,16 @@ Abstract:
 
 #define MLAS_SGEMM_TRANSA_ROWS              12
 
+//
+// Define the maximum number of rows of matrix A for which the threads of a
+// SGEMM operation also partition the K dimension. These skinny operations,
+// such as the matrix/vector products of autoregressive decoding, are bound by
+// the bandwidth of streaming matrix B, so all threads should read a part of
+// matrix B even if there are fewer column blocks than threads.
+//
+
+#define MLAS_SGEMM_SPLITK_MAXIMUM_M         8
+
 //
 // Define the parameters to execute segments of a SGEMM operation on worker
 // threads.
@@ -1552,6 +1564,94 @@ Return Value:
             DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
     }
 }
+void
+MlasSgemmSplitKThreaded(
+    const ptrdiff_t ThreadCountN,
+    const ptrdiff_t ThreadCountK,
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams,
+    float* PartialC,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    skinny SGEMM operation that is partitioned along the N and K dimensions.
+
+    The threads of the first partition of the K dimension update matrix C as
+    usual. The other threads store their partial products to a buffer, which
+    the caller adds to matrix C once all threads completed.
+
+Arguments:
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    ThreadCountK - Supplies the total thread partition on the K dimension.
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    PartialC - Supplies the buffer of (ThreadCountK - 1) M by N matrices to
+        receive the partial products.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdK = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the K dimension, on the boundaries of the
+    // slices of a packed matrix B.
+    //
+
+    const size_t SlicesK = (K + MLAS_SGEMM_PACKED_STRIDEK - 1) / MLAS_SGEMM_PACKED_STRIDEK;
+
+    size_t RangeStartK;
+    size_t RangeCountK;
+
+    MlasPartitionWork(ThreadIdK, ThreadCountK, SlicesK, &RangeStartK, &RangeCountK);
+
+    RangeStartK *= MLAS_SGEMM_PACKED_STRIDEK;
+    RangeCountK = std::min(K - RangeStartK, RangeCountK * MLAS_SGEMM_PACKED_STRIDEK);
+
+    MLAS_SGEMM_DATA_PARAMS Params = *DataParams;
+
+    Params.A += RangeStartK * ((TransA == CblasNoTrans) ? 1 : Params.lda);
+
+    if (Params.BIsPacked) {
+        const size_t AlignedN =
+            (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+        Params.B += AlignedN * RangeStartK;
+    } else {
+        Params.B += RangeStartK * ((TransB == CblasNoTrans) ? Params.ldb : 1);
+    }
+
+    if (ThreadIdK > 0) {
+        Params.C = PartialC + (ThreadIdK - 1) * M * N;
+        Params.ldc = N;
+        Params.beta = 0.0f;
+    }
+
+    MlasSgemmThreaded(1, ThreadCountN, TransA, TransB, M, N, RangeCountK, &Params, ThreadIdN);
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // Chance of arithmetic overflow could be reduced
@@ -1602,6 +1702,7 @@ MlasGemmBatch(
     ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
     ptrdiff_t ThreadCountM;
     ptrdiff_t ThreadCountN;
+    ptrdiff_t ThreadCountK = 1;
 
     if (N > M) {
 
@@ -1609,12 +1710,64 @@ MlasGemmBatch(
             MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
 
         if (size_t(ThreadsPerGemm) > BlockedN) {
+
+            //
+            // Use the threads left over by the column blocks of a skinny
+            // operation to partition the K dimension.
+            //
+
+            if (M <= MLAS_SGEMM_SPLITK_MAXIMUM_M) {
+
+                const size_t SlicesK = (K + MLAS_SGEMM_PACKED_STRIDEK - 1) /
+                    MLAS_SGEMM_PACKED_STRIDEK;
+
+                ThreadCountK = ptrdiff_t(std::min(size_t(ThreadsPerGemm) / BlockedN, SlicesK));
+            }
+
             ThreadsPerGemm = ptrdiff_t(BlockedN);
         }
 
         ThreadCountM = 1;
         ThreadCountN = ThreadsPerGemm;
 
+        if (ThreadCountK > 1) {
+
+            const size_t PartialSize = size_t(ThreadCountK - 1) * M * N;
+            std::unique_ptr<float[]> PartialC(new float[PartialSize * BatchSize]);
+            float* Partial = PartialC.get();
+
+            MlasTrySimpleParallel(ThreadPool,
+                ThreadCountN * ThreadCountK * static_cast<ptrdiff_t>(BatchSize),
+                [=](ptrdiff_t tid)
+            {
+                ptrdiff_t GemmIdx = tid / (ThreadCountN * ThreadCountK);
+                ptrdiff_t ThreadIdx = tid % (ThreadCountN * ThreadCountK);
+                MlasSgemmSplitKThreaded(ThreadCountN, ThreadCountK, TransA, TransB,
+                    M, N, K, &(Data[GemmIdx]), Partial + GemmIdx * PartialSize, ThreadIdx);
+            });
+
+            //
+            // Add the partial products to the output matrices.
+            //
+
+            for (size_t GemmIdx = 0; GemmIdx < BatchSize; GemmIdx++) {
+
+                float* C = Data[GemmIdx].C;
+                const size_t ldc = Data[GemmIdx].ldc;
+                const float* p = Partial + GemmIdx * PartialSize;
+
+                for (ptrdiff_t k = 1; k < ThreadCountK; k++) {
+                    for (size_t m = 0; m < M; m++) {
+                        for (size_t n = 0; n < N; n++) {
+                            C[m * ldc + n] += *p++;
+                        }
+                    }
+                }
+            }
+
+            return;
+        }
+
     } else {
 
         if (size_t(ThreadsPerGemm) > M) {
@@ -0,0 +1,750 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a sparse matrix B, such as the weights of a pruned
+    model.
+
+    Matrix B is split into panels of 16 columns and packed in one of two
+    formats:
+
+    Block sparse: the rows of each panel that contain a nonzero value are
+    stored as 1x16 blocks, in compressed sparse row (CSR) order.
+
+    Structured: each panel is split into groups of 8 rows. Each column of a
+    group stores a fixed number of nonzero values with their row index in
+    the group (N:8 structured sparsity).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters of the packed formats.
+//
+
+constexpr size_t MLAS_SPARSE_GEMM_STRIDEN = 16;
+constexpr size_t MLAS_SPARSE_GEMM_STRIDEM = 4;
+constexpr size_t MLAS_SPARSE_GEMM_GROUP_SIZE = 8;
+constexpr size_t MLAS_SPARSE_GEMM_ALIGNMENT = 64;
+
+//
+// Define the maximum density of matrix B at which a sparse kernel is expected
+// to be faster than the dense SGEMM kernels. The structured kernel gathers
+// the elements of matrix A, so a nonzero value has twice the cost of a
+// nonzero value of the block sparse kernel.
+//
+
+constexpr float MLAS_SPARSE_GEMM_MAXIMUM_DENSITY = 0.5f;
+constexpr float MLAS_SPARSE_GEMM_STRUCTURED_COST = 2.0f;
+
+struct MLAS_SPARSE_GEMM_PACKED_HEADER {
+    uint32_t Format;
+    uint32_t N;
+    uint32_t K;
+    uint32_t Count;
+};
+
+struct MLAS_SPARSE_GEMM_WORK_BLOCK {
+    ptrdiff_t ThreadCount;
+    CBLAS_TRANSPOSE TransA;
+    size_t M;
+    size_t N;
+    size_t K;
+    float alpha;
+    const float* A;
+    size_t lda;
+    const MLAS_SPARSE_GEMM_PACKED_HEADER* PackedB;
+    float beta;
+    float* C;
+    size_t ldc;
+};
+
+MLAS_FORCEINLINE
+size_t
+MlasSparseGemmAlignOffset(
+    size_t Offset
+    )
+{
+    return (Offset + MLAS_SPARSE_GEMM_ALIGNMENT - 1) & ~(MLAS_SPARSE_GEMM_ALIGNMENT - 1);
+}
+
+MLAS_FORCEINLINE
+float
+MlasSparseGemmElementB(
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t k,
+    size_t n
+    )
+{
+    return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+}
+
+void
+MlasSparseGemmAnalyzeB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    size_t* BlockCount,
+    size_t* GroupNonzeroCount
+    )
+/*++
+
+Routine Description:
+
+    This routine counts the 1x16 blocks of matrix B that contain a nonzero
+    value and the maximum number of nonzero values in a column of a group of
+    8 rows.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    BlockCount - Receives the number of nonzero blocks.
+
+    GroupNonzeroCount - Receives the maximum number of nonzero values in a
+        column of a group of rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t Blocks = 0;
+    size_t GroupNonzeros = 0;
+
+    for (size_t n = 0; n < N; n += MLAS_SPARSE_GEMM_STRIDEN) {
+
+        const size_t CountN = std::min(N - n, MLAS_SPARSE_GEMM_STRIDEN);
+        size_t ColumnNonzeros[MLAS_SPARSE_GEMM_STRIDEN] = {};
+
+        for (size_t k = 0; k < K; k++) {
+
+            if (k % MLAS_SPARSE_GEMM_GROUP_SIZE == 0) {
+                std::fill_n(ColumnNonzeros, MLAS_SPARSE_GEMM_STRIDEN, size_t(0));
+            }
+
+            bool IsNonzeroBlock = false;
+
+            for (size_t nn = 0; nn < CountN; nn++) {
+                if (MlasSparseGemmElementB(TransB, B, ldb, k, n + nn) != 0.0f) {
+                    IsNonzeroBlock = true;
+                    GroupNonzeros = std::max(GroupNonzeros, ++ColumnNonzeros[nn]);
+                }
+            }
+
+            if (IsNonzeroBlock) {
+                Blocks++;
+            }
+        }
+    }
+
+    *BlockCount = Blocks;
+    *GroupNonzeroCount = GroupNonzeros;
+}
+
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    MLAS_SPARSE_GEMM_FORMAT* Format
+    )
+/*++
+
+Routine Description:
+
+    This routine analyzes matrix B and selects the packed format for the
+    sparse SGEMM operation.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    Format - Receives the format selected for the packed matrix.
+
+Return Value:
+
+    Returns the size in bytes of the packed buffer, or zero if matrix B is not
+    sparse enough for the sparse SGEMM operation to be faster than SGEMM.
+
+--*/
+{
+    if (N == 0 || K == 0 || N > UINT32_MAX || K > UINT32_MAX) {
+        return 0;
+    }
+
+    size_t BlockCount;
+    size_t GroupNonzeroCount;
+
+    MlasSparseGemmAnalyzeB(TransB, N, K, B, ldb, &BlockCount, &GroupNonzeroCount);
+
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_GEMM_STRIDEN);
+    const size_t GroupCount = MlasDivRoundup(K, MLAS_SPARSE_GEMM_GROUP_SIZE);
+
+    const float BlockCost = float(BlockCount) / float(PanelCount * K);
+    const float StructuredCost = MLAS_SPARSE_GEMM_STRUCTURED_COST *
+        float(GroupNonzeroCount) / float(std::min(K, MLAS_SPARSE_GEMM_GROUP_SIZE));
+
+    size_t BytesRequired = sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER);
+
+    if (BlockCost <= StructuredCost) {
+
+        if (BlockCost > MLAS_SPARSE_GEMM_MAXIMUM_DENSITY) {
+            return 0;
+        }
+
+        *Format = MlasSparseGemmBlockCsr;
+
+        BytesRequired += sizeof(uint32_t) * (PanelCount + 1);
+        BytesRequired += sizeof(uint32_t) * BlockCount;
+        BytesRequired = MlasSparseGemmAlignOffset(BytesRequired);
+        BytesRequired += sizeof(float) * MLAS_SPARSE_GEMM_STRIDEN * BlockCount;
+
+    } else {
+
+        if (StructuredCost > MLAS_SPARSE_GEMM_MAXIMUM_DENSITY) {
+            return 0;
+        }
+
+        *Format = MlasSparseGemmStructured;
+
+        const size_t SlotCount = PanelCount * GroupCount * GroupNonzeroCount * MLAS_SPARSE_GEMM_STRIDEN;
+
+        BytesRequired = MlasSparseGemmAlignOffset(BytesRequired);
+        BytesRequired += sizeof(float) * SlotCount;
+        BytesRequired += sizeof(uint8_t) * SlotCount;
+    }
+
+    return MlasSparseGemmAlignOffset(BytesRequired);
+}
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    MLAS_SPARSE_GEMM_FORMAT Format,
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs matrix B in the format selected by
+    MlasSparseGemmPackBSize.
+
+Arguments:
+
+    Format - Supplies the format returned by MlasSparseGemmPackBSize.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of the packed buffer. The buffer must be
+        at least the size returned by MlasSparseGemmPackBSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t BlockCount;
+    size_t GroupNonzeroCount;
+
+    MlasSparseGemmAnalyzeB(TransB, N, K, B, ldb, &BlockCount, &GroupNonzeroCount);
+
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_GEMM_STRIDEN);
+    const size_t GroupCount = MlasDivRoundup(K, MLAS_SPARSE_GEMM_GROUP_SIZE);
+
+    auto* Header = reinterpret_cast<MLAS_SPARSE_GEMM_PACKED_HEADER*>(PackedB);
+    uint8_t* Buffer = reinterpret_cast<uint8_t*>(PackedB);
+
+    Header->Format = uint32_t(Format);
+    Header->N = uint32_t(N);
+    Header->K = uint32_t(K);
+
+    if (Format == MlasSparseGemmBlockCsr) {
+
+        Header->Count = uint32_t(BlockCount);
+
+        uint32_t* PanelOffsets = reinterpret_cast<uint32_t*>(Header + 1);
+        uint32_t* BlockRows = PanelOffsets + PanelCount + 1;
+        float* Values = reinterpret_cast<float*>(Buffer +
+            MlasSparseGemmAlignOffset(reinterpret_cast<uint8_t*>(BlockRows + BlockCount) - Buffer));
+
+        size_t Block = 0;
+
+        for (size_t n = 0; n < N; n += MLAS_SPARSE_GEMM_STRIDEN) {
+
+            const size_t CountN = std::min(N - n, MLAS_SPARSE_GEMM_STRIDEN);
+
+            *PanelOffsets++ = uint32_t(Block);
+
+            for (size_t k = 0; k < K; k++) {
+
+                float Row[MLAS_SPARSE_GEMM_STRIDEN] = {};
+                bool IsNonzeroBlock = false;
+
+                for (size_t nn = 0; nn < CountN; nn++) {
+                    Row[nn] = MlasSparseGemmElementB(TransB, B, ldb, k, n + nn);
+                    IsNonzeroBlock |= (Row[nn] != 0.0f);
+                }
+
+                if (IsNonzeroBlock) {
+                    BlockRows[Block] = uint32_t(k);
+                    std::copy_n(Row, MLAS_SPARSE_GEMM_STRIDEN, Values + Block * MLAS_SPARSE_GEMM_STRIDEN);
+                    Block++;
+                }
+            }
+        }
+
+        *PanelOffsets = uint32_t(Block);
+
+    } else {
+
+        Header->Count = uint32_t(GroupNonzeroCount);
+
+        const size_t SlotCount = PanelCount * GroupCount * GroupNonzeroCount * MLAS_SPARSE_GEMM_STRIDEN;
+
+        float* Values = reinterpret_cast<float*>(Buffer +
+            MlasSparseGemmAlignOffset(sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER)));
+        uint8_t* Indices = reinterpret_cast<uint8_t*>(Values + SlotCount);
+
+        std::fill_n(Values, SlotCount, 0.0f);
+        std::fill_n(Indices, SlotCount, uint8_t(0));
+
+        for (size_t n = 0; n < N; n += MLAS_SPARSE_GEMM_STRIDEN) {
+
+            const size_t CountN = std::min(N - n, MLAS_SPARSE_GEMM_STRIDEN);
+
+            for (size_t k = 0; k < K; k += MLAS_SPARSE_GEMM_GROUP_SIZE) {
+
+                const size_t CountK = std::min(K - k, MLAS_SPARSE_GEMM_GROUP_SIZE);
+
+                for (size_t nn = 0; nn < CountN; nn++) {
+
+                    size_t Slot = 0;
+
+                    for (size_t kk = 0; kk < CountK; kk++) {
+
+                        const float Value = MlasSparseGemmElementB(TransB, B, ldb, k + kk, n + nn);
+
+                        if (Value != 0.0f) {
+                            Values[Slot * MLAS_SPARSE_GEMM_STRIDEN + nn] = Value;
+                            Indices[Slot * MLAS_SPARSE_GEMM_STRIDEN + nn] = uint8_t(kk);
+                            Slot++;
+                        }
+                    }
+                }
+
+                Values += GroupNonzeroCount * MLAS_SPARSE_GEMM_STRIDEN;
+                Indices += GroupNonzeroCount * MLAS_SPARSE_GEMM_STRIDEN;
+            }
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasSparseGemmStoreBlock(
+    const MLAS_SPARSE_GEMM_WORK_BLOCK* WorkBlock,
+    const float Accumulators[MLAS_SPARSE_GEMM_STRIDEM][MLAS_SPARSE_GEMM_STRIDEN],
+    size_t CountM,
+    size_t CountN,
+    float* C
+    )
+/*++
+
+Routine Description:
+
+    This routine scales the accumulators of a block of rows by alpha and
+    stores them to matrix C, adding in matrix C scaled by beta.
+
+--*/
+{
+    const float alpha = WorkBlock->alpha;
+    const float beta = WorkBlock->beta;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        float* c = C + m * WorkBlock->ldc;
+
+        for (size_t nn = 0; nn < CountN; nn++) {
+            float Value = alpha * Accumulators[m][nn];
+            if (beta != 0.0f) {
+                Value += beta * c[nn];
+            }
+            c[nn] = Value;
+        }
+    }
+}
+
+void
+MlasSparseGemmBlockCsrKernel(
+    const MLAS_SPARSE_GEMM_WORK_BLOCK* WorkBlock,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t Panel
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a panel of 16 columns of matrix C for a range of
+    rows using matrix B packed in the block sparse format.
+
+--*/
+{
+    const auto* Header = WorkBlock->PackedB;
+    const size_t PanelCount = MlasDivRoundup(Header->N, MLAS_SPARSE_GEMM_STRIDEN);
+
+    const uint32_t* PanelOffsets = reinterpret_cast<const uint32_t*>(Header + 1);
+    const uint32_t* BlockRows = PanelOffsets + PanelCount + 1;
+    const uint8_t* Buffer = reinterpret_cast<const uint8_t*>(Header);
+    const float* Values = reinterpret_cast<const float*>(Buffer +
+        MlasSparseGemmAlignOffset(reinterpret_cast<const uint8_t*>(BlockRows + Header->Count) - Buffer));
+
+    const size_t BlockStart = PanelOffsets[Panel];
+    const size_t BlockEnd = PanelOffsets[Panel + 1];
+
+    const size_t n = Panel * MLAS_SPARSE_GEMM_STRIDEN;
+    const size_t CountN = std::min(WorkBlock->N - n, MLAS_SPARSE_GEMM_STRIDEN);
+
+    const size_t StrideAM = (WorkBlock->TransA == CblasNoTrans) ? WorkBlock->lda : 1;
+    const size_t StrideAK = (WorkBlock->TransA == CblasNoTrans) ? 1 : WorkBlock->lda;
+
+    for (size_t m = RangeStartM; m < RangeStartM + RangeCountM; m += MLAS_SPARSE_GEMM_STRIDEM) {
+
+        const size_t CountM = std::min(RangeStartM + RangeCountM - m, MLAS_SPARSE_GEMM_STRIDEM);
+        const float* A = WorkBlock->A + m * StrideAM;
+
+        MLAS_FLOAT32X4 Accumulators[MLAS_SPARSE_GEMM_STRIDEM][MLAS_SPARSE_GEMM_STRIDEN / 4];
+
+        for (size_t mm = 0; mm < MLAS_SPARSE_GEMM_STRIDEM; mm++) {
+            for (size_t v = 0; v < MLAS_SPARSE_GEMM_STRIDEN / 4; v++) {
+                Accumulators[mm][v] = MlasZeroFloat32x4();
+            }
+        }
+
+        for (size_t Block = BlockStart; Block < BlockEnd; Block++) {
+
+            const float* b = Values + Block * MLAS_SPARSE_GEMM_STRIDEN;
+            const float* a = A + BlockRows[Block] * StrideAK;
+
+            MLAS_FLOAT32X4 BElements[MLAS_SPARSE_GEMM_STRIDEN / 4];
+
+            for (size_t v = 0; v < MLAS_SPARSE_GEMM_STRIDEN / 4; v++) {
+                BElements[v] = MlasLoadFloat32x4(b + v * 4);
+            }
+
+            for (size_t mm = 0; mm < CountM; mm++) {
+
+                MLAS_FLOAT32X4 AElement = MlasBroadcastFloat32x4(a + mm * StrideAM);
+
+                for (size_t v = 0; v < MLAS_SPARSE_GEMM_STRIDEN / 4; v++) {
+                    Accumulators[mm][v] = MlasMultiplyAddFloat32x4(AElement, BElements[v], Accumulators[mm][v]);
+                }
+            }
+        }
+
+        float Output[MLAS_SPARSE_GEMM_STRIDEM][MLAS_SPARSE_GEMM_STRIDEN];
+
+        for (size_t mm = 0; mm < CountM; mm++) {
+            for (size_t v = 0; v < MLAS_SPARSE_GEMM_STRIDEN / 4; v++) {
+                MlasStoreFloat32x4(&Output[mm][v * 4], Accumulators[mm][v]);
+            }
+        }
+
+        MlasSparseGemmStoreBlock(WorkBlock, Output, CountM, CountN, WorkBlock->C + m * WorkBlock->ldc + n);
+    }
+}
+
+void
+MlasSparseGemmStructuredKernel(
+    const MLAS_SPARSE_GEMM_WORK_BLOCK* WorkBlock,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t Panel
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a panel of 16 columns of matrix C for a range of
+    rows using matrix B packed in the structured sparse format.
+
+--*/
+{
+    const auto* Header = WorkBlock->PackedB;
+    const size_t K = Header->K;
+    const size_t GroupNonzeroCount = Header->Count;
+    const size_t GroupCount = MlasDivRoundup(K, MLAS_SPARSE_GEMM_GROUP_SIZE);
+    const size_t PanelCount = MlasDivRoundup(Header->N, MLAS_SPARSE_GEMM_STRIDEN);
+    const size_t SlotCount = PanelCount * GroupCount * GroupNonzeroCount * MLAS_SPARSE_GEMM_STRIDEN;
+    const size_t PanelSlotOffset = Panel * GroupCount * GroupNonzeroCount * MLAS_SPARSE_GEMM_STRIDEN;
+
+    const float* PanelValues = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(Header) +
+        MlasSparseGemmAlignOffset(sizeof(MLAS_SPARSE_GEMM_PACKED_HEADER)));
+    const uint8_t* PanelIndices = reinterpret_cast<const uint8_t*>(PanelValues + SlotCount) + PanelSlotOffset;
+    PanelValues += PanelSlotOffset;
+
+    const size_t n = Panel * MLAS_SPARSE_GEMM_STRIDEN;
+    const size_t CountN = std::min(WorkBlock->N - n, MLAS_SPARSE_GEMM_STRIDEN);
+
+    const size_t StrideAM = (WorkBlock->TransA == CblasNoTrans) ? WorkBlock->lda : 1;
+    const size_t StrideAK = (WorkBlock->TransA == CblasNoTrans) ? 1 : WorkBlock->lda;
+
+    for (size_t m = RangeStartM; m < RangeStartM + RangeCountM; m += MLAS_SPARSE_GEMM_STRIDEM) {
+
+        const size_t CountM = std::min(RangeStartM + RangeCountM - m, MLAS_SPARSE_GEMM_STRIDEM);
+        const float* A = WorkBlock->A + m * StrideAM;
+
+        float Accumulators[MLAS_SPARSE_GEMM_STRIDEM][MLAS_SPARSE_GEMM_STRIDEN] = {};
+
+        const float* Values = PanelValues;
+        const uint8_t* Indices = PanelIndices;
+
+        for (size_t k = 0; k < K; k += MLAS_SPARSE_GEMM_GROUP_SIZE) {
+
+            //
+            // Copy the elements of the group of rows from matrix A. Padding
+            // rows of the last group have zero values in matrix B.
+            //
+
+            const size_t CountK = std::min(K - k, MLAS_SPARSE_GEMM_GROUP_SIZE);
+            float AElements[MLAS_SPARSE_GEMM_STRIDEM][MLAS_SPARSE_GEMM_GROUP_SIZE] = {};
+
+            for (size_t mm = 0; mm < CountM; mm++) {
+                for (size_t kk = 0; kk < CountK; kk++) {
+                    AElements[mm][kk] = A[mm * StrideAM + (k + kk) * StrideAK];
+                }
+            }
+
+            for (size_t Slot = 0; Slot < GroupNonzeroCount; Slot++) {
+
+                for (size_t mm = 0; mm < MLAS_SPARSE_GEMM_STRIDEM; mm++) {
+                    for (size_t nn = 0; nn < MLAS_SPARSE_GEMM_STRIDEN; nn++) {
+                        Accumulators[mm][nn] += AElements[mm][Indices[nn]] * Values[nn];
+                    }
+                }
+
+                Values += MLAS_SPARSE_GEMM_STRIDEN;
+                Indices += MLAS_SPARSE_GEMM_STRIDEN;
+            }
+        }
+
+        MlasSparseGemmStoreBlock(WorkBlock, Accumulators, CountM, CountN, WorkBlock->C + m * WorkBlock->ldc + n);
+    }
+}
+
+void
+MlasSparseGemmThreaded(
+    void* Context,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    sparse SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SPARSE_GEMM_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the panels of matrix B, then along the
+    // blocks of rows of matrix A.
+    //
+
+    const size_t BlockCountM = MlasDivRoundup(WorkBlock->M, MLAS_SPARSE_GEMM_STRIDEM);
+    const size_t PanelCount = MlasDivRoundup(WorkBlock->N, MLAS_SPARSE_GEMM_STRIDEN);
+    const size_t WorkCount = PanelCount * BlockCountM;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(ThreadId, WorkBlock->ThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t Panel = WorkIndex / BlockCountM;
+        const size_t BlockM = WorkIndex % BlockCountM;
+        const size_t BlocksThisPass = std::min(WorkRemaining, BlockCountM - BlockM);
+
+        const size_t RangeStartM = BlockM * MLAS_SPARSE_GEMM_STRIDEM;
+        const size_t RangeCountM = std::min(WorkBlock->M - RangeStartM, BlocksThisPass * MLAS_SPARSE_GEMM_STRIDEM);
+
+        if (WorkBlock->PackedB->Format == MlasSparseGemmBlockCsr) {
+            MlasSparseGemmBlockCsrKernel(WorkBlock, RangeStartM, RangeCountM, Panel);
+        } else {
+            MlasSparseGemmStructuredKernel(WorkBlock, RangeStartM, RangeCountM, Panel);
+        }
+
+        WorkIndex += BlocksThisPass;
+        WorkRemaining -= BlocksThisPass;
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix B packed by MlasSparseGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* Header = reinterpret_cast<const MLAS_SPARSE_GEMM_PACKED_HEADER*>(PackedB);
+
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the number of multiply
+    // accumulate operations. Small requests should run using the single
+    // threaded path.
+    //
+
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_GEMM_STRIDEN);
+    const double NonzerosPerPanel = (Header->Format == MlasSparseGemmBlockCsr) ?
+        double(Header->Count) / double(PanelCount) :
+        double(Header->Count) * double(MlasDivRoundup(Header->K, MLAS_SPARSE_GEMM_GROUP_SIZE));
+    const double Complexity = double(M) * double(N) * NonzerosPerPanel;
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    const size_t WorkCount = PanelCount * MlasDivRoundup(M, MLAS_SPARSE_GEMM_STRIDEM);
+
+    if (size_t(TargetThreadCount) > WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    MLAS_SPARSE_GEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.ThreadCount = TargetThreadCount;
+    WorkBlock.TransA = TransA;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.PackedB = Header;
+    WorkBlock.beta = beta;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+
+    MlasExecuteThreaded(MlasSparseGemmThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+}
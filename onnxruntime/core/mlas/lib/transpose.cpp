@@ -168,6 +168,85 @@ MlasTranspose8x8Block(
     vst1_u8(&Output[OutputStride * 7], vreinterpret_u8_u32(d3.val[1]));
 }
 
+#elif defined(MLAS_WASM_SIMD_INTRINSICS)
+
+MLAS_FORCEINLINE
+void
+MlasTranspose4x4Block(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride
+    )
+{
+    v128_t a0 = wasm_v128_load(&Input[InputStride * 0]);
+    v128_t a1 = wasm_v128_load(&Input[InputStride * 1]);
+    v128_t a2 = wasm_v128_load(&Input[InputStride * 2]);
+    v128_t a3 = wasm_v128_load(&Input[InputStride * 3]);
+
+    v128_t b0 = wasm_i32x4_shuffle(a0, a2, 0, 4, 1, 5);
+    v128_t b1 = wasm_i32x4_shuffle(a0, a2, 2, 6, 3, 7);
+    v128_t b2 = wasm_i32x4_shuffle(a1, a3, 0, 4, 1, 5);
+    v128_t b3 = wasm_i32x4_shuffle(a1, a3, 2, 6, 3, 7);
+
+    v128_t c0 = wasm_i32x4_shuffle(b0, b2, 0, 4, 1, 5);
+    v128_t c1 = wasm_i32x4_shuffle(b0, b2, 2, 6, 3, 7);
+    v128_t c2 = wasm_i32x4_shuffle(b1, b3, 0, 4, 1, 5);
+    v128_t c3 = wasm_i32x4_shuffle(b1, b3, 2, 6, 3, 7);
+
+    wasm_v128_store(&Output[OutputStride * 0], c0);
+    wasm_v128_store(&Output[OutputStride * 1], c1);
+    wasm_v128_store(&Output[OutputStride * 2], c2);
+    wasm_v128_store(&Output[OutputStride * 3], c3);
+}
+
+MLAS_FORCEINLINE
+void
+MlasTranspose8x8Block(
+    const uint8_t* Input,
+    size_t InputStride,
+    uint8_t* Output,
+    size_t OutputStride
+    )
+{
+    v128_t a0 = wasm_v128_load64_zero(&Input[InputStride * 0]);
+    v128_t a1 = wasm_v128_load64_zero(&Input[InputStride * 1]);
+    v128_t b0 = wasm_i8x16_shuffle(a0, a1, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+
+    v128_t a2 = wasm_v128_load64_zero(&Input[InputStride * 2]);
+    v128_t a3 = wasm_v128_load64_zero(&Input[InputStride * 3]);
+    v128_t b1 = wasm_i8x16_shuffle(a2, a3, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+
+    v128_t a4 = wasm_v128_load64_zero(&Input[InputStride * 4]);
+    v128_t a5 = wasm_v128_load64_zero(&Input[InputStride * 5]);
+    v128_t b2 = wasm_i8x16_shuffle(a4, a5, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+
+    v128_t a6 = wasm_v128_load64_zero(&Input[InputStride * 6]);
+    v128_t a7 = wasm_v128_load64_zero(&Input[InputStride * 7]);
+    v128_t b3 = wasm_i8x16_shuffle(a6, a7, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+
+    v128_t c0 = wasm_i16x8_shuffle(b0, b1, 0, 8, 1, 9, 2, 10, 3, 11);
+    v128_t c1 = wasm_i16x8_shuffle(b0, b1, 4, 12, 5, 13, 6, 14, 7, 15);
+    v128_t c2 = wasm_i16x8_shuffle(b2, b3, 0, 8, 1, 9, 2, 10, 3, 11);
+    v128_t c3 = wasm_i16x8_shuffle(b2, b3, 4, 12, 5, 13, 6, 14, 7, 15);
+
+    v128_t d0 = wasm_i32x4_shuffle(c0, c2, 0, 4, 1, 5);
+    wasm_v128_store64_lane(&Output[OutputStride * 0], d0, 0);
+    wasm_v128_store64_lane(&Output[OutputStride * 1], d0, 1);
+
+    v128_t d1 = wasm_i32x4_shuffle(c0, c2, 2, 6, 3, 7);
+    wasm_v128_store64_lane(&Output[OutputStride * 2], d1, 0);
+    wasm_v128_store64_lane(&Output[OutputStride * 3], d1, 1);
+
+    v128_t d2 = wasm_i32x4_shuffle(c1, c3, 0, 4, 1, 5);
+    wasm_v128_store64_lane(&Output[OutputStride * 4], d2, 0);
+    wasm_v128_store64_lane(&Output[OutputStride * 5], d2, 1);
+
+    v128_t d3 = wasm_i32x4_shuffle(c1, c3, 2, 6, 3, 7);
+    wasm_v128_store64_lane(&Output[OutputStride * 6], d3, 0);
+    wasm_v128_store64_lane(&Output[OutputStride * 7], d3, 1);
+}
+
 #endif
 
 template<typename ElementType>
@@ -251,7 +330,7 @@ Return Value:
         uint32_t* d = Output;
         size_t m = M;
 
-#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS) || defined(MLAS_WASM_SIMD_INTRINSICS)
 
         while (m >= 4) {
 
@@ -375,7 +454,7 @@ Return Value:
         uint8_t* d = Output;
         size_t m = M;
 
-#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS) || defined(MLAS_WASM_SIMD_INTRINSICS)
 
         while (m >= 8) {
 
@@ -7,6 +7,7 @@
 #include "core/optimizer/utils.h"
 #include "core/optimizer/attention_fusion_helper.h"
 #include "core/graph/graph_utils.h"
+#include <array>
 #include <cmath>
 
 namespace onnxruntime {
@@ -192,6 +193,13 @@ static NodeArg* ConvertMaskToInt32(
   return output;
 }
 
+// The CPU EP only has a float Attention kernel, although it can run the float16 subgraph the fusion replaces.
+static bool IsAttentionDataTypeSupported(const Node& layer_norm) {
+  static constexpr std::array cpu_supported_data_types{"tensor(float)"};
+  return layer_norm.GetExecutionProviderType() != kCpuExecutionProvider ||
+         optimizer_utils::IsSupportedDataType(layer_norm, cpu_supported_data_types);
+}
+
 Status AttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
@@ -210,7 +218,8 @@ Status AttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
 
     if ((node.GetOutputEdgesCount() >= 2 && node.GetOutputEdgesCount() <= 6) &&  // Add node.GetOutputEdgesCount() == 5/6 for distilbert
         graph_utils::IsSupportedOptypeVersionAndDomain(node, "LayerNormalization", {1}, kOnnxDomain) &&
-        graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+        graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) &&
+        IsAttentionDataTypeSupported(node)) {
       // Get hidden size from layer norm bias tensor shape.
       const NodeArg& layer_norm_bias = *(node.InputDefs()[2]);
       if (!optimizer_utils::IsShapeKnownOnAllDims(layer_norm_bias, 1)) {
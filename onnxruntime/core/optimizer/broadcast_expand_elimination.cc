@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/broadcast_expand_elimination.h"
+
+#include <algorithm>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+// The ONNX operators that broadcast all their inputs to the shape of their output, with the opset version that
+// introduced the multidirectional broadcasting.
+const InlinedHashMap<std::string, int>& BroadcastingOpTypes() {
+  static const InlinedHashMap<std::string, int> op_types = {
+      {"Add", 7}, {"Sub", 7}, {"Mul", 7}, {"Div", 7}, {"Pow", 7}, {"And", 7}, {"Or", 7}, {"Xor", 7}, {"Equal", 7},
+      {"Less", 7}, {"Greater", 7}, {"LessOrEqual", 12}, {"GreaterOrEqual", 12}, {"Max", 8}, {"Min", 8},
+      {"Sum", 8}, {"Mean", 8}, {"Where", 9}};
+  return op_types;
+}
+
+// A dimension of a broadcast shape, where nullptr is a dimension of 1.
+using BroadcastDim = const TensorShapeProto_Dimension*;
+
+bool IsSameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+
+  return utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param();
+}
+
+// Broadcasts the shapes aligned at their trailing dimension. Returns false if a dimension of the result can not
+// be determined, which is when two dimensions other than 1 are not known to be the same.
+bool BroadcastShapes(const InlinedVector<const TensorShapeProto*>& shapes, InlinedVector<BroadcastDim>& result) {
+  int rank = 0;
+  for (const auto* shape : shapes) {
+    rank = std::max(rank, shape->dim_size());
+  }
+
+  result.assign(rank, nullptr);
+  for (const auto* shape : shapes) {
+    const int offset = rank - shape->dim_size();
+    for (int i = 0; i < shape->dim_size(); ++i) {
+      const auto& dim = shape->dim(i);
+      if (utils::HasDimValue(dim) && dim.dim_value() == 1) {
+        continue;
+      }
+
+      BroadcastDim& result_dim = result[offset + i];
+      if (result_dim == nullptr) {
+        result_dim = &dim;
+      } else if (!IsSameDim(*result_dim, dim)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Returns the index of the input of consumer that is the output of the Expand node if consumer broadcasts its
+// inputs and its output is the same when that input is replaced by the input of the Expand node, or -1.
+int GetReplaceableInputIndex(const Node& expand, const Node& consumer) {
+  const auto op_type = BroadcastingOpTypes().find(consumer.OpType());
+  if (op_type == BroadcastingOpTypes().end() || !graph_utils::MatchesOpSetDomain(consumer, kOnnxDomain) ||
+      consumer.SinceVersion() < op_type->second) {
+    return -1;
+  }
+
+  const NodeArg* expand_output = expand.OutputDefs()[0];
+  int input_index = -1;
+  InlinedVector<const TensorShapeProto*> expanded_shapes{expand_output->Shape()};
+  InlinedVector<const TensorShapeProto*> input_shapes{expand.InputDefs()[0]->Shape()};
+  const auto& consumer_inputs = consumer.InputDefs();
+  for (int i = 0; i < static_cast<int>(consumer_inputs.size()); ++i) {
+    if (consumer_inputs[i] == expand_output) {
+      // the Expand node must feed a single input of the consumer.
+      if (input_index != -1) {
+        return -1;
+      }
+      input_index = i;
+    } else if (consumer_inputs[i]->Exists()) {
+      const auto* shape = consumer_inputs[i]->Shape();
+      if (shape == nullptr) {
+        return -1;
+      }
+      expanded_shapes.push_back(shape);
+      input_shapes.push_back(shape);
+    }
+  }
+
+  InlinedVector<BroadcastDim> expanded_output;
+  InlinedVector<BroadcastDim> output;
+  if (input_index == -1 || !BroadcastShapes(expanded_shapes, expanded_output) ||
+      !BroadcastShapes(input_shapes, output) || output.size() != expanded_output.size()) {
+    return -1;
+  }
+
+  for (size_t i = 0; i < output.size(); ++i) {
+    if ((output[i] == nullptr) != (expanded_output[i] == nullptr) ||
+        (output[i] != nullptr && !IsSameDim(*output[i], *expanded_output[i]))) {
+      return -1;
+    }
+  }
+
+  return input_index;
+}
+
+}  // namespace
+
+Status BroadcastExpandElimination::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+                                         const logging::Logger&) const {
+  NodeArg& input = *node.MutableInputDefs()[0];
+  const Node::EdgeEnd* input_edge = graph_utils::GetInputEdge(node, 0);
+  const NodeIndex input_node_index = input_edge != nullptr ? input_edge->GetNode().Index() : 0;
+  const int input_node_output_index = input_edge != nullptr ? input_edge->GetSrcArgIndex() : 0;
+
+  // find the consumers first, as the output edges change while they are moved to the input.
+  InlinedVector<std::pair<NodeIndex, int>> consumers;
+  for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+    const int input_index = GetReplaceableInputIndex(node, it->GetNode());
+    if (input_index != -1 && input_index == it->GetDstArgIndex()) {
+      consumers.push_back({it->GetNode().Index(), input_index});
+    }
+  }
+
+  for (const auto& consumer : consumers) {
+    graph.RemoveEdge(node.Index(), consumer.first, 0, consumer.second);
+    graph_utils::ReplaceNodeInput(*graph.GetNode(consumer.first), consumer.second, input);
+    if (input_edge != nullptr) {
+      graph.AddEdge(input_node_index, consumer.first, input_node_output_index, consumer.second);
+    }
+  }
+
+  if (node.GetOutputEdgesCount() == 0 && !graph.NodeProducesGraphOutput(node)) {
+    graph.RemoveNode(node.Index());
+    rule_effect = RewriteRuleEffect::kRemovedCurrentNode;
+  } else {
+    rule_effect = RewriteRuleEffect::kModifiedRestOfGraph;
+  }
+
+  return Status::OK();
+}
+
+bool BroadcastExpandElimination::SatisfyCondition(const Graph&, const Node& node, const logging::Logger&) const {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Expand", {8, 13}) ||
+      node.InputDefs()[0]->Shape() == nullptr || node.OutputDefs()[0]->Shape() == nullptr) {
+    return false;
+  }
+
+  for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+    if (GetReplaceableInputIndex(node, it->GetNode()) == it->GetDstArgIndex()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/rewrite_rule.h"
+
+namespace onnxruntime {
+
+/**
+@Class BroadcastExpandElimination
+
+Rewrite rule that feeds the input of an Expand node directly to the consumers that broadcast their inputs, when
+the consumer's output is the same without the Expand. E.g. an attention mask of shape [B, 1, 1, S] expanded to
+[B, H, S, S] before being added to the attention scores of shape [B, H, S, S].
+
+The Expand node is removed once it has no consumers left.
+
+It is attempted to be triggered only on nodes with op type "Expand".
+*/
+class BroadcastExpandElimination : public RewriteRule {
+ public:
+  BroadcastExpandElimination() noexcept : RewriteRule("BroadcastExpandElimination") {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {"Expand"};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
+
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -5,6 +5,8 @@
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
@@ -32,6 +34,13 @@
 // first every graph input, constant initializer and graph node output are assigned
 // an equivalence class, and then nodes that have the same operation and equivalent inputs
 // are collapsed.
+//
+// The inputs of commutative operations are put in a canonical order, so that e.g. Add(a, b) and Add(b, a) are
+// merged, and attributes that are set to the default value of the operator schema are treated as absent.
+//
+// Nodes of a subgraph that only consume values of the graph containing the subgraph are also replaced with the
+// equivalent values of that graph, if it computes them, so that e.g. a mask computed in the main graph and again in
+// the branches of an If is computed once.
 
 namespace onnxruntime {
 
@@ -76,6 +85,16 @@ void UpdateHashWithContainer(const Container& c, std::size_t& hash) {
 
 using OutputIndex = int;
 
+// Operations whose result doesn't depend on the order of their two inputs.
+bool IsCommutative(const Node& node) {
+  static const InlinedHashSet<std::string_view> commutative_ops = {
+      "Add", "Mul", "And", "Or", "Xor", "Equal", "Max", "Min", "Sum", "Mean"};
+  return node.Domain() == kOnnxDomain && commutative_ops.count(node.OpType()) > 0;
+}
+
+// Returns the attributes of the node that are not set to the default value of the attribute, sorted by name.
+InlinedVector<const ONNX_NAMESPACE::AttributeProto*> NormalizeAttributes(const Node& node);
+
 constexpr OutputIndex kInvalidOutputIndex = -1;
 
 const NodeArg* Normalize(const NodeArg* node_arg) {
@@ -92,8 +111,7 @@ class EquivalenceClass {
   friend InlinedVector<InlinedVector<const EquivalenceClass*>> Normalize(const Node& node, gsl::span<const EquivalenceClass* const> inputs);
 
   explicit EquivalenceClass(const NodeArg* non_op_value)
-      : attributes_(nullptr),
-        output_index_(kInvalidOutputIndex),
+      : output_index_(kInvalidOutputIndex),
         non_op_value_(Normalize(non_op_value)),
         discriminator_(0),
         hash_(CalculateHash()) {
@@ -104,7 +122,7 @@ class EquivalenceClass {
       : op_type_(node.OpType()),
         domain_(node.Domain()),
         inputs_(Normalize(node, explicit_inputs)),
-        attributes_(&node.GetAttributes()),
+        attributes_(NormalizeAttributes(node)),
         output_index_(output_index),
         non_op_value_(nullptr),
         discriminator_(discriminator),
@@ -121,8 +139,8 @@ class EquivalenceClass {
   // Explicit inputs to the operation, sequence of inputs for each formal parameter.
   const InlinedVector<InlinedVector<const EquivalenceClass*>> inputs_;
 
-  // Attributes of the operation.
-  const NodeAttributes* attributes_;
+  // Attributes of the operation that are not set to their default value, sorted by name.
+  const InlinedVector<const ONNX_NAMESPACE::AttributeProto*> attributes_;
 
   // Index of this value in the output list of the operation.
   const OutputIndex output_index_;
@@ -161,6 +179,17 @@ InlinedVector<InlinedVector<const EquivalenceClass*>> Normalize(const Node& node
     }
   }
 
+  // Order the two inputs of a commutative operation by value number. Variadic operations with more inputs are left
+  // alone, as their floating point result depends on the order in which the inputs are accumulated.
+  if (IsCommutative(node)) {
+    std::less<const EquivalenceClass*> less;
+    if (result.size() == 2 && result[0].size() == 1 && result[1].size() == 1 && less(result[1][0], result[0][0])) {
+      std::swap(result[0], result[1]);
+    } else if (result.size() == 1 && result[0].size() == 2 && less(result[0][1], result[0][0])) {
+      std::swap(result[0][0], result[0][1]);
+    }
+  }
+
   return result;
 }
 
@@ -247,16 +276,35 @@ std::size_t GetAttributeHash(const ONNX_NAMESPACE::AttributeProto& attr) {
   return hash;
 }
 
-bool SameAttribute(const NodeAttributes::value_type& lhs, const NodeAttributes::value_type& rhs) {
-  return lhs.first == rhs.first && AreEqual(lhs.second, rhs.second);
+InlinedVector<const ONNX_NAMESPACE::AttributeProto*> NormalizeAttributes(const Node& node) {
+  const auto* schema = node.Op();
+  InlinedVector<const ONNX_NAMESPACE::AttributeProto*> result;
+  result.reserve(node.GetAttributes().size());
+  for (const auto& kv : node.GetAttributes()) {
+    if (schema != nullptr) {
+      auto it = schema->attributes().find(kv.first);
+      if (it != schema->attributes().end() && it->second.default_value.type() == kv.second.type() &&
+          AreEqual(it->second.default_value, kv.second)) {
+        continue;
+      }
+    }
+    result.push_back(&kv.second);
+  }
+
+  std::sort(result.begin(), result.end(),
+            [](const ONNX_NAMESPACE::AttributeProto* lhs, const ONNX_NAMESPACE::AttributeProto* rhs) {
+              return lhs->name() < rhs->name();
+            });
+  return result;
 }
 
-bool SameAttributes(const NodeAttributes* lhs, const NodeAttributes* rhs) {
-  if (lhs == nullptr || rhs == nullptr) {
-    return lhs == rhs;
-  }
-  return lhs->size() == rhs->size() &&
-         std::equal(lhs->begin(), lhs->end(), rhs->begin(), &SameAttribute);
+bool SameAttributes(gsl::span<const ONNX_NAMESPACE::AttributeProto* const> lhs,
+                    gsl::span<const ONNX_NAMESPACE::AttributeProto* const> rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin(),
+                    [](const ONNX_NAMESPACE::AttributeProto* l, const ONNX_NAMESPACE::AttributeProto* r) {
+                      return AreEqual(*l, *r);
+                    });
 }
 
 bool EquivalenceClass::operator==(const EquivalenceClass& other) const {
@@ -280,11 +328,8 @@ std::size_t EquivalenceClass::CalculateHash() const {
   UpdateHash(non_op_value_, hash);
   UpdateHash(op_type_, hash);
   UpdateHash(domain_, hash);
-  if (attributes_ != nullptr) {
-    for (const auto& kv : *attributes_) {
-      UpdateHash(kv.first, hash);
-      UpdateHash(kv.second, &GetAttributeHash, hash);
-    }
+  for (const auto* attr : attributes_) {
+    UpdateHash(*attr, &GetAttributeHash, hash);
   }
 
   for (const auto& arg : inputs_) {
@@ -341,6 +386,113 @@ struct hash<onnxruntime::EquivalenceClass> {
 
 namespace onnxruntime {
 
+namespace {
+using EquivalenceClassMap =
+    std::unordered_map<const NodeArg*, const EquivalenceClass*, NodeArgPtrHash, NodeArgPtrEquality>;
+using RepresentativeMap =
+    std::unordered_map<const EquivalenceClass*, Representative, DeepPointerHash, DeepPointerEquality>;
+
+// Replaces the nodes of subgraph that compute a value from outer scope values only, with the equivalent value
+// computed in the graph containing the subgraph. Only values computed by nodes that precede the node containing the
+// subgraph in topological order are available in equivalence_classes and value_to_representative, so the
+// replacement never introduces a cycle.
+bool ReplaceWithOuterScopeValues(const Graph& graph, Graph& subgraph,
+                                 const EquivalenceClassMap& equivalence_classes,
+                                 const RepresentativeMap& value_to_representative,
+                                 const logging::Logger& logger) {
+  // Names of values in the subgraph that now refer to values of graph, and their equivalence class in graph.
+  InlinedHashMap<std::string, const EquivalenceClass*> outer_values;
+  auto get_outer_value = [&](const NodeArg* node_arg) -> const EquivalenceClass* {
+    if (!node_arg->Exists()) {
+      return nullptr;
+    }
+
+    auto replaced = outer_values.find(node_arg->Name());
+    if (replaced != outer_values.end()) {
+      return replaced->second;
+    }
+
+    if (!subgraph.IsOuterScopeValue(node_arg->Name())) {
+      return nullptr;
+    }
+
+    const NodeArg* outer_node_arg = graph.GetNodeArg(node_arg->Name());
+    if (outer_node_arg == nullptr) {
+      return nullptr;
+    }
+
+    auto it = equivalence_classes.find(outer_node_arg);
+    return it == equivalence_classes.end() ? nullptr : it->second;
+  };
+
+  InlinedHashSet<const NodeArg*> subgraph_outputs;
+  subgraph_outputs.insert(subgraph.GetOutputs().begin(), subgraph.GetOutputs().end());
+
+  bool modified = false;
+  GraphViewer subgraph_viewer(subgraph);
+  for (NodeIndex node_index : subgraph_viewer.GetNodesInTopologicalOrder()) {
+    Node* node = subgraph.GetNode(node_index);
+    if (node == nullptr || !IsNodeSupported(*node) || node->OutputDefs().size() != 1) {
+      continue;
+    }
+
+    InlinedVector<const EquivalenceClass*> input_values;
+    input_values.reserve(node->InputDefs().size());
+    for (const NodeArg* input_def : node->InputDefs()) {
+      const EquivalenceClass* value = get_outer_value(input_def);
+      if (value == nullptr) {
+        break;
+      }
+      input_values.push_back(value);
+    }
+
+    if (input_values.size() != node->InputDefs().size()) {
+      continue;
+    }
+
+    const NodeArg* output_def = node->OutputDefs()[0];
+    if (subgraph_outputs.count(output_def) > 0) {
+      continue;
+    }
+
+    EquivalenceClass equivalence_class(*node, input_values, 0, 0);
+    auto it = value_to_representative.find(&equivalence_class);
+    if (it == value_to_representative.end()) {
+      continue;
+    }
+
+    // Nested subgraphs would need their implicit inputs renamed; leave those nodes alone.
+    auto consumers = subgraph.GetMutableConsumerNodes(output_def->Name());
+    bool all_explicit = std::all_of(consumers.begin(), consumers.end(), [output_def](const Node* consumer) {
+      const auto& input_defs = consumer->InputDefs();
+      return std::find(input_defs.begin(), input_defs.end(), output_def) != input_defs.end();
+    });
+    if (!all_explicit) {
+      continue;
+    }
+
+    const NodeArg& representative = *it->second.node_arg;
+    NodeArg& outer_value = subgraph.GetOrCreateNodeArg(representative.Name(), representative.TypeAsProto());
+    graph_utils::RemoveNodeOutputEdges(subgraph, *node);
+    for (Node* consumer : consumers) {
+      for (int i = 0, end = static_cast<int>(consumer->InputDefs().size()); i < end; ++i) {
+        if (consumer->InputDefs()[i] == output_def) {
+          graph_utils::ReplaceNodeInput(*consumer, i, outer_value);
+        }
+      }
+    }
+
+    LOGS(logger, VERBOSE) << "Replaced output " << output_def->Name() << " of node " << node->Name() << "["
+                          << node->OpType() << "] with outer scope value " << representative.Name();
+    outer_values.emplace(representative.Name(), it->first);
+    subgraph.RemoveNode(node_index);
+    modified = true;
+  }
+
+  return modified;
+}
+}  // namespace
+
 Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
@@ -350,16 +502,12 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
   unique_equivalence_classes.reserve(graph.NumberOfNodes());
 
   // Maps an equivalence class of values to a representative NodeArg that belongs to this class.
-  std::unordered_map<
-      const EquivalenceClass*,
-      Representative,
-      DeepPointerHash, DeepPointerEquality>
-      value_to_representative;
+  RepresentativeMap value_to_representative;
 
   // Maps every NodeArg to its equivalence class of.
   // This is the inverse of the above mapping, except that different NodeArgs can belong to the same
   // equivalence class. In that case these NodeArgs will be "merged" into one.
-  std::unordered_map<const NodeArg*, const EquivalenceClass*, NodeArgPtrHash, NodeArgPtrEquality> equivalence_classes;
+  EquivalenceClassMap equivalence_classes;
 
   int unique_discriminator = 1;
 
@@ -370,6 +518,12 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
 
     ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
 
+    for (auto& entry : node->GetAttributeNameToMutableSubgraphMap()) {
+      if (ReplaceWithOuterScopeValues(graph, *entry.second, equivalence_classes, value_to_representative, logger)) {
+        modified = true;
+      }
+    }
+
     InlinedVector<const EquivalenceClass*> input_values;
     input_values.reserve(node->InputDefs().size());
     for (const NodeArg* input_def : node->InputDefs()) {
@@ -9,6 +9,7 @@
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime::common;
 
@@ -89,17 +90,221 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
   return is_concrete_shape;  // convert to constant if this is true
 }
 
-Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  bool have_updated_nodes = false;
-  GraphViewer graph_viewer(graph);
-  auto& order = graph_viewer.GetNodesInTopologicalOrder();
+// Returns true if the node can be folded by computing it with the CPU EP, and sets its constant inputs.
+bool ConstantFolding::CanComputeNode(const Graph& graph, const Node& node, InitializedTensorSet& constant_inputs) const {
+  // we currently constant fold using the CPU EP only.
+  // if the node is assigned to a different EP we can run it if it's an ONNX op as we have CPU based
+  // implementations for all ONNX ops. If the node/op is from a different op domain or if the CPU implementation
+  // does not support the specific input type(s) required by the node (currently we only support a subset of
+  // types in some CPU kernels) then we can't proceed with constant folding for the node.
+  const bool cpu_ep = node.GetExecutionProviderType() == kCpuExecutionProvider;
+  if (!cpu_ep && node.Domain() != kOnnxDomain) {
+    return false;
+  }
+
+  // Check if constant folding can be applied on this node.
+  return graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) &&
+         optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType()) &&
+         // constant folding does not support executing a node that includes subgraphs (control flow operators,
+         // such as If/Loop/Scan, fall into this category). individual nodes in the subgraph will be processed
+         // by the Recurse call in ApplyImpl
+         !node.ContainsSubgraph() &&
+         graph_utils::AllNodeInputsAreConstant(graph, node, constant_inputs, excluded_initializers_);
+}
 
+// Computes the outputs of a node whose inputs are all constant with the CPU EP.
+// `fetches` is left empty if there is no CPU kernel for the node.
+// Only the node itself is modified, so different nodes can be computed concurrently.
+Status ConstantFolding::ComputeNode(const Graph& graph, Node& node, const InitializedTensorSet& constant_inputs,
+                                    const logging::Logger& logger, std::vector<OrtValue>& fetches) const {
 #if !defined(DISABLE_SPARSE_TENSORS)
   std::function<bool(const std::string&)> is_sparse_initializer_check = [&graph](const std::string& name) -> bool {
     return graph.IsSparseInitializer(name);
   };
+  // Create execution frame for executing constant nodes.
+  OptimizerExecutionFrame::Info info({&node}, constant_inputs, graph.ModelPath(), execution_provider_,
+                                     is_sparse_initializer_check);
+#else
+  // Create execution frame for executing constant nodes.
+  OptimizerExecutionFrame::Info info({&node}, constant_inputs, graph.ModelPath(), execution_provider_,
+                                     [](std::string const&) { return false; });
 #endif
 
+  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_out : node.OutputDefs()) {
+    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+  }
+
+  // override the EP assigned to the node so that it will use the CPU kernel for Compute.
+  const auto ep_type = node.GetExecutionProviderType();
+  const bool cpu_ep = ep_type == kCpuExecutionProvider;
+  if (!cpu_ep) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  auto kernel = info.CreateKernel(&node);
+
+  // undo the EP change to the value that was assigned at graph partitioning time
+  if (!cpu_ep) {
+    node.SetExecutionProviderType(ep_type);
+  }
+
+  if (kernel == nullptr) {
+    LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
+                          << "can't constant fold " << node.OpType() << " node '" << node.Name() << "'";
+    return Status::OK();
+  }
+
+  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
+
+  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
+  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+
+  ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+  ORT_ENFORCE(fetches.size() == node.OutputDefs().size());
+  return Status::OK();
+}
+
+// Adds the computed outputs of a node to the graph as initializers. Returns false if an output is not a tensor.
+static bool AddOutputsAsInitializers(Graph& graph, Node& node, const std::vector<OrtValue>& fetches,
+                                     const logging::Logger& logger) {
+  if (fetches.empty()) {
+    return false;
+  }
+
+  for (const OrtValue& ort_value : fetches) {
+    // XXX: Add support for SparseTensors outputs when we have sparse outputs
+    if (!ort_value.IsTensor()) {
+      LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
+                            << ". Can't constant fold " << node.OpType() << " node '" << node.Name() << "'";
+      return false;
+    }
+  }
+
+  // Go over all output node args and substitute them with the newly computed tensors, which will be
+  // added to the graph as initializers.
+  for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+    const OrtValue& ort_value = fetches[fetch_idx];
+    // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
+    auto* constant_arg_out = node.MutableOutputDefs()[fetch_idx];
+    const Tensor& out_tensor = ort_value.Get<Tensor>();
+    ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+
+    ONNX_NAMESPACE::TensorShapeProto result_shape;
+    for (auto& dim : out_tensor.Shape().GetDims()) {
+      result_shape.add_dim()->set_dim_value(dim);
+    }
+
+    constant_arg_out->SetShape(result_shape);
+    graph.AddInitializedTensor(out_tensorproto);
+  }
+
+  return true;
+}
+
+// Removes a node whose outputs were converted to initializers.
+static void RemoveConstantNode(Graph& graph, Node& node) {
+  // Remove single-output node chain for inputs of the node
+  auto p_ip_node = node.InputNodesBegin();
+  const auto p_ip_node_end = node.InputNodesEnd();
+  while (p_ip_node != p_ip_node_end) {
+    const auto& input_node = *p_ip_node;
+    // Update the node iterator before removing the corresponding node because removing
+    // the node will invalidate the node iterator
+    ++p_ip_node;
+    graph_utils::RemoveNodesWithOneOutputBottomUp(graph, input_node);
+  }
+
+  // Remove the output edges of the constant node and then remove the node itself.
+  graph_utils::RemoveNodeOutputEdges(graph, node);
+  graph.RemoveNode(node.Index());
+}
+
+Status ConstantFolding::FoldNodesConcurrently(Graph& graph, bool& modified, const logging::Logger& logger) const {
+  // nodes that were computed but couldn't be folded. they are left to the serial pass rather than computed again in
+  // every wave.
+  InlinedHashSet<NodeIndex> unfoldable_nodes;
+  for (;;) {
+    struct FoldableNode {
+      NodeIndex node_index;
+      InitializedTensorSet constant_inputs;
+      std::vector<OrtValue> fetches;
+      Status status;
+    };
+
+    // the nodes whose inputs are all constant are independent of each other
+    std::vector<FoldableNode> foldable_nodes;
+    {
+      GraphViewer graph_viewer(graph);
+      for (NodeIndex i : graph_viewer.GetNodesInTopologicalOrder()) {
+        auto* node = graph.GetNode(i);
+        if (!node || node->OpType() == "Shape" || unfoldable_nodes.count(i) > 0 ||
+            (skip_dequantize_linear_ && node->OpType().compare("DequantizeLinear") == 0)) {
+          continue;
+        }
+
+        InitializedTensorSet constant_inputs;
+        if (CanComputeNode(graph, *node, constant_inputs)) {
+          foldable_nodes.push_back({i, std::move(constant_inputs), {}, Status::OK()});
+        }
+      }
+    }
+
+    // leave a single node to the serial pass
+    if (foldable_nodes.size() < 2) {
+      return Status::OK();
+    }
+
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        GetThreadPool(), static_cast<std::ptrdiff_t>(foldable_nodes.size()), [&](std::ptrdiff_t i) {
+          auto& foldable_node = foldable_nodes[i];
+          ORT_TRY {
+            foldable_node.status = ComputeNode(graph, *graph.GetNode(foldable_node.node_index),
+                                               foldable_node.constant_inputs, logger, foldable_node.fetches);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              foldable_node.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+        });
+
+    bool folded = false;
+    for (auto& foldable_node : foldable_nodes) {
+      ORT_RETURN_IF_ERROR(foldable_node.status);
+      auto* node = graph.GetNode(foldable_node.node_index);
+      if (node == nullptr) {
+        continue;
+      }
+
+      if (AddOutputsAsInitializers(graph, *node, foldable_node.fetches, logger)) {
+        RemoveConstantNode(graph, *node);
+        folded = true;
+      } else {
+        unfoldable_nodes.insert(foldable_node.node_index);
+      }
+    }
+
+    if (!folded) {
+      return Status::OK();
+    }
+    modified = true;
+  }
+}
+
+Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  bool have_updated_nodes = false;
+
+  // Fold the nodes that only depend on initializers concurrently first. Only the main graph is folded concurrently
+  // as the subgraphs may already be transformed on the thread pool.
+  if (graph_level == 0 && concurrency::ThreadPool::DegreeOfParallelism(GetThreadPool()) > 1) {
+    ORT_RETURN_IF_ERROR(FoldNodesConcurrently(graph, have_updated_nodes, logger));
+    modified = modified || have_updated_nodes;
+  }
+
+  GraphViewer graph_viewer(graph);
+  auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
   for (NodeIndex i : order) {
     auto* node = graph.GetNode(i);
     if (!node) {
@@ -126,120 +331,17 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       converted_to_constant = ConstantFoldShapeNode(graph, *node);
     } else {
       InitializedTensorSet constant_inputs;
-
-      // we currently constant fold using the CPU EP only.
-      // if the node is assigned to a different EP we can run it if it's an ONNX op as we have CPU based
-      // implementations for all ONNX ops. If the node/op is from a different op domain or if the CPU implementation
-      // does not support the specific input type(s) required by the node (currently we only support a subset of
-      // types in some CPU kernels) then we can't proceed with constant folding for the node.
-      auto ep_type = node->GetExecutionProviderType();
-      bool cpu_ep = ep_type == kCpuExecutionProvider;
-      if (!cpu_ep && node->Domain() != kOnnxDomain) {
-        continue;
-      }
-
-      // Check if constant folding can be applied on this node.
-      if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) ||
-          !optimizer_utils::IsOperationDeterministic(node->Domain(), node->OpType()) ||
-          // constant folding does not support executing a node that includes subgraphs (control flow operators,
-          // such as If/Loop/Scan, fall into this category). individual nodes in the subgraph will be processed
-          // by the Recurse call above
-          node->ContainsSubgraph() || !graph_utils::AllNodeInputsAreConstant(graph, *node, constant_inputs, excluded_initializers_)) {
-        continue;
-      }
-
-#if !defined(DISABLE_SPARSE_TENSORS)
-      // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
-                                         is_sparse_initializer_check);
-#else
-      // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
-                                         [](std::string const&) { return false; });
-#endif
-
-      std::vector<int> fetch_mlvalue_idxs;
-      for (const auto* node_out : node->OutputDefs()) {
-        fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
-      }
-
-      // override the EP assigned to the node so that it will use the CPU kernel for Compute.
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(kCpuExecutionProvider);
-      }
-
-      auto kernel = info.CreateKernel(node);
-
-      // undo the EP change to the value that was assigned at graph partitioning time
-      if (!cpu_ep) {
-        node->SetExecutionProviderType(ep_type);
-      }
-
-      if (kernel == nullptr) {
-        LOGS(logger, WARNING) << "Could not find a CPU kernel and hence "
-                              << "can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-
-        // Move on to the next candidate node
+      if (!CanComputeNode(graph, *node, constant_inputs)) {
         continue;
       }
 
-      OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
-
-      OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, logger);
-      ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
-
       std::vector<OrtValue> fetches;
-      ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
-
-      // Go over all output node args and substitute them with the newly computed tensors, which will be
-      // added to the graph as initializers.
-      ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
-      converted_to_constant = true;
-      for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-        OrtValue& ort_value = fetches[fetch_idx];
-        // XXX: Add support for SparseTensors outputs when we have sparse outputs
-        if (!ort_value.IsTensor()) {
-          LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
-                                << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-          converted_to_constant = false;
-          break;
-        }
-      }
-
-      if (converted_to_constant) {
-        for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-          OrtValue& ort_value = fetches[fetch_idx];
-          // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
-          auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
-          const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
-
-          ONNX_NAMESPACE::TensorShapeProto result_shape;
-          for (auto& dim : out_tensor.Shape().GetDims()) {
-            result_shape.add_dim()->set_dim_value(dim);
-          }
-
-          constant_arg_out->SetShape(result_shape);
-          graph.AddInitializedTensor(out_tensorproto);
-        }
-      }
+      ORT_RETURN_IF_ERROR(ComputeNode(graph, *node, constant_inputs, logger, fetches));
+      converted_to_constant = AddOutputsAsInitializers(graph, *node, fetches, logger);
     }
 
     if (converted_to_constant) {
-      // Remove single-output node chain for inputs of the node
-      auto p_ip_node = node->InputNodesBegin();
-      const auto p_ip_node_end = node->InputNodesEnd();
-      while (p_ip_node != p_ip_node_end) {
-        const auto& input_node = *p_ip_node;
-        // Update the node iterator before removing the corresponding node because removing
-        // the node will invalidate the node iterator
-        ++p_ip_node;
-        graph_utils::RemoveNodesWithOneOutputBottomUp(graph, input_node);
-      }
-
-      // Remove the output edges of the constant node and then remove the node itself.
-      graph_utils::RemoveNodeOutputEdges(graph, *node);
-      graph.RemoveNode(node->Index());
+      RemoveConstantNode(graph, *node);
       modified = true;
       have_updated_nodes = true;
     }
@@ -6,6 +6,7 @@
 #include "core/optimizer/graph_transformer.h"
 #include "core/framework/ort_value.h"
 #include <memory>
+#include <vector>
 #include "core/framework/execution_provider.h"
 
 namespace onnxruntime {
@@ -30,6 +31,14 @@ class ConstantFolding : public GraphTransformer {
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+  bool CanComputeNode(const Graph& graph, const Node& node, InitializedTensorSet& constant_inputs) const;
+
+  Status ComputeNode(const Graph& graph, Node& node, const InitializedTensorSet& constant_inputs,
+                     const logging::Logger& logger, std::vector<OrtValue>& fetches) const;
+
+  // Folds the nodes whose inputs are all initializers on the thread pool, repeatedly while several are found.
+  Status FoldNodesConcurrently(Graph& graph, bool& modified, const logging::Logger& logger) const;
+
   bool skip_dequantize_linear_;
   const InlinedHashSet<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
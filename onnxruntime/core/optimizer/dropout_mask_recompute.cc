@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/dropout_mask_recompute.h"
+#include "core/graph/graph_utils.h"
+#include <algorithm>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the NodeArg of input index of node, or an empty NodeArg if the input is not set.
+NodeArg* InputOrEmpty(Graph& graph, Node& node, size_t index) {
+  auto& input_defs = node.MutableInputDefs();
+  if (index < input_defs.size()) {
+    return input_defs[index];
+  }
+  return &graph.GetOrCreateNodeArg("", nullptr);
+}
+
+bool IsDropoutGradOfMask(const Node& node, const NodeArg& mask, const Node& dropout_node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "DropoutGrad", {1}, kMSDomain) ||
+      node.GetExecutionProviderType() != dropout_node.GetExecutionProviderType()) {
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() < 2 || input_defs[1] != &mask) {
+    return false;
+  }
+
+  // The mask must not be used as any other input, and the node must not take a philox_state already.
+  return input_defs[0] != &mask && input_defs.size() <= 4 &&
+         std::none_of(input_defs.begin() + 2, input_defs.end(), [&mask](const NodeArg* arg) { return arg == &mask; });
+}
+
+}  // namespace
+
+Status DropoutMaskRecompute::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const bool is_dropout = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Dropout", {12, 13}, kOnnxDomain);
+    const bool is_bias_dropout = graph_utils::IsSupportedOptypeVersionAndDomain(node, "BiasDropout", {1}, kMSDomain);
+    if ((!is_dropout && !is_bias_dropout) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const auto& output_defs = node.OutputDefs();
+    if (output_defs.size() < 2 || !output_defs[1]->Exists() || graph.IsOutput(output_defs[1]) ||
+        (output_defs.size() > 2 && output_defs[2]->Exists())) {
+      continue;
+    }
+
+    const NodeArg& mask = *output_defs[1];
+    std::vector<Node*> grad_nodes = graph.GetMutableConsumerNodes(mask.Name());
+    if (grad_nodes.empty() ||
+        std::any_of(grad_nodes.begin(), grad_nodes.end(),
+                    [&](const Node* grad_node) { return !IsDropoutGradOfMask(*grad_node, mask, node); })) {
+      continue;
+    }
+
+    // BiasDropout(data, bias, residual, ratio, training_mode). A Dropout has neither bias nor residual.
+    InlinedVector<NodeArg*> dropout_inputs;
+    if (is_dropout) {
+      dropout_inputs = {node.MutableInputDefs()[0],
+                        &graph.GetOrCreateNodeArg("", nullptr),
+                        &graph.GetOrCreateNodeArg("", nullptr),
+                        InputOrEmpty(graph, node, 1),
+                        InputOrEmpty(graph, node, 2)};
+    } else {
+      for (size_t i = 0; i < 5; ++i) {
+        dropout_inputs.push_back(InputOrEmpty(graph, node, i));
+      }
+    }
+
+    NodeArg* philox_state = &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("philox_state"), nullptr);
+    InlinedVector<NodeArg*> dropout_outputs{node.MutableOutputDefs()[0],
+                                            &graph.GetOrCreateNodeArg("", nullptr),
+                                            philox_state};
+
+    const std::string op_type = "BiasDropout";
+    Node& new_dropout_node = graph.AddNode(graph.GenerateNodeName(op_type),
+                                           op_type,
+                                           "Dropout with recomputed mask for " + node.Name(),
+                                           dropout_inputs,
+                                           dropout_outputs,
+                                           {},
+                                           kMSDomain);
+
+    // Get attribute "seed" from the original node if available.
+    const NodeAttributes& dropout_attrs = node.GetAttributes();
+    NodeAttributes::const_iterator seed = dropout_attrs.find("seed");
+    if (seed != dropout_attrs.end()) {
+      new_dropout_node.AddAttributeProto(seed->second);
+    }
+    new_dropout_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    for (Node* grad_node : grad_nodes) {
+      // DropoutGrad(dy, mask, ratio, training_mode, philox_state) without the mask.
+      InlinedVector<NodeArg*> grad_inputs{grad_node->MutableInputDefs()[0],
+                                          &graph.GetOrCreateNodeArg("", nullptr),
+                                          InputOrEmpty(graph, *grad_node, 2),
+                                          InputOrEmpty(graph, *grad_node, 3),
+                                          philox_state};
+
+      Node& new_grad_node = graph.AddNode(graph.GenerateNodeName(grad_node->OpType()),
+                                          grad_node->OpType(),
+                                          "DropoutGrad with recomputed mask for " + grad_node->Name(),
+                                          grad_inputs,
+                                          grad_node->MutableOutputDefs(),
+                                          &grad_node->GetAttributes(),
+                                          kMSDomain);
+      new_grad_node.SetExecutionProviderType(grad_node->GetExecutionProviderType());
+
+      graph_utils::RemoveNodeOutputEdges(graph, *grad_node);
+      graph.RemoveNode(grad_node->Index());
+    }
+
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.Index());
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
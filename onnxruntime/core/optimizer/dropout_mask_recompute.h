@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class DropoutMaskRecompute
+
+Rewrite Dropout and BiasDropout nodes whose mask is only consumed by DropoutGrad nodes, so that the mask is
+regenerated in the backward pass instead of being kept alive from the forward pass:
+
+  Dropout/BiasDropout(X, ...) -> (Y, mask)        BiasDropout(X, ...) -> (Y, philox_state)
+  DropoutGrad(dY, mask, ...)                =>    DropoutGrad(dY, , ..., philox_state)
+
+philox_state is the seed and offset of the random generator the forward pass drew the mask from.
+*/
+class DropoutMaskRecompute : public GraphTransformer {
+ public:
+  DropoutMaskRecompute(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("DropoutMaskRecompute", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Element-wise nodes that consume NCHWc tensors are left to the NCHWc transformer, which already folded what it
+// could into the NCHWc convolutions.
+bool ConsumesNchwcValue(const Node& node) {
+  for (auto it = node.InputNodesBegin(), end = node.InputNodesEnd(); it != end; ++it) {
+    if (it->Domain() == kMSNchwcDomain) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The CUDA kernel runs its chain from kernel arguments, which bounds the number of steps. Longer chains are split.
+constexpr size_t kMaxChainLength = 16;
+
+bool IsFusibleNode(const Node& node) {
+  // the CPU kernel only runs float chains
+  static const std::vector<std::string> cpu_data_types{"tensor(float)"};
+  static const std::vector<std::string> cuda_data_types{"tensor(float)", "tensor(float16)"};
+  const auto& supported_data_types =
+      node.GetExecutionProviderType() == kCudaExecutionProvider ? cuda_data_types : cpu_data_types;
+
+  return (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13})) &&
+         optimizer_utils::IsSupportedDataType(node, supported_data_types) &&
+         !ConsumesNchwcValue(node);
+}
+
+bool IsBinaryNode(const Node& node) {
+  return node.InputDefs().size() == 2;
+}
+
+// Returns true if both shapes are known and equal. Symbolic dimensions are equal if they have the same name.
+bool HaveSameShape(const TensorShapeProto* shape, const TensorShapeProto* other_shape) {
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() != other_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& other_dim = other_shape->dim(i);
+    if (utils::HasDimValue(dim) && utils::HasDimValue(other_dim)) {
+      if (dim.dim_value() != other_dim.dim_value()) {
+        return false;
+      }
+    } else if (utils::HasDimParam(dim) && utils::HasDimParam(other_dim)) {
+      if (dim.dim_param() != other_dim.dim_param()) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// The steps of the FusedElementwise node being built. `inputs` holds the input of the chain followed by the other
+// operands of the binary nodes.
+struct ChainSteps {
+  InlinedVector<NodeArg*> inputs;
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  std::vector<int64_t> operand_first;
+};
+
+// Adds `node` to the chain, whose value is input `chain_input_index` of the node. Returns false if the other input
+// of a binary node doesn't have the shape of the chain or a single element.
+bool AppendStep(Node& node, int chain_input_index, const TensorShapeProto& shape, ChainSteps& steps) {
+  if (!IsBinaryNode(node)) {
+    steps.ops.push_back(node.OpType());
+    steps.operands.push_back(-1);
+    steps.operand_first.push_back(0);
+    return true;
+  }
+
+  NodeArg* operand = node.MutableInputDefs()[1 - chain_input_index];
+  if (!HaveSameShape(operand->Shape(), &shape) && !optimizer_utils::IsScalar(*operand)) {
+    return false;
+  }
+
+  // an operand used by several nodes is passed once
+  auto operand_index = std::find(steps.inputs.begin(), steps.inputs.end(), operand) - steps.inputs.begin();
+  if (operand_index == static_cast<ptrdiff_t>(steps.inputs.size())) {
+    steps.inputs.push_back(operand);
+  }
+
+  steps.ops.push_back(node.OpType());
+  steps.operands.push_back(static_cast<int64_t>(operand_index));
+  steps.operand_first.push_back(chain_input_index == 1 ? 1 : 0);
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsFusibleNode(node) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+      continue;
+    }
+
+    const TensorShapeProto* shape = node.OutputDefs()[0]->Shape();
+    if (shape == nullptr) {
+      continue;
+    }
+
+    // The input of the chain has the shape of the output, the other input of a binary node may be broadcast.
+    int chain_input_index = 0;
+    if (IsBinaryNode(node) && !HaveSameShape(node.InputDefs()[0]->Shape(), shape)) {
+      chain_input_index = 1;
+    }
+    if (!HaveSameShape(node.InputDefs()[chain_input_index]->Shape(), shape)) {
+      continue;
+    }
+
+    ChainSteps steps;
+    steps.inputs.push_back(node.MutableInputDefs()[chain_input_index]);
+    if (!AppendStep(node, chain_input_index, *shape, steps)) {
+      continue;
+    }
+
+    InlinedVector<std::reference_wrapper<Node>> nodes{node};
+
+    // Follow the chain while the intermediate values have no other consumer.
+    Node* current = &node;
+    while (steps.ops.size() < kMaxChainLength && optimizer_utils::CheckOutputEdges(graph, *current, 1)) {
+      Node& next = *graph.GetNode(current->OutputNodesBegin()->Index());
+      if (!IsFusibleNode(next) ||
+          next.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          !HaveSameShape(next.OutputDefs()[0]->Shape(), shape)) {
+        break;
+      }
+
+      const int next_chain_input_index = optimizer_utils::IndexOfNodeInput(next, *current->OutputDefs()[0]);
+      if (next_chain_input_index < 0 || !AppendStep(next, next_chain_input_index, *shape, steps)) {
+        break;
+      }
+
+      nodes.push_back(next);
+      current = &next;
+    }
+
+    if (nodes.size() < 2) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused element-wise chain",
+                                     steps.inputs,
+                                     {},
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", steps.ops);
+    fused_node.AddAttribute("operands", steps.operands);
+    fused_node.AddAttribute("operand_first", steps.operand_first);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, nodes, fused_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseChainFusion
+
+Fuses chains of two or more float element-wise nodes (Add, Sub, Mul, Div, Relu, Sigmoid, Tanh) into a single
+FusedElementwise node that runs the whole chain over tiles of the tensor, so the tensor is read and written once
+instead of once per node. Chains assigned to the CUDA EP may also be float16, and run in a single kernel launch. Every intermediate value must have a single consumer, and the other input of the binary
+nodes must have the shape of the chain or be a single element.
+*/
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -3,22 +3,72 @@
 
 #include "core/optimizer/graph_transformer.h"
 
+#include <vector>
+
+#include "core/platform/threadpool.h"
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
+Status GraphTransformer::ApplyWithConcurrentSubgraphs(Graph& graph, bool& modified,
+                                                      const logging::Logger& logger) const {
+  std::vector<Graph*> subgraphs;
+  for (auto& node : graph.Nodes()) {
+    for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
+      subgraphs.push_back(entry.second);
+    }
+  }
+
+  if (subgraphs.size() < 2) {
+    return ApplyImpl(graph, modified, 0, logger);
+  }
+
+  // The subgraphs are independent graphs, which only read the outer scope values. Their own subgraphs are
+  // transformed serially by the task of the subgraph.
+  std::vector<Status> statuses(subgraphs.size());
+  std::vector<char> subgraph_modified(subgraphs.size(), 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(subgraphs.size()), [&](std::ptrdiff_t i) {
+        ORT_TRY {
+          bool is_modified = false;
+          statuses[i] = ApplyImpl(*subgraphs[i], is_modified, 1, logger);
+          subgraph_modified[i] = is_modified;
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (size_t i = 0; i < subgraphs.size(); ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    modified = modified || subgraph_modified[i];
+  }
+
+  subgraphs_of_main_graph_applied_ = true;
+  auto status = ApplyImpl(graph, modified, 0, logger);
+  subgraphs_of_main_graph_applied_ = false;
+  return status;
+}
+
 Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logger& logger) const {
   // the Graph should be in a good state prior this being called, so there should be no need to call Resolve here
   // ORT_RETURN_IF_ERROR(graph.Resolve());
 
-  auto status = ApplyImpl(graph, modified, 0, logger);
+  auto status = concurrency::ThreadPool::DegreeOfParallelism(thread_pool_) > 1
+                    ? ApplyWithConcurrentSubgraphs(graph, modified, logger)
+                    : ApplyImpl(graph, modified, 0, logger);
   ORT_RETURN_IF_ERROR(status);
 
 #if !defined(ORT_MINIMAL_BUILD)
   // At least currently, some transformers (InsertCastTransformer and MemcpyTransformer) need this to be called
   // after they complete to put the graph back into a valid state for the next transformer.
   if (modified) {
-    status = graph.Resolve();
+    Graph::ResolveOptions options;
+    options.only_infer_modified_nodes = ShouldOnlyInferModifiedNodes();
+    status = graph.Resolve(options);
   }
 #endif
 
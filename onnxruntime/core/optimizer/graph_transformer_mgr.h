@@ -27,6 +27,10 @@ class GraphTransformerManager {
   // Register a transformer with a level.
   common::Status Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level);
 
+  // Set the thread pool used by the transformers to transform the subgraphs of the main graph concurrently.
+  // nullptr, the default, applies the transformers serially.
+  void SetThreadPool(concurrency::ThreadPool* thread_pool);
+
   // Apply all transformers registered for the given level on the given graph
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
@@ -36,6 +40,8 @@ class GraphTransformerManager {
   // maximum number of graph transformation steps
   unsigned steps_;
 
+  concurrency::ThreadPool* thread_pool_ = nullptr;
+
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
 };
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <variant>
 
+#include "core/common/parse_string.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
@@ -21,6 +22,7 @@
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
+#include "core/optimizer/broadcast_expand_elimination.h"
 #include "core/optimizer/cast_elimination.h"
 #include "core/optimizer/common_subexpression_elimination.h"
 #include "core/optimizer/constant_folding.h"
@@ -29,7 +31,9 @@
 #include "core/optimizer/conv_mul_fusion.h"
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
+#include "core/optimizer/dropout_mask_recompute.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -39,9 +43,12 @@
 #include "core/optimizer/gemm_activation_fusion.h"
 #include "core/optimizer/gemm_sum_fusion.h"
 #include "core/optimizer/gemm_transpose_fusion.h"
+#include "core/optimizer/group_norm_fusion.h"
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_add_fusion.h"
+#include "core/optimizer/matmul_fast_gelu_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
@@ -52,11 +59,14 @@
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
 #include "core/optimizer/qdq_transformer/relu_quantizelinear.h"
+#include "core/optimizer/qlinear_binary_activation_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaler_linear_fusion.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
 #include "core/optimizer/transpose_optimizer/ort_transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 
@@ -94,6 +104,7 @@ InlinedVector<std::unique_ptr<RewriteRule>> GenerateRewriteRules(
       rules.push_back(std::make_unique<UnsqueezeElimination>());
       rules.push_back(std::make_unique<EliminateDropout>());
       rules.push_back(std::make_unique<ExpandElimination>());
+      rules.push_back(std::make_unique<BroadcastExpandElimination>());
       rules.push_back(std::make_unique<CastElimination>());
       rules.push_back(std::make_unique<NoopElimination>());
       rules.push_back(std::make_unique<DivMulFusion>());
@@ -104,6 +115,7 @@ InlinedVector<std::unique_ptr<RewriteRule>> GenerateRewriteRules(
       rules.push_back(std::make_unique<ConvAddFusion>());
       rules.push_back(std::make_unique<ConvMulFusion>());
       rules.push_back(std::make_unique<ConvBNFusion>());
+      rules.push_back(std::make_unique<ScalerLinearFusion>());
       rules.push_back(std::make_unique<ClipQuantFusion>());
       rules.push_back(std::make_unique<ReluQuantFusion>());
       break;
@@ -178,12 +190,37 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // no filtering on execution provider for L1 optimizations as they only use official ONNX operators
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
       transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq));
+      transformers.emplace_back(std::make_unique<LoopInvariantCodeMotion>());
+#ifndef DISABLE_CONTRIB_OPS
+      // shards the MatMul weights before MatMulAddFusion turns the blocks into Gemm nodes.
+      // it inserts AllReduce contrib ops, which are placed on the CUDA EP as it is the only one implementing them.
+      int tensor_parallel_size = 1;
+      int tensor_parallel_rank = 0;
+      ORT_ENFORCE(TryParseStringWithClassicLocale(
+                      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelSize, "1"),
+                      tensor_parallel_size) &&
+                      tensor_parallel_size >= 1,
+                  "Invalid value for ", kOrtSessionOptionsConfigTensorParallelSize);
+      ORT_ENFORCE(TryParseStringWithClassicLocale(
+                      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelRank, "0"),
+                      tensor_parallel_rank) &&
+                      tensor_parallel_rank >= 0 && tensor_parallel_rank < tensor_parallel_size,
+                  "Invalid value for ", kOrtSessionOptionsConfigTensorParallelRank);
+      if (tensor_parallel_size > 1) {
+        transformers.emplace_back(std::make_unique<TensorParallelTransformer>(tensor_parallel_size,
+                                                                              tensor_parallel_rank));
+      }
+#endif
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
           session_options.free_dimension_overrides));
       auto cpu_allocator = cpu_execution_provider.GetAllocator(0, OrtMemTypeDefault);
-      transformers.emplace_back(std::make_unique<TransposeOptimizer>(std::move(cpu_allocator)));
+      const bool transpose_size_based_cost =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTransposeOptimizerCostModel,
+                                                            "rank") == "size";
+      transformers.emplace_back(std::make_unique<TransposeOptimizer>(std::move(cpu_allocator),
+                                                                     transpose_size_based_cost));
 
       if (!disable_quant_qdq) {
         transformers.emplace_back(std::make_unique<QDQPropagationTransformer>());
@@ -201,6 +238,9 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
 
+      const InlinedHashSet<std::string_view> cuda_eps = {onnxruntime::kCudaExecutionProvider};
+      const InlinedHashSet<std::string_view> cpu_cuda_eps = {onnxruntime::kCpuExecutionProvider,
+                                                             onnxruntime::kCudaExecutionProvider};
       const InlinedHashSet<std::string_view> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                               onnxruntime::kRocmExecutionProvider};
       const InlinedHashSet<std::string_view> cpu_cuda_rocm_eps = {onnxruntime::kCpuExecutionProvider,
@@ -222,6 +262,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<QDQSelectorActionTransformer>(qdq_is_int8_allowed));
       }
 
+      // Runs after the QDQ selectors so that it also sees the QLinear nodes they create.
+      transformers.emplace_back(std::make_unique<QLinearBinaryActivationFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<MatMulIntegerToFloatFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_ep));
@@ -235,12 +277,22 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_cuda_rocm_eps));
 
       transformers.emplace_back(std::make_unique<BiasDropoutFusion>(cuda_rocm_eps));
+#ifdef ENABLE_TRAINING
+      // Regenerating the mask from the random generator state is only implemented by the CUDA EP.
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDropoutMaskRecompute, "0") == "1") {
+        transformers.emplace_back(std::make_unique<DropoutMaskRecompute>(cuda_eps));
+      }
+#endif
       transformers.emplace_back(std::make_unique<MatmulTransposeFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<BiasGeluFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<BiasSoftmaxFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<SkipLayerNormFusion>(cpu_cuda_rocm_eps));
+      // GroupNorm is not implemented by the ROCm EP.
+      transformers.emplace_back(std::make_unique<GroupNormFusion>(cpu_cuda_eps));
 
       transformers.emplace_back(std::make_unique<FastGeluFusion>(cpu_cuda_rocm_eps));
+      // MatMulFastGelu is only implemented by the CUDA EP.
+      transformers.emplace_back(std::make_unique<MatMulFastGeluFusion>(cuda_eps));
 
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_cuda_rocm_eps));
 
@@ -271,6 +323,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // we will prefer NhwcTransformer once ort runs on x86-64 CPU, otherwise ConvAddActivationFusion is enabled.
       // this PR #6351 implemented similiar fusion-pattern but only for CUDA, and can only fuse conv-add-relu, while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+      // Runs last so that the fusions above, which fold element-wise nodes into their producers, take precedence.
+      const InlinedHashSet<std::string_view> cpu_cuda_eps = {onnxruntime::kCpuExecutionProvider,
+                                                             onnxruntime::kCudaExecutionProvider};
+      transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_cuda_eps));
 #endif
     } break;
 
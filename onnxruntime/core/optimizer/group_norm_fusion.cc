@@ -0,0 +1,280 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/group_norm_fusion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+bool IsSupportedDataType(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return false;
+  }
+  const auto elem_type = type->tensor_type().elem_type();
+  return elem_type == TensorProto_DataType_FLOAT || elem_type == TensorProto_DataType_FLOAT16;
+}
+
+// Reads a constant float or float16 initializer as single precision values.
+bool GetConstantFloatValues(const Graph& graph, const NodeArg& arg, std::vector<float>& values,
+                            InlinedVector<int64_t>& dims) {
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor_proto == nullptr) {
+    return false;
+  }
+
+  Initializer initializer{*tensor_proto, graph.ModelPath()};
+  const size_t size = static_cast<size_t>(initializer.size());
+  values.resize(size);
+  if (initializer.data_type() == TensorProto_DataType_FLOAT) {
+    const float* data = initializer.data<float>();
+    std::copy(data, data + size, values.begin());
+  } else if (initializer.data_type() == TensorProto_DataType_FLOAT16) {
+    const MLFloat16* data = initializer.data<MLFloat16>();
+    for (size_t i = 0; i < size; i++) {
+      values[i] = data[i].ToFloat();
+    }
+  } else {
+    return false;
+  }
+
+  dims.assign(tensor_proto->dims().begin(), tensor_proto->dims().end());
+  return true;
+}
+
+// Reads the per channel gamma or beta of the exported pattern, which is shaped (C, 1, 1) or (1, C, 1, 1) to
+// broadcast over the image.
+bool GetChannelValues(const Graph& graph, const Node& node, const NodeArg& input, int64_t num_channels,
+                      std::vector<float>& values, const NodeArg*& param_arg) {
+  const auto& input_defs = node.InputDefs();
+  const int param_index = (input_defs[0] == &input) ? 1 : 0;
+  if (input_defs[1 - param_index] != &input) {
+    return false;
+  }
+
+  InlinedVector<int64_t> dims;
+  if (!GetConstantFloatValues(graph, *input_defs[param_index], values, dims)) {
+    return false;
+  }
+
+  const bool is_chw = dims.size() == 3 && dims[0] == num_channels && dims[1] == 1 && dims[2] == 1;
+  const bool is_nchw = dims.size() == 4 && dims[0] == 1 && dims[1] == num_channels && dims[2] == 1 && dims[3] == 1;
+  param_arg = input_defs[param_index];
+  return is_chw || is_nchw;
+}
+
+bool IsSingleConsumer(const Graph& graph, const Node& node) {
+  return optimizer_utils::CheckOutputEdges(graph, node, 1);
+}
+
+NodeArg& AddChannelInitializer(Graph& graph, const std::string& name, const std::vector<float>& values) {
+  TensorProto initializer;
+  initializer.set_name(graph.GenerateNodeArgName(name));
+  initializer.add_dims(static_cast<int64_t>(values.size()));
+  initializer.set_data_type(TensorProto_DataType_FLOAT);
+  initializer.set_raw_data(values.data(), values.size() * sizeof(float));
+  return graph_utils::AddInitializer(graph, initializer);
+}
+
+}  // namespace
+
+Status GroupNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_reshape = graph.GetNode(node_index);
+    if (p_reshape == nullptr)
+      continue;  // we removed the node as part of an earlier fusion
+
+    Node& reshape_node = *p_reshape;
+    ORT_RETURN_IF_ERROR(Recurse(reshape_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(reshape_node, "Reshape", {5, 13, 14}) ||
+        !graph_utils::IsSupportedProvider(reshape_node, GetCompatibleExecutionProviders()) ||
+        !IsSingleConsumer(graph, reshape_node) ||
+        graph.NodeProducesGraphOutput(reshape_node)) {
+      continue;
+    }
+
+    // The input is a batch of NCHW images with a known number of channels.
+    NodeArg* x_input = reshape_node.MutableInputDefs()[0];
+    const TensorShapeProto* x_shape = x_input->Shape();
+    if (!IsSupportedDataType(*x_input) || x_shape == nullptr || x_shape->dim_size() != 4 ||
+        !utils::HasDimValue(x_shape->dim(1))) {
+      continue;
+    }
+    const int64_t num_channels = x_shape->dim(1).dim_value();
+
+    // The first reshape splits the channels to (N, G, -1).
+    InlinedVector<int64_t> group_shape;
+    if (!optimizer_utils::AppendTensorFromInitializer(graph, *reshape_node.InputDefs()[1], group_shape) ||
+        group_shape.size() != 3 || group_shape[2] != -1) {
+      continue;
+    }
+    const bool batch_matches = group_shape[0] == 0 ||
+                               (utils::HasDimValue(x_shape->dim(0)) && group_shape[0] == x_shape->dim(0).dim_value());
+    const int64_t num_groups = group_shape[1];
+    if (!batch_matches || num_groups <= 0 || num_channels % num_groups != 0) {
+      continue;
+    }
+
+    // InstanceNormalization of the groups with a unit scale and no bias.
+    Node& instance_norm_node = *graph.GetNode(reshape_node.OutputNodesBegin()->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(instance_norm_node, "InstanceNormalization", {6}) ||
+        instance_norm_node.GetExecutionProviderType() != reshape_node.GetExecutionProviderType() ||
+        instance_norm_node.InputDefs()[0] != reshape_node.OutputDefs()[0] ||
+        !IsSingleConsumer(graph, instance_norm_node) ||
+        graph.NodeProducesGraphOutput(instance_norm_node)) {
+      continue;
+    }
+
+    std::vector<float> unit_scale;
+    std::vector<float> zero_bias;
+    InlinedVector<int64_t> dims;
+    if (!GetConstantFloatValues(graph, *instance_norm_node.InputDefs()[1], unit_scale, dims) ||
+        !GetConstantFloatValues(graph, *instance_norm_node.InputDefs()[2], zero_bias, dims) ||
+        unit_scale.size() != static_cast<size_t>(num_groups) || zero_bias.size() != static_cast<size_t>(num_groups) ||
+        std::any_of(unit_scale.begin(), unit_scale.end(), [](float v) { return v != 1.0f; }) ||
+        std::any_of(zero_bias.begin(), zero_bias.end(), [](float v) { return v != 0.0f; })) {
+      continue;
+    }
+
+    float epsilon = 1e-5f;
+    const auto& instance_norm_attributes = instance_norm_node.GetAttributes();
+    const auto epsilon_attr = instance_norm_attributes.find("epsilon");
+    if (epsilon_attr != instance_norm_attributes.end()) {
+      epsilon = epsilon_attr->second.f();
+    }
+
+    // The second reshape restores the shape of the input, either from Shape(X) or from a constant.
+    Node& restore_node = *graph.GetNode(instance_norm_node.OutputNodesBegin()->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(restore_node, "Reshape", {5, 13, 14}) ||
+        restore_node.GetExecutionProviderType() != reshape_node.GetExecutionProviderType() ||
+        restore_node.InputDefs()[0] != instance_norm_node.OutputDefs()[0] ||
+        !IsSingleConsumer(graph, restore_node) ||
+        graph.NodeProducesGraphOutput(restore_node)) {
+      continue;
+    }
+
+    const Node* shape_node = graph_utils::GetInputNode(restore_node, 1);
+    if (shape_node != nullptr) {
+      if (!graph_utils::IsSupportedOptypeVersionAndDomain(*shape_node, "Shape", {1, 13, 15}) ||
+          shape_node->InputDefs()[0] != x_input ||
+          !shape_node->GetAttributes().empty() ||
+          !IsSingleConsumer(graph, *shape_node) ||
+          graph.NodeProducesGraphOutput(*shape_node)) {
+        continue;
+      }
+    } else {
+      InlinedVector<int64_t> restore_shape;
+      if (!optimizer_utils::AppendTensorFromInitializer(graph, *restore_node.InputDefs()[1], restore_shape) ||
+          restore_shape.size() != 4) {
+        continue;
+      }
+      bool shape_matches = true;
+      for (int i = 0; i < 4; i++) {
+        if (!utils::HasDimValue(x_shape->dim(i)) || restore_shape[i] != x_shape->dim(i).dim_value()) {
+          shape_matches = false;
+        }
+      }
+      if (!shape_matches) {
+        continue;
+      }
+    }
+
+    // The per channel affine transform.
+    Node& mul_node = *graph.GetNode(restore_node.OutputNodesBegin()->Index());
+    std::vector<float> gamma;
+    const NodeArg* gamma_arg = nullptr;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(mul_node, "Mul", {7, 13, 14}) ||
+        mul_node.GetExecutionProviderType() != reshape_node.GetExecutionProviderType() ||
+        !IsSingleConsumer(graph, mul_node) ||
+        graph.NodeProducesGraphOutput(mul_node) ||
+        !GetChannelValues(graph, mul_node, *restore_node.OutputDefs()[0], num_channels, gamma, gamma_arg)) {
+      continue;
+    }
+
+    Node& add_node = *graph.GetNode(mul_node.OutputNodesBegin()->Index());
+    std::vector<float> beta;
+    const NodeArg* beta_arg = nullptr;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(add_node, "Add", {7, 13, 14}) ||
+        add_node.GetExecutionProviderType() != reshape_node.GetExecutionProviderType() ||
+        !GetChannelValues(graph, add_node, *mul_node.OutputDefs()[0], num_channels, beta, beta_arg)) {
+      continue;
+    }
+
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_remove{reshape_node, instance_norm_node, restore_node,
+                                                                 mul_node, add_node};
+
+    // An optional swish activation, Mul(Y, Sigmoid(Y)), else the Add is the last node of the fusion.
+    int64_t activation = 0;
+    Node* sigmoid_node = nullptr;
+    Node* swish_mul_node = nullptr;
+    if (add_node.GetOutputEdgesCount() == 2 && !graph.NodeProducesGraphOutput(add_node)) {
+      for (auto it = add_node.OutputNodesBegin(); it != add_node.OutputNodesEnd(); ++it) {
+        Node* consumer = graph.GetNode(it->Index());
+        if (graph_utils::IsSupportedOptypeVersionAndDomain(*consumer, "Sigmoid", {6, 13})) {
+          sigmoid_node = consumer;
+        } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*consumer, "Mul", {7, 13, 14})) {
+          swish_mul_node = consumer;
+        }
+      }
+    }
+
+    if (sigmoid_node != nullptr && swish_mul_node != nullptr &&
+        sigmoid_node->GetExecutionProviderType() == reshape_node.GetExecutionProviderType() &&
+        swish_mul_node->GetExecutionProviderType() == reshape_node.GetExecutionProviderType() &&
+        IsSingleConsumer(graph, *sigmoid_node) &&
+        !graph.NodeProducesGraphOutput(*sigmoid_node) &&
+        sigmoid_node->OutputNodesBegin()->Index() == swish_mul_node->Index()) {
+      const auto& swish_inputs = swish_mul_node->InputDefs();
+      const NodeArg* add_output = add_node.OutputDefs()[0];
+      const NodeArg* sigmoid_output = sigmoid_node->OutputDefs()[0];
+      if ((swish_inputs[0] == add_output && swish_inputs[1] == sigmoid_output) ||
+          (swish_inputs[0] == sigmoid_output && swish_inputs[1] == add_output)) {
+        nodes_to_remove.push_back(*sigmoid_node);
+        nodes_to_remove.push_back(*swish_mul_node);
+        activation = 1;
+      }
+    }
+
+    NodeArg& gamma_input = AddChannelInitializer(graph, gamma_arg->Name() + "_GroupNorm", gamma);
+    NodeArg& beta_input = AddChannelInitializer(graph, beta_arg->Name() + "_GroupNorm", beta);
+
+    Node& group_norm_node = graph.AddNode(graph.GenerateNodeName("GroupNorm"),
+                                          "GroupNorm",
+                                          "fused GroupNorm subgraphs",
+                                          {x_input, &gamma_input, &beta_input},
+                                          {}, {}, kMSDomain);
+    group_norm_node.AddAttribute("epsilon", epsilon);
+    group_norm_node.AddAttribute("groups", num_groups);
+    group_norm_node.AddAttribute("activation", activation);
+    group_norm_node.AddAttribute("channels_last", static_cast<int64_t>(0));
+    group_norm_node.SetExecutionProviderType(reshape_node.GetExecutionProviderType());
+
+    // The Shape node only fed the reshape that restored the input shape.
+    const NodeIndex shape_node_index = shape_node != nullptr ? shape_node->Index() : 0;
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_remove, group_norm_node);
+
+    if (shape_node != nullptr) {
+      graph.RemoveNode(shape_node_index);
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
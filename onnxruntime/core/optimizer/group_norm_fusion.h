@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class GroupNormFusion
+
+Rewrite the group normalization exported from PyTorch, optionally followed by a swish activation,
+to a single GroupNorm node.
+
+X --> Reshape(N, G, -1) --> InstanceNormalization(1, 0) --> Reshape(Shape(X)) --> Mul(gamma) --> Add(beta)
+                                                                                  [--> Sigmoid --> Mul]
+*/
+class GroupNormFusion : public GraphTransformer {
+ public:
+  explicit GroupNormFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GroupNormFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_invariant_code_motion.h"
+
+#include "core/framework/data_types_internal.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Returns true if the value is the same on every iteration of the body, given the outputs of the nodes that were
+// already moved out of it.
+bool IsInvariantValue(const Graph& body, const NodeArg& value, const InlinedHashSet<std::string>& moved_outputs) {
+  if (!value.Exists()) {
+    return true;
+  }
+
+  const auto& name = value.Name();
+  if (moved_outputs.count(name) > 0 || body.IsOuterScopeValue(name)) {
+    return true;
+  }
+
+  // a constant initializer of the body, which can be copied to the outer graph
+  const auto& body_inputs = body.GetInputs();
+  return body.IsInitializedTensor(name) &&
+         std::none_of(body_inputs.cbegin(), body_inputs.cend(),
+                      [&name](const NodeArg* input) { return input->Name() == name; });
+}
+
+// Ops that can't fail at runtime for inputs that passed type and shape inference, so they can be computed even if
+// the body would not run at all.
+bool CannotFail(const Node& node) {
+  static const InlinedHashSet<std::string_view> non_failing_ops = {
+      "Abs", "Ceil", "Exp", "Floor", "Identity", "Neg", "Not", "Reciprocal", "Relu", "Shape", "Sigmoid", "Sign",
+      "Size", "Tanh"};
+  return non_failing_ops.count(node.OpType()) > 0;
+}
+
+template <typename T>
+bool GetConstantScalar(const Graph& graph, const NodeArg* input, T& value) {
+  if (input == nullptr || !input->Exists()) {
+    return false;
+  }
+
+  const auto* initializer = graph_utils::GetConstantInitializer(graph, input->Name());
+  return initializer != nullptr &&
+         initializer->data_type() == utils::ToTensorProtoElementType<T>() &&
+         utils::UnpackTensor<T>(*initializer, graph.ModelPath(), &value, 1).IsOK();
+}
+
+// Returns true if the body of the Loop or Scan node is known to run at least once, so that moving a node out of it
+// doesn't compute anything that would not have been computed, or raise an error that would not have been raised.
+bool IsBodyRunAtLeastOnce(const Graph& graph, const Node& node) {
+  const auto& inputs = node.InputDefs();
+  if (node.OpType() == "Loop") {
+    // the trip count must be a constant of at least 1 and the condition either omitted or a constant true
+    int64_t trip_count = 0;
+    if (!GetConstantScalar(graph, inputs.size() > 0 ? inputs[0] : nullptr, trip_count) || trip_count < 1) {
+      return false;
+    }
+
+    bool cond = false;
+    const NodeArg* cond_input = inputs.size() > 1 ? inputs[1] : nullptr;
+    return cond_input == nullptr || !cond_input->Exists() || (GetConstantScalar(graph, cond_input, cond) && cond);
+  }
+
+  // Scan 8 has a batch dimension and per batch sequence lengths, which are not inspected
+  if (node.SinceVersion() < 9) {
+    return false;
+  }
+
+  // every scan input must have a known, non-zero length along its scan axis
+  const auto* num_scan_inputs_attr = graph_utils::GetNodeAttribute(node, "num_scan_inputs");
+  const auto* scan_input_axes = graph_utils::GetNodeAttribute(node, "scan_input_axes");
+  const auto num_scan_inputs = num_scan_inputs_attr != nullptr ? num_scan_inputs_attr->i() : 0;
+  if (num_scan_inputs < 1 || static_cast<size_t>(num_scan_inputs) > inputs.size() ||
+      (scan_input_axes != nullptr && scan_input_axes->ints_size() != num_scan_inputs)) {
+    return false;
+  }
+
+  const size_t num_state_inputs = inputs.size() - static_cast<size_t>(num_scan_inputs);
+  for (size_t i = 0; i < static_cast<size_t>(num_scan_inputs); ++i) {
+    const auto* shape = inputs[num_state_inputs + i]->Shape();
+    if (shape == nullptr) {
+      return false;
+    }
+
+    int64_t axis = scan_input_axes != nullptr ? scan_input_axes->ints(static_cast<int>(i)) : 0;
+    if (axis < 0) {
+      axis += shape->dim_size();
+    }
+
+    if (axis < 0 || axis >= shape->dim_size() || !utils::HasDimValue(shape->dim(static_cast<int>(axis))) ||
+        shape->dim(static_cast<int>(axis)).dim_value() < 1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CanMoveNode(const Graph& outer_graph, const Graph& body, const Node& node,
+                 const InlinedHashSet<std::string>& moved_outputs, bool body_runs_at_least_once) {
+  // only deterministic ONNX ops give the same result when computed once. nodes with subgraphs are left alone.
+  if (!optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType()) || node.ContainsSubgraph() ||
+      body.NodeProducesGraphOutput(node)) {
+    return false;
+  }
+
+  // a body that may not run can only lose nodes whose computation is harmless
+  if (!body_runs_at_least_once && !CannotFail(node)) {
+    return false;
+  }
+
+  for (const auto* input : node.InputDefs()) {
+    if (!IsInvariantValue(body, *input, moved_outputs)) {
+      return false;
+    }
+
+    // initializers of the body are copied to the outer graph, where they must not be confused with another value
+    if (input->Exists() && body.IsInitializedTensor(input->Name()) &&
+        (!outer_graph.CanOverrideInitializer() ||
+         (outer_graph.GetNodeArg(input->Name()) != nullptr && !outer_graph.IsInitializedTensor(input->Name())))) {
+      return false;
+    }
+  }
+
+  // the outputs keep their names, which must not be in use in the outer graph
+  for (const auto* output : node.OutputDefs()) {
+    if (output->Exists() && outer_graph.GetNodeArg(output->Name()) != nullptr) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Moves the node from the body to the outer graph. Its consumers in the body read its outputs as outer scope values
+// once the graph is resolved.
+void MoveNode(Graph& outer_graph, Graph& body, Node& node) {
+  auto get_outer_node_arg = [&outer_graph](const NodeArg* node_arg) {
+    return &outer_graph.GetOrCreateNodeArg(node_arg->Name(), node_arg->TypeAsProto());
+  };
+
+  InlinedVector<NodeArg*> inputs;
+  inputs.reserve(node.InputDefs().size());
+  for (const auto* input : node.InputDefs()) {
+    const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+    if (input->Exists() && body.GetInitializedTensor(input->Name(), initializer) &&
+        !outer_graph.IsInitializedTensor(input->Name())) {
+      outer_graph.AddInitializedTensor(*initializer);
+    }
+    inputs.push_back(get_outer_node_arg(input));
+  }
+
+  InlinedVector<NodeArg*> outputs;
+  outputs.reserve(node.OutputDefs().size());
+  for (const auto* output : node.OutputDefs()) {
+    outputs.push_back(get_outer_node_arg(output));
+  }
+
+  outer_graph.AddNode(outer_graph.GenerateNodeName(node.Name()), node.OpType(), node.Description(), inputs, outputs,
+                      &node.GetAttributes(), node.Domain());
+
+  graph_utils::RemoveNodeOutputEdges(body, node);
+  body.RemoveNode(node.Index());
+}
+
+}  // namespace
+
+Status LoopInvariantCodeMotion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (NodeIndex node_index : node_topology_list) {
+    Node* node = graph.GetNode(node_index);
+    if (node == nullptr)
+      continue;
+
+    // nested bodies first, so that their invariant nodes can move further out through this body
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    // the branches of an If are only computed conditionally, so they are left alone
+    if (node->Domain() != kOnnxDomain || (node->OpType() != "Loop" && node->OpType() != "Scan")) {
+      continue;
+    }
+
+    Graph* body = node->GetMutableGraphAttribute("body");
+    if (body == nullptr) {
+      continue;
+    }
+
+    const bool body_runs_at_least_once = IsBodyRunAtLeastOnce(graph, *node);
+    InlinedHashSet<std::string> moved_outputs;
+    GraphViewer body_viewer(*body);
+    for (NodeIndex body_node_index : body_viewer.GetNodesInTopologicalOrder()) {
+      Node* body_node = body->GetNode(body_node_index);
+      if (body_node == nullptr ||
+          !CanMoveNode(graph, *body, *body_node, moved_outputs, body_runs_at_least_once)) {
+        continue;
+      }
+
+      for (const auto* output : body_node->OutputDefs()) {
+        moved_outputs.insert(output->Name());
+      }
+
+      LOGS(logger, VERBOSE) << "Moving loop invariant node " << body_node->Name() << " (" << body_node->OpType()
+                            << ") out of the body of " << node->Name();
+      MoveNode(graph, *body, *body_node);
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LoopInvariantCodeMotion
+Moves the nodes of Loop and Scan bodies that only depend on outer scope values, initializers and other such nodes
+out of the body into the graph containing the Loop or Scan node, so they are computed once rather than on every
+iteration. The body then reads their outputs as outer scope values.
+Nodes are only moved out of bodies that are known to run at least once, i.e. Loops with a constant trip count of at
+least 1 and a constant true condition, and Scans with a known non-zero sequence length. Other bodies only lose nodes
+that can't fail, so that a body that doesn't run never raises an error.
+*/
+class LoopInvariantCodeMotion : public GraphTransformer {
+ public:
+  LoopInvariantCodeMotion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopInvariantCodeMotion", compatible_execution_providers) {
+  }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/matmul_fast_gelu_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+Status MatMulFastGeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+      continue;
+    }
+
+    // The fused kernel only supports float and float16.
+    const auto* input_type = node.InputDefs()[0]->TypeAsProto();
+    if (input_type == nullptr ||
+        !(input_type->tensor_type().elem_type() == TensorProto_DataType_FLOAT ||
+          input_type->tensor_type().elem_type() == TensorProto_DataType_FLOAT16)) {
+      continue;
+    }
+
+    // A 2D B makes the MatMul a single GEMM with A flattened to 2D.
+    const TensorShapeProto* b_shape = node.InputDefs()[1]->Shape();
+    if (b_shape == nullptr || b_shape->dim_size() != 2) {
+      continue;
+    }
+
+    const Node& next_node = *node.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "FastGelu", {1}, kMSDomain) ||
+        next_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        next_node.InputDefs()[0] != node.OutputDefs()[0]) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> fused_inputs{node.MutableInputDefs()[0], node.MutableInputDefs()[1]};
+
+    if (next_node.InputDefs().size() > 1 && next_node.InputDefs()[1]->Exists()) {
+      const TensorShapeProto* bias_shape = next_node.InputDefs()[1]->Shape();
+      if (bias_shape == nullptr || bias_shape->dim_size() != 1 ||
+          !utils::HasDimValue(bias_shape->dim(0)) || !utils::HasDimValue(b_shape->dim(1)) ||
+          bias_shape->dim(0).dim_value() != b_shape->dim(1).dim_value()) {
+        continue;
+      }
+      fused_inputs.push_back(const_cast<NodeArg*>(next_node.InputDefs()[1]));
+    }
+
+    if (graph.NodeProducesGraphOutput(node)) {
+      continue;
+    }
+
+    Node& matmul_node = node;
+    Node& gelu_node = const_cast<Node&>(next_node);
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("MatMulFastGelu"),
+                                     "MatMulFastGelu",
+                                     "fused MatMul and FastGelu",
+                                     fused_inputs,
+                                     {},
+                                     {},
+                                     kMSDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(gelu_node.GetExecutionProviderType());
+
+    // move output definitions and edges from gelu_node to fused_node
+    // delete matmul_node and gelu_node.
+    graph_utils::FinalizeNodeFusion(graph, {matmul_node, gelu_node}, fused_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
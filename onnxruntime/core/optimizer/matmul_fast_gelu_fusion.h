@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MatMulFastGeluFusion
+Fuse MatMul + FastGelu to MatMulFastGelu, which applies the bias and the activation in the epilogue of the GEMM.
+B must be a 2D matrix so that the MatMul is a single GEMM.
+*/
+class MatMulFastGeluFusion : public GraphTransformer {
+ public:
+  MatMulFastGeluFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MatMulFastGeluFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
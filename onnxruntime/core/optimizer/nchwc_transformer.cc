@@ -18,6 +18,9 @@ class NchwcTransformerImpl {
   void Transform(Node& node);
   void Finalize(bool& modified);
 
+  size_t ReorderInputCount() const { return reorder_input_count_; }
+  size_t ReorderOutputCount() const { return reorder_output_count_; }
+
   static constexpr int kNchwcBatchChannelDims = 2;
   static constexpr int kNchwcSpatialDims = 2;
   static constexpr int kNchwcDims = kNchwcBatchChannelDims + kNchwcSpatialDims;
@@ -127,6 +130,9 @@ class NchwcTransformerImpl {
   void TransformBatchNormalization(Node& node);
   void TransformTransposeToNhwc(Node& node);
   void TransformResize(Node& node);
+  void TransformReduceMean(Node& node);
+  void TransformSplit(Node& node);
+  void TransformPad(Node& node);
   void TrackTransposeFromNhwc(Node& node);
 
   Graph& graph_;
@@ -160,6 +166,10 @@ class NchwcTransformerImpl {
   // NHWC to NCHW format.
   Node* transpose_from_nhwc_node_{nullptr};
   NodeArg* transpose_from_nhwc_output_arg_{nullptr};
+
+  // Tracks the number of reorder nodes inserted at the NCHW/NCHWc boundaries.
+  size_t reorder_input_count_{0};
+  size_t reorder_output_count_{0};
 };
 
 size_t NchwcTransformerImpl::RemoveOutputEdges(Node& node) {
@@ -220,6 +230,7 @@ void NchwcTransformerImpl::InsertReorderInput(Node& node) {
                                               kMSNchwcDomain);
     reorder_input_node.SetExecutionProviderType(kCpuExecutionProvider);
     input_defs[0] = input_nchwc_arg;
+    reorder_input_count_++;
 
     // Attempt to fuse the ReorderInput with a previous Transpose of NHWC->NCHW.
     // If the last known node to transpose from NHWC is the same as this input
@@ -1118,6 +1129,251 @@ void NchwcTransformerImpl::TransformResize(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
+// Transform ReduceMean over the spatial dimensions to GlobalAveragePool. This
+// is the squeeze step of squeeze-and-excitation blocks as exported by several
+// frameworks.
+void NchwcTransformerImpl::TransformReduceMean(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Don't transform the node if the input is not already in NCHWc format.
+  auto* nchwc_input = LookupNchwcArgument(input_defs[0]);
+  if (nchwc_input == nullptr) {
+    return;
+  }
+
+  // The reduced dimensions must be kept and only the spatial axes reduced.
+  const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+  if (keepdims_attr != nullptr && utils::HasInt(*keepdims_attr) && keepdims_attr->i() != 1) {
+    return;
+  }
+  const auto* axes_attr = graph_utils::GetNodeAttribute(node, "axes");
+  if (axes_attr == nullptr || axes_attr->ints_size() != kNchwcSpatialDims) {
+    return;
+  }
+  int reduced_axes_mask = 0;
+  for (int64_t axis : axes_attr->ints()) {
+    if (axis < 0) {
+      axis += kNchwcDims;
+    }
+    if (axis < kNchwcBatchChannelDims || axis >= kNchwcDims) {
+      return;
+    }
+    reduced_axes_mask |= 1 << axis;
+  }
+  if (reduced_axes_mask != ((1 << 2) | (1 << 3))) {
+    return;
+  }
+
+  std::string nchwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nchwc");
+  Node& nchwc_node = graph_.AddNode(nchwc_node_name,
+                                    "GlobalAveragePool",
+                                    nchwc_node_name,
+                                    {nchwc_input->nchwc_arg_},
+                                    output_defs,
+                                    nullptr,
+                                    kMSNchwcDomain);
+  nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+  nchwc_input->remaining_original_uses_--;
+
+  // The batch and channel dimensions pass through unchanged.
+  NchwcArgument::Shape output_shape(output_defs[0]);
+  output_shape.dims_[0] = nchwc_input->shape_.dims_[0];
+  output_shape.dims_[1] = nchwc_input->shape_.dims_[1];
+
+  CreateNchwcArgument(node, nchwc_node, nchwc_input->channels_, output_shape);
+  removed_nodes_.push_front(node.Index());
+}
+
+// Split along the channel axis at NCHWc block boundaries produces the same
+// memory layout as splitting a NCHW tensor of the padded shape, so the node
+// can consume and produce NCHWc tensors without changes.
+void NchwcTransformerImpl::TransformSplit(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Don't transform the node if the input is not already in NCHWc format.
+  auto* nchwc_input = LookupNchwcArgument(input_defs[0]);
+  if (nchwc_input == nullptr) {
+    return;
+  }
+
+  // Verify that this is a split along the channel axis.
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr == nullptr || !utils::HasInt(*axis_attr) ||
+      (axis_attr->i() != 1 && axis_attr->i() != 1 - kNchwcDims)) {
+    return;
+  }
+
+  const size_t nchwc_block_size = MlasNchwcGetBlockSize();
+  const int64_t channels = nchwc_input->channels_;
+  if ((channels % nchwc_block_size) != 0) {
+    return;
+  }
+
+  const size_t output_defs_count = output_defs.size();
+  InlinedVector<int64_t> split_channels;
+
+  if (node.SinceVersion() >= 13) {
+    if (input_defs.size() >= 2 && input_defs[1]->Exists()) {
+      // Require that the split tensor be static.
+      const auto* split_tensor_proto = graph_utils::GetConstantInitializer(graph_, input_defs[1]->Name());
+      if ((split_tensor_proto == nullptr) ||
+          (split_tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_INT64)) {
+        return;
+      }
+      Initializer split{*split_tensor_proto, graph_.ModelPath()};
+      auto* split_data = split.template data<int64_t>();
+      split_channels.assign(split_data, split_data + split.size());
+    }
+  } else {
+    const auto* split_attr = graph_utils::GetNodeAttribute(node, "split");
+    if (split_attr != nullptr) {
+      split_channels.assign(split_attr->ints().begin(), split_attr->ints().end());
+    }
+  }
+
+  if (split_channels.empty()) {
+    if ((channels % output_defs_count) != 0) {
+      return;
+    }
+    split_channels.resize(output_defs_count, channels / static_cast<int64_t>(output_defs_count));
+  }
+
+  if (split_channels.size() != output_defs_count) {
+    return;
+  }
+  for (int64_t output_channels : split_channels) {
+    if (output_channels <= 0 || (output_channels % nchwc_block_size) != 0) {
+      return;
+    }
+  }
+
+  input_defs[0] = nchwc_input->nchwc_arg_;
+  nchwc_input->remaining_original_uses_--;
+
+  // Count the uses of each output before removing the output edges. Graph
+  // outputs count as an additional use.
+  InlinedVector<size_t> original_uses(output_defs_count, 0);
+  for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+    original_uses[it->GetSrcArgIndex()]++;
+  }
+  for (const auto* graph_output : graph_.GetOutputs()) {
+    for (size_t i = 0; i < output_defs_count; i++) {
+      if (graph_output == output_defs[i]) {
+        original_uses[i]++;
+      }
+    }
+  }
+  graph_utils::RemoveNodeOutputEdges(graph_, node);
+
+  for (size_t i = 0; i < output_defs_count; i++) {
+    auto* output_original_arg = output_defs[i];
+    std::string output_reorder_def_name = graph_.GenerateNodeArgName("reorder");
+    auto* output_nchwc_arg = &graph_.GetOrCreateNodeArg(output_reorder_def_name, nullptr);
+
+    NchwcArgument::Shape output_shape = nchwc_input->shape_;
+    output_shape.dims_[1] = output_original_arg;
+
+    nchwc_args_[output_original_arg] =
+        std::make_unique<NchwcArgument>(node, output_nchwc_arg, original_uses[i], split_channels[i], output_shape);
+    output_defs[i] = output_nchwc_arg;
+  }
+}
+
+// Pad of the spatial dimensions is done on the 5D view of the NCHWc tensor, so
+// the channel blocks are padded as a unit.
+void NchwcTransformerImpl::TransformPad(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Don't transform the node if the input is not already in NCHWc format.
+  auto* nchwc_input = LookupNchwcArgument(input_defs[0]);
+  if (nchwc_input == nullptr) {
+    return;
+  }
+
+  InlinedVector<int64_t> pads;
+  bool has_constant_value = false;
+
+  if (node.SinceVersion() >= 11) {
+    // Require that the pads tensor be static.
+    const auto* pads_tensor_proto = graph_utils::GetConstantInitializer(graph_, input_defs[1]->Name());
+    if ((pads_tensor_proto == nullptr) ||
+        (pads_tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_INT64) ||
+        (pads_tensor_proto->dims_size() != 1) ||
+        (pads_tensor_proto->dims(0) != 2 * kNchwcDims)) {
+      return;
+    }
+    Initializer pads_initializer{*pads_tensor_proto, graph_.ModelPath()};
+    auto* pads_data = pads_initializer.template data<int64_t>();
+    pads.assign(pads_data, pads_data + 2 * kNchwcDims);
+    has_constant_value = (input_defs.size() >= 3 && input_defs[2]->Exists());
+  } else {
+    const auto* pads_attr = graph_utils::GetNodeAttribute(node, "pads");
+    if (pads_attr == nullptr || pads_attr->ints_size() != 2 * kNchwcDims) {
+      return;
+    }
+    pads.assign(pads_attr->ints().begin(), pads_attr->ints().end());
+    const auto* value_attr = graph_utils::GetNodeAttribute(node, "value");
+    has_constant_value = (value_attr != nullptr && value_attr->f() != 0.0f);
+  }
+
+  // Only the spatial dimensions can be padded.
+  for (int i = 0; i < kNchwcBatchChannelDims; i++) {
+    if (pads[i] != 0 || pads[kNchwcDims + i] != 0) {
+      return;
+    }
+  }
+
+  // A non-zero constant would also be written to the zero padded channels of
+  // a partial channel block.
+  const size_t nchwc_block_size = MlasNchwcGetBlockSize();
+  if (has_constant_value && (nchwc_input->channels_ % nchwc_block_size) != 0) {
+    return;
+  }
+
+  // Build the pads for the 5D (N, C/Bc, H, W, Bc) view of the NCHWc tensor.
+  InlinedVector<int64_t> nchwc_pads(2 * (kNchwcDims + 1), 0);
+  for (int i = 0; i < kNchwcSpatialDims; i++) {
+    nchwc_pads[kNchwcBatchChannelDims + i] = pads[kNchwcBatchChannelDims + i];
+    nchwc_pads[kNchwcDims + 1 + kNchwcBatchChannelDims + i] = pads[kNchwcDims + kNchwcBatchChannelDims + i];
+  }
+
+  if (node.SinceVersion() >= 11) {
+    ONNX_NAMESPACE::TensorProto pads_tensor_proto;
+    pads_tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    pads_tensor_proto.set_name(graph_.GenerateNodeArgName("pads"));
+    for (int64_t pad : nchwc_pads) {
+      pads_tensor_proto.add_int64_data(pad);
+    }
+    pads_tensor_proto.add_dims(static_cast<int64_t>(nchwc_pads.size()));
+    input_defs[1] = &graph_utils::AddInitializer(graph_, pads_tensor_proto);
+  } else {
+    node.AddAttribute("pads", std::vector<int64_t>(nchwc_pads.begin(), nchwc_pads.end()));
+  }
+
+  std::string reshape_input_def_name = graph_.GenerateNodeArgName("reshape");
+  auto* reshape_input_arg = &graph_.GetOrCreateNodeArg(reshape_input_def_name, nullptr);
+  InsertReshape(nchwc_input->nchwc_arg_, reshape_input_arg, true);
+
+  input_defs[0] = reshape_input_arg;
+  nchwc_input->remaining_original_uses_--;
+
+  std::string output_reshaped_def_name = graph_.GenerateNodeArgName("reshape");
+  auto* output_reshaped_arg = &graph_.GetOrCreateNodeArg(output_reshaped_def_name, nullptr);
+  Node& nchwc_node = InsertReshape(output_reshaped_arg, output_defs[0], false);
+
+  // The batch and channel dimensions pass through unchanged.
+  NchwcArgument::Shape output_shape(output_defs[0]);
+  output_shape.dims_[0] = nchwc_input->shape_.dims_[0];
+  output_shape.dims_[1] = nchwc_input->shape_.dims_[1];
+
+  CreateNchwcArgument(node, nchwc_node, nchwc_input->channels_, output_shape);
+  output_defs[0] = output_reshaped_arg;
+}
+
 void NchwcTransformerImpl::TrackTransposeFromNhwc(Node& node) {
   const auto* perm_attr = graph_utils::GetNodeAttribute(node, "perm");
   if (perm_attr == nullptr || perm_attr->ints_size() != 4) {
@@ -1179,6 +1435,12 @@ void NchwcTransformerImpl::Transform(Node& node) {
                graph_utils::IsSupportedOptypeVersionAndDomain(node, "GlobalAveragePool", {1})) {
       // Convert these pooling types only if the input is already in NCHWc format.
       TransformPool(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", {1, 11, 13})) {
+      TransformReduceMean(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Split", {2, 11, 13})) {
+      TransformSplit(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Pad", {2, 11, 13})) {
+      TransformPad(node);
     }
   }
 
@@ -1206,6 +1468,7 @@ void NchwcTransformerImpl::Finalize(bool& modified) {
                                                  kMSNchwcDomain);
       reorder_output_node.SetExecutionProviderType(kCpuExecutionProvider);
       reorder_output_node.AddAttribute("channels", nchwc_output.second->channels_);
+      reorder_output_count_++;
     }
   }
 
@@ -1230,6 +1493,11 @@ Status NchwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level
     }
   }
   impl.Finalize(modified);
+
+  if (impl.ReorderInputCount() > 0 || impl.ReorderOutputCount() > 0) {
+    LOGS(logger, INFO) << "NchwcTransformer inserted " << impl.ReorderInputCount() << " ReorderInput and "
+                       << impl.ReorderOutputCount() << " ReorderOutput nodes";
+  }
   return Status::OK();
 }
 
@@ -31,9 +31,41 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
 
   modified = false;
   for (std::unique_ptr<api::NodeRef>& node : api_graph->Nodes()) {
-    // Only QLinearConv needs to be handled explicitly. The rest will be transformed if needed during transpose
-    // optimization.
-    if (node->OpType() == "QLinearConv") {
+    // Only QLinearConv and float Conv need to be handled explicitly. The rest will be transformed if needed during
+    // transpose optimization.
+    if (node->OpType() == "Conv") {
+      // Convs that were already converted to NCHWc (kMSDomain) or are assigned to other providers are left alone.
+      if (node->Domain() != kOnnxDomain || node->GetExecutionProviderType() != kCpuExecutionProvider) {
+        continue;
+      }
+
+      auto inputs = node->Inputs();
+      if (api_graph->GetValueInfo(inputs[0])->DType() != api::DataType::FLOAT) {
+        continue;
+      }
+
+      // The filter must be constant so that NhwcConv can reorder and pack it once.
+      if (api_graph->GetConstant(inputs[1]) == nullptr) {
+        continue;
+      }
+
+      // Skip if unknown rank
+      auto shape = NodeFromApiNode(*node).InputDefs()[0]->Shape();
+      if (shape == nullptr || shape->dim_size() < 3) {
+        continue;
+      }
+
+      // Only the activations change layout, the filter and bias stay as-is. Consecutive NhwcConv nodes and the
+      // layout agnostic ops between them end up without any Transpose once the graph is optimized below.
+      size_t rank = shape->dim_size();
+      std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
+      std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
+      WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+
+      SwapNodeOpTypeAndDomain(*api_graph, *node, "NhwcConv", kMSDomain);
+
+      modified = true;
+    } else if (node->OpType() == "QLinearConv") {
       auto domain = node->Domain();
 
       // Skip if domain is incorrect
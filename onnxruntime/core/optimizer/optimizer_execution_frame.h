@@ -95,6 +95,14 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
                           const std::vector<int>& fetch_mlvalue_idxs,
                           const std::vector<OrtValue>& fetches = {});
 
+  // Frame whose node inputs are fed rather than taken from the initializers of info, so that info and the kernels
+  // created from it can be reused across runs with different input values.
+  OptimizerExecutionFrame(const Info& info,
+                          const std::vector<int>& feed_mlvalue_idxs,
+                          const std::vector<OrtValue>& feeds,
+                          const std::vector<int>& fetch_mlvalue_idxs,
+                          const std::vector<OrtValue>& fetches);
+
   ~OptimizerExecutionFrame() override = default;
 
  private:
@@ -3,6 +3,7 @@
 
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_actions.h"
 
+#include "core/graph/node_attr_utils.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 
 namespace onnxruntime {
@@ -25,6 +26,22 @@ std::vector<NodeAndMoveInfo> UnaryMoves() {
   return moves;
 }
 
+// moves for replacing DQ -> Pad -> Q with Pad. The DQ zero point becomes the pad value, which is only used in
+// 'constant' mode.
+std::vector<NodeAndMoveInfo> PadMoves() {
+  NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAndAppend(dq, ArgType::kInput, 0, ArgType::kInput),      // data from dq
+      MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput),  // pads from target
+      MoveAndAppend(dq, ArgType::kInput, 2, ArgType::kInput),      // zp (input 2) from dq as the pad value
+      MoveAll(q, ArgType::kOutput)};
+
+  return moves;
+}
+
 // moves for replacing a node with two DQ inputs with the qlinear version
 std::vector<NodeAndMoveInfo> BinaryMoves() {
   NTO::NodeLocation dq1{NTO::NodeType::kInput, 0};
@@ -195,6 +212,29 @@ UnaryReplaceWithQLinear::UnaryReplaceWithQLinear(std::string domain)
     : ReplaceWithQLinear(std::move(domain), UnaryMoves()) {
 }
 
+SoftmaxReplaceWithQLinear::SoftmaxReplaceWithQLinear()
+    : UnaryReplaceWithQLinear(kMSDomain) {
+}
+
+NodeAttributes SoftmaxReplaceWithQLinear::ExtraAttributes(const RuntimeState& state) const {
+  const Node& target = state.selected_nodes.Target();
+  const int64_t opset = target.SinceVersion();
+
+  NodeAttributes extra_attributes;
+  utils::SetNodeAttribute(utils::MakeAttribute("opset", opset), extra_attributes);
+  // the default axis also changed in opset 13 so make it explicit
+  if (target.GetAttributes().count("axis") == 0) {
+    utils::SetNodeAttribute(utils::MakeAttribute("axis", static_cast<int64_t>(opset < 13 ? 1 : -1)),
+                            extra_attributes);
+  }
+
+  return extra_attributes;
+}
+
+PadReplaceWithQuantizedPad::PadReplaceWithQuantizedPad()
+    : QDQReplaceWithNew(kOnnxDomain, "Pad", PadMoves()) {
+}
+
 BinaryReplaceWithQLinear::BinaryReplaceWithQLinear(std::string domain)
     : ReplaceWithQLinear(std::move(domain), BinaryMoves()) {
 }
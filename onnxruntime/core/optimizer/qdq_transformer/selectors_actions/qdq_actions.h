@@ -45,6 +45,19 @@ struct UnaryReplaceWithQLinear : ReplaceWithQLinear {
   UnaryReplaceWithQLinear(std::string domain);
 };
 
+// QLinearSoftmax needs the opset of the Softmax node as the axis semantics changed in opset 13
+struct SoftmaxReplaceWithQLinear : UnaryReplaceWithQLinear {
+  SoftmaxReplaceWithQLinear();
+
+ private:
+  NodeAttributes ExtraAttributes(const RuntimeState& state) const override;
+};
+
+// replace DQ -> Pad -> Q with an integer Pad that pads with the zero point, i.e. the quantized 0
+struct PadReplaceWithQuantizedPad : QDQReplaceWithNew {
+  PadReplaceWithQuantizedPad();
+};
+
 struct BinaryReplaceWithQLinear : ReplaceWithQLinear {
   BinaryReplaceWithQLinear(std::string domain);
 };
@@ -70,6 +70,24 @@ void DropDQNodesRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+// create rules for Pad, which is run on the quantized data with the zero point as pad value
+void PadQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ, target, Q. Replace with Pad of the quantized data and remove DQ and Q.
+  const std::string action_name{"Pad"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::PadReplaceWithQuantizedPad>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::PadSelector>();
+  // 'pads' is an attribute before opset 11
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Pad", {11, 13}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 3 nodes. DQ, target, Q
   // Replace with internal QLinear version of operator. Delete all original nodes.
@@ -90,6 +108,23 @@ void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void SoftmaxQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ, target, Q
+  // Replace with QLinearSoftmax. Delete all original nodes.
+  const std::string action_name{"Softmax"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::SoftmaxReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::UnarySelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Softmax", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void BinaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 4 nodes. 2 x DQ for inputs, target, Q
   // Replace with internal QLinear version of operator. Delete all original nodes.
@@ -196,7 +231,9 @@ SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
 
   DropQDQNodesRules(qdq_selector_action_registry);
   DropDQNodesRules(qdq_selector_action_registry);
+  PadQDQRules(qdq_selector_action_registry);
   UnaryOpQDQRules(qdq_selector_action_registry);
+  SoftmaxQDQRules(qdq_selector_action_registry);
   BinaryOpQDQRules(qdq_selector_action_registry);
   VariadicOpQDQRules(qdq_selector_action_registry);
   ConvQDQRules(qdq_selector_action_registry, is_int8_allowed);
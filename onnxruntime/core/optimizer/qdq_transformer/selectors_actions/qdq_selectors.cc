@@ -6,6 +6,7 @@
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 
 #include "core/graph/graph.h"
+#include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 #include "core/optimizer/utils.h"
@@ -111,6 +112,41 @@ bool DropQDQNodeGroupSelector::Check(const GraphViewer& graph_viewer,
   return IsQDQPairSupported(q_node, dq_node, get_const_initializer, graph_viewer.ModelPath());
 }
 
+bool PadNodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                 const Node& node,
+                                 const std::vector<const Node*>& dq_nodes,
+                                 const std::vector<const Node*>& q_nodes) const {
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 1)) {
+    return false;
+  }
+
+  auto get_const_initializer = [&graph_viewer](const std::string& initializer_name) {
+    return graph_viewer.GetConstantInitializer(initializer_name, true);
+  };
+
+  if (!IsQDQPairSupported(*q_nodes.front(), *dq_nodes.front(), get_const_initializer, graph_viewer.ModelPath())) {
+    return false;
+  }
+
+  const auto* mode_attr = graph_utils::GetNodeAttribute(node, "mode");
+  if (mode_attr != nullptr && mode_attr->s() != "constant") {
+    return true;  // 'edge' and 'reflect' only copy existing values
+  }
+
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() < 3 || !input_defs[2]->Exists()) {
+    return true;  // default pad value is 0
+  }
+
+  const ONNX_NAMESPACE::TensorProto* value_tensor_proto = get_const_initializer(input_defs[2]->Name());
+  if (value_tensor_proto == nullptr) {
+    return false;
+  }
+
+  Initializer value(*value_tensor_proto, graph_viewer.ModelPath());
+  return value.size() == 1 && *value.data<float>() == 0.0f;
+}
+
 bool DropDQNodeGroupSelector::CheckDQNodes(const Node& node, const std::vector<const Node*>& dq_nodes) const {
   int num_dq_inputs = NumActualValues(node, true);
 
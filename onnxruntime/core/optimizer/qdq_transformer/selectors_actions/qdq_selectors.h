@@ -57,6 +57,14 @@ class DropQDQNodeGroupSelector : public NodeGroupSelector {
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// Single DQ -> Pad -> Q. Zero point and scale are constant scalars and must match.
+// In 'constant' mode the pad value must be 0 so that padding with the zero point is equivalent.
+class PadNodeGroupSelector : public NodeGroupSelector {
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // Single DQ -> node.
 class DropDQNodeGroupSelector : public NodeGroupSelector {
   // base check that we have the expected number of DQ inputs.
@@ -162,6 +170,11 @@ class DropQDQNodesSelector : public BaseSelector {
   DropQDQNodesSelector() : BaseSelector(std::make_unique<DropQDQNodeGroupSelector>()) {}
 };
 
+class PadSelector : public BaseSelector {
+ public:
+  PadSelector() : BaseSelector(std::make_unique<PadNodeGroupSelector>()) {}
+};
+
 class DropDQNodesSelector : public BaseSelector {
  public:
   DropDQNodesSelector() : BaseSelector(std::make_unique<DropDQNodeGroupSelector>()) {}
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qlinear_binary_activation_fusion.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+Status QLinearBinaryActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!(graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearAdd", {1}, kMSDomain) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearMul", {1}, kMSDomain)) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(node) ||
+        node.GetAttributes().count("activation") != 0) {
+      continue;
+    }
+
+    const Node& next_node = *(node.OutputNodesBegin());
+    if (!(graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "QLinearSigmoid", {1}, kMSDomain) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "QLinearLeakyRelu", {1}, kMSDomain)) ||
+        next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    Node& binary_node = node;
+    Node& act_node = *graph.GetNode(next_node.Index());  // get mutable reference
+
+    // The activation's X_scale and X_zero_point are the binary node's C_scale and C_zero_point. Its Y_scale and
+    // Y_zero_point become the trailing inputs of the fused node.
+    auto& binary_input_defs = binary_node.MutableInputDefs();
+    auto& act_input_defs = act_node.MutableInputDefs();
+    std::vector<NodeArg*> fused_input_defs(binary_input_defs.begin(), binary_input_defs.end());
+    NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+    fused_input_defs.resize(8, &empty_arg);
+    fused_input_defs.push_back(act_input_defs[3]);
+    if (act_input_defs.size() > 4) {
+      fused_input_defs.push_back(act_input_defs[4]);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(binary_node.Name() + "_" + act_node.OpType()),
+                                     binary_node.OpType(),
+                                     "fused " + binary_node.Name() + " with activation " + act_node.OpType(),
+                                     fused_input_defs, {}, &binary_node.GetAttributes(), kMSDomain);
+
+    // QLinearSigmoid -> Sigmoid, QLinearLeakyRelu -> LeakyRelu
+    fused_node.AddAttribute("activation", act_node.OpType().substr(std::string("QLinear").size()));
+    const NodeAttributes& attrs = act_node.GetAttributes();
+    for (const auto& attr : attrs) {
+      AttributeProto fused_attr(attr.second);
+      fused_attr.set_name("activation_" + attr.first);
+      fused_node.AddAttributeProto(std::move(fused_attr));
+    }
+
+    fused_node.SetExecutionProviderType(binary_node.GetExecutionProviderType());
+
+    // move output definitions and edges from act_node to fused_node. delete binary_node and act_node.
+    graph_utils::FinalizeNodeFusion(graph, {binary_node, act_node}, fused_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class QLinearBinaryActivationFusion
+
+Fuses a QLinearSigmoid or QLinearLeakyRelu that follows a QLinearAdd or QLinearMul into the binary node, so that the
+lookup table of the activation is applied to each block of the result while it is still in cache instead of in a
+separate pass over the whole tensor.
+*/
+class QLinearBinaryActivationFusion : public GraphTransformer {
+ public:
+  QLinearBinaryActivationFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QLinearBinaryActivationFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -33,7 +33,8 @@ Status ReshapeFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, c
       continue;
     }
 
-    if (ReshapeFusion::Fuse_Subgraph(reshape, graph, logger)) {
+    if (ReshapeFusion::Fuse_Subgraph(reshape, graph, logger) ||
+        ReshapeFusion::Fuse_Symbolic_Shape_Value(reshape, graph, logger)) {
       fused_count++;
       LOGS(logger, INFO) << "Fused reshape node: " << reshape.OutputDefs()[0]->Name();
       modified = true;
@@ -430,4 +431,81 @@ bool ReshapeFusion::Fuse_Subgraph(Node& reshape, Graph& graph, const logging::Lo
   return true;
 }
 
+// Removes the node, and then its producers, as long as none of their outputs is consumed or is a graph output.
+static void RemoveUnusedNodesBottomUp(Graph& graph, NodeIndex node_index) {
+  std::vector<NodeIndex> nodes_to_check{node_index};
+  while (!nodes_to_check.empty()) {
+    const Node* node = graph.GetNode(nodes_to_check.back());
+    nodes_to_check.pop_back();
+    if (node == nullptr || node->GetOutputEdgesCount() != 0 || graph.NodeProducesGraphOutput(*node) ||
+        node->ContainsSubgraph()) {
+      continue;
+    }
+
+    for (auto it = node->InputNodesBegin(), end = node->InputNodesEnd(); it != end; ++it) {
+      nodes_to_check.push_back(it->Index());
+    }
+    graph.RemoveNode(node->Index());
+  }
+}
+
+/**
+Replace the shape input of the Reshape with an initializer when its value, as inferred by the symbolic shape
+inference of Graph::Resolve, only has dims that are constants, the dim of the data input at the same index (0),
+or a single other dim (-1). This covers the Shape -> Gather -> Unsqueeze -> Concat subgraphs of exported models
+that the patterns above do not match, so that they no longer run on every inference.
+*/
+bool ReshapeFusion::Fuse_Symbolic_Shape_Value(Node& reshape, Graph& graph, const logging::Logger& logger) {
+  const NodeArg& shape_def = *(reshape.InputDefs()[1]);
+  const Node* p_shape_node = graph_utils::GetInputNode(reshape, 1);
+  const ONNX_NAMESPACE::TensorShapeProto* data_shape = reshape.InputDefs()[0]->Shape();
+  const ONNX_NAMESPACE::TensorShapeProto* shape_value = graph.GetSymbolicShapeValue(shape_def.Name(), true);
+  if (p_shape_node == nullptr || data_shape == nullptr || shape_value == nullptr) {
+    return false;
+  }
+
+  InlinedVector<int64_t> new_shape;
+  new_shape.reserve(shape_value->dim_size());
+  int infer_count = 0;
+  for (int i = 0; i < shape_value->dim_size(); ++i) {
+    const auto& dim = shape_value->dim(i);
+    if (utils::HasDimValue(dim)) {
+      // allowzero is 0, so 0 and -1 have the same meaning in the initializer as in the computed shape.
+      new_shape.push_back(dim.dim_value());
+    } else if (!utils::HasDimParam(dim)) {
+      return false;
+    } else if (i < data_shape->dim_size() && utils::HasDimParam(data_shape->dim(i)) &&
+               data_shape->dim(i).dim_param() == dim.dim_param()) {
+      new_shape.push_back(0);
+    } else {
+      new_shape.push_back(-1);
+    }
+
+    if (new_shape.back() == -1 && ++infer_count > 1) {
+      return false;
+    }
+  }
+
+  ONNX_NAMESPACE::TensorProto shape_initializer_proto;
+  shape_initializer_proto.set_name(graph.GenerateNodeArgName(shape_def.Name() + "_symbolic"));
+  shape_initializer_proto.add_dims(static_cast<int64_t>(new_shape.size()));
+  shape_initializer_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  shape_initializer_proto.set_raw_data(new_shape.data(), new_shape.size() * sizeof(int64_t));
+  auto& new_node_arg = graph_utils::AddInitializer(graph, shape_initializer_proto);
+
+  // The shape subgraph may be shared with other nodes, so only remove what is no longer used.
+  const NodeIndex shape_node_index = p_shape_node->Index();
+  for (auto it = reshape.InputEdgesBegin(), end = reshape.InputEdgesEnd(); it != end; ++it) {
+    if (it->GetDstArgIndex() == 1) {
+      graph.RemoveEdge(shape_node_index, reshape.Index(), it->GetSrcArgIndex(), 1);
+      break;
+    }
+  }
+  graph_utils::ReplaceNodeInput(reshape, 1, new_node_arg);
+  RemoveUnusedNodesBottomUp(graph, shape_node_index);
+
+  LOGS(logger, VERBOSE) << "Replaced the shape subgraph of " << reshape.Name() << " with its symbolic value";
+  return true;
+}
+
 }  // namespace onnxruntime
@@ -10,6 +10,9 @@ namespace onnxruntime {
 /**
 @Class ReshapeFusion
 Rewrite graph fusing reshape subgraph to a single Reshape node.
+
+Besides the known patterns, any subgraph computing the shape input of a Reshape is fused when the symbolic shape
+inference of Graph::Resolve expresses its value with constants and the dims of the data input.
 */
 class ReshapeFusion : public GraphTransformer {
  public:
@@ -20,6 +23,7 @@ class ReshapeFusion : public GraphTransformer {
 
  private:
   static bool Fuse_Subgraph(Node& reshape, Graph& graph, const logging::Logger& logger);
+  static bool Fuse_Symbolic_Shape_Value(Node& reshape, Graph& graph, const logging::Logger& logger);
   static bool Match_One_Element_Output_Subgraph_1(Graph& graph, const NodeArg& root_input, const Node& concat,
                                                   int index, gsl::span<const int64_t> shape_value, bool checkOneElementOnly, const logging::Logger& looger);
   static bool Match_One_Element_Output_Subgraph_2(Graph& graph, const NodeArg& root_input, const Node& concat,
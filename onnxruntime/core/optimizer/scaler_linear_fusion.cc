@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/scaler_linear_fusion.h"
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the number of rows (classes or targets) of the coefficients of the linear model, or 0 if unknown.
+size_t GetNumTargets(const Node& linear_node) {
+  if (linear_node.OpType() == "LinearRegressor") {
+    const auto* targets = graph_utils::GetNodeAttribute(linear_node, "targets");
+    return targets != nullptr && targets->i() > 0 ? static_cast<size_t>(targets->i()) : 0;
+  }
+
+  // LinearClassifier infers the number of classes from the intercepts
+  const auto* intercepts = graph_utils::GetNodeAttribute(linear_node, "intercepts");
+  return intercepts != nullptr ? static_cast<size_t>(intercepts->floats_size()) : 0;
+}
+
+}  // namespace
+
+Status ScalerLinearFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+                                 const logging::Logger&) const {
+  auto& scaler_node = node;
+  auto& linear_node = *graph.GetNode(scaler_node.OutputNodesBegin()->Index());
+
+  InlinedVector<float> scale;
+  InlinedVector<float> offset;
+  InlinedVector<float> coefficients;
+  InlinedVector<float> intercepts;
+  graph_utils::GetRepeatedNodeAttributeValues(scaler_node, "scale", scale);
+  graph_utils::GetRepeatedNodeAttributeValues(scaler_node, "offset", offset);
+  graph_utils::GetRepeatedNodeAttributeValues(linear_node, "coefficients", coefficients);
+  graph_utils::GetRepeatedNodeAttributeValues(linear_node, "intercepts", intercepts);
+
+  const size_t num_targets = GetNumTargets(linear_node);
+  if (num_targets == 0 || coefficients.empty() || coefficients.size() % num_targets != 0 ||
+      scale.empty() || scale.size() != offset.size()) {
+    return Status::OK();
+  }
+
+  // Both Scaler and the linear models work on the last dim of the input, Scaler broadcasts a single scale/offset
+  const size_t num_features = coefficients.size() / num_targets;
+  if (scale.size() != 1 && scale.size() != num_features) {
+    return Status::OK();
+  }
+
+  // LinearRegressor ignores the intercepts unless there is one per target
+  if (intercepts.size() != num_targets) {
+    intercepts.assign(num_targets, 0.f);
+  }
+
+  for (size_t target = 0; target < num_targets; ++target) {
+    float* target_coefficients = coefficients.data() + target * num_features;
+    for (size_t feature = 0; feature < num_features; ++feature) {
+      const size_t scaler_index = scale.size() == 1 ? 0 : feature;
+      target_coefficients[feature] *= scale[scaler_index];
+      intercepts[target] -= target_coefficients[feature] * offset[scaler_index];
+    }
+  }
+
+  linear_node.AddAttribute("coefficients", gsl::make_span<const float>(coefficients.data(), coefficients.size()));
+  linear_node.AddAttribute("intercepts", gsl::make_span<const float>(intercepts.data(), intercepts.size()));
+
+  // The linear node now consumes the input of the Scaler directly
+  graph_utils::RemoveNode(graph, scaler_node);
+
+  rule_effect = RewriteRuleEffect::kRemovedCurrentNode;
+
+  return Status::OK();
+}
+
+bool ScalerLinearFusion::SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain) ||
+      node.GetOutputEdgesCount() != 1) {
+    return false;
+  }
+
+  const auto& next_node = *node.OutputNodesBegin();
+  if (!(graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "LinearClassifier", {1}, kMLDomain) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "LinearRegressor", {1}, kMLDomain)) ||
+      // Make sure the two nodes do not span execution providers.
+      next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return false;
+  }
+
+  // Scaler always produces float, the linear model must see the same values if it consumes the Scaler input
+  const auto* input_type = node.InputDefs()[0]->TypeAsProto();
+  if (input_type == nullptr ||
+      input_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  return graph_utils::CanRemoveNode(graph, node, logger);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/optimizer/rewrite_rule.h"
+
+namespace onnxruntime {
+
+/**
+@Class ScalerLinearFusion
+
+Rewrite rule that folds a Scaler node into the LinearClassifier or LinearRegressor node consuming its output,
+as found in the scikit-learn pipelines converted by skl2onnx (StandardScaler followed by a linear model).
+
+Scaler computes (X - offset) * scale per feature, so the linear model on its output is equivalent to a linear model
+on X with coefficients W * scale and intercepts b - W * (offset * scale), which saves a pass over the input and the
+intermediate tensor.
+
+It is attempted to be triggered only on nodes with op type "Scaler".
+*/
+class ScalerLinearFusion : public RewriteRule {
+ public:
+  ScalerLinearFusion() noexcept : RewriteRule("ScalerLinearFusion") {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {"Scaler"};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
+
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
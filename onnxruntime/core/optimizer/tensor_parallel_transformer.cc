@@ -0,0 +1,277 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/tensor_parallel_transformer.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the single consumer of output 0 of `node`, or nullptr if the output has several consumers or is a graph
+// output. The blocks are only sharded if their intermediate values are not used anywhere else.
+Node* GetSingleConsumer(Graph& graph, const Node& node) {
+  if (node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(node)) {
+    return nullptr;
+  }
+
+  const auto& edge = *node.OutputEdgesBegin();
+  if (edge.GetSrcArgIndex() != 0) {
+    return nullptr;
+  }
+
+  return graph.GetNode(edge.GetNode().Index());
+}
+
+// Returns the constant initializer of input `input_index` of `node` if it has rank `rank` and its dimension `axis`
+// is made of `sections` sections that can each be split into `size` equal shards, nullptr otherwise.
+const TensorProto* GetShardableWeight(const Graph& graph, const Node& node, size_t input_index,
+                                      int rank, int axis, int64_t sections, int size) {
+  const auto& input_defs = node.InputDefs();
+  if (input_index >= input_defs.size() || !input_defs[input_index]->Exists()) {
+    return nullptr;
+  }
+
+  const TensorProto* weight = graph_utils::GetConstantInitializer(graph, input_defs[input_index]->Name());
+  if (weight == nullptr || weight->dims_size() != rank) {
+    return nullptr;
+  }
+
+  const int64_t dim = weight->dims(axis);
+  return dim > 0 && dim % (sections * size) == 0 ? weight : nullptr;
+}
+
+// Makes input `input_index` of `node` use the shard `shard_index` of `weight` along `axis`. The dimension is made of
+// `sections` equally sized sections, e.g. the Q, K and V weights of an Attention node, which are sharded separately
+// so that every shard keeps the same layout.
+Status ShardWeight(Graph& graph, Node& node, size_t input_index, const TensorProto& weight,
+                   int axis, int64_t sections, int size, int shard_index) {
+  std::vector<uint8_t> data;
+  ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(weight, graph.ModelPath(), data));
+
+  int64_t outer = 1;
+  int64_t inner = 1;
+  for (int i = 0; i < weight.dims_size(); ++i) {
+    if (i < axis) {
+      outer *= weight.dims(i);
+    } else if (i > axis) {
+      inner *= weight.dims(i);
+    }
+  }
+
+  const int64_t dim = weight.dims(axis);
+  const size_t element_size = data.size() / static_cast<size_t>(outer * dim * inner);
+  const int64_t section_size = dim / sections;
+  const int64_t shard_size = section_size / size;
+  const size_t block_bytes = static_cast<size_t>(shard_size * inner) * element_size;
+
+  TensorProto shard;
+  shard.set_name(graph.GenerateNodeArgName(weight.name() + "_shard_" + std::to_string(shard_index)));
+  shard.set_data_type(weight.data_type());
+  for (int i = 0; i < weight.dims_size(); ++i) {
+    shard.add_dims(i == axis ? dim / size : weight.dims(i));
+  }
+
+  std::string shard_data;
+  shard_data.reserve(static_cast<size_t>(outer * sections) * block_bytes);
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t s = 0; s < sections; ++s) {
+      const int64_t start = o * dim + s * section_size + shard_index * shard_size;
+      shard_data.append(reinterpret_cast<const char*>(data.data()) + static_cast<size_t>(start * inner) * element_size,
+                        block_bytes);
+    }
+  }
+  shard.set_raw_data(std::move(shard_data));
+
+  // the original initializer is removed when the graph is resolved if no other node uses it
+  NodeArg& shard_arg = graph_utils::AddInitializer(graph, shard);
+  graph_utils::ReplaceNodeInput(node, static_cast<int>(input_index), shard_arg);
+  return Status::OK();
+}
+
+// Adds the partial results of output 0 of `node` over the ranks before its consumers use it.
+void InsertAllReduce(Graph& graph, Node& node, int size) {
+  NodeArg& reduced = graph_utils::CreateNodeArg(graph, *node.OutputDefs()[0]);
+  Node& all_reduce = graph.AddNode(graph.GenerateNodeName(node.Name() + "_AllReduce"),
+                                   "AllReduce",
+                                   "Sum of the partial results of the tensor-parallel ranks",
+                                   {node.MutableOutputDefs()[0]},
+                                   {&reduced},
+                                   nullptr,
+                                   kMSDomain);
+  all_reduce.AddAttribute("group_size", static_cast<int64_t>(size));
+  all_reduce.SetExecutionProviderType(node.GetExecutionProviderType());
+
+  graph_utils::ReplaceDownstreamNodeInput(graph, node, 0, all_reduce, 0);
+  graph.AddEdge(node.Index(), all_reduce.Index(), 0, 0);
+}
+
+// Returns the index of the input of the Add node `add` that is not produced by `producer`.
+size_t OtherAddInput(const Node& add, const Node& producer) {
+  return add.InputDefs()[0] == producer.OutputDefs()[0] ? 1 : 0;
+}
+
+}  // namespace
+
+Status TensorParallelTransformer::TryShardMlp(Graph& graph, Node& matmul, bool& sharded,
+                                              const logging::Logger& logger) const {
+  const TensorProto* w1 = GetShardableWeight(graph, matmul, 1, 2, 1, 1, size_);
+  if (w1 == nullptr) {
+    return Status::OK();
+  }
+  const int64_t intermediate_size = w1->dims(1);
+
+  Node* next = GetSingleConsumer(graph, matmul);
+  if (next == nullptr) {
+    return Status::OK();
+  }
+
+  Node* add = nullptr;
+  const TensorProto* b1 = nullptr;
+  size_t b1_index = 0;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(*next, "Add", {7, 13, 14})) {
+    add = next;
+    b1_index = OtherAddInput(*add, matmul);
+    b1 = GetShardableWeight(graph, *add, b1_index, 1, 0, 1, size_);
+    if (b1 == nullptr || b1->dims(0) != intermediate_size) {
+      return Status::OK();
+    }
+
+    next = GetSingleConsumer(graph, *add);
+    if (next == nullptr) {
+      return Status::OK();
+    }
+  }
+
+  Node* activation = next;
+  const TensorProto* activation_bias = nullptr;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "FastGelu", {1}, kMSDomain) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "BiasGelu", {1}, kMSDomain)) {
+    const auto& input_defs = activation->InputDefs();
+    if (input_defs.size() > 1 && input_defs[1]->Exists()) {
+      activation_bias = GetShardableWeight(graph, *activation, 1, 1, 0, 1, size_);
+      if (activation_bias == nullptr || activation_bias->dims(0) != intermediate_size) {
+        return Status::OK();
+      }
+    }
+  } else if (!graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "Relu", {6, 13, 14}) &&
+             !graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "Gelu", {1}, kMSDomain)) {
+    return Status::OK();
+  }
+
+  Node* matmul2 = GetSingleConsumer(graph, *activation);
+  if (matmul2 == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*matmul2, "MatMul", {1, 9, 13}) ||
+      matmul2->InputDefs()[0] != activation->OutputDefs()[0] ||
+      graph.NodeProducesGraphOutput(*matmul2)) {
+    return Status::OK();
+  }
+
+  const TensorProto* w2 = GetShardableWeight(graph, *matmul2, 1, 2, 0, 1, size_);
+  if (w2 == nullptr || w2->dims(0) != intermediate_size) {
+    return Status::OK();
+  }
+
+  // the pattern matched, the graph is only modified from here
+  ORT_RETURN_IF_ERROR(ShardWeight(graph, matmul, 1, *w1, 1, 1, size_, rank_));
+  matmul.MutableOutputDefs()[0]->ClearShape();
+  if (add != nullptr) {
+    ORT_RETURN_IF_ERROR(ShardWeight(graph, *add, b1_index, *b1, 0, 1, size_, rank_));
+    add->MutableOutputDefs()[0]->ClearShape();
+  }
+  if (activation_bias != nullptr) {
+    ORT_RETURN_IF_ERROR(ShardWeight(graph, *activation, 1, *activation_bias, 0, 1, size_, rank_));
+  }
+  activation->MutableOutputDefs()[0]->ClearShape();
+  ORT_RETURN_IF_ERROR(ShardWeight(graph, *matmul2, 1, *w2, 0, 1, size_, rank_));
+  InsertAllReduce(graph, *matmul2, size_);
+
+  LOGS(logger, VERBOSE) << "Sharded the MLP block from " << matmul.Name() << " to " << matmul2->Name();
+  sharded = true;
+  return Status::OK();
+}
+
+Status TensorParallelTransformer::TryShardAttention(Graph& graph, Node& attention, bool& sharded,
+                                                    const logging::Logger& logger) const {
+  const auto* num_heads_attr = graph_utils::GetNodeAttribute(attention, "num_heads");
+  if (num_heads_attr == nullptr || num_heads_attr->i() % size_ != 0 ||
+      graph_utils::GetNodeAttribute(attention, "qkv_hidden_sizes") != nullptr) {
+    return Status::OK();
+  }
+
+  // past/present and extra_add_qk have a num_heads dimension that would change for the callers
+  const auto& input_defs = attention.InputDefs();
+  for (size_t i = 4; i < input_defs.size(); ++i) {
+    if (input_defs[i]->Exists()) {
+      return Status::OK();
+    }
+  }
+  if (graph_utils::IsOutputUsed(attention, 1) ||
+      (attention.OutputDefs().size() > 1 && graph.IsOutput(attention.OutputDefs()[1]))) {
+    return Status::OK();
+  }
+
+  const TensorProto* weights = GetShardableWeight(graph, attention, 1, 2, 1, 3, size_);
+  const TensorProto* bias = GetShardableWeight(graph, attention, 2, 1, 0, 3, size_);
+  if (weights == nullptr || bias == nullptr || bias->dims(0) != weights->dims(1)) {
+    return Status::OK();
+  }
+  const int64_t hidden_size = weights->dims(1) / 3;
+
+  Node* projection = GetSingleConsumer(graph, attention);
+  if (projection == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*projection, "MatMul", {1, 9, 13}) ||
+      projection->InputDefs()[0] != attention.OutputDefs()[0] ||
+      graph.NodeProducesGraphOutput(*projection)) {
+    return Status::OK();
+  }
+
+  const TensorProto* projection_weight = GetShardableWeight(graph, *projection, 1, 2, 0, 1, size_);
+  if (projection_weight == nullptr || projection_weight->dims(0) != hidden_size) {
+    return Status::OK();
+  }
+
+  // each rank keeps the same heads of Q, K and V, and the rows of the projection matching its heads
+  const int64_t num_heads = num_heads_attr->i();
+  ORT_RETURN_IF_ERROR(ShardWeight(graph, attention, 1, *weights, 1, 3, size_, rank_));
+  ORT_RETURN_IF_ERROR(ShardWeight(graph, attention, 2, *bias, 0, 3, size_, rank_));
+  attention.AddAttribute("num_heads", num_heads / size_);
+  attention.MutableOutputDefs()[0]->ClearShape();
+  ORT_RETURN_IF_ERROR(ShardWeight(graph, *projection, 1, *projection_weight, 0, 1, size_, rank_));
+  InsertAllReduce(graph, *projection, size_);
+
+  LOGS(logger, VERBOSE) << "Sharded the attention block from " << attention.Name() << " to " << projection->Name();
+  sharded = true;
+  return Status::OK();
+}
+
+Status TensorParallelTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // the second MatMul of a sharded block is followed by an AllReduce, so it never starts another block
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13})) {
+      ORT_RETURN_IF_ERROR(TryShardMlp(graph, node, modified, logger));
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Attention", {1}, kMSDomain)) {
+      ORT_RETURN_IF_ERROR(TryShardAttention(graph, node, modified, logger));
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TensorParallelTransformer
+
+Shards the MLP and self-attention blocks of a transformer model over the `size` ranks of a tensor-parallel group,
+Megatron style, and keeps the part of rank `rank`:
+
+  MLP:       MatMul(W1) -> [Add(B1)] -> Relu/Gelu/FastGelu/BiasGelu -> MatMul(W2) -> [Add(B2)]
+  Attention: Attention(W, B) -> MatMul(Wo) -> [Add(Bo)]
+
+W1, B1 and the bias of the activation keep 1/size of their columns, the Attention node keeps 1/size of its heads,
+and W2 and Wo keep 1/size of their rows. The second MatMul then produces a partial sum that is added over the ranks
+by an AllReduce node before B2/Bo. The weights must be constant initializers whose sharded dimension is divisible
+by `size`; other blocks are left replicated.
+*/
+class TensorParallelTransformer : public GraphTransformer {
+ public:
+  TensorParallelTransformer(int size, int rank) noexcept
+      : GraphTransformer("TensorParallelTransformer"), size_(size), rank_(rank) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  // set `sharded` to true if the block starting at the node was sharded
+  Status TryShardMlp(Graph& graph, Node& matmul, bool& sharded, const logging::Logger& logger) const;
+  Status TryShardAttention(Graph& graph, Node& attention, bool& sharded, const logging::Logger& logger) const;
+
+  const int size_;
+  const int rank_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "transformer_memcpy.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/execution_providers.h"
+#include "core/framework/fallback_cpu_capability.h"
 #include "core/framework/utils.h"
 
 using namespace ONNX_NAMESPACE;
@@ -16,9 +17,10 @@ class TransformerMemcpyImpl {
   TransformerMemcpyImpl(onnxruntime::Graph& graph, const std::string& provider)
       : graph_(graph), provider_(provider) {}
 
-  bool ModifyGraph(const KernelRegistryManager& schema_registries);
+  bool ModifyGraph(const KernelRegistryManager& schema_registries, const logging::Logger& logger);
 
  private:
+  size_t RunCheapNodesOnCpu(const KernelRegistryManager& kernel_registries);
   void ProcessDefs(onnxruntime::Node& node, const KernelRegistryManager& kernel_registries, InitializedTensorSet& initializers_consumed);
   void BuildDefsMapping(const onnxruntime::NodeArg* arg, const KernelRegistryManager& kernel_registries);
   void AddCopyNode(onnxruntime::NodeArg* arg, bool is_input);
@@ -65,7 +67,7 @@ common::Status MemcpyTransformer::ApplyImpl(Graph& graph, bool& modified, int gr
   for (auto& provider : provider_types_) {
     if (!utils::ProviderIsCpuBased(provider)) {
       TransformerMemcpyImpl copy_impl(graph, provider);
-      auto current_modified = copy_impl.ModifyGraph(registry_manager_);
+      auto current_modified = copy_impl.ModifyGraph(registry_manager_, logger);
       modified = modified || current_modified;
       break;
     }
@@ -107,12 +109,23 @@ considered to be non-provider here.)
 Note that every ml-value is computed at a unique point (either provider or non-provider),
 but it may be referenced and used at multiple points (by both provider and non-provider).
 
+Before that, a cheap provider node whose inputs are all in CPU memory and whose output X is referenced by
+non-provider nodes is also run on CPU for those references, which saves the copy of X (see RunCheapNodesOnCpu).
+
 This transformer does not currently optimize copies between, e.g., two different GPU devices, etc.
 
 */
 
-bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_registries) {
+bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_registries,
+                                        const logging::Logger& logger) {
   bool modified = false;
+  const size_t copies_avoided = RunCheapNodesOnCpu(kernel_registries);
+  if (copies_avoided > 0) {
+    LOGS(logger, INFO) << "Running cheap " << provider_ << " nodes on CPU avoided " << copies_avoided
+                       << " copies to host memory";
+    modified = true;
+  }
+
   InitializedTensorSet initializers_consumed;
   // find defs that require copy
   for (auto& node : graph_.Nodes()) {
@@ -267,6 +280,147 @@ void TransformerMemcpyImpl::ProcessDefs(onnxruntime::Node& node, const KernelReg
   }
 }
 
+// Runs the cheap provider nodes whose outputs are consumed by CPU nodes on CPU as well when all their inputs are
+// already in CPU memory, so the outputs don't need to be copied to host memory. The node is duplicated if provider
+// nodes or the graph outputs also use its outputs, and moved to CPU otherwise.
+// Returns the number of copies avoided.
+size_t TransformerMemcpyImpl::RunCheapNodesOnCpu(const KernelRegistryManager& kernel_registries) {
+  // the producer and consumer maps of the graph may be stale after the previous transformers, so build our own
+  std::map<std::string, const onnxruntime::Node*> producers;
+  std::map<std::string, std::vector<onnxruntime::Node*>> consumers;
+  for (auto& node : graph_.Nodes()) {
+    for (const auto* arg : node.OutputDefs()) {
+      if (arg->Exists()) {
+        producers[arg->Name()] = &node;
+      }
+    }
+    for (const auto* defs : {&node.MutableInputDefs(), &node.MutableImplicitInputDefs()}) {
+      for (const auto* arg : *defs) {
+        if (arg->Exists()) {
+          consumers[arg->Name()].push_back(&node);
+        }
+      }
+    }
+  }
+
+  std::set<std::string> graph_outputs;
+  for (const auto* output : graph_.GetOutputs()) {
+    graph_outputs.insert(output->Name());
+  }
+
+  auto in_cpu_memory = [this, &producers](const onnxruntime::NodeArg& arg) {
+    if (GetInitializer(graph_, arg.Name(), false) != nullptr) {
+      return true;
+    }
+    const auto& inputs = graph_.GetInputs();
+    if (std::find(inputs.cbegin(), inputs.cend(), &arg) != inputs.cend()) {
+      return true;
+    }
+    auto producer = producers.find(arg.Name());
+    return producer != producers.end() && producer->second->GetExecutionProviderType() == kCpuExecutionProvider;
+  };
+
+  std::vector<onnxruntime::Node*> candidates;
+  for (auto& node : graph_.Nodes()) {
+    if (node.GetExecutionProviderType() == provider_ && IsCheapOnCpu(node)) {
+      candidates.push_back(&node);
+    }
+  }
+
+  size_t copies_avoided = 0;
+  for (auto* node : candidates) {
+    const KernelCreateInfo* kci = nullptr;
+    ORT_IGNORE_RETURN_VALUE(kernel_registries.SearchKernelRegistry(*node, &kci));
+    if (kci == nullptr || !std::all_of(node->MutableInputDefs().cbegin(), node->MutableInputDefs().cend(),
+                                       [&](const onnxruntime::NodeArg* arg) {
+                                         return !arg->Exists() || in_cpu_memory(*arg);
+                                       })) {
+      continue;
+    }
+
+    // find the outputs used by CPU nodes and whether the node is still needed on the provider
+    std::map<const onnxruntime::NodeArg*, std::vector<onnxruntime::Node*>> cpu_consumers;
+    bool used_by_provider = false;
+    bool used_implicitly = false;
+    for (size_t i = 0; i < node->OutputDefs().size(); ++i) {
+      const auto* output = node->OutputDefs()[i];
+      if (!output->Exists()) {
+        continue;
+      }
+      if (kci->kernel_def->IsOutputOnCpu(i)) {
+        used_by_provider = true;
+        continue;
+      }
+      used_by_provider = used_by_provider || graph_outputs.count(output->Name()) > 0;
+      for (auto* consumer : consumers[output->Name()]) {
+        const auto& implicit_inputs = consumer->MutableImplicitInputDefs();
+        used_implicitly = used_implicitly ||
+                          std::find(implicit_inputs.cbegin(), implicit_inputs.cend(), output) != implicit_inputs.cend();
+        if (consumer->GetExecutionProviderType() == kCpuExecutionProvider) {
+          cpu_consumers[output].push_back(consumer);
+        } else {
+          used_by_provider = true;
+        }
+      }
+    }
+
+    if (cpu_consumers.empty() || used_implicitly) {
+      continue;
+    }
+
+    // recomputing the outputs must be cheaper than copying them
+    int64_t copy_cost = 0;
+    for (const auto& entry : cpu_consumers) {
+      copy_cost += EstimateCopyCost(*entry.first);
+    }
+    if (EstimateCpuCost(*node) >= copy_cost) {
+      continue;
+    }
+
+    // check that the CPU EP has a kernel for the node
+    node->SetExecutionProviderType(kCpuExecutionProvider);
+    const KernelCreateInfo* cpu_kci = nullptr;
+    ORT_IGNORE_RETURN_VALUE(kernel_registries.SearchKernelRegistry(*node, &cpu_kci));
+    if (cpu_kci == nullptr || used_by_provider) {
+      node->SetExecutionProviderType(provider_);
+    }
+    if (cpu_kci == nullptr) {
+      continue;
+    }
+
+    if (used_by_provider) {
+      std::vector<onnxruntime::NodeArg*> cpu_outputs;
+      std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> replacements;
+      for (auto* output : node->MutableOutputDefs()) {
+        if (!output->Exists()) {
+          cpu_outputs.push_back(output);
+          continue;
+        }
+        auto& cpu_output = graph_.GetOrCreateNodeArg(graph_.GenerateNodeArgName(output->Name() + "_cpu"),
+                                                     output->TypeAsProto());
+        cpu_outputs.push_back(&cpu_output);
+        replacements[output] = &cpu_output;
+      }
+
+      auto& cpu_node = graph_.AddNode(graph_.GenerateNodeName(node->Name() + "_cpu"), node->OpType(),
+                                      "Duplicate of " + node->Name() + " to avoid a copy to host memory",
+                                      node->MutableInputDefs(), cpu_outputs, &node->GetAttributes(), node->Domain());
+      cpu_node.SetSinceVersion(node->SinceVersion());
+      cpu_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+      for (const auto& entry : cpu_consumers) {
+        for (auto* consumer : entry.second) {
+          consumer->ReplaceDefs({{entry.first, replacements[entry.first]}});
+        }
+      }
+    }
+
+    copies_avoided += cpu_consumers.size();
+  }
+
+  return copies_avoided;
+}
+
 //for non_provider defs, collect the nodes that expect it is provider tensor as input/output.
 void TransformerMemcpyImpl::BuildDefsMapping(const onnxruntime::NodeArg* arg, const KernelRegistryManager& kernel_registries) {
   for (auto& it : graph_.Nodes()) {
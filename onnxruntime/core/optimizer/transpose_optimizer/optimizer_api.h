@@ -435,6 +435,11 @@ enum class OptimizerMode {
   OPTIMIZE_LAYOUT_TRANSFORM  // transpose optimization post layout transformation
 };
 
+enum class CostModel {
+  RANK,  // cost of transposing a value is its number of dimensions that aren't 1
+  SIZE   // cost of transposing a value is its estimated number of elements
+};
+
 /// <summary>
 /// Gets a list of layout sensitive ops defined by ONNX standard.
 /// </summary>
@@ -463,12 +468,15 @@ struct OptimizeResult {
 /// <param name="layout_sensitive_ops">List of ops which are treated as layout sensitive by the ONNX standard
 /// as well as any runtime specific ops. These ops should be provided when mode is set to OPTIMIZE_LAYOUT_TRANSFORM.
 /// If these ops are not provided, transpose optimizer may convert the layout for these ops </param>
+/// <param name="cost_model">How the cost of transposing a value is estimated when deciding whether to push a
+/// Transpose. SIZE keeps transposes on small tensors rather than moving them to large activations.</param>
 /// <returns>OptimizeResult. If error_msg is set the Optimize failed. If not set, graph_modified indicates whether
 /// any changes were required during optimization.</returns>
 OptimizeResult Optimize(api::GraphRef& graph, bool allow_extended_ops,
                         const std::string& provider_type = "",
                         OptimizerMode mode = OptimizerMode::OPTIMIZE_TRANSPOSE,
-                        const std::unordered_set<std::string_view>& layout_sensitive_ops = {});
+                        const std::unordered_set<std::string_view>& layout_sensitive_ops = {},
+                        CostModel cost_model = CostModel::RANK);
 
 /* Layout Transformation Tools
  * These methods help change the channel ordering of layout sensitive ops (like Conv). ONNX currently only supports
@@ -15,10 +15,14 @@ Push transposes through ops and eliminate them.
 class TransposeOptimizer : public GraphTransformer {
  private:
   AllocatorPtr cpu_allocator_;
+  // Weigh transposes by the estimated number of elements of the transposed values instead of by their rank.
+  bool size_based_cost_;
 
  public:
-  explicit TransposeOptimizer(AllocatorPtr cpu_allocator) noexcept
-      : GraphTransformer("TransposeOptimizer"), cpu_allocator_(std::move(cpu_allocator)) {}
+  explicit TransposeOptimizer(AllocatorPtr cpu_allocator, bool size_based_cost = false) noexcept
+      : GraphTransformer("TransposeOptimizer"),
+        cpu_allocator_(std::move(cpu_allocator)),
+        size_based_cost_(size_based_cost) {}
 
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
@@ -20,6 +20,7 @@ struct OptimizerCtx {
   const std::string provider_type;
   OptimizerMode mode;
   std::unordered_set<std::string_view> layout_sensitive_ops;
+  CostModel cost_model;
 };
 
 // Each op handler points to a (potentially shared) function for determining which input indices are eligible for
@@ -690,6 +691,31 @@ static int EstimateValueRank(api::GraphRef& graph, std::string_view input) {
   return rank;
 }
 
+// Given a value, returns its estimated number of elements. Symbolic dimensions are assumed to be 64 and values of
+// unknown rank to have 4 of them. Capped to keep sums of costs from overflowing.
+static int64_t EstimateValueSize(api::GraphRef& graph, std::string_view input) {
+  constexpr int64_t kSymbolicDimSize = 64;
+  constexpr int64_t kMaxSize = int64_t{1} << 40;
+  auto value_info = graph.GetValueInfo(input);
+  std::optional<std::vector<int64_t>> shape = value_info->Shape();
+  if (shape == std::nullopt) {
+    return kSymbolicDimSize * kSymbolicDimSize * kSymbolicDimSize * kSymbolicDimSize;
+  }
+  int64_t size = 1;
+  for (int64_t d : *shape) {
+    size = std::min(size * (d >= 0 ? d : kSymbolicDimSize), kMaxSize);
+  }
+  return size;
+}
+
+// Estimates the cost of a transpose of the value, using the cost model of the context.
+static int64_t EstimateValueCost(const OptimizerCtx& ctx, std::string_view input) {
+  if (ctx.cost_model == CostModel::SIZE) {
+    return EstimateValueSize(ctx.graph, input);
+  }
+  return EstimateValueRank(ctx.graph, input);
+}
+
 static const HandlerInfo* GetHandler(api::NodeRef& node, bool allow_extended_ops);
 
 // Returns true if the provided transpose node is only consumed by nodes we can likely push it through.
@@ -706,10 +732,11 @@ static bool CanLikelyRemoveTranspose(api::GraphRef& graph, api::NodeRef& transpo
   return true;
 }
 
-// Estimates the cost of transposing an input. Currently uses rank heuristic. Negative if transpose is removed.
+// Estimates the cost of transposing an input using the cost model of the context. Negative if transpose is removed.
 // Feel free to improve as needed.
-static int EstimateTransposeValueCost(api::GraphRef& graph, std::string_view input,
-                                      const std::vector<int64_t>& perm_inv) {
+static int64_t EstimateTransposeValueCost(const OptimizerCtx& ctx, std::string_view input,
+                                          const std::vector<int64_t>& perm_inv) {
+  api::GraphRef& graph = ctx.graph;
   // Case 1: Transposing constants probably costs nothing.
   std::unique_ptr<api::TensorRef> constant = graph.GetConstant(input);
   if (constant != nullptr) {
@@ -722,7 +749,7 @@ static int EstimateTransposeValueCost(api::GraphRef& graph, std::string_view inp
     std::optional<std::vector<int64_t>> perm2 = GetPermAttrIfValid(*node);
     if (perm2 != std::nullopt) {
       if (*perm2 == perm_inv && CanLikelyRemoveTranspose(graph, *node)) {
-        return -EstimateValueRank(graph, input);
+        return -EstimateValueCost(ctx, input);
       } else {
         return 0;
       }
@@ -730,16 +757,17 @@ static int EstimateTransposeValueCost(api::GraphRef& graph, std::string_view inp
   }
 
   // Case 3: We will likely need to add a transpose.
-  return EstimateValueRank(graph, input);
+  return EstimateValueCost(ctx, input);
 }
 
 // Estimates total cost of transposing a node's inputs. Negative if transposing is beneficial.
-static int EstimateTransposeInputsCost(api::GraphRef& graph, api::NodeRef& node, const std::vector<int64_t>& perm_inv,
-                                       const std::vector<size_t>& input_indices) {
+static int64_t EstimateTransposeInputsCost(const OptimizerCtx& ctx, api::NodeRef& node,
+                                           const std::vector<int64_t>& perm_inv,
+                                           const std::vector<size_t>& input_indices) {
   auto inputs = node.Inputs();
-  int cost = 0;
+  int64_t cost = 0;
   for (size_t j : input_indices) {
-    cost += EstimateTransposeValueCost(graph, inputs[j], perm_inv);
+    cost += EstimateTransposeValueCost(ctx, inputs[j], perm_inv);
   }
   return cost;
 }
@@ -1264,6 +1292,32 @@ static bool HandleArgMinMax(HandlerArgs& args) {
 
 constexpr HandlerInfo arg_min_max_handler = {&FirstInput, &HandleArgMinMax};
 
+// Gather of a transposed data input is a Gather along the permuted axis of the data. Scalar indices remove that axis
+// like Squeeze, 1D indices keep the rank. Indices of higher rank insert several axes and aren't supported.
+static bool HandleGather(HandlerArgs& args) {
+  size_t rank = args.perm.size();
+  int64_t axis = args.node.GetAttributeIntDefault("axis", 0);
+  if (!NormalizeAndValidateAxis(axis, rank)) {
+    return false;
+  }
+
+  std::optional<std::vector<int64_t>> indices_shape = args.ctx.graph.GetValueInfo(args.node.Inputs()[1])->Shape();
+  if (indices_shape == std::nullopt || indices_shape->size() > 1) {
+    return false;
+  }
+
+  int64_t new_axis = args.perm[gsl::narrow_cast<size_t>(axis)];
+  std::vector<int64_t> out_perm = indices_shape->empty() ? SqueezePerm({new_axis}, args.perm) : args.perm;
+
+  args.node.SetAttributeInt("axis", new_axis);
+  TransposeFirstInput(args.ctx, args.node, args.perm_inv);
+  TransposeOutputs(args.ctx, args.node, out_perm);
+
+  return true;
+}
+
+constexpr HandlerInfo gather_handler = {&FirstInput, &HandleGather};
+
 // Creates an int32 or int64 initializer and returns the name (Slice supports int64 or int32 axes)
 static std::string_view AddIntInitializerMatchingDtype(api::GraphRef& graph, std::vector<int64_t> values,
                                                        api::DataType dtype) {
@@ -1591,7 +1645,7 @@ static bool HandleQLinearPoolOp(HandlerArgs& args) {
 constexpr HandlerInfo q_linear_pool_op_handler = {&FirstInput, &HandleQLinearPoolOp};
 
 static bool HandleMaxPool(HandlerArgs& args) {
-  // For CPU EP replace with NhwcMaxPool if possible. Only int8 and uint8 dtypes are supported by NhwcMaxPool.
+  // For CPU EP replace with NhwcMaxPool if possible. Only int8, uint8 and float dtypes are supported by NhwcMaxPool.
   if (args.node.GetExecutionProviderType() != "CPUExecutionProvider") {
     return false;
   }
@@ -1604,7 +1658,7 @@ static bool HandleMaxPool(HandlerArgs& args) {
 
   auto info = args.ctx.graph.GetValueInfo(outputs[0]);
   api::DataType dtype = info->DType();
-  if (dtype != api::DataType::UINT8 && dtype != api::DataType::INT8) {
+  if (dtype != api::DataType::UINT8 && dtype != api::DataType::INT8 && dtype != api::DataType::FLOAT) {
     return false;
   }
 
@@ -1715,6 +1769,8 @@ static const std::unordered_map<std::string_view, const HandlerInfo&> handler_ma
     {"ArgMin", arg_min_max_handler},
     {"ArgMax", arg_min_max_handler},
 
+    {"Gather", gather_handler},
+
     {"Squeeze", squeeze_handler},
     {"Unsqueeze", unsqueeze_handler},
     {"Slice", slice_handler},
@@ -1786,17 +1842,17 @@ bool ProcessTranspose(OptimizerCtx& ctx, api::NodeRef& transpose, api::NodeRef&
     // Strict decrease of the input cost ensures the optimization is stable, since the total cost decrease is just an
     // estimate (the transpose after the op may or may not cancel with a subsequent transpose). We don't want
     // repeated runs of the optimizer to have a transpose toggle between two inputs of a binary op.
-    int cost = EstimateTransposeInputsCost(ctx.graph, node, perm, input_indices);
+    int64_t cost = EstimateTransposeInputsCost(ctx, node, perm, input_indices);
 
     if (cost < 0 && info->transposes_outputs) {
       // If the output will be transposed and won't ultimately cancel, factor in that cost.
       bool has_output_leading_to_transpose = false;
       auto outputs = node.Outputs();
-      int out_cost = 0;
+      int64_t out_cost = 0;
       // Having multiple outputs is rare. When it happens (Split), the total size of the outputs isn't much larger
-      // than the largest input. Cost is rank currently, so just use the largest cost (rank) over all outputs.
+      // than the largest input, so just use the largest cost over all outputs.
       for (auto out : outputs) {
-        out_cost = std::max(out_cost, EstimateValueRank(ctx.graph, out));
+        out_cost = std::max(out_cost, EstimateValueCost(ctx, out));
         if (outputs_leading_to_transpose.find(std::string(out)) != outputs_leading_to_transpose.end()) {
           has_output_leading_to_transpose = true;
         }
@@ -1821,7 +1877,7 @@ bool ProcessTranspose(OptimizerCtx& ctx, api::NodeRef& transpose, api::NodeRef&
 std::optional<OptimizerCtx> MakeOptimizerContext(api::GraphRef& graph, bool allow_extended_ops,
                                                  const std::string& provider_type, OptimizerMode mode,
                                                  const std::unordered_set<std::string_view>& layout_sensitive_ops,
-                                                 std::string& error_msg) {
+                                                 CostModel cost_model, std::string& error_msg) {
   auto opset = graph.Opset("");
   if (opset == std::nullopt) {
     opset = graph.Opset("ai.onnx");
@@ -1846,7 +1902,8 @@ std::optional<OptimizerCtx> MakeOptimizerContext(api::GraphRef& graph, bool allo
   // during layout transformation we want to push the transposes as far out as possible.
   // it is important that the EP gets the entire graph in the layout it prefers.
   bool skip_cost_check = mode == OptimizerMode::OPTIMIZE_LAYOUT_TRANSFORM;
-  OptimizerCtx ctx{*opset, graph, allow_extended_ops, skip_cost_check, provider_type, mode, layout_sensitive_ops};
+  OptimizerCtx ctx{*opset, graph, allow_extended_ops, skip_cost_check, provider_type, mode, layout_sensitive_ops,
+                   cost_model};
   return ctx;
 }
 
@@ -1978,11 +2035,12 @@ const std::unordered_set<std::string_view>& GetLayoutSensitiveOps() {
 
 OptimizeResult Optimize(api::GraphRef& graph, bool allow_extended_ops,
                         const std::string& provider_type, OptimizerMode mode,
-                        const std::unordered_set<std::string_view>& layout_sensitive_ops) {
+                        const std::unordered_set<std::string_view>& layout_sensitive_ops, CostModel cost_model) {
   OptimizeResult result{};
 
   std::string error_msg;
-  auto ctx = MakeOptimizerContext(graph, allow_extended_ops, provider_type, mode, layout_sensitive_ops, error_msg);
+  auto ctx = MakeOptimizerContext(graph, allow_extended_ops, provider_type, mode, layout_sensitive_ops, cost_model,
+                                  error_msg);
   if (ctx == std::nullopt) {
     if (!error_msg.empty()) {
       result.error_msg = error_msg;
@@ -79,6 +79,24 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // Use the lock-free implementation of the per-thread work queues instead of the default one, which takes a lock
+  // when work is pushed from threads other than the queue's owner.
+  bool use_lock_free_queues = false;
+
+  // NUMA node of each thread, in the format returned by Env::GetNumaNodeOfAffinity. Index is thread index. If it is
+  // not empty it must have an entry for every thread. Threads on the same node prefer to steal work from each other
+  // and parallel loops give each node a contiguous part of the iteration space.
+  std::vector<int> numa_nodes;
+
+  // Spin for a duration derived from a moving average of how long the threads wait for work, rather than for a
+  // fixed number of iterations, and block right away when the waits are too long for spinning to pay off.
+  // Only used if the pool is allowed to spin.
+  bool adaptive_spinning = false;
+
+  // The threads are bound to the fastest cores of a hybrid processor, e.g. the P-cores of Intel processors with
+  // P-cores and E-cores. Parallel loops then split their work as for a processor whose cores are all alike.
+  bool performance_cores_only = false;
 };
 /// \brief An interface used by the onnxruntime implementation to
 /// access operating system functionality like the filesystem etc.
@@ -122,6 +140,31 @@ class Env {
   // This function doesn't support systems with more than 64 logical processors
   virtual std::vector<size_t> GetThreadAffinityMasks() const = 0;
 
+  /// \brief Returns the NUMA node of the processor(s) selected by an entry of GetThreadAffinityMasks(), or -1 if
+  /// it is unknown. The default implementation reports every processor as being on node 0.
+  virtual int GetNumaNodeOfAffinity(size_t /*affinity*/) const {
+    return 0;
+  }
+
+  /// \brief Returns the efficiency class of the core(s) selected by an entry of GetThreadAffinityMasks(). Cores of a
+  /// higher class are faster, e.g. the P-cores of a hybrid processor compared to its E-cores. The default
+  /// implementation reports every core as being of class 0.
+  virtual int GetEfficiencyClassOfAffinity(size_t /*affinity*/) const {
+    return 0;
+  }
+
+  /// \brief Asks the operating system to place the pages of [addr, addr + length) on NUMA node numa_node.
+  /// Pages that were already touched are migrated. Partial pages at either end of the range are left alone.
+  virtual common::Status BindMemoryToNumaNode(void* /*addr*/, size_t /*length*/, int /*numa_node*/) const {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "NUMA memory placement is not supported on this platform");
+  }
+
+  /// \brief Asks the operating system to back [addr, addr + length) with huge pages, e.g. transparent huge pages
+  /// on Linux. Only the huge page aligned part of the range can be backed by them.
+  virtual common::Status AdviseHugePages(void* /*addr*/, size_t /*length*/) const {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Huge pages are not supported on this platform");
+  }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -31,6 +31,10 @@ limitations under the License.
 #include <utility>  // for std::forward
 #include <vector>
 #include <assert.h>
+#include <fstream>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
@@ -122,6 +126,107 @@ int nftw_remove(
   return result;
 }
 
+#if defined(__linux__)
+// Parses a sysfs list such as "0-3,8,10-11" into the individual values.
+std::vector<size_t> ParseSysfsList(const std::string& list) {
+  std::vector<size_t> values;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    std::string range = list.substr(pos, end - pos);
+    pos = end + 1;
+    if (range.empty() || !isdigit(static_cast<unsigned char>(range[0]))) {
+      continue;
+    }
+    size_t dash = range.find('-');
+    size_t first = std::stoul(range.substr(0, dash));
+    size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+    for (size_t v = first; v <= last; ++v) {
+      values.push_back(v);
+    }
+  }
+  return values;
+}
+
+std::string ReadFirstLine(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+// Maps each processor id to its NUMA node. Empty if the kernel does not expose the topology.
+const std::vector<int>& GetProcessorNumaNodes() {
+  static const std::vector<int> processor_nodes = []() {
+    std::vector<int> result;
+    ORT_TRY {
+      for (size_t node : ParseSysfsList(ReadFirstLine("/sys/devices/system/node/online"))) {
+        auto cpus = ParseSysfsList(ReadFirstLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+        for (size_t cpu : cpus) {
+          if (cpu >= result.size()) {
+            result.resize(cpu + 1, -1);
+          }
+          result[cpu] = static_cast<int>(node);
+        }
+      }
+    }
+    ORT_CATCH(const std::exception&) {
+      // malformed topology information, treat the machine as having no NUMA information
+      result.clear();
+    }
+    return result;
+  }();
+  return processor_nodes;
+}
+
+// Maps each processor id to the efficiency class of its core. Empty if the kernel does not tell the cores apart.
+const std::vector<int>& GetProcessorEfficiencyClasses() {
+  static const std::vector<int> processor_classes = []() {
+    std::vector<int> result;
+    auto set_class = [&result](size_t cpu, int efficiency_class) {
+      if (cpu >= result.size()) {
+        result.resize(cpu + 1, 0);
+      }
+      result[cpu] = efficiency_class;
+    };
+
+    ORT_TRY {
+      // Intel hybrid processors have a PMU for each type of core
+      const std::string performance_cpus = ReadFirstLine("/sys/devices/cpu_core/cpus");
+      const std::string efficient_cpus = ReadFirstLine("/sys/devices/cpu_atom/cpus");
+      if (!performance_cpus.empty() && !efficient_cpus.empty()) {
+        for (size_t cpu : ParseSysfsList(performance_cpus)) {
+          set_class(cpu, 1);
+        }
+        for (size_t cpu : ParseSysfsList(efficient_cpus)) {
+          set_class(cpu, 0);
+        }
+      } else {
+        // ARM processors with big and little cores report the relative capacity of each core
+        for (size_t cpu : ParseSysfsList(ReadFirstLine("/sys/devices/system/cpu/possible"))) {
+          const std::string capacity =
+              ReadFirstLine("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpu_capacity");
+          if (capacity.empty()) {
+            result.clear();
+            break;
+          }
+          set_class(cpu, std::stoi(capacity));
+        }
+      }
+    }
+    ORT_CATCH(const std::exception&) {
+      // malformed topology information, treat the cores as being alike
+      result.clear();
+    }
+    return result;
+  }();
+  return processor_classes;
+}
+#endif
+
 template <typename T>
 struct Freer {
   void operator()(T* p) { ::free(p); }
@@ -246,6 +351,86 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  int GetNumaNodeOfAffinity(size_t affinity) const override {
+#if defined(__linux__)
+    // affinity entries are processor ids on this platform
+    const auto& processor_nodes = GetProcessorNumaNodes();
+    if (processor_nodes.empty()) {
+      return 0;
+    }
+    return affinity < processor_nodes.size() ? processor_nodes[affinity] : -1;
+#else
+    ORT_UNUSED_PARAMETER(affinity);
+    return 0;
+#endif
+  }
+
+  int GetEfficiencyClassOfAffinity(size_t affinity) const override {
+#if defined(__linux__)
+    // affinity entries are processor ids on this platform
+    const auto& processor_classes = GetProcessorEfficiencyClasses();
+    return affinity < processor_classes.size() ? processor_classes[affinity] : 0;
+#else
+    ORT_UNUSED_PARAMETER(affinity);
+    return 0;
+#endif
+  }
+
+  common::Status BindMemoryToNumaNode(void* addr, size_t length, int numa_node) const override {
+#if defined(__linux__) && defined(SYS_mbind)
+    // values from <linux/mempolicy.h>, which is not always installed
+    constexpr int kMpolPreferred = 1;
+    constexpr unsigned kMpolMfMove = 1 << 1;
+    constexpr size_t kBitsPerMaskWord = sizeof(unsigned long) * 8;
+
+    if (numa_node < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid NUMA node: ", numa_node);
+    }
+
+    // mbind works on whole pages
+    const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(addr) + page_size - 1) & ~(page_size - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + length) & ~(page_size - 1);
+    if (end <= begin) {
+      return Status::OK();
+    }
+
+    std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / kBitsPerMaskWord + 1, 0);
+    node_mask[static_cast<size_t>(numa_node) / kBitsPerMaskWord] |= 1UL << (static_cast<size_t>(numa_node) % kBitsPerMaskWord);
+
+    // Prefer rather than bind so an allocation still succeeds when the node runs out of memory
+    long ret = syscall(SYS_mbind, reinterpret_cast<void*>(begin), end - begin, kMpolPreferred, node_mask.data(),
+                       node_mask.size() * kBitsPerMaskWord + 1, kMpolMfMove);
+    if (ret != 0) {
+      auto [err_no, err_msg] = GetSystemError();
+      return common::Status(common::SYSTEM, err_no, MakeString("mbind failed, error code: ", err_no, " error msg: ", err_msg));
+    }
+    return Status::OK();
+#else
+    return Env::BindMemoryToNumaNode(addr, length, numa_node);
+#endif
+  }
+
+  common::Status AdviseHugePages(void* addr, size_t length) const override {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // madvise works on whole pages, the kernel then uses huge pages for the 2MB aligned parts of the range
+    const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(addr) + page_size - 1) & ~(page_size - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + length) & ~(page_size - 1);
+    if (end <= begin) {
+      return Status::OK();
+    }
+
+    if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) != 0) {
+      auto [err_no, err_msg] = GetSystemError();
+      return common::Status(common::SYSTEM, err_no, MakeString("madvise failed, error code: ", err_no, " error msg: ", err_msg));
+    }
+    return Status::OK();
+#else
+    return Env::AdviseHugePages(addr, length);
+#endif
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+// Static tracing probes for Linux perf, bpftrace, BCC and SystemTap.
+//
+// When built with onnxruntime_ENABLE_USDT_PROBES, each probe is a USDT (user statically-defined tracing) probe of
+// the "onnxruntime" provider: a single nop instruction plus an ELF note telling the tracers where it is and how to
+// read its arguments. A tracer attached to the probe replaces the nop with a breakpoint, so a probe costs nothing
+// but the evaluation of its arguments while nobody traces it. The arguments are kept to integers and pointers that
+// are already at hand. Without the option the probes compile to nothing.
+//
+// Probes (the "__" in the names is shown as "-" by the tracers):
+//   run__start(session_id, run_tag)                  InferenceSession::Run, before the graph is executed
+//   run__end(session_id, status_code)                InferenceSession::Run, after the graph is executed
+//   node__start(node_index, op_type, node_name)      before a kernel computes
+//   node__end(node_index, op_type, status_code)      after a kernel computes
+//   memcpy(src_device_type, dst_device_type, bytes)  copy of a tensor between devices, see OrtDevice::Type
+//   alloc(allocator_name, ptr, bytes)                allocation from a BFCArena
+//   free(allocator_name, ptr)                        deallocation to a BFCArena
+// Strings are null terminated, e.g. with bpftrace:
+//   bpftrace -e 'usdt:./libonnxruntime.so:onnxruntime:node__start { @start[tid] = nsecs; }
+//                usdt:./libonnxruntime.so:onnxruntime:node__end /@start[tid]/ {
+//                  @us[str(arg1)] = hist((nsecs - @start[tid]) / 1000); delete(@start[tid]); }'
+//   perf probe -x libonnxruntime.so sdt_onnxruntime:node__start && perf record -e sdt_onnxruntime:node__start
+
+#if defined(ORT_USE_USDT_PROBES)
+#include <sys/sdt.h>
+
+#define ORT_PROBE0(name) STAP_PROBE(onnxruntime, name)
+#define ORT_PROBE1(name, a1) STAP_PROBE1(onnxruntime, name, a1)
+#define ORT_PROBE2(name, a1, a2) STAP_PROBE2(onnxruntime, name, a1, a2)
+#define ORT_PROBE3(name, a1, a2, a3) STAP_PROBE3(onnxruntime, name, a1, a2, a3)
+#else
+// the arguments are not evaluated, sizeof only keeps the variables passed to the probes from being unused
+#define ORT_PROBE0(name) \
+  do {                   \
+  } while (false)
+#define ORT_PROBE1(name, a1) \
+  do {                       \
+    (void)sizeof(a1);        \
+  } while (false)
+#define ORT_PROBE2(name, a1, a2)        \
+  do {                                  \
+    (void)sizeof(a1), (void)sizeof(a2); \
+  } while (false)
+#define ORT_PROBE3(name, a1, a2, a3)                      \
+  do {                                                    \
+    (void)sizeof(a1), (void)sizeof(a2), (void)sizeof(a3); \
+  } while (false)
+#endif
@@ -211,6 +211,45 @@ class WindowsEnv : public Env {
     return ret;
   }
 
+  int GetNumaNodeOfAffinity(size_t affinity) const override {
+    // affinity entries are processor masks on this platform. Use the node of the lowest processor in the mask.
+    if (affinity == 0) {
+      return -1;
+    }
+    UCHAR processor = 0;
+    while ((affinity & 1) == 0) {
+      affinity >>= 1;
+      ++processor;
+    }
+    UCHAR node = 0;
+    if (!GetNumaProcessorNode(processor, &node) || node == 0xFF) {
+      return -1;
+    }
+    return static_cast<int>(node);
+  }
+
+  int GetEfficiencyClassOfAffinity(size_t affinity) const override {
+    // affinity entries are the processor masks of the cores of the first processor group on this platform
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+      return 0;
+    }
+    std::unique_ptr<char[]> buffer(new char[length]);
+    auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.get());
+    if (!GetLogicalProcessorInformationEx(RelationProcessorCore, info, &length)) {
+      return 0;
+    }
+    for (DWORD offset = 0; offset < length;) {
+      const auto* core = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.get() + offset);
+      if (core->Processor.GroupMask[0].Group == 0 && core->Processor.GroupMask[0].Mask == affinity) {
+        return static_cast<int>(core->Processor.EfficiencyClass);
+      }
+      offset += core->Size;
+    }
+    return 0;
+  }
+
   static WindowsEnv& Instance() {
     static WindowsEnv default_env;
     return default_env;
@@ -319,8 +358,67 @@ class WindowsEnv : public Env {
     return Status::OK();
   }
 
-  Status MapFileIntoMemory(_In_z_ const ORTCHAR_T*, FileOffsetType, size_t, MappedMemoryPtr&) const override {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MapFileIntoMemory is not implemented on Windows.");
+  Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
+                           MappedMemoryPtr& mapped_memory) const override {
+    ORT_RETURN_IF_NOT(file_path, "file_path == nullptr");
+    ORT_RETURN_IF_NOT(offset >= 0, "offset < 0");
+
+#if WINVER >= _WIN32_WINNT_WIN8
+    wil::unique_hfile file_handle{
+        CreateFile2(file_path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, NULL)};
+#else
+    wil::unique_hfile file_handle{
+        CreateFileW(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)};
+#endif
+    if (file_handle.get() == INVALID_HANDLE_VALUE) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "open file ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+    }
+
+    if (length == 0) {
+      mapped_memory = MappedMemoryPtr{};
+      return Status::OK();
+    }
+
+    // copy-on-write, matching the MAP_PRIVATE mapping on other platforms
+    wil::unique_handle file_mapping_handle{
+        CreateFileMappingW(file_handle.get(), NULL, PAGE_WRITECOPY, 0, 0, NULL)};
+    if (!file_mapping_handle) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CreateFileMapping ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+    }
+
+    // the view offset must be a multiple of the allocation granularity
+    static const DWORD allocation_granularity = []() {
+      SYSTEM_INFO system_info;
+      GetSystemInfo(&system_info);
+      return system_info.dwAllocationGranularity;
+    }();
+    const FileOffsetType offset_to_granularity = offset % static_cast<FileOffsetType>(allocation_granularity);
+    const size_t mapped_length = length + static_cast<size_t>(offset_to_granularity);
+    const uint64_t mapped_offset = static_cast<uint64_t>(offset - offset_to_granularity);
+    void* const mapped_base = MapViewOfFile(file_mapping_handle.get(), FILE_MAP_COPY,
+                                            static_cast<DWORD>(mapped_offset >> 32),
+                                            static_cast<DWORD>(mapped_offset & 0xFFFFFFFF), mapped_length);
+    if (mapped_base == nullptr) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "MapViewOfFile ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+    }
+
+    // the view keeps the file and the mapping alive, so the handles can be closed
+    mapped_memory =
+        MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_granularity,
+                        OrtCallbackInvoker{OrtCallback{UnmapFile, mapped_base}}};
+
+    return Status::OK();
+  }
+
+  static void UnmapFile(void* param) noexcept {
+    if (!UnmapViewOfFile(param)) {
+      const auto error_code = GetLastError();
+      LOGS_DEFAULT(ERROR) << "UnmapViewOfFile failed. errcode = " << error_code << " - "
+                          << std::system_category().message(error_code);
+    }
   }
 
   bool FolderExists(const std::wstring& path) const override {
@@ -51,13 +51,52 @@ arm_compute::TensorShape Conv<T>::ACLReshapeWeightsDepthwise(arm_compute::Tensor
   return shape;
 }
 
+// Map the fused activation to ACL, returns false if ACL can't run it as part of the convolution
+static bool ACLActivationLayerInfo(const MLAS_ACTIVATION& activation, arm_compute::ActivationLayerInfo& info) {
+  using ActivationFunction = arm_compute::ActivationLayerInfo::ActivationFunction;
+  switch (activation.ActivationKind) {
+    case MlasIdentityActivation:
+      info = arm_compute::ActivationLayerInfo();
+      return true;
+    case MlasReluActivation:
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::RELU);
+      return true;
+    case MlasLeakyReluActivation:
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::LEAKY_RELU, activation.Parameters.LeakyRelu.alpha);
+      return true;
+    case MlasTanhActivation:
+      // ACL computes a * tanh(b * x)
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::TANH, 1.0f, 1.0f);
+      return true;
+    case MlasLogisticActivation:
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::LOGISTIC);
+      return true;
+    case MlasClipActivation:
+      // ACL computes min(a, max(b, x))
+      info = arm_compute::ActivationLayerInfo(ActivationFunction::LU_BOUNDED_RELU,
+                                              activation.Parameters.Clip.maximum, activation.Parameters.Clip.minimum);
+      return true;
+    default:
+      return false;
+  }
+}
+
 #ifdef CONV_ACL
 template <typename T>
 Status Conv<T>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
 
   ACLNEConv* pConv;
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+
   ConvLayersIterator it = Conv::convLayers.find((OpKernel*)this);
+  if (it != Conv::convLayers.end() && it->second.inputShape != X->Shape()) {
+    // the layer is reused as long as the input shape is stable, reconfigure it otherwise
+    Conv::convLayers.erase(it);
+    it = Conv::convLayers.end();
+  }
   if (it != Conv::convLayers.end()) {
     pConv = &it->second;
     if (pConv->isDepthwiseCPU == true) {
@@ -66,10 +105,6 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     }
   }
 
-  const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
-  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
-
   const int64_t N = X->Shape()[0];
   const int64_t M = W->Shape()[0];
 
@@ -109,27 +144,11 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   Tensor* Y = context->Output(0, TensorShape(Y_dims));
   LOGS_DEFAULT(VERBOSE) << "Y " << Y->Shape().ToString().c_str();
 
-  arm_compute::ActivationLayerInfo::ActivationFunction acl_activ_func;
-  bool acl_activ_enabled = false;
-
-  if (activation_type == "Relu") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::RELU;
-    acl_activ_enabled = true;
-    LOGS_DEFAULT(VERBOSE) << "ACL Conv-Relu fused implementation";
-  } else if (activation_type == "LeakyRelu") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::LEAKY_RELU;
-    acl_activ_enabled = true;
-    LOGS_DEFAULT(VERBOSE) << "ACL Conv-LeakyRelu fused implementation";
-  } else if (activation_type == "Tanh") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::TANH;
-    acl_activ_enabled = true;
-    LOGS_DEFAULT(VERBOSE) << "ACL Conv-Tanh fused implementation";
-  } else if (activation_type == "Sigmoid") {
-    acl_activ_func = arm_compute::ActivationLayerInfo::ActivationFunction::LOGISTIC;
-    acl_activ_enabled = true;
-    LOGS_DEFAULT(VERBOSE) << "ACL Conv-Sigmoid fused implementation";
-  } else if (!activation_type.empty()) {
-    ORT_NOT_IMPLEMENTED("Not implemented fused activation: ", activation_type);
+  arm_compute::ActivationLayerInfo acl_activ_info;
+  if (!ACLActivationLayerInfo(this->activation_, acl_activ_info)) {
+    LOGS_DEFAULT(WARNING) << "ACL does not support the fused activation; defaulting to cpu implementation";
+    Status s = onnxruntime::Conv<T>::Compute(context);
+    return s;
   }
 
   if (it == Conv::convLayers.end()) {
@@ -156,6 +175,8 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     const int idx_channel = arm_compute::get_data_layout_dimension_index(data_layout, arm_compute::DataLayoutDimension::CHANNEL);
     bool isDepthwise = (conv_attrs_.group > 1 && conv_attrs_.group == tconv.in->info()->tensor_shape()[idx_channel]);
     tconv.isDepthwiseCPU = isDepthwise;
+    tconv.inputShape = X->Shape();
+    tconv.constWeights = false;
 
     std::vector<int64_t> aclStrides(2);
     aclStrides[0] = (strides.size() == 2) ? strides[1] : 1;
@@ -222,9 +243,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
                                                                            tconv.out->info(),
                                                                            aclPadStride,
                                                                            1 /* depth multiplier */,
-                                                                           acl_activ_enabled ?
-                                                                              arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) :
-                                                                              arm_compute::ActivationLayerInfo(),
+                                                                           acl_activ_info,
                                                                            arm_compute::Size2D(aclDilation0, dilations[0])));
 #endif
 
@@ -241,11 +260,11 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 #ifdef ACL_1902
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride, 1 /* depth multiplier */,
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo());
+                         acl_activ_info);
 #elif defined(ACL_1905) || defined(ACL_1908) || defined(ACL_2002)
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride, 1 /* depth multiplier */,
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo(),
+                         acl_activ_info,
                          arm_compute::Size2D(aclDilation0, dilations[0]));
 #endif
         tconv.layer = std::move(layer);
@@ -274,7 +293,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
         layer->configure(tconv.in.get(), tconv.k.get(), (B != nullptr) ? tconv.b.get() : nullptr, tconv.out.get(),
                          aclPadStride,
                          arm_compute::WeightsInfo(), arm_compute::Size2D(aclDilation0, dilations[0]),
-                         acl_activ_enabled ? arm_compute::ActivationLayerInfo(acl_activ_func, conv_attrs_.alpha) : arm_compute::ActivationLayerInfo(),
+                         acl_activ_info,
                          false, conv_attrs_.group);
         tconv.layer = std::move(layer);
       }
@@ -282,6 +301,18 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
     tconv.out->info()->set_format(tconv.in->info()->format());
 
+    // constant weights are imported once, ACL reshapes them on the first run only
+    const Tensor* constW = nullptr;
+    const Tensor* constB = nullptr;
+    if (OpKernel::Info().TryGetConstantInput(1, &constW) && constW == W &&
+        (B == nullptr || (OpKernel::Info().TryGetConstantInput(2, &constB) && constB == B))) {
+      ACLImportMemory(tconv.k->allocator(), (void*)W->template Data<T>(), W->Shape().Size() * 4);
+      if (B != nullptr) {
+        ACLImportMemory(tconv.b->allocator(), (void*)B->template Data<T>(), B->Shape().Size() * 4);
+      }
+      tconv.constWeights = true;
+    }
+
     std::pair<ConvLayersIterator, bool> ret;
     ret = Conv::convLayers.insert(std::pair<OpKernel*, ACLNEConv>((OpKernel*)this, tconv));
     pConv = &ret.first->second;
@@ -302,12 +333,14 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
     ACLImportMemory(pConv->in->allocator(), (void*)x_data, X->Shape().Size() * 4);
   }
 
-  const T* k_data = W->template Data<T>();
-  ACLImportMemory(pConv->k->allocator(), (void*)k_data, W->Shape().Size() * 4);
+  if (!pConv->constWeights) {
+    const T* k_data = W->template Data<T>();
+    ACLImportMemory(pConv->k->allocator(), (void*)k_data, W->Shape().Size() * 4);
 
-  if (B != nullptr) {
-    const T* b_data = B->template Data<T>();
-    ACLImportMemory(pConv->b->allocator(), (void*)b_data, B->Shape().Size() * 4);
+    if (B != nullptr) {
+      const T* b_data = B->template Data<T>();
+      ACLImportMemory(pConv->b->allocator(), (void*)b_data, B->Shape().Size() * 4);
+    }
   }
 
   T* y_data = Y->template MutableData<T>();
@@ -327,9 +360,11 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   }
 
   pConv->in->allocator()->free();
-  pConv->k->allocator()->free();
-  if (B != nullptr)
-    pConv->b->allocator()->free();
+  if (!pConv->constWeights) {
+    pConv->k->allocator()->free();
+    if (B != nullptr)
+      pConv->b->allocator()->free();
+  }
   pConv->out->allocator()->free();
 
   LOGS_DEFAULT(VERBOSE) << std::endl;
@@ -31,6 +31,10 @@ typedef struct
   std::shared_ptr<arm_compute::Tensor> b;
   std::shared_ptr<arm_compute::Tensor> out;
   bool isDepthwiseCPU;
+  // input shape the layer was configured for
+  TensorShape inputShape;
+  // weights and bias are initializers imported once at configuration
+  bool constWeights;
 } ACLNEConv;
 
 typedef std::map<OpKernel*, ACLNEConv>::iterator ConvLayersIterator;
@@ -53,7 +57,6 @@ class Conv : public onnxruntime::Conv<T> {
   static thread_local std::map<OpKernel*, ACLNEConv> convLayers;
   ConvAttributes conv_attrs_;
   ACLExecutionProvider* provider_;
-  std::string activation_type;
 
   arm_compute::TensorShape ACLReshapeWeightsDepthwise(arm_compute::Tensor* kernel) const;
 };
@@ -20,7 +20,6 @@ namespace acl{
 class FusedConv final : public acl::Conv<float> {
 public:
   explicit FusedConv(const OpKernelInfo& info) : acl::Conv<float>(info) {
-    ORT_ENFORCE(info.GetAttr<std::string>("activation", &(this->activation_type)).IsOK());
     ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
   }
 };
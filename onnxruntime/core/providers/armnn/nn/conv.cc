@@ -89,6 +89,41 @@ armnn::DepthwiseConvolution2dDescriptor createDepthwiseDescriptor(armnn::Convolu
   return depthwiseDescriptor;
 }
 
+// Map the fused activation to ArmNN, returns false if ArmNN can't run it after the convolution
+static bool ArmNNActivationDescriptor(const MLAS_ACTIVATION& activation, armnn::ActivationDescriptor& desc,
+                                      bool& enabled) {
+  enabled = true;
+  switch (activation.ActivationKind) {
+    case MlasIdentityActivation:
+      enabled = false;
+      return true;
+    case MlasReluActivation:
+      desc.m_Function = armnn::ActivationFunction::ReLu;
+      return true;
+    case MlasLeakyReluActivation:
+      desc.m_Function = armnn::ActivationFunction::LeakyReLu;
+      desc.m_A = activation.Parameters.LeakyRelu.alpha;
+      return true;
+    case MlasTanhActivation:
+      // ArmNN computes a * tanh(b * x)
+      desc.m_Function = armnn::ActivationFunction::TanH;
+      desc.m_A = 1.0f;
+      desc.m_B = 1.0f;
+      return true;
+    case MlasLogisticActivation:
+      desc.m_Function = armnn::ActivationFunction::Sigmoid;
+      return true;
+    case MlasClipActivation:
+      // ArmNN computes min(a, max(b, x))
+      desc.m_Function = armnn::ActivationFunction::BoundedReLu;
+      desc.m_A = activation.Parameters.Clip.maximum;
+      desc.m_B = activation.Parameters.Clip.minimum;
+      return true;
+    default:
+      return false;
+  }
+}
+
 template <typename T>
 Status Conv<T>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
@@ -113,6 +148,14 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
   ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
 
+  armnn::ActivationDescriptor desc;
+  bool armnn_activ_enabled = true;
+  if (!ArmNNActivationDescriptor(this->activation_, desc, armnn_activ_enabled)) {
+    LOGS_DEFAULT(WARNING) << "ArmNN does not support the fused activation; defaulting to cpu implementation";
+    Status s = onnxruntime::Conv<T>::Compute(context);
+    return s;
+  }
+
   LOGS_DEFAULT(VERBOSE) << "Conv ArmNN:";
   LOGS_DEFAULT(VERBOSE) << "X " << X->Shape().ToString().c_str();
   LOGS_DEFAULT(VERBOSE) << "W " << W->Shape().ToString().c_str();
@@ -218,30 +261,6 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
       }
     }
 
-    bool armnn_activ_enabled = false;
-    armnn::ActivationDescriptor desc;
-    desc.m_A = conv_attrs_.alpha;
-
-    if (activation_type == "Relu") {
-      desc.m_Function = armnn::ActivationFunction::ReLu;
-      LOGS_DEFAULT(VERBOSE) << "ArmNN Conv-Relu fused implementation";
-      armnn_activ_enabled = true;
-    } else if (activation_type == "LeakyRelu") {
-      desc.m_Function = armnn::ActivationFunction::LeakyReLu;
-      LOGS_DEFAULT(VERBOSE) << "ArmNN Conv-LeakyRelu fused implementation";
-      armnn_activ_enabled = true;
-    } else if (activation_type == "Tanh") {
-      desc.m_Function = armnn::ActivationFunction::TanH;
-      LOGS_DEFAULT(VERBOSE) << "ArmNN Conv-Tanh fused implementation";
-      armnn_activ_enabled = true;
-    } else if (activation_type == "Sigmoid") {
-      desc.m_Function = armnn::ActivationFunction::Sigmoid;
-      LOGS_DEFAULT(VERBOSE) << "ArmNN Conv-Sigmoid fused implementation";
-      armnn_activ_enabled = true;
-    } else if (!activation_type.empty()) {
-      ORT_NOT_IMPLEMENTED("Not implemented fused activation: ", activation_type);
-    }
-
     armnn::IConnectableLayer* activation = myNetwork->AddActivationLayer(desc, "activation_armnn");
 
     armnn::IConnectableLayer* InputLayer = myNetwork->AddInputLayer(0);
@@ -44,7 +44,6 @@ class Conv : public onnxruntime::Conv<T> {
   ConvAttributes conv_attrs_;
   ArmNNExecutionProvider* provider_;
   static armnn::IRuntimePtr run;
-  std::string activation_type;
 
 };
 
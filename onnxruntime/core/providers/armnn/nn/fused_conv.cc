@@ -23,7 +23,6 @@ namespace armnn_ep{
 class FusedConv final : public armnn_ep::Conv<float> {
 public:
   explicit FusedConv(const OpKernelInfo& info) : armnn_ep::Conv<float>(info) {
-    ORT_ENFORCE(info.GetAttr<std::string>("activation", &(this->activation_type)).IsOK());
     ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
   }
 };
@@ -2,12 +2,14 @@
 // Licensed under the MIT License.
 
 #include <fstream>
+#include <iomanip>
 #include <core/common/safeint.h>
 
 #include "model_builder.h"
 #include "helper.h"
 #include "op_builder_factory.h"
 
+#include "core/framework/murmurhash3.h"
 #include "core/providers/common.h"
 #include "core/providers/coreml/model/model.h"
 #include "core/providers/coreml/model/host_utils.h"
@@ -210,7 +212,7 @@ Status ModelBuilder::RegisterModelOutputs() {
 
 Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path) {
   ORT_RETURN_IF_ERROR(SaveCoreMLModel(path));
-  model.reset(new Model(path, logger_, coreml_flags_));
+  model.reset(new Model(path, compiled_model_cache_path_, logger_, coreml_flags_));
   model->SetScalarOutputs(std::move(scalar_outputs_));
   model->SetInt64Outputs(std::move(int64_outputs_));
   model->SetInputOutputInfo(std::move(input_output_info_));
@@ -219,8 +221,26 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& p
 
 Status ModelBuilder::SaveCoreMLModel(const std::string& path) {
   ORT_RETURN_IF_ERROR(Initialize());
+  std::string serialized_model;
+  ORT_RETURN_IF_NOT(coreml_model_->SerializeToString(&serialized_model), "Serialize the CoreML model failed");
   std::ofstream stream(path, std::ofstream::out | std::ofstream::binary);
-  ORT_RETURN_IF_NOT(coreml_model_->SerializeToOstream(&stream), "Save the CoreML model failed");
+  stream.write(serialized_model.data(), serialized_model.size());
+  ORT_RETURN_IF_NOT(stream.good(), "Save the CoreML model failed");
+
+  if (!compiled_model_cache_dir_.empty()) {
+    // The compiled model is keyed by the content of the CoreML model, so any change to the partition,
+    // its weights or the way we convert it results in a new entry
+    uint32_t hash[4];
+    MurmurHash3::x86_128(serialized_model.data(), static_cast<int>(serialized_model.size()), 0, hash);
+    std::ostringstream file_name;
+    file_name << std::hex << std::setfill('0');
+    for (const auto h : hash) {
+      file_name << std::setw(8) << h;
+    }
+
+    file_name << ".mlmodelc";
+    compiled_model_cache_path_ = compiled_model_cache_dir_ + "/" + file_name.str();
+  }
 
   // TODO, Delete, debug only
   if (const char* path = std::getenv("ORT_COREML_EP_CONVERTED_MODEL_PATH")) {
@@ -23,6 +23,10 @@ class ModelBuilder {
   Status Compile(std::unique_ptr<Model>& model, const std::string& path) ORT_MUST_USE_RESULT;
   Status SaveCoreMLModel(const std::string& path) ORT_MUST_USE_RESULT;
 
+  // Keep the compiled CoreML model in the given directory, and reuse it if it is already there
+  // It is off by default (empty directory)
+  void SetCompiledModelCacheDir(const std::string& cache_dir) { compiled_model_cache_dir_ = cache_dir; }
+
   // Accessors for members
   const GraphViewer& GetGraphViewer() const { return graph_viewer_; }
   const InitializedTensorSet& GetInitializerTensors() const { return graph_viewer_.GetAllInitializedTensors(); }
@@ -43,6 +47,10 @@ class ModelBuilder {
   const logging::Logger& logger_;
   uint32_t coreml_flags_;
 
+  std::string compiled_model_cache_dir_;
+  // Path of the compiled model in the cache, set by SaveCoreMLModel if the cache is enabled
+  std::string compiled_model_cache_path_;
+
   std::unique_ptr<CoreML::Specification::Model> coreml_model_;
   std::unordered_set<std::string> scalar_outputs_;
   std::unordered_set<std::string> int64_outputs_;
@@ -20,9 +20,16 @@ namespace onnxruntime {
 
 constexpr const char* COREML = "CoreML";
 
-CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags)
+CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags,
+                                                 const optional<std::string>& compiled_model_cache_dir)
     : IExecutionProvider{onnxruntime::kCoreMLExecutionProvider, true},
       coreml_flags_(coreml_flags) {
+#ifdef __APPLE__
+  compiled_model_cache_dir_ = compiled_model_cache_dir.value_or("");
+#else
+  ORT_UNUSED_PARAMETER(compiled_model_cache_dir);
+#endif
+
   AllocatorCreationInfo device_info(
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(COREML, OrtAllocatorType::OrtDeviceAllocator));
@@ -104,6 +111,7 @@ common::Status CoreMLExecutionProvider::Compile(const std::vector<FusedNodeAndGr
     const onnxruntime::GraphViewer& graph_viewer(fused_node_and_graph.filtered_graph);
 
     coreml::ModelBuilder builder(graph_viewer, *GetLogger(), coreml_flags_);
+    builder.SetCompiledModelCacheDir(compiled_model_cache_dir_);
     std::unique_ptr<coreml::Model> coreml_model;
     const std::string coreml_model_file_path = coreml::util::GetTemporaryFilePath();
     ORT_RETURN_IF_ERROR(builder.Compile(coreml_model, coreml_model_file_path));
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/common/optional.h"
 #include "core/framework/execution_provider.h"
 #include "core/providers/coreml/coreml_provider_factory.h"
 
@@ -13,7 +14,7 @@ class Model;
 
 class CoreMLExecutionProvider : public IExecutionProvider {
  public:
-  CoreMLExecutionProvider(uint32_t coreml_flags);
+  CoreMLExecutionProvider(uint32_t coreml_flags, const optional<std::string>& compiled_model_cache_dir = {});
   virtual ~CoreMLExecutionProvider();
 
   std::vector<std::unique_ptr<ComputeCapability>>
@@ -33,8 +34,10 @@ class CoreMLExecutionProvider : public IExecutionProvider {
   const uint32_t coreml_flags_;
 
  private:
-  // <fused_node_name, <coreml_model_file_path, compiled_coreml_model>>
   #ifdef __APPLE__
+  // Directory of the compiled CoreML models cache, empty if the cache is disabled
+  std::string compiled_model_cache_dir_;
+  // <fused_node_name, <coreml_model_file_path, compiled_coreml_model>>
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::coreml::Model>> coreml_models_;
   #endif
 };
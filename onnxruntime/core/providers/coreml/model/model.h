@@ -59,7 +59,10 @@ class Model {
 
   OrtMutex mutex_;
 
-  Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  // The model is compiled from the CoreML model at path, unless there is already a compiled model at
+  // compiled_model_cache_path. A newly compiled model is moved there, if compiled_model_cache_path is not empty.
+  Model(const std::string& path, const std::string& compiled_model_cache_path,
+        const logging::Logger& logger, uint32_t coreml_flags);
   onnxruntime::common::Status LoadModel();
 
   void SetInputOutputInfo(std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info) {
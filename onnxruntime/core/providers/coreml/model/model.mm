@@ -35,17 +35,20 @@
 // Execution for a CoreML model, it performs
 // 1. Compile the model by given path for execution
 // 2. Predict using given OnnxTensorFeatureProvider input and copy the output data back ORT
-// 3. The compiled model will be removed in dealloc or removed using cleanup function
+// 3. The compiled model will be removed in dealloc or removed using cleanup function,
+//    unless it is kept in the compiled model cache
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
   NSString* compiled_model_path_;
+  NSString* compiled_model_cache_path_;
   const onnxruntime::logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const onnxruntime::logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags;
+    compiled_model_cache_path:(const std::string&)compiled_model_cache_path
+                       logger:(const onnxruntime::logging::Logger&)logger
+                 coreml_flags:(uint32_t)coreml_flags;
 - (void)cleanup;
 - (void)dealloc;
 - (onnxruntime::common::Status)loadModel API_AVAILABLE_OS_VERSIONS;
@@ -136,10 +139,14 @@
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const onnxruntime::logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags {
+    compiled_model_cache_path:(const std::string&)compiled_model_cache_path
+                       logger:(const onnxruntime::logging::Logger&)logger
+                 coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = [NSString stringWithUTF8String:path.c_str()];
+    if (!compiled_model_cache_path.empty()) {
+      compiled_model_cache_path_ = [NSString stringWithUTF8String:compiled_model_cache_path.c_str()];
+    }
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -174,6 +181,26 @@
 
 - (onnxruntime::common::Status)loadModel {
   NSError* error = nil;
+  MLModelConfiguration* config = [MLModelConfiguration alloc];
+  config.computeUnits = MLComputeUnitsAll;
+
+  if (compiled_model_cache_path_ != nil &&
+      [[NSFileManager defaultManager] fileExistsAtPath:compiled_model_cache_path_]) {
+    NSURL* cachedUrl = [NSURL fileURLWithPath:compiled_model_cache_path_ isDirectory:YES];
+    _model = [MLModel modelWithContentsOfURL:cachedUrl configuration:config error:&error];
+    if (error == nil) {
+      LOGS(*logger_, VERBOSE) << "Loaded the compiled model from the cache: " << [compiled_model_cache_path_ UTF8String];
+      return onnxruntime::common::Status::OK();
+    }
+
+    // The cached model may be stale, e.g. compiled by a different version of CoreML, compile the model again
+    LOGS(*logger_, WARNING) << "Failed loading the cached compiled model: " << [compiled_model_cache_path_ UTF8String]
+                            << ", error message: " << [[error localizedDescription] UTF8String];
+    error = nil;
+    [[NSFileManager defaultManager] removeItemAtPath:compiled_model_cache_path_ error:&error];
+    error = nil;
+  }
+
   NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
   NSAssert(modelUrl != nil, @"modelUrl must not be nil");
   NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
@@ -185,8 +212,19 @@
 
   compiled_model_path_ = [compileUrl path];
 
-  MLModelConfiguration* config = [MLModelConfiguration alloc];
-  config.computeUnits = MLComputeUnitsAll;
+  if (compiled_model_cache_path_ != nil) {
+    // Another session may have cached the same model in the meantime, then we keep using our temporary copy
+    NSURL* cachedUrl = [NSURL fileURLWithPath:compiled_model_cache_path_ isDirectory:YES];
+    if ([[NSFileManager defaultManager] moveItemAtURL:compileUrl toURL:cachedUrl error:&error]) {
+      compileUrl = cachedUrl;
+      compiled_model_path_ = nil;
+    } else {
+      LOGS(*logger_, WARNING) << "Failed caching the compiled model: " << [compiled_model_cache_path_ UTF8String]
+                              << ", error message: " << [[error localizedDescription] UTF8String];
+    }
+    error = nil;
+  }
+
   _model = [MLModel modelWithContentsOfURL:compileUrl configuration:config error:&error];
 
   if (error != NULL) {
@@ -296,7 +334,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& compiled_model_cache_path,
+            const logging::Logger& logger, uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -308,8 +347,10 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& compiled_model_cache_path,
+                     const logging::Logger& logger, uint32_t coreml_flags) {
   execution_ = [[CoreMLExecution alloc] initWithPath:path
+                           compiled_model_cache_path:compiled_model_cache_path
                                               logger:logger
                                         coreml_flags:coreml_flags];
 }
@@ -339,8 +380,9 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::LoadModel requires macos 10.15+ or ios 13+ ");
 }
 
-Model::Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)) {
+Model::Model(const std::string& path, const std::string& compiled_model_cache_path,
+             const logging::Logger& logger, uint32_t coreml_flags)
+    : execution_(std::make_unique<Execution>(path, compiled_model_cache_path, logger, coreml_flags)) {
 }
 
 Model::~Model() {}
@@ -4,6 +4,8 @@
 #include "core/providers/cpu/controlflow/if.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include <algorithm>
+
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
@@ -138,6 +140,9 @@ class IfImpl {
  private:
   Status AllocateOutputTensors();
 
+  // Sets the outputs that are outer scope values or initializers of the subgraph.
+  Status SetUnfetchedOutputs();
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const If::Info& info_;
@@ -146,7 +151,8 @@ class IfImpl {
 
   enum class AllocationType {
     Delayed,  // allocation of If output will be done by subgraph execution
-    IfOutput
+    IfOutput,
+    NotFetched  // If output is set from the outer scope value or initializer providing it
   };
 
   // track where the fetches provided to subgraph execution were allocated.
@@ -172,6 +178,50 @@ void If::Init(const OpKernelInfo& info) {
   ORT_IGNORE_RETURN_VALUE(proto);
 }
 
+namespace {
+// Returns true if another value of the graph is planned to reuse the buffer of the value, in which case the value
+// cannot alias a buffer it does not own.
+bool IsBufferReused(const SequentialExecutionPlan& plan, int ort_value_idx) {
+  return std::any_of(plan.allocation_plan.cbegin(), plan.allocation_plan.cend(),
+                     [ort_value_idx](const AllocPlanPerValue& value_plan) {
+                       return value_plan.alloc_kind == AllocKind::kReuse &&
+                              value_plan.reused_buffer == ort_value_idx;
+                     });
+}
+
+// Returns true if the If output can alias the outer scope value or the subgraph initializer providing it. The
+// output must not be returned to the caller of the graph and its buffer must not be reused, as both could write to
+// the aliased value. An outer scope value must be a graph input, an outer scope value or an initializer of the
+// graph containing the If node, which remain valid and unchanged while that graph runs.
+bool CanAliasOutput(const SessionState& session_state, const std::string& output_name,
+                    const std::string* outer_scope_name) {
+  const auto* plan = session_state.GetExecutionPlan();
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+
+  int output_idx;
+  if (plan == nullptr || !name_idx_map.GetIdx(output_name, output_idx).IsOK() ||
+      plan->allocation_plan[output_idx].alloc_kind == AllocKind::kAllocateOutput ||
+      IsBufferReused(*plan, output_idx)) {
+    return false;
+  }
+
+  if (outer_scope_name != nullptr) {
+    int value_idx;
+    if (!name_idx_map.GetIdx(*outer_scope_name, value_idx).IsOK()) {
+      return false;
+    }
+
+    const auto alloc_kind = plan->allocation_plan[value_idx].alloc_kind;
+    if ((alloc_kind != AllocKind::kPreExisting && alloc_kind != AllocKind::kAllocateStatically) ||
+        IsBufferReused(*plan, value_idx)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
 common::Status If::SetupSubgraphExecutionInfo(const SessionState& session_state,
                                               const std::string& attribute_name,
                                               const SessionState& subgraph_session_state) {
@@ -204,26 +254,68 @@ common::Status If::SetupSubgraphExecutionInfo(const SessionState& session_state,
     }
   }
 
-  std::unique_ptr<FeedsFetchesManager> ffm;
-  ORT_RETURN_IF_ERROR(FeedsFetchesManager::Create(feed_names, info->subgraph_output_names, subgraph_map, ffm));
-  ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(subgraph_session_state, *ffm));
-
-  // find the location all the feeds will be coming from
-  std::vector<OrtDevice> feed_locations;
-  ORT_RETURN_IF_ERROR(controlflow::detail::FindDevicesForValues(session_state, feed_names, feed_locations));
-
+  // only the outputs produced by the nodes of the subgraph are fetched. tensor outputs that are outer scope values
+  // or initializers of the subgraph are set from those values directly.
+  const auto& outputs = node.OutputDefs();
+  const auto& subgraph_outputs = info->subgraph.GetOutputs();
+  const auto& initializers = subgraph_session_state.GetInitializedTensors();
+  std::vector<std::string> fetch_names;
   std::vector<const OrtMemoryInfo*> fetch_locations;
+  fetch_names.reserve(info->num_outputs);
   fetch_locations.reserve(info->num_outputs);
 
-  // we need the allocator info for each output from the If node
-  // as the subgraph execution will write directly into those buffers
-  const auto& outputs = node.OutputDefs();
   for (int i = 0, end = info->num_outputs; i < end; ++i) {
-    // const auto& alloc_info = controlflow::detail::FindMemoryInfoForValue(session_state, outputs[i]->Name());
+    const std::string& name = info->subgraph_output_names[i];
+
+    // we need the allocator info for each output from the If node
+    // as the subgraph execution will write directly into those buffers
     const auto& alloc_info = utils::FindMemoryInfoForValue(session_state, outputs[i]->Name());
-    fetch_locations.push_back(&alloc_info);
+    info->output_devices.push_back(alloc_info.device);
+
+    int outer_scope_index = -1;
+    const OrtValue* initializer = nullptr;
+
+    if (subgraph_outputs[i]->TypeAsProto()->has_tensor_type() &&
+        info->subgraph.GetProducerNode(name) == nullptr) {
+      for (int j = 0; j < static_cast<int>(implicit_input_defs.size()); ++j) {
+        if (info->used_implicit_inputs[j] && implicit_input_defs[j]->Name() == name) {
+          outer_scope_index = j;
+          break;
+        }
+      }
+
+      int idx;
+      if (outer_scope_index < 0 && subgraph_map.GetIdx(name, idx).IsOK()) {
+        auto entry = initializers.find(idx);
+        if (entry != initializers.cend() && entry->second.IsTensor()) {
+          initializer = &entry->second;
+        }
+      }
+    }
+
+    const bool is_fetched = outer_scope_index < 0 && initializer == nullptr;
+    info->fetch_index.push_back(is_fetched ? static_cast<int>(fetch_names.size()) : -1);
+    info->outer_scope_output_index.push_back(outer_scope_index);
+    info->initializer_outputs.push_back(initializer);
+    info->can_alias_output.push_back(!is_fetched &&
+                                     CanAliasOutput(session_state, outputs[i]->Name(),
+                                                    outer_scope_index >= 0 ? &name : nullptr));
+
+    if (is_fetched) {
+      info->fetched_outputs.push_back(i);
+      fetch_names.push_back(name);
+      fetch_locations.push_back(&alloc_info);
+    }
   }
 
+  std::unique_ptr<FeedsFetchesManager> ffm;
+  ORT_RETURN_IF_ERROR(FeedsFetchesManager::Create(feed_names, fetch_names, subgraph_map, ffm));
+  ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(subgraph_session_state, *ffm));
+
+  // find the location all the feeds will be coming from
+  std::vector<OrtDevice> feed_locations;
+  ORT_RETURN_IF_ERROR(controlflow::detail::FindDevicesForValues(session_state, feed_names, feed_locations));
+
   utils::FinalizeFeedFetchCopyInfo(*ffm, feed_locations, fetch_locations);
 
   if (attribute_name == "then_branch")
@@ -291,6 +383,12 @@ Status IfImpl::AllocateOutputTensors() {
 #endif
 
   for (auto& graph_output : graph_outputs) {
+    if (info_.fetch_index[index] < 0) {
+      outputs_.push_back({AllocationType::NotFetched, {}});
+      ++index;
+      continue;
+    }
+
     const auto* graph_output_type = graph_output->TypeAsProto();
 
 #if !defined(DISABLE_OPTIONAL_TYPE)
@@ -377,15 +475,17 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
   std::vector<OrtValue> fetches;
   std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
-  fetches.reserve(info_.num_outputs);
-  for (int i = 0; i < info_.num_outputs; ++i) {
+  const auto num_fetches = info_.fetched_outputs.size();
+  fetches.reserve(num_fetches);
+  for (size_t f = 0; f < num_fetches; ++f) {
+    const int i = info_.fetched_outputs[f];
     fetches.push_back(outputs_[i].second);
 
     if (outputs_[i].first == AllocationType::Delayed) {
       // functor to forward the allocation request from the subgraph to the If node's context so that the
       // allocation plan for the If node's output is used.
-      fetch_allocators[i] = [this, i, &fetches](const TensorShape& shape, const OrtMemoryInfo& location,
-                                                OrtValue& ort_value, bool& allocated) {
+      fetch_allocators[f] = [this, i, f, &fetches](const TensorShape& shape, const OrtMemoryInfo& location,
+                                                   OrtValue& ort_value, bool& allocated) {
         // if the device the If output is allocated on does not match the required device for the subgraph output
         // we don't update the provided OrtValue and return false for 'allocated'.
         // the execution frame will allocate a buffer on the required device, and the fetches copy
@@ -403,7 +503,7 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
           allocated = true;
         } else {
           // put the allocated value into fetches so the copy logic in utils::ExecuteGraphImpl can use it
-          fetches[i] = value;
+          fetches[f] = value;
         }
 
         return Status::OK();
@@ -411,11 +511,16 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
     }
   }
 
-  status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
-                                  ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(),
-                                  context_.Logger());
+  // a branch whose outputs are all outer scope values or initializers has nothing to execute
+  if (num_fetches > 0) {
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
+                                    ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(),
+                                    context_.Logger());
 
-  ORT_RETURN_IF_ERROR(status);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  ORT_RETURN_IF_ERROR(SetUnfetchedOutputs());
 
 #if !defined(DISABLE_OPTIONAL_TYPE)
   // Deal with Nones in fetches
@@ -423,14 +528,14 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
     // "None" - reflect Nones in the output of If
     // For non-Nones, we would have directly used the custom allocator
     // to directly write-into If's outputs.
-    if (!fetches[output_index].IsAllocated()) {
+    if (!fetches[info_.fetch_index[output_index]].IsAllocated()) {
       context_.OutputOptionalWithoutData<Tensor>(output_index);
     }
   }
 
   for (auto& output_index : optional_tensor_sequence_type_subgraph_outputs_) {
     // "None" - reflect Nones in the output of If
-    if (!fetches[output_index].IsAllocated()) {
+    if (!fetches[info_.fetch_index[output_index]].IsAllocated()) {
       context_.OutputOptionalWithoutData<TensorSeq>(output_index);
     }
   }
@@ -439,4 +544,29 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
   return status;
 }
 
+Status IfImpl::SetUnfetchedOutputs() {
+  for (int i = 0; i < info_.num_outputs; ++i) {
+    if (outputs_[i].first != AllocationType::NotFetched) {
+      continue;
+    }
+
+    const int outer_scope_index = info_.outer_scope_output_index[i];
+    const OrtValue& value = outer_scope_index >= 0 ? *implicit_inputs_[outer_scope_index]
+                                                   : *info_.initializer_outputs[i];
+    const Tensor& src = value.Get<Tensor>();
+
+    if (info_.can_alias_output[i] && src.Location().device == info_.output_devices[i]) {
+      ORT_RETURN_IF_ERROR(context_.SetOutputMLValue(i, value));
+    } else {
+      auto* tensor = context_.Output(i, src.Shape());
+      if (!tensor)
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create output tensor for If output ", i);
+
+      ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(src, *tensor));
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
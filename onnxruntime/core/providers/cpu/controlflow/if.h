@@ -30,6 +30,22 @@ class If : public controlflow::IControlFlowKernel {
     int num_outputs;
 
     std::vector<std::string> subgraph_output_names;
+
+    // Subgraph outputs that are not produced by a node of the subgraph are not fetched from its execution.
+    // They are set from the outer scope value or the initializer that provides them, which the If output aliases
+    // when no other value can write to its buffer, or else copies.
+    // Index of each output in the subgraph fetches, or -1 if it is not fetched.
+    std::vector<int> fetch_index;
+    // If output index of each subgraph fetch.
+    std::vector<int> fetched_outputs;
+    // Index of the implicit input providing each output, or -1.
+    std::vector<int> outer_scope_output_index;
+    // Initializer of the subgraph providing each output, or nullptr.
+    std::vector<const OrtValue*> initializer_outputs;
+    // Whether the If output may alias the value providing it.
+    std::vector<bool> can_alias_output;
+    // Device each If output is expected on.
+    std::vector<OrtDevice> output_devices;
   };
 
  private:
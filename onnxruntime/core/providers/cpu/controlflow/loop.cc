@@ -15,6 +15,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/ort_value_tensor_slicer.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
@@ -173,6 +174,15 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
     auto& output = subgraph_outputs[i];
     subgraph_output_names.push_back(output->Name());
   }
+
+  // a loop body with the trip count as the only exit condition (e.g. a for loop exported from PyTorch) returns the
+  // 'cond' input unchanged
+  condition_is_passthrough = subgraph_output_names[0] == subgraph_input_names[1];
+  if (!condition_is_passthrough) {
+    const Node* producer = subgraph.GetProducerNode(subgraph_output_names[0]);
+    condition_is_passthrough = producer != nullptr && producer->OpType() == "Identity" &&
+                               producer->InputDefs()[0]->Name() == subgraph_input_names[1];
+  }
 }
 
 class LoopImpl {
@@ -192,7 +202,14 @@ class LoopImpl {
 
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
-  void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  Status SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+
+  // write the loop outputs from the last iteration to the current slice of the Loop outputs.
+  // only used if the number of iterations is known upfront.
+  Status SaveOutputsToSlices(const std::vector<OrtValue>& last_outputs);
+
+  // setup fetches so the subgraph writes the loop outputs directly to the current slice of the Loop outputs
+  void CreateSlicedFetches(std::vector<OrtValue>& fetches);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
@@ -213,6 +230,11 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // number of iterations if known upfront, or -1. if known, the Loop outputs are allocated after the first iteration
+  // and each iteration writes to a slice of them instead of them being concatenated after the last iteration.
+  int64_t fixed_trip_count_ = -1;
+  std::vector<OrtValueTensorSlicer<OrtValue>::Iterator> loop_output_iterators_;
+
   const Loop::ConcatOutput& concat_output_func_;
   void* stream_;
 };
@@ -423,6 +445,12 @@ Status LoopImpl::Initialize() {
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
 
+  // the loop runs for exactly 'M' iterations if the subgraph can't change the condition
+  if (info_.condition_is_passthrough && max_trip_count_tensor && condition_ && max_trip_count_ > 0 &&
+      info_.num_outputs > info_.num_loop_carried_vars) {
+    fixed_trip_count_ = max_trip_count_;
+  }
+
   return status;
 }
 
@@ -444,8 +472,8 @@ void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
   }
 }
 
-void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
-                                         std::vector<OrtValue>& next_inputs) {
+Status LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
+                                           std::vector<OrtValue>& next_inputs) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
@@ -454,11 +482,69 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
     next_inputs[i] = last_outputs[i - 1];
   }
 
+  if (fixed_trip_count_ > 0) {
+    return SaveOutputsToSlices(last_outputs);
+  }
+
   // save loop outputs as we have to concatenate at the end
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
     ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
     loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
   }
+
+  return Status::OK();
+}
+
+Status LoopImpl::SaveOutputsToSlices(const std::vector<OrtValue>& last_outputs) {
+  if (loop_output_iterators_.empty()) {
+    // first iteration. the per-iteration shape is now known so we can allocate the Loop outputs.
+    loop_output_iterators_.reserve(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
+    for (int j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+      const auto& per_iteration_output = last_outputs[static_cast<ptrdiff_t>(j) + 1];  // skip 'cond' in output
+      ORT_RETURN_IF_NOT(per_iteration_output.IsTensor(), "All scan outputs MUST be tensors");
+      const auto& per_iteration_dims = per_iteration_output.Get<Tensor>().Shape().GetDims();
+
+      std::vector<int64_t> dims;
+      dims.reserve(1 + per_iteration_dims.size());
+      dims.push_back(fixed_trip_count_);
+      std::copy(per_iteration_dims.begin(), per_iteration_dims.end(), std::back_inserter(dims));
+
+      ORT_RETURN_IF(context_.Output(j, TensorShape(dims)) == nullptr, "Failed to create output tensor for output #", j);
+      loop_output_iterators_.push_back(OrtValueTensorSlicer<OrtValue>::Create(*context_.GetOutputMLValue(j)).begin());
+    }
+  }
+
+  for (int j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+    auto& iterator = loop_output_iterators_[static_cast<ptrdiff_t>(j) - info_.num_loop_carried_vars];
+    const auto& per_iteration_output = last_outputs[static_cast<ptrdiff_t>(j) + 1];  // skip 'cond' in output
+    ORT_RETURN_IF_NOT(per_iteration_output.IsTensor(), "All scan outputs MUST be tensors");
+
+    const auto& src = per_iteration_output.Get<Tensor>();
+    auto& dst = *(*iterator).GetMutable<Tensor>();
+
+    // after the first iteration the subgraph writes to the slice directly. a copy is only needed for the first
+    // iteration, or if the subgraph output is not produced by a node in the subgraph (e.g. it's an implicit input)
+    if (src.DataRaw() != dst.DataRaw()) {
+      if (src.Shape() != dst.Shape()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                               " Expected:", dst.Shape(), " Got:", src.Shape());
+      }
+
+      ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(src, dst));
+    }
+
+    ++iterator;
+  }
+
+  return Status::OK();
+}
+
+void LoopImpl::CreateSlicedFetches(std::vector<OrtValue>& fetches) {
+  // empty entries for 'cond' and the loop carried vars let the subgraph allocate those
+  fetches.resize(info_.num_subgraph_outputs);
+  for (int j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+    fetches[static_cast<ptrdiff_t>(j) + 1] = *loop_output_iterators_[static_cast<ptrdiff_t>(j) - info_.num_loop_carried_vars];
+  }
 }
 
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
@@ -492,14 +578,20 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
-      SaveOutputsAndUpdateFeeds(fetches, feeds);
+      ORT_RETURN_IF_ERROR(SaveOutputsAndUpdateFeeds(fetches, feeds));
       fetches.clear();
+
+      if (!loop_output_iterators_.empty()) {
+        CreateSlicedFetches(fetches);
+      }
     }
 
     status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
 
     ORT_RETURN_IF_ERROR(status);
+    // the subgraph may have been cut short by the termination of the run, stop before using its outputs
+    ORT_RETURN_IF_ERROR(utils::CheckRunTermination(context_.GetTerminateFlag(), context_.Logger()));
 
     condition_mlvalue_ = fetches[0];
 
@@ -573,6 +665,12 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       ORT_RETURN_IF_ERROR(copy_mlvalue_to_output(fetches[static_cast<ptrdiff_t>(i) + 1], i, iter_num_value, *info_.loop_carried_vars_types[static_cast<ptrdiff_t>(i)]));  // skip cond
     }
 
+    if (fixed_trip_count_ > 0) {
+      // the Loop outputs were allocated after the first iteration. add last output.
+      ORT_RETURN_IF_ERROR(SaveOutputsToSlices(fetches));
+      return status;
+    }
+
     for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
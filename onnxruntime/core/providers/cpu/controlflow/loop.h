@@ -39,6 +39,10 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // true if the subgraph 'cond' output is the 'cond' input passed through unchanged (directly or via Identity).
+    // the number of iterations is then known before the first one runs.
+    bool condition_is_passthrough;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
@@ -275,6 +275,8 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
                                     ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger());
 
     ORT_RETURN_IF_ERROR(status);
+    // the subgraph may have been cut short by the termination of the run, stop before using its outputs
+    ORT_RETURN_IF_ERROR(utils::CheckRunTermination(context.GetTerminateFlag(), context.Logger()));
 
     // cycle the LoopStateVariable input/output in preparation for the next iteration
     std::for_each(loop_state_variables.begin(), loop_state_variables.end(), [](LoopStateVariable& v) { v.Next(); });
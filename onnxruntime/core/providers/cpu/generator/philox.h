@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace onnxruntime {
+namespace philox {
+
+// Philox4x32-10 from Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3".
+// Every 128-bit counter gives a block of four random 32-bit words, so any part of a stream can be generated
+// without generating what comes before it. The random kernels use the seed as key and the offset of a
+// PhiloxGenerator plus the index of the block as counter, which makes their output independent of the number of
+// threads that generate it.
+using Block = std::array<uint32_t, 4>;
+
+constexpr uint32_t kMultiplier0 = 0xD2511F53;
+constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+constexpr uint32_t kWeyl0 = 0x9E3779B9;
+constexpr uint32_t kWeyl1 = 0xBB67AE85;
+constexpr int kRounds = 10;
+
+inline Block Philox4x32x10(Block counter, uint32_t key0, uint32_t key1) {
+  for (int round = 0; round < kRounds; ++round) {
+    const uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * counter[0];
+    const uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * counter[2];
+    counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key0,
+               static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key1,
+               static_cast<uint32_t>(product0)};
+    key0 += kWeyl0;
+    key1 += kWeyl1;
+  }
+  return counter;
+}
+
+// Returns the block with the given index in the stream of seed.
+inline Block GenerateBlock(uint64_t seed, uint64_t index) {
+  return Philox4x32x10({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), 0, 0},
+                       static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+}
+
+// Number of blocks that GenerateBlocks computes together.
+constexpr int kBatchSize = 16;
+
+// Writes the words of the blocks first_index, ..., first_index + kBatchSize - 1 of the stream of seed to words,
+// block after block. It gives the same words as GenerateBlock, with the rounds of all the blocks computed in the
+// same loop so that the compiler vectorizes the multiplications.
+inline void GenerateBlocks(uint64_t seed, uint64_t first_index, uint32_t* words) {
+  uint32_t c0[kBatchSize];
+  uint32_t c1[kBatchSize];
+  uint32_t c2[kBatchSize];
+  uint32_t c3[kBatchSize];
+  for (int i = 0; i < kBatchSize; ++i) {
+    const uint64_t index = first_index + i;
+    c0[i] = static_cast<uint32_t>(index);
+    c1[i] = static_cast<uint32_t>(index >> 32);
+    c2[i] = 0;
+    c3[i] = 0;
+  }
+
+  uint32_t key0 = static_cast<uint32_t>(seed);
+  uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+  for (int round = 0; round < kRounds; ++round) {
+    for (int i = 0; i < kBatchSize; ++i) {
+      const uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * c0[i];
+      const uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * c2[i];
+      c0[i] = static_cast<uint32_t>(product1 >> 32) ^ c1[i] ^ key0;
+      c1[i] = static_cast<uint32_t>(product1);
+      c2[i] = static_cast<uint32_t>(product0 >> 32) ^ c3[i] ^ key1;
+      c3[i] = static_cast<uint32_t>(product0);
+    }
+    key0 += kWeyl0;
+    key1 += kWeyl1;
+  }
+
+  for (int i = 0; i < kBatchSize; ++i) {
+    words[4 * i] = c0[i];
+    words[4 * i + 1] = c1[i];
+    words[4 * i + 2] = c2[i];
+    words[4 * i + 3] = c3[i];
+  }
+}
+
+// Uniform float in [0, 1) from the 24 high bits of a word.
+inline float UniformFloat(uint32_t x) {
+  return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform double in [0, 1) from the 53 high bits of two words.
+inline double UniformDouble(uint32_t x, uint32_t y) {
+  const uint64_t bits = ((static_cast<uint64_t>(x) << 32) | y) >> 11;
+  return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+}
+
+// Box-Muller transform of two uniform values to two standard normal values. u1 must be in (0, 1], which the
+// callers get as 1 - UniformFloat or 1 - UniformDouble, so that its logarithm is finite.
+template <typename T>
+inline void BoxMuller(T u1, T u2, T& z0, T& z1) {
+  const T radius = std::sqrt(T(-2) * std::log(u1));
+  const T theta = T(6.283185307179586476925286766559) * u2;
+  z0 = radius * std::cos(theta);
+  z1 = radius * std::sin(theta);
+}
+
+}  // namespace philox
+}  // namespace onnxruntime
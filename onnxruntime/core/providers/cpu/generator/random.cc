@@ -22,16 +22,16 @@ limitations under the License.
 #endif
 
 #include <algorithm>
-#include <chrono>
-#include <random>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 #include "gsl/gsl"
 
-#include "core/common/eigen_common_wrapper.h"
-#include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "core/providers/op_kernel_type_control.h"
-#include "core/util/math_cpuonly.h"
 
 using namespace ONNX_NAMESPACE;
 using namespace ::onnxruntime::common;
@@ -143,11 +143,10 @@ ONNX_CPU_OPERATOR_KERNEL(
                         BuildKernelDefConstraintsFromTypeList<EnabledMultinomialOutputTypes>()),
     Multinomial);
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor);
-
-static Status RandomNormalCompute(float mean, float scale, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
-static Status RandomUniformCompute(float high, float low, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                  concurrency::ThreadPool* thread_pool, Tensor& Y);
+static Status RandomUniformCompute(float low, float high, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                   concurrency::ThreadPool* thread_pool, Tensor& Y);
 
 static Status CreateOutputTensorFromTensorShape(OpKernelContext* ctx, const Tensor& X, Tensor** Y);
 static TensorProto::DataType InferDataType(const Tensor& tensor);
@@ -155,19 +154,13 @@ static TensorProto::DataType InferDataType(const Tensor& tensor);
 Status RandomNormal::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y);
-
-  return status;
+  return RandomNormalCompute(mean_, scale_, generator_, dtype_, ctx->GetOperatorThreadPool(), Y);
 }
 
 Status RandomUniform::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y);
-
-  return status;
+  return RandomUniformCompute(low_, high_, generator_, dtype_, ctx->GetOperatorThreadPool(), Y);
 }
 
 Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
@@ -186,8 +179,7 @@ Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y);
+  status = RandomNormalCompute(mean_, scale_, generator_, dtype, ctx->GetOperatorThreadPool(), *Y);
 
   return status;
 }
@@ -207,83 +199,76 @@ Status RandomUniformLike::Compute(OpKernelContext* ctx) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomUniformCompute(low_, high_, generator_, dtype, *Y);
+  status = RandomUniformCompute(low_, high_, generator_, dtype, ctx->GetOperatorThreadPool(), *Y);
 
   return status;
 }
 
-// Rank-2 tensor (matrix) of scalar type T.
-template <typename T, typename IndexType = int64_t>
-using Matrix = Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor, IndexType>>;
-
-template <typename T, typename IndexType = int64_t>
-using ConstMatrix = Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, IndexType>>;
-
-template <typename T, typename IndexType = int64_t>
-using EigenVector = Eigen::TensorMap<Eigen::Tensor<T, 1, Eigen::RowMajor, IndexType>>;
-
 template <typename OutputType>
 static Status MultinomialCompute(OpKernelContext* ctx,
                                  const Tensor& X,
                                  const int64_t batch_size,
                                  const int64_t num_classes,
                                  const int64_t num_samples,
-                                 std::default_random_engine& generator,
+                                 PhiloxGenerator& generator,
                                  Tensor& Y) {
   if (!utils::HasType<EnabledMultinomialOutputTypes, OutputType>()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output type not supported in this build.");
   }
 
-  // implementation copied from Tensorflow with some changes such as using the std::uniform_real_distribution
-  // instead of the Philox RNG.
-  Eigen::array<int64_t, 2> X_dims = {{batch_size, num_classes}};
-  ConstMatrix<float> logits = ConstMatrix<float>(X.template Data<float>(), X_dims);
-
-  Eigen::array<int64_t, 2> Y_dims = {{batch_size, num_samples}};
-  Matrix<OutputType> output = Matrix<OutputType>(Y.template MutableData<OutputType>(), Y_dims);
-
-  // BEGIN create temporary tensor
-  AllocatorPtr alloc;
-  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
-  auto cdf_data = static_cast<double*>(alloc->Alloc(SafeInt<size_t>(sizeof(double)) * num_classes));
-  BufferUniquePtr cdf_buffer(cdf_data, BufferDeleter(alloc));
-  Eigen::array<int64_t, 1> cdf_dims = {{num_classes}};
-  auto cdf = EigenVector<double>(cdf_data, cdf_dims);
-  // END create temporary tensor
-
-  std::uniform_real_distribution<double> dist(0.0, 1.0);  // TODO: should this be initialized per batch?
-
-  for (int64_t b = 0; b < batch_size; ++b) {
-    const float* logits_row = &(logits(b, 0));
-    // Takes an along-class maximum (for numerical stability).
-    float maxx = std::numeric_limits<float>::lowest();
-    for (int64_t j = 0; j < num_classes; ++j) {
-      if (Eigen::numext::isfinite(logits_row[j])) {
-        maxx = std::max(maxx, logits_row[j]);
-      }
-    }
-    const auto max_logit = static_cast<double>(maxx);
-
-    // Precompute cumulative probability distribution across classes.
-    // Note: This isn't normalized.
-    cdf = (logits.chip<0>(b).cast<double>() - max_logit).exp();
-    double running_total = 0;
-    for (int64_t j = 0; j < num_classes; ++j) {
-      if (Eigen::numext::isfinite(logits_row[j])) {
-        running_total += cdf(j);
-      }
-      cdf(j) = running_total;
-    }
-    // Generate each sample.
-    const double* cdf_begin = cdf.data();
-    const double* cdf_end = cdf.data() + num_classes;
-    for (int64_t j = 0; j < num_samples; ++j) {
-      const double to_find = dist(generator) * running_total;
-      auto found_iter = std::upper_bound(cdf_begin, cdf_end, to_find);
-      output(b, j) = static_cast<OutputType>(std::distance(cdf_begin, found_iter));
-    }
-  }
+  // implementation copied from Tensorflow with some changes such as sampling the batches in parallel.
+  const float* logits = X.Data<float>();
+  OutputType* output = Y.MutableData<OutputType>();
+
+  // sample k of the output, counting across the batches, uses the uniform double from the words of lane k % 2 of
+  // block k / 2, so the samples do not depend on how the batches are split between threads.
+  const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>((batch_size * num_samples + 1) / 2));
+
+  const TensorOpCost cost{static_cast<double>(num_classes * sizeof(float)),
+                          static_cast<double>(num_samples * sizeof(OutputType)),
+                          static_cast<double>(num_classes * 20 + num_samples * 40)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<double> cdf(num_classes);
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const float* logits_row = logits + b * num_classes;
+          // Takes an along-class maximum (for numerical stability).
+          float maxx = std::numeric_limits<float>::lowest();
+          for (int64_t j = 0; j < num_classes; ++j) {
+            if (std::isfinite(logits_row[j])) {
+              maxx = std::max(maxx, logits_row[j]);
+            }
+          }
+          const auto max_logit = static_cast<double>(maxx);
+
+          // Precompute cumulative probability distribution across classes.
+          // Note: This isn't normalized.
+          double running_total = 0;
+          for (int64_t j = 0; j < num_classes; ++j) {
+            if (std::isfinite(logits_row[j])) {
+              running_total += std::exp(static_cast<double>(logits_row[j]) - max_logit);
+            }
+            cdf[j] = running_total;
+          }
+
+          // Generate each sample.
+          const double* cdf_begin = cdf.data();
+          const double* cdf_end = cdf.data() + num_classes;
+          philox::Block block;
+          for (int64_t j = 0; j < num_samples; ++j) {
+            const int64_t k = b * num_samples + j;
+            if (j == 0 || k % 2 == 0) {
+              block = philox::GenerateBlock(seeds.first, seeds.second + static_cast<uint64_t>(k / 2));
+            }
+            const int lane = static_cast<int>(k % 2) * 2;
+            const double to_find = philox::UniformDouble(block[lane], block[lane + 1]) * running_total;
+            auto found_iter = std::upper_bound(cdf_begin, cdf_end, to_find);
+            output[k] = static_cast<OutputType>(std::distance(cdf_begin, found_iter));
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -315,7 +300,6 @@ Status Multinomial::Compute(OpKernelContext* ctx) const {
   Tensor* Y = ctx->Output(0, {batch_size, num_samples_});
 
   Status status = Status::OK();
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
   switch (output_dtype_) {
     case TensorProto::INT32: {
       status = MultinomialCompute<int32_t>(ctx, X, batch_size, num_classes, num_samples_, generator_, *Y);
@@ -351,23 +335,94 @@ static TensorProto::DataType InferDataType(const Tensor& tensor) {
   return static_cast<TensorProto::DataType>(dtype);
 }
 
+// Fills the tensor with values converted from the words of consecutive Philox blocks by transform, which converts
+// the words of philox::kBatchSize blocks at a time. Value i comes from block i / kValuesPerBlock of the stream, so
+// the output depends on the seed and offset of the generator but not on the number of threads.
+template <typename T, typename TTransform>
+static void GenerateData(PhiloxGenerator& generator, TTransform transform, concurrency::ThreadPool* thread_pool,
+                         Tensor& tensor) {
+  // a block of four words gives four floats or two doubles.
+  constexpr int64_t kValuesPerBlock = 4 * sizeof(uint32_t) / sizeof(T);
+  constexpr int64_t kValuesPerBatch = kValuesPerBlock * philox::kBatchSize;
+
+  T* out = tensor.MutableData<T>();
+  const int64_t size = tensor.Shape().Size();
+  const int64_t num_batches = (size + kValuesPerBatch - 1) / kValuesPerBatch;
+  const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(num_batches) * philox::kBatchSize);
+
+  const TensorOpCost cost{0, static_cast<double>(sizeof(T) * kValuesPerBatch),
+                          static_cast<double>(kValuesPerBatch * 20)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_batches), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        uint32_t words[4 * philox::kBatchSize];
+        T values[kValuesPerBatch];
+        for (std::ptrdiff_t batch = first; batch < last; ++batch) {
+          philox::GenerateBlocks(seeds.first, seeds.second + static_cast<uint64_t>(batch) * philox::kBatchSize, words);
+          transform(words, values);
+          const int64_t start = batch * kValuesPerBatch;
+          std::copy_n(values, std::min(kValuesPerBatch, size - start), out + start);
+        }
+      });
+}
+
+// Each pair of words gives two floats and each block gives two doubles with the Box-Muller transform.
+static void NormalTransform(const uint32_t* words, float mean, float scale, float* values) {
+  for (int i = 0; i < 4 * philox::kBatchSize; i += 2) {
+    float z0, z1;
+    philox::BoxMuller(1.0f - philox::UniformFloat(words[i]), philox::UniformFloat(words[i + 1]), z0, z1);
+    values[i] = z0 * scale + mean;
+    values[i + 1] = z1 * scale + mean;
+  }
+}
+
+static void NormalTransform(const uint32_t* words, float mean, float scale, double* values) {
+  for (int i = 0; i < 2 * philox::kBatchSize; i += 2) {
+    double z0, z1;
+    philox::BoxMuller(1.0 - philox::UniformDouble(words[2 * i], words[2 * i + 1]),
+                      philox::UniformDouble(words[2 * i + 2], words[2 * i + 3]), z0, z1);
+    values[i] = z0 * scale + mean;
+    values[i + 1] = z1 * scale + mean;
+  }
+}
+
+// Each word gives a float and each pair of words gives a double.
+static void UniformTransform(const uint32_t* words, float low, float high, float* values) {
+  const float range = high - low;
+  for (int i = 0; i < 4 * philox::kBatchSize; ++i) {
+    values[i] = philox::UniformFloat(words[i]) * range + low;
+  }
+}
+
+static void UniformTransform(const uint32_t* words, float low, float high, double* values) {
+  const double range = static_cast<double>(high) - low;
+  for (int i = 0; i < 2 * philox::kBatchSize; ++i) {
+    values[i] = philox::UniformDouble(words[2 * i], words[2 * i + 1]) * range + low;
+  }
+}
+
 static Status RandomNormalCompute(float mean, float scale,
-                                  std::default_random_engine& generator,
-                                  TensorProto::DataType dtype, Tensor& Y) {
+                                  PhiloxGenerator& generator,
+                                  TensorProto::DataType dtype,
+                                  concurrency::ThreadPool* thread_pool,
+                                  Tensor& Y) {
   bool handled = false;
   switch (dtype) {
     case TensorProto::FLOAT: {
       if (utils::HasType<EnabledRandomNormalComputeOutputTypes, float>()) {
-        GenerateData<float, std::normal_distribution<float>>(
-            generator, std::normal_distribution<float>{mean, scale}, Y);
+        GenerateData<float>(
+            generator, [mean, scale](const uint32_t* words, float* values) { NormalTransform(words, mean, scale, values); },
+            thread_pool, Y);
         handled = true;
       }
       break;
     }
     case TensorProto::DOUBLE: {
       if (utils::HasType<EnabledRandomNormalComputeOutputTypes, double>()) {
-        GenerateData<double, std::normal_distribution<double>>(
-            generator, std::normal_distribution<double>{mean, scale}, Y);
+        GenerateData<double>(
+            generator, [mean, scale](const uint32_t* words, double* values) { NormalTransform(words, mean, scale, values); },
+            thread_pool, Y);
         handled = true;
       }
       break;
@@ -384,23 +439,26 @@ static Status RandomNormalCompute(float mean, float scale,
 }
 
 static Status RandomUniformCompute(float low, float high,
-                                   std::default_random_engine& generator,
+                                   PhiloxGenerator& generator,
                                    TensorProto::DataType dtype,
+                                   concurrency::ThreadPool* thread_pool,
                                    Tensor& Y) {
   bool handled = false;
   switch (dtype) {
     case TensorProto::FLOAT: {
       if (utils::HasType<EnabledRandomUniformComputeOutputTypes, float>()) {
-        GenerateData<float, std::uniform_real_distribution<float>>(
-            generator, std::uniform_real_distribution<float>{low, high}, Y);
+        GenerateData<float>(
+            generator, [low, high](const uint32_t* words, float* values) { UniformTransform(words, low, high, values); },
+            thread_pool, Y);
         handled = true;
       }
       break;
     }
     case TensorProto::DOUBLE: {
       if (utils::HasType<EnabledRandomUniformComputeOutputTypes, double>()) {
-        GenerateData<double, std::uniform_real_distribution<double>>(
-            generator, std::uniform_real_distribution<double>{low, high}, Y);
+        GenerateData<double>(
+            generator, [low, high](const uint32_t* words, double* values) { UniformTransform(words, low, high, values); },
+            thread_pool, Y);
         handled = true;
       }
       break;
@@ -416,13 +474,4 @@ static Status RandomUniformCompute(float low, float high,
   return Status::OK();
 }
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor) {
-  T* out = tensor.MutableData<T>();
-  for (int64_t i = 0, end = tensor.Shape().Size(); i < end; ++i) {
-    *out = distribution(generator);
-    ++out;
-  }
-}
-
 }  // namespace onnxruntime
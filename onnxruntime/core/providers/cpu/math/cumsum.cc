@@ -2,50 +2,68 @@
 // Licensed under the MIT License.
 
 #include "cumsum.h"
+
+#include <algorithm>
+
 #include "core/providers/common.h"
-#include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime;
 
 namespace {
-// static section
-std::vector<int64_t> GetStarts(int64_t rank, int64_t axis, int64_t index) {
-  std::vector<int64_t> starts(rank, 0);
-  starts[axis] = index;
-  return starts;
-}
+// Computes the prefix sums of an [outer, dim, inner] view of the input along its middle dimension. The independent
+// (outer index, block of inner columns) pairs are partitioned between the threads, and every block walks the scanned
+// dimension adding one row of contiguous columns at a time.
 template <typename T>
-void ZeroOutSliceAtIndex(Tensor& output, int64_t rank, int64_t axis, int64_t index,
-                         gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  T zero{};
-  auto output_starts(GetStarts(rank, axis, index));
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator) {
-    *output_iterator = zero;
-  }
+void PrefixSum(const T* input, T* output, int64_t outer, int64_t dim, int64_t inner, bool exclusive, bool reverse,
+               concurrency::ThreadPool* tp) {
+  constexpr int64_t kColumnBlockSize = 256;
+  const int64_t column_blocks = (inner + kColumnBlockSize - 1) / kColumnBlockSize;
+  const int64_t row_step = reverse ? -inner : inner;
+  const int64_t first_row = reverse ? dim - 1 : 0;
+
+  const double block_size = static_cast<double>(dim * std::min(inner, kColumnBlockSize));
+  const TensorOpCost cost{block_size * sizeof(T), block_size * sizeof(T), block_size};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(outer * column_blocks), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t work = first; work < last; ++work) {
+          const int64_t o = work / column_blocks;
+          const int64_t column = (work % column_blocks) * kColumnBlockSize;
+          const int64_t columns = std::min(kColumnBlockSize, inner - column);
+
+          const T* in = input + (o * dim + first_row) * inner + column;
+          T* out = output + (o * dim + first_row) * inner + column;
+
+          // the first slice is a copy of the input, or zeros if exclusive
+          for (int64_t i = 0; i < columns; ++i) {
+            out[i] = exclusive ? T{} : in[i];
+          }
+
+          for (int64_t s = 1; s < dim; ++s) {
+            // each output slice is the sum of the previous output slice and the corresponding input slice, which
+            // is the previous one if exclusive
+            const T* addend = exclusive ? in : in + row_step;
+            const T* previous = out;
+            in += row_step;
+            out += row_step;
+            for (int64_t i = 0; i < columns; ++i) {
+              out[i] = previous[i] + addend[i];
+            }
+          }
+        }
+      });
 }
-template <typename T>
-void CopySlices(const Tensor& input, Tensor& output,
-                const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts,
-                gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator) {
-    *output_iterator = *input_iterator;
-  }
-}
-template <typename T>
-void SumSlices(const Tensor& input, Tensor& output,
-               const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts, const std::vector<int64_t>& previous_output_starts,
-               gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  SliceIterator<T> previous_output_iterator(output, previous_output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator, ++previous_output_iterator) {
-    *output_iterator = *input_iterator + *previous_output_iterator;
-  }
+
+template <>
+void PrefixSum<float>(const float* input, float* output, int64_t outer, int64_t dim, int64_t inner, bool exclusive,
+                      bool reverse, concurrency::ThreadPool* tp) {
+  MlasPrefixSum(input, output, static_cast<size_t>(outer), static_cast<size_t>(dim), static_cast<size_t>(inner),
+                exclusive, reverse, tp);
 }
 }  // namespace
 
@@ -184,62 +202,12 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   int64_t axis = 0;
   ORT_THROW_IF_ERROR(cumsum_op::GetAxis(axis_tensor, rank, axis));
 
-  auto dim(output_tensor.Shape()[axis]);    // dimension size for the axis
-  TensorShape slice_shape(input->Shape());  // the shape of one slice of input/output for the given value of the axis
-  slice_shape[axis] = 1;
-  auto slice_size(slice_shape.Size());     // total number of elements in each slice
-  auto slice_dims(slice_shape.GetDims());  // dim array for the slice
-
-  std::vector<int64_t> steps(rank, 1);  // steps for the slice -- always set to 1
+  const int64_t dim = output_shape[axis];  // dimension size for the axis
+  const int64_t outer = output_shape.SizeToDimension(axis);
+  const int64_t inner = output_shape.SizeFromDimension(axis + 1);
 
-  if (!reverse_) {
-    int64_t index(0);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      ++index;
-    }
-    {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, 0));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      ++index;
-    }
-
-    for (; index < dim; ++index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index - 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index - 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
-  } else {
-    //_reverse == true
-    int64_t index(dim - 1);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      --index;
-    }
-    {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, dim - 1));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      --index;
-    }
-
-    for (; index >= 0; --index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index + 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index + 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
-  }
+  ::PrefixSum<T>(input->template Data<T>(), output_tensor.template MutableData<T>(), outer, dim, inner,
+                 exclusive_ != 0, reverse_ != 0, ctx->GetOperatorThreadPool());
 
   return Status::OK();
 }
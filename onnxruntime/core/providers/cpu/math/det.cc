@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/det.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 //TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -57,13 +58,20 @@ Status Det<T>::Compute(OpKernelContext* context) const {
       output_shape.push_back(X_shape[i]);
     }
 
-    int num_matrix_elems = matrix_dim * matrix_dim;
+    int64_t num_matrix_elems = static_cast<int64_t>(matrix_dim) * matrix_dim;
     auto* Y = context->Output(0, output_shape);
     auto* Y_data = Y->template MutableData<T>();
-    for (int b = 0; b < static_cast<int>(batch_size); ++b) {  // can be parallelized if need to
-      const T* one_matrix = X_data + (b * num_matrix_elems);
-      *Y_data++ = get_determinant(one_matrix);
-    }
+
+    // the LU decomposition of each matrix takes about matrix_dim^3 operations
+    const TensorOpCost cost{static_cast<double>(num_matrix_elems * sizeof(T)), static_cast<double>(sizeof(T)),
+                            static_cast<double>(num_matrix_elems * matrix_dim)};
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size), cost,
+        [&get_determinant, X_data, Y_data, num_matrix_elems](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t b = first; b < last; ++b) {
+            Y_data[b] = get_determinant(X_data + b * num_matrix_elems);
+          }
+        });
   }
 
   return Status::OK();
@@ -60,6 +60,10 @@ int64_t EinsumComputePreprocessor::GetNumSubscriptIndices() const {
   return num_subscript_indices_;
 }
 
+EinsumOp::ContractionPathCache& EinsumComputePreprocessor::GetContractionPathCache() {
+  return *einsum_equation_preprocessor_.contraction_path_cache_;
+}
+
 void EinsumComputePreprocessor::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Diagonal& device_diagonal_func,
                                                  const EinsumOp::DeviceHelpers::Transpose& device_transpose_func) {
   device_diagonal_func_ = device_diagonal_func;
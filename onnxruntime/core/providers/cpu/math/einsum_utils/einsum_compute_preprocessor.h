@@ -14,6 +14,7 @@
 #pragma once
 
 #include "einsum_auxiliary_ops.h"
+#include "einsum_contraction_planner.h"
 
 namespace onnxruntime {
 
@@ -73,6 +74,8 @@ struct EinsumEquationPreprocessor {
       left_equation_split_.push_back(token);  // This copy is done statically at model load, hence should not affect runtime perf
     }
     left_equation_split_.push_back(left_equation_);  // This holds the portion of the equation after the last ','
+
+    contraction_path_cache_ = std::make_shared<EinsumOp::ContractionPathCache>();
   }
 
   // Holds the pre-processed equation string
@@ -95,6 +98,10 @@ struct EinsumEquationPreprocessor {
 
   // Flag indicating if the Einsum op is being used in explicit form (i.e.) contains '->'
   bool is_explicit_ = false;
+
+  // Contraction paths found for the input shapes seen so far
+  // Shared (not copied) by the EinsumComputePreprocessor instances created from this equation in Compute()
+  std::shared_ptr<EinsumOp::ContractionPathCache> contraction_path_cache_;
 };
 
 // Prologue:
@@ -142,6 +149,9 @@ class EinsumComputePreprocessor final {
   // Get the number of subscript indices (subscript labels) in the einsum equation
   int64_t GetNumSubscriptIndices() const;
 
+  // Get the cache of contraction paths shared by all Compute() calls of the kernel
+  EinsumOp::ContractionPathCache& GetContractionPathCache();
+
   // Pass-in device specific functions
   // (Pass-in CPU implementation or CUDA implementation function depending on the kernel using this class)
   void SetDeviceHelpers(const EinsumOp::DeviceHelpers::Diagonal& diagonal_func,
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "einsum_contraction_planner.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+namespace {
+
+struct PlannerOperand {
+  size_t id;
+  std::vector<int64_t> dims;
+  double size;
+};
+
+// Holds the number of remaining operands that carry each subscript label (i.e.) have a dim value > 1 along it
+using LabelCounts = std::vector<int64_t>;
+
+LabelCounts CountLabels(const std::vector<PlannerOperand>& operands, size_t num_labels) {
+  LabelCounts counts(num_labels, 0);
+  for (const auto& operand : operands) {
+    for (size_t l = 0; l < num_labels; ++l) {
+      if (operand.dims[l] > 1) {
+        ++counts[l];
+      }
+    }
+  }
+  return counts;
+}
+
+// Contracts `a` and `b` into `result`, reducing the labels that neither the output nor any other remaining
+// operand carries. Returns the number of multiply-adds the pair-wise contraction takes.
+double ContractPair(const PlannerOperand& a, const PlannerOperand& b, const LabelCounts& counts,
+                    const std::vector<bool>& in_output, PlannerOperand& result) {
+  const size_t num_labels = in_output.size();
+  result.dims.resize(num_labels);
+  result.size = 1.0;
+  double cost = 1.0;
+  for (size_t l = 0; l < num_labels; ++l) {
+    const int64_t dim = std::max(a.dims[l], b.dims[l]);
+    cost *= static_cast<double>(dim);
+    const int64_t carried_elsewhere = counts[l] - (a.dims[l] > 1 ? 1 : 0) - (b.dims[l] > 1 ? 1 : 0);
+    result.dims[l] = (in_output[l] || carried_elsewhere > 0) ? dim : 1;
+    result.size *= static_cast<double>(result.dims[l]);
+  }
+  return cost;
+}
+
+void RemoveLabels(const PlannerOperand& operand, LabelCounts& counts) {
+  for (size_t l = 0; l < counts.size(); ++l) {
+    if (operand.dims[l] > 1) {
+      --counts[l];
+    }
+  }
+}
+
+void AddLabels(const PlannerOperand& operand, LabelCounts& counts) {
+  for (size_t l = 0; l < counts.size(); ++l) {
+    if (operand.dims[l] > 1) {
+      ++counts[l];
+    }
+  }
+}
+
+// Replaces operands i and j (i < j) with `result`
+void ReplacePair(std::vector<PlannerOperand>& operands, size_t i, size_t j, PlannerOperand&& result) {
+  operands.erase(operands.begin() + j);
+  operands.erase(operands.begin() + i);
+  operands.push_back(std::move(result));
+}
+
+// Picks the pair that shrinks the working set the most (ties are broken by the lower contraction cost)
+ContractionPath GreedyPath(std::vector<PlannerOperand> operands, const std::vector<bool>& in_output) {
+  ContractionPath path;
+  size_t next_id = operands.size();
+  LabelCounts counts = CountLabels(operands, in_output.size());
+
+  while (operands.size() > 1) {
+    size_t best_i = 0;
+    size_t best_j = 1;
+    double best_score = std::numeric_limits<double>::infinity();
+    double best_cost = std::numeric_limits<double>::infinity();
+    PlannerOperand best_result;
+
+    PlannerOperand candidate;
+    for (size_t i = 0; i < operands.size(); ++i) {
+      for (size_t j = i + 1; j < operands.size(); ++j) {
+        double cost = ContractPair(operands[i], operands[j], counts, in_output, candidate);
+        double score = candidate.size - operands[i].size - operands[j].size;
+        if (score < best_score || (score == best_score && cost < best_cost)) {
+          best_i = i;
+          best_j = j;
+          best_score = score;
+          best_cost = cost;
+          best_result = candidate;
+        }
+      }
+    }
+
+    path.emplace_back(operands[best_i].id, operands[best_j].id);
+    RemoveLabels(operands[best_i], counts);
+    RemoveLabels(operands[best_j], counts);
+    best_result.id = next_id++;
+    AddLabels(best_result, counts);
+    ReplacePair(operands, best_i, best_j, std::move(best_result));
+  }
+
+  return path;
+}
+
+// Exhaustive search over all contraction orders, pruning branches that cannot beat the best path found so far
+void SearchOptimalPath(const std::vector<PlannerOperand>& operands, const LabelCounts& counts,
+                       const std::vector<bool>& in_output, size_t next_id, double cost_so_far,
+                       ContractionPath& current_path, double& best_cost, ContractionPath& best_path) {
+  if (operands.size() == 1) {
+    if (cost_so_far < best_cost) {
+      best_cost = cost_so_far;
+      best_path = current_path;
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < operands.size(); ++i) {
+    for (size_t j = i + 1; j < operands.size(); ++j) {
+      PlannerOperand result;
+      double cost = cost_so_far + ContractPair(operands[i], operands[j], counts, in_output, result);
+      if (cost >= best_cost) {
+        continue;
+      }
+
+      result.id = next_id;
+      LabelCounts next_counts = counts;
+      RemoveLabels(operands[i], next_counts);
+      RemoveLabels(operands[j], next_counts);
+      AddLabels(result, next_counts);
+
+      std::vector<PlannerOperand> next_operands = operands;
+      ReplacePair(next_operands, i, j, std::move(result));
+
+      current_path.emplace_back(operands[i].id, operands[j].id);
+      SearchOptimalPath(next_operands, next_counts, in_output, next_id + 1, cost,
+                        current_path, best_cost, best_path);
+      current_path.pop_back();
+    }
+  }
+}
+
+}  // namespace
+
+ContractionPath FindContractionPath(const std::vector<std::vector<int64_t>>& homogenized_input_dims,
+                                    const std::vector<bool>& subscript_label_in_output,
+                                    size_t optimal_max_inputs) {
+  std::vector<PlannerOperand> operands;
+  operands.reserve(homogenized_input_dims.size());
+  for (size_t i = 0; i < homogenized_input_dims.size(); ++i) {
+    double size = 1.0;
+    for (auto dim : homogenized_input_dims[i]) {
+      size *= static_cast<double>(dim);
+    }
+    operands.push_back({i, homogenized_input_dims[i], size});
+  }
+
+  if (operands.size() > optimal_max_inputs) {
+    return GreedyPath(std::move(operands), subscript_label_in_output);
+  }
+
+  ContractionPath current_path;
+  ContractionPath best_path;
+  double best_cost = std::numeric_limits<double>::infinity();
+  SearchOptimalPath(operands, CountLabels(operands, subscript_label_in_output.size()), subscript_label_in_output,
+                    operands.size(), 0.0, current_path, best_cost, best_path);
+
+  // Costs are products of dim values and may overflow to infinity for huge operands - fall back to greedy then
+  if (best_path.size() + 1 != operands.size()) {
+    return GreedyPath(std::move(operands), subscript_label_in_output);
+  }
+
+  return best_path;
+}
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
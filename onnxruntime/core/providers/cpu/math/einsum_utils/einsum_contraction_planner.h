@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// This module hosts the following abstractions -
+
+// 1) FindContractionPath -
+// Searches for the order in which Einsum operands are to be contracted pair-wise (in the spirit of numpy.einsum_path
+// and opt_einsum). Contracting operands in input order can create intermediates much larger than necessary
+// (e.g.) 'ij,jk,kl->il' with a small 'l' is cheaper when contracting the last 2 operands first.
+
+// 2) ContractionPathCache -
+// The search only depends on the homogenized input dims, so the path found for a given shape signature is cached
+// and re-used across Compute() calls of the same kernel.
+
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+// Each step of a contraction path names the 2 operands to be contracted.
+// Operands [0, num_inputs) are the op's inputs and operand (num_inputs + i) is the result of step i.
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// Up to this many inputs, all contraction orders are searched. Beyond it, a greedy search is used.
+constexpr size_t kOptimalContractionPathMaxInputs = 5;
+
+/** Find a contraction path for the given operands
+  * @param homogenized_input_dims The homogenized dims of each input (all of rank num_subscript_labels).
+  *                               A dim value of 1 means the input doesn't carry the subscript label.
+  * @param subscript_label_in_output For each subscript label, whether it appears in the op's output
+  * @param optimal_max_inputs Use the exhaustive search for at most this many inputs and the greedy one otherwise
+  */
+ContractionPath FindContractionPath(const std::vector<std::vector<int64_t>>& homogenized_input_dims,
+                                    const std::vector<bool>& subscript_label_in_output,
+                                    size_t optimal_max_inputs = kOptimalContractionPathMaxInputs);
+
+// Thread-safe cache of contraction paths keyed by the concatenated homogenized input dims
+class ContractionPathCache {
+ public:
+  bool Find(const std::vector<int64_t>& shape_signature, ContractionPath& path) const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = paths_.find(shape_signature);
+    if (it == paths_.end()) {
+      return false;
+    }
+    path = it->second;
+    return true;
+  }
+
+  void Insert(const std::vector<int64_t>& shape_signature, const ContractionPath& path) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    // Models with dynamic shapes may present an unbounded number of signatures - start over rather than grow
+    if (paths_.size() >= kMaxEntries) {
+      paths_.clear();
+    }
+    paths_[shape_signature] = path;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 32;
+
+  mutable OrtMutex mutex_;
+  std::map<std::vector<int64_t>, ContractionPath> paths_;
+};
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
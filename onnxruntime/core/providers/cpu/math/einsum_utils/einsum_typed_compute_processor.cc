@@ -349,6 +349,19 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // With more than 2 inputs, the order in which the operands are contracted matters
+  if (num_inputs > 2) {
+    bool has_empty_input = false;
+    for (const auto& dims : homogenized_input_dims) {
+      has_empty_input = has_empty_input || dims.Size() == 0;
+    }
+
+    if (!has_empty_input) {
+      RunContractionPath();
+      return Status::OK();
+    }
+  }
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
@@ -418,6 +431,109 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   return Status::OK();
 }
 
+template <typename T>
+void EinsumTypedComputeProcessor<T>::RunContractionPath() {
+  auto& preprocessed_inputs = einsum_compute_preprocessor_.GetPreprocessedInputTensors();
+
+  const auto& raw_inputs = einsum_compute_preprocessor_.GetRawInputTensors();
+
+  const auto& homogenized_input_dims = einsum_compute_preprocessor_.GetHomogenizedInputDims();
+
+  const auto& subscript_indices_to_output_indices = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+
+  const size_t num_subscript_labels = static_cast<size_t>(einsum_compute_preprocessor_.GetNumSubscriptIndices());
+
+  const size_t num_inputs = homogenized_input_dims.size();
+
+  // Operands [0, num_inputs) are the op's inputs and operand (num_inputs + i) is the result of step i of the path
+  const size_t num_operands = 2 * num_inputs - 1;
+  std::vector<std::vector<int64_t>> operand_dims(num_operands);
+  std::vector<int64_t> shape_signature;
+  shape_signature.reserve(num_inputs * num_subscript_labels);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    auto dims = homogenized_input_dims[i].GetDims();
+    operand_dims[i].assign(dims.begin(), dims.end());
+    shape_signature.insert(shape_signature.end(), dims.begin(), dims.end());
+  }
+
+  std::vector<bool> subscript_label_in_output(num_subscript_labels);
+  for (size_t l = 0; l < num_subscript_labels; ++l) {
+    subscript_label_in_output[l] = subscript_indices_to_output_indices[l] != -1;
+  }
+
+  EinsumOp::ContractionPath path;
+  auto& path_cache = einsum_compute_preprocessor_.GetContractionPathCache();
+  if (!path_cache.Find(shape_signature, path)) {
+    path = EinsumOp::FindContractionPath(std::vector<std::vector<int64_t>>(operand_dims.begin(),
+                                                                           operand_dims.begin() + num_inputs),
+                                         subscript_label_in_output);
+    path_cache.Insert(shape_signature, path);
+  }
+
+  ORT_ENFORCE(path.size() + 1 == num_inputs, "Einsum op: Invalid contraction path");
+
+  // Number of not yet contracted operands that carry each subscript label (i.e.) have a dim value > 1 along it
+  std::vector<int64_t> label_counts(num_subscript_labels, 0);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    for (size_t l = 0; l < num_subscript_labels; ++l) {
+      label_counts[l] += operand_dims[i][l] > 1 ? 1 : 0;
+    }
+  }
+
+  std::vector<std::unique_ptr<Tensor>> intermediates(num_operands);
+  auto get_operand = [&](size_t id) -> const Tensor& {
+    if (id >= num_inputs) {
+      return *intermediates[id];
+    }
+    return preprocessed_inputs[id] ? *preprocessed_inputs[id] : *raw_inputs[id];
+  };
+
+  TensorShapeVector reduced_dims;
+  reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving.
+
+  for (size_t step = 0; step < path.size(); ++step) {
+    const size_t left = path[step].first;
+    const size_t right = path[step].second;
+    const size_t result = num_inputs + step;
+
+    // Reduce the dims that neither the op's output nor any operand yet to be contracted carries
+    reduced_dims.clear();
+    operand_dims[result].resize(num_subscript_labels);
+    for (size_t l = 0; l < num_subscript_labels; ++l) {
+      const int64_t left_dim = operand_dims[left][l];
+      const int64_t right_dim = operand_dims[right][l];
+      label_counts[l] -= (left_dim > 1 ? 1 : 0) + (right_dim > 1 ? 1 : 0);
+      if (!subscript_label_in_output[l] && label_counts[l] == 0 && (left_dim > 1 || right_dim > 1)) {
+        reduced_dims.push_back(static_cast<int64_t>(l));
+        operand_dims[result][l] = 1;
+      } else {
+        operand_dims[result][l] = std::max(left_dim, right_dim);
+      }
+      label_counts[l] += operand_dims[result][l] > 1 ? 1 : 0;
+    }
+
+    const Tensor& left_operand = get_operand(left);
+    const Tensor& right_operand = get_operand(right);
+    intermediates[result] = PairwiseOperandProcess(left_operand,
+                                                   left < num_inputs ? homogenized_input_dims[left] : left_operand.Shape(),
+                                                   right_operand,
+                                                   right < num_inputs ? homogenized_input_dims[right] : right_operand.Shape(),
+                                                   reduced_dims, step + 1 == path.size());
+
+    // Release the contracted operands as soon as possible to keep the peak memory down
+    if (left >= num_inputs) {
+      intermediates[left].reset();
+    } else {
+      preprocessed_inputs[left].reset();
+    }
+    if (right >= num_inputs) {
+      intermediates[right].reset();
+    } else {
+      preprocessed_inputs[right].reset();
+    }
+  }
+}
+
 // Explicit class instantiation
 template class EinsumTypedComputeProcessor<float>;
 template class EinsumTypedComputeProcessor<int32_t>;
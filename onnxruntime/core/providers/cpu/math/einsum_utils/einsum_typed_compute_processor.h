@@ -48,6 +48,10 @@ class EinsumTypedComputeProcessor {
                                                  const gsl::span<const int64_t>& reduce_dims,
                                                  bool is_final_pair);
 
+  // Contracts 3 or more operands pair-wise in the order found by EinsumOp::FindContractionPath
+  // (rather than in input order) and writes the op's output
+  void RunContractionPath();
+
   // Here we take a "candidate output"(candidate output is a tensor that is a permutation and / or a reshape away from the final output),
   // and after a few operations to get it to the required output structure, copy it to the op's output
   // The candidate output might contain dims that may not be part of the op's output (i.e.) the dims will have to be unsqueezed
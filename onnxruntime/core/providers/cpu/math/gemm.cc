@@ -56,7 +56,7 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
 
-// opset 13 Adds BFloat16 support but we are not supporting it yet
+// opset 13 Adds BFloat16 support
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Gemm,
     13,
@@ -70,6 +70,41 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
 
+// MLFloat16 and BFloat16 are computed by MLAS in half precision with float accumulation
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    9,
+    10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    Gemm<BFloat16>);
+
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
@@ -108,6 +143,73 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_b,
+                         BufferUniquePtr& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  MLAS_SPARSE_GEMM_FORMAT format;
+  packed_b_size = MlasSparseGemmPackBSize(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(),
+                                          trans_b ? K : N, &format);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasSparseGemmPackB(format,
+                      trans_b ? CblasTrans : CblasNoTrans,
+                      N,
+                      K,
+                      tensor_b.Data<float>(),
+                      trans_b ? K : N,
+                      packed_b_data);
+  return true;
+}
+
+bool GemmPackBHalf(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasHalfGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasHalfGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                    N,
+                    K,
+                    static_cast<const uint16_t*>(tensor_b.DataRaw()),
+                    trans_b ? K : N,
+                    packed_b_data);
+  return true;
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
@@ -162,8 +264,18 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
     bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (GemmPackBSparseFp32(alloc, tensor, trans_B_ != CblasNoTrans, sparse_b_, packed_b_size, b_shape_)) {
+      is_packed = true;
+      if (share_prepacked_weights) {
+        prepacked_weights->buffers_.push_back(nullptr);  // packed_b_ is nullptr
+        prepacked_weights->buffer_sizes_.push_back(0);
+        prepacked_weights->buffers_.push_back(std::move(sparse_b_));
+        prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+      }
+      return Status::OK();
+    }
+    is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
       prepacked_weights->buffer_sizes_.push_back(packed_b_size);
@@ -188,7 +300,12 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
 
   if (input_idx == 1) {
     used_shared_buffers = true;
-    packed_b_ = std::move(prepacked_buffers[0]);
+    if (prepacked_buffers.size() == 1) {  // This means that only packed_b_ exists
+      packed_b_ = std::move(prepacked_buffers[0]);
+    } else if (prepacked_buffers.size() == 2) {  // This means that only sparse_b_ exists
+      ORT_ENFORCE(prepacked_buffers[0].get() == nullptr);
+      sparse_b_ = std::move(prepacked_buffers[1]);
+    }
   }
   return Status::OK();
 }
@@ -251,7 +368,7 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   const auto* A = context->Input<Tensor>(0);
-  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* B = (packed_b_ || sparse_b_) ? nullptr : context->Input<Tensor>(1);
   const auto* C = context->Input<Tensor>(2);
 
   // Bias could be missing. Treat as scalar 0 if that is the case.
@@ -279,6 +396,21 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   if (B) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
+  } else if (sparse_b_) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    MlasSparseGemm(
+        trans_A_,
+        static_cast<size_t>(M),
+        static_cast<size_t>(N),
+        static_cast<size_t>(K),
+        alpha_,
+        A->Data<float>(),
+        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
+        sparse_b_.get(),
+        c_data != nullptr ? beta_ : 0.0f,
+        y_data,
+        static_cast<size_t>(N),
+        thread_pool);
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
     MlasGemm(
@@ -301,4 +433,126 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <typename T>
+static Status HalfGemmPrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool trans_b,
+                              BufferUniquePtr& packed_b, TensorShape& b_shape,
+                              /*out*/ bool& is_packed,
+                              /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBHalf(alloc, tensor, trans_b, packed_b, packed_b_size, b_shape);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+template <typename T>
+static Status HalfGemmCompute(OpKernelContext* context, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                              float alpha, float beta, const BufferUniquePtr& packed_b, const TensorShape& b_shape) {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_a != CblasNoTrans, B ? B->Shape() : b_shape, trans_b != CblasNoTrans,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+
+  auto Y = context->Output(0, {M, N});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  // The bias is only copied, so it is broadcast with the bits of the half precision values.
+  auto* y_data = static_cast<uint16_t*>(Y->MutableDataRaw());
+  const auto* c_data = C != nullptr ? static_cast<const uint16_t*>(C->DataRaw()) : nullptr;
+  const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
+  GemmBroadcastBias(M, N, beta, c_data, c_shape, y_data);
+
+  MLAS_HALF_GEMM_DATA_PARAMS data;
+  data.A = static_cast<const uint16_t*>(A->DataRaw());
+  data.lda = static_cast<size_t>(trans_a != CblasNoTrans ? M : K);
+  data.BIsPacked = bool(packed_b);
+  data.B = packed_b ? packed_b.get() : B->DataRaw();
+  data.ldb = static_cast<size_t>(trans_b != CblasNoTrans ? K : N);
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha;
+  data.beta = c_data != nullptr ? beta : 0.0f;
+
+  MlasHalfGemmBatch(HalfGemmType<T>::value, trans_a, trans_b,
+                    static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                    &data, 1, thread_pool);
+
+  return Status::OK();
+}
+
+template <>
+Status Gemm<MLFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                                AllocatorPtr alloc, /*out*/ bool& is_packed,
+                                /*out*/ PrePackedWeights* prepacked_weights) {
+  return HalfGemmPrePack<MLFloat16>(tensor, input_idx, alloc, trans_B_ != CblasNoTrans, packed_b_, b_shape_,
+                                    is_packed, prepacked_weights);
+}
+
+template <>
+Status Gemm<MLFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                  int input_idx,
+                                                  /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
+  return HalfGemmCompute<MLFloat16>(context, trans_A_, trans_B_, alpha_, beta_, packed_b_, b_shape_);
+}
+
+template <>
+Status Gemm<BFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                               AllocatorPtr alloc, /*out*/ bool& is_packed,
+                               /*out*/ PrePackedWeights* prepacked_weights) {
+  return HalfGemmPrePack<BFloat16>(tensor, input_idx, alloc, trans_B_ != CblasNoTrans, packed_b_, b_shape_,
+                                   is_packed, prepacked_weights);
+}
+
+template <>
+Status Gemm<BFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                 int input_idx,
+                                                 /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <>
+Status Gemm<BFloat16>::Compute(OpKernelContext* context) const {
+  return HalfGemmCompute<BFloat16>(context, trans_A_, trans_B_, alpha_, beta_, packed_b_, b_shape_);
+}
+
 }  // namespace onnxruntime
@@ -40,6 +40,8 @@ class Gemm : protected GemmBase, public OpKernel {
  protected:
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
+  // B packed with MlasSparseGemmPackB instead of packed_b_ if it is sparse enough
+  BufferUniquePtr sparse_b_;
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -14,4 +15,36 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
 
+// Packs a 2D float weight matrix with MlasSparseGemmPackB if it is sparse enough for MlasSparseGemm to be
+// faster than MlasGemm, as for the weights of pruned models. Returns false if the matrix should be packed
+// with GemmPackBFp32 instead.
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_b,
+                         BufferUniquePtr& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape);
+
+// Element types computed with MlasHalfGemmBatch.
+template <typename T>
+struct HalfGemmType;
+
+template <>
+struct HalfGemmType<MLFloat16> {
+  static constexpr MLAS_HALF_GEMM_TYPE value = MlasHalfGemmFloat16;
+};
+
+template <>
+struct HalfGemmType<BFloat16> {
+  static constexpr MLAS_HALF_GEMM_TYPE value = MlasHalfGemmBFloat16;
+};
+
+// Packs a 2D MLFloat16 or BFloat16 weight matrix with MlasHalfGemmPackB.
+bool GemmPackBHalf(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape);
+
 };  // namespace onnxruntime
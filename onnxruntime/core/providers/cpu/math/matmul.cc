@@ -89,6 +89,36 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+// MLFloat16 and BFloat16 are computed by MLAS in half precision with float accumulation
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    HalfMatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    HalfMatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    HalfMatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    HalfMatMul<BFloat16>);
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -134,8 +164,18 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (GemmPackBSparseFp32(alloc, tensor, trans_b_attr_ != 0, sparse_b_, packed_b_size, b_shape_)) {
+      is_packed = true;
+      if (share_prepacked_weights) {
+        prepacked_weights->buffers_.push_back(nullptr);  // packed_b_ is nullptr
+        prepacked_weights->buffer_sizes_.push_back(0);
+        prepacked_weights->buffers_.push_back(std::move(sparse_b_));
+        prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+      }
+      return Status::OK();
+    }
+    is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
       prepacked_weights->buffer_sizes_.push_back(packed_b_size);
@@ -151,25 +191,80 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
 
   if (input_idx == 1) {
     used_shared_buffers = true;
-    packed_b_ = std::move(prepacked_buffers[0]);
+    if (prepacked_buffers.size() == 1) {  // This means that only packed_b_ exists
+      packed_b_ = std::move(prepacked_buffers[0]);
+    } else if (prepacked_buffers.size() == 2) {  // This means that only sparse_b_ exists
+      ORT_ENFORCE(prepacked_buffers[0].get() == nullptr);
+      sparse_b_ = std::move(prepacked_buffers[1]);
+    }
   }
 
   return Status::OK();
 }
 
+std::string MatMul<float>::GetPrePackedWeightsFormat(int input_idx) const {
+  // The layout of MlasGemmPackB depends on the platform. A sparse B is not saved, as its first buffer is empty.
+  if (input_idx == 1) {
+    return std::string("MlasGemmPackB:") + MlasGetPackedBufferFormat();
+  }
+  return {};
+}
+
+Status MatMul<float>::UseSavedPrePackedBuffers(const Tensor& tensor, PrePackedWeights& prepacked_weights,
+                                               int input_idx,
+                                               /*out*/ bool& used_saved_buffers) {
+  used_saved_buffers = false;
+
+  const auto& shape = tensor.Shape();
+  if (input_idx != 1 || shape.NumDimensions() != 2 || prepacked_weights.buffers_.size() != 1) {
+    return Status::OK();
+  }
+
+  const size_t K = trans_b_attr_ ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b_attr_ ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  if (prepacked_weights.buffer_sizes_[0] != MlasGemmPackBSize(N, K)) {
+    return Status::OK();
+  }
+
+  b_shape_ = shape;
+  packed_b_ = std::move(prepacked_weights.buffers_[0]);
+  used_saved_buffers = true;
+  return Status::OK();
+}
+
+Status MatMul<float>::PrepareForShapes(gsl::span<const TensorShape* const> input_shapes,
+                                       gsl::span<const TensorShape* const> /*output_shapes*/) {
+  const TensorShape* a_shape = input_shapes[0];
+  const TensorShape* b_shape = (packed_b_ || sparse_b_) ? &b_shape_ : input_shapes[1];
+  if (a_shape == nullptr || b_shape == nullptr) {
+    return Status::OK();
+  }
+
+  const bool trans_a = trans_a_attr_ && a_shape->NumDimensions() != 1;
+  const bool trans_b = trans_b_attr_ && b_shape->NumDimensions() != 1;
+  auto helper = std::make_unique<MatMulComputeHelper>();
+  ORT_RETURN_IF_ERROR(helper->Compute(*a_shape, *b_shape, trans_a, trans_b, trans_batch_a_, trans_batch_b_));
+  frozen_helper_ = std::move(helper);
+  return Status::OK();
+}
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
   const Tensor* a = ctx->Input<Tensor>(0);
-  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const Tensor* b = (packed_b_ || sparse_b_) ? nullptr : ctx->Input<Tensor>(1);
   const auto& b_shape = b ? b->Shape() : b_shape_;
 
   // match CUDA kernel implementation, ignore transpose for vectors
   const bool trans_a = trans_a_attr_ && a->Shape().NumDimensions() != 1;
   const bool trans_b = trans_b_attr_ && b_shape.NumDimensions() != 1;
 
-  MatMulComputeHelper helper;
-  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, trans_a, trans_b, trans_batch_a_, trans_batch_b_));
+  MatMulComputeHelper computed_helper;
+  if (!frozen_helper_) {
+    ORT_RETURN_IF_ERROR(computed_helper.Compute(a->Shape(), b_shape, trans_a, trans_b,
+                                                trans_batch_a_, trans_batch_b_));
+  }
+  const MatMulComputeHelper& helper = frozen_helper_ ? *frozen_helper_ : computed_helper;
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   // Bail out early if the output is going to be empty
@@ -187,6 +282,15 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
 
+  if (sparse_b_) {
+    for (size_t i = 0; i < max_len; i++) {
+      MlasSparseGemm(trans_a ? CblasTrans : CblasNoTrans, M, N, K, alpha_attr_,
+                     a_data + helper.LeftOffsets()[i], lda, sparse_b_.get(), 0.0f,
+                     y_data + helper.OutputOffsets()[i], N, thread_pool);
+    }
+    return Status::OK();
+  }
+
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = bool(packed_b_);
@@ -205,4 +309,78 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+template <typename T>
+Status HalfMatMul<T>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                              /*out*/ bool& is_packed,
+                              /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBHalf(alloc, tensor, false, packed_b_, packed_b_size, b_shape_);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status HalfMatMul<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                int input_idx,
+                                                /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status HalfMatMul<T>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const auto& b_shape = b ? b->Shape() : b_shape_;
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = static_cast<const uint16_t*>(a->DataRaw());
+  const auto* b_data = b ? static_cast<const uint16_t*>(b->DataRaw()) : nullptr;
+  auto* y_data = static_cast<uint16_t*>(y->MutableDataRaw());
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].BIsPacked = bool(packed_b_);
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = data[i].BIsPacked ? packed_b_.get() : static_cast<const void*>(b_data + helper.RightOffsets()[i]);
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasHalfGemmBatch(HalfGemmType<T>::value, CblasNoTrans, CblasNoTrans,
+                    M, N, K, data.data(), max_len, thread_pool);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/matmul_helper.h"
 
 namespace onnxruntime {
 
@@ -36,11 +37,23 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  std::string GetPrePackedWeightsFormat(int input_idx) const override;
+
+  Status UseSavedPrePackedBuffers(const Tensor& tensor, PrePackedWeights& prepacked_weights, int input_idx,
+                                  /*out*/ bool& used_saved_buffers) override;
+
+  Status PrepareForShapes(gsl::span<const TensorShape* const> input_shapes,
+                          gsl::span<const TensorShape* const> output_shapes) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
+  // B packed with MlasSparseGemmPackB instead of packed_b_ if it is sparse enough
+  BufferUniquePtr sparse_b_;
+  // dimensions and offsets computed once if the session freezes the shapes
+  std::unique_ptr<MatMulComputeHelper> frozen_helper_;
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
@@ -50,4 +63,24 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_b_;
 };
 
+// MatMul of MLFloat16 or BFloat16, computed by MLAS in half precision with float accumulation.
+template <typename T>
+class HalfMatMul final : public OpKernel {
+ public:
+  HalfMatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+
 }  // namespace onnxruntime
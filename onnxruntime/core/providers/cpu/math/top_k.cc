@@ -140,6 +140,119 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Rows shorter than this are not split across threads.
+static constexpr int64_t kTopKMinChunkSize = 4 * 1024;
+
+// Values are checked against the top of the heap this many at a time before any is inserted.
+static constexpr int64_t kTopKFilterBlockSize = 16;
+
+// Selects the top k elements of the contiguous range [begin, end) of input_data and stores their indices in heap,
+// the weakest of them first. Requires end - begin >= k.
+template <class Comparator>
+static void SelectTopKInRange(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                              int64_t begin, int64_t end, const unsigned k, int64_t* heap) {
+  int64_t cur_idx = begin;
+  for (unsigned l = 0; l < k; ++l, ++cur_idx) {
+    heap[k - l - 1] = cur_idx;
+    HeapifyIthPosition(heap, k - l - 1, k, comparer);
+  }
+
+  auto top = input_data[heap[0]];
+
+  // most values don't make it into the heap once it's warm, so compare a block of them with the top of the heap
+  // in a loop the compiler can vectorize and only visit the values of the blocks where one does.
+  for (; cur_idx + kTopKFilterBlockSize <= end; cur_idx += kTopKFilterBlockSize) {
+    const auto* block = input_data + cur_idx;
+    bool any_replaces_top = false;
+    for (int64_t b = 0; b < kTopKFilterBlockSize; ++b) {
+      any_replaces_top |= comparer.CompareValueOnly(block[b], top);
+    }
+
+    if (any_replaces_top) {
+      for (int64_t b = 0; b < kTopKFilterBlockSize; ++b) {
+        if (comparer.CompareValueOnly(block[b], top)) {
+          heap[0] = cur_idx + b;
+          HeapifyIthPosition(heap, 0, k, comparer);
+          top = input_data[heap[0]];
+        }
+      }
+    }
+  }
+
+  for (; cur_idx < end; ++cur_idx) {
+    if (comparer.CompareValueOnly(input_data[cur_idx], top)) {
+      heap[0] = cur_idx;
+      HeapifyIthPosition(heap, 0, k, comparer);
+      top = input_data[heap[0]];
+    }
+  }
+}
+
+// Returns the number of chunks each row is split in when there are fewer rows than threads and the rows are long
+// enough to be worth it, or 1 to select the top k of each row on a single thread.
+static int64_t TopKChunksPerRow(int64_t rows, int64_t cols, int64_t block_slice, const unsigned k,
+                                concurrency::ThreadPool* threadpool) {
+  // only the innermost axis is split, the values of a row then being contiguous
+  if (block_slice != 1) {
+    return 1;
+  }
+
+  const int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+  if (rows >= tp_threads) {
+    return 1;
+  }
+
+  int64_t chunks_per_row = std::min((tp_threads + rows - 1) / rows, cols / kTopKMinChunkSize);
+
+  // the candidates of the chunks are merged on a single thread, keep them a small fraction of the row
+  chunks_per_row = std::min(chunks_per_row, cols / (static_cast<int64_t>(k) * 16));
+
+  return std::max(chunks_per_row, static_cast<int64_t>(1));
+}
+
+// Selects the top k elements of each row by splitting the row in chunks processed by different threads. Each chunk
+// keeps a heap of its own top k elements, the k * chunks_per_row candidates of the row are then merged. The
+// comparator breaks ties with the index, so the result is the one of the single threaded selection.
+template <class Comparator>
+static void FindTopKElementsSplitRows(const typename Comparator::DataType* input_data,
+                                      typename Comparator::DataType* values_data, int64_t* indices_data,
+                                      int64_t rows, int64_t cols, const unsigned k, bool sorted,
+                                      int64_t chunks_per_row, concurrency::ThreadPool* threadpool) {
+  const int64_t num_chunks = rows * chunks_per_row;
+  std::vector<int64_t> candidates(static_cast<size_t>(num_chunks) * k);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, num_chunks,
+      [input_data, cols, k, chunks_per_row, &candidates](std::ptrdiff_t chunk) {
+        const int64_t row = chunk / chunks_per_row;
+        auto work = concurrency::ThreadPool::PartitionWork(chunk % chunks_per_row, chunks_per_row, cols);
+
+        Comparator comparer(input_data);
+        SelectTopKInRange(comparer, input_data, row * cols + work.start, row * cols + work.end, k,
+                          candidates.data() + chunk * k);
+      });
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, rows,
+      [input_data, values_data, indices_data, cols, k, sorted, chunks_per_row, &candidates](std::ptrdiff_t row) {
+        Comparator comparer(input_data);
+        auto row_candidates_begin = candidates.begin() + row * chunks_per_row * k;
+        auto row_candidates_end = row_candidates_begin + chunks_per_row * k;
+
+        nth_element(row_candidates_begin, row_candidates_begin + (k - 1), row_candidates_end, comparer);
+        if (sorted) {
+          std::sort(row_candidates_begin, row_candidates_begin + k, comparer);
+        }
+
+        const int64_t row_offset = row * cols;
+        for (unsigned l = 0; l < k; ++l) {
+          const int64_t idx = row_candidates_begin[l];
+          values_data[row * k + l] = input_data[idx];
+          indices_data[row * k + l] = idx - row_offset;
+        }
+      });
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -164,6 +277,14 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t num_blocks = input_shape[axis_parsed];
   const int64_t block_slice = reduced_cols / k;
 
+  // e.g. selecting the next tokens from the logits of a large vocabulary with a small batch
+  const int64_t chunks_per_row = TopKChunksPerRow(rows, cols, block_slice, k, threadpool);
+  if (chunks_per_row > 1) {
+    FindTopKElementsSplitRows<Comparator>(input_data, values_data, indices_data, rows, cols, k, sorted,
+                                          chunks_per_row, threadpool);
+    return;
+  }
+
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
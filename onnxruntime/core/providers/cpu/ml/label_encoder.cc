@@ -34,16 +34,11 @@ Status LabelEncoder::Compute(OpKernelContext* context) const {
 
     auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
     auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
-    auto out = output.begin();
 
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
-
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
+    BatchedLookup(input, output, context->GetOperatorThreadPool(),
+                  [this](const std::string& value) -> int64_t {
                     auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
+                    return map_to == string_to_int_map_.end() ? default_int_ : map_to->second;
                   });
   } else {
     if (!Y.IsDataTypeString())
@@ -51,15 +46,11 @@ Status LabelEncoder::Compute(OpKernelContext* context) const {
 
     auto input = gsl::make_span(X.template Data<int64_t>(), shape.Size());
     auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
-    auto out = output.begin();
-
-    const auto map_end = int_to_string_map_.end();
 
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
+    BatchedLookup(input, output, context->GetOperatorThreadPool(),
+                  [this](int64_t value) -> const std::string& {
                     auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
+                    return map_to == int_to_string_map_.end() ? default_string_ : map_to->second;
                   });
   }
 
@@ -383,6 +383,27 @@ static void write_scores(InlinedVector<T>& scores, POST_EVAL_TRANSFORM post_tran
   write_scores(scores, post_transform, out_p, add_second_class);
 }
 
+// Writes lookup_fn(input[i]) to output[i] for each element, as done by the LabelEncoder and CategoryMapper ops.
+// The lookups are independent, so a large input is partitioned over the thread pool.
+template <typename TIn, typename TOut, typename LookupFn>
+void BatchedLookup(gsl::span<const TIn> input, gsl::span<TOut> output, concurrency::ThreadPool* threadpool,
+                   LookupFn lookup_fn) {
+  ORT_ENFORCE(input.size() == output.size());
+
+  // a hash table lookup, plus a copy of the value for strings
+  const TensorOpCost cost{static_cast<double>(sizeof(TIn)), static_cast<double>(sizeof(TOut)), 32.0};
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.size()), cost,
+      [&input, &output, &lookup_fn](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const TIn* in = input.data() + first;
+        const TIn* in_end = input.data() + last;
+        TOut* out = output.data() + first;
+        while (in < in_end) {
+          *out++ = lookup_fn(*in++);
+        }
+      });
+}
+
 // TODO: Update TreeEnsemble* ops to use this instead of write_scores if possible.
 //       Attempted to parallelize the calculations if the number of scores to process was large, but no clear benefit
 //       was seen from testing with the arbitrary values of 1000 scores per threads.
@@ -39,28 +39,35 @@ class SVMCommon {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
-
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
-
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
+      // ||x - sv||^2 = ||x||^2 + ||sv||^2 - 2 * x.sv, so the squared distances for the whole batch come from a
+      // single GEMM with the support vector norms as the bias, followed by a vectorized exp of each row.
+      std::vector<T> a_norms(static_cast<size_t>(m));
+      std::vector<T> b_norms(static_cast<size_t>(n));
+      auto squared_norms = [k](const T* data, std::vector<T>& norms) {
+        for (auto& norm : norms) {
+          norm = ConstEigenVectorArrayMap<T>(data, k).square().sum();
+          data += k;
+        }
+      };
 
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
+      squared_norms(a.data(), a_norms);
+      squared_norms(b.data(), b_norms);
 
-          *cur_out++ = std::exp(-gamma_ * sum);
-        }
+      const TensorShape shape_C({n});
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        -2.f, a.data(), b.data(), 1.f,
+                                        b_norms.data(), &shape_C,
+                                        out.data(),
+                                        threadpool);
 
-        cur_batch += k;  // move to start of next batch
-      }
+      const float gamma = gamma_;
+      TransformRows(out, m, n, threadpool, [&a_norms, gamma](T* row, int64_t row_index, int64_t row_size) {
+        auto map_row = EigenVectorArrayMap<T>(row, row_size);
+        // the expansion can go slightly negative due to rounding when x is very close to a support vector
+        map_row = (map_row + a_norms[row_index]).max(T(0)) * -gamma;
+        MlasComputeExp(row, row, static_cast<size_t>(row_size));
+      });
     } else {
       float alpha = 1.f;
       float beta = 1.f;
@@ -81,21 +88,41 @@ class SVMCommon {
                                         threadpool);
 
       if (kernel_type_ == KERNEL::POLY) {
-        auto map_out = EigenVectorArrayMap<T>(out.data(), out.size());
-        if (degree_ == 2)
-          map_out = map_out.square();
-        else if (degree_ == 3)
-          map_out = map_out.cube();
-        else
-          map_out = map_out.pow(degree_);
-
+        const float degree = degree_;
+        TransformRows(out, m, n, threadpool, [degree](T* row, int64_t /*row_index*/, int64_t row_size) {
+          auto map_row = EigenVectorArrayMap<T>(row, row_size);
+          if (degree == 2)
+            map_row = map_row.square();
+          else if (degree == 3)
+            map_row = map_row.cube();
+          else
+            map_row = map_row.pow(degree);
+        });
       } else if (kernel_type_ == KERNEL::SIGMOID) {
-        MlasComputeTanh(out.data(), out.data(), out.size());
+        TransformRows(out, m, n, threadpool, [](T* row, int64_t /*row_index*/, int64_t row_size) {
+          MlasComputeTanh(row, row, static_cast<size_t>(row_size));
+        });
       }
     }
   }
 
  private:
+  // Applies fn(row, row_index, n) to each row of the m x n kernel matrix, partitioning the rows over the threadpool.
+  template <typename T, typename TransformFn>
+  static void TransformRows(const gsl::span<T> out, int64_t m, int64_t n,
+                            concurrency::ThreadPool* threadpool, TransformFn fn) {
+    // exp/tanh/pow dominate the cost, a few tens of cycles per element
+    const TensorOpCost cost{static_cast<double>(n * sizeof(T)), static_cast<double>(n * sizeof(T)),
+                            static_cast<double>(n * 32)};
+    concurrency::ThreadPool::TryParallelFor(
+        threadpool, static_cast<std::ptrdiff_t>(m), cost,
+        [&out, n, &fn](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t row = first; row < last; ++row) {
+            fn(out.data() + row * n, static_cast<int64_t>(row), n);
+          }
+        });
+  }
+
   KERNEL kernel_type_;
   float gamma_{0.f};
   float coef0_{0.f};
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <limits>
+#include <queue>
 #include "tree_ensemble_aggregator.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
@@ -32,6 +34,17 @@ class TreeEnsembleCommonAttributes {
   int parallel_N_;     // starts parallelizing the computing if n_rows >= parallel_N_
 };
 
+// Compact node of the flattened trees, 16 bytes for float thresholds.
+// The nodes of a tree are stored in breadth-first order so that the first levels share cache lines.
+// A leaf points to itself on both sides, so a row that reached a leaf stays there.
+template <typename T>
+struct TreeNodeElementFlat {
+  T value;
+  int32_t feature_id;
+  uint32_t truenode;
+  uint32_t falsenode;
+};
+
 // TI: input type
 // TH: tree type (types of the node values and targets)
 // TO: output type, usually float
@@ -42,6 +55,21 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<TreeNodeElement<ThresholdType>> nodes_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // Flattened copy of the trees used to evaluate many rows at once, built only if all nodes use the same mode.
+  // Instead of following the pointers of nodes_ for one row after another, a block of rows goes through a tree
+  // together, one level at a time. The loads of the rows are independent, so their cache misses overlap.
+  std::vector<TreeNodeElementFlat<ThresholdType>> flat_nodes_;
+  std::vector<const TreeNodeElement<ThresholdType>*> flat_leaves_;  // leaf in nodes_ of each flat leaf
+  std::vector<unsigned char> flat_missing_tracks_true_;             // only filled if has_missing_tracks_
+  std::vector<uint32_t> flat_roots_;
+  std::vector<uint32_t> flat_depths_;
+  NODE_MODE flat_mode_;
+
+  // number of rows evaluated together by ComputeRows1/ComputeRows.
+  static constexpr int64_t kTreeBatchRows = 64;
+  // minimum number of rows to use the flattened trees.
+  static constexpr int64_t kFlatMinRows = 8;
+
  public:
   TreeEnsembleCommon() {}
 
@@ -76,8 +104,28 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Finds the leaves of tree j for n_rows rows starting at x_data.
+  void ProcessTreeNodeLeaves(size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+                             const TreeNodeElement<ThresholdType>** leaves) const;
+
+  template <typename Compare>
+  void ProcessTreeNodeLeavesFlat(size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+                                 const TreeNodeElement<ThresholdType>** leaves, Compare compare) const;
+
+  void BuildFlatTrees();
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
+
+  // Computes the scores of rows [begin, end), 1 output.
+  template <typename AGG>
+  void ComputeRows1(const AGG& agg, const InputType* x_data, int64_t stride, int64_t begin, int64_t end,
+                    OutputType* z_data, int64_t* label_data) const;
+
+  // Computes the scores of rows [begin, end), 2+ outputs.
+  template <typename AGG>
+  void ComputeRows(const AGG& agg, const InputType* x_data, int64_t stride, int64_t begin, int64_t end,
+                   OutputType* z_data, int64_t* label_data) const;
 };
 
 template <typename InputType, typename ThresholdType, typename OutputType>
@@ -177,6 +225,7 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(int parall
   size_t i, limit;
   std::vector<NODE_MODE> cmodes(nodes_modes.size());
   same_mode_ = true;
+  flat_mode_ = NODE_MODE::LEAF;
   int fpos = -1;
   for (i = 0, limit = nodes_modes.size(); i < limit; ++i) {
     cmodes[i] = MakeTreeNodeMode(nodes_modes[i]);
@@ -184,6 +233,7 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(int parall
       continue;
     if (fpos == -1) {
       fpos = static_cast<int>(i);
+      flat_mode_ = cmodes[i];
       continue;
     }
     if (cmodes[i] != cmodes[fpos])
@@ -297,9 +347,81 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(int parall
       break;
     }
   }
+
+  BuildFlatTrees();
   return Status::OK();
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BuildFlatTrees() {
+  flat_nodes_.clear();
+  flat_leaves_.clear();
+  flat_missing_tracks_true_.clear();
+  flat_roots_.clear();
+  flat_depths_.clear();
+  if (!same_mode_ || nodes_.size() >= static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
+    return;
+  }
+
+  // position of every node of nodes_ in flat_nodes_
+  std::vector<uint32_t> positions(nodes_.size(), std::numeric_limits<uint32_t>::max());
+  auto position = [this, &positions](const TreeNodeElement<ThresholdType>* node) -> uint32_t& {
+    return positions[node - nodes_.data()];
+  };
+
+  flat_nodes_.reserve(nodes_.size());
+  flat_leaves_.reserve(nodes_.size());
+  flat_roots_.reserve(roots_.size());
+  flat_depths_.reserve(roots_.size());
+  std::queue<std::pair<const TreeNodeElement<ThresholdType>*, uint32_t>> queue;  // node and its depth
+  for (const TreeNodeElement<ThresholdType>* root : roots_) {
+    position(root) = static_cast<uint32_t>(flat_nodes_.size());
+    flat_roots_.push_back(position(root));
+    flat_nodes_.push_back({0, 0, position(root), position(root)});
+    flat_leaves_.push_back(nullptr);
+    uint32_t depth = 0;
+    queue.push({root, 0});
+    while (!queue.empty()) {
+      const TreeNodeElement<ThresholdType>* node = queue.front().first;
+      uint32_t node_depth = queue.front().second;
+      queue.pop();
+      uint32_t index = position(node);
+      if (!node->is_not_leaf) {
+        flat_leaves_[index] = node;
+        depth = std::max(depth, node_depth);
+        continue;
+      }
+
+      for (const TreeNodeElement<ThresholdType>* child : {node->truenode, node->falsenode}) {
+        // The flattened trees do not support missing children or nodes shared by several parents.
+        if (child == nullptr || position(child) != std::numeric_limits<uint32_t>::max()) {
+          flat_nodes_.clear();
+          flat_leaves_.clear();
+          flat_roots_.clear();
+          flat_depths_.clear();
+          return;
+        }
+        position(child) = static_cast<uint32_t>(flat_nodes_.size());
+        flat_nodes_.push_back({0, 0, position(child), position(child)});
+        flat_leaves_.push_back(nullptr);
+        queue.push({child, node_depth + 1});
+      }
+
+      flat_nodes_[index] = {node->value, node->feature_id, position(node->truenode), position(node->falsenode)};
+    }
+    flat_depths_.push_back(depth);
+  }
+
+  if (has_missing_tracks_) {
+    flat_missing_tracks_true_.resize(flat_nodes_.size(), 0);
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+      if (positions[i] != std::numeric_limits<uint32_t>::max()) {
+        flat_missing_tracks_true_[positions[i]] = nodes_[i].is_missing_track_true ? 1 : 0;
+      }
+    }
+  }
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::compute(OpKernelContext* ctx,
                                                                          const Tensor* X,
@@ -375,18 +497,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
       agg.FinalizeScores1(z_data, score, label_data);
     } else if (N <= parallel_N_) { /* section C: 1 output, 2+ rows but not enough rows to parallelize */
-      ScoreValue<ThresholdType> score;
-      size_t j;
-
-      for (int64_t i = 0; i < N; ++i) {
-        score = {0, 0};
-        for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-        }
-
-        agg.FinalizeScores1(z_data + i, score,
-                            label_data == nullptr ? nullptr : (label_data + i));
-      }
+      ComputeRows1(agg, x_data, stride, 0, N, z_data, label_data);
     } else if (n_trees_ > max_num_threads) { /* section D: 1 output, 2+ rows and enough trees to parallelize */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<ScoreValue<ThresholdType>> scores(num_threads * N);
@@ -398,10 +509,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i] = {0, 0};
             }
+            const TreeNodeElement<ThresholdType>* leaves[kTreeBatchRows];
             for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction1(scores[batch_num * N + i],
-                                               *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              for (int64_t i = 0; i < N; i += kTreeBatchRows) {
+                int64_t n_rows = std::min<int64_t>(kTreeBatchRows, N - i);
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction1(scores[batch_num * N + i + r], *leaves[r]);
+                }
               }
             }
           });
@@ -420,19 +535,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             }
           });
     } else { /* section E: 1 output, 2+ rows, parallelization by rows */
-      concurrency::ThreadPool::TryBatchParallelFor(
+      auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+      concurrency::ThreadPool::TrySimpleParallelFor(
           ttp,
-          SafeInt<int32_t>(N),
-          [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
-            ScoreValue<ThresholdType> score = {0, 0};
-            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-            }
-
-            agg.FinalizeScores1(z_data + i, score,
-                                label_data == nullptr ? nullptr : (label_data + i));
-          },
-          0);
+          num_threads,
+          [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+            auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, N);
+            ComputeRows1(agg, x_data, stride, work.start, work.end, z_data, label_data);
+          });
     }
   } else {
     if (N == 1) {                       /* section A2: 2+ outputs, 1 row, not enough trees to parallelize */
@@ -461,18 +571,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         agg.FinalizeScores(scores[0], z_data, -1, label_data);
       }
     } else if (N <= parallel_N_) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
-      InlinedVector<ScoreValue<ThresholdType>> scores(n_targets_or_classes_);
-      size_t j, limit;
-
-      for (int64_t i = 0; i < N; ++i) {
-        std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
-        for (j = 0, limit = roots_.size(); j < limit; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-        }
-
-        agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
-                           label_data == nullptr ? nullptr : (label_data + i));
-      }
+      ComputeRows(agg, x_data, stride, 0, N, z_data, label_data);
     } else if (n_trees_ >= max_num_threads) { /* section: D2: 2+ outputs, 2+ rows, enough trees to parallelize*/
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(num_threads * N);
@@ -484,10 +583,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * N + i].resize(n_targets_or_classes_, {0, 0});
             }
+            const TreeNodeElement<ThresholdType>* leaves[kTreeBatchRows];
             for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction(scores[batch_num * N + i],
-                                              *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              for (int64_t i = 0; i < N; i += kTreeBatchRows) {
+                int64_t n_rows = std::min<int64_t>(kTreeBatchRows, N - i);
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction(scores[batch_num * N + i + r], *leaves[r]);
+                }
               }
             }
           });
@@ -511,25 +614,67 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           ttp,
           num_threads,
           [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
-            size_t j, limit;
-            InlinedVector<ScoreValue<ThresholdType>> scores(n_targets_or_classes_);
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, N);
-
-            for (auto i = work.start; i < work.end; ++i) {
-              std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
-              for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-              }
-
-              agg.FinalizeScores(scores,
-                                 z_data + i * n_targets_or_classes_, -1,
-                                 label_data == nullptr ? nullptr : (label_data + i));
-            }
+            ComputeRows(agg, x_data, stride, work.start, work.end, z_data, label_data);
           });
     }
   }
 }  // namespace detail
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeRows1(const AGG& agg, const InputType* x_data,
+                                                                            int64_t stride, int64_t begin,
+                                                                            int64_t end, OutputType* z_data,
+                                                                            int64_t* label_data) const {
+  ScoreValue<ThresholdType> scores[kTreeBatchRows];
+  const TreeNodeElement<ThresholdType>* leaves[kTreeBatchRows];
+  for (int64_t i = begin; i < end; i += kTreeBatchRows) {
+    int64_t n_rows = std::min<int64_t>(kTreeBatchRows, end - i);
+    std::fill(scores, scores + n_rows, ScoreValue<ThresholdType>({0, 0}));
+    for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+      ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+      for (int64_t r = 0; r < n_rows; ++r) {
+        agg.ProcessTreeNodePrediction1(scores[r], *leaves[r]);
+      }
+    }
+
+    for (int64_t r = 0; r < n_rows; ++r) {
+      agg.FinalizeScores1(z_data + i + r, scores[r],
+                          label_data == nullptr ? nullptr : (label_data + i + r));
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeRows(const AGG& agg, const InputType* x_data,
+                                                                           int64_t stride, int64_t begin,
+                                                                           int64_t end, OutputType* z_data,
+                                                                           int64_t* label_data) const {
+  std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(
+      std::min<int64_t>(kTreeBatchRows, end - begin),
+      InlinedVector<ScoreValue<ThresholdType>>(n_targets_or_classes_));
+  const TreeNodeElement<ThresholdType>* leaves[kTreeBatchRows];
+  for (int64_t i = begin; i < end; i += kTreeBatchRows) {
+    int64_t n_rows = std::min<int64_t>(kTreeBatchRows, end - i);
+    for (int64_t r = 0; r < n_rows; ++r) {
+      std::fill(scores[r].begin(), scores[r].end(), ScoreValue<ThresholdType>({0, 0}));
+    }
+    for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+      ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+      for (int64_t r = 0; r < n_rows; ++r) {
+        agg.ProcessTreeNodePrediction(scores[r], *leaves[r]);
+      }
+    }
+
+    for (int64_t r = 0; r < n_rows; ++r) {
+      agg.FinalizeScores(scores[r], z_data + (i + r) * n_targets_or_classes_, -1,
+                         label_data == nullptr ? nullptr : (label_data + i + r));
+    }
+  }
+}
+
 #define TREE_FIND_VALUE(CMP)                                         \
   if (has_missing_tracks_) {                                         \
     while (root->is_not_leaf) {                                      \
@@ -636,6 +781,88 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  if (flat_nodes_.empty() || n_rows < kFlatMinRows) {
+    for (int64_t r = 0; r < n_rows; ++r) {
+      leaves[r] = ProcessTreeNodeLeave(roots_[j], x_data + r * stride);
+    }
+    return;
+  }
+
+  switch (flat_mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      ProcessTreeNodeLeavesFlat(j, x_data, stride, n_rows, leaves,
+                                [](InputType val, ThresholdType threshold) { return val <= threshold; });
+      break;
+    case NODE_MODE::BRANCH_LT:
+      ProcessTreeNodeLeavesFlat(j, x_data, stride, n_rows, leaves,
+                                [](InputType val, ThresholdType threshold) { return val < threshold; });
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      ProcessTreeNodeLeavesFlat(j, x_data, stride, n_rows, leaves,
+                                [](InputType val, ThresholdType threshold) { return val >= threshold; });
+      break;
+    case NODE_MODE::BRANCH_GT:
+      ProcessTreeNodeLeavesFlat(j, x_data, stride, n_rows, leaves,
+                                [](InputType val, ThresholdType threshold) { return val > threshold; });
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      ProcessTreeNodeLeavesFlat(j, x_data, stride, n_rows, leaves,
+                                [](InputType val, ThresholdType threshold) { return val == threshold; });
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      ProcessTreeNodeLeavesFlat(j, x_data, stride, n_rows, leaves,
+                                [](InputType val, ThresholdType threshold) { return val != threshold; });
+      break;
+    case NODE_MODE::LEAF:  // all trees are leaves
+      for (int64_t r = 0; r < n_rows; ++r) {
+        leaves[r] = flat_leaves_[flat_roots_[j]];
+      }
+      break;
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Compare>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeavesFlat(
+    size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves, Compare compare) const {
+  const TreeNodeElementFlat<ThresholdType>* nodes = flat_nodes_.data();
+  uint32_t indices[kTreeBatchRows];
+  ORT_ENFORCE(n_rows <= kTreeBatchRows);
+  std::fill(indices, indices + n_rows, flat_roots_[j]);
+
+  // All rows go down one level at each step, those which reached a leaf stay on it. There is no branch on the
+  // values of the rows, so the loop over the rows can be vectorized with gathers.
+  const uint32_t depth = flat_depths_[j];
+  if (has_missing_tracks_) {
+    const unsigned char* missing_tracks_true = flat_missing_tracks_true_.data();
+    for (uint32_t d = 0; d < depth; ++d) {
+      for (int64_t r = 0; r < n_rows; ++r) {
+        const TreeNodeElementFlat<ThresholdType>& node = nodes[indices[r]];
+        InputType val = x_data[r * stride + node.feature_id];
+        indices[r] = (compare(val, node.value) || (missing_tracks_true[indices[r]] && _isnan_(val)))
+                         ? node.truenode
+                         : node.falsenode;
+      }
+    }
+  } else {
+    for (uint32_t d = 0; d < depth; ++d) {
+      for (int64_t r = 0; r < n_rows; ++r) {
+        const TreeNodeElementFlat<ThresholdType>& node = nodes[indices[r]];
+        indices[r] = compare(x_data[r * stride + node.feature_id], node.value) ? node.truenode : node.falsenode;
+      }
+    }
+  }
+
+  for (int64_t r = 0; r < n_rows; ++r) {
+    leaves[r] = flat_leaves_[indices[r]];
+  }
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
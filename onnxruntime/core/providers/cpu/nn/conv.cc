@@ -17,7 +17,10 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <sstream>
+
 #include "core/common/safeint.h"
+#include "core/framework/kernel_tuning.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -152,6 +155,52 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+
+  // only transform the filter tensor
+  if (input_idx != 1 || tensor.Shape().NumDimensions() < 3) {
+    return Status::OK();
+  }
+
+  const auto& filter_shape = tensor.Shape();
+  const size_t kernel_rank = filter_shape.NumDimensions() - 2;
+
+  TensorShapeVector kernel_shape(filter_shape.GetDims().begin() + 2, filter_shape.GetDims().end());
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+  if (dilations.size() != kernel_rank || strides.size() != kernel_rank) {
+    return Status::OK();
+  }
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t input_channels = static_cast<size_t>(filter_shape[1]);
+  const size_t filter_count = static_cast<size_t>(filter_shape[0]) / group_count;
+
+  const size_t transformed_size = MlasConvWinogradFilterSize(kernel_rank, group_count, input_channels,
+                                                             kernel_shape.data(), dilations.data(), strides.data(),
+                                                             filter_count);
+  if (transformed_size == 0) {
+    return Status::OK();
+  }
+
+  auto* transformed_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * transformed_size);
+  winograd_filter_ = BufferUniquePtr(transformed_data, BufferDeleter(alloc));
+
+  MlasConvWinogradTransformFilter(group_count, input_channels, filter_count, tensor.Data<float>(),
+                                  static_cast<float*>(transformed_data));
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
@@ -211,7 +260,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const size_t kernel_rank = kernel_shape.size();
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
-  if (kernel_rank >= 1 && kernel_rank <= 3) {
+  // Runs the convolution through MLAS, which selects its algorithm from the shapes.
+  auto run_mlas = [&]() {
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
     MlasConvPrepare(&Parameters,
@@ -231,6 +281,10 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     Beta,
                     thread_pool);
 
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd && winograd_filter_ != nullptr) {
+      Parameters.u.Winograd.TransformedFilter = static_cast<const float*>(winograd_filter_.get());
+    }
+
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * WorkingBufferSize)
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
@@ -242,7 +296,10 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
              static_cast<float*>(working_buffer.get()),
              Ydata,
              thread_pool);
-  } else {
+  };
+
+  // Runs the convolution as an im2col followed by a GEMM for each group, which supports any kernel rank.
+  auto run_im2col_gemm = [&]() {
     const int64_t input_image_size = input_shape.Size();
     const int64_t output_image_size = output_shape.Size();
     const int64_t kernel_size = TensorShape(kernel_shape).Size();
@@ -256,10 +313,13 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
     auto* col_buffer_data = static_cast<float*>(col_buffer.get());
 
+    const float* x_data = Xdata;
+    float* y_data = Ydata;
+
     for (int image_id = 0; image_id < N; ++image_id) {
       for (int group_id = 0; group_id < conv_attrs_.group; ++group_id) {
         math::Im2col<float, StorageOrder::NCHW>()(
-            Xdata + group_id * X_offset,
+            x_data + group_id * X_offset,
             input_shape.GetDims().data(),
             output_shape.GetDims().data(),
             kernel_dim,
@@ -280,15 +340,48 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
             W->template Data<float>() + group_id * W_offset,
             col_buffer_data,
             Beta,
-            Ydata + group_id * Y_offset,
+            y_data + group_id * Y_offset,
             thread_pool);
       }
 
-      MlasActivation(&activation_, Ydata, Bdata, M, output_image_size, output_image_size);
+      MlasActivation(&activation_, y_data, Bdata, M, output_image_size, output_image_size);
 
-      Xdata += X_offset * conv_attrs_.group;
-      Ydata += Y_offset * conv_attrs_.group;
+      x_data += X_offset * conv_attrs_.group;
+      y_data += Y_offset * conv_attrs_.group;
     }
+  };
+
+  if (kernel_rank < 1 || kernel_rank > 3) {
+    run_im2col_gemm();
+    return Status::OK();
+  }
+
+  // With a kernel tuning database, benchmark both implementations for this shape and use the faster one. A fused
+  // Sum accumulates into the output, so it cannot be run more than once.
+  int variant = 0;
+  auto& tuning_database = KernelTuningDatabase::Instance();
+  if (Beta == 0.0f && tuning_database.IsEnabled()) {
+    std::ostringstream key;
+    key << "Conv:X" << X->Shape() << ":W" << W->Shape()
+        << ":pads" << TensorShape(pads.data(), pads.size())
+        << ":strides" << TensorShape(strides)
+        << ":dilations" << TensorShape(dilations)
+        << ":group" << conv_attrs_.group
+        << ":activation" << static_cast<int>(activation_.ActivationKind)
+        << ":threads" << concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+
+    ORT_RETURN_IF_ERROR(tuning_database.Tune(KernelTuningDatabase::CpuDeviceKey(), key.str(), 2,
+                                             [&](int v) {
+                                               v == 0 ? run_mlas() : run_im2col_gemm();
+                                               return Status::OK();
+                                             },
+                                             variant));
+  }
+
+  if (variant == 0) {
+    run_mlas();
+  } else {
+    run_im2col_gemm();
   }
 
   return Status::OK();
@@ -29,11 +29,20 @@ class Conv<float> : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
-  
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // Filter transformed for the MLAS Winograd algorithm. The original filter is
+  // kept, as the algorithm is only selected once the input shape is known.
+  BufferUniquePtr winograd_filter_;
 };
 
 }  // namespace onnxruntime
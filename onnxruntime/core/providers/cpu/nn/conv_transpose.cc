@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv_transpose.h"
 
+#include <algorithm>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/common/safeint.h"
 #include "core/util/math.h"
@@ -24,6 +26,101 @@
 
 namespace onnxruntime {
 
+namespace {
+
+// Shape of a 2D transposed convolution of one group computed by ConvTransposeSubPixel2D.
+struct SubPixelShape {
+  size_t C, M;              // input and output channels of the group
+  size_t H, W, Ho, Wo;      // input and output image shape
+  size_t Kh, Kw, Sh, Sw;    // kernel shape and strides
+  size_t PadTop, PadLeft;   // leading pads of the output
+  size_t QhBegin, QwBegin;  // phase row and column of the first output row and column
+  size_t Qh, Qw;            // number of output rows and columns of a phase
+  size_t PadH, PadW;        // zero rows and columns before the input for the other taps of a phase
+  size_t Hp, Wp;            // shape of the zero padded input
+
+  SubPixelShape(size_t c, size_t m, size_t h, size_t w, size_t ho, size_t wo, size_t kh, size_t kw,
+                size_t sh, size_t sw, size_t pad_top, size_t pad_left)
+      : C(c), M(m), H(h), W(w), Ho(ho), Wo(wo), Kh(kh), Kw(kw), Sh(sh), Sw(sw), PadTop(pad_top), PadLeft(pad_left) {
+    QhBegin = PadTop / Sh;
+    QwBegin = PadLeft / Sw;
+    Qh = (Ho - 1 + PadTop) / Sh - QhBegin + 1;
+    Qw = (Wo - 1 + PadLeft) / Sw - QwBegin + 1;
+    PadH = (Kh + Sh - 1) / Sh - 1;
+    PadW = (Kw + Sw - 1) / Sw - 1;
+    Hp = Qh + PadH;
+    Wp = Qw + PadW;
+  }
+};
+
+// Computes a 2D transposed convolution of one group without the column buffer. Output pixel (oh, ow) only receives
+// the filter taps with kh = (oh + pad_top) mod stride_h + j x stride_h, and likewise for kw, from input pixel
+// ((oh + pad_top) / stride_h - j, ...). The output therefore splits into stride_h x stride_w phases, each of them a
+// regular convolution of the input with a sub-kernel, computed as one GEMM per filter tap over a zero padded copy of
+// the input and then stored into its strided output positions with the bias.
+void ConvTransposeSubPixel2D(const float* X,              // input of the group, C x H x W
+                             const float* packed_filter,  // filter of the group, (M x Kh x Kw) x C
+                             const float* bias,           // bias of the group or nullptr
+                             float* Y,                    // output of the group, M x Ho x Wo
+                             float* padded_input,         // C x Hp x Wp + Wp elements
+                             float* phase_output,         // M x Qh x Wp elements
+                             const SubPixelShape& s,
+                             concurrency::ThreadPool* thread_pool) {
+  // Copy the input into the zero padded buffer, where row r and column c hold the input pixel
+  // (r + QhBegin - PadH, c + QwBegin - PadW). The input pixels outside of it are not read by any output pixel.
+  std::fill_n(padded_input, s.C * s.Hp * s.Wp + s.Wp, 0.0f);
+  const size_t w_begin = std::min(s.W, s.QwBegin - std::min(s.QwBegin, s.PadW));
+  const size_t w_end = std::min(s.W, s.Wp + s.QwBegin - s.PadW);
+  for (size_t c = 0; c < s.C; c++) {
+    for (size_t h = 0; h < s.H; h++) {
+      const size_t r = h + s.PadH - s.QhBegin;
+      if (h + s.PadH < s.QhBegin || r >= s.Hp || w_begin >= w_end) {
+        continue;
+      }
+      std::copy_n(X + (c * s.H + h) * s.W + w_begin, w_end - w_begin,
+                  padded_input + (c * s.Hp + r) * s.Wp + w_begin + s.PadW - s.QwBegin);
+    }
+  }
+
+  const size_t kernel_size = s.Kh * s.Kw;
+  const size_t N = s.Qh * s.Wp;
+
+  for (size_t rh = 0; rh < s.Sh; rh++) {
+    for (size_t rw = 0; rw < s.Sw; rw++) {
+      // Accumulate the taps of the phase.
+      bool first_tap = true;
+      for (size_t kh = rh; kh < s.Kh; kh += s.Sh) {
+        for (size_t kw = rw; kw < s.Kw; kw += s.Sw) {
+          const size_t j = kh / s.Sh;
+          const size_t i = kw / s.Sw;
+          const float* A = packed_filter + (kh * s.Kw + kw) * s.C;
+          const float* B = padded_input + (s.PadH - j) * s.Wp + (s.PadW - i);
+          MlasGemm(CblasNoTrans, CblasNoTrans, s.M, N, s.C, 1.0f, A, kernel_size * s.C, B, s.Hp * s.Wp,
+                   first_tap ? 0.0f : 1.0f, phase_output, N, thread_pool);
+          first_tap = false;
+        }
+      }
+
+      // Store the phase into the output with the bias.
+      const size_t oh_begin = (rh + s.Sh - s.PadTop % s.Sh) % s.Sh;
+      const size_t ow_begin = (rw + s.Sw - s.PadLeft % s.Sw) % s.Sw;
+      for (size_t m = 0; m < s.M; m++) {
+        const float b = (bias != nullptr) ? bias[m] : 0.0f;
+        for (size_t oh = oh_begin; oh < s.Ho; oh += s.Sh) {
+          const size_t a = (oh + s.PadTop) / s.Sh - s.QhBegin;
+          const float* src = phase_output + (m * s.Qh + a) * s.Wp;
+          float* dst = Y + (m * s.Ho + oh) * s.Wo;
+          for (size_t ow = ow_begin; ow < s.Wo; ow += s.Sw) {
+            dst[ow] = first_tap ? b : src[(ow + s.PadLeft) / s.Sw - s.QwBegin] + b;
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     ConvTranspose,
     1, 10,
@@ -244,6 +341,54 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
+  // 2D transposed convolutions without dilations skip the column buffer and the col2im pass.
+  if (p.X->Shape().NumDimensions() == 4 &&
+      std::all_of(p.dilations.begin(), p.dilations.end(), [](int64_t d) { return d == 1; }) &&
+      std::all_of(p.pads.begin(), p.pads.end(), [](int64_t pad) { return pad >= 0; })) {
+    const SubPixelShape shape(static_cast<size_t>(p.num_input_channels / conv_transpose_attrs_.group),
+                              static_cast<size_t>(p.num_output_channels / conv_transpose_attrs_.group),
+                              static_cast<size_t>(p.input_shape[0]), static_cast<size_t>(p.input_shape[1]),
+                              static_cast<size_t>(p.Y->Shape()[2]), static_cast<size_t>(p.Y->Shape()[3]),
+                              static_cast<size_t>(p.kernel_shape[0]), static_cast<size_t>(p.kernel_shape[1]),
+                              static_cast<size_t>(p.strides[0]), static_cast<size_t>(p.strides[1]),
+                              static_cast<size_t>(p.pads[0]), static_cast<size_t>(p.pads[1]));
+
+    // The GEMMs read the filter taps from the transposed filter, which is packed unless the filter isn't constant.
+    const float* packed_filter = static_cast<const float*>(transposed_filter_.get());
+    BufferUniquePtr filter_buffer;
+    if (p.F != nullptr) {
+      auto* filter_data = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * p.F->Shape().Size()));
+      filter_buffer = BufferUniquePtr(filter_data, BufferDeleter(alloc));
+      for (int64_t group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
+        MlasTranspose(p.F->Data<float>() + group_id * W_offset, filter_data + group_id * W_offset,
+                      shape.C, static_cast<size_t>(kernel_dim));
+      }
+      packed_filter = filter_data;
+    }
+
+    const size_t padded_input_size = SafeInt<size_t>(shape.C) * shape.Hp * shape.Wp + shape.Wp;
+    const size_t phase_output_size = SafeInt<size_t>(shape.M) * shape.Qh * shape.Wp;
+    auto* work_data = static_cast<float*>(
+        alloc->Alloc(SafeInt<size_t>(sizeof(float)) * (SafeInt<size_t>(padded_input_size) + phase_output_size)));
+    BufferUniquePtr work_buffer(work_data, BufferDeleter(alloc));
+
+    const float* Xdata = p.X->Data<float>();
+    const float* Bdata = p.B != nullptr ? p.B->Data<float>() : nullptr;
+    float* Ydata = p.Y->MutableData<float>();
+
+    for (int64_t image_id = 0; image_id < p.N; ++image_id) {
+      for (int64_t group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
+        ConvTransposeSubPixel2D(Xdata, packed_filter + group_id * W_offset,
+                                Bdata != nullptr ? Bdata + group_id * shape.M : nullptr, Ydata,
+                                work_data, work_data + padded_input_size, shape, thread_pool);
+        Xdata += X_offset;
+        Ydata += Y_offset;
+      }
+    }
+
+    return Status::OK();
+  }
+
   const int64_t col_buffer_size = kernel_dim * p.input_shape.Size();
   auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * col_buffer_size);
   BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
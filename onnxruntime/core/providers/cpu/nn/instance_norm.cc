@@ -3,7 +3,7 @@
 
 #include "core/providers/cpu/nn/instance_norm.h"
 #include "core/providers/cpu/nn/instance_norm_helper.h"
-#include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -28,16 +28,11 @@ Status InstanceNorm<float>::Compute(OpKernelContext* p_op_kernel_context) const
   const TensorShape& x_shape = input->Shape();
   Tensor* Y = p_op_kernel_context->Output(0, x_shape);
 
-  for (auto i = 0; i < N * C; ++i) {
-    ConstEigenVectorArrayMap<float> Xi(input->template Data<float>() + W * i, W);
-    const float Xi_mean = Xi.mean();
-    const float squared_norm = (Xi - Xi_mean).matrix().squaredNorm();
-    const float inv_stdev = 1.0f / std::sqrt(squared_norm / W + epsilon_);
-    EigenVectorArrayMap<float> Yi(Y->template MutableData<float>() + W * i, W);
-    const float channel_scale = inv_stdev * scale->template Data<float>()[i % C];
-    const float channel_shift = B->template Data<float>()[i % C] - Xi_mean * channel_scale;
-    Yi = Xi * channel_scale + channel_shift;
-  }
+  // instance normalization is group normalization with a group per channel
+  MlasGroupNormalization(input->Data<float>(), scale->Data<float>(), B->Data<float>(), Y->MutableData<float>(),
+                         static_cast<size_t>(N), static_cast<size_t>(C), static_cast<size_t>(W),
+                         static_cast<size_t>(C), epsilon_, false, false,
+                         p_op_kernel_context->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -15,6 +15,7 @@
 #include <iconv.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -115,21 +116,36 @@ using Utf8Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
 #else
 
 // All others (Linux)
+// The iconv descriptors are opened once and reused for all the strings of a Compute() call.
 class Utf8Converter {
  public:
-  Utf8Converter(const std::string&, const std::wstring&) {}
+  // Order of arguments is to, from
+  Utf8Converter(const std::string&, const std::wstring&)
+      : to_wchar_(iconv_open("WCHAR_T", "UTF-8")),
+        to_utf8_(iconv_open("UTF-8", "WCHAR_T")) {}
+
+  ~Utf8Converter() {
+    if (IsValid(to_wchar_)) {
+      iconv_close(to_wchar_);
+    }
+    if (IsValid(to_utf8_)) {
+      iconv_close(to_utf8_);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Utf8Converter);
 
   std::wstring from_bytes(const std::string& s) const {
     std::wstring result;
     if (s.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("WCHAR_T", "UTF-8");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    auto icvt = to_wchar_;
+    if (!IsValid(icvt)) {
       return wconv_error;
     }
+    // Reset the conversion state left by a previous failed conversion
+    iconv(icvt, nullptr, nullptr, nullptr, nullptr);
 
     char* iconv_in = const_cast<char*>(s.c_str());
     size_t iconv_in_bytes = s.length();
@@ -147,7 +163,6 @@ class Utf8Converter {
       assert((converted_bytes % sizeof(wchar_t)) == 0);
       result.assign(reinterpret_cast<const wchar_t*>(buffer.get()), converted_bytes / sizeof(wchar_t));
     }
-    iconv_close(icvt);
     return result;
   }
 
@@ -156,12 +171,11 @@ class Utf8Converter {
     if (wstr.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("UTF-8", "WCHAR_T");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    auto icvt = to_utf8_;
+    if (!IsValid(icvt)) {
       return conv_error;
     }
+    iconv(icvt, nullptr, nullptr, nullptr, nullptr);
 
     // I hope this does not modify the incoming buffer
     wchar_t* non_const_in = const_cast<wchar_t*>(wstr.c_str());
@@ -181,9 +195,17 @@ class Utf8Converter {
       size_t converted_len = buffer_len - iconv_out_bytes;
       result.assign(buffer.get(), converted_len);
     }
-    iconv_close(icvt);
     return result;
   }
+
+ private:
+  static bool IsValid(iconv_t icvt) {
+    // CentOS is not happy with -1
+    return std::numeric_limits<iconv_t>::max() != icvt;
+  }
+
+  iconv_t to_wchar_;
+  iconv_t to_utf8_;
 };
 
 #endif  // __APPLE__
@@ -192,12 +214,56 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS
 
 #endif  // MS_VER
 
+// Returns true if the locale changes the case of the ASCII chars like the "C" locale does, i.e. only 'A'-'Z' and
+// 'a'-'z' change, to each other. This is not the case of the Turkish locales for example, which map 'i' to U+0130.
+bool HasAsciiCaseMapping(const Locale& loc) {
+  std::wstring lower(128, L'\0');
+  for (size_t ch = 0; ch < lower.size(); ++ch) {
+    lower[ch] = static_cast<wchar_t>(ch);
+  }
+  std::wstring upper(lower);
+  loc.ChangeCase(StringNormalizer::LOWER, lower);
+  loc.ChangeCase(StringNormalizer::UPPER, upper);
+
+  for (size_t ch = 0; ch < lower.size(); ++ch) {
+    const bool is_upper = ch >= 'A' && ch <= 'Z';
+    const bool is_lower = ch >= 'a' && ch <= 'z';
+    if (lower[ch] != static_cast<wchar_t>(is_upper ? ch - 'A' + 'a' : ch) ||
+        upper[ch] != static_cast<wchar_t>(is_lower ? ch - 'a' + 'A' : ch)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// The loops below have no early exit and no branches so that the compiler vectorizes them
+bool IsAscii(const std::string& s) {
+  unsigned char all_bits = 0;
+  for (const char ch : s) {
+    all_bits |= static_cast<unsigned char>(ch);
+  }
+  return all_bits < 0x80;
+}
+
+// Changes the case of an ASCII string in place, without the round trip through std::wstring
+void ChangeAsciiCase(StringNormalizer::CaseAction caseaction, std::string& s) {
+  assert(caseaction != StringNormalizer::NONE);
+  // 'a' - 'A' is 0x20, so flip that bit for the chars in the first range
+  const unsigned char first = caseaction == StringNormalizer::LOWER ? 'A' : 'a';
+  std::transform(s.begin(), s.end(), s.begin(), [first](char ch) {
+    const unsigned char in_range = static_cast<unsigned char>(static_cast<unsigned char>(ch) - first) < 26;
+    return static_cast<char>(static_cast<unsigned char>(ch) ^ (in_range << 5));
+  });
+}
+
 template <class ForwardIter>
 Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
                       const Locale& loc,
                       Utf8Converter& converter,
                       size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
+                      StringNormalizer::CaseAction caseaction,
+                      bool ascii_case_mapping) {
   std::vector<int64_t> output_dims;
   if (N == 1) {
     output_dims.push_back(1);
@@ -221,7 +287,12 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
   size_t output_idx = 0;
   while (first != end) {
     auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
+    if ((caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) &&
+        ascii_case_mapping && IsAscii(s)) {
+      std::string& output = *(output_data + output_idx);
+      output = static_cast<const std::string&>(s);
+      ChangeAsciiCase(caseaction, output);
+    } else if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
       std::wstring wstr = converter.from_bytes(s);
       if (wstr == wconv_error) {
         // Please do not include the input text in the error message as it could
@@ -276,6 +347,7 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
   Locale locale(locale_name_);
   Utf8Converter converter(conv_error, wconv_error);
+  ascii_case_mapping_ = HasAsciiCaseMapping(locale);
 
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
   for (auto& sw : swords) {
@@ -287,6 +359,10 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       std::wstring wstr = converter.from_bytes(sw);
       ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
       locale.ChangeCase(compare_caseaction_, wstr);
+      if (ascii_case_mapping_ &&
+          std::all_of(wstr.cbegin(), wstr.cend(), [](wchar_t ch) { return static_cast<uint32_t>(ch) < 0x80; })) {
+        ascii_stopwords_.insert(std::string(wstr.cbegin(), wstr.cend()));
+      }
       auto p = wstopwords_.insert(std::move(wstr));
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     }
@@ -339,10 +415,11 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
         ++first;
       }
       status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
+                              N, filtered_strings.size(), case_change_action_, ascii_case_mapping_);
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_,
+                              ascii_case_mapping_);
     }
   } else {
     if (!wstopwords_.empty()) {
@@ -353,10 +430,27 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       InlinedVector<std::string> filtered_cased_strings;
       filtered_orignal_strings.reserve(C);
       filtered_cased_strings.reserve(C);
+      std::string ascii_cased;
       auto first = input_data;
       auto const last = input_data + C;
       while (first != last) {
         const std::string& s = *first;
+        if (ascii_case_mapping_ && IsAscii(s)) {
+          // An ASCII string stays ASCII once cased, so it can only match one of the ASCII stopwords
+          ascii_cased.assign(s);
+          ChangeAsciiCase(compare_caseaction_, ascii_cased);
+          if (0 == ascii_stopwords_.count(ascii_cased)) {
+            if (case_change_action_ == NONE) {
+              filtered_orignal_strings.push_back(std::cref(s));
+            } else {
+              // compare_caseaction_ is the case change action in this case
+              filtered_cased_strings.push_back(ascii_cased);
+            }
+          }
+          ++first;
+          continue;
+        }
+
         std::wstring wstr = converter.from_bytes(s);
         if (wstr == wconv_error) {
           // Please do not include the input text in the error message as it could
@@ -376,14 +470,15 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       }
       if (case_change_action_ == NONE) {
         status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
+                                N, filtered_orignal_strings.size(), NONE, ascii_case_mapping_);
       } else {
         status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+                                N, filtered_cased_strings.size(), NONE, ascii_case_mapping_);
       }
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_,
+                              ascii_case_mapping_);
     }
   }
   return status;
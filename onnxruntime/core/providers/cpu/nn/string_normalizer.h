@@ -29,9 +29,13 @@ class StringNormalizer : public OpKernel {
   CaseAction case_change_action_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
+  // The locale maps the case of ASCII chars like the "C" locale, so ASCII strings can skip the wchar_t conversion
+  bool ascii_case_mapping_{false};
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
+  // The case-insensitive stopwords that are ASCII once cased, to filter ASCII strings without converting them
+  InlinedHashSet<std::string> ascii_stopwords_;
 };
 
 }  // namespace onnxruntime
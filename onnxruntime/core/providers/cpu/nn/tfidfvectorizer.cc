@@ -23,61 +23,57 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
-
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
-
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
+// NgramAutomaton is the n-gram pool compiled into a Trie like state machine.
+// Pool items are mapped to dense token ids (0 - means the item is not in the pool) and
+// the edges of all states are kept in a single hash map keyed by (state, token), so matching
+// an input window hashes a pair of integers per step instead of the input item itself.
+// For a unigram (1) the root gets an edge to a state with a valid id.
+// For (1,2,3) the state reached through 2 would have id == 0
+// because (1,2) does not exists. The state reached through 3 would have a valid id.
+struct NgramAutomaton {
+  // Per state n-gram id, 0 - means no entry, search for a bigger N. State 0 is the root.
+  std::vector<size_t> ngram_ids_{0};
+  std::unordered_map<uint64_t, uint32_t> transitions_;
+
+  static uint64_t Key(uint32_t state, uint32_t token) {
+    return (static_cast<uint64_t>(state) << 32) | token;
+  }
 
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+  // Returns the state reached from state through token, adding it if needed
+  uint32_t AddTransition(uint32_t state, uint32_t token) {
+    auto p = transitions_.emplace(Key(state, token), static_cast<uint32_t>(ngram_ids_.size()));
+    if (p.second) {
+      ngram_ids_.push_back(0);
+    }
+    return p.first->second;
+  }
 
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+  // Returns 0 if there is no such transition. The root is never a transition target.
+  uint32_t Next(uint32_t state, uint32_t token) const {
+    auto hit = transitions_.find(Key(state, token));
+    return (hit == transitions_.end()) ? 0 : hit->second;
+  }
 };
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+using IntTokenMap = std::unordered_map<int64_t, uint32_t>;
+
+using StrTokenMap = std::unordered_map<std::reference_wrapper<const std::string>, uint32_t,
+                                       std::hash<std::string>, std::equal_to<std::string>>;
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter, class TokenMap>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            TokenMap& tokens, NgramAutomaton& automaton) {
   for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
+    uint32_t state = 0;
+    for (size_t n = 1; n <= ngram_size; ++n, ++first) {
+      // token ids start with 1
+      const uint32_t token = tokens.emplace(*first, static_cast<uint32_t>(tokens.size() + 1)).first->second;
+      state = automaton.AddTransition(state, token);
     }
+    ORT_ENFORCE(automaton.ngram_ids_[state] == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+    automaton.ngram_ids_[state] = ngram_id;
+    ++ngram_id;
   }
   return ngram_id;
 }
@@ -89,10 +85,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -128,10 +120,12 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const float> weights_;
 
   // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // of pool_strings attribute and their token ids
+  StrTokenMap str_tokens_;
+  // This map contains pool_int64s entries and their token ids
+  IntTokenMap int64_tokens_;
+  // Loaded n-grams over the token ids
+  NgramAutomaton automaton_;
 
   size_t output_size_ = 0;
 
@@ -237,9 +231,11 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->int64_tokens_, impl_->automaton_);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id,
+                                   impl_->str_tokens_, impl_->automaton_);
         }
       } else {
         ngram_id += ngrams;
@@ -313,65 +309,55 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
 void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
                                   std::vector<uint32_t>& frequencies) const {
   auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
+  const auto& impl = *impl_;
 
-  const void* const row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
+  // Map the row items to token ids once so the n-gram matching below hashes only integers
+  std::vector<uint32_t> tokens(row_size);
+  const size_t row_offset = static_cast<size_t>(row_num) * row_size;
+  auto map_tokens = [&tokens, row_size](const auto* items, const auto& token_map) {
+    for (size_t i = 0; i < row_size; ++i) {
+      auto hit = token_map.find(items[i]);
+      tokens[i] = (hit == token_map.end()) ? 0 : hit->second;
+    }
+  };
 
-  const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
+  if (X->IsDataTypeString()) {
+    map_tokens(X->Data<std::string>() + row_offset, impl.str_tokens_);
+  } else if (X->IsDataType<int32_t>()) {
+    map_tokens(X->Data<int32_t>() + row_offset, impl.int64_tokens_);
+  } else {
+    map_tokens(X->Data<int64_t>() + row_offset, impl.int64_tokens_);
+  }
 
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
+  const auto& automaton = impl.automaton_;
+  const size_t max_gram_length = impl.max_gram_length_;
+  const size_t max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
+  size_t start_ngram_size = impl.min_gram_length_;
 
-    while (ngram_start < ngram_row_end) {
+  for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (size_t ngram_start = 0; ngram_start < row_size; ++ngram_start) {
       // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, skip_distance * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= row_size) {
         break;
       }
 
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
+      uint32_t state = 0;
+      for (size_t ngram_size = 1, ngram_item = ngram_start;
+           ngram_size <= max_gram_length && ngram_item < row_size;
+           ++ngram_size, ngram_item += skip_distance) {
+        const uint32_t token = tokens[ngram_item];
+        if (token == 0) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
+        state = automaton.Next(state, token);
+        if (state == 0) {
+          break;
+        }
+        const size_t ngram_id = automaton.ngram_ids_[state];
+        if (ngram_size >= start_ngram_size && ngram_id != 0) {
+          impl.IncrementCount(ngram_id, row_num, frequencies);
         }
       }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
     }
     // We count UniGrams only once since they are not affected
     // by skip distance
@@ -417,8 +403,8 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   frequencies.resize(num_rows * impl_->output_size_, 0);
 
   if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+      (X->IsDataTypeString() && impl_->str_tokens_.empty()) ||
+      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_tokens_.empty())) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
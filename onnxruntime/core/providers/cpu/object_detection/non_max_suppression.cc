@@ -13,6 +13,7 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
+#include "core/platform/threadpool.h"
 #include <queue>
 #include <utility>
 //TODO:fix the warnings
@@ -39,6 +40,109 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+
+// The corners and areas of boxes, one array per coordinate so that a box is compared with many boxes in a loop the
+// compiler can vectorize.
+struct BoxCorners {
+  std::vector<float> x_min, y_min, x_max, y_max, area;
+
+  void Reserve(size_t count) {
+    x_min.reserve(count);
+    y_min.reserve(count);
+    x_max.reserve(count);
+    y_max.reserve(count);
+    area.reserve(count);
+  }
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  size_t Size() const {
+    return area.size();
+  }
+
+  void Push(float box_x_min, float box_y_min, float box_x_max, float box_y_max, float box_area) {
+    x_min.push_back(box_x_min);
+    y_min.push_back(box_y_min);
+    x_max.push_back(box_x_max);
+    y_max.push_back(box_y_max);
+    area.push_back(box_area);
+  }
+
+  void Push(const BoxCorners& boxes, int64_t index) {
+    Push(boxes.x_min[index], boxes.y_min[index], boxes.x_max[index], boxes.y_max[index], boxes.area[index]);
+  }
+
+  // Computes the corners of the boxes of a batch the way SuppressByIOU does.
+  void Load(const float* boxes_data, int64_t num_boxes, int64_t center_point_box) {
+    Clear();
+    Reserve(static_cast<size_t>(num_boxes));
+
+    for (int64_t i = 0; i < num_boxes; ++i) {
+      const float* box = boxes_data + 4 * i;
+      float box_x_min{};
+      float box_y_min{};
+      float box_x_max{};
+      float box_y_max{};
+      // center_point_box_ only support 0 or 1
+      if (0 == center_point_box) {
+        // boxes data format [y1, x1, y2, x2],
+        MaxMin(box[1], box[3], box_x_min, box_x_max);
+        MaxMin(box[0], box[2], box_y_min, box_y_max);
+      } else {
+        // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+        const float box_width_half = box[2] / 2;
+        const float box_height_half = box[3] / 2;
+        box_x_min = box[0] - box_width_half;
+        box_x_max = box[0] + box_width_half;
+        box_y_min = box[1] - box_height_half;
+        box_y_max = box[1] + box_height_half;
+      }
+      Push(box_x_min, box_y_min, box_x_max, box_y_max, (box_x_max - box_x_min) * (box_y_max - box_y_min));
+    }
+  }
+
+  // Returns true if the IOU (Intersection Over Union) of box `index` of `boxes` with one of these boxes exceeds
+  // iou_threshold. Same result as SuppressByIOU, the boxes with an empty intersection or area are not suppressed.
+  bool Suppress(const BoxCorners& boxes, int64_t index, float iou_threshold) const {
+    // the boxes are compared by blocks, so the loop is vectorized and still stops early once the box is suppressed
+    constexpr size_t block_size = 16;
+
+    const float box_x_min = boxes.x_min[index];
+    const float box_y_min = boxes.y_min[index];
+    const float box_x_max = boxes.x_max[index];
+    const float box_y_max = boxes.y_max[index];
+    const float box_area = boxes.area[index];
+
+    const size_t count = Size();
+    for (size_t block_start = 0; block_start < count; block_start += block_size) {
+      const size_t block_end = std::min(block_start + block_size, count);
+      bool suppressed = false;
+      for (size_t i = block_start; i < block_end; ++i) {
+        const float intersection_width = std::max(std::min(box_x_max, x_max[i]) - std::max(box_x_min, x_min[i]), 0.f);
+        const float intersection_height = std::max(std::min(box_y_max, y_max[i]) - std::max(box_y_min, y_min[i]), 0.f);
+        const float intersection_area = intersection_width * intersection_height;
+        const float union_area = box_area + area[i] - intersection_area;
+        suppressed |= (intersection_area > .0f) & (box_area > .0f) & (area[i] > .0f) & (union_area > .0f) &
+                      (intersection_area / union_area > iou_threshold);
+      }
+      if (suppressed) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+}  // namespace
+
 // This works for both CPU and GPU.
 // CUDA kernel declare OrtMemTypeCPUInput for max_output_boxes_per_class(2), iou_threshold(3) and score_threshold(4)
 Status NonMaxSuppressionBase::PrepareCompute(OpKernelContext* ctx, PrepareContext& pc) {
@@ -144,55 +248,66 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   };
 
   const auto center_point_box = GetCenterPointBox();
+  const int64_t num_boxes = pc.num_boxes_;
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
+  // The corners of the boxes of a batch are computed once for all its classes.
+  std::vector<BoxCorners> batch_boxes(static_cast<size_t>(pc.num_batches_));
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
+    batch_boxes[batch_index].Load(boxes_data + (batch_index * num_boxes * 4), num_boxes, center_point_box);
+  }
+
+  // The classes of all the batches are processed in parallel, each one selecting its boxes in its own vector.
+  const int64_t num_batch_classes = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<SelectedIndex>> selected_indices_per_class(static_cast<size_t>(num_batch_classes));
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_batch_classes),
+      [&](std::ptrdiff_t batch_class_index) {
+        const int64_t batch_index = batch_class_index / pc.num_classes_;
+        const int64_t class_index = batch_class_index % pc.num_classes_;
+        const BoxCorners& boxes = batch_boxes[batch_index];
+        std::vector<SelectedIndex>& selected_indices = selected_indices_per_class[batch_class_index];
+
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(num_boxes);
+
+        // Filter by score_threshold_ before building the heap, so that only the candidates are ordered
+        const auto* class_scores = scores_data + batch_class_index * num_boxes;
+        if (pc.score_threshold_ != nullptr) {
+          for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+            if (*class_scores > score_threshold) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
+          }
+        } else {
+          for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
             candidate_boxes.emplace_back(*class_scores, box_index);
           }
         }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+        std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
+
+        BoxCorners selected_boxes_inside_class;
+        selected_boxes_inside_class.Reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class),
+                                                             sorted_boxes.size()));
+
+        // Get the next box with top score, filter by iou_threshold
+        while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.Size()) < max_output_boxes_per_class) {
+          const BoxInfoPtr& next_top_score = sorted_boxes.top();
+
+          // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+          if (!selected_boxes_inside_class.Suppress(boxes, next_top_score.index_, iou_threshold)) {
+            selected_boxes_inside_class.Push(boxes, next_top_score.index_);
+            selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
           }
-        }
+          sorted_boxes.pop();
+        }  //while
+      },
+      0);
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+  std::vector<SelectedIndex> selected_indices;
+  for (const auto& class_selected_indices : selected_indices_per_class) {
+    selected_indices.insert(selected_indices.end(), class_selected_indices.begin(), class_selected_indices.end());
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
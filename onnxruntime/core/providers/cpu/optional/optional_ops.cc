@@ -38,8 +38,7 @@ ONNX_CPU_OPERATOR_KERNEL(OptionalGetElement,
                              .Alias(0, 0),
                          OptionalGetElement);
 
-static void CopySequenceTensor(AllocatorPtr alloc,
-                               const TensorSeq* src,
+static void CopySequenceTensor(const TensorSeq* src,
                                TensorSeq* tgt) {
   // The static allocation planner has deemed that the input can be re-used as the output
   // Analogy: Checking if data pointers for the input and output Tensors are the same
@@ -50,17 +49,11 @@ static void CopySequenceTensor(AllocatorPtr alloc,
 
   tgt->SetType(src->DataType());
 
-  std::vector<Tensor> output_tensors;
-  output_tensors.reserve(src->Size());
-
-  auto in_tensor = src->begin();
-  for (; in_tensor != src->end(); ++in_tensor) {
-    Tensor tmp(in_tensor->DataType(), onnxruntime::TensorShape(in_tensor->Shape()), alloc);
-    CopyCpuTensor(&*in_tensor, &tmp);
-    output_tensors.push_back(std::move(tmp));
+  // the tensors of a sequence are never modified, so the target shares them with the source
+  tgt->Reserve(src->Size());
+  for (size_t i = 0, end = src->Size(); i < end; ++i) {
+    tgt->Add(src->GetOrtValue(i));
   }
-
-  tgt->SetElements(std::move(output_tensors));
 }
 
 static Status PropagateInputOrtValueToFirstOutput(const OrtValue* input_ort_value,
@@ -80,14 +73,11 @@ static Status PropagateInputOrtValueToFirstOutput(const OrtValue* input_ort_valu
     const auto* input_tensor_sequence = &input_ort_value->Get<TensorSeq>();
     auto* output_tensor_sequence = ctx->Output<TensorSeq>(0);
 
-    AllocatorPtr alloc;
-    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
-
     // If the allocation planner had deemed that we re-use the input OrtValue
     // as the output OrtValue, the pointers of the source TensorSeq and the
     // target TensorSeq will be the same and the copy is a no-op.
     // CopySequenceTensor() already has such copy optimizations
-    CopySequenceTensor(alloc, input_tensor_sequence, output_tensor_sequence);
+    CopySequenceTensor(input_tensor_sequence, output_tensor_sequence);
 
   } else {
     // Will not reach here
@@ -72,6 +72,7 @@ class QLinearConv : public OpKernel {
 
   static void ComputeOffset(OpKernelContext* context,
                             int64_t M,
+                            bool is_W_centered,
                             ActType& X_zero_point_value,
                             ActType& Y_zero_point_value,
                             uint8_t& W_zero_point_value) {
@@ -91,7 +92,8 @@ class QLinearConv : public OpKernel {
     const int64_t W_zero_point_size = W_zero_point->Shape().Size();
     const auto* W_zero_point_data = static_cast<const uint8_t*>(W_zero_point->DataRaw());
     W_zero_point_value = W_zero_point_data[0];
-    for (int64_t i = 1; i < W_zero_point_size; i++) {
+    // The zero points were already subtracted from a filter packed for the symmetric kernels.
+    for (int64_t i = 1; i < W_zero_point_size && !is_W_centered; i++) {
       ORT_ENFORCE(W_zero_point_data[i] == W_zero_point_value,
                   "QLinearConv : zero point of per-channel filter must be same");
     }
@@ -150,6 +152,34 @@ class QLinearConv : public OpKernel {
     return task_count;
   }
 
+  // Subtract the (possibly per-channel) zero point from each output channel of the filter, so that filters with
+  // unsigned or asymmetric weights can use the symmetric kernels. Returns false if a shifted weight does not fit in
+  // int8_t.
+  static bool CenterFilter(const uint8_t* Wdata,
+                           const Tensor& W_zero_point,
+                           bool is_W_signed,
+                           size_t output_channels,
+                           size_t kernel_dim,
+                           int8_t* centered_W) {
+    const size_t W_zero_point_size = static_cast<size_t>(W_zero_point.Shape().Size());
+    const auto* W_zero_point_data = static_cast<const uint8_t*>(W_zero_point.DataRaw());
+    auto to_int32 = [is_W_signed](uint8_t v) {
+      return is_W_signed ? static_cast<int32_t>(static_cast<int8_t>(v)) : static_cast<int32_t>(v);
+    };
+
+    for (size_t oc = 0; oc < output_channels; oc++) {
+      const int32_t zero_point = to_int32(W_zero_point_data[W_zero_point_size == 1 ? 0 : oc]);
+      for (size_t k = 0; k < kernel_dim; k++) {
+        const int32_t w = to_int32(*Wdata++) - zero_point;
+        if (w < std::numeric_limits<int8_t>::lowest() || w > std::numeric_limits<int8_t>::max()) {
+          return false;
+        }
+        *centered_W++ = static_cast<int8_t>(w);
+      }
+    }
+    return true;
+  }
+
   bool TryConvSymPrepack(const uint8_t* Wdata,
                          AllocatorPtr alloc,
                          size_t output_channels,
@@ -167,11 +197,20 @@ class QLinearConv : public OpKernel {
     }
 
     auto X_zero_point_value = *(X_zero_point->template Data<ActType>());
+
+    // Symmetric means weight zero point must be zero. Other filters are shifted by their zero points first.
+    const size_t kernel_dim = group_input_channels * kernel_size;
     const size_t W_zero_point_size = static_cast<size_t>(W_zero_point->Shape().Size());
-    const auto* W_zero_point_data = W_zero_point->Data<int8_t>();
-    if (!std::all_of(W_zero_point_data, W_zero_point_data + W_zero_point_size, [](int8_t v) { return v == 0; })) {
-      // Symmetric means weight zero point must be zero
-      return false;
+    const auto* W_zero_point_data = static_cast<const uint8_t*>(W_zero_point->DataRaw());
+    BufferUniquePtr centered_W_buffer;
+    if (!is_W_signed_ ||
+        !std::all_of(W_zero_point_data, W_zero_point_data + W_zero_point_size, [](uint8_t v) { return v == 0; })) {
+      auto* centered_W = static_cast<int8_t*>(alloc->Alloc(SafeInt<size_t>(output_channels) * kernel_dim));
+      centered_W_buffer = BufferUniquePtr(centered_W, BufferDeleter(alloc));
+      if (!CenterFilter(Wdata, *W_zero_point, is_W_signed_, output_channels, kernel_dim, centered_W)) {
+        return false;
+      }
+      Wdata = reinterpret_cast<const uint8_t*>(centered_W);
     }
 
     // Try indirect conv packing
@@ -186,7 +225,7 @@ class QLinearConv : public OpKernel {
       int32_t X_zero_point_fixup = MlasConvSymFixupInputZeroPoint(X_zero_point_value, std::is_signed<ActType>::value);
       for (size_t oc = 0; oc < output_channels; oc++) {
         int32_t sum = 0;
-        for (size_t ks = 0; ks < kernel_size * group_input_channels; ks++) {
+        for (size_t ks = 0; ks < kernel_dim; ks++) {
           sum += *sdata++;
         }
         column_sums_[oc] = (Bdata != nullptr ? Bdata[oc] : 0) - sum * X_zero_point_fixup;
@@ -212,7 +251,6 @@ class QLinearConv : public OpKernel {
     // Try symmetric GEMM packing
     // Don't pack the filter buffer if the MlasConvDepthwise path is used.
     if (group_input_channels != 1 || group_output_channels != 1) {
-      const size_t kernel_dim = group_input_channels * kernel_size;
       packed_W_size_ = MlasSymmQgemmPackBSize(group_output_channels,
                                               kernel_dim,
                                               std::is_same<ActType, int8_t>::value);
@@ -384,15 +422,15 @@ Status QLinearConv<ActType>::PrePack(const Tensor& tensor, int input_idx, Alloca
 
   bool share_prepacked_weights = (prepacked_weights != nullptr);
 
-  // Determine if the symmetric weight convolution path can be used. The weights must be
-  // signed and all weight zero points must be zero.
-  if (is_W_signed_ && TryConvSymPrepack(Wdata,
-                                        alloc,
-                                        output_channels,
-                                        group_count,
-                                        group_input_channels,
-                                        group_output_channels,
-                                        kernel_size)) {
+  // Determine if the symmetric weight convolution path can be used. The weights are shifted by
+  // their zero points if needed, which must leave every weight within the range of int8_t.
+  if (TryConvSymPrepack(Wdata,
+                        alloc,
+                        output_channels,
+                        group_count,
+                        group_input_channels,
+                        group_output_channels,
+                        kernel_size)) {
     is_packed = true;
     return Status::OK();
   }
@@ -509,7 +547,8 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
   ActType X_zero_point_value;
   ActType Y_zero_point_value;
   uint8_t W_zero_point_value;
-  ComputeOffset(context, M, X_zero_point_value, Y_zero_point_value, W_zero_point_value);
+  ComputeOffset(context, M, is_symmetric_conv_ || is_symmetric_gemm_,
+                X_zero_point_value, Y_zero_point_value, W_zero_point_value);
   std::vector<float> output_scales = ComputeOutputScale(context, M);
 
   const Tensor* B = context->Input<Tensor>(InputTensors::IN_BIAS);
@@ -834,7 +873,7 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
           gemm_shape.N = static_cast<size_t>(group_output_channels);
           gemm_shape.K = static_cast<size_t>(kernel_dim);
           gemm_shape.AIsSigned = std::is_signed<ActType>::value;
-          gemm_shape.BIsSigned = is_W_signed;
+          gemm_shape.BIsSigned = is_W_signed || is_symmetric_gemm_;
 
           if (is_symmetric_gemm_) {
             MLAS_SYMM_QGEMM_DATA_PARAMS symm_gemm;
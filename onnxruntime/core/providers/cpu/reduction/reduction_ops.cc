@@ -230,7 +230,7 @@ bool operator!=(FastReduceKind a, FastReduceKind b) {
 }
 
 bool ResultsNoTransposePrepareForReduce::equal(gsl::span<const int64_t> local_input_shape,
-                                               gsl::span<const int64_t> local_reduced_axes) {
+                                               gsl::span<const int64_t> local_reduced_axes) const {
   if (gsl::make_span(input_shape) != local_input_shape)
     return false;
   if (gsl::make_span(reduced_axes) != local_reduced_axes)
@@ -238,7 +238,7 @@ bool ResultsNoTransposePrepareForReduce::equal(gsl::span<const int64_t> local_in
   return true;
 }
 
-void ResultsNoTransposePrepareForReduce::ValidateNotEmpty() {
+void ResultsNoTransposePrepareForReduce::ValidateNotEmpty() const {
   ORT_ENFORCE(last_loop_red_size > 0);
   ORT_ENFORCE(last_loop_size > 0);
   ORT_ENFORCE(projected_index.size() > 0);
@@ -378,6 +378,62 @@ void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
   }
 }
 
+static bool NeedsPrepareForReduce(const TensorShape& new_input_shape, gsl::span<const int64_t> reduced_axes) {
+  // NoTransposeReduce1Loop and NoTransposeReduce2Loops do not use the indices when all or no axes are reduced.
+  return !reduced_axes.empty() && reduced_axes.size() != new_input_shape.NumDimensions();
+}
+
+static std::shared_ptr<const ResultsNoTransposePrepareForReduce> PrepareForReduce(
+    const TensorShape& new_input_shape, gsl::span<const int64_t> reduced_axes, ReducePlanCache* plan_cache) {
+  if (plan_cache != nullptr) {
+    return plan_cache->GetPrepareForReduceResults(new_input_shape, reduced_axes);
+  }
+  auto results = std::make_shared<ResultsNoTransposePrepareForReduce>();
+  if (NeedsPrepareForReduce(new_input_shape, reduced_axes)) {
+    NoTransposePrepareForReduce(new_input_shape, reduced_axes, *results);
+  }
+  return results;
+}
+
+FastReduceKind ReducePlanCache::GetFastReduceShapes(gsl::span<const int64_t> input_shape,
+                                                    gsl::span<const int64_t> reduced_axes,
+                                                    TensorShapeVector& fast_shape,
+                                                    TensorShapeVector& fast_output_shape,
+                                                    TensorShapeVector& fast_axes,
+                                                    bool keep_dims, bool noop_with_empty_axes) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!has_fast_shapes_ || keep_dims != keep_dims_ || noop_with_empty_axes != noop_with_empty_axes_ ||
+      gsl::make_span(input_shape_) != input_shape || gsl::make_span(reduced_axes_) != reduced_axes) {
+    has_fast_shapes_ = false;
+    fast_kind_ = OptimizeShapeForFastReduce(input_shape, reduced_axes, fast_shape_, fast_output_shape_, fast_axes_,
+                                            keep_dims, noop_with_empty_axes);
+    input_shape_.assign(input_shape.begin(), input_shape.end());
+    reduced_axes_.assign(reduced_axes.begin(), reduced_axes.end());
+    keep_dims_ = keep_dims;
+    noop_with_empty_axes_ = noop_with_empty_axes;
+    has_fast_shapes_ = true;
+  }
+  fast_shape = fast_shape_;
+  fast_output_shape = fast_output_shape_;
+  fast_axes = fast_axes_;
+  return fast_kind_;
+}
+
+std::shared_ptr<const ResultsNoTransposePrepareForReduce> ReducePlanCache::GetPrepareForReduceResults(
+    const TensorShape& new_input_shape, gsl::span<const int64_t> reduced_axes) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (results_ == nullptr || !results_->equal(new_input_shape.GetDims(), reduced_axes)) {
+    auto results = std::make_shared<ResultsNoTransposePrepareForReduce>();
+    if (NeedsPrepareForReduce(new_input_shape, reduced_axes)) {
+      NoTransposePrepareForReduce(new_input_shape, reduced_axes, *results);
+    }
+    results->input_shape = new_input_shape.AsShapeVector();
+    results->reduced_axes.assign(reduced_axes.begin(), reduced_axes.end());
+    results_ = std::move(results);
+  }
+  return results_;
+}
+
 void ValidateNoTransposeReduce(int64_t count) {
   ORT_ENFORCE(count == 1, "Reduction on all axes, output size should be 1.");
 }
@@ -386,7 +442,7 @@ template <typename AGG>
 struct ParallelizedData {
   int64_t denominator;
   int64_t loop_size;
-  ResultsNoTransposePrepareForReduce* last_results;
+  const ResultsNoTransposePrepareForReduce* last_results;
   const typename AGG::input_type* from_data;
   typename AGG::value_type* to_data;
 };
@@ -394,7 +450,7 @@ struct ParallelizedData {
 template <typename AGG>
 void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
                             gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
-                            ResultsNoTransposePrepareForReduce& last_results) {
+                            const ResultsNoTransposePrepareForReduce& last_results) {
   auto output_shape = output->Shape();
   const typename AGG::input_type* from_data = input.template Data<typename AGG::input_type>();
   typename AGG::value_type* to_data = output->template MutableData<typename AGG::value_type>();
@@ -407,11 +463,8 @@ void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape,
     return;
   }
 
-  if (!last_results.equal(new_input_shape.GetDims(), reduced_axes)) {
-    NoTransposePrepareForReduce(new_input_shape, reduced_axes, last_results);
-    if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
-      return;
-  }
+  if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
+    return;
   last_results.ValidateNotEmpty();
 
   ParallelizedData<AGG> data;
@@ -459,7 +512,7 @@ void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape,
 template <typename AGG>
 void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
                              gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
-                             ResultsNoTransposePrepareForReduce& last_results) {
+                             const ResultsNoTransposePrepareForReduce& last_results) {
   auto output_shape = output->Shape();
   const typename AGG::input_type* from_data = input.template Data<typename AGG::input_type>();
   typename AGG::value_type* to_data = output->template MutableData<typename AGG::value_type>();
@@ -472,11 +525,8 @@ void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape,
     return;
   }
 
-  if (!last_results.equal(new_input_shape.GetDims(), reduced_axes)) {
-    NoTransposePrepareForReduce(new_input_shape, reduced_axes, last_results);
-    if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
-      return;
-  }
+  if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
+    return;
   last_results.ValidateNotEmpty();
 
   ParallelizedData<AGG> data;
@@ -677,10 +727,12 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             TensorShapeVector& output_shape,
                             TensorShapeVector& fast_axes,
                             FastReduceKind which_fast_reduce,
+                            bool is_vectorized,
                             fast_reduce_fct* case_kr,
                             fast_reduce_fct* case_rk,
                             fast_reduce_fct* case_krk,
-                            fast_reduce_fct* case_rkr) {
+                            fast_reduce_fct* case_rkr,
+                            ReducePlanCache* plan_cache) {
   TensorShapeVector axes;
   const Tensor* input = ctx->Input<Tensor>(0);
   auto reduced_dims = input->Shape().GetDims();
@@ -690,9 +742,17 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
     return true;
   }
 
-  fast_kind = OptimizeShapeForFastReduce(
-      reduced_dims, input_axes.empty() ? axes_ : input_axes,
-      fast_shape, output_shape, fast_axes, keepdims_ != 0, noop_with_empty_axes);
+  gsl::span<const int64_t> reduced_axes = axes_;
+  if (!input_axes.empty()) {
+    reduced_axes = input_axes;
+  }
+  if (plan_cache != nullptr) {
+    fast_kind = plan_cache->GetFastReduceShapes(reduced_dims, reduced_axes, fast_shape, output_shape, fast_axes,
+                                                keepdims_ != 0, noop_with_empty_axes);
+  } else {
+    fast_kind = OptimizeShapeForFastReduce(reduced_dims, reduced_axes, fast_shape, output_shape, fast_axes,
+                                           keepdims_ != 0, noop_with_empty_axes);
+  }
 
   if (which_fast_reduce != FastReduceKind::kNone) {
     if (IsFastReduceKindAvailable(fast_kind, which_fast_reduce)) {
@@ -705,9 +765,10 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
         }
         case FastReduceKind::kRK: {
           ValidateFastReduceRK(fast_shape, *output);
-          if ((fast_shape[0] > concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 16) &&
-              (std::max(fast_shape[0], fast_shape[1]) >
-               concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 256)) {
+          if (is_vectorized ||
+              ((fast_shape[0] > concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 16) &&
+               (std::max(fast_shape[0], fast_shape[1]) >
+                concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 256))) {
             // See benchmarks in PR #7719.
             case_rk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
             return true;
@@ -717,7 +778,8 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
         }
         case FastReduceKind::kKRK:
           ValidateFastReduceKRK(fast_shape, *output);
-          if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
+          if (is_vectorized ||
+              fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
             // See benchmarks in PR #7719.
             case_krk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
             return true;
@@ -752,11 +814,13 @@ bool CommonFastReduce(OpKernelContext* ctx,
                       FastReduceKind& fast_kind,
                       TensorShapeVector& fast_shape,
                       TensorShapeVector& output_shape,
-                      TensorShapeVector& fast_axes) {
+                      TensorShapeVector& fast_axes,
+                      ReducePlanCache* plan_cache) {
   return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
                                 fast_kind, fast_shape, output_shape, fast_axes,
-                                AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK,
-                                &AGG::FastReduceKRK, &AGG::FastReduceRKR);
+                                AGG::WhichFastReduce(), AGG::IsFastReduceVectorized(),
+                                &AGG::FastReduceKR, &AGG::FastReduceRK,
+                                &AGG::FastReduceKRK, &AGG::FastReduceRKR, plan_cache);
 }
 
 static void ValidateKeepDims(const TensorShape& shape, int64_t keepdims) {
@@ -773,13 +837,14 @@ static void ValidateKeepDims(const Tensor* input, int64_t keepdims) {
 template <typename AGG>
 void CommonReduce1Loop(OpKernelContext* ctx,
                        const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                       bool noop_with_empty_axes) {
+                       bool noop_with_empty_axes,
+                       ReducePlanCache* plan_cache) {
   FastReduceKind fast_kind;
   TensorShapeVector fast_shape;
   TensorShapeVector output_shape;
   TensorShapeVector fast_axes;
   if (CommonFastReduce<AGG>(ctx, axes_, keepdims_, noop_with_empty_axes,
-                            fast_kind, fast_shape, output_shape, fast_axes)) {
+                            fast_kind, fast_shape, output_shape, fast_axes, plan_cache)) {
     return;
   }
 
@@ -799,18 +864,20 @@ void CommonReduce1Loop(OpKernelContext* ctx,
     return;
   }
 
-  ResultsNoTransposePrepareForReduce last_results;
-  NoTransposeReduce1Loop<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), last_results);
+  TensorShape new_input_shape(fast_shape);
+  auto last_results = PrepareForReduce(new_input_shape, fast_axes, plan_cache);
+  NoTransposeReduce1Loop<AGG>(output, new_input_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), *last_results);
 }
 
 template <typename AGG>
 void CommonReduce2Loops(OpKernelContext* ctx,
                         const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                        bool noop_with_empty_axes) {
+                        bool noop_with_empty_axes,
+                        ReducePlanCache* plan_cache) {
   FastReduceKind fast_kind;
   TensorShapeVector fast_shape, output_shape, fast_axes;
   if (CommonFastReduce<AGG>(ctx, axes_, keepdims_, noop_with_empty_axes,
-                            fast_kind, fast_shape, output_shape, fast_axes)) {
+                            fast_kind, fast_shape, output_shape, fast_axes, plan_cache)) {
     return;
   }
 
@@ -831,64 +898,62 @@ void CommonReduce2Loops(OpKernelContext* ctx,
     return;
   }
 
-  ResultsNoTransposePrepareForReduce last_results;
-  NoTransposeReduce2Loops<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), last_results);
+  TensorShape new_input_shape(fast_shape);
+  auto last_results = PrepareForReduce(new_input_shape, fast_axes, plan_cache);
+  NoTransposeReduce2Loops<AGG>(output, new_input_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), *last_results);
 }
 
 template <typename T>
 Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  // The following variable does not change if the input tensor and the
-  // axes do not either. It could be either cached in ctx or precomputed
-  // in the constructor if shape and axes are known at this stage.
-  CommonReduce1Loop<ReduceAggregatorL1<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorL1<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorL2<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorL2<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce2Loops<ReduceAggregatorLogSumExp<T>>(ctx, axes_, keepdims_);
+  CommonReduce2Loops<ReduceAggregatorLogSumExp<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorMax<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorMax<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorMean<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorMean<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorMin<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorMin<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorProd<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorProd<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorSum<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorSum<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
@@ -926,8 +991,8 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
       }
       case FastReduceKind::kRK:
         ValidateFastReduceRK(fast_shape, *output);
-        if (std::max(fast_shape[0], fast_shape[1]) >
-            concurrency::ThreadPool::DegreeOfParallelism(tp) * 256) {
+        if (ReduceAggregatorSum<T>::IsFastReduceVectorized() ||
+            std::max(fast_shape[0], fast_shape[1]) > concurrency::ThreadPool::DegreeOfParallelism(tp) * 256) {
           // See benchmarks in PR #7719.
           ReduceAggregatorSum<T>::FastReduceRK(input, fast_shape, *output, tp);
           return output;
@@ -936,7 +1001,8 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
         }
       case FastReduceKind::kKRK:
         ValidateFastReduceKRK(fast_shape, *output);
-        if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
+        if (ReduceAggregatorSum<T>::IsFastReduceVectorized() ||
+            fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
           // See benchmarks in PR #7719.
           ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, *output, tp);
           return output;
@@ -960,23 +1026,24 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
     }
   }
 
-  ResultsNoTransposePrepareForReduce last_results;
-  NoTransposeReduce1Loop<ReduceAggregatorSum<T>>(output.get(), fast_shape, input, fast_axes, tp, last_results);
+  TensorShape fast_input_shape(fast_shape);
+  auto last_results = PrepareForReduce(fast_input_shape, fast_axes, nullptr);
+  NoTransposeReduce1Loop<ReduceAggregatorSum<T>>(output.get(), fast_input_shape, input, fast_axes, tp, *last_results);
   return output;
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_);
+  CommonReduce1Loop<ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
   if (select_last_index_) {
-    CommonReduce1Loop<ReduceAggregatorArgMaxLastIndex<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMaxLastIndex<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   } else {
-    CommonReduce1Loop<ReduceAggregatorArgMax<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMax<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   }
   return Status::OK();
 }
@@ -984,9 +1051,9 @@ Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
   if (select_last_index_) {
-    CommonReduce1Loop<ReduceAggregatorArgMinLastIndex<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMinLastIndex<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   } else {
-    CommonReduce1Loop<ReduceAggregatorArgMin<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMin<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   }
   return Status::OK();
 }
@@ -1002,15 +1069,19 @@ template class ReduceSum<int64_t>;
 
 template void CommonReduce1Loop<ReduceAggregatorSum<float>>(OpKernelContext* ctx,
                                                             const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                            bool noop_with_empty_axes);
+                                                            bool noop_with_empty_axes,
+                                                            ReducePlanCache* plan_cache);
 template void CommonReduce1Loop<ReduceAggregatorSum<int32_t>>(OpKernelContext* ctx,
                                                               const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                              bool noop_with_empty_axes);
+                                                              bool noop_with_empty_axes,
+                                                              ReducePlanCache* plan_cache);
 template void CommonReduce1Loop<ReduceAggregatorSum<double>>(OpKernelContext* ctx,
                                                              const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                             bool noop_with_empty_axes);
+                                                             bool noop_with_empty_axes,
+                                                             ReducePlanCache* plan_cache);
 template void CommonReduce1Loop<ReduceAggregatorSum<int64_t>>(OpKernelContext* ctx,
                                                               const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                              bool noop_with_empty_axes);
+                                                              bool noop_with_empty_axes,
+                                                              ReducePlanCache* plan_cache);
 
 }  // namespace onnxruntime
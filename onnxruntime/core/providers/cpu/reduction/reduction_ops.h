@@ -12,9 +12,12 @@
 #include "core/util/math.h"
 #endif
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
 #include "core/common/safeint.h"
 #include <cmath>
+#include <memory>
 
 namespace onnxruntime {
 
@@ -86,10 +89,66 @@ class ResultsNoTransposePrepareForReduce {
     last_loop_inc = 0;
   }
 
-  bool equal(gsl::span<const int64_t> local_input_shape, gsl::span<const int64_t> local_reduced_axes);
-  void ValidateNotEmpty();
+  bool equal(gsl::span<const int64_t> local_input_shape, gsl::span<const int64_t> local_reduced_axes) const;
+  void ValidateNotEmpty() const;
 };
 
+/**
+  Plan of the last reduction run by a kernel: the shapes computed by OptimizeShapeForFastReduce
+  and, once a run needs them, the indices of the generic loops. Both are only computed again
+  when the input shape or the axes change, shapes usually stay the same from one run to the next.
+  Concurrent runs of the kernel may share the cache.
+*/
+class ReducePlanCache {
+ public:
+  // Same as OptimizeShapeForFastReduce.
+  FastReduceKind GetFastReduceShapes(gsl::span<const int64_t> input_shape,
+                                     gsl::span<const int64_t> reduced_axes,
+                                     TensorShapeVector& fast_shape,
+                                     TensorShapeVector& fast_output_shape,
+                                     TensorShapeVector& fast_axes,
+                                     bool keep_dims, bool noop_with_empty_axes);
+
+  // Same as NoTransposePrepareForReduce, the results are not computed when all or no axes are reduced.
+  std::shared_ptr<const ResultsNoTransposePrepareForReduce> GetPrepareForReduceResults(
+      const TensorShape& new_input_shape, gsl::span<const int64_t> reduced_axes);
+
+ private:
+  OrtMutex mutex_;
+
+  bool has_fast_shapes_ = false;
+  TensorShapeVector input_shape_;
+  TensorShapeVector reduced_axes_;
+  bool keep_dims_ = false;
+  bool noop_with_empty_axes_ = false;
+  FastReduceKind fast_kind_ = FastReduceKind::kNone;
+  TensorShapeVector fast_shape_;
+  TensorShapeVector fast_output_shape_;
+  TensorShapeVector fast_axes_;
+
+  std::shared_ptr<const ResultsNoTransposePrepareForReduce> results_;
+};
+
+/* Float reductions vectorized with MLAS for the KR, RK and KRK cases. */
+inline void VectorizedFastReduceKR(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                   Tensor& output, concurrency::ThreadPool* tp) {
+  MlasReduceInnermost(kind, input.Data<float>(), output.MutableData<float>(),
+                      static_cast<size_t>(fast_shape[0]), static_cast<size_t>(fast_shape[1]), tp);
+}
+
+inline void VectorizedFastReduceRK(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                   Tensor& output, concurrency::ThreadPool* tp) {
+  MlasReduceStrided(kind, input.Data<float>(), output.MutableData<float>(),
+                    1, static_cast<size_t>(fast_shape[0]), static_cast<size_t>(fast_shape[1]), tp);
+}
+
+inline void VectorizedFastReduceKRK(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                    Tensor& output, concurrency::ThreadPool* tp) {
+  MlasReduceStrided(kind, input.Data<float>(), output.MutableData<float>(),
+                    static_cast<size_t>(fast_shape[0]), static_cast<size_t>(fast_shape[1]),
+                    static_cast<size_t>(fast_shape[2]), tp);
+}
+
 template <typename T>
 inline T reduce_sqrt(T value) { return std::sqrt(value); }
 
@@ -153,6 +212,9 @@ class ReduceAggregatorBase {
  public:
   // Fast reduction: see OptimizeShapeForFastReduce's comment.
   static inline FastReduceKind WhichFastReduce() { return FastReduceKind::kNone; }
+  // The fast reductions are vectorized and beat the generic loops whatever the size of the tensor,
+  // the size thresholds of CommonFastReduceSwitch do not apply.
+  static inline bool IsFastReduceVectorized() { return false; }
   static void FastReduceKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceKRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
@@ -222,53 +284,67 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
     return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
   }
 
+  static inline bool IsFastReduceVectorized() { return std::is_same<T, float>::value; }
+
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
-          for (ptrdiff_t d = first; d < last; ++d) {
-            out[d] = aggall(data + d * stridei, stridei);
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceKR(MlasReduceSum, input, fast_shape, output, tp);
+    } else {
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+      int64_t stridei = fast_shape[1];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+          [data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t d = first; d < last; ++d) {
+              out[d] = aggall(data + d * stridei, stridei);
+            }
+          });
+    }
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[1];
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-
-    int64_t n_rows = fast_shape[0];
-    memcpy(out, data, N * sizeof(T));
-    concurrency::ThreadPool::TryParallelFor(
-        tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          for (int64_t row = 1; row < n_rows; ++row) {
-            EigenVectorArrayMap<T>(out + begin, end - begin) += ConstEigenVectorArrayMap<T>(
-                data + row * N + begin, end - begin);
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceRK(MlasReduceSum, input, fast_shape, output, tp);
+    } else {
+      int64_t N = fast_shape[1];
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+
+      int64_t n_rows = fast_shape[0];
+      memcpy(out, data, N * sizeof(T));
+      concurrency::ThreadPool::TryParallelFor(
+          tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+          [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+            for (int64_t row = 1; row < n_rows; ++row) {
+              EigenVectorArrayMap<T>(out + begin, end - begin) += ConstEigenVectorArrayMap<T>(
+                  data + row * N + begin, end - begin);
+            }
+          });
+    }
   }
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[2];
-    const T* data = input.Data<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    T* out = output.MutableData<T>();
-    std::vector<T> one(fast_shape[1], 1);
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [one, data, fast_shape, stridei, strideo, out, N](ptrdiff_t begin, ptrdiff_t last) {
-          for (ptrdiff_t d = begin; d < last; ++d) {
-            math::MatMul<T>(1, N, fast_shape[1], one.data(), data + stridei * d, out + strideo * d, nullptr);
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceKRK(MlasReduceSum, input, fast_shape, output, tp);
+    } else {
+      int64_t N = fast_shape[2];
+      const T* data = input.Data<T>();
+      int64_t stridei = fast_shape[1] * fast_shape[2];
+      int64_t strideo = fast_shape[2];
+      T* out = output.MutableData<T>();
+      std::vector<T> one(fast_shape[1], 1);
+      concurrency::ThreadPool::TryParallelFor(
+          tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
+          [one, data, fast_shape, stridei, strideo, out, N](ptrdiff_t begin, ptrdiff_t last) {
+            for (ptrdiff_t d = begin; d < last; ++d) {
+              math::MatMul<T>(1, N, fast_shape[1], one.data(), data + stridei * d, out + strideo * d, nullptr);
+            }
+          });
+    }
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -290,6 +366,30 @@ class ReduceAggregatorSumSquare : public ReduceAggregator<T, TVAL> {
     return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, this->N_).squaredNorm();
   }
   inline void update(const T& v) { this->accumulator_ += v * v; }
+
+  // Fast reduction, float only
+  static constexpr bool kIsVectorized = std::is_same<T, float>::value && std::is_same<TVAL, float>::value;
+
+  static inline FastReduceKind WhichFastReduce() {
+    return kIsVectorized ? FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK : FastReduceKind::kNone;
+  }
+
+  static inline bool IsFastReduceVectorized() { return kIsVectorized; }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceKR(MlasReduceSumSquare, input, fast_shape, output, tp);
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceRK(MlasReduceSumSquare, input, fast_shape, output, tp);
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceKRK(MlasReduceSumSquare, input, fast_shape, output, tp);
+  }
 };
 
 template <typename T>
@@ -375,60 +475,74 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
     return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
   }
 
+  static inline bool IsFastReduceVectorized() { return std::is_same<T, float>::value; }
+
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
-          EigenVectorMap<T>(out + first, last - first) = ConstEigenMatrixMap<T>(
-                                                             data + first * stridei, stridei, last - first)
-                                                             .colwise()
-                                                             .maxCoeff();
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceKR(MlasReduceMaximum, input, fast_shape, output, tp);
+    } else {
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+      int64_t stridei = fast_shape[1];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+          [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
+            EigenVectorMap<T>(out + first, last - first) = ConstEigenMatrixMap<T>(
+                                                               data + first * stridei, stridei, last - first)
+                                                               .colwise()
+                                                               .maxCoeff();
+          });
+    }
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t n_rows = fast_shape[0];
-    int64_t N = fast_shape[1];
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    memcpy(out, data, N * sizeof(T));
-
-    concurrency::ThreadPool::TryParallelFor(
-        tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          const T* p;
-          for (int64_t row = 1; row < n_rows; ++row) {
-            p = data + row * N;
-            for (int64_t j = begin; j < end; ++j) {
-              if (out[j] < p[j])
-                out[j] = p[j];
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceRK(MlasReduceMaximum, input, fast_shape, output, tp);
+    } else {
+      int64_t n_rows = fast_shape[0];
+      int64_t N = fast_shape[1];
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+      memcpy(out, data, N * sizeof(T));
+
+      concurrency::ThreadPool::TryParallelFor(
+          tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+          [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+            const T* p;
+            for (int64_t row = 1; row < n_rows; ++row) {
+              p = data + row * N;
+              for (int64_t j = begin; j < end; ++j) {
+                if (out[j] < p[j])
+                  out[j] = p[j];
+              }
             }
-          }
-        });
+          });
+    }
   }
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            EigenVectorMap<T>(out + j * strideo, strideo) =
-                ConstEigenMatrixMap<T>(
-                    data + j * stridei, fast_shape[2], fast_shape[1])
-                    .rowwise()
-                    .maxCoeff();
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceKRK(MlasReduceMaximum, input, fast_shape, output, tp);
+    } else {
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+      int64_t stridei = fast_shape[1] * fast_shape[2];
+      int64_t strideo = fast_shape[2];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
+          [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
+            for (ptrdiff_t j = begin; j < end; ++j) {
+              EigenVectorMap<T>(out + j * strideo, strideo) =
+                  ConstEigenMatrixMap<T>(
+                      data + j * stridei, fast_shape[2], fast_shape[1])
+                      .rowwise()
+                      .maxCoeff();
+            }
+          });
+    }
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -550,60 +664,74 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
     return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
   }
 
+  static inline bool IsFastReduceVectorized() { return std::is_same<T, float>::value; }
+
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
-          EigenVectorMap<T>(out + first, last - first) = ConstEigenMatrixMap<T>(
-                                                             data + first * stridei, stridei, last - first)
-                                                             .colwise()
-                                                             .minCoeff();
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceKR(MlasReduceMinimum, input, fast_shape, output, tp);
+    } else {
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+      int64_t stridei = fast_shape[1];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+          [data, stridei, out](std::ptrdiff_t first, std::ptrdiff_t last) {
+            EigenVectorMap<T>(out + first, last - first) = ConstEigenMatrixMap<T>(
+                                                               data + first * stridei, stridei, last - first)
+                                                               .colwise()
+                                                               .minCoeff();
+          });
+    }
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t n_rows = fast_shape[0];
-    int64_t N = fast_shape[1];
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    memcpy(out, data, N * sizeof(T));
-
-    concurrency::ThreadPool::TryParallelFor(
-        tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
-        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
-          const T* p;
-          for (int64_t row = 1; row < n_rows; ++row) {
-            p = data + row * N;
-            for (int64_t j = begin; j < end; ++j) {
-              if (out[j] > p[j])
-                out[j] = p[j];
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceRK(MlasReduceMinimum, input, fast_shape, output, tp);
+    } else {
+      int64_t n_rows = fast_shape[0];
+      int64_t N = fast_shape[1];
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+      memcpy(out, data, N * sizeof(T));
+
+      concurrency::ThreadPool::TryParallelFor(
+          tp, N, ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+          [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+            const T* p;
+            for (int64_t row = 1; row < n_rows; ++row) {
+              p = data + row * N;
+              for (int64_t j = begin; j < end; ++j) {
+                if (out[j] > p[j])
+                  out[j] = p[j];
+              }
             }
-          }
-        });
+          });
+    }
   }
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
-            EigenVectorMap<T>(out + j * strideo, strideo) =
-                ConstEigenMatrixMap<T>(
-                    data + j * stridei, fast_shape[2], fast_shape[1])
-                    .rowwise()
-                    .minCoeff();
-          }
-        });
+    if constexpr (std::is_same<T, float>::value) {
+      VectorizedFastReduceKRK(MlasReduceMinimum, input, fast_shape, output, tp);
+    } else {
+      const T* data = input.Data<T>();
+      T* out = output.MutableData<T>();
+      int64_t stridei = fast_shape[1] * fast_shape[2];
+      int64_t strideo = fast_shape[2];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
+          [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
+            for (ptrdiff_t j = begin; j < end; ++j) {
+              EigenVectorMap<T>(out + j * strideo, strideo) =
+                  ConstEigenMatrixMap<T>(
+                      data + j * stridei, fast_shape[2], fast_shape[1])
+                      .rowwise()
+                      .minCoeff();
+            }
+          });
+    }
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -648,6 +776,38 @@ class ReduceAggregatorL2 : public ReduceAggregator<T, T> {
   }
   inline void update(const T& v) { this->accumulator_ += v * v; }
   inline T get_value() { return reduce_sqrt<T>(this->accumulator_); }
+
+  // Fast reduction, float only: the sum of squares followed by the square root.
+  static inline FastReduceKind WhichFastReduce() {
+    return std::is_same<T, float>::value ? FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK
+                                         : FastReduceKind::kNone;
+  }
+
+  static inline bool IsFastReduceVectorized() { return std::is_same<T, float>::value; }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceKR(MlasReduceSumSquare, input, fast_shape, output, tp);
+    ComputeSqrt(output);
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceRK(MlasReduceSumSquare, input, fast_shape, output, tp);
+    ComputeSqrt(output);
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceKRK(MlasReduceSumSquare, input, fast_shape, output, tp);
+    ComputeSqrt(output);
+  }
+
+ private:
+  static void ComputeSqrt(Tensor& output) {
+    EigenVectorArrayMap<float> values(output.MutableData<float>(), output.Shape().Size());
+    values = values.sqrt();
+  }
 };
 
 template <typename T>
@@ -682,33 +842,61 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, T> {
   }
   inline void update(const T& v) { this->accumulator_ += reduce_exp(v - max_); }
   inline T get_value() { return reduce_log<T>(this->accumulator_) + max_; }
+
+  // Fast reduction, float only
+  static inline FastReduceKind WhichFastReduce() {
+    return std::is_same<T, float>::value ? FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK
+                                         : FastReduceKind::kNone;
+  }
+
+  static inline bool IsFastReduceVectorized() { return std::is_same<T, float>::value; }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceKR(MlasReduceLogSumExp, input, fast_shape, output, tp);
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceRK(MlasReduceLogSumExp, input, fast_shape, output, tp);
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    VectorizedFastReduceKRK(MlasReduceLogSumExp, input, fast_shape, output, tp);
+  }
 };
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  gsl::span<const int64_t> reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results);
 
+// `last_results` holds the results of NoTransposePrepareForReduce for new_input_shape and reduced_axes,
+// it is not used when all or no axes are reduced.
 template <typename AGG>
 void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
                             gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
-                            ResultsNoTransposePrepareForReduce& last_results);
+                            const ResultsNoTransposePrepareForReduce& last_results);
 
 // Specific case for ReduceLogSumExp.
 template <typename AGG>
 void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
                              gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
-                             ResultsNoTransposePrepareForReduce& last_results);
+                             const ResultsNoTransposePrepareForReduce& last_results);
 
+// `plan_cache` is the plan cache of the kernel, if any.
 template <typename AGG>
 void CommonReduce1Loop(OpKernelContext* ctx,
                        const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                       bool noop_with_empty_axes = false);
+                       bool noop_with_empty_axes = false,
+                       ReducePlanCache* plan_cache = nullptr);
 
 // Specific case for ReduceLogSumExp.
 template <typename AGG>
 void CommonReduce2Loops(OpKernelContext* ctx,
                         const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                        bool noop_with_empty_axes = false);
+                        bool noop_with_empty_axes = false,
+                        ReducePlanCache* plan_cache = nullptr);
 
 template <bool allow_multi_axes>
 class ReduceKernelBase {
@@ -743,6 +931,8 @@ template <bool allow_multi_axes>
 class ReduceKernel : public OpKernel, public ReduceKernelBase<allow_multi_axes> {
  protected:
   ReduceKernel(const OpKernelInfo& info) : OpKernel(info), ReduceKernelBase<allow_multi_axes>(info) {}
+
+  mutable ReducePlanCache plan_cache_;
 };
 
 template <typename T>
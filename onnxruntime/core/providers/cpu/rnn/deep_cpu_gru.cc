@@ -174,8 +174,8 @@ class UniDirectionalGru {
                     onnxruntime::concurrency::ThreadPool* ttp);
 
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
-               const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
-               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
+               const GemmWeights<T>& input_weights, const GemmWeights<T>& recurrent_weightsZR,
+               const GemmWeights<T>& recurrent_weightsH, gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   ~UniDirectionalGru() = default;
 
@@ -193,6 +193,10 @@ class UniDirectionalGru {
   Direction direction_;
   bool use_bias_;
 
+  // sigmoid/tanh activations with no clip. the bias is added to the input projection for all steps upfront,
+  // zt and rt are activated together and ht/Ht are calculated by deepcpu::gru_output_gate_tanh_fused.
+  bool use_fused_gates_;
+
   IAllocatorUniquePtr<T> outputZRH_ptr_;
   gsl::span<T> outputZRH_;
 
@@ -249,6 +253,154 @@ class UniDirectionalGru {
 #define DumpMatrix(...) ((void)0)
 #endif
 
+Status DeepCpuGruOp::TryPackInputWeights(const Tensor& weights, AllocatorPtr& alloc, bool& is_packed) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return Status::OK();
+  }
+
+  // weights: [num_directions, 3*hidden_size, input_size]
+  const size_t N = static_cast<size_t>(shape[1]);
+  const size_t K = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || (N != static_cast<size_t>(hidden_size_) * 3)) {
+    return Status::OK();
+  }
+
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K);
+  if (packed_weights_size == 0) {
+    return Status::OK();
+  }
+
+  size_t packed_weights_data_size = SafeInt<size_t>(packed_weights_size) * num_directions_;
+  auto* packed_weights_data = alloc->Alloc(packed_weights_data_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_weights_data, 0, packed_weights_data_size);
+
+  packed_W_.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
+  packed_W_.buffer_size_ = packed_weights_data_size;
+  packed_W_.weights_size_ = packed_weights_size;
+  packed_W_.shape_ = shape;
+
+  const auto* weights_data = weights.Data<float>();
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(CblasTrans, N, K, weights_data, K, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += N * K;
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::TryPackRecurrentWeights(const Tensor& weights, AllocatorPtr& alloc, bool& is_packed) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return Status::OK();
+  }
+
+  // recurrence weights: [num_directions, 3*hidden_size, hidden_size]
+  const size_t N = static_cast<size_t>(hidden_size_);
+  const size_t K = static_cast<size_t>(hidden_size_);
+
+  if ((shape[0] != num_directions_) || (static_cast<size_t>(shape[1]) != N * 3) ||
+      (static_cast<size_t>(shape[2]) != K)) {
+    return Status::OK();
+  }
+
+  // R[zr] and R[h] are packed separately so each can be used as the B matrix of its own GEMM
+  const size_t packed_zr_size = MlasGemmPackBSize(N * 2, K);
+  const size_t packed_h_size = MlasGemmPackBSize(N, K);
+  if (packed_zr_size == 0 || packed_h_size == 0) {
+    return Status::OK();
+  }
+
+  const size_t packed_weights_size = packed_zr_size + packed_h_size;
+  size_t packed_weights_data_size = SafeInt<size_t>(packed_weights_size) * num_directions_;
+  auto* packed_weights_data = alloc->Alloc(packed_weights_data_size);
+
+  // Initialize memory to 0 for the same reason as in TryPackInputWeights.
+  memset(packed_weights_data, 0, packed_weights_data_size);
+
+  packed_R_.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
+  packed_R_.buffer_size_ = packed_weights_data_size;
+  packed_R_.weights_size_ = packed_weights_size;
+  packed_R_.shape_ = shape;
+
+  const auto* weights_data = weights.Data<float>();
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(CblasTrans, N * 2, K, weights_data, K, packed_weights_data);
+    MlasGemmPackB(CblasTrans, N, K, weights_data + N * 2 * K, K,
+                  static_cast<uint8_t*>(packed_weights_data) + packed_zr_size);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += N * 3 * K;
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::PrePack(const Tensor& tensor, int input_idx,
+                             AllocatorPtr alloc, /*out*/ bool& is_packed,
+                             /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (tensor.IsDataType<float>()) {
+    PackedWeights* packed_weights = nullptr;
+    if (input_idx == 1) {
+      ORT_RETURN_IF_ERROR(TryPackInputWeights(tensor, alloc, is_packed));
+      packed_weights = &packed_W_;
+    } else if (input_idx == 2) {
+      ORT_RETURN_IF_ERROR(TryPackRecurrentWeights(tensor, alloc, is_packed));
+      packed_weights = &packed_R_;
+    }
+
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_weights->buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_weights->buffer_size_);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                               int input_idx,
+                                               /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == 2) {
+    used_shared_buffers = true;
+    packed_R_.buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+// R is packed per direction as R[zr] followed by R[h]. Set up the GemmWeights for each part.
+static void InitRecurrentWeights(int idx, const float* recurrent_weights, int hidden_size,
+                                 const PackedWeights& packed_R,
+                                 GemmWeights<float>& recurrent_weights_zr, GemmWeights<float>& recurrent_weights_h) {
+  const size_t recurrent_weights_size_per_direction = SafeInt<size_t>(hidden_size) * hidden_size * 3;
+  recurrent_weights_zr.Init(idx, recurrent_weights, recurrent_weights_size_per_direction, packed_R, nullptr);
+
+  recurrent_weights_h.is_prepacked_ = recurrent_weights_zr.is_prepacked_;
+  if (recurrent_weights_zr.is_prepacked_) {
+    recurrent_weights_h.buffer_ = static_cast<const uint8_t*>(recurrent_weights_zr.buffer_) +
+                                  MlasGemmPackBSize(static_cast<size_t>(hidden_size) * 2, hidden_size);
+  } else {
+    recurrent_weights_h.buffer_ = static_cast<const float*>(recurrent_weights_zr.buffer_) +
+                                  static_cast<size_t>(hidden_size) * hidden_size * 2;
+  }
+}
+
 Status DeepCpuGruOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -271,8 +423,13 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
 
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
-  const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 3*hidden_size, input_size]
-  const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context.Input<Tensor>(1);
+  // weights. [num_directions, 3*hidden_size, input_size]
+  const Tensor* R = packed_R_.buffer_ ? nullptr : context.Input<Tensor>(2);
+  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_.shape_;
 
   // optional
   const auto* B = context.Input<Tensor>(3);              // bias. [num_directions, 6*hidden_size]
@@ -285,7 +442,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   int batch_size = gsl::narrow<int>(X_shape[1]);
   int input_size = gsl::narrow<int>(X_shape[2]);
 
-  auto status = ValidateCommonRnnInputs(X, W.Shape(), R.Shape(), B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
+  auto status = ValidateCommonRnnInputs(X, W_shape, R_shape, B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
   ORT_RETURN_IF_ERROR(status);
 
   // GRU outputs are optional but must be in the same order
@@ -308,17 +465,19 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  const T* input_weights = (W != nullptr) ? W->Data<T>() : nullptr;
+  const T* recurrent_weights = (R != nullptr) ? R->Data<T>() : nullptr;
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
   const size_t input_weights_size_per_direction = 3 * hidden_size_ * input_size;
-  const size_t recurrent_weights_size_per_direction = 3 * hidden_size_ * hidden_size_;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
+  GemmWeights<T> input_weights_1(0, input_weights, input_weights_size_per_direction, packed_W_);
+  GemmWeights<T> recurrent_weights_zr_1;
+  GemmWeights<T> recurrent_weights_h_1;
+  InitRecurrentWeights(0, recurrent_weights, hidden_size_, packed_R_, recurrent_weights_zr_1, recurrent_weights_h_1);
+
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -352,11 +511,11 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   gsl::span<T> hidden_output_1 = hidden_output.subspan(0, hidden_output_size_per_direction);
 
   if (direction_ == Direction::kBidirectional) {
-    // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> recurrent_weights_2 = recurrent_weights.subspan(recurrent_weights_size_per_direction,
-                                                                       recurrent_weights_size_per_direction);
+    // weights and spans for second direction
+    GemmWeights<T> input_weights_2(1, input_weights, input_weights_size_per_direction, packed_W_);
+    GemmWeights<T> recurrent_weights_zr_2;
+    GemmWeights<T> recurrent_weights_h_2;
+    InitRecurrentWeights(1, recurrent_weights, hidden_size_, packed_R_, recurrent_weights_zr_2, recurrent_weights_h_2);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
 
     gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
@@ -375,24 +534,24 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
                                     activation_funcs_.Entries()[0],
                                     activation_funcs_.Entries()[1],
                                     clip_, thread_pool);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-               output_1, hidden_output_1);
+    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_zr_1,
+               recurrent_weights_h_1, output_1, hidden_output_1);
 
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kReverse, bias_2, initial_hidden_2,
                                     activation_funcs_.Entries()[2],
                                     activation_funcs_.Entries()[3],
                                     clip_, thread_pool);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2,
-               output_2, hidden_output_2);
+    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_zr_2,
+               recurrent_weights_h_2, output_2, hidden_output_2);
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
                                        linear_before_reset_ != 0, direction_, bias_1, initial_hidden_1,
                                        activation_funcs_.Entries()[0],
                                        activation_funcs_.Entries()[1],
                                        clip_, thread_pool);
-    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-                  output_1, hidden_output_1);
+    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_zr_1,
+                  recurrent_weights_h_1, output_1, hidden_output_1);
   }
 
   if (!output.empty())
@@ -442,6 +601,9 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
   h_alpha_ = activation_func_g.alpha;
   h_beta_ = activation_func_g.beta;
 
+  use_fused_gates_ = activation_func_f.name == "sigmoid" && activation_func_g.name == "tanh" &&
+                     clip_ == std::numeric_limits<float>::max();
+
   AllocateBuffers();
 
   if (use_bias_) {
@@ -491,8 +653,9 @@ template <typename T>
 void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const gsl::span<const int>& sequence_lengths_arg,
                                    const int num_directions,
-                                   const gsl::span<const T>& input_weights,
-                                   const gsl::span<const T>& recurrent_weights,
+                                   const GemmWeights<T>& input_weights,
+                                   const GemmWeights<T>& recurrent_weightsZR,
+                                   const GemmWeights<T>& recurrent_weightsH,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -509,11 +672,6 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 
   DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-  DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-  DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
-
-  gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
-  gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
 
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
@@ -543,11 +701,21 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   // apply weights to all the inputs
   ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
               inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, 0.f,
+              input_weights, 0.f,
               outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3, ttp_);
+              hidden_size_x3, nullptr, nullptr, ttp_);
+
+  // with the fused gates the bias is added once here for every step instead of inside the per step gate math.
+  // Rbh is still added to Ht-1 * (Rh^T) if linear_before_reset_ is set.
+  if (use_fused_gates_ && use_bias_) {
+    const T* p_bias_h = linear_before_reset_ ? batched_bias_Wh_.data() : batched_bias_WRh_.data();
+    for (int r = 0; r < total_rows; r++) {
+      T* p_zrh = SafeRawPointer<T>(outputZRH_, r * hidden_size_x3, hidden_size_x3);
+      deepcpu::add_bias_into(batched_bias_WRz_.data(), p_zrh, hidden_size_);
+      deepcpu::add_bias_into(batched_bias_WRr_.data(), p_zrh + hidden_size_, hidden_size_);
+      deepcpu::add_bias_into(p_bias_h, p_zrh + hidden_size_x2, hidden_size_);
+    }
+  }
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -613,11 +781,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
       ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
                   prev_Ht, prev_Ht_end,
-                  hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                  hidden_size_, 1.f,  // beta == 1 so we add existing values in outputZRH_
+                  recurrent_weightsZR,
+                  1.f,  // beta == 1 so we add existing values in outputZRH_
                   outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                  hidden_size_x3, ttp_);
+                  hidden_size_x3, nullptr, nullptr, ttp_);
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -633,19 +800,35 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         // compute Ht-1 * (Rh^T) + Rbh
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     prev_Ht, prev_Ht_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_,
+                    recurrent_weightsH,    // Rh^T
                     use_bias_ ? 1.f : 0.f,  // don't add values in linear_output_ if no bias input
                     linear_output_.begin(),
                     linear_output_.end(),  // pre: Rbh if use_bias_, post:output
-                    hidden_size_, ttp_);
+                    hidden_size_, nullptr, nullptr, ttp_);
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
 
       // 1st Set Of Activations
       for (int r = 0; r < batch_size_; r++) {
+        if (use_fused_gates_) {
+          // zt and rt are adjacent and already include the bias so calculate both in one call
+          T* p_zt = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_x2);
+          MlasComputeLogistic(p_zt, p_zt, static_cast<size_t>(hidden_size_x2));
+
+          const T* p_rt = p_zt + hidden_size_;
+          const T* p_reset_input =
+              linear_before_reset_ ? SafeRawPointer<T>(linear_output_, r * hidden_size_, hidden_size_)
+                                   : SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
+
+          for (int h = 0; h < hidden_size_; ++h) {
+            p_cur_h[h] = p_rt[h] * p_reset_input[h];
+          }
+
+          continue;
+        }
+
         const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
                                                                batched_bias_WRr_local_end, hidden_size_)
                                       : nullptr;
@@ -706,11 +889,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                     cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, 1.f,                                       // beta == 1 to add Xt*(Wh^T) from out_H
+                    recurrent_weightsH,            // Rh^T
+                    1.f,                           // beta == 1 to add Xt*(Wh^T) from out_H
                     out_H, outputZRH_.end(),
-                    hidden_size_x3, ttp_);
+                    hidden_size_x3, nullptr, nullptr, ttp_);
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
@@ -740,6 +922,17 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           continue;
         }
 
+        if (use_fused_gates_) {
+          // zt was calculated with rt, and p_ht already includes the bias
+          const T* p_zt = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_);
+          T* p_ht = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_x2, hidden_size_);
+          const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+          T* p_Ht = SafeRawPointer<T>(output + r * hidden_size_, output_end, hidden_size_);
+
+          deepcpu::gru_output_gate_tanh_fused(p_ht, p_zt, p_prev_Ht, p_Ht, hidden_size_);
+          continue;
+        }
+
         const T* p_bias_z = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRz_local,
                                                                batched_bias_WRz_local_end, hidden_size_)
                                       : nullptr;
@@ -55,6 +55,14 @@ class DeepCpuGruOp final : public OpKernel {
         "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuGruOp() override = default;
@@ -70,6 +78,14 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W is packed as one [3*hidden_size, input_size] matrix per direction. R is packed per direction as R[zr]
+  // followed by R[h] as they are used in separate GEMMs.
+  rnn::detail::PackedWeights packed_W_;
+  rnn::detail::PackedWeights packed_R_;
+
+  Status TryPackInputWeights(const Tensor& weights, AllocatorPtr& alloc, bool& is_packed);
+  Status TryPackRecurrentWeights(const Tensor& weights, AllocatorPtr& alloc, bool& is_packed);
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 };
@@ -650,6 +650,35 @@ void gru_output_gate_relu(float* ph, const float* pz, const float* ps, float* po
   }
 }
 
+void lstm_gates_sigmoid_tanh(float* piofc, float* restrict pC, float* restrict ptmp, float* restrict pH, int c) {
+  const float* pi = piofc;
+  const float* po = piofc + c;
+  const float* pf = piofc + 2 * c;
+  float* pg = piofc + 3 * c;
+
+  // i, o and f are adjacent so a single call computes all three sigmoid gates
+  MlasComputeLogistic(piofc, piofc, static_cast<size_t>(3) * c);
+  MlasComputeTanh(pg, pg, c);
+
+  for (int i = 0; i < c; i++) {
+    pC[i] = pC[i] * pf[i] + pi[i] * pg[i];
+  }
+
+  MlasComputeTanh(pC, ptmp, c);
+
+  for (int i = 0; i < c; i++) {
+    pH[i] = po[i] * ptmp[i];
+  }
+}
+
+void gru_output_gate_tanh_fused(float* ph, const float* pz, const float* ps, float* po, int c) {
+  MlasComputeTanh(ph, ph, c);
+
+  for (int i = 0; i < c; i++) {
+    po[i] = (1 - pz[i]) * ph[i] + pz[i] * ps[i];
+  }
+}
+
 void gru_output_gate_composed(float* ph, const float* pz, const float* ps, float* po, int c,
                               std::function<float(float, float, float)> func, float alpha, float beta) {
   for (int i = 0; i < c; i++) {
@@ -351,6 +351,16 @@ void gru_output_gate_tanh(float* ph, const float* pz, const float* ps, float* po
 void gru_output_gate_sigmoid(float* ph, const float* pz, const float* ps, float* po, int c, float alpha, float beta);
 void gru_output_gate_relu(const float* ph, const float* pz, const float* ps, float* po, int c, float alpha, float beta);
 
+// Fused gate math for the default activations (sigmoid for the gates, tanh for the cell/hidden input) with no clip.
+// The inputs must already include the bias and the whole gate row is processed with the MLAS vector activations.
+//
+// piofc holds the [i, o, f, c] pre-activations of one row (4 * c values) and is overwritten with the activations.
+// pC holds Ct-1 on input and Ct on output. ptmp is scratch space for tanh(Ct). pH receives Ht.
+void lstm_gates_sigmoid_tanh(float* piofc, float* pC, float* ptmp, float* pH, int c);
+// ph holds the input to calculate ht and is overwritten with ht. pz holds zt (already activated).
+// po receives Ht = (1 - zt) (.) ht + zt (.) Ht-1 where ps is Ht-1. po may be the same buffer as ps.
+void gru_output_gate_tanh_fused(float* ph, const float* pz, const float* ps, float* po, int c);
+
 inline void elementwise_product(const float* op1, const float* op2, float* dest, int size) {
   for (int i = 0; i < size; i++)
     dest[i] += op1[i] * op2[i];
@@ -3,6 +3,8 @@
 
 #include "uni_directional_lstm.h"
 
+#include <limits>
+
 #include "core/platform/threadpool.h"
 //TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -73,6 +75,10 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+  use_fused_gates_ = activation_func_f.name == "sigmoid" && activation_func_g.name == "tanh" &&
+                     activation_func_h.name == "tanh" && clip_ == std::numeric_limits<float>::max() &&
+                     !use_peepholes_ && !input_forget_;
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -285,6 +291,17 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
               nullptr,
               thread_pool_);
 
+  // with the fused gates the bias is added once here for every step instead of inside the per step gate math
+  if (use_fused_gates_ && use_bias_) {
+    for (int r = 0; r < total_rows; r++) {
+      float* p_iofc = SafeRawPointer<T>(output_iofc_, r * hidden_size_x4, hidden_size_x4);
+      deepcpu::add_bias_into(bias_WRi_.data(), p_iofc, hidden_size_);
+      deepcpu::add_bias_into(bias_WRo_.data(), p_iofc + hidden_size_, hidden_size_);
+      deepcpu::add_bias_into(bias_WRf_.data(), p_iofc + 2 * hidden_size_, hidden_size_);
+      deepcpu::add_bias_into(bias_WRc_.data(), p_iofc + 3 * hidden_size_, hidden_size_);
+    }
+  }
+
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
   beta = 1.0f;  // calls to ComputeGemm now add to existing data
@@ -453,6 +470,16 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // check that we have hidden_size_x4 left starting at cur_out + b * hidden_size_x4, and get a raw pointer to that
     float* pi = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4);
+
+    if (use_fused_gates_) {
+      float* pC = SafeRawPointer<T>(C_prev + b * hidden_size_, C_prev_end, hidden_size_);
+      float* pC_tmp = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_, C_prev_clipped_end, hidden_size_);
+      float* pH =
+          SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+      deepcpu::lstm_gates_sigmoid_tanh(pi, pC, pC_tmp, pH, hidden_size_);
+      continue;
+    }
+
     float* po = pi + hidden_size_;
     float* pf = po + hidden_size_;
     float* pc = pf + hidden_size_;
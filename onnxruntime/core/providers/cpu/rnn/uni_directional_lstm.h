@@ -75,6 +75,10 @@ class UniDirectionalLstm {
   bool use_bias_;
   bool use_peepholes_;
 
+  // sigmoid/tanh/tanh activations with no clip, peepholes or input_forget. the bias is added to the
+  // input projection for all steps upfront and the gate math runs through deepcpu::lstm_gates_sigmoid_tanh.
+  bool use_fused_gates_;
+
   int num_threads_ = -1;
 
   IAllocatorUniquePtr<T> output_iofc_ptr_;
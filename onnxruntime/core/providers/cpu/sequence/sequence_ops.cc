@@ -15,8 +15,9 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
-// TODO: The current implementation of sequence ops relies on tensor copies. Ideally we should try to avoid
-// these copies. This has been postponed due to lack of time.
+// The tensors of a sequence are never modified, so the sequence ops share the tensors of their input sequences with
+// their output sequences. Input tensors are still copied, as the buffers of tensors that are not in a sequence can be
+// reused by the allocation planner once their last consumer has run.
 
 // SequenceLength
 ONNX_CPU_OPERATOR_KERNEL(
@@ -218,23 +219,21 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
 
   auto* Y = context->Output<TensorSeq>(0);
 
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_tensors_input_seq + 1);
+  std::vector<Tensor> inserted;
+  ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, inserted));
+
+  Y->SetType(S->DataType());
+  Y->Reserve(num_tensors_input_seq + 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
-    } else {
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
+      Y->Add(std::move(inserted.front()));
     }
+    Y->Add(S->GetOrtValue(i));
   }
   if (input_seq_idx == num_tensors_input_seq) {
-    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
+    Y->Add(std::move(inserted.front()));
   }
 
-  Y->SetType(S->DataType());
-  Y->SetElements(std::move(tensors));
-
   return Status::OK();
 }
 
@@ -270,15 +269,13 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   auto* Y = context->Output<TensorSeq>(0);
   Y->SetType(S->DataType());
 
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_tensors_input_seq - 1);
+  Y->Reserve(num_tensors_input_seq - 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
       continue;
     }
-    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
+    Y->Add(S->GetOrtValue(i));
   }
-  Y->SetElements(std::move(tensors));
   return Status::OK();
 }
 
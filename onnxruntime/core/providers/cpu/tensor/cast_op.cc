@@ -22,9 +22,7 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
 #include "core/mlas/inc/mlas.h"
-#endif
 
 namespace onnxruntime {
 
@@ -213,54 +211,75 @@ struct TensorCaster<std::string, DstType> {
   }
 };
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
+// specializations to use the vectorized MLAS conversions between the float16 types and float
+
+template <typename HalfType>
+constexpr MLAS_HALF_GEMM_TYPE MlasHalfType() {
+  return std::is_same<HalfType, MLFloat16>::value ? MlasHalfGemmFloat16 : MlasHalfGemmBFloat16;
+}
+
+template <typename HalfType>
+void CastHalfToFloat(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) {
+  const size_t shape_size = gsl::narrow<size_t>(shape.Size());
+  MlasConvertHalfToFloat(MlasHalfType<HalfType>(), reinterpret_cast<const uint16_t*>(in.Data<HalfType>()),
+                         out.MutableData<float>(), shape_size, context.GetOperatorThreadPool());
+}
+
+template <typename HalfType>
+void CastFloatToHalf(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) {
+  const size_t shape_size = gsl::narrow<size_t>(shape.Size());
+  MlasConvertFloatToHalf(MlasHalfType<HalfType>(), in.Data<float>(),
+                         reinterpret_cast<uint16_t*>(out.MutableData<HalfType>()), shape_size,
+                         context.GetOperatorThreadPool());
+}
 
 // tensor MLFloat16 -> float
 template <>
 struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = gsl::narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastHalfToFloat<MLFloat16>(context, shape, in, out);
   }
 };
 
-Tensor GetIntermediateMLFloat16ToFloatTensor(
-    const OpKernelContext& context, const TensorShape& shape, const Tensor& in) {
-  AllocatorPtr allocator;
-  ORT_THROW_IF_ERROR(context.GetTempSpaceAllocator(&allocator));
-  Tensor out{DataTypeImpl::GetType<float>(), shape, allocator};
-  TensorCaster<MLFloat16, float>{}.Cast(context, shape, in, out);
-  return out;
-}
-
-template <typename DstType>
-void CastMLFloat16ThroughFloatTensor(
-    const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) {
-  // use optimized MLFloat16 -> float, then float -> DstType
-  Tensor intermediate_tensor = GetIntermediateMLFloat16ToFloatTensor(context, shape, in);
-  TensorCaster<float, DstType>{}.Cast(context, shape, intermediate_tensor, out);
-}
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastHalfToFloat<BFloat16>(context, shape, in, out);
+  }
+};
 
-// tensor MLFloat16 -> X
-template <typename DstType>
-struct TensorCaster<MLFloat16, DstType> {
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
   void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    CastMLFloat16ThroughFloatTensor<DstType>(context, shape, in, out);
+    CastFloatToHalf<MLFloat16>(context, shape, in, out);
   }
 };
 
-// tensor MLFloat16 -> string
+// tensor float -> BFloat16
 template <>
-struct TensorCaster<MLFloat16, std::string> {
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastFloatToHalf<BFloat16>(context, shape, in, out);
+  }
+};
+
+// tensor MLFloat16/BFloat16 -> X, other than float and string
+template <typename SrcType, typename DstType>
+struct TensorCaster<SrcType, DstType,
+                    std::enable_if_t<IsOrtFloat16Type<SrcType>::value &&
+                                     !std::is_same<DstType, float>::value &&
+                                     !std::is_same<DstType, std::string>::value>> {
   void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
+    // use the vectorized conversion to float, then float -> DstType
+    AllocatorPtr allocator;
+    ORT_THROW_IF_ERROR(context.GetTempSpaceAllocator(&allocator));
+    Tensor intermediate_tensor{DataTypeImpl::GetType<float>(), shape, allocator};
+    CastHalfToFloat<SrcType>(context, shape, in, intermediate_tensor);
+    TensorCaster<float, DstType>{}.Cast(context, shape, intermediate_tensor, out);
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
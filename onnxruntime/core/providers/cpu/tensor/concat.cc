@@ -11,11 +11,28 @@
 
 namespace onnxruntime {
 
+namespace {
+#ifdef ENABLE_TRAINING
+// Concat copies its inputs with a strided copy, so they may be strided views e.g. the output of Slice.
+// The kernel def lists the inputs accepting strided tensors by index, which covers the usual small input counts.
+constexpr int kMaxStridedInputs = 8;
+#endif
+
+KernelDefBuilder& AllowStridedInputs(KernelDefBuilder& builder) {
+#ifdef ENABLE_TRAINING
+  for (int i = 0; i < kMaxStridedInputs; ++i) {
+    builder.MayStridedInput(i);
+  }
+#endif
+  return builder;
+}
+}  // namespace
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Concat,
     4,
     10,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    AllowStridedInputs(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes())),
     Concat);
 
 // Opset 11 starts to support Neg Axis.
@@ -23,14 +40,14 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Concat,
     11,
     12,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    AllowStridedInputs(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes())),
     Concat);
 
 // Opset 13 .
 ONNX_CPU_OPERATOR_KERNEL(
     Concat,
     13,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    AllowStridedInputs(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes())),
     Concat);
 
 namespace op_kernel_type_control {
@@ -240,6 +240,101 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
 #pragma GCC diagnostic pop
 #endif
 
+// GatherElements of a fixed size element type, T being an unsigned integer type of the size of the elements.
+// The rows of the indices along the innermost axis are processed in parallel. The offset of a row in the input is
+// computed once, and the elements of the row are copied in a loop on the element type, which along the innermost
+// axis is a plain gather the compiler can vectorize.
+template <typename T, typename Tin>
+static void GatherElementsTyped(const Tensor* input_tensor, const Tensor* indices_tensor,
+                                Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
+  const T* input_data = reinterpret_cast<const T*>(input_tensor->DataRaw());
+  T* output_data = reinterpret_cast<T*>(output_tensor->MutableDataRaw());
+  const Tin* indices_data = indices_tensor->Data<Tin>();
+
+  const auto& input_shape = input_tensor->Shape();
+  const TensorShape& indices_shape = indices_tensor->Shape();
+  const int64_t rank = static_cast<int64_t>(input_shape.NumDimensions());
+  const TensorPitches input_shape_pitches(*input_tensor);
+
+  const int64_t axis_dim = input_shape[axis];
+  const int64_t axis_pitch = input_shape_pitches[axis];
+  const int64_t num_rows = calculate_num_inner_dim(indices_shape);
+  const int64_t row_size = indices_shape[rank - 1];
+  const bool processing_inner_dim = axis == rank - 1;
+
+  concurrency::ThreadPool::TryParallelFor(
+      ttp, num_rows, static_cast<double>(row_size * sizeof(T)),
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        for (ptrdiff_t row = first; row < last; ++row) {
+          // offset of the row in the input, without the axis
+          int64_t base_offset = 0;
+          int64_t remaining = row;
+          for (int64_t i = rank - 2; i >= 0; --i) {
+            const int64_t coordinate = remaining % indices_shape[i];
+            remaining /= indices_shape[i];
+            if (i != axis) {
+              base_offset += coordinate * input_shape_pitches[i];
+            }
+          }
+
+          const T* input_row = input_data + base_offset;
+          const Tin* indices_row = indices_data + row * row_size;
+          T* output_row = output_data + row * row_size;
+
+          if (processing_inner_dim) {
+            for (int64_t j = 0; j < row_size; ++j) {
+              const int64_t index = indices_row[j] < 0 ? indices_row[j] + axis_dim : indices_row[j];
+              output_row[j] = input_row[index];
+            }
+          } else {
+            for (int64_t j = 0; j < row_size; ++j) {
+              const int64_t index = indices_row[j] < 0 ? indices_row[j] + axis_dim : indices_row[j];
+              output_row[j] = input_row[index * axis_pitch + j];
+            }
+          }
+        }
+      });
+}
+
+template <typename Tin>
+static bool TryGatherElementsTyped(const Tensor* input_tensor, const Tensor* indices_tensor,
+                                   Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
+  switch (input_tensor->DataType()->Size()) {
+    case sizeof(uint8_t):
+      GatherElementsTyped<uint8_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      return true;
+    case sizeof(uint16_t):
+      GatherElementsTyped<uint16_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      return true;
+    case sizeof(uint32_t):
+      GatherElementsTyped<uint32_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      return true;
+    case sizeof(uint64_t):
+      GatherElementsTyped<uint64_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename Tin>
+static Status ValidateIndices(const Tensor* indices_tensor, int64_t axis_dim) {
+  const Tin* indices_data = indices_tensor->Data<Tin>();
+  const int64_t num_elements = indices_tensor->Shape().Size();
+  const int64_t lower_index_limit = -axis_dim;
+  const int64_t upper_index_limit = axis_dim - 1;
+
+  for (int64_t i = 0; i < num_elements; ++i) {
+    const int64_t indices_val = indices_data[i];
+    if (indices_val < lower_index_limit || indices_val > upper_index_limit)
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "GatherElements op: Value in indices must be within bounds [",
+                             lower_index_limit, " , ", upper_index_limit, "]. Actual value is ", indices_val);
+  }
+
+  return Status::OK();
+}
+
 Status GatherElements::ValidateInputShapes(const TensorShape& input_data_shape,
                                            const TensorShape& indices_shape,
                                            int64_t axis) {
@@ -304,10 +399,13 @@ Status GatherElements::Compute(OpKernelContext* context) const {
       core_impl<true, std::string, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
     else
       core_impl<true, std::string, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
-  } else {
-    if (indices_tensor->IsDataType<int32_t>())
+  } else if (indices_tensor->IsDataType<int32_t>()) {
+    ORT_RETURN_IF_ERROR(ValidateIndices<int32_t>(indices_tensor, input_data_shape[axis]));
+    if (!TryGatherElementsTyped<int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp))
       core_impl<false, int8_t, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
-    else
+  } else {
+    ORT_RETURN_IF_ERROR(ValidateIndices<int64_t>(indices_tensor, input_data_shape[axis]));
+    if (!TryGatherElementsTyped<int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp))
       core_impl<false, int8_t, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
   }
 
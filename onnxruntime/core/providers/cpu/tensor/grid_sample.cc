@@ -97,23 +97,29 @@ T GsBicubicInterpolate(T p[4][4], float x, float y) {
   return static_cast<T>(coeffs[0] * v[0] + coeffs[1] * v[1] + coeffs[2] * v[2] + coeffs[3] * v[3]);
 }
 
+// Offset of the pixel at grid location (r, c) of an image after padding, or -1
+// if the location is in the zero padding.
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
-  T pixel = {};  // default 0
+int64_t GridSample<T>::IndexAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
   if (padding_mode_ == Zeros) {
     if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
+      return r * W + c;
     }
+    return -1;
   } else if (padding_mode_ == Border) {
     c = std::clamp<int64_t>(c, 0, W - 1);
     r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
   } else {  // (padding_mode_ == Reflection)
     c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
     r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
   }
-  return pixel;
+  return r * W + c;
+}
+
+template <typename T>
+T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
+  const int64_t index = IndexAtGrid(r, c, H, W, border);
+  return index >= 0 ? image[index] : T{};  // default 0
 }
 
 // When grid sampling, padding is applied before interpolation.
@@ -168,80 +174,137 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
   }
   float border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
 
-  concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-  for (int64_t n = 0; n < N; n++) {
-    const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, C,
-        [&](std::ptrdiff_t c) {
-          const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
-          T* Y_data = Y.MutableData<T>() + (n * C + c) * (H_out * W_out);
-
-          for (int64_t oy = 0; oy < H_out; oy++) {
-            for (int64_t ox = 0; ox < W_out; ox++) {
-              const T* gridpoint = grid_data + (oy * W_out + ox) * 2;
-              T* Y_gridpoint = Y_data + oy * W_out + ox;
-              auto nx = gridpoint[0];  // normalized location
-              auto ny = gridpoint[1];
-              auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-              auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-
-              if (mode_ == Nearest) {
-                x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
-                y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
-              }
+  // Denormalizes the location of a grid point and applies the padding to the locations outside of the image.
+  auto sample_location = [&](const T* gridpoint, T& x, T& y) {
+    auto nx = gridpoint[0];  // normalized location
+    auto ny = gridpoint[1];
+    x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
+    y = GsDenormalize<T>(ny, H_in, align_corners_);
 
-              if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
-                if (padding_mode_ == Border) {
-                  // use original border in both align_corner cases
-                  x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
-                  y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
-                } else if (padding_mode_ == Reflection) {
-                  x = GsReflect(x, x_min, x_max);
-                  y = GsReflect(y, y_min, y_max);
-                }
-              }  // out of bound
+    if (mode_ == Nearest) {
+      x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
+      y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
+    }
 
-              if (mode_ == Nearest) {
-                // x, y are integers in all padding modes
-                *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                continue;
-              }
+    if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
+      if (padding_mode_ == Border) {
+        // use original border in both align_corner cases
+        x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
+        y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
+      } else if (padding_mode_ == Reflection) {
+        x = GsReflect(x, x_min, x_max);
+        y = GsReflect(y, y_min, y_max);
+      }
+    }  // out of bound
+  };
 
-              if (mode_ == Bilinear) {
-                int64_t x1 = static_cast<int64_t>(std::floor(x));
-                int64_t y1 = static_cast<int64_t>(std::floor(y));
-                int64_t x2 = x1 + 1;
-                int64_t y2 = y1 + 1;
-
-                T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                T dx2 = static_cast<T>(x2) - x;
-                T dx1 = x - static_cast<T>(x1);
-                T dy2 = static_cast<T>(y2) - y;
-                T dy1 = y - static_cast<T>(y1);
-                *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-              }
-              if (mode_ == Bicubic) {
-                int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-                T p[4][4] = {};  // [H][W]
-                for (int64_t h = 0; h < 4; h++) {
-                  for (int64_t w = 0; w < 4; w++) {
-                    p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                  }
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  const int64_t output_size = H_out * W_out;
+  const T* grid_data = grid->Data<T>();
+  const T* input_data = input->Data<T>();
+  T* output_data = Y.MutableData<T>();
+
+  if (mode_ == Bicubic) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(N * C), static_cast<double>(output_size * 64),
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t nc = first; nc < last; nc++) {
+            const T* X_data = input_data + nc * (H_in * W_in);
+            const T* gridpoint = grid_data + (nc / C) * output_size * 2;
+            T* Y_data = output_data + nc * output_size;
+
+            for (int64_t i = 0; i < output_size; i++, gridpoint += 2) {
+              T x;
+              T y;
+              sample_location(gridpoint, x, y);
+
+              int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+              int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
+              T p[4][4] = {};  // [H][W]
+              for (int64_t h = 0; h < 4; h++) {
+                for (int64_t w = 0; w < 4; w++) {
+                  p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
                 }
-                T dx = static_cast<T>(x - x0 - 1);
-                T dy = static_cast<T>(y - y0 - 1);
-                *Y_gridpoint = GsBicubicInterpolate(p, static_cast<float>(dx), static_cast<float>(dy));
               }
+              T dx = static_cast<T>(x - x0 - 1);
+              T dy = static_cast<T>(y - y0 - 1);
+              Y_data[i] = GsBicubicInterpolate(p, static_cast<float>(dx), static_cast<float>(dy));
             }
           }
         });
+    return Status::OK();
   }
+
+  // The sampling locations are shared by all the channels of an image, so the input offsets of the nearest or the
+  // four bilinear neighbors and the bilinear weights (dx1, dx2, dy1, dy2) are computed once per grid point.
+  const int64_t taps = (mode_ == Bilinear) ? 4 : 1;
+  std::vector<int64_t> offsets(static_cast<size_t>(N * output_size * taps));
+  std::vector<T> weights(mode_ == Bilinear ? offsets.size() : 0);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(N * output_size), static_cast<double>(taps * 8),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; i++) {
+          T x;
+          T y;
+          sample_location(grid_data + i * 2, x, y);
+
+          int64_t* offset = offsets.data() + i * taps;
+          if (mode_ == Nearest) {
+            // x, y are integers in all padding modes
+            offset[0] = IndexAtGrid(static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
+            continue;
+          }
+
+          int64_t x1 = static_cast<int64_t>(std::floor(x));
+          int64_t y1 = static_cast<int64_t>(std::floor(y));
+          int64_t x2 = x1 + 1;
+          int64_t y2 = y1 + 1;
+
+          offset[0] = IndexAtGrid(y1, x1, H_in, W_in, border);
+          offset[1] = IndexAtGrid(y1, x2, H_in, W_in, border);
+          offset[2] = IndexAtGrid(y2, x1, H_in, W_in, border);
+          offset[3] = IndexAtGrid(y2, x2, H_in, W_in, border);
+
+          T* weight = weights.data() + i * 4;
+          weight[0] = x - static_cast<T>(x1);  // dx1
+          weight[1] = static_cast<T>(x2) - x;  // dx2
+          weight[2] = y - static_cast<T>(y1);  // dy1
+          weight[3] = static_cast<T>(y2) - y;  // dy2
+        }
+      });
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(N * C), static_cast<double>(output_size * taps * 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t nc = first; nc < last; nc++) {
+          const T* X_data = input_data + nc * (H_in * W_in);
+          const int64_t* offset = offsets.data() + (nc / C) * output_size * taps;
+          T* Y_data = output_data + nc * output_size;
+
+          if (mode_ == Nearest) {
+            for (int64_t i = 0; i < output_size; i++) {
+              Y_data[i] = offset[i] >= 0 ? X_data[offset[i]] : T{};
+            }
+            continue;
+          }
+
+          const T* weight = weights.data() + (nc / C) * output_size * 4;
+          for (int64_t i = 0; i < output_size; i++, offset += 4, weight += 4) {
+            T p11 = offset[0] >= 0 ? X_data[offset[0]] : T{};
+            T p12 = offset[1] >= 0 ? X_data[offset[1]] : T{};
+            T p21 = offset[2] >= 0 ? X_data[offset[2]] : T{};
+            T p22 = offset[3] >= 0 ? X_data[offset[3]] : T{};
+
+            const T dx1 = weight[0];
+            const T dx2 = weight[1];
+            const T dy1 = weight[2];
+            const T dy2 = weight[3];
+            Y_data[i] = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
+          }
+        }
+      });
+
   return Status::OK();
 }
 
@@ -53,6 +53,7 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
+  int64_t IndexAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const;
   T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const;
 
   GridSampleInterpolationMode mode_{Bilinear};
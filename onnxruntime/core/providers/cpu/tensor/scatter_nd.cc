@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -268,6 +270,12 @@ struct Func_Mul_ND<BFloat16> {
   }
 };
 
+static bool HasUniqueOffsets(const std::vector<uint64_t>& element_offsets) {
+  std::vector<uint64_t> sorted_offsets(element_offsets);
+  std::sort(sorted_offsets.begin(), sorted_offsets.end());
+  return std::adjacent_find(sorted_offsets.begin(), sorted_offsets.end()) == sorted_offsets.end();
+}
+
 template <typename TData>
 struct ScatterNDDispatchTarget {
   Status operator()(OpKernelContext* context, concurrency::ThreadPool* tp, ScatterND::Reduction reduction) const {
@@ -300,13 +308,23 @@ struct ScatterNDDispatchTarget {
         } break;
       }
     };
-    concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
-          }
-        });
+
+    // The slices can only be updated in parallel when no two indices address the same slice of the output,
+    // otherwise the updates of duplicated indices race with each other.
+    const auto offset_count = static_cast<ptrdiff_t>(prepare.element_offsets.size());
+    if (concurrency::ThreadPool::DegreeOfParallelism(tp) > 1 && HasUniqueOffsets(prepare.element_offsets)) {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, offset_count, static_cast<double>(prepare.element_to_copy),
+          [&lambda](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t i = first; i < last; ++i) {
+              lambda(i);
+            }
+          });
+    } else {
+      for (ptrdiff_t i = 0; i < offset_count; ++i) {
+        lambda(i);
+      }
+    }
     return Status::OK();
   }
 };
@@ -6,6 +6,7 @@
 #include <limits>
 #include <unordered_map>
 
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
@@ -40,37 +41,46 @@ using EnabledDataTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuExec
                                                                         Slice, Input, 0);
 using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuExecutionProvider, kOnnxDomain,
                                                                            Slice, Input, 1);
+
+// The output of Slice may be a strided view of the input, which the allocation planner chooses when all the
+// consumers of the output accept strided tensors.
+KernelDefBuilder& AllowStridedOutput(KernelDefBuilder& builder) {
+#ifdef ENABLE_TRAINING
+  builder.MayStridedOutput(0, 0);
+#endif
+  return builder;
+}
 }  // namespace
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    AllowStridedOutput(KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     10, 10,
-    KernelDefBuilder()
-        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+    AllowStridedOutput(KernelDefBuilder()
+                           .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+                           .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())),
     Slice10);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     11,
     12,
-    KernelDefBuilder()
-        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+    AllowStridedOutput(KernelDefBuilder()
+                           .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+                           .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())),
     Slice10);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Slice,
     13,
-    KernelDefBuilder()
-        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+    AllowStridedOutput(KernelDefBuilder()
+                           .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<DataTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+                           .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<IndicesTypes>(), BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())),
     Slice10);
 
 // Check if it's possible to combine innermost dimensions so we copy larger blocks.
@@ -260,6 +270,36 @@ static Status SliceImpl(OpKernelContext* ctx,
   return Status::OK();
 }
 
+#ifdef ENABLE_TRAINING
+// If the allocation planner shared the buffer of the input with the output, makes the output a view of the input
+// with the offset of the first sliced element and the strides scaled by the steps. No data is copied.
+// Returns false if the output has a buffer of its own and the data needs to be copied.
+static bool TrySliceAsView(OpKernelContext* ctx, const Tensor& input_tensor,
+                           const SliceOp::PrepareForComputeMetadata& compute_metadata) {
+  TensorShape output_shape(compute_metadata.output_dims_);
+  Tensor& output_tensor = *ctx->Output(0, output_shape);
+  if (output_tensor.DataRaw() != input_tensor.DataRaw()) {
+    return false;
+  }
+
+  // Slice does not accept strided inputs, so the input is contiguous
+  const auto input_strides = StridesForTensor(input_tensor);
+  TensorShapeVector output_strides(input_strides.size());
+  int64_t offset = 0;
+  for (size_t i = 0; i < input_strides.size(); ++i) {
+    offset += compute_metadata.starts_[i] * input_strides[i];
+    output_strides[i] = compute_metadata.steps_[i] * input_strides[i];
+  }
+
+  if (output_shape.Size() != 0) {
+    const auto element_size = static_cast<int64_t>(input_tensor.DataType()->Size());
+    output_tensor.SetByteOffset(output_tensor.ByteOffset() + static_cast<ptrdiff_t>(offset * element_size));
+  }
+  output_tensor.SetShapeAndStrides(output_shape, output_strides);
+  return true;
+}
+#endif
+
 template <typename EnabledTypes, typename T>
 static inline bool CallSliceImplIfEnabled(OpKernelContext* ctx,
                                           const Tensor& input_tensor,
@@ -302,6 +342,12 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
   }
 
+#ifdef ENABLE_TRAINING
+  if (TrySliceAsView(ctx, input_tensor, compute_metadata)) {
+    return Status::OK();
+  }
+#endif
+
   Status status = Status::OK();
 
   bool supported = false;
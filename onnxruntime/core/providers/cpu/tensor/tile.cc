@@ -9,7 +9,10 @@
 #pragma warning(disable : 4996)
 #endif
 
+#include <algorithm>
+
 #include "gsl/gsl"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/tile.h"
 #include "core/providers/cpu/tensor/utils.h"
 
@@ -99,6 +102,36 @@ Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tens
   return Status::OK();
 }
 
+namespace {
+// Size of the block that the first copies are doubled into before the rest of the output is filled in parallel.
+constexpr size_t kTileBlockBytes = 64 * 1024;
+
+// Fills data with num_copies copies of its first copy_bytes bytes, which hold the first copy.
+// The copied part is doubled until it reaches kTileBlockBytes, which turns many small copies into a few large
+// ones, and the rest of the data is filled with copies of that block in parallel.
+void ReplicateBytes(uint8_t* data, size_t copy_bytes, size_t num_copies, concurrency::ThreadPool* thread_pool) {
+  const size_t total_bytes = copy_bytes * num_copies;
+  size_t block_bytes = copy_bytes;
+  while (block_bytes < kTileBlockBytes && block_bytes < total_bytes) {
+    const size_t bytes = std::min(block_bytes, total_bytes - block_bytes);
+    memcpy(data + block_bytes, data, bytes);
+    block_bytes += bytes;
+  }
+
+  // block_bytes is a multiple of copy_bytes, so a partial block at the end still ends with a whole copy.
+  const size_t num_blocks = (total_bytes - block_bytes + block_bytes - 1) / block_bytes;
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_blocks),
+      TensorOpCost{static_cast<double>(block_bytes), static_cast<double>(block_bytes), 0},
+      [data, block_bytes, total_bytes](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const size_t start = block_bytes * (static_cast<size_t>(i) + 1);
+          memcpy(data + start, data, std::min(block_bytes, total_bytes - start));
+        }
+      });
+}
+}  // namespace
+
 namespace TileOp {
 // Find the first non-1 repeat and check the input shape to the left of that dimension:
 // 1) If the dim values to the left are all 1s (or don't exist), then the tiling logic is essentially copying the input buffer
@@ -193,41 +226,29 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
     ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
 
-    int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-    const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
+    uint8_t* output_data_casted = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
+    const uint8_t* input_data_casted = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
+    concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
     if (!is_batched_memcpy) {
       size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
+      memcpy(output_data_casted, input_data_casted, copy_bytes);
+      ReplicateBytes(output_data_casted, copy_bytes, num_of_copies_per_batch, thread_pool);
     } else {
       size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
       size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
 
-      // TODO: Multi-thread if needed
       for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
+        memcpy(output_data_casted, input_data_casted, copy_bytes);
+        ReplicateBytes(output_data_casted, copy_bytes, num_of_copies_per_batch, thread_pool);
+        output_data_casted += copy_bytes * num_of_copies_per_batch;
         input_data_casted += copy_bytes;
       }
 
       // Now account for batch dim repeat
       if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-        copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
+        ReplicateBytes(reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw()),
+                       copy_bytes * num_of_copies_per_batch * batch_count, num_of_batch_copies, thread_pool);
       }
     }
 
@@ -3,10 +3,14 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "utils.h"
 
@@ -237,9 +241,172 @@ static void DoTransposeEltWise(int64_t num_axes, gsl::span<const int64_t> target
   }
 }
 
+/* Blocked transpose for the general case where the innermost input axis moves.
+
+The axes of size 1 are removed and the input axes that stay adjacent in the output are merged, which reduces most
+permutations to 2 or 3 axes. The two axes that change fastest, the innermost input axis and the input axis that
+becomes the innermost output axis, are transposed by tiles sized to a cache line so the reads and the writes both
+use whole cache lines. The remaining axes and the rows of tiles are distributed across the thread pool.
+*/
+
+// Merges the axes of a transposition. `merged_perm` is the permutation of the `merged_dims` input axes.
+static void MergeTransposeAxes(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> input_dims,
+                               InlinedVector<size_t>& merged_dims, InlinedVector<size_t>& merged_perm) {
+  // group the output axes whose input axes are consecutive once the axes of size 1 are ignored
+  InlinedVector<size_t> group_first_axis;
+  InlinedVector<size_t> group_dim;
+  size_t previous_axis = 0;
+  for (size_t axis : permutations) {
+    if (input_dims[axis] == 1) {
+      continue;
+    }
+    bool consecutive = !group_first_axis.empty() && axis > previous_axis;
+    for (size_t a = previous_axis + 1; consecutive && a < axis; ++a) {
+      consecutive = input_dims[a] == 1;
+    }
+    if (consecutive) {
+      group_dim.back() *= static_cast<size_t>(input_dims[axis]);
+    } else {
+      group_first_axis.push_back(axis);
+      group_dim.push_back(static_cast<size_t>(input_dims[axis]));
+    }
+    previous_axis = axis;
+  }
+
+  // the merged input axes keep the order of their first input axis
+  const size_t merged_rank = group_first_axis.size();
+  InlinedVector<size_t> order(merged_rank);
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(),
+            [&group_first_axis](size_t a, size_t b) { return group_first_axis[a] < group_first_axis[b]; });
+
+  merged_dims.resize(merged_rank);
+  merged_perm.resize(merged_rank);
+  for (size_t i = 0; i < merged_rank; ++i) {
+    merged_dims[i] = group_dim[order[i]];
+    merged_perm[order[i]] = i;
+  }
+}
+
+// target[c * target_stride + r] = source[r * source_stride + c]
+template <typename T>
+static inline void TransposeTile(const T* source, T* target, size_t rows, size_t cols,
+                                 size_t source_stride, size_t target_stride) {
+  for (size_t c = 0; c < cols; ++c) {
+    const T* s = source + c;
+    T* t = target + c * target_stride;
+    for (size_t r = 0; r < rows; ++r) {
+      t[r] = s[r * source_stride];
+    }
+  }
+}
+
+template <typename T>
+static void TransposeBlocked(gsl::span<const size_t> dims, gsl::span<const size_t> perm,
+                             const T* source, T* target, concurrency::ThreadPool* tp) {
+  // a tile is a cache line wide in both the source and the target
+  constexpr size_t tile = 64 / sizeof(T);
+
+  const size_t rank = dims.size();
+  InlinedVector<size_t> source_strides(rank);
+  InlinedVector<size_t> target_strides(rank);  // stride in the target of each input axis
+  source_strides[rank - 1] = 1;
+  for (size_t i = rank - 1; i > 0; --i) {
+    source_strides[i - 1] = source_strides[i] * dims[i];
+  }
+  for (size_t i = rank, stride = 1; i > 0; --i) {
+    target_strides[perm[i - 1]] = stride;
+    stride *= dims[perm[i - 1]];
+  }
+
+  // rows are read with a stride and written contiguously, columns the other way around
+  const size_t row_axis = perm[rank - 1];
+  const size_t col_axis = rank - 1;
+  const size_t rows = dims[row_axis];
+  const size_t cols = dims[col_axis];
+  const size_t source_row_stride = source_strides[row_axis];
+  const size_t target_col_stride = target_strides[col_axis];
+
+  // the other axes in the order of the output
+  InlinedVector<size_t> outer_axes;
+  for (size_t i = 0; i + 1 < rank; ++i) {
+    if (perm[i] != col_axis) {
+      outer_axes.push_back(perm[i]);
+    }
+  }
+
+  const size_t row_tiles = (rows + tile - 1) / tile;
+  const size_t outer_count = std::accumulate(outer_axes.begin(), outer_axes.end(), size_t{1},
+                                             [&dims](size_t n, size_t axis) { return n * dims[axis]; });
+  const double bytes_per_unit = static_cast<double>(std::min(rows, tile) * cols * sizeof(T));
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(outer_count * row_tiles), TensorOpCost{bytes_per_unit, bytes_per_unit, 0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto unit = static_cast<size_t>(first); unit < static_cast<size_t>(last); ++unit) {
+          size_t outer = unit / row_tiles;
+          const size_t row_start = (unit % row_tiles) * tile;
+          const size_t row_count = std::min(tile, rows - row_start);
+
+          const T* s = source + row_start * source_row_stride;
+          T* t = target + row_start;
+          for (size_t i = outer_axes.size(); i > 0; --i) {
+            const size_t axis = outer_axes[i - 1];
+            const size_t index = outer % dims[axis];
+            outer /= dims[axis];
+            s += index * source_strides[axis];
+            t += index * target_strides[axis];
+          }
+
+          for (size_t col_start = 0; col_start < cols; col_start += tile) {
+            TransposeTile(s + col_start, t + col_start * target_col_stride, row_count,
+                          std::min(tile, cols - col_start), source_row_stride, target_col_stride);
+          }
+        }
+      });
+}
+
+template <typename T>
+static bool TypedTransposeBlocked(gsl::span<const size_t> dims, gsl::span<const size_t> perm,
+                                  const uint8_t* source, uint8_t* target, concurrency::ThreadPool* tp) {
+  constexpr bool enabled = utils::HasTypeWithSameSize<EnabledDataTypes, T>();
+
+  if (enabled) {
+    TransposeBlocked(dims, perm, reinterpret_cast<const T*>(source), reinterpret_cast<T*>(target), tp);
+  }
+
+  return enabled;
+}
+
+// Returns false if the transposition doesn't move the innermost input axis or the element size isn't handled.
+static bool TryTransposeBlocked(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> input_dims,
+                                const uint8_t* source, uint8_t* target, size_t element_size,
+                                concurrency::ThreadPool* tp) {
+  InlinedVector<size_t> dims;
+  InlinedVector<size_t> perm;
+  MergeTransposeAxes(permutations, input_dims, dims, perm);
+  if (dims.size() < 2 || perm.back() == dims.size() - 1) {
+    return false;
+  }
+
+  switch (element_size) {
+    case sizeof(uint64_t):
+      return TypedTransposeBlocked<uint64_t>(dims, perm, source, target, tp);
+    case sizeof(uint32_t):
+      return TypedTransposeBlocked<uint32_t>(dims, perm, source, target, tp);
+    case sizeof(uint16_t):
+      return TypedTransposeBlocked<uint16_t>(dims, perm, source, target, tp);
+    case sizeof(uint8_t):
+      return TypedTransposeBlocked<uint8_t>(dims, perm, source, target, tp);
+    default:
+      return false;
+  }
+}
+
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+                                 const TensorShape* input_shape_override = nullptr,
+                                 concurrency::ThreadPool* tp = nullptr) {
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
@@ -300,9 +467,11 @@ static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, co
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
     } else if (1 == suffix_blocksize) {
-      // this may return a failed status if the data size is not supported in this build
-      status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                                  input_data, output_data, element_size);
+      if (!TryTransposeBlocked(permutations, input_dims, input_data, output_data, element_size, tp)) {
+        // this may return a failed status if the data size is not supported in this build
+        status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+                                    input_data, output_data, element_size);
+      }
     } else {
       DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
                       input_data, output_data, element_size);
@@ -735,7 +904,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
     SingleAxisTranspose(*p_perm, X, Y, from, to);
   } else {
     // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
+    status = DoUntypedTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
   }
 
   return status;
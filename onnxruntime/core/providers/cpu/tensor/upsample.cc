@@ -5,6 +5,10 @@
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample.h"
 
+#include <array>
+#include <limits>
+#include <type_traits>
+
 using namespace onnxruntime::common;
 using namespace std;
 namespace onnxruntime {
@@ -522,6 +526,66 @@ static BilinearParams SetupUpsampleBilinear(int64_t input_height,
   return p;
 }
 
+// Bilinear upsampling of float images split in a horizontal and a vertical pass. The input rows are interpolated
+// along the width, and the two interpolated rows of each output row are blended along the height in a contiguous
+// loop the compiler vectorizes. The interpolated rows are reused by the next output rows while they map to the
+// same input rows, which is the case for most of the rows when upsampling.
+static void UpsampleBilinearSeparable(int64_t batch_size,
+                                      int64_t num_channels,
+                                      int64_t input_height,
+                                      int64_t input_width,
+                                      int64_t output_height,
+                                      int64_t output_width,
+                                      const BilinearParams& p,
+                                      const float* XdataBase,
+                                      float* YdataBase,
+                                      concurrency::ThreadPool* tp) {
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, batch_size * num_channels,
+      [&](std::ptrdiff_t nc) {
+        const float* Xdata = XdataBase + nc * (input_height * input_width);
+        float* Ydata = YdataBase + nc * (output_height * output_width);
+
+        std::vector<float> rows(2 * static_cast<size_t>(output_width));
+        float* row1 = rows.data();
+        float* row2 = row1 + output_width;
+        int64_t row1_offset = -1;
+        int64_t row2_offset = -1;
+
+        auto interpolate_row = [&](int64_t offset, float* row) {
+          const float* Xrow = Xdata + offset;
+          for (int64_t x = 0; x < output_width; ++x) {
+            row[x] = p.dx2[x] * Xrow[p.in_x1[x]] + p.dx1[x] * Xrow[p.in_x2[x]];
+          }
+        };
+
+        for (int64_t y = 0; y < output_height; ++y) {
+          const int64_t offset1 = p.input_width_mul_y1[y];
+          const int64_t offset2 = p.input_width_mul_y2[y];
+          if (offset1 != row1_offset) {
+            if (offset1 == row2_offset) {
+              std::swap(row1, row2);
+              std::swap(row1_offset, row2_offset);
+            } else {
+              interpolate_row(offset1, row1);
+              row1_offset = offset1;
+            }
+          }
+          if (offset2 != row2_offset) {
+            interpolate_row(offset2, row2);
+            row2_offset = offset2;
+          }
+
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+          float* Yrow = Ydata + output_width * y;
+          for (int64_t x = 0; x < output_width; ++x) {
+            Yrow[x] = dy2 * row1[x] + dy1 * row2[x];
+          }
+        }
+      });
+}
+
 template <typename T>
 void UpsampleBilinear(int64_t batch_size,
                       int64_t num_channels,
@@ -543,6 +607,14 @@ void UpsampleBilinear(int64_t batch_size,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate);
 
+  if constexpr (std::is_same<T, float>::value) {
+    if (!use_extrapolation) {
+      UpsampleBilinearSeparable(batch_size, num_channels, input_height, input_width, output_height, output_width,
+                                p, XdataBase, YdataBase, tp);
+      return;
+    }
+  }
+
   for (int64_t n = 0; n < batch_size; ++n) {
     concurrency::ThreadPool::TrySimpleParallelFor(
         tp, num_channels,
@@ -575,6 +647,70 @@ void UpsampleBilinear(int64_t batch_size,
   }
 }
 
+// Bilinear upsampling of a 4-D input in NHWC layout, i.e. with the scales of the outermost and innermost
+// dimensions being 1. The 4 input pixels of an output pixel are blended with the same weights for all the channels,
+// which are contiguous.
+template <typename T>
+void NhwcUpsampleBilinear(int64_t batch_size,
+                          int64_t num_channels,
+                          int64_t input_height,
+                          int64_t input_width,
+                          int64_t output_height,
+                          int64_t output_width,
+                          float height_scale,
+                          float width_scale,
+                          const std::vector<float>& roi,
+                          bool use_extrapolation,
+                          float extrapolation_value,
+                          const T* XdataBase,
+                          T* YdataBase,
+                          AllocatorPtr& alloc,
+                          const GetOriginalCoordinateFunc& get_original_coordinate,
+                          concurrency::ThreadPool* tp) {
+  // SetupUpsampleBilinear reads the roi of the height and width as the two innermost dimensions
+  const std::vector<float> roi_hw{roi[0], roi[3], roi[1], roi[2], roi[4], roi[7], roi[5], roi[6]};
+  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                           height_scale, width_scale, roi_hw,
+                                           alloc, get_original_coordinate);
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * output_height),
+      [&](std::ptrdiff_t ny) {
+        const int64_t n = ny / output_height;
+        const int64_t y = ny % output_height;
+        const T* Xdata = XdataBase + n * (input_height * input_width * num_channels);
+        T* Yrow = YdataBase + ny * (output_width * num_channels);
+
+        for (int64_t x = 0; x < output_width; ++x) {
+          T* Ypixel = Yrow + x * num_channels;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation &&
+              ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
+               (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
+            std::fill_n(Ypixel, num_channels, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const T* X11 = Xdata + (p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels;
+          const T* X21 = Xdata + (p.input_width_mul_y1[y] + p.in_x2[x]) * num_channels;
+          const T* X12 = Xdata + (p.input_width_mul_y2[y] + p.in_x1[x]) * num_channels;
+          const T* X22 = Xdata + (p.input_width_mul_y2[y] + p.in_x2[x]) * num_channels;
+
+          const float w11 = p.dx2[x] * p.dy2[y];
+          const float w21 = p.dx1[x] * p.dy2[y];
+          const float w12 = p.dx2[x] * p.dy1[y];
+          const float w22 = p.dx1[x] * p.dy1[y];
+
+          for (int64_t c = 0; c < num_channels; ++c) {
+            Ypixel[c] = static_cast<T>(w11 * X11[c] + w21 * X21[c] + w12 * X12[c] + w22 * X22[c]);
+          }
+        }
+      },
+      0);
+}
+
 struct TrilinearParams {
   std::vector<float> x_original;
   std::vector<float> y_original;
@@ -829,49 +965,80 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// The input indices and weights of the CubicModeGridLength samples of each output coordinate along one axis
+struct CubicAxisParams {
+  // indices clamped to the input
+  std::vector<int64_t> index;
+  // coefficients already divided by their sum when exclude_outside is set
+  std::vector<float> weight;
+  // the original coordinate is outside of the input and extrapolation_value is used
+  std::vector<uint8_t> extrapolate;
+};
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+static CubicAxisParams SetupCubicAxis(int64_t input_length,
+                                      int64_t output_length,
+                                      float scale,
+                                      float roi_start,
+                                      float roi_end,
+                                      float cubic_coeff_a,
+                                      bool use_extrapolation,
+                                      bool exclude_outside,
+                                      const GetOriginalCoordinateFunc& get_original_coordinate) {
+  CubicAxisParams p;
+  p.index.resize(static_cast<size_t>(output_length) * CubicModeGridLength);
+  p.weight.resize(static_cast<size_t>(output_length) * CubicModeGridLength);
+  p.extrapolate.resize(static_cast<size_t>(output_length));
+
+  for (int64_t i = 0; i < output_length; ++i) {
+    const float in = scale == 1 ? static_cast<float>(i)
+                                : get_original_coordinate(static_cast<float>(i), scale,
+                                                          static_cast<float>(output_length),
+                                                          static_cast<float>(input_length),
+                                                          roi_start, roi_end);
+    p.extrapolate[i] = use_extrapolation && (in < 0 || in > static_cast<float>(input_length - 1));
+
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    const auto coeffs = GetCubicCoeffs(static_cast<float>(in - in_int), cubic_coeff_a);
+
+    // When exclude_outside is set, the weight of sampling locations outside the grid will be set to 0
+    // and the weight will be renormalized so that their sum is 1.0
+    std::array<float, CubicModeGridLength> weights;
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      coeff_sum = 0;
+      for (int64_t j = 0, in_val = in_int - 1; j < static_cast<int64_t>(CubicModeGridLength); j++, in_val++) {
+        weights[j] = (in_val < 0 || in_val >= input_length) ? 0.0f : coeffs[j];
+        coeff_sum += weights[j];
+      }
+    } else {
+      weights = coeffs;
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
+    for (int64_t j = 0, in_val = in_int - 1; j < static_cast<int64_t>(CubicModeGridLength); j++, in_val++) {
+      p.index[i * CubicModeGridLength + j] = std::max(static_cast<int64_t>(0), std::min(in_val, input_length - 1));
+      p.weight[i * CubicModeGridLength + j] = weights[j] / coeff_sum;
+    }
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return p;
+}
+
+// Converts an interpolated value to the type of the output. Cubic interpolation overshoots near edges, so the
+// values of integer types are rounded and saturated as an image library would.
+template <typename T>
+static T CastInterpolatedValue(float value) {
+  if constexpr (std::is_integral<T>::value) {
+    const double rounded = std::round(static_cast<double>(value));
+    return static_cast<T>(std::min(std::max(rounded, static_cast<double>(std::numeric_limits<T>::lowest())),
+                                   static_cast<double>(std::numeric_limits<T>::max())));
+  } else {
+    return static_cast<T>(value);
+  }
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
+
+// Bicubic resizing split in a horizontal and a vertical pass. The coefficients of the output rows and columns are
+// computed once for all the channels. The input rows used by the output are interpolated along the width, then the
+// output rows are computed from 4 interpolated rows each in a contiguous loop the compiler vectorizes.
 template <typename T>
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
@@ -886,140 +1053,90 @@ void ResizeBiCubic(int64_t batch_size,
                    float extrapolation_value,
                    bool exclude_outside,
                    const std::vector<float>& roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
+                   const T* XdataBase,
+                   T* YdataBase,
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
 
-  // generate coefficients in y direction
+  const CubicAxisParams py = SetupCubicAxis(input_height, output_height, height_scale,
+                                            roi[roi_y_start], roi[roi_y_end], cubic_coeff_a,
+                                            use_extrapolation, exclude_outside, get_original_coordinate);
+  const CubicAxisParams px = SetupCubicAxis(input_width, output_width, width_scale,
+                                            roi[roi_x_start], roi[roi_x_end], cubic_coeff_a,
+                                            use_extrapolation, exclude_outside, get_original_coordinate);
+
+  // Map the input rows used by the output to rows of the buffer of the horizontal pass
+  std::vector<int64_t> buffer_row(static_cast<size_t>(input_height), -1);
+  std::vector<int64_t> input_rows;
   for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    if (py.extrapolate[y]) {
+      continue;
     }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    for (size_t i = 0; i < CubicModeGridLength; ++i) {
+      const int64_t in_y = py.index[y * CubicModeGridLength + i];
+      if (buffer_row[in_y] < 0) {
+        buffer_row[in_y] = static_cast<int64_t>(input_rows.size());
+        input_rows.push_back(in_y);
+      }
     }
   }
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, batch_size * num_channels,
+      [&](std::ptrdiff_t nc) {
+        const T* Xdata = XdataBase + nc * (input_height * input_width);
+        T* Ydata = YdataBase + nc * (output_height * output_width);
+
+        // horizontal pass
+        std::vector<float> rows(input_rows.size() * static_cast<size_t>(output_width));
+        for (size_t r = 0; r < input_rows.size(); ++r) {
+          const T* Xrow = Xdata + input_rows[r] * input_width;
+          float* row = rows.data() + r * output_width;
           for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
+            const int64_t* index = px.index.data() + x * CubicModeGridLength;
+            const float* weight = px.weight.data() + x * CubicModeGridLength;
+            float result = 0;
+            for (size_t i = 0; i < CubicModeGridLength; ++i) {
+              result += weight[i] * Xrow[index[i]];
+            }
+            row[x] = result;
           }
         }
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
+        // vertical pass
+        std::vector<float> output_row(static_cast<size_t>(output_width));
+        for (int64_t y = 0; y < output_height; ++y) {
+          T* Yrow = Ydata + y * output_width;
 
           // when use_extrapolation is set and original index is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+          if (py.extrapolate[y]) {
+            std::fill_n(Yrow, output_width, static_cast<T>(extrapolation_value));
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
+          const int64_t* index = py.index.data() + y * CubicModeGridLength;
+          const float* weight = py.weight.data() + y * CubicModeGridLength;
+          std::fill(output_row.begin(), output_row.end(), 0.0f);
+          for (size_t i = 0; i < CubicModeGridLength; ++i) {
+            const float* row = rows.data() + buffer_row[index[i]] * output_width;
+            const float w = weight[i];
+            for (int64_t x = 0; x < output_width; ++x) {
+              output_row[x] += row[x] * w;
             }
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
+          for (int64_t x = 0; x < output_width; ++x) {
+            Yrow[x] = px.extrapolate[x] ? static_cast<T>(extrapolation_value)
+                                        : CastInterpolatedValue<T>(output_row[x]);
           }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1065,6 +1182,25 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
     case UpsampleMode::LINEAR: {
       // Supports 'bilinear' and 'trilinear' sampling only
 
+      // 4-D input in NHWC layout with outermost and innermost scales as 1
+      if (dims.size() == 4 && scales[0] == 1 && scales[3] == 1 && scales[1] != 1) {
+        const int64_t batch_size = dims[0];
+        const int64_t input_height = dims[1];
+        const int64_t input_width = dims[2];
+        const int64_t num_channels = dims[3];
+
+        const int64_t output_height = output_dims[1];
+        const int64_t output_width = output_dims[2];
+
+        AllocatorPtr alloc;
+        ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+        NhwcUpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
+                             scales[1], scales[2], roi, use_extrapolation_, extrapolation_value_, X->Data<T>(),
+                             Y->MutableData<T>(), alloc, get_original_coordinate_,
+                             output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+        return Status::OK();
+      }
+
       //'bilinear' == 2-D input or 4-D input with outermost 2 scales as 1
       if (dims.size() == 2 || dims.size() == 4) {
         bool is_2D = dims.size() == 2;
@@ -1136,8 +1272,9 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
 
       ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                     is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
-                    extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                    Y->MutableData<float>(), get_original_coordinate_);
+                    extrapolation_value_, exclude_outside_, roi, X->Data<T>(),
+                    Y->MutableData<T>(), get_original_coordinate_,
+                    output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
       return Status::OK();
     }
     default:
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "cuda_allocator.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "cuda_common.h"
 #include "core/framework/allocatormgr.h"
 #include "cuda_fence.h"
@@ -63,6 +67,88 @@ void CUDAAllocator::Free(void* p) {
   cudaFree(p);         // do not throw error since it's OK for cudaFree to fail during shutdown
 }
 
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, cudaStream_t stream,
+                                           size_t mem_limit, size_t release_threshold)
+    : CUDAAllocator(device_id, name), stream_(stream), mem_limit_(mem_limit) {
+#if defined(CUDART_VERSION) && CUDART_VERSION >= 11020
+  int supported = 0;
+  CUDA_CALL_THROW(cudaDeviceGetAttribute(&supported, cudaDevAttrMemoryPoolsSupported, device_id));
+  ORT_ENFORCE(supported != 0, "CUDA device ", device_id, " does not support memory pools.");
+
+  CUDA_CALL_THROW(cudaDeviceGetDefaultMemPool(&pool_, device_id));
+
+  // The pool is shared by the process, so the largest threshold requested by any of its users wins.
+  cuuint64_t threshold = 0;
+  CUDA_CALL_THROW(cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+  if (threshold < release_threshold) {
+    threshold = release_threshold;
+    CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+  }
+
+  stats_.bytes_limit = mem_limit == std::numeric_limits<size_t>::max() ? 0 : static_cast<int64_t>(mem_limit);
+#else
+  ORT_UNUSED_PARAMETER(release_threshold);
+  ORT_THROW("The CUDA memory pool allocator requires CUDA 11.2 or later.");
+#endif
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  void* p = nullptr;
+  if (size == 0) {
+    return p;
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  // The pool has no limit of its own, so the limit is applied to the memory in use by this allocator.
+  ORT_ENFORCE(static_cast<size_t>(stats_.bytes_in_use) + size <= mem_limit_,
+              "Failed to allocate ", size, " bytes from the CUDA memory pool: ", stats_.bytes_in_use,
+              " bytes are in use and the limit is ", mem_limit_, " bytes.");
+
+#if defined(CUDART_VERSION) && CUDART_VERSION >= 11020
+  SetDevice(true);
+  CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, stream_));
+
+  cuuint64_t reserved = 0;
+  CUDA_CALL_THROW(cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrReservedMemCurrent, &reserved));
+  stats_.bytes_reserved = static_cast<int64_t>(reserved);
+  stats_.max_bytes_reserved = std::max(stats_.max_bytes_reserved, stats_.bytes_reserved);
+#endif
+
+  allocation_sizes_[p] = size;
+  stats_.num_allocs++;
+  stats_.bytes_in_use += size;
+  stats_.total_allocated_bytes += size;
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+
+  return p;
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  auto it = allocation_sizes_.find(p);
+  if (it != allocation_sizes_.end()) {
+    stats_.bytes_in_use -= it->second;
+    allocation_sizes_.erase(it);
+  }
+
+#if defined(CUDART_VERSION) && CUDART_VERSION >= 11020
+  SetDevice(false);
+  // The memory is reused by work queued on the stream after this point, so no synchronization is needed.
+  // Do not throw since it's OK for the free to fail during shutdown.
+  cudaFreeAsync(p, stream_);
+#endif
+}
+
+void CUDAMemPoolAllocator::GetStats(AllocatorStats* stats) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  *stats = stats_;
+}
+
 void* CUDAExternalAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cuda_runtime_api.h>
 
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
@@ -51,6 +52,29 @@ class CUDAExternalAllocator : public CUDAAllocator {
   InlinedHashSet<void*> reserved_;
 };
 
+// Allocator backed by the default memory pool of the device (cudaMallocFromPoolAsync).
+// Allocations and frees are ordered on `stream`, so freed memory is reused by later work on that stream without
+// synchronizing with the device and without a private arena: the sessions of the process share the pool.
+// Memory the pool holds above `release_threshold` bytes is returned to the device when the stream synchronizes.
+class CUDAMemPoolAllocator : public CUDAAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, cudaStream_t stream,
+                       size_t mem_limit, size_t release_threshold);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+ private:
+  cudaStream_t stream_;
+  cudaMemPool_t pool_{nullptr};
+  size_t mem_limit_;
+
+  OrtMutex lock_;
+  InlinedHashMap<void*, size_t> allocation_sizes_;
+  AllocatorStats stats_;
+};
+
 //TODO: add a default constructor
 class CUDAPinnedAllocator : public IAllocator {
  public:
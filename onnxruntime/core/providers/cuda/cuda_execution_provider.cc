@@ -111,7 +111,8 @@ ONNX_OPERATOR_KERNEL_EX(
 }  // namespace cuda
 
 AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t gpu_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                                                        CUDAExecutionProviderExternalAllocatorInfo external_allocator_info, OrtArenaCfg* default_memory_arena_cfg) {
+                                                        CUDAExecutionProviderExternalAllocatorInfo external_allocator_info, OrtArenaCfg* default_memory_arena_cfg,
+                                                        CUDAExecutionProviderMemPoolInfo mem_pool_info, cudaStream_t stream) {
   if (external_allocator_info.UseExternalAllocator()) {
     AllocatorCreationInfo default_memory_info(
         [external_allocator_info](OrtDevice::DeviceId id) {
@@ -122,6 +123,17 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
 
     return CreateAllocator(default_memory_info);
 
+  } else if (mem_pool_info.use_mem_pool) {
+    // The memory pool reuses freed memory itself, so there is no arena on top of it.
+    AllocatorCreationInfo default_memory_info(
+        [gpu_mem_limit, mem_pool_info, stream](OrtDevice::DeviceId id) {
+          return std::make_unique<CUDAMemPoolAllocator>(id, CUDA, stream, gpu_mem_limit, mem_pool_info.release_threshold);
+        },
+        device_id,
+        false);
+
+    return CreateAllocator(default_memory_info);
+
   } else {
     AllocatorCreationInfo default_memory_info(
         [](OrtDevice::DeviceId id) {
@@ -139,7 +151,14 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
 
 CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t gpu_mem_limit,
                                                           ArenaExtendStrategy arena_extend_strategy, CUDAExecutionProviderExternalAllocatorInfo external_allocator_info,
-                                                          OrtArenaCfg* default_memory_arena_cfg) {
+                                                          OrtArenaCfg* default_memory_arena_cfg,
+                                                          CUDAExecutionProviderMemPoolInfo mem_pool_info)
+    : device_id_(device_id),
+      gpu_mem_limit_(gpu_mem_limit),
+      arena_extend_strategy_(arena_extend_strategy),
+      external_allocator_info_(external_allocator_info),
+      default_memory_arena_cfg_(default_memory_arena_cfg),
+      mem_pool_info_(mem_pool_info) {
   CUDA_CALL_THROW(cudaSetDevice(device_id));
   stream_ = stream;
 
@@ -150,11 +169,8 @@ CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
   CUDNN_CALL_THROW(cudnnSetStream(cudnn_handle_, stream));
 
   // CUDA malloc/free is expensive so always use an arena
-  allocator_ = CreateCudaAllocator(device_id, gpu_mem_limit, arena_extend_strategy, external_allocator_info, default_memory_arena_cfg);
-
-#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-  cuda_graph_.SetStream(stream_);
-#endif
+  allocator_ = CreateCudaAllocator(device_id, gpu_mem_limit, arena_extend_strategy, external_allocator_info, default_memory_arena_cfg,
+                                   mem_pool_info, stream);
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -172,34 +188,90 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
   } catch (const std::exception& ex) {
     LOGS_DEFAULT(ERROR) << "cudnnDestroy threw:" << ex.what();
   }
+
+  for (auto& aux_context : aux_stream_contexts_) {
+    try {
+      if (aux_context.cublas_handle != nullptr) {
+        CUBLAS_CALL(cublasDestroy(aux_context.cublas_handle));
+      }
+      if (aux_context.cudnn_handle != nullptr) {
+        CUDNN_CALL(cudnnDestroy(aux_context.cudnn_handle));
+      }
+    } catch (const std::exception& ex) {
+      LOGS_DEFAULT(ERROR) << "Destroying the handles of an aux stream threw:" << ex.what();
+    }
+  }
+}
+
+void CUDAExecutionProvider::PerThreadContext::SelectStream(int stream_index, cudaStream_t stream) {
+  if (stream_index != 0) {
+    if (aux_stream_contexts_.size() <= static_cast<size_t>(stream_index)) {
+      aux_stream_contexts_.resize(stream_index + 1);
+    }
+
+    auto& aux_context = aux_stream_contexts_[stream_index];
+    if (aux_context.stream != stream) {
+      if (aux_context.cublas_handle == nullptr) {
+        CUBLAS_CALL_THROW(cublasCreate(&aux_context.cublas_handle));
+        CUDNN_CALL_THROW(cudnnCreate(&aux_context.cudnn_handle));
+        aux_context.allocator = CreateCudaAllocator(device_id_, gpu_mem_limit_, arena_extend_strategy_,
+                                                    external_allocator_info_, default_memory_arena_cfg_,
+                                                    mem_pool_info_, stream);
+      }
+      CUBLAS_CALL_THROW(cublasSetStream(aux_context.cublas_handle, stream));
+      CUDNN_CALL_THROW(cudnnSetStream(aux_context.cudnn_handle, stream));
+      aux_context.stream = stream;
+    }
+  }
+
+  current_stream_index_ = stream_index;
 }
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+CUDAExecutionProvider::PerThreadContext::CapturedGraph& CUDAExecutionProvider::PerThreadContext::GetCapturedGraph() {
+  auto& captured_graph = cuda_graphs_[graph_annotation_id_];
+  if (captured_graph == nullptr) {
+    captured_graph = std::make_unique<CapturedGraph>();
+    captured_graph->cuda_graph.SetStream(stream_);
+  }
+  return *captured_graph;
+}
+
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
-  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
+  if (graph_annotation_id_ == kGraphAnnotationSkip) {
+    return false;
+  }
+  auto it = cuda_graphs_.find(graph_annotation_id_);
+  int regular_run_count = it == cuda_graphs_.end() ? 0 : it->second->regular_run_count_before_graph_capture;
+  return regular_run_count >= min_num_runs_before_cuda_graph_capture_;
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureBegin() {
-  cuda_graph_.Reset();
-  cuda_graph_.CaptureBegin();
+  auto& captured_graph = GetCapturedGraph();
+  captured_graph.cuda_graph.Reset();
+  captured_graph.cuda_graph.CaptureBegin();
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureEnd() {
-  cuda_graph_.CaptureEnd();
-  is_graph_captured_ = true;
+  auto& captured_graph = GetCapturedGraph();
+  captured_graph.cuda_graph.CaptureEnd();
+  captured_graph.is_graph_captured = true;
 }
 
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured() const {
-  return is_graph_captured_;
+  auto it = cuda_graphs_.find(graph_annotation_id_);
+  return it != cuda_graphs_.end() && it->second->is_graph_captured;
 }
 
 Status CUDAExecutionProvider::PerThreadContext::ReplayGraph() {
   ORT_ENFORCE(IsGraphCaptured());
-  return cuda_graph_.Replay();
+  return GetCapturedGraph().cuda_graph.Replay();
 }
 
 void CUDAExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
-  ++regular_run_count_before_graph_capture_;
+  if (graph_annotation_id_ != kGraphAnnotationSkip) {
+    ++GetCapturedGraph().regular_run_count_before_graph_capture;
+  }
 }
 #endif
 
@@ -226,6 +298,19 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
     }
   }
 
+  if (info.num_compute_streams > 1) {
+    // the legacy default stream synchronizes with all the other streams, and a captured CUDA graph replays the
+    // work of a single stream.
+    if (stream_ == nullptr || info.enable_cuda_graph) {
+      LOGS_DEFAULT(WARNING) << "num_compute_streams is ignored when the default stream is used or CUDA graph is enabled.";
+    } else {
+      aux_streams_.resize(info.num_compute_streams - 1);
+      for (auto& aux_stream : aux_streams_) {
+        CUDA_CALL_THROW(cudaStreamCreateWithFlags(&aux_stream, cudaStreamNonBlocking));
+      }
+    }
+  }
+
   size_t free = 0;
   size_t total = 0;
   CUDA_CALL_THROW(cudaMemGetInfo(&free, &total));
@@ -259,11 +344,74 @@ CUDAExecutionProvider::~CUDAExecutionProvider() {
     }
   }
 
+  for (auto event : free_stream_events_) {
+    CUDA_CALL(cudaEventDestroy(event));
+  }
+
+  for (auto aux_stream : aux_streams_) {
+    CUDA_CALL(cudaStreamDestroy(aux_stream));
+  }
+
   if (!external_stream_ && stream_) {
     CUDA_CALL(cudaStreamDestroy(stream_));
   }
 }
 
+void* CUDAExecutionProvider::GetComputeStream() const {
+  return static_cast<void*>(aux_streams_.empty() ? stream_ : GetCurrentComputeStream(stream_));
+}
+
+Status CUDAExecutionProvider::SetCurrentComputeStream(int stream_index) const {
+  ORT_RETURN_IF_NOT(stream_index >= 0 && stream_index < GetComputeStreamCount(),
+                    "Invalid compute stream index: ", stream_index);
+  if (aux_streams_.empty()) {
+    return Status::OK();
+  }
+
+  cudaStream_t stream = ComputeStream(stream_index);
+  SelectCurrentComputeStream(stream_, stream_index == 0 ? nullptr : stream);
+  GetPerThreadContext().SelectStream(stream_index, stream);
+  return Status::OK();
+}
+
+Status CUDAExecutionProvider::RecordStreamEvent(int stream_index, void** event) const {
+  ORT_RETURN_IF_NOT(stream_index >= 0 && stream_index < GetComputeStreamCount(),
+                    "Invalid compute stream index: ", stream_index);
+  cudaEvent_t stream_event = nullptr;
+  {
+    std::lock_guard<OrtMutex> lock(stream_events_mutex_);
+    if (!free_stream_events_.empty()) {
+      stream_event = free_stream_events_.back();
+      free_stream_events_.pop_back();
+    }
+  }
+
+  if (stream_event == nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&stream_event, cudaEventDisableTiming));
+  }
+
+  *event = stream_event;
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(stream_event, ComputeStream(stream_index)));
+  return Status::OK();
+}
+
+Status CUDAExecutionProvider::WaitStreamEvent(int stream_index, void* event) const {
+  ORT_RETURN_IF_NOT(stream_index >= 0 && stream_index < GetComputeStreamCount(),
+                    "Invalid compute stream index: ", stream_index);
+  // the node recording the event may have been skipped
+  if (event != nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(ComputeStream(stream_index), static_cast<cudaEvent_t>(event), 0));
+  }
+  return Status::OK();
+}
+
+void CUDAExecutionProvider::ReleaseStreamEvent(void* event) const {
+  if (event != nullptr) {
+    std::lock_guard<OrtMutex> lock(stream_events_mutex_);
+    free_stream_events_.push_back(static_cast<cudaEvent_t>(event));
+  }
+}
+
 std::unique_ptr<profiling::EpProfiler> CUDAExecutionProvider::GetProfiler() {
   return std::make_unique<profiling::CudaProfiler>();
 }
@@ -286,8 +434,9 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
 
     // get or create a context
     if (context_state_.retired_context_pool.empty()) {
-      context = std::make_shared<PerThreadContext>(info_.device_id, static_cast<cudaStream_t>(GetComputeStream()), info_.gpu_mem_limit,
-                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+      context = std::make_shared<PerThreadContext>(info_.device_id, stream_, info_.gpu_mem_limit,
+                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                                   info_.mem_pool_info);
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -400,9 +549,9 @@ Status CUDAExecutionProvider::OnRunEnd(bool sync_stream) {
   }
   // record deferred release event on default stream, and release per_thread_context
   auto current_deferred_release_event = GetPerThreadContext().GetCurrentDeferredReleaseEvent();
-  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, static_cast<cudaStream_t>(GetComputeStream())));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, stream_));
   if (sync_stream) {
-    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(static_cast<cudaStream_t>(GetComputeStream())));
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream_));
   }
 
   // If cuda graph is enabled, the per thread context will not be released
@@ -441,6 +590,10 @@ bool CUDAExecutionProvider::IsGraphCaptured() const {
 Status CUDAExecutionProvider::ReplayGraph() {
   return GetPerThreadContext().ReplayGraph();
 }
+
+void CUDAExecutionProvider::SetGraphAnnotationId(int graph_annotation_id) {
+  GetPerThreadContext().SetGraphAnnotationId(graph_annotation_id);
+}
 #endif
 
 namespace cuda {
@@ -2348,7 +2501,8 @@ static bool CastNeedFallbackToCPU(const onnxruntime::Node& node) {
 }
 
 std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransfer() const {
-  return std::make_unique<onnxruntime::GPUDataTransfer>(static_cast<cudaStream_t>(GetComputeStream()), info_.do_copy_in_default_stream);
+  return std::make_unique<onnxruntime::GPUDataTransfer>(stream_, info_.do_copy_in_default_stream,
+                                                        info_.enable_pinned_io_staging);
 }
 
 std::vector<std::unique_ptr<ComputeCapability>>
@@ -2441,7 +2595,8 @@ void CUDAExecutionProvider::RegisterAllocator(std::shared_ptr<AllocatorManager>
   auto cuda_alloc = allocator_manager->GetAllocator(info_.device_id, OrtMemTypeDefault);
   if (nullptr == cuda_alloc) {
     cuda_alloc = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                                     info_.external_allocator_info, info_.default_memory_arena_cfg);
+                                     info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                     info_.mem_pool_info, stream_);
     allocator_manager->InsertAllocator(cuda_alloc);
   }
   TryInsertAllocator(std::move(cuda_alloc));
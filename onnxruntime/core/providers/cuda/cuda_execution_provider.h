@@ -39,7 +39,14 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   Status SetComputeStream(void* stream) override;
 
-  void* GetComputeStream() const override { return static_cast<void*>(stream_); }
+  // the stream selected for the calling thread with SetCurrentComputeStream(), stream_ by default
+  void* GetComputeStream() const override;
+
+  int GetComputeStreamCount() const override { return 1 + static_cast<int>(aux_streams_.size()); }
+  Status SetCurrentComputeStream(int stream_index) const override;
+  Status RecordStreamEvent(int stream_index, void** event) const override;
+  Status WaitStreamEvent(int stream_index, void* event) const override;
+  void ReleaseStreamEvent(void* event) const override;
 
   cublasHandle_t PerThreadCublasHandle() {
     return GetPerThreadContext().CublasHandle();
@@ -91,8 +98,10 @@ class CUDAExecutionProvider : public IExecutionProvider {
   }
 
   void RegisterAllocator(std::shared_ptr<AllocatorManager> allocator_manager) override;
+  // With `mem_pool_info.use_mem_pool`, the allocator allocates and frees in the order of `stream`.
   static AllocatorPtr CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                                          CUDAExecutionProviderMemPoolInfo mem_pool_info = {}, cudaStream_t stream = nullptr);
 
   std::unique_ptr<profiling::EpProfiler> GetProfiler() override;
 
@@ -100,6 +109,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool IsGraphCaptureEnabled() const override;
   bool IsGraphCaptured() const override;
   Status ReplayGraph() override;
+  void SetGraphAnnotationId(int graph_annotation_id) override;
 #endif
 
  private:
@@ -108,6 +118,15 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool external_stream_ = false;
   cudaStream_t stream_ = nullptr;
 
+  // compute streams 1 .. num_compute_streams - 1, stream 0 is stream_
+  std::vector<cudaStream_t> aux_streams_;
+  mutable std::vector<cudaEvent_t> free_stream_events_;
+  mutable OrtMutex stream_events_mutex_;
+
+  cudaStream_t ComputeStream(int stream_index) const {
+    return stream_index == 0 ? stream_ : aux_streams_[stream_index - 1];
+  }
+
   struct DeferredReleaseCPUPtrs {
     bool recorded = false;
     std::vector<void*> cpu_ptrs;
@@ -119,17 +138,23 @@ class CUDAExecutionProvider : public IExecutionProvider {
   class PerThreadContext final {
    public:
     PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                     CUDAExecutionProviderMemPoolInfo mem_pool_info);
     ~PerThreadContext();
 
     cublasHandle_t CublasHandle() const {
-      return cublas_handle_;
+      return current_stream_index_ == 0 ? cublas_handle_ : aux_stream_contexts_[current_stream_index_].cublas_handle;
     }
 
     cudnnHandle_t CudnnHandle() const {
-      return cudnn_handle_;
+      return current_stream_index_ == 0 ? cudnn_handle_ : aux_stream_contexts_[current_stream_index_].cudnn_handle;
     }
 
+    // Makes the handles and the allocator of the context refer to compute stream `stream_index`.
+    // Each compute stream has its own handles and arena, so memory freed by the kernels of one stream is only
+    // reused on the same stream.
+    void SelectStream(int stream_index, cudaStream_t stream);
+
     cudaEvent_t& GetCurrentDeferredReleaseEvent() {
       return current_deferred_release_event_;
     }
@@ -140,29 +165,29 @@ class CUDAExecutionProvider : public IExecutionProvider {
         if (!constant_ones_float_) {
           constant_ones_float_ = cuda::CreateConstantOnes<float>();
         }
-        return reinterpret_cast<const T*>(constant_ones_float_->GetBuffer(stream_, count));
+        return reinterpret_cast<const T*>(constant_ones_float_->GetBuffer(CurrentStream(), count));
       } else if (std::is_same<T, double>::value) {
         if (!constant_ones_double_) {
           constant_ones_double_ = cuda::CreateConstantOnes<double>();
         }
-        return reinterpret_cast<const T*>(constant_ones_double_->GetBuffer(stream_, count));
+        return reinterpret_cast<const T*>(constant_ones_double_->GetBuffer(CurrentStream(), count));
       } else if (std::is_same<T, half>::value) {
         if (!constant_ones_half_) {
           constant_ones_half_ = cuda::CreateConstantOnes<half>();
         }
-        return reinterpret_cast<const T*>(constant_ones_half_->GetBuffer(stream_, count));
+        return reinterpret_cast<const T*>(constant_ones_half_->GetBuffer(CurrentStream(), count));
       } else if (std::is_same<T, BFloat16>::value) {
         if (!constant_ones_bfloat16_) {
           constant_ones_bfloat16_ = cuda::CreateConstantOnes<BFloat16>();
         }
-        return reinterpret_cast<const T*>(constant_ones_bfloat16_->GetBuffer(stream_, count));
+        return reinterpret_cast<const T*>(constant_ones_bfloat16_->GetBuffer(CurrentStream(), count));
       } else {
         return nullptr;
       }
     }
 
     AllocatorPtr GetAllocator() const {
-      return allocator_;
+      return current_stream_index_ == 0 ? allocator_ : aux_stream_contexts_[current_stream_index_].allocator;
     }
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
@@ -172,13 +197,37 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool IsGraphCaptured() const;
   Status ReplayGraph();
   void IncrementRegularRunCountBeforeGraphCapture();
+  void SetGraphAnnotationId(int graph_annotation_id) { graph_annotation_id_ = graph_annotation_id; }
 #endif
 
    private:
+    cudaStream_t CurrentStream() const {
+      return current_stream_index_ == 0 ? stream_ : aux_stream_contexts_[current_stream_index_].stream;
+    }
+
     cudaStream_t stream_ = nullptr;
     cublasHandle_t cublas_handle_ = nullptr;
     cudnnHandle_t cudnn_handle_ = nullptr;
 
+    struct AuxStreamContext {
+      cudaStream_t stream = nullptr;
+      cublasHandle_t cublas_handle = nullptr;
+      cudnnHandle_t cudnn_handle = nullptr;
+      AllocatorPtr allocator;
+    };
+
+    // indexed by stream index, created when a stream is first selected. entry 0 is unused, see the members above.
+    std::vector<AuxStreamContext> aux_stream_contexts_;
+    int current_stream_index_ = 0;
+
+    // needed to create the arenas of the aux streams
+    OrtDevice::DeviceId device_id_;
+    size_t gpu_mem_limit_;
+    ArenaExtendStrategy arena_extend_strategy_;
+    CUDAExecutionProviderExternalAllocatorInfo external_allocator_info_;
+    OrtArenaCfg* default_memory_arena_cfg_;
+    CUDAExecutionProviderMemPoolInfo mem_pool_info_;
+
     // deferred release for temporary CPU pinned memory used in cudaMemcpyAsync
     // note that cudaEvent will be assigned at OnRunEnd() when PerThreadContext destory
     // so the ownership is passed to deferred_release_cpu_ptr_
@@ -192,13 +241,21 @@ class CUDAExecutionProvider : public IExecutionProvider {
     AllocatorPtr allocator_;
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-    // Cuda graph with multi threads will be supported in the future, so cuda_graph_
-    // is put under PerThreadContext.
-    CUDAGraph cuda_graph_;
-    bool is_graph_captured_ = false;
-    int regular_run_count_before_graph_capture_ = 0;
+    // Cuda graph with multi threads will be supported in the future, so the cuda graphs
+    // are put under PerThreadContext.
+    // One graph is captured per graph annotation id, e.g. one per set of input shapes.
+    struct CapturedGraph {
+      CUDAGraph cuda_graph;
+      bool is_graph_captured = false;
+      int regular_run_count_before_graph_capture = 0;
+    };
+    // CUDAGraph is not movable, so the graphs are held by pointer.
+    std::unordered_map<int, std::unique_ptr<CapturedGraph>> cuda_graphs_;
+    int graph_annotation_id_ = 0;
     const int min_num_runs_before_cuda_graph_capture_ = 1; // required min regular runs before graph capture for the necessary memory allocations.
 
+    CapturedGraph& GetCapturedGraph();
+
 #endif
 
   };
@@ -24,6 +24,10 @@ constexpr const char* kGpuExternalEmptyCache = "gpu_external_empty_cache";
 constexpr const char* kCudnnConvUseMaxWorkspace = "cudnn_conv_use_max_workspace";
 constexpr const char* kEnableCudaGraph = "enable_cuda_graph";
 constexpr const char* kCudnnConv1dPadToNc1d = "cudnn_conv1d_pad_to_nc1d";
+constexpr const char* kEnablePinnedIoStaging = "enable_pinned_io_staging";
+constexpr const char* kNumComputeStreams = "num_compute_streams";
+constexpr const char* kUseMemPool = "use_mem_pool";
+constexpr const char* kMemPoolReleaseThreshold = "mem_pool_release_threshold";
 }  // namespace provider_option_names
 }  // namespace cuda
 
@@ -96,6 +100,18 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvUseMaxWorkspace, info.cudnn_conv_use_max_workspace)
           .AddAssignmentToReference(cuda::provider_option_names::kEnableCudaGraph, info.enable_cuda_graph)
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConv1dPadToNc1d, info.cudnn_conv1d_pad_to_nc1d)
+          .AddAssignmentToReference(cuda::provider_option_names::kEnablePinnedIoStaging, info.enable_pinned_io_staging)
+          .AddAssignmentToReference(cuda::provider_option_names::kUseMemPool, info.mem_pool_info.use_mem_pool)
+          .AddAssignmentToReference(cuda::provider_option_names::kMemPoolReleaseThreshold,
+                                    info.mem_pool_info.release_threshold)
+          .AddValueParser(
+              cuda::provider_option_names::kNumComputeStreams,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.num_compute_streams));
+                ORT_RETURN_IF_NOT(info.num_compute_streams >= 1,
+                                  "num_compute_streams must be at least 1 but was ", info.num_compute_streams, ".");
+                return Status::OK();
+              })
           .Parse(options));
 
   CUDAExecutionProviderExternalAllocatorInfo alloc_info{alloc, free, empty_cache};
@@ -117,7 +133,12 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
       {cuda::provider_option_names::kEnableCudaGraph, MakeStringWithClassicLocale(info.enable_cuda_graph)},
-      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)}
+      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
+      {cuda::provider_option_names::kEnablePinnedIoStaging, MakeStringWithClassicLocale(info.enable_pinned_io_staging)},
+      {cuda::provider_option_names::kNumComputeStreams, MakeStringWithClassicLocale(info.num_compute_streams)},
+      {cuda::provider_option_names::kUseMemPool, MakeStringWithClassicLocale(info.mem_pool_info.use_mem_pool)},
+      {cuda::provider_option_names::kMemPoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.mem_pool_info.release_threshold)}
   };
 
   return options;
@@ -131,7 +152,11 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
       {cuda::provider_option_names::kCudnnConvAlgoSearch, EnumToName(*ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)},
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
-      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)}
+      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
+      {cuda::provider_option_names::kEnablePinnedIoStaging, MakeStringWithClassicLocale(info.enable_pinned_io_staging)},
+      {cuda::provider_option_names::kNumComputeStreams, MakeStringWithClassicLocale(info.num_compute_streams)},
+      {cuda::provider_option_names::kUseMemPool, MakeStringWithClassicLocale(info.use_mem_pool)},
+      {cuda::provider_option_names::kMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.mem_pool_release_threshold)}
   };
 
   return options;
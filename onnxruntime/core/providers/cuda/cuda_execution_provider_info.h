@@ -34,6 +34,13 @@ struct CUDAExecutionProviderExternalAllocatorInfo {
   }
 };
 
+// Configuration of the allocator backed by the CUDA memory pool, which replaces the BFC arena of the device memory.
+struct CUDAExecutionProviderMemPoolInfo {
+  bool use_mem_pool{false};
+  // Bytes the pool keeps when the stream synchronizes. The rest of the memory it holds is returned to the device.
+  size_t release_threshold{std::numeric_limits<size_t>::max()};
+};
+
 struct CUDAExecutionProviderInfo {
   OrtDevice::DeviceId device_id{0};
   size_t gpu_mem_limit{std::numeric_limits<size_t>::max()};                         // Will be over-ridden by contents of `default_memory_arena_cfg` (if specified)
@@ -57,6 +64,18 @@ struct CUDAExecutionProviderInfo {
   // By default, for Conv1D, will pad [N,C,D] to [N,C,D,1], if turn on, will pad to [N,C,1,D].
   bool cudnn_conv1d_pad_to_nc1d{false};
 
+  // If turned on, copies between pageable CPU memory and the device are staged through a pool of pinned buffers,
+  // so a host-to-device copy does not block on the compute stream and a device-to-host copy only waits for itself.
+  bool enable_pinned_io_staging{false};
+
+  // Number of compute streams the nodes are spread over, so that independent branches of the graph run
+  // concurrently. Values used on several streams are kept until the end of the run, which increases memory usage.
+  int num_compute_streams{1};
+
+  // If turned on, device memory is allocated in stream order from the CUDA memory pool of the device, which is shared
+  // by the sessions of the process, instead of a BFC arena per session. gpu_mem_limit still applies.
+  CUDAExecutionProviderMemPoolInfo mem_pool_info{};
+
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtCUDAProviderOptionsV2& info);
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/shared_library/provider_api.h"
+#include "core/providers/cuda/cuda_pinned_staging_pool.h"
+
+#include <algorithm>
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t kMinBlockBytes = 64 * 1024;
+
+size_t RoundUpBlockSize(size_t bytes) {
+  size_t size = kMinBlockBytes;
+  while (size < bytes) {
+    size <<= 1;
+  }
+  return size;
+}
+}  // namespace
+
+CudaPinnedStagingPool::CudaPinnedStagingPool(size_t max_pool_bytes) : max_pool_bytes_(max_pool_bytes) {}
+
+CudaPinnedStagingPool::~CudaPinnedStagingPool() {
+  for (auto& block : blocks_) {
+    CUDA_CALL(cudaEventSynchronize(block.event));
+    CUDA_CALL(cudaEventDestroy(block.event));
+    CUDA_CALL(cudaFreeHost(block.data));
+  }
+}
+
+bool CudaPinnedStagingPool::Acquire(size_t bytes, Buffer& buffer) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  // Pick the smallest idle block that fits and whose previous copy has completed
+  size_t best = blocks_.size();
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    const auto& block = blocks_[i];
+    if (block.in_use || block.size < bytes || (best < blocks_.size() && blocks_[best].size <= block.size)) {
+      continue;
+    }
+    auto query = cudaEventQuery(block.event);
+    if (query == cudaSuccess) {
+      best = i;
+    } else if (query != cudaErrorNotReady) {
+      // Clear the sticky error state left by the failed query and treat the block as busy
+      CUDA_CALL(query);
+    }
+  }
+
+  if (best == blocks_.size()) {
+    const size_t size = RoundUpBlockSize(bytes);
+    if (size > max_pool_bytes_ - std::min(pool_bytes_, max_pool_bytes_)) {
+      return false;
+    }
+
+    Block block{nullptr, size, nullptr, false};
+    if (!CUDA_CALL(cudaHostAlloc(&block.data, size, cudaHostAllocPortable))) {
+      return false;
+    }
+    if (!CUDA_CALL(cudaEventCreateWithFlags(&block.event, cudaEventDisableTiming))) {
+      CUDA_CALL(cudaFreeHost(block.data));
+      return false;
+    }
+
+    pool_bytes_ += size;
+    blocks_.push_back(block);
+  }
+
+  auto& block = blocks_[best];
+  block.in_use = true;
+  buffer.data = block.data;
+  buffer.event = block.event;
+  buffer.index = best;
+  return true;
+}
+
+void CudaPinnedStagingPool::Release(const Buffer& buffer) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ORT_ENFORCE(buffer.index < blocks_.size() && blocks_[buffer.index].data == buffer.data,
+              "Buffer was not acquired from this staging pool.");
+  blocks_[buffer.index].in_use = false;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_pch.h"
+
+namespace onnxruntime {
+
+// Pool of pinned host buffers used to stage copies between pageable CPU memory and the device.
+// Each buffer carries a CUDA event that the user records after the last queued copy touching the buffer,
+// and the buffer is only handed out again once that event has completed.
+class CudaPinnedStagingPool {
+ public:
+  struct Buffer {
+    void* data{nullptr};
+    cudaEvent_t event{nullptr};
+    size_t index{0};
+  };
+
+  explicit CudaPinnedStagingPool(size_t max_pool_bytes = kDefaultMaxPoolBytes);
+  ~CudaPinnedStagingPool();
+
+  // Returns false if no buffer of at least `bytes` is available and the pool is at its size limit,
+  // in which case the caller should fall back to copying without staging.
+  bool Acquire(size_t bytes, Buffer& buffer);
+
+  // Hands `buffer` back to the pool. The caller must have recorded `buffer.event` after its last use of the buffer.
+  void Release(const Buffer& buffer);
+
+  static constexpr size_t kDefaultMaxPoolBytes = 256 * 1024 * 1024;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaPinnedStagingPool);
+
+  struct Block {
+    void* data;
+    size_t size;
+    cudaEvent_t event;
+    bool in_use;
+  };
+
+  const size_t max_pool_bytes_;
+  size_t pool_bytes_{0};
+  std::vector<Block> blocks_;
+  OrtMutex mutex_;
+};
+
+}  // namespace onnxruntime
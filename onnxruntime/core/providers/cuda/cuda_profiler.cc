@@ -124,7 +124,8 @@ void CudaProfiler::EndProfiling(TimePoint start_time, Events& events) {
                                                                          {"grid_z", std::to_string(stat.grid_z_)},
                                                                          {"block_x", std::to_string(stat.block_x_)},
                                                                          {"block_y", std::to_string(stat.block_y_)},
-                                                                         {"block_z", std::to_string(stat.block_z_)}};
+                                                                         {"block_z", std::to_string(stat.block_z_)},
+                                                                         {"correlation_id", std::to_string(stat.correlation_id)}};
       EventRecord event{
           KEVENT, -1, -1, stat.name_, DUR(profiling_start, stat.start_), DUR(stat.start_, stat.stop_), {args.begin(), args.end()}};
       auto ts = id_map[stat.correlation_id];
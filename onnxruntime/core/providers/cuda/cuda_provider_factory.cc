@@ -222,6 +222,10 @@ struct CUDA_Provider : Provider {
     info.cudnn_conv_use_max_workspace = params->cudnn_conv_use_max_workspace != 0;
     info.enable_cuda_graph = params->enable_cuda_graph != 0;
     info.cudnn_conv1d_pad_to_nc1d = params->cudnn_conv1d_pad_to_nc1d != 0;
+    info.enable_pinned_io_staging = params->enable_pinned_io_staging != 0;
+    info.num_compute_streams = params->num_compute_streams;
+    info.mem_pool_info.use_mem_pool = params->use_mem_pool != 0;
+    info.mem_pool_info.release_threshold = params->mem_pool_release_threshold;
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -241,6 +245,10 @@ struct CUDA_Provider : Provider {
     cuda_options.cudnn_conv_use_max_workspace = internal_options.cudnn_conv_use_max_workspace;
     cuda_options.enable_cuda_graph = internal_options.enable_cuda_graph;
     cuda_options.cudnn_conv1d_pad_to_nc1d = internal_options.cudnn_conv1d_pad_to_nc1d;
+    cuda_options.enable_pinned_io_staging = internal_options.enable_pinned_io_staging;
+    cuda_options.num_compute_streams = internal_options.num_compute_streams;
+    cuda_options.use_mem_pool = internal_options.mem_pool_info.use_mem_pool;
+    cuda_options.mem_pool_release_threshold = internal_options.mem_pool_info.release_threshold;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
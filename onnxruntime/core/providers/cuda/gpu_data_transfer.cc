@@ -10,7 +10,26 @@
 // so we leave it as optional, in case user need the previous behavior
 // a full fix to BFC arena is being looked at, and once it's in, we can revert this change
 namespace onnxruntime {
-GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream) {
+namespace {
+struct CurrentComputeStream {
+  cudaStream_t default_stream = nullptr;
+  cudaStream_t stream = nullptr;
+};
+
+thread_local CurrentComputeStream current_compute_stream;
+}  // namespace
+
+cudaStream_t GetCurrentComputeStream(cudaStream_t default_stream) {
+  const auto& current = current_compute_stream;
+  return current.stream != nullptr && current.default_stream == default_stream ? current.stream : default_stream;
+}
+
+void SelectCurrentComputeStream(cudaStream_t default_stream, cudaStream_t stream) {
+  current_compute_stream.default_stream = default_stream;
+  current_compute_stream.stream = stream;
+}
+
+GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream, bool enable_pinned_io_staging) {
   // create streams, default is nullptr
   do_copy_in_default_stream_ = do_copy_in_default_stream;
   streams_[kCudaStreamDefault] = stream;
@@ -21,9 +40,14 @@ GPUDataTransfer::GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_st
     CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams_[kCudaStreamCopyIn], cudaStreamNonBlocking));
     CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams_[kCudaStreamCopyOut], cudaStreamNonBlocking));
   }
+  if (enable_pinned_io_staging) {
+    staging_pool_ = std::make_unique<CudaPinnedStagingPool>();
+  }
 }
 
 GPUDataTransfer::~GPUDataTransfer() {
+  // release the staging buffers first as they wait for the copies queued on the streams below
+  staging_pool_.reset();
   if (!do_copy_in_default_stream_ && streams_[kCudaStreamCopyIn] != nullptr) {
     CUDA_CALL(cudaStreamDestroy(streams_[kCudaStreamCopyIn]));
   }
@@ -44,6 +68,7 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
 
   auto& src_device = src.Location().device;
   auto& dst_device = dst.Location().device;
+  Status status;
 
   if (dst_device.Type() == OrtDevice::GPU) {
     if (src_device.Type() == OrtDevice::CPU && src_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
@@ -55,6 +80,9 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
       if (dst_data != src_data) {
         CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, GetStream(kCudaStreamDefault)));
       }
+    } else if (staging_pool_ && StagedCopyToDevice(src_data, dst_data, bytes, status)) {
+      // copy from other CPU memory to GPU through a pinned staging buffer, this is non-blocking
+      return status;
     } else {
       // copy from other CPU memory to GPU, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, GetStream(kCudaStreamDefault)));
@@ -64,6 +92,9 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
     if (dst_device.Type() == OrtDevice::CPU && dst_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
       // copying from GPU to pinned memory, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, GetStream(exec_queue_id)));
+    } else if (staging_pool_ && StagedCopyFromDevice(src_data, dst_data, bytes, status)) {
+      // copying from GPU to CPU memory through a pinned staging buffer, this only waits for the copy itself
+      return status;
     } else {
       // copying from GPU to CPU memory, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, GetStream(kCudaStreamDefault)));
@@ -76,4 +107,67 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
 
   return Status::OK();
 }
+
+bool GPUDataTransfer::StagedCopyToDevice(const void* src_data, void* dst_data, size_t bytes, Status& status) const {
+  CudaPinnedStagingPool::Buffer buffer;
+  if (!staging_pool_->Acquire(bytes, buffer)) {
+    return false;
+  }
+
+  // the source may be reused by the caller as soon as we return, so take a snapshot of it
+  memcpy(buffer.data, src_data, bytes);
+
+  status = [&]() -> Status {
+    cudaStream_t compute_stream = GetStream(kCudaStreamDefault);
+    cudaStream_t copy_stream = GetStream(kCudaStreamCopyIn);
+    if (copy_stream != compute_stream) {
+      // dst may be memory the arena just handed back from a kernel still queued on the compute stream
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer.event, compute_stream));
+      CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(copy_stream, buffer.event, 0));
+    }
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, buffer.data, bytes, cudaMemcpyHostToDevice, copy_stream));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer.event, copy_stream));
+    if (copy_stream != compute_stream) {
+      // kernels consuming dst are queued on the compute stream
+      CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(compute_stream, buffer.event, 0));
+    }
+    return Status::OK();
+  }();
+
+  if (!status.IsOK()) {
+    // the buffer may still be referenced by a queued copy, so wait for it before handing it back
+    CUDA_CALL(cudaStreamSynchronize(GetStream(kCudaStreamCopyIn)));
+  }
+  staging_pool_->Release(buffer);
+  return true;
+}
+
+bool GPUDataTransfer::StagedCopyFromDevice(const void* src_data, void* dst_data, size_t bytes, Status& status) const {
+  CudaPinnedStagingPool::Buffer buffer;
+  if (!staging_pool_->Acquire(bytes, buffer)) {
+    return false;
+  }
+
+  status = [&]() -> Status {
+    cudaStream_t compute_stream = GetStream(kCudaStreamDefault);
+    cudaStream_t copy_stream = GetStream(kCudaStreamCopyOut);
+    if (copy_stream != compute_stream) {
+      // src is produced by kernels queued on the compute stream
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer.event, compute_stream));
+      CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(copy_stream, buffer.event, 0));
+    }
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(buffer.data, src_data, bytes, cudaMemcpyDeviceToHost, copy_stream));
+    // only wait for the work queued up to this copy rather than everything on the stream
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(buffer.event, copy_stream));
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(buffer.event));
+    memcpy(dst_data, buffer.data, bytes);
+    return Status::OK();
+  }();
+
+  if (!status.IsOK()) {
+    CUDA_CALL(cudaStreamSynchronize(GetStream(kCudaStreamCopyOut)));
+  }
+  staging_pool_->Release(buffer);
+  return true;
+}
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
+#include "core/providers/cuda/cuda_pinned_staging_pool.h"
 
 namespace onnxruntime {
 
@@ -15,9 +16,16 @@ enum CUDAStreamType : int {
   kTotalCudaStreams,
 };
 
+// Compute stream that the calling thread selected in place of `default_stream`, the compute stream of a CUDA
+// execution provider, see CUDAExecutionProvider::SetCurrentComputeStream(). Returns `default_stream` if the thread
+// didn't select another stream.
+cudaStream_t GetCurrentComputeStream(cudaStream_t default_stream);
+// Selects `stream` in place of `default_stream` for the calling thread, nullptr selects `default_stream` again.
+void SelectCurrentComputeStream(cudaStream_t default_stream, cudaStream_t stream);
+
 class GPUDataTransfer : public IDataTransfer {
  public:
-  GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream = true);
+  GPUDataTransfer(cudaStream_t stream, bool do_copy_in_default_stream = true, bool enable_pinned_io_staging = false);
   ~GPUDataTransfer();
 
   bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override;
@@ -28,12 +36,20 @@ class GPUDataTransfer : public IDataTransfer {
 
   cudaStream_t GetStream(int queue_id) const {
     ORT_ENFORCE(queue_id >= 0 && queue_id < kTotalCudaStreams);
-    return streams_[queue_id];
+    // copies on the compute stream follow the compute stream selected for the calling thread
+    return streams_[queue_id] == streams_[kCudaStreamDefault] ? GetCurrentComputeStream(streams_[kCudaStreamDefault])
+                                                              : streams_[queue_id];
   }
 
  private:
+  // Copies between pageable CPU memory and the device through a pinned staging buffer.
+  // Returns false (without copying) if no staging buffer is available.
+  bool StagedCopyToDevice(const void* src_data, void* dst_data, size_t bytes, common::Status& status) const;
+  bool StagedCopyFromDevice(const void* src_data, void* dst_data, size_t bytes, common::Status& status) const;
+
   bool do_copy_in_default_stream_;
   cudaStream_t streams_[kTotalCudaStreams];
+  std::unique_ptr<CudaPinnedStagingPool> staging_pool_;
 };
 
 }  // namespace onnxruntime
@@ -92,7 +92,10 @@ Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, Bin
       ver,                                                                                 \
       T,                                                                                   \
       kCudaExecutionProvider,                                                              \
-      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      (*KernelDefBuilder::Create())                                                        \
+          .MayInplace(0, 0)                                                                \
+          .MayInplace(1, 0)                                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),                          \
       class_name<T>);
 
 #define BINARY_ELEMENTWISE_REGISTER_KERNEL_TYPED(x, ver, T) \
@@ -136,7 +139,10 @@ Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, Bin
       endver,                                                                              \
       T,                                                                                   \
       kCudaExecutionProvider,                                                              \
-      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      (*KernelDefBuilder::Create())                                                        \
+          .MayInplace(0, 0)                                                                \
+          .MayInplace(1, 0)                                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),                          \
       x<T>);
 
 #define BINARY_ELEMENTWISE_REGISTER_KERNEL_VERSIONED_TYPED_CLASS(x, class_name, startver, endver, T) \
@@ -147,7 +153,10 @@ Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, Bin
       endver,                                                                                        \
       T,                                                                                             \
       kCudaExecutionProvider,                                                                        \
-      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),           \
+      (*KernelDefBuilder::Create())                                                                  \
+          .MayInplace(0, 0)                                                                          \
+          .MayInplace(1, 0)                                                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),                                    \
       class_name<T>);
 
 #define BINARY_ELEMENTWISE_COMPUTE(x, T)                                                                         \
@@ -15,6 +15,7 @@ ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(
     float,
     kCudaExecutionProvider,
     (*KernelDefBuilder::Create())
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Clip_6<float>);
 
@@ -24,6 +25,7 @@ ONNX_OPERATOR_VERSIONED_KERNEL_EX(
     11, 11,
     kCudaExecutionProvider,
     (*KernelDefBuilder::Create())
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Clip);
 
@@ -33,6 +35,7 @@ ONNX_OPERATOR_VERSIONED_KERNEL_EX(
     12, 12,
     kCudaExecutionProvider,
     (*KernelDefBuilder::Create())
+        .MayInplace(0, 0)
         .TypeConstraint("T", BuildKernelDefConstraints<float, double, MLFloat16, int8_t, uint8_t, int64_t, uint64_t>()),
     Clip);
 
@@ -42,6 +45,7 @@ ONNX_OPERATOR_KERNEL_EX(
     13,
     kCudaExecutionProvider,
     (*KernelDefBuilder::Create())
+        .MayInplace(0, 0)
         .TypeConstraint("T", BuildKernelDefConstraints<float, double, MLFloat16, int8_t, uint8_t, int64_t, uint64_t>()),
     Clip);
 
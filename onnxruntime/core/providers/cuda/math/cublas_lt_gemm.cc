@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/math/cublas_lt_gemm.h"
+
+#if CUDART_VERSION >= 11040
+
+#include <cublasLt.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+namespace onnxruntime {
+namespace cuda {
+
+namespace {
+
+// device, data type, transposes, m, n, k, leading dimensions, epilogue, alignment and workspace size
+using AlgoKey = std::tuple<int, int, int, int, int, int, int, int, int, int, int, uint32_t, size_t>;
+
+// The algorithms found for each GEMM, or nullopt if the heuristics found none.
+struct AlgoCache {
+  std::mutex mutex;
+  std::map<AlgoKey, std::optional<cublasLtMatmulAlgo_t>> algos;
+};
+
+AlgoCache& GetAlgoCache() {
+  static AlgoCache cache;
+  return cache;
+}
+
+// Largest power of two, up to 256, that divides all the addresses.
+uint32_t GetAlignment(std::initializer_list<const void*> pointers) {
+  uint32_t alignment = 256;
+  for (const void* pointer : pointers) {
+    const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+    while (address % alignment != 0) {
+      alignment /= 2;
+    }
+  }
+  return alignment;
+}
+
+// Owns the descriptors of a cuBLASLt GEMM.
+struct LtGemmDescriptors {
+  cublasLtMatmulDesc_t operation = nullptr;
+  cublasLtMatrixLayout_t a = nullptr;
+  cublasLtMatrixLayout_t b = nullptr;
+  cublasLtMatrixLayout_t c = nullptr;
+  cublasLtMatmulPreference_t preference = nullptr;
+
+  ~LtGemmDescriptors() {
+    if (preference != nullptr) cublasLtMatmulPreferenceDestroy(preference);
+    if (c != nullptr) cublasLtMatrixLayoutDestroy(c);
+    if (b != nullptr) cublasLtMatrixLayoutDestroy(b);
+    if (a != nullptr) cublasLtMatrixLayoutDestroy(a);
+    if (operation != nullptr) cublasLtMatmulDescDestroy(operation);
+  }
+};
+
+}  // namespace
+
+#define CUBLAS_LT_RETURN_IF_ERROR(expr)     \
+  do {                                      \
+    const cublasStatus_t status_ = (expr);  \
+    if (status_ != CUBLAS_STATUS_SUCCESS) { \
+      return status_;                       \
+    }                                       \
+  } while (0)
+
+cublasStatus_t CublasLtGemmWithEpilogue(cublasHandle_t cublas,
+                                        cudaStream_t stream,
+                                        int device_id,
+                                        cudaDataType_t data_type,
+                                        cublasOperation_t trans_a,
+                                        cublasOperation_t trans_b,
+                                        int m, int n, int k,
+                                        float alpha,
+                                        const void* a, int lda,
+                                        const void* b, int ldb,
+                                        const void* bias,
+                                        void* c, int ldc,
+                                        GemmEpilogueActivation activation,
+                                        void* workspace,
+                                        size_t workspace_size) {
+  // A cuBLAS handle holds a cuBLASLt handle and can be used as one.
+  cublasLtHandle_t cublas_lt = reinterpret_cast<cublasLtHandle_t>(cublas);
+
+  cublasLtEpilogue_t epilogue = CUBLASLT_EPILOGUE_DEFAULT;
+  switch (activation) {
+    case GemmEpilogueActivation::None:
+      epilogue = bias != nullptr ? CUBLASLT_EPILOGUE_BIAS : CUBLASLT_EPILOGUE_DEFAULT;
+      break;
+    case GemmEpilogueActivation::Relu:
+      epilogue = bias != nullptr ? CUBLASLT_EPILOGUE_RELU_BIAS : CUBLASLT_EPILOGUE_RELU;
+      break;
+    case GemmEpilogueActivation::Gelu:
+      epilogue = bias != nullptr ? CUBLASLT_EPILOGUE_GELU_BIAS : CUBLASLT_EPILOGUE_GELU;
+      break;
+  }
+
+  LtGemmDescriptors desc;
+  CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulDescCreate(&desc.operation, CUBLAS_COMPUTE_32F, CUDA_R_32F));
+  CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.operation, CUBLASLT_MATMUL_DESC_TRANSA,
+                                                           &trans_a, sizeof(trans_a)));
+  CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.operation, CUBLASLT_MATMUL_DESC_TRANSB,
+                                                           &trans_b, sizeof(trans_b)));
+  CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.operation, CUBLASLT_MATMUL_DESC_EPILOGUE,
+                                                           &epilogue, sizeof(epilogue)));
+  if (bias != nullptr) {
+    CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.operation, CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                                             &bias, sizeof(bias)));
+  }
+
+  // the layouts describe the stored matrices, before the transposes
+  CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc.a, data_type, trans_a == CUBLAS_OP_N ? m : k,
+                                                       trans_a == CUBLAS_OP_N ? k : m, lda));
+  CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc.b, data_type, trans_b == CUBLAS_OP_N ? k : n,
+                                                       trans_b == CUBLAS_OP_N ? n : k, ldb));
+  CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc.c, data_type, m, n, ldc));
+
+  // An algorithm picked for aligned pointers may not run on less aligned ones, so the alignment is part of the key.
+  const uint32_t alignment = GetAlignment({a, b, c, bias});
+  const AlgoKey key{device_id, static_cast<int>(data_type), static_cast<int>(trans_a), static_cast<int>(trans_b),
+                    m, n, k, lda, ldb, ldc, static_cast<int>(epilogue), alignment, workspace_size};
+
+  std::optional<cublasLtMatmulAlgo_t> algo;
+  auto& cache = GetAlgoCache();
+  bool cached = false;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.algos.find(key);
+    if (it != cache.algos.end()) {
+      algo = it->second;
+      cached = true;
+    }
+  }
+
+  if (!cached) {
+    CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulPreferenceCreate(&desc.preference));
+    CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(
+        desc.preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspace_size, sizeof(workspace_size)));
+    for (auto attribute : {CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES,
+                           CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES}) {
+      CUBLAS_LT_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(desc.preference, attribute,
+                                                                     &alignment, sizeof(alignment)));
+    }
+
+    cublasLtMatmulHeuristicResult_t result{};
+    int result_count = 0;
+    const cublasStatus_t status = cublasLtMatmulAlgoGetHeuristic(cublas_lt, desc.operation, desc.a, desc.b,
+                                                                 desc.c, desc.c, desc.preference, 1, &result,
+                                                                 &result_count);
+    if (status != CUBLAS_STATUS_SUCCESS && status != CUBLAS_STATUS_NOT_SUPPORTED) {
+      return status;
+    }
+    if (status == CUBLAS_STATUS_SUCCESS && result_count > 0) {
+      algo = result.algo;
+    }
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.algos.emplace(key, algo);
+  }
+
+  if (!algo.has_value()) {
+    return CUBLAS_STATUS_NOT_SUPPORTED;
+  }
+
+  const float beta = 0.0f;
+  return cublasLtMatmul(cublas_lt, desc.operation, &alpha, a, desc.a, b, desc.b, &beta, c, desc.c, c, desc.c,
+                        &*algo, workspace, workspace_size, stream);
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cublas_v2.h>
+#include <cuda_runtime.h>
+
+namespace onnxruntime {
+namespace cuda {
+
+#if CUDART_VERSION >= 11040
+
+enum class GemmEpilogueActivation {
+  None,
+  Relu,
+  Gelu,  // the tanh approximation, as FastGelu
+};
+
+// Workspace given to cuBLASLt, which lets the heuristics pick split-K algorithms for GEMMs with few rows.
+constexpr size_t kCublasLtGemmWorkspaceSize = 4 * 1024 * 1024;
+
+// Computes the column major C(m, n) = activation(alpha * op(A) x op(B) + bias(m)) in a single cuBLASLt GEMM, where
+// bias may be null. The algorithm returned by the cuBLASLt heuristics is cached for each device, shape, alignment of
+// the pointers and epilogue, so the heuristics run once per shape instead of on every call.
+// Returns CUBLAS_STATUS_NOT_SUPPORTED if cuBLASLt has no algorithm for these arguments, so the caller can fall back
+// to a cuBLAS GEMM followed by separate kernels.
+cublasStatus_t CublasLtGemmWithEpilogue(cublasHandle_t cublas,
+                                        cudaStream_t stream,
+                                        int device_id,
+                                        cudaDataType_t data_type,
+                                        cublasOperation_t trans_a,
+                                        cublasOperation_t trans_b,
+                                        int m, int n, int k,
+                                        float alpha,
+                                        const void* a, int lda,
+                                        const void* b, int ldb,
+                                        const void* bias,
+                                        void* c, int ldc,
+                                        GemmEpilogueActivation activation,
+                                        void* workspace,
+                                        size_t workspace_size);
+
+#endif
+
+}  // namespace cuda
+}  // namespace onnxruntime
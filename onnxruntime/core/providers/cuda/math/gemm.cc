@@ -4,6 +4,7 @@
 #include "core/providers/cuda/math/gemm.h"
 #include "core/providers/cpu/math/gemm_helper.h"
 #include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/math/cublas_lt_gemm.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 
 namespace onnxruntime {
@@ -74,6 +75,36 @@ Status Gemm<T>::ComputeInternal(OpKernelContext* ctx) const {
   auto* Y = ctx->Output(0, {M, N});
   CudaT* out_data = reinterpret_cast<CudaT*>(Y->template MutableData<T>());
 
+#if CUDART_VERSION >= 11040
+  // A bias of shape (N,) or (1, N) is added in the epilogue of a cuBLASLt GEMM, instead of being broadcast into Y
+  // by a GEMM of its own before the main one. Float keeps the cuBLAS path, which uses TF32 tensor cores.
+  if constexpr (std::is_same<T, MLFloat16>::value || std::is_same<T, BFloat16>::value) {
+    if (beta_ == 1.0f && B != nullptr && B->Shape().Size() == N &&
+        (B->Shape().NumDimensions() == 1 || B->Shape()[0] == 1) && M > 0 && N > 0 && K > 0) {
+      auto workspace = GetScratchBuffer<void>(kCublasLtGemmWorkspaceSize);
+      auto lt_status = CublasLtGemmWithEpilogue(
+          CublasHandle(), Stream(), GetDeviceId(),
+          std::is_same<T, MLFloat16>::value ? CUDA_R_16F : CUDA_R_16BF,
+          trans_B_ ? CUBLAS_OP_T : CUBLAS_OP_N,
+          trans_A_ ? CUBLAS_OP_T : CUBLAS_OP_N,
+          N, M, K,
+          alpha_,
+          W->DataRaw(), (trans_B_ ? K : N),
+          X->DataRaw(), (trans_A_ ? M : K),
+          B->DataRaw(),
+          out_data, N,
+          GemmEpilogueActivation::None,
+          workspace.get(), kCublasLtGemmWorkspaceSize);
+      if (lt_status == CUBLAS_STATUS_SUCCESS) {
+        return Status::OK();
+      }
+      if (lt_status != CUBLAS_STATUS_NOT_SUPPORTED) {
+        CUBLAS_RETURN_IF_ERROR(lt_status);
+      }
+    }
+  }
+#endif
+
   CudaT one = ToCudaType<T>::FromFloat(1.0f);
   CudaT zero = ToCudaType<T>::FromFloat(0.0f);
   auto& device_prop = GetDeviceProp();
@@ -21,7 +21,9 @@ Status UnaryElementwise::Prepare(OpKernelContext* context, UnaryElementwisePrepa
       endver,                                                                              \
       T,                                                                                   \
       kCudaExecutionProvider,                                                              \
-      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      (*KernelDefBuilder::Create())                                                        \
+          .MayInplace(0, 0)                                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),                          \
       x<T>);
 
 #define UNARY_ELEMENTWISE_REGISTER_KERNEL(x, ver, T)                                       \
@@ -31,7 +33,9 @@ Status UnaryElementwise::Prepare(OpKernelContext* context, UnaryElementwisePrepa
       ver,                                                                                 \
       T,                                                                                   \
       kCudaExecutionProvider,                                                              \
-      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      (*KernelDefBuilder::Create())                                                        \
+          .MayInplace(0, 0)                                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),                          \
       x<T>);
 
 #define UNARY_ELEMENTWISE_LOGICALOP_REGISTER_KERNEL_TYPED(x, ver, T)  \
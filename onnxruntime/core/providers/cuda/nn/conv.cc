@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <sstream>
+
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/nn/conv.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
@@ -50,6 +52,14 @@ cudnnStatus_t GetWorkspaceSize(const CudnnConvState<cudnnConvolutionFwdAlgoPerf_
   return cudnnGetConvolutionForwardWorkspaceSize(s.handle, s.x_tensor, s.w_desc, s.conv_desc, s.y_tensor, algo, sz);
 }
 
+// The algorithm found for a convolution depends on the GPU and on the cuDNN version, so both are part of the device key
+// of its entries in the kernel tuning database.
+std::string GetCudnnConvTuningDeviceKey(const cudaDeviceProp& prop) {
+  std::ostringstream ss;
+  ss << "cuda:" << prop.name << ":sm" << prop.major << prop.minor << ":cudnn" << cudnnGetVersion();
+  return ss.str();
+}
+
 size_t GetMaxWorkspaceSize(const CudnnConvState<cudnnConvolutionFwdAlgoPerf_t>& s,
                            const cudnnConvolutionFwdAlgo_t* algo, int n_algo) {
   // TODO: get maximum available size from memory areana
@@ -266,6 +276,36 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
       ORT_ENFORCE(cudnn_conv_algo > -1 && cudnn_conv_algo < 3, "cudnn_conv_algo should be 0, 1 or 2, but got ", cudnn_conv_algo);
       switch (cudnn_conv_algo) {
         case 0: {
+          // The exhaustive search runs every algorithm, so with a kernel tuning database its result is shared by the
+          // sessions of the process and saved for later ones. The variant encodes the algorithm and the math type.
+          auto& tuning_database = KernelTuningDatabase::Instance();
+          const bool use_tuning_database = tuning_database.IsEnabled();
+          std::string tuning_device;
+          std::string tuning_key;
+          if (use_tuning_database) {
+            std::ostringstream key;
+            key << "CudnnConv:X" << TensorShape(x_dims_cudnn) << ":W" << TensorShape(w_dims)
+                << ":pads" << TensorShape(pads.data(), pads.size())
+                << ":strides" << TensorShape(strides)
+                << ":dilations" << TensorShape(dilations)
+                << ":group" << conv_attrs_.group
+                << ":type" << static_cast<int>(CudnnTensor::GetDataType<CudaT>())
+                << ":max_workspace" << cuda_ep->GetCudnnConvUseMaxWorkspace();
+            tuning_device = GetCudnnConvTuningDeviceKey(cuda_ep->GetDeviceProp());
+            tuning_key = key.str();
+
+            int variant = -1;
+            if (tuning_database.Lookup(tuning_device, tuning_key, variant) &&
+                variant < CUDNN_CONVOLUTION_FWD_ALGO_COUNT * (CUDNN_FMA_MATH + 1)) {
+              perf.algo = static_cast<cudnnConvolutionFwdAlgo_t>(variant % CUDNN_CONVOLUTION_FWD_ALGO_COUNT);
+              perf.mathType = static_cast<cudnnMathType_t>(variant / CUDNN_CONVOLUTION_FWD_ALGO_COUNT);
+              // The workspace size depends on the math type of the descriptor.
+              CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
+              CUDNN_RETURN_IF_ERROR(GetWorkspaceSize(s_, perf.algo, &perf.memory));
+              break;
+            }
+          }
+
           static constexpr int num_algos = CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
           size_t max_ws_size = cuda_ep->GetCudnnConvUseMaxWorkspace() ? GetMaxWorkspaceSize(s_, kAllAlgos, num_algos)
                                                                       : AlgoSearchWorkspaceSize;
@@ -286,6 +326,12 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
               &perf,
               algo_search_workspace.get(),
               max_ws_size));
+
+          if (use_tuning_database) {
+            tuning_database.Record(tuning_device, tuning_key,
+                                   static_cast<int>(perf.mathType) * CUDNN_CONVOLUTION_FWD_ALGO_COUNT +
+                                       static_cast<int>(perf.algo));
+          }
           break;
         }
         case 1:
@@ -24,7 +24,7 @@
 namespace onnxruntime {
 namespace cuda {
 
-constexpr int UNROLL = 4;
+constexpr int UNROLL = kDropoutUnroll;
 
 template <typename T>
 __global__ void DropoutKernel(
@@ -129,18 +129,16 @@ void DropoutKernelImpl(
     const T* X_data,
     T* Y_data,
     bool* mask_data) {
-  const int block_size = 256;
-  const int blocks_per_sm = prop.maxThreadsPerMultiProcessor / block_size;
-  const int grid_size = std::min(prop.multiProcessorCount * blocks_per_sm, static_cast<int>(CeilDiv(N, block_size * UNROLL)));
+  const int grid_size = DropoutGridSize(prop, N);
 
   // Compute the number of random numbers generated by each thread, and increment philox generator offset by that amount.
-  const uint64_t counter_offset = static_cast<uint64_t>(((N - 1) / (block_size * grid_size * UNROLL) + 1) * UNROLL);
+  const uint64_t counter_offset = DropoutCounterOffset(grid_size, N);
   auto seeds = generator.NextPhiloxSeeds(counter_offset);
 
   if ( N % UNROLL != 0) {
-    DropoutKernel<T><<<grid_size, block_size, 0, stream>>>(N, ratio, seeds, X_data, Y_data, mask_data);
+    DropoutKernel<T><<<grid_size, kDropoutBlockSize, 0, stream>>>(N, ratio, seeds, X_data, Y_data, mask_data);
   } else {
-    DropoutVectorizedKernel<T><<<grid_size, block_size, 0, stream>>>(N, ratio, seeds, X_data, Y_data, mask_data);
+    DropoutVectorizedKernel<T><<<grid_size, kDropoutBlockSize, 0, stream>>>(N, ratio, seeds, X_data, Y_data, mask_data);
   }
 }
 
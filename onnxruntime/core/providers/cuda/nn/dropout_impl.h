@@ -3,11 +3,32 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "core/framework/random_generator.h"
 
 namespace onnxruntime {
 namespace cuda {
 
+// Launch configuration of the dropout kernels. Every thread draws its random numbers from its own Philox subsequence,
+// so the mask generated from a seed and offset depends on the grid. Kernels regenerating a mask from the seed and
+// offset of a dropout launch, instead of reading a stored mask, must use the same configuration.
+constexpr int kDropoutBlockSize = 256;
+constexpr int kDropoutUnroll = 4;
+
+inline int DropoutGridSize(const cudaDeviceProp& prop, const int64_t N) {
+  const int blocks_per_sm = prop.maxThreadsPerMultiProcessor / kDropoutBlockSize;
+  const int64_t elements_per_block = static_cast<int64_t>(kDropoutBlockSize) * kDropoutUnroll;
+  return static_cast<int>(std::min<int64_t>(static_cast<int64_t>(prop.multiProcessorCount) * blocks_per_sm,
+                                            (N + elements_per_block - 1) / elements_per_block));
+}
+
+// The number of random numbers each thread generates, i.e. how far a launch advances the Philox offset.
+inline uint64_t DropoutCounterOffset(const int grid_size, const int64_t N) {
+  return static_cast<uint64_t>(((N - 1) / (static_cast<int64_t>(kDropoutBlockSize) * grid_size * kDropoutUnroll) + 1) *
+                               kDropoutUnroll);
+}
+
 template <typename T>
 void DropoutKernelImpl(
   const cudaDeviceProp& prop,
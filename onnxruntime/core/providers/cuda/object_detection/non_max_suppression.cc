@@ -4,7 +4,6 @@
 #include "non_max_suppression.h"
 #include "core/providers/cpu/object_detection/non_max_suppression_helper.h"
 #include "non_max_suppression_impl.h"
-#include "core/providers/cuda/tensor/concat_impl.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -49,86 +48,72 @@ Status NonMaxSuppression::ComputeInternal(OpKernelContext* ctx) const {
   // TODO: use cub::DeviceSegmentedRadixSort::SortPairsDescending instead of cub::DeviceRadixSort::SortPairsDescending
   //       to deal with multi batch/class parallelly
 
-  std::vector<std::tuple<IAllocatorUniquePtr<void>, int>> all_selected_indices;
-  int total_num_saved_outputs = 0;
-
   // safe downcast max_output_boxes_per_class to int as cub::DeviceSelect::Flagged() does not support int64_t
   int int_max_output_boxes_per_class = max_output_boxes_per_class > std::numeric_limits<int>::max()
                                            ? std::numeric_limits<int>::max()
                                            : static_cast<int>(max_output_boxes_per_class);
 
+  // The counts of all the (batch, class) pairs stay on the device between the phases and are read back with one
+  // copy per phase, instead of synchronizing the stream twice for every pair.
+  const int64_t num_pairs = pc.num_batches_ * pc.num_classes_;
+  auto allocator = [this](size_t bytes) { return GetScratchBuffer<void>(bytes); };
+  std::vector<NmsSortedBoxes> sorted(num_pairs);
+  IAllocatorUniquePtr<int> d_counts = GetScratchBuffer<int>(2 * num_pairs);
+  IAllocatorUniquePtr<int> h_counts = AllocateBufferOnCPUPinned<int>(2 * num_pairs);
+  int* d_num_boxes = d_counts.get();
+  int* d_num_selected = d_counts.get() + num_pairs;
+  int* h_num_boxes = h_counts.get();
+  int* h_num_selected = h_counts.get() + num_pairs;
+
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
     for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      IAllocatorUniquePtr<void> d_selected_indices{};
-      IAllocatorUniquePtr<void> h_number_selected_ptr{AllocateBufferOnCPUPinned<void>(sizeof(int))};
-      auto* h_number_selected = static_cast<int*>(h_number_selected_ptr.get());
-
-      ORT_RETURN_IF_ERROR(NonMaxSuppressionImpl(
-          Stream(),
-          [this](size_t bytes) { return GetScratchBuffer<void>(bytes); },
-          pc,
-          GetCenterPointBox(),
-          batch_index,
-          class_index,
-          int_max_output_boxes_per_class,
-          iou_threshold,
-          score_threshold,
-          d_selected_indices,
-          h_number_selected));
-
-      int num_saved_outputs = *h_number_selected;
-      if (num_saved_outputs > 0) {
-        all_selected_indices.emplace_back(std::move(d_selected_indices), num_saved_outputs);
-        total_num_saved_outputs += num_saved_outputs;
-      }
+      const int64_t pair = batch_index * pc.num_classes_ + class_index;
+      ORT_RETURN_IF_ERROR(NonMaxSuppressionSortBoxes(Stream(), allocator, pc, batch_index, class_index,
+                                                     score_threshold, sorted[pair], d_num_boxes + pair));
     }
   }
 
-  if (total_num_saved_outputs == 0) {
-    ctx->Output(0, {0, 3});
+  if (pc.score_threshold_ != nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(h_num_boxes, d_num_boxes, num_pairs * sizeof(int), cudaMemcpyDeviceToHost,
+                                         Stream()));
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(Stream()));
   } else {
-    // concatenate outputs
-    const int last_dim = 3;
-    const int num_elements = last_dim * total_num_saved_outputs;
-    Tensor* output = ctx->Output(0, {static_cast<int64_t>(total_num_saved_outputs), last_dim});
-    ORT_ENFORCE(output != nullptr);
-    int64_t* dst = output->MutableData<int64_t>();
-    size_t count = all_selected_indices.size();
-
-    CudaAsyncBuffer<const void*> input_ptr(this, count);
-    CudaAsyncBuffer<int64_t> concat_sizes_gpu(this, count);
-    CudaAsyncBuffer<int64_t> concat_sizes_range_gpu(this, count);
-    CudaAsyncBuffer<int64_t> axis_dimension_input_output_mapping_gpu(this, total_num_saved_outputs);
-
-    int index = 0;
-    for (size_t i = 0; i < count; i++) {
-      auto& it = all_selected_indices[i];
-      auto src = std::get<0>(it).get();
-      auto size = std::get<1>(it);
-
-      input_ptr.CpuPtr()[i] = src;
-      concat_sizes_gpu.CpuPtr()[i] = size;
-      concat_sizes_range_gpu.CpuPtr()[i] = (i == 0) ? size : size + concat_sizes_range_gpu.CpuPtr()[i - 1];
-      for (int j = 0; j < size; j++) {
-        axis_dimension_input_output_mapping_gpu.CpuPtr()[index++] = i;
-      }
+    std::fill_n(h_num_boxes, num_pairs, pc.num_boxes_);
+  }
+
+  for (int64_t pair = 0; pair < num_pairs; ++pair) {
+    if (h_num_boxes[pair] > 0) {
+      ORT_RETURN_IF_ERROR(NonMaxSuppressionSelectBoxes(Stream(), allocator, GetCenterPointBox(), h_num_boxes[pair],
+                                                       int_max_output_boxes_per_class, iou_threshold, sorted[pair],
+                                                       d_num_selected + pair));
+    }
+  }
+
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(h_num_selected, d_num_selected, num_pairs * sizeof(int),
+                                       cudaMemcpyDeviceToHost, Stream()));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(Stream()));
+
+  int64_t total_num_saved_outputs = 0;
+  for (int64_t pair = 0; pair < num_pairs; ++pair) {
+    // the selection is skipped for a pair without any box above the score threshold
+    if (h_num_boxes[pair] == 0) {
+      h_num_selected[pair] = 0;
     }
+    h_num_selected[pair] = std::min(h_num_selected[pair], int_max_output_boxes_per_class);
+    total_num_saved_outputs += h_num_selected[pair];
+  }
+
+  Tensor* output = ctx->Output(0, {total_num_saved_outputs, 3});
+  ORT_ENFORCE(output != nullptr);
+  int64_t* dst = output->MutableData<int64_t>();
 
-    ORT_RETURN_IF_ERROR(concat_sizes_gpu.CopyToGpu());
-    ORT_RETURN_IF_ERROR(axis_dimension_input_output_mapping_gpu.CopyToGpu());
-    ORT_RETURN_IF_ERROR(concat_sizes_range_gpu.CopyToGpu());
-    ORT_RETURN_IF_ERROR(input_ptr.CopyToGpu());
-
-    ORT_RETURN_IF_ERROR(ConcatImpl(Stream(),
-                                   sizeof(int64_t),
-                                   num_elements,
-                                   last_dim,
-                                   concat_sizes_gpu.GpuPtr(),
-                                   concat_sizes_range_gpu.GpuPtr(),
-                                   axis_dimension_input_output_mapping_gpu.GpuPtr(),
-                                   dst,
-                                   input_ptr.GpuPtr(),
-                                   static_cast<size_t>(num_elements)));
+  for (int64_t pair = 0; pair < num_pairs; ++pair) {
+    const int num_saved_outputs = h_num_selected[pair];
+    if (num_saved_outputs > 0) {
+      ORT_RETURN_IF_ERROR(NonMaxSuppressionWriteOutput(Stream(), allocator, sorted[pair], num_saved_outputs,
+                                                       pair / pc.num_classes_, pair % pc.num_classes_, dst));
+      dst += static_cast<int64_t>(num_saved_outputs) * 3;
+    }
   }
 
   return Status::OK();
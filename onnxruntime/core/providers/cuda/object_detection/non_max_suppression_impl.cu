@@ -14,9 +14,6 @@ limitations under the License.
 ==============================================================================*/
 /* Modifications Copyright (c) Microsoft. */
 
-#include <thrust/device_vector.h>
-#include <thrust/execution_policy.h>
-
 #include "non_max_suppression_impl.h"
 #include "core/providers/cpu/object_detection/non_max_suppression_helper.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
@@ -227,6 +224,20 @@ __global__ void NormalizeOutput(const int num_elements, const int* original, int
   }
 }
 
+// Counts the sorted scores above the threshold, the scores are in descending order so the count is the position of
+// the last one above the threshold plus one.
+__global__ void CountAboveThreshold(const int num_elements, const float* sorted_scores, float threshold, int* count) {
+  for (int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_elements; idx += blockDim.x * gridDim.x) {
+    const bool above = sorted_scores[idx] > threshold;
+    const bool next_above = (idx + 1 < num_elements) && sorted_scores[idx + 1] > threshold;
+    if (above && !next_above) {
+      *count = idx + 1;
+    } else if (idx == 0 && !above) {
+      *count = 0;
+    }
+  }
+}
+
 Status NmsGpu(cudaStream_t stream,
               std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
               const int64_t center_point_box,
@@ -234,7 +245,7 @@ Status NmsGpu(cudaStream_t stream,
               const int num_boxes,
               const float iou_threshold,
               int* d_selected_indices,
-              int* h_nkeep,
+              int* d_num_selected,
               const int max_boxes) {
   // Making sure we respect the __align(16)__
   // we promised to the compiler.
@@ -252,7 +263,6 @@ Status NmsGpu(cudaStream_t stream,
   SetZero<int><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(max_nms_mask_size, d_nms_mask);
 
   int* d_delete_mask = d_nms_mask;
-  int* h_selected_count = h_nkeep;
   const Box* d_sorted_boxes =
       reinterpret_cast<const Box*>(d_sorted_boxes_float_ptr);
   dim3 block_dim, thread_block;
@@ -293,9 +303,8 @@ Status NmsGpu(cudaStream_t stream,
 
   IAllocatorUniquePtr<void> d_cub_scratch_buffer_ptr{allocator(flagged_buffer_size)};
   auto* d_cub_scratch_buffer = static_cast<uint8_t*>(d_cub_scratch_buffer_ptr.get());
-  IAllocatorUniquePtr<void> d_num_selected_ptr{allocator(sizeof(int))};
-  auto* d_num_selected = static_cast<int*>(d_num_selected_ptr.get());
 
+  // the number of selected boxes stays on the device, the caller reads the counts of all the classes at once
   CUDA_RETURN_IF_ERROR(cub::DeviceSelect::Flagged(
       d_cub_scratch_buffer,  // temp_storage
       flagged_buffer_size,
@@ -303,37 +312,21 @@ Status NmsGpu(cudaStream_t stream,
       d_selected_boxes,    // selection flag
       d_selected_indices,  // selected items
       d_num_selected, num_boxes, stream));
-  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(h_selected_count, d_num_selected, sizeof(int), cudaMemcpyDeviceToHost, stream));
-  // cudaStreamSynchronize is needed since the value of h_selected_count will be used by host after this function.
-  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
 
   return Status::OK();
 }
 
-struct DeviceGreaterThan {
-  float threshold_;
-  __host__ __device__ __forceinline__ DeviceGreaterThan(float threshold)
-      : threshold_(threshold) {}
-
-  __host__ __device__ __forceinline__ bool operator()(const float& val) const {
-    return (val > threshold_);
-  }
-};
-
 }  // namespace
 
-Status NonMaxSuppressionImpl(
+Status NonMaxSuppressionSortBoxes(
     cudaStream_t stream,
     std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
     const PrepareContext& pc,
-    const int64_t center_point_box,
     int64_t batch_index,
     int64_t class_index,
-    int max_output_boxes_per_class,
-    float iou_threshold,
     float score_threshold,
-    IAllocatorUniquePtr<void>& selected_indices,
-    int* h_number_selected) {
+    NmsSortedBoxes& sorted,
+    int* d_num_boxes) {
   // STEP 1. Prepare data
   int num_boxes = pc.num_boxes_;
   const float* boxes_data = pc.boxes_data_ + batch_index * num_boxes * 4;
@@ -358,14 +351,13 @@ Status NonMaxSuppressionImpl(
   auto* d_cub_sort_buffer = static_cast<uint8_t*>(d_cub_sort_buffer_ptr.get());
   IAllocatorUniquePtr<void> d_indices_ptr{allocator(num_boxes * sizeof(int))};
   auto* d_indices = static_cast<int*>(d_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_sorted_indices = static_cast<int*>(d_sorted_indices_ptr.get());
-  IAllocatorUniquePtr<void> d_selected_indices_ptr{allocator(num_boxes * sizeof(int))};
-  auto* d_selected_indices = static_cast<int*>(d_selected_indices_ptr.get());
+  sorted.sorted_indices = allocator(num_boxes * sizeof(int));
+  auto* d_sorted_indices = static_cast<int*>(sorted.sorted_indices.get());
+  sorted.selected_indices = allocator(num_boxes * sizeof(int));
   IAllocatorUniquePtr<void> d_sorted_scores_ptr{allocator(num_boxes * sizeof(float))};
   auto* d_sorted_scores = static_cast<float*>(d_sorted_scores_ptr.get());
-  IAllocatorUniquePtr<void> d_sorted_boxes_ptr{allocator(num_boxes * 4 * sizeof(float))};
-  auto* d_sorted_boxes = static_cast<float*>(d_sorted_boxes_ptr.get());
+  sorted.sorted_boxes = allocator(num_boxes * 4 * sizeof(float));
+  auto* d_sorted_boxes = static_cast<float*>(sorted.sorted_boxes.get());
 
   // create sequense of indices
   int blocksPerGrid = (int)(ceil(static_cast<float>(num_boxes) / GridDim::maxThreadsPerBlock));
@@ -391,51 +383,59 @@ Status NonMaxSuppressionImpl(
   IndexMultiSelect<int, Box><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_boxes, d_sorted_indices, original_boxes, sorted_boxes);
   CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
-  // STEP 2. filter boxes by scores
-  int limited_num_boxes = num_boxes;
+  // STEP 2. count the boxes above the score threshold on the device
   if (pc.score_threshold_ != nullptr) {
-    thrust::device_ptr<float> sorted_scores_device_ptr(d_sorted_scores);
-    limited_num_boxes = thrust::count_if(
-        thrust::cuda::par.on(stream),
-        sorted_scores_device_ptr,
-        sorted_scores_device_ptr + num_boxes,
-        DeviceGreaterThan(score_threshold));
+    CountAboveThreshold<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_boxes, d_sorted_scores,
+                                                                                  score_threshold, d_num_boxes);
     CUDA_RETURN_IF_ERROR(cudaGetLastError());
-
-    if (limited_num_boxes == 0) {
-      *h_number_selected = 0;
-      return Status::OK();
-    }
   }
 
+  return Status::OK();
+}
+
+Status NonMaxSuppressionSelectBoxes(
+    cudaStream_t stream,
+    std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
+    const int64_t center_point_box,
+    int num_boxes,
+    int max_output_boxes_per_class,
+    float iou_threshold,
+    NmsSortedBoxes& sorted,
+    int* d_num_selected) {
   // STEP 3. launch NMS kernels
   ORT_RETURN_IF_ERROR(NmsGpu(stream,
                              allocator,
                              center_point_box,
-                             d_sorted_boxes,
-                             limited_num_boxes,
+                             static_cast<const float*>(sorted.sorted_boxes.get()),
+                             num_boxes,
                              iou_threshold,
-                             d_selected_indices,
-                             h_number_selected,
+                             static_cast<int*>(sorted.selected_indices.get()),
+                             d_num_selected,
                              max_output_boxes_per_class));
   CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
-  // STEP 4. map back to sorted indices
-  *h_number_selected = std::min(*h_number_selected, max_output_boxes_per_class);
-  int num_to_keep = *h_number_selected;
-  if (num_to_keep > 0) {
-    IAllocatorUniquePtr<void> d_output_indices_ptr{allocator(num_to_keep * sizeof(int))};
-    auto* d_output_indices = static_cast<int*>(d_output_indices_ptr.get());
-    IAllocatorUniquePtr<void> d_normalized_output_indices_ptr{allocator(num_to_keep * 3 * sizeof(int64_t))};
-    auto* d_normalized_output_indices = static_cast<int64_t*>(d_normalized_output_indices_ptr.get());
-
-    blocksPerGrid = (int)(ceil(static_cast<float>(num_to_keep) / GridDim::maxThreadsPerBlock));
-    IndexMultiSelect<int, int><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_to_keep, d_selected_indices, d_sorted_indices, d_output_indices);
-    NormalizeOutput<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_to_keep, d_output_indices, d_normalized_output_indices, batch_index, class_index);
-    CUDA_RETURN_IF_ERROR(cudaGetLastError());
+  return Status::OK();
+}
 
-    selected_indices = std::move(d_normalized_output_indices_ptr);
-  }
+Status NonMaxSuppressionWriteOutput(
+    cudaStream_t stream,
+    std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
+    const NmsSortedBoxes& sorted,
+    int num_to_keep,
+    int64_t batch_index,
+    int64_t class_index,
+    int64_t* output) {
+  // STEP 4. map back to sorted indices
+  IAllocatorUniquePtr<void> d_output_indices_ptr{allocator(num_to_keep * sizeof(int))};
+  auto* d_output_indices = static_cast<int*>(d_output_indices_ptr.get());
+
+  int blocksPerGrid = (int)(ceil(static_cast<float>(num_to_keep) / GridDim::maxThreadsPerBlock));
+  IndexMultiSelect<int, int><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      num_to_keep, static_cast<const int*>(sorted.selected_indices.get()),
+      static_cast<const int*>(sorted.sorted_indices.get()), d_output_indices);
+  NormalizeOutput<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(num_to_keep, d_output_indices, output,
+                                                                             batch_index, class_index);
+  CUDA_RETURN_IF_ERROR(cudaGetLastError());
 
   return Status::OK();
 }
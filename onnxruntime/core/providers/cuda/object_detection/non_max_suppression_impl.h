@@ -10,18 +10,45 @@
 namespace onnxruntime {
 namespace cuda {
 
-Status NonMaxSuppressionImpl(
+// Device buffers of one (batch, class) pair that live from the sort to the output.
+struct NmsSortedBoxes {
+  IAllocatorUniquePtr<void> sorted_indices;
+  IAllocatorUniquePtr<void> sorted_boxes;
+  IAllocatorUniquePtr<void> selected_indices;
+};
+
+// Sorts the boxes of a pair by descending score. When there is a score threshold the number of boxes above it is
+// written to the device pointer d_num_boxes, so the counts of all the pairs can be read back with a single copy.
+Status NonMaxSuppressionSortBoxes(
     cudaStream_t stream,
     std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
     const PrepareContext& pc,
-    const int64_t center_point_box,
     int64_t batch_index,
     int64_t class_index,
+    float score_threshold,
+    NmsSortedBoxes& sorted,
+    int* d_num_boxes);
+
+// Selects among the first num_boxes sorted boxes, the number of selected boxes is written to d_num_selected.
+Status NonMaxSuppressionSelectBoxes(
+    cudaStream_t stream,
+    std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
+    const int64_t center_point_box,
+    int num_boxes,
     int max_output_boxes_per_class,
     float iou_threshold,
-    float score_threshold,
-    IAllocatorUniquePtr<void>& selected_indices,
-    int* h_number_selected);
+    NmsSortedBoxes& sorted,
+    int* d_num_selected);
+
+// Writes num_to_keep selected boxes as [batch_index, class_index, box_index] rows to output.
+Status NonMaxSuppressionWriteOutput(
+    cudaStream_t stream,
+    std::function<IAllocatorUniquePtr<void>(size_t)> allocator,
+    const NmsSortedBoxes& sorted,
+    int num_to_keep,
+    int64_t batch_index,
+    int64_t class_index,
+    int64_t* output);
 
 }  // namespace cuda
 }  // namespace onnxruntime
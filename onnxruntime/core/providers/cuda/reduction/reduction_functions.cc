@@ -86,20 +86,11 @@ optional<std::pair<int64_t, int64_t>> GetMinAndMaxContiguousAxes(
 
   return std::make_pair(min_axis, max_axis);
 }
-}  // namespace
 
-ApplicableMatrixReduction get_applicable_matrix_reduction(
-    const cudnnReduceTensorOp_t cudnn_reduce_op,
-    gsl::span<const int64_t> dims, gsl::span<const int64_t> original_axes,
-    int& m_out, int& n_out) {
-  if (cudnn_reduce_op != CUDNN_REDUCE_TENSOR_ADD && cudnn_reduce_op != CUDNN_REDUCE_TENSOR_AVG) {
-    return ApplicableMatrixReduction::None;
-  }
-
-  // Remove all dims with value 1. This can help to optimize case like:
-  // dims=[2,3,1,4,1,5] and axes=[0,2,4], which is same as dims=[2,3,4,5] and axes=[0].
-  std::vector<int64_t> new_dims;
-  std::vector<int64_t> new_axes;
+// Removes all dims with value 1. This can help to optimize case like:
+// dims=[2,3,1,4,1,5] and axes=[0,2,4], which is same as dims=[2,3,4,5] and axes=[0].
+void RemoveDimsOfOne(gsl::span<const int64_t> dims, gsl::span<const int64_t> original_axes,
+                     std::vector<int64_t>& new_dims, std::vector<int64_t>& new_axes) {
   const auto original_rank = gsl::narrow<int64_t>(dims.size());
   std::set<int64_t> original_axes_set;
   for (const auto axis : original_axes) {
@@ -128,6 +119,20 @@ ApplicableMatrixReduction get_applicable_matrix_reduction(
   if (!dims.empty() && new_dims.empty()) {
     new_dims.emplace_back(1);
   }
+}
+}  // namespace
+
+ApplicableMatrixReduction get_applicable_matrix_reduction(
+    const cudnnReduceTensorOp_t cudnn_reduce_op,
+    gsl::span<const int64_t> dims, gsl::span<const int64_t> original_axes,
+    int& m_out, int& n_out) {
+  if (cudnn_reduce_op != CUDNN_REDUCE_TENSOR_ADD && cudnn_reduce_op != CUDNN_REDUCE_TENSOR_AVG) {
+    return ApplicableMatrixReduction::None;
+  }
+
+  std::vector<int64_t> new_dims;
+  std::vector<int64_t> new_axes;
+  RemoveDimsOfOne(dims, original_axes, new_dims, new_axes);
 
   const auto rank = gsl::narrow<int64_t>(new_dims.size());
   const auto min_and_max_axes = GetMinAndMaxContiguousAxes(rank, new_dims, new_axes);
@@ -171,5 +176,42 @@ ApplicableMatrixReduction get_applicable_matrix_reduction(
              : ApplicableMatrixReduction::Columns;
 }
 
+bool get_applicable_axes_reduction(
+    gsl::span<const int64_t> dims, gsl::span<const int64_t> original_axes,
+    int& outer_out, int& reduce_out, int& inner_out) {
+  std::vector<int64_t> new_dims;
+  std::vector<int64_t> new_axes;
+  RemoveDimsOfOne(dims, original_axes, new_dims, new_axes);
+
+  // a scalar is reduced as a single element
+  if (new_dims.empty()) {
+    new_dims.emplace_back(1);
+  }
+
+  const auto rank = gsl::narrow<int64_t>(new_dims.size());
+  const auto min_and_max_axes = GetMinAndMaxContiguousAxes(rank, new_dims, new_axes);
+  if (!min_and_max_axes.has_value()) {
+    return false;
+  }
+
+  const auto shape = TensorShape::FromExistingBuffer(new_dims);
+  if (shape.Size() <= 0) {
+    return false;
+  }
+
+  const auto outer = shape.SizeToDimension(min_and_max_axes->first);
+  const auto inner = shape.SizeFromDimension(min_and_max_axes->second + 1);
+  const auto reduce = shape.Size() / (outer * inner);
+
+  if (outer * inner > std::numeric_limits<int>::max() || reduce > std::numeric_limits<int>::max()) {
+    return false;
+  }
+
+  outer_out = gsl::narrow_cast<int>(outer);
+  reduce_out = gsl::narrow_cast<int>(reduce);
+  inner_out = gsl::narrow_cast<int>(inner);
+  return true;
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -459,6 +459,232 @@ Status call_reduce_matrix_rows(cudaStream_t stream, const TIn* input, TOut* outp
 }
 }  // namespace detail
 
+namespace detail {
+
+struct AbsValue {
+  template <typename T>
+  __forceinline__ __device__ T operator()(const T& value) {
+    return value < T(0) ? -value : value;
+  }
+};
+
+struct SumReducer {
+  template <typename T>
+  __forceinline__ __device__ static T Init() { return T(0); }
+  template <typename T>
+  __forceinline__ __device__ static T Combine(T a, T b) { return a + b; }
+};
+
+struct ProdReducer {
+  template <typename T>
+  __forceinline__ __device__ static T Init() { return T(1); }
+  template <typename T>
+  __forceinline__ __device__ static T Combine(T a, T b) { return a * b; }
+};
+
+// Max and Min propagate NaN, like the cuDNN reductions.
+struct MaxReducer {
+  template <typename T>
+  __forceinline__ __device__ static T Init() { return T(-INFINITY); }
+  template <typename T>
+  __forceinline__ __device__ static T Combine(T a, T b) { return (isnan(a) || a > b) ? a : b; }
+};
+
+struct MinReducer {
+  template <typename T>
+  __forceinline__ __device__ static T Init() { return T(INFINITY); }
+  template <typename T>
+  __forceinline__ __device__ static T Combine(T a, T b) { return (isnan(a) || a < b) ? a : b; }
+};
+
+enum class AxesReductionFinalOp {
+  None,
+  DivideBySize,
+  Sqrt,
+  Log,
+};
+
+template <typename TAcc>
+__forceinline__ __device__ TAcc finalize_axes_reduction(TAcc value, AxesReductionFinalOp final_op, int reduce) {
+  switch (final_op) {
+    case AxesReductionFinalOp::DivideBySize:
+      return value / TAcc(reduce);
+    case AxesReductionFinalOp::Sqrt:
+      return _Sqrt(value);
+    case AxesReductionFinalOp::Log:
+      return _Log(value);
+    default:
+      return value;
+  }
+}
+
+// Reduces the rows of a row-major [outer, reduce] matrix. Each row is reduced by blockDim.x threads, with warp
+// shuffles and then through shared memory if the row spans several warps, and a block reduces blockDim.y rows.
+template <typename TIn, typename TAcc, typename TMap, typename TReducer>
+__global__ void reduce_last_axes_kernel(const TIn* input, TIn* output, int outer, int reduce,
+                                        AxesReductionFinalOp final_op) {
+  extern __shared__ unsigned char shared_memory_bytes[];
+  TAcc* shared_memory = reinterpret_cast<TAcc*>(shared_memory_bytes);
+
+  const int warp_width = min(static_cast<int>(blockDim.x), GPU_WARP_SIZE);
+  const int warps_per_row = (blockDim.x + GPU_WARP_SIZE - 1) / GPU_WARP_SIZE;
+  const int warp_in_row = threadIdx.x / GPU_WARP_SIZE;
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+
+  // the loop bound is the same for all the threads of the block, which all reach the barriers
+  for (int first_row = blockIdx.x * blockDim.y; first_row < outer; first_row += gridDim.x * blockDim.y) {
+    const int row = first_row + threadIdx.y;
+
+    TAcc value = TReducer::template Init<TAcc>();
+    if (row < outer) {
+      const TIn* row_input = input + static_cast<int64_t>(row) * reduce;
+      for (int i = threadIdx.x; i < reduce; i += blockDim.x) {
+        value = TReducer::Combine(value, TMap()(TAcc(row_input[i])));
+      }
+    }
+
+    for (int offset = warp_width / 2; offset > 0; offset /= 2) {
+      value = TReducer::Combine(value, WARP_SHFL_XOR(value, offset));
+    }
+
+    if (warps_per_row > 1) {
+      if (lane == 0) {
+        shared_memory[threadIdx.y * warps_per_row + warp_in_row] = value;
+      }
+      __syncthreads();
+      if (warp_in_row == 0) {
+        value = lane < warps_per_row ? shared_memory[threadIdx.y * warps_per_row + lane]
+                                     : TReducer::template Init<TAcc>();
+        for (int offset = GPU_WARP_SIZE / 2; offset > 0; offset /= 2) {
+          value = TReducer::Combine(value, WARP_SHFL_XOR(value, offset));
+        }
+      }
+      __syncthreads();
+    }
+
+    if (threadIdx.x == 0 && row < outer) {
+      output[row] = TIn(finalize_axes_reduction(value, final_op, reduce));
+    }
+  }
+}
+
+// Reduces the middle dimension of a row-major [outer, reduce, inner] tensor. The threads of a block along x read
+// consecutive inner elements, and the threads along y split the reduced dimension and are combined in shared memory.
+template <typename TIn, typename TAcc, typename TMap, typename TReducer>
+__global__ void reduce_middle_axes_kernel(const TIn* input, TIn* output, int outer, int reduce, int inner,
+                                          AxesReductionFinalOp final_op) {
+  extern __shared__ unsigned char shared_memory_bytes[];
+  TAcc* shared_memory = reinterpret_cast<TAcc*>(shared_memory_bytes);
+
+  const int inner_index = blockIdx.x * blockDim.x + threadIdx.x;
+  const int tid_in_block = threadIdx.y * blockDim.x + threadIdx.x;
+
+  for (int outer_index = blockIdx.y; outer_index < outer; outer_index += gridDim.y) {
+    TAcc value = TReducer::template Init<TAcc>();
+    if (inner_index < inner) {
+      const TIn* column = input + static_cast<int64_t>(outer_index) * reduce * inner + inner_index;
+      for (int i = threadIdx.y; i < reduce; i += blockDim.y) {
+        value = TReducer::Combine(value, TMap()(TAcc(column[static_cast<int64_t>(i) * inner])));
+      }
+    }
+    shared_memory[tid_in_block] = value;
+    __syncthreads();
+
+    for (int stride = blockDim.y / 2; stride > 0; stride /= 2) {
+      if (threadIdx.y < stride) {
+        shared_memory[tid_in_block] = TReducer::Combine(shared_memory[tid_in_block],
+                                                        shared_memory[tid_in_block + stride * blockDim.x]);
+      }
+      __syncthreads();
+    }
+
+    if (threadIdx.y == 0 && inner_index < inner) {
+      output[static_cast<int64_t>(outer_index) * inner + inner_index] =
+          TIn(finalize_axes_reduction(shared_memory[threadIdx.x], final_op, reduce));
+    }
+    __syncthreads();
+  }
+}
+
+template <typename TIn, typename TMap, typename TReducer>
+Status call_reduce_axes(cudaStream_t stream, const TIn* input, TIn* output, int outer, int reduce, int inner,
+                        AxesReductionFinalOp final_op) {
+  using TAcc = AccumulationType_t<TIn>;
+  constexpr int num_threads_in_block = 256;
+  constexpr int max_num_blocks_in_grid = 65535;
+
+  if (inner == 1) {
+    // a few elements per thread, so that short rows share a block
+    const int block_x_dim = std::min(num_threads_in_block, least_pow2_bound(std::max(1, reduce / 4)));
+    const int block_y_dim = num_threads_in_block / block_x_dim;
+    const int grid_dim = std::min(max_num_blocks_in_grid, (outer + block_y_dim - 1) / block_y_dim);
+    const int warps_per_row = (block_x_dim + GPU_WARP_SIZE - 1) / GPU_WARP_SIZE;
+    reduce_last_axes_kernel<TIn, TAcc, TMap, TReducer>
+        <<<grid_dim, dim3(block_x_dim, block_y_dim), block_y_dim * warps_per_row * sizeof(TAcc), stream>>>(
+            input, output, outer, reduce, final_op);
+  } else {
+    const int block_x_dim = std::min(GPU_WARP_SIZE, least_pow2_bound(inner));
+    const int block_y_dim = std::min(num_threads_in_block / block_x_dim, least_pow2_bound(reduce));
+    const dim3 grid((inner + block_x_dim - 1) / block_x_dim, std::min(max_num_blocks_in_grid, outer));
+    reduce_middle_axes_kernel<TIn, TAcc, TMap, TReducer>
+        <<<grid, dim3(block_x_dim, block_y_dim), block_x_dim * block_y_dim * sizeof(TAcc), stream>>>(
+            input, output, outer, reduce, inner, final_op);
+  }
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace detail
+
+template <typename T>
+Status reduce_axes(cudaStream_t stream, AxesReductionOp op, const T* input, T* output, int outer, int reduce, int inner) {
+  using namespace detail;
+  ORT_ENFORCE(outer >= 0 && reduce > 0 && inner > 0);
+  if (outer == 0) {
+    return Status::OK();
+  }
+
+  switch (op) {
+    case AxesReductionOp::Sum:
+      return call_reduce_axes<T, Identity, SumReducer>(stream, input, output, outer, reduce, inner,
+                                                       AxesReductionFinalOp::None);
+    case AxesReductionOp::Mean:
+      return call_reduce_axes<T, Identity, SumReducer>(stream, input, output, outer, reduce, inner,
+                                                       AxesReductionFinalOp::DivideBySize);
+    case AxesReductionOp::SumSquare:
+      return call_reduce_axes<T, Square, SumReducer>(stream, input, output, outer, reduce, inner,
+                                                     AxesReductionFinalOp::None);
+    case AxesReductionOp::LogSum:
+      return call_reduce_axes<T, Identity, SumReducer>(stream, input, output, outer, reduce, inner,
+                                                       AxesReductionFinalOp::Log);
+    case AxesReductionOp::L1:
+      return call_reduce_axes<T, AbsValue, SumReducer>(stream, input, output, outer, reduce, inner,
+                                                       AxesReductionFinalOp::None);
+    case AxesReductionOp::L2:
+      return call_reduce_axes<T, Square, SumReducer>(stream, input, output, outer, reduce, inner,
+                                                     AxesReductionFinalOp::Sqrt);
+    case AxesReductionOp::Max:
+      return call_reduce_axes<T, Identity, MaxReducer>(stream, input, output, outer, reduce, inner,
+                                                       AxesReductionFinalOp::None);
+    case AxesReductionOp::Min:
+      return call_reduce_axes<T, Identity, MinReducer>(stream, input, output, outer, reduce, inner,
+                                                       AxesReductionFinalOp::None);
+    case AxesReductionOp::Prod:
+      return call_reduce_axes<T, Identity, ProdReducer>(stream, input, output, outer, reduce, inner,
+                                                        AxesReductionFinalOp::None);
+  }
+
+  return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported axes reduction ", static_cast<int>(op));
+}
+
+#define INSTANTIATE_REDUCE_AXES(T) \
+  template Status reduce_axes<T>(cudaStream_t stream, AxesReductionOp op, const T* input, T* output, int outer, int reduce, int inner)
+INSTANTIATE_REDUCE_AXES(half);
+INSTANTIATE_REDUCE_AXES(float);
+INSTANTIATE_REDUCE_AXES(double);
+INSTANTIATE_REDUCE_AXES(BFloat16);
+#undef INSTANTIATE_REDUCE_AXES
+
 template <typename T>
 struct OP_Div {
   __device__ __inline__ T operator()(const T& a) const {
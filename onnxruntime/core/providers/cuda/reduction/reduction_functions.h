@@ -103,6 +103,44 @@ Status reduce_matrix_rows(cudaStream_t stream, const TIn* input, TOut* output, i
 template <typename TIn, typename TOut>
 Status reduce_matrix_columns(cudaStream_t stream, const TIn* input, TOut* output, int m, int n, void* buffer, size_t buffer_size);
 
+/** The reductions computed by reduce_axes(). */
+enum class AxesReductionOp {
+  Sum,
+  Mean,
+  SumSquare,
+  LogSum,
+  L1,
+  L2,
+  Max,
+  Min,
+  Prod,
+};
+
+/**
+ * Determines whether the reduction axes form a single contiguous range once the dimensions of size 1 are removed, so
+ * the input can be viewed as an [outer, reduce, inner] tensor reduced by reduce_axes().
+ * @param dims The input dimensions.
+ * @param axes The reduction axes, empty to reduce all dimensions.
+ * @param[out] outer The number of elements before the reduced dimensions.
+ * @param[out] reduce The number of elements of the reduced dimensions.
+ * @param[out] inner The number of elements after the reduced dimensions.
+ * @return Whether reduce_axes() applies.
+ */
+bool get_applicable_axes_reduction(
+    gsl::span<const int64_t> dims, gsl::span<const int64_t> axes,
+    int& outer, int& reduce, int& inner);
+
+/**
+ * Reduces the middle dimension of a row-major [outer, reduce, inner] tensor to an [outer, inner] tensor.
+ * 16-bit types are accumulated in single precision. Every output is reduced by a single block without atomics, so the
+ * result is deterministic.
+ * @param op The reduction.
+ * @param input The input data.
+ * @param output The output data.
+ */
+template <typename T>
+Status reduce_axes(cudaStream_t stream, AxesReductionOp op, const T* input, T* output, int outer, int reduce, int inner);
+
 /** Apply unary elementwise division. */
 template <typename T>
 void UnaryDiv(cudaStream_t stream, const T* input, T* output, T denominator, size_t count);
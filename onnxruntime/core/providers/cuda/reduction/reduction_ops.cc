@@ -506,6 +506,57 @@ Status ReduceComputeCore(CUDAExecutionProvider& cuda_ep, const Tensor& input, Pr
     }
   }
 
+  // Block of native reduction over one contiguous range of axes. Unlike the fast matrix reduction it is
+  // deterministic, so it is used whether or not deterministic compute is requested.
+  if constexpr (ReduceTensorIndices == CUDNN_REDUCE_TENSOR_NO_INDICES &&
+                (std::is_floating_point<T>::value || std::is_same<T, MLFloat16>::value ||
+                 std::is_same<T, BFloat16>::value)) {
+    AxesReductionOp axes_reduction_op{};
+    bool supported = !log_sum_exp;
+    switch (cudnn_reduce_op) {
+      case CUDNN_REDUCE_TENSOR_ADD:
+        axes_reduction_op = calculate_sqt ? AxesReductionOp::SumSquare
+                                          : (calculate_log ? AxesReductionOp::LogSum : AxesReductionOp::Sum);
+        supported = supported && !(calculate_sqt && calculate_log);
+        break;
+      case CUDNN_REDUCE_TENSOR_AVG:
+        axes_reduction_op = AxesReductionOp::Mean;
+        break;
+      case CUDNN_REDUCE_TENSOR_MAX:
+        axes_reduction_op = AxesReductionOp::Max;
+        break;
+      case CUDNN_REDUCE_TENSOR_MIN:
+        axes_reduction_op = AxesReductionOp::Min;
+        break;
+      case CUDNN_REDUCE_TENSOR_MUL:
+        axes_reduction_op = AxesReductionOp::Prod;
+        break;
+      case CUDNN_REDUCE_TENSOR_NORM1:
+        axes_reduction_op = AxesReductionOp::L1;
+        break;
+      case CUDNN_REDUCE_TENSOR_NORM2:
+        axes_reduction_op = AxesReductionOp::L2;
+        break;
+      default:
+        supported = false;
+        break;
+    }
+    // only the add based reductions apply calculate_sqt/calculate_log in the kernel
+    supported = supported && (cudnn_reduce_op == CUDNN_REDUCE_TENSOR_ADD || (!calculate_sqt && !calculate_log));
+
+    int outer{}, reduce{}, inner{};
+    // a single output reduced by a long loop leaves most of the device idle, cuDNN splits such reductions
+    constexpr int max_reduce_size_for_few_outputs = 16384;
+    constexpr int64_t min_outputs_for_any_reduce_size = 1024;
+    if (supported &&
+        get_applicable_axes_reduction(input_shape.GetDims(), axes, outer, reduce, inner) &&
+        (reduce <= max_reduce_size_for_few_outputs ||
+         static_cast<int64_t>(outer) * inner >= min_outputs_for_any_reduce_size)) {
+      return reduce_axes(stream, axes_reduction_op, reinterpret_cast<const CudaT*>(input.template Data<T>()),
+                         reinterpret_cast<CudaT*>(output.template MutableData<T>()), outer, reduce, inner);
+    }
+  }
+
   // This reduction keep adding values to this buffer. If a non-zero value, say 1000, is here, the sum will start with 1000.
   // Therefore zeroing out the memory is required
   CUDA_RETURN_IF_ERROR(cudaMemsetAsync(output.MutableDataRaw(), 0, output.SizeInBytes(), stream));
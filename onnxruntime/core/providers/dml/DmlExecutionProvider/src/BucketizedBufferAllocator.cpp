@@ -61,20 +61,43 @@ namespace Dml
     {
         assert(size != 0);
 
-        // Each bucket is twice as large as the previous one, in ascending order
-        gsl::index index = static_cast<gsl::index>(ceil(log2(size)));
-        assert((1ull << index) >= size); // This must be true unless there were some strange rounding issues
-
         // The smallest bucket is 2^n bytes large, where n = c_minResourceSizeExponent
-        index = std::max<gsl::index>(index, c_minResourceSizeExponent);
-        index -= c_minResourceSizeExponent;
+        if (size <= (1ull << c_minResourceSizeExponent))
+        {
+            return 0;
+        }
+
+        // Find the power of two range (2^exponent, 2^(exponent + 1)] containing the size
+        uint32_t exponent = c_minResourceSizeExponent;
+        while ((2ull << exponent) < size)
+        {
+            ++exponent;
+        }
+
+        // Round up to the next of the evenly spaced buckets within the range
+        const uint64_t rangeStart = 1ull << exponent;
+        const uint64_t step = rangeStart >> c_bucketsPerDoublingExponent;
+        const uint64_t stepInRange = (size - rangeStart + step - 1) / step;
+
+        gsl::index index = static_cast<gsl::index>(exponent - c_minResourceSizeExponent) << c_bucketsPerDoublingExponent;
+        index += static_cast<gsl::index>(stepInRange);
+        assert(GetBucketSizeFromIndex(index) >= size);
 
         return index;
     }
 
     /*static*/ uint64_t BucketizedBufferAllocator::GetBucketSizeFromIndex(gsl::index index)
     {
-        return (1ull << (index + c_minResourceSizeExponent));
+        if (index == 0)
+        {
+            return (1ull << c_minResourceSizeExponent);
+        }
+
+        const uint32_t bucketsPerDoubling = 1u << c_bucketsPerDoublingExponent;
+        const uint64_t exponent = c_minResourceSizeExponent + (index - 1) / bucketsPerDoubling;
+        const uint64_t stepInRange = (index - 1) % bucketsPerDoubling + 1;
+        const uint64_t rangeStart = 1ull << exponent;
+        return rangeStart + stepInRange * (rangeStart >> c_bucketsPerDoublingExponent);
     }
 
     void* BucketizedBufferAllocator::Alloc(size_t size)
@@ -92,7 +115,7 @@ namespace Dml
         uint64_t bucketSize = 0;
 
         // Use a pooled resource if the size (post rounding, if requested) matches a bucket size
-        if (m_defaultRoundingMode == AllocatorRoundingMode::Enabled || size == GetBucketSizeFromIndex(GetBucketIndexFromSize(size)))
+        if (roundingMode == AllocatorRoundingMode::Enabled || size == GetBucketSizeFromIndex(GetBucketIndexFromSize(size)))
         {
             Bucket* bucket = nullptr;
 
@@ -110,10 +110,12 @@ namespace Dml
 
     private:
         static const uint32_t c_minResourceSizeExponent = 16; // 2^16 = 64KB
+        static const uint32_t c_bucketsPerDoublingExponent = 2; // 2^2 = 4 buckets between powers of two
 
         // The pool consists of a number of buckets, and each bucket contains a number of resources of the same size.
-        // The resources in each bucket are always sized as a power of two, and each bucket contains resources twice
-        // as large as the previous bucket.
+        // The smallest bucket is 2^c_minResourceSizeExponent bytes. Above it, each power of two is split into
+        // 2^c_bucketsPerDoublingExponent evenly spaced buckets (e.g. 80KB, 96KB, 112KB and 128KB after 64KB), which
+        // bounds the memory wasted by rounding to 25% of an allocation instead of 50% with power of two buckets.
         struct Resource
         {
             ComPtr<ID3D12Resource> resource;
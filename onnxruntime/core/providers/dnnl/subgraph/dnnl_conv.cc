@@ -12,8 +12,13 @@ namespace ort_dnnl {
 DnnlConv::DnnlConv() {}
 
 void DnnlConv::CreatePrimitive(DnnlSubgraphPrimitive& sp, DnnlNode& node) {
+  bool has_add = false;
   bool has_relu = false;
-  if (node.OpType() == "ConvRelu") {
+  if (node.OpType() == "ConvAdd" || node.OpType() == "ConvAddRelu") {
+    has_add = true;
+    assert(node.Input(IN_BINARY).Exists());
+  }
+  if (node.OpType() == "ConvRelu" || node.OpType() == "ConvAddRelu") {
     has_relu = true;
   }
 
@@ -95,13 +100,35 @@ void DnnlConv::CreatePrimitive(DnnlSubgraphPrimitive& sp, DnnlNode& node) {
   auto prop_kind = dnnl::prop_kind::forward_inference;
 #endif  // ENABLE_TRAINING
 
+  /*
+  * The Add of a ConvAdd fusion is a binary post op summing the other input into the convolution output, which
+  * saves writing and reading back the convolution output (e.g. the residual connection of a ResNet block).
+  * The other input keeps the layout of its producer, so a blocked output of a previous convolution is consumed
+  * without a reorder. It is only unsqueezed when it has a lower rank than the output, which requires a plain layout.
+  */
   dnnl::primitive_attr attr;
+  dnnl::post_ops ops;
+  if (has_add) {
+    auto binary_mem_desc = sp.GetMemory(node.Input(IN_BINARY)).get_desc();
+    auto binary_mem_dims = binary_mem_desc.dims();
+    if (binary_mem_dims.size() > dst_mem_dims.size()) {
+      ORT_THROW("add fusion with conv output broadcasting by unsqueezing is not supported");
+    }
+    if (binary_mem_dims.size() < dst_mem_dims.size()) {
+      while (binary_mem_dims.size() < dst_mem_dims.size()) {
+        binary_mem_dims.insert(binary_mem_dims.begin(), 1);
+      }
+      binary_mem_desc = binary_mem_desc.reshape(binary_mem_dims);
+    }
+    ops.append_binary(dnnl::algorithm::binary_add, binary_mem_desc);
+  }
   if (has_relu) {
     const float ops_scale = 1.f;
     const float ops_alpha = 0.f;
     const float ops_beta = 0.f;
-    dnnl::post_ops ops;
     ops.append_eltwise(ops_scale, dnnl::algorithm::eltwise_relu, ops_alpha, ops_beta);
+  }
+  if (has_add || has_relu) {
     attr.set_post_ops(ops);
   }
 
@@ -130,16 +157,21 @@ void DnnlConv::CreatePrimitive(DnnlSubgraphPrimitive& sp, DnnlNode& node) {
 
   // Add the convolution layer to the subgraph
   auto conv_op = dnnl::convolution_forward(conv_pd);
+  std::unordered_map<int, dnnl::memory> mem_map({{DNNL_ARG_SRC, conv_src_mem},
+                                                 {DNNL_ARG_WEIGHTS, conv_weights_mem},
+                                                 {DNNL_ARG_DST, conv_dst_mem}});
   if (bias_exists) {
-    sp.AddPrimitive(conv_op, {{DNNL_ARG_SRC, conv_src_mem},
-                              {DNNL_ARG_WEIGHTS, conv_weights_mem},
-                              {DNNL_ARG_BIAS, conv_bias_mem},
-                              {DNNL_ARG_DST, conv_dst_mem}});
-  } else {
-    sp.AddPrimitive(conv_op, {{DNNL_ARG_SRC, conv_src_mem},
-                              {DNNL_ARG_WEIGHTS, conv_weights_mem},
-                              {DNNL_ARG_DST, conv_dst_mem}});
+    mem_map[DNNL_ARG_BIAS] = conv_bias_mem;
+  }
+  if (has_add) {
+    dnnl::algorithm algo;
+    dnnl::memory::desc binary_mem_desc;
+    conv_pd.get_primitive_attr().get_post_ops().get_params_binary(0, algo, binary_mem_desc);
+    assert(algo == dnnl::algorithm::binary_add);
+    auto binary_post_op_mem = sp.GetMemoryAndReshape(node.Input(IN_BINARY), binary_mem_desc, dnnl_engine);
+    mem_map[DNNL_ARG_ATTR_MULTIPLE_POST_OP(0) | DNNL_ARG_SRC_1] = binary_post_op_mem;
   }
+  sp.AddPrimitive(conv_op, mem_map);
 
   sp.SetMemory(node.Output(OUT_Y), conv_dst_mem);
 }
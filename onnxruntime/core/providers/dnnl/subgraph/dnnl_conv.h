@@ -13,7 +13,8 @@ class DnnlConv {
   enum InputTensors : int {
     IN_X = 0,
     IN_W = 1,
-    IN_B = 2
+    IN_B = 2,
+    IN_BINARY = 3  // the extra input due to ConvAdd fusion
   };
 
   enum OutputTensors : int {
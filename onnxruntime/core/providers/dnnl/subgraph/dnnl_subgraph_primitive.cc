@@ -138,7 +138,8 @@ void DnnlSubgraphPrimitive::AddKernels() {
       DnnlBinary().CreatePrimitive(*this, node);
     } else if (node.OpType() == "Cast") {
       DnnlCast().CreatePrimitive(*this, node);
-    } else if (node.OpType() == "Conv" || node.OpType() == "ConvRelu") {
+    } else if (node.OpType() == "Conv" || node.OpType() == "ConvRelu" ||
+               node.OpType() == "ConvAdd" || node.OpType() == "ConvAddRelu") {
       DnnlConv().CreatePrimitive(*this, node);
     } else if (node.OpType() == "DynamicQuantizeLinear") {
       DnnlDynamicQuantizeLinear().CreatePrimitive(*this, node);
@@ -13,6 +13,7 @@ namespace ort_dnnl {
 
 //apply all transformation rules in order
 void DnnlGraphTransformer::Apply(DnnlSubgraph& subgraph) {
+  ConvAdd(subgraph);
   ConvRelu(subgraph);
   MatMulAdd(subgraph);
   Gelu(subgraph);
@@ -631,6 +632,71 @@ bool DnnlGraphTransformer::FastGeluFormulaCommon(DnnlSubgraph& subgraph, DnnlNod
   return true;
 }
 
+void DnnlGraphTransformer::ConvAdd(DnnlSubgraph& subgraph) {
+  static int fused_index = 0;
+  size_t max_index = subgraph.GetMaxNodeIndex();
+  for (size_t index = 0; index < max_index; index++) {
+    auto dnnl_node = subgraph.GetDnnlNode(index);
+
+    //look for conv add (relu) pattern
+    if (dnnl_node == nullptr || dnnl_node->OpType() != "Conv") {
+      continue;
+    }
+
+    auto conv_node = dnnl_node;
+
+    if (!IsNodeFusable(subgraph, conv_node)) {
+      continue;
+    }
+
+    auto add_node = conv_node->Output(0).GetConsumers()[0].GetNode();
+    if (add_node == nullptr || add_node->OpType() != "Add") {
+      continue;
+    }
+
+    //add is taking two inputs from the same conv output
+    auto add_inputs = add_node->Inputs();
+    if (add_inputs[0] == add_inputs[1]) {
+      continue;
+    }
+
+    //the optional bias is kept at its index so the other add input is always the 4th input
+    auto fused_node_inputs = conv_node->Inputs();
+    fused_node_inputs.resize(3, nullptr);
+    if (conv_node->Output(0).Name() == add_inputs[0]->Name()) {
+      fused_node_inputs.push_back(add_inputs[1]);
+    } else {
+      fused_node_inputs.push_back(add_inputs[0]);
+    }
+
+    std::vector<size_t> fused_indices = {conv_node->Index(), add_node->Index()};
+    auto last_node = add_node;
+    std::string fused_node_type = "ConvAdd";
+    if (IsNodeFusable(subgraph, add_node)) {
+      auto relu_node = add_node->Output(0).GetConsumers()[0].GetNode();
+      if (relu_node != nullptr && relu_node->OpType() == "Relu") {
+        fused_indices.push_back(relu_node->Index());
+        last_node = relu_node;
+        fused_node_type = "ConvAddRelu";
+      }
+    }
+
+    //construct new node
+    auto fused_node = std::make_unique<DnnlNode>();
+    fused_node->Name() = conv_node->Name() + "_" + fused_node_type + "_" + std::to_string(fused_index++);
+    fused_node->OpType() = fused_node_type;
+    fused_node->Inputs() = fused_node_inputs;
+    fused_node->Outputs() = {last_node->Outputs()[0]};
+    fused_node->Attributes().insert(conv_node->Attributes());
+
+    //insert new node, remove original nodes, connect new edges
+    if (debug_log_) {
+      LOGS_DEFAULT(ERROR) << fused_node_type << " fusion of [" << conv_node->Name() << "] and [" << add_node->Name() << "]";
+    }
+    ResolveFusion(subgraph, fused_indices, std::move(fused_node));
+  }
+}
+
 void DnnlGraphTransformer::ConvRelu(DnnlSubgraph& subgraph) {
   //global index of convrelu
   static int conv_relu_index = 0;
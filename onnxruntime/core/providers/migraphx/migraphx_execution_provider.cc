@@ -15,7 +15,12 @@
 
 #include <fstream>
 #include <algorithm>
+#include <cstdio>
+#include <functional>
 #include <iterator>
+#include <sstream>
+#include <thread>
+#include <tuple>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4244 4245)
@@ -120,6 +125,25 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
   if (!dump_model_ops_env.empty()) {
     dump_model_ops_ = (std::stoi(dump_model_ops_env) == 0 ? false : true);
   }
+
+  // directory to save and load compiled programs
+  model_cache_path_ = onnxruntime::GetEnvironmentVar(migraphx_env_vars::kModelCachePath);
+
+  // batch sizes the inputs are padded to, e.g. "1,2,4,8"
+  const std::string batch_sizes_env = onnxruntime::GetEnvironmentVar(migraphx_env_vars::kBatchSizes);
+  if (!batch_sizes_env.empty()) {
+    std::istringstream batch_sizes_stream(batch_sizes_env);
+    std::string batch_size;
+    while (std::getline(batch_sizes_stream, batch_size, ',')) {
+      if (!batch_size.empty()) {
+        auto value = std::stoll(batch_size);
+        ORT_ENFORCE(value > 0, "MIGraphX: invalid batch size '", batch_size, "' in ", migraphx_env_vars::kBatchSizes);
+        batch_sizes_.push_back(static_cast<std::size_t>(value));
+      }
+    }
+    std::sort(batch_sizes_.begin(), batch_sizes_.end());
+    batch_sizes_.erase(std::unique(batch_sizes_.begin(), batch_sizes_.end()), batch_sizes_.end());
+  }
 }
 
 AllocatorPtr MIGraphXExecutionProvider::GetAllocator(int id, OrtMemType mem_type) const {
@@ -1019,6 +1043,71 @@ bool get_input_output_names(const GraphViewer& graph,
   return no_input_shape;
 }
 
+// Key of a compiled program, made of the subgraph, the shapes of its inputs and the precision
+static std::string GetProgramKey(const std::string& onnx_string,
+                                 const std::map<std::string, std::vector<std::size_t>>& input_shapes,
+                                 bool fp16_enable) {
+  std::ostringstream key;
+  key << std::hash<std::string>{}(onnx_string);
+  for (const auto& it : input_shapes) {
+    key << "|" << it.first << ":";
+    for (auto dim : it.second) {
+      key << dim << ",";
+    }
+  }
+  key << "|" << fp16_enable;
+
+  std::ostringstream hashed_key;
+  hashed_key << "mgx_" << std::hex << std::hash<std::string>{}(key.str());
+  return hashed_key.str();
+}
+
+// Load the compiled program from the model cache, or compile it and save it there
+static migraphx::program LoadOrCompileProgram(const std::string& onnx_string, migraphx::onnx_options& options,
+                                              const migraphx::target& t, bool fp16_enable,
+                                              const std::string& model_cache_path, const std::string& key) {
+  std::string cache_file;
+  if (!model_cache_path.empty()) {
+    cache_file = model_cache_path + "/" + key + ".mxr";
+    std::ifstream cache_stream(cache_file, std::ios::binary);
+    if (cache_stream.good()) {
+      cache_stream.close();
+      LOGS_DEFAULT(VERBOSE) << "[MIGraphX EP] Loading compiled program from " << cache_file;
+      return migraphx::load(cache_file.c_str());
+    }
+  }
+
+  auto prog = migraphx::parse_onnx_buffer(onnx_string, options);
+  if (fp16_enable) {
+    migraphx::quantize_fp16(prog);
+  }
+  prog.compile(t);
+
+  if (!cache_file.empty()) {
+    // write to a temporary file first so that concurrent sessions never load a partial program
+    const std::string tmp_file = cache_file + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    migraphx::save(prog, tmp_file.c_str());
+    if (std::rename(tmp_file.c_str(), cache_file.c_str()) != 0) {
+      std::remove(tmp_file.c_str());
+    }
+    LOGS_DEFAULT(VERBOSE) << "[MIGraphX EP] Saved compiled program to " << cache_file;
+  }
+
+  return prog;
+}
+
+// Leading dimension shared by all the inputs, 0 if they do not have one
+static std::size_t GetBatchSize(const std::map<std::string, std::vector<std::size_t>>& input_shapes) {
+  std::size_t batch_size = 0;
+  for (const auto& it : input_shapes) {
+    if (it.second.empty() || it.second[0] == 0 || (batch_size != 0 && it.second[0] != batch_size)) {
+      return 0;
+    }
+    batch_size = it.second[0];
+  }
+  return batch_size;
+}
+
 Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>& fused_nodes,
                                           std::vector<NodeComputeInfo>& node_compute_funcs) {
   migraphx::onnx_options options;
@@ -1059,10 +1148,10 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
 
     // by parsing the model_proto, create a program corresponding to
     // the input fused_node
-    migraphx::program prog;
+    std::unordered_map<std::string, migraphx::program> progs;
 
     if (!no_input_shape) {
-      prog = migraphx::parse_onnx_buffer(onnx_string_buffer, options);
+      auto prog = migraphx::parse_onnx_buffer(onnx_string_buffer, options);
       if (fp16_enable_) {
         migraphx::quantize_fp16(prog);
       }
@@ -1073,20 +1162,35 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
         auto out_len = prog_output_shapes[i].lengths();
         options.set_input_parameter_shape(output_names[i], out_len);
       }
+
+      // key the program by the shapes it was compiled for, as seen by ORT
+      std::map<std::string, std::vector<std::size_t>> input_shapes;
+      auto param_shapes = prog.get_parameter_shapes();
+      for (auto&& name : param_shapes.names()) {
+        if (input_name_index.count(name) > 0) {
+          auto mgx_s = param_shapes[name];
+          auto mgx_lens = mgx_s.lengths();
+          auto mgx_strides = mgx_s.strides();
+          if (mgx_lens.size() == 1 and mgx_lens[0] == 1 and
+              mgx_strides.size() == 1 and mgx_strides[0] == 0) {
+            mgx_lens.clear();
+          }
+          input_shapes[name] = mgx_lens;
+        }
+      }
+      progs.emplace(GetProgramKey(onnx_string_buffer, input_shapes, fp16_enable_), prog);
     }
 
-    // compile the program
-    map_progs_[fused_node->Name()] = prog;
+    map_progs_[fused_node->Name()] = progs;
 
     map_onnx_string_[fused_node->Name()] = onnx_string_buffer;
     map_input_index_[fused_node->Name()] = input_name_index;
-    map_no_input_shape_[fused_node->Name()] = no_input_shape;
     NodeComputeInfo compute_info;
     compute_info.create_state_func = [=](ComputeContext* context, FunctionState* state) {
       std::unique_ptr<MIGraphXFuncState> p = std::make_unique<MIGraphXFuncState>();
       *p = {context->allocate_func, context->release_func, context->allocator_handle, map_progs_[context->node_name],
             map_onnx_string_[context->node_name], options, t_, map_input_index_[context->node_name], &mgx_mu_,
-            map_no_input_shape_[context->node_name], fp16_enable_, dump_model_ops_};
+            fp16_enable_, dump_model_ops_, model_cache_path_, batch_sizes_};
       *state = p.release();
       return 0;
     };
@@ -1100,74 +1204,64 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
       Ort::CustomOpApi ort{*api};
       MIGraphXFuncState* mgx_state = reinterpret_cast<MIGraphXFuncState*>(state);
       std::unordered_map<std::string, std::size_t>& map_input_name_index = mgx_state->input_name_indexes;
-      migraphx::target t = mgx_state->t;
-      migraphx::program& prog = mgx_state->prog;
-      std::string& onnx_string = mgx_state->onnx_string;
-      migraphx::onnx_options& cmp_options = mgx_state->options;
-      bool& no_input_shape = mgx_state->no_input_shape;
-      bool fp16_enable = mgx_state->fp16_enable;
-
-      // mean no program at all, so need to get the input shape info
-      // from input data
-      bool input_shape_match = true;
-      migraphx::program_parameter_shapes param_shapes;
-      if (no_input_shape) {
-        for (auto& it : map_input_name_index) {
-          auto& name = it.first;
-          auto& index = it.second;
-          const OrtValue* input_tensor = ort.KernelContext_GetInput(context, index);
-          auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
-          const auto& tensor_shape = ort.GetTensorShape(tensor_info);
-          std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
-          cmp_options.set_input_parameter_shape(name, ort_lens);
-          input_shape_match = false;
-        }
-      } else {
-        param_shapes = prog.get_parameter_shapes();
-        auto prog_output_shapes = prog.get_output_shapes();
-
-        // check whether input shapes match with shapes of program inputs
-        // migraphx::onnx_options cmp_options;
-        if (param_shapes.size() > 0) {
-          for (auto&& name : param_shapes.names()) {
-            if (map_input_name_index.count(name) > 0) {
-              const OrtValue* input_tensor = ort.KernelContext_GetInput(context, map_input_name_index[name]);
-              auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
-              const auto& tensor_shape = ort.GetTensorShape(tensor_info);
-              std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
-
-              auto mgx_s = param_shapes[name];
-              auto mgx_lens = mgx_s.lengths();
-              auto mgx_strides = mgx_s.strides();
-              if (mgx_lens.size() == 1 and mgx_lens[0] == 1 and
-                  mgx_strides.size() == 1 and mgx_strides[0] == 0) {
-                mgx_lens.clear();
-              }
 
-              if (mgx_lens != ort_lens) {
-                cmp_options.set_input_parameter_shape(name, ort_lens);
-                input_shape_match = false;
-              }
-            }
+      // shapes of the inputs of this run
+      std::map<std::string, std::vector<std::size_t>> input_shapes;
+      for (auto& it : map_input_name_index) {
+        const OrtValue* input_tensor = ort.KernelContext_GetInput(context, it.second);
+        auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+        const auto& tensor_shape = ort.GetTensorShape(tensor_info);
+        ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
+        input_shapes[it.first] = std::vector<std::size_t>(tensor_shape.begin(), tensor_shape.end());
+      }
+
+      // pad the batch to the next configured batch size so that a few programs serve all of them,
+      // batches larger than all configured sizes get a program of their own
+      std::size_t batch_size = 0;
+      std::size_t padded_batch_size = 0;
+      if (!mgx_state->batch_sizes.empty()) {
+        batch_size = GetBatchSize(input_shapes);
+        auto size_it = std::lower_bound(mgx_state->batch_sizes.begin(), mgx_state->batch_sizes.end(), batch_size);
+        if (batch_size != 0 && size_it != mgx_state->batch_sizes.end() && *size_it > batch_size) {
+          padded_batch_size = *size_it;
+          for (auto& it : input_shapes) {
+            it.second[0] = padded_batch_size;
           }
         }
       }
-
-      // input shapes are different, needs to re-parse onnx and
-      // re-compile the program
-      if (!input_shape_match) {
-        prog = migraphx::parse_onnx_buffer(onnx_string, cmp_options);
-        if (fp16_enable) {
-          migraphx::quantize_fp16(prog);
+      const bool pad_batch = padded_batch_size != 0;
+
+      // lock to avoid race condition, the program cache and the evaluation are shared by all the runs
+      std::lock_guard<OrtMutex> lock(*(mgx_state->mgx_mu_ptr));
+
+      // the input shapes have not been seen yet, needs to re-parse onnx and
+      // compile the program, or load it from the model cache
+      auto key = GetProgramKey(mgx_state->onnx_string, input_shapes, mgx_state->fp16_enable);
+      auto prog_it = mgx_state->programs.find(key);
+      if (prog_it == mgx_state->programs.end()) {
+        migraphx::onnx_options& cmp_options = mgx_state->options;
+        for (auto& it : input_shapes) {
+          cmp_options.set_input_parameter_shape(it.first, it.second);
         }
-
-        prog.compile(t);
-        mgx_state->prog = prog;
-        param_shapes = prog.get_parameter_shapes();
-        no_input_shape = false;
+        prog_it = mgx_state->programs.emplace(key, LoadOrCompileProgram(mgx_state->onnx_string, cmp_options, mgx_state->t,
+                                                                        mgx_state->fp16_enable,
+                                                                        mgx_state->model_cache_path, key))
+                      .first;
       }
+      migraphx::program& prog = prog_it->second;
+
+      // scratch buffers of the padded inputs and outputs
+      std::vector<std::unique_ptr<void, std::function<void(void*)>>> padded_buffers;
+      auto allocate_padded = [&](std::size_t bytes) {
+        void* ptr = mgx_state->allocate_func(mgx_state->allocate_handle, bytes, 256);
+        padded_buffers.emplace_back(ptr, [mgx_state](void* p) { mgx_state->release_func(mgx_state->allocate_handle, p); });
+        return ptr;
+      };
+      // padded outputs to copy back: ORT output, scratch buffer and bytes of the unpadded batch
+      std::vector<std::tuple<void*, const void*, std::size_t>> padded_outputs;
 
       migraphx::program_parameters m;
+      auto param_shapes = prog.get_parameter_shapes();
       auto prog_output_shapes = prog.get_output_shapes();
       std::vector<std::size_t> prog_output_indices;
       if (param_shapes.size() > 0) {
@@ -1175,7 +1269,6 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
           if (map_input_name_index.count(name) > 0) {
             const OrtValue* input_tensor = ort.KernelContext_GetInput(context, map_input_name_index[name]);
             auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
-            const auto& tensor_shape = ort.GetTensorShape(tensor_info);
             auto tensor_type = ort.GetTensorElementType(tensor_info);
             ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
 
@@ -1186,7 +1279,18 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
             if (mgx_type != mgx_s.type()) {
               LOGS_DEFAULT(FATAL) << "MIGraphX: param type mismatch";
             }
-            m.add(name, migraphx::argument(param_shapes[name], const_cast<void*>(ort.GetTensorData<void>(input_tensor))));
+
+            void* input_data = const_cast<void*>(ort.GetTensorData<void>(input_tensor));
+            if (pad_batch) {
+              // copy the batch into a zero-filled buffer of the padded batch size
+              const std::size_t padded_bytes = mgx_s.bytes();
+              const std::size_t bytes = padded_bytes / padded_batch_size * batch_size;
+              void* padded_data = allocate_padded(padded_bytes);
+              HIP_CALL_THROW(hipMemcpy(padded_data, input_data, bytes, hipMemcpyDeviceToDevice));
+              HIP_CALL_THROW(hipMemset(static_cast<char*>(padded_data) + bytes, 0, padded_bytes - bytes));
+              input_data = padded_data;
+            }
+            m.add(name, migraphx::argument(mgx_s, input_data));
           }
           // It is a output argument
           else {
@@ -1206,38 +1310,55 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
               prog_output_indices.push_back(output_index);
               auto mgx_output_shape = prog_output_shapes[output_index];
               auto lens = mgx_output_shape.lengths();
+              const bool pad_output = pad_batch && !lens.empty() && lens[0] == padded_batch_size;
               std::vector<int64_t> ort_output_shape(lens.begin(), lens.end());
+              if (pad_output) {
+                ort_output_shape[0] = batch_size;
+              }
               OrtValue* output_tensor = ort.KernelContext_GetOutput(context, output_index, ort_output_shape.data(), ort_output_shape.size());
               void* output_data = ort.GetTensorMutableData<void>(output_tensor);
 
               // argument shape
               auto mgx_arg_shape = param_shapes[name];
+              if (pad_output) {
+                void* padded_data = allocate_padded(mgx_arg_shape.bytes());
+                padded_outputs.emplace_back(output_data, padded_data,
+                                            mgx_arg_shape.bytes() / padded_batch_size * batch_size);
+                output_data = padded_data;
+              }
               m.add(name, migraphx::argument(mgx_arg_shape, output_data));
             }
           }
         }
       }
 
-      {
-        // lock to avoid race condition
-        std::lock_guard<OrtMutex> lock(*(mgx_state->mgx_mu_ptr));
-        auto prog_outputs = prog.eval(m);
-        HIP_CALL_THROW(hipDeviceSynchronize());
-
-        // In case of input parameters are reused as output parameter call hipMemcpy
-        auto output_num = prog_outputs.size();
-        if (prog_output_indices.size() < output_num) {
-          for (std::size_t i = 0; i < output_num; ++i) {
-            if (std::find(prog_output_indices.begin(), prog_output_indices.end(), i) != prog_output_indices.end())
-              continue;
-            auto gpu_res = prog_outputs[i];
-            migraphx::shape res_shape = gpu_res.get_shape();
-            auto res_lens = res_shape.lengths();
-            std::vector<int64_t> ort_shape{res_lens.begin(), res_lens.end()};
-            OrtValue* output_tensor = ort.KernelContext_GetOutput(context, i, ort_shape.data(), ort_shape.size());
-            void* output_data = ort.GetTensorMutableData<void>(output_tensor);
-            HIP_CALL_THROW(hipMemcpy(output_data, gpu_res.data(), res_shape.bytes(), hipMemcpyDeviceToDevice));
+      auto prog_outputs = prog.eval(m);
+      HIP_CALL_THROW(hipDeviceSynchronize());
+
+      // drop the padding of the outputs
+      for (const auto& padded_output : padded_outputs) {
+        HIP_CALL_THROW(hipMemcpy(std::get<0>(padded_output), std::get<1>(padded_output), std::get<2>(padded_output),
+                                 hipMemcpyDeviceToDevice));
+      }
+
+      // In case of input parameters are reused as output parameter call hipMemcpy
+      auto output_num = prog_outputs.size();
+      if (prog_output_indices.size() < output_num) {
+        for (std::size_t i = 0; i < output_num; ++i) {
+          if (std::find(prog_output_indices.begin(), prog_output_indices.end(), i) != prog_output_indices.end())
+            continue;
+          auto gpu_res = prog_outputs[i];
+          migraphx::shape res_shape = gpu_res.get_shape();
+          auto res_lens = res_shape.lengths();
+          std::vector<int64_t> ort_shape{res_lens.begin(), res_lens.end()};
+          std::size_t res_bytes = res_shape.bytes();
+          if (pad_batch && !res_lens.empty() && res_lens[0] == padded_batch_size) {
+            ort_shape[0] = batch_size;
+            res_bytes = res_bytes / padded_batch_size * batch_size;
           }
+          OrtValue* output_tensor = ort.KernelContext_GetOutput(context, i, ort_shape.data(), ort_shape.size());
+          void* output_data = ort.GetTensorMutableData<void>(output_tensor);
+          HIP_CALL_THROW(hipMemcpy(output_data, gpu_res.data(), res_bytes, hipMemcpyDeviceToDevice));
         }
       }
 
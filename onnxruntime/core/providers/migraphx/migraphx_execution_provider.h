@@ -10,6 +10,7 @@
 #include "migraphx_execution_provider_info.h"
 
 #include <map>
+#include <vector>
 #include "migraphx_inc.h"
 
 namespace onnxruntime {
@@ -17,6 +18,8 @@ namespace onnxruntime {
 namespace migraphx_env_vars {
 static const std::string kFP16Enable = "ORT_MIGRAPHX_FP16_ENABLE";
 static const std::string dumpModelOps = "ORT_MIGRAPHX_DUMP_MODEL_OPS";
+static const std::string kModelCachePath = "ORT_MIGRAPHX_MODEL_CACHE_PATH";
+static const std::string kBatchSizes = "ORT_MIGRAPHX_BATCH_SIZES";
 };
 
 // Information to construct kernel function state.
@@ -24,15 +27,17 @@ struct MIGraphXFuncState {
   AllocateFunc allocate_func = nullptr;
   DestroyFunc release_func = nullptr;
   AllocatorHandle allocate_handle = nullptr;
-  migraphx::program prog{};
+  // compiled programs of the subgraph, keyed by the shapes of its inputs
+  std::unordered_map<std::string, migraphx::program> programs;
   std::string onnx_string;
   migraphx::onnx_options options;
   migraphx::target t{};
   std::unordered_map<std::string, std::size_t> input_name_indexes;
   OrtMutex* mgx_mu_ptr = nullptr;
-  bool no_input_shape = false;
   bool fp16_enable = false;
   bool dump_model_ops = false;
+  std::string model_cache_path;
+  std::vector<std::size_t> batch_sizes;
 };
 
 // Logical device representation.
@@ -61,15 +66,18 @@ class MIGraphXExecutionProvider : public IExecutionProvider {
 private:
   bool fp16_enable_ = false;
   bool dump_model_ops_ = false;
+  // directory of the serialized compiled programs, empty if disabled
+  std::string model_cache_path_;
+  // sorted batch sizes the inputs are padded to, empty if disabled
+  std::vector<std::size_t> batch_sizes_;
   int device_id_;
   migraphx::target t_; 
   OrtMutex mgx_mu_;
   hipStream_t stream_ = nullptr;
 
-  std::unordered_map<std::string, migraphx::program> map_progs_;
+  std::unordered_map<std::string, std::unordered_map<std::string, migraphx::program>> map_progs_;
   std::unordered_map<std::string, std::string> map_onnx_string_;
   std::unordered_map<std::string, std::unordered_map<std::string, std::size_t>> map_input_index_;
-  std::unordered_map<std::string, bool> map_no_input_shape_;
 
   AllocatorPtr allocator_;
 };
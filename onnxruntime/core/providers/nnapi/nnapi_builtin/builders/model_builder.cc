@@ -6,6 +6,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/safeint.h"
 #include "core/common/status.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/providers/common.h"
@@ -38,6 +39,8 @@ int32_t ModelBuilder::GetNNAPIFeatureLevel() const {
         nnapi_->ANeuralNetworksModel_setOperandValue(                             \
             nnapi_model_->model_, index, &value, sizeof(value)),                  \
         "value: " + std::to_string(value));                                       \
+    UpdateCacheToken(&index, sizeof(index));                                      \
+    UpdateCacheToken(&value, sizeof(value));                                      \
     return Status::OK();                                                          \
   }
 
@@ -47,6 +50,19 @@ DEFINE_ADD_OPERAND_FROM_SCALAR(float, FLOAT32);
 
 #undef DEFINE_ADD_OPERAND_FROM_SCALAR
 
+void ModelBuilder::UpdateCacheToken(const void* data, size_t size) {
+  if (compilation_cache_dir_.empty()) {
+    return;
+  }
+
+  // Chain the hash of the data with the current token, as MurmurHash3 cannot be computed incrementally
+  uint8_t buffer[ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN + 16];
+  memcpy(buffer, cache_token_.data(), cache_token_.size());
+  MurmurHash3::x86_128(data, static_cast<int>(size), 0, buffer + cache_token_.size());
+  MurmurHash3::x86_128(buffer, static_cast<int>(sizeof(buffer)), 1, cache_token_.data());
+  MurmurHash3::x86_128(buffer, static_cast<int>(sizeof(buffer)), 2, cache_token_.data() + 16);
+}
+
 void ModelBuilder::AddInitializerToSkip(const std::string& tensor_name) {
   skipped_initializers_.insert(tensor_name);
 }
@@ -412,6 +428,11 @@ Status ModelBuilder::AddNewNNAPIOperand(const OperandType& operand_type, uint32_
       nnapi_->ANeuralNetworksModel_addOperand(nnapi_model_->model_, &operand_type.operandType));
   index = next_index_++;
 
+  UpdateCacheToken(&operand_type.operandType.type, sizeof(operand_type.operandType.type));
+  UpdateCacheToken(operand_type.dimensions.data(), operand_type.dimensions.size() * sizeof(uint32_t));
+  UpdateCacheToken(&operand_type.operandType.scale, sizeof(operand_type.operandType.scale));
+  UpdateCacheToken(&operand_type.operandType.zeroPoint, sizeof(operand_type.operandType.zeroPoint));
+
   if (operand_type.channelQuant) {
     if (GetNNAPIFeatureLevel() < ANEURALNETWORKS_FEATURE_LEVEL_3) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
@@ -421,6 +442,11 @@ Status ModelBuilder::AddNewNNAPIOperand(const OperandType& operand_type, uint32_
 
     RETURN_STATUS_ON_ERROR(nnapi_->ANeuralNetworksModel_setOperandSymmPerChannelQuantParams(
         nnapi_model_->model_, index, &operand_type.channelQuant->params));
+
+    const auto& channel_quant_params = operand_type.channelQuant->params;
+    UpdateCacheToken(&channel_quant_params.channelDim, sizeof(channel_quant_params.channelDim));
+    UpdateCacheToken(operand_type.channelQuant->scales.data(),
+                     operand_type.channelQuant->scales.size() * sizeof(float));
   }
 
   return Status::OK();
@@ -450,6 +476,8 @@ Status ModelBuilder::SetOperandValue(uint32_t index,
           size));
 #endif
 
+  UpdateCacheToken(&index, sizeof(index));
+  UpdateCacheToken(memory->GetDataPtr() + offset, size);
   return Status::OK();
 }
 
@@ -468,6 +496,8 @@ Status ModelBuilder::AddOperandFromPersistMemoryBuffer(
         nnapi_->ANeuralNetworksModel_setOperandValue(
             nnapi_model_->model_, index,
             buffer, size));
+    UpdateCacheToken(&index, sizeof(index));
+    UpdateCacheToken(buffer, size);
   } else {
     const size_t padded_size = GetPaddedByteSize(size);
     auto persist_buffer = std::make_unique<Model::NNMemory>(nnapi_, name.c_str(), padded_size);
@@ -534,6 +564,10 @@ Status ModelBuilder::AddOperation(int op, const std::vector<uint32_t>& input_ind
           output_indices.size(), &output_indices[0]),
       "op = " + std::to_string(op));
 
+  UpdateCacheToken(&op, sizeof(op));
+  UpdateCacheToken(input_indices.data(), input_indices.size() * sizeof(uint32_t));
+  UpdateCacheToken(output_indices.data(), output_indices.size() * sizeof(uint32_t));
+
   num_nnapi_ops_++;
 
   LOGS_DEFAULT(VERBOSE) << "Added NNAPI Operation Type [" << op << "]";
@@ -611,6 +645,20 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
           nnapi_model_->compilation_, static_cast<int32_t>(exe_pref_)),
       "on setPreference");
 
+  // The compiled model also depends on the compilation options and the target devices
+  if (!compilation_cache_dir_.empty() && GetNNAPIFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_3) {
+    UpdateCacheToken(input_index_vec_.data(), input_index_vec_.size() * sizeof(uint32_t));
+    UpdateCacheToken(output_index_vec_.data(), output_index_vec_.size() * sizeof(uint32_t));
+    UpdateCacheToken(&use_fp16_, sizeof(use_fp16_));
+    UpdateCacheToken(&exe_pref_, sizeof(exe_pref_));
+    UpdateCacheToken(nnapi_target_devices_detail_.data(), nnapi_target_devices_detail_.size());
+
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_->ANeuralNetworksCompilation_setCaching(
+            nnapi_model_->compilation_, compilation_cache_dir_.c_str(), cache_token_.data()),
+        "on setCaching");
+  }
+
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_->ANeuralNetworksCompilation_finish(nnapi_model_->compilation_),
       "on compilation finish");
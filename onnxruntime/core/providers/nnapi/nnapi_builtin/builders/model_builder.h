@@ -3,6 +3,7 @@
 
 #pragma once
 #include <onnx/onnx_pb.h>
+#include <array>
 #include <unordered_set>
 
 #include "core/graph/basic_types.h"
@@ -87,6 +88,10 @@ class ModelBuilder {
 
   void SetTargetDeviceOption(TargetDeviceOption option) { target_device_option_ = option; }
 
+  // Let NNAPI cache the compiled model in the given directory, on Android API level 29+
+  // It is off by default (empty directory)
+  void SetCompilationCacheDir(const std::string& cache_dir) { compilation_cache_dir_ = cache_dir; }
+
   // Set NNAPI execution preference
   // Default preference is PREFER_SUSTAINED_SPEED
   void ExecutePreference(
@@ -161,6 +166,10 @@ class ModelBuilder {
   size_t num_nnapi_ops_ = 0;
   uint32_t next_index_ = 0;
 
+  std::string compilation_cache_dir_;
+  // Hash of everything added to the NNAPI model, which identifies the model in the compilation cache
+  std::array<uint8_t, ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN> cache_token_{};
+
   // Convert the onnx model to ANeuralNetworksModel
   common::Status Prepare();
 
@@ -187,6 +196,9 @@ class ModelBuilder {
 
   common::Status SetOperandValue(uint32_t index, Model::NNMemory* memory, size_t size, size_t offset);
 
+  // Mix the given data into cache_token_, if the compiled model is cached
+  void UpdateCacheToken(const void* data, size_t size);
+
   common::Status AddNewNNAPIOperand(const android::nn::wrapper::OperandType& type, uint32_t& index);
   common::Status AddNewOperand(const std::string& name,
                                const android::nn::wrapper::OperandType& operand_type,
@@ -50,10 +50,17 @@ std::unordered_set<std::string> GetPartitioningStopOps(const optional<std::strin
 }  // namespace
 
 NnapiExecutionProvider::NnapiExecutionProvider(uint32_t nnapi_flags,
-                                               const optional<std::string>& partitioning_stop_ops_list)
+                                               const optional<std::string>& partitioning_stop_ops_list,
+                                               const optional<std::string>& compilation_cache_dir)
     : IExecutionProvider{onnxruntime::kNnapiExecutionProvider, true},
       nnapi_flags_(nnapi_flags),
       partitioning_stop_ops_(GetPartitioningStopOps(partitioning_stop_ops_list)) {
+#ifdef __ANDROID__
+  compilation_cache_dir_ = compilation_cache_dir.value_or("");
+#else
+  ORT_UNUSED_PARAMETER(compilation_cache_dir);
+#endif
+
   AllocatorCreationInfo device_info(
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(NNAPI, OrtAllocatorType::OrtDeviceAllocator));
@@ -250,6 +257,7 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
     nnapi::ModelBuilder builder(graph_viewer);
     builder.SetUseNCHW(nnapi_flags_ & NNAPI_FLAG_USE_NCHW);
     builder.SetUseFp16(nnapi_flags_ & NNAPI_FLAG_USE_FP16);
+    builder.SetCompilationCacheDir(compilation_cache_dir_);
 
     bool cpu_disabled = nnapi_flags_ & NNAPI_FLAG_CPU_DISABLED;
     bool cpu_only = nnapi_flags_ & NNAPI_FLAG_CPU_ONLY;
@@ -15,7 +15,8 @@ class Model;
 class NnapiExecutionProvider : public IExecutionProvider {
  public:
   explicit NnapiExecutionProvider(uint32_t nnapi_flags,
-                                  const optional<std::string>& partitioning_stop_ops_list = {});
+                                  const optional<std::string>& partitioning_stop_ops_list = {},
+                                  const optional<std::string>& compilation_cache_dir = {});
 
   virtual ~NnapiExecutionProvider();
 
@@ -44,6 +45,9 @@ class NnapiExecutionProvider : public IExecutionProvider {
 
 #ifdef __ANDROID__
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::nnapi::Model>> nnapi_models_;
+
+  // The directory in which NNAPI caches the compiled models, empty if they are not cached.
+  std::string compilation_cache_dir_;
 #endif
 };
 }  // namespace onnxruntime
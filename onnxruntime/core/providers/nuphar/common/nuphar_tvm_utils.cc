@@ -20,6 +20,9 @@
 #undef _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING
 #include <atomic>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 namespace fs = std::experimental::filesystem;
 
 namespace onnxruntime {
@@ -173,15 +176,32 @@ CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtim
     }
   }
 
-  if (!VerifyCacheVersion(so_path)) {
-    return CacheStatus::Mismatch;
+  // Verify and load the dll once and look up all the functions from it, instead of
+  // reloading it for every fused subgraph and weight layout at session creation.
+  // The checksum setting is part of the key as it may differ between sessions.
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+  std::string module_key = so_path;
+  if (settings.HasOption(kNupharCacheModelChecksum)) {
+    module_key += "|" + settings.GetOptionValue(kNupharCacheModelChecksum);
+  }
+
+  static std::mutex cache_modules_mutex;
+  static std::unordered_map<std::string, std::unique_ptr<tvm::runtime::Module>> cache_modules;
+  std::lock_guard<std::mutex> lock(cache_modules_mutex);
+  auto module_it = cache_modules.find(module_key);
+  if (module_it == cache_modules.end()) {
+    // a null module records a version or checksum mismatch
+    std::unique_ptr<tvm::runtime::Module> module;
+    if (VerifyCacheVersion(so_path) && VerifyTVMModuleChecksum(so_path)) {
+      module = std::make_unique<tvm::runtime::Module>(tvm::runtime::Module::LoadFromFile(so_path));
+    }
+    module_it = cache_modules.emplace(module_key, std::move(module)).first;
   }
 
-  if (!VerifyTVMModuleChecksum(so_path))
+  if (module_it->second == nullptr)
     return CacheStatus::Mismatch;
 
-  tvm::runtime::Module module = tvm::runtime::Module::LoadFromFile(so_path);
-  func = module.GetFunction(func_name);
+  func = module_it->second->GetFunction(func_name);
   if (func == nullptr) {
     LOGS_DEFAULT(CODEGEN_SETTINGS_LOG_LEVEL) << "Cannot find " << func_name << " in cache, using JIT...";
     return CacheStatus::Missing;
@@ -189,6 +209,14 @@ CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtim
   return CacheStatus::Found;
 }
 
+void EnforceJITAllowed(const std::string& func_name) {
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+  if (settings.HasOption(kNupharCacheForceNoJIT) &&
+      settings.OptionMatches(kNupharCacheForceNoJIT, "on")) {
+    ORT_THROW("Force not using JIT code! ", func_name, " is not found in the cached dll.");
+  }
+}
+
 void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& module) {
   fs::path path;
 
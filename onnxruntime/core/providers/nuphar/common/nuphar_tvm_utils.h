@@ -29,6 +29,8 @@ enum class CacheStatus {
 
 CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtime::PackedFunc& func);
 void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& module);
+// Throws when nuphar_cache_force_no_jit is on, as func_name would need to be JIT compiled
+void EnforceJITAllowed(const std::string& func_name);
 
 std::string GetPackedFuncName(const nuphar::NupharSubgraphUnit& subgraph, const CodeGenTarget& codegen_target, int64_t parallel_min_workloads);
 
@@ -61,6 +61,7 @@ static tvm::runtime::PackedFunc LowerLayoutFunc(const tvm_codegen::WeightLayout*
   auto cache_status = nuphar::LoadTVMPackedFuncFromCache(func_name, cached_func);
   if (cache_status != nuphar::CacheStatus::Found) {
     ORT_ENFORCE(cached_func == nullptr);
+    nuphar::EnforceJITAllowed(func_name);
     auto lowered = tvm::lower(S, {inputs[0], outputs[0]}, func_name, {}, config);
     auto module = tvm::build(lowered, tvm::target::llvm(), tvm::Target(), config);
     tvm_codegen::DumpTVMModuleToFile(func_name, module);
@@ -156,11 +156,7 @@ tvm::runtime::PackedFunc NupharCompiler::GetLoweredPackedFunc(
   if (cache_status != nuphar::CacheStatus::Found) {
     codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
 
-    if (settings.HasOption(kNupharCacheForceNoJIT)) {
-      if (settings.OptionMatches(kNupharCacheForceNoJIT, "on")) {
-        ORT_THROW("Force not using JIT code!");
-      }
-    }
+    nuphar::EnforceJITAllowed(func_name);
 
     tvm::Schedule tvm_schedule = CreateSchedule(tvm_outputs_, context_);
     std::unordered_map<tvm::Tensor, tvm::Buffer> binds;
@@ -58,6 +58,23 @@ bool UseCompiledNetwork() {
   return false;
 }
 
+bool SetThroughputStreams(const std::string& device_type, std::map<std::string, std::string>& config) {
+  const std::string num_streams = onnxruntime::GetEnvironmentVar("ORT_OPENVINO_NUM_STREAMS");
+  if (num_streams.empty()) {
+    return false;
+  }
+  if (device_type.find("CPU") != std::string::npos) {
+    config[CONFIG_KEY(CPU_THROUGHPUT_STREAMS)] = (num_streams == "AUTO") ? CONFIG_VALUE(CPU_THROUGHPUT_AUTO) : num_streams;
+  } else if (device_type.find("GPU") != std::string::npos) {
+    config[CONFIG_KEY(GPU_THROUGHPUT_STREAMS)] = (num_streams == "AUTO") ? CONFIG_VALUE(GPU_THROUGHPUT_AUTO) : num_streams;
+  } else {
+    LOGS_DEFAULT(WARNING) << log_tag << "Throughput streams are only supported on CPU and GPU, ignoring ORT_OPENVINO_NUM_STREAMS";
+    return false;
+  }
+  LOGS_DEFAULT(INFO) << log_tag << "Using " << num_streams << " throughput streams";
+  return true;
+}
+
 std::string GetCurrentWorkingDir() {
   std::string curr_dir;
   ORT_UNUSED_PARAMETER(curr_dir);
@@ -34,6 +34,11 @@ bool IsCILogEnabled();
 
 bool UseCompiledNetwork();
 
+// Adds the throughput streams requested with ORT_OPENVINO_NUM_STREAMS to the config of a CPU or GPU network.
+// The value is a number of streams or "AUTO" to let the plugin pick it.
+// @returns true if streams were requested.
+bool SetThroughputStreams(const std::string& device_type, std::map<std::string, std::string>& config);
+
 std::string GetCurrentWorkingDir();
 
 bool IsDirExists(const std::string& pathname);
@@ -1,6 +1,7 @@
 // Copyright(C) 2019 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <memory>
@@ -46,6 +47,7 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
   std::string model_blob_name;
   std::ifstream blob_path;
   std::string ov_compiled_blobs_dir = "";
+  bool use_throughput_streams = false;
 
 #if defined(OPENVINO_2021_4)
   if(hw_target == "MYRIAD")
@@ -92,6 +94,7 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
   //to check preprocessing inside model
   config["MYRIAD_CHECK_PREPROCESSING_INSIDE_MODEL"] = CONFIG_VALUE(NO);
   }
+  use_throughput_streams = SetThroughputStreams(global_context_.device_type, config);
 
   //Enable caching
   if (global_context_.use_compiled_network == true) {
@@ -221,6 +224,7 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
           config["MYRIAD_COPY_OPTIMIZATION"] = CONFIG_VALUE(NO);
         }
       }
+      use_throughput_streams = SetThroughputStreams(global_context_.device_type, config);
       try {
         #if defined(IO_BUFFER_ENABLED)
         if ((global_context.device_type.find("GPU") != std::string::npos)  && 
@@ -253,6 +257,16 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
   //The infer_requests_ pool will be intialized with a default value of 8 infer_request's
   //The nireq value can also be configured to any num_of_threads during runtime
   size_t nireq = global_context_.num_of_threads;
+  // Each stream runs its own infer request, so keep at least as many requests as the plugin needs to fill
+  // all streams with the concurrent Run calls of the session.
+  if (use_throughput_streams) {
+    try {
+      auto optimal_nireq = exe_network_.GetMetric(METRIC_KEY(OPTIMAL_NUMBER_OF_INFER_REQUESTS)).as<unsigned int>();
+      nireq = std::max(nireq, static_cast<size_t>(optimal_nireq));
+    } catch (const Exception& e) {
+      LOGS_DEFAULT(WARNING) << log_tag << "Couldn't query the optimal number of infer requests: " << e.what();
+    }
+  }
   LOGS_DEFAULT(INFO) << log_tag << "The value of nireq being used is: " << nireq;
 #ifndef NDEBUG
   if (openvino_ep::backend_utils::IsDebugEnabled()) {
@@ -35,8 +35,29 @@ struct RknpuFuncState {
   std::unordered_map<std::string, int> output_map;
   std::vector<int> input_indexes;
   std::vector<int> output_indexes;
+  // The descriptors of the inputs and outputs only depend on the input shape,
+  // so they are set up when the graph is built and each run only sets the
+  // buffers of the tensors
+  std::vector<rk::nn::InputInfo> inputs;
+  std::vector<rk::nn::OutputInfo> outputs;
+  std::vector<std::vector<int64_t>> output_shapes;
 };
 
+static size_t GetPrecisionSize(rk::nn::PrecisionType type) {
+  switch (type) {
+    case rk::nn::PrecisionType::FLOAT32:
+      return 4;
+    case rk::nn::PrecisionType::UINT8:
+      return 1;
+    case rk::nn::PrecisionType::INT32:
+      return 4;
+    case rk::nn::PrecisionType::INT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
 RknpuExecutionProvider::RknpuExecutionProvider()
     : IExecutionProvider{onnxruntime::kRknpuExecutionProvider} {
   AllocatorCreationInfo default_memory_info{
@@ -415,95 +436,78 @@ common::Status RknpuExecutionProvider::Compile(
       ORT_ENFORCE(graph->GetOutputs().size() == n_outputs,
                   "Inconsistent output sizes");
 
-      std::vector<rk::nn::InputInfo> inputs;
-      inputs.resize(graph->GetInputs().size());
-      for (size_t i = 0; i < graph->GetInputs().size(); i++) {
-        const OrtValue* input_tensor =
-            ort.KernelContext_GetInput(context, rk_state->input_indexes[i]);
-        float* input_buf =
-            const_cast<float*>(ort.GetTensorData<float>(input_tensor));
-
-        const auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
-        const auto& tensor_shape = ort.GetTensorShape(tensor_info);
+      if (rebuild) {
+        rk_state->inputs.resize(graph->GetInputs().size());
+        for (size_t i = 0; i < graph->GetInputs().size(); i++) {
+          const OrtValue* input_tensor =
+              ort.KernelContext_GetInput(context, rk_state->input_indexes[i]);
+          auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+          const auto tensor_shape = ort.GetTensorShape(tensor_info);
+          ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
 
-        auto type = graph->GetInputs()[i]->GetPrecision();
-        size_t type_size = 4;
-        switch (type) {
-          case rk::nn::PrecisionType::FLOAT32:
-            type_size = 4;
-            break;
-          case rk::nn::PrecisionType::UINT8:
-            type_size = 1;
-            break;
-          case rk::nn::PrecisionType::INT32:
-            type_size = 4;
-            break;
-          case rk::nn::PrecisionType::INT64:
-            type_size = 8;
-            break;
-          default:
+          const auto type = graph->GetInputs()[i]->GetPrecision();
+          const size_t type_size = GetPrecisionSize(type);
+          if (type_size == 0) {
             // TODO
             throw std::invalid_argument(
                 "compute_func: unknow input data type!");
-            break;
+          }
+
+          auto& input = rk_state->inputs[i];
+          input.index = i;
+          input.size = std::accumulate(tensor_shape.begin(),
+                                       tensor_shape.end(), 1,
+                                       std::multiplies<int64_t>()) *
+                       type_size;
+          input.pass_through = false;
+          input.type = type;
+          input.layout = rk::nn::DataLayoutType::NCHW;
         }
 
-        inputs[i].index = i;
-        inputs[i].buf = (void*)input_buf;
-        inputs[i].size = std::accumulate(tensor_shape.begin(),
-                                         tensor_shape.end(), 1,
-                                         std::multiplies<int64_t>()) *
-                         type_size;
-        inputs[i].pass_through = false;
-        inputs[i].type = type;
-        inputs[i].layout = rk::nn::DataLayoutType::NCHW;
-      }
+        rk_state->outputs.resize(n_outputs);
+        rk_state->output_shapes.resize(n_outputs);
+        for (size_t i = 0; i < n_outputs; i++) {
+          const auto output = graph->GetOutputs()[i];
+          const auto output_shape = output->GetDims();
+          rk_state->output_shapes[i].assign(output_shape.begin(),
+                                            output_shape.end());
 
-      std::vector<rk::nn::OutputInfo> outputs;
-      outputs.resize(n_outputs);
-      for (size_t i = 0; i < n_outputs; i++) {
-        const auto output = graph->GetOutputs()[i];
-        const auto output_shape = output->GetDims();
-        std::vector<int64_t>
-            int64_output_shape(output_shape.begin(), output_shape.end());
-        const auto* output_tensor = ort.KernelContext_GetOutput(
-            context, rk_state->output_indexes[i],
-            int64_output_shape.data(),
-            int64_output_shape.size());
-        float* output_buf =
-            const_cast<float*>(ort.GetTensorData<float>(output_tensor));
-
-        const auto type = output->GetPrecision();
-        size_t type_size = 4;
-        switch (type) {
-          case rk::nn::PrecisionType::FLOAT32:
-            type_size = 4;
-            break;
-          case rk::nn::PrecisionType::UINT8:
-            type_size = 1;
-            break;
-          case rk::nn::PrecisionType::INT32:
-            type_size = 4;
-            break;
-          case rk::nn::PrecisionType::INT64:
-            type_size = 8;
-            break;
-          default:
+          const auto type = output->GetPrecision();
+          const size_t type_size = GetPrecisionSize(type);
+          if (type_size == 0) {
             // TODO
             throw std::invalid_argument(
                 "compute_func: unknow output data type!");
-            break;
+          }
+
+          auto& output_info = rk_state->outputs[i];
+          output_info.index = i;
+          output_info.size = accumulate(output_shape.begin(),
+                                        output_shape.end(), 1,
+                                        std::multiplies<uint32_t>()) *
+                             type_size;
+          output_info.type = type;
+          output_info.layout = rk::nn::DataLayoutType::NCHW;
+          output_info.want_float = false;
         }
+      }
+
+      // The NPU reads the inputs from and writes the outputs to the buffers
+      // of the ORT tensors
+      auto& inputs = rk_state->inputs;
+      for (size_t i = 0; i < inputs.size(); i++) {
+        const OrtValue* input_tensor =
+            ort.KernelContext_GetInput(context, rk_state->input_indexes[i]);
+        inputs[i].buf = const_cast<void*>(ort.GetTensorData<void>(input_tensor));
+      }
 
-        outputs[i].index = i;
-        outputs[i].buf = (void*)output_buf;
-        outputs[i].size = accumulate(output_shape.begin(),
-                                     output_shape.end(), 1,
-                                     std::multiplies<uint32_t>()) *
-                          type_size;
-        outputs[i].type = type;
-        outputs[i].layout = rk::nn::DataLayoutType::NCHW;
-        outputs[i].want_float = false;
+      auto& outputs = rk_state->outputs;
+      for (size_t i = 0; i < outputs.size(); i++) {
+        auto& output_shape = rk_state->output_shapes[i];
+        auto* output_tensor = ort.KernelContext_GetOutput(
+            context, rk_state->output_indexes[i],
+            output_shape.data(), output_shape.size());
+        outputs[i].buf = ort.GetTensorMutableData<void>(output_tensor);
       }
 
       rk_state->exector->SetInputs(inputs);
@@ -128,6 +128,7 @@ struct Capture;
 struct ComputeCapability;
 struct DataTransferManager;
 struct IndexedSubGraph;
+struct KernelTuningDatabase;
 struct IndexedSubGraph_MetaDef;
 struct KernelCreateInfo;
 struct KernelDef;
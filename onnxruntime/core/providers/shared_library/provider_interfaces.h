@@ -243,6 +243,12 @@ struct ProviderHost {
   virtual bool CPUIDInfo__HasAVX2(const CPUIDInfo* p) = 0;
   virtual bool CPUIDInfo__HasAVX512f(const CPUIDInfo* p) = 0;
 
+  // KernelTuningDatabase
+  virtual KernelTuningDatabase& KernelTuningDatabase__Instance() = 0;
+  virtual bool KernelTuningDatabase__IsEnabled(const KernelTuningDatabase* p) = 0;
+  virtual bool KernelTuningDatabase__Lookup(const KernelTuningDatabase* p, const std::string& device, const std::string& key, int& variant) = 0;
+  virtual void KernelTuningDatabase__Record(KernelTuningDatabase* p, const std::string& device, const std::string& key, int variant) = 0;
+
   // logging::Logger
   virtual bool logging__Logger__OutputIsEnabled(const logging::Logger* p, logging::Severity severity, logging::DataType data_type) = 0;
 
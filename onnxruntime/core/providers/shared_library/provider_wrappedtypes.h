@@ -14,6 +14,16 @@ struct CPUIDInfo final {
   PROVIDER_DISALLOW_ALL(CPUIDInfo)
 };
 
+struct KernelTuningDatabase final {
+  static KernelTuningDatabase& Instance() { return g_host->KernelTuningDatabase__Instance(); }
+
+  bool IsEnabled() const { return g_host->KernelTuningDatabase__IsEnabled(this); }
+  bool Lookup(const std::string& device, const std::string& key, int& variant) const { return g_host->KernelTuningDatabase__Lookup(this, device, key, variant); }
+  void Record(const std::string& device, const std::string& key, int variant) { g_host->KernelTuningDatabase__Record(this, device, key, variant); }
+
+  PROVIDER_DISALLOW_ALL(KernelTuningDatabase)
+};
+
 namespace logging {
 
 struct Logger final {
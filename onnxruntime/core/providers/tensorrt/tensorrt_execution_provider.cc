@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
+#include <cmath>
 #include <fstream>
 #include <list>
+#include <numeric>
 #include <unordered_set>
 #include "core/providers/shared_library/provider_api.h"
 #define ORT_API_MANUAL_INIT
@@ -19,6 +21,9 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <deque>
+#include <thread>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -114,6 +119,80 @@ bool SetDynamicRange(nvinfer1::INetworkDefinition& network, std::unordered_map<s
   }
   return true;
 }
+
+/*
+ * Pin the layers named in layer_precisions to a precision, e.g. to keep accuracy sensitive layers in FP16 or FP32
+ * while the rest of the network runs in INT8. Constraints to FP16 or INT8 only apply if the builder config enables
+ * that precision. TensorRT is asked to obey the constraints rather than treat them as preferences.
+ */
+void SetLayerPrecisions(nvinfer1::INetworkDefinition& network, nvinfer1::IBuilderConfig& config,
+                        const std::unordered_map<std::string, nvinfer1::DataType>& layer_precisions) {
+  if (layer_precisions.empty()) {
+    return;
+  }
+
+  size_t num_constrained_layers = 0;
+  for (int i = 0, end = network.getNbLayers(); i < end; ++i) {
+    auto trt_layer = network.getLayer(i);
+    const auto precision_iter = layer_precisions.find(trt_layer->getName());
+    if (precision_iter == layer_precisions.end()) {
+      continue;
+    }
+    const nvinfer1::DataType precision = precision_iter->second;
+    if ((precision == nvinfer1::DataType::kHALF && !config.getFlag(nvinfer1::BuilderFlag::kFP16)) ||
+        (precision == nvinfer1::DataType::kINT8 && !config.getFlag(nvinfer1::BuilderFlag::kINT8))) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] The precision of layer " << trt_layer->getName()
+                            << " isn't enabled, its constraint is ignored";
+      continue;
+    }
+    trt_layer->setPrecision(precision);
+    // the outputs of INT8 layers are left to TensorRT, which reformats them for the consumers
+    if (precision != nvinfer1::DataType::kINT8) {
+      for (int j = 0, num_outputs = trt_layer->getNbOutputs(); j < num_outputs; ++j) {
+        const auto output_type = trt_layer->getOutput(j)->getType();
+        if (output_type == nvinfer1::DataType::kFLOAT || output_type == nvinfer1::DataType::kHALF) {
+          trt_layer->setOutputType(j, precision);
+        }
+      }
+    }
+    ++num_constrained_layers;
+  }
+
+  if (num_constrained_layers > 0) {
+#if NV_TENSORRT_MAJOR > 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR >= 2)
+    config.setFlag(nvinfer1::BuilderFlag::kOBEY_PRECISION_CONSTRAINTS);
+#else
+    config.setFlag(nvinfer1::BuilderFlag::kSTRICT_TYPES);
+#endif
+  }
+}
+
+// In calibration mode every float activation is also an output of the network, so that its range can be collected
+void MarkActivationsAsOutputs(nvinfer1::INetworkDefinition& network) {
+  for (int i = 0, end = network.getNbLayers(); i < end; ++i) {
+    auto trt_layer = network.getLayer(i);
+    // the ranges of weights are computed from their values when the table is used
+    if (trt_layer->getType() == nvinfer1::LayerType::kCONSTANT) {
+      continue;
+    }
+    for (int j = 0, num_outputs = trt_layer->getNbOutputs(); j < num_outputs; ++j) {
+      auto tensor = trt_layer->getOutput(j);
+      if (!tensor->isNetworkOutput() && !tensor->isShapeTensor() && tensor->getType() == nvinfer1::DataType::kFLOAT) {
+        network.markOutput(*tensor);
+      }
+    }
+  }
+}
+
+// Hash of the layer precision constraints added to the engine cache names, empty if there are none
+std::string GetLayerPrecisionsSuffix(const std::string& layer_precisions_option) {
+  if (layer_precisions_option.empty()) {
+    return {};
+  }
+  std::ostringstream suffix;
+  suffix << "_lp" << std::hex << std::hash<std::string>{}(layer_precisions_option);
+  return suffix.str();
+}
 }  // namespace
 
 namespace google {
@@ -251,11 +330,334 @@ TensorrtLogger& GetTensorrtLogger() {
   return trt_logger;
 }
 
-std::unique_lock<OrtMutex> TensorrtExecutionProvider::GetApiLock() const {
+namespace {
+// Guards the TensorRT API calls that aren't thread safe, for all the providers and the background engine builder.
+std::unique_lock<OrtMutex> LockTensorrtApi() {
   static OrtMutex singleton;
   return std::unique_lock<OrtMutex>(singleton);
 }
 
+using ShapeRangesMap = std::unordered_map<std::string, std::unordered_map<size_t, std::pair<int64_t, int64_t>>>;
+
+/*
+ * Attach the timing cache persisted at `timing_cache_path` to a builder config, so that the kernel timings measured
+ * for previous engines are reused. Must be called with the TensorRT API lock held until the timing cache is saved.
+ * The returned timing cache must outlive the builder config.
+ */
+tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache> LoadTimingCache(nvinfer1::IBuilderConfig& trt_config,
+                                                                      const std::string& timing_cache_path) {
+  std::vector<char> timing_cache_buf = ReadBinaryFile(timing_cache_path);
+  auto timing_cache = tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache>(
+      trt_config.createTimingCache(timing_cache_buf.data(), timing_cache_buf.size()));
+  if (timing_cache == nullptr && !timing_cache_buf.empty()) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not load timing cache " << timing_cache_path << ", starting a new one";
+    timing_cache = tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache>(trt_config.createTimingCache(nullptr, 0));
+  }
+  if (timing_cache == nullptr || !trt_config.setTimingCache(*timing_cache, false)) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not set timing cache " << timing_cache_path;
+    return nullptr;
+  }
+  return timing_cache;
+}
+
+// Persist the timing cache of a builder config after an engine has been built with it.
+void SaveTimingCache(const nvinfer1::IBuilderConfig& trt_config, const std::string& timing_cache_path) {
+  const nvinfer1::ITimingCache* timing_cache = trt_config.getTimingCache();
+  if (timing_cache == nullptr) {
+    return;
+  }
+  auto serialized_cache = tensorrt_ptr::unique_pointer<nvinfer1::IHostMemory>(timing_cache->serialize());
+  if (serialized_cache == nullptr) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not serialize timing cache " << timing_cache_path;
+    return;
+  }
+  std::ofstream file(timing_cache_path, std::ios::binary | std::ios::out);
+  file.write(reinterpret_cast<const char*>(serialized_cache->data()), serialized_cache->size());
+  LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + timing_cache_path;
+}
+
+/*
+ * Add an optimization profile made of the declared shapes to a builder config. This is only done if the declared
+ * shapes cover all the dynamic inputs of the network, in which case the shape ranges of the dynamic dimensions are
+ * set to the declared min/max shapes so that inputs within them don't trigger engine rebuilds.
+ * Shape tensor inputs need shape values instead of shapes, so they are never covered.
+ */
+bool ApplyDeclaredProfile(const TensorrtProfileShapes& profile_shapes, nvinfer1::IBuilder& trt_builder,
+                          nvinfer1::INetworkDefinition& trt_network, nvinfer1::IBuilderConfig& trt_config,
+                          ShapeRangesMap& input_shape_ranges) {
+  nvinfer1::IOptimizationProfile* trt_profile = nullptr;
+  ShapeRangesMap declared_shape_ranges;
+  for (int i = 0, end = trt_network.getNbInputs(); i < end; ++i) {
+    auto input = trt_network.getInput(i);
+    const std::string input_name = input->getName();
+    nvinfer1::Dims dims = input->getDimensions();
+    if (input->isShapeTensor()) {
+      return false;
+    }
+    if (std::none_of(dims.d, dims.d + dims.nbDims, [](int32_t dim) { return dim == -1; })) {
+      continue;
+    }
+    if (!profile_shapes.Contains(input_name)) {
+      return false;
+    }
+
+    const auto& min_shape = profile_shapes.min_shapes.at(input_name);
+    const auto& max_shape = profile_shapes.max_shapes.at(input_name);
+    const auto& opt_shape = profile_shapes.opt_shapes.at(input_name);
+    if (min_shape.size() != static_cast<size_t>(dims.nbDims) || max_shape.size() != min_shape.size() ||
+        opt_shape.size() != min_shape.size()) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] The declared profile shapes of " << input_name
+                            << " don't match its rank " << dims.nbDims;
+      return false;
+    }
+
+    nvinfer1::Dims dims_min(dims), dims_opt(dims), dims_max(dims);
+    for (int j = 0; j < dims.nbDims; ++j) {
+      if (min_shape[j] > opt_shape[j] || opt_shape[j] > max_shape[j] ||
+          (dims.d[j] != -1 && (min_shape[j] != dims.d[j] || max_shape[j] != dims.d[j]))) {
+        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Invalid declared profile shapes for dimension " << j << " of "
+                              << input_name;
+        return false;
+      }
+      dims_min.d[j] = static_cast<int32_t>(min_shape[j]);
+      dims_opt.d[j] = static_cast<int32_t>(opt_shape[j]);
+      dims_max.d[j] = static_cast<int32_t>(max_shape[j]);
+      if (dims.d[j] == -1) {
+        declared_shape_ranges[input_name][j] = std::make_pair(min_shape[j], max_shape[j]);
+      }
+    }
+
+    if (trt_profile == nullptr) {
+      trt_profile = trt_builder.createOptimizationProfile();
+    }
+    trt_profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kMIN, dims_min);
+    trt_profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+    trt_profile->setDimensions(input_name.c_str(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
+  }
+
+  if (trt_profile == nullptr) {
+    return false;
+  }
+  trt_config.addOptimizationProfile(trt_profile);
+  input_shape_ranges = std::move(declared_shape_ranges);
+  return true;
+}
+
+// Everything needed to build the engine of a subgraph without the provider that scheduled it.
+struct TensorrtEngineBuildJob {
+  std::string name;
+  std::string model;  // serialized ModelProto of the subgraph
+  std::string model_path;
+  int device_id;
+  size_t max_workspace_size;
+  bool fp16_enable;
+  bool int8_enable;
+  std::string int8_calibration_cache_path;  // empty if there is no calibration table
+  bool int8_use_native_calibration_table;
+  bool dla_enable;
+  int dla_core;
+  std::unordered_map<std::string, nvinfer1::DataType> layer_precisions;
+  TensorrtProfileShapes profile_shapes;
+  std::string engine_cache_path;
+  std::string profile_cache_path;
+  std::string timing_cache_path;  // empty if the timing cache isn't enabled
+};
+
+Status BuildEngine(const TensorrtEngineBuildJob& job) {
+  CUDA_RETURN_IF_ERROR(cudaSetDevice(job.device_id));
+  TensorrtLogger& trt_logger = GetTensorrtLogger();
+  auto trt_builder = tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(trt_logger));
+  tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache> timing_cache;
+  const auto explicitBatch = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+  auto trt_network = tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>(trt_builder->createNetworkV2(explicitBatch));
+  auto trt_config = tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
+  auto trt_parser = tensorrt_ptr::unique_pointer<nvonnxparser::IParser>(nvonnxparser::createParser(*trt_network, trt_logger));
+  if (!trt_parser->parse(job.model.data(), job.model.size(), job.model_path.c_str())) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not parse subgraph ", job.name);
+  }
+  trt_config->setMaxWorkspaceSize(job.max_workspace_size);
+
+  bool has_dynamic_shape = false;
+  for (int i = 0, end = trt_network->getNbInputs(); i < end; ++i) {
+    auto input = trt_network->getInput(i);
+    nvinfer1::Dims dims = input->getDimensions();
+    if (input->isShapeTensor() || std::any_of(dims.d, dims.d + dims.nbDims, [](int32_t dim) { return dim == -1; })) {
+      has_dynamic_shape = true;
+    }
+  }
+  ShapeRangesMap input_shape_ranges;
+  if (has_dynamic_shape &&
+      !ApplyDeclaredProfile(job.profile_shapes, *trt_builder, *trt_network, *trt_config, input_shape_ranges)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "The declared profile shapes don't cover the dynamic inputs of ",
+                           job.name);
+  }
+
+  const bool fp16_enable = job.fp16_enable && trt_builder->platformHasFastFp16();
+  const bool int8_enable = job.int8_enable && trt_builder->platformHasFastInt8();
+  if (fp16_enable && int8_enable) {
+    trt_config->setFlags(1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kFP16) | 1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kINT8));
+  } else if (fp16_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
+  } else if (int8_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kINT8);
+  }
+  if (int8_enable && !job.int8_calibration_cache_path.empty()) {
+    std::unordered_map<std::string, float> dynamic_range_map;
+    if (!ReadDynamicRange(job.int8_calibration_cache_path, job.int8_use_native_calibration_table, dynamic_range_map)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "Failed to read INT8 calibration table ", job.int8_calibration_cache_path);
+    }
+    trt_config->setInt8Calibrator(nullptr);
+    if (!SetDynamicRange(*trt_network, dynamic_range_map)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not set INT8 dynamic range for ", job.name);
+    }
+  }
+  if ((fp16_enable || int8_enable) && job.dla_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
+    trt_config->setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
+    trt_config->setDLACore(job.dla_core);
+  }
+  SetLayerPrecisions(*trt_network, *trt_config, job.layer_precisions);
+
+  tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> trt_engine;
+  {
+    auto lock = LockTensorrtApi();
+    if (!job.timing_cache_path.empty()) {
+      timing_cache = LoadTimingCache(*trt_config, job.timing_cache_path);
+    }
+    trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
+    if (timing_cache != nullptr) {
+      SaveTimingCache(*trt_config, job.timing_cache_path);
+    }
+  }
+  if (trt_engine == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not build engine for ", job.name);
+  }
+
+  // The profile is written first and the engine is moved in place once complete, so that a session never picks up
+  // a partial engine or an engine without its profile.
+  if (has_dynamic_shape) {
+    SerializeProfile(job.profile_cache_path, input_shape_ranges);
+  }
+  auto serialized_engine = tensorrt_ptr::unique_pointer<nvinfer1::IHostMemory>(trt_engine->serialize());
+  const std::string temp_engine_cache_path = job.engine_cache_path + ".tmp";
+  {
+    std::ofstream file(temp_engine_cache_path, std::ios::binary | std::ios::out);
+    file.write(reinterpret_cast<const char*>(serialized_engine->data()), serialized_engine->size());
+    if (!file) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not write ", temp_engine_cache_path);
+    }
+  }
+  fs::rename(temp_engine_cache_path, job.engine_cache_path);
+  return Status::OK();
+}
+
+/*
+ * Builds engines on a background thread shared by all the providers of the process, so that sessions created with
+ * trt_engine_build_async don't wait for them. The engines are written to the engine cache, where the sessions
+ * created afterwards find them.
+ */
+class TensorrtEngineBuilder {
+ public:
+  static TensorrtEngineBuilder& Get() {
+    static TensorrtEngineBuilder builder;
+    return builder;
+  }
+
+  ~TensorrtEngineBuilder() {
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      shutdown_ = true;
+      jobs_.clear();
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // Returns false if the engine failed to build before.
+  bool Schedule(TensorrtEngineBuildJob job) {
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      if (failed_.count(job.engine_cache_path) != 0) {
+        return false;
+      }
+      if (!scheduled_.insert(job.engine_cache_path).second) {
+        return true;
+      }
+      LOGS_DEFAULT(INFO) << "[TensorRT EP] Building engine " << job.engine_cache_path << " in the background";
+      jobs_.push_back(std::move(job));
+      if (!thread_.joinable()) {
+        thread_ = std::thread([this]() { Loop(); });
+      }
+    }
+    cv_.notify_one();
+    return true;
+  }
+
+  bool HasFailed(const std::string& engine_cache_path) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    return failed_.count(engine_cache_path) != 0;
+  }
+
+ private:
+  TensorrtEngineBuilder() = default;
+
+  void Loop() {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this]() { return shutdown_ || !jobs_.empty(); });
+      if (shutdown_) {
+        return;
+      }
+      TensorrtEngineBuildJob job = std::move(jobs_.front());
+      jobs_.pop_front();
+
+      lock.unlock();
+      Status status;
+      ORT_TRY {
+        status = BuildEngine(job);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, ex.what());
+        });
+      }
+      lock.lock();
+
+      if (status.IsOK()) {
+        LOGS_DEFAULT(INFO) << "[TensorRT EP] Built engine " << job.engine_cache_path;
+      } else {
+        // the subgraph is compiled at session initialization from now on
+        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Background engine build failed: " << status.ErrorMessage();
+        failed_.insert(job.engine_cache_path);
+      }
+      scheduled_.erase(job.engine_cache_path);
+    }
+  }
+
+  OrtMutex mutex_;
+  OrtCondVar cv_;
+  std::deque<TensorrtEngineBuildJob> jobs_;
+  std::unordered_set<std::string> scheduled_;
+  std::unordered_set<std::string> failed_;
+  bool shutdown_ = false;
+  std::thread thread_;
+};
+
+// FNV-1a, used to derive engine cache names that are stable across processes.
+uint64_t HashString(const std::string& str, uint64_t hash = 14695981039346656037ULL) {
+  for (unsigned char c : str) {
+    hash = (hash ^ c) * 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace
+
+std::unique_lock<OrtMutex> TensorrtExecutionProvider::GetApiLock() const {
+  return LockTensorrtApi();
+}
+
 TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProviderInfo& info)
     : IExecutionProvider{onnxruntime::kTensorrtExecutionProvider, true}, info_(info), device_id_(info.device_id) {
   CUDA_CALL_THROW(cudaSetDevice(device_id_));
@@ -267,13 +669,15 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
   }
 
   // Get environment variables
+  std::string profile_min_shapes, profile_max_shapes, profile_opt_shapes;
   if (info.has_trt_options) {
     max_partition_iterations_ = info.max_partition_iterations;
     min_subgraph_size_ = info.min_subgraph_size;
     max_workspace_size_ = info.max_workspace_size;
     fp16_enable_ = info.fp16_enable;
     int8_enable_ = info.int8_enable;
-    if (int8_enable_) {
+    int8_calibration_enable_ = info.int8_calibration_enable;
+    if (int8_enable_ || int8_calibration_enable_) {
       int8_calibration_cache_name_ = info.int8_calibration_table_name;
       int8_use_native_tensorrt_calibration_table_ = info.int8_use_native_calibration_table;
     }
@@ -283,7 +687,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     }
     dump_subgraphs_ = info.dump_subgraphs;
     engine_cache_enable_ = info.engine_cache_enable;
-    if (engine_cache_enable_ || int8_enable_) {
+    timing_cache_enable_ = info.timing_cache_enable;
+    if (engine_cache_enable_ || int8_enable_ || int8_calibration_enable_ || timing_cache_enable_) {
       cache_path_ = info.engine_cache_path;
     }
     engine_decryption_enable_ = info.engine_decryption_enable;
@@ -291,6 +696,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       engine_decryption_lib_path_ = info.engine_decryption_lib_path;
     }
     force_sequential_engine_build_ = info.force_sequential_engine_build;
+    engine_build_async_ = info.engine_build_async;
+    profile_min_shapes = info.profile_min_shapes;
+    profile_max_shapes = info.profile_max_shapes;
+    profile_opt_shapes = info.profile_opt_shapes;
+    layer_precisions_option_ = info.layer_precisions;
   } else {
     const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
     if (!max_partition_iterations_env.empty()) {
@@ -317,7 +727,12 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       int8_enable_ = (std::stoi(int8_enable_env) == 0 ? false : true);
     }
 
-    if (int8_enable_) {
+    const std::string int8_calibration_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kINT8CalibrationEnable);
+    if (!int8_calibration_enable_env.empty()) {
+      int8_calibration_enable_ = (std::stoi(int8_calibration_enable_env) == 0 ? false : true);
+    }
+
+    if (int8_enable_ || int8_calibration_enable_) {
       const std::string int8_calibration_cache_name_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kINT8CalibrationTableName);
       if (!int8_calibration_cache_name_env.empty()) {
         int8_calibration_cache_name_ = int8_calibration_cache_name_env;
@@ -353,7 +768,12 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       engine_cache_enable_ = (std::stoi(engine_cache_enable_env) == 0 ? false : true);
     }
 
-    if (engine_cache_enable_ || int8_enable_) {
+    const std::string timing_cache_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kTimingCacheEnable);
+    if (!timing_cache_enable_env.empty()) {
+      timing_cache_enable_ = (std::stoi(timing_cache_enable_env) == 0 ? false : true);
+    }
+
+    if (engine_cache_enable_ || int8_enable_ || int8_calibration_enable_ || timing_cache_enable_) {
       const std::string engine_cache_path = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineCachePath);
       cache_path_ = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kCachePath);
       if (!engine_cache_path.empty() && cache_path_.empty()) {
@@ -375,6 +795,16 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     if (!force_sequential_engine_build_env.empty()) {
       force_sequential_engine_build_ = (std::stoi(force_sequential_engine_build_env) == 0 ? false : true);
     }
+
+    const std::string engine_build_async_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineBuildAsync);
+    if (!engine_build_async_env.empty()) {
+      engine_build_async_ = (std::stoi(engine_build_async_env) == 0 ? false : true);
+    }
+
+    profile_min_shapes = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfileMinShapes);
+    profile_max_shapes = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfileMaxShapes);
+    profile_opt_shapes = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfileOptShapes);
+    layer_precisions_option_ = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kLayerPrecisions);
   }
 
   // Validate setting
@@ -395,7 +825,36 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     dla_core_ = 0;
   }
 
-  if (engine_cache_enable_ || int8_enable_) {
+  if (!ParseProfileShapes(profile_min_shapes, profile_shapes_.min_shapes) ||
+      !ParseProfileShapes(profile_max_shapes, profile_shapes_.max_shapes) ||
+      !ParseProfileShapes(profile_opt_shapes, profile_shapes_.opt_shapes)) {
+    ORT_THROW("[TensorRT EP] Invalid profile shapes. They should be given as 'input1:1x3x224x224,input2:1x128'");
+  }
+  if (!ParseLayerPrecisions(layer_precisions_option_, layer_precisions_)) {
+    ORT_THROW("[TensorRT EP] Invalid layer precisions. They should be given as 'Conv_12:fp32,MatMul_40:fp16,Conv_7:int8'");
+  }
+  if (int8_calibration_enable_) {
+    if (int8_calibration_cache_name_.empty()) {
+      ORT_THROW("[TensorRT EP] TensorRT option trt_int8_calibration_enable requires trt_int8_calibration_table_name");
+    }
+    // The ranges are collected from FP32 engines with the extra outputs, which are neither cached nor built ahead
+    if (fp16_enable_ || int8_enable_ || engine_cache_enable_ || engine_build_async_) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_int8_calibration_enable runs FP32 engines without "
+                            << "engine cache. FP16, INT8, engine cache and background engine builds are disabled";
+    }
+    fp16_enable_ = false;
+    int8_enable_ = false;
+    dla_enable_ = false;
+    engine_cache_enable_ = false;
+    engine_build_async_ = false;
+  }
+  if (engine_build_async_ && (!engine_cache_enable_ || engine_decryption_enable_)) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_engine_build_async requires trt_engine_cache_enable "
+                          << "and doesn't support engine decryption. Engines will be built synchronously";
+    engine_build_async_ = false;
+  }
+
+  if (engine_cache_enable_ || int8_enable_ || int8_calibration_enable_ || timing_cache_enable_) {
     if (!cache_path_.empty() && !fs::is_directory(cache_path_)) {
       if (!fs::create_directory(cache_path_)) {
         throw std::runtime_error("Failed to create directory " + cache_path_);
@@ -421,6 +880,14 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     int8_calibration_cache_available_ = !int8_calibration_cache_name_.empty();
   }
 
+  if (timing_cache_enable_) {
+    // Timings are only valid for the GPU they were measured on
+    cudaDeviceProp prop;
+    CUDA_CALL_THROW(cudaGetDeviceProperties(&prop, device_id_));
+    timing_cache_path_ = GetCachePath(cache_path_, "TensorrtExecutionProvider_sm" + std::to_string(prop.major) +
+                                                       std::to_string(prop.minor) + ".timing");
+  }
+
   LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] TensorRT provider options: "
                         << "device_id: " << device_id_
                         << ", trt_max_partition_iterations: " << max_partition_iterations_
@@ -431,6 +898,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_int8_calibration_cache_name: " << int8_calibration_cache_name_
                         << ", int8_calibration_cache_available: " << int8_calibration_cache_available_
                         << ", trt_int8_use_native_tensorrt_calibration_table: " << int8_use_native_tensorrt_calibration_table_
+                        << ", trt_int8_calibration_enable: " << int8_calibration_enable_
+                        << ", trt_layer_precisions: " << layer_precisions_option_
                         << ", trt_dla_enable: " << dla_enable_
                         << ", trt_dla_core: " << dla_core_
                         << ", trt_dump_subgraphs: " << dump_subgraphs_
@@ -438,10 +907,24 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_cache_path: " << cache_path_
                         << ", trt_engine_decryption_enable: " << engine_decryption_enable_
                         << ", trt_engine_decryption_lib_path: " << engine_decryption_lib_path_
-                        << ", trt_force_sequential_engine_build: " << force_sequential_engine_build_;
+                        << ", trt_force_sequential_engine_build: " << force_sequential_engine_build_
+                        << ", trt_timing_cache_enable: " << timing_cache_enable_
+                        << ", trt_engine_build_async: " << engine_build_async_
+                        << ", trt_profile_min_shapes: " << profile_min_shapes
+                        << ", trt_profile_max_shapes: " << profile_max_shapes
+                        << ", trt_profile_opt_shapes: " << profile_opt_shapes;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
+  if (int8_calibration_enable_ && !calibration_ranges_.empty()) {
+    const std::string calibration_table_path = GetCachePath(cache_path_, int8_calibration_cache_name_);
+    if (WriteDynamicRange(calibration_table_path, calibration_ranges_)) {
+      LOGS_DEFAULT(INFO) << "[TensorRT EP] Wrote the ranges of " << calibration_ranges_.size()
+                         << " tensors to INT8 calibration table " << calibration_table_path;
+    } else {
+      LOGS_DEFAULT(ERROR) << "[TensorRT EP] Failed to write INT8 calibration table " << calibration_table_path;
+    }
+  }
   if (!external_stream_ && stream_) {
     CUDA_CALL(cudaStreamDestroy(stream_));
   }
@@ -671,6 +1154,22 @@ std::unique_ptr<IndexedSubGraph> TensorrtExecutionProvider::GetSubGraph(SubGraph
   const std::string graph_type = graph.IsSubgraph() ? "subgraph" : "graph";
   meta_def->name() = "TRTKernel_" + graph_type + "_" + graph.Name() + "_" + subgraph_id;
 
+  // The id in the kernel name depends on the subgraphs compiled before in the process, so engines that are built
+  // in the background for later sessions are cached under a name derived from the content of the subgraph instead
+  if (engine_build_async_) {
+    std::string subgraph_content;
+    for (const auto& index : graph_nodes_index.first) {
+      const auto& node = graph.GetNode(node_index[index]);
+      subgraph_content += node->Domain() + ":" + node->OpType() + ":" + node->Name() + ";";
+      for (const auto& output : node->OutputDefs()) {
+        subgraph_content += output->Name() + ";";
+      }
+    }
+    engine_cache_names_[meta_def->name()] = "TRTKernel_" + graph_type + "_" + graph.Name() + "_" +
+                                            std::to_string(model_hash) + "_" +
+                                            std::to_string(HashString(subgraph_content));
+  }
+
   // Assign inputs and outputs to subgraph's meta_def
   for (const auto& input : inputs) {
     if (input.second->Exists()) {
@@ -989,15 +1488,29 @@ TensorrtExecutionProvider::GetCapability(const GraphViewer& graph,
   // Construct subgraph capability from node list
   std::vector<std::unique_ptr<ComputeCapability>> result;
   int number_of_trt_nodes = 0;
+  size_t number_of_subgraphs = 0;
   for (const auto& group : supported_nodes_vector) {
     if (!group.first.empty()) {
       std::unique_ptr<IndexedSubGraph> sub_graph = GetSubGraph(group, graph);
+
+      // Leave the nodes to the other execution providers while the engine is built in the background. The engine
+      // is used by the sessions created once it is in the engine cache.
+      if (engine_build_async_ && !graph.IsSubgraph()) {
+        const std::string cache_name = engine_cache_names_[sub_graph->GetMetaDef()->name()] + GetPrecisionSuffix();
+        const std::string engine_cache_path = GetCachePath(cache_path_, cache_name) + ".engine";
+        if (!fs::exists(engine_cache_path) && ScheduleEngineBuild(*sub_graph, graph, cache_name)) {
+          LOGS_DEFAULT(INFO) << "[TensorRT EP] " << group.first.size() << " nodes won't run on TensorRT until "
+                             << engine_cache_path << " is built";
+          continue;
+        }
+      }
+
       result.push_back(ComputeCapability::Create(std::move(sub_graph)));
       number_of_trt_nodes += static_cast<int>(group.first.size());
+      ++number_of_subgraphs;
     }
   }
 
-  const size_t number_of_subgraphs = supported_nodes_vector.size();
   if (number_of_trt_nodes == 0) {
     LOGS_DEFAULT(WARNING) << "[TensorRT EP] No graph will run on TensorRT execution provider";
   } else if (number_of_trt_nodes == number_of_ort_nodes) {
@@ -1009,6 +1522,107 @@ TensorrtExecutionProvider::GetCapability(const GraphViewer& graph,
   return result;
 }
 
+std::string TensorrtExecutionProvider::GetPrecisionSuffix() const {
+  std::string suffix;
+  if (fp16_enable_ && int8_enable_) {
+    suffix = "_fp16_int8";
+  } else if (fp16_enable_) {
+    suffix = "_fp16";
+  } else if (int8_enable_) {
+    suffix = "_int8";
+  }
+  if ((fp16_enable_ || int8_enable_) && dla_enable_ && dla_core_ >= 0) {
+    suffix += "_dlacore" + std::to_string(dla_core_);
+  }
+  suffix += GetLayerPrecisionsSuffix(layer_precisions_option_);
+  return suffix;
+}
+
+bool TensorrtExecutionProvider::ScheduleEngineBuild(IndexedSubGraph& sub_graph, const GraphViewer& graph,
+                                                    const std::string& cache_name) const {
+  const std::string cache_path = GetCachePath(cache_path_, cache_name);
+  if (TensorrtEngineBuilder::Get().HasFailed(cache_path + ".engine")) {
+    return false;
+  }
+
+  // The engine can only be built before the first run if the shapes of the inputs are known
+  const auto* meta_def = sub_graph.GetMetaDef();
+  for (const auto& input_name : meta_def->inputs()) {
+    const auto* input_shape = graph.GetNodeArg(input_name)->Shape();
+    if (input_shape == nullptr) {
+      return false;
+    }
+    for (int i = 0, end = input_shape->dim_size(); i < end; ++i) {
+      const auto& dim = input_shape->dim(i);
+      if ((!dim.has_dim_value() || dim.dim_value() < 0) && !profile_shapes_.Contains(input_name)) {
+        return false;
+      }
+    }
+  }
+
+  // Rebuild the subgraph as a model whose outputs are the outputs of the fused node
+  auto model_build = graph.CreateModel(*GetLogger());
+  auto& graph_build = model_build->MainGraph();
+  for (const auto& index : sub_graph.Nodes()) {
+    const auto& node = graph.GetNode(index);
+    std::vector<onnxruntime::NodeArg*> inputs, outputs;
+    for (auto input : node->InputDefs()) {
+      auto& n_input = graph_build.GetOrCreateNodeArg(input->Name(), input->TypeAsProto());
+      inputs.push_back(&n_input);
+      const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+      if (graph.IsConstantInitializer(input->Name(), false) && graph.GetInitializedTensor(input->Name(), initializer)) {
+        const ONNX_NAMESPACE::TensorProto* subgraph_initializer = nullptr;
+        if (!graph_build.GetInitializedTensor(input->Name(), subgraph_initializer)) {
+          graph_build.AddInitializedTensor(*(initializer));
+        }
+      }
+    }
+    for (auto output : node->OutputDefs()) {
+      auto& n_output = graph_build.GetOrCreateNodeArg(output->Name(), output->TypeAsProto());
+      outputs.push_back(&n_output);
+    }
+    graph_build.AddNode(node->Name(), node->OpType(), node->Description(), inputs, outputs, &node->GetAttributes(), node->Domain());
+  }
+  if (!graph_build.Resolve().IsOK()) {
+    return false;
+  }
+  std::vector<const NodeArg*> subgraph_outputs;
+  for (const auto& output_name : meta_def->outputs()) {
+    subgraph_outputs.push_back(&graph_build.GetOrCreateNodeArg(output_name, graph.GetNodeArg(output_name)->TypeAsProto()));
+  }
+  graph_build.SetOutputs(subgraph_outputs);
+  if (!graph_build.Resolve().IsOK()) {
+    return false;
+  }
+
+  auto graph_viewer = graph_build.CreateGraphViewer();
+  auto model = graph_viewer->CreateModel(*GetLogger());
+  auto model_proto = model->ToProto();
+  ToGraphProtoInternal(*graph_viewer, *model_proto->mutable_graph());
+  model_proto->set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+
+  TensorrtEngineBuildJob job;
+  job.name = meta_def->name();
+  model_proto->SerializeToString(job.model);
+  job.model_path = model_path_;
+  job.device_id = device_id_;
+  job.max_workspace_size = max_workspace_size_;
+  job.fp16_enable = fp16_enable_;
+  job.int8_enable = int8_enable_;
+  if (int8_enable_ && int8_calibration_cache_available_) {
+    job.int8_calibration_cache_path = GetCachePath(cache_path_, int8_calibration_cache_name_);
+  }
+  job.int8_use_native_calibration_table = int8_use_native_tensorrt_calibration_table_;
+  job.dla_enable = dla_enable_;
+  job.dla_core = dla_core_;
+  job.layer_precisions = layer_precisions_;
+  job.profile_shapes = profile_shapes_;
+  job.engine_cache_path = cache_path + ".engine";
+  job.profile_cache_path = cache_path + ".profile";
+  job.timing_cache_path = timing_cache_path_;
+  return TensorrtEngineBuilder::Get().Schedule(std::move(job));
+}
+
 common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fused_nodes,
                                                   std::vector<NodeComputeInfo>& node_compute_funcs) {
   for (const auto* fused_node : fused_nodes) {
@@ -1050,6 +1664,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
 
     TensorrtLogger& trt_logger = GetTensorrtLogger();
     auto trt_builder = tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(trt_logger));
+    tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache> timing_cache;
     const auto explicitBatch = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
     auto trt_network = tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>(trt_builder->createNetworkV2(explicitBatch));
     auto trt_config = tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
@@ -1063,6 +1678,9 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
     std::unordered_map<std::string, std::unordered_map<size_t, std::pair<int64_t, int64_t>>> input_shape_ranges;
     std::unordered_map<std::string, size_t> output_indexes(num_outputs);
     std::unordered_map<std::string, size_t> output_types(num_outputs);
+    if (int8_calibration_enable_) {
+      MarkActivationsAsOutputs(*trt_network);
+    }
 
     // Initialize shape range for dynamic shape tensors
     bool has_dynamic_shape = false;
@@ -1086,6 +1704,13 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
       }
     }
 
+    // Use the declared profile if it covers all the dynamic shape inputs, so that the engine can be built now and
+    // isn't rebuilt for input shapes within the declared ranges
+    bool has_declared_profile = false;
+    if (has_dynamic_shape) {
+      has_declared_profile = ApplyDeclaredProfile(profile_shapes_, *trt_builder, *trt_network, *trt_config, input_shape_ranges);
+    }
+
     // Check platform availability for low precision
     if (fp16_enable_) {
       if (!trt_builder->platformHasFastFp16()) {
@@ -1112,6 +1737,10 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
 
     // Set precision flags
     std::string trt_node_name_with_precision = fused_node->Name();
+    auto cache_name_it = engine_cache_names_.find(fused_node->Name());
+    if (cache_name_it != engine_cache_names_.end()) {
+      trt_node_name_with_precision = cache_name_it->second;
+    }
     if (fp16_enable_ && int8_enable_) {
       trt_config->setFlags(1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kFP16) | 1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kINT8));
       trt_node_name_with_precision += "_fp16_int8";
@@ -1146,15 +1775,25 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         }
       }
     }
+    trt_node_name_with_precision += GetLayerPrecisionsSuffix(layer_precisions_option_);
 
-    // Build TRT engine here if the graph doesn't have dynamic shape input. Otherwise engine will
-    // be built at runtime
+    // Build TRT engine here if the graph doesn't have dynamic shape input or has a declared profile. Otherwise
+    // engine will be built at runtime
     tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> trt_engine;
     tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext> trt_context;
-    if (!has_dynamic_shape) {
+    if (!has_dynamic_shape || has_declared_profile) {
       const std::string cache_path = GetCachePath(cache_path_, trt_node_name_with_precision);
       const std::string engine_cache_path = cache_path + ".engine";
+      const std::string profile_cache_path = cache_path + ".profile";
       std::ifstream engine_file(engine_cache_path, std::ios::binary | std::ios::in);
+      if (has_declared_profile && engine_cache_enable_) {
+        // The cached engine may have been rebuilt at runtime for shapes outside of the declared ranges
+        std::ifstream profile_file(profile_cache_path, std::ios::binary | std::ios::in);
+        if (profile_file) {
+          input_shape_ranges = DeserializeProfile(profile_file);
+          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + profile_cache_path;
+        }
+      }
       if (engine_cache_enable_ && engine_file) {
         engine_file.seekg(0, std::ios::end);
         size_t engine_size = engine_file.tellg();
@@ -1195,17 +1834,28 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
                                    "TensorRT EP could not set INT8 dynamic range for fused node: " + fused_node->Name());
           }
         }
+        SetLayerPrecisions(*trt_network, *trt_config, layer_precisions_);
 
         // Build engine
         {
           auto lock = GetApiLock();
+          if (timing_cache_enable_) {
+            timing_cache = LoadTimingCache(*trt_config, timing_cache_path_);
+          }
           trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
+          if (timing_cache != nullptr) {
+            SaveTimingCache(*trt_config, timing_cache_path_);
+          }
         }
         if (trt_engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
                                  "TensorRT EP could not build engine for fused node: " + fused_node->Name());
         }
         if (engine_cache_enable_) {
+          if (has_declared_profile) {
+            SerializeProfile(profile_cache_path, input_shape_ranges);
+            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + profile_cache_path;
+          }
           nvinfer1::IHostMemory* serializedModel = trt_engine->serialize();
           size_t engine_size = serializedModel->size();
           if (engine_decryption_enable_) {
@@ -1274,7 +1924,8 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
             &networks_[context->node_name], input_info_[context->node_name], output_info_[context->node_name],
             input_shape_ranges_[context->node_name], &tensorrt_mu_, fp16_enable_, int8_enable_, int8_calibration_cache_available_,
             dla_enable_, dla_core_, &max_workspace_size_, trt_node_name_with_precision, engine_cache_enable_, cache_path_,
-            runtime_.get(), nullptr, allocator_, dynamic_range_map, engine_decryption_enable_, engine_decryption_, engine_encryption_};
+            runtime_.get(), nullptr, allocator_, dynamic_range_map, engine_decryption_enable_, engine_decryption_, engine_encryption_,
+            timing_cache_path_, &layer_precisions_, int8_calibration_enable_ ? &calibration_ranges_ : nullptr};
       *state = p.release();
       return 0;
     };
@@ -1508,6 +2159,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
       if (engine_update) {
         trt_state->context->reset();
         trt_state->engine->reset();
+        tensorrt_ptr::unique_pointer<nvinfer1::ITimingCache> timing_cache;
         auto trt_config = tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
         trt_config->setMaxWorkspaceSize(*(trt_state->max_workspace_size_ptr));
         trt_config->addOptimizationProfile(*trt_profile);
@@ -1536,12 +2188,19 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
           trt_config->setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
           trt_config->setDLACore(trt_state->dla_core);
         }
+        SetLayerPrecisions(*trt_state->network->get(), *trt_config, *trt_state->layer_precisions);
 
         // Build engine
         {
           auto lock = GetApiLock();
+          if (!trt_state->timing_cache_path.empty()) {
+            timing_cache = LoadTimingCache(*trt_config, trt_state->timing_cache_path);
+          }
           *(trt_state->engine) = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(
               trt_builder->buildEngineWithConfig(*trt_state->network->get(), *trt_config));
+          if (timing_cache != nullptr) {
+            SaveTimingCache(*trt_config, trt_state->timing_cache_path);
+          }
         }
         if (trt_state->engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
@@ -1726,8 +2385,8 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
       }
 
       // Set output shapes and assign output buffers
-      std::vector<int> output_dim_sizes(num_outputs, 1);
-      std::vector<OrtValue*> output_tensor(num_outputs, nullptr);
+      std::vector<int> output_dim_sizes(output_binding_names.size(), 1);
+      std::vector<OrtValue*> output_tensor(output_binding_names.size(), nullptr);
       for (size_t i = 0, end = output_binding_names.size(); i < end; ++i) {
         // Set dynamic shapes
         const std::string& output_name = output_binding_names[i];
@@ -1740,6 +2399,15 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         const auto& index_iter = output_indexes.find(output_name);
         if (index_iter != output_indexes.end()) {
           output_index = index_iter->second;
+        } else if (trt_state->calibration_ranges != nullptr) {
+          // A float activation marked as output for calibration, which only lives for this run
+          nvinfer1::Dims dimensions = trt_context->getBindingDimensions(binding_index);
+          const int64_t element_count = std::accumulate(dimensions.d, dimensions.d + dimensions.nbDims, int64_t{1},
+                                                        std::multiplies<int64_t>());
+          scratch_buffers.push_back(
+              IAllocator::MakeUniquePtr<void>(alloc, std::max<int64_t>(element_count, 1) * sizeof(float)));
+          buffers[binding_index] = scratch_buffers.back().get();
+          continue;
         }
         nvinfer1::Dims dimensions = trt_context->getBindingDimensions(static_cast<int>(binding_index));
         int nb_dims = dimensions.nbDims;
@@ -1863,6 +2531,37 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "TensorRT EP execution context enqueue failed.");
       }
 
+      // Collect the ranges of the float inputs, activations and outputs for the calibration table
+      if (trt_state->calibration_ranges != nullptr) {
+        std::vector<std::pair<int, std::vector<float>>> calibration_values;
+        for (int binding_index = 0; binding_index < total_bindings; ++binding_index) {
+          if (trt_engine->getBindingDataType(binding_index) != nvinfer1::DataType::kFLOAT ||
+              buffers[binding_index] == nullptr) {
+            continue;
+          }
+          nvinfer1::Dims dimensions = trt_context->getBindingDimensions(binding_index);
+          const int64_t element_count = std::accumulate(dimensions.d, dimensions.d + dimensions.nbDims, int64_t{1},
+                                                        std::multiplies<int64_t>());
+          if (element_count <= 0) {
+            continue;
+          }
+          calibration_values.emplace_back(binding_index, std::vector<float>(static_cast<size_t>(element_count)));
+          CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(calibration_values.back().second.data(), buffers[binding_index],
+                                               element_count * sizeof(float), cudaMemcpyDeviceToHost, stream));
+        }
+        CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+        for (const auto& binding_values : calibration_values) {
+          float max_abs_value = 0.0f;
+          for (float value : binding_values.second) {
+            if (std::isfinite(value)) {
+              max_abs_value = std::max(max_abs_value, std::fabs(value));
+            }
+          }
+          float& range = (*trt_state->calibration_ranges)[trt_engine->getBindingName(binding_values.first)];
+          range = std::max(range, max_abs_value);
+        }
+      }
+
       // Cast INT64 input to INT32 because TensorRT doesn't fully support INT64
       for (size_t i = 0, end = output_binding_names.size(); i < end; ++i) {
         const std::string& output_name = output_binding_names[i];
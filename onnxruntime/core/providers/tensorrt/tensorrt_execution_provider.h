@@ -18,6 +18,8 @@ static const std::string kFP16Enable = "ORT_TENSORRT_FP16_ENABLE";
 static const std::string kINT8Enable = "ORT_TENSORRT_INT8_ENABLE";
 static const std::string kINT8CalibrationTableName = "ORT_TENSORRT_INT8_CALIBRATION_TABLE_NAME";
 static const std::string kINT8UseNativeTensorrtCalibrationTable = "ORT_TENSORRT_INT8_USE_NATIVE_CALIBRATION_TABLE";
+static const std::string kINT8CalibrationEnable = "ORT_TENSORRT_INT8_CALIBRATION_ENABLE";
+static const std::string kLayerPrecisions = "ORT_TENSORRT_LAYER_PRECISIONS";
 static const std::string kDLAEnable = "ORT_TENSORRT_DLA_ENABLE";
 static const std::string kDLACore = "ORT_TENSORRT_DLA_CORE";
 static const std::string kDumpSubgraphs = "ORT_TENSORRT_DUMP_SUBGRAPHS";
@@ -26,6 +28,11 @@ static const std::string kCachePath = "ORT_TENSORRT_CACHE_PATH";
 static const std::string kDecryptionEnable = "ORT_TENSORRT_ENGINE_DECRYPTION_ENABLE";
 static const std::string kDecryptionLibPath = "ORT_TENSORRT_ENGINE_DECRYPTION_LIB_PATH";
 static const std::string kForceSequentialEngineBuild= "ORT_TENSORRT_FORCE_SEQUENTIAL_ENGINE_BUILD";
+static const std::string kTimingCacheEnable = "ORT_TENSORRT_TIMING_CACHE_ENABLE";
+static const std::string kEngineBuildAsync = "ORT_TENSORRT_ENGINE_BUILD_ASYNC";
+static const std::string kProfileMinShapes = "ORT_TENSORRT_PROFILE_MIN_SHAPES";
+static const std::string kProfileMaxShapes = "ORT_TENSORRT_PROFILE_MAX_SHAPES";
+static const std::string kProfileOptShapes = "ORT_TENSORRT_PROFILE_OPT_SHAPES";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
 }  // namespace tensorrt_env_vars
@@ -77,6 +84,18 @@ template <typename T>
 using unique_pointer = std::unique_ptr<T, TensorrtInferDeleter>;
 };  // namespace tensorrt_ptr
 
+// Shapes of the dynamic inputs declared up front with trt_profile_min_shapes/max_shapes/opt_shapes.
+// The engines of subgraphs whose dynamic inputs are all declared are built with this profile before the first run.
+struct TensorrtProfileShapes {
+  std::unordered_map<std::string, std::vector<int64_t>> min_shapes;
+  std::unordered_map<std::string, std::vector<int64_t>> max_shapes;
+  std::unordered_map<std::string, std::vector<int64_t>> opt_shapes;
+
+  bool Contains(const std::string& input_name) const {
+    return min_shapes.count(input_name) != 0 && max_shapes.count(input_name) != 0 && opt_shapes.count(input_name) != 0;
+  }
+};
+
 // Information to construct kernel function state.
 struct TensorrtFuncState {
   AllocateFunc test_allocate_func = nullptr;
@@ -107,6 +126,10 @@ struct TensorrtFuncState {
   bool engine_decryption_enable;
   int (*engine_decryption)(const char*, char*, size_t*);
   int (*engine_encryption)(const char*, char*, size_t);
+  std::string timing_cache_path;
+  const std::unordered_map<std::string, nvinfer1::DataType>* layer_precisions = nullptr;
+  // Activation ranges collected in calibration mode, nullptr otherwise
+  std::unordered_map<std::string, float>* calibration_ranges = nullptr;
 };
 
 // Logical device representation.
@@ -153,12 +176,19 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool dla_enable_ = false;
   int dla_core_ = 0;
   bool force_sequential_engine_build_ = false;
+  bool timing_cache_enable_ = false;
+  bool engine_build_async_ = false;
   std::string int8_calibration_cache_name_;
   bool int8_calibration_cache_available_ = false;
   bool int8_use_native_tensorrt_calibration_table_ = false;
+  bool int8_calibration_enable_ = false;
   bool dump_subgraphs_ = false;
   bool engine_cache_enable_ = false;
   std::string cache_path_, engine_decryption_lib_path_;
+  std::string timing_cache_path_;
+  TensorrtProfileShapes profile_shapes_;
+  std::string layer_precisions_option_;
+  std::unordered_map<std::string, nvinfer1::DataType> layer_precisions_;
   tensorrt_ptr::unique_pointer<nvinfer1::IRuntime> runtime_ = nullptr;
   OrtMutex tensorrt_mu_;
   int device_id_;
@@ -177,6 +207,14 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, size_t>>> output_info_;
   std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<size_t, std::pair<int64_t, int64_t>>>> input_shape_ranges_;
 
+  // Maximum absolute values of the float tensors of the subgraphs seen in calibration mode, written to the INT8
+  // calibration table when the provider is destroyed. Guarded by tensorrt_mu_.
+  std::unordered_map<std::string, float> calibration_ranges_;
+
+  // Engine cache names of the fused nodes, derived from the content of their subgraph when engines are built
+  // asynchronously so that they can be found again by later sessions.
+  mutable std::unordered_map<std::string, std::string> engine_cache_names_;
+
   /**Get IndexedSubGraph based on node list of the subgraph*/
   std::unique_ptr<IndexedSubGraph> GetSubGraph(SubGraph_t graph_nodes_index,
                                                const GraphViewer& graph) const;
@@ -193,6 +231,16 @@ class TensorrtExecutionProvider : public IExecutionProvider {
 
   void RemoveTensorRTGraphCycles(SubGraphCollection_t& supported_nodes_vector, const GraphViewer& graph) const;
 
+  /** Get the suffix added to the engine cache names for the precision and DLA settings */
+  std::string GetPrecisionSuffix() const;
+
+  /**
+  Queue the build of the engine of a subgraph on the background engine builder. Returns false if the engine can't be
+  built ahead of the first run, i.e. if it has dynamic shape inputs without a declared profile or a previous
+  background build failed, in which case the subgraph is compiled as usual.
+  */
+  bool ScheduleEngineBuild(IndexedSubGraph& sub_graph, const GraphViewer& graph, const std::string& cache_name) const;
+
   /** 
   Get a unique_lock object to control the concurrency behavior. 
   Every api call not in the thread-safe operations(https://docs.nvidia.com/deeplearning/tensorrt/developer-guide/index.html#threading)
@@ -27,6 +27,13 @@ constexpr const char* kCachePath = "trt_engine_cache_path";
 constexpr const char* kDecryptionEnable = "trt_engine_decryption_enable";
 constexpr const char* kDecryptionLibPath = "trt_engine_decryption_lib_path";
 constexpr const char* kForceSequentialEngineBuild = "trt_force_sequential_engine_build";
+constexpr const char* kTimingCacheEnable = "trt_timing_cache_enable";
+constexpr const char* kEngineBuildAsync = "trt_engine_build_async";
+constexpr const char* kProfileMinShapes = "trt_profile_min_shapes";
+constexpr const char* kProfileMaxShapes = "trt_profile_max_shapes";
+constexpr const char* kProfileOptShapes = "trt_profile_opt_shapes";
+constexpr const char* kInt8CalibrationEnable = "trt_int8_calibration_enable";
+constexpr const char* kLayerPrecisions = "trt_layer_precisions";
 // add new provider option name here. 
 }  // namespace provider_option_names
 }  // namespace tensorrt 
@@ -64,6 +71,13 @@ TensorrtExecutionProviderInfo TensorrtExecutionProviderInfo::FromProviderOptions
           .AddAssignmentToReference(tensorrt::provider_option_names::kDecryptionEnable, info.engine_decryption_enable)
           .AddAssignmentToReference(tensorrt::provider_option_names::kDecryptionLibPath, info.engine_decryption_lib_path) 
           .AddAssignmentToReference(tensorrt::provider_option_names::kForceSequentialEngineBuild, info.force_sequential_engine_build)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kTimingCacheEnable, info.timing_cache_enable)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kEngineBuildAsync, info.engine_build_async)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfileMinShapes, info.profile_min_shapes)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfileMaxShapes, info.profile_max_shapes)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfileOptShapes, info.profile_opt_shapes)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kInt8CalibrationEnable, info.int8_calibration_enable)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kLayerPrecisions, info.layer_precisions)
           .Parse(options)); // add new provider option here.
 
   return info;
@@ -88,17 +102,28 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const TensorrtE
       {tensorrt::provider_option_names::kDecryptionEnable, MakeStringWithClassicLocale(info.engine_decryption_enable)},
       {tensorrt::provider_option_names::kDecryptionLibPath, MakeStringWithClassicLocale(info.engine_decryption_lib_path)},
       {tensorrt::provider_option_names::kForceSequentialEngineBuild, MakeStringWithClassicLocale(info.force_sequential_engine_build)},
+      {tensorrt::provider_option_names::kTimingCacheEnable, MakeStringWithClassicLocale(info.timing_cache_enable)},
+      {tensorrt::provider_option_names::kEngineBuildAsync, MakeStringWithClassicLocale(info.engine_build_async)},
+      {tensorrt::provider_option_names::kProfileMinShapes, MakeStringWithClassicLocale(info.profile_min_shapes)},
+      {tensorrt::provider_option_names::kProfileMaxShapes, MakeStringWithClassicLocale(info.profile_max_shapes)},
+      {tensorrt::provider_option_names::kProfileOptShapes, MakeStringWithClassicLocale(info.profile_opt_shapes)},
+      {tensorrt::provider_option_names::kInt8CalibrationEnable, MakeStringWithClassicLocale(info.int8_calibration_enable)},
+      {tensorrt::provider_option_names::kLayerPrecisions, MakeStringWithClassicLocale(info.layer_precisions)},
       // add new provider option here.
   };
   return options;
 }
 
-ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensorRTProviderOptions& info) {
+ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensorRTProviderOptionsV2& info) {
 
   auto empty_if_null = [](const char* s) { return s != nullptr ? std::string{s} : std::string{}; };
   const std::string kInt8CalibTable_ = empty_if_null(info.trt_int8_calibration_table_name);
   const std::string kCachePath_ = empty_if_null(info.trt_engine_cache_path);
   const std::string kDecryptionLibPath_ = empty_if_null(info.trt_engine_decryption_lib_path);
+  const std::string kProfileMinShapes_ = empty_if_null(info.trt_profile_min_shapes);
+  const std::string kProfileMaxShapes_ = empty_if_null(info.trt_profile_max_shapes);
+  const std::string kProfileOptShapes_ = empty_if_null(info.trt_profile_opt_shapes);
+  const std::string kLayerPrecisions_ = empty_if_null(info.trt_layer_precisions);
 
   const ProviderOptions options{
       {tensorrt::provider_option_names::kDeviceId, MakeStringWithClassicLocale(info.device_id)},
@@ -117,6 +142,13 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensor
       {tensorrt::provider_option_names::kDecryptionEnable, MakeStringWithClassicLocale(info.trt_engine_decryption_enable)},
       {tensorrt::provider_option_names::kDecryptionLibPath, kDecryptionLibPath_},
       {tensorrt::provider_option_names::kForceSequentialEngineBuild, MakeStringWithClassicLocale(info.trt_force_sequential_engine_build)},
+      {tensorrt::provider_option_names::kTimingCacheEnable, MakeStringWithClassicLocale(info.trt_timing_cache_enable)},
+      {tensorrt::provider_option_names::kEngineBuildAsync, MakeStringWithClassicLocale(info.trt_engine_build_async)},
+      {tensorrt::provider_option_names::kProfileMinShapes, kProfileMinShapes_},
+      {tensorrt::provider_option_names::kProfileMaxShapes, kProfileMaxShapes_},
+      {tensorrt::provider_option_names::kProfileOptShapes, kProfileOptShapes_},
+      {tensorrt::provider_option_names::kInt8CalibrationEnable, MakeStringWithClassicLocale(info.trt_int8_calibration_enable)},
+      {tensorrt::provider_option_names::kLayerPrecisions, kLayerPrecisions_},
   };
   return options;
 }
@@ -8,6 +8,7 @@
 #include "core/framework/ortdevice.h"
 #include "core/framework/provider_options.h"
 #include "core/session/onnxruntime_c_api.h"
+#include "core/providers/tensorrt/tensorrt_provider_options.h"
 
 namespace onnxruntime {
 // Information needed to construct trt execution providers.
@@ -31,9 +32,16 @@ struct TensorrtExecutionProviderInfo {
   bool engine_decryption_enable{false};
   std::string engine_decryption_lib_path{""};
   bool force_sequential_engine_build{false};
+  bool timing_cache_enable{false};
+  bool engine_build_async{false};
+  std::string profile_min_shapes{""};
+  std::string profile_max_shapes{""};
+  std::string profile_opt_shapes{""};
+  bool int8_calibration_enable{false};
+  std::string layer_precisions{""};
 
   static TensorrtExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const TensorrtExecutionProviderInfo& info);
-  static ProviderOptions ToProviderOptions(const OrtTensorRTProviderOptions& info);
+  static ProviderOptions ToProviderOptions(const OrtTensorRTProviderOptionsV2& info);
 };
 }  // namespace onnxruntime
@@ -1,12 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <sstream>
 #include <unordered_map>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <experimental/filesystem>
 #include "flatbuffers/idl.h"
+#include "NvInfer.h"
 #include "ort_trt_int8_cal_table.fbs.h"
 
 namespace fs = std::experimental::filesystem;
@@ -194,4 +199,131 @@ void RemoveCachesByType(const std::string& root, std::string file_extension) {
     fs::remove(entry);
   }
 }
+
+/*
+ * Parse the input shapes of an explicit optimization profile
+ * The shapes are a comma separated list of input name and dimensions separated by 'x', for example,
+ *   input_ids:1x128,attention_mask:1x128
+ *
+ * \param profile_shapes shapes string given by trt_profile_min_shapes, trt_profile_max_shapes or trt_profile_opt_shapes
+ * \param shape_map input name to dimensions
+ * \return false if the string is malformed
+ */
+bool ParseProfileShapes(const std::string& profile_shapes, std::unordered_map<std::string, std::vector<int64_t>>& shape_map) {
+  shape_map.clear();
+  size_t begin = 0;
+  while (begin < profile_shapes.size()) {
+    size_t end = profile_shapes.find(',', begin);
+    if (end == std::string::npos) {
+      end = profile_shapes.size();
+    }
+    const std::string input_shape = profile_shapes.substr(begin, end - begin);
+    begin = end + 1;
+
+    // input names may contain ':', dimensions can't
+    const size_t separator = input_shape.rfind(':');
+    if (separator == std::string::npos || separator == 0 || separator + 1 == input_shape.size()) {
+      return false;
+    }
+    std::vector<int64_t> dims;
+    size_t dim_begin = separator + 1;
+    while (dim_begin <= input_shape.size()) {
+      size_t dim_end = input_shape.find('x', dim_begin);
+      if (dim_end == std::string::npos) {
+        dim_end = input_shape.size();
+      }
+      const std::string dim = input_shape.substr(dim_begin, dim_end - dim_begin);
+      if (dim.empty() || dim.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+      }
+      dims.push_back(std::stoll(dim));
+      dim_begin = dim_end + 1;
+    }
+    shape_map[input_shape.substr(0, separator)] = dims;
+  }
+  return true;
+}
+
+/*
+ * Parse the per-layer precision constraints
+ * The constraints are a comma separated list of layer name and precision separated by ':', for example,
+ *   Conv_12:fp32,MatMul_40:fp16,Conv_7:int8
+ * TensorRT layers are named after the ONNX nodes they are parsed from.
+ *
+ * \param layer_precisions constraints string given by trt_layer_precisions
+ * \param precision_map layer name to precision
+ * \return false if the string is malformed or a precision isn't one of fp32, fp16 and int8
+ */
+bool ParseLayerPrecisions(const std::string& layer_precisions, std::unordered_map<std::string, nvinfer1::DataType>& precision_map) {
+  precision_map.clear();
+  size_t begin = 0;
+  while (begin < layer_precisions.size()) {
+    size_t end = layer_precisions.find(',', begin);
+    if (end == std::string::npos) {
+      end = layer_precisions.size();
+    }
+    const std::string layer_precision = layer_precisions.substr(begin, end - begin);
+    begin = end + 1;
+
+    // layer names may contain ':', precisions can't
+    const size_t separator = layer_precision.rfind(':');
+    if (separator == std::string::npos || separator == 0) {
+      return false;
+    }
+    const std::string precision = layer_precision.substr(separator + 1);
+    nvinfer1::DataType data_type;
+    if (precision == "fp32") {
+      data_type = nvinfer1::DataType::kFLOAT;
+    } else if (precision == "fp16") {
+      data_type = nvinfer1::DataType::kHALF;
+    } else if (precision == "int8") {
+      data_type = nvinfer1::DataType::kINT8;
+    } else {
+      return false;
+    }
+    precision_map[layer_precision.substr(0, separator)] = data_type;
+  }
+  return true;
+}
+
+/*
+ * Write an ORT calibration table, the format read by ReadDynamicRange with is_trt_calibration_table false.
+ * The ranges of an existing table are merged in, so that calibration sessions over different data accumulate.
+ */
+bool WriteDynamicRange(const std::string& file_name, std::unordered_map<std::string, float> dynamic_range_map) {
+  std::unordered_map<std::string, float> existing_dynamic_range_map;
+  if (ReadDynamicRange(file_name, false, existing_dynamic_range_map)) {
+    for (const auto& entry : existing_dynamic_range_map) {
+      auto& dynamic_range = dynamic_range_map[entry.first];
+      dynamic_range = std::max(dynamic_range, entry.second);
+    }
+  }
+
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<flatbuffers::Offset<CalTableFlatBuffers::KeyValue>> dict;
+  for (const auto& entry : dynamic_range_map) {
+    std::ostringstream value;
+    value.precision(std::numeric_limits<float>::max_digits10);
+    value << entry.second;
+    dict.push_back(CalTableFlatBuffers::CreateKeyValueDirect(builder, entry.first.c_str(), value.str().c_str()));
+  }
+  builder.Finish(CalTableFlatBuffers::CreateTrtTableDirect(builder, &dict));
+
+  std::ofstream file(file_name, std::ios::binary | std::ios::out);
+  file.write(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+  return static_cast<bool>(file);
+}
+
+// Read a whole binary file, e.g. a timing cache. The buffer is empty if the file doesn't exist
+std::vector<char> ReadBinaryFile(const std::string& file_name) {
+  std::vector<char> buffer;
+  std::ifstream file(file_name, std::ios::binary | std::ios::in);
+  if (file) {
+    file.seekg(0, std::ios::end);
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(buffer.data(), buffer.size());
+  }
+  return buffer;
+}
 }
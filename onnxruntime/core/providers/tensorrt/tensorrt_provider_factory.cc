@@ -70,6 +70,13 @@ struct Tensorrt_Provider : Provider {
     info.engine_decryption_enable = options.trt_engine_decryption_enable != 0;
     info.engine_decryption_lib_path = options.trt_engine_decryption_lib_path == nullptr ? "" : options.trt_engine_decryption_lib_path;
     info.force_sequential_engine_build = options.trt_force_sequential_engine_build != 0;
+    info.timing_cache_enable = options.trt_timing_cache_enable != 0;
+    info.engine_build_async = options.trt_engine_build_async != 0;
+    info.profile_min_shapes = options.trt_profile_min_shapes == nullptr ? "" : options.trt_profile_min_shapes;
+    info.profile_max_shapes = options.trt_profile_max_shapes == nullptr ? "" : options.trt_profile_max_shapes;
+    info.profile_opt_shapes = options.trt_profile_opt_shapes == nullptr ? "" : options.trt_profile_opt_shapes;
+    info.int8_calibration_enable = options.trt_int8_calibration_enable != 0;
+    info.layer_precisions = options.trt_layer_precisions == nullptr ? "" : options.trt_layer_precisions;
     return std::make_shared<TensorrtProviderFactory>(info);
   }
 
@@ -135,10 +142,31 @@ struct Tensorrt_Provider : Provider {
     }
 
     trt_options.trt_force_sequential_engine_build = internal_options.force_sequential_engine_build;
+    trt_options.trt_timing_cache_enable = internal_options.timing_cache_enable;
+    trt_options.trt_engine_build_async = internal_options.engine_build_async;
+
+    auto copy_string = [](const std::string& str) -> const char* {
+      if (str.empty()) {
+        return nullptr;
+      }
+      char* dest = new char[str.size() + 1];
+#ifdef _MSC_VER
+      strncpy_s(dest, str.size() + 1, str.c_str(), str.size());
+#else
+      strncpy(dest, str.c_str(), str.size());
+#endif
+      dest[str.size()] = '\0';
+      return dest;
+    };
+    trt_options.trt_profile_min_shapes = copy_string(internal_options.profile_min_shapes);
+    trt_options.trt_profile_max_shapes = copy_string(internal_options.profile_max_shapes);
+    trt_options.trt_profile_opt_shapes = copy_string(internal_options.profile_opt_shapes);
+    trt_options.trt_int8_calibration_enable = internal_options.int8_calibration_enable;
+    trt_options.trt_layer_precisions = copy_string(internal_options.layer_precisions);
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
-    auto& options = *reinterpret_cast<const OrtTensorRTProviderOptions*>(provider_options);
+    auto& options = *reinterpret_cast<const OrtTensorRTProviderOptionsV2*>(provider_options);
     return onnxruntime::TensorrtExecutionProviderInfo::ToProviderOptions(options);
   }
 
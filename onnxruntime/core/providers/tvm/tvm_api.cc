@@ -45,7 +45,8 @@ TvmModule TVMCompile(const std::string& onnx_txt,
                              shapes,
                              options.to_nhwc,
                              options.tuning_file_path,
-                             options.tuning_type);
+                             options.tuning_type,
+                             options.module_cache_dir);
   ORT_ENFORCE(mod.get() != nullptr, "Compiled TVM Module is nullptr!");
   return mod;
 }
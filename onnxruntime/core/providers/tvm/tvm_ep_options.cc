@@ -23,6 +23,7 @@ constexpr const char* kFreezeWeights = "freeze_weights";
 constexpr const char* kToNHWC = "to_nhwc";
 constexpr const char* kTuningFilePath = "tuning_file_path";
 constexpr const char* kTuningType = "tuning_type";
+constexpr const char* kModuleCacheDir = "module_cache_dir";
 constexpr const char* kInputNames = "input_names";
 constexpr const char* kInputShapes = "input_shapes";
 
@@ -35,6 +36,7 @@ static const std::unordered_set<std::string> valid_keys {
   std::string{kToNHWC},
   std::string{kTuningFilePath},
   std::string{kTuningType},
+  std::string{kModuleCacheDir},
   std::string{kInputNames},
   std::string{kInputShapes}
 };
@@ -118,6 +120,7 @@ TvmEPOptions TvmEPOptionsHelper::FromProviderOptions(const ProviderOptions& pr_o
       .AddAssignmentToReference(tvm::provider_option_names::kToNHWC, options.to_nhwc)
       .AddAssignmentToReference(tvm::provider_option_names::kTuningFilePath, options.tuning_file_path)
       .AddAssignmentToReference(tvm::provider_option_names::kTuningType, options.tuning_type)
+      .AddAssignmentToReference(tvm::provider_option_names::kModuleCacheDir, options.module_cache_dir)
       .AddAssignmentToReference(tvm::provider_option_names::kInputNames, options.input_names_str)
       .AddAssignmentToReference(tvm::provider_option_names::kInputShapes, options.input_shapes_str)
       .Parse(pr_options));
@@ -251,6 +254,7 @@ std::ostream& operator<<(std::ostream& out, const TvmEPOptions& options) {
   "freeze weights: " << options.freeze_weights << "\n" <<
   "tuning file path: " << options.tuning_file_path << "\n" <<
   "tuning type: " << options.tuning_type << "\n" <<
+  "module cache dir: " << options.module_cache_dir << "\n" <<
   "convert layout to NHWC: " << options.to_nhwc << "\n" <<
   "input tensor names: " << options.input_names_str << "\n" <<
   "input tensor shapes: " << options.input_shapes_str;
@@ -1,8 +1,11 @@
 // Copyright(C) Xilinx Inc.
 // Licensed under the MIT License
 
+#include <cstdio>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 #if defined(_MSC_VER)
@@ -24,6 +27,7 @@
 #include <pyxir/runtime/run_options.hpp>
 
 #include "vitisai_custom_op.h"
+#include "core/framework/murmurhash3.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/common/logging/logging.h"
@@ -57,6 +61,7 @@ VitisAICustomOp::VitisAICustomOp(const ComputeContext* context,
                                  const std::string& backend_type,
                                  const std::string& export_runtime_module,
                                  const std::string& load_runtime_module,
+                                 const std::string& compiled_model_cache_dir,
                                  const logging::Logger* logger)
   : backend_type_(backend_type), export_runtime_module_(export_runtime_module),
     load_runtime_module_(load_runtime_module)
@@ -69,9 +74,40 @@ VitisAICustomOp::VitisAICustomOp(const ComputeContext* context,
   name_ = context->node_name;
 
   model_proto_ = GetModelProtoFromFusedNode(fused_node, *GetLogger());
-  std::istringstream model_stream{model_proto_.SerializeAsString()};
+  const std::string serialized_model = model_proto_.SerializeAsString();
+  std::istringstream model_stream{serialized_model};
   xg_ = pyxir::onnx::import_onnx_model(model_stream);
-  
+
+  // The runtime module of a partition is cached under the hash of the
+  // partition and the DPU target, so a change to the partition, its weights
+  // or the target results in a new entry
+  std::string cached_runtime_module;
+  if (load_runtime_module_.empty() && !compiled_model_cache_dir.empty()) {
+    uint32_t hash[4];
+    MurmurHash3::x86_128(serialized_model.data(), static_cast<int>(serialized_model.size()), 0, hash);
+    std::ostringstream file_name;
+    file_name << std::hex << std::setfill('0');
+    for (const auto h : hash) {
+      file_name << std::setw(8) << h;
+    }
+
+    file_name << "_" << backend_type_ << ".rtmod";
+    cached_runtime_module = compiled_model_cache_dir + "/" + file_name.str();
+  }
+
+  if (!cached_runtime_module.empty() && std::ifstream(cached_runtime_module).good()) {
+    try {
+      LoadRuntimeModule(cached_runtime_module);
+      LOGS(*GetLogger(), VERBOSE) << "Loaded the runtime module from the cache: " << cached_runtime_module;
+      return;
+    } catch (const std::exception& exp) {
+      LOGS(*GetLogger(), WARNING) << "Failed loading the cached runtime module: " << cached_runtime_module
+                                  << ", error: " << exp.what() << ". The partition will be compiled again.";
+      std::remove(cached_runtime_module.c_str());
+      rt_mod_ = nullptr;
+    }
+  }
+
   // If the `load_runtime_module` provider option is empty we  build a PyXIR
   // runtime module from scratch. Otherwise, we load the runtime module from
   // the provided file.   
@@ -90,26 +126,33 @@ VitisAICustomOp::VitisAICustomOp(const ComputeContext* context,
     
     pyxir::RunOptionsHolder run_options(new pyxir::runtime::RunOptions());
     run_options->on_the_fly_quantization = true;
-    run_options->export_runtime_module_path = export_runtime_module_;
+    // PyXIR exports the runtime module once the on-the-fly quantization has
+    // compiled it, which fills the cache unless an explicit export path is given
+    run_options->export_runtime_module_path =
+        export_runtime_module_.empty() ? cached_runtime_module : export_runtime_module_;
     rt_mod_ = pyxir::build_rt(xg_, backend_type_, in_tensor_names_,
                               out_tensor_names_, "vai", run_options);
   } else {
-    std::ifstream in_file(load_runtime_module_);
-    std::stringstream buffer;
-    buffer << in_file.rdbuf();
-    std::string serialized_rt_mod = buffer.str();
-    in_file.close();
-
-    std::istringstream sstream(serialized_rt_mod);
-    rt_mod_.reset(new pyxir::runtime::RuntimeModule());
-    rt_mod_->deserialize(sstream);
-    in_tensor_names_ = rt_mod_->get_in_tensor_names();
-    out_tensor_names_ = rt_mod_->get_out_tensor_names();
+    LoadRuntimeModule(load_runtime_module_);
   }
 }
 
 VitisAICustomOp::~VitisAICustomOp() {}
 
+void VitisAICustomOp::LoadRuntimeModule(const std::string& path) {
+  std::ifstream in_file(path);
+  std::stringstream buffer;
+  buffer << in_file.rdbuf();
+  std::string serialized_rt_mod = buffer.str();
+  in_file.close();
+
+  std::istringstream sstream(serialized_rt_mod);
+  rt_mod_.reset(new pyxir::runtime::RuntimeModule());
+  rt_mod_->deserialize(sstream);
+  in_tensor_names_ = rt_mod_->get_in_tensor_names();
+  out_tensor_names_ = rt_mod_->get_out_tensor_names();
+}
+
 
 Status VitisAICustomOp::Compute(const OrtApi* api, OrtKernelContext* context) const { 
   Ort::CustomOpApi ort{*api};
@@ -33,6 +33,7 @@ class VitisAICustomOp {
                   const std::string& backend_type,
                   const std::string& export_runtime_module,
                   const std::string& load_runtime_module,
+                  const std::string& compiled_model_cache_dir,
                   const logging::Logger* logger);
 
   Status Compute(const OrtApi* api, OrtKernelContext* context) const;
@@ -48,6 +49,9 @@ class VitisAICustomOp {
   }
 
  private:
+  // Deserializes the PyXIR runtime module in the given file
+  void LoadRuntimeModule(const std::string& path);
+
   // The partition input tensor names
   std::vector<std::string> in_tensor_names_;
   // The partition output tensor names
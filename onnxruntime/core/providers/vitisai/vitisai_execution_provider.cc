@@ -32,7 +32,8 @@ typedef std::shared_ptr<pyxir::graph::XLayer> XLayerHolder;
 VitisAIExecutionProvider::VitisAIExecutionProvider(const VitisAIExecutionProviderInfo& info)
     : IExecutionProvider{onnxruntime::kVitisAIExecutionProvider}, backend_type_(info.backend_type),
       device_id_(info.device_id), export_runtime_module_(info.export_runtime_module),
-      load_runtime_module_(info.load_runtime_module) {
+      load_runtime_module_(info.load_runtime_module),
+      compiled_model_cache_dir_(info.compiled_model_cache_dir) {
   AllocatorCreationInfo default_memory_info{
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(VITISAI, OrtAllocatorType::OrtDeviceAllocator));
@@ -279,7 +280,7 @@ common::Status VitisAIExecutionProvider::Compile(const std::vector<onnxruntime::
     NodeComputeInfo compute_info;
     compute_info.create_state_func = [this, fused_node, logger = GetLogger()](ComputeContext* context, FunctionState* state) {
       auto* p = new vitisai_ep::VitisAICustomOp(context, fused_node, backend_type_, export_runtime_module_,
-                                                load_runtime_module_, logger);
+                                                load_runtime_module_, compiled_model_cache_dir_, logger);
       *state = p;
       return 0;
     };
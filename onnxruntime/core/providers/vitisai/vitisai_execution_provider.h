@@ -15,6 +15,7 @@ struct VitisAIExecutionProviderInfo {
   std::string backend_type;
   std::string export_runtime_module;
   std::string load_runtime_module;
+  std::string compiled_model_cache_dir;
 };
 
 // Logical device representation.
@@ -43,6 +44,9 @@ class VitisAIExecutionProvider : public IExecutionProvider {
   // If not empty, the path to the file where the PyXIR runtime module
   //	should be loaded from
   std::string load_runtime_module_;
+  // If not empty, the directory where the PyXIR runtime modules of the
+  //	partitions are cached, keyed by the hash of the partition
+  std::string compiled_model_cache_dir_;
 };
 
 }  // namespace onnxruntime
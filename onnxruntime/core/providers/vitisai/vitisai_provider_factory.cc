@@ -12,10 +12,11 @@ namespace onnxruntime {
 
 struct VitisAIProviderFactory : IExecutionProviderFactory {
   VitisAIProviderFactory(std::string&& backend_type, int device_id, std::string&& export_runtime_module,
-                         std::string&& load_runtime_module)
+                         std::string&& load_runtime_module, std::string&& compiled_model_cache_dir)
     : backend_type_(std::move(backend_type)), device_id_(device_id),
       export_runtime_module_(std::move(export_runtime_module)),
-      load_runtime_module_(std::move(load_runtime_module)) {}
+      load_runtime_module_(std::move(load_runtime_module)),
+      compiled_model_cache_dir_(std::move(compiled_model_cache_dir)) {}
   ~VitisAIProviderFactory() = default;
 
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
@@ -31,6 +32,9 @@ struct VitisAIProviderFactory : IExecutionProviderFactory {
   // If not empty, the path to the file where the PyXIR runtime module
   //	should be loaded from
   const std::string load_runtime_module_;
+  // If not empty, the directory where the PyXIR runtime modules of the
+  //	partitions are cached
+  const std::string compiled_model_cache_dir_;
 };
 
 std::unique_ptr<IExecutionProvider> VitisAIProviderFactory::CreateProvider() {
@@ -39,14 +43,15 @@ std::unique_ptr<IExecutionProvider> VitisAIProviderFactory::CreateProvider() {
   info.device_id = device_id_;
   info.export_runtime_module = export_runtime_module_;
   info.load_runtime_module = load_runtime_module_;
+  info.compiled_model_cache_dir = compiled_model_cache_dir_;
   return std::make_unique<VitisAIExecutionProvider>(info);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_VITISAI(
     const char* backend_type, int device_id, const char* export_runtime_module,
-    const char* load_runtime_module) {
+    const char* load_runtime_module, const char* compiled_model_cache_dir) {
   return std::make_shared<onnxruntime::VitisAIProviderFactory>(
-    backend_type, device_id, export_runtime_module, load_runtime_module);
+    backend_type, device_id, export_runtime_module, load_runtime_module, compiled_model_cache_dir);
 }
 }  // namespace onnxruntime
 
@@ -54,7 +59,7 @@ ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_VITISAI,
                     _In_ OrtSessionOptions* options, _In_ const char* backend_type, int device_id,
                     const char* export_runtime_module, const char* load_runtime_module) {
   options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_VITISAI(
-    backend_type, device_id, export_runtime_module, load_runtime_module));
+    backend_type, device_id, export_runtime_module, load_runtime_module, ""));
   return nullptr;
 }
 
@@ -14,6 +14,11 @@ IOBinding::IOBinding(const SessionState& session_state) : session_state_(session
 common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_value) {
   auto it = mapped_feed_names_.emplace(name, feed_names_.size());
 
+  feeds_validated_ = false;
+  if (it.second) {
+    feeds_fetches_manager_.reset();
+  }
+
   auto add_or_replace = [&](const OrtValue& value) {
     if (it.second) {
       feed_names_.push_back(name);
@@ -45,6 +50,8 @@ void IOBinding::ClearInputs() {
   mapped_feed_names_.clear();
   feed_names_.clear();
   feeds_.clear();
+  feeds_fetches_manager_.reset();
+  feeds_validated_ = false;
 }
 
 static common::Status SyncProviders(const SessionState::NameNodeInfoMapType& node_info_map,
@@ -94,12 +101,17 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
     output_names_.push_back(name);
     outputs_.push_back(ml_value);
     outputs_device_info_.push_back(device);
+    outputs_preallocated_.push_back(ml_value.IsAllocated());
   } else {
     outputs_[index] = ml_value;
     outputs_device_info_[index] = device;
+    outputs_preallocated_[index] = ml_value.IsAllocated();
   }
   ORT_ENFORCE(mapped_output_names_.size() == output_names_.size(), "Size mismatch", mapped_output_names_.size(), "!=", output_names_.size());
 
+  // the device of the output is part of the copy info of the feeds and fetches manager
+  feeds_fetches_manager_.reset();
+
   return Status::OK();
 }
 
@@ -108,6 +120,28 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  outputs_preallocated_.clear();
+  feeds_fetches_manager_.reset();
+}
+
+void IOBinding::ReleaseOutputsIfShapesChanged() {
+  bool shapes_changed = feed_shapes_.size() != feeds_.size();
+  feed_shapes_.resize(feeds_.size());
+  for (size_t i = 0, end = feeds_.size(); i < end; ++i) {
+    const auto& feed = feeds_[i];
+    if (feed.IsTensor() && feed_shapes_[i] != feed.Get<Tensor>().Shape()) {
+      feed_shapes_[i] = feed.Get<Tensor>().Shape();
+      shapes_changed = true;
+    }
+  }
+
+  if (shapes_changed) {
+    for (size_t i = 0, end = outputs_.size(); i < end; ++i) {
+      if (!outputs_preallocated_[i]) {
+        outputs_[i] = OrtValue();
+      }
+    }
+  }
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
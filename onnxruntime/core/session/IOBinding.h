@@ -7,6 +7,8 @@
 #include <unordered_map>
 
 #include "core/framework/execution_provider.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/tensor_shape.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
 #include "core/framework/ort_value.h"
@@ -35,6 +37,11 @@ class SessionState;
  * session.Run(io_binding);
  *
  * vector<OrtValue>& outputs = io_binding->GetOutputs();
+ *
+ * The first run validates the bindings and maps their names to the values of the session. The following runs reuse
+ * that until the bound names change or an output is bound again, so an IOBinding should be kept for repeated runs
+ * rather than recreated. The values allocated for the outputs bound to a device are reused by the next run too,
+ * unless an input is bound to a tensor of another shape.
  */
 class IOBinding {
  public:
@@ -106,6 +113,16 @@ class IOBinding {
   std::unordered_map<std::string, size_t> mapped_output_names_;
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
+  // whether each output was bound to a pre-allocated value rather than a device
+  std::vector<bool> outputs_preallocated_;
+
+  // the feeds and fetches manager of the bound names, created by the first run and reused by the following ones.
+  // reset when an input or output name is added or removed, or when an output is bound again.
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+  // whether the bound inputs were validated by a run since they were last bound
+  bool feeds_validated_ = false;
+  // the shapes of the tensor inputs when they were last validated
+  std::vector<TensorShape> feed_shapes_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
@@ -114,5 +131,9 @@ class IOBinding {
 
   // The implementation for the BindOutput() overloads
   common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
+
+  // Called once the bound inputs are validated. Releases the values the previous runs allocated for the outputs bound
+  // to a device if the shapes of the inputs changed, as the outputs may not fit them anymore.
+  void ReleaseOutputsIfShapesChanged();
 };
 }  // namespace onnxruntime
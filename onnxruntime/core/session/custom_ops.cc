@@ -11,8 +11,10 @@
 #include "core/framework/error_code_helper.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/platform/threadpool.h"
 #include "core/session/inference_session.h"
 #include "core/session/ort_apis.h"
+#include <algorithm>
 #include <type_traits>
 
 ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_float, _In_ const OrtKernelInfo* info, _In_ const char* name, _Out_ float* out) {
@@ -50,6 +52,34 @@ ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetOutput, _Inout_ OrtKernelContext*
   return nullptr;
 };
 
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_ParallelFor, _In_ const OrtKernelContext* context, _In_ OrtParallelForFn fn,
+                    size_t total, size_t num_batches, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (fn == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "fn must not be nullptr");
+  }
+  if (total == 0) {
+    return nullptr;
+  }
+
+  using onnxruntime::concurrency::ThreadPool;
+  ThreadPool* tp = reinterpret_cast<const onnxruntime::OpKernelContext*>(context)->GetOperatorThreadPool();
+  std::ptrdiff_t batches = num_batches == 0 ? ThreadPool::DegreeOfParallelism(tp)
+                                            : static_cast<std::ptrdiff_t>(num_batches);
+  batches = std::min<std::ptrdiff_t>(batches, static_cast<std::ptrdiff_t>(total));
+  if (tp == nullptr || batches <= 1) {
+    fn(user_data, 0, total);
+    return nullptr;
+  }
+
+  ThreadPool::TrySimpleParallelFor(tp, batches, [&](std::ptrdiff_t batch) {
+    auto work = ThreadPool::PartitionWork(batch, batches, static_cast<std::ptrdiff_t>(total));
+    fn(user_data, static_cast<size_t>(work.start), static_cast<size_t>(work.end));
+  });
+  return nullptr;
+  API_IMPL_END
+};
+
 ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_string, _In_ const OrtKernelInfo* info, _In_ const char* name, _Out_ char* out, _Inout_ size_t* size) {
   std::string value;
   auto status = reinterpret_cast<const onnxruntime::OpKernelInfo*>(info)->GetAttr<std::string>(name, &value);
@@ -115,6 +145,17 @@ ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttributeArray_int64, _In_ const OrtKe
 #include "core/framework/customregistry.h"
 namespace onnxruntime {
 
+// Converts and releases the status returned by a custom op callback
+static Status ToStatus(OrtStatus* ort_status) {
+  if (ort_status == nullptr) {
+    return Status::OK();
+  }
+  Status status(common::ONNXRUNTIME, static_cast<common::StatusCode>(OrtApis::GetErrorCode(ort_status)),
+                OrtApis::GetErrorMessage(ort_status));
+  OrtApis::ReleaseStatus(ort_status);
+  return status;
+}
+
 struct CustomOpKernel : OpKernel {
   CustomOpKernel(const OpKernelInfo& info, const OrtCustomOp& op) : OpKernel(info), op_(op) {
     if (op_.version > ORT_API_VERSION) {
@@ -132,6 +173,23 @@ struct CustomOpKernel : OpKernel {
     return Status::OK();
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr /*alloc*/,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    is_packed = false;
+    // the packed data is private to the custom kernel, so it can't be shared between sessions
+    if (op_.version < 12 || op_.KernelPrePack == nullptr || prepacked_weights != nullptr) {
+      return Status::OK();
+    }
+
+    OrtValue value;
+    Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), const_cast<void*>(tensor.DataRaw()), tensor.Location(),
+                         value);
+    int packed = 0;
+    ORT_RETURN_IF_ERROR(ToStatus(op_.KernelPrePack(op_kernel_, &value, input_idx, &packed)));
+    is_packed = packed != 0;
+    return Status::OK();
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CustomOpKernel);
 
@@ -139,6 +197,76 @@ struct CustomOpKernel : OpKernel {
   void* op_kernel_;
 };
 
+#if !defined(ORT_MINIMAL_BUILD)
+// Runs the shape inference callback of a custom op for each of its outputs
+static void InferCustomOpOutputShapes(const OrtCustomOp& op, ONNX_NAMESPACE::InferenceContext& ctx) {
+  const size_t input_count = ctx.getNumInputs();
+  std::vector<std::unique_ptr<OrtTensorTypeAndShapeInfo>> input_infos(input_count);
+  std::vector<const OrtTensorTypeAndShapeInfo*> input_shapes(input_count, nullptr);
+  // dynamic typed outputs have the element type of the dynamic typed input
+  int32_t dynamic_elem_type = ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED;
+  for (size_t i = 0; i < input_count; ++i) {
+    const auto* input_type = ctx.getInputType(i);
+    if (input_type == nullptr || !input_type->has_tensor_type()) {
+      continue;
+    }
+
+    const auto& tensor_type = input_type->tensor_type();
+    if (op.GetInputType(&op, i) == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED &&
+        dynamic_elem_type == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+      dynamic_elem_type = tensor_type.elem_type();
+    }
+    if (!tensor_type.has_shape()) {
+      continue;
+    }
+
+    auto info = std::make_unique<OrtTensorTypeAndShapeInfo>();
+    info->type = static_cast<ONNXTensorElementDataType>(tensor_type.elem_type());
+    TensorShapeVector dims;
+    for (const auto& dim : tensor_type.shape().dim()) {
+      dims.push_back(dim.has_dim_value() ? dim.dim_value() : -1);
+      info->dim_params.push_back(dim.has_dim_param() ? dim.dim_param() : "");
+    }
+    info->shape = TensorShape(dims);
+    input_shapes[i] = info.get();
+    input_infos[i] = std::move(info);
+  }
+
+  for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+    int32_t elem_type = op.GetOutputType(&op, i);
+    if (elem_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+      elem_type = dynamic_elem_type;
+    }
+    if (elem_type == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+      continue;
+    }
+
+    auto* output_type = ctx.getOutputType(i)->mutable_tensor_type();
+    output_type->set_elem_type(elem_type);
+
+    OrtTensorTypeAndShapeInfo output_shape;
+    output_shape.type = static_cast<ONNXTensorElementDataType>(elem_type);
+    int is_inferred = 0;
+    auto status = ToStatus(op.InferOutputShape(&op, i, input_shapes.data(), input_count, &output_shape, &is_inferred));
+    if (!status.IsOK()) {
+      fail_shape_inference("Custom op ", op.GetName(&op), " failed to infer the shape of output ", i, ": ",
+                           status.ErrorMessage());
+    }
+
+    if (is_inferred) {
+      auto* shape = output_type->mutable_shape();
+      shape->clear_dim();
+      for (size_t d = 0; d < output_shape.shape.NumDimensions(); ++d) {
+        auto* dim = shape->add_dim();
+        if (output_shape.shape[d] >= 0) {
+          dim->set_dim_value(output_shape.shape[d]);
+        }
+      }
+    }
+  }
+}
+#endif
+
 common::Status CreateCustomRegistry(const std::vector<OrtCustomOpDomain*>& op_domains,
                                     std::shared_ptr<CustomRegistry>& output) {
   output = std::make_shared<CustomRegistry>();
@@ -215,6 +343,13 @@ common::Status CreateCustomRegistry(const std::vector<OrtCustomOpDomain*>& op_do
         }
       }
 
+      // Only since the ORT API version 12 does the OrtCustomOp interface have the shape inference callback
+      if (op->version >= 12 && op->InferOutputShape != nullptr) {
+        schema.TypeAndShapeInferenceFunction([op](ONNX_NAMESPACE::InferenceContext& ctx) {
+          InferCustomOpOutputShapes(*op, ctx);
+        });
+      }
+
       schema.SetDomain(domain->domain_);
       schema.SinceVersion(1);
       schema.AllowUncheckedAttributes();
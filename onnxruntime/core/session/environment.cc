@@ -135,6 +135,12 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
     int initial_chunk_size_bytes = -1;
     int max_dead_bytes_per_chunk = -1;
     int initial_growth_chunk_size_bytes = -1;
+    int small_alloc_cache_strategy = -1;
+    int small_alloc_cache_bytes = -1;
+    int numa_node = -1;
+    int idle_shrink_ms = -1;
+    size_t shrink_high_water_bytes = 0;
+    int use_huge_pages = -1;
 
     // override with values from the user supplied arena_cfg object
     if (arena_cfg) {
@@ -151,10 +157,36 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
       initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
       max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
       initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
+
+      small_alloc_cache_strategy = arena_cfg->small_alloc_cache_strategy;
+      if (!(small_alloc_cache_strategy == -1 || small_alloc_cache_strategy == 0 || small_alloc_cache_strategy == 1)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Received invalid value for small alloc cache strategy."
+                               " Valid values can be either 0, 1 or -1.");
+      }
+
+      small_alloc_cache_bytes = arena_cfg->small_alloc_cache_bytes;
+
+      numa_node = arena_cfg->numa_node;
+      if (numa_node < -1) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Received invalid value for NUMA node. Valid values are -1 or a node index.");
+      }
+
+      idle_shrink_ms = arena_cfg->idle_shrink_ms;
+      shrink_high_water_bytes = arena_cfg->shrink_high_water_bytes;
+
+      use_huge_pages = arena_cfg->use_huge_pages;
+      if (!(use_huge_pages == -1 || use_huge_pages == 0 || use_huge_pages == 1)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Received invalid value for use_huge_pages."
+                               " Valid values can be either 0, 1 or -1.");
+      }
     }
 
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
-                            initial_growth_chunk_size_bytes};
+                            initial_growth_chunk_size_bytes, small_alloc_cache_strategy, small_alloc_cache_bytes,
+                            numa_node, idle_shrink_ms, shrink_high_water_bytes, use_huge_pages};
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
         0,
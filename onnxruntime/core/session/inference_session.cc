@@ -4,10 +4,14 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <unordered_set>
 #include <list>
+#include <map>
 #include <string>
 #include <thread>
 
@@ -24,6 +28,7 @@
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/kernel_tuning.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/session_state_flatbuffers_utils.h"
 #include "core/framework/TensorSeq.h"
@@ -44,6 +49,8 @@
 #include "core/optimizer/transpose_optimizer/optimizer_utils.h"
 #include "core/platform/Barrier.h"
 #include "core/platform/ort_mutex.h"
+#include "core/platform/path_lib.h"
+#include "core/platform/probes.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
@@ -55,6 +62,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/session_cache.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/util/thread_utils.h"
 
@@ -287,6 +295,12 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       to.allow_spinning = allow_intra_op_spinning;
       to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
       LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
+      to.use_lock_free_queues =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseLockFreeQueues, "0") == "1";
+      to.numa_aware =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1";
+      to.performance_cores_only = session_options_.config_options.GetConfigOrDefault(
+                                      kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly, "0") == "1";
 
       // Set custom threading functions
       to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -317,6 +331,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       to.set_denormal_as_zero = set_denormal_as_zero;
       to.allow_spinning = allow_inter_op_spinning;
       to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
+      to.use_lock_free_queues =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseLockFreeQueues, "0") == "1";
 
       // Set custom threading functions
       to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -340,9 +356,29 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
     ORT_ENFORCE(session_env.EnvCreatedWithGlobalThreadPools(),
                 "When the session is not configured to use per session"
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
+
+    concurrency::ThreadPoolQuota quota;
+    quota.max_threads = std::stoi(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGlobalIntraOpMaxThreads, "0"));
+    quota.weight = std::stoi(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGlobalIntraOpWeight, "0"));
+    if (intra_op_thread_pool_from_env_ != nullptr && (quota.max_threads > 0 || quota.weight > 0)) {
+      LOGS(*session_logger_, INFO) << "Using at most " << quota.max_threads << " threads with weight " << quota.weight
+                                   << " of the global intra-op thread pool";
+      intra_op_thread_pool_quota_ =
+          std::make_unique<concurrency::ThreadPool>(*intra_op_thread_pool_from_env_, quota);
+      intra_op_thread_pool_from_env_ = intra_op_thread_pool_quota_.get();
+    }
   }
 
   session_profiler_.Initialize(session_logger_);
+  const auto profiling_ring_buffer_events = std::stoull(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingRingBufferEvents, "0"));
+  if (profiling_ring_buffer_events > 0) {
+    session_profiler_.EnableRingBuffer(static_cast<size_t>(profiling_ring_buffer_events));
+  }
+  session_profiler_.EnableHardwareCounters(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingHardwareCounters, "0") == "1");
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -426,6 +462,11 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  {
+    std::unique_lock<OrtMutex> lock(async_runs_mutex_);
+    async_runs_cv_.wait(lock, [this] { return num_async_runs_ == 0; });
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -445,6 +486,13 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigKernelTuningFile, "").empty()) {
+    auto status = KernelTuningDatabase::Instance().Flush();
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, ERROR) << "Failed to save the kernel tuning database: " << status.ErrorMessage();
+    }
+  }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   if (session_activity_started_)
     TraceLoggingWriteStop(session_activity, "OrtInferenceSessionActivity");
@@ -565,7 +613,9 @@ common::Status InferenceSession::RegisterGraphTransformer(
                           "Graph transformers must be registered before the session is initialized.");
   }
 
-  return graph_transformation_mgr_.Register(std::move(p_graph_transformer), level);
+  ORT_RETURN_IF_ERROR(graph_transformation_mgr_.Register(std::move(p_graph_transformer), level));
+  has_custom_graph_transformers_ = true;
+  return Status::OK();
 }
 
 common::Status InferenceSession::SaveToOrtFormat(const std::basic_string<ORTCHAR_T>& filepath) const {
@@ -608,6 +658,186 @@ common::Status InferenceSession::SaveToOrtFormat(const std::basic_string<ORTCHAR
   return Status::OK();
 }
 
+bool InferenceSession::IsSessionCacheEnabled() const {
+  return !session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSessionCacheDir, "").empty();
+}
+
+// Collect the paths of the files holding external data for initializers in this graph and its subgraphs.
+static void GetExternalDataFiles(const Graph& graph, const PathString& model_dir, std::set<PathString>& files) {
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *entry.second;
+    if (!utils::HasExternalData(tensor_proto)) {
+      continue;
+    }
+
+    for (const auto& data_entry : tensor_proto.external_data()) {
+      if (data_entry.key() == "location") {
+        const PathString location = ToPathString(data_entry.value());
+        files.insert(model_dir.empty() ? location : ConcatPathComponent<PATH_CHAR_TYPE>(model_dir, location));
+      }
+    }
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    for (const auto& subgraph : node.GetSubgraphs()) {
+      GetExternalDataFiles(*subgraph, model_dir, files);
+    }
+  }
+}
+
+void InferenceSession::UpdateSessionCacheModelHash(const void* model_data, size_t model_data_len) {
+  session_cache::KeyBuilder builder;
+  PathString model_dir;
+
+  Status status = Status::OK();
+  if (model_data != nullptr) {
+    builder.AddBytes(model_data, model_data_len);
+  } else {
+    status = builder.AddFile(model_location_);
+    if (status.IsOK()) {
+      status = GetDirNameFromFilePath(model_location_, model_dir);
+    }
+  }
+
+  if (status.IsOK()) {
+    std::set<PathString> external_data_files;
+    GetExternalDataFiles(model_->MainGraph(), model_dir, external_data_files);
+    for (const auto& file : external_data_files) {
+      builder.AddString(ToUTF8String(file));
+      status = builder.AddFile(file);
+      if (!status.IsOK()) {
+        break;
+      }
+    }
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "The session cache will not be used as the model could not be hashed. "
+                                    << status.ErrorMessage();
+    return;
+  }
+
+  session_cache_model_hash_ = builder.ToString();
+}
+
+std::string InferenceSession::GetSessionCacheKey() const {
+  // custom ops, custom transformers and user provided initializers are outside of what the key can describe
+  if (session_cache_model_hash_.empty() || HasLocalSchema() || has_custom_graph_transformers_ ||
+      !session_options_.initializers_to_share_map.empty()) {
+    return {};
+  }
+
+  session_cache::KeyBuilder builder;
+  builder.AddString(ORT_VERSION);
+  builder.AddString(kOrtModelVersion);
+  builder.AddString(session_cache_model_hash_);
+
+  // the order of the execution providers matters for partitioning so it is kept
+  for (const auto& ep : execution_providers_) {
+    builder.AddString(ep->Type());
+    const auto provider_options = ep->GetProviderOptions();
+    const std::map<std::string, std::string> sorted_provider_options(provider_options.begin(),
+                                                                    provider_options.end());
+    builder.AddInt(static_cast<int64_t>(sorted_provider_options.size()));
+    for (const auto& option : sorted_provider_options) {
+      builder.AddString(option.first);
+      builder.AddString(option.second);
+    }
+  }
+
+  builder.AddInt(static_cast<int64_t>(session_options_.graph_optimization_level));
+
+  std::map<std::string, std::string> sorted_configs(session_options_.config_options.configurations.begin(),
+                                                    session_options_.config_options.configurations.end());
+  sorted_configs.erase(kOrtSessionOptionsConfigSessionCacheDir);
+  builder.AddInt(static_cast<int64_t>(sorted_configs.size()));
+  for (const auto& config : sorted_configs) {
+    builder.AddString(config.first);
+    builder.AddString(config.second);
+  }
+
+  builder.AddInt(static_cast<int64_t>(session_options_.free_dimension_overrides.size()));
+  for (const auto& dim_override : session_options_.free_dimension_overrides) {
+    builder.AddString(dim_override.dim_identifier);
+    builder.AddInt(static_cast<int64_t>(dim_override.dim_identifer_type));
+    builder.AddInt(dim_override.dim_value);
+  }
+
+  const std::set<std::string> sorted_optimizers_to_disable(optimizers_to_disable_.begin(),
+                                                           optimizers_to_disable_.end());
+  builder.AddInt(static_cast<int64_t>(sorted_optimizers_to_disable.size()));
+  for (const auto& optimizer : sorted_optimizers_to_disable) {
+    builder.AddString(optimizer);
+  }
+
+  session_cache::AddHardwareProperties(builder);
+
+  return builder.ToString();
+}
+
+Status InferenceSession::LoadFromSessionCache(const std::string& cache_key, bool& loaded) {
+  loaded = false;
+
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSessionCacheDir, "");
+  const PathString cache_file = session_cache::GetCacheFilePath(cache_dir, cache_key);
+
+  const Env& env = Env::Default();
+  size_t length = 0;
+  if (!env.GetFileLength(cache_file.c_str(), length).IsOK() || length == 0) {
+    LOGS(*session_logger_, INFO) << "No session cache entry found at " << ToUTF8String(cache_file);
+    return Status::OK();
+  }
+
+  std::unique_ptr<Model> cached_model;
+  Status status = env.MapFileIntoMemory(cache_file.c_str(), 0, length, session_cache_mapped_model_);
+  if (status.IsOK()) {
+    ort_format_model_bytes_ = gsl::span<const uint8_t>(
+        reinterpret_cast<const uint8_t*>(session_cache_mapped_model_.get()), length);
+    status = CreateModelFromOrtFormatBytes(cached_model);
+  }
+
+  // a bad cache entry is not fatal as we still have the original model
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Ignoring invalid session cache entry " << ToUTF8String(cache_file) << ". "
+                                    << status.ErrorMessage();
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    session_cache_mapped_model_.reset();
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(SaveModelMetadata(*cached_model));
+  model_ = std::move(cached_model);
+  loaded = true;
+
+  LOGS(*session_logger_, INFO) << "Loaded optimized model from session cache entry " << ToUTF8String(cache_file);
+  return Status::OK();
+}
+
+Status InferenceSession::SaveToSessionCache(const std::string& cache_key) const {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSessionCacheDir, "");
+  const PathString cache_file = session_cache::GetCacheFilePath(cache_dir, cache_key);
+
+  // write to a file unique to this session so concurrent writers of the same entry don't interfere
+  const PathString temp_file =
+      cache_file + ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + "." +
+                                std::to_string(session_id_) + ".tmp");
+
+  Status status = SaveToOrtFormat(temp_file);
+  if (status.IsOK()) {
+    status = session_cache::ReplaceFile(temp_file, cache_file);
+  }
+
+  if (!status.IsOK()) {
+    session_cache::RemoveFileIfExists(temp_file);
+    return status;
+  }
+
+  LOGS(*session_logger_, INFO) << "Saved optimized model to session cache entry " << ToUTF8String(cache_file);
+  return Status::OK();
+}
+
 common::Status InferenceSession::Load(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                       const std::string& event_name) {
   Status status = Status::OK();
@@ -673,6 +903,11 @@ common::Status InferenceSession::Load(const std::basic_string<T>& model_uri) {
     oss << "Load model from " << ToUTF8String(model_uri) << " failed:" << st.ErrorMessage();
     return common::Status(st.Category(), st.Code(), oss.str());
   }
+
+  if (IsSessionCacheEnabled()) {
+    UpdateSessionCacheModelHash(nullptr, 0);
+  }
+
   return Status::OK();
 }
 
@@ -767,7 +1002,13 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
                                     HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
   };
 
-  return Load(loader, "model_loading_array");
+  ORT_RETURN_IF_ERROR(Load(loader, "model_loading_array"));
+
+  if (IsSessionCacheEnabled()) {
+    UpdateSessionCacheModelHash(model_data, static_cast<size_t>(model_data_len));
+  }
+
+  return Status::OK();
 #else
   return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ONNX format model is not supported in this build.");
 #endif
@@ -943,11 +1184,20 @@ template <typename T>
 static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                                 std::basic_string<ORTCHAR_T>& model_location,
                                 gsl::span<const uint8_t>& bytes,
-                                std::vector<uint8_t>& bytes_data_holder) {
+                                std::vector<uint8_t>& bytes_data_holder,
+                                Env::MappedMemoryPtr* mapped_bytes) {
   size_t num_bytes = 0;
   model_location = ToWideString(model_uri);
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location.c_str(), num_bytes));
 
+  // Map the file if requested, so that its pages are only read when they are used. Fall back to reading the file
+  // if that fails, e.g. on a platform without mmap support.
+  if (mapped_bytes != nullptr && num_bytes > 0 &&
+      Env::Default().MapFileIntoMemory(model_location.c_str(), 0, num_bytes, *mapped_bytes).IsOK()) {
+    bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes->get()), num_bytes);
+    return Status::OK();
+  }
+
   bytes_data_holder.resize(num_bytes);
 
   std::ifstream bytes_stream(model_uri, std::ifstream::in | std::ifstream::binary);
@@ -969,7 +1219,8 @@ Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
       [&]() {
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              UseOrtModelBytesForInitializers() ? &ort_format_model_mapped_bytes_ : nullptr));
         return Status::OK();
       });
 }
@@ -980,7 +1231,8 @@ Status InferenceSession::LoadOrtModel(const std::wstring& model_uri) {
       [&]() {
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              UseOrtModelBytesForInitializers() ? &ort_format_model_mapped_bytes_ : nullptr));
         return Status::OK();
       });
 }
@@ -1024,6 +1276,24 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
 
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
 
+  // need to go from unique_ptr to shared_ptr when moving into model_
+  std::unique_ptr<Model> tmp_model;
+  ORT_RETURN_IF_ERROR(CreateModelFromOrtFormatBytes(tmp_model));
+
+  ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
+  model_ = std::move(tmp_model);
+
+  is_model_loaded_ = true;
+
+  return Status::OK();
+}
+
+bool InferenceSession::UseOrtModelBytesForInitializers() const {
+  return GetSessionOptions().config_options.GetConfigOrDefault(
+             kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+}
+
+Status InferenceSession::CreateModelFromOrtFormatBytes(std::unique_ptr<Model>& model) {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier), "ORT model verification failed.");
@@ -1041,26 +1311,21 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
   const auto* fbs_model = fbs_session->model();
   ORT_RETURN_IF(nullptr == fbs_model, "Missing Model. Invalid ORT format model.");
 
-  // need to go from unique_ptr to shared_ptr when moving into model_
-  std::unique_ptr<Model> tmp_model;
+  // Initialize takes the session_mutex_ as well so we need to have released it prior to calling this
+  const auto* fbs_sess_state = fbs_session->session_state();
+  ORT_RETURN_IF(nullptr == fbs_sess_state, "SessionState is null. Invalid ORT format model.");
+
+  const bool use_ort_model_bytes_for_initializers = UseOrtModelBytesForInitializers();
 #if !defined(ORT_MINIMAL_BUILD)
   ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model,
                                                HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                               *session_logger_, tmp_model));
+                                               use_ort_model_bytes_for_initializers, *session_logger_, model));
 
 #else
-  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, *session_logger_, tmp_model));
+  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, use_ort_model_bytes_for_initializers,
+                                               *session_logger_, model));
 #endif
 
-  ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
-  model_ = std::move(tmp_model);
-
-  // Initialize takes the session_mutex_ as well so we need to have released it prior to calling this
-  const auto* fbs_sess_state = fbs_session->session_state();
-  ORT_RETURN_IF(nullptr == fbs_sess_state, "SessionState is null. Invalid ORT format model.");
-
-  is_model_loaded_ = true;
-
   return Status::OK();
 }
 
@@ -1178,6 +1443,18 @@ static void ResolveMemoryPatternFlags(SessionState& session_state) {
     }
   }
 }
+#if !defined(ORT_MINIMAL_BUILD)
+static void CleanInitializedTensorsFromGraphs(SessionState& session_state) {
+  session_state.CleanInitializedTensorsFromGraph();
+
+  for (const auto& entry : session_state.GetSubgraphSessionStateMap()) {
+    for (const auto& name_to_subgraph_session_state : entry.second) {
+      CleanInitializedTensorsFromGraphs(*name_to_subgraph_session_state.second);
+    }
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // VC++ reports: "Releasing unheld lock 'l' in function 'onnxruntime::InferenceSession::Initialize'". But I don't see anything wrong.
@@ -1214,9 +1491,8 @@ common::Status InferenceSession::Initialize() {
     }
 
     // Verify that there are no external initializers in the graph if external data is disabled.
-    onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
-    const InitializedTensorSet& initializers = graph.GetAllInitializedTensors();
+    const InitializedTensorSet& initializers = model_->MainGraph().GetAllInitializedTensors();
     for (const auto& it : initializers) {
       if (utils::HasExternalData(*it.second)) {
         return common::Status(common::ONNXRUNTIME, common::FAIL,
@@ -1261,6 +1537,29 @@ common::Status InferenceSession::Initialize() {
     session_activity_started_ = true;
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // The cache key depends on the execution providers, so the cached model can only be looked up now.
+    // On a hit the model is replaced with the cached ORT format model and initialized the same way as if that had
+    // been loaded. On a miss the optimized model is saved to the cache once the session state is finalized.
+    const std::string session_cache_key =
+        ort_format_model_bytes_.empty() && IsSessionCacheEnabled() ? GetSessionCacheKey() : std::string();
+    bool loaded_from_session_cache = false;
+    if (!session_cache_key.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(LoadFromSessionCache(session_cache_key, loaded_from_session_cache));
+    }
+    const bool saving_to_session_cache = !session_cache_key.empty() && !loaded_from_session_cache;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+    onnxruntime::Graph& graph = model_->MainGraph();
+
+    // Unless the user provided a container, share pre-packed weights with the other sessions in the env
+    PrepackedWeightsContainer* prepacked_weights_container = prepacked_weights_container_;
+    if (prepacked_weights_container == nullptr &&
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableEnvPrepackedWeightsSharing,
+                                                           "0") != "1") {
+      prepacked_weights_container = &environment_.GetPrepackedWeightsContainer();
+    }
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1273,7 +1572,25 @@ common::Status InferenceSession::Initialize() {
         session_profiler_,
         session_options_.use_deterministic_compute,
         session_options_.enable_mem_reuse,
-        prepacked_weights_container_);
+        prepacked_weights_container);
+
+    uint64_t mem_pattern_cache_size = 0;
+    ORT_RETURN_IF_ERROR_SESSIONID_(ParseStringWithClassicLocale(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheSize, "0"),
+        mem_pattern_cache_size));
+    session_state_->SetMemoryPatternCacheOptions(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternShapeBuckets, "0") == "1",
+        static_cast<size_t>(mem_pattern_cache_size));
+    session_state_->SetUseOfflineMemoryPatternPlanner(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOfflineMemoryPatternPlanner, "0") == "1");
+    session_state_->SetFreezeShapes(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigFreezeShapes, "0") == "1");
+
+    uint64_t memory_budget_bytes = 0;
+    ORT_RETURN_IF_ERROR_SESSIONID_(ParseStringWithClassicLocale(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryBudgetBytes, "0"),
+        memory_budget_bytes));
+    session_state_->SetMemoryBudget(static_cast<size_t>(memory_budget_bytes));
 
     // Collect the kernel registries from execution provider instances;
     // There are 2 kinds of kernel registries with priority from high to low as below,
@@ -1312,6 +1629,14 @@ common::Status InferenceSession::Initialize() {
                                                                          saving_ort_format,
                                                                          minimal_build_optimization_handling));
 
+      if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelGraphOptimization,
+                                                             "0") == "1") {
+        // the inter-op thread pool only exists for the parallel execution mode
+        auto* inter_op_thread_pool = GetInterOpThreadPoolToUse();
+        graph_transformation_mgr_.SetThreadPool(inter_op_thread_pool != nullptr ? inter_op_thread_pool
+                                                                                : GetIntraOpThreadPoolToUse());
+      }
+
       // add predefined transformers
       ORT_RETURN_IF_ERROR_SESSIONID_(AddPredefinedTransformers(graph_transformation_mgr_,
                                                                session_options_.graph_optimization_level,
@@ -1359,6 +1684,15 @@ common::Status InferenceSession::Initialize() {
           } else {
             LOGS(*session_logger_, INFO) << "This session will use the CUDA Graph feature as requested by the user.";
             cached_execution_provider_for_graph_replay_.SetExecutionProvider(cuda_ep);
+
+            int64_t graph_capture_shape_cache_size = 0;
+            ORT_RETURN_IF_ERROR_SESSIONID_(ParseStringWithClassicLocale(
+                session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGraphCaptureShapeCacheSize,
+                                                                   "0"),
+                graph_capture_shape_cache_size));
+            ORT_RETURN_IF_NOT(graph_capture_shape_cache_size >= 0, kOrtSessionOptionsConfigGraphCaptureShapeCacheSize,
+                              " must not be negative.");
+            graph_capture_shape_cache_size_ = static_cast<size_t>(graph_capture_shape_cache_size);
           }
         }
       }
@@ -1387,15 +1721,33 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    const bool keep_initializers = saving_model || saving_to_session_cache;
+#else
+    const bool keep_initializers = saving_model;
+#endif
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              session_options_,
                                              serialized_session_state,
                                              // need to keep the initializers if saving the optimized model
-                                             !saving_model,
+                                             !keep_initializers,
                                              saving_ort_format));
 
 #if !defined(ORT_MINIMAL_BUILD)
+    if (saving_to_session_cache) {
+      // compiled nodes can't be serialized. the cache is skipped rather than failing the session.
+      if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+        LOGS(*session_logger_, INFO) << "Not saving the model to the session cache as it contains compiled nodes.";
+      } else {
+        const Status cache_status = SaveToSessionCache(session_cache_key);
+        if (!cache_status.IsOK()) {
+          LOGS(*session_logger_, WARNING) << "Failed to save the model to the session cache. "
+                                          << cache_status.ErrorMessage();
+        }
+      }
+    }
     if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
         ORT_RETURN_IF_ERROR_SESSIONID_(
@@ -1419,17 +1771,44 @@ common::Status InferenceSession::Initialize() {
         ORT_RETURN_IF_ERROR_SESSIONID_(Model::Save(*model_, session_options_.optimized_model_filepath));
       }
     }
+
+    // the initializers were only kept for serialization
+    if (saving_to_session_cache && !saving_model) {
+      CleanInitializedTensorsFromGraphs(*session_state_);
+    }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    InitBatchStacking();
+
+    const std::string kernel_tuning_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigKernelTuningFile, "");
+    if (!kernel_tuning_file.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(KernelTuningDatabase::Instance().Open(kernel_tuning_file));
+    }
+
+    uint64_t metrics_sampling_interval = 0;
+    ORT_RETURN_IF_ERROR_SESSIONID_(ParseStringWithClassicLocale(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMetricsSamplingInterval, "0"),
+        metrics_sampling_interval));
+    if (metrics_sampling_interval > 0) {
+      session_metrics_ = std::make_unique<SessionMetrics>(session_state_->GetGraphViewer(), metrics_sampling_interval);
+      session_state_->SetMetrics(session_metrics_.get());
+    }
+
     is_inited_ = true;
 
-    // we don't directly use the ORT format bytes currently, so free those now
-    // TODO, we may need to keep the bytes if we are using the offset directly in the initializers
-    ort_format_model_bytes_ = gsl::span<const uint8_t>();
-    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    // the initializers may refer to the ORT format bytes in place, otherwise those are not used anymore.
+    if (!UseOrtModelBytesForInitializers()) {
+      ort_format_model_bytes_ = gsl::span<const uint8_t>();
+      std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+      ort_format_model_mapped_bytes_.reset();
+#if !defined(ORT_MINIMAL_BUILD)
+      session_cache_mapped_model_.reset();
+#endif
+    }
 
     // and log telemetry
     bool model_has_fp16_inputs = ModelHasFP16Inputs(graph);
@@ -1763,6 +2142,19 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
                              const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  if (graph_capture_shape_cache_size_ > 0) {
+    return RunWithGraphCache(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                 /*capture_graph*/ true);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                 const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info, bool capture_graph,
+                                 FeedsFetchesManager* bound_feeds_fetches_manager) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -1775,6 +2167,24 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #endif
   Status retval = Status::OK();
   const Env& env = Env::Default();
+  ORT_PROBE2(run__start, session_id_, run_options.run_tag.c_str());
+
+  // takes part in the fair sharing of the global intra-op thread pool if the session has a weight
+  concurrency::ThreadPool::ActiveScope thread_pool_scope(intra_op_thread_pool_quota_.get());
+
+  // the terminate flag and the deadline of the run apply to the kernels and the parallel loops it runs
+  uint64_t run_timeout_ms = 0;
+  ORT_RETURN_IF_ERROR_SESSIONID_(ParseStringWithClassicLocale(
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigRunTimeoutMs, "0"), run_timeout_ms));
+  const auto run_deadline = run_timeout_ms > 0
+                                ? concurrency::ThreadPool::RunTerminationScope::Clock::now() +
+                                      std::chrono::milliseconds(run_timeout_ms)
+                                : concurrency::ThreadPool::RunTerminationScope::Clock::time_point::max();
+  concurrency::ThreadPool::RunTerminationScope run_termination(run_options.terminate, run_deadline);
+
+  // in ring buffer mode the work items of the parallel loops and the arena allocations of the run are profiled too
+  profiling::Profiler::ThreadScope profiler_scope(
+      session_profiler_.IsEnabled() && session_profiler_.IsRingBufferEnabled() ? &session_profiler_ : nullptr);
 
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
@@ -1798,8 +2208,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      if (bound_feeds_fetches_manager == nullptr) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      }
 
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
@@ -1809,13 +2221,21 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      std::optional<FeedsFetchesManager> owned_feeds_fetches_manager;
+      FeedsFetchesManager* feeds_fetches_manager = bound_feeds_fetches_manager;
+      if (feeds_fetches_manager == nullptr) {
+        owned_feeds_fetches_manager.emplace(
+            FeedsFetchesInfo(feed_names, output_names, session_state_->GetOrtValueNameIdxMap()));
+        feeds_fetches_manager = &*owned_feeds_fetches_manager;
+      } else {
+        // the inputs may have been bound to values on other devices since the previous run
+        feeds_fetches_manager->ResetDeviceCopyChecks();
+      }
 
       if (p_fetches_device_info) {
         // populate the target device info. ignored if pre-allocated fetches are provided
         const auto& fetch_device_info = *p_fetches_device_info;
-        auto& fetch_info = feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo();
+        auto& fetch_info = feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo();
 
         for (size_t i = 0, end = output_names.size(); i < end; ++i) {
           fetch_info[i].target_device = fetch_device_info[i];
@@ -1850,7 +2270,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
 #if !defined(ORT_MINIMAL_BUILD)
       if (run_options.only_execute_path_to_fetches) {
-        session_state_->UpdateToBeExecutedNodes(feeds_fetches_manager.GetFeedsFetchesInfo().fetches_mlvalue_idxs);
+        session_state_->UpdateToBeExecutedNodes(feeds_fetches_manager->GetFeedsFetchesInfo().fetches_mlvalue_idxs);
       }
 #endif
 
@@ -1858,9 +2278,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
       session_state_->IncrementGraphExecutionCounter();
 #endif
-      ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
+      ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, *feeds_fetches_manager, feeds, *p_fetches,
                                                    session_options_.execution_mode, run_options.terminate, run_logger,
                                                    run_options.only_execute_path_to_fetches));
+
+      // the parallel loops of the last kernels may have been cut short after the last check of the executor
+      ORT_CHECK_AND_SET_RETVAL(utils::CheckRunTermination(run_options.terminate, run_logger));
     }
     ORT_CATCH(const std::exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -1900,6 +2323,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
   // log evaluation stop to trace logging provider
   env.GetTelemetryProvider().LogEvaluationStop();
+  ORT_PROBE2(run__end, session_id_, retval.Code());
 
   // send out profiling events (optional)
   if (session_profiler_.IsEnabled()) {
@@ -1913,16 +2337,114 @@ Status InferenceSession::Run(const RunOptions& run_options,
   // are needed before replaying the captured graph, here run the inference again
   // to capture the graph, so that users just need one session run to capture
   // the graph.
-  if (retval.IsOK() && cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
+  if (retval.IsOK() && capture_graph && cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
     LOGS(*session_logger_, INFO) << "Start the second Run() to capture the graph. "
                                     "The first one is for necessary memory allocation;"
                                     "The second one is for capturing the graph.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                capture_graph, bound_feeds_fetches_manager));
   }
   return retval;
 }
 
+Status InferenceSession::RunWithGraphCache(const RunOptions& run_options,
+                                           const std::vector<std::string>& feed_names,
+                                           const std::vector<OrtValue>& feeds,
+                                           const std::vector<std::string>& output_names,
+                                           std::vector<OrtValue>* p_fetches,
+                                           const std::vector<OrtDevice>* p_fetches_device_info) {
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+
+  std::lock_guard<OrtMutex> lock(graph_cache_mutex_);
+
+  std::ostringstream key;
+  bool all_feeds_are_tensors = true;
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    if (!feeds[i].IsTensor()) {
+      all_feeds_are_tensors = false;
+      break;
+    }
+    const auto& tensor = feeds[i].Get<Tensor>();
+    key << feed_names[i] << ':' << DataTypeImpl::ToString(tensor.DataType()) << tensor.Shape() << ';';
+  }
+  for (const auto& output_name : output_names) {
+    key << output_name << ';';
+  }
+
+  auto it = graph_cache_.find(key.str());
+  if (it == graph_cache_.end()) {
+    if (!all_feeds_are_tensors || graph_cache_.size() >= graph_capture_shape_cache_size_) {
+      LOGS(*session_logger_, INFO) << "No graph is cached for the feeds of this run and no more graphs can be captured."
+                                   << " Running the model without graph capture.";
+      cached_execution_provider_for_graph_replay_.SetGraphAnnotationId(IExecutionProvider::kGraphAnnotationSkip);
+      return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                     /*capture_graph*/ false);
+    }
+
+    CachedGraph cached_graph;
+    cached_graph.graph_annotation_id = next_graph_annotation_id_++;
+    // the staging buffers are allocated by the EP the graph is captured for, so that the feeds are not copied
+    // again during the graph
+    auto allocator = cached_execution_provider_for_graph_replay_.GetAllocator();
+    for (const auto& feed : feeds) {
+      const auto& tensor = feed.Get<Tensor>();
+      OrtValue staged_feed;
+      Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), allocator, staged_feed);
+      cached_graph.staged_feeds.push_back(std::move(staged_feed));
+    }
+    it = graph_cache_.emplace(key.str(), std::move(cached_graph)).first;
+  }
+
+  CachedGraph& cached_graph = it->second;
+  const auto& data_transfer_mgr = session_state_->GetDataTransferMgr();
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(data_transfer_mgr.CopyTensor(
+        feeds[i].Get<Tensor>(), *cached_graph.staged_feeds[i].GetMutable<Tensor>()));
+  }
+
+  cached_execution_provider_for_graph_replay_.SetGraphAnnotationId(cached_graph.graph_annotation_id);
+  // Capture the graph if it isn't captured yet for this thread. The first run allocates the staged fetches, which
+  // are then used as the pre-allocated fetches of the run that captures the graph.
+  if (!cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
+    auto status = RunImpl(run_options, feed_names, cached_graph.staged_feeds, output_names,
+                          &cached_graph.staged_fetches, nullptr, /*capture_graph*/ true);
+    if (!status.IsOK()) {
+      // the staged fetches may be incomplete, so start over with a new graph on the next run
+      graph_cache_.erase(it);
+      return status;
+    }
+  } else {
+    LOGS(*session_logger_, INFO) << "Replaying the captured "
+                                 << cached_execution_provider_for_graph_replay_.Type()
+                                 << " CUDA Graph for the shapes of the feeds with tag: " << run_options.run_tag;
+    ++current_num_runs_;
+    auto status = cached_execution_provider_for_graph_replay_.ReplayGraph();
+    --current_num_runs_;
+    ORT_RETURN_IF_ERROR_SESSIONID_(status);
+  }
+
+  // copy the staged fetches out, as the next replay overwrites them
+  if (p_fetches->empty()) {
+    p_fetches->resize(output_names.size());
+  }
+  for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+    const auto& staged_fetch = cached_graph.staged_fetches[i].Get<Tensor>();
+    auto& fetch = (*p_fetches)[i];
+    if (!fetch.IsAllocated()) {
+      AllocatorPtr allocator = p_fetches_device_info != nullptr
+                                   ? session_state_->GetAllocator((*p_fetches_device_info)[i])
+                                   : session_state_->GetAllocator(staged_fetch.Location());
+      ORT_RETURN_IF_NOT(allocator != nullptr, "No allocator for output ", output_names[i]);
+      Tensor::InitOrtValue(staged_fetch.DataType(), staged_fetch.Shape(), allocator, fetch);
+    }
+    ORT_RETURN_IF_ERROR_SESSIONID_(data_transfer_mgr.CopyTensor(staged_fetch, *fetch.GetMutable<Tensor>()));
+  }
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -2011,8 +2533,28 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  if (graph_capture_shape_cache_size_ > 0) {
+    return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+               &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  }
+
+  // validate the bindings and map their names once, the runs with the same bindings skip that
+  if (!io_binding.feeds_validated_) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(io_binding.feed_names_, io_binding.feeds_));
+    io_binding.ReleaseOutputsIfShapesChanged();
+    io_binding.feeds_validated_ = true;
+  }
+
+  if (!io_binding.feeds_fetches_manager_) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(io_binding.output_names_, &io_binding.outputs_));
+    ORT_RETURN_IF_ERROR_SESSIONID_(FeedsFetchesManager::Create(io_binding.feed_names_, io_binding.output_names_,
+                                                               session_state_->GetOrtValueNameIdxMap(),
+                                                               io_binding.feeds_fetches_manager_));
+  }
+
+  return RunImpl(run_options, io_binding.feed_names_, io_binding.feeds_, io_binding.output_names_,
+                 &io_binding.outputs_, &io_binding.outputs_device_info_, /*capture_graph*/ true,
+                 io_binding.feeds_fetches_manager_.get());
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -2020,6 +2562,393 @@ common::Status InferenceSession::Run(IOBinding& io_binding) {
   return Run(run_options, io_binding);
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options, std::vector<std::string> feed_names,
+                                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                                          std::vector<OrtValue> fetches, RunAsyncCallback callback) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  // The inter op thread pool only exists in ORT_PARALLEL mode, where the executor blocks the thread of the run
+  // until the nodes it scheduled on that pool have completed, so runs in flight could starve it. A run executing on
+  // an intra op thread still parallelizes its kernels over the pool.
+  auto* tp = GetIntraOpThreadPoolToUse();
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "RunAsync requires an intra op thread pool with at least one thread besides the caller. "
+                           "Set the number of intra op threads to 0 or more than 1.");
+  }
+
+  // std::function requires a copyable task, so the arguments are moved into shared state.
+  struct AsyncRun {
+    RunOptions default_run_options;
+    const RunOptions* run_options;
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    std::vector<std::string> output_names;
+    std::vector<OrtValue> fetches;
+    RunAsyncCallback callback;
+  };
+
+  auto async_run = std::make_shared<AsyncRun>();
+  async_run->run_options = run_options != nullptr ? run_options : &async_run->default_run_options;
+  async_run->feed_names = std::move(feed_names);
+  async_run->feeds = std::move(feeds);
+  async_run->output_names = std::move(output_names);
+  async_run->fetches = std::move(fetches);
+  async_run->callback = std::move(callback);
+
+  {
+    std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+    ++num_async_runs_;
+  }
+
+  concurrency::ThreadPool::Schedule(tp, [this, async_run]() {
+    Status status;
+    ORT_TRY {
+      status = Run(*async_run->run_options, async_run->feed_names, async_run->feeds, async_run->output_names,
+                   &async_run->fetches, nullptr);
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, e.what());
+      });
+    }
+
+    // The feeds are released before the callback so that the caller may hold the last references to them, e.g. to
+    // free them under a lock of its own.
+    async_run->feeds.clear();
+    async_run->callback(async_run->fetches, status);
+
+    // The fetches may have been allocated by the session, so they are released before the count is decremented and
+    // the destructor may proceed. Nothing of the session may be used after that.
+    async_run->fetches.clear();
+    async_run->callback = nullptr;
+
+    std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+    if (--num_async_runs_ == 0) {
+      async_runs_cv_.notify_all();
+    }
+  });
+
+  return Status::OK();
+}
+
+// Returns the symbolic leading dimension of a graph input or output, or nullptr.
+static const std::string* GetLeadingDimParam(const NodeArg& node_arg) {
+  const auto* shape = node_arg.Shape();
+  if (shape == nullptr || shape->dim_size() == 0 || !shape->dim(0).has_dim_param()) {
+    return nullptr;
+  }
+  return &shape->dim(0).dim_param();
+}
+
+void InferenceSession::InitBatchStacking() {
+  batch_dim_param_.clear();
+  stack_batch_feeds_ = false;
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableBatchStacking, "0") != "1") {
+    return;
+  }
+
+  // the model declares the batch dimension by giving its inputs and outputs the same symbolic leading dimension
+  const auto& graph_viewer = session_state_->GetGraphViewer();
+  const std::string* batch_dim_param = nullptr;
+  auto has_batch_dim = [&batch_dim_param](const NodeArg* node_arg) {
+    const std::string* dim_param = GetLeadingDimParam(*node_arg);
+    if (dim_param == nullptr || (batch_dim_param != nullptr && *dim_param != *batch_dim_param)) {
+      return false;
+    }
+    batch_dim_param = dim_param;
+    return true;
+  };
+
+  if (graph_viewer.GetInputs().empty() || graph_viewer.GetOutputs().empty() ||
+      !std::all_of(graph_viewer.GetInputs().cbegin(), graph_viewer.GetInputs().cend(), has_batch_dim) ||
+      !std::all_of(graph_viewer.GetOutputs().cbegin(), graph_viewer.GetOutputs().cend(), has_batch_dim)) {
+    LOGS(*session_logger_, WARNING) << "Batch stacking is enabled but the inputs and outputs of the model don't share "
+                                    << "a symbolic leading dimension. RunBatch will run the requests separately.";
+    return;
+  }
+
+  batch_dim_param_ = *batch_dim_param;
+  stack_batch_feeds_ = true;
+  LOGS(*session_logger_, INFO) << "RunBatch will concatenate the feeds of its requests along the dimension '"
+                               << batch_dim_param_ << "'.";
+}
+
+bool InferenceSession::CanStackFeeds(const std::vector<std::string>& feed_names,
+                                     const std::vector<std::vector<OrtValue>>& feeds,
+                                     const std::vector<std::vector<OrtValue>>& fetches) const {
+  if (feeds.size() < 2 || feed_names.empty()) {
+    return false;
+  }
+
+  // overridable initializers don't have the batch dimension
+  for (const auto& feed_name : feed_names) {
+    auto it = input_def_map_.find(feed_name);
+    if (it == input_def_map_.end()) {
+      return false;
+    }
+    const std::string* dim_param = GetLeadingDimParam(*it->second.node_arg);
+    if (dim_param == nullptr || *dim_param != batch_dim_param_) {
+      return false;
+    }
+  }
+
+  for (const auto& request_fetches : fetches) {
+    if (std::any_of(request_fetches.cbegin(), request_fetches.cend(),
+                    [](const OrtValue& fetch) { return fetch.IsAllocated(); })) {
+      return false;
+    }
+  }
+
+  // the feeds must be CPU tensors of fixed size elements, the feeds of a request must have the same batch size, and
+  // the feeds with the same name must only differ in their batch size
+  for (const auto& request_feeds : feeds) {
+    if (request_feeds.size() != feed_names.size()) {
+      return false;
+    }
+
+    for (size_t i = 0, end = request_feeds.size(); i < end; ++i) {
+      if (!request_feeds[i].IsTensor()) {
+        return false;
+      }
+
+      const auto& tensor = request_feeds[i].Get<Tensor>();
+      const auto& first_tensor = feeds[0][i].Get<Tensor>();
+      if (tensor.IsDataTypeString() || tensor.Location().device.Type() != OrtDevice::CPU ||
+          tensor.Shape().NumDimensions() == 0 || tensor.DataType() != first_tensor.DataType() ||
+          tensor.Shape().NumDimensions() != first_tensor.Shape().NumDimensions() ||
+          tensor.Shape().Slice(1) != first_tensor.Shape().Slice(1) ||
+          tensor.Shape()[0] != request_feeds[0].Get<Tensor>().Shape()[0]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+Status InferenceSession::RunStackedFeeds(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                         const std::vector<std::vector<OrtValue>>& feeds,
+                                         const std::vector<std::string>& output_names,
+                                         std::vector<std::vector<OrtValue>>& fetches, bool& split) {
+  const size_t num_requests = feeds.size();
+  std::vector<int64_t> batch_sizes(num_requests);
+  int64_t total_batch_size = 0;
+  for (size_t r = 0; r < num_requests; ++r) {
+    batch_sizes[r] = feeds[r][0].Get<Tensor>().Shape()[0];
+    total_batch_size += batch_sizes[r];
+  }
+
+  auto allocator = session_state_->GetAllocator(OrtDevice());
+  ORT_RETURN_IF_NOT(allocator != nullptr, "No CPU allocator to concatenate the feeds.");
+
+  std::vector<OrtValue> stacked_feeds(feed_names.size());
+  for (size_t i = 0, end = feed_names.size(); i < end; ++i) {
+    const auto& first_tensor = feeds[0][i].Get<Tensor>();
+    TensorShape shape = first_tensor.Shape();
+    shape[0] = total_batch_size;
+    Tensor::InitOrtValue(first_tensor.DataType(), shape, allocator, stacked_feeds[i]);
+
+    auto* data = static_cast<uint8_t*>(stacked_feeds[i].GetMutable<Tensor>()->MutableDataRaw());
+    for (const auto& request_feeds : feeds) {
+      const auto& tensor = request_feeds[i].Get<Tensor>();
+      memcpy(data, tensor.DataRaw(), tensor.SizeInBytes());
+      data += tensor.SizeInBytes();
+    }
+  }
+
+  std::vector<OrtValue> stacked_fetches;
+  ORT_RETURN_IF_ERROR(Run(run_options, feed_names, stacked_feeds, output_names, &stacked_fetches, nullptr));
+
+  // the declared shapes of the outputs are not enforced, so check that they can be split
+  split = std::all_of(stacked_fetches.cbegin(), stacked_fetches.cend(), [total_batch_size](const OrtValue& fetch) {
+    if (!fetch.IsTensor()) {
+      return false;
+    }
+    const auto& tensor = fetch.Get<Tensor>();
+    return !tensor.IsDataTypeString() && tensor.Location().device.Type() == OrtDevice::CPU &&
+           tensor.Shape().NumDimensions() > 0 && tensor.Shape()[0] == total_batch_size;
+  });
+  if (!split) {
+    return Status::OK();
+  }
+
+  fetches.resize(num_requests);
+  for (size_t r = 0; r < num_requests; ++r) {
+    fetches[r].resize(output_names.size());
+  }
+
+  for (size_t o = 0, end = output_names.size(); o < end; ++o) {
+    const auto& stacked_tensor = stacked_fetches[o].Get<Tensor>();
+    const size_t bytes_per_sample = static_cast<size_t>(stacked_tensor.Shape().SizeFromDimension(1)) *
+                                    stacked_tensor.DataType()->Size();
+    const auto* data = static_cast<const uint8_t*>(stacked_tensor.DataRaw());
+    for (size_t r = 0; r < num_requests; ++r) {
+      TensorShape shape = stacked_tensor.Shape();
+      shape[0] = batch_sizes[r];
+      Tensor::InitOrtValue(stacked_tensor.DataType(), shape, allocator, fetches[r][o]);
+      const size_t num_bytes = static_cast<size_t>(batch_sizes[r]) * bytes_per_sample;
+      memcpy(fetches[r][o].GetMutable<Tensor>()->MutableDataRaw(), data, num_bytes);
+      data += num_bytes;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status InferenceSession::RunBatch(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                  const std::vector<std::vector<OrtValue>>& feeds,
+                                  const std::vector<std::string>& output_names,
+                                  std::vector<std::vector<OrtValue>>& fetches) {
+  if (!fetches.empty() && fetches.size() != feeds.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "RunBatch got the feeds of ", feeds.size(),
+                           " requests but the fetches of ", fetches.size(), " requests.");
+  }
+
+  if (stack_batch_feeds_ && CanStackFeeds(feed_names, feeds, fetches)) {
+    bool split = false;
+    ORT_RETURN_IF_ERROR_SESSIONID_(RunStackedFeeds(run_options, feed_names, feeds, output_names, fetches, split));
+    if (split) {
+      return Status::OK();
+    }
+
+    // the declared shapes are wrong, so stop stacking rather than running every batch twice
+    if (stack_batch_feeds_.exchange(false)) {
+      LOGS(*session_logger_, WARNING) << "The outputs of the model don't have the batch dimension of its inputs. "
+                                      << "RunBatch will run the requests separately from now on.";
+    }
+  }
+
+  fetches.resize(feeds.size());
+  std::vector<Status> statuses(feeds.size());
+  auto run_request = [&](size_t r) {
+    ORT_TRY {
+      statuses[r] = Run(run_options, feed_names, feeds[r], output_names, &fetches[r], nullptr);
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        statuses[r] = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, e.what());
+      });
+    }
+  };
+
+  // As with RunAsync, the other requests run on threads of the intra op thread pool, which still parallelize their
+  // kernels over the pool. A parallel loop can't run them, as the kernels of the caller can't start parallel loops
+  // of their own within it.
+  OrtMutex mutex;
+  OrtCondVar done;
+  size_t num_pending = feeds.size() > 0 ? feeds.size() - 1 : 0;
+  for (size_t r = 1; r < feeds.size(); ++r) {
+    concurrency::ThreadPool::Schedule(GetIntraOpThreadPoolToUse(), [&, r]() {
+      run_request(r);
+      std::lock_guard<OrtMutex> lock(mutex);
+      if (--num_pending == 0) {
+        done.notify_all();
+      }
+    });
+  }
+
+  if (!feeds.empty()) {
+    run_request(0);
+  }
+
+  {
+    std::unique_lock<OrtMutex> lock(mutex);
+    done.wait(lock, [&num_pending]() { return num_pending == 0; });
+  }
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(status);
+  }
+
+  return Status::OK();
+}
+
+Status InferenceSession::WarmUp(const RunOptions& run_options,
+                                const std::vector<std::unordered_map<std::string, TensorShape>>& input_shapes) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  auto allocator = session_state_->GetAllocator(OrtDevice());
+  ORT_RETURN_IF_NOT(allocator != nullptr, "No CPU allocator to create the warm-up feeds.");
+
+  const auto& model_inputs = model_->MainGraph().GetInputs();
+  std::vector<std::string> output_names;
+  output_names.reserve(output_def_list_.size());
+  for (const auto* output : output_def_list_) {
+    output_names.push_back(output->Name());
+  }
+
+  for (const auto& shapes : input_shapes) {
+    for (const auto& name_and_shape : shapes) {
+      if (input_def_map_.find(name_and_shape.first) == input_def_map_.cend()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid warm-up input name: ", name_and_shape.first);
+      }
+    }
+
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    for (const auto& [name, meta_data] : input_def_map_) {
+      auto shape_it = shapes.find(name);
+      const bool is_required = std::any_of(model_inputs.cbegin(), model_inputs.cend(),
+                                           [&name](const NodeArg* input) { return input->Name() == name; });
+      // overridable initializers keep their values unless a shape is given for them
+      if (shape_it == shapes.cend() && !is_required) {
+        continue;
+      }
+
+      if (!meta_data.ml_data_type->IsTensorType()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input ", name,
+                               " is not a tensor. Only models with tensor inputs can be warmed up.");
+      }
+
+      TensorShape shape;
+      if (shape_it != shapes.cend()) {
+        shape = shape_it->second;
+      } else {
+        // symbolic and unknown dimensions are -1 in the shape of the input
+        if (meta_data.node_arg->Shape() == nullptr || meta_data.tensor_shape.Size() < 0) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No warm-up shape was given for input ", name,
+                                 ", which doesn't have a static shape in the model.");
+        }
+        shape = meta_data.tensor_shape;
+      }
+
+      OrtValue feed;
+      Tensor::InitOrtValue(meta_data.ml_data_type->AsTensorType()->GetElementType(), shape, allocator, feed);
+      auto* tensor = feed.GetMutable<Tensor>();
+      // string tensors are initialized to empty strings
+      if (!tensor->IsDataTypeString()) {
+        memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+      }
+      feed_names.push_back(name);
+      feeds.push_back(std::move(feed));
+    }
+
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    std::vector<OrtValue> fetches;
+    ORT_RETURN_IF_ERROR_SESSIONID_(Run(run_options, feed_names, feeds, output_names, &fetches, nullptr));
+    LOGS(*session_logger_, INFO) << "Warm-up run took "
+                                 << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        std::chrono::high_resolution_clock::now() - start_time)
+                                        .count()
+                                 << " ms";
+  }
+
+  return Status::OK();
+}
+
 template <typename T>
 void InferenceSession::StartProfiling(const std::basic_string<T>& file_prefix) {
   std::basic_ostringstream<T> ss;
@@ -2054,10 +2983,50 @@ std::string InferenceSession::EndProfiling() {
   return std::string();
 }
 
+std::string InferenceSession::DumpProfiling() {
+  if (is_model_loaded_) {
+    if (session_profiler_.IsEnabled()) {
+      return session_profiler_.DumpProfiling();
+    } else {
+      LOGS(*session_logger_, VERBOSE) << "Profiler is disabled.";
+      return std::string();
+    }
+  }
+  LOGS(*session_logger_, ERROR) << "Could not write a profile because no model was loaded.";
+  return std::string();
+}
+
 const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+common::Status InferenceSession::GetMetrics(std::string& metrics_json) const {
+  if (session_metrics_ == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Metrics are not enabled for this session. Set the session option ",
+                           kOrtSessionOptionsConfigMetricsSamplingInterval, " to enable them.");
+  }
+
+  SessionMetrics::ResourceUsage resource_usage;
+  for (const auto& provider : execution_providers_) {
+    for (const auto& allocator : provider->GetAllocators()) {
+      AllocatorStats stats;
+      allocator->GetStats(&stats);
+      resource_usage.allocator_stats.emplace_back(
+          MakeString(provider->Type(), ":", allocator->Info().name, ":", allocator->Info().id), stats);
+    }
+  }
+
+  if (const auto* intra_op_thread_pool = GetIntraOpThreadPoolToUse()) {
+    resource_usage.intra_op_queued_tasks = intra_op_thread_pool->NumQueuedTasks();
+  }
+  if (const auto* inter_op_thread_pool = GetInterOpThreadPoolToUse()) {
+    resource_usage.inter_op_queued_tasks = inter_op_thread_pool->NumQueuedTasks();
+  }
+
+  metrics_json = session_metrics_->ToJson(resource_usage);
+  return Status::OK();
+}
+
 AllocatorPtr InferenceSession::GetAllocator(const OrtMemoryInfo& mem_info) const {
   return session_state_->GetAllocator(mem_info);
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -16,11 +18,13 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/session_metrics.h"
 #include "core/framework/session_state.h"
 #include "core/graph/basic_types.h"
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include "core/framework/session_options.h"
 #include "core/framework/allocatormgr.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
@@ -326,6 +330,48 @@ class InferenceSession {
   virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding) ORT_MUST_USE_RESULT;
   common::Status Run(IOBinding& io_binding) ORT_MUST_USE_RESULT;
 
+  /**
+   * Callback of RunAsync, invoked on the thread that executed the run with the fetches and the status of the run.
+   */
+  using RunAsyncCallback = std::function<void(std::vector<OrtValue>& fetches, const common::Status& status)>;
+
+  /**
+   * Run a pre-loaded and pre-intialized model asynchronously on a thread of the intra op thread pool, so that the
+   * calling thread is not blocked while the model runs. The arguments are the same as for Run and are owned by the
+   * run. The outcome of the run is passed to `callback`, the returned status only reports whether the run could be
+   * scheduled. The destructor waits for the outstanding asynchronous runs.
+   * @param run_options use this to tune the Run call to your needs. Default run options are used if nullptr,
+   *        otherwise it must stay valid until the callback is invoked.
+   * @param callback invoked when the run has completed.
+   */
+  common::Status RunAsync(const RunOptions* run_options, std::vector<std::string> feed_names,
+                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                          std::vector<OrtValue> fetches, RunAsyncCallback callback) ORT_MUST_USE_RESULT;
+
+  /**
+   * Run a pre-loaded and pre-intialized model for several independent requests with the same feed and output names.
+   * If batch stacking is enabled and the model gives all its inputs and outputs the same symbolic leading dimension,
+   * e.g. "batch", and the feeds are CPU tensors whose other dimensions match across the requests and no fetches are
+   * pre-allocated, the feeds are concatenated along that dimension, the model runs once, and its outputs are split.
+   * Otherwise the requests run concurrently on the intra op thread pool.
+   * See kOrtSessionOptionsConfigEnableBatchStacking.
+   * @param feeds the feeds of each request, in the order of feed_names.
+   * @param fetches resized to the number of requests. As with Run, the fetches of a request may be pre-allocated.
+   */
+  common::Status RunBatch(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                          const std::vector<std::vector<OrtValue>>& feeds, const std::vector<std::string>& output_names,
+                          std::vector<std::vector<OrtValue>>& fetches) ORT_MUST_USE_RESULT;
+
+  /**
+   * Warm up a pre-initialized model by running it once with zero valued CPU feeds for each of the given sets of input
+   * shapes, so that the first real runs with these shapes don't pay for the per-shape work of a first run, e.g.
+   * memory pattern planning, arena growth, algorithm selection of the kernels or graph capture.
+   * @param input_shapes each entry maps input names to the shape to warm up with. Inputs that are not in an entry
+   *        must have a static shape in the model.
+   */
+  common::Status WarmUp(const RunOptions& run_options,
+                        const std::vector<std::unordered_map<std::string, TensorShape>>& input_shapes) ORT_MUST_USE_RESULT;
+
 #ifdef ENABLE_TRAINING
   /**
    * Partially run a pre-loaded and pre-intialized model.
@@ -424,12 +470,27 @@ class InferenceSession {
     @return the name of the profile file.
     */
   std::string EndProfiling();
+
+  /**
+    * Write the profile events captured so far in chromium format to a new file, without ending profiling.
+    @return the name of the file, or an empty string if profiling is not enabled.
+    */
+  std::string DumpProfiling();
+
   /**
     * Return the profiler to access its attributes
     @return the profiler object
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Get the metrics of the runs of this session, enabled with kOrtSessionOptionsConfigMetricsSamplingInterval.
+    * @param metrics_json Set to a JSON object with the latency histograms of the sampled runs, per op type and per
+    * node, the allocator usage and the number of tasks queued in the thread pools.
+    * @return OK if metrics are enabled for this session.
+    */
+  common::Status GetMetrics(std::string& metrics_json) const;
+
   /**
    * Search registered execution providers for an allocator that has characteristics
    * specified within mem_info
@@ -533,6 +594,24 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::basic_string<ORTCHAR_T>& filepath) const;
+
+  // Session cache support. See kOrtSessionOptionsConfigSessionCacheDir.
+  bool IsSessionCacheEnabled() const;
+
+  // Hashes the model bytes, or the file at model_location_ if `model_data` is null, and any external data files
+  // the model refers to into session_cache_model_hash_. Called once the model has been loaded.
+  // The cache is not used for the session if this fails.
+  void UpdateSessionCacheModelHash(const void* model_data, size_t model_data_len);
+
+  // Returns the cache key for the current model, execution providers and session options, or an empty string if
+  // the session can not use the cache.
+  std::string GetSessionCacheKey() const;
+
+  // Replaces model_ with the cached ORT format model for `cache_key` if there is a valid one.
+  // `loaded` is set to false if the model was not replaced.
+  common::Status LoadFromSessionCache(const std::string& cache_key, bool& loaded) ORT_MUST_USE_RESULT;
+
+  common::Status SaveToSessionCache(const std::string& cache_key) const ORT_MUST_USE_RESULT;
 #endif
 
   /**
@@ -557,6 +636,12 @@ class InferenceSession {
 
   common::Status LoadOrtModel(std::function<Status()> load_ort_format_model_bytes) ORT_MUST_USE_RESULT;
 
+  // Whether the initializers of an ORT format model refer to ort_format_model_bytes_ in place.
+  bool UseOrtModelBytesForInitializers() const;
+
+  // Verifies ort_format_model_bytes_ and creates the Model from them.
+  common::Status CreateModelFromOrtFormatBytes(std::unique_ptr<Model>& model) ORT_MUST_USE_RESULT;
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -565,6 +650,35 @@ class InferenceSession {
   const logging::Logger& CreateLoggerForRun(const RunOptions& run_options,
                                             std::unique_ptr<logging::Logger>& new_run_logger);
 
+  // Runs the model. If capture_graph is true and graph capture is enabled, a graph that isn't captured yet is
+  // captured by running the model a second time. bound_feeds_fetches_manager is the feeds and fetches manager of an
+  // IOBinding, whose names and values were already validated. If it is nullptr, they are validated and a feeds and
+  // fetches manager is created for the run.
+  common::Status RunImpl(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                         const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                         std::vector<OrtValue>* p_fetches, const std::vector<OrtDevice>* p_fetches_device_info,
+                         bool capture_graph, FeedsFetchesManager* bound_feeds_fetches_manager = nullptr);
+
+  // Decides whether RunBatch concatenates the feeds of its requests. See kOrtSessionOptionsConfigEnableBatchStacking.
+  void InitBatchStacking();
+
+  // Returns true if RunBatch can concatenate the feeds of the requests along their batch dimension.
+  bool CanStackFeeds(const std::vector<std::string>& feed_names, const std::vector<std::vector<OrtValue>>& feeds,
+                     const std::vector<std::vector<OrtValue>>& fetches) const;
+
+  // Runs the model once for the feeds of all the requests of RunBatch, concatenated along their batch dimension, and
+  // splits its outputs. Sets split to false and leaves fetches as is if the outputs don't have the batch dimension.
+  common::Status RunStackedFeeds(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                 const std::vector<std::vector<OrtValue>>& feeds,
+                                 const std::vector<std::string>& output_names,
+                                 std::vector<std::vector<OrtValue>>& fetches, bool& split);
+
+  // Runs the model with the graph captured for the shapes of the feeds, capturing it on the first run with those
+  // shapes. See kOrtSessionOptionsConfigGraphCaptureShapeCacheSize.
+  common::Status RunWithGraphCache(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                   const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                                   std::vector<OrtValue>* p_fetches, const std::vector<OrtDevice>* p_fetches_device_info);
+
   void InitLogger(logging::LoggingManager* logging_manager);
 
   common::Status CheckShapes(const std::string& input_name, const TensorShape& input_shape,
@@ -632,6 +746,9 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Metrics of the runs of this session. nullptr unless enabled in the session options.
+  std::unique_ptr<SessionMetrics> session_metrics_;
+
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
   std::unique_ptr<SessionState> session_state_;
@@ -649,6 +766,10 @@ class InferenceSession {
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
   onnxruntime::concurrency::ThreadPool* inter_op_thread_pool_from_env_{};
 
+  // Runs on the global intra-op thread pool within the session's quota. Set if the session has a quota, in which
+  // case intra_op_thread_pool_from_env_ points to it.
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> intra_op_thread_pool_quota_;
+
   // initialized from session options
   // Determines which threadpools will be intialized and used for the duration of this session.
   // If true, use the per session ones, or else the global threadpools.
@@ -727,19 +848,18 @@ class InferenceSession {
   // specifies that ORT should use the model bytes directly by setting the session config option
   // "session.use_ort_model_bytes_directly" to "1"
   //   We use the the byte array directly without copy to reduce peak memory usage
-  //   (Short term) This will require the user to guarantee the life time of the model data
-  //   until the session is created.
-  //   (Longer term) If we are going to use the memory offsets directly for initializers, the model data
-  //   should be alive until the InferenceSession goes away.
+  //   This will require the user to guarantee the life time of the model data until the session is created,
+  //   or until the session goes away if "session.use_ort_model_bytes_for_initializers" is also set to "1".
   // If the session is started with an input byte array contains model data, and the caller does not
   // specify ORT should use the model bytes directly
   // Or the session is started with a model_uri
   //   We store them currently in the ort_format_model_bytes_data_holder_ to make the Load + Initialize
   //   behave the same way as for an ONNX model, as we need some of the bytes for the Load (create the Model)
   //   and some for the Initialize (create SessionState).
-  // Short term we free them after Initialize.
-  // Longer term we may want to directly refer to offsets in this buffer for initializers so we don't need to copy
-  // those into new OrtValue instances, at which point we won't free them until the InferenceSession goes away.
+  // If "session.use_ort_model_bytes_for_initializers" is set to "1", a model_uri is mapped into
+  //   ort_format_model_mapped_bytes_ instead.
+  // We free them after Initialize, unless "session.use_ort_model_bytes_for_initializers" is set to "1", in which
+  // case the initializers refer to offsets in this buffer and it is kept until the InferenceSession goes away.
   gsl::span<const uint8_t> ort_format_model_bytes_;
 
   // This holds the actual model data
@@ -748,6 +868,21 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // Mapping of the ORT format model file if "session.use_ort_model_bytes_for_initializers" is set to "1".
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Hash of the ONNX model and its external data, set by Load if the session cache is enabled.
+  std::string session_cache_model_hash_;
+
+  // Set if RegisterGraphTransformer was called. The output of custom transformers is not cached.
+  bool has_custom_graph_transformers_ = false;
+
+  // Mapping of the cached ORT format model that ort_format_model_bytes_ points into on a cache hit.
+  // Freed together with the bytes at the end of Initialize.
+  Env::MappedMemoryPtr session_cache_mapped_model_;
+#endif
+
   std::shared_ptr<onnxruntime::AllocatorManager> allocator_manager_;
 
   // Container to store pre-packed weights to share between sessions.
@@ -784,6 +919,16 @@ class InferenceSession {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Cached EP instance for graph replay is not set yet before calling ReplayGraph()");
     }
 
+    void SetGraphAnnotationId(int graph_annotation_id) {
+      if (cached_execution_provider_for_graph_replay_) {
+        cached_execution_provider_for_graph_replay_->SetGraphAnnotationId(graph_annotation_id);
+      }
+    }
+
+    AllocatorPtr GetAllocator() const {
+      return cached_execution_provider_for_graph_replay_->GetAllocator(0, OrtMemTypeDefault);
+    }
+
     const std::string& Type() const {
       return cached_execution_provider_for_graph_replay_->Type();
     }
@@ -792,6 +937,34 @@ class InferenceSession {
   };
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
+
+  // A graph captured for one set of feed shapes. The graph reads from and writes to the addresses it was captured
+  // with, so the feeds are copied into staging buffers before a replay and the outputs are copied out after it.
+  struct CachedGraph {
+    int graph_annotation_id;
+    std::vector<OrtValue> staged_feeds;
+    std::vector<OrtValue> staged_fetches;
+  };
+
+  // Maximum number of feed shapes with a captured graph, 0 if graphs are not cached per feed shapes.
+  size_t graph_capture_shape_cache_size_ = 0;
+  // Captured graphs by the names, types and shapes of the feeds and the names of the fetches.
+  std::unordered_map<std::string, CachedGraph> graph_cache_;
+  // graph annotation id 0 is the graph of the runs without the cache
+  int next_graph_annotation_id_ = 1;
+  // The staging buffers are shared by the runs, and capturing a graph doesn't allow other work on the device.
+  OrtMutex graph_cache_mutex_;
+
+  // The symbolic leading dimension of the inputs and outputs of the model that RunBatch concatenates the feeds of its
+  // requests along, if stack_batch_feeds_ is set. Stacking is turned off for good if the outputs turn out not to
+  // have that dimension.
+  std::string batch_dim_param_;
+  std::atomic<bool> stack_batch_feeds_{false};
+
+  // Number of RunAsync calls whose callback has not returned yet. The destructor waits for them to complete.
+  size_t num_async_runs_ = 0;
+  OrtMutex async_runs_mutex_;
+  OrtCondVar async_runs_cv_;
 };
 
 struct SessionIOBinding {
@@ -10,6 +10,9 @@
 #include "core/framework/execution_provider.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/utils.h"
+#ifdef ENABLE_DLPACK
+#include "core/dlpack/dlpack_converter.h"
+#endif
 #include <cassert>
 #include <cstring>
 #include <functional>
@@ -221,6 +224,43 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorAsOrtValue, _Inout_ OrtAllocator* alloc
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateTensorFromDLPack, _Inout_ struct DLManagedTensor* dlpack_tensor,
+                    int is_bool_tensor, _Outptr_ OrtValue** out) {
+  API_IMPL_BEGIN
+#ifdef ENABLE_DLPACK
+  if (dlpack_tensor == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "dlpack_tensor is nullptr");
+  }
+  auto value = std::make_unique<OrtValue>(dlpack::DlpackToOrtValue(dlpack_tensor, is_bool_tensor != 0));
+  *out = value.release();
+  return nullptr;
+#else
+  ORT_UNUSED_PARAMETER(dlpack_tensor);
+  ORT_UNUSED_PARAMETER(is_bool_tensor);
+  ORT_UNUSED_PARAMETER(out);
+  return OrtApis::CreateStatus(ORT_FAIL, "DLPack is not supported in this build.");
+#endif
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::GetDLPackFromValue, _In_ const OrtValue* value, _Outptr_ struct DLManagedTensor** out) {
+  API_IMPL_BEGIN
+#ifdef ENABLE_DLPACK
+  if (!value->IsTensor()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "DLPack only supports tensors");
+  }
+  // the DLPack tensor holds a copy of the OrtValue, which keeps the data alive until its deleter is called
+  OrtValue shared_value = *value;
+  *out = dlpack::OrtValueToDlpack(shared_value);
+  return nullptr;
+#else
+  ORT_UNUSED_PARAMETER(value);
+  ORT_UNUSED_PARAMETER(out);
+  return OrtApis::CreateStatus(ORT_FAIL, "DLPack is not supported in this build.");
+#endif
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::CreateSparseTensorAsOrtValue, _Inout_ OrtAllocator* allocator, _In_ const int64_t* dense_shape,
                     size_t dense_shape_len, ONNXTensorElementDataType type, _Outptr_ OrtValue** out) {
   API_IMPL_BEGIN
@@ -742,17 +782,17 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
   API_IMPL_END
 }
 
-ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
-                    _In_reads_(input_len) const char* const* input_names,
-                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
-                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
-                    _Inout_updates_all_(output_names_len) OrtValue** output) {
-  API_IMPL_BEGIN
-  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+// Converts the arguments of OrtApi::Run and OrtApi::RunAsync to the arguments of InferenceSession::Run.
+static OrtStatus* GetFeedsAndFetches(_In_reads_(input_len) const char* const* input_names,
+                                     _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                                     _In_reads_(output_names_len) const char* const* output_names1,
+                                     size_t output_names_len, _In_reads_(output_names_len) OrtValue* const* output,
+                                     std::vector<std::string>& feed_names, std::vector<OrtValue>& feeds,
+                                     std::vector<std::string>& output_names, std::vector<OrtValue>& fetches) {
   constexpr int queue_id = 0;
 
-  std::vector<std::string> feed_names(input_len);
-  std::vector<OrtValue> feeds(input_len);
+  feed_names.resize(input_len);
+  feeds.resize(input_len);
 
   for (size_t i = 0; i != input_len; ++i) {
     if (input_names[i] == nullptr || input_names[i][0] == '\0') {
@@ -766,7 +806,7 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   }
 
   // Create output feed
-  std::vector<std::string> output_names(output_names_len);
+  output_names.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
       return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
@@ -774,7 +814,7 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
     output_names[i] = output_names1[i];
   }
 
-  std::vector<OrtValue> fetches(output_names_len);
+  fetches.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output[i] != nullptr) {
       ::OrtValue& value = *(output[i]);
@@ -783,6 +823,39 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
       fetches[i] = value;
     }
   }
+  return nullptr;
+}
+
+// Stores the fetches of a successful run in the output array of OrtApi::Run and OrtApi::RunAsync.
+static void SetOutputs(std::vector<OrtValue>& fetches, OrtValue** output) {
+  constexpr int queue_id = 0;
+  for (size_t i = 0; i != fetches.size(); ++i) {
+    ::OrtValue& value = fetches[i];
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    if (output[i] == nullptr) {
+      output[i] = new OrtValue(value);
+    }
+  }
+}
+
+ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  if (auto* status = GetFeedsAndFetches(input_names, input, input_len, output_names1, output_names_len, output,
+                                        feed_names, feeds, output_names, fetches)) {
+    return status;
+  }
+
   Status status;
   if (run_options == nullptr) {
     OrtRunOptions op;
@@ -793,18 +866,125 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
 
   if (!status.IsOK())
     return ToOrtStatus(status);
-  for (size_t i = 0; i != output_names_len; ++i) {
-    ::OrtValue& value = fetches[i];
-    if (value.Fence())
-      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
-    if (output[i] == nullptr) {
-      output[i] = new OrtValue(value);
+  SetOutputs(fetches, output);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len* num_requests) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    size_t num_requests, _Inout_updates_all_(output_names_len* num_requests) OrtValue** outputs) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<std::vector<OrtValue>> feeds(num_requests);
+  std::vector<std::string> output_names;
+  std::vector<std::vector<OrtValue>> fetches(num_requests);
+  for (size_t r = 0; r < num_requests; ++r) {
+    if (auto* status = GetFeedsAndFetches(input_names, inputs + r * input_len, input_len, output_names1,
+                                          output_names_len, outputs + r * output_names_len, feed_names, feeds[r],
+                                          output_names, fetches[r])) {
+      return status;
     }
   }
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->RunBatch(op, feed_names, feeds, output_names, fetches);
+  } else {
+    status = session->RunBatch(*run_options, feed_names, feeds, output_names, fetches);
+  }
+
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  for (size_t r = 0; r < num_requests; ++r) {
+    SetOutputs(fetches[r], outputs + r * output_names_len);
+  }
   return nullptr;
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionWarmUp, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const int64_t* const* input_shapes,
+                    _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::unordered_map<std::string, TensorShape> shapes;
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    if (input_shapes[i] == nullptr && input_shape_lens[i] != 0) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input shape cannot be null");
+    }
+    shapes.emplace(input_names[i], TensorShape(input_shapes[i], input_shape_lens[i]));
+  }
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->WarmUp(op, {shapes});
+  } else {
+    status = session->WarmUp(*run_options, {shapes});
+  }
+
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (run_async_callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "run_async_callback cannot be null");
+  }
+
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  if (auto* status = GetFeedsAndFetches(input_names, input, input_len, output_names1, output_names_len, output,
+                                        feed_names, feeds, output_names, fetches)) {
+    return status;
+  }
+
+  auto callback = [output, output_names_len, run_async_callback, user_data](std::vector<OrtValue>& run_fetches,
+                                                                            const Status& run_status) {
+    OrtStatus* ort_status = nullptr;
+    if (run_status.IsOK()) {
+      ORT_TRY {
+        SetOutputs(run_fetches, output);
+      }
+      ORT_CATCH(const std::exception& e) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          ort_status = OrtApis::CreateStatus(ORT_RUNTIME_EXCEPTION, e.what());
+        });
+      }
+    } else {
+      ort_status = ToOrtStatus(run_status);
+    }
+
+    run_async_callback(user_data, output, output_names_len, ort_status);
+    OrtApis::ReleaseStatus(ort_status);
+  };
+
+  return ToOrtStatus(session->RunAsync(run_options, std::move(feed_names), std::move(feeds), std::move(output_names),
+                                       std::move(fetches), std::move(callback)));
+  API_IMPL_END
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -1286,6 +1466,29 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionDumpProfiling, _In_ OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto profile_file_name = session->DumpProfiling();
+  *out = StrDup(profile_file_name, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMetrics, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string metrics_json;
+  auto status = session->GetMetrics(metrics_json);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = StrDup(metrics_json, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2118,6 +2321,18 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->max_dead_bytes_per_chunk = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "initial_growth_chunk_size_bytes") == 0) {
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "small_alloc_cache_strategy") == 0) {
+      cfg->small_alloc_cache_strategy = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "small_alloc_cache_bytes") == 0) {
+      cfg->small_alloc_cache_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "numa_node") == 0) {
+      cfg->numa_node = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "idle_shrink_ms") == 0) {
+      cfg->idle_shrink_ms = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "shrink_high_water_bytes") == 0) {
+      cfg->shrink_high_water_bytes = arena_config_values[i];
+    } else if (strcmp(arena_config_keys[i], "use_huge_pages") == 0) {
+      cfg->use_huge_pages = static_cast<int>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2521,6 +2736,18 @@ static constexpr OrtApi ort_api_1_to_12 = {
     &OrtApis::ReleaseCUDAProviderOptions,
     &OrtApis::SessionOptionsAppendExecutionProvider_MIGraphX,
     // End of Version 11 - DO NOT MODIFY ABOVE (see above text for more information)
+
+    &OrtApis::SetGlobalLockFreeQueues,
+    &OrtApis::SetGlobalNumaAware,
+    &OrtApis::SessionGetMetrics,
+    &OrtApis::RunAsync,
+    &OrtApis::CreateTensorFromDLPack,
+    &OrtApis::GetDLPackFromValue,
+    &OrtApis::SetGlobalAdaptiveSpinning,
+    &OrtApis::SessionDumpProfiling,
+    &OrtApis::RunBatch,
+    &OrtApis::KernelContext_ParallelFor,
+    &OrtApis::SessionWarmUp,
 };
 
 // Asserts to do a some checks to ensure older Versions of the OrtApi never change (will detect an addition or deletion but not if they cancel out each other)
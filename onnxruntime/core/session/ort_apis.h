@@ -339,4 +339,32 @@ ORT_API_STATUS_IMPL(UpdateCUDAProviderOptions, _Inout_ OrtCUDAProviderOptionsV2*
                     size_t num_keys);
 ORT_API_STATUS_IMPL(GetCUDAProviderOptionsAsString, _In_ const OrtCUDAProviderOptionsV2* cuda_options, _Inout_ OrtAllocator* allocator, _Outptr_ char** ptr);
 ORT_API(void, ReleaseCUDAProviderOptions, _Frees_ptr_opt_ OrtCUDAProviderOptionsV2*);
+
+ORT_API_STATUS_IMPL(SetGlobalLockFreeQueues, _Inout_ OrtThreadingOptions* tp_options, int use_lock_free_queues);
+ORT_API_STATUS_IMPL(SetGlobalNumaAware, _Inout_ OrtThreadingOptions* tp_options, int numa_aware);
+ORT_API_STATUS_IMPL(SessionGetMetrics, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(CreateTensorFromDLPack, _Inout_ struct DLManagedTensor* dlpack_tensor, int is_bool_tensor,
+                    _Outptr_ OrtValue** out);
+ORT_API_STATUS_IMPL(GetDLPackFromValue, _In_ const OrtValue* value, _Outptr_ struct DLManagedTensor** out);
+ORT_API_STATUS_IMPL(SetGlobalAdaptiveSpinning, _Inout_ OrtThreadingOptions* tp_options, int adaptive_spinning);
+ORT_API_STATUS_IMPL(SessionDumpProfiling, _In_ OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len* num_requests) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    size_t num_requests, _Inout_updates_all_(output_names_len* num_requests) OrtValue** outputs);
+ORT_API_STATUS_IMPL(KernelContext_ParallelFor, _In_ const OrtKernelContext* context, _In_ OrtParallelForFn fn,
+                    size_t total, size_t num_batches, _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(SessionWarmUp, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const int64_t* const* input_shapes,
+                    _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len);
 }  // namespace OrtApis
@@ -10,12 +10,18 @@
 #include "core/session/environment.h"
 #include "core/session/allocator_adapters.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
+#include "core/platform/env.h"
 #include "core/framework/provider_shutdown.h"
 #include "core/platform/logging/make_platform_default_log_sink.h"
 
 using namespace onnxruntime;
 using namespace onnxruntime::logging;
 
+// Set to "1" to send the log messages to the sink of the environment (the platform default sink or the user's
+// logging function) from a background thread, so that the threads logging don't wait for the output.
+static constexpr const char* kOrtAsyncLoggingEnvVar = "ORT_ASYNC_LOGGING";
+
 std::unique_ptr<OrtEnv> OrtEnv::p_instance_;
 int OrtEnv::ref_count_ = 0;
 onnxruntime::OrtMutex OrtEnv::m_;
@@ -49,23 +55,22 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
   if (!p_instance_) {
     std::unique_ptr<LoggingManager> lmgr;
     std::string name = lm_info.logid;
+    std::unique_ptr<ISink> sink;
     if (lm_info.logging_function) {
-      std::unique_ptr<ISink> logger = std::make_unique<LoggingWrapper>(lm_info.logging_function,
-                                                                       lm_info.logger_param);
-      lmgr = std::make_unique<LoggingManager>(std::move(logger),
-                                              static_cast<Severity>(lm_info.default_warning_level),
-                                              false,
-                                              LoggingManager::InstanceType::Default,
-                                              &name);
+      sink = std::make_unique<LoggingWrapper>(lm_info.logging_function, lm_info.logger_param);
     } else {
-      auto sink = MakePlatformDefaultLogSink();
+      sink = MakePlatformDefaultLogSink();
+    }
 
-      lmgr = std::make_unique<LoggingManager>(std::move(sink),
-                                              static_cast<Severity>(lm_info.default_warning_level),
-                                              false,
-                                              LoggingManager::InstanceType::Default,
-                                              &name);
+    if (onnxruntime::Env::Default().GetEnvironmentVar(kOrtAsyncLoggingEnvVar) == "1") {
+      sink = std::make_unique<AsyncSink>(std::move(sink));
     }
+
+    lmgr = std::make_unique<LoggingManager>(std::move(sink),
+                                            static_cast<Severity>(lm_info.default_warning_level),
+                                            false,
+                                            LoggingManager::InstanceType::Default,
+                                            &name);
     std::unique_ptr<onnxruntime::Environment> env;
     if (!tp_options) {
       status = onnxruntime::Environment::Create(std::move(lmgr), env);
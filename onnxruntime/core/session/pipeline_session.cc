@@ -0,0 +1,479 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/pipeline_session.h"
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/environment.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Gives access to InferenceSession::Load(std::unique_ptr<ModelProto>) so that the model of a stage does not need
+// to be serialized.
+class PipelineStageSession final : public InferenceSession {
+ public:
+  using InferenceSession::InferenceSession;
+  using InferenceSession::Load;
+};
+
+template <typename TFunc>
+void ForEachInput(const Node& node, TFunc&& func) {
+  for (const auto* input_defs : {&node.InputDefs(), &node.ImplicitInputDefs()}) {
+    for (const NodeArg* input : *input_defs) {
+      if (input->Exists()) {
+        func(*input);
+      }
+    }
+  }
+}
+
+// Returns a view of the rows [start, start + count) of the first dimension of `tensor`.
+OrtValue SliceBatch(const Tensor& tensor, int64_t start, int64_t count) {
+  TensorShapeVector dims = tensor.Shape().AsShapeVector();
+  const size_t row_bytes = dims[0] == 0 ? 0 : tensor.SizeInBytes() / static_cast<size_t>(dims[0]);
+  dims[0] = count;
+
+  OrtValue value;
+  Tensor::InitOrtValue(tensor.DataType(), TensorShape(dims), const_cast<void*>(tensor.DataRaw()),
+                       tensor.Location(), value, static_cast<ptrdiff_t>(static_cast<size_t>(start) * row_bytes));
+  return value;
+}
+
+// Concatenates the output `name` of the micro-batches along its first dimension.
+Status ConcatMicroBatches(const std::vector<NameMLValMap>& results, const std::string& name, OrtValue& output) {
+  std::vector<const Tensor*> parts;
+  parts.reserve(results.size());
+  int64_t batch_size = 0;
+  for (const auto& values : results) {
+    auto it = values.find(name);
+    ORT_RETURN_IF(it == values.end(), "Output ", name, " was not produced by the pipeline.");
+    ORT_RETURN_IF_NOT(it->second.IsTensor(), "Output ", name,
+                      " must be a tensor to be concatenated over the micro-batches.");
+    const Tensor& part = it->second.Get<Tensor>();
+    ORT_RETURN_IF_NOT(part.Location().device.Type() == OrtDevice::CPU, "Output ", name, " is not on CPU.");
+    ORT_RETURN_IF(part.Shape().NumDimensions() == 0, "Output ", name, " has no batch dimension.");
+    if (!parts.empty()) {
+      ORT_RETURN_IF_NOT(part.DataType() == parts[0]->DataType() &&
+                            part.Shape().Slice(1) == parts[0]->Shape().Slice(1),
+                        "Output ", name, " has a different type or shape in different micro-batches: ",
+                        parts[0]->Shape(), " vs ", part.Shape());
+    }
+    batch_size += part.Shape()[0];
+    parts.push_back(&part);
+  }
+
+  TensorShapeVector dims = parts[0]->Shape().AsShapeVector();
+  dims[0] = batch_size;
+  Tensor::InitOrtValue(parts[0]->DataType(), TensorShape(dims), std::make_shared<CPUAllocator>(), output);
+  Tensor& concatenated = *output.GetMutable<Tensor>();
+
+  if (concatenated.IsDataTypeString()) {
+    std::string* dst = concatenated.MutableData<std::string>();
+    for (const Tensor* part : parts) {
+      const auto size = gsl::narrow<size_t>(part->Shape().Size());
+      std::copy(part->Data<std::string>(), part->Data<std::string>() + size, dst);
+      dst += size;
+    }
+  } else {
+    auto* dst = static_cast<uint8_t*>(concatenated.MutableDataRaw());
+    for (const Tensor* part : parts) {
+      memcpy(dst, part->DataRaw(), part->SizeInBytes());
+      dst += part->SizeInBytes();
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+struct PipelineSession::Stage {
+  std::unique_ptr<InferenceSession> session;
+  std::vector<std::string> input_names;
+  std::vector<std::string> output_names;
+  // values of the micro-batch that are not needed anymore once the stage ran
+  std::vector<std::string> released_names;
+};
+
+struct PipelineSession::MicroBatch {
+  RunState* run;
+  size_t index;
+  // the feeds and the values produced by the previous stages
+  NameMLValMap values;
+};
+
+// Bounded FIFO queue of micro-batches. A null micro-batch is returned once the queue is closed and empty.
+class PipelineSession::MicroBatchQueue {
+ public:
+  explicit MicroBatchQueue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+  void Push(std::unique_ptr<MicroBatch> micro_batch) {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    not_full_.wait(lock, [this]() { return items_.size() < capacity_; });
+    items_.push(std::move(micro_batch));
+    not_empty_.notify_one();
+  }
+
+  std::unique_ptr<MicroBatch> Pop() {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    not_empty_.wait(lock, [this]() { return !items_.empty() || closed_; });
+    if (items_.empty()) {
+      return nullptr;
+    }
+
+    auto micro_batch = std::move(items_.front());
+    items_.pop();
+    not_full_.notify_one();
+    return micro_batch;
+  }
+
+  void Close() {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+  }
+
+ private:
+  const size_t capacity_;
+  std::queue<std::unique_ptr<MicroBatch>> items_;
+  bool closed_{false};
+  OrtMutex mutex_;
+  OrtCondVar not_full_;
+  OrtCondVar not_empty_;
+};
+
+// State of a Run call, shared by its micro-batches.
+struct PipelineSession::RunState {
+  RunState(const RunOptions& options, size_t num_micro_batches)
+      : run_options(options), results(num_micro_batches), remaining(num_micro_batches) {}
+
+  bool Failed() {
+    std::lock_guard<OrtMutex> lock(mutex);
+    return !status.IsOK();
+  }
+
+  void Fail(const Status& error) {
+    std::lock_guard<OrtMutex> lock(mutex);
+    if (status.IsOK()) {
+      status = error;
+    }
+  }
+
+  void Complete(std::unique_ptr<MicroBatch> micro_batch) {
+    std::lock_guard<OrtMutex> lock(mutex);
+    results[micro_batch->index] = std::move(micro_batch->values);
+    if (--remaining == 0) {
+      done.notify_all();
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<OrtMutex> lock(mutex);
+    done.wait(lock, [this]() { return remaining == 0; });
+  }
+
+  const RunOptions& run_options;
+  std::vector<NameMLValMap> results;
+  size_t remaining;
+  Status status;
+  OrtMutex mutex;
+  OrtCondVar done;
+};
+
+PipelineSession::PipelineSession(const PipelineSessionOptions& options)
+    : micro_batch_size_(options.micro_batch_size) {
+}
+
+Status PipelineSession::Create(const Environment& env, const PathString& model_uri, PipelineSessionOptions options,
+                               std::unique_ptr<PipelineSession>& session) {
+  const size_t num_stages = options.stages.size();
+  ORT_RETURN_IF(num_stages == 0, "A pipeline session needs at least one stage.");
+  ORT_RETURN_IF_NOT(options.stages.back().cut_values.empty(), "The last pipeline stage cannot have cut values.");
+  ORT_RETURN_IF(options.micro_batch_size < 0, "Invalid micro-batch size: ", options.micro_batch_size);
+
+  const auto& logger = env.GetLoggingManager()->DefaultLogger();
+  std::shared_ptr<Model> model;
+  ORT_RETURN_IF_ERROR(Model::Load(model_uri, model, nullptr, logger));
+  const Graph& graph = model->MainGraph();
+
+  // Assign each node to the first stage that needs it to compute its cut values.
+  std::vector<int> node_stages(graph.MaxNodeIndex(), -1);
+  for (size_t s = 0; s < num_stages; ++s) {
+    size_t num_nodes = 0;
+    if (s + 1 < num_stages) {
+      std::vector<const Node*> to_visit;
+      for (const auto& name : options.stages[s].cut_values) {
+        const Node* producer = graph.GetProducerNode(name);
+        ORT_RETURN_IF(producer == nullptr, "Cut value ", name, " of pipeline stage ", s, " is not produced by a node.");
+        to_visit.push_back(producer);
+      }
+
+      while (!to_visit.empty()) {
+        const Node* node = to_visit.back();
+        to_visit.pop_back();
+        if (node_stages[node->Index()] != -1) {
+          continue;
+        }
+
+        node_stages[node->Index()] = static_cast<int>(s);
+        ++num_nodes;
+        ForEachInput(*node, [&](const NodeArg& input) {
+          const Node* producer = graph.GetProducerNode(input.Name());
+          if (producer != nullptr && node_stages[producer->Index()] == -1) {
+            to_visit.push_back(producer);
+          }
+        });
+      }
+    } else {
+      for (const auto& node : graph.Nodes()) {
+        if (node_stages[node.Index()] == -1) {
+          node_stages[node.Index()] = static_cast<int>(s);
+          ++num_nodes;
+        }
+      }
+    }
+
+    ORT_RETURN_IF(num_nodes == 0, "Pipeline stage ", s, " has no nodes.");
+  }
+
+  // The last stage that consumes each value, so that the micro-batches only carry the values still needed.
+  std::unordered_map<std::string, size_t> last_consumers;
+  for (const auto& node : graph.Nodes()) {
+    const auto stage = static_cast<size_t>(node_stages[node.Index()]);
+    ForEachInput(node, [&](const NodeArg& input) {
+      auto& last_consumer = last_consumers[input.Name()];
+      last_consumer = std::max(last_consumer, stage);
+    });
+  }
+
+  session.reset(new PipelineSession(options));
+  for (const NodeArg* output : graph.GetOutputs()) {
+    ORT_RETURN_IF(graph.GetProducerNode(output->Name()) == nullptr && !graph.IsInputsIncludingInitializers(output),
+                  "Graph output ", output->Name(), " is not produced by a node, which is not supported.");
+    session->model_output_names_.insert(output->Name());
+  }
+
+  ONNX_NAMESPACE::ModelProto model_template = model->ToProto();
+  model_template.clear_graph();
+  GraphViewer graph_viewer(graph);
+
+  for (size_t s = 0; s < num_stages; ++s) {
+    auto stage = std::make_unique<Stage>();
+    auto model_proto = std::make_unique<ONNX_NAMESPACE::ModelProto>(model_template);
+    auto& graph_proto = *model_proto->mutable_graph();
+    graph_proto.set_name(graph.Name() + "_stage_" + std::to_string(s));
+
+    std::unordered_set<std::string> produced;
+    std::unordered_set<std::string> consumed;
+    std::vector<std::string> consumed_in_order;
+    for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+      const Node& node = *graph.GetNode(node_index);
+      if (node_stages[node_index] != static_cast<int>(s)) {
+        continue;
+      }
+
+      node.ToProto(*graph_proto.add_node(), true);
+      ForEachInput(node, [&](const NodeArg& input) {
+        if (produced.count(input.Name()) == 0 && consumed.insert(input.Name()).second) {
+          consumed_in_order.push_back(input.Name());
+        }
+      });
+      for (const NodeArg* output : node.OutputDefs()) {
+        if (output->Exists()) {
+          produced.insert(output->Name());
+          if (session->model_output_names_.count(output->Name()) > 0 ||
+              (last_consumers.count(output->Name()) > 0 && last_consumers[output->Name()] > s)) {
+            stage->output_names.push_back(output->Name());
+            *graph_proto.add_output() = output->ToProto();
+          }
+        }
+      }
+    }
+
+    for (const auto& name : consumed_in_order) {
+      const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+      const bool is_initializer = graph.GetInitializedTensor(name, initializer);
+      if (is_initializer) {
+        auto& stage_initializer = *graph_proto.add_initializer();
+        if (utils::HasExternalData(*initializer)) {
+          // the stage is loaded from memory, so the data cannot stay relative to the model path
+          std::vector<uint8_t> data;
+          ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(*initializer, graph.ModelPath(), data));
+          stage_initializer.set_name(initializer->name());
+          stage_initializer.set_data_type(initializer->data_type());
+          *stage_initializer.mutable_dims() = initializer->dims();
+          stage_initializer.set_raw_data(data.data(), data.size());
+        } else {
+          stage_initializer = *initializer;
+        }
+      }
+
+      if (!is_initializer || graph.GetConstantInitializer(name, false) == nullptr) {
+        stage->input_names.push_back(name);
+        *graph_proto.add_input() = graph.GetNodeArg(name)->ToProto();
+      }
+
+      if (last_consumers[name] == s && session->model_output_names_.count(name) == 0) {
+        stage->released_names.push_back(name);
+      }
+    }
+
+    LOGS(logger, INFO) << "Pipeline stage " << s << ": " << graph_proto.node_size() << " nodes, "
+                       << stage->input_names.size() << " inputs, " << stage->output_names.size() << " outputs";
+
+    auto stage_session = std::make_unique<PipelineStageSession>(options.stages[s].session_options, env);
+    for (const auto& provider : options.stages[s].execution_providers) {
+      ORT_RETURN_IF_ERROR(stage_session->RegisterExecutionProvider(provider));
+    }
+    ORT_RETURN_IF_ERROR(stage_session->Load(std::move(model_proto)));
+    ORT_RETURN_IF_ERROR(stage_session->Initialize());
+    stage->session = std::move(stage_session);
+
+    session->stages_.push_back(std::move(stage));
+    session->queues_.push_back(std::make_unique<MicroBatchQueue>(options.queue_capacity));
+  }
+
+  for (size_t s = 0; s < num_stages; ++s) {
+    session->threads_.emplace_back(&PipelineSession::StageLoop, session.get(), s);
+  }
+
+  return Status::OK();
+}
+
+PipelineSession::~PipelineSession() {
+  for (auto& queue : queues_) {
+    queue->Close();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+const std::vector<std::string>& PipelineSession::GetStageInputNames(size_t stage) const {
+  return stages_.at(stage)->input_names;
+}
+
+const std::vector<std::string>& PipelineSession::GetStageOutputNames(size_t stage) const {
+  return stages_.at(stage)->output_names;
+}
+
+void PipelineSession::StageLoop(size_t stage_index) {
+  Stage& stage = *stages_[stage_index];
+  const bool is_last = stage_index + 1 == stages_.size();
+
+  while (auto micro_batch = queues_[stage_index]->Pop()) {
+    // the micro-batches of a failed run still flow to the end so that the run completes
+    if (!micro_batch->run->Failed()) {
+      RunStage(stage, *micro_batch);
+    }
+
+    if (is_last) {
+      RunState* run = micro_batch->run;
+      run->Complete(std::move(micro_batch));
+    } else {
+      queues_[stage_index + 1]->Push(std::move(micro_batch));
+    }
+  }
+}
+
+void PipelineSession::RunStage(Stage& stage, MicroBatch& micro_batch) {
+  NameMLValMap feeds;
+  for (const auto& name : stage.input_names) {
+    auto it = micro_batch.values.find(name);
+    if (it != micro_batch.values.end()) {
+      feeds.insert(*it);
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  Status status = stage.session->Run(micro_batch.run->run_options, feeds, stage.output_names, &fetches);
+  if (!status.IsOK()) {
+    micro_batch.run->Fail(status);
+    return;
+  }
+
+  for (size_t i = 0; i < stage.output_names.size(); ++i) {
+    micro_batch.values[stage.output_names[i]] = std::move(fetches[i]);
+  }
+  for (const auto& name : stage.released_names) {
+    micro_batch.values.erase(name);
+  }
+}
+
+Status PipelineSession::Run(const RunOptions& run_options, const NameMLValMap& feeds,
+                            const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches) {
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+  for (const auto& name : output_names) {
+    ORT_RETURN_IF(model_output_names_.count(name) == 0, "Invalid output name: ", name);
+  }
+
+  int64_t batch_size = 0;
+  size_t num_micro_batches = 1;
+  if (micro_batch_size_ > 0 && !feeds.empty()) {
+    batch_size = -1;
+    for (const auto& feed : feeds) {
+      ORT_RETURN_IF_NOT(feed.second.IsTensor() && feed.second.Get<Tensor>().Shape().NumDimensions() > 0,
+                        "Input ", feed.first, " must be a tensor with a batch dimension to be micro-batched.");
+      const int64_t feed_batch_size = feed.second.Get<Tensor>().Shape()[0];
+      ORT_RETURN_IF(batch_size != -1 && feed_batch_size != batch_size,
+                    "The inputs have different batch sizes: ", batch_size, " vs ", feed_batch_size);
+      batch_size = feed_batch_size;
+    }
+    num_micro_batches = std::max<size_t>(1, gsl::narrow<size_t>((batch_size + micro_batch_size_ - 1) /
+                                                                 micro_batch_size_));
+  }
+
+  RunState run(run_options, num_micro_batches);
+  for (size_t i = 0; i < num_micro_batches; ++i) {
+    auto micro_batch = std::make_unique<MicroBatch>();
+    micro_batch->run = &run;
+    micro_batch->index = i;
+    if (num_micro_batches == 1) {
+      micro_batch->values = feeds;
+    } else {
+      const int64_t start = static_cast<int64_t>(i) * micro_batch_size_;
+      const int64_t count = std::min(micro_batch_size_, batch_size - start);
+      for (const auto& feed : feeds) {
+        micro_batch->values.emplace(feed.first, SliceBatch(feed.second.Get<Tensor>(), start, count));
+      }
+    }
+
+    // blocks while the first stage is behind, which bounds the number of micro-batches in flight
+    queues_[0]->Push(std::move(micro_batch));
+  }
+
+  run.Wait();
+  ORT_RETURN_IF_ERROR(run.status);
+
+  auto& fetches = *p_fetches;
+  fetches.resize(output_names.size());
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    if (num_micro_batches == 1) {
+      auto it = run.results[0].find(output_names[i]);
+      ORT_RETURN_IF(it == run.results[0].end(), "Output ", output_names[i], " was not produced by the pipeline.");
+      fetches[i] = it->second;
+    } else {
+      ORT_RETURN_IF_ERROR(ConcatMicroBatches(run.results, output_names[i], fetches[i]));
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/execution_provider.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/run_options.h"
+#include "core/framework/session_options.h"
+
+namespace onnxruntime {
+
+class Environment;
+
+/**
+ * One stage of a pipeline-parallel session.
+ */
+struct PipelineStageOptions {
+  // Names of the values computed by this stage and its predecessors that are passed to the following stages.
+  // The stage contains every node that is needed to compute them and is not part of a previous stage.
+  // Must be empty for the last stage, which contains all the remaining nodes.
+  std::vector<std::string> cut_values;
+
+  SessionOptions session_options;
+
+  // Execution providers of the stage's session, in order of preference. The CPU EP is added if missing.
+  std::vector<std::shared_ptr<IExecutionProvider>> execution_providers;
+};
+
+struct PipelineSessionOptions {
+  std::vector<PipelineStageOptions> stages;
+
+  // Size of the micro-batches the inputs are split into along their first dimension. All the inputs and outputs
+  // must have the batch size as first dimension if set. 0 runs each request as a single micro-batch.
+  int64_t micro_batch_size = 0;
+
+  // Number of micro-batches that can wait in front of a stage before the previous stage blocks.
+  size_t queue_capacity = 2;
+};
+
+/**
+ * Runs a model as a pipeline of sessions, e.g. on different devices.
+ *
+ * The graph is cut into stages with PipelineSessionOptions::stages, each stage being a separate InferenceSession
+ * with its own execution providers. Every stage runs on its own thread and the stages are connected by bounded
+ * queues, so the inputs of a Run call, split into micro-batches, stream through the stages and keep all of them
+ * busy. Concurrent Run calls share the pipeline. The outputs of the micro-batches are concatenated on CPU.
+ */
+class PipelineSession {
+ public:
+  // Loads the model, cuts it into the stages of `options` and initializes the session of every stage.
+  static Status Create(const Environment& env, const PathString& model_uri, PipelineSessionOptions options,
+                       std::unique_ptr<PipelineSession>& session) ORT_MUST_USE_RESULT;
+
+  ~PipelineSession();
+
+  Status Run(const RunOptions& run_options, const NameMLValMap& feeds, const std::vector<std::string>& output_names,
+             std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
+
+  size_t NumStages() const noexcept { return stages_.size(); }
+
+  // Names of the values a stage consumes from the previous stages or the feeds, and of the values it produces for
+  // the following stages or the outputs.
+  const std::vector<std::string>& GetStageInputNames(size_t stage) const;
+  const std::vector<std::string>& GetStageOutputNames(size_t stage) const;
+
+ private:
+  struct Stage;
+  struct MicroBatch;
+  class MicroBatchQueue;
+  struct RunState;
+
+  explicit PipelineSession(const PipelineSessionOptions& options);
+
+  void StageLoop(size_t stage_index);
+  void RunStage(Stage& stage, MicroBatch& micro_batch);
+
+  const int64_t micro_batch_size_;
+  std::unordered_set<std::string> model_output_names_;
+  std::vector<std::unique_ptr<Stage>> stages_;
+  // queues_[i] holds the micro-batches waiting for stage i
+  std::vector<std::unique_ptr<MicroBatchQueue>> queues_;
+  std::vector<std::thread> threads_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PipelineSession);
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
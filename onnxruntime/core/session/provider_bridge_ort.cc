@@ -17,6 +17,7 @@
 #include "core/framework/TensorSeq.h"
 #include "core/framework/provider_options.h"
 #include "core/framework/fallback_cpu_capability.h"
+#include "core/framework/kernel_tuning.h"
 #include "core/framework/random_generator.h"
 #include "core/graph/model.h"
 #include "core/platform/env.h"
@@ -303,6 +304,12 @@ struct ProviderHostImpl : ProviderHost {
   bool CPUIDInfo__HasAVX2(const CPUIDInfo* p) override { return p->HasAVX2(); }
   bool CPUIDInfo__HasAVX512f(const CPUIDInfo* p) override { return p->HasAVX512f(); }
 
+  // KernelTuningDatabase (wrapped)
+  KernelTuningDatabase& KernelTuningDatabase__Instance() override { return KernelTuningDatabase::Instance(); }
+  bool KernelTuningDatabase__IsEnabled(const KernelTuningDatabase* p) override { return p->IsEnabled(); }
+  bool KernelTuningDatabase__Lookup(const KernelTuningDatabase* p, const std::string& device, const std::string& key, int& variant) override { return p->Lookup(device, key, variant); }
+  void KernelTuningDatabase__Record(KernelTuningDatabase* p, const std::string& device, const std::string& key, int variant) override { p->Record(device, key, variant); }
+
   // logging::Logger (wrapped)
   bool logging__Logger__OutputIsEnabled(const logging::Logger* p, logging::Severity severity, logging::DataType data_type) override { return p->OutputIsEnabled(severity, data_type); }
 
@@ -1118,6 +1125,10 @@ OrtCUDAProviderOptionsV2 OrtCUDAProviderOptionsToOrtCUDAProviderOptionsV2(const
   cuda_options_converted.cudnn_conv_use_max_workspace = 0;
   cuda_options_converted.enable_cuda_graph = 0;
   cuda_options_converted.cudnn_conv1d_pad_to_nc1d = 0;
+  cuda_options_converted.enable_pinned_io_staging = 0;
+  cuda_options_converted.num_compute_streams = 1;
+  cuda_options_converted.use_mem_pool = 0;
+  cuda_options_converted.mem_pool_release_threshold = std::numeric_limits<size_t>::max();
 
   return cuda_options_converted;
 }
@@ -1189,6 +1200,13 @@ OrtTensorRTProviderOptionsV2 OrtTensorRTProviderOptionsToOrtTensorRTProviderOpti
   trt_options_converted.trt_force_sequential_engine_build = legacy_trt_options->trt_force_sequential_engine_build;
   // Add new provider option below
   // Use default value as this field is not available in OrtTensorRTProviderOptionsV
+  trt_options_converted.trt_timing_cache_enable = 0;
+  trt_options_converted.trt_engine_build_async = 0;
+  trt_options_converted.trt_profile_min_shapes = nullptr;
+  trt_options_converted.trt_profile_max_shapes = nullptr;
+  trt_options_converted.trt_profile_opt_shapes = nullptr;
+  trt_options_converted.trt_int8_calibration_enable = 0;
+  trt_options_converted.trt_layer_precisions = nullptr;
 
   return trt_options_converted;
 }
@@ -1506,6 +1524,13 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorRTProviderOptions, _Outptr_ OrtTensorRT
   (*out)->trt_engine_decryption_enable = false;
   (*out)->trt_engine_decryption_lib_path = nullptr;
   (*out)->trt_force_sequential_engine_build = false;
+  (*out)->trt_timing_cache_enable = false;
+  (*out)->trt_engine_build_async = false;
+  (*out)->trt_profile_min_shapes = nullptr;
+  (*out)->trt_profile_max_shapes = nullptr;
+  (*out)->trt_profile_opt_shapes = nullptr;
+  (*out)->trt_int8_calibration_enable = false;
+  (*out)->trt_layer_precisions = nullptr;
   return nullptr;
 #else
   ORT_UNUSED_PARAMETER(out);
@@ -1591,6 +1616,22 @@ ORT_API(void, OrtApis::ReleaseTensorRTProviderOptions, _Frees_ptr_opt_ OrtTensor
     if (ptr->trt_engine_decryption_lib_path != nullptr) {
       delete ptr->trt_engine_decryption_lib_path;
     }
+
+    if (ptr->trt_profile_min_shapes != nullptr) {
+      delete ptr->trt_profile_min_shapes;
+    }
+
+    if (ptr->trt_profile_max_shapes != nullptr) {
+      delete ptr->trt_profile_max_shapes;
+    }
+
+    if (ptr->trt_profile_opt_shapes != nullptr) {
+      delete ptr->trt_profile_opt_shapes;
+    }
+
+    if (ptr->trt_layer_precisions != nullptr) {
+      delete ptr->trt_layer_precisions;
+    }
   }
 
   delete ptr;
@@ -1626,6 +1667,10 @@ ORT_API_STATUS_IMPL(OrtApis::CreateCUDAProviderOptions, _Outptr_ OrtCUDAProvider
   (*out)->cudnn_conv_use_max_workspace = 0;
   (*out)->enable_cuda_graph = 0;
   (*out)->cudnn_conv1d_pad_to_nc1d = 0;
+  (*out)->enable_pinned_io_staging = 0;
+  (*out)->num_compute_streams = 1;
+  (*out)->use_mem_pool = 0;
+  (*out)->mem_pool_release_threshold = std::numeric_limits<size_t>::max();
   return nullptr;
 #else
   ORT_UNUSED_PARAMETER(out);
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/session_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/murmurhash3.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace onnxruntime {
+namespace session_cache {
+
+void KeyBuilder::AddBytes(const void* data, size_t length) {
+  // MurmurHash3 takes an int length, so large inputs are hashed in chunks. The hash of each chunk is combined
+  // with the current state by hashing both together, which keeps the result sensitive to the chunk order.
+  constexpr size_t kMaxChunkSize = size_t{1} << 30;
+  static_assert(kMaxChunkSize <= static_cast<size_t>(INT_MAX), "chunk size must fit in an int");
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  do {
+    const size_t chunk_size = std::min(length, kMaxChunkSize);
+
+    std::array<uint32_t, 8> combined{};
+    std::copy(state_.begin(), state_.end(), combined.begin());
+    MurmurHash3::x86_128(bytes, static_cast<int>(chunk_size), state_[0], combined.data() + 4);
+    MurmurHash3::x86_128(combined.data(), static_cast<int>(sizeof(combined)), state_[1], state_.data());
+
+    bytes += chunk_size;
+    length -= chunk_size;
+  } while (length > 0);
+}
+
+void KeyBuilder::AddString(std::string_view value) {
+  AddInt(static_cast<int64_t>(value.size()));
+  AddBytes(value.data(), value.size());
+}
+
+void KeyBuilder::AddInt(int64_t value) {
+  AddBytes(&value, sizeof(value));
+}
+
+Status KeyBuilder::AddFile(const PathString& file_path) {
+  const Env& env = Env::Default();
+
+  size_t length = 0;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(file_path.c_str(), length));
+  AddInt(static_cast<int64_t>(length));
+  if (length == 0) {
+    return Status::OK();
+  }
+
+  Env::MappedMemoryPtr mapped_file;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path.c_str(), 0, length, mapped_file));
+  AddBytes(mapped_file.get(), length);
+
+  return Status::OK();
+}
+
+std::string KeyBuilder::ToString() const {
+  std::string result;
+  result.reserve(state_.size() * 8);
+
+  char hex[9];
+  for (uint32_t word : state_) {
+    snprintf(hex, sizeof(hex), "%08x", word);
+    result.append(hex);
+  }
+
+  return result;
+}
+
+void AddHardwareProperties(KeyBuilder& builder) {
+  // the NchwcTransformer and the layout of prepacked weights depend on the instruction sets available
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool flags[] = {cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasAVX512f(),
+                        cpu_info.HasAVX512Skylake(), cpu_info.HasF16C(), cpu_info.HasSSE3(),
+                        cpu_info.HasSSE4_1(), cpu_info.HasArmNeonDot()};
+  for (bool flag : flags) {
+    builder.AddInt(flag ? 1 : 0);
+  }
+
+  builder.AddInt(static_cast<int64_t>(MlasNchwcGetBlockSize()));
+}
+
+PathString GetCacheFilePath(const std::string& cache_dir, const std::string& key) {
+  return ConcatPathComponent<PATH_CHAR_TYPE>(ToPathString(cache_dir), ToPathString(key + ".ort"));
+}
+
+Status ReplaceFile(const PathString& from, const PathString& to) {
+#ifdef _WIN32
+  ORT_RETURN_IF_NOT(::MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0,
+                    "Failed to move ", ToUTF8String(from), " to ", ToUTF8String(to),
+                    ". Error code: ", ::GetLastError());
+#else
+  if (std::rename(from.c_str(), to.c_str()) != 0) {
+    const int err = errno;
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to move ", from, " to ", to, ". ", std::strerror(err));
+  }
+#endif
+
+  return Status::OK();
+}
+
+void RemoveFileIfExists(const PathString& file_path) {
+#ifdef _WIN32
+  ::DeleteFileW(file_path.c_str());
+#else
+  std::remove(file_path.c_str());
+#endif
+}
+
+}  // namespace session_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
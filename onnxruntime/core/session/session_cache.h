@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+
+namespace onnxruntime {
+namespace session_cache {
+
+// Support for the session cache enabled via kOrtSessionOptionsConfigSessionCacheDir.
+//
+// The cache stores the optimized and partitioned model in ORT format under a key that covers everything that
+// can change the result of optimization: the ORT version, the model bytes (including external data), the
+// execution providers and their options, the session options and the properties of the current machine that
+// the optimizers look at.
+
+// Incrementally builds a 128-bit cache key with MurmurHash3.
+class KeyBuilder {
+ public:
+  KeyBuilder() = default;
+
+  // Adds raw bytes. Inputs of any size are supported.
+  void AddBytes(const void* data, size_t length);
+
+  // Adds a string. The length is hashed as well so consecutive strings can't alias each other.
+  void AddString(std::string_view value);
+
+  void AddInt(int64_t value);
+
+  // Adds the content of a file. The file is memory mapped rather than read to avoid a copy of large models.
+  Status AddFile(const PathString& file_path);
+
+  // Returns the key as 32 hex digits.
+  std::string ToString() const;
+
+ private:
+  std::array<uint32_t, 4> state_{};
+};
+
+// Adds the properties of the current machine that affect the optimized graph, e.g. the NCHWc block size.
+void AddHardwareProperties(KeyBuilder& builder);
+
+// Returns the path of the cache file for `key` in `cache_dir`.
+PathString GetCacheFilePath(const std::string& cache_dir, const std::string& key);
+
+// Moves `from` to `to`, replacing `to` if it exists. As the cache file is written to a temporary path and
+// renamed into place, a concurrent reader sees either no file or a complete one.
+Status ReplaceFile(const PathString& from, const PathString& to);
+
+// Removes `file_path` if it exists. Used to clean up after a failed write.
+void RemoveFileIfExists(const PathString& file_path);
+
+}  // namespace session_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -13,6 +13,66 @@
 
 namespace onnxruntime {
 namespace concurrency {
+
+// Picks thread_pool_size entries from cpu_list so that the threads are spread evenly across the NUMA nodes, and
+// orders them by node. Returns the NUMA node of each picked entry in numa_nodes. Leaves both outputs empty if
+// the entries do not span at least two nodes.
+static void SpreadAffinityAcrossNumaNodes(const Env& env, const std::vector<size_t>& cpu_list, int thread_pool_size,
+                                          std::vector<size_t>& affinity, std::vector<int>& numa_nodes) {
+  std::vector<int> node_ids;
+  std::vector<std::vector<size_t>> node_cpus;
+  for (size_t cpu : cpu_list) {
+    int node_id = env.GetNumaNodeOfAffinity(cpu);
+    auto it = std::find(node_ids.begin(), node_ids.end(), node_id);
+    if (it == node_ids.end()) {
+      node_ids.push_back(node_id);
+      node_cpus.emplace_back();
+      it = node_ids.end() - 1;
+    }
+    node_cpus[it - node_ids.begin()].push_back(cpu);
+  }
+
+  if (node_ids.size() < 2) {
+    return;
+  }
+
+  // thread i goes to node (i * num_nodes / thread_pool_size), taking that node's processors in turn
+  const size_t num_nodes = node_ids.size();
+  const size_t num_threads = static_cast<size_t>(thread_pool_size);
+  for (size_t i = 0; i < num_threads; ++i) {
+    size_t node = i * num_nodes / num_threads;
+    size_t first_thread_on_node = (node * num_threads + num_nodes - 1) / num_nodes;
+    const auto& cpus = node_cpus[node];
+    affinity.push_back(cpus[(i - first_thread_on_node) % cpus.size()]);
+    numa_nodes.push_back(node_ids[node]);
+  }
+}
+
+// Keeps the entries of cpu_list on the cores of the highest efficiency class. Returns false and leaves cpu_list as is
+// if the cores are all of the same class.
+static bool KeepPerformanceCores(const Env& env, std::vector<size_t>& cpu_list) {
+  std::vector<int> classes;
+  classes.reserve(cpu_list.size());
+  for (size_t cpu : cpu_list) {
+    classes.push_back(env.GetEfficiencyClassOfAffinity(cpu));
+  }
+
+  const auto minmax = std::minmax_element(classes.cbegin(), classes.cend());
+  if (minmax.first == classes.cend() || *minmax.first == *minmax.second) {
+    return false;
+  }
+
+  const int performance_class = *minmax.second;
+  std::vector<size_t> performance_cpus;
+  for (size_t i = 0; i < cpu_list.size(); ++i) {
+    if (classes[i] == performance_class) {
+      performance_cpus.push_back(cpu_list[i]);
+    }
+  }
+  cpu_list = std::move(performance_cpus);
+  return true;
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   if (options.thread_pool_size == 1)
@@ -22,6 +82,20 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   if (options.affinity_vec_len != 0) {
     to.affinity.assign(options.affinity_vec, options.affinity_vec + options.affinity_vec_len);
   }
+  if (options.performance_cores_only && to.affinity.empty()) {
+    std::vector<size_t> performance_cpus = Env::Default().GetThreadAffinityMasks();
+    if (KeepPerformanceCores(Env::Default(), performance_cpus)) {
+      if (options.thread_pool_size <= 0) {
+        options.thread_pool_size = static_cast<int>(performance_cpus.size());
+        if (options.thread_pool_size == 1)
+          return nullptr;
+      }
+      for (int i = 0; i < options.thread_pool_size; ++i) {
+        to.affinity.push_back(performance_cpus[static_cast<size_t>(i) % performance_cpus.size()]);
+      }
+      to.performance_cores_only = true;
+    }
+  }
   if (options.thread_pool_size <= 0) {  // default
     cpu_list = Env::Default().GetThreadAffinityMasks();
     if (cpu_list.empty() || cpu_list.size() == 1)
@@ -30,6 +104,20 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
     if (options.auto_set_affinity)
       to.affinity = cpu_list;
   }
+  if (options.numa_aware) {
+    if (!to.affinity.empty()) {
+      // keep the caller's binding and only record where each thread runs
+      for (size_t cpu : to.affinity) {
+        to.numa_nodes.push_back(Env::Default().GetNumaNodeOfAffinity(cpu));
+      }
+    } else {
+      // grouping threads by node is only meaningful if they stay on that node, so bind them
+      if (cpu_list.empty()) {
+        cpu_list = Env::Default().GetThreadAffinityMasks();
+      }
+      SpreadAffinityAcrossNumaNodes(Env::Default(), cpu_list, options.thread_pool_size, to.affinity, to.numa_nodes);
+    }
+  }
   to.set_denormal_as_zero = options.set_denormal_as_zero;
 
   // set custom thread management members
@@ -37,6 +125,8 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.use_lock_free_queues = options.use_lock_free_queues;
+  to.adaptive_spinning = options.adaptive_spinning;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
@@ -132,4 +222,40 @@ ORT_API_STATUS_IMPL(SetGlobalCustomJoinThreadFn, _Inout_ OrtThreadingOptions* tp
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(SetGlobalLockFreeQueues, _Inout_ OrtThreadingOptions* tp_options, int use_lock_free_queues) {
+  if (!tp_options) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
+  }
+  if (!(use_lock_free_queues == 1 || use_lock_free_queues == 0)) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received invalid value for use_lock_free_queues. Valid values are 0 or 1");
+  }
+  tp_options->intra_op_thread_pool_params.use_lock_free_queues = (use_lock_free_queues != 0);
+  tp_options->inter_op_thread_pool_params.use_lock_free_queues = (use_lock_free_queues != 0);
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(SetGlobalNumaAware, _Inout_ OrtThreadingOptions* tp_options, int numa_aware) {
+  if (!tp_options) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
+  }
+  if (!(numa_aware == 1 || numa_aware == 0)) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received invalid value for numa_aware. Valid values are 0 or 1");
+  }
+  tp_options->intra_op_thread_pool_params.numa_aware = (numa_aware != 0);
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(SetGlobalAdaptiveSpinning, _Inout_ OrtThreadingOptions* tp_options, int adaptive_spinning) {
+  if (!tp_options) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
+  }
+  if (!(adaptive_spinning == 1 || adaptive_spinning == 0)) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "Received invalid value for adaptive_spinning. Valid values are 0 or 1");
+  }
+  tp_options->intra_op_thread_pool_params.adaptive_spinning = (adaptive_spinning != 0);
+  tp_options->inter_op_thread_pool_params.adaptive_spinning = (adaptive_spinning != 0);
+  return nullptr;
+}
+
 }  // namespace OrtApis
@@ -36,6 +36,22 @@ struct OrtThreadPoolParams {
   OrtCustomCreateThreadFn custom_create_thread_fn = nullptr;
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
+
+  // If it is true, use lock-free per-thread work queues.
+  bool use_lock_free_queues = false;
+
+  // If it is true, group the threads by NUMA node. When the affinity is chosen by ORT, the threads are bound to
+  // processors spread evenly across the nodes. Has no effect on machines with a single NUMA node.
+  bool numa_aware = false;
+
+  // If it is true and spinning is allowed, the threads spin for a duration adapted to how long they typically wait
+  // for work instead of a fixed number of iterations.
+  bool adaptive_spinning = false;
+
+  // If it is true and the processor has cores of different speeds, e.g. P-cores and E-cores, the threads are bound
+  // to the fastest cores. If the size of the pool is not set, there is one thread per fast core. Has no effect if the
+  // affinity is set explicitly.
+  bool performance_cores_only = false;
 };
 
 struct OrtThreadingOptions {
@@ -4,6 +4,7 @@
 # --------------------------------------------------------------------------
 import collections
 import collections.abc
+import concurrent.futures
 import os
 import warnings
 
@@ -169,17 +170,23 @@ class Session:
         """
         self._enable_fallback = True
 
-    def run(self, output_names, input_feed, run_options=None):
+    def run(self, output_names, input_feed, run_options=None, outputs=None, zero_copy_outputs=False):
         """
         Compute the predictions.
 
         :param output_names: name of the outputs
         :param input_feed: dictionary ``{ input_name: input_value }``
         :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param outputs: optional list of preallocated numpy arrays, one per output name, or None for the outputs
+            to allocate. The outputs are written into the arrays, which must be C contiguous and of the shape and
+            type of the output, and the arrays are returned.
+        :param zero_copy_outputs: return the outputs on CPU as numpy arrays using the memory of the onnxruntime
+            tensors instead of copies of them. The memory is released when the arrays are.
 
         ::
 
             sess.run([output_name], {input_name: x})
+            sess.run([output_name], {input_name: x}, outputs=[np.empty(shape, dtype=np.float32)])
         """
         num_required_inputs = len(self._inputs_meta)
         num_inputs = len(input_feed)
@@ -189,7 +196,7 @@ class Session:
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
         try:
-            return self._sess.run(output_names, input_feed, run_options)
+            return self._sess.run(output_names, input_feed, run_options, outputs, zero_copy_outputs)
         except C.EPFail as err:
             if self._enable_fallback:
                 print("EP Error: {} using {}".format(str(err), self._providers))
@@ -197,10 +204,60 @@ class Session:
                 self.set_providers(self._fallback_providers)
                 # Fallback only once.
                 self.disable_fallback()
-                return self._sess.run(output_names, input_feed, run_options)
+                return self._sess.run(output_names, input_feed, run_options, outputs, zero_copy_outputs)
             else:
                 raise
 
+    def run_async(self, output_names, input_feed, callback=None, user_data=None, run_options=None):
+        """
+        Compute the predictions asynchronously in a thread of the intra op thread pool of the session.
+        The call returns once the run is scheduled.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param callback: python function ``callback(outputs, user_data, err)`` invoked when the run has completed,
+            with the list of outputs and an empty ``err`` on success, or an empty list and the error message
+            otherwise. It is invoked from a thread of the thread pool. If None, a
+            :class:`concurrent.futures.Future` is returned instead, which completes with the list of outputs
+            or raises a ``RuntimeError`` with the error message.
+        :param user_data: any object passed to the callback
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+
+        ::
+
+            def callback(outputs, user_data, err):
+                ...
+
+            sess.run_async([output_name], {input_name: x}, callback, user_data)
+
+            outputs = sess.run_async([output_name], {input_name: x}).result()
+
+            # in a coroutine
+            outputs = await asyncio.wrap_future(sess.run_async([output_name], {input_name: x}))
+        """
+        future = None
+        if callback is None:
+            future = concurrent.futures.Future()
+            future.set_running_or_notify_cancel()
+
+            def callback(outputs, future, err):
+                if err:
+                    future.set_exception(RuntimeError(err))
+                else:
+                    future.set_result(outputs)
+
+            user_data = future
+
+        num_required_inputs = len(self._inputs_meta)
+        num_inputs = len(input_feed)
+        # the graph may have optional inputs used to override initializers. allow for that.
+        if num_inputs < num_required_inputs:
+            raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        self._sess.run_async(output_names, input_feed, callback, user_data, run_options)
+        return future
+
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
         """
         Compute the predictions.
@@ -566,6 +623,21 @@ class OrtValue:
         return OrtValue(C.OrtValue.ortvalue_from_shape_and_type(shape, element_type,
                         C.OrtDevice(get_ort_device_type(device_type), C.OrtDevice.default_memory(), device_id)))
 
+    @staticmethod
+    def ortvalue_from_dlpack(dlpack_obj, is_bool_tensor=False):
+        '''
+        Factory method to construct an OrtValue (which holds a Tensor) that shares the data of a DLPack tensor,
+        e.g. a PyTorch or CuPy tensor on CPU or CUDA. No copy of the data is made.
+
+        :param dlpack_obj: A DLPack capsule, or an object implementing `__dlpack__`.
+            A capsule can only be consumed once.
+        :param is_bool_tensor: DLPack describes bool and uint8 tensors the same way.
+            Set to True to create a bool tensor.
+        '''
+        if hasattr(dlpack_obj, '__dlpack__'):
+            dlpack_obj = dlpack_obj.__dlpack__()
+        return OrtValue(C.OrtValue.from_dlpack(dlpack_obj, is_bool_tensor))
+
     @staticmethod
     def ort_value_from_sparse_tensor(sparse_tensor):
         '''
@@ -580,6 +652,13 @@ class OrtValue:
         '''
         return SparseTensor(self._ortvalue.as_sparse_tensor())
 
+    def to_dlpack(self):
+        '''
+        Returns a DLPack capsule that shares the data of the Tensor in this OrtValue, e.g. to create a
+        PyTorch tensor with `torch.utils.dlpack.from_dlpack`. The capsule keeps the data alive.
+        '''
+        return self._ortvalue.to_dlpack()
+
     def data_ptr(self):
         '''
         Returns the address of the first element in the OrtValue's data buffer
@@ -61,7 +61,7 @@ void addGlobalSchemaFunctions(pybind11::module& m) {
                 }()),
 #endif
 #ifdef USE_VITISAI
-            onnxruntime::CreateExecutionProviderFactory_VITISAI("DPUCADX8G", 0, "", ""),
+            onnxruntime::CreateExecutionProviderFactory_VITISAI("DPUCADX8G", 0, "", "", ""),
 #endif
 #ifdef USE_ACL
             onnxruntime::CreateExecutionProviderFactory_ACL(0),
@@ -79,7 +79,7 @@ void addGlobalSchemaFunctions(pybind11::module& m) {
             onnxruntime::CreateExecutionProviderFactory_Rknpu(),
 #endif
 #ifdef USE_COREML
-            onnxruntime::CreateExecutionProviderFactory_CoreML(0),
+            onnxruntime::CreateExecutionProviderFactory_CoreML(0, {}),
 #endif
         };
 
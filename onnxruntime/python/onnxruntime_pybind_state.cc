@@ -9,6 +9,8 @@
 #define PY_ARRAY_UNIQUE_SYMBOL onnxruntime_python_ARRAY_API
 #include <numpy/arrayobject.h>
 
+#include "python/numpy_helper.h"
+
 #include "core/common/logging/logging.h"
 #include "core/common/logging/severity.h"
 #include "core/common/optional.h"
@@ -124,6 +126,9 @@ static py::object AddNonTensor(const OrtValue& val,
   return py::cast(val.Get<T>());
 }
 
+// Copies of outputs at least this large are made without holding the GIL.
+static constexpr size_t kReleaseGilMinCopyBytes = 64 * 1024;
+
 // In all cases, we may not have access to a DataTransferManager, hence the user may specify functions that
 // pretty much does what a DataTransferManager does - copy data from device(s) to the host
 void GetPyObjFromTensor(const Tensor& rtensor, py::object& obj,
@@ -145,6 +150,13 @@ void GetPyObjFromTensor(const Tensor& rtensor, py::object& obj,
       PyArray_DATA(reinterpret_cast<PyArrayObject*>(obj.ptr())));
 
   if (numpy_type != NPY_OBJECT) {
+    // the copy doesn't touch python objects, other python threads can run meanwhile if it is large enough to be
+    // worth releasing the GIL
+    optional<py::gil_scoped_release> release_gil;
+    if (dtype->Size() * shape.Size() >= kReleaseGilMinCopyBytes) {
+      release_gil.emplace();
+    }
+
     // if it is not cpu tensor, need to copy to host
     auto device_type = rtensor.Location().device.Type();
     if (device_type != OrtDevice::CPU) {
@@ -372,7 +384,8 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
     // If the environment variable 'ORT_TENSORRT_UNAVAILABLE' exists, then we do not load TensorRT. This is set by _ld_preload for the manylinux case
     // as in that case, trying to load the library itself will result in a crash due to the way that auditwheel strips dependencies.
     if (Env::Default().GetEnvironmentVar("ORT_TENSORRT_UNAVAILABLE").empty()) {
-      std::string calibration_table, cache_path, lib_path;
+      std::string calibration_table, cache_path, lib_path, profile_min_shapes, profile_max_shapes, profile_opt_shapes,
+          layer_precisions;
       auto it = provider_options_map.find(type);
       if (it != provider_options_map.end()) {
         OrtTensorRTProviderOptionsV2 params{
@@ -393,7 +406,14 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             nullptr,
             0,
             nullptr,
-            0};
+            0,
+            0,
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            0,
+            nullptr};
         for (auto option : it->second) {
           if (option.first == "device_id") {
             if (!option.second.empty()) {
@@ -510,6 +530,58 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_force_sequential_engine_build' should be a boolean i.e. 'True' or 'False'. Default value is False.\n");
             }
+          } else if (option.first == "trt_timing_cache_enable") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_timing_cache_enable = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_timing_cache_enable = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_timing_cache_enable' should be a boolean i.e. 'True' or 'False'. Default value is False.\n");
+            }
+          } else if (option.first == "trt_engine_build_async") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_engine_build_async = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_engine_build_async = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_build_async' should be a boolean i.e. 'True' or 'False'. Default value is False.\n");
+            }
+          } else if (option.first == "trt_profile_min_shapes") {
+            if (!option.second.empty()) {
+              profile_min_shapes = option.second;
+              params.trt_profile_min_shapes = profile_min_shapes.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_min_shapes' should be a list of input shapes i.e. 'input1:1x3x224x224,input2:1x128'.\n");
+            }
+          } else if (option.first == "trt_profile_max_shapes") {
+            if (!option.second.empty()) {
+              profile_max_shapes = option.second;
+              params.trt_profile_max_shapes = profile_max_shapes.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_max_shapes' should be a list of input shapes i.e. 'input1:1x3x224x224,input2:1x128'.\n");
+            }
+          } else if (option.first == "trt_profile_opt_shapes") {
+            if (!option.second.empty()) {
+              profile_opt_shapes = option.second;
+              params.trt_profile_opt_shapes = profile_opt_shapes.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_opt_shapes' should be a list of input shapes i.e. 'input1:1x3x224x224,input2:1x128'.\n");
+            }
+          } else if (option.first == "trt_int8_calibration_enable") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_int8_calibration_enable = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_int8_calibration_enable = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_int8_calibration_enable' should be a boolean i.e. 'True' or 'False'. Default value is False.\n");
+            }
+          } else if (option.first == "trt_layer_precisions") {
+            if (!option.second.empty()) {
+              layer_precisions = option.second;
+              params.trt_layer_precisions = layer_precisions.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_layer_precisions' should be a list of layer precisions i.e. 'Conv_12:fp32,MatMul_40:fp16'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -664,9 +736,12 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
     // `export_runtime_module`: export a Vitis AI PyXIR runtime module to the specified file.
     //    This can be used for cross compilation or saving state.
     // `load_runtime_module`: Load an exported runtime module from disk.
+    // `compiled_model_cache_dir`: Cache the runtime module of each partition in this directory and load
+    //    it from there instead of compiling the partition again.
     std::string target = "DPUCADX8G";
     std::string export_runtime_module = "";
     std::string load_runtime_module = "";
+    std::string compiled_model_cache_dir = "";
     auto it = provider_options_map.find(type);
     if (it != provider_options_map.end()) {
       auto vitis_ai_provider_options = it->second;
@@ -682,10 +757,15 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
       if (vai_options_it != vitis_ai_provider_options.end()) {
         load_runtime_module = vai_options_it->second;
       }
+      vai_options_it = vitis_ai_provider_options.find("compiled_model_cache_dir");
+      if (vai_options_it != vitis_ai_provider_options.end()) {
+        compiled_model_cache_dir = vai_options_it->second;
+      }
     }
     return onnxruntime::CreateExecutionProviderFactory_VITISAI(target.c_str(), 0,
                                                                export_runtime_module.c_str(),
-                                                               load_runtime_module.c_str())
+                                                               load_runtime_module.c_str(),
+                                                               compiled_model_cache_dir.c_str())
         ->CreateProvider();
 #endif
   } else if (type == kAclExecutionProvider) {
@@ -722,7 +802,10 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #endif
     const auto partitioning_stop_ops_list = session_options.config_options.GetConfigEntry(
         kOrtSessionOptionsConfigNnapiEpPartitioningStopOps);
-    return onnxruntime::CreateExecutionProviderFactory_Nnapi(0, partitioning_stop_ops_list)->CreateProvider();
+    const auto compilation_cache_dir = session_options.config_options.GetConfigEntry(
+        kOrtSessionOptionsConfigNnapiEpCompilationCacheDir);
+    return onnxruntime::CreateExecutionProviderFactory_Nnapi(0, partitioning_stop_ops_list, compilation_cache_dir)
+        ->CreateProvider();
 #endif
   } else if (type == kRknpuExecutionProvider) {
 #ifdef USE_RKNPU
@@ -733,7 +816,9 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #if !defined(__APPLE__)
     LOGS_DEFAULT(WARNING) << "CoreML execution provider can only be used to generate ORT format model in this build.";
 #endif
-    return onnxruntime::CreateExecutionProviderFactory_CoreML(0)->CreateProvider();
+    const auto compiled_model_cache_dir = session_options.config_options.GetConfigEntry(
+        kOrtSessionOptionsConfigCoreMLEpCompiledModelCacheDir);
+    return onnxruntime::CreateExecutionProviderFactory_CoreML(0, compiled_model_cache_dir)->CreateProvider();
 #endif
   } else {
     // check whether it is a dynamic load EP:
@@ -1003,6 +1088,130 @@ void addGlobalMethods(py::module& m, Environment& env) {
 #endif
 }
 
+// Converts the feeds of InferenceSession.run to OrtValues.
+static NameMLValMap CreateFeeds(PyInferenceSession* sess, const std::map<std::string, py::object>& pyfeeds) {
+  NameMLValMap feeds;
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      feeds.insert(std::make_pair(feed.first, ml_value));
+    }
+  }
+  return feeds;
+}
+
+// Converts the fetches of a run to the python objects returned by InferenceSession.run.
+// Returns a numpy array using the buffer of a CPU tensor instead of a copy of it. The array holds a reference to
+// the OrtValue in its base object, which keeps the buffer alive as long as the array or any view of it exists.
+// String tensors, empty tensors and tensors on other devices are copied.
+static py::object AddTensorAsPyObjNoCopy(const OrtValue& val) {
+  const Tensor& rtensor = val.Get<Tensor>();
+  const int numpy_type = OnnxRuntimeTensorToNumpyType(rtensor.DataType());
+  const TensorShape& shape = rtensor.Shape();
+  if (!IsNumericNumpyType(numpy_type) || shape.Size() == 0 ||
+      rtensor.Location().device.Type() != OrtDevice::CPU) {
+    return AddTensorAsPyObj(val, nullptr, nullptr);
+  }
+
+  std::vector<npy_intp> npy_dims;
+  for (size_t n = 0; n < shape.NumDimensions(); ++n) {
+    npy_dims.push_back(shape[n]);
+  }
+
+  py::capsule keep_alive(new OrtValue(val), [](void* ort_value) { delete static_cast<OrtValue*>(ort_value); });
+  auto obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+      static_cast<int>(shape.NumDimensions()), npy_dims.data(), numpy_type, const_cast<void*>(rtensor.DataRaw())));
+  if (!obj) {
+    throw py::error_already_set();
+  }
+
+  // PyArray_SetBaseObject steals the reference to the capsule, also when it fails
+  if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), keep_alive.release().ptr()) != 0) {
+    throw py::error_already_set();
+  }
+  return obj;
+}
+
+// Wraps the preallocated numpy arrays given for the outputs into OrtValues, so the session writes the outputs into
+// their buffers. A None entry leaves the output to be allocated by the session.
+static std::vector<OrtValue> CreateFetchesFromArrays(PyInferenceSession* sess,
+                                                     const std::vector<std::string>& output_names,
+                                                     const std::vector<py::object>& outputs) {
+  if (outputs.size() != output_names.size()) {
+    throw std::runtime_error("The number of preallocated outputs (" + std::to_string(outputs.size()) +
+                             ") must match the number of output names (" + std::to_string(output_names.size()) + ").");
+  }
+
+  auto model_outputs = sess->GetSessionHandle()->GetModelOutputs();
+  OrtPybindThrowIfError(model_outputs.first);
+
+  std::vector<OrtValue> fetches(outputs.size());
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    py::object output = outputs[i];
+    if (output.is_none()) {
+      continue;
+    }
+
+    const std::string& name = output_names[i];
+    onnx::TypeProto type_proto;
+    if (!IsNumpyArray(output) || !CheckIfTensor(*model_outputs.second, name, type_proto)) {
+      throw std::runtime_error("The preallocated output '" + name + "' must be a numpy array for a tensor output.");
+    }
+
+    auto* array = reinterpret_cast<PyArrayObject*>(output.ptr());
+    const int npy_type = PyArray_TYPE(array);
+    if (!IsNumericNumpyType(npy_type) || !PyArray_ISCARRAY(array)) {
+      throw std::runtime_error("The preallocated output '" + name +
+                               "' must be a C contiguous, aligned and writeable numpy array of a numeric type.");
+    }
+
+    MLDataType element_type = NumpyTypeToOnnxRuntimeTensorType(npy_type);
+    if (element_type != DataTypeImpl::TensorTypeFromONNXEnum(type_proto.tensor_type().elem_type())->GetElementType()) {
+      throw std::runtime_error("The type of the preallocated output '" + name + "' doesn't match the model output.");
+    }
+
+    Tensor::InitOrtValue(element_type, GetShape(output.cast<py::array>()), PyArray_DATA(array),
+                         GetAllocator()->Info(), fetches[i]);
+  }
+
+  return fetches;
+}
+
+// preallocated_outputs are returned as is for the fetches they were given for, see CreateFetchesFromArrays.
+static std::vector<py::object> GetPyFetches(const std::vector<OrtValue>& fetches, bool zero_copy = false,
+                                            const std::vector<py::object>& preallocated_outputs = {}) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  size_t pos = 0;
+  for (auto fet : fetches) {
+    if (pos < preallocated_outputs.size() && !preallocated_outputs[pos].is_none()) {
+      rfetch.push_back(preallocated_outputs[pos]);
+    } else if (fet.IsAllocated()) {
+      if (fet.IsTensor()) {
+        rfetch.push_back(zero_copy ? AddTensorAsPyObjNoCopy(fet) : AddTensorAsPyObj(fet, nullptr, nullptr));
+      } else if (fet.IsSparseTensor()) {
+        rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+      } else {
+        rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+      }
+    } else {  // Send back None because the corresponding OrtValue was empty
+      rfetch.push_back(py::none());
+    }
+    ++pos;
+  }
+  return rfetch;
+}
+
 void addObjectMethods(py::module& m, Environment& env, ExecutionProviderRegistrationFn ep_registration_fn) {
   py::enum_<GraphOptimizationLevel>(m, "GraphOptimizationLevel")
       .value("ORT_DISABLE_ALL", GraphOptimizationLevel::ORT_DISABLE_ALL)
@@ -1386,59 +1595,98 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                               disabled_optimizer_names);
           },
           R"pbdoc(Load a model saved in ONNX or ORT format.)pbdoc")
-      .def("run",
-           [](PyInferenceSession* sess, std::vector<std::string> output_names,
-              std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
-               -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, ml_value));
-               }
-             }
+      /// outputs is an optional list of preallocated numpy arrays, or None, for each of the output names. The
+      /// outputs are written into the given arrays, which are returned. With zero_copy_outputs, the other CPU tensor
+      /// outputs are returned as numpy arrays using the buffers of the OrtValues instead of copies of them.
+      .def(
+          "run",
+          [](PyInferenceSession* sess, std::vector<std::string> output_names,
+             std::map<std::string, py::object> pyfeeds, RunOptions* run_options, py::object outputs,
+             bool zero_copy_outputs)
+              -> std::vector<py::object> {
+            NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
+
+            std::vector<py::object> preallocated_outputs;
+            std::vector<OrtValue> fetches;
+            if (!outputs.is_none()) {
+              preallocated_outputs = outputs.cast<std::vector<py::object>>();
+              fetches = CreateFetchesFromArrays(sess, output_names, preallocated_outputs);
+            }
 
-             std::vector<OrtValue> fetches;
-             common::Status status;
+            {
+              // release GIL to allow multiple python threads to invoke Run() in parallel.
+              py::gil_scoped_release release;
+              if (run_options != nullptr) {
+                OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
+              } else {
+                OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
+              }
+            }
 
-             {
-               // release GIL to allow multiple python threads to invoke Run() in parallel.
-               py::gil_scoped_release release;
-               if (run_options != nullptr) {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
-               } else {
-                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
-               }
+            return GetPyFetches(fetches, zero_copy_outputs, preallocated_outputs);
+          },
+          py::arg("output_names"), py::arg("input_feed"), py::arg("run_options") = nullptr,
+          py::arg("outputs") = py::none(), py::arg("zero_copy_outputs") = false)
+      /// This method schedules the run on the intra op thread pool of the session and returns immediately.
+      /// callback(outputs, user_data, err) is invoked from a thread of the pool when the run has completed, with
+      /// the list of outputs and an empty err on success, or an empty list and the error message otherwise.
+      .def("run_async",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::map<std::string, py::object> pyfeeds, py::object callback, py::object user_data,
+              py::object run_options) {
+             NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
+             std::vector<std::string> feed_names;
+             std::vector<OrtValue> feed_values;
+             feed_names.reserve(feeds.size());
+             feed_values.reserve(feeds.size());
+             for (auto& feed : feeds) {
+               feed_names.push_back(feed.first);
+               feed_values.push_back(feed.second);
              }
 
-             std::vector<py::object> rfetch;
-             rfetch.reserve(fetches.size());
-             size_t pos = 0;
-             for (auto fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+             // The python objects are referenced until the callback has run, the feeds may use the memory of the
+             // arrays. All of them are released while holding the GIL. The feeds are released by the session before
+             // the callback, so the copies here hold the last references to them.
+             struct AsyncRunState {
+               py::object callback;
+               py::object user_data;
+               py::object run_options;
+               std::map<std::string, py::object> pyfeeds;
+               std::vector<OrtValue> feeds;
+             };
+             auto state = std::make_shared<AsyncRunState>();
+             state->callback = std::move(callback);
+             state->user_data = std::move(user_data);
+             state->run_options = std::move(run_options);
+             state->pyfeeds = std::move(pyfeeds);
+             state->feeds = feed_values;
+
+             const RunOptions* ort_run_options = state->run_options.is_none()
+                                                     ? nullptr
+                                                     : state->run_options.cast<RunOptions*>();
+             auto on_completed = [state](std::vector<OrtValue>& fetches, const common::Status& status) {
+               py::gil_scoped_acquire acquire;
+               try {
+                 if (status.IsOK()) {
+                   state->callback(GetPyFetches(fetches), state->user_data, "");
                  } else {
-                   rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+                   state->callback(std::vector<py::object>(), state->user_data, status.ErrorMessage());
                  }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 rfetch.push_back(py::none());
+               } catch (py::error_already_set& ex) {
+                 // there is no caller to raise the error of the callback to
+                 ex.discard_as_unraisable(__func__);
                }
-               ++pos;
-             }
-             return rfetch;
+
+               state->callback = py::object();
+               state->user_data = py::object();
+               state->run_options = py::object();
+               state->pyfeeds.clear();
+               state->feeds.clear();
+             };
+
+             OrtPybindThrowIfError(sess->GetSessionHandle()->RunAsync(
+                 ort_run_options, std::move(feed_names), std::move(feed_values), output_names,
+                 std::vector<OrtValue>(output_names.size()), std::move(on_completed)));
            })
       /// This method accepts a dictionary of feeds (name -> OrtValue) and the list of output_names
       /// and returns a list of python objects representing OrtValues. Each name may represent either
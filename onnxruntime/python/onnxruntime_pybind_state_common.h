@@ -11,7 +11,7 @@
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 #include "core/dlpack/dlpack_converter.h"
 #endif
 
@@ -282,7 +282,13 @@ struct PyInferenceSession {
 
   InferenceSession* GetSessionHandle() const { return sess_.get(); }
 
-  virtual ~PyInferenceSession() {}
+  virtual ~PyInferenceSession() {
+    // The session waits for the outstanding runs of run_async, whose callbacks acquire the GIL.
+    if (PyGILState_Check()) {
+      pybind11::gil_scoped_release release;
+      sess_.reset();
+    }
+  }
 
  protected:
   PyInferenceSession(std::unique_ptr<InferenceSession> sess) {
@@ -459,7 +465,7 @@ bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
                    const std::string& name,
                    /*out*/ ONNX_NAMESPACE::TypeProto& type_proto);
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 
 // Allocate a new Capsule object, which takes the ownership of OrtValue.
 // Caller is responsible for releasing.
@@ -489,14 +495,17 @@ std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Tvm(co
 #endif
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_VITISAI(const char* backend_type, int device_id,
                                                                                   const char* export_runtime_module,
-                                                                                  const char* load_runtime_module);
+                                                                                  const char* load_runtime_module,
+                                                                                  const char* compiled_model_cache_dir);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_ACL(int use_arena);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_ArmNN(int use_arena);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_DML(int device_id);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Nnapi(
-    uint32_t flags, const optional<std::string>& partitioning_stop_ops_list);
+    uint32_t flags, const optional<std::string>& partitioning_stop_ops_list,
+    const optional<std::string>& compilation_cache_dir);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Rknpu();
-std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CoreML(uint32_t flags);
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CoreML(
+    uint32_t flags, const optional<std::string>& compiled_model_cache_dir);
 
 constexpr const char* kDefaultExecutionProviderEntry = "GetProvider";
 }  // namespace onnxruntime
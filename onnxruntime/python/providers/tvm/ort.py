@@ -7,6 +7,7 @@
 import os
 import collections
 import copy
+import hashlib
 import logging
 
 import onnx
@@ -22,6 +23,48 @@ ANSOR_TYPE = "Ansor"
 AUTO_TVM_TYPE = "AutoTVM"
 
 
+def get_cache_key(model, executor, target, target_host, opt_level, freeze_params, input_shapes, nhwc,
+                  tuning_logfile, tuning_type):
+    key = hashlib.sha256()
+    key.update(model.SerializeToString())
+    settings = [executor, target, target_host, int(opt_level), bool(freeze_params),
+                [[int(dim) for dim in shape] for shape in input_shapes], bool(nhwc), tuning_type, tvm.__version__]
+    key.update(str(settings).encode())
+    if tuning_logfile:
+        with open(tuning_logfile, "rb") as f:
+            key.update(f.read())
+    return key.hexdigest()
+
+
+def load_cached_module(cache_path, executor, ctx):
+    # The library is written last, so its presence means that the cache entry is complete
+    lib_path = cache_path + ".so"
+    if not os.path.exists(lib_path):
+        return None
+
+    log.info("Load compiled TVM module from {}".format(lib_path))
+    lib = tvm.runtime.load_module(lib_path)
+    if executor == "vm":
+        with open(cache_path + ".ro", "rb") as f:
+            code = bytearray(f.read())
+        return tvm.runtime.vm.VirtualMachine(vm.Executable.load_exec(code, lib), ctx).module
+    return graph_executor.GraphModule(lib["default"](ctx)).module
+
+
+def save_cached_module(cache_path, executor, lib):
+    lib_path = cache_path + ".so"
+    tmp_lib_path = "{}.{}.tmp.so".format(cache_path, os.getpid())
+    if executor == "vm":
+        code, lib = lib.save()
+        tmp_code_path = "{}.{}.tmp.ro".format(cache_path, os.getpid())
+        with open(tmp_code_path, "wb") as f:
+            f.write(code)
+        os.replace(tmp_code_path, cache_path + ".ro")
+    lib.export_library(tmp_lib_path)
+    os.replace(tmp_lib_path, lib_path)
+    log.info("Saved compiled TVM module to {}".format(lib_path))
+
+
 @tvm.register_func("tvm_onnx_import_and_compile")
 def onnx_compile(model_string,
                  model_path,
@@ -34,7 +77,8 @@ def onnx_compile(model_string,
                  input_shapes,
                  nhwc=False,
                  tuning_logfile="",
-                 tuning_type=AUTO_TVM_TYPE):
+                 tuning_type=AUTO_TVM_TYPE,
+                 module_cache_dir=""):
     def get_tvm_executor(irmod, executor, target, params):
         if executor == "vm":
             log.info("Build TVM virtual machine")
@@ -71,12 +115,24 @@ def onnx_compile(model_string,
     for name in net_feed_input_names:
         feed_shape_dict[name] = shape_dict[name]
 
-    irmod, params = relay.frontend.from_onnx(model, feed_shape_dict, opset=opset, freeze_params=freeze_params)
-    irmod = relay.transform.DynamicToStatic()(irmod)
-
     # Tuning file can be set by client through ep options
     if tuning_logfile == "":
         tuning_logfile = os.getenv("AUTOTVM_TUNING_LOG")
+
+    # Modules compiled ahead of time are looked up by the hash of the model and of the compilation settings
+    ctx = tvm.device(target, 0)
+    cache_path = None
+    if module_cache_dir:
+        cache_key = get_cache_key(model, executor, target, target_host, opt_level, freeze_params, input_shapes, nhwc,
+                                  tuning_logfile, tuning_type)
+        cache_path = os.path.join(module_cache_dir, cache_key)
+        module = load_cached_module(cache_path, executor, ctx)
+        if module is not None:
+            return module
+
+    irmod, params = relay.frontend.from_onnx(model, feed_shape_dict, opset=opset, freeze_params=freeze_params)
+    irmod = relay.transform.DynamicToStatic()(irmod)
+
     lib = None
     tvm_target = tvm.target.Target(target, host=target_host)
     if tuning_logfile:
@@ -123,7 +179,10 @@ def onnx_compile(model_string,
     if lib is None:
         return None
 
-    ctx = tvm.device(target, 0)
+    if cache_path is not None:
+        os.makedirs(module_cache_dir, exist_ok=True)
+        save_cached_module(cache_path, executor, lib)
+
     if executor == "vm":
         m = tvm.runtime.vm.VirtualMachine(lib, ctx)
     elif executor == "graph":
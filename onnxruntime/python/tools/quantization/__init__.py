@@ -3,3 +3,4 @@ from .quantize import QuantizationMode
 from .calibrate import CalibrationDataReader, CalibraterBase, MinMaxCalibrater, create_calibrator, CalibrationMethod
 from .quant_utils import QuantType, QuantFormat, write_calibration_table
 from .qdq_quantizer import QDQQuantizer
+from .matmul_nbits_quantizer import MatMulNBitsQuantizer, quantize_matmul_nbits
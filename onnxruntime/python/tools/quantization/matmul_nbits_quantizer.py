@@ -0,0 +1,153 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+import logging
+import numpy as np
+
+from pathlib import Path
+from onnx import numpy_helper, helper
+from onnx import onnx_pb as onnx_proto
+
+from .quant_utils import ms_domain
+from .quantize import load_model
+from .onnx_model import ONNXModel
+
+
+class MatMulNBitsQuantizer:
+    '''
+    Replaces the MatMul nodes whose weight is a constant 2D float tensor by com.microsoft.MatMulNBits nodes, the
+    weight being quantized to `bits` bits along its K dimension in blocks of `block_size` elements. Only the weights
+    are quantized, the activations stay in float.
+    '''
+    def __init__(self, model, block_size=32, bits=4, is_symmetric=False, nodes_to_exclude=None):
+        if bits not in (4, 8):
+            raise ValueError('bits must be 4 or 8, got {}'.format(bits))
+        if block_size < 16 or block_size > 256 or (block_size & (block_size - 1)) != 0:
+            raise ValueError('block_size must be a power of 2 in [16, 256], got {}'.format(block_size))
+
+        self.model = ONNXModel(model)
+        self.block_size = block_size
+        self.bits = bits
+        self.is_symmetric = is_symmetric
+        self.nodes_to_exclude = set(nodes_to_exclude or [])
+
+    def quantize_weight(self, weight):
+        '''
+        Quantizes a K x N weight, returning the packed blobs [N, ceil(K / block_size), blob_size], the scales
+        [N * ceil(K / block_size)] and the packed zero points, None if symmetric.
+        '''
+        k, n = weight.shape
+        block_count = (k + self.block_size - 1) // self.block_size
+        max_value = (1 << self.bits) - 1
+
+        # [N, block_count, block_size], padded with zeros
+        padded = np.zeros((block_count * self.block_size, n), dtype=np.float32)
+        padded[:k, :] = weight
+        blocks = padded.T.reshape(n, block_count, self.block_size)
+
+        if self.is_symmetric:
+            abs_max = np.abs(blocks).max(axis=2, keepdims=True)
+            # symmetric around the implicit zero point 2^(bits - 1)
+            scales = abs_max / ((1 << (self.bits - 1)) - 1)
+            scales[scales == 0] = 1.0
+            zero_points = np.full(scales.shape, 1 << (self.bits - 1), dtype=np.float32)
+        else:
+            # the range must include 0 so that zero padding stays exact
+            min_value = np.minimum(blocks.min(axis=2, keepdims=True), 0.0)
+            max_value_f = np.maximum(blocks.max(axis=2, keepdims=True), 0.0)
+            scales = (max_value_f - min_value) / max_value
+            scales[scales == 0] = 1.0
+            zero_points = np.clip(np.round(-min_value / scales), 0, max_value)
+
+        quantized = np.clip(np.round(blocks / scales) + zero_points, 0, max_value).astype(np.uint8)
+
+        if self.bits == 4:
+            packed = (quantized[:, :, 0::2] | (quantized[:, :, 1::2] << 4)).astype(np.uint8)
+        else:
+            packed = quantized
+
+        packed_zero_points = None
+        if not self.is_symmetric:
+            zero_points = zero_points.reshape(n, block_count).astype(np.uint8)
+            if self.bits == 4:
+                if block_count % 2 == 1:
+                    zero_points = np.concatenate([zero_points, np.zeros((n, 1), dtype=np.uint8)], axis=1)
+                zero_points = (zero_points[:, 0::2] | (zero_points[:, 1::2] << 4)).astype(np.uint8)
+            packed_zero_points = zero_points.reshape(-1)
+
+        return packed, scales.reshape(-1).astype(np.float32), packed_zero_points
+
+    def _quantize_matmul(self, node):
+        weight_tensor = self.model.get_initializer(node.input[1])
+        if weight_tensor is None or weight_tensor.data_type != onnx_proto.TensorProto.FLOAT or \
+                len(weight_tensor.dims) != 2:
+            return None
+
+        weight = numpy_helper.to_array(weight_tensor)
+        k, n = weight.shape
+        packed, scales, zero_points = self.quantize_weight(weight)
+
+        b_name = weight_tensor.name + '_Q{}'.format(self.bits)
+        scales_name = weight_tensor.name + '_scales'
+        self.model.add_initializer(numpy_helper.from_array(packed, b_name))
+        self.model.add_initializer(numpy_helper.from_array(scales, scales_name))
+        inputs = [node.input[0], b_name, scales_name]
+        if zero_points is not None:
+            zero_points_name = weight_tensor.name + '_zero_points'
+            self.model.add_initializer(numpy_helper.from_array(zero_points, zero_points_name))
+            inputs.append(zero_points_name)
+
+        return helper.make_node('MatMulNBits', inputs, [node.output[0]],
+                                name=(node.name + '_Q{}'.format(self.bits)) if node.name else '',
+                                domain=ms_domain, K=k, N=n, bits=self.bits, block_size=self.block_size)
+
+    def process(self):
+        new_nodes = []
+        removed_nodes = []
+        for node in self.model.nodes():
+            if node.op_type != 'MatMul' or node.name in self.nodes_to_exclude:
+                continue
+            quantized_node = self._quantize_matmul(node)
+            if quantized_node is None:
+                logging.info('MatMul node {} is not quantized, its weight is not a constant 2D float tensor'.format(
+                    node.name))
+                continue
+            new_nodes.append(quantized_node)
+            removed_nodes.append(node)
+
+        self.model.remove_nodes(removed_nodes)
+        self.model.add_nodes(new_nodes)
+        self.model.remove_unused_constant()
+        self.model.topological_sort()
+
+        if not any(opset.domain == ms_domain for opset in self.model.opset_import()):
+            self.model.opset_import().extend([helper.make_opsetid(ms_domain, 1)])
+
+        return self.model.model
+
+
+def quantize_matmul_nbits(model_input: Path,
+                          model_output: Path,
+                          block_size=32,
+                          bits=4,
+                          is_symmetric=False,
+                          nodes_to_exclude=[],
+                          use_external_data_format=False):
+    '''
+        Given an onnx model, quantizes the constant weights of its MatMul nodes block-wise to 4 or 8 bits and
+        replaces those nodes by com.microsoft.MatMulNBits. This weight-only quantization mostly targets the memory
+        bound token generation of decoder models.
+    :param model_input: file path of model to quantize
+    :param model_output: file path of quantized model
+    :param block_size: number of weights along K sharing a scale and zero point, a power of 2 in [16, 256]
+    :param bits: 4 or 8
+    :param is_symmetric: if True, no zero points are stored and 2^(bits - 1) is used as zero point
+    :param nodes_to_exclude: list of MatMul node names to leave in float
+    :param use_external_data_format: option used for large size (>2GB) model. Set to False by default.
+    '''
+    model = load_model(Path(model_input), False)
+    quantizer = MatMulNBitsQuantizer(model, block_size, bits, is_symmetric, nodes_to_exclude)
+    quantizer.process()
+    quantizer.model.save_model_to_file(model_output, use_external_data_format)
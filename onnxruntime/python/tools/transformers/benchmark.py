@@ -35,7 +35,9 @@
         Run ONNXRuntime and TorchScript on CPU for all models with quantization:
             python benchmark.py -e torchscript onnxruntime -p "int8" -o
         Run OnnxRuntime with the ROCM provider and graph optimization script:
-            python benchmark.py -g -m bert-base-cased --provider rocm --optimizer_info by_script --disable_embed_layer_norm
+            python benchmark.py -g -m bert-base-cased --provider rocm --optimizer_info by_script
+        Compare with the CUDA provider on equivalent hardware, using the same fused graph:
+            python benchmark.py -g -m bert-base-cased --provider cuda --optimizer_info by_script
 
     It is recommended to use run_benchmark.sh to launch benchmark.
 """
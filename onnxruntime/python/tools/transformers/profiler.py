@@ -401,6 +401,45 @@ def group_node_results(sess_time, kernel_time_only, use_gpu):
     return lines
 
 
+def group_hardware_counters(sess_time):
+    """Group hardware counters by operator name. The counters are recorded when the session config entry
+    session.profiling_hardware_counters is set to 1.
+
+    Args:
+        sess_time (List[Dict]): profile data
+
+    Returns:
+        List[str]: lines of string for output. Empty if the profile has no hardware counters.
+    """
+    op_counters = {}
+    for item in sess_time:
+        if item["cat"] == "Node" and "args" in item and isinstance(item["args"].get("hardware_counters"), dict):
+            op_name = item["args"]["op_name"]
+            if op_name in NODES_TYPE_CONTAINING_SUBGRAPH:
+                continue
+            counters = op_counters.setdefault(op_name, {"cycles": 0, "instructions": 0, "llc_misses": 0})
+            for name in counters:
+                counters[name] += item["args"]["hardware_counters"][name]
+
+    if not op_counters:
+        return []
+
+    cache_line_size = 64
+    lines = ["", "Hardware counters grouped by operator"]
+    lines.append("-" * 64)
+    lines.append("Cycles\tInstructions\tIPC\tLLCMisses\tMPKI\tLLCMB\tOperator")
+    for op_name, counters in sorted(op_counters.items(), key=lambda x: x[1]["cycles"], reverse=True):
+        cycles = counters["cycles"]
+        instructions = counters["instructions"]
+        llc_misses = counters["llc_misses"]
+        ipc = instructions / cycles if cycles > 0 else 0.0
+        mpki = llc_misses * 1000.0 / instructions if instructions > 0 else 0.0
+        llc_mb = llc_misses * cache_line_size / 1e6
+        lines.append(f"{cycles:12d}\t{instructions:12d}\t{ipc:5.2f}\t{llc_misses:10d}\t{mpki:6.2f}\t{llc_mb:8.1f}\t{op_name}")
+
+    return lines
+
+
 def get_dim_from_type_proto(dim):
     return getattr(dim, dim.WhichOneof('value')) if type(dim.WhichOneof('value')) == str else None
 
@@ -581,6 +620,8 @@ def process_results(profile_file, args):
 
     lines += group_node_results(profile_records, args.kernel_time_only, args.use_gpu)
 
+    lines += group_hardware_counters(profile_records)
+
     return lines
 
 def run(args):
@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <thread>
+
+#include "core/common/hardware_counters.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+using profiling::HardwareCounters;
+using profiling::HardwareCounterValues;
+
+TEST(HardwareCountersTest, ScopesNest) {
+  EXPECT_EQ(HardwareCounters::Scope::Current(), nullptr);
+  {
+    HardwareCounters::Scope outer;
+    EXPECT_EQ(HardwareCounters::Scope::Current(), &outer);
+    {
+      HardwareCounters::Scope inner;
+      EXPECT_EQ(HardwareCounters::Scope::Current(), &inner);
+    }
+    EXPECT_EQ(HardwareCounters::Scope::Current(), &outer);
+  }
+  EXPECT_EQ(HardwareCounters::Scope::Current(), nullptr);
+}
+
+TEST(HardwareCountersTest, CountsEventsOfOtherThreads) {
+  // the counters are often not available, e.g. in VMs or with a restrictive perf_event_paranoid
+  HardwareCounterValues values;
+  const bool available = HardwareCounters::Read(values);
+
+  HardwareCounters::Scope scope;
+  volatile double sum = 0;
+  std::thread worker([&scope, &sum]() {
+    HardwareCounterValues start, end;
+    if (HardwareCounters::Read(start)) {
+      for (int i = 0; i < 100000; ++i) {
+        sum = sum + i;
+      }
+      ASSERT_TRUE(HardwareCounters::Read(end));
+      EXPECT_GT(end.instructions, start.instructions);
+      scope.Add({end.cycles - start.cycles, end.instructions - start.instructions, end.llc_misses - start.llc_misses});
+    }
+  });
+  worker.join();
+
+  const std::string counters = scope.Stop();
+  if (!available) {
+    EXPECT_TRUE(counters.empty());
+    return;
+  }
+
+  ASSERT_FALSE(counters.empty());
+  EXPECT_EQ(counters.front(), '{');
+  for (const char* name : {"\"cycles\"", "\"instructions\"", "\"llc_misses\""}) {
+    EXPECT_NE(counters.find(name), std::string::npos) << counters;
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -300,5 +300,31 @@ TEST_F(LoggingTestsFixture, TestStreamMacroFromConditionalWithoutCompoundStateme
   log_from_conditional_without_compound_statement(false);
 }
 
+/// <summary>
+/// Tests that the rate limited macros log the expected messages of each call site.
+/// </summary>
+TEST_F(LoggingTestsFixture, TestRateLimitedMacros) {
+  const std::string logger_id{"TestRateLimitedMacros"};
+  const Severity min_log_level = Severity::kINFO;
+  constexpr bool filter_user_data = false;
+
+  auto sink = std::make_unique<MockSink>();
+  // messages 0, 3, 6 and 9 of the EVERY_N call site and the first one of the EVERY_MS call site
+  EXPECT_CALL(*sink, SendImpl(testing::_, HasSubstr(logger_id), testing::Property(&Capture::Message, Eq("every 3"))))
+      .Times(4);
+  EXPECT_CALL(*sink, SendImpl(testing::_, HasSubstr(logger_id), testing::Property(&Capture::Message, Eq("every hour"))))
+      .Times(1);
+
+  LoggingManager manager{std::move(sink), min_log_level, filter_user_data, InstanceType::Temporal};
+  auto logger = manager.CreateLogger(logger_id, min_log_level, filter_user_data);
+
+  for (int i = 0; i < 10; ++i) {
+    LOGS_EVERY_N(*logger, INFO, 3) << "every 3";
+    LOGS_EVERY_MS(*logger, INFO, 3600 * 1000) << "every hour";
+    // disabled severity, not counted
+    LOGS_EVERY_N(*logger, VERBOSE, 1) << "verbose";
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
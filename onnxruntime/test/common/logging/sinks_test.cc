@@ -3,6 +3,7 @@
 
 #include "core/common/logging/capture.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
@@ -163,3 +164,67 @@ TEST(LoggingTests, TestCompositeSink) {
 
   LOGS_CATEGORY(*logger, WARNING, "ArbitraryCategory") << "Warning";
 }
+
+/// <summary>
+/// Tests that the async sink sends the messages to the wrapped sink in order.
+/// </summary>
+TEST(LoggingTests, TestAsyncSink) {
+  const std::string logid{"TestAsyncSink"};
+  const Severity min_log_level = Severity::kWARNING;
+
+  MockSink* sink_ptr = new MockSink();
+  {
+    testing::InSequence s{};
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_CALL(*sink_ptr, SendImpl(testing::_, testing::HasSubstr(logid),
+                                      testing::Property(&Capture::Message, testing::Eq(std::to_string(i)))))
+          .Times(1);
+    }
+  }
+
+  AsyncSink* sink = new AsyncSink(std::unique_ptr<ISink>{sink_ptr});
+  LoggingManager manager{std::unique_ptr<ISink>(sink), min_log_level, false, InstanceType::Temporal};
+
+  auto logger = manager.CreateLogger(logid);
+
+  for (int i = 0; i < 3; ++i) {
+    LOGS(*logger, WARNING) << i;
+  }
+
+  sink->Flush();
+  EXPECT_EQ(sink->DroppedMessages(), 0u);
+}
+
+/// <summary>
+/// Tests that the async sink drops the messages that don't fit in its buffer and reports them.
+/// </summary>
+TEST(LoggingTests, TestAsyncSinkDropsMessagesWhenFull) {
+  const std::string logid{"TestAsyncSinkDropsMessagesWhenFull"};
+  const Severity min_log_level = Severity::kWARNING;
+
+  MockSink* sink_ptr = new MockSink();
+  std::atomic<int> num_messages{0};
+  std::atomic<int> num_reports{0};
+  ON_CALL(*sink_ptr, SendImpl(testing::_, testing::_, testing::_))
+      .WillByDefault([&](const Timestamp&, const std::string& logger_id, const Capture&) {
+        ++(logger_id == "AsyncSink" ? num_reports : num_messages);
+      });
+  EXPECT_CALL(*sink_ptr, SendImpl(testing::_, testing::_, testing::_)).Times(testing::AnyNumber());
+
+  {
+    // an interval of an hour, the messages are only sent by Flush
+    AsyncSink* sink = new AsyncSink(std::unique_ptr<ISink>{sink_ptr}, 4, std::chrono::hours(1));
+    LoggingManager manager{std::unique_ptr<ISink>(sink), min_log_level, false, InstanceType::Temporal};
+    auto logger = manager.CreateLogger(logid);
+
+    for (int i = 0; i < 10; ++i) {
+      LOGS(*logger, WARNING) << i;
+    }
+
+    sink->Flush();
+    // the background thread may read a few messages when it starts, at least 4 of them fit in the buffer
+    EXPECT_GE(num_messages.load(), 4);
+    EXPECT_EQ(num_messages.load() + sink->DroppedMessages(), 10u);
+    EXPECT_EQ(num_reports.load(), sink->DroppedMessages() > 0 ? 1 : 0);
+  }
+}
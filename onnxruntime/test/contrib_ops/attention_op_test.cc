@@ -1683,6 +1683,130 @@ TEST(AttentionTest, AttentionPastState_dynamic) {
 }
 #endif //!defined(__wasm__)
 
+#ifdef USE_CUDA
+// Computes attention in float. Masked keys get -10000 added to their scores like the 2D raw mask does.
+static std::vector<float> ComputeAttentionReference(const std::vector<float>& input_data,
+                                                    const std::vector<float>& weight_data,
+                                                    const std::vector<float>& bias_data,
+                                                    const std::vector<int32_t>& raw_mask_data,
+                                                    int batch_size, int sequence_length, int hidden_size,
+                                                    int number_of_heads, bool is_unidirectional) {
+  const int head_size = hidden_size / number_of_heads;
+  const int qkv_size = 3 * hidden_size;
+
+  std::vector<float> qkv(static_cast<size_t>(batch_size) * sequence_length * qkv_size);
+  for (int row = 0; row < batch_size * sequence_length; row++) {
+    for (int col = 0; col < qkv_size; col++) {
+      float sum = bias_data[col];
+      for (int i = 0; i < hidden_size; i++) {
+        sum += input_data[row * hidden_size + i] * weight_data[i * qkv_size + col];
+      }
+      qkv[row * qkv_size + col] = sum;
+    }
+  }
+
+  std::vector<float> output(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  std::vector<float> scores(sequence_length);
+  const float scale = 1.0f / sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = &qkv[(b * sequence_length + s) * qkv_size + n * head_size];
+        float max_score = std::numeric_limits<float>::lowest();
+        for (int j = 0; j < sequence_length; j++) {
+          const float* k = &qkv[(b * sequence_length + j) * qkv_size + hidden_size + n * head_size];
+          float score = 0.0f;
+          for (int h = 0; h < head_size; h++) {
+            score += q[h] * k[h];
+          }
+          score *= scale;
+          if (is_unidirectional && j > s) {
+            score = -10000.0f;
+          }
+          if (!raw_mask_data.empty() && raw_mask_data[b * sequence_length + j] == 0) {
+            score += -10000.0f;
+          }
+          scores[j] = score;
+          max_score = std::max(max_score, score);
+        }
+
+        float sum = 0.0f;
+        for (int j = 0; j < sequence_length; j++) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum += scores[j];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          float value = 0.0f;
+          for (int j = 0; j < sequence_length; j++) {
+            value += scores[j] * qkv[(b * sequence_length + j) * qkv_size + 2 * hidden_size + n * head_size + h];
+          }
+          output[(b * sequence_length + s) * hidden_size + n * head_size + h] = value / sum;
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// Sequences over 1024 tokens use the memory efficient kernel for half precision on sm70+.
+static void RunAttentionLongSequenceTest(int batch_size, bool is_unidirectional, bool use_raw_mask) {
+  if (!HasCudaEnvironment(700)) {
+    return;
+  }
+
+  constexpr int sequence_length = 1040;
+  constexpr int hidden_size = 16;
+  constexpr int number_of_heads = 2;
+
+  std::vector<int64_t> input_dims{batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> weight_dims{hidden_size, 3 * hidden_size};
+  std::vector<int64_t> bias_dims{3 * hidden_size};
+
+  RandomValueGenerator random{};
+  std::vector<float> input_data = random.Gaussian<float>(input_dims, 0.0f, 0.3f);
+  std::vector<float> weight_data = random.Gaussian<float>(weight_dims, 0.0f, 0.3f);
+  std::vector<float> bias_data = random.Gaussian<float>(bias_dims, 0.0f, 0.3f);
+
+  // The last sequence of the batch is padded.
+  std::vector<int32_t> mask_index_data;
+  if (use_raw_mask) {
+    mask_index_data.resize(static_cast<size_t>(batch_size) * sequence_length, 1);
+    std::fill(mask_index_data.end() - sequence_length / 4, mask_index_data.end(), 0);
+  }
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, mask_index_data,
+                                                             batch_size, sequence_length, hidden_size,
+                                                             number_of_heads, is_unidirectional);
+
+  bool use_float16 = true;
+  bool use_past_state = false;
+  int past_sequence_length = 0;
+  const std::vector<float>* past_data = nullptr;
+  const std::vector<float>* present_data = nullptr;
+  int input_hidden_size = 0;
+  int max_sequence_length = 0;
+  bool only_enable_cuda = true;
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads,
+                   use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data,
+                   kMaskRaw, input_hidden_size, max_sequence_length, only_enable_cuda);
+}
+
+TEST(AttentionTest, AttentionLongSequence_Float16) {
+  RunAttentionLongSequenceTest(1, false, false);
+}
+
+TEST(AttentionTest, AttentionLongSequenceUnidirectional_Float16) {
+  RunAttentionLongSequenceTest(1, true, false);
+}
+
+TEST(AttentionTest, AttentionLongSequenceRawMask_Float16) {
+  RunAttentionLongSequenceTest(2, true, true);
+}
+#endif
+
 TEST(AttentionTest, AttentionPrunedModel) {
   int batch_size = 2;
   int sequence_length = 2;
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "contrib_ops/cpu/transformers/beam_search_shared.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Reorders a past state with one element per beam in each of key and value,
+// and checks against a gather into a new buffer.
+static void TestInPlaceBeamReorder(const std::vector<int32_t>& beam_indices) {
+  const size_t batch_beam_size = beam_indices.size();
+  const size_t block_size_per_beam = 3;
+  std::vector<float> state(2 * batch_beam_size * block_size_per_beam);
+  for (size_t i = 0; i < state.size(); i++) {
+    state[i] = static_cast<float>(i);
+  }
+
+  std::vector<float> expected(state.size());
+  for (size_t part = 0; part < 2; part++) {
+    for (size_t j = 0; j < batch_beam_size; j++) {
+      for (size_t k = 0; k < block_size_per_beam; k++) {
+        size_t offset = part * batch_beam_size * block_size_per_beam;
+        expected[offset + j * block_size_per_beam + k] = state[offset + beam_indices[j] * block_size_per_beam + k];
+      }
+    }
+  }
+
+  contrib::transformers::InPlaceBeamReorder reorder(beam_indices);
+  std::vector<float> scratch(reorder.ScratchSize(block_size_per_beam));
+  size_t num_copied = 0;
+  ASSERT_STATUS_OK(reorder.Apply(state.data(), block_size_per_beam, scratch.data(),
+                                 [&num_copied](float* target, const float* source, size_t elements) {
+                                   memcpy(target, source, elements * sizeof(float));
+                                   num_copied += elements;
+                                   return Status::OK();
+                                 }));
+  EXPECT_EQ(state, expected);
+  EXPECT_EQ(reorder.IsIdentity(), num_copied == 0);
+}
+
+TEST(BeamSearchTest, InPlaceBeamReorder) {
+  TestInPlaceBeamReorder({0, 1, 2, 3});
+  TestInPlaceBeamReorder({1, 0, 3, 2});
+  TestInPlaceBeamReorder({0, 0, 0, 0});
+  TestInPlaceBeamReorder({3, 3, 1, 1});
+  TestInPlaceBeamReorder({1, 2, 0, 2});
+  TestInPlaceBeamReorder({0, 1, 1, 3, 5, 5});
+}
+
+TEST(BeamSearchTest, InPlaceBeamReorderCopiesOnlyMovedBeams) {
+  // only beam 1 is overwritten and nothing reads it, so no scratch is needed
+  const std::vector<int32_t> beam_indices{0, 0, 2, 3};
+  contrib::transformers::InPlaceBeamReorder reorder(beam_indices);
+  EXPECT_FALSE(reorder.IsIdentity());
+  EXPECT_EQ(reorder.ScratchSize(10), 0u);
+
+  // beams 0 and 1 swap, each is read before it is overwritten
+  const std::vector<int32_t> swap_indices{1, 0, 2, 3};
+  contrib::transformers::InPlaceBeamReorder swap(swap_indices);
+  EXPECT_EQ(swap.ScratchSize(10), 2u * 2u * 10u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <random>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -69,5 +72,43 @@ TEST(CDistOpTest, DoubleEuclidean) {
   test.Run();
 }
 
+// Large enough for the kernel to split the rows of both inputs and of the output between threads.
+TEST(CDistOpTest, LargeEuclideanAndSqeuclidean) {
+  constexpr int64_t m = 301;
+  constexpr int64_t n = 257;
+  constexpr int64_t k = 70;
+
+  std::default_random_engine generator(7);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> a(m * k);
+  std::vector<float> b(n * k);
+  for (auto& value : a) value = distribution(generator);
+  for (auto& value : b) value = distribution(generator);
+
+  std::vector<float> sqeuclidean(m * n);
+  std::vector<float> euclidean(m * n);
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      double sum = 0.0;
+      for (int64_t l = 0; l < k; ++l) {
+        const double diff = static_cast<double>(a[i * k + l]) - b[j * k + l];
+        sum += diff * diff;
+      }
+      sqeuclidean[i * n + j] = static_cast<float>(sum);
+      euclidean[i * n + j] = static_cast<float>(std::sqrt(sum));
+    }
+  }
+
+  for (const auto& metric : {std::string("sqeuclidean"), std::string("euclidean")}) {
+    OpTester test("CDist", 1, onnxruntime::kMSDomain);
+    test.AddAttribute("metric", metric);
+    test.AddInput<float>("A", {m, k}, a);
+    test.AddInput<float>("B", {n, k}, b);
+    test.AddOutput<float>("y", {m, n}, metric == "euclidean" ? euclidean : sqeuclidean);
+    test.SetOutputAbsErr("y", 1e-3f);
+    test.Run();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Appends the keys and values of the new tokens to the cache, and computes unidirectional attention over it.
+static void ComputeDecoderMaskedSelfAttentionReference(const std::vector<float>& input_data,
+                                                       const std::vector<float>& weight_data,
+                                                       const std::vector<float>& bias_data,
+                                                       const std::vector<int32_t>& mask_data,
+                                                       int batch_size, int sequence_length, int hidden_size,
+                                                       int number_of_heads, int past_sequence_length,
+                                                       int max_sequence_length,
+                                                       std::vector<float>& present_data,
+                                                       std::vector<float>& output_data) {
+  const int head_size = hidden_size / number_of_heads;
+  const int qkv_size = 3 * hidden_size;
+  const int mask_sequence_length = past_sequence_length + sequence_length;
+
+  std::vector<float> qkv(static_cast<size_t>(batch_size) * sequence_length * qkv_size);
+  for (int row = 0; row < batch_size * sequence_length; row++) {
+    for (int col = 0; col < qkv_size; col++) {
+      float sum = bias_data[col];
+      for (int i = 0; i < hidden_size; i++) {
+        sum += input_data[row * hidden_size + i] * weight_data[i * qkv_size + col];
+      }
+      qkv[row * qkv_size + col] = sum;
+    }
+  }
+
+  auto cache_index = [&](int part, int b, int n, int position, int h) {
+    return (((static_cast<size_t>(part) * batch_size + b) * number_of_heads + n) * max_sequence_length + position) *
+               head_size +
+           h;
+  };
+
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      for (int n = 0; n < number_of_heads; n++) {
+        for (int h = 0; h < head_size; h++) {
+          const float* row = &qkv[(b * sequence_length + s) * qkv_size + n * head_size + h];
+          present_data[cache_index(0, b, n, past_sequence_length + s, h)] = row[hidden_size];
+          present_data[cache_index(1, b, n, past_sequence_length + s, h)] = row[2 * hidden_size];
+        }
+      }
+    }
+  }
+
+  output_data.assign(static_cast<size_t>(batch_size) * sequence_length * hidden_size, 0.0f);
+  const float scale = 1.0f / sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = &qkv[(b * sequence_length + s) * qkv_size + n * head_size];
+        const int key_count = past_sequence_length + s + 1;
+        std::vector<float> scores(key_count);
+        float max_score = std::numeric_limits<float>::lowest();
+        for (int j = 0; j < key_count; j++) {
+          float score = 0.0f;
+          for (int h = 0; h < head_size; h++) {
+            score += q[h] * present_data[cache_index(0, b, n, j, h)];
+          }
+          score *= scale;
+          if (!mask_data.empty() && mask_data[b * mask_sequence_length + j] == 0) {
+            score += -10000.0f;
+          }
+          scores[j] = score;
+          max_score = std::max(max_score, score);
+        }
+
+        float sum = 0.0f;
+        for (int j = 0; j < key_count; j++) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum += scores[j];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          float value = 0.0f;
+          for (int j = 0; j < key_count; j++) {
+            value += scores[j] * present_data[cache_index(1, b, n, j, h)];
+          }
+          output_data[(b * sequence_length + s) * hidden_size + n * head_size + h] = value / sum;
+        }
+      }
+    }
+  }
+}
+
+static void RunDecoderMaskedSelfAttentionTest(int batch_size, int sequence_length, int past_sequence_length,
+                                              bool use_mask, bool use_float16) {
+  if (!HasCudaEnvironment(use_float16 ? 530 : 0)) {
+    return;
+  }
+
+  constexpr int hidden_size = 64;
+  constexpr int number_of_heads = 2;
+  constexpr int max_sequence_length = 24;
+  const int head_size = hidden_size / number_of_heads;
+
+  std::vector<int64_t> input_dims{batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> weight_dims{hidden_size, 3 * hidden_size};
+  std::vector<int64_t> bias_dims{3 * hidden_size};
+  std::vector<int64_t> past_dims{2, batch_size, number_of_heads, max_sequence_length, head_size};
+  std::vector<int64_t> output_dims{batch_size, sequence_length, hidden_size};
+
+  RandomValueGenerator random{};
+  std::vector<float> input_data = random.Gaussian<float>(input_dims, 0.0f, 0.3f);
+  std::vector<float> weight_data = random.Gaussian<float>(weight_dims, 0.0f, 0.3f);
+  std::vector<float> bias_data = random.Gaussian<float>(bias_dims, 0.0f, 0.3f);
+  // Positions after past_sequence_length are not valid yet, and shall not be read by the kernel.
+  std::vector<float> past_data = random.Gaussian<float>(past_dims, 0.0f, 0.3f);
+
+  // The first token of the last sequence is padding.
+  std::vector<int32_t> mask_data;
+  const int mask_sequence_length = past_sequence_length + sequence_length;
+  if (use_mask) {
+    mask_data.resize(static_cast<size_t>(batch_size) * mask_sequence_length, 1);
+    mask_data[static_cast<size_t>(batch_size - 1) * mask_sequence_length] = 0;
+  }
+
+  std::vector<float> present_data = past_data;
+  std::vector<float> output_data;
+  ComputeDecoderMaskedSelfAttentionReference(input_data, weight_data, bias_data, mask_data,
+                                             batch_size, sequence_length, hidden_size, number_of_heads,
+                                             past_sequence_length, max_sequence_length, present_data, output_data);
+
+  OpTester tester("DecoderMaskedSelfAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
+    tester.AddInput<MLFloat16>("weight", weight_dims, ToFloat16(weight_data));
+    tester.AddInput<MLFloat16>("bias", bias_dims, ToFloat16(bias_data));
+  } else {
+    tester.AddInput<float>("input", input_dims, input_data);
+    tester.AddInput<float>("weight", weight_dims, weight_data);
+    tester.AddInput<float>("bias", bias_dims, bias_data);
+  }
+
+  if (use_mask) {
+    tester.AddInput<int32_t>("mask_index", {batch_size, mask_sequence_length}, mask_data);
+  } else {
+    tester.AddOptionalInputEdge<int32_t>();
+  }
+
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("past", past_dims, ToFloat16(past_data));
+  } else {
+    tester.AddInput<float>("past", past_dims, past_data);
+  }
+  tester.AddInput<int32_t>("past_sequence_length", {1}, {past_sequence_length});
+
+  if (use_float16) {
+    tester.AddOutput<MLFloat16>("output", output_dims, ToFloat16(output_data));
+    tester.AddOutput<MLFloat16>("present", past_dims, ToFloat16(present_data));
+  } else {
+    tester.AddOutput<float>("output", output_dims, output_data);
+    tester.AddOutput<float>("present", past_dims, present_data);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(DecoderMaskedSelfAttentionTest, Prompt) {
+  RunDecoderMaskedSelfAttentionTest(2, 5, 0, false, false);
+}
+
+TEST(DecoderMaskedSelfAttentionTest, SingleToken) {
+  RunDecoderMaskedSelfAttentionTest(2, 1, 9, false, false);
+}
+
+TEST(DecoderMaskedSelfAttentionTest, SingleTokenWithMask) {
+  RunDecoderMaskedSelfAttentionTest(3, 1, 9, true, false);
+}
+
+TEST(DecoderMaskedSelfAttentionTest, MultipleTokensWithMask) {
+  RunDecoderMaskedSelfAttentionTest(2, 3, 6, true, false);
+}
+
+TEST(DecoderMaskedSelfAttentionTest, SingleToken_Float16) {
+  RunDecoderMaskedSelfAttentionTest(2, 1, 22, true, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
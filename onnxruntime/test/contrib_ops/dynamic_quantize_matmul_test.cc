@@ -125,6 +125,87 @@ TEST(DynamicQuantizeMatMul, NoZeroPoint_HasBias_test) {
   RunDynamicQuantizeMatMulTest<uint8_t, false, true>("testdata/dynamic_quantize_matmul_uint8_bias.onnx");
 }
 
+// A is quantized row by row, the expected output is computed from the same quantized values.
+template <typename T>
+void TestDynamicQuantizeMatMulPerRow(const std::vector<int64_t>& A_dims,
+                                     const std::vector<int64_t>& B_dims,
+                                     bool is_matrix_b_constant,
+                                     bool per_column,
+                                     bool has_bias) {
+  RandomValueGenerator random{};
+
+  const int64_t K = B_dims[0];
+  const int64_t N = B_dims[1];
+  const int64_t rows = TensorShape(A_dims).Size() / K;
+
+  // rows with different ranges
+  std::vector<float> A_data = random.Uniform<float>(A_dims, -1.0f, 1.0f);
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t k = 0; k < K; k++) {
+      A_data[r * K + k] = A_data[r * K + k] * static_cast<float>(r + 1) + static_cast<float>(r % 3);
+    }
+  }
+
+  std::vector<int32_t> tmp_B_data = random.Uniform<int32_t>(B_dims, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+  std::vector<T> B_data(tmp_B_data.begin(), tmp_B_data.end());
+
+  const int64_t b_scale_zp_size = per_column ? N : 1;
+  std::vector<float> B_scale = random.Uniform<float>(std::vector<int64_t>{b_scale_zp_size}, 0.01f, 0.1f);
+  std::vector<int32_t> tmp_B_zero_point = random.Uniform<int32_t>(std::vector<int64_t>{b_scale_zp_size},
+                                                                  std::numeric_limits<T>::min() / 2,
+                                                                  std::numeric_limits<T>::max() / 2);
+  std::vector<T> B_zero_point(tmp_B_zero_point.begin(), tmp_B_zero_point.end());
+  std::vector<float> Bias = random.Uniform<float>(std::vector<int64_t>{N}, -0.1f, 0.1f);
+
+  std::vector<float> Y_data(static_cast<size_t>(rows * N));
+  for (int64_t r = 0; r < rows; r++) {
+    const float* a_row = A_data.data() + r * K;
+    const float min = std::min(0.0f, *std::min_element(a_row, a_row + K));
+    const float max = std::max(0.0f, *std::max_element(a_row, a_row + K));
+    const float a_scale = max == min ? 1.0f : (max - min) / 255.0f;
+    const int32_t a_zp = static_cast<int32_t>(std::nearbyint(std::max(0.0f, std::min(255.0f, -min / a_scale))));
+
+    for (int64_t n = 0; n < N; n++) {
+      const int64_t b_idx = per_column ? n : 0;
+      int32_t acc = 0;
+      for (int64_t k = 0; k < K; k++) {
+        const int32_t a_q = static_cast<int32_t>(std::max(0.0f, std::min(255.0f, std::nearbyint(a_row[k] / a_scale) + a_zp)));
+        acc += (a_q - a_zp) * (static_cast<int32_t>(B_data[k * N + n]) - static_cast<int32_t>(B_zero_point[b_idx]));
+      }
+      Y_data[r * N + n] = static_cast<float>(acc) * a_scale * B_scale[b_idx] + (has_bias ? Bias[n] : 0.0f);
+    }
+  }
+
+  std::vector<int64_t> Y_dims(A_dims);
+  Y_dims.back() = N;
+
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("quantize_a_per_row", 1);
+  test.AddInput<float>("A", A_dims, A_data);
+  test.AddInput<T>("B", B_dims, B_data, is_matrix_b_constant);
+  test.AddInput<float>("b_scale", {b_scale_zp_size}, B_scale);
+  test.AddInput<T>("b_zero_point", {b_scale_zp_size}, B_zero_point);
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, Bias);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+  test.AddOutput<float>("Y", Y_dims, Y_data);
+  test.SetOutputRelErr("Y", 1e-4f);
+  test.Run();
+}
+
+TEST(DynamicQuantizeMatMul, PerRowA) {
+  for (bool is_matrix_b_constant : {false, true}) {
+    for (bool per_column : {false, true}) {
+      TestDynamicQuantizeMatMulPerRow<uint8_t>({4, 128}, {128, 64}, is_matrix_b_constant, per_column, false);
+      TestDynamicQuantizeMatMulPerRow<int8_t>({4, 128}, {128, 64}, is_matrix_b_constant, per_column, true);
+      TestDynamicQuantizeMatMulPerRow<uint8_t>({2, 3, 40}, {40, 17}, is_matrix_b_constant, per_column, true);
+      TestDynamicQuantizeMatMulPerRow<int8_t>({2, 3, 40}, {40, 17}, is_matrix_b_constant, per_column, false);
+    }
+  }
+}
+
 TEST(DynamicQuantizeMatMul, UInt8_test_with_empty_input) {
   std::vector<int64_t> A_dims{0, 128};
   std::vector<int64_t> B_dims{128, 128};
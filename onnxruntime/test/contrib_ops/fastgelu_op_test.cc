@@ -259,5 +259,67 @@ TEST(FastGeluTest, FastGeluWithBias_BFloat16) {
 }
 #endif
 
+#ifdef USE_CUDA
+static void RunMatMulFastGeluTest(bool has_bias, bool use_float16) {
+  if (!HasCudaEnvironment(use_float16 ? 530 : 0)) {
+    return;
+  }
+
+  constexpr int64_t m = 3;
+  constexpr int64_t k = 4;
+  constexpr int64_t n = 5;
+
+  std::vector<float> a_data(m * k);
+  std::vector<float> b_data(k * n);
+  std::vector<float> bias_data(n);
+  for (size_t i = 0; i < a_data.size(); i++) a_data[i] = 0.1f * static_cast<float>(i % 7) - 0.3f;
+  for (size_t i = 0; i < b_data.size(); i++) b_data[i] = 0.05f * static_cast<float>(i % 5) - 0.1f;
+  for (size_t i = 0; i < bias_data.size(); i++) bias_data[i] = 0.2f * static_cast<float>(i) - 0.4f;
+
+  std::vector<float> product(m * n, 0.0f);
+  for (int64_t i = 0; i < m; i++) {
+    for (int64_t j = 0; j < n; j++) {
+      for (int64_t l = 0; l < k; l++) {
+        product[i * n + j] += a_data[i * k + l] * b_data[l * n + j];
+      }
+    }
+  }
+  std::vector<float> y_data = has_bias ? GetExpectedResult(product, bias_data) : ComputeGelu(product);
+
+  OpTester tester("MatMulFastGelu", 1, onnxruntime::kMSDomain);
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("A", {1, m, k}, ToFloat16(a_data));
+    tester.AddInput<MLFloat16>("B", {k, n}, ToFloat16(b_data));
+    if (has_bias) {
+      tester.AddInput<MLFloat16>("bias", {n}, ToFloat16(bias_data));
+    }
+    tester.AddOutput<MLFloat16>("Y", {1, m, n}, ToFloat16(y_data));
+  } else {
+    tester.AddInput<float>("A", {1, m, k}, a_data);
+    tester.AddInput<float>("B", {k, n}, b_data);
+    if (has_bias) {
+      tester.AddInput<float>("bias", {n}, bias_data);
+    }
+    tester.AddOutput<float>("Y", {1, m, n}, y_data);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MatMulFastGeluTest, MatMulFastGeluWithBias) {
+  RunMatMulFastGeluTest(true, false);
+}
+
+TEST(MatMulFastGeluTest, MatMulFastGeluWithoutBias) {
+  RunMatMulFastGeluTest(false, false);
+}
+
+TEST(MatMulFastGeluTest, MatMulFastGeluWithBias_Float16) {
+  RunMatMulFastGeluTest(true, true);
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Computes Sigmoid(Relu(0.25 - (bias + x * scale)) / divisor), the chain of the tests below.
+static std::vector<float> FusedElementwiseReference(const std::vector<float>& x, const std::vector<float>& bias,
+                                                    const std::vector<float>& divisor, float scale) {
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    float value = 0.25f - (bias[i] + x[i] * scale);
+    value = std::max(value, 0.0f) / divisor[i];
+    y[i] = 1.0f / (1.0f + std::exp(-value));
+  }
+  return y;
+}
+
+static void AddChainAttributes(OpTester& test) {
+  // inputs are x, scale, bias, offset and divisor
+  test.AddAttribute<std::vector<std::string>>("ops", {"Mul", "Add", "Sub", "Relu", "Div", "Sigmoid"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {1, 2, 3, -1, 4, -1});
+  test.AddAttribute<std::vector<int64_t>>("operand_first", {0, 1, 1, 0, 0, 0});
+}
+
+static void RunFusedElementwiseTest(const std::vector<int64_t>& dims, bool use_float16) {
+  RandomValueGenerator random{};
+  std::vector<float> x = random.Uniform<float>(dims, -1.0f, 1.0f);
+  std::vector<float> bias = random.Uniform<float>(dims, -1.0f, 1.0f);
+  std::vector<float> divisor = random.Uniform<float>(dims, 1.0f, 2.0f);
+  const float scale = 1.5f;
+
+  if (use_float16) {
+    // round the values that the operator sees
+    for (auto* values : {&x, &bias, &divisor}) {
+      std::vector<MLFloat16> half = ToFloat16(*values);
+      for (size_t i = 0; i < half.size(); i++) {
+        (*values)[i] = half[i].ToFloat();
+      }
+    }
+  }
+
+  std::vector<float> y = FusedElementwiseReference(x, bias, divisor, scale);
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  AddChainAttributes(test);
+
+  if (use_float16) {
+    test.AddInput<MLFloat16>("x", dims, ToFloat16(x));
+    test.AddInput<MLFloat16>("scale", {}, ToFloat16({scale}));
+    test.AddInput<MLFloat16>("bias", dims, ToFloat16(bias));
+    test.AddInput<MLFloat16>("offset", {1}, ToFloat16({0.25f}));
+    test.AddInput<MLFloat16>("divisor", dims, ToFloat16(divisor));
+    test.AddOutput<MLFloat16>("Y", dims, ToFloat16(y));
+    test.SetOutputAbsErr("Y", 0.005f);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCudaExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  } else {
+    test.AddInput<float>("x", dims, x);
+    test.AddInput<float>("scale", {}, {scale});
+    test.AddInput<float>("bias", dims, bias);
+    test.AddInput<float>("offset", {1}, {0.25f});
+    test.AddInput<float>("divisor", dims, divisor);
+    test.AddOutput<float>("Y", dims, y);
+    test.SetOutputAbsErr("Y", 1e-5f);
+    test.Run();
+  }
+}
+
+TEST(FusedElementwiseTest, Float) {
+  RunFusedElementwiseTest({7}, false);
+  RunFusedElementwiseTest({2, 3, 1000}, false);
+}
+
+#ifdef USE_CUDA
+TEST(FusedElementwiseTest, Float16) {
+  if (NeedSkipIfCudaArchLowerThan(530)) {
+    return;
+  }
+
+  RunFusedElementwiseTest({7}, true);
+  RunFusedElementwiseTest({2, 3, 1000}, true);
+}
+#endif
+
+TEST(FusedElementwiseTest, OperandShapeMismatch) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Relu"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {1, -1});
+  test.AddInput<float>("x", {2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<float>("y", {2}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "must have the shape of input 0");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
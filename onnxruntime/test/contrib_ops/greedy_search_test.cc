@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+#include <set>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "contrib_ops/cpu/transformers/sampling.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::IGreedySearchParameters;
+using contrib::transformers::TokenSampler;
+
+static IGreedySearchParameters GetSamplingParameters(bool do_sample, int top_k, float top_p) {
+  IGreedySearchParameters parameters{};
+  parameters.temperature = 1.0f;
+  parameters.do_sample = do_sample;
+  parameters.top_k = top_k;
+  parameters.top_p = top_p;
+  return parameters;
+}
+
+// log probabilities of a vocabulary of 6 tokens, the most likely is token 3, then token 1 and token 4.
+static const std::vector<float> kScores{-3.0f, -1.0f, -4.0f, -0.5f, -1.5f, -6.0f};
+
+TEST(GreedySearchTest, TokenSamplerSelectsArgMaxWithoutSampling) {
+  std::default_random_engine generator(0);
+  TokenSampler sampler(GetSamplingParameters(false, 0, 1.0f));
+  EXPECT_EQ(sampler.Select(kScores, generator), 3);
+  EXPECT_EQ(TokenSampler::ArgMax(kScores), 3);
+
+  const std::vector<float> topk_scores{-0.5f, -1.0f};
+  const std::vector<int32_t> topk_tokens{3, 1};
+  EXPECT_EQ(sampler.SelectFromTopK(topk_scores, topk_tokens, generator), 3);
+}
+
+TEST(GreedySearchTest, TokenSamplerTopKOneIsGreedy) {
+  std::default_random_engine generator(0);
+  TokenSampler sampler(GetSamplingParameters(true, 1, 1.0f));
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(sampler.Select(kScores, generator), 3);
+  }
+}
+
+TEST(GreedySearchTest, TokenSamplerSmallTopPIsGreedy) {
+  std::default_random_engine generator(0);
+  TokenSampler sampler(GetSamplingParameters(true, 0, 0.01f));
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(sampler.Select(kScores, generator), 3);
+  }
+}
+
+TEST(GreedySearchTest, TokenSamplerSamplesWithinTopK) {
+  std::default_random_engine generator(0);
+  TokenSampler sampler(GetSamplingParameters(true, 3, 1.0f));
+  std::set<int32_t> selected;
+  for (int i = 0; i < 200; i++) {
+    selected.insert(sampler.Select(kScores, generator));
+  }
+  EXPECT_EQ(selected, (std::set<int32_t>{1, 3, 4}));
+
+  // top_p keeps tokens 3 and 1 of the top 3, whose probabilities add up to about 0.51 and 0.81 of the top 3.
+  TokenSampler nucleus_sampler(GetSamplingParameters(true, 3, 0.8f));
+  selected.clear();
+  for (int i = 0; i < 200; i++) {
+    selected.insert(nucleus_sampler.Select(kScores, generator));
+  }
+  EXPECT_EQ(selected, (std::set<int32_t>{1, 3}));
+}
+
+TEST(GreedySearchTest, TokenSamplerSamplesWithinTopP) {
+  std::default_random_engine generator(0);
+  TokenSampler sampler(GetSamplingParameters(true, 0, 0.8f));
+  std::set<int32_t> selected;
+  for (int i = 0; i < 200; i++) {
+    selected.insert(sampler.Select(kScores, generator));
+  }
+  EXPECT_EQ(selected, (std::set<int32_t>{1, 3, 4}));
+}
+
+constexpr int64_t kDecoderVocabSize = 8;
+
+// A GPT-2 like decoder whose logits of token t are one-hot at token (t + 1) % vocab_size, so the greedy search
+// generates successive ids. The present state is the past state with the new input ids appended.
+//
+//   input_ids -> Gather(embedding) -> logits
+//   input_ids -> Cast -> Unsqueeze -> Concat(x2, axis 0) -> Concat(past_0, axis 3) -> present_0
+static GraphProto CreateDecoder() {
+  Model model("GreedySearch decoder", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto make_type = [](TensorProto_DataType elem_type, const std::vector<std::variant<int64_t, std::string>>& dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(elem_type);
+    auto* shape = type.mutable_tensor_type()->mutable_shape();
+    for (const auto& dim : dims) {
+      if (std::holds_alternative<int64_t>(dim)) {
+        shape->add_dim()->set_dim_value(std::get<int64_t>(dim));
+      } else {
+        shape->add_dim()->set_dim_param(std::get<std::string>(dim));
+      }
+    }
+    return type;
+  };
+
+  TypeProto ids_type = make_type(TensorProto_DataType_INT32, {"batch_size", "sequence_length"});
+  TypeProto mask_type = make_type(TensorProto_DataType_INT32, {"batch_size", "total_sequence_length"});
+  TypeProto past_type = make_type(TensorProto_DataType_FLOAT, {int64_t{2}, "batch_size", int64_t{1}, "past_sequence_length", int64_t{1}});
+  TypeProto present_type = make_type(TensorProto_DataType_FLOAT, {int64_t{2}, "batch_size", int64_t{1}, "total_sequence_length", int64_t{1}});
+  TypeProto logits_type = make_type(TensorProto_DataType_FLOAT, {"batch_size", "sequence_length", kDecoderVocabSize});
+
+  auto& input_ids = graph.GetOrCreateNodeArg("input_ids", &ids_type);
+  auto& position_ids = graph.GetOrCreateNodeArg("position_ids", &ids_type);
+  auto& attention_mask = graph.GetOrCreateNodeArg("attention_mask", &mask_type);
+  auto& past_0 = graph.GetOrCreateNodeArg("past_0", &past_type);
+  auto& logits = graph.GetOrCreateNodeArg("logits", &logits_type);
+  auto& present_0 = graph.GetOrCreateNodeArg("present_0", &present_type);
+
+  TensorProto embedding;
+  embedding.set_name("embedding");
+  embedding.set_data_type(TensorProto_DataType_FLOAT);
+  embedding.add_dims(kDecoderVocabSize);
+  embedding.add_dims(kDecoderVocabSize);
+  for (int64_t i = 0; i < kDecoderVocabSize; ++i) {
+    for (int64_t j = 0; j < kDecoderVocabSize; ++j) {
+      embedding.add_float_data(j == (i + 1) % kDecoderVocabSize ? 1.0f : 0.0f);
+    }
+  }
+  graph.AddInitializedTensor(embedding);
+
+  TensorProto axes;
+  axes.set_name("axes");
+  axes.set_data_type(TensorProto_DataType_INT64);
+  axes.add_dims(3);
+  for (int64_t axis : {0, 2, 4}) {
+    axes.add_int64_data(axis);
+  }
+  graph.AddInitializedTensor(axes);
+
+  auto& embedding_arg = graph.GetOrCreateNodeArg("embedding", nullptr);
+  auto& axes_arg = graph.GetOrCreateNodeArg("axes", nullptr);
+  auto& ids_float = graph.GetOrCreateNodeArg("ids_float", nullptr);
+  auto& new_state = graph.GetOrCreateNodeArg("new_state", nullptr);
+  auto& new_key_value = graph.GetOrCreateNodeArg("new_key_value", nullptr);
+
+  graph.AddNode("gather", "Gather", "Logits of the next token", {&embedding_arg, &input_ids}, {&logits});
+
+  auto& cast = graph.AddNode("cast", "Cast", "Input ids as float", {&input_ids}, {&ids_float});
+  cast.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+
+  graph.AddNode("unsqueeze", "Unsqueeze", "Input ids as (1, batch_size, 1, sequence_length, 1)",
+                {&ids_float, &axes_arg}, {&new_state});
+
+  auto& key_value = graph.AddNode("key_value", "Concat", "Key and value of the input ids",
+                                  {&new_state, &new_state}, {&new_key_value});
+  key_value.AddAttribute("axis", static_cast<int64_t>(0));
+
+  auto& present = graph.AddNode("present", "Concat", "Append to the past state",
+                                {&past_0, &new_key_value}, {&present_0});
+  present.AddAttribute("axis", static_cast<int64_t>(3));
+
+  graph.SetInputs({&input_ids, &position_ids, &attention_mask, &past_0});
+  graph.SetOutputs({&logits, &present_0});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  return graph.ToGraphProto();
+}
+
+static void RunGreedySearch(bool use_draft_decoder) {
+  OpTester test("GreedySearch", 1, kMSDomain);
+  test.AddAttribute<int64_t>("eos_token_id", 7);
+  test.AddAttribute<int64_t>("pad_token_id", 0);
+  test.AddAttribute("decoder", CreateDecoder());
+  if (use_draft_decoder) {
+    test.AddAttribute("draft_decoder", CreateDecoder());
+    test.AddAttribute<int64_t>("num_draft_tokens", 2);
+  }
+
+  test.AddInput<int32_t>("input_ids", {2, 2}, {0, 1, 4, 5});
+  test.AddInput<int32_t>("max_length", {1}, {6});
+
+  // The second sequence generates eos_token_id 7 and is padded afterwards.
+  test.AddOutput<int32_t>("sequences", {2, 6}, {0, 1, 2, 3, 4, 5,
+                                                4, 5, 6, 7, 0, 0});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(GreedySearchTest, GeneratesGreedyIds) {
+  RunGreedySearch(false);
+}
+
+TEST(GreedySearchTest, GeneratesGreedyIdsWithDraftDecoder) {
+  RunGreedySearch(true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
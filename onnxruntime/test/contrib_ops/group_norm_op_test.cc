@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Reference group normalization of a (N, C, H, W) or (N, H, W, C) input.
+static std::vector<float> GroupNormReference(const std::vector<float>& input, const std::vector<float>& gamma,
+                                             const std::vector<float>& beta, int64_t batch_size,
+                                             int64_t num_channels, int64_t image_size, int64_t groups,
+                                             float epsilon, bool channels_last, bool use_swish) {
+  std::vector<float> output(input.size());
+  const int64_t group_channels = num_channels / groups;
+
+  auto offset = [&](int64_t n, int64_t c, int64_t p) {
+    return channels_last ? (n * image_size + p) * num_channels + c : (n * num_channels + c) * image_size + p;
+  };
+
+  for (int64_t n = 0; n < batch_size; n++) {
+    for (int64_t g = 0; g < groups; g++) {
+      double sum = 0.0;
+      double sum_square = 0.0;
+      for (int64_t c = g * group_channels; c < (g + 1) * group_channels; c++) {
+        for (int64_t p = 0; p < image_size; p++) {
+          const double value = input[offset(n, c, p)];
+          sum += value;
+          sum_square += value * value;
+        }
+      }
+      const double count = static_cast<double>(group_channels * image_size);
+      const double mean = sum / count;
+      const double inv_std_dev = 1.0 / std::sqrt(sum_square / count - mean * mean + epsilon);
+
+      for (int64_t c = g * group_channels; c < (g + 1) * group_channels; c++) {
+        for (int64_t p = 0; p < image_size; p++) {
+          double value = (input[offset(n, c, p)] - mean) * inv_std_dev * gamma[c] + beta[c];
+          if (use_swish) {
+            value = value / (1.0 + std::exp(-value));
+          }
+          output[offset(n, c, p)] = static_cast<float>(value);
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+static void RunGroupNormTest(int64_t batch_size, int64_t num_channels, int64_t height, int64_t width,
+                             int64_t groups, bool channels_last, bool use_swish, bool use_float16) {
+  const float epsilon = 1e-5f;
+  const int64_t image_size = height * width;
+  std::vector<int64_t> input_dims = channels_last ? std::vector<int64_t>{batch_size, height, width, num_channels}
+                                                  : std::vector<int64_t>{batch_size, num_channels, height, width};
+
+  RandomValueGenerator random{};
+  std::vector<float> input = random.Uniform<float>(input_dims, -2.0f, 2.0f);
+  const std::vector<int64_t> channel_dims{num_channels};
+  std::vector<float> gamma = random.Uniform<float>(channel_dims, 0.5f, 1.5f);
+  std::vector<float> beta = random.Uniform<float>(channel_dims, -1.0f, 1.0f);
+
+  if (use_float16) {
+    // normalize the values that the operator sees
+    input = [](const std::vector<MLFloat16>& half) {
+      std::vector<float> values(half.size());
+      for (size_t i = 0; i < half.size(); i++) {
+        values[i] = half[i].ToFloat();
+      }
+      return values;
+    }(ToFloat16(input));
+  }
+
+  std::vector<float> output = GroupNormReference(input, gamma, beta, batch_size, num_channels, image_size, groups,
+                                                 epsilon, channels_last, use_swish);
+
+  OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("epsilon", epsilon);
+  test.AddAttribute<int64_t>("groups", groups);
+  test.AddAttribute<int64_t>("activation", use_swish ? 1 : 0);
+  test.AddAttribute<int64_t>("channels_last", channels_last ? 1 : 0);
+
+  if (use_float16) {
+    test.AddInput<MLFloat16>("X", input_dims, ToFloat16(input));
+    test.AddInput<float>("gamma", {num_channels}, gamma);
+    test.AddInput<float>("beta", {num_channels}, beta);
+    test.AddOutput<MLFloat16>("Y", input_dims, ToFloat16(output));
+    test.SetOutputAbsErr("Y", 0.01f);
+  } else {
+    test.AddInput<float>("X", input_dims, input);
+    test.AddInput<float>("gamma", {num_channels}, gamma);
+    test.AddInput<float>("beta", {num_channels}, beta);
+    test.AddOutput<float>("Y", input_dims, output);
+    test.SetOutputAbsErr("Y", 1e-4f);
+  }
+
+  test.Run();
+}
+
+TEST(GroupNormTest, ChannelsFirst) {
+  RunGroupNormTest(2, 32, 6, 5, 8, false, false, false);
+  RunGroupNormTest(1, 6, 3, 3, 3, false, false, false);
+}
+
+TEST(GroupNormTest, ChannelsLast) {
+  RunGroupNormTest(2, 32, 6, 5, 8, true, false, false);
+  RunGroupNormTest(1, 6, 3, 3, 3, true, false, false);
+}
+
+TEST(GroupNormTest, Swish) {
+  RunGroupNormTest(2, 64, 4, 4, 32, false, true, false);
+  RunGroupNormTest(2, 64, 4, 4, 32, true, true, false);
+}
+
+TEST(GroupNormTest, Float16) {
+  RunGroupNormTest(2, 32, 8, 8, 8, false, true, true);
+  RunGroupNormTest(2, 32, 8, 8, 8, true, false, true);
+}
+
+TEST(GroupNormTest, InvalidGroups) {
+  OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("groups", 5);
+  test.AddAttribute<int64_t>("channels_last", 0);
+  test.AddInput<float>("X", {1, 6, 1, 1}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("gamma", {6}, std::vector<float>(6, 1.0f));
+  test.AddInput<float>("beta", {6}, std::vector<float>(6, 0.0f));
+  test.AddOutput<float>("Y", {1, 6, 1, 1}, std::vector<float>(6, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is expected to be a multiple of groups");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Quantizes random weights block by block, then checks MatMulNBits against A x dequantize(B).
+void TestMatMulNBits(int64_t M, int64_t N, int64_t K, int64_t bits, int64_t block_size,
+                     bool has_zero_point, bool has_bias) {
+  RandomValueGenerator random{};
+
+  const int64_t block_count_k = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size * bits / 8;
+  const int64_t zero_point_column_bytes = (block_count_k * bits + 7) / 8;
+  // exclusive upper bound of the quantized values
+  const int32_t value_count = 1 << bits;
+
+  std::vector<float> a_data = random.Uniform<float>(std::vector<int64_t>{M, K}, -1.0f, 1.0f);
+  std::vector<float> scales = random.Uniform<float>(std::vector<int64_t>{N * block_count_k}, 0.01f, 0.1f);
+  std::vector<int32_t> values = random.Uniform<int32_t>(std::vector<int64_t>{N, block_count_k * block_size}, 0, value_count);
+  std::vector<int32_t> zero_point_values = random.Uniform<int32_t>(std::vector<int64_t>{N, block_count_k}, 0, value_count);
+  std::vector<float> bias = random.Uniform<float>(std::vector<int64_t>{N}, -1.0f, 1.0f);
+
+  std::vector<uint8_t> b_data(static_cast<size_t>(N * block_count_k * blob_size), 0);
+  std::vector<uint8_t> zero_points(static_cast<size_t>(N * zero_point_column_bytes), 0);
+  std::vector<float> b_dequantized(static_cast<size_t>(K * N));
+
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t block = 0; block < block_count_k; block++) {
+      int32_t zero_point = 1 << (bits - 1);
+      if (has_zero_point) {
+        zero_point = zero_point_values[n * block_count_k + block];
+        uint8_t& packed = zero_points[n * zero_point_column_bytes + block * bits / 8];
+        packed |= static_cast<uint8_t>(bits == 4 && (block & 1) ? zero_point << 4 : zero_point);
+      }
+
+      for (int64_t j = 0; j < block_size && block * block_size + j < K; j++) {
+        const int32_t value = values[n * block_count_k * block_size + block * block_size + j];
+        uint8_t* blob = b_data.data() + (n * block_count_k + block) * blob_size;
+        if (bits == 4) {
+          blob[j / 2] |= static_cast<uint8_t>((j & 1) ? value << 4 : value);
+        } else {
+          blob[j] = static_cast<uint8_t>(value);
+        }
+        b_dequantized[(block * block_size + j) * N + n] =
+            static_cast<float>(value - zero_point) * scales[n * block_count_k + block];
+      }
+    }
+  }
+
+  std::vector<float> expected(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = has_bias ? bias[n] : 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_data[m * K + k] * b_dequantized[k * N + n];
+      }
+      expected[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<float>("A", {M, K}, a_data);
+  test.AddInput<uint8_t>("B", {N, block_count_k, blob_size}, b_data, true);
+  test.AddInput<float>("scales", {N * block_count_k}, scales, true);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N * zero_point_column_bytes}, zero_points, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, bias, true);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+  test.AddOutput<float>("Y", {M, N}, expected);
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.Run();
+}
+
+TEST(MatMulNBits, Int4) {
+  for (int64_t block_size : {16, 32, 64, 128}) {
+    TestMatMulNBits(1, 1, 16, 4, block_size, false, false);
+    TestMatMulNBits(1, 72, 288, 4, block_size, true, false);
+    TestMatMulNBits(4, 40, 300, 4, block_size, false, true);
+    TestMatMulNBits(33, 17, 520, 4, block_size, true, true);
+  }
+}
+
+TEST(MatMulNBits, Int8) {
+  for (int64_t block_size : {32, 128}) {
+    TestMatMulNBits(1, 72, 288, 8, block_size, false, false);
+    TestMatMulNBits(4, 40, 300, 8, block_size, true, true);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
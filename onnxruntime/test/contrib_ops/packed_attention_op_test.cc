@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Attention of each sequence of the packed input, computed without any padding.
+static std::vector<float> ComputePackedAttentionReference(const std::vector<float>& input_data,
+                                                          const std::vector<float>& weight_data,
+                                                          const std::vector<float>& bias_data,
+                                                          const std::vector<int32_t>& cumulative_sequence_length,
+                                                          int hidden_size, int number_of_heads,
+                                                          bool is_unidirectional) {
+  const int token_count = cumulative_sequence_length.back();
+  const int head_size = hidden_size / number_of_heads;
+  const int qkv_size = 3 * hidden_size;
+
+  std::vector<float> qkv(static_cast<size_t>(token_count) * qkv_size);
+  for (int t = 0; t < token_count; t++) {
+    for (int col = 0; col < qkv_size; col++) {
+      float sum = bias_data[col];
+      for (int i = 0; i < hidden_size; i++) {
+        sum += input_data[t * hidden_size + i] * weight_data[i * qkv_size + col];
+      }
+      qkv[t * qkv_size + col] = sum;
+    }
+  }
+
+  std::vector<float> output(static_cast<size_t>(token_count) * hidden_size);
+  const float scale = 1.0f / sqrt(static_cast<float>(head_size));
+  for (size_t b = 0; b + 1 < cumulative_sequence_length.size(); b++) {
+    const int token_start = cumulative_sequence_length[b];
+    const int sequence_length = cumulative_sequence_length[b + 1] - token_start;
+    std::vector<float> scores(sequence_length);
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = &qkv[(token_start + s) * qkv_size + n * head_size];
+        float max_score = std::numeric_limits<float>::lowest();
+        for (int j = 0; j < sequence_length; j++) {
+          const float* k = &qkv[(token_start + j) * qkv_size + hidden_size + n * head_size];
+          float score = 0.0f;
+          for (int h = 0; h < head_size; h++) {
+            score += q[h] * k[h];
+          }
+          score *= scale;
+          if (is_unidirectional && j > s) {
+            score = -10000.0f;
+          }
+          scores[j] = score;
+          max_score = std::max(max_score, score);
+        }
+
+        float sum = 0.0f;
+        for (int j = 0; j < sequence_length; j++) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum += scores[j];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          float value = 0.0f;
+          for (int j = 0; j < sequence_length; j++) {
+            value += scores[j] * qkv[(token_start + j) * qkv_size + 2 * hidden_size + n * head_size + h];
+          }
+          output[(token_start + s) * hidden_size + n * head_size + h] = value / sum;
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+static void RunPackedAttentionTest(const std::vector<int32_t>& cumulative_sequence_length,
+                                   bool is_unidirectional,
+                                   bool use_float16) {
+  constexpr int hidden_size = 16;
+  constexpr int number_of_heads = 2;
+  const int token_count = cumulative_sequence_length.back();
+  const int batch_size = static_cast<int>(cumulative_sequence_length.size()) - 1;
+
+  bool enable_cuda = HasCudaEnvironment(use_float16 ? 530 : 0);
+  bool enable_cpu = (nullptr != DefaultCpuExecutionProvider().get()) && !use_float16;
+  if (!enable_cuda && !enable_cpu) {
+    return;
+  }
+
+  std::vector<int64_t> input_dims{token_count, hidden_size};
+  std::vector<int64_t> weight_dims{hidden_size, 3 * hidden_size};
+  std::vector<int64_t> bias_dims{3 * hidden_size};
+  std::vector<int64_t> cumulative_sequence_length_dims{batch_size + 1};
+  std::vector<int64_t> output_dims{token_count, hidden_size};
+
+  RandomValueGenerator random{};
+  std::vector<float> input_data = random.Gaussian<float>(input_dims, 0.0f, 0.3f);
+  std::vector<float> weight_data = random.Gaussian<float>(weight_dims, 0.0f, 0.3f);
+  std::vector<float> bias_data = random.Gaussian<float>(bias_dims, 0.0f, 0.3f);
+
+  std::vector<float> output_data = ComputePackedAttentionReference(input_data, weight_data, bias_data,
+                                                                   cumulative_sequence_length, hidden_size,
+                                                                   number_of_heads, is_unidirectional);
+
+  OpTester tester("PackedAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
+    tester.AddInput<MLFloat16>("weight", weight_dims, ToFloat16(weight_data));
+    tester.AddInput<MLFloat16>("bias", bias_dims, ToFloat16(bias_data));
+    tester.AddInput<int32_t>("cumulative_sequence_length", cumulative_sequence_length_dims,
+                             cumulative_sequence_length);
+    tester.AddOutput<MLFloat16>("output", output_dims, ToFloat16(output_data));
+  } else {
+    tester.AddInput<float>("input", input_dims, input_data);
+    tester.AddInput<float>("weight", weight_dims, weight_data);
+    tester.AddInput<float>("bias", bias_dims, bias_data);
+    tester.AddInput<int32_t>("cumulative_sequence_length", cumulative_sequence_length_dims,
+                             cumulative_sequence_length);
+    tester.AddOutput<float>("output", output_dims, output_data);
+  }
+
+  if (enable_cuda) {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCudaExecutionProvider());
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+
+  if (enable_cpu) {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
+TEST(PackedAttentionTest, VariableSequenceLength) {
+  RunPackedAttentionTest({0, 3, 10, 15}, false, false);
+}
+
+TEST(PackedAttentionTest, VariableSequenceLengthUnidirectional) {
+  RunPackedAttentionTest({0, 3, 10, 15}, true, false);
+}
+
+TEST(PackedAttentionTest, SingleSequence) {
+  RunPackedAttentionTest({0, 37}, false, false);
+}
+
+TEST(PackedAttentionTest, VariableSequenceLength_Float16) {
+  RunPackedAttentionTest({0, 5, 6, 40}, false, true);
+}
+
+TEST(PackedAttentionTest, VariableSequenceLengthUnidirectional_Float16) {
+  RunPackedAttentionTest({0, 5, 6, 40}, true, true);
+}
+
+TEST(PackedAttentionTest, InvalidCumulativeSequenceLength) {
+  constexpr int hidden_size = 4;
+  OpTester tester("PackedAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(2));
+  tester.AddInput<float>("input", {3, hidden_size}, std::vector<float>(3 * hidden_size, 0.1f));
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, std::vector<float>(3 * hidden_size * hidden_size, 0.1f));
+  tester.AddInput<float>("bias", {3 * hidden_size}, std::vector<float>(3 * hidden_size, 0.0f));
+  tester.AddInput<int32_t>("cumulative_sequence_length", {3}, {0, 2, 4});
+  tester.AddOutput<float>("output", {3, hidden_size}, std::vector<float>(3 * hidden_size, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "shall start with 0 and end with the token count", {}, nullptr,
+             &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -43,7 +43,9 @@ void RunQLinearMathTestFromFloat(
     const quantization::Params<T>& a_params,
     const std::vector<float>& b, const std::vector<int64_t>& b_shape_origin,
     const quantization::Params<T>& b_params,
-    const quantization::Params<T>& c_params) {
+    const quantization::Params<T>& c_params,
+    const quantization::Params<T>* leaky_relu_y_params = nullptr,
+    float leaky_relu_alpha = 0.01f) {
   const auto run_test = [&](bool input_b_is_initializer,
                             bool all_initializer_scale_zero_point) {
     size_t number_dims = std::max(a_shape_origin.size(), b_shape_origin.size());
@@ -81,6 +83,13 @@ void RunQLinearMathTestFromFloat(
 
     test.AddInput<float>("C_scale", {}, {c_params.scale}, all_initializer_scale_zero_point);
     test.template AddInput<T>("C_zero_point", {}, {c_params.zero_point}, all_initializer_scale_zero_point);
+    if (leaky_relu_y_params != nullptr) {
+      test.AddAttribute<std::string>("activation", "LeakyRelu");
+      test.AddAttribute("activation_alpha", leaky_relu_alpha);
+      test.AddInput<float>("Y_scale", {}, {leaky_relu_y_params->scale}, all_initializer_scale_zero_point);
+      test.template AddInput<T>("Y_zero_point", {}, {leaky_relu_y_params->zero_point},
+                                all_initializer_scale_zero_point);
+    }
     std::vector<T> c(c_size);
     for (int64_t offset = 0; offset < c_size; ++offset) {
       int64_t remain = offset, a_offset = 0, b_offset = 0;
@@ -94,6 +103,11 @@ void RunQLinearMathTestFromFloat(
       float a_dequantized = quantization::Dequantize(a_quantized[a_offset], a_params);
       float b_dequantized = quantization::Dequantize(b_quantized[b_offset], b_params);
       c[offset] = clampi<T>(static_cast<int>(std::nearbyintf(calc(a_dequantized, b_dequantized) / c_params.scale)) + c_params.zero_point, qmin, qmax);
+      if (leaky_relu_y_params != nullptr) {
+        float c_dequantized = quantization::Dequantize(c[offset], c_params);
+        float y = c_dequantized >= 0.0f ? c_dequantized : leaky_relu_alpha * c_dequantized;
+        c[offset] = clampi<T>(static_cast<int>(std::nearbyintf(y / leaky_relu_y_params->scale)) + leaky_relu_y_params->zero_point, qmin, qmax);
+      }
     }
 
     float abs_error = 0.0f;
@@ -114,7 +128,14 @@ void RunQLinearMathTestFromFloat(
 
     test.template AddOutput<T>("C", c_shape, c, false /* sort_output */, 0.0f /* rel_error */, abs_error);
 
-    test.Run();
+    if (leaky_relu_y_params != nullptr) {
+      // the activation attribute is only produced by the CPU graph optimizer
+      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    } else {
+      test.Run();
+    }
   };
 
   run_test(false /* input_b_is_initializer */, false /* all_initializer_scale_zero_point */);
@@ -556,5 +577,77 @@ TEST(QLinearBinaryOpTest, MulS8VectorScalarBroadcast) {
                               C_params);
 }
 
+TEST(QLinearBinaryOpTest, AddU8ChannelBroadcast) {
+  const std::vector<float>& A(A4Add);
+  float A_scale = 8.0f / 256.0f;
+  quantization::Params<uint8_t> A_params(A_scale, /*zero_point=*/128);
+  std::vector<float> B = {4.00f, 0.25f, -0.50f, -1.50f, 2.50f, -3.75f, 5.50f};
+  float B_scale = 8.0f / 256.0f;
+  quantization::Params<uint8_t> B_params(B_scale, /*zero_point=*/128);
+  float C_scale = 16.0f / 256.0f;
+  quantization::Params<uint8_t> C_params(C_scale, /*zero_point=*/128);
+
+  RunQLinearMathTestFromFloat("QLinearAdd", add_function,
+                              A, {3, 7, 3}, A_params,
+                              B, {7, 1}, B_params,
+                              C_params);
+  RunQLinearMathTestFromFloat("QLinearAdd", add_function,
+                              B, {7, 1}, B_params,
+                              A, {3, 7, 3}, A_params,
+                              C_params);
+}
+
+TEST(QLinearBinaryOpTest, MulS8ChannelBroadcast) {
+  const std::vector<float>& A(A4Add);
+  float A_scale = 8.0f / 256.0f;
+  quantization::Params<int8_t> A_params(A_scale, /*zero_point=*/0);
+  std::vector<float> B = {0.25f, -0.25f, -0.00f, 0.50f, 1.00f, -1.25f, 0.75f};
+  float B_scale = 2.0f / 256.0f;
+  quantization::Params<int8_t> B_params(B_scale, /*zero_point=*/16);
+  float C_scale = 8.0f / 256.0f;
+  quantization::Params<int8_t> C_params(C_scale, /*zero_point=*/10);
+
+  RunQLinearMathTestFromFloat("QLinearMul", mul_function,
+                              A, {3, 7, 3}, A_params,
+                              B, {1, 7, 1}, B_params,
+                              C_params);
+}
+
+TEST(QLinearBinaryOpTest, AddU8FusedLeakyRelu) {
+  const std::vector<float>& A(A4Add);
+  float A_scale = 8.0f / 256.0f;
+  quantization::Params<uint8_t> A_params(A_scale, /*zero_point=*/128);
+  const std::vector<float>& B(B4Add);
+  float B_scale = 8.0f / 256.0f;
+  quantization::Params<uint8_t> B_params(B_scale, /*zero_point=*/128);
+  float C_scale = 16.0f / 256.0f;
+  quantization::Params<uint8_t> C_params(C_scale, /*zero_point=*/128);
+  float Y_scale = 8.0f / 256.0f;
+  quantization::Params<uint8_t> Y_params(Y_scale, /*zero_point=*/64);
+
+  RunQLinearMathTestFromFloat("QLinearAdd", add_function,
+                              A, {63}, A_params,
+                              B, {63}, B_params,
+                              C_params, &Y_params, 0.25f);
+}
+
+TEST(QLinearBinaryOpTest, MulS8ChannelBroadcastFusedLeakyRelu) {
+  const std::vector<float>& A(A4Add);
+  float A_scale = 8.0f / 256.0f;
+  quantization::Params<int8_t> A_params(A_scale, /*zero_point=*/0);
+  std::vector<float> B = {0.25f, -0.25f, -0.00f};
+  float B_scale = 2.0f / 256.0f;
+  quantization::Params<int8_t> B_params(B_scale, /*zero_point=*/16);
+  float C_scale = 8.0f / 256.0f;
+  quantization::Params<int8_t> C_params(C_scale, /*zero_point=*/10);
+  float Y_scale = 4.0f / 256.0f;
+  quantization::Params<int8_t> Y_params(Y_scale, /*zero_point=*/-20);
+
+  RunQLinearMathTestFromFloat("QLinearMul", mul_function,
+                              A, {3, 7, 3}, A_params,
+                              B, {1, 1, 3}, B_params,
+                              C_params, &Y_params, 0.25f);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -336,6 +336,55 @@ TEST(QAttentionTest, QAttentionBatch1) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+TEST(QAttentionTest, QAttentionQuantizedScores) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f};
+
+  std::vector<float> weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f, 1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      0.5f, 0.1f, 0.4f, 1.6f, 1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      0.3f, 0.2f, 4.0f, 2.2f, 1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      0.2f, 0.1f, 0.4f, 1.6f, 2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  // same as QAttentionBatch1, the 8-bit Q/K/V and attention probabilities only cost some precision
+  std::vector<float> output_data = {
+      3.1495983600616455f, 0.10843668878078461f, 4.25f, 5.6499996185302734f,
+      3.9696791172027588f, 0.073143675923347473f, 4.2499995231628418f, 5.6499991416931152f};
+
+  quantization::Params<uint8_t> input_quant_params(/*scale=*/0.1f, /*zero_point=*/128);
+  quantization::Params<uint8_t> weight_quant_params(/*scale=*/0.1f, /*zero_point=*/128);
+
+  OpTester tester("QAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("quantize_attention_scores", 1);
+
+  tester.AddInput<uint8_t>("input", {batch_size, sequence_length, hidden_size},
+                           QuantizeTestVector<uint8_t>(input_data, input_quant_params));
+  tester.AddInput<uint8_t>("weight", {hidden_size, 3 * hidden_size},
+                           QuantizeTestVector<uint8_t>(weight_data, weight_quant_params));
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  tester.AddInput<float>("input_scale", {1}, {input_quant_params.scale});
+  tester.AddInput<float>("weight_scale", {1}, {weight_quant_params.scale});
+  tester.AddInput<int32_t>("mask_index", {batch_size}, {2});
+  tester.AddInput<uint8_t>("input_zero_point", {1}, {input_quant_params.zero_point});
+  tester.AddInput<uint8_t>("weight_zero_point", {1}, {weight_quant_params.zero_point});
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+  tester.SetOutputAbsErr("output", 0.1f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(QAttentionTest, QAttentionBatch1_Float16) {
   int batch_size = 1;
   int sequence_length = 2;
@@ -54,8 +54,7 @@ static void RunTest(
 
     test.AddOutput<float>("output", output_dims, output_data);
     test.Run();
-  } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/) ||
-             rocm_ep != nullptr) {
+  } else {
     OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
     test.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
     test.AddInput<MLFloat16>("skip", skip_dims, ToFloat16(skip_data));
@@ -63,7 +62,7 @@ static void RunTest(
     if (!no_beta) {
       test.AddInput<MLFloat16>("beta", beta_dims, ToFloat16(beta_data));
     } else {
-      test.AddOptionalInputEdge<float>();
+      test.AddOptionalInputEdge<MLFloat16>();
     }
     test.AddAttribute("epsilon", epsilon);
     if (!bias_data.empty()) {
@@ -75,9 +74,10 @@ static void RunTest(
     std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
     if (rocm_ep != nullptr) {
       execution_providers.push_back(DefaultRocmExecutionProvider());
-    } else {
+    } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/)) {
       execution_providers.push_back(DefaultCudaExecutionProvider());
     }
+    execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
@@ -79,6 +79,38 @@ TEST(InvokerTest, Inplace) {
   }
 }
 
+TEST(InvokerTest, ReuseCachedKernel) {
+  std::unique_ptr<IExecutionProvider> cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const std::string logger_id{"InvokerTest"};
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+      logging::Severity::kVERBOSE, false,
+      logging::LoggingManager::InstanceType::Default,
+      &logger_id);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+  IOnnxRuntimeOpSchemaRegistryList tmp_op_registry = {};
+  ORTInvoker kernel_invoker(std::move(cpu_execution_provider), env->GetLoggingManager()->DefaultLogger(), tmp_op_registry);
+  auto allocator = kernel_invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault);
+
+  // the second invocation reuses the kernel of the first one with different input values and shapes
+  std::vector<std::vector<int64_t>> dims = {{3, 2}, {2, 2}};
+  std::vector<std::vector<float>> values = {{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, {-1.0f, 0.5f, 7.0f, 10.0f}};
+  for (size_t run = 0; run < dims.size(); ++run) {
+    OrtValue A, B;
+    CreateMLValue<float>(allocator, dims[run], values[run], &A);
+    CreateMLValue<float>(allocator, dims[run], values[run], &B);
+    std::vector<OrtValue> result(1);
+    ASSERT_STATUS_OK(kernel_invoker.Invoke("Mul", {A, B}, result, nullptr));
+    const Tensor& C = result.back().Get<Tensor>();
+    EXPECT_EQ(C.Shape().GetDims(), gsl::make_span(dims[run]));
+    auto* c_data = C.Data<float>();
+    for (size_t i = 0; i < values[run].size(); ++i) {
+      EXPECT_EQ(c_data[i], values[run][i] * values[run][i]);
+    }
+  }
+}
+
 class TestKernel final : public OpKernel {
  public:
   TestKernel(const OpKernelInfo& info) : OpKernel(info) {}
@@ -4,7 +4,10 @@
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -298,5 +301,237 @@ TEST(BFCArenaTest, TestBackoffDoesntHang) {
   BFCArena a(std::unique_ptr<IAllocator>(new BadAllocator()), 10 * 1024 * 1024);
   EXPECT_THROW(a.Alloc(1024), OnnxRuntimeException) << "Arena should be unable to allocate memory";
 }
+
+TEST(BFCArenaTest, SmallAllocCache) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             ArenaSmallAllocCacheStrategy::kPerThreadCache);
+
+  std::vector<void*> ptrs;
+  for (int s = 1; s <= 4096; s += 63) {
+    void* raw = a.Alloc(s);
+    ASSERT_NE(raw, nullptr);
+    ASSERT_GE(a.AllocatedSize(raw), static_cast<size_t>(s));
+    std::memset(raw, 0xAB, s);
+    ptrs.push_back(raw);
+  }
+
+  // large allocations bypass the cache
+  void* large = a.Alloc(1 << 20);
+  ASSERT_EQ(a.RequestedSize(large), static_cast<size_t>(1 << 20));
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_small_alloc_cache_hits, static_cast<int64_t>(ptrs.size()));
+  EXPECT_EQ(stats.num_small_alloc_cache_misses, 0);
+  EXPECT_EQ(stats.num_allocs, static_cast<int64_t>(ptrs.size()) + 1);
+
+  std::sort(ptrs.begin(), ptrs.end());
+  for (size_t i = 1; i < ptrs.size(); i++) {
+    ASSERT_NE(ptrs[i], ptrs[i - 1]);
+    ASSERT_GE(static_cast<size_t>(static_cast<char*>(ptrs[i]) - static_cast<char*>(ptrs[i - 1])),
+              a.AllocatedSize(ptrs[i - 1]));
+  }
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+  a.Free(large);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, SmallAllocCacheFallsBackWhenExhausted) {
+  // a single slab for the cache
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             ArenaSmallAllocCacheStrategy::kPerThreadCache,
+             static_cast<int>(SmallAllocCache::kSlabSize));
+
+  const size_t blocks_per_slab = SmallAllocCache::kSlabSize / SmallAllocCache::kMaxBlockSize;
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < blocks_per_slab + 4; ++i) {
+    ptrs.push_back(a.Alloc(SmallAllocCache::kMaxBlockSize));
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_small_alloc_cache_hits, static_cast<int64_t>(blocks_per_slab));
+  EXPECT_EQ(stats.num_small_alloc_cache_misses, 4);
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, SmallAllocCacheMultiThreaded) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             ArenaSmallAllocCacheStrategy::kPerThreadCache);
+
+  // memory allocated on one thread is freed on another to exercise the depot
+  constexpr int kNumThreads = 4;
+  constexpr int kNumAllocs = 1000;
+  std::vector<std::vector<void*>> ptrs(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&a, &ptrs, t]() {
+      for (int i = 0; i < kNumAllocs; ++i) {
+        void* p = a.Alloc(static_cast<size_t>(8 + (i % 16) * 256));
+        *static_cast<int*>(p) = t;
+        ptrs[t].push_back(p);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&a, &ptrs, t]() {
+      for (void* p : ptrs[(t + 1) % kNumThreads]) {
+        EXPECT_EQ(*static_cast<int*>(p), (t + 1) % kNumThreads);
+        a.Free(p);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_small_alloc_cache_hits, kNumThreads * kNumAllocs);
+}
+
+static std::unique_ptr<BFCArena> CreateArenaWithShrinkPolicy(int idle_shrink_ms, size_t shrink_high_water_bytes) {
+  // kSameAsRequested so that each allocation below gets a region of its own, including the first one
+  return std::make_unique<BFCArena>(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+                                    ArenaExtendStrategy::kSameAsRequested,
+                                    BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+                                    BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+                                    BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+                                    BFCArena::DEFAULT_SMALL_ALLOC_CACHE_STRATEGY,
+                                    BFCArena::DEFAULT_SMALL_ALLOC_CACHE_BYTES,
+                                    BFCArena::DEFAULT_NUMA_NODE,
+                                    idle_shrink_ms,
+                                    shrink_high_water_bytes);
+}
+
+TEST(BFCArenaTest, IdleShrinkImmediately) {
+  auto a = CreateArenaWithShrinkPolicy(0, 0);
+
+  void* p1 = a->Alloc(1 << 20);
+  void* p2 = a->Alloc(2 << 20);
+  AllocatorStats stats;
+
+  // p2 is still in use, so nothing is freed
+  a->Free(p1);
+  a->GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 3 << 20);
+  EXPECT_EQ(stats.num_arena_shrinkages, 0);
+
+  a->Free(p2);
+  a->GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.num_arena_shrinkages, 2);
+
+  // the arena extends again for the next burst
+  void* p3 = a->Alloc(1 << 20);
+  a->GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  a->Free(p3);
+}
+
+TEST(BFCArenaTest, IdleShrinkAfterDelay) {
+  auto a = CreateArenaWithShrinkPolicy(20, 0);
+
+  a->Free(a->Alloc(1 << 20));
+
+  // poll as the shrink happens on the arena's thread
+  AllocatorStats stats;
+  for (int i = 0; i < 500; ++i) {
+    a->GetStats(&stats);
+    if (stats.total_allocated_bytes == 0) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+
+  // an allocation before the idle period ends cancels the shrink
+  auto b = CreateArenaWithShrinkPolicy(60 * 60 * 1000, 0);
+  b->Free(b->Alloc(1 << 20));
+  void* p = b->Alloc(1 << 20);
+  b->GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  EXPECT_EQ(stats.num_arena_shrinkages, 0);
+  b->Free(p);
+}
+
+TEST(BFCArenaTest, ShrinkAboveHighWaterMark) {
+  auto a = CreateArenaWithShrinkPolicy(-1, 3 << 20);
+
+  void* p1 = a->Alloc(2 << 20);
+  void* p2 = a->Alloc(2 << 20);
+  AllocatorStats stats;
+
+  // 4MB are allocated, above the 3MB high-water mark, so the region of p1 is freed
+  a->Free(p1);
+  a->GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 2 << 20);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+
+  // below the high-water mark the region is kept for reuse
+  a->Free(p2);
+  a->GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 2 << 20);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+}
+
+TEST(BFCArenaTest, HugePagesRoundRegions) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_SMALL_ALLOC_CACHE_STRATEGY,
+             BFCArena::DEFAULT_SMALL_ALLOC_CACHE_BYTES,
+             BFCArena::DEFAULT_NUMA_NODE,
+             BFCArena::DEFAULT_IDLE_SHRINK_MS,
+             BFCArena::DEFAULT_SHRINK_HIGH_WATER_BYTES,
+             true);
+
+  // the region is grown to a whole huge page, and the advice is only a hint so the memory is usable either way
+  void* p = a.Alloc(1 << 20);
+  ASSERT_NE(p, nullptr);
+  memset(p, 0, 1 << 20);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, static_cast<int64_t>(BFCArena::kHugePageSize));
+
+  // the next allocation fits in the remainder of the region
+  void* p2 = a.Alloc(1 << 20);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+  a.Free(p2);
+  a.Free(p);
+}
 }  // namespace test
 }  // namespace onnxruntime
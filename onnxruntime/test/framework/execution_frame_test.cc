@@ -301,6 +301,148 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+TEST_F(ExecutionFrameTest, MemPatternShapeBucketsTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def1("X1", &tensor_float),
+      input_def2("X2", &tensor_float),
+      input_def3("X3", &tensor_float),
+      gemm1_out_def("T1", &tensor_float),
+      gemm2_out_def("T2", &tensor_float),
+      clip_out_def("T3", &tensor_float);
+
+  graph.AddNode("node1", "MatMul", "gemm1", ArgMap{&input_def1, &input_def2}, ArgMap{&gemm1_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "MatMul", "gemm2", ArgMap{&gemm1_out_def, &input_def3}, ArgMap{&gemm2_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "Clip", "clip1", ArgMap{&gemm2_out_def}, ArgMap{&clip_out_def})
+      .SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState state(graph, execution_providers, true, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler);
+  state.SetMemoryPatternCacheOptions(/*use_shape_buckets*/ true, /*max_cached_patterns*/ 0);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+  int x1_idx = -1, x2_idx = -1, x3_idx = -1, t3_idx = -1;
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X1", x1_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X2", x2_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X3", x3_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T3", t3_idx));
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->GetAllocator(0, OrtMemTypeDefault);
+
+  // feeds with a sequence length of rows
+  auto create_feeds = [&](int64_t rows) {
+    std::vector<OrtValue> feeds(3);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{rows, 8}, std::vector<float>(static_cast<size_t>(rows * 8), 1.0f), &feeds[0]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{8, 8}, std::vector<float>(64, 1.0f), &feeds[1]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{8, 8}, std::vector<float>(64, 1.0f), &feeds[2]);
+    return feeds;
+  };
+
+  // allocates T1 and T2 with the given number of rows, in the same way as a run of the graph
+  auto allocate = [&](ExecutionFrame& frame, int64_t rows) -> std::pair<const void*, const void*> {
+    OrtValue& t1 = *frame.GetMutableNodeInputOrOutputMLValue(3);
+    OrtValue& t2 = *frame.GetMutableNodeInputOrOutputMLValue(4);
+    ORT_ENFORCE(frame.AllocateMLValueTensorSelfOwnBuffer(t1, 3, DataTypeImpl::GetType<float>(), cpu_allocator->Info(),
+                                                         TensorShape({rows, 8}))
+                    .IsOK());
+    ORT_ENFORCE(frame.AllocateMLValueTensorSelfOwnBuffer(t2, 4, DataTypeImpl::GetType<float>(), cpu_allocator->Info(),
+                                                         TensorShape({rows, 8}))
+                    .IsOK());
+    return {t1.Get<Tensor>().DataRaw(), t2.Get<Tensor>().DataRaw()};
+  };
+
+  // trace the pattern of a run with 32 rows
+  {
+    auto feeds = create_feeds(32);
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+    ASSERT_TRUE(frame.HasMemoryPatternPlanner());
+    allocate(frame, 32);
+    auto pattern = std::make_unique<MemoryPatternGroup>();
+    ASSERT_STATUS_OK(frame.GeneratePatterns(pattern.get()));
+    ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(feeds, std::move(pattern)));
+  }
+
+  // a run with 20 rows is in the same bucket and uses the pattern of 32 rows
+  {
+    auto feeds = create_feeds(20);
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+    ASSERT_FALSE(frame.HasMemoryPatternPlanner());
+    auto buffers = allocate(frame, 20);
+    EXPECT_EQ(static_cast<const char*>(buffers.second) - static_cast<const char*>(buffers.first),
+              static_cast<ptrdiff_t>(32 * 8 * sizeof(float)));
+  }
+
+  // a run with 40 rows is in the next bucket, which has no pattern yet
+  {
+    auto feeds = create_feeds(40);
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+    EXPECT_TRUE(frame.HasMemoryPatternPlanner());
+  }
+
+  // a run in the bucket that needs larger blocks than the pattern has makes the next run trace a larger pattern
+  {
+    auto feeds = create_feeds(24);
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+    ASSERT_FALSE(frame.HasMemoryPatternPlanner());
+    allocate(frame, 48);
+  }
+  {
+    auto feeds = create_feeds(24);
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+    ASSERT_TRUE(frame.HasMemoryPatternPlanner());
+    allocate(frame, 24);
+    auto pattern = std::make_unique<MemoryPatternGroup>();
+    ASSERT_STATUS_OK(frame.GeneratePatterns(pattern.get()));
+    // the blocks grow to the size of the allocations that outgrew the pattern
+    EXPECT_EQ(pattern->GetPatterns(cpu_allocator->Info())->GetBlock(3)->size_, 48 * 8 * sizeof(float));
+    EXPECT_EQ(pattern->GetPatterns(cpu_allocator->Info())->GetBlock(4)->size_, 48 * 8 * sizeof(float));
+    ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(feeds, std::move(pattern)));
+  }
+
+  // the run that outgrew the previous pattern is now served from the new one
+  {
+    auto feeds = create_feeds(24);
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+    ASSERT_FALSE(frame.HasMemoryPatternPlanner());
+    auto buffers = allocate(frame, 48);
+    EXPECT_EQ(static_cast<const char*>(buffers.second) - static_cast<const char*>(buffers.first),
+              static_cast<ptrdiff_t>(48 * 8 * sizeof(float)));
+  }
+  {
+    auto feeds = create_feeds(24);
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+    EXPECT_FALSE(frame.HasMemoryPatternPlanner());
+  }
+}
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
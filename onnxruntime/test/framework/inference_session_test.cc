@@ -6,8 +6,10 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <cmath>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <thread>
 #include <fstream>
 
@@ -52,6 +54,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 
@@ -488,6 +491,86 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, TestSessionCache) {
+  TemporaryDirectory cache_dir{ORT_TSTR("session_cache_test_dir")};
+  const string test_model = "testdata/transform/abs-id-max.onnx";
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestSessionCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSessionCacheDir,
+                                                    ToUTF8String(cache_dir.Path()).c_str()));
+
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  auto has_log_entry = [&capturing_sink](const std::string& text, size_t first_msg = 0) {
+    const auto& msgs = capturing_sink->Messages();
+    return std::any_of(msgs.begin() + first_msg, msgs.end(),
+                       [&text](const std::string& msg) { return msg.find(text) != string::npos; });
+  };
+
+  // runs the model, which computes the absolute value of its input, and returns its output
+  std::vector<float> input_values(24);
+  for (size_t i = 0; i < input_values.size(); ++i) {
+    input_values[i] = (i % 2 == 0 ? -1.f : 1.f) * static_cast<float>(i);
+  }
+  auto run_model = [&input_values](InferenceSession& session_object, std::vector<float>& output_values) {
+    OrtValue input;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3, 4}, input_values,
+                         &input);
+    NameMLValMap feeds{{"A", input}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"D"}, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    const auto& output = fetches[0].Get<Tensor>();
+    ASSERT_EQ(output.Shape(), TensorShape({2, 3, 4}));
+    output_values.assign(output.Data<float>(), output.Data<float>() + output.Shape().Size());
+  };
+
+  // the first session optimizes the model and populates the cache
+  std::vector<float> uncached_outputs;
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+    ASSERT_NO_FATAL_FAILURE(run_model(session_object, uncached_outputs));
+  }
+  ASSERT_TRUE(has_log_entry("Saved optimized model to session cache entry"));
+  ASSERT_FALSE(has_log_entry("Loaded optimized model from session cache entry"));
+
+  // a session with the same model and options loads the optimized model from the cache and computes the same outputs
+  std::vector<float> cached_outputs;
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+    ASSERT_NO_FATAL_FAILURE(run_model(session_object, cached_outputs));
+  }
+  ASSERT_TRUE(has_log_entry("Loaded optimized model from session cache entry"));
+  EXPECT_EQ(cached_outputs, uncached_outputs);
+  for (size_t i = 0; i < input_values.size(); ++i) {
+    EXPECT_EQ(uncached_outputs[i], std::abs(input_values[i]));
+  }
+
+  // different session options must not hit the existing entry
+  const size_t first_msg = capturing_sink->Messages().size();
+  so.graph_optimization_level = TransformerLevel::Default;
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_GT(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  }
+  ASSERT_FALSE(has_log_entry("Loaded optimized model from session cache entry", first_msg));
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -615,6 +698,59 @@ TEST(InferenceSessionTests, CheckRunLogger) {
 
 // WebAssembly will emit profiling data into console
 #if !defined(__wasm__)
+TEST(InferenceSessionTests, SessionMetrics) {
+  SessionOptions so;
+  so.session_logid = "SessionMetrics";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMetricsSamplingInterval, "2"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  std::string metrics;
+  ASSERT_STATUS_OK(session_object.GetMetrics(metrics));
+
+  // 4 runs, of which runs 0 and 2 are sampled
+  EXPECT_NE(metrics.find("\"runs\":4,\"sampling_interval\":2,\"run_latency\":{\"count\":2,"), std::string::npos)
+      << metrics;
+  EXPECT_NE(metrics.find("\"op_types\":{\"Mul\":{\"count\":2,"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("\"nodes\":{\"mul_1\":{\"op_type\":\"Mul\",\"count\":2,"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("\"allocators\":{"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find("\"intra_op_queued_tasks\":"), std::string::npos) << metrics;
+
+  // metrics are disabled by default
+  InferenceSession session_object_2(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(session_object_2.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object_2.Initialize());
+  ASSERT_FALSE(session_object_2.GetMetrics(metrics).IsOK());
+}
+
+TEST(InferenceSessionTests, LatencyHistogram) {
+  LatencyHistogram histogram;
+  histogram.Record(0);
+  histogram.Record(1);
+  histogram.Record(3);
+  histogram.Record(1000);
+  histogram.Record(std::numeric_limits<int64_t>::max());
+
+  EXPECT_EQ(histogram.Count(), 5u);
+  EXPECT_EQ(histogram.BucketCount(0), 1u);   // < 1us
+  EXPECT_EQ(histogram.BucketCount(1), 1u);   // [1, 2)
+  EXPECT_EQ(histogram.BucketCount(2), 1u);   // [2, 4)
+  EXPECT_EQ(histogram.BucketCount(10), 1u);  // [512, 1024)
+  EXPECT_EQ(histogram.BucketCount(LatencyHistogram::kNumBuckets - 1), 1u);
+
+  LatencyHistogram merged;
+  merged.Merge(histogram);
+  EXPECT_EQ(merged.Count(), histogram.Count());
+  EXPECT_EQ(merged.TotalMicroseconds(), histogram.TotalMicroseconds());
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   SessionOptions so;
 
@@ -707,6 +843,51 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
     count++;
   }
 }
+
+TEST(InferenceSessionTests, CheckRunProfilerWithRingBuffer) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_ring_buffer_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingRingBufferEvents, "4"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  auto read_lines = [](const std::string& file) {
+    std::ifstream profile(file);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(profile, line)) {
+      lines.push_back(line);
+    }
+    return lines;
+  };
+
+  // only the last 4 events are kept, the last one being the end of the second run
+  std::string dump_file = session_object.DumpProfiling();
+  ASSERT_TRUE(dump_file.find("_dump1.json") != string::npos);
+  auto lines = read_lines(dump_file);
+  ASSERT_EQ(lines.size(), 6u);
+  ASSERT_TRUE(lines[0].find("[") != string::npos);
+  ASSERT_TRUE(lines[4].find("model_run") != string::npos);
+  ASSERT_TRUE(lines[5].find("]") != string::npos);
+
+  // profiling goes on after a dump
+  ASSERT_TRUE(session_object.GetProfiling().IsEnabled());
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+  lines = read_lines(profile_file);
+  ASSERT_EQ(lines.size(), 6u);
+  ASSERT_TRUE(lines[4].find("model_run") != string::npos);
+}
 #endif  // __wasm__
 
 TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
@@ -952,6 +1133,52 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingRepeatedRuns) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  OrtValue input_A, input_B;
+  CreateMLValue<float>(allocator, {2, 2}, {1.f, 2.f, 3.f, 4.f}, &input_A);
+  CreateMLValue<float>(allocator, {2, 2}, {1.f, 0.f, 0.f, 1.f}, &input_B);
+  ASSERT_STATUS_OK(io_binding->BindInput("A", input_A));
+  ASSERT_STATUS_OK(io_binding->BindInput("B", input_B));
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y", OrtDevice()));
+
+  // the output allocated by the first run is reused by the following runs with the same shapes
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  VerifyOutputs(io_binding->GetOutputs(), {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  const void* output_data = io_binding->GetOutputs()[0].Get<Tensor>().DataRaw();
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  VerifyOutputs(io_binding->GetOutputs(), {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  EXPECT_EQ(io_binding->GetOutputs()[0].Get<Tensor>().DataRaw(), output_data);
+
+  // an output of another shape is allocated once the inputs change shape
+  OrtValue input_A2, input_B2;
+  CreateMLValue<float>(allocator, {1, 3}, {1.f, 2.f, 3.f}, &input_A2);
+  CreateMLValue<float>(allocator, {3, 1}, {4.f, 5.f, 6.f}, &input_B2);
+  ASSERT_STATUS_OK(io_binding->BindInput("A", input_A2));
+  ASSERT_STATUS_OK(io_binding->BindInput("B", input_B2));
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  VerifyOutputs(io_binding->GetOutputs(), {1, 1}, {32.f});
+
+  // an invalid input is still detected when it replaces a validated one
+  OrtValue input_int;
+  CreateMLValue<int64_t>(allocator, {1, 3}, {1, 2, 3}, &input_int);
+  ASSERT_STATUS_OK(io_binding->BindInput("A", input_int));
+  ASSERT_FALSE(session_object.Run(*io_binding).IsOK());
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -2614,6 +2841,166 @@ TEST(InferenceSessionTests, AllocatorSharing_EnsureSessionsDontUseSameOrtCreated
             sess2.GetSessionState().GetAllocator(mem_info).get());
 }
 
+// Ensure sessions share the pre-packed weights of constant initializers through the env by default, and that the
+// weights are freed once no session uses them.
+TEST(InferenceSessionTests, PrepackedWeightsSharing_EnsureSessionsShareEnvPrepackedWeights) {
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+  const PrepackedWeightsContainer& container = env->GetPrepackedWeightsContainer();
+
+  const ORTCHAR_T* model_uri = ORT_TSTR("testdata/matmul_1.onnx");
+
+  {
+    SessionOptions so1;
+    InferenceSessionWrapper sess1(so1, *env);
+    ASSERT_STATUS_OK(sess1.Load(model_uri));
+    ASSERT_STATUS_OK(sess1.Initialize());
+    ASSERT_EQ(sess1.GetSessionState().GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(sess1.GetSessionState().GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(0));
+    ASSERT_EQ(container.GetNumberOfElements(), static_cast<size_t>(1));
+
+    SessionOptions so2;
+    InferenceSessionWrapper sess2(so2, *env);
+    ASSERT_STATUS_OK(sess2.Load(model_uri));
+    ASSERT_STATUS_OK(sess2.Initialize());
+    ASSERT_EQ(sess2.GetSessionState().GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(sess2.GetSessionState().GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(container.GetNumberOfElements(), static_cast<size_t>(1));
+
+    // opting out keeps the pre-packed weights in the session
+    SessionOptions so3;
+    ASSERT_STATUS_OK(so3.config_options.AddConfigEntry(kOrtSessionOptionsConfigDisableEnvPrepackedWeightsSharing, "1"));
+    InferenceSessionWrapper sess3(so3, *env);
+    ASSERT_STATUS_OK(sess3.Load(model_uri));
+    ASSERT_STATUS_OK(sess3.Initialize());
+    ASSERT_EQ(sess3.GetSessionState().GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(sess3.GetSessionState().GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(0));
+  }
+
+  ASSERT_EQ(container.GetNumberOfElements(), static_cast<size_t>(0));
+}
+
+// Y = Relu(X * W) with X of shape [2, 3], or [batch, 3] if `static_shapes` is false
+static std::string SerializeMatMulReluModel(bool static_shapes) {
+  onnxruntime::Model model("matmul_relu", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* x_dim = x_type.mutable_tensor_type()->mutable_shape()->add_dim();
+  if (static_shapes) {
+    x_dim->set_dim_value(2);
+  } else {
+    x_dim->set_dim_param("batch");
+  }
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TensorProto w;
+  w.set_name("W");
+  w.set_data_type(TensorProto_DataType_FLOAT);
+  w.add_dims(3);
+  w.add_dims(2);
+  for (float value : {1.f, -1.f, 2.f, -2.f, 3.f, -3.f}) {
+    w.add_float_data(value);
+  }
+  graph.AddInitializedTensor(w);
+
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& w_arg = graph.GetOrCreateNodeArg("W", &float_type);
+  auto& xw = graph.GetOrCreateNodeArg("XW", &float_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_type);
+  graph.AddNode("matmul", "MatMul", "", {&x, &w_arg}, {&xw});
+  graph.AddNode("relu", "Relu", "", {&xw}, {&y});
+  EXPECT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  return serialized;
+}
+
+TEST(InferenceSessionTests, FreezeShapes) {
+  for (bool static_shapes : {true, false}) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigFreezeShapes, "1"));
+    InferenceSessionWrapper session{so, GetEnvironment()};
+    const std::string model_data = SerializeMatMulReluModel(static_shapes);
+    ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+    ASSERT_STATUS_OK(session.Initialize());
+    ASSERT_EQ(session.GetSessionState().HasFrozenShapes(), static_shapes);
+
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3},
+                         {1.f, 2.f, 3.f, -1.f, -2.f, -3.f}, &x);
+    // the second run uses the memory pattern planned from the frozen shapes
+    for (int run = 0; run < 2; ++run) {
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(session.Run(RunOptions(), {{"X", x}}, {"Y"}, &fetches));
+      VerifyOutputs(fetches, {2, 2}, {14.f, 0.f, 0.f, 14.f});
+    }
+  }
+}
+
+TEST(InferenceSessionTests, RunBatch) {
+  // the feeds of the requests are concatenated for the model with a batch dimension if that's enabled, and the
+  // requests run separately otherwise
+  for (bool static_shapes : {false, true}) {
+    for (bool enable_stacking : {false, true}) {
+      SessionOptions so;
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableBatchStacking,
+                                                        enable_stacking ? "1" : "0"));
+      InferenceSession session{so, GetEnvironment()};
+      const std::string model_data = SerializeMatMulReluModel(static_shapes);
+      ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+      ASSERT_STATUS_OK(session.Initialize());
+
+      auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+      OrtValue x1, x2;
+      CreateMLValue<float>(allocator, {2, 3}, {1.f, 2.f, 3.f, -1.f, -2.f, -3.f}, &x1);
+      CreateMLValue<float>(allocator, {2, 3}, {-1.f, -2.f, -3.f, 1.f, 2.f, 3.f}, &x2);
+
+      RunOptions run_options;
+      std::vector<std::vector<OrtValue>> fetches;
+      ASSERT_STATUS_OK(session.RunBatch(run_options, {"X"}, {{x1}, {x2}}, {"Y"}, fetches));
+      ASSERT_EQ(fetches.size(), 2u);
+      VerifyOutputs(fetches[0], {2, 2}, {14.f, 0.f, 0.f, 14.f});
+      VerifyOutputs(fetches[1], {2, 2}, {0.f, 14.f, 14.f, 0.f});
+    }
+  }
+}
+
+TEST(InferenceSessionTests, WarmUp) {
+  for (bool static_shapes : {true, false}) {
+    SessionOptions so;
+    InferenceSession session{so, GetEnvironment()};
+    const std::string model_data = SerializeMatMulReluModel(static_shapes);
+    ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    // without a shape, only the model with static shapes can be warmed up
+    auto status = session.WarmUp(RunOptions(), std::vector<std::unordered_map<std::string, TensorShape>>(1));
+    ASSERT_EQ(status.IsOK(), static_shapes) << status.ErrorMessage();
+    ASSERT_FALSE(session.WarmUp(RunOptions(), {{{"unknown", TensorShape({2, 3})}}}).IsOK());
+
+    if (!static_shapes) {
+      ASSERT_STATUS_OK(session.WarmUp(RunOptions(), {{{"X", TensorShape({1, 3})}}, {{"X", TensorShape({4, 3})}}}));
+    }
+
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3},
+                         {1.f, 2.f, 3.f, -1.f, -2.f, -3.f}, &x);
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions(), {{"X", x}}, {"Y"}, &fetches));
+    VerifyOutputs(fetches, {2, 2}, {14.f, 0.f, 0.f, 14.f});
+  }
+}
+
 class InferenceSessionTestSharingInitializer : public InferenceSessionWrapper {
  public:
   InferenceSessionTestSharingInitializer(const SessionOptions& session_options,
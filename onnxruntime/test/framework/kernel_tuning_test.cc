@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/framework/kernel_tuning.h"
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+class ScopedFileDeleter {
+ public:
+  explicit ScopedFileDeleter(std::string path) : path_(std::move(path)) { std::remove(path_.c_str()); }
+  ~ScopedFileDeleter() { std::remove(path_.c_str()); }
+
+ private:
+  std::string path_;
+};
+}  // namespace
+
+TEST(KernelTuningDatabaseTest, DisabledUntilOpened) {
+  KernelTuningDatabase database;
+  EXPECT_FALSE(database.IsEnabled());
+
+  const std::string path = "kernel_tuning_test_disabled.txt";
+  ScopedFileDeleter deleter(path);
+  ASSERT_STATUS_OK(database.Open(path));
+  EXPECT_TRUE(database.IsEnabled());
+
+  // Nothing was recorded, so no file is written.
+  ASSERT_STATUS_OK(database.Flush());
+  EXPECT_FALSE(std::ifstream(path).good());
+}
+
+TEST(KernelTuningDatabaseTest, TuneRecordsFastestVariant) {
+  const std::string path = "kernel_tuning_test_tune.txt";
+  ScopedFileDeleter deleter(path);
+
+  KernelTuningDatabase database;
+  ASSERT_STATUS_OK(database.Open(path));
+
+  // Variant 1 is made slower by doing more work.
+  std::vector<int> runs(2, 0);
+  volatile float sink = 0.0f;
+  auto run_variant = [&](int v) {
+    runs[v]++;
+    const int work = v == 1 ? 10000000 : 1;
+    for (int i = 0; i < work; i++) {
+      sink = sink + 1.0f;
+    }
+    return Status::OK();
+  };
+
+  int variant = -1;
+  ASSERT_STATUS_OK(database.Tune("cpu:test", "Kernel:shape", 2, run_variant, variant));
+  EXPECT_EQ(variant, 0);
+  EXPECT_GT(runs[0], 0);
+  EXPECT_GT(runs[1], 0);
+
+  // The recorded variant is reused without running the variants again.
+  runs.assign(2, 0);
+  variant = -1;
+  ASSERT_STATUS_OK(database.Tune("cpu:test", "Kernel:shape", 2, run_variant, variant));
+  EXPECT_EQ(variant, 0);
+  EXPECT_EQ(runs[0], 0);
+  EXPECT_EQ(runs[1], 0);
+}
+
+TEST(KernelTuningDatabaseTest, PersistsEntriesByDevice) {
+  const std::string path = "kernel_tuning_test_persist.txt";
+  ScopedFileDeleter deleter(path);
+
+  {
+    KernelTuningDatabase database;
+    ASSERT_STATUS_OK(database.Open(path));
+    database.Record("cpu:first", "Conv:X{1,32,8,8}", 1);
+    database.Record("cpu:second", "Conv:X{1,32,8,8}", 0);
+    ASSERT_STATUS_OK(database.Flush());
+  }
+
+  KernelTuningDatabase database;
+  ASSERT_STATUS_OK(database.Open(path));
+
+  int variant = -1;
+  ASSERT_TRUE(database.Lookup("cpu:first", "Conv:X{1,32,8,8}", variant));
+  EXPECT_EQ(variant, 1);
+  ASSERT_TRUE(database.Lookup("cpu:second", "Conv:X{1,32,8,8}", variant));
+  EXPECT_EQ(variant, 0);
+  EXPECT_FALSE(database.Lookup("cpu:third", "Conv:X{1,32,8,8}", variant));
+  EXPECT_FALSE(database.Lookup("cpu:first", "Conv:X{1,32,16,16}", variant));
+}
+
+TEST(KernelTuningDatabaseTest, InvalidFile) {
+  const std::string path = "kernel_tuning_test_invalid.txt";
+  ScopedFileDeleter deleter(path);
+  {
+    std::ofstream file(path);
+    file << "cpu:test\tConv\tfast\n";
+  }
+
+  KernelTuningDatabase database;
+  EXPECT_FALSE(database.Open(path).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
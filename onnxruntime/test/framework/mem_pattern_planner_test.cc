@@ -35,5 +35,33 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+TEST(MemPatternPlannerTest, OfflinePlannerTest) {
+  // block 2 doesn't fit in the gap freed by block 0 when it is allocated, but block 0 fits next to it.
+  auto trace = [](MemPatternPlanner& planner) {
+    planner.TraceAllocation(0, 100);
+    planner.TraceAllocation(1, 100);
+    planner.TraceFree(0);
+    planner.TraceAllocation(2, 200);
+    planner.TraceFree(1);
+    planner.TraceAllocation(3, 0);
+  };
+
+  MemPatternPlanner online_planner{false};
+  trace(online_planner);
+  auto pattern = online_planner.GenerateMemPattern();
+  EXPECT_EQ(pattern.PeakSize(), 400u);
+  EXPECT_EQ(pattern.LowerBoundSize(), 300u);
+
+  MemPatternPlanner offline_planner{false, /*offline*/ true};
+  trace(offline_planner);
+  pattern = offline_planner.GenerateMemPattern();
+  EXPECT_EQ(pattern.PeakSize(), 300u);
+  EXPECT_EQ(pattern.LowerBoundSize(), 300u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 200u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(3)->size_, 0u);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -448,6 +448,67 @@ TEST(TransformerTest, MemcpyTransformerTestImplicitInputConsumedOnMultipleDevice
   ASSERT_TRUE(op_count_map["MemcpyFromHost"] == 1);
 }
 
+TEST(TransformerTest, MemcpyTransformerRunsCheapNodesOnCpu) {
+  // A cheap Relu on CUDA between CPU nodes is run on CPU for its CPU consumer instead of copying its output to host
+  // memory. It is duplicated when a CUDA node also consumes its output, and moved to CPU otherwise.
+  for (bool with_cuda_consumer : {true, false}) {
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[kOnnxDomain] = 7;
+    auto model = std::make_shared<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                      IOnnxRuntimeOpSchemaRegistryList(),
+                                                      domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                      DefaultLoggingManager().DefaultLogger());
+    onnxruntime::Graph& graph = model->MainGraph();
+
+    TypeProto tensor_float_type;
+    tensor_float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    onnxruntime::NodeArg i1_def("I1", &tensor_float_type),
+        i2_def("I2", &tensor_float_type),
+        o1_def("O1", &tensor_float_type),
+        o2_def("O2", &tensor_float_type),
+        o3_def("O3", &tensor_float_type),
+        o4_def("O4", &tensor_float_type);
+
+    auto& node1 = graph.AddNode("node1", "MatMul", "cpu operator1", ArgMap{&i1_def, &i2_def}, ArgMap{&o1_def});
+    node1.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+    auto& node2 = graph.AddNode("node2", "Relu", "cheap gpu operator", ArgMap{&o1_def}, ArgMap{&o2_def});
+    node2.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+    auto& node3 = graph.AddNode("node3", "MatMul", "cpu operator2", ArgMap{&o2_def, &i2_def}, ArgMap{&o3_def});
+    node3.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+    if (with_cuda_consumer) {
+      auto& node4 = graph.AddNode("node4", "MatMul", "gpu operator", ArgMap{&o2_def, &o2_def}, ArgMap{&o4_def});
+      node4.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+    }
+
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    ExecutionProviders execution_providers;
+    ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCudaExecutionProvider, DefaultCudaExecutionProvider()));
+    ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCpuExecutionProvider,
+                                             std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+    KernelRegistryManager test_registry_manager;
+    ASSERT_STATUS_OK(test_registry_manager.RegisterKernels(execution_providers));
+
+    MemcpyTransformer transformer({onnxruntime::kCudaExecutionProvider}, test_registry_manager);
+
+    bool modified = false;
+    ASSERT_STATUS_OK(transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()));
+    EXPECT_TRUE(modified);
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    auto op_count_map = CountOpsInGraph(graph);
+    EXPECT_EQ(op_count_map["MemcpyToHost"], 0);
+    EXPECT_EQ(op_count_map["MemcpyFromHost"], with_cuda_consumer ? 1 : 0);
+    EXPECT_EQ(op_count_map["Relu"], with_cuda_consumer ? 2 : 1);
+
+    // node3 consumes the output of a Relu on CPU
+    const auto* relu = graph.GetProducerNode(graph.GetNode(node3.Index())->InputDefs()[0]->Name());
+    ASSERT_NE(relu, nullptr);
+    EXPECT_EQ(relu->OpType(), "Relu");
+    EXPECT_EQ(relu->GetExecutionProviderType(), onnxruntime::kCpuExecutionProvider);
+  }
+}
+
 #endif
 
 }  // namespace test
@@ -361,6 +361,34 @@ TEST(OrtModelOnlyTests, MetadataSerialization) {
   SaveAndCompareModels("testdata/model_with_metadata.onnx", ort_file);
 }
 
+#if !defined(ENABLE_TRAINING)
+// the MatMul weights of mnist are pre-packed, saved in the ORT format model and used instead of pre-packing them again
+TEST(OrtModelOnlyTests, SavePrePackedWeightsInOrtFormat) {
+  const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/mnist.onnx.prepacked.test_output.ort");
+
+  SessionOptions so;
+  so.session_logid = "SavePrePackedWeightsInOrtFormat";
+  so.optimized_model_filepath = ort_file;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSavePrePackedWeightsInOrtFormat, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_GT(session_object.GetSessionState().GetNumberOfPrepacksCounter(), static_cast<size_t>(0));
+  ASSERT_EQ(session_object.GetSessionState().GetUsedSavedPrePackedWeightCounter(), static_cast<size_t>(0));
+
+  SessionOptions so2;
+  so2.session_logid = "LoadPrePackedWeightsFromOrtFormat";
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load(ort_file));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+
+  CompareGraphAndSessionState(session_object, session_object2);
+  ASSERT_GT(session_object2.GetSessionState().GetUsedSavedPrePackedWeightCounter(), static_cast<size_t>(0));
+}
+#endif  // !defined(ENABLE_TRAINING)
+
 #if !defined(DISABLE_ML_OPS)
 TEST(OrtModelOnlyTests, SerializeToOrtFormatMLOps) {
   const std::basic_string<ORTCHAR_T> ort_file =
@@ -460,6 +488,22 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBufferNoCopy) {
   RunOrtModel(test_info);
 }
 
+// Map the model file and use its bytes for the initializers
+TEST(OrtModelOnlyTests, LoadOrtFormatModelUseBytesForInitializers) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "1"));
+  RunOrtModel(test_info);
+}
+
+// Use the buffer for the initializers, the buffer is alive until the session goes away
+TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBufferNoCopyUseBytesForInitializers) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.run_use_buffer = true;
+  test_info.disable_copy_ort_buffer = true;
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "1"));
+  RunOrtModel(test_info);
+}
+
 #if !defined(DISABLE_ML_OPS)
 // test that we can deserialize and run a previously saved ORT format model
 // for a model with sequence and map outputs
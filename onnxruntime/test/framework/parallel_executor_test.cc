@@ -1,10 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <sstream>
+
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
 #include "test_utils.h"
+#include "asserts.h"
 #include "core/session/inference_session.h"
 
 #include "gtest/gtest.h"
@@ -143,6 +148,60 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
   tester.Run(so, OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr);
 }
 
+// The output of the Identity node is consumed by several nodes that become ready at the same time. With a thread
+// pool size of 1 there is no inter op thread pool and the nodes run inline on the thread of the run.
+TEST_P(ParallelExecutorThreadPoolTest, TestBranchingGraph) {
+  onnxruntime::Model model("ParallelExecutorBranchingGraph", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& identity_out = graph.GetOrCreateNodeArg("identity_out", &float_tensor);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &float_tensor);
+  auto& neg_out = graph.GetOrCreateNodeArg("neg_out", &float_tensor);
+  auto& abs_out = graph.GetOrCreateNodeArg("abs_out", &float_tensor);
+  // x.x is a scalar that is broadcast by Sum
+  auto& matmul_out = graph.GetOrCreateNodeArg("matmul_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+
+  graph.AddNode("identity", "Identity", "", {&x}, {&identity_out});
+  graph.AddNode("relu", "Relu", "", {&identity_out}, {&relu_out});
+  graph.AddNode("neg", "Neg", "", {&identity_out}, {&neg_out});
+  graph.AddNode("abs", "Abs", "", {&identity_out}, {&abs_out});
+  // a heavy kernel ready together with the light ones
+  graph.AddNode("matmul", "MatMul", "", {&identity_out, &identity_out}, {&matmul_out});
+  graph.AddNode("sum", "Sum", "", {&relu_out, &neg_out, &abs_out, &matmul_out}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  onnxruntime::SessionOptions so;
+  so.session_logid = "TestBranchingGraph";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = GetParam();
+  InferenceSession session{so, GetEnvironment()};
+  std::stringstream model_stream(model_data);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2}, {-1.f, 2.f}, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+  std::vector<OrtValue> fetches;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_STATUS_OK(session.Run(feeds, {"Y"}, &fetches));
+    // relu(x) + neg(x) + abs(x) + x.x = {0 + 1 + 1 + 5, 2 - 2 + 2 + 5}
+    auto y_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y_values.size(), 2u);
+    EXPECT_EQ(y_values[0], 7.f);
+    EXPECT_EQ(y_values[1], 7.f);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
                          testing::Values(1, 0));
 }  // namespace test
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/pipeline_session.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "core/graph/model.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = X - Relu(X), with X consumed by the first and last stages:
+//   X -> Relu -> A -> Neg -> B -> Add(X, B) -> Y
+void SavePipelineModel(const PathString& model_file_name) {
+  onnxruntime::Model model("pipeline", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& a = graph.GetOrCreateNodeArg("A", &float_tensor);
+  auto& b = graph.GetOrCreateNodeArg("B", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("relu", "Relu", "stage 0", {&x}, {&a});
+  graph.AddNode("neg", "Neg", "stage 1", {&a}, {&b});
+  graph.AddNode("add", "Add", "stage 2", {&x, &b}, {&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+}
+
+PipelineSessionOptions ThreeStageOptions(int64_t micro_batch_size) {
+  PipelineSessionOptions options;
+  options.stages.resize(3);
+  options.stages[0].cut_values = {"A"};
+  options.stages[1].cut_values = {"B"};
+  options.micro_batch_size = micro_batch_size;
+  return options;
+}
+
+void RunAndCheck(PipelineSession& session, const std::vector<float>& x_values) {
+  const int64_t batch_size = static_cast<int64_t>(x_values.size() / 2);
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {batch_size, 2}, x_values,
+                       &x);
+
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions(), {{"X", x}}, {"Y"}, &fetches));
+  ASSERT_EQ(fetches.size(), 1u);
+
+  const Tensor& y = fetches[0].Get<Tensor>();
+  ASSERT_EQ(y.Shape(), TensorShape({batch_size, 2}));
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    EXPECT_FLOAT_EQ(y.Data<float>()[i], x_values[i] - std::max(x_values[i], 0.0f)) << i;
+  }
+}
+
+}  // namespace
+
+TEST(PipelineSessionTest, StagesAndMicroBatches) {
+  const PathString model_file_name = ORT_TSTR("pipeline_session_test.onnx");
+  SavePipelineModel(model_file_name);
+
+  std::unique_ptr<PipelineSession> session;
+  ASSERT_STATUS_OK(PipelineSession::Create(GetEnvironment(), model_file_name, ThreeStageOptions(2), session));
+  ASSERT_EQ(session->NumStages(), 3u);
+
+  // X skips the middle stage and is released after the last stage that uses it
+  EXPECT_THAT(session->GetStageInputNames(0), testing::ElementsAre("X"));
+  EXPECT_THAT(session->GetStageOutputNames(0), testing::ElementsAre("A"));
+  EXPECT_THAT(session->GetStageInputNames(1), testing::ElementsAre("A"));
+  EXPECT_THAT(session->GetStageOutputNames(1), testing::ElementsAre("B"));
+  EXPECT_THAT(session->GetStageInputNames(2), testing::ElementsAre("X", "B"));
+  EXPECT_THAT(session->GetStageOutputNames(2), testing::ElementsAre("Y"));
+
+  // 5 rows are run as 3 micro-batches, the last one being partial
+  RunAndCheck(*session, {-1.f, 2.f, 3.f, -4.f, 5.f, 6.f, -7.f, -8.f, 9.f, 10.f});
+  // a batch smaller than a micro-batch
+  RunAndCheck(*session, {-1.f, 1.f});
+}
+
+TEST(PipelineSessionTest, InvalidCuts) {
+  const PathString model_file_name = ORT_TSTR("pipeline_session_invalid_cuts_test.onnx");
+  SavePipelineModel(model_file_name);
+
+  std::unique_ptr<PipelineSession> session;
+  PipelineSessionOptions options = ThreeStageOptions(0);
+  options.stages[0].cut_values = {"X"};
+  auto status = PipelineSession::Create(GetEnvironment(), model_file_name, options, session);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("is not produced by a node"));
+
+  // B is already computed by the first stage, so the second one would be empty
+  options = ThreeStageOptions(0);
+  options.stages[0].cut_values = {"B"};
+  status = PipelineSession::Create(GetEnvironment(), model_file_name, options, session);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("has no nodes"));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
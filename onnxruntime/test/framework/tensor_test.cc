@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/TensorSeq.h"
 #include "test_utils.h"
 
 #include "gmock/gmock.h"
@@ -238,5 +239,26 @@ TEST(TensorTest, Strided) {
 }
 #endif
 
+TEST(TensorSeqTest, SharesTensors) {
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  TensorSeq seq(DataTypeImpl::GetType<float>());
+  seq.Add(Tensor(DataTypeImpl::GetType<float>(), TensorShape({2}), alloc));
+  seq.Add(Tensor(DataTypeImpl::GetType<float>(), TensorShape({3}), alloc));
+
+  // a sequence built from another one shares its tensors rather than copying them
+  TensorSeq other(seq.DataType());
+  for (size_t i = 0; i < seq.Size(); ++i) {
+    other.Add(seq.GetOrtValue(i));
+  }
+
+  ASSERT_EQ(other.Size(), 2u);
+  size_t i = 0;
+  for (const Tensor& tensor : other) {
+    EXPECT_EQ(tensor.DataRaw(), seq.Get(i).DataRaw());
+    EXPECT_EQ(tensor.Shape(), seq.Get(i).Shape());
+    ++i;
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -191,6 +191,47 @@ TEST(TensorProtoUtilsTest, UnpackTensorWithExternalData) {
   TestUnpackExternalTensor<bool>(TensorProto_DataType_BOOL, model_path);
 }
 
+TEST(TensorProtoUtilsTest, MapExternalDataTensorProtoToMLValue) {
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  TensorProto tensor_proto;
+  const auto test_data = CreateValues<float>();
+  CreateTensorWithExternalData<float>(TensorProto_DataType_FLOAT, test_data, filename, tensor_proto);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+
+  const OrtMemoryInfo cpu_memory_info(CPU, OrtDeviceAllocator);
+
+  {
+    OrtValue value;
+    OrtCallback deleter{nullptr, nullptr};
+    ASSERT_STATUS_OK(MapExternalDataTensorProtoToMLValue(Env::Default(), nullptr, tensor_proto, cpu_memory_info,
+                                                         value, deleter));
+    OrtCallbackInvoker deleter_invoker{deleter};
+
+    const Tensor& tensor = value.Get<Tensor>();
+    ASSERT_EQ(tensor.Shape().Size(), static_cast<int64_t>(test_data.size()));
+    ASSERT_EQ(tensor.Location().device, cpu_memory_info.device);
+    const auto* data = tensor.Data<float>();
+    for (size_t i = 0; i < test_data.size(); ++i) {
+      ASSERT_EQ(data[i], test_data[i]);
+    }
+  }
+
+  // the data can only be used in place if it is suitably aligned
+  onnx::StringStringEntryProto* offset = tensor_proto.mutable_external_data()->Add();
+  offset->set_key("offset");
+  offset->set_value("4");
+  tensor_proto.set_dims(0, static_cast<int64_t>(test_data.size()) - 1);
+  {
+    OrtValue value;
+    OrtCallback deleter{nullptr, nullptr};
+    ASSERT_FALSE(MapExternalDataTensorProtoToMLValue(Env::Default(), nullptr, tensor_proto, cpu_memory_info,
+                                                     value, deleter)
+                     .IsOK());
+    ASSERT_EQ(deleter.f, nullptr);
+  }
+}
+
 template <typename T>
 static NodeProto CreateConstantNode(const std::string& attrib_name, AttributeProto_AttributeType type,
                                     std::function<void(AttributeProto&)> add_data) {
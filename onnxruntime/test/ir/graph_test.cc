@@ -1487,6 +1487,119 @@ TEST_F(GraphTest, GraphConstruction_TypeInference) {
   EXPECT_EQ("node_4_out_1", graph_proto.output(0).name());
 }
 
+// Only the modified node, and the nodes downstream of it whose inputs changed, are inferred.
+TEST_F(GraphTest, ResolveOnlyInferModifiedNodes) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  // x -> id_1 -> a -> id_2 -> b -> id_3 -> c
+  // x -> id_4 -> d
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& a = graph.GetOrCreateNodeArg("a", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("b", nullptr);
+  auto& c = graph.GetOrCreateNodeArg("c", nullptr);
+  auto& d = graph.GetOrCreateNodeArg("d", nullptr);
+  auto& id_1 = graph.AddNode("id_1", "Identity", "", {&x}, {&a});
+  graph.AddNode("id_2", "Identity", "", {&a}, {&b});
+  graph.AddNode("id_3", "Identity", "", {&b}, {&c});
+  graph.AddNode("id_4", "Identity", "", {&x}, {&d});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto* node_arg : {&a, &b, &c, &d}) {
+    ASSERT_NE(node_arg->Shape(), nullptr);
+    node_arg->ClearShape();
+  }
+
+  graph.SetNodeModified(id_1.Index());
+  graph.SetGraphResolveNeeded();
+  Graph::ResolveOptions options;
+  options.only_infer_modified_nodes = true;
+  ASSERT_STATUS_OK(graph.Resolve(options));
+
+  for (auto* node_arg : {&a, &b, &c}) {
+    ASSERT_NE(node_arg->Shape(), nullptr) << node_arg->Name();
+    ASSERT_EQ(node_arg->Shape()->dim_size(), 2);
+    EXPECT_EQ(node_arg->Shape()->dim(0).dim_value(), 2);
+    EXPECT_EQ(node_arg->Shape()->dim(1).dim_value(), 3);
+  }
+  EXPECT_EQ(d.Shape(), nullptr);
+
+  // a full Resolve infers all the nodes
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_NE(d.Shape(), nullptr);
+}
+
+TEST_F(GraphTest, SymbolicShapeInference) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("sequence");
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(768);
+
+  TypeProto tensor_int64;
+  tensor_int64.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  auto add_initializer = [&](const std::string& name, int64_t value) -> NodeArg& {
+    TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(TensorProto_DataType_INT64);
+    tensor.add_dims(1);
+    tensor.add_int64_data(value);
+    graph.AddInitializedTensor(tensor);
+    return graph.GetOrCreateNodeArg(name, &tensor_int64);
+  };
+
+  // y = Reshape(x, [batch * sequence, 768]) and z = Reshape(y, [batch, -1]), with the shapes computed from Shape(x)
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& zero = add_initializer("zero", 0);
+  auto& one = add_initializer("one", 1);
+  auto& hidden_size = add_initializer("hidden_size", 768);
+  auto& minus_one = add_initializer("minus_one", -1);
+  auto& shape = graph.GetOrCreateNodeArg("shape", nullptr);
+  auto& batch = graph.GetOrCreateNodeArg("batch", nullptr);
+  auto& sequence = graph.GetOrCreateNodeArg("sequence", nullptr);
+  auto& tokens = graph.GetOrCreateNodeArg("tokens", nullptr);
+  auto& y_shape = graph.GetOrCreateNodeArg("y_shape", nullptr);
+  auto& z_shape = graph.GetOrCreateNodeArg("z_shape", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  auto& z = graph.GetOrCreateNodeArg("z", nullptr);
+
+  graph.AddNode("shape", "Shape", "", {&x}, {&shape});
+  graph.AddNode("gather_batch", "Gather", "", {&shape, &zero}, {&batch});
+  graph.AddNode("gather_sequence", "Gather", "", {&shape, &one}, {&sequence});
+  graph.AddNode("mul", "Mul", "", {&batch, &sequence}, {&tokens});
+  graph.AddNode("concat_y", "Concat", "", {&tokens, &hidden_size}, {&y_shape}).AddAttribute("axis", int64_t{0});
+  graph.AddNode("concat_z", "Concat", "", {&batch, &minus_one}, {&z_shape}).AddAttribute("axis", int64_t{0});
+  graph.AddNode("reshape_y", "Reshape", "", {&x, &y_shape}, {&y});
+  graph.AddNode("reshape_z", "Reshape", "", {&y, &z_shape}, {&z});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const auto* shape_value = graph.GetSymbolicShapeValue("y_shape", false);
+  ASSERT_NE(shape_value, nullptr);
+  ASSERT_EQ(shape_value->dim_size(), 2);
+  EXPECT_EQ(shape_value->dim(0).dim_param(), "batch*sequence");
+  EXPECT_EQ(shape_value->dim(1).dim_value(), 768);
+
+  ASSERT_NE(y.Shape(), nullptr);
+  ASSERT_EQ(y.Shape()->dim_size(), 2);
+  EXPECT_EQ(y.Shape()->dim(0).dim_param(), "batch*sequence");
+  EXPECT_EQ(y.Shape()->dim(1).dim_value(), 768);
+
+  ASSERT_NE(z.Shape(), nullptr);
+  ASSERT_EQ(z.Shape()->dim_size(), 2);
+  EXPECT_EQ(z.Shape()->dim(0).dim_param(), "batch");
+  EXPECT_EQ(z.Shape()->dim(1).dim_param(), "768*sequence");
+}
+
 TEST_F(GraphTest, ShapeInferenceErrorHandling) {
   Model model("graph", false, *logger_);
   auto& graph = model.MainGraph();
@@ -1748,6 +1861,32 @@ TEST_F(GraphTest, ReplaceInitializedTensor) {
   }
 }
 
+TEST_F(GraphTest, ReleaseInitializedTensorData) {
+  Model model{"GraphUpdateTest", false, *logger_};
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TensorProto initializer{};
+  initializer.set_name("initializer");
+  initializer.set_data_type(TensorProto_DataType_FLOAT);
+  initializer.add_dims(2);
+  initializer.add_float_data(1.f);
+  initializer.add_float_data(2.f);
+  graph.AddInitializedTensor(initializer);
+
+  graph.ReleaseInitializedTensorData(initializer.name());
+  // unknown names are ignored
+  graph.ReleaseInitializedTensorData("unknown");
+
+  // the name, type and shape are kept, and the data is gone
+  const ONNX_NAMESPACE::TensorProto* result = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor(initializer.name(), result));
+  EXPECT_EQ(result->data_type(), TensorProto_DataType_FLOAT);
+  ASSERT_EQ(result->dims_size(), 1);
+  EXPECT_EQ(result->dims(0), 2);
+  EXPECT_EQ(result->float_data_size(), 0);
+  EXPECT_FALSE(result->has_raw_data());
+}
+
 TEST_F(GraphTest, AddRemoveInitializerHandling) {
   Model m{"test_model", false, *logger_};
   Graph& graph = m.MainGraph();
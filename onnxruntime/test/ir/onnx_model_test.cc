@@ -4,12 +4,14 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <memory>
 #include "core/platform/env.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
 #include "core/session/onnxruntime_c_api.h"
 #include "test/providers/provider_test_utils.h"  //For ASSERT_STATUS_OK
 #include "test/test_environment.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "onnx/defs/function.h"
 #include "onnx/defs/parser.h"
@@ -189,6 +191,69 @@ TEST_F(ONNXModelsTest, TestModelsWithAnOpContainingAFunctionBody) {
   ASSERT_STATUS_OK(model->MainGraph().Resolve());
 }
 
+// The in-memory external data location is only created by ORT when it loads an ORT format model. A model file that
+// uses it must not be able to make ORT read from an address of its choice.
+TEST_F(ONNXModelsTest, RejectInMemoryExternalDataLocation) {
+  const char* code = R"ONNX(
+<
+  ir_version: 8,
+  opset_import: [ "" : 13]
+>
+agraph (float[4] x) => (float[4] y)
+{
+    y = Add(x, w)
+}
+)ONNX";
+
+  const float data[4] = {1.f, 2.f, 3.f, 4.f};
+  auto add_tensor_with_data_in_memory = [&data](TensorProto& tensor, const std::string& name) {
+    tensor.set_name(name);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.add_dims(4);
+    tensor.set_data_location(TensorProto_DataLocation_EXTERNAL);
+    auto add_external_data = [&tensor](const std::string& key, const std::string& value) {
+      auto* entry = tensor.add_external_data();
+      entry->set_key(key);
+      entry->set_value(value);
+    };
+    add_external_data("location", ToUTF8String(utils::kTensorProtoMemoryAddressTag));
+    add_external_data("offset", std::to_string(reinterpret_cast<intptr_t>(data)));
+    add_external_data("length", std::to_string(sizeof(data)));
+  };
+
+  // as an initializer
+  {
+    ModelProto model_proto;
+    ONNX_NAMESPACE::OnnxParser parser(code);
+    ASSERT_TRUE(parser.Parse(model_proto).IsOK());
+    add_tensor_with_data_in_memory(*model_proto.mutable_graph()->add_initializer(), "w");
+
+    std::shared_ptr<Model> model;
+    auto status = Model::Load(std::move(model_proto), model, nullptr, *logger_);
+    ASSERT_FALSE(status.IsOK());
+    EXPECT_THAT(status.ErrorMessage(), ::testing::HasSubstr("invalid external data location"));
+  }
+
+  // as the value of a Constant node
+  {
+    ModelProto model_proto;
+    ONNX_NAMESPACE::OnnxParser parser(code);
+    ASSERT_TRUE(parser.Parse(model_proto).IsOK());
+    auto* constant = model_proto.mutable_graph()->add_node();
+    constant->set_op_type("Constant");
+    constant->add_output("w");
+    auto* value = constant->add_attribute();
+    value->set_name("value");
+    value->set_type(AttributeProto_AttributeType_TENSOR);
+    add_tensor_with_data_in_memory(*value->mutable_t(), "w");
+
+    std::shared_ptr<Model> model;
+    auto status = Model::Load(std::move(model_proto), model, nullptr, *logger_);
+    ASSERT_FALSE(status.IsOK());
+    EXPECT_THAT(status.ErrorMessage(), ::testing::HasSubstr("invalid external data location"));
+  }
+}
+
 // The following tests verify ORT can successfully load models which reference functions
 // present in the ModelProto aka model local functions. This feature was added to ONNX standard starting IRv8
 
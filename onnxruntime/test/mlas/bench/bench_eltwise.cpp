@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+#include <memory>
+
+static const std::vector<std::string> eltwise_arg_names = {"Outer", "Channels", "Inner", "Threads"};
+
+// Benchmarks the broadcast of a bias over a tensor as done by Add for [N, C, H, W] + [C, 1, 1].
+void EltwiseChannelBroadcast(benchmark::State& state) {
+  const size_t outer = static_cast<size_t>(state.range(0));
+  const size_t channels = static_cast<size_t>(state.range(1));
+  const size_t inner = static_cast<size_t>(state.range(2));
+  const size_t threads = static_cast<size_t>(state.range(3));
+
+  if (outer == 0 || channels == 0 || inner == 0 || threads == 0) {
+    throw std::invalid_argument("all dimensions must be greater than 0!");
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+      tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto input = RandomVectorUniform(outer * channels * inner, -1.0f, 1.0f);
+  auto bias = RandomVectorUniform(channels, -1.0f, 1.0f);
+  std::vector<float> output(input.size());
+
+  // warm up first round.
+  MlasEltwiseChannelBroadcast(MlasEltwiseAdd, input.data(), bias.data(), output.data(), outer, channels, inner,
+                              false, tp.get());
+
+  for (auto _ : state) {
+    MlasEltwiseChannelBroadcast(MlasEltwiseAdd, input.data(), bias.data(), output.data(), outer, channels, inner,
+                                false, tp.get());
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size() * 2 * sizeof(float)));
+}
+
+static void ConvBiasShapes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(eltwise_arg_names);
+  for (int64_t threads : {1, 4}) {
+    b->Args({1, 64, 112 * 112, threads});  // ResNet50 stem, NCHW
+    b->Args({1, 256, 56 * 56, threads});
+    b->Args({1, 2048, 7 * 7, threads});
+    b->Args({1, 960, 7 * 7, threads});     // MobileNetV2 head
+    b->Args({56 * 56, 256, 1, threads});   // channels last
+    b->Args({128, 768, 1, threads});       // BERT bias
+  }
+}
+
+BENCHMARK(EltwiseChannelBroadcast)->Apply(ConvBiasShapes)->UseRealTime();
@@ -1,6 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+// Results can be saved in a machine readable form with --benchmark_out=<file> --benchmark_out_format=json
+// and compared between builds with the compare.py tool of Google Benchmark. On x64, the environment
+// variable MLAS_MAXIMUM_ISA (sse2, avx, avx2, avxvnni, avx512f, avx512core, avx512vnni or amx) caps the
+// kernels MLAS selects, so that the kernels of older processors can be measured on a newer one.
+
 #include <benchmark/benchmark.h>
 
 BENCHMARK_MAIN();
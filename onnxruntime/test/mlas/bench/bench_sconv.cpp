@@ -222,6 +222,24 @@ static void TeamsModel(benchmark::internal::Benchmark* b) {
 
 BENCHMARK_CAPTURE(SCONV_NCHW, TeamsModel, "")->Apply(TeamsModel)->UseRealTime();
 
+static void MobileNetV2(benchmark::internal::Benchmark* b) {
+  b->ArgNames(ArgNamesForConv(2));
+  //    Rank, N,  G, Cpg, Fpg,  I,   , K, , P, , , , S, , D, ,
+  b->Args({2, 1,   1,   3,  32,224,224, 3,3, 1,1,1,1, 2,2, 1,1}); // stem
+  b->Args({2, 1,  32,   1,   1,112,112, 3,3, 1,1,1,1, 1,1, 1,1}); // depthwise
+  b->Args({2, 1,   1,  32,  16,112,112, 1,1, 0,0,0,0, 1,1, 1,1}); // project
+  b->Args({2, 1,   1,  16,  96,112,112, 1,1, 0,0,0,0, 1,1, 1,1}); // expand
+  b->Args({2, 1,  96,   1,   1,112,112, 3,3, 1,1,1,1, 2,2, 1,1}); // depthwise, stride 2
+  b->Args({2, 1, 144,   1,   1, 56, 56, 3,3, 1,1,1,1, 1,1, 1,1});
+  b->Args({2, 1,   1, 144,  24, 56, 56, 1,1, 0,0,0,0, 1,1, 1,1});
+  b->Args({2, 1, 384,   1,   1, 14, 14, 3,3, 1,1,1,1, 1,1, 1,1});
+  b->Args({2, 1,   1, 384,  64, 14, 14, 1,1, 0,0,0,0, 1,1, 1,1});
+  b->Args({2, 1, 960,   1,   1,  7,  7, 3,3, 1,1,1,1, 1,1, 1,1});
+  b->Args({2, 1,   1, 320,1280,  7,  7, 1,1, 0,0,0,0, 1,1, 1,1}); // head
+}
+
+BENCHMARK_CAPTURE(SCONV_NCHW, MobileNetV2, "")->Apply(MobileNetV2)->UseRealTime();
+
 static void General_Conv2d(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
   ArgsProduct(
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+#include <memory>
+#include <numeric>
+
+static const std::vector<std::string> nchwc_conv_arg_names = {"N", "G", "Cpg", "Fpg", "H", "W", "KH", "KW", "P", "S", "Threads"};
+
+// Benchmarks MlasNchwcConv as used by the NCHWc transformer. The buffers are sized and laid out like
+// the test in test_conv2d_nchwc.h picks them: depthwise and NCHWc convolutions read a NCHWc input, the
+// first convolution of a model reads the NCHW input directly. The values are random so no reordering
+// is done.
+void SCONV_NCHWC(benchmark::State& state, const char* /*dummy*/) {
+  for (int i = 0; i < 11; i++) {
+    if (state.range(i) <= 0 && i != 8) throw std::invalid_argument(nchwc_conv_arg_names[i] + " must greater than 0!");
+  }
+  const int64_t batch_size = state.range(0);
+  const int64_t groups = state.range(1);
+  const int64_t input_channels_per_group = state.range(2);
+  const int64_t output_channels_per_group = state.range(3);
+  const int64_t input_height = state.range(4);
+  const int64_t input_width = state.range(5);
+  const int64_t kernel_height = state.range(6);
+  const int64_t kernel_width = state.range(7);
+  const int64_t padding = state.range(8);
+  const int64_t stride = state.range(9);
+  const size_t threads = static_cast<size_t>(state.range(10));
+
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc convolution is not supported on this platform");
+    return;
+  }
+
+  const bool depthwise = groups > 1 && input_channels_per_group == 1 && output_channels_per_group == 1;
+  const bool nchwc_input = depthwise || input_channels_per_group >= block_size;
+  if (groups > 1 && !depthwise) throw std::invalid_argument("only depthwise grouped convolutions are supported!");
+
+  const int64_t input_channels = groups * input_channels_per_group;
+  const int64_t output_channels = groups * output_channels_per_group;
+  const int64_t nchwc_input_channels = (input_channels + block_size - 1) / block_size * block_size;
+  const int64_t nchwc_output_channels = (output_channels + block_size - 1) / block_size * block_size;
+  const int64_t output_height = (input_height + 2 * padding - kernel_height) / stride + 1;
+  const int64_t output_width = (input_width + 2 * padding - kernel_width) / stride + 1;
+
+  const int64_t input_shape[] = {batch_size, nchwc_input ? nchwc_input_channels : input_channels, input_height, input_width};
+  const int64_t kernel_shape[] = {kernel_height, kernel_width};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t paddings[] = {padding, padding, padding, padding};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {batch_size, nchwc_output_channels, output_height, output_width};
+
+  // OIHWBiBo filters of NCHWc convolutions pad the input channels, OIHWBo filters don't
+  const int64_t filter_input_channels = (nchwc_input && !depthwise) ? nchwc_input_channels : input_channels_per_group;
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+      tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto X = RandomVectorUniform(std::vector<int64_t>(std::begin(input_shape), std::end(input_shape)), -2.0f, 2.0f);
+  auto F = RandomVectorUniform({nchwc_output_channels, filter_input_channels, kernel_height, kernel_width}, -1.0f, 1.0f);
+  auto B = RandomVectorUniform(static_cast<size_t>(nchwc_output_channels), -1.0f, 1.0f);
+  std::vector<float> Y(static_cast<size_t>(batch_size * nchwc_output_channels * output_height * output_width));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  // warm up first round.
+  MlasNchwcConv(input_shape, kernel_shape, dilation_shape, paddings, stride_shape, output_shape,
+                static_cast<size_t>(groups), X.data(), F.data(), B.data(), Y.data(), &activation, true, tp.get());
+
+  for (auto _ : state) {
+    MlasNchwcConv(input_shape, kernel_shape, dilation_shape, paddings, stride_shape, output_shape,
+                  static_cast<size_t>(groups), X.data(), F.data(), B.data(), Y.data(), &activation, true, tp.get());
+  }
+}
+
+static void ResNet50Nchwc(benchmark::internal::Benchmark* b) {
+  b->ArgNames(nchwc_conv_arg_names);
+  for (int64_t threads : {1, 4}) {
+    //      N, G, Cpg,  Fpg,   H,   W,KH,KW, P, S, Threads
+    b->Args({1, 1,   3,   64, 224, 224, 7, 7, 3, 2, threads});  // Conv 1, NCHW input
+    b->Args({1, 1,  64,   64,  56,  56, 1, 1, 0, 1, threads});  // Conv 2.1
+    b->Args({1, 1,  64,   64,  56,  56, 3, 3, 1, 1, threads});
+    b->Args({1, 1,  64,  256,  56,  56, 1, 1, 0, 1, threads});
+    b->Args({1, 1, 128,  128,  56,  56, 3, 3, 1, 2, threads});  // Conv 3.1
+    b->Args({1, 1, 256,  256,  28,  28, 3, 3, 1, 2, threads});  // Conv 4.1
+    b->Args({1, 1, 256, 1024,  14,  14, 1, 1, 0, 1, threads});
+    b->Args({1, 1, 512,  512,   7,   7, 3, 3, 1, 1, threads});  // Conv 5.X
+    b->Args({1, 1, 2048, 512,   7,   7, 1, 1, 0, 1, threads});
+  }
+}
+
+static void MobileNetV2Nchwc(benchmark::internal::Benchmark* b) {
+  b->ArgNames(nchwc_conv_arg_names);
+  for (int64_t threads : {1, 4}) {
+    //      N,   G, Cpg, Fpg,   H,   W,KH,KW, P, S, Threads
+    b->Args({1,   1,   3,  32, 224, 224, 3, 3, 1, 2, threads});  // stem, NCHW input
+    b->Args({1,  32,   1,   1, 112, 112, 3, 3, 1, 1, threads});  // depthwise
+    b->Args({1,   1,  32,  16, 112, 112, 1, 1, 0, 1, threads});  // project
+    b->Args({1,   1,  16,  96, 112, 112, 1, 1, 0, 1, threads});  // expand
+    b->Args({1,  96,   1,   1, 112, 112, 3, 3, 1, 2, threads});  // depthwise, stride 2
+    b->Args({1, 144,   1,   1,  56,  56, 3, 3, 1, 1, threads});
+    b->Args({1,   1, 144,  24,  56,  56, 1, 1, 0, 1, threads});
+    b->Args({1, 384,   1,   1,  14,  14, 3, 3, 1, 1, threads});
+    b->Args({1,   1, 384,  64,  14,  14, 1, 1, 0, 1, threads});
+    b->Args({1, 960,   1,   1,   7,   7, 3, 3, 1, 1, threads});
+    b->Args({1,   1, 320, 1280,  7,   7, 1, 1, 0, 1, threads});  // head
+  }
+}
+
+BENCHMARK_CAPTURE(SCONV_NCHWC, ResNet50, "")->Apply(ResNet50Nchwc)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NCHWC, MobileNetV2, "")->Apply(MobileNetV2Nchwc)->UseRealTime();
@@ -3,8 +3,10 @@
 
 #include "mlas.h"
 #include "bench_util.h"
+#include "core/util/thread_utils.h"
 
 #include <stdexcept>
+#include <memory>
 #include <numeric>
 
 static const std::vector<std::string> sgemm_bench_arg_names = {"M", "N", "K"};
@@ -118,3 +120,74 @@ BENCHMARK_CAPTURE(SGEMM, GEMV_ABTrans, false, true, true)->Apply(GemmSizeWithOne
 
 BENCHMARK_CAPTURE(SGEMM, PACKB_NoTransA, true, false, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, PACKB_TransA, true, true, false)->Apply(GemmSizeProducts)->UseRealTime();
+
+static const std::vector<std::string> sgemm_batch_bench_arg_names = {"M", "N", "K", "Batch", "Threads"};
+
+void SGEMM_BATCH(benchmark::State& state, bool trans_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Batch must greater than 0!");
+  if (state.range(4) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t batch = static_cast<size_t>(state.range(3));
+  const size_t threads = static_cast<size_t>(state.range(4));
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+      tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto A = RandomVectorUniform(static_cast<size_t>(M * K * batch), -1.0f, 1.0f);
+  auto B = RandomVectorUniform(static_cast<size_t>(N * K * batch), -1.0f, 1.0f);
+  std::vector<float> C(static_cast<size_t>(M * N * batch));
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(batch);
+  for (size_t i = 0; i < batch; i++) {
+    data[i].A = A.data() + M * K * i;
+    data[i].lda = K;
+    data[i].B = B.data() + N * K * i;
+    data[i].ldb = trans_b ? K : N;
+    data[i].C = C.data() + M * N * i;
+    data[i].ldc = N;
+  }
+
+  MlasGemmBatch(CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans, M, N, K, data.data(), batch, tp.get());
+
+  for (auto _ : state) {
+    MlasGemmBatch(CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans, M, N, K, data.data(), batch, tp.get());
+  }
+}
+
+static void BertBaseGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sgemm_batch_bench_arg_names);
+  // sequence length 128, hidden size 768, 12 heads of 64
+  for (int64_t threads : {1, 4}) {
+    b->Args({128, 2304, 768, 1, threads});   // packed QKV projection
+    b->Args({128, 768, 768, 1, threads});    // attention output projection
+    b->Args({128, 3072, 768, 1, threads});   // FFN up projection
+    b->Args({128, 768, 3072, 1, threads});   // FFN down projection
+    b->Args({128, 128, 64, 12, threads});    // Q x K' per head
+    b->Args({128, 64, 128, 12, threads});    // softmax(Q x K') x V per head
+  }
+}
+
+static void LstmGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sgemm_batch_bench_arg_names);
+  // gates of 4 x hidden size, the input projection over the whole sequence then one recurrence per step
+  for (int64_t threads : {1, 4}) {
+    b->Args({35, 4 * 256, 256, 1, threads});
+    b->Args({1, 4 * 256, 256, 1, threads});
+    b->Args({100, 4 * 512, 512, 1, threads});
+    b->Args({1, 4 * 512, 512, 1, threads});
+    b->Args({16, 4 * 1024, 1024, 1, threads});
+  }
+}
+
+BENCHMARK_CAPTURE(SGEMM_BATCH, BertBase, false)->Apply(BertBaseGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM_BATCH, BertBase_TransB, true)->Apply(BertBaseGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM_BATCH, Lstm_TransB, true)->Apply(LstmGemmSize)->UseRealTime();
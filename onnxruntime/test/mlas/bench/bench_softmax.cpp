@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+#include <memory>
+
+static const std::vector<std::string> softmax_arg_names = {"N", "D", "Threads"};
+
+void SOFTMAX(benchmark::State& state, bool log_softmax) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+  const size_t threads = static_cast<size_t>(state.range(2));
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+      tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto X = RandomVectorUniform(N * D, -10.0f, 10.0f);
+  std::vector<float> Y(N * D);
+
+  MlasComputeSoftmax(X.data(), Y.data(), N, D, log_softmax, tp.get());
+
+  for (auto _ : state) {
+    MlasComputeSoftmax(X.data(), Y.data(), N, D, log_softmax, tp.get());
+  }
+}
+
+static void SoftmaxSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(softmax_arg_names);
+  for (int64_t threads : {1, 4}) {
+    // BERT base attention probabilities, batch 1 x 12 heads x sequence length rows of sequence length
+    b->Args({12 * 128, 128, threads});
+    b->Args({12 * 384, 384, threads});
+    b->Args({12 * 512, 512, threads});
+    // ImageNet classifier
+    b->Args({1, 1000, threads});
+    b->Args({32, 1000, threads});
+    // language model heads, a few tokens over a large vocabulary
+    b->Args({1, 32128, threads});
+    b->Args({8, 50257, threads});
+  }
+}
+
+BENCHMARK_CAPTURE(SOFTMAX, Softmax, false)->Apply(SoftmaxSize)->UseRealTime();
+BENCHMARK_CAPTURE(SOFTMAX, LogSoftmax, true)->Apply(SoftmaxSize)->UseRealTime();
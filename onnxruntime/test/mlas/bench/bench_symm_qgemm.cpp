@@ -59,7 +59,7 @@ void SYMMQGEMM(benchmark::State& state, bool a_signed) {
     gemm_params.A = A_holder.data() + M * K * i;
     gemm_params.C = C_holder.data() + M * N * i;
 
-    MlasSymmQgemmPackB(N, K, (const int8_t*)gemm_params.B, N, a_signed, a_zero_point, (void*)(pack_b_holder.data() + packed_b_size * i));
+    MlasSymmQgemmPackB(N, K, B_holder.data() + N * K * i, N, a_signed, a_zero_point, (void*)(pack_b_holder.data() + packed_b_size * i));
     gemm_params.B = (void*)(pack_b_holder.data() + packed_b_size * i);
   }
   for (auto _ : state) {
@@ -100,4 +100,17 @@ static void SymmQGemmSize(benchmark::internal::Benchmark* b) {
   b->Args({512, 64, 512, 12, 6});
 }
 
+static void SymmQGemmLstmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(qgemm_arg_names);
+  // Args for  "M", "N", "K", "Batch", "Threads": gates of 4 x hidden size, input projection then recurrence
+
+  b->Args({35, 1024, 256, 1, 1});
+  b->Args({1, 1024, 256, 1, 1});
+  b->Args({100, 2048, 512, 1, 1});
+  b->Args({100, 2048, 512, 1, 4});
+  b->Args({1, 2048, 512, 1, 1});
+  b->Args({1, 2048, 512, 1, 4});
+}
+
 BENCHMARK_CAPTURE(SYMMQGEMM, SignedActivation, true)->Apply(SymmQGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(SYMMQGEMM, Lstm, true)->Apply(SymmQGemmLstmSize)->UseRealTime();
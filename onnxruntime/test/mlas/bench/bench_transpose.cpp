@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> transpose_arg_names = {"M", "N"};
+
+template <typename ElementType>
+void TRANSPOSE(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  std::vector<ElementType> X(M * N);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<ElementType>(i);
+  }
+  std::vector<ElementType> Y(M * N);
+
+  for (auto _ : state) {
+    MlasTranspose(X.data(), Y.data(), M, N);
+  }
+}
+
+static void TransposeSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(transpose_arg_names);
+  // BERT base: heads to sequence major, [128, 12 x 64] <-> [12 x 64, 128], and the FFN weights
+  b->Args({128, 768});
+  b->Args({768, 128});
+  b->Args({512, 768});
+  b->Args({768, 3072});
+  // NCHW <-> NHWC of ResNet / MobileNet activations, channels x spatial
+  b->Args({64, 56 * 56});
+  b->Args({56 * 56, 64});
+  b->Args({256, 14 * 14});
+  b->Args({32, 112 * 112});
+  // LSTM weights, 4 x hidden size x input size
+  b->Args({4 * 512, 512});
+  // odd sizes that take the remainder loops
+  b->Args({63, 255});
+  b->Args({255, 1023});
+}
+
+BENCHMARK_TEMPLATE(TRANSPOSE, float)->Apply(TransposeSize)->UseRealTime();
+BENCHMARK_TEMPLATE(TRANSPOSE, uint8_t)->Apply(TransposeSize)->UseRealTime();
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <size_t BlkBitWidth, bool Threaded>
+class MlasBlkQuantGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferQuantBData;
+  MatrixGuardBuffer<float> BufferQuantBScale;
+  MatrixGuardBuffer<uint8_t> BufferQuantBZeroPoint;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t M, size_t N, size_t K, size_t BlkLen, bool HasZeroPoint, bool HasBias) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlobSize = BlkLen * BlkBitWidth / 8;
+    const size_t ZeroPointColumnBytes = (BlockCountK * BlkBitWidth + 7) / 8;
+    const uint8_t MaximumValue = uint8_t((1 << BlkBitWidth) - 1);
+
+    float* A = BufferA.GetBuffer(M * K);
+    uint8_t* QuantBData = BufferQuantBData.GetBuffer(N * BlockCountK * BlobSize, true);
+    float* QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+    uint8_t* QuantBZeroPoint = HasZeroPoint ? BufferQuantBZeroPoint.GetBuffer(N * ZeroPointColumnBytes, true) : nullptr;
+    float* Bias = HasBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* C = BufferC.GetBuffer(M * N, true);
+    float* CReference = BufferCReference.GetBuffer(M * N, true);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K + BlkLen));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> value_distribution(0, MaximumValue);
+
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < N * BlockCountK; i++) {
+      QuantBScale[i] = (distribution(generator) + 2.0f) / 32.0f;
+    }
+    if (Bias != nullptr) {
+      for (size_t i = 0; i < N; i++) {
+        Bias[i] = distribution(generator);
+      }
+    }
+
+    // Dequantized B, column by column.
+    std::vector<float> B(N * K);
+
+    for (size_t n = 0; n < N; n++) {
+      for (size_t block = 0; block < BlockCountK; block++) {
+        uint8_t ZeroPoint = uint8_t(1 << (BlkBitWidth - 1));
+        if (QuantBZeroPoint != nullptr) {
+          ZeroPoint = uint8_t(value_distribution(generator));
+          uint8_t& Packed = QuantBZeroPoint[n * ZeroPointColumnBytes + block * BlkBitWidth / 8];
+          if (BlkBitWidth == 4) {
+            Packed |= (block & 1) ? uint8_t(ZeroPoint << 4) : ZeroPoint;
+          } else {
+            Packed = ZeroPoint;
+          }
+        }
+
+        const float Scale = QuantBScale[n * BlockCountK + block];
+        uint8_t* Blob = QuantBData + (n * BlockCountK + block) * BlobSize;
+
+        for (size_t j = 0; j < BlkLen && block * BlkLen + j < K; j++) {
+          const uint8_t Value = uint8_t(value_distribution(generator));
+          if (BlkBitWidth == 4) {
+            Blob[j / 2] |= (j & 1) ? uint8_t(Value << 4) : Value;
+          } else {
+            Blob[j] = Value;
+          }
+          B[n * K + block * BlkLen + j] = (float(Value) - float(ZeroPoint)) * Scale;
+        }
+      }
+    }
+
+    MLAS_BLKQUANT_GEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.QuantBData = QuantBData;
+    Data.QuantBScale = QuantBScale;
+    Data.QuantBZeroPoint = QuantBZeroPoint;
+    Data.Bias = Bias;
+    Data.C = C;
+    Data.ldc = N;
+
+    MlasBlkQuantGemm(M, N, K, BlkBitWidth, BlkLen, &Data, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Accumulator = Bias != nullptr ? double(Bias[n]) : 0.0;
+        for (size_t k = 0; k < K; k++) {
+          Accumulator += double(A[m * K + k]) * double(B[n * K + k]);
+        }
+        CReference[m * N + n] = float(Accumulator);
+      }
+    }
+
+    constexpr float AbsoluteTolerance = 1e-3f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t i = 0; i < M * N; i++) {
+      float diff = std::fabs(C[i] - CReference[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(CReference[i]) * RelativeTolerance)
+          << "ZeroPoint:" << HasZeroPoint << " Bias:" << HasBias << " M/N/K/BlkLen " << M << "/" << N << "/"
+          << K << "/" << BlkLen << " @" << i << ", got: " << C[i] << ", expecting: " << CReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::string("BlkQuantGemm") + std::to_string(BlkBitWidth) + "Bit" +
+                                        (Threaded ? "_Threaded" : "_SingleThread"));
+    return suite_name.c_str();
+  }
+
+  MlasBlkQuantGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t BlkLen : {16, 32, 64, 128, 256}) {
+      for (bool HasZeroPoint : {false, true}) {
+        Test(1, 1, 1, BlkLen, HasZeroPoint, false);
+        Test(1, 17, 33, BlkLen, HasZeroPoint, true);
+        Test(1, 64, 512, BlkLen, HasZeroPoint, false);
+        Test(3, 40, 300, BlkLen, HasZeroPoint, true);
+        Test(16, 33, 777, BlkLen, HasZeroPoint, false);
+      }
+    }
+  }
+};
+
+template <> MlasBlkQuantGemmTest<4, false>* MlasTestFixture<MlasBlkQuantGemmTest<4, false>>::mlas_tester(nullptr);
+template <> MlasBlkQuantGemmTest<4, true>* MlasTestFixture<MlasBlkQuantGemmTest<4, true>>::mlas_tester(nullptr);
+template <> MlasBlkQuantGemmTest<8, false>* MlasTestFixture<MlasBlkQuantGemmTest<8, false>>::mlas_tester(nullptr);
+template <> MlasBlkQuantGemmTest<8, true>* MlasTestFixture<MlasBlkQuantGemmTest<8, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasBlkQuantGemmTest<4, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasBlkQuantGemmTest<8, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasBlkQuantGemmTest<4, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasBlkQuantGemmTest<8, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
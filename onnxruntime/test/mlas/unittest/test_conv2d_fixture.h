@@ -140,6 +140,18 @@ class Conv2dShortExecuteTest : public MlasTestFixture<Conv2dTester> {
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2);
     }
+    // Depthwise and narrow grouped shapes that select the direct grouped algorithm.
+    for (unsigned i = 3; i < 40; i += 9) {
+      test_registered += RegisterSingleTest(2, 24, 1, i, i + 2, 1, 5, 5, 2, 2, 2, 2, 1, 1, 1, 1);
+      test_registered += RegisterSingleTest(1, 24, 1, i + 1, i, 2, 5, 5, 2, 1, 2, 1, 1, 1, 2, 2);
+      test_registered += RegisterSingleTest(1, 8, 4, i, i, 4, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+      test_registered += RegisterSingleTest(2, 4, 16, i, i + 3, 8, 3, 3, 1, 0, 0, 1, 2, 2, 2, 1);
+    }
+    // Shapes that select the Winograd algorithm, including partial output tiles.
+    for (unsigned i = 4; i < 64; i += 7) {
+      test_registered += RegisterSingleTest(1, 1, 32, i, i + 1, 48, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+      test_registered += RegisterSingleTest(2, 2, 32, i + 2, i, 32, 3, 3, 0, 1, 2, 0, 1, 1, 1, 1);
+    }
     return test_registered;
   }
 
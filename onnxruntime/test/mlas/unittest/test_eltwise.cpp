@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasEltwiseChannelBroadcastTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferChannels;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  static float ReferenceOp(MLAS_ELTWISE_KIND Kind, float a, float b) {
+    switch (Kind) {
+      case MlasEltwiseAdd:
+        return a + b;
+      case MlasEltwiseSub:
+        return a - b;
+      case MlasEltwiseMul:
+        return a * b;
+      case MlasEltwiseDiv:
+        return a / b;
+    }
+    return 0.0f;
+  }
+
+  void Test(MLAS_ELTWISE_KIND Kind, size_t OuterCount, size_t ChannelCount, size_t InnerCount, bool ChannelsFirst) {
+    const size_t TotalCount = OuterCount * ChannelCount * InnerCount;
+
+    float* Input = BufferInput.GetBuffer(TotalCount);
+    float* Channels = BufferChannels.GetBuffer(ChannelCount);
+    float* Output = BufferOutput.GetBuffer(TotalCount);
+    float* OutputReference = BufferOutputReference.GetBuffer(TotalCount);
+
+    std::default_random_engine generator(static_cast<unsigned>(TotalCount + ChannelCount));
+    std::uniform_real_distribution<float> distribution(0.5f, 2.0f);
+
+    for (size_t i = 0; i < TotalCount; i++) {
+      Input[i] = distribution(generator);
+    }
+    for (size_t c = 0; c < ChannelCount; c++) {
+      Channels[c] = distribution(generator);
+    }
+
+    for (size_t i = 0; i < TotalCount; i++) {
+      const float ChannelValue = Channels[(i / InnerCount) % ChannelCount];
+      OutputReference[i] = ChannelsFirst ? ReferenceOp(Kind, ChannelValue, Input[i])
+                                         : ReferenceOp(Kind, Input[i], ChannelValue);
+    }
+
+    MlasEltwiseChannelBroadcast(Kind, Input, Channels, Output, OuterCount, ChannelCount, InnerCount, ChannelsFirst,
+                                threadpool_);
+
+    for (size_t i = 0; i < TotalCount; i++) {
+      ASSERT_EQ(Output[i], OutputReference[i])
+          << "Kind=" << int(Kind) << " @" << i << " of [" << OuterCount << "," << ChannelCount << "," << InnerCount
+          << "] ChannelsFirst=" << ChannelsFirst;
+    }
+
+    // Updating the input in place gives the same result.
+    MlasEltwiseChannelBroadcast(Kind, Input, Channels, Input, OuterCount, ChannelCount, InnerCount, ChannelsFirst,
+                                threadpool_);
+
+    ASSERT_EQ(memcmp(Input, OutputReference, TotalCount * sizeof(float)), 0)
+        << "in place, Kind=" << int(Kind) << " [" << OuterCount << "," << ChannelCount << "," << InnerCount << "]";
+  }
+
+ public:
+  MlasEltwiseChannelBroadcastTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("EltwiseChannelBroadcast") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_ELTWISE_KIND Kind : {MlasEltwiseAdd, MlasEltwiseSub, MlasEltwiseMul, MlasEltwiseDiv}) {
+      for (bool ChannelsFirst : {false, true}) {
+        for (size_t InnerCount : {1, 3, 4, 17, 49, 64}) {
+          Test(Kind, 1, 7, InnerCount, ChannelsFirst);
+          Test(Kind, 3, 16, InnerCount, ChannelsFirst);
+        }
+        Test(Kind, 1, 3, 224 * 224, ChannelsFirst);
+        Test(Kind, 64, 33, 1, ChannelsFirst);
+      }
+    }
+  }
+};
+
+template <> MlasEltwiseChannelBroadcastTest<false>* MlasTestFixture<MlasEltwiseChannelBroadcastTest<false>>::mlas_tester(nullptr);
+template <> MlasEltwiseChannelBroadcastTest<true>* MlasTestFixture<MlasEltwiseChannelBroadcastTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasEltwiseChannelBroadcastTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasEltwiseChannelBroadcastTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
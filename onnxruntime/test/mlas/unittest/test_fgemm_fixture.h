@@ -70,6 +70,13 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+
+    // Skinny products with few column blocks, whose threads also partition the K dimension.
+    for (size_t m : {1, 3, 8}) {
+      test_registered += RegisterTestTransposeABProduct(m, 40, 2000, 1, 1.0f, 0.0f);
+      test_registered += RegisterTestTransposeABProduct(m, 16, 4096, 2, 1.0f, 1.0f);
+      test_registered += RegisterTestTransposeABProduct(m, 100, 1500, 1, 0.5f, 0.25f);
+    }
     return test_registered;
   }
 
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQuery;
+  MatrixGuardBuffer<float> BufferKey;
+  MatrixGuardBuffer<float> BufferValue;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferWorkspace;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchSize, size_t NumHeads, size_t QSequenceLength, size_t KvSequenceLength,
+            size_t QkHeadSize, size_t VHeadSize, bool Causal, bool HasBias) {
+    const size_t Heads = BatchSize * NumHeads;
+
+    float* Query = BufferQuery.GetBuffer(Heads * QSequenceLength * QkHeadSize);
+    float* Key = BufferKey.GetBuffer(Heads * KvSequenceLength * QkHeadSize);
+    float* Value = BufferValue.GetBuffer(Heads * KvSequenceLength * VHeadSize);
+    float* Bias = HasBias ? BufferBias.GetBuffer(Heads * QSequenceLength * KvSequenceLength) : nullptr;
+    float* Output = BufferOutput.GetBuffer(Heads * QSequenceLength * VHeadSize);
+    float* OutputReference = BufferOutputReference.GetBuffer(Heads * QSequenceLength * VHeadSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(Heads * QSequenceLength * KvSequenceLength));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < Heads * QSequenceLength * QkHeadSize; i++) {
+      Query[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < Heads * KvSequenceLength * QkHeadSize; i++) {
+      Key[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < Heads * KvSequenceLength * VHeadSize; i++) {
+      Value[i] = distribution(generator);
+    }
+    if (Bias != nullptr) {
+      for (size_t i = 0; i < Heads * QSequenceLength * KvSequenceLength; i++) {
+        Bias[i] = distribution(generator) > 0.5f ? -10000.0f : distribution(generator);
+      }
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMETERS Parameters;
+    Parameters.BatchSize = BatchSize;
+    Parameters.NumHeads = NumHeads;
+    Parameters.QSequenceLength = QSequenceLength;
+    Parameters.KvSequenceLength = KvSequenceLength;
+    Parameters.QkHeadSize = QkHeadSize;
+    Parameters.VHeadSize = VHeadSize;
+    Parameters.Scale = 1.0f / std::sqrt(float(QkHeadSize));
+    Parameters.Causal = Causal;
+    Parameters.Query = Query;
+    Parameters.Key = Key;
+    Parameters.Value = Value;
+    Parameters.Bias = Bias;
+    Parameters.BiasHeadStride = QSequenceLength * KvSequenceLength;
+    Parameters.BiasBatchStride = NumHeads * Parameters.BiasHeadStride;
+    Parameters.BiasRowStride = KvSequenceLength;
+    Parameters.Output = Output;
+
+    float* Workspace = BufferWorkspace.GetBuffer(MlasFlashAttentionGetWorkspaceSize(&Parameters, threadpool_));
+
+    MlasFlashAttention(&Parameters, Workspace, threadpool_);
+    ReferenceAttention(Parameters, OutputReference);
+
+    constexpr float AbsoluteTolerance = 1e-5f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t i = 0; i < Heads * QSequenceLength * VHeadSize; i++) {
+      float diff = std::fabs(Output[i] - OutputReference[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[i]) * RelativeTolerance)
+          << "Causal:" << Causal << " Bias:" << HasBias << " B/N/S/S*/H/Hv " << BatchSize << "/" << NumHeads << "/"
+          << QSequenceLength << "/" << KvSequenceLength << "/" << QkHeadSize << "/" << VHeadSize
+          << " @" << i << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+    }
+  }
+
+  void ReferenceAttention(const MLAS_FLASH_ATTENTION_PARAMETERS& Parameters, float* Output) {
+    const size_t S = Parameters.QSequenceLength;
+    const size_t T = Parameters.KvSequenceLength;
+    const size_t H = Parameters.QkHeadSize;
+    const size_t Hv = Parameters.VHeadSize;
+    std::vector<double> Scores(T);
+
+    for (size_t b = 0; b < Parameters.BatchSize; b++) {
+      for (size_t n = 0; n < Parameters.NumHeads; n++) {
+        const size_t Head = b * Parameters.NumHeads + n;
+        const float* Query = Parameters.Query + Head * S * H;
+        const float* Key = Parameters.Key + Head * T * H;
+        const float* Value = Parameters.Value + Head * T * Hv;
+
+        for (size_t i = 0; i < S; i++) {
+          const size_t KeyCount = Parameters.Causal ? (std::min)(T, i + T - S + 1) : T;
+          double MaximumValue = std::numeric_limits<double>::lowest();
+
+          for (size_t j = 0; j < KeyCount; j++) {
+            double Dot = 0.0;
+            for (size_t h = 0; h < H; h++) {
+              Dot += double(Query[i * H + h]) * double(Key[j * H + h]);
+            }
+            Scores[j] = Dot * Parameters.Scale;
+            if (Parameters.Bias != nullptr) {
+              Scores[j] += Parameters.Bias[b * Parameters.BiasBatchStride + n * Parameters.BiasHeadStride +
+                                           i * Parameters.BiasRowStride + j];
+            }
+            MaximumValue = (std::max)(MaximumValue, Scores[j]);
+          }
+
+          double Sum = 0.0;
+          for (size_t j = 0; j < KeyCount; j++) {
+            Scores[j] = std::exp(Scores[j] - MaximumValue);
+            Sum += Scores[j];
+          }
+
+          float* OutputRow = Output + ((b * S + i) * Parameters.NumHeads + n) * Hv;
+          for (size_t v = 0; v < Hv; v++) {
+            double Accumulator = 0.0;
+            for (size_t j = 0; j < KeyCount; j++) {
+              Accumulator += Scores[j] * double(Value[j * Hv + v]);
+            }
+            OutputRow[v] = float(Accumulator / Sum);
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "FlashAttention_Threaded" : "FlashAttention_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (bool Causal : {false, true}) {
+      for (bool HasBias : {false, true}) {
+        Test(1, 1, 1, 1, 8, 8, Causal, HasBias);
+        Test(1, 2, 17, 17, 16, 16, Causal, HasBias);
+        Test(2, 3, 33, 130, 24, 16, Causal, HasBias);
+        Test(1, 4, 64, 300, 32, 32, Causal, HasBias);
+        Test(2, 2, 129, 129, 64, 40, Causal, HasBias);
+      }
+    }
+  }
+};
+
+template <> MlasFlashAttentionTest<false>* MlasTestFixture<MlasFlashAttentionTest<false>>::mlas_tester(nullptr);
+template <> MlasFlashAttentionTest<true>* MlasTestFixture<MlasFlashAttentionTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
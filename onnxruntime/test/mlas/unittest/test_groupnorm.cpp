@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasGroupNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferVectors;
+  MatrixGuardBuffer<float> BufferOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchCount, size_t ChannelCount, size_t ImageSize, size_t GroupCount, bool ChannelsLast,
+            bool Swish, float Offset) {
+    const float Epsilon = 1e-5f;
+    const size_t ElementCount = BatchCount * ChannelCount * ImageSize;
+
+    float* Input = BufferInput.GetBuffer(ElementCount);
+    float* Vectors = BufferVectors.GetBuffer(ChannelCount * 2);
+    float* Output = BufferOutput.GetBuffer(ElementCount);
+    float* Scale = Vectors;
+    float* Bias = Vectors + ChannelCount;
+
+    // the offset checks the precision of the variance of values with a large mean
+    std::default_random_engine generator(static_cast<unsigned>(ElementCount + GroupCount));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < ElementCount; i++) {
+      Input[i] = distribution(generator) + Offset;
+    }
+    for (size_t i = 0; i < ChannelCount * 2; i++) {
+      Vectors[i] = distribution(generator);
+    }
+
+    MlasGroupNormalization(Input, Scale, Bias, Output, BatchCount, ChannelCount, ImageSize, GroupCount, Epsilon,
+                           ChannelsLast, Swish, threadpool_);
+
+    const size_t GroupChannels = ChannelCount / GroupCount;
+    const size_t GroupSize = GroupChannels * ImageSize;
+
+    auto OffsetOf = [&](size_t n, size_t c, size_t p) {
+      return ChannelsLast ? (n * ImageSize + p) * ChannelCount + c : (n * ChannelCount + c) * ImageSize + p;
+    };
+
+    for (size_t n = 0; n < BatchCount; n++) {
+      for (size_t g = 0; g < GroupCount; g++) {
+        double Mean = 0.0;
+        for (size_t c = g * GroupChannels; c < (g + 1) * GroupChannels; c++) {
+          for (size_t p = 0; p < ImageSize; p++) {
+            Mean += Input[OffsetOf(n, c, p)];
+          }
+        }
+        Mean /= GroupSize;
+
+        double Variance = 0.0;
+        for (size_t c = g * GroupChannels; c < (g + 1) * GroupChannels; c++) {
+          for (size_t p = 0; p < ImageSize; p++) {
+            const double Value = Input[OffsetOf(n, c, p)] - Mean;
+            Variance += Value * Value;
+          }
+        }
+        const double InverseStdDev = 1.0 / std::sqrt(Variance / GroupSize + Epsilon);
+
+        for (size_t c = g * GroupChannels; c < (g + 1) * GroupChannels; c++) {
+          for (size_t p = 0; p < ImageSize; p++) {
+            double Expected = (Input[OffsetOf(n, c, p)] - Mean) * InverseStdDev * Scale[c] + Bias[c];
+            if (Swish) {
+              Expected = Expected / (1.0 + std::exp(-Expected));
+            }
+            ASSERT_NEAR(Output[OffsetOf(n, c, p)], Expected, 2e-3 + std::fabs(Expected) * 2e-3)
+                << "@[" << n << "," << c << "," << p << "] of [" << BatchCount << "," << ChannelCount << ","
+                << ImageSize << "] groups " << GroupCount << " ChannelsLast=" << ChannelsLast << " Swish=" << Swish
+                << " offset " << Offset;
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  MlasGroupNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("GroupNorm") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool ChannelsLast : {false, true}) {
+      for (bool Swish : {false, true}) {
+        Test(1, 4, 1, 4, ChannelsLast, Swish, 0.0f);
+        Test(2, 6, 5, 3, ChannelsLast, Swish, 0.0f);
+        Test(2, 32, 17, 8, ChannelsLast, Swish, 0.0f);
+        Test(1, 64, 64, 32, ChannelsLast, Swish, 0.0f);
+        Test(3, 20, 49, 1, ChannelsLast, Swish, 0.0f);
+      }
+      Test(2, 320, 256, 32, ChannelsLast, true, 0.0f);
+      Test(1, 16, 1024, 4, ChannelsLast, false, 1000.0f);
+    }
+  }
+};
+
+template <> MlasGroupNormTest<false>* MlasTestFixture<MlasGroupNormTest<false>>::mlas_tester(nullptr);
+template <> MlasGroupNormTest<true>* MlasTestFixture<MlasGroupNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasGroupNormTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasGroupNormTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
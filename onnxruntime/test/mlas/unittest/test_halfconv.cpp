@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasHalfConvertTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint16_t> BufferHalf;
+  MatrixGuardBuffer<uint16_t> BufferHalfOutput;
+  MatrixGuardBuffer<float> BufferFloat;
+  MLAS_THREADPOOL* threadpool_;
+
+  static bool IsNaN(MLAS_HALF_GEMM_TYPE Type, uint16_t Half) {
+    return Type == MlasHalfGemmFloat16 ? (Half & 0x7FFF) > 0x7C00 : (Half & 0x7FFF) > 0x7F80;
+  }
+
+  // Every value that isn't a NaN converts exactly to single precision and back.
+  void TestRoundTrip(MLAS_HALF_GEMM_TYPE Type, size_t Count) {
+    uint16_t* Half = BufferHalf.GetBuffer(Count);
+    uint16_t* HalfOutput = BufferHalfOutput.GetBuffer(Count);
+    float* Float = BufferFloat.GetBuffer(Count);
+
+    size_t n = 0;
+    for (uint32_t value = 0; n < Count; value = (value + 1) & 0xFFFF) {
+      if (!IsNaN(Type, uint16_t(value))) {
+        Half[n++] = uint16_t(value);
+      }
+    }
+
+    MlasConvertHalfToFloat(Type, Half, Float, Count, threadpool_);
+    MlasConvertFloatToHalf(Type, Float, HalfOutput, Count, threadpool_);
+
+    for (size_t i = 0; i < Count; i++) {
+      ASSERT_EQ(HalfOutput[i], Half[i]) << "Type=" << int(Type) << " @" << i << " of " << Count
+                                        << ", single precision value " << Float[i];
+    }
+  }
+
+  // Single precision values convert to the nearest half precision value.
+  void TestRounding(MLAS_HALF_GEMM_TYPE Type, size_t Count) {
+    float* Float = BufferFloat.GetBuffer(Count);
+    uint16_t* Half = BufferHalf.GetBuffer(Count);
+
+    std::default_random_engine generator(static_cast<unsigned>(Count));
+    std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+
+    for (size_t i = 0; i < Count; i++) {
+      Float[i] = distribution(generator);
+    }
+
+    MlasConvertFloatToHalf(Type, Float, Half, Count, threadpool_);
+
+    for (size_t i = 0; i < Count; i++) {
+      // the value and its neighbors, none of them is zero or infinite for this range
+      const uint16_t Neighbors[3] = {Half[i], uint16_t(Half[i] - 1), uint16_t(Half[i] + 1)};
+      float Converted[3];
+      MlasConvertHalfToFloat(Type, Neighbors, Converted, 3, nullptr);
+
+      const float Error = std::fabs(Converted[0] - Float[i]);
+      ASSERT_LE(Error, std::fabs(Converted[1] - Float[i])) << "Type=" << int(Type) << " @" << i << " value " << Float[i];
+      ASSERT_LE(Error, std::fabs(Converted[2] - Float[i])) << "Type=" << int(Type) << " @" << i << " value " << Float[i];
+    }
+  }
+
+ public:
+  MlasHalfConvertTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("HalfConvert") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_HALF_GEMM_TYPE Type : {MlasHalfGemmFloat16, MlasHalfGemmBFloat16}) {
+      for (size_t Count : {1, 7, 8, 15, 16, 17, 63, 1000}) {
+        TestRoundTrip(Type, Count);
+        TestRounding(Type, Count);
+      }
+      TestRoundTrip(Type, 65536 * 3 + 5);
+      TestRounding(Type, 100003);
+    }
+  }
+};
+
+template <> MlasHalfConvertTest<false>* MlasTestFixture<MlasHalfConvertTest<false>>::mlas_tester(nullptr);
+template <> MlasHalfConvertTest<true>* MlasTestFixture<MlasHalfConvertTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasHalfConvertTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasHalfConvertTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferVectors;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferStatistics;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t RowCount, size_t N, bool HasSkip, bool HasBias, bool HasShift, bool Simplified, float Offset) {
+    const float Epsilon = 1e-5f;
+
+    float* Input = BufferInput.GetBuffer(RowCount * N);
+    float* Skip = HasSkip ? BufferSkip.GetBuffer(RowCount * N) : nullptr;
+    float* Vectors = BufferVectors.GetBuffer(N * 3);
+    float* Output = BufferOutput.GetBuffer(RowCount * N);
+    float* Statistics = BufferStatistics.GetBuffer(RowCount * 2);
+    float* Scale = Vectors;
+    float* Shift = HasShift ? Vectors + N : nullptr;
+    float* Bias = HasBias ? Vectors + 2 * N : nullptr;
+
+    // the offset checks the precision of the variance of values with a large mean
+    std::default_random_engine generator(static_cast<unsigned>(RowCount * N));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < RowCount * N; i++) {
+      Input[i] = distribution(generator) + Offset;
+      if (Skip != nullptr) {
+        Skip[i] = distribution(generator);
+      }
+    }
+    for (size_t i = 0; i < N * 3; i++) {
+      Vectors[i] = distribution(generator);
+    }
+
+    MlasLayerNormalization(Input, Skip, Bias, Scale, Shift, Output, Statistics, Statistics + RowCount, RowCount, N,
+                           Epsilon, Simplified, threadpool_);
+
+    for (size_t row = 0; row < RowCount; row++) {
+      std::vector<double> Values(N);
+      double Mean = 0.0;
+      for (size_t n = 0; n < N; n++) {
+        Values[n] = double(Input[row * N + n]) + (Skip != nullptr ? Skip[row * N + n] : 0.0f) +
+                    (Bias != nullptr ? Bias[n] : 0.0f);
+        Mean += Values[n];
+      }
+      Mean = Simplified ? 0.0 : Mean / N;
+
+      double Variance = 0.0;
+      for (size_t n = 0; n < N; n++) {
+        Variance += (Values[n] - Mean) * (Values[n] - Mean);
+      }
+      const double InverseStdDev = 1.0 / std::sqrt(Variance / N + Epsilon);
+
+      ASSERT_NEAR(Statistics[row], Mean, 1e-5 + std::fabs(Mean) * 1e-5) << "mean of row " << row;
+      ASSERT_NEAR(Statistics[RowCount + row], InverseStdDev, InverseStdDev * 2e-3)
+          << "inverse standard deviation of row " << row << " of [" << RowCount << "," << N << "] offset " << Offset;
+
+      for (size_t n = 0; n < N; n++) {
+        double Expected = (Values[n] - Mean) * InverseStdDev * Scale[n];
+        if (Shift != nullptr && !Simplified) {
+          Expected += Shift[n];
+        }
+        ASSERT_NEAR(Output[row * N + n], Expected, 2e-3 + std::fabs(Expected) * 2e-3)
+            << "@[" << row << "," << n << "] of [" << RowCount << "," << N << "] Skip=" << HasSkip
+            << " Bias=" << HasBias << " Shift=" << HasShift << " Simplified=" << Simplified;
+      }
+    }
+  }
+
+ public:
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("LayerNorm") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t N : {1, 3, 8, 13, 64, 768}) {
+      for (bool HasSkip : {false, true}) {
+        for (bool HasBias : {false, true}) {
+          Test(5, N, HasSkip, HasBias, true, false, 0.0f);
+        }
+      }
+      Test(3, N, false, false, false, false, 0.0f);
+      Test(3, N, false, false, true, true, 0.0f);
+    }
+    Test(128, 768, true, true, true, false, 0.0f);
+    Test(4, 1024, false, false, true, false, 1000.0f);
+  }
+};
+
+template <> MlasLayerNormTest<false>* MlasTestFixture<MlasLayerNormTest<false>>::mlas_tester(nullptr);
+template <> MlasLayerNormTest<true>* MlasTestFixture<MlasLayerNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -63,14 +63,84 @@ class MlasQuantizeLinearTest : public MlasTestBase {
   }
 };
 
+class MlasDynamicQuantizeLinearPerRowTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<uint8_t> BufferOutput;
+  MatrixGuardBuffer<float> BufferScales;
+  MatrixGuardBuffer<uint8_t> BufferZeroPoints;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t Rows, size_t Columns) {
+    float* Input = BufferInput.GetBuffer(Rows * Columns);
+    uint8_t* Output = BufferOutput.GetBuffer(Rows * Columns);
+    float* Scales = BufferScales.GetBuffer(Rows);
+    uint8_t* ZeroPoints = BufferZeroPoints.GetBuffer(Rows);
+
+    std::default_random_engine generator(static_cast<unsigned>(Rows * Columns));
+    std::uniform_real_distribution<float> range_distribution(-10.f, 10.f);
+
+    // rows with very different ranges, some of them all positive
+    for (size_t r = 0; r < Rows; r++) {
+      float MinimumValue = range_distribution(generator);
+      float MaximumValue = range_distribution(generator);
+      if (MinimumValue > MaximumValue) {
+        std::swap(MinimumValue, MaximumValue);
+      }
+      std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+      for (size_t c = 0; c < Columns; c++) {
+        Input[r * Columns + c] = distribution(generator);
+      }
+    }
+
+    MlasDynamicQuantizeLinearPerRow(Input, Output, Rows, Columns, Scales, ZeroPoints, threadpool_);
+
+    for (size_t r = 0; r < Rows; r++) {
+      const float* Row = Input + r * Columns;
+      float MinimumValue = std::min(0.0f, *std::min_element(Row, Row + Columns));
+      float MaximumValue = std::max(0.0f, *std::max_element(Row, Row + Columns));
+      float Scale = MaximumValue == MinimumValue ? 1.0f : (MaximumValue - MinimumValue) / 255.0f;
+      ASSERT_FLOAT_EQ(Scales[r], Scale) << ", rows=" << Rows << ", columns=" << Columns << ", row=" << r;
+
+      float ZeroPoint = std::nearbyintf(std::max(0.0f, std::min(255.0f, -MinimumValue / Scale)));
+      ASSERT_EQ(ZeroPoints[r], uint8_t(ZeroPoint)) << ", rows=" << Rows << ", columns=" << Columns << ", row=" << r;
+
+      for (size_t c = 0; c < Columns; c++) {
+        float FloatValue = std::nearbyintf(Row[c] / Scales[r]) + float(ZeroPoints[r]);
+        FloatValue = std::max(0.0f, std::min(255.0f, FloatValue));
+        ASSERT_EQ(Output[r * Columns + c], uint8_t(FloatValue))
+            << ", rows=" << Rows << ", columns=" << Columns << ", index=" << r * Columns + c;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("DynamicQuantizeLinearPerRow");
+    return suite_name.c_str();
+  }
+
+  MlasDynamicQuantizeLinearPerRowTest() : threadpool_(GetMlasThreadPool()) {}
+
+  void ExecuteShort(void) override {
+    for (size_t Rows : {1, 3, 16, 67}) {
+      for (size_t Columns : {1, 7, 64, 255, 1024}) {
+        Test(Rows, Columns);
+      }
+    }
+  }
+};
+
 template <> MlasQuantizeLinearTest<int8_t>* MlasTestFixture<MlasQuantizeLinearTest<int8_t>>::mlas_tester(nullptr);
 template <> MlasQuantizeLinearTest<uint8_t>* MlasTestFixture<MlasQuantizeLinearTest<uint8_t>>::mlas_tester(nullptr);
+template <> MlasDynamicQuantizeLinearPerRowTest* MlasTestFixture<MlasDynamicQuantizeLinearPerRowTest>::mlas_tester(nullptr);
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
   if (is_short_execute) {
       count += MlasDirectShortExecuteTests<MlasQuantizeLinearTest<int8_t>>::RegisterShortExecute();
       count += MlasDirectShortExecuteTests<MlasQuantizeLinearTest<uint8_t>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasDynamicQuantizeLinearPerRowTest>::RegisterShortExecute();
   }
   return count;
 });
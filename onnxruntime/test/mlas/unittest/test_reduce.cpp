@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+
+template <bool Threaded>
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  static double ReferenceReduce(MLAS_REDUCE_KIND Kind, const float* Input, size_t ReduceCount, size_t Stride) {
+    double Maximum = Input[0];
+    for (size_t r = 1; r < ReduceCount; r++) {
+      Maximum = std::max(Maximum, double(Input[r * Stride]));
+    }
+
+    double Value = 0.0;
+    for (size_t r = 0; r < ReduceCount; r++) {
+      const double x = Input[r * Stride];
+      switch (Kind) {
+        case MlasReduceSum:
+          Value += x;
+          break;
+        case MlasReduceSumSquare:
+          Value += x * x;
+          break;
+        case MlasReduceMaximum:
+          Value = (r == 0) ? x : std::max(Value, x);
+          break;
+        case MlasReduceMinimum:
+          Value = (r == 0) ? x : std::min(Value, x);
+          break;
+        case MlasReduceLogSumExp:
+          Value += std::exp(x - Maximum);
+          break;
+      }
+    }
+
+    if (Kind == MlasReduceLogSumExp) {
+      Value = Maximum + std::log(Value);
+    }
+    return Value;
+  }
+
+  void Test(MLAS_REDUCE_KIND Kind, size_t OuterCount, size_t ReduceCount, size_t InnerCount) {
+    const size_t TotalCount = OuterCount * ReduceCount * InnerCount;
+    const size_t OutputCount = OuterCount * InnerCount;
+
+    float* Input = BufferInput.GetBuffer(TotalCount);
+    float* Output = BufferOutput.GetBuffer(OutputCount);
+
+    std::default_random_engine generator(static_cast<unsigned>(TotalCount + InnerCount));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    for (size_t i = 0; i < TotalCount; i++) {
+      Input[i] = distribution(generator);
+    }
+
+    if (InnerCount == 1) {
+      MlasReduceInnermost(Kind, Input, Output, OuterCount, ReduceCount, threadpool_);
+    } else {
+      MlasReduceStrided(Kind, Input, Output, OuterCount, ReduceCount, InnerCount, threadpool_);
+    }
+
+    for (size_t o = 0; o < OuterCount; o++) {
+      for (size_t i = 0; i < InnerCount; i++) {
+        const double Reference =
+            ReferenceReduce(Kind, Input + o * ReduceCount * InnerCount + i, ReduceCount, InnerCount);
+        const float Value = Output[o * InnerCount + i];
+        if (Kind == MlasReduceMaximum || Kind == MlasReduceMinimum) {
+          ASSERT_EQ(Value, float(Reference)) << "Kind=" << int(Kind) << " @[" << o << "," << i << "] of ["
+                                             << OuterCount << "," << ReduceCount << "," << InnerCount << "]";
+        } else {
+          ASSERT_NEAR(Value, Reference, 1e-3 + std::fabs(Reference) * 1e-4)
+              << "Kind=" << int(Kind) << " @[" << o << "," << i << "] of [" << OuterCount << "," << ReduceCount
+              << "," << InnerCount << "]";
+        }
+      }
+    }
+  }
+
+ public:
+  MlasReduceTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Reduce") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_REDUCE_KIND Kind : {MlasReduceSum, MlasReduceSumSquare, MlasReduceMaximum, MlasReduceMinimum,
+                                  MlasReduceLogSumExp}) {
+      for (size_t ReduceCount : {1, 3, 16, 17, 255, 1000}) {
+        Test(Kind, 5, ReduceCount, 1);
+        Test(Kind, 2, ReduceCount, 7);
+        Test(Kind, 3, ReduceCount, 33);
+      }
+      Test(Kind, 1, 100000, 1);
+      Test(Kind, 1, 20000, 3);
+      Test(Kind, 1, 512, 768);
+      Test(Kind, 1000, 40, 1);
+    }
+  }
+};
+
+template <> MlasReduceTest<false>* MlasTestFixture<MlasReduceTest<false>>::mlas_tester(nullptr);
+template <> MlasReduceTest<true>* MlasTestFixture<MlasReduceTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasReduceTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasReduceTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
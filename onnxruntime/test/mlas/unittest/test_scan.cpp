@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasPrefixSumTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t OuterCount, size_t ScanCount, size_t InnerCount, bool Exclusive, bool Reverse, bool InPlace) {
+    const size_t ElementCount = OuterCount * ScanCount * InnerCount;
+
+    float* Input = BufferInput.GetBuffer(ElementCount);
+    float* Output = InPlace ? Input : BufferOutput.GetBuffer(ElementCount);
+
+    std::default_random_engine generator(static_cast<unsigned>(ElementCount));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> Values(ElementCount);
+    for (size_t i = 0; i < ElementCount; i++) {
+      Values[i] = distribution(generator);
+      Input[i] = Values[i];
+    }
+
+    MlasPrefixSum(Input, Output, OuterCount, ScanCount, InnerCount, Exclusive, Reverse, threadpool_);
+
+    for (size_t o = 0; o < OuterCount; o++) {
+      for (size_t i = 0; i < InnerCount; i++) {
+        double Sum = 0.0;
+        double Magnitude = 0.0;
+        for (size_t k = 0; k < ScanCount; k++) {
+          const size_t s = Reverse ? ScanCount - 1 - k : k;
+          const size_t index = (o * ScanCount + s) * InnerCount + i;
+          double Expected = Sum;
+          Sum += Values[index];
+          Magnitude += std::fabs(Values[index]);
+          if (!Exclusive) {
+            Expected = Sum;
+          }
+          // the chunks and segments change the order of the additions
+          ASSERT_NEAR(Output[index], Expected, 1e-5 + Magnitude * 1e-6)
+              << "@[" << o << "," << s << "," << i << "] of [" << OuterCount << "," << ScanCount << ","
+              << InnerCount << "] Exclusive=" << Exclusive << " Reverse=" << Reverse << " InPlace=" << InPlace;
+        }
+      }
+    }
+  }
+
+ public:
+  MlasPrefixSumTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("PrefixSum") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool Exclusive : {false, true}) {
+      for (bool Reverse : {false, true}) {
+        for (size_t ScanCount : {1, 2, 7, 63, 64, 67, 1000}) {
+          for (size_t InnerCount : {1, 3, 4, 16, 21, 50}) {
+            Test(3, ScanCount, InnerCount, Exclusive, Reverse, false);
+          }
+        }
+        Test(2, 100, 9, Exclusive, Reverse, true);
+        Test(1, 200003, 1, Exclusive, Reverse, false);
+        Test(1, 200003, 1, Exclusive, Reverse, true);
+        Test(1, 20011, 24, Exclusive, Reverse, false);
+        Test(4, 50021, 1, Exclusive, Reverse, false);
+      }
+    }
+  }
+};
+
+template <> MlasPrefixSumTest<false>* MlasTestFixture<MlasPrefixSumTest<false>>::mlas_tester(nullptr);
+template <> MlasPrefixSumTest<true>* MlasTestFixture<MlasPrefixSumTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasPrefixSumTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasPrefixSumTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -9,6 +9,9 @@ class MlasSoftmaxTest : public MlasTestBase {
   MatrixGuardBuffer<float> BufferInput;
   MatrixGuardBuffer<float> BufferOutput;
   MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferInputCopy;
+  MatrixGuardBuffer<uint8_t> BufferQuantizedOutput;
+  MatrixGuardBuffer<float> BufferMask;
   MLAS_THREADPOOL* threadpool_;
 
   void Test(size_t N, size_t D, float MinimumValue, float MaximumValue) {
@@ -25,6 +28,24 @@ class MlasSoftmaxTest : public MlasTestBase {
 
     Test(Input, Output, OutputReference, N, D, false);
     Test(Input, Output, OutputReference, N, D, true);
+    TestQuantized(Input, OutputReference, N, D);
+  }
+
+  void TestQuantized(const float* Input, float* OutputReference, size_t N, size_t D) {
+    // the input is overwritten
+    float* InputCopy = BufferInputCopy.GetBuffer(N * D);
+    uint8_t* QuantizedOutput = BufferQuantizedOutput.GetBuffer(N * D);
+    std::copy_n(Input, N * D, InputCopy);
+
+    MlasComputeSoftmaxQuantized(InputCopy, QuantizedOutput, N, D, threadpool_);
+    ReferenceSoftmax(Input, OutputReference, N, D, false);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      float expected = std::nearbyint(OutputReference[nd] * 255.0f);
+      ASSERT_LE(std::fabs(float(QuantizedOutput[nd]) - expected), 1.0f)
+          << "Quantized difference " << N << "/" << D
+          << ", got: " << int(QuantizedOutput[nd]) << ", expecting: " << expected;
+    }
   }
 
   void Test(const float* Input, float* Output, float* OutputReference, size_t N, size_t D, bool LogSoftmax) {
@@ -42,6 +63,54 @@ class MlasSoftmaxTest : public MlasTestBase {
     }
   }
 
+  void TestMasked(size_t N, size_t D, float Scale, size_t MaskRowCount, bool Causal, size_t CausalOffset,
+                  bool LogSoftmax) {
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+    float* InputReference = BufferInputCopy.GetBuffer(N * D);
+    float* Mask = MaskRowCount > 0 ? BufferMask.GetBuffer(MaskRowCount * D) : nullptr;
+
+    std::default_random_engine generator(static_cast<unsigned>(N * D + MaskRowCount));
+    std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      Input[nd] = distribution(generator);
+    }
+    for (size_t md = 0; md < MaskRowCount * D; md++) {
+      Mask[md] = (md % 3 == 0) ? -10000.0f : distribution(generator);
+    }
+
+    // the reference computes the softmax of the valid columns of each row
+    for (size_t n = 0; n < N; n++) {
+      const size_t ValidD = Causal ? (std::min)(D, n + CausalOffset + 1) : D;
+      for (size_t d = 0; d < ValidD; d++) {
+        InputReference[d] = Input[n * D + d] * Scale + (Mask != nullptr ? Mask[(n % MaskRowCount) * D + d] : 0.0f);
+      }
+      ReferenceSoftmax(InputReference, OutputReference + n * D, 1, ValidD, LogSoftmax);
+      for (size_t d = ValidD; d < D; d++) {
+        OutputReference[n * D + d] = LogSoftmax ? -std::numeric_limits<float>::infinity() : 0.0f;
+      }
+    }
+
+    // in place
+    std::copy_n(Input, N * D, Output);
+    MlasComputeSoftmaxMasked(Output, Output, N, D, Scale, Mask, MaskRowCount, Causal, CausalOffset, LogSoftmax,
+                             threadpool_);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      if (std::isinf(OutputReference[nd])) {
+        ASSERT_EQ(Output[nd], OutputReference[nd]) << "masked @" << nd << " of " << N << "/" << D;
+        continue;
+      }
+      float diff = std::fabs(Output[nd] - OutputReference[nd]);
+      ASSERT_TRUE(diff <= 1e-5f || diff <= std::fabs(OutputReference[nd]) * 1e-5f)
+          << "LogSoftmax:" << (int)LogSoftmax << " Causal:" << Causal << " MaskRowCount:" << MaskRowCount
+          << " difference @" << nd << " of " << N << "/" << D
+          << ", got: " << Output[nd] << ", expecting: " << OutputReference[nd];
+    }
+  }
+
   void ReferenceSoftmax(const float* Input, float* Output, size_t N, size_t D, bool LogSoftmax) {
     for (size_t n = 0; n < N; n++) {
       float MaximumValue = std::numeric_limits<float>::lowest();
@@ -94,6 +163,16 @@ class MlasSoftmaxTest : public MlasTestBase {
     Test(3, 128, 20.f, 30.f);
     Test(63, 95, -150.f, 190.f);
     Test(16, 211, 20.f, 30.f);
+
+    for (bool LogSoftmax : {false, true}) {
+      for (size_t D : {1, 7, 64, 129}) {
+        TestMasked(9, D, 0.125f, 0, false, 0, LogSoftmax);
+        TestMasked(9, D, 1.0f, 1, false, 0, LogSoftmax);
+        TestMasked(9, D, 0.5f, 9, false, 0, LogSoftmax);
+        TestMasked(9, D, 1.0f, 3, true, 0, LogSoftmax);
+        TestMasked(9, D, 0.25f, 0, true, 5, LogSoftmax);
+      }
+    }
   }
 };
 
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  // Pattern 0 keeps every 5th row of B, pattern 1 keeps one value per group of 8 rows of a column.
+  void Test(size_t M, size_t N, size_t K, bool TransA, bool TransB, int Pattern, float beta,
+            MLAS_SPARSE_GEMM_FORMAT ExpectedFormat) {
+    const float alpha = 0.5f;
+    const size_t lda = TransA ? M : K;
+    const size_t ldb = TransB ? K : N;
+
+    float* A = BufferA.GetBuffer(M * K);
+    float* B = BufferB.GetBuffer(K * N);
+    float* C = BufferC.GetBuffer(M * N);
+    float* CReference = BufferCReference.GetBuffer(M * N);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 7 + N * 13 + K));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = distribution(generator);
+    }
+    for (size_t k = 0; k < K; k++) {
+      for (size_t n = 0; n < N; n++) {
+        const bool Nonzero = (Pattern == 0) ? (k % 5 == 0) : ((k + n) % 8 == 0);
+        B[TransB ? n * K + k : k * N + n] = Nonzero ? distribution(generator) : 0.0f;
+      }
+    }
+    for (size_t i = 0; i < M * N; i++) {
+      C[i] = CReference[i] = distribution(generator);
+    }
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          Sum += double(TransA ? A[k * lda + m] : A[m * lda + k]) * double(TransB ? B[n * ldb + k] : B[k * ldb + n]);
+        }
+        CReference[m * N + n] = float(alpha * Sum + beta * CReference[m * N + n]);
+      }
+    }
+
+    MLAS_SPARSE_GEMM_FORMAT Format;
+    const size_t PackedBSize = MlasSparseGemmPackBSize(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb, &Format);
+    ASSERT_NE(PackedBSize, size_t(0)) << "M/N/K " << M << "/" << N << "/" << K << " Pattern:" << Pattern;
+    ASSERT_EQ(Format, ExpectedFormat) << "M/N/K " << M << "/" << N << "/" << K << " Pattern:" << Pattern;
+
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasSparseGemmPackB(Format, TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb, PackedB);
+
+    MlasSparseGemm(TransA ? CblasTrans : CblasNoTrans, M, N, K, alpha, A, lda, PackedB, beta, C, N, threadpool_);
+
+    constexpr float AbsoluteTolerance = 1e-4f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t i = 0; i < M * N; i++) {
+      float diff = std::fabs(C[i] - CReference[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(CReference[i]) * RelativeTolerance)
+          << "M/N/K " << M << "/" << N << "/" << K << " TransA:" << TransA << " TransB:" << TransB
+          << " Pattern:" << Pattern << " @" << i << ", got: " << C[i] << ", expecting: " << CReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SparseGemm_Threaded" : "SparseGemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasSparseGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (bool TransA : {false, true}) {
+      for (bool TransB : {false, true}) {
+        for (float beta : {0.0f, 1.5f}) {
+          for (size_t M : {1, 3, 4, 9, 33}) {
+            for (size_t N : {16, 17, 70}) {
+              Test(M, N, 100, TransA, TransB, 0, beta, MlasSparseGemmBlockCsr);
+              Test(M, N, 100, TransA, TransB, 1, beta, MlasSparseGemmStructured);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void ExecuteLong(void) override {
+    // Dense matrices are left to MlasGemm.
+    float* B = BufferB.GetBuffer(64 * 64);
+    for (size_t i = 0; i < 64 * 64; i++) {
+      B[i] = 1.0f + float(i % 3);
+    }
+    MLAS_SPARSE_GEMM_FORMAT Format;
+    ASSERT_EQ(MlasSparseGemmPackBSize(CblasNoTrans, 64, 64, B, 64, &Format), size_t(0));
+
+    for (size_t K : {9, 64, 257, 1024}) {
+      for (size_t M : {1, 16, 129}) {
+        for (size_t N : {32, 129, 512}) {
+          Test(M, N, K, false, true, 0, 0.0f, MlasSparseGemmBlockCsr);
+          Test(M, N, K, false, false, 1, 1.0f, MlasSparseGemmStructured);
+        }
+      }
+    }
+  }
+};
+
+template <> MlasSparseGemmTest<false>* MlasTestFixture<MlasSparseGemmTest<false>>::mlas_tester(nullptr);
+template <> MlasSparseGemmTest<true>* MlasTestFixture<MlasSparseGemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparseGemmTest<true>>::RegisterShortExecute();
+    }
+  } else {
+    count += MlasLongExecuteTests<MlasSparseGemmTest<false>>::RegisterLongExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasLongExecuteTests<MlasSparseGemmTest<true>>::RegisterLongExecute();
+    }
+  }
+  return count;
+});
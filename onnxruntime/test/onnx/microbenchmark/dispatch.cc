@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// A chain of `num_nodes` Relu nodes on a single float, so the run time is dominated by the executor.
+static std::string SerializeReluChain(int64_t num_nodes) {
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  Model model("relu_chain", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}}, {}, *logger);
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  NodeArg* input = &graph.GetOrCreateNodeArg("X", &float_tensor);
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    NodeArg* output = &graph.GetOrCreateNodeArg(i + 1 == num_nodes ? "Y" : "T" + std::to_string(i), &float_tensor);
+    graph.AddNode("relu_" + std::to_string(i), "Relu", "", {input}, {output});
+    input = output;
+  }
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  return serialized;
+}
+
+// Per-node overhead of SequentialExecutor for a graph of trivial nodes. Arg 1 enables the profiler, which forces
+// the executor to trace every node.
+static void BM_SequentialExecutorDispatch(benchmark::State& state) {
+  const int64_t num_nodes = 1000;
+  const std::string model_data = SerializeReluChain(num_nodes);
+
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetSessionGraphOptimizationLevel(session_options, ORT_DISABLE_ALL));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, 1));
+  if (state.range(0) != 0) {
+    ORT_BREAK_ON_ERROR(g_ort->EnableProfiling(session_options, ORT_TSTR("dispatch_benchmark")));
+  }
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options,
+                                                   &session));
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  float input_data = -1.0f;
+  const int64_t shape = 1;
+  OrtValue* input;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &input_data, sizeof(float), &shape, 1,
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input));
+  const char* input_name = "X";
+  const char* output_name = "Y";
+
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, &input_name, &input, 1, &output_name, 1, &output));
+    g_ort->ReleaseValue(output);
+  }
+  // seconds per node
+  state.counters["time_per_node"] = benchmark::Counter(static_cast<double>(num_nodes),
+                                                       benchmark::Counter::kIsIterationInvariantRate |
+                                                           benchmark::Counter::kInvert);
+
+  g_ort->ReleaseValue(input);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+BENCHMARK(BM_SequentialExecutorDispatch)
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
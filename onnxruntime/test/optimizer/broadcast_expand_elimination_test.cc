@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "core/graph/graph_utils.h"
+#include "test/framework/test_utils.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(BroadcastExpandEliminationTests, RemoveExpandOfAttentionMask) {
+  // Add(scores, Expand(mask, [2, 4, 8, 8])) is the same as Add(scores, mask).
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    auto* scores_arg = helper.MakeInput<float>({2, 4, 8, 8}, -1.0f, 1.0f);
+    auto* mask_arg = helper.MakeInput<float>({2, 1, 1, 8}, -1.0f, 1.0f);
+    auto* expand_out = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddNode("Expand", {mask_arg, helper.Make1DInitializer<int64_t>({2, 4, 8, 8})}, {expand_out});
+    helper.AddNode("Add", {scores_arg, expand_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Expand"], 0);
+    EXPECT_EQ(op_to_count["Add"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+TEST(BroadcastExpandEliminationTests, KeepExpandForOtherConsumers) {
+  // The Where node gets the input of the Expand node, and the Expand node stays for the Relu node.
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    auto* condition_arg = helper.MakeInputBool({3, 5, 6});
+    auto* bias_arg = helper.MakeInput<float>({1, 6}, -1.0f, 1.0f);
+    auto* other_arg = helper.MakeInput<float>({3, 5, 6}, -1.0f, 1.0f);
+    auto* expand_out = helper.MakeIntermediate();
+    auto* where_out = helper.MakeOutput();
+    auto* relu_out = helper.MakeOutput();
+
+    helper.AddNode("Expand", {bias_arg, helper.Make1DInitializer<int64_t>({3, 5, 6})}, {expand_out});
+    helper.AddNode("Where", {condition_arg, expand_out, other_arg}, {where_out});
+    helper.AddNode("Relu", {expand_out}, {relu_out});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    const Graph& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Expand"], 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Where") {
+        EXPECT_EQ(graph_utils::GetInputNode(node, 1), nullptr);
+      }
+    }
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+TEST(BroadcastExpandEliminationTests, KeepExpandThatChangesOutputShape) {
+  // The output of Mul is [4, 3, 5] with the Expand node and [3, 5] without it.
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    auto* input_arg = helper.MakeInput<float>({3, 1}, -1.0f, 1.0f);
+    auto* scale_arg = helper.MakeInput<float>({5}, -1.0f, 1.0f);
+    auto* expand_out = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddNode("Expand", {input_arg, helper.Make1DInitializer<int64_t>({4, 3, 5})}, {expand_out});
+    helper.AddNode("Mul", {expand_out, scale_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Expand"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
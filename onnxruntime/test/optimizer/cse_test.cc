@@ -293,5 +293,108 @@ TEST(CseTests, MergeConstants) {
   ASSERT_EQ(op_count["Add"], 2);
 }
 
+TEST(CseTests, CommutativeInputsAndDefaultAttributes) {
+  ONNX_NAMESPACE::TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  Model model("CseCommutativeInputsAndDefaultAttributes", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_tensor_type);
+  auto& add_1 = graph.GetOrCreateNodeArg("add_1", &float_tensor_type);
+  auto& add_2 = graph.GetOrCreateNodeArg("add_2", &float_tensor_type);
+  auto& leaky_relu_1 = graph.GetOrCreateNodeArg("leaky_relu_1", &float_tensor_type);
+  auto& leaky_relu_2 = graph.GetOrCreateNodeArg("leaky_relu_2", &float_tensor_type);
+  auto& result_1 = graph.GetOrCreateNodeArg("Result1", &float_tensor_type);
+  auto& result_2 = graph.GetOrCreateNodeArg("Result2", &float_tensor_type);
+  graph.AddNode("add_1", "Add", "", {&x, &y}, {&add_1});
+  graph.AddNode("add_2", "Add", "", {&y, &x}, {&add_2});
+  graph.AddNode("leaky_relu_1", "LeakyRelu", "", {&x}, {&leaky_relu_1});
+  graph.AddNode("leaky_relu_2", "LeakyRelu", "", {&x}, {&leaky_relu_2}).AddAttribute("alpha", 0.01f);
+  graph.AddNode("sub_1", "Sub", "", {&add_1, &add_2}, {&result_1});
+  graph.AddNode("sub_2", "Sub", "", {&leaky_relu_1, &leaky_relu_2}, {&result_2});
+  graph.SetInputs({&x, &y});
+  graph.SetOutputs({&result_1, &result_2});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyCse(model);
+
+  auto op_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count["Add"], 1);
+  ASSERT_EQ(op_count["LeakyRelu"], 1);
+  ASSERT_EQ(op_count["Sub"], 2);
+}
+
+TEST(CseTests, SubgraphUsesOuterScopeValue) {
+  ONNX_NAMESPACE::TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  ONNX_NAMESPACE::TypeProto bool_tensor_type;
+  bool_tensor_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  bool_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  // then: Result = Abs(Neg(x)), which recomputes the Neg of the main graph
+  ONNX_NAMESPACE::GraphProto then_proto;
+  {
+    Model model("CseSubgraphUsesOuterScopeValue_then", false, DefaultLoggingManager().DefaultLogger());
+    Graph& branch = model.MainGraph();
+    auto& x = branch.GetOrCreateNodeArg("x", &float_tensor_type);
+    branch.AddOuterScopeNodeArg("x");
+    auto& neg = branch.GetOrCreateNodeArg("then_neg", &float_tensor_type);
+    auto& result = branch.GetOrCreateNodeArg("then_result", &float_tensor_type);
+    branch.AddNode("then_neg", "Neg", "", {&x}, {&neg});
+    branch.AddNode("then_abs", "Abs", "", {&neg}, {&result});
+    branch.SetOutputs({&result});
+    ASSERT_TRUE(branch.Resolve().IsOK());
+    then_proto = branch.ToGraphProto();
+  }
+
+  // else: Result = Identity(neg), which makes the If node consume the Neg of the main graph
+  ONNX_NAMESPACE::GraphProto else_proto;
+  {
+    Model model("CseSubgraphUsesOuterScopeValue_else", false, DefaultLoggingManager().DefaultLogger());
+    Graph& branch = model.MainGraph();
+    auto& neg = branch.GetOrCreateNodeArg("neg", &float_tensor_type);
+    branch.AddOuterScopeNodeArg("neg");
+    auto& result = branch.GetOrCreateNodeArg("else_result", &float_tensor_type);
+    branch.AddNode("else_identity", "Identity", "", {&neg}, {&result});
+    branch.SetOutputs({&result});
+    ASSERT_TRUE(branch.Resolve().IsOK());
+    else_proto = branch.ToGraphProto();
+  }
+
+  Model model("CseSubgraphUsesOuterScopeValue", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  auto& b = graph.GetOrCreateNodeArg("b", &bool_tensor_type);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+  auto& neg = graph.GetOrCreateNodeArg("neg", &float_tensor_type);
+  auto& result = graph.GetOrCreateNodeArg("Result", &float_tensor_type);
+  graph.AddNode("neg", "Neg", "", {&x}, {&neg});
+  auto& if_node = graph.AddNode("if_0", "If", "", {&b}, {&result});
+  if_node.AddAttribute("then_branch", then_proto);
+  if_node.AddAttribute("else_branch", else_proto);
+  graph.SetInputs({&b, &x});
+  graph.SetOutputs({&result});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ApplyCse(model);
+
+  auto op_count = CountOpsInGraph(graph, false);
+  ASSERT_EQ(op_count["Neg"], 1);
+
+  const Graph* then_graph = graph.GetNode(if_node.Index())->GetGraphAttribute("then_branch");
+  ASSERT_NE(then_graph, nullptr);
+  // Keep VC++ static analyzer happy
+  if (then_graph) {
+    op_count = CountOpsInGraph(*then_graph);
+    ASSERT_EQ(op_count["Neg"], 0);
+    ASSERT_EQ(op_count["Abs"], 1);
+    for (const auto& node : then_graph->Nodes()) {
+      ASSERT_EQ(node.InputDefs()[0]->Name(), "neg");
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
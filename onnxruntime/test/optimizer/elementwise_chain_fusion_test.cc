@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "core/graph/graph_utils.h"
+#include "test/framework/test_utils.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(ElementwiseChainFusionTests, FuseChain) {
+  // Mul(scalar) -> Add(bias, .) -> Sub(scalar, .) -> Relu -> Div(., y) -> Sigmoid, over several tiles
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    auto* input_arg = helper.MakeInput<float>({2, 3, 1000}, -1.0f, 1.0f);
+    auto* bias_arg = helper.MakeInput<float>({2, 3, 1000}, -1.0f, 1.0f);
+    auto* divisor_arg = helper.MakeInput<float>({2, 3, 1000}, 1.0f, 2.0f);
+    auto* mul_out = helper.MakeIntermediate();
+    auto* add_out = helper.MakeIntermediate();
+    auto* sub_out = helper.MakeIntermediate();
+    auto* relu_out = helper.MakeIntermediate();
+    auto* div_out = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddNode("Mul", {input_arg, helper.MakeScalarInitializer<float>(1.5f)}, {mul_out});
+    helper.AddNode("Add", {bias_arg, mul_out}, {add_out});
+    helper.AddNode("Sub", {helper.MakeInitializer<float>({1}, {0.25f}), add_out}, {sub_out});
+    helper.AddNode("Relu", {sub_out}, {relu_out});
+    helper.AddNode("Div", {relu_out, divisor_arg}, {div_out});
+    helper.AddNode("Sigmoid", {div_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Div"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level2, TransformerLevel::Level3);
+}
+
+TEST(ElementwiseChainFusionTests, StopAtSharedValue) {
+  // The output of Relu is also a graph output, so Add -> Relu and Mul -> Tanh are fused separately.
+  // The Add with a broadcast bias is not fused into the second chain.
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    auto* input_arg = helper.MakeInput<float>({4, 16}, -1.0f, 1.0f);
+    auto* add_out = helper.MakeIntermediate();
+    auto* relu_out = helper.MakeOutput();
+    auto* mul_out = helper.MakeIntermediate();
+    auto* tanh_out = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddNode("Add", {input_arg, helper.MakeScalarInitializer<float>(0.5f)}, {add_out});
+    helper.AddNode("Relu", {add_out}, {relu_out});
+    helper.AddNode("Mul", {relu_out, relu_out}, {mul_out});
+    helper.AddNode("Tanh", {mul_out}, {tanh_out});
+    helper.AddNode("Add", {tanh_out, helper.MakeInitializer<float>({16}, -1.0f, 1.0f)}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 2);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level2, TransformerLevel::Level3);
+}
+
+TEST(ElementwiseChainFusionTests, SplitLongChain) {
+  // A chain of 20 nodes is longer than a FusedElementwise node runs, it is split after 16 nodes.
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    NodeArg* value = helper.MakeInput<float>({8, 32}, -1.0f, 1.0f);
+    for (int i = 0; i < 20; i++) {
+      NodeArg* next = i == 19 ? helper.MakeOutput() : helper.MakeIntermediate();
+      if (i % 2 == 0) {
+        helper.AddNode("Mul", {value, helper.MakeScalarInitializer<float>(0.9f)}, {next});
+      } else {
+        helper.AddNode("Tanh", {value}, {next});
+      }
+      value = next;
+    }
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 2);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level2, TransformerLevel::Level3);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
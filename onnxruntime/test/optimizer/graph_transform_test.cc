@@ -50,7 +50,9 @@
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_add_fusion.h"
+#include "core/optimizer/matmul_fast_gelu_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
@@ -59,6 +61,7 @@
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaler_linear_fusion.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
 #include "core/optimizer/unsqueeze_elimination.h"
@@ -66,6 +69,7 @@
 #include "core/optimizer/propagate_cast_ops.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math.h"
@@ -73,6 +77,7 @@
 #include "test/common/tensor_op_test_utils.h"
 #include "test/compare_ortvalue.h"
 #include "test/framework/test_utils.h"
+#include "test/optimizer/graph_transform_test_builder.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/test_environment.h"
@@ -375,6 +380,327 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingSubgraphWithThreadPool) {
+  concurrency::ThreadPool thread_pool(&Env::Default(), ThreadOptions(), ORT_TSTR("ConstantFoldingSubgraph"), 2, true);
+
+  TensorProto value_tensor;
+  value_tensor.add_dims(1);
+  value_tensor.add_float_data(1.f);
+  value_tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto create_subgraph = [&](GraphProto& graph_proto) {
+    // create subgraph that has an Add node to add a local and parent graph initializer
+    Model model("ConstantFoldingSubgraphTest_subgraph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+
+    TensorProto local_constant(value_tensor);
+    local_constant.set_name("local_constant");
+    graph.AddInitializedTensor(local_constant);
+
+    auto& local_constant_arg = graph.GetOrCreateNodeArg("local_constant", &float_tensor_type);
+    auto& parent_constant_arg = graph.GetOrCreateNodeArg("parent_constant", &float_tensor_type);
+    graph.AddOuterScopeNodeArg("parent_constant");
+
+    auto& add_out = graph.GetOrCreateNodeArg("add_out", &float_tensor_type);
+    graph.AddNode("add", "Add", "Add two inputs.", {&parent_constant_arg, &local_constant_arg}, {&add_out});
+
+    auto& subgraph_out = graph.GetOrCreateNodeArg("subgraph_out", &float_tensor_type);
+    graph.AddNode("identity", "Identity", "So Add isn't providing graph output.", {&add_out}, {&subgraph_out});
+
+    ASSERT_STATUS_OK(graph.Resolve());
+    graph_proto = graph.ToGraphProto();
+  };
+
+  Model model("ConstantFoldingSubgraphTest_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  // add initializer at parent level
+  TensorProto parent_value_tensor(value_tensor);
+  parent_value_tensor.set_name("parent_constant");
+  graph.AddInitializedTensor(parent_value_tensor);
+
+  // put the subgraph in an If node
+  TypeProto if_cond_type;
+  if_cond_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  if_cond_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  auto& if_cond_input = graph.GetOrCreateNodeArg("if_in", &if_cond_type);
+  auto& if_output = graph.GetOrCreateNodeArg("if_out", &float_tensor_type);
+
+  auto& if_node = graph.AddNode("if", "If", "If node", {&if_cond_input}, {&if_output});
+
+  GraphProto subgraph;
+  create_subgraph(subgraph);
+
+  if_node.AddAttribute("then_branch", subgraph);
+  if_node.AddAttribute("else_branch", subgraph);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Add"] == 2);  // one in each subgraph
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  // the subgraphs of the If node are transformed concurrently
+  graph_transformation_mgr.SetThreadPool(&thread_pool);
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/), TransformerLevel::Level1));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Add"] == 0)
+      << "Constant folding should have been able to remove the Add node in both subgraphs";
+}
+
+TEST_F(GraphTransformationTests, LoopInvariantCodeMotion) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  TypeProto int64_scalar_type;
+  int64_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto bool_scalar_type;
+  bool_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar_type.mutable_tensor_type()->mutable_shape();
+
+  // body: x_out = x_in + Neg(W) * scale + iter_num, where only the Add of the loop-carried value and the Add of the
+  // iteration number depend on the iteration
+  GraphProto body_proto;
+  {
+    Model model("LoopInvariantCodeMotionTest_body", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+    auto& body = model.MainGraph();
+
+    TensorProto scale;
+    scale.set_name("scale");
+    scale.add_dims(2);
+    scale.add_float_data(2.f);
+    scale.add_float_data(3.f);
+    scale.set_data_type(TensorProto_DataType_FLOAT);
+    body.AddInitializedTensor(scale);
+
+    auto& iter_num = body.GetOrCreateNodeArg("iter_num", &int64_scalar_type);
+    auto& cond_in = body.GetOrCreateNodeArg("cond_in", &bool_scalar_type);
+    auto& x_in = body.GetOrCreateNodeArg("x_in", &float_tensor_type);
+    auto& w = body.GetOrCreateNodeArg("W", &float_tensor_type);
+    body.AddOuterScopeNodeArg("W");
+    auto& scale_arg = body.GetOrCreateNodeArg("scale", &float_tensor_type);
+
+    auto& neg_out = body.GetOrCreateNodeArg("neg_out", &float_tensor_type);
+    auto& mul_out = body.GetOrCreateNodeArg("mul_out", &float_tensor_type);
+    auto& add_out = body.GetOrCreateNodeArg("add_out", &float_tensor_type);
+    auto& iter_float = body.GetOrCreateNodeArg("iter_float", &float_tensor_type);
+    auto& cond_out = body.GetOrCreateNodeArg("cond_out", &bool_scalar_type);
+    auto& x_out = body.GetOrCreateNodeArg("x_out", &float_tensor_type);
+    body.AddNode("neg", "Neg", "", {&w}, {&neg_out});
+    body.AddNode("mul", "Mul", "", {&neg_out, &scale_arg}, {&mul_out});
+    body.AddNode("add", "Add", "", {&x_in, &mul_out}, {&add_out});
+    body.AddNode("cast", "Cast", "", {&iter_num}, {&iter_float})
+        .AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+    body.AddNode("add_iter", "Add", "", {&add_out, &iter_float}, {&x_out});
+    body.AddNode("identity", "Identity", "", {&cond_in}, {&cond_out});
+
+    body.SetInputs({&iter_num, &cond_in, &x_in});
+    body.SetOutputs({&cond_out, &x_out});
+    ASSERT_STATUS_OK(body.Resolve());
+    body_proto = body.ToGraphProto();
+  }
+
+  Model model("LoopInvariantCodeMotionTest_main_graph", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  // the Loop runs a constant number of iterations, so its body is known to run
+  TensorProto trip_count_value;
+  trip_count_value.set_name("M");
+  trip_count_value.set_data_type(TensorProto_DataType_INT64);
+  trip_count_value.add_int64_data(3);
+  graph.AddInitializedTensor(trip_count_value);
+  TensorProto cond_value;
+  cond_value.set_name("cond");
+  cond_value.set_data_type(TensorProto_DataType_BOOL);
+  cond_value.add_int32_data(1);
+  graph.AddInitializedTensor(cond_value);
+
+  auto& trip_count = graph.GetOrCreateNodeArg("M", &int64_scalar_type);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_scalar_type);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor_type);
+  auto& w = graph.GetOrCreateNodeArg("W", &float_tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor_type);
+  auto& loop_node = graph.AddNode("loop", "Loop", "", {&trip_count, &cond, &x}, {&y});
+  loop_node.AddAttribute("body", body_proto);
+  graph.SetInputs({&x, &w});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopInvariantCodeMotion>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // Neg and the Mul with the initializer of the body move out of the body, the nodes using the iteration don't
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph, false);
+  EXPECT_EQ(op_to_count["Neg"], 1);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  EXPECT_TRUE(graph.IsInitializedTensor("scale"));
+
+  const Graph& body = *graph.GetNode(loop_node.Index())->GetGraphAttribute("body");
+  op_to_count = CountOpsInGraph(body);
+  EXPECT_EQ(op_to_count["Neg"], 0);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["Add"], 2);
+  EXPECT_EQ(op_to_count["Cast"], 1);
+  EXPECT_EQ(op_to_count["Identity"], 1);
+}
+
+// Builds a Loop body computing x_out = x_in + Neg(W) + Gather(W, gather_index) with W from the outer scope.
+// Gather fails if gather_index is out of range for W.
+static void BuildLoopInvariantCodeMotionBody(const std::string& w_name, int64_t gather_index,
+                                             const logging::Logger& logger, GraphProto& body_proto) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  TypeProto float_scalar_type;
+  float_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto int64_scalar_type;
+  int64_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto bool_scalar_type;
+  bool_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar_type.mutable_tensor_type()->mutable_shape();
+
+  Model model("LoopInvariantCodeMotionTest_body", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, logger);
+  auto& body = model.MainGraph();
+
+  TensorProto index;
+  index.set_name("gather_index");
+  index.set_data_type(TensorProto_DataType_INT64);
+  index.add_int64_data(gather_index);
+  body.AddInitializedTensor(index);
+
+  auto& iter_num = body.GetOrCreateNodeArg("iter_num", &int64_scalar_type);
+  auto& cond_in = body.GetOrCreateNodeArg("cond_in", &bool_scalar_type);
+  auto& x_in = body.GetOrCreateNodeArg("x_in", &float_tensor_type);
+  auto& w = body.GetOrCreateNodeArg(w_name, &float_tensor_type);
+  body.AddOuterScopeNodeArg(w_name);
+  auto& index_arg = body.GetOrCreateNodeArg("gather_index", &int64_scalar_type);
+
+  auto& neg_out = body.GetOrCreateNodeArg("neg_out", &float_tensor_type);
+  auto& gather_out = body.GetOrCreateNodeArg("gather_out", &float_scalar_type);
+  auto& add_out = body.GetOrCreateNodeArg("add_out", &float_tensor_type);
+  auto& cond_out = body.GetOrCreateNodeArg("cond_out", &bool_scalar_type);
+  auto& x_out = body.GetOrCreateNodeArg("x_out", &float_tensor_type);
+  body.AddNode("neg", "Neg", "", {&w}, {&neg_out});
+  body.AddNode("gather", "Gather", "", {&w, &index_arg}, {&gather_out});
+  body.AddNode("add", "Add", "", {&x_in, &neg_out}, {&add_out});
+  body.AddNode("add_gather", "Add", "", {&add_out, &gather_out}, {&x_out});
+  body.AddNode("identity", "Identity", "", {&cond_in}, {&cond_out});
+
+  body.SetInputs({&iter_num, &cond_in, &x_in});
+  body.SetOutputs({&cond_out, &x_out});
+  ASSERT_STATUS_OK(body.Resolve());
+  body_proto = body.ToGraphProto();
+}
+
+// Runs the model with and without the transformers of Level1 and compares the outputs.
+TEST_F(GraphTransformationTests, LoopInvariantCodeMotionKeepsResults) {
+  auto count_body_ops = [](InferenceSessionWrapper& session) {
+    const Graph& graph = session.GetGraph();
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Loop") {
+        return CountOpsInGraph(*node.GetGraphAttribute("body"));
+      }
+    }
+    return std::map<std::string, int>{};
+  };
+
+  // constant trip count and condition: the body runs, so Neg and Gather move out of it
+  {
+    auto build_test_case = [](ModelTestBuilder& builder) {
+      auto* w = builder.MakeInput<float>({2}, {1.f, 2.f});
+      auto* x = builder.MakeInput<float>({2}, {3.f, 4.f});
+      auto* trip_count = builder.MakeScalarInitializer<int64_t>(3);
+
+      TensorProto cond_value;
+      cond_value.set_name("cond");
+      cond_value.set_data_type(TensorProto_DataType_BOOL);
+      cond_value.add_int32_data(1);
+      builder.graph_.AddInitializedTensor(cond_value);
+      auto* cond = &builder.graph_.GetOrCreateNodeArg("cond", nullptr);
+
+      GraphProto body_proto;
+      BuildLoopInvariantCodeMotionBody(w->Name(), 1, DefaultLoggingManager().DefaultLogger(), body_proto);
+      builder.AddNode("Loop", {trip_count, cond, x}, {builder.MakeOutput()}).AddAttribute("body", body_proto);
+    };
+
+    auto check_graph = [&count_body_ops](InferenceSessionWrapper& session) {
+      auto op_to_count = count_body_ops(session);
+      EXPECT_EQ(op_to_count["Neg"], 0);
+      EXPECT_EQ(op_to_count["Gather"], 0);
+      EXPECT_EQ(op_to_count["Add"], 2);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1, 13);
+  }
+
+  // trip count of 0 from a graph input: the body doesn't run, so the Gather that would fail must stay in it.
+  // Neg can't fail, so it still moves out.
+  {
+    auto build_test_case = [](ModelTestBuilder& builder) {
+      auto* w = builder.MakeInput<float>({2}, {1.f, 2.f});
+      auto* x = builder.MakeInput<float>({2}, {3.f, 4.f});
+      auto* trip_count = builder.MakeInput<int64_t>({}, {0});
+      auto* cond = builder.MakeInput<bool>({}, {true});
+
+      GraphProto body_proto;
+      BuildLoopInvariantCodeMotionBody(w->Name(), 5, DefaultLoggingManager().DefaultLogger(), body_proto);
+      builder.AddNode("Loop", {trip_count, cond, x}, {builder.MakeOutput()}).AddAttribute("body", body_proto);
+    };
+
+    auto check_graph = [&count_body_ops](InferenceSessionWrapper& session) {
+      auto op_to_count = count_body_ops(session);
+      EXPECT_EQ(op_to_count["Neg"], 0);
+      EXPECT_EQ(op_to_count["Gather"], 1);
+      EXPECT_EQ(op_to_count["Add"], 2);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1, 13);
+  }
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingWithThreadPool) {
+  concurrency::ThreadPool thread_pool(&Env::Default(), ThreadOptions(), ORT_TSTR("ConstantFoldingWithThreadPool"), 4,
+                                      true);
+
+  // independent nodes of the main graph are folded concurrently
+  {
+    auto model_uri = MODEL_FOLDER "fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+    Graph& graph = model->MainGraph();
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["Unsqueeze"] == 2);
+    std::unique_ptr<CPUExecutionProvider> e =
+        std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    graph_transformation_mgr.SetThreadPool(&thread_pool);
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/), TransformerLevel::Level1));
+
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+    op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["Unsqueeze"] == 0);
+  }
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   auto model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -945,6 +1271,54 @@ TEST_F(GraphTransformationTests, FuseConvMulNoBias) {
   ASSERT_TRUE(op_to_count["Unsqueeze"] == 0);
 }
 
+TEST_F(GraphTransformationTests, FuseScalerLinearClassifier) {
+  Model model("FuseScalerLinearClassifier", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}, {kMLDomain, 1}}, {}, *logger_);
+  Graph& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& scaled = graph.GetOrCreateNodeArg("scaled", nullptr);
+  auto& label = graph.GetOrCreateNodeArg("label", nullptr);
+  auto& probabilities = graph.GetOrCreateNodeArg("probabilities", nullptr);
+
+  // scores = ((x - offset) * scale) * coefficients^T + intercepts, with 3 classes and 2 features
+  auto& scaler = graph.AddNode("scaler", "Scaler", "", {&x}, {&scaled}, nullptr, kMLDomain);
+  scaler.AddAttribute("offset", std::vector<float>{1.f, -2.f});
+  scaler.AddAttribute("scale", std::vector<float>{0.5f, 4.f});
+  auto& classifier = graph.AddNode("classifier", "LinearClassifier", "", {&scaled}, {&label, &probabilities},
+                                   nullptr, kMLDomain);
+  classifier.AddAttribute("coefficients", std::vector<float>{1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  classifier.AddAttribute("intercepts", std::vector<float>{1.f, 0.f, -1.f});
+  classifier.AddAttribute("classlabels_ints", std::vector<int64_t>{0, 1, 2});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  auto rule_transformer_L1 = std::make_unique<RuleBasedGraphTransformer>("RuleTransformer1");
+  ASSERT_STATUS_OK(rule_transformer_L1->Register(std::make_unique<ScalerLinearFusion>()));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(rule_transformer_L1), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Scaler"], 0);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.LinearClassifier"], 1);
+
+  const Node& fused = *graph.GetNode(classifier.Index());
+  EXPECT_EQ(fused.InputDefs()[0]->Name(), "x");
+
+  InlinedVector<float> coefficients;
+  InlinedVector<float> intercepts;
+  ASSERT_TRUE(graph_utils::GetRepeatedNodeAttributeValues(fused, "coefficients", coefficients));
+  ASSERT_TRUE(graph_utils::GetRepeatedNodeAttributeValues(fused, "intercepts", intercepts));
+  EXPECT_THAT(coefficients, testing::ElementsAre(0.5f, 8.f, 1.5f, 16.f, 2.5f, 24.f));
+  // intercept - sum(coefficient * scale * offset)
+  EXPECT_THAT(intercepts, testing::ElementsAre(1.f - (0.5f - 16.f), 0.f - (1.5f - 32.f), -1.f - (2.5f - 48.f)));
+}
+
 TEST_F(GraphTransformationTests, FuseConvAddNoBias) {
   auto model_uri = MODEL_FOLDER "fusion/fuse-conv-add-no-bias.onnx";
 
@@ -1369,6 +1743,39 @@ TEST_F(GraphTransformationTests, TransposeMatmulTransBatchNoFusion) {
   }
 }
 
+// The CPU EP has a float16 MatMul kernel but only a float FusedMatMul kernel, so the fusion must leave a float16
+// Transpose and MatMul on CPU as they are for the session to initialize.
+TEST_F(GraphTransformationTests, TransposeMatmulNoFusionForFloat16OnCpu) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto to_float16 = [](const std::vector<float>& values) {
+      std::vector<MLFloat16> result;
+      result.reserve(values.size());
+      for (float value : values) {
+        result.push_back(MLFloat16(math::floatToHalf(value)));
+      }
+      return result;
+    };
+
+    RandomValueGenerator random{};
+    auto* input0_arg = builder.MakeInput<MLFloat16>({2, 4, 3}, to_float16(random.Uniform<float>({2, 4, 3}, -1.f, 1.f)));
+    auto* input1_arg = builder.MakeInput<MLFloat16>({2, 4, 5}, to_float16(random.Uniform<float>({2, 4, 5}, -1.f, 1.f)));
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Transpose", {input0_arg}, {transpose_out}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+    builder.AddNode("MatMul", {transpose_out, input1_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+    EXPECT_EQ(op_to_count["MatMul"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.FusedMatMul"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13);
+}
+
 TEST_F(GraphTransformationTests, Gemm_LeakyRelu_Fusion) {
   auto model_uri = MODEL_FOLDER "gemm_activation_fusion/gemm_activation_fusion.onnx";
 
@@ -2221,6 +2628,88 @@ TEST_F(GraphTransformationTests, ReshapeFusionTest) {
   }
 }
 
+// Test Reshape Fusion of shape subgraphs that do not match the known patterns, using their symbolic values.
+TEST_F(GraphTransformationTests, ReshapeFusionSymbolicShapeValueTest) {
+  Model model("ReshapeFusionSymbolicShapeValue", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 14}}, {}, *logger_);
+  Graph& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("sequence");
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(12);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+
+  ONNX_NAMESPACE::TypeProto tensor_int64;
+  tensor_int64.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+
+  auto add_initializer = [&](const std::string& name, int64_t value) -> NodeArg& {
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    tensor.add_dims(1);
+    tensor.add_int64_data(value);
+    graph.AddInitializedTensor(tensor);
+    return graph.GetOrCreateNodeArg(name, &tensor_int64);
+  };
+
+  // y_1 = Reshape(x, Concat(batch, sequence, 768)) and y_2 = Reshape(x, Concat(batch * sequence, 768))
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& zero = add_initializer("zero", 0);
+  auto& one = add_initializer("one", 1);
+  auto& hidden_size = add_initializer("hidden_size", 768);
+  auto& shape = graph.GetOrCreateNodeArg("shape", nullptr);
+  auto& batch = graph.GetOrCreateNodeArg("batch", nullptr);
+  auto& sequence = graph.GetOrCreateNodeArg("sequence", nullptr);
+  auto& tokens = graph.GetOrCreateNodeArg("tokens", nullptr);
+  auto& shape_1 = graph.GetOrCreateNodeArg("shape_1", nullptr);
+  auto& shape_2 = graph.GetOrCreateNodeArg("shape_2", nullptr);
+  auto& y_1 = graph.GetOrCreateNodeArg("y_1", nullptr);
+  auto& y_2 = graph.GetOrCreateNodeArg("y_2", nullptr);
+
+  graph.AddNode("shape", "Shape", "", {&x}, {&shape});
+  graph.AddNode("gather_batch", "Gather", "", {&shape, &zero}, {&batch});
+  graph.AddNode("gather_sequence", "Gather", "", {&shape, &one}, {&sequence});
+  graph.AddNode("mul", "Mul", "", {&batch, &sequence}, {&tokens});
+  graph.AddNode("concat_1", "Concat", "", {&batch, &sequence, &hidden_size}, {&shape_1})
+      .AddAttribute("axis", int64_t{0});
+  graph.AddNode("concat_2", "Concat", "", {&tokens, &hidden_size}, {&shape_2}).AddAttribute("axis", int64_t{0});
+  graph.AddNode("reshape_1", "Reshape", "", {&x, &shape_1}, {&y_1});
+  graph.AddNode("reshape_2", "Reshape", "", {&x, &shape_2}, {&y_2});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ReshapeFusion>(), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Shape"], 0);
+  ASSERT_EQ(op_to_count["Gather"], 0);
+  ASSERT_EQ(op_to_count["Mul"], 0);
+  ASSERT_EQ(op_to_count["Concat"], 0);
+  ASSERT_EQ(op_to_count["Reshape"], 2);
+
+  for (const Node& node : graph.Nodes()) {
+    const ONNX_NAMESPACE::TensorProto* tensor_proto =
+        graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+    ASSERT_TRUE(tensor_proto != nullptr);
+
+    Initializer initializer{*tensor_proto, graph.ModelPath()};
+    const int64_t* val = initializer.data<int64_t>();
+    if (node.Name() == "reshape_1") {
+      ASSERT_EQ(initializer.size(), 3);
+      EXPECT_EQ(val[0], 0);
+      EXPECT_EQ(val[1], 0);
+      EXPECT_EQ(val[2], 768);
+    } else {
+      ASSERT_EQ(initializer.size(), 2);
+      EXPECT_EQ(val[0], -1);
+      EXPECT_EQ(val[1], 768);
+    }
+  }
+}
+
 // Test Reshape Fusion with one constant initializer for Concat inputs.
 TEST_F(GraphTransformationTests, ReshapeFusionOneConstTest) {
   auto model_uri = MODEL_FOLDER "fusion/reshape_one_const.onnx";
@@ -3314,6 +3803,68 @@ TEST_F(GraphTransformationTests, FastGeluFusionTest) {
   ASSERT_TRUE(op_to_count["com.microsoft.FastGelu"] == 1);
 }
 
+// MatMul with a 2D B followed by FastGelu with a bias is fused into MatMulFastGelu on the CUDA EP.
+// The second MatMul has a 3D B and is left as is.
+TEST_F(GraphTransformationTests, MatMulFastGeluFusionTest) {
+  Model model("MatMulFastGeluFusion", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMSDomain, 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  auto make_type = [](std::initializer_list<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+
+  TypeProto a_type = make_type({2, 8, 16});
+  TypeProto b_type = make_type({16, 32});
+  TypeProto batched_b_type = make_type({2, 16, 32});
+  TypeProto bias_type = make_type({32});
+  TypeProto y_type = make_type({2, 8, 32});
+
+  auto& a = graph.GetOrCreateNodeArg("a", &a_type);
+  auto& b = graph.GetOrCreateNodeArg("b", &b_type);
+  auto& batched_b = graph.GetOrCreateNodeArg("batched_b", &batched_b_type);
+  auto& bias = graph.GetOrCreateNodeArg("bias", &bias_type);
+  auto& matmul0_output = graph.GetOrCreateNodeArg("matmul0_output", &y_type);
+  auto& matmul1_output = graph.GetOrCreateNodeArg("matmul1_output", &y_type);
+  auto& y0 = graph.GetOrCreateNodeArg("y0", &y_type);
+  auto& y1 = graph.GetOrCreateNodeArg("y1", &y_type);
+
+  graph.AddNode("matmul0", "MatMul", "MatMul to fuse", {&a, &b}, {&matmul0_output});
+  graph.AddNode("gelu0", "FastGelu", "FastGelu to fuse", {&matmul0_output, &bias}, {&y0}, nullptr, kMSDomain);
+  graph.AddNode("matmul1", "MatMul", "MatMul with a 3D B", {&a, &batched_b}, {&matmul1_output});
+  graph.AddNode("gelu1", "FastGelu", "FastGelu to keep", {&matmul1_output}, {&y1}, nullptr, kMSDomain);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<MatMulFastGeluFusion>(InlinedHashSet<std::string_view>{kCudaExecutionProvider}),
+      TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["MatMul"], 1);
+  EXPECT_EQ(op_to_count["com.microsoft.FastGelu"], 1);
+  EXPECT_EQ(op_to_count["com.microsoft.MatMulFastGelu"], 1);
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "MatMulFastGelu") {
+      ASSERT_EQ(node.InputDefs().size(), 3u);
+      EXPECT_EQ(node.InputDefs()[2]->Name(), "bias");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "y0");
+      EXPECT_EQ(node.GetExecutionProviderType(), kCudaExecutionProvider);
+    }
+  }
+}
+
 TEST_F(GraphTransformationTests, FastGeluUseGraphInputFusionTest) {
   auto model_uri = MODEL_FOLDER "fusion/fast_gelu_use_graph_input.onnx";
   std::shared_ptr<Model> p_model;
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "core/graph/graph_utils.h"
+#include "test/framework/test_utils.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+// Builds the group normalization of a (2, 32, 8, 8) input with 8 groups as exported from PyTorch.
+static void BuildExportedGroupNorm(ModelTestBuilder& helper, bool use_shape, bool with_swish) {
+  auto* input_arg = helper.MakeInput<float>({2, 32, 8, 8}, -2.0f, 2.0f);
+  auto* group_out = helper.MakeIntermediate();
+  auto* norm_out = helper.MakeIntermediate();
+  auto* restore_out = helper.MakeIntermediate();
+  auto* mul_out = helper.MakeIntermediate();
+  auto* add_out = with_swish ? helper.MakeIntermediate() : helper.MakeOutput();
+
+  helper.AddNode("Reshape", {input_arg, helper.Make1DInitializer<int64_t>({0, 8, -1})}, {group_out});
+  helper.AddNode("InstanceNormalization",
+                 {group_out, helper.MakeInitializer<float>({8}, std::vector<float>(8, 1.0f)),
+                  helper.MakeInitializer<float>({8}, std::vector<float>(8, 0.0f))},
+                 {norm_out})
+      .AddAttribute("epsilon", 1e-5f);
+
+  NodeArg* restore_shape;
+  if (use_shape) {
+    restore_shape = helper.MakeIntermediate();
+    helper.AddNode("Shape", {input_arg}, {restore_shape});
+  } else {
+    restore_shape = helper.Make1DInitializer<int64_t>({2, 32, 8, 8});
+  }
+  helper.AddNode("Reshape", {norm_out, restore_shape}, {restore_out});
+  helper.AddNode("Mul", {restore_out, helper.MakeInitializer<float>({32, 1, 1}, -1.0f, 1.0f)}, {mul_out});
+  helper.AddNode("Add", {helper.MakeInitializer<float>({32, 1, 1}, -1.0f, 1.0f), mul_out}, {add_out});
+
+  if (with_swish) {
+    auto* sigmoid_out = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+    helper.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    helper.AddNode("Mul", {add_out, sigmoid_out}, {output_arg});
+  }
+}
+
+TEST(GroupNormFusionTests, FuseExportedPattern) {
+  for (bool use_shape : {false, true}) {
+    for (bool with_swish : {false, true}) {
+      auto build_test_case = [&](ModelTestBuilder& helper) {
+        BuildExportedGroupNorm(helper, use_shape, with_swish);
+      };
+
+      auto check_graph = [&](InferenceSessionWrapper& session) {
+        auto op_to_count = CountOpsInGraph(session.GetGraph());
+        EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 1);
+        EXPECT_EQ(op_to_count["Reshape"], 0);
+        EXPECT_EQ(op_to_count["Shape"], 0);
+        EXPECT_EQ(op_to_count["InstanceNormalization"], 0);
+        EXPECT_EQ(op_to_count["Mul"], 0);
+        EXPECT_EQ(op_to_count["Add"], 0);
+        EXPECT_EQ(op_to_count["Sigmoid"], 0);
+
+        for (const auto& node : session.GetGraph().Nodes()) {
+          if (node.OpType() == "GroupNorm") {
+            EXPECT_EQ(node.GetAttributes().at("groups").i(), 8);
+            EXPECT_EQ(node.GetAttributes().at("activation").i(), with_swish ? 1 : 0);
+            EXPECT_EQ(node.GetAttributes().at("channels_last").i(), 0);
+          }
+        }
+      };
+
+      TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+    }
+  }
+}
+
+TEST(GroupNormFusionTests, NotFusedWithInstanceNormScale) {
+  // The scale of the InstanceNormalization isn't folded into gamma, so the pattern is left alone.
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    auto* input_arg = helper.MakeInput<float>({1, 16, 4, 4}, -2.0f, 2.0f);
+    auto* group_out = helper.MakeIntermediate();
+    auto* norm_out = helper.MakeIntermediate();
+    auto* restore_out = helper.MakeIntermediate();
+    auto* mul_out = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddNode("Reshape", {input_arg, helper.Make1DInitializer<int64_t>({0, 4, -1})}, {group_out});
+    helper.AddNode("InstanceNormalization",
+                   {group_out, helper.MakeInitializer<float>({4}, 0.5f, 1.5f),
+                    helper.MakeInitializer<float>({4}, std::vector<float>(4, 0.0f))},
+                   {norm_out})
+        .AddAttribute("epsilon", 1e-5f);
+    helper.AddNode("Reshape", {norm_out, helper.Make1DInitializer<int64_t>({1, 16, 4, 4})}, {restore_out});
+    helper.AddNode("Mul", {restore_out, helper.MakeInitializer<float>({16, 1, 1}, -1.0f, 1.0f)}, {mul_out});
+    helper.AddNode("Add", {mul_out, helper.MakeInitializer<float>({16, 1, 1}, -1.0f, 1.0f)}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.GroupNorm"], 0);
+    EXPECT_EQ(op_to_count["InstanceNormalization"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
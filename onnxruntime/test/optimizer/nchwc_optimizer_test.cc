@@ -1401,6 +1401,108 @@ TEST(NchwcOptimizerTests, MaxPoolTypeCheck) {
   NchwcOptimizerTester(build_test_case, check_nchwc_graph, 12);
 }
 
+TEST(NchwcOptimizerTests, ConvReduceMean) {
+  auto test_case = [&](const std::vector<int64_t>& axes, int64_t keepdims, int reduce_mean_count) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {64, 32, 3, 3});
+      auto& reduce_node = helper.AddNode("ReduceMean", {conv_output_arg}, {output_arg});
+      reduce_node.AddAttribute("axes", axes);
+      reduce_node.AddAttribute("keepdims", keepdims);
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.GlobalAveragePool"], 1 - reduce_mean_count);
+      EXPECT_EQ(op_to_count["ReduceMean"], reduce_mean_count);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Reduction over the spatial axes becomes GlobalAveragePool.
+  test_case({2, 3}, 1, 0);
+  test_case({-1, -2}, 1, 0);
+
+  // Other reductions stay as ReduceMean.
+  test_case({2, 3}, 0, 1);
+  test_case({1, 2}, 1, 1);
+}
+
+TEST(NchwcOptimizerTests, ConvSplit) {
+  auto test_case = [&](const std::vector<int64_t>& split, int nchwc_conv_count, int reorder_output_count) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({1, 32, 25, 21});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* split1_output_arg = helper.MakeIntermediate();
+      auto* split2_output_arg = helper.MakeIntermediate();
+      auto* output1_arg = helper.MakeOutput();
+      auto* output2_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {96, 32, 3, 3});
+      auto& split_node = helper.AddNode("Split", {conv_output_arg, helper.Make1DInitializer<int64_t>(split)},
+                                        {split1_output_arg, split2_output_arg});
+      split_node.AddAttribute("axis", static_cast<int64_t>(1));
+      helper.AddConvNode(split1_output_arg, output1_arg, {32, split[0], 1, 1});
+      helper.AddConvNode(split2_output_arg, output2_arg, {32, split[1], 1, 1});
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], nchwc_conv_count);
+      EXPECT_EQ(op_to_count["Split"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], reorder_output_count);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Split at a block boundary (stays in NCHWc format).
+  test_case({64, 32}, 3, 2);
+
+  // Split inside a block (reorders back to NCHW).
+  test_case({60, 36}, 1, 1);
+}
+
+TEST(NchwcOptimizerTests, ConvPad) {
+  auto test_case = [&](const std::string& mode, const std::vector<int64_t>& pads, int reorder_output_count) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({1, 32, 23, 19});
+      auto* conv1_output_arg = helper.MakeIntermediate();
+      auto* pad_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv1_output_arg, {48, 32, 3, 3});
+      auto& pad_node = helper.AddNode("Pad", {conv1_output_arg, helper.Make1DInitializer<int64_t>(pads)},
+                                      {pad_output_arg});
+      pad_node.AddAttribute("mode", mode);
+      helper.AddConvNode(pad_output_arg, output_arg, {64, 48 + pads[1] + pads[5], 3, 3});
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 2);
+      EXPECT_EQ(op_to_count["Pad"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], reorder_output_count);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Padding of the spatial dimensions stays in NCHWc format.
+  test_case("constant", {0, 0, 1, 2, 0, 0, 2, 1}, 1);
+  test_case("reflect", {0, 0, 1, 1, 0, 0, 1, 1}, 1);
+  test_case("edge", {0, 0, 2, 0, 0, 0, 0, 2}, 1);
+
+  // Padding of the channel dimension reorders back to NCHW.
+  test_case("constant", {0, 8, 1, 1, 0, 8, 1, 1}, 2);
+}
+
 #endif
 
 }  // namespace test
@@ -500,6 +500,46 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+TEST(NhwcTransformerTests, FloatConvMaxPoolDepthwiseConv) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 7, 17, 17}, 0.0f, 1.0f);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* pool_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    auto* conv1_weight_arg = builder.MakeInitializer<float>({9, 7, 3, 3}, -1.0f, 1.0f);
+    auto* conv1_bias_arg = builder.MakeInitializer<float>({9}, -1.0f, 1.0f);
+    Node& conv1_node = builder.AddNode("Conv", {input_arg, conv1_weight_arg, conv1_bias_arg}, {conv1_output_arg});
+    conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+
+    Node& pool_node = builder.AddNode("MaxPool", {conv1_output_arg}, {pool_output_arg});
+    pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    pool_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+
+    auto* conv2_weight_arg = builder.MakeInitializer<float>({9, 1, 3, 3}, -1.0f, 1.0f);
+    Node& conv2_node = builder.AddConvNode(pool_output_arg, conv2_weight_arg, output_arg);
+    conv2_node.AddAttribute("group", static_cast<int64_t>(9));
+    conv2_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 2);
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcMaxPool"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  // The channel counts are not a multiple of the NCHWc block size, so the NCHWc
+  // transformer leaves the float convolutions to the NHWC transformer.
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12,
+                    1e-5,
+                    1e-5);
+}
+
 #endif  // DISABLE_CONTRIB_OPS
 
 }  // namespace test
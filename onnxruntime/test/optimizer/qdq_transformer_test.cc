@@ -1459,6 +1459,104 @@ TEST(QDQTransformerTests, Sigmoid_U8S8) {
   QDQTransformerSigmoidTests<uint8_t, int8_t>();
 }
 
+template <typename T>
+void QDQTransformerSoftmaxTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, int64_t axis, int opset_version) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -5.f, 5.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + Softmax
+      auto* dq_output = AddQDQNodePair<T>(builder, input_arg, .04f, std::is_same<T, int8_t>::value ? 0 : 128);
+      auto* softmax_output = builder.MakeIntermediate();
+      Node& softmax_node = builder.AddNode("Softmax", {dq_output}, {softmax_output});
+      softmax_node.AddAttribute("axis", axis);
+
+      // add QDQ output
+      const T output_zp = std::numeric_limits<T>::min();
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<T>(softmax_output, 1.f / 256, output_zp, q_output);
+      builder.AddDequantizeLinearNode<T>(q_output, 1.f / 256, output_zp, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearSoftmax"], 1);
+      EXPECT_EQ(op_to_count["Softmax"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      opset_version,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 12, 37}, -1, 13);
+  // reduce along a dimension that is not the innermost one
+  test_case({1, 12, 37}, 1, 13);
+  // before opset 13 the input is coerced to 2D at axis
+  test_case({1, 12, 37}, 1, 12);
+}
+
+TEST(QDQTransformerTests, Softmax_S8S8) {
+  QDQTransformerSoftmaxTests<int8_t>();
+}
+
+TEST(QDQTransformerTests, Softmax_U8U8) {
+  QDQTransformerSoftmaxTests<uint8_t>();
+}
+
+TEST(QDQTransformerTests, Pad) {
+  auto test_case = [&](const std::string& mode, bool has_constant_value, bool expect_fusion) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>({1, 3, 4, 5}, 0, 255);
+      auto* pads = builder.Make1DInitializer<int64_t>({0, 0, 1, 2, 0, 0, 2, 1});
+      auto* output_arg = builder.MakeOutput();
+
+      // add DQ
+      auto* dq_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(input_arg, .003f, 100, dq_output);
+
+      // add Pad
+      std::vector<NodeArg*> pad_inputs{dq_output, pads};
+      if (has_constant_value) {
+        pad_inputs.push_back(builder.MakeScalarInitializer<float>(expect_fusion ? 0.f : 1.f));
+      }
+      auto* pad_output = builder.MakeIntermediate();
+      Node& pad_node = builder.AddNode("Pad", pad_inputs, {pad_output});
+      pad_node.AddAttribute("mode", mode);
+
+      // add Q
+      builder.AddQuantizeLinearNode<uint8_t>(pad_output, .003f, 100, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["Pad"], 1);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], expect_fusion ? 0 : 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], expect_fusion ? 0 : 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      13 /*opset_version*/);
+  };
+
+  test_case("constant", false, true);
+  test_case("constant", true, true);
+  test_case("edge", false, true);
+  test_case("reflect", false, true);
+  // a non-zero pad value can't be represented by the zero point
+  test_case("constant", true, false);
+}
+
 TEST(QDQTransformerTests, ConvTranspose_QBackward) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape, const std::vector<int64_t>& perms) {
     auto build_test_case = [&](ModelTestBuilder& builder) {
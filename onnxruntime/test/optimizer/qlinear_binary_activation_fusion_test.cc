@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "core/graph/graph_utils.h"
+#include "test/framework/test_utils.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void BuildQLinearAddActivation(ModelTestBuilder& helper, const std::string& activation, bool add_is_output) {
+  auto* input_a = helper.MakeInput<uint8_t>({2, 7, 16}, 0, 255);
+  auto* input_b = helper.MakeInput<uint8_t>({2, 7, 16}, 0, 255);
+  auto* add_out = add_is_output ? helper.MakeOutput() : helper.MakeIntermediate();
+  auto* output_arg = helper.MakeOutput();
+
+  helper.AddNode("QLinearAdd",
+                 {input_a, helper.MakeScalarInitializer<float>(0.02f), helper.MakeScalarInitializer<uint8_t>(128),
+                  input_b, helper.MakeScalarInitializer<float>(0.03f), helper.MakeScalarInitializer<uint8_t>(120),
+                  helper.MakeScalarInitializer<float>(0.05f), helper.MakeScalarInitializer<uint8_t>(125)},
+                 {add_out}, kMSDomain);
+  Node& act = helper.AddNode(activation,
+                             {add_out, helper.MakeScalarInitializer<float>(0.05f),
+                              helper.MakeScalarInitializer<uint8_t>(125),
+                              helper.MakeScalarInitializer<float>(0.01f), helper.MakeScalarInitializer<uint8_t>(100)},
+                             {output_arg}, kMSDomain);
+  if (activation == "QLinearLeakyRelu") {
+    act.AddAttribute("alpha", 0.2f);
+  }
+}
+
+TEST(QLinearBinaryActivationFusionTests, FuseLeakyRelu) {
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    BuildQLinearAddActivation(helper, "QLinearLeakyRelu", false);
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearAdd"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearLeakyRelu"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+}
+
+TEST(QLinearBinaryActivationFusionTests, FuseSigmoid) {
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    BuildQLinearAddActivation(helper, "QLinearSigmoid", false);
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearAdd"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearSigmoid"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+}
+
+TEST(QLinearBinaryActivationFusionTests, KeepActivationOfGraphOutput) {
+  // The output of QLinearAdd is also a graph output, so the activation can not be folded into it.
+  auto build_test_case = [](ModelTestBuilder& helper) {
+    BuildQLinearAddActivation(helper, "QLinearLeakyRelu", true);
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearAdd"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearLeakyRelu"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
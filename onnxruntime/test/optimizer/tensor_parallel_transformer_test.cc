@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
+#include "test/framework/test_utils.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+#include "test/optimizer/graph_transform_test_fixture.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+
+std::vector<float> Iota(size_t count) {
+  std::vector<float> data(count);
+  std::iota(data.begin(), data.end(), 0.0f);
+  return data;
+}
+
+// Returns the data of the initializer used by input `input_index` of the first node of type `op_type`.
+std::vector<float> GetWeight(const Graph& graph, const std::string& op_type, size_t input_index,
+                             std::vector<int64_t>& dims) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == op_type) {
+      const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node.InputDefs()[input_index]->Name());
+      EXPECT_NE(tensor_proto, nullptr);
+      if (tensor_proto == nullptr) {
+        return {};
+      }
+      dims.assign(tensor_proto->dims().begin(), tensor_proto->dims().end());
+      Initializer init(*tensor_proto, graph.ModelPath());
+      return std::vector<float>(init.data<float>(), init.data<float>() + init.size());
+    }
+  }
+  ADD_FAILURE() << "No " << op_type << " node";
+  return {};
+}
+
+}  // namespace
+
+TEST_F(GraphTransformationTests, TensorParallelTransformerMlp) {
+  Model model("TensorParallelMlp", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMSDomain, 1}}, {}, *logger_);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder helper(graph);
+
+  // MatMul([2, 4] x [4, 8]) -> Add -> Relu -> MatMul([2, 8] x [8, 4]) -> Add
+  auto* input = helper.MakeInput<float>({2, 4}, Iota(8));
+  auto* w1 = helper.MakeInitializer<float>({4, 8}, Iota(32));
+  auto* b1 = helper.Make1DInitializer<float>(Iota(8));
+  auto* w2 = helper.MakeInitializer<float>({8, 4}, Iota(32));
+  auto* b2 = helper.Make1DInitializer<float>(Iota(4));
+  auto* matmul_out = helper.MakeIntermediate();
+  auto* add_out = helper.MakeIntermediate();
+  auto* relu_out = helper.MakeIntermediate();
+  auto* matmul2_out = helper.MakeIntermediate();
+  auto* output = helper.MakeOutput();
+  helper.AddNode("MatMul", {input, w1}, {matmul_out});
+  helper.AddNode("Add", {matmul_out, b1}, {add_out});
+  helper.AddNode("Relu", {add_out}, {relu_out});
+  helper.AddNode("MatMul", {relu_out, w2}, {matmul2_out});
+  helper.AddNode("Add", {matmul2_out, b2}, {output});
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<TensorParallelTransformer>(2, 1),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["com.microsoft.AllReduce"], 1);
+  ASSERT_EQ(op_to_count["MatMul"], 2);
+
+  // rank 1 keeps columns 4..7 of W1 and rows 4..7 of W2
+  std::vector<int64_t> dims;
+  std::vector<float> expected_w1;
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 4; col < 8; ++col) {
+      expected_w1.push_back(static_cast<float>(row * 8 + col));
+    }
+  }
+  EXPECT_EQ(GetWeight(graph, "MatMul", 1, dims), expected_w1);
+  EXPECT_EQ(dims, (std::vector<int64_t>{4, 4}));
+
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "MatMul" && node.InputDefs()[0]->Name() == relu_out->Name()) {
+      const auto* w2_shard = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+      ASSERT_NE(w2_shard, nullptr);
+      ASSERT_EQ(w2_shard->dims_size(), 2);
+      EXPECT_EQ(w2_shard->dims(0), 4);
+      Initializer init(*w2_shard, graph.ModelPath());
+      std::vector<float> expected_w2 = Iota(32);
+      expected_w2.erase(expected_w2.begin(), expected_w2.begin() + 16);
+      EXPECT_EQ(std::vector<float>(init.data<float>(), init.data<float>() + init.size()), expected_w2);
+
+      // the partial product is reduced before the bias is added
+      ASSERT_EQ(node.GetOutputEdgesCount(), 1u);
+      EXPECT_EQ(node.OutputNodesBegin()->OpType(), "AllReduce");
+    }
+  }
+}
+
+TEST_F(GraphTransformationTests, TensorParallelTransformerAttention) {
+  Model model("TensorParallelAttention", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMSDomain, 1}}, {}, *logger_);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder helper(graph);
+
+  // Attention(hidden 4, 2 heads) -> MatMul([4, 4]) -> Add
+  auto* input = helper.MakeInput<float>({1, 2, 4}, Iota(8));
+  auto* weights = helper.MakeInitializer<float>({4, 12}, Iota(48));
+  auto* bias = helper.Make1DInitializer<float>(Iota(12));
+  auto* projection_weight = helper.MakeInitializer<float>({4, 4}, Iota(16));
+  auto* projection_bias = helper.Make1DInitializer<float>(Iota(4));
+  auto* attention_out = helper.MakeIntermediate();
+  auto* projection_out = helper.MakeIntermediate();
+  auto* output = helper.MakeOutput();
+  auto& attention = helper.AddNode("Attention", {input, weights, bias}, {attention_out}, kMSDomain);
+  attention.AddAttribute("num_heads", static_cast<int64_t>(2));
+  helper.AddNode("MatMul", {attention_out, projection_weight}, {projection_out});
+  helper.AddNode("Add", {projection_out, projection_bias}, {output});
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<TensorParallelTransformer>(2, 1),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["com.microsoft.AllReduce"], 1);
+
+  // rank 1 keeps the second head of Q, K and V, i.e. columns {2, 3, 6, 7, 10, 11}
+  std::vector<int64_t> dims;
+  std::vector<float> expected_weights;
+  for (int row = 0; row < 4; ++row) {
+    for (int col : {2, 3, 6, 7, 10, 11}) {
+      expected_weights.push_back(static_cast<float>(row * 12 + col));
+    }
+  }
+  EXPECT_EQ(GetWeight(graph, "Attention", 1, dims), expected_weights);
+  EXPECT_EQ(dims, (std::vector<int64_t>{4, 6}));
+  EXPECT_EQ(GetWeight(graph, "Attention", 2, dims), (std::vector<float>{2, 3, 6, 7, 10, 11}));
+
+  // and rows 2..3 of the projection
+  EXPECT_EQ(GetWeight(graph, "MatMul", 1, dims), (std::vector<float>{8, 9, 10, 11, 12, 13, 14, 15}));
+  EXPECT_EQ(dims, (std::vector<int64_t>{2, 4}));
+
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "Attention") {
+      EXPECT_EQ(graph_utils::GetNodeAttribute(node, "num_heads")->i(), 1);
+    }
+  }
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "graph_transform_test_builder.h"
 
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/test_environment.h"
 #include "test/util/include/asserts.h"
 
@@ -2449,6 +2450,110 @@ TEST(TransposeOptimizerTests, TestArgMax) {
                     /*opset_version*/ 15);
 }
 
+TEST(TransposeOptimizerTests, TestGatherScalarIndices) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{2, 4, 6, 3}}, {2, 4, 6, 3}, 0.0, 1.0);
+    auto* const_1 = builder.MakeScalarInitializer<int64_t>(1);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* gather_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    auto& gather_1 = builder.AddNode("Gather", {transpose_1_out_0, const_1}, {gather_1_out_0});
+    gather_1.AddAttribute("axis", (int64_t)2);
+    auto& transpose_2 = builder.AddNode("Transpose", {gather_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{0, 2, 1});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 0);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ 15);
+}
+
+TEST(TransposeOptimizerTests, TestGather1DIndices) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{2, 4, 6, 3}}, {2, 4, 6, 3}, 0.0, 1.0);
+    auto* const_1 = builder.MakeInitializer<int64_t>({2}, {3, 0});
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* gather_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    auto& gather_1 = builder.AddNode("Gather", {transpose_1_out_0, const_1}, {gather_1_out_0});
+    gather_1.AddAttribute("axis", (int64_t)-2);
+    auto& transpose_2 = builder.AddNode("Transpose", {gather_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 0);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ 15);
+}
+
+TEST(TransposeOptimizerTests, TestSizeCostModel) {
+  // Pushing the Transpose of the small activation through the Add cancels it with the final Transpose, but needs a
+  // Transpose of the much larger second input. Only the rank based cost model does so.
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{3, 1, 3, 3}}, {3, 1, 3, 3}, 0.0, 1.0);
+    auto* input1_arg = MakeInput<float>(builder, {{3, 1, 1, 4096}}, {3, 1, 1, 4096}, 0.0, 1.0);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* add_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    builder.AddNode("Add", {transpose_1_out_0, input1_arg}, {add_1_out_0});
+    auto& transpose_2 = builder.AddNode("Transpose", {add_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+  };
+
+  auto check_rank_cost_graph = [&](InferenceSessionWrapper& session) {
+    std::map<std::string, int> op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+  };
+
+  auto check_size_cost_graph = [&](InferenceSessionWrapper& session) {
+    std::map<std::string, int> op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_rank_cost_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ 15);
+
+  const std::function<void(SessionOptions&)> use_size_cost = [](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigTransposeOptimizerCostModel,
+                                                                   "size"));
+  };
+  TransformerTester(build_test_case_1,
+                    check_size_cost_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ 15,
+                    /*per_sample_tolerance*/ 0.0,
+                    /*relative_per_sample_tolerance*/ 0.0,
+                    /*transformer*/ nullptr,
+                    &use_size_cost);
+}
+
 TEST(TransposeOptimizerTests, TestSoftmax) {
   auto build_test_case_1 = [&](ModelTestBuilder& builder) {
     auto* input0_arg = MakeInput<float>(builder, std::nullopt, {2, 3, 4, 5}, 0.0, 1.0);
@@ -27,17 +27,26 @@ namespace perftest {
   printf(
       "perf_test [options...] model_path [result_file]\n"
       "Options:\n"
-      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
+      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration', 'times' or 'openloop'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
+      "\t\tProvide 'openloop' to issue requests at the rate given by -Q for the duration given by -t, whether or not the\n"
+      "\t\tprevious requests completed. The latency of a request then includes the time it waited to be served.\n"
+      "\t-Q [requests_per_second]: Specifies the target rate of 'openloop' mode, with Poisson arrivals. Implies 'openloop'.\n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t\tIn 'openloop' mode, the number of threads serving the requests.\n"
+      "\t-D [shape_distribution_file]: Generate inputs of several shapes, picked at random by weight for each run. Implies -I.\n"
+      "\t\tEach line of the file is '<weight> <input_name>:<dim>x<dim>...[,<input_name>:<dim>x<dim>...]', lines starting with '#'\n"
+      "\t\tare ignored. Inputs not listed in a line use their model shape, with free dimensions treated as 1.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|nuphar|dml|acl|rocm|migraphx]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'nuphar', 'dml', 'acl', 'nnapi', 'coreml', 'rocm' or 'migraphx'. "
       "Default:'cpu'.\n"
       "\t-b [tf|ort]: backend to use. Default:ort\n"
       "\t-r [repeated_times]: Specifies the repeated times if running in 'times' test mode.Default:1000.\n"
+      "\t-W [warmup_times]: Specifies the number of untimed runs before the test. Default:1.\n"
+      "\t-J [json_result_file]: Writes the latency percentiles, throughput and peak memory of the test to a JSON file.\n"
       "\t-t [seconds_to_run]: Specifies the seconds to run for 'duration' mode. Default:600.\n"
       "\t-p [profile_file]: Specifies the profile name to enable profiling and dump the profile data to the file.\n"
       "\t-s: Show statistics result, like P75, P90. If no result_file provided this defaults to on.\n"
@@ -77,6 +86,13 @@ namespace perftest {
       "\t    [TensorRT only] [trt_engine_cache_enable]: Enable engine caching.\n"
       "\t    [TensorRT only] [trt_engine_cache_path]: Specify engine cache path.\n"
       "\t    [TensorRT only] [trt_force_sequential_engine_build]: Force TensorRT engines to be built sequentially.\n"
+      "\t    [TensorRT only] [trt_timing_cache_enable]: Enable the TensorRT timing cache persisted in the cache path.\n"
+      "\t    [TensorRT only] [trt_engine_build_async]: Build engines in the background while CUDA EP runs the nodes.\n"
+      "\t    [TensorRT only] [trt_profile_min_shapes]: Minimum shapes of dynamic inputs, e.g. 'input1:1x3x224x224,input2:1x128'.\n"
+      "\t    [TensorRT only] [trt_profile_max_shapes]: Maximum shapes of dynamic inputs.\n"
+      "\t    [TensorRT only] [trt_profile_opt_shapes]: Optimal shapes of dynamic inputs.\n"
+      "\t    [TensorRT only] [trt_int8_calibration_enable]: Run in FP32 and write the activation ranges to the INT8 calibration table.\n"
+      "\t    [TensorRT only] [trt_layer_precisions]: Per-layer precision constraints, e.g. 'Conv_12:fp32,MatMul_40:fp16'.\n"
       "\t [Usage]: -e <provider_name> -i '<key1>|<value1> <key2>|<value2>'\n\n"
       "\t [Example] [For TensorRT EP] -e tensorrt -i 'trt_fp16_enable|true trt_int8_enable|true trt_int8_calibration_table_name|calibration.flatbuffers trt_int8_use_native_calibration_table|false trt_force_sequential_engine_build|false'\n"
       "\t    [NNAPI only] [NNAPI_FLAG_USE_FP16]: Use fp16 relaxation in NNAPI EP..\n"
@@ -113,7 +129,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:Q:D:W:J:AMPIvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -138,10 +154,28 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
         } else if (!CompareCString(optarg, ORT_TSTR("times"))) {
           test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("openloop"))) {
+          test_config.run_config.test_mode = TestMode::kOpenLoopMode;
         } else {
           return false;
         }
         break;
+      case 'Q':
+        ORT_TRY {
+          test_config.run_config.target_qps = std::stod(std::basic_string<ORTCHAR_T>(optarg));
+        }
+        ORT_CATCH(...) {
+          return false;
+        }
+        if (!(test_config.run_config.target_qps > 0.0)) {
+          return false;
+        }
+        test_config.run_config.test_mode = TestMode::kOpenLoopMode;
+        break;
+      case 'D':
+        test_config.run_config.input_shape_distribution_file = optarg;
+        test_config.run_config.generate_model_input_binding = true;
+        break;
       case 'b':
         test_config.backend = optarg;
         break;
@@ -193,6 +227,12 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
         }
         test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
         break;
+      case 'W':
+        test_config.run_config.warmup_times = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        break;
+      case 'J':
+        test_config.run_config.json_result_file = optarg;
+        break;
       case 't':
         test_config.run_config.duration_in_seconds = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         if (test_config.run_config.repeated_times <= 0) {
@@ -295,6 +335,11 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
   test_config.model_info.model_file_path = argv[0];
 
+  if (test_config.run_config.test_mode == TestMode::kOpenLoopMode && test_config.run_config.target_qps <= 0.0) {
+    fprintf(stderr, "'openloop' mode requires a target rate, set with -Q.\n");
+    return false;
+  }
+
   return true;
 }
 
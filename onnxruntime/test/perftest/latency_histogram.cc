@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace perftest {
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(static_cast<size_t>(kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketHalfCount), 0) {
+}
+
+size_t LatencyHistogram::BucketIndex(int64_t value) {
+  if (value < kSubBucketCount) {
+    return static_cast<size_t>(value);
+  }
+
+  int msb = kSubBucketBits;
+  while ((value >> (msb + 1)) != 0) {
+    msb++;
+  }
+
+  // keep the kSubBucketBits most significant bits, the top one is always set
+  const int shift = msb - (kSubBucketBits - 1);
+  const int64_t sub_bucket = (value >> shift) - kSubBucketHalfCount;
+  return static_cast<size_t>(kSubBucketCount + (shift - 1) * kSubBucketHalfCount + sub_bucket);
+}
+
+int64_t LatencyHistogram::HighestEquivalentValue(size_t index) {
+  const int64_t i = static_cast<int64_t>(index);
+  if (i < kSubBucketCount) {
+    return i;
+  }
+
+  const int64_t shift = (i - kSubBucketCount) / kSubBucketHalfCount + 1;
+  const int64_t sub_bucket = (i - kSubBucketCount) % kSubBucketHalfCount + kSubBucketHalfCount;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(int64_t latency_us) {
+  const int64_t value = std::min(std::max(latency_us, int64_t{0}), (int64_t{1} << kMaxValueBits) - 1);
+  counts_[BucketIndex(value)]++;
+  count_++;
+  max_us_ = std::max(max_us_, value);
+}
+
+int64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  const uint64_t target =
+      std::max<uint64_t>(static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count_))), 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    seen += counts_[i];
+    if (seen >= target) {
+      return std::min(HighestEquivalentValue(i), max_us_);
+    }
+  }
+
+  return max_us_;
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onnxruntime {
+namespace perftest {
+
+// HDR style histogram of latencies in microseconds.
+// Latencies below 2048 us are counted exactly. Above that, each power of 2 range is split into 1024 linear buckets,
+// so every recorded value is known with 3 significant digits while the histogram has a fixed size, independent of
+// the number of runs. Latencies above ~19 hours are clamped. Not thread safe.
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  void Record(int64_t latency_us);
+
+  uint64_t Count() const { return count_; }
+  int64_t Max() const { return max_us_; }
+
+  // Returns the latency in microseconds at `percentile` in [0, 100], the highest value that is equivalent to the
+  // recorded values of its bucket. Returns 0 if nothing was recorded.
+  int64_t ValueAtPercentile(double percentile) const;
+
+ private:
+  static constexpr int kSubBucketBits = 11;
+  static constexpr int64_t kSubBucketCount = int64_t{1} << kSubBucketBits;
+  static constexpr int64_t kSubBucketHalfCount = kSubBucketCount / 2;
+  static constexpr int kMaxValueBits = 36;
+
+  static size_t BucketIndex(int64_t value);
+  static int64_t HighestEquivalentValue(size_t index);
+
+  std::vector<uint64_t> counts_;
+  uint64_t count_{0};
+  int64_t max_us_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
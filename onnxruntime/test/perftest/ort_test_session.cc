@@ -3,6 +3,10 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/providers/tensorrt/tensorrt_provider_options.h"
 #include <assert.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
 #include "providers.h"
 #include "TestCase.h"
 
@@ -15,9 +19,17 @@ namespace onnxruntime {
 namespace perftest {
 
 std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
-  //Randomly pick one OrtValueArray from test_inputs_. (NOT ThreadSafe)
-  const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
-  const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
+  //Randomly pick one OrtValueArray from test_inputs_, by weight if the inputs come from a shape distribution.
+  size_t id;
+  {
+    std::lock_guard<OrtMutex> guard(rand_mutex_);
+    if (input_weights_.size() == test_inputs_.size()) {
+      id = weighted_dist_(rand_engine_);
+    } else {
+      const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
+      id = static_cast<size_t>(dist_(rand_engine_, p));
+    }
+  }
   auto& input = test_inputs_.at(id);
   auto start = std::chrono::high_resolution_clock::now();
   auto output_values = session_.Run(Ort::RunOptions{nullptr}, input_names_.data(), input.data(), input_names_.size(),
@@ -75,6 +87,13 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     bool trt_engine_decryption_enable = false;
     std::string trt_engine_decryption_lib_path = "";
     bool trt_force_sequential_engine_build = false;
+    bool trt_timing_cache_enable = false;
+    bool trt_engine_build_async = false;
+    std::string trt_profile_min_shapes = "";
+    std::string trt_profile_max_shapes = "";
+    std::string trt_profile_opt_shapes = "";
+    bool trt_int8_calibration_enable = false;
+    std::string trt_layer_precisions = "";
 
 #ifdef _MSC_VER
     std::string ov_string = ToUTF8String(performance_test_config.run_config.ep_runtime_config_string);
@@ -206,8 +225,56 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         } else {
           ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_force_sequential_engine_build' should be a boolean i.e. true or false. Default value is false.\n");
         }
+      } else if (key == "trt_timing_cache_enable") {
+        if (value == "true" || value == "True") {
+          trt_timing_cache_enable = true;
+        } else if (value == "false" || value == "False") {
+          trt_timing_cache_enable = false;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_timing_cache_enable' should be a boolean i.e. true or false. Default value is false.\n");
+        }
+      } else if (key == "trt_engine_build_async") {
+        if (value == "true" || value == "True") {
+          trt_engine_build_async = true;
+        } else if (value == "false" || value == "False") {
+          trt_engine_build_async = false;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_build_async' should be a boolean i.e. true or false. Default value is false.\n");
+        }
+      } else if (key == "trt_profile_min_shapes") {
+        if (!value.empty()) {
+          trt_profile_min_shapes = value;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_min_shapes' should be a non-emtpy string.\n");
+        }
+      } else if (key == "trt_profile_max_shapes") {
+        if (!value.empty()) {
+          trt_profile_max_shapes = value;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_max_shapes' should be a non-emtpy string.\n");
+        }
+      } else if (key == "trt_profile_opt_shapes") {
+        if (!value.empty()) {
+          trt_profile_opt_shapes = value;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_opt_shapes' should be a non-emtpy string.\n");
+        }
+      } else if (key == "trt_int8_calibration_enable") {
+        if (value == "true" || value == "True") {
+          trt_int8_calibration_enable = true;
+        } else if (value == "false" || value == "False") {
+          trt_int8_calibration_enable = false;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_int8_calibration_enable' should be a boolean i.e. true or false. Default value is false.\n");
+        }
+      } else if (key == "trt_layer_precisions") {
+        if (!value.empty()) {
+          trt_layer_precisions = value;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_layer_precisions' should be a non-emtpy string.\n");
+        }
       } else {
-        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['device_id', 'trt_max_partition_iterations', 'trt_min_subgraph_size', 'trt_max_workspace_size', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_dla_enable', 'trt_dla_core', 'trt_dump_subgraphs', 'trt_engine_cache_enable', 'trt_engine_cache_path', 'trt_engine_decryption_enable', 'trt_engine_decryption_lib_path', 'trt_force_sequential_engine_build'] \n");
+        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['device_id', 'trt_max_partition_iterations', 'trt_min_subgraph_size', 'trt_max_workspace_size', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_dla_enable', 'trt_dla_core', 'trt_dump_subgraphs', 'trt_engine_cache_enable', 'trt_engine_cache_path', 'trt_engine_decryption_enable', 'trt_engine_decryption_lib_path', 'trt_force_sequential_engine_build', 'trt_timing_cache_enable', 'trt_engine_build_async', 'trt_profile_min_shapes', 'trt_profile_max_shapes', 'trt_profile_opt_shapes', 'trt_int8_calibration_enable', 'trt_layer_precisions'] \n");
       }
     }
     OrtTensorRTProviderOptionsV2 tensorrt_options;
@@ -229,6 +296,13 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     tensorrt_options.trt_engine_decryption_enable = trt_engine_decryption_enable;
     tensorrt_options.trt_engine_decryption_lib_path = trt_engine_decryption_lib_path.c_str();
     tensorrt_options.trt_force_sequential_engine_build = trt_force_sequential_engine_build;
+    tensorrt_options.trt_timing_cache_enable = trt_timing_cache_enable;
+    tensorrt_options.trt_engine_build_async = trt_engine_build_async;
+    tensorrt_options.trt_profile_min_shapes = trt_profile_min_shapes.empty() ? nullptr : trt_profile_min_shapes.c_str();
+    tensorrt_options.trt_profile_max_shapes = trt_profile_max_shapes.empty() ? nullptr : trt_profile_max_shapes.c_str();
+    tensorrt_options.trt_profile_opt_shapes = trt_profile_opt_shapes.empty() ? nullptr : trt_profile_opt_shapes.c_str();
+    tensorrt_options.trt_int8_calibration_enable = trt_int8_calibration_enable;
+    tensorrt_options.trt_layer_precisions = trt_layer_precisions.empty() ? nullptr : trt_layer_precisions.c_str();
     session_options.AppendExecutionProvider_TensorRT_V2(tensorrt_options);
 
     OrtCUDAProviderOptions cuda_options;
@@ -432,6 +506,8 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     session_options.SetOptimizedModelFilePath(performance_test_config.run_config.optimized_model_path.c_str());
   if (performance_test_config.run_config.set_denormal_as_zero)
     session_options.AddConfigEntry(kOrtSessionOptionsConfigSetDenormalAsZero, "1");
+  // The metrics are only read for the peak memory of the arenas, so time as few runs as possible.
+  session_options.AddConfigEntry(kOrtSessionOptionsConfigMetricsSamplingInterval, "1000000000");
   if (!performance_test_config.run_config.free_dim_name_overrides.empty()) {
     for (auto const& dim_override : performance_test_config.run_config.free_dim_name_overrides) {
       if (g_ort->AddFreeDimensionOverrideByName(session_options, ToUTF8String(dim_override.first).c_str(), dim_override.second) != nullptr) {
@@ -452,6 +528,7 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
   }
 
   session_ = Ort::Session(env, performance_test_config.model_info.model_file_path.c_str(), session_options);
+  input_shape_distribution_file_ = performance_test_config.run_config.input_shape_distribution_file;
 
   size_t output_count = session_.GetOutputCount();
   output_names_.resize(output_count);
@@ -474,26 +551,121 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
   }
 }
 
+size_t OnnxRuntimeTestSession::GetPeakArenaMemory() const {
+  Ort::AllocatorWithDefaultOptions allocator;
+  char* metrics = nullptr;
+  ORT_TRY {
+    metrics = session_.GetMetrics(allocator);
+  }
+  ORT_CATCH(const Ort::Exception&) {
+    return 0;
+  }
+
+  // sum "max_bytes_in_use" over the allocators of the session, the JSON is flat enough to not need a parser
+  static constexpr const char* kMaxBytesInUse = "\"max_bytes_in_use\":";
+  size_t peak = 0;
+  for (const char* p = strstr(metrics, kMaxBytesInUse); p != nullptr; p = strstr(p, kMaxBytesInUse)) {
+    p += strlen(kMaxBytesInUse);
+    peak += static_cast<size_t>(strtoull(p, nullptr, 10));
+  }
+  allocator.Free(metrics);
+  return peak;
+}
+
+// Parses a line '<weight> <input_name>:<dim>x<dim>...[,<input_name>:<dim>x<dim>...]' of a shape distribution file.
+static bool ParseInputShapeLine(const std::string& line, double& weight,
+                                std::unordered_map<std::string, std::vector<int64_t>>& shapes) {
+  std::istringstream ss(line);
+  std::string shapes_str;
+  if (!(ss >> weight >> shapes_str) || weight < 0.0) {
+    return false;
+  }
+
+  std::istringstream shapes_ss(shapes_str);
+  std::string shape_str;
+  while (std::getline(shapes_ss, shape_str, ',')) {
+    const size_t colon = shape_str.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+      return false;
+    }
+    std::vector<int64_t>& dims = shapes[shape_str.substr(0, colon)];
+    std::istringstream dims_ss(shape_str.substr(colon + 1));
+    std::string dim_str;
+    while (std::getline(dims_ss, dim_str, 'x')) {
+      char* end = nullptr;
+      const long long dim = strtoll(dim_str.c_str(), &end, 10);
+      if (dim_str.empty() || *end != '\0' || dim < 0) {
+        return false;
+      }
+      dims.push_back(dim);
+    }
+  }
+  return true;
+}
+
 bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData() {
-  // iterate over all input nodes
-  for (size_t i = 0; i < static_cast<size_t>(input_length_); i++) {
-    Ort::TypeInfo type_info = session_.GetInputTypeInfo(i);
-    Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-    if (type_info.GetONNXType() == ONNX_TYPE_TENSOR) {
-      auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
-      std::vector<int64_t> input_node_dim = tensor_info.GetShape();
+  // each line of the shape distribution file is one test data set, without a file there is a single one
+  std::vector<std::unordered_map<std::string, std::vector<int64_t>>> input_shapes(1);
+  if (!input_shape_distribution_file_.empty()) {
+    std::ifstream file(input_shape_distribution_file_);
+    if (!file.good()) {
+      fprintf(stderr, "failed to open shape distribution file '%s'\n", ToUTF8String(input_shape_distribution_file_).c_str());
+      return false;
+    }
+
+    input_shapes.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.find_first_not_of(" \t\r") == std::string::npos || line[line.find_first_not_of(" \t")] == '#') {
+        continue;
+      }
+      double weight;
+      input_shapes.emplace_back();
+      if (!ParseInputShapeLine(line, weight, input_shapes.back())) {
+        fprintf(stderr, "invalid line in shape distribution file: '%s'\n", line.c_str());
+        return false;
+      }
+      input_weights_.push_back(weight);
+    }
+
+    if (input_shapes.empty()) {
+      fprintf(stderr, "shape distribution file '%s' has no shapes\n", ToUTF8String(input_shape_distribution_file_).c_str());
+      return false;
+    }
+    weighted_dist_ = std::discrete_distribution<size_t>(input_weights_.begin(), input_weights_.end());
+  }
+
+  for (size_t test_data_id = 0; test_data_id < input_shapes.size(); test_data_id++) {
+    // iterate over all input nodes
+    for (size_t i = 0; i < static_cast<size_t>(input_length_); i++) {
+      Ort::TypeInfo type_info = session_.GetInputTypeInfo(i);
+      if (type_info.GetONNXType() == ONNX_TYPE_TENSOR) {
+        auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+        std::vector<int64_t> input_node_dim = tensor_info.GetShape();
+
+        auto shape = input_shapes[test_data_id].find(input_names_str_[i]);
+        if (shape != input_shapes[test_data_id].end()) {
+          if (shape->second.size() != input_node_dim.size()) {
+            fprintf(stderr, "shape of input '%s' in the shape distribution file has %d dimensions, the model has %d\n",
+                    input_names_str_[i].c_str(), static_cast<int>(shape->second.size()),
+                    static_cast<int>(input_node_dim.size()));
+            return false;
+          }
+          input_node_dim = shape->second;
+        }
 
-      // free dimensions are treated as 1 if not overriden
-      for (int64_t& dim : input_node_dim) {
-        if (dim == -1) {
-          dim = 1;
+        // free dimensions are treated as 1 if not overriden
+        for (int64_t& dim : input_node_dim) {
+          if (dim == -1) {
+            dim = 1;
+          }
         }
+        // default allocator doesn't have to be freed by user
+        auto allocator = static_cast<OrtAllocator*>(Ort::AllocatorWithDefaultOptions());
+        Ort::Value input_tensor = Ort::Value::CreateTensor(allocator, (const int64_t*)input_node_dim.data(),
+                                                           input_node_dim.size(), tensor_info.GetElementType());
+        PreLoadTestData(test_data_id, i, std::move(input_tensor));
       }
-      // default allocator doesn't have to be freed by user
-      auto allocator = static_cast<OrtAllocator*>(Ort::AllocatorWithDefaultOptions());
-      Ort::Value input_tensor = Ort::Value::CreateTensor(allocator, (const int64_t*)input_node_dim.data(),
-                                                         input_node_dim.size(), tensor_info.GetElementType());
-      PreLoadTestData(0, i, std::move(input_tensor));
     }
   }
   return true;
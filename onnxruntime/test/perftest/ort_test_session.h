@@ -3,6 +3,7 @@
 
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
+#include <core/platform/ort_mutex.h>
 #include <random>
 #include "test_configuration.h"
 #include "test_session.h"
@@ -25,8 +26,11 @@ class OnnxRuntimeTestSession : public TestSession {
     test_inputs_[test_data_id][input_id] = std::move(value);
   }
 
+  // Generates the inputs, one set per shape of the shape distribution file if there is one.
   bool PopulateGeneratedInputTestData();
 
+  size_t GetPeakArenaMemory() const override;
+
   ~OnnxRuntimeTestSession() = default;
 
   std::chrono::duration<double> Run() override;
@@ -37,6 +41,11 @@ class OnnxRuntimeTestSession : public TestSession {
   Ort::Session session_{nullptr};
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
+  // the weights of the test data sets when they come from a shape distribution file
+  std::vector<double> input_weights_;
+  std::discrete_distribution<size_t> weighted_dist_;
+  OrtMutex rand_mutex_;
+  std::basic_string<ORTCHAR_T> input_shape_distribution_file_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
   std::vector<std::string> output_names_;
   // The same size with output_names_.
@@ -8,6 +8,7 @@
 
 #include "performance_runner.h"
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -108,13 +109,61 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+static std::string JsonEscape(const std::string& s) {
+  std::string escaped;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+  }
+  return escaped;
+}
+
+void PerformanceResult::DumpToJson(const std::basic_string<ORTCHAR_T>& path,
+                                   const PerformanceTestConfig& test_config) const {
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  if (!outfile.good()) {
+    std::cerr << "failed to open JSON result file '" << ToUTF8String(path.c_str()) << "'.\n";
+    return;
+  }
+
+  const std::chrono::duration<double> inference_duration = end - start;
+  const double runs = static_cast<double>(time_costs.size());
+  auto ms = [](int64_t us) { return us / 1000.0; };
+
+  outfile << "{\n"
+          << "  \"model\": \"" << JsonEscape(model_name) << "\",\n"
+          << "  \"model_path\": \"" << JsonEscape(ToUTF8String(test_config.model_info.model_file_path)) << "\",\n"
+          << "  \"execution_provider\": \"" << test_config.machine_config.provider_type_name << "\",\n"
+          << "  \"runs\": " << time_costs.size() << ",\n"
+          << "  \"warmup_runs\": " << test_config.run_config.warmup_times << ",\n"
+          << "  \"session_creation_s\": " << session_creation_time << ",\n"
+          << "  \"inferences_per_second\": " << (inference_duration.count() > 0 ? runs / inference_duration.count() : 0.0)
+          << ",\n"
+          << "  \"latency_ms\": {\n"
+          << "    \"average\": " << (runs > 0 ? total_time_cost / runs * 1000 : 0.0) << ",\n"
+          << "    \"p50\": " << ms(latency_histogram.ValueAtPercentile(50.0)) << ",\n"
+          << "    \"p90\": " << ms(latency_histogram.ValueAtPercentile(90.0)) << ",\n"
+          << "    \"p99\": " << ms(latency_histogram.ValueAtPercentile(99.0)) << ",\n"
+          << "    \"p999\": " << ms(latency_histogram.ValueAtPercentile(99.9)) << ",\n"
+          << "    \"max\": " << ms(latency_histogram.Max()) << "\n"
+          << "  },\n"
+          << "  \"average_cpu_usage\": " << average_CPU_usage << ",\n"
+          << "  \"peak_working_set_bytes\": " << peak_workingset_size << ",\n"
+          << "  \"peak_arena_bytes\": " << peak_arena_memory << "\n"
+          << "}" << std::endl;
+}
+
 Status PerformanceRunner::Run() {
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
 
   // warm up
-  ORT_RETURN_IF_ERROR(RunOneIteration<true>());
+  for (size_t i = 0; i < performance_test_config_.run_config.warmup_times; ++i) {
+    ORT_RETURN_IF_ERROR(RunOneIteration<true>());
+  }
 
   // TODO: start profiling
   // if (!performance_test_config_.run_config.profile_file.empty())
@@ -128,6 +177,9 @@ Status PerformanceRunner::Run() {
     case TestMode::KFixRepeatedTimesMode:
       ORT_RETURN_IF_ERROR(RepeatedTimesTest());
       break;
+    case TestMode::kOpenLoopMode:
+      ORT_RETURN_IF_ERROR(RunOpenLoop());
+      break;
     default:
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
   }
@@ -135,8 +187,10 @@ Status PerformanceRunner::Run() {
 
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
+  performance_result_.peak_arena_memory = session_->GetPeakArenaMemory();
 
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
+  performance_result_.session_creation_time = session_create_duration.count();
   // TODO: end profiling
   // if (!performance_test_config_.run_config.profile_file.empty()) session_object->EndProfiling();
   std::chrono::duration<double> inference_duration = performance_result_.end - performance_result_.start;
@@ -149,9 +203,23 @@ Status PerformanceRunner::Run() {
             << "Total inference run time: " << inference_duration.count() << " s\n"
             << "Number of inferences per second: " << performance_result_.time_costs.size() / inference_duration.count() << " \n"
             << "Avg CPU usage: " << performance_result_.average_CPU_usage << " %\n"
-            << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
+            << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes\n"
+            << "Peak arena memory: " << performance_result_.peak_arena_memory << " bytes"
             << std::endl;
 
+  const LatencyHistogram& latency = performance_result_.latency_histogram;
+  if (performance_test_config_.run_config.test_mode == TestMode::kOpenLoopMode) {
+    std::cout << "Target inferences per second: " << performance_test_config_.run_config.target_qps << "\n"
+              << "Latency (including queueing delay):\n";
+  } else {
+    std::cout << "Latency:\n";
+  }
+  std::cout << "  P50: " << latency.ValueAtPercentile(50.0) / 1000.0 << " ms\n"
+            << "  P90: " << latency.ValueAtPercentile(90.0) / 1000.0 << " ms\n"
+            << "  P99: " << latency.ValueAtPercentile(99.0) / 1000.0 << " ms\n"
+            << "  P99.9: " << latency.ValueAtPercentile(99.9) / 1000.0 << " ms\n"
+            << "  Max: " << latency.Max() / 1000.0 << " ms" << std::endl;
+
   return Status::OK();
 }
 
@@ -242,6 +310,49 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOpenLoop() {
+  // Issue the requests at the target rate whether or not the previous ones completed, unlike the other modes which
+  // wait for a request to complete before issuing the next one. The time between two requests is exponentially
+  // distributed, so the arrivals follow a Poisson process.
+  // Each request is timed from the time it was due rather than from when it started to run, so neither the
+  // scheduling delay of this thread nor the time spent queued behind busy workers is left out of the latency.
+  const auto& run_config = performance_test_config_.run_config;
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(run_config.concurrent_session_runs));
+  std::exponential_distribution<double> inter_arrival_seconds(run_config.target_qps);
+  std::atomic<int> counter{0};
+  OrtMutex m;
+  OrtCondVar cv;
+
+  using clock = std::chrono::high_resolution_clock;
+  const auto end = clock::now() + std::chrono::seconds(run_config.duration_in_seconds);
+  auto arrival_time = clock::now();
+  for (;;) {
+    arrival_time += std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(inter_arrival_seconds(arrival_engine_)));
+    if (arrival_time >= end) {
+      break;
+    }
+    std::this_thread::sleep_until(arrival_time);
+
+    counter++;
+    tpool->Schedule([this, arrival_time, &counter, &m, &cv]() {
+      auto status = RunOneIteration<false>(&arrival_time);
+      if (!status.IsOK())
+        std::cerr << status.ErrorMessage();
+      // Simplified version of Eigen::Barrier
+      std::lock_guard<OrtMutex> lg(m);
+      counter--;
+      cv.notify_all();
+    });
+  }
+
+  //Join
+  std::unique_lock<OrtMutex> lock(m);
+  cv.wait(lock, [&counter]() { return counter == 0; });
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
@@ -281,7 +392,8 @@ static std::unique_ptr<TestSession> CreateSession(Ort::Env& env, std::random_dev
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
     : performance_test_config_(test_config),
-      test_model_info_(CreateModelInfo(test_config)) {
+      test_model_info_(CreateModelInfo(test_config)),
+      arrival_engine_(rd()) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = CreateSession(env, rd, test_config, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
@@ -18,6 +18,7 @@
 #include <core/session/onnxruntime_cxx_api.h>
 #include "test_configuration.h"
 #include "heap_buffer.h"
+#include "latency_histogram.h"
 #include "test_session.h"
 #include "OrtValueList.h"
 
@@ -31,12 +32,17 @@ struct PerformanceResult {
   std::chrono::time_point<std::chrono::high_resolution_clock> start;
   std::chrono::time_point<std::chrono::high_resolution_clock> end;
   size_t peak_workingset_size{0};
+  size_t peak_arena_memory{0};
   short average_CPU_usage{0};
+  double session_creation_time{0};
   double total_time_cost{0};
   std::vector<double> time_costs;
+  // latencies of the requests in microseconds, in 'openloop' mode including the time waiting to be served
+  LatencyHistogram latency_histogram;
   std::string model_name;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
+  void DumpToJson(const std::basic_string<ORTCHAR_T>& path, const PerformanceTestConfig& test_config) const;
 };
 
 class PerformanceRunner {
@@ -51,14 +57,18 @@ class PerformanceRunner {
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
+    if (!performance_test_config_.run_config.json_result_file.empty()) {
+      performance_result_.DumpToJson(performance_test_config_.run_config.json_result_file, performance_test_config_);
+    }
   }
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
  private:
   bool Initialize();
 
+  // `arrival_time` is when the request was issued in 'openloop' mode, its latency is measured from there.
   template <bool isWarmup>
-  Status RunOneIteration() {
+  Status RunOneIteration(const std::chrono::high_resolution_clock::time_point* arrival_time = nullptr) {
     std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
 
     auto status = Status::OK();
@@ -73,9 +83,16 @@ class PerformanceRunner {
     ORT_RETURN_IF_ERROR(status);
 
     if (!isWarmup) {
+      std::chrono::duration<double> latency_seconds = duration_seconds;
+      if (arrival_time != nullptr) {
+        latency_seconds = std::chrono::high_resolution_clock::now() - *arrival_time;
+      }
+
       std::lock_guard<OrtMutex> guard(results_mutex_);
-      performance_result_.time_costs.emplace_back(duration_seconds.count());
+      performance_result_.time_costs.emplace_back(latency_seconds.count());
       performance_result_.total_time_cost += duration_seconds.count();
+      performance_result_.latency_histogram.Record(
+          std::chrono::duration_cast<std::chrono::microseconds>(latency_seconds).count());
       if (performance_test_config_.run_config.f_verbose) {
         std::cout << "iteration:" << performance_result_.time_costs.size() << ","
                   << "time_cost:" << performance_result_.time_costs.back() << std::endl;
@@ -88,6 +105,7 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -112,6 +130,7 @@ class PerformanceRunner {
   std::unique_ptr<TestSession> session_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
+  std::mt19937 arrival_engine_;
 
   OrtMutex results_mutex_;
 };
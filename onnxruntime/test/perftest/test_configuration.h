@@ -15,7 +15,8 @@ namespace perftest {
 
 enum class TestMode : std::uint8_t {
   kFixDurationMode = 0,
-  KFixRepeatedTimesMode
+  KFixRepeatedTimesMode,
+  kOpenLoopMode
 };
 
 enum class Platform : std::uint8_t {
@@ -39,8 +40,11 @@ struct RunConfig {
   std::basic_string<ORTCHAR_T> profile_file;
   TestMode test_mode{TestMode::kFixDurationMode};
   size_t repeated_times{1000};
+  size_t warmup_times{1};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // requests per second issued in 'openloop' mode, the arrivals follow a Poisson process
+  double target_qps{0.0};
   bool f_dump_statistics{false};
   bool f_verbose{false};
   bool enable_memory_pattern{true};
@@ -57,6 +61,9 @@ struct RunConfig {
   std::basic_string<ORTCHAR_T> ep_runtime_config_string;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_name_overrides;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_denotation_overrides;
+  std::basic_string<ORTCHAR_T> input_shape_distribution_file;
+  // summary of the run in JSON, for tools that track the results over time
+  std::basic_string<ORTCHAR_T> json_result_file;
 };
 
 struct PerformanceTestConfig {
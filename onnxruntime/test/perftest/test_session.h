@@ -16,6 +16,8 @@ class TestSession {
   // Please measure the perf at a higher level.
   void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, Ort::Value&& value) = 0;
+  // Sum of the peak memory in use of the arenas of the session, 0 if unknown.
+  virtual size_t GetPeakArenaMemory() const { return 0; }
 
   virtual ~TestSession() = default;
 };
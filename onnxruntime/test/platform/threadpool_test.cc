@@ -4,11 +4,16 @@
 #include "core/platform/threadpool.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
+#include "core/common/profiler.h"
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <functional>
+#include <chrono>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -46,15 +51,18 @@ void ValidateTestData(TestData& test_data, int expected=1) {
 // test the function with a null pointer, reflecting scenarios where we
 // run with just the main thread.  Note that the thread pool API uses
 // static methods and should operate across all of these cases.
-void CreateThreadPoolAndTest(const std::string&, int num_threads, const std::function<void(ThreadPool*)>& test_body, int dynamic_block_base = 0, bool mock_hybrid = false) {
+void CreateThreadPoolAndTest(const std::string&, int num_threads, const std::function<void(ThreadPool*)>& test_body, int dynamic_block_base = 0, bool mock_hybrid = false, bool use_lock_free_queues = false) {
   if (num_threads > 0) {
     if (dynamic_block_base > 0) {
       onnxruntime::ThreadOptions thread_options;
       thread_options.dynamic_block_base_ = dynamic_block_base;
+      thread_options.use_lock_free_queues = use_lock_free_queues;
       auto tp_dynamic_block_size = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, num_threads, true, mock_hybrid);
       test_body(tp_dynamic_block_size.get());  // test thread pool with dynamic block size
     } else {
-      auto tp_constant_block_size = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, num_threads, true, mock_hybrid);
+      onnxruntime::ThreadOptions thread_options;
+      thread_options.use_lock_free_queues = use_lock_free_queues;
+      auto tp_constant_block_size = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, num_threads, true, mock_hybrid);
       test_body(tp_constant_block_size.get()); // test thread pool with constant block size
     } 
   } else {
@@ -80,7 +88,7 @@ void TestBatchParallelFor(const std::string& name, int num_threads, int num_task
   ValidateTestData(*test_data);
 }
 
-void TestConcurrentParallelFor(const std::string& name, int num_threads, int num_concurrent, int num_tasks, int dynamic_block_base = 0, bool mock_hybrid = false) {
+void TestConcurrentParallelFor(const std::string& name, int num_threads, int num_concurrent, int num_tasks, int dynamic_block_base = 0, bool mock_hybrid = false, bool use_lock_free_queues = false) {
   // Test running multiple concurrent loops over the same thread pool.  This aims to provoke a
   // more diverse mix of interleavings than with a single loop running at a time.
   for (int rep = 0; rep < 5; rep++) {
@@ -115,11 +123,11 @@ void TestConcurrentParallelFor(const std::string& name, int num_threads, int num
           }
           td.clear();
         },
-        dynamic_block_base, mock_hybrid);
+        dynamic_block_base, mock_hybrid, use_lock_free_queues);
   }
 }
 
-void TestBurstScheduling(const std::string& name, int num_tasks) {
+void TestBurstScheduling(const std::string& name, int num_tasks, bool use_lock_free_queues = false) {
   // Test submitting a burst of functions for executing.  The aim is to provoke cases such
   // as the thread pool's work queues being full.
   for (int rep = 0; rep < 5; rep++) {
@@ -136,7 +144,7 @@ void TestBurstScheduling(const std::string& name, int num_tasks) {
           ctr++;
         });
       }
-    });
+    }, 0, false, use_lock_free_queues);
     ASSERT_TRUE(ctr == num_tasks);
     CreateThreadPoolAndTest(name, 2, [&](ThreadPool* tp) {
       // Second variant : schedule from inside the pool
@@ -147,7 +155,7 @@ void TestBurstScheduling(const std::string& name, int num_tasks) {
           });
         }
       });
-    });
+    }, 0, false, use_lock_free_queues);
     ASSERT_TRUE(ctr == num_tasks*2);
   }
 }
@@ -177,7 +185,7 @@ void TestPoolCreation(const std::string&, int iter) {
 }
 
 // Test multi-loop parallel sections, with a series of fixed-size loops
-void TestMultiLoopSections(const std::string& name, int num_threads, int num_loops) {
+void TestMultiLoopSections(const std::string& name, int num_threads, int num_loops, bool use_lock_free_queues = false) {
   for (int rep = 0; rep < 5; rep++) {
     constexpr int num_tasks = 1024;
     auto test_data = CreateTestData(num_tasks);
@@ -190,7 +198,7 @@ void TestMultiLoopSections(const std::string& name, int num_threads, int num_loo
                                              IncrementElement(*test_data, i);
                                            });
 	}
-      });
+      }, 0, false, use_lock_free_queues);
     ValidateTestData(*test_data, num_loops);
   }
 }
@@ -505,6 +513,337 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestConcurrentParallelFor_4Thread_4Conc_1MTasks_LockFreeQueues) {
+  TestConcurrentParallelFor("TestConcurrentParallelFor_4Thread_4Conc_1MTasks_LockFreeQueues", 4, 4, 1000000, 0, false, true);
+}
+
+TEST(ThreadPoolTest, TestConcurrentParallelFor_4Thread_4Conc_1MTasks_dynamic_block_base_16_LockFreeQueues) {
+  TestConcurrentParallelFor("TestConcurrentParallelFor_4Thread_4Conc_1MTasks_dynamic_block_base_16_LockFreeQueues", 4, 4, 1000000, 16, false, true);
+}
+
+TEST(ThreadPoolTest, TestConcurrentParallelFor_8Thread_8Conc_8Tasks_LockFreeQueues) {
+  TestConcurrentParallelFor("TestConcurrentParallelFor_8Thread_8Conc_8Tasks_LockFreeQueues", 8, 8, 8, 0, false, true);
+}
+
+TEST(ThreadPoolTest, TestBurstScheduling_65536Task_LockFreeQueues) {
+  TestBurstScheduling("TestBurstScheduling_65536Task_LockFreeQueues", 65536, true);
+}
+
+TEST(ThreadPoolTest, TestMultiLoopSections_4Thread_100Loop_LockFreeQueues) {
+  TestMultiLoopSections("TestMultiLoopSections_4Thread_100Loop_LockFreeQueues", 4, 100, true);
+}
+
+TEST(ThreadPoolTest, LockFreeRunQueue) {
+  using Queue = LockFreeRunQueue<std::function<void()>, int, 4>;
+  Queue q;
+  int ctr = 0;
+  unsigned w_idx = 0;
+
+  EXPECT_TRUE(q.Empty());
+  EXPECT_EQ(q.PushBackWithTag([&]() { ctr += 1; }, 1, w_idx), PushResult::ACCEPTED_IDLE);
+  EXPECT_EQ(q.PushBackWithTag([&]() { ctr += 10; }, 2, w_idx), PushResult::ACCEPTED_BUSY);
+  EXPECT_FALSE(q.PushBack([&]() { ctr += 100; }));
+  EXPECT_FALSE(q.PushBack([&]() { ctr += 1000; }));
+  EXPECT_EQ(q.Size(), 4u);
+
+  // the queue is full so the work is handed back
+  auto rejected = q.PushBack([&]() { ctr += 10000; });
+  EXPECT_TRUE(rejected);
+
+  // revoke the second item, using the wrong tag first
+  EXPECT_FALSE(q.RevokeWithTag(3, w_idx));
+  EXPECT_TRUE(q.RevokeWithTag(2, w_idx));
+  EXPECT_FALSE(q.RevokeWithTag(2, w_idx));
+
+  // items come out in FIFO order from either end, skipping the revoked item
+  q.PopFront()();
+  EXPECT_EQ(ctr, 1);
+  q.PopBack()();
+  EXPECT_EQ(ctr, 101);
+  q.PopFront()();
+  EXPECT_EQ(ctr, 1101);
+  EXPECT_FALSE(q.PopFront());
+  EXPECT_FALSE(q.PopBack());
+  EXPECT_TRUE(q.Empty());
+
+  // wrap around the ring a few times
+  for (int i = 0; i < 10; i++) {
+    EXPECT_FALSE(q.PushBack([&]() { ctr++; }));
+    q.PopFront()();
+  }
+  EXPECT_EQ(ctr, 1111);
+}
+
+// Workers are assigned to fake NUMA nodes through ThreadOptions, so these tests run on any machine.
+// The loop must still cover every iteration exactly once, regardless of the node-local scheduling.
+void TestNumaAwareParallelFor(int num_threads, const std::vector<int>& numa_nodes, int num_tasks,
+                              int dynamic_block_base) {
+  auto test_data = CreateTestData(num_tasks);
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.numa_nodes = numa_nodes;
+  thread_options.dynamic_block_base_ = dynamic_block_base;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, num_threads, true);
+  for (int i = 0; i < 10; i++) {
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t j) { IncrementElement(*test_data, j); });
+  }
+  ValidateTestData(*test_data, 10);
+}
+
+TEST(ThreadPoolTest, TestNumaAwareParallelFor_4Thread_2Node_1MTasks) {
+  TestNumaAwareParallelFor(4, {0, 0, 1, 1}, 1000000, 0);
+}
+
+TEST(ThreadPoolTest, TestNumaAwareParallelFor_8Thread_2Node_1MTasks_dynamic_block_base_16) {
+  TestNumaAwareParallelFor(8, {3, 3, 3, 3, 5, 5, 5, 5}, 1000000, 16);
+}
+
+TEST(ThreadPoolTest, TestNumaAwareParallelFor_8Thread_3Node_100Tasks) {
+  TestNumaAwareParallelFor(8, {0, 1, 2, 0, 1, 2, 0, 1}, 100, 0);
+}
+
+TEST(ThreadPoolTest, NumaNodeGrouping) {
+  onnxruntime::ThreadOptions thread_options;
+  // node ids are renumbered densely in order of first appearance
+  thread_options.numa_nodes = {7, 7, 2, 2};
+  ThreadPoolTempl<onnxruntime::Env> tp(nullptr, 4, true, onnxruntime::Env::Default(), thread_options);
+  EXPECT_EQ(tp.NumNumaNodes(), 2u);
+  EXPECT_EQ(tp.CurrentThreadNumaNode(), -1);
+
+  std::vector<int> thread_ids(5, -2);
+  std::vector<int> thread_nodes(5, -2);
+  tp.RunInParallel([&](unsigned idx) {
+    thread_ids[idx] = tp.CurrentThreadId();
+    thread_nodes[idx] = tp.CurrentThreadNumaNode();
+  }, 5, 1);
+
+  for (size_t i = 0; i < thread_ids.size(); i++) {
+    if (thread_ids[i] == -1) {
+      EXPECT_EQ(thread_nodes[i], -1);
+    } else if (thread_ids[i] >= 0) {
+      EXPECT_EQ(thread_nodes[i], thread_ids[i] < 2 ? 0 : 1);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, NumaNodeGrouping_SingleNode) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.numa_nodes = {1, 1, 1};
+  ThreadPoolTempl<onnxruntime::Env> tp(nullptr, 3, true, onnxruntime::Env::Default(), thread_options);
+  EXPECT_EQ(tp.NumNumaNodes(), 1u);
+
+  // too few entries, the information is ignored
+  thread_options.numa_nodes = {0, 1};
+  ThreadPoolTempl<onnxruntime::Env> tp2(nullptr, 3, true, onnxruntime::Env::Default(), thread_options);
+  EXPECT_EQ(tp2.NumNumaNodes(), 1u);
+}
+
+TEST(ThreadPoolTest, NumQueuedTasks) {
+  onnxruntime::ThreadOptions thread_options;
+  ThreadPoolTempl<onnxruntime::Env> tp(nullptr, 1, true, onnxruntime::Env::Default(), thread_options);
+  EXPECT_EQ(tp.NumQueuedTasks(), 0u);
+
+  // keep the only worker busy so that the following tasks stay in its queue
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+  tp.Schedule([&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  std::atomic<int> num_run{0};
+  for (int i = 0; i < 3; i++) {
+    tp.Schedule([&]() { ++num_run; });
+  }
+  EXPECT_EQ(tp.NumQueuedTasks(), 3u);
+
+  release = true;
+  while (num_run != 3) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(tp.NumQueuedTasks(), 0u);
+}
+
+TEST(ThreadPoolTest, SharedPoolQuota) {
+  onnxruntime::ThreadOptions thread_options;
+  ThreadPool shared_pool(&onnxruntime::Env::Default(), thread_options, nullptr, 8, true);
+  // hybrid CPUs scale the degree of parallelism by a constant factor
+  const int factor = ThreadPool::DegreeOfParallelism(&shared_pool) / 8;
+
+  onnxruntime::concurrency::ThreadPoolQuota quota;
+  quota.max_threads = 2;
+  ThreadPool capped_pool(shared_pool, quota);
+  EXPECT_EQ(ThreadPool::DegreeOfParallelism(&capped_pool), 3 * factor);
+
+  // the loops of the capped pool still cover every iteration exactly once
+  auto test_data = CreateTestData(10000);
+  for (int i = 0; i < 10; i++) {
+    ThreadPool::TrySimpleParallelFor(&capped_pool, 10000, [&](std::ptrdiff_t j) { IncrementElement(*test_data, j); });
+  }
+  ValidateTestData(*test_data, 10);
+
+  quota.max_threads = 0;
+  quota.weight = 3;
+  ThreadPool heavy_pool(shared_pool, quota);
+  quota.weight = 1;
+  ThreadPool light_pool(shared_pool, quota);
+  EXPECT_EQ(ThreadPool::DegreeOfParallelism(&heavy_pool), 8 * factor);
+  {
+    ThreadPool::ActiveScope heavy_scope(&heavy_pool);
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(&heavy_pool), 8 * factor);
+    {
+      ThreadPool::ActiveScope light_scope(&light_pool);
+      ThreadPool::ActiveScope nested_light_scope(&light_pool);
+      EXPECT_EQ(ThreadPool::DegreeOfParallelism(&heavy_pool), 6 * factor);
+      EXPECT_EQ(ThreadPool::DegreeOfParallelism(&light_pool), 2 * factor);
+      // pools without a weight aren't affected
+      EXPECT_EQ(ThreadPool::DegreeOfParallelism(&capped_pool), 3 * factor);
+    }
+    EXPECT_EQ(ThreadPool::DegreeOfParallelism(&heavy_pool), 8 * factor);
+  }
+}
+
+// Runs `num_tasks` tasks one after the other on the pool, waiting `gap` between the end of a task and the next one.
+static void RunSpacedTasks(ThreadPoolTempl<onnxruntime::Env>& tp, int num_tasks, std::chrono::microseconds gap) {
+  for (int i = 0; i < num_tasks; i++) {
+    std::atomic<bool> done{false};
+    tp.Schedule([&]() { done = true; });
+    while (!done) {
+      std::this_thread::yield();
+    }
+    if (gap.count() > 0) {
+      std::this_thread::sleep_for(gap);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, AdaptiveSpinning) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.adaptive_spinning = true;
+  ThreadPoolTempl<onnxruntime::Env> tp(nullptr, 1, true, onnxruntime::Env::Default(), thread_options);
+
+  // waits far longer than the spin limit, the worker stops spinning and blocks right away
+  RunSpacedTasks(tp, 30, std::chrono::microseconds(20000));
+  auto long_gap_stats = tp.GetSpinStats();
+  EXPECT_EQ(long_gap_stats.spin_ns, 0u);
+  EXPECT_GT(long_gap_stats.avg_wait_ns, 0u);
+  EXPECT_GT(long_gap_stats.blocks, 0u);
+  EXPECT_GT(long_gap_stats.wakes, 0u);
+
+  // back-to-back tasks bring the average wait time down again
+  RunSpacedTasks(tp, 200, std::chrono::microseconds(0));
+  auto short_gap_stats = tp.GetSpinStats();
+  EXPECT_LT(short_gap_stats.avg_wait_ns, long_gap_stats.avg_wait_ns);
+  EXPECT_GE(short_gap_stats.blocks, long_gap_stats.blocks);
+}
+
+TEST(ThreadPoolTest, AdaptiveSpinning_Disabled) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.adaptive_spinning = true;
+  // adaptive spinning has no effect if spinning isn't allowed
+  ThreadPoolTempl<onnxruntime::Env> tp(nullptr, 1, false, onnxruntime::Env::Default(), thread_options);
+  RunSpacedTasks(tp, 10, std::chrono::microseconds(0));
+  auto stats = tp.GetSpinStats();
+  EXPECT_EQ(stats.spin_hits, 0u);
+  EXPECT_EQ(stats.avg_wait_ns, 0u);
+  EXPECT_EQ(stats.spin_ns, 0u);
+  EXPECT_GT(stats.blocks, 0u);
+}
+
+TEST(ThreadPoolTest, RunTermination_StopsClaimingBlocks) {
+  CreateThreadPoolAndTest("", 4, [](ThreadPool* tp) {
+    bool terminate = false;
+    std::atomic<int> count{0};
+    {
+      ThreadPool::RunTerminationScope run_termination(terminate);
+      ThreadPool::TrySimpleParallelFor(tp, 1000, [&](std::ptrdiff_t) {
+        count++;
+        terminate = true;
+      });
+    }
+    // each thread finishes the block it claimed before seeing the flag
+    EXPECT_GT(count.load(), 0);
+    EXPECT_LE(count.load(), 5);
+    EXPECT_EQ(ThreadPool::RunTerminationScope::Current(), nullptr);
+
+    // without a scope the loop runs to completion regardless of the flag
+    count = 0;
+    ThreadPool::TrySimpleParallelFor(tp, 1000, [&](std::ptrdiff_t) { count++; });
+    EXPECT_EQ(count.load(), 1000);
+  });
+}
+
+TEST(ThreadPoolTest, RunTermination_Deadline) {
+  CreateThreadPoolAndTest("", 4, [](ThreadPool* tp) {
+    using Clock = ThreadPool::RunTerminationScope::Clock;
+    bool terminate = false;
+    std::atomic<int> count{0};
+
+    ThreadPool::RunTerminationScope expired(terminate, Clock::now() - std::chrono::milliseconds(1));
+    EXPECT_TRUE(expired.ShouldTerminate());
+    ThreadPool::TrySimpleParallelFor(tp, 1000, [&](std::ptrdiff_t) { count++; });
+    EXPECT_EQ(count.load(), 0);
+
+    {
+      // the innermost scope applies
+      ThreadPool::RunTerminationScope pending(terminate, Clock::now() + std::chrono::hours(1));
+      EXPECT_EQ(ThreadPool::RunTerminationScope::Current(), &pending);
+      EXPECT_FALSE(pending.ShouldTerminate());
+      ThreadPool::TrySimpleParallelFor(tp, 1000, [&](std::ptrdiff_t) { count++; });
+      EXPECT_EQ(count.load(), 1000);
+    }
+    EXPECT_EQ(ThreadPool::RunTerminationScope::Current(), &expired);
+  });
+}
+
+#if !defined(__wasm__)
+TEST(ThreadPoolTest, ProfilerRecordsWorkItems) {
+  CreateThreadPoolAndTest("", 4, [](ThreadPool* tp) {
+    onnxruntime::profiling::Profiler profiler;
+    profiler.EnableRingBuffer(1000);
+    profiler.StartProfiling(std::string("threadpool_profile_test.json"));
+    std::atomic<int> count{0};
+    {
+      onnxruntime::profiling::Profiler::ThreadScope scope(&profiler);
+      EXPECT_EQ(onnxruntime::profiling::Profiler::Current(), &profiler);
+      ThreadPool::TrySimpleParallelFor(tp, 1000, [&](std::ptrdiff_t) { count++; });
+    }
+    EXPECT_EQ(onnxruntime::profiling::Profiler::Current(), nullptr);
+    EXPECT_EQ(count.load(), 1000);
+
+    const std::string dump_file = profiler.DumpProfiling();
+    EXPECT_EQ(dump_file, "threadpool_profile_test_dump1.json");
+
+    // the work items together ran all the iterations
+    std::ifstream dump(dump_file);
+    ASSERT_TRUE(dump);
+    const std::string iterations_arg = "\"iterations\" : \"";
+    int num_work_items = 0;
+    int num_iterations = 0;
+    std::string line;
+    while (std::getline(dump, line)) {
+      if (line.find("parallel_for_work_item") != std::string::npos) {
+        auto pos = line.find(iterations_arg);
+        ASSERT_NE(pos, std::string::npos);
+        num_iterations += std::stoi(line.substr(pos + iterations_arg.size()));
+        ++num_work_items;
+      }
+    }
+    EXPECT_GE(num_work_items, 1);
+    EXPECT_EQ(num_iterations, 1000);
+    dump.close();
+
+    profiler.EndProfiling();
+    std::remove(dump_file.c_str());
+    std::remove("threadpool_profile_test.json");
+  });
+}
+#endif
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -413,6 +413,87 @@ TEST(If, ConditionalBranchesOnlyContainConstantNodes_ElseBranchExecution) {
   test.Run();
 }
 
+// The 'then' branch returns the outer scope value 'A' and the 'else' branch returns one of its initializers, so
+// neither branch has a node to execute. The If output aliases those values when it is consumed by a node of the
+// main graph, and is a copy of them when it is a graph output.
+class IfOpTesterWithUnfetchedOutputs : public OpTester {
+ public:
+  explicit IfOpTesterWithUnfetchedOutputs(bool if_output_is_graph_output)
+      : OpTester("If", 13), if_output_is_graph_output_(if_output_is_graph_output) {
+  }
+
+ protected:
+  void AddNodes(onnxruntime::Graph& graph,
+                std::vector<onnxruntime::NodeArg*>& graph_input_defs,
+                std::vector<onnxruntime::NodeArg*>& graph_output_defs,
+                std::vector<std::function<void(onnxruntime::Node& node)>>& /*add_attribute_funcs*/) override {
+    // Graph inputs are 0:Cond for If, 1:A
+    ASSERT_EQ(graph_input_defs.size(), 2u);
+    ASSERT_EQ(graph_output_defs.size(), 1u);
+
+    NodeArg* a_input = graph_input_defs[1];
+    NodeArg* if_output = if_output_is_graph_output_
+                             ? graph_output_defs[0]
+                             : &graph.GetOrCreateNodeArg("if_out", a_input->TypeAsProto());
+
+    auto CreateSubgraph = [a_input](bool then_branch) {
+      Model model(then_branch ? "Then" : "Else", false, DefaultLoggingManager().DefaultLogger());
+      auto& subgraph = model.MainGraph();
+
+      NodeArg* output = nullptr;
+      if (then_branch) {
+        output = &subgraph.GetOrCreateNodeArg(a_input->Name(), a_input->TypeAsProto());
+        subgraph.AddOuterScopeNodeArg(a_input->Name());
+      } else {
+        TensorProto initializer;
+        initializer.set_name("else_value");
+        initializer.set_data_type(TensorProto_DataType_FLOAT);
+        initializer.add_dims(2);
+        initializer.add_float_data(10.f);
+        initializer.add_float_data(20.f);
+        subgraph.AddInitializedTensor(initializer);
+        output = &subgraph.GetOrCreateNodeArg("else_value", a_input->TypeAsProto());
+      }
+
+      subgraph.SetOutputs({output});
+      EXPECT_EQ(subgraph.Resolve(), Status::OK());
+      return subgraph.ToGraphProto();
+    };
+
+    auto& if_node = graph.AddNode("if", "If", "If node", {graph_input_defs[0]}, {if_output});
+    if_node.AddAttribute("then_branch", CreateSubgraph(true));
+    if_node.AddAttribute("else_branch", CreateSubgraph(false));
+
+    if (!if_output_is_graph_output_) {
+      auto& concat_node = graph.AddNode("concat", "Concat", "Consumer of the If output", {if_output, if_output},
+                                        {graph_output_defs[0]});
+      concat_node.AddAttribute("axis", static_cast<int64_t>(0));
+    }
+  }
+
+ private:
+  bool if_output_is_graph_output_;
+};
+
+TEST(If, UnfetchedOutputs) {
+  for (bool if_output_is_graph_output : {false, true}) {
+    for (bool condition : {true, false}) {
+      IfOpTesterWithUnfetchedOutputs test(if_output_is_graph_output);
+      test.AddInput<bool>("If_input", {1}, {condition});
+      test.AddInput<float>("A", {2}, {1.f, 2.f});
+
+      std::vector<float> expected = condition ? std::vector<float>{1.f, 2.f} : std::vector<float>{10.f, 20.f};
+      if (!if_output_is_graph_output) {
+        expected.insert(expected.end(), expected.begin(), expected.end());
+      }
+
+      test.AddOutput<float>("Y", {static_cast<int64_t>(expected.size())}, expected);
+      // TensorRT: subgraph outputs that are not produced by a node are not supported
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+    }
+  }
+}
+
 // This is to test an "If" node with just a "SequenceEmpty" node in the "then" and "else" conditional branches
 class IfOpTesterWithSequencesAsOutput : public OpTester {
  public:
@@ -2,14 +2,71 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "test/providers/provider_test_utils.h"
 
 #include <algorithm>
-#include <random>
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+// The values the CPU kernels generate for a seed, one element at a time. Value i of a float output comes from
+// the Philox block offset + i / 4 and value i of a double output from the block offset + i / 2.
+static void PhiloxNormal(uint64_t seed, uint64_t offset, float mean, float scale, std::vector<float>& values) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    const philox::Block block = philox::GenerateBlock(seed, offset + i / 4);
+    const size_t pair = i % 4 - i % 2;
+    float z0, z1;
+    philox::BoxMuller(1.0f - philox::UniformFloat(block[pair]), philox::UniformFloat(block[pair + 1]), z0, z1);
+    values[i] = (i % 2 == 0 ? z0 : z1) * scale + mean;
+  }
+}
+
+static void PhiloxNormal(uint64_t seed, uint64_t offset, float mean, float scale, std::vector<double>& values) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    const philox::Block block = philox::GenerateBlock(seed, offset + i / 2);
+    double z0, z1;
+    philox::BoxMuller(1.0 - philox::UniformDouble(block[0], block[1]), philox::UniformDouble(block[2], block[3]),
+                      z0, z1);
+    values[i] = (i % 2 == 0 ? z0 : z1) * scale + mean;
+  }
+}
+
+static void PhiloxUniform(uint64_t seed, uint64_t offset, float low, float high, std::vector<float>& values) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    const philox::Block block = philox::GenerateBlock(seed, offset + i / 4);
+    values[i] = philox::UniformFloat(block[i % 4]) * (high - low) + low;
+  }
+}
+
+static void PhiloxUniform(uint64_t seed, uint64_t offset, float low, float high, std::vector<double>& values) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    const philox::Block block = philox::GenerateBlock(seed, offset + i / 2);
+    const size_t lane = (i % 2) * 2;
+    values[i] = philox::UniformDouble(block[lane], block[lane + 1]) * (static_cast<double>(high) - low) + low;
+  }
+}
+
+// Known answers of Philox4x32-10 from the Random123 library.
+TEST(Random, PhiloxKnownAnswers) {
+  EXPECT_EQ(philox::Philox4x32x10({0, 0, 0, 0}, 0, 0),
+            (philox::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(philox::Philox4x32x10({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, 0xffffffff, 0xffffffff),
+            (philox::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(philox::Philox4x32x10({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, 0xa4093822, 0x299f31d0),
+            (philox::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+  // the batched generation gives the same blocks, also when the low word of the counter wraps around.
+  constexpr uint64_t seed = 0x123456789;
+  constexpr uint64_t first_index = 0xfffffff8;
+  uint32_t words[4 * philox::kBatchSize];
+  philox::GenerateBlocks(seed, first_index, words);
+  for (int i = 0; i < philox::kBatchSize; ++i) {
+    const philox::Block block = philox::GenerateBlock(seed, first_index + i);
+    EXPECT_TRUE(std::equal(block.begin(), block.end(), words + 4 * i)) << "block " << i;
+  }
+}
+
 TEST(Random, RandomNormal2DDouble) {
   OpTester test("RandomNormal");
 
@@ -25,16 +82,12 @@ TEST(Random, RandomNormal2DDouble) {
   test.AddAttribute<int64_t>("dtype", TensorProto::DOUBLE);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<double> distribution{mean, scale};
-
   std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  PhiloxNormal(static_cast<uint64_t>(seed), 0, mean, scale, expected_output);
 
   test.AddOutput<double>("Y", dims, expected_output);
 
-  // The expected_output is generated using std lib, which is used by CPU kernel only.
+  // The expected_output is generated like the CPU kernel generates it.
   // So we need to exclude other EPs here. Ditto for other places.
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kRocmExecutionProvider});
 }
@@ -62,12 +115,8 @@ void RunRandomNormalLike3DFloat(bool infer_dtype = false) {
                         0.f, 0.f, 0.f,
                         0.f, 0.f, 0.f});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<float> distribution{mean, scale};
-
   std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  PhiloxNormal(static_cast<uint64_t>(seed), 0, mean, scale, expected_output);
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -98,12 +147,8 @@ TEST(Random, RandomUniform1DFloat) {
   test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<float> distribution{low, high};
-
   std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  PhiloxUniform(static_cast<uint64_t>(seed), 0, low, high, expected_output);
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -111,6 +156,38 @@ TEST(Random, RandomUniform1DFloat) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kRocmExecutionProvider, kTensorrtExecutionProvider});
 }
 
+// The output is generated by several threads, and it must be the same as when it is generated one value at a time.
+// The second call to Compute continues the stream after the blocks used by the first one.
+TEST(Random, RandomUniformLargeFloatMultipleCalls) {
+  OpTester test("RandomUniform");
+
+  std::vector<int64_t> dims{300, 1001};
+
+  constexpr float low = -1.f;
+  constexpr float high = 1.f;
+  constexpr float seed = 42.f;
+
+  test.AddAttribute("low", low);
+  test.AddAttribute("high", high);
+  test.AddAttribute("seed", seed);
+  test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
+  test.AddAttribute("shape", dims);
+
+  // the first call uses whole batches of philox::kBatchSize blocks, with four floats per block.
+  const int64_t size = TensorShape(dims).Size();
+  const int64_t values_per_batch = 4 * philox::kBatchSize;
+  const auto first_call_blocks =
+      static_cast<uint64_t>((size + values_per_batch - 1) / values_per_batch * philox::kBatchSize);
+
+  std::vector<float> expected_output(size);
+  PhiloxUniform(static_cast<uint64_t>(seed), first_call_blocks, low, high, expected_output);
+
+  test.AddOutput<float>("Y", dims, expected_output);
+  test.SetNumRunCalls(2);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kRocmExecutionProvider, kTensorrtExecutionProvider});
+}
+
 void RunRandomUniformLikeTest(bool infer_dtype = false) {
   OpTester test("RandomUniformLike");
 
@@ -131,12 +208,8 @@ void RunRandomUniformLikeTest(bool infer_dtype = false) {
                         {0., 0., 0., 0., 0., 0.,
                          0., 0., 0., 0., 0., 0.});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<double> distribution{low, high};
-
   std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  PhiloxUniform(static_cast<uint64_t>(seed), 0, low, high, expected_output);
 
   test.AddOutput<double>("Y", dims, expected_output);
 
@@ -226,10 +299,9 @@ TEST(Random, InvalidDType) {
 }
 
 /*
-Note: There are no reference tests that can be reused in this case. I tried to use the tensorflow
-test cases but they use a different RNG (Philox) and hence the test results differ. Since the implementation
-of the op is same as tensorflow, for now I've just relied on the output generated by this code as ground truth
-for verification.
+Note: There are no reference tests that can be reused in this case. The tensorflow test cases also use Philox,
+but their streams are split differently and hence the test results differ. Since the implementation of the op is
+same as tensorflow, for now I've just relied on the output generated by this code as ground truth for verification.
 */
 TEST(Random, MultinomialGoodCase) {
   OpTester test("Multinomial");
@@ -249,13 +321,7 @@ TEST(Random, MultinomialGoodCase) {
   test.AddAttribute<int64_t>("dtype", TensorProto::INT64);
 
   const std::vector<int64_t> output_dims{batch_size, num_samples};
-#ifdef _WIN32
-  const std::vector<int64_t> expected_output{2, 0, 0, 2, 2, 2, 0, 2, 2, 1, 1, 2, 1, 1, 1, 1, 2, 1, 2, 0};
-#elif defined(__MACH__) || defined(__ANDROID__) || defined(__FreeBSD__) || defined(__wasm__)
-  const std::vector<int64_t> expected_output{1, 1, 2, 2, 0, 2, 2, 2, 0, 2, 1, 1, 2, 0, 2, 2, 0, 2, 1, 1};
-#else
-  const std::vector<int64_t> expected_output{2, 0, 0, 1, 0, 1, 2, 0, 1, 0, 0, 1, 1, 0, 1, 0, 2, 0, 2, 0};
-#endif
+  const std::vector<int64_t> expected_output{1, 2, 0, 2, 0, 0, 2, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0};
   test.AddOutput<int64_t>("Y", output_dims, expected_output);
 
   test.Run();
@@ -286,16 +352,9 @@ TEST(Random, MultinomialDefaultDType) {
     test.Run();
   };
 
-#ifdef _WIN32
-  const std::vector<int32_t> expected_output_1{2, 0, 0, 2, 2, 2, 0, 2, 2, 1, 1, 2, 1, 1, 1, 1, 2, 1, 2, 0};
-  const std::vector<int32_t> expected_output_2{0, 0, 1, 0, 2, 2, 2, 0, 2, 1, 2, 1, 0, 2, 0, 2, 2, 1, 2, 1};
-#elif defined(__MACH__) || defined(__ANDROID__) || defined(__FreeBSD__) || defined(__wasm__)
-  const std::vector<int32_t> expected_output_1{1, 1, 2, 2, 0, 2, 2, 2, 0, 2, 1, 1, 2, 0, 2, 2, 0, 2, 1, 1};
-  const std::vector<int32_t> expected_output_2{1, 0, 1, 1, 1, 1, 0, 0, 1, 1, 0, 2, 0, 1, 1, 0, 2, 2, 2, 1};
-#else
-  const std::vector<int32_t> expected_output_1{2, 0, 0, 1, 0, 1, 2, 0, 1, 0, 0, 1, 1, 0, 1, 0, 2, 0, 2, 0};
-  const std::vector<int32_t> expected_output_2{2, 2, 1, 1, 0, 2, 2, 1, 1, 2, 0, 0, 0, 2, 0, 1, 1, 1, 0, 0};
-#endif
+  // Philox is the same on every platform, so the expected output is too.
+  const std::vector<int32_t> expected_output_1{1, 2, 0, 2, 0, 0, 2, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0};
+  const std::vector<int32_t> expected_output_2{2, 0, 0, 2, 0, 1, 2, 1, 1, 0, 0, 2, 0, 2, 2, 0, 2, 2, 1, 2};
 
   // Test output from a single call to Multinomial::Compute
   run_test(1, expected_output_1);
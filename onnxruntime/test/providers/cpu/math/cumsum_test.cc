@@ -223,5 +223,73 @@ TEST(CumSumTest, _1DTestdouble_WithInt64Axis) {
   test.AddOutput<double>("y", {5}, {1., 3., 6., 10., 15.});
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+
+// Computes the expected CumSum of a [outer, dim, inner] tensor along its middle dimension.
+template <typename T>
+static std::vector<T> ReferenceCumSum(const std::vector<T>& x, int64_t outer, int64_t dim, int64_t inner,
+                                      bool exclusive, bool reverse) {
+  std::vector<T> y(x.size());
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t i = 0; i < inner; ++i) {
+      T sum{};
+      for (int64_t k = 0; k < dim; ++k) {
+        const int64_t index = (o * dim + (reverse ? dim - 1 - k : k)) * inner + i;
+        if (exclusive) {
+          y[index] = sum;
+          sum += x[index];
+        } else {
+          sum += x[index];
+          y[index] = sum;
+        }
+      }
+    }
+  }
+  return y;
+}
+
+// Long axes that are split between threads and scanned in independent segments, with all the combinations of the
+// exclusive and reverse attributes.
+TEST(CumSumTest, LongAxis) {
+  for (int64_t inner : {1, 3, 37}) {
+    for (int64_t exclusive : {0, 1}) {
+      for (int64_t reverse : {0, 1}) {
+        const int64_t outer = 2;
+        const int64_t dim = 4099;
+        std::vector<float> x(outer * dim * inner);
+        for (size_t n = 0; n < x.size(); ++n) {
+          // small integers keep the sums exact whatever the order of the additions
+          x[n] = static_cast<float>(static_cast<int>(n % 7) - 3);
+        }
+
+        OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+        test.AddAttribute<int64_t>("exclusive", exclusive);
+        test.AddAttribute<int64_t>("reverse", reverse);
+        test.AddInput<float>("x", {outer, dim, inner}, x);
+        test.AddInput<int64_t>("axis", {}, {1});
+        test.AddOutput<float>("y", {outer, dim, inner},
+                              ReferenceCumSum(x, outer, dim, inner, exclusive != 0, reverse != 0));
+        test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+      }
+    }
+  }
+}
+
+TEST(CumSumTest, _3DTestInt64ReverseExclusive) {
+  const int64_t outer = 3;
+  const int64_t dim = 50;
+  const int64_t inner = 300;
+  std::vector<int64_t> x(outer * dim * inner);
+  for (size_t n = 0; n < x.size(); ++n) {
+    x[n] = static_cast<int64_t>(n % 11) - 5;
+  }
+
+  OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  test.AddAttribute<int64_t>("reverse", 1);
+  test.AddInput<int64_t>("x", {outer, dim, inner}, x);
+  test.AddInput<int32_t>("axis", {}, {-2});
+  test.AddOutput<int64_t>("y", {outer, dim, inner}, ReferenceCumSum(x, outer, dim, inner, true, true));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
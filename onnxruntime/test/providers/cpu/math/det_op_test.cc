@@ -30,6 +30,23 @@ TEST(DetOpTest, 2dWithMultipleBatchDims) {
   test.Run();
 }
 
+TEST(DetOpTest, ManyBatches) {
+  // the determinant of [[a, 1, 0], [0, a, 1], [1, 0, a]] is a^3 + 1.
+  constexpr int64_t batch_size = 1000;
+  std::vector<float> X;
+  std::vector<float> Y;
+  for (int64_t b = 0; b < batch_size; ++b) {
+    const float a = static_cast<float>(b % 7) * 0.5f - 1.5f;
+    X.insert(X.end(), {a, 1.f, 0.f, 0.f, a, 1.f, 1.f, 0.f, a});
+    Y.push_back(a * a * a + 1.f);
+  }
+
+  OpTester test("Det", 11);
+  test.AddInput<float>("X", {10, batch_size / 10, 3, 3}, X);
+  test.AddOutput<float>("Y", {10, batch_size / 10}, Y);
+  test.Run();
+}
+
 TEST(DetOpTest, InputDimsLessThan2) {
   OpTester test("Det", 11);
   test.AddInput<float>("X", {1}, {3.0f});
@@ -209,6 +209,31 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run();
 }
 
+// The cheapest contraction path contracts the last 2 inputs first
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_Reordered) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl->il");
+  test.AddInput<float>("x", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("z", {2, 1}, {1.f, 2.f});
+  test.AddOutput<float>("o", {2, 1}, {78.f, 177.f});
+  test.Run();
+}
+
+// More inputs than kOptimalContractionPathMaxInputs - the contraction path is found by the greedy search
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_Greedy) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl,lm,mn,no->io");
+  test.AddInput<float>("a", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("b", {2, 2}, {1.f, 0.f, 1.f, 1.f});
+  test.AddInput<float>("c", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("d", {2, 2}, {1.f, 0.f, 1.f, 1.f});
+  test.AddInput<float>("e", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("f", {2, 2}, {1.f, 0.f, 1.f, 1.f});
+  test.AddOutput<float>("o", {2, 2}, {167.f, 102.f, 357.f, 218.f});
+  test.Run();
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
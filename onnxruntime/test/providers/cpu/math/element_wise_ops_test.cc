@@ -6,6 +6,7 @@
 #include "test/util/include/default_providers.h"
 #include "core/util/math.h"
 #include <algorithm>
+#include <functional>
 #include <math.h>
 
 namespace onnxruntime {
@@ -141,6 +142,38 @@ TEST(MathOpTest, Add_float) {
 #endif
 }
 
+TEST(MathOpTest, Add_MLFloat16_Broadcast) {
+  OpTester test("Add", 14);
+  test.AddInput<MLFloat16>("A", {2, 3}, MakeMLFloat16({1.0f, 2.5f, -1.0f, 0.0f, 1.5f, -100.0f}));
+  test.AddInput<MLFloat16>("B", {3}, MakeMLFloat16({-1.0f, 4.5f, 0.25f}));
+  test.AddOutput<MLFloat16>("C", {2, 3}, MakeMLFloat16({0.0f, 7.0f, -0.75f, -1.0f, 6.0f, -99.75f}));
+  test.Run();
+}
+
+TEST(MathOpTest, Div_MLFloat16_Scalar) {
+  // more elements than a block of the float conversion
+  const std::vector<int64_t> dims{1030};
+  std::vector<float> lhs_values(1030);
+  std::vector<float> out_values(1030);
+  for (size_t i = 0; i < lhs_values.size(); ++i) {
+    lhs_values[i] = static_cast<float>(i % 64) - 32.0f;
+    out_values[i] = lhs_values[i] / 4.0f;
+  }
+
+  auto to_half = [](const std::vector<float>& values) {
+    std::vector<MLFloat16> output;
+    std::transform(values.begin(), values.end(), std::back_inserter(output),
+                   [](float fl) { return MLFloat16(math::floatToHalf(fl)); });
+    return output;
+  };
+
+  OpTester test("Div", 14);
+  test.AddInput<MLFloat16>("A", dims, to_half(lhs_values));
+  test.AddInput<MLFloat16>("B", {}, MakeMLFloat16({4.0f}));
+  test.AddOutput<MLFloat16>("C", dims, to_half(out_values));
+  test.Run();
+}
+
 TEST(MathOpTest, Add_double) {
   OpTester test("Add");
   std::vector<int64_t> dims{3, 3};
@@ -342,6 +375,66 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);  //TensorRT: Input batch size is inconsistent
 }
 
+// Runs `op_name` with a tensor of `full_dims` viewed as [outer, channels, inner] and a vector of channel values of
+// `channel_dims` broadcast over it, in both orders of the inputs.
+static void TestChannelBroadcast(const char* op_name, const std::function<float(float, float)>& op,
+                                 const std::vector<int64_t>& full_dims, const std::vector<int64_t>& channel_dims,
+                                 int64_t outer, int64_t channels, int64_t inner) {
+  std::vector<float> full_values(static_cast<size_t>(outer * channels * inner));
+  std::vector<float> channel_values(static_cast<size_t>(channels));
+  for (size_t i = 0; i < full_values.size(); i++) {
+    full_values[i] = static_cast<float>(i % 13) + 1.0f;
+  }
+  for (size_t i = 0; i < channel_values.size(); i++) {
+    channel_values[i] = static_cast<float>(i % 5) + 0.5f;
+  }
+
+  for (bool channels_first : {false, true}) {
+    std::vector<float> expected(full_values.size());
+    for (size_t i = 0; i < full_values.size(); i++) {
+      const float c = channel_values[(i / static_cast<size_t>(inner)) % static_cast<size_t>(channels)];
+      expected[i] = channels_first ? op(c, full_values[i]) : op(full_values[i], c);
+    }
+
+    OpTester test(op_name);
+    if (channels_first) {
+      test.AddInput<float>("A", channel_dims, channel_values);
+      test.AddInput<float>("B", full_dims, full_values);
+    } else {
+      test.AddInput<float>("A", full_dims, full_values);
+      test.AddInput<float>("B", channel_dims, channel_values);
+    }
+    test.AddOutput<float>("C", full_dims, expected);
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+}
+
+static void TestChannelBroadcastShapes(const char* op_name, const std::function<float(float, float)>& op) {
+  // NCHW bias, the spatial size is not a multiple of the vector width
+  TestChannelBroadcast(op_name, op, {2, 3, 5, 7}, {3, 1, 1}, 2, 3, 35);
+  TestChannelBroadcast(op_name, op, {2, 16, 8, 8}, {1, 16, 1, 1}, 2, 16, 64);
+  // channels last bias
+  TestChannelBroadcast(op_name, op, {2, 4, 4, 19}, {19}, 32, 19, 1);
+  // channels spanning several dimensions, with dimensions of 1 in between
+  TestChannelBroadcast(op_name, op, {3, 4, 1, 5, 6}, {4, 1, 5, 1}, 3, 20, 6);
+}
+
+TEST(MathOpTest, Add_Broadcast_Channels) {
+  TestChannelBroadcastShapes("Add", [](float a, float b) { return a + b; });
+}
+
+TEST(MathOpTest, Sub_Broadcast_Channels) {
+  TestChannelBroadcastShapes("Sub", [](float a, float b) { return a - b; });
+}
+
+TEST(MathOpTest, Mul_Broadcast_Channels) {
+  TestChannelBroadcastShapes("Mul", [](float a, float b) { return a * b; });
+}
+
+TEST(MathOpTest, Div_Broadcast_Channels) {
+  TestChannelBroadcastShapes("Div", [](float a, float b) { return a / b; });
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
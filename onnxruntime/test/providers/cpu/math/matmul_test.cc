@@ -163,7 +163,6 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
-#if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(MathOpTest, MatMul_Float16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -192,7 +191,79 @@ TEST(MathOpTest, MatMul_Float16) {
   test.AddOutput<MLFloat16>("Y", {2, 3}, f_Y);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: fp16 is not supported
 }
-#endif
+
+// Exercises the blocking of the MLAS half precision GEMM with a pre-packed B.
+TEST(MathOpTest, MatMul_Float16_PrepackedB) {
+  constexpr int64_t M = 37, K = 150, N = 70;
+  std::vector<float> A(M * K);
+  std::vector<float> B(K * N);
+  std::vector<float> Y(M * N, 0.0f);
+  for (int64_t i = 0; i < M * K; i++) {
+    A[i] = static_cast<float>((i % 7) - 3) * 0.25f;
+  }
+  for (int64_t i = 0; i < K * N; i++) {
+    B[i] = static_cast<float>((i % 5) - 2) * 0.5f;
+  }
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        Y[m * N + n] += A[m * K + k] * B[k * N + n];
+      }
+    }
+  }
+
+  std::vector<MLFloat16> f_A(A.size());
+  std::vector<MLFloat16> f_B(B.size());
+  std::vector<MLFloat16> f_Y(Y.size());
+  ConvertFloatToMLFloat16(A.data(), f_A.data(), static_cast<int>(A.size()));
+  ConvertFloatToMLFloat16(B.data(), f_B.data(), static_cast<int>(B.size()));
+  ConvertFloatToMLFloat16(Y.data(), f_Y.data(), static_cast<int>(Y.size()));
+
+  OpTester test("MatMul", 14);
+  test.AddInput<MLFloat16>("A", {M, K}, f_A);
+  test.AddInput<MLFloat16>("B", {K, N}, f_B, true);
+  test.AddOutput<MLFloat16>("Y", {M, N}, f_Y);
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+// B is packed for the sparse MLAS kernels when enough of it is zero.
+TEST(MathOpTest, MatMul_SparseInitializer) {
+  constexpr int64_t Batch = 2, M = 5, K = 96, N = 40;
+  // rows of B pruned as a whole, then a single nonzero value in each group of 8 rows of a column
+  for (int pattern = 0; pattern < 2; pattern++) {
+    std::vector<float> A(Batch * M * K);
+    std::vector<float> B(K * N, 0.0f);
+    std::vector<float> Y(Batch * M * N, 0.0f);
+    for (int64_t i = 0; i < Batch * M * K; i++) {
+      A[i] = static_cast<float>((i % 7) - 3) * 0.25f;
+    }
+    for (int64_t k = 0; k < K; k++) {
+      for (int64_t n = 0; n < N; n++) {
+        const bool nonzero = pattern == 0 ? (k % 4 == 1) : ((k + n) % 8 == 0);
+        if (nonzero) {
+          B[k * N + n] = static_cast<float>(((k + 3 * n) % 5) - 2) * 0.5f;
+        }
+      }
+    }
+    for (int64_t m = 0; m < Batch * M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        for (int64_t k = 0; k < K; k++) {
+          Y[m * N + n] += A[m * K + k] * B[k * N + n];
+        }
+      }
+    }
+
+    OpTester test("MatMul", 13);
+    test.AddInput<float>("A", {Batch, M, K}, A);
+    test.AddInput<float>("B", {K, N}, B, true);
+    test.AddOutput<float>("Y", {Batch, M, N}, Y);
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
 
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(MathOpTest, MatMul_BFloat16) {
@@ -861,5 +861,48 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// long rows and a small batch, as the logits of a vocabulary when decoding. the rows are split across threads when
+// the session has more than one, the result must match the single threaded selection.
+template <typename T>
+static void TestSplitRow(int64_t k, int64_t n, int64_t batch_size, int64_t largest) {
+  std::vector<T> input_vals(n * batch_size);
+  for (int64_t i = 0; i < n * batch_size; ++i) {
+    // shuffled values of a row, 7919 being prime with the batch sizes used below
+    input_vals[i] = static_cast<T>((i * 7919) % batch_size) * static_cast<T>(0.25);
+  }
+
+  std::vector<int64_t> input_dimensions = {n, batch_size};
+
+  std::vector<T> expected_vals(n * k);
+  std::vector<int64_t> expected_indices(n * k);
+  std::vector<int64_t> expected_dimensions = {n, k};
+
+  for (int64_t i = 0; i < n; ++i) {
+    std::vector<int64_t> order(batch_size);
+    std::iota(order.begin(), order.end(), static_cast<int64_t>(0));
+    const T* row = input_vals.data() + i * batch_size;
+    std::sort(order.begin(), order.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+
+    for (int64_t j = 0; j < k; ++j) {
+      expected_vals[i * k + j] = row[order[j]];
+      expected_indices[i * k + j] = order[j];
+    }
+  }
+
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, -1,
+          largest);
+}
+
+TEST(TopKOperator, SplitRowThreaded) {
+  for (int64_t largest : {1, 0}) {
+    TestSplitRow<float>(1, 1, 50257, largest);
+    TestSplitRow<float>(10, 1, 50257, largest);
+    TestSplitRow<float>(5, 3, 32000, largest);
+    TestSplitRow<double>(10, 1, 50257, largest);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -676,5 +678,60 @@ TEST(MLOpTest, TreeRegressorSingleTargetSum_as_tensor_precision) {
   GenTreeAndRunTest1_as_tensor_precision(3);
 }
 
+void GenTreeAndRunTestMissingTracks(int64_t n_obs) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  // missing values of feature 0 go to the true branch, missing values of feature 1 to the false branch.
+  std::vector<int64_t> lefts = {1, 3, 0, 0, 0};
+  std::vector<int64_t> rights = {2, 4, 0, 0, 0};
+  std::vector<int64_t> treeids = {0, 0, 0, 0, 0};
+  std::vector<int64_t> nodeids = {0, 1, 2, 3, 4};
+  std::vector<int64_t> featureids = {0, 1, 0, 0, 0};
+  std::vector<float> thresholds = {0.5f, 0.5f, 0.f, 0.f, 0.f};
+  std::vector<std::string> modes = {"BRANCH_LEQ", "BRANCH_LEQ", "LEAF", "LEAF", "LEAF"};
+  std::vector<int64_t> missing_tracks_true = {1, 0, 0, 0, 0};
+
+  std::vector<int64_t> target_treeids = {0, 0, 0};
+  std::vector<int64_t> target_nodeids = {2, 3, 4};
+  std::vector<int64_t> target_classids = {0, 0, 0};
+  std::vector<float> target_weights = {3.f, 1.f, 2.f};
+
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", missing_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_classids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> X = {0.f, 0.f, nan, 1.f, 1.f, 0.f, 0.f, nan};
+  std::vector<float> results = {1.f, 2.f, 3.f, 2.f};
+
+  ASSERT_TRUE(n_obs % 4 == 0);
+  std::vector<float> xn;
+  std::vector<float> yn;
+  for (int64_t i = 0; i < n_obs; i += 4) {
+    xn.insert(xn.end(), X.begin(), X.end());
+    yn.insert(yn.end(), results.begin(), results.end());
+  }
+  test.AddInput<float>("X", {n_obs, 2}, xn);
+  test.AddOutput<float>("Y", {n_obs, 1}, yn);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorMissingTracksBatch) {
+  // The batches are large enough to use the flattened trees.
+  GenTreeAndRunTestMissingTracks(4);
+  GenTreeAndRunTestMissingTracks(16);   // section C
+  GenTreeAndRunTestMissingTracks(200);  // section E
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -217,6 +217,43 @@ TEST(ConvTransposeTest, ConvTranspose_2D_Bias_2) {
   TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
 }
 
+TEST(ConvTransposeTest, ConvTranspose_2D_Upsample_Stride2) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{4, 4},        // kernel_shape
+      vector<int64_t>{0, 0},        // output_padding
+      {},                           // output_shape
+      vector<int64_t>{1, 1, 1, 1},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      "NOTSET"                      // auto_pad
+  };
+  vector<float> X = {-2.0f, 0.0f, 2.0f, -1.0f, 1.0f, -2.0f, 0.0f, 2.0f, -1.0f,
+                     1.0f, -2.0f, 0.0f, 2.0f, -1.0f, 1.0f, -2.0f, 0.0f, 2.0f};
+  vector<int64_t> X_shape = {1, 2, 3, 3};
+  vector<float> W(2 * 2 * 4 * 4);
+  for (size_t i = 0; i < W.size(); i++) {
+    W[i] = static_cast<float>(static_cast<int>(i * 3 % 7) - 3) / 2.0f;
+  }
+  vector<int64_t> W_shape = {2, 2, 4, 4};
+  vector<float> B = {0.5f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {1, 2, 6, 6};
+  auto expected_vals = {4.0f, -1.0f, 1.5f, 3.5f, -3.5f, 1.5f,
+                        -4.0f, -1.0f, -4.0f, 8.5f, 3.5f, -3.0f,
+                        3.0f, 1.0f, 1.5f, -4.5f, 4.5f, -4.0f,
+                        2.0f, -5.0f, 3.5f, 7.0f, -4.0f, -0.5f,
+                        -4.0f, 4.5f, -4.5f, 1.5f, 1.0f, 3.0f,
+                        -0.5f, 3.5f, 3.5f, -2.5f, 2.0f, -2.0f,
+                        3.0f, -1.0f, -5.5f, 2.0f, -5.0f, -1.0f,
+                        -5.5f, 5.5f, 2.5f, -6.5f, -1.0f, -5.0f,
+                        1.5f, -6.5f, -2.5f, -5.5f, 7.0f, 1.0f,
+                        1.0f, 7.0f, -5.5f, -2.5f, -6.5f, 1.5f,
+                        -5.0f, -1.0f, -6.5f, 2.5f, 5.5f, -5.5f,
+                        -1.0f, -5.0f, 2.0f, -5.5f, -1.0f, 3.0f};
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 TEST(ConvTransposeTest, ConvTranspose_2D_OutputShape_1) {
   ConvTransposeOpAttributes attrs = {
       vector<int64_t>{3, 3},        // kernel_shape
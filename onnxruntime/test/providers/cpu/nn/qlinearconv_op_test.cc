@@ -276,6 +276,7 @@ class QLinearConvOpTester {
   std::default_random_engine generator_{1234};
   QuantizedTensor<ActType> X_;
   QuantizedTensor<FilterType> W_;
+  std::vector<FilterType> W_zero_points_;
   std::vector<int32_t> B_;
   std::vector<int64_t> pads_;
   std::vector<int64_t> strides_;
@@ -401,7 +402,6 @@ class QLinearConvOpTester {
     const int64_t kernel_size = std::accumulate(
         kernel_shape, kernel_shape + kernel_rank, 1LL, std::multiplies<int64_t>());
     const int32_t X_zero_point = X_.zero_point_;
-    const int32_t W_zero_point = W_.zero_point_;
 
     const ActType* Xdata = X_.data_.data();
     ActType* Ydata = Y_data.data();
@@ -418,6 +418,7 @@ class QLinearConvOpTester {
           int32_t bias = B_.empty() ? 0 : B_[channel_index];
           float weight_scale = W_.scale_[(W_.scale_.size() == 1) ? 0 : channel_index];
           float requantize_scale = (X_.scale_[0] * weight_scale) / output_scale_;
+          const int32_t W_zero_point = W_zero_points_.empty() ? W_.zero_point_ : W_zero_points_[channel_index];
 
           std::vector<int64_t> d_output(kernel_rank, 0);
           std::vector<int64_t> d_kernel(kernel_rank, 0);
@@ -471,7 +472,12 @@ class QLinearConvOpTester {
     const std::vector<int64_t> W_scale_shape{static_cast<int64_t>(W_.scale_.size())};
     test.AddInput<FilterType>("w", W_.shape_, W_.data_, all_input_initializer_except_x);
     test.AddInput<float>("w_scale", W_scale_shape, W_.scale_, all_input_initializer_except_x);
-    test.AddInput<FilterType>("w_zero_point", {}, {W_.zero_point_}, all_input_initializer_except_x);
+    if (W_zero_points_.empty()) {
+      test.AddInput<FilterType>("w_zero_point", {}, {W_.zero_point_}, all_input_initializer_except_x);
+    } else {
+      const std::vector<int64_t> W_zero_point_shape{static_cast<int64_t>(W_zero_points_.size())};
+      test.AddInput<FilterType>("w_zero_point", W_zero_point_shape, W_zero_points_, all_input_initializer_except_x);
+    }
 
     test.AddInput<float>("y_scale", {}, {output_scale_}, all_input_initializer_except_x);
     test.AddInput<ActType>("y_zero_point", {}, {output_zero_point_}, all_input_initializer_except_x);
@@ -533,10 +539,19 @@ class QLinearConvOpTester {
     }
   }
 
+  void GenerateRandomWeights(const std::vector<int64_t>& shape, float scale, FilterType zero_point,
+                             int32_t min_value, int32_t max_value) {
+    GenerateRandom(W_, shape, scale, zero_point, min_value, max_value);
+  }
+
   void SetWeightScales(const std::vector<float>& scales) {
     W_.scale_ = scales;
   }
 
+  void SetWeightZeroPoints(const std::vector<FilterType>& zero_points) {
+    W_zero_points_ = zero_points;
+  }
+
   void GenerateRandomBias() {
     ORT_ENFORCE(W_.shape_.size() >= 1);
     const size_t output_channels = static_cast<size_t>(W_.shape_[0]);
@@ -570,6 +585,10 @@ class QLinearConvOpTester {
 
   void Run() {
     for (bool all_input_initializer_except_x : std::initializer_list<bool>{false, true}) {
+      // Distinct per-channel filter zero points are only supported for a constant filter.
+      if (!W_zero_points_.empty() && !all_input_initializer_except_x) {
+        continue;
+      }
       Run(all_input_initializer_except_x);
     }
   }
@@ -940,6 +959,43 @@ TEST(QLinearConvTest, Conv2D_U8S8_Depthwise_Kernelsize_PerChannel) {
   TestQLinearConv2dDepthwiseKernelsizePerChannel<uint8_t, int8_t>();
 }
 
+TEST(QLinearConvTest, Conv2D_U8U8_Depthwise_Kernelsize_PerChannel) {
+  // Unsigned weights with per-channel zero points, shifted into int8_t for the symmetric depthwise kernels.
+  for (int64_t channels : std::initializer_list<int64_t>{32, 96}) {
+    for (int64_t kernel : std::initializer_list<int64_t>{3, 5, 7}) {
+      if (MlasConvSymPackWSize(static_cast<size_t>(channels), 1, 1, static_cast<size_t>(kernel * kernel), false) == 0) {
+        continue;  // no symmetric depthwise kernel on this platform
+      }
+      QLinearConvOpTester<uint8_t, uint8_t> test;
+      test.GenerateRandomInput({1, channels, 29, 29}, .03f, 12);
+      test.GenerateRandomWeights({channels, 1, kernel, kernel}, .10f, 0, 40, 200);
+      std::vector<float> weight_scales;
+      std::vector<uint8_t> weight_zero_points;
+      for (int64_t i = 0; i < channels; i++) {
+        weight_scales.push_back(.10f + static_cast<float>(i) * .002f);
+        weight_zero_points.push_back(static_cast<uint8_t>(100 + i % 40));
+      }
+      test.SetWeightScales(weight_scales);
+      test.SetWeightZeroPoints(weight_zero_points);
+      test.GenerateRandomBias();
+      test.SetPads({1, 1, 1, 1});
+      test.SetGroups(channels);
+      test.SetOutputScaleAndZeroPoint(.76f, 88);
+      test.Run();
+    }
+  }
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_Asymmetric_M64_C64) {
+  QLinearConvOpTester<uint8_t, int8_t> test;
+  test.GenerateRandomInput({1, 64, 15, 11}, .05f, 4);
+  test.GenerateRandomWeights({64, 64, 3, 3}, .125f, 7);
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetOutputScaleAndZeroPoint(.55f, 54);
+  test.Run();
+}
+
 TEST(QLinearConvTest, Conv2D_U8U8_Depthwise) {
   for (int64_t channels : std::initializer_list<int64_t>{3, 8, 13, 24, 31, 64}) {
     QLinearConvOpTester<uint8_t, uint8_t> test;
@@ -481,6 +481,32 @@ TEST(TfIdfVectorizerTest, String_TF_BatchUniAndBigrams_Skip5) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, String_TF_BatchUniBiAndTrigrams_Skip0) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=0, Min=1, Max=3, weights empty, string
+  // the bigram (a, b) is also the prefix of the trigram (a, b, c)
+  InitTestAttr(test, "TF", 1, 3, 0,
+               {0, 2, 6},
+               {0, 1, 2, 3, 4},  //5 output indexes
+               {},
+               {},
+               {"a", "b",            //1-grams
+                "a", "b", "b", "c",  //bi-grams
+                "a", "b", "c"});     //tri-grams
+
+  std::vector<int64_t> dims{2, 4};
+  std::vector<std::string> input{"a", "b", "c", "a",
+                                 "b", "c", "a", "b"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> out_dims{2, 5};
+  std::vector<float> output = {2, 1, 1, 1, 1,
+                               1, 2, 1, 1, 0};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(TfIdfVectorizerTest, Int32_IDF_onlyBigrams_Skip5) {
   OpTester test("TfIdfVectorizer", opset_ver);
   // s=5, Min=Max=2, weights empty, int32
@@ -383,5 +383,59 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  // 40 disjoint boxes along x, each followed later by a copy shifted by 0.1 which it suppresses and which suppresses
+  // it. more than 16 boxes are selected per class, and the classes of all the batches have different scores.
+  constexpr int64_t num_batches = 3;
+  constexpr int64_t num_classes = 4;
+  constexpr int64_t num_unique_boxes = 40;
+  constexpr int64_t num_boxes = 2 * num_unique_boxes;
+  constexpr int64_t max_output_boxes_per_class = 30;
+
+  std::vector<float> boxes;
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      const float x = 2.0f * (box_index % num_unique_boxes) + (box_index < num_unique_boxes ? 0.0f : 0.1f);
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> expected_indices;
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    for (int64_t class_index = 0; class_index < num_classes; ++class_index) {
+      // a permutation of the boxes, different for each class
+      std::vector<int64_t> boxes_by_score(num_boxes);
+      for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+        const int64_t rank = (box_index * 37 + (batch_index * num_classes + class_index) * 11) % num_boxes;
+        scores.push_back(static_cast<float>(num_boxes - rank) / num_boxes);
+        boxes_by_score[rank] = box_index;
+      }
+
+      std::vector<bool> selected(num_unique_boxes, false);
+      int64_t num_selected = 0;
+      for (int64_t box_index : boxes_by_score) {
+        if (num_selected == max_output_boxes_per_class) {
+          break;
+        }
+        if (!selected[box_index % num_unique_boxes]) {
+          selected[box_index % num_unique_boxes] = true;
+          expected_indices.insert(expected_indices.end(), {batch_index, class_index, box_index});
+          ++num_selected;
+        }
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output_boxes_per_class});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {static_cast<int64_t>(expected_indices.size() / 3), 3}, expected_indices);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
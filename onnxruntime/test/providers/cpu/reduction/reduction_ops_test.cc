@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <random>
 #include <cmath>
 #include <type_traits>
@@ -4504,5 +4505,203 @@ TEST(ReductionOpTest, ReduceSum_RKRK_keepdims) {
   test.Run();
 }
 
+// Checks the float reductions vectorized with MLAS against a reference computed in double.
+static void TestVectorizedReduce(const char* op, const std::vector<int64_t>& shape, const std::vector<int64_t>& axes) {
+  RandomValueGenerator random{};
+  const std::vector<float> data = random.Uniform<float>(shape, -2.0f, 2.0f);
+
+  // Groups the values by output element.
+  std::vector<int64_t> output_shape;
+  int64_t output_size = 1;
+  for (size_t d = 0; d < shape.size(); ++d) {
+    if (std::find(axes.begin(), axes.end(), static_cast<int64_t>(d)) == axes.end()) {
+      output_shape.push_back(shape[d]);
+      output_size *= shape[d];
+    }
+  }
+  std::vector<std::vector<double>> groups(static_cast<size_t>(output_size));
+  std::vector<int64_t> index(shape.size(), 0);
+  for (float value : data) {
+    int64_t output_index = 0;
+    for (size_t d = 0; d < shape.size(); ++d) {
+      if (std::find(axes.begin(), axes.end(), static_cast<int64_t>(d)) == axes.end()) {
+        output_index = output_index * shape[d] + index[d];
+      }
+    }
+    groups[static_cast<size_t>(output_index)].push_back(value);
+    for (size_t d = shape.size(); d-- > 0;) {
+      if (++index[d] < shape[d]) {
+        break;
+      }
+      index[d] = 0;
+    }
+  }
+
+  const std::string op_type(op);
+  std::vector<float> expected;
+  for (const auto& values : groups) {
+    double sum = 0, sum_square = 0;
+    double maximum = values[0], minimum = values[0];
+    for (double v : values) {
+      sum += v;
+      sum_square += v * v;
+      maximum = std::max(maximum, v);
+      minimum = std::min(minimum, v);
+    }
+    double sum_exp = 0;
+    for (double v : values) {
+      sum_exp += std::exp(v - maximum);
+    }
+
+    double result = sum;
+    if (op_type == "ReduceMean") {
+      result = sum / static_cast<double>(values.size());
+    } else if (op_type == "ReduceMax") {
+      result = maximum;
+    } else if (op_type == "ReduceMin") {
+      result = minimum;
+    } else if (op_type == "ReduceSumSquare") {
+      result = sum_square;
+    } else if (op_type == "ReduceL2") {
+      result = std::sqrt(sum_square);
+    } else if (op_type == "ReduceLogSumExp") {
+      result = maximum + std::log(sum_exp);
+    }
+    expected.push_back(static_cast<float>(result));
+  }
+
+  OpTester test(op);
+  test.AddAttribute("axes", axes);
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", shape, data);
+  test.AddOutput<float>("reduced", output_shape, expected);
+  test.SetOutputRelErr("reduced", 1e-4f);
+  test.SetOutputAbsErr("reduced", 1e-3f);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceFloat_Vectorized) {
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> cases = {
+      {{3, 1000}, {1}},         // KR
+      {{2, 70000}, {1}},        // KR, fewer rows than threads
+      {{8, 20, 30}, {1, 2}},    // KR over two axes
+      {{3000, 40}, {0}},        // RK
+      {{20000, 3}, {0}},        // RK, few columns
+      {{1, 512, 768}, {1}},     // KRK with a single outer element
+      {{4, 300, 37}, {1}},      // KRK
+  };
+
+  for (const char* op : {"ReduceSum", "ReduceMean", "ReduceMax", "ReduceMin",
+                         "ReduceSumSquare", "ReduceL2", "ReduceLogSumExp"}) {
+    for (const auto& c : cases) {
+      SCOPED_TRACE(MakeString(op, " shape ", TensorShape(c.first), " axes ", TensorShape(c.second)));
+      TestVectorizedReduce(op, c.first, c.second);
+    }
+  }
+}
+
+TEST(ReductionOpTest, ReducePlanCache) {
+  ReducePlanCache cache;
+  FastReduceKind fast_kind;
+  TensorShapeVector fast_shape, fast_output_shape, fast_axes;
+  TensorShapeVector expected_fast_shape, expected_fast_output_shape, expected_fast_axes;
+
+  for (int run = 0; run < 2; ++run) {
+    fast_kind = cache.GetFastReduceShapes(std::vector<int64_t>{10, 11, 12}, std::vector<int64_t>{1},
+                                          fast_shape, fast_output_shape, fast_axes, true, false);
+    expected_fast_shape = {10, 11, 12};
+    expected_fast_output_shape = {10, 1, 12};
+    expected_fast_axes = {1};
+    ASSERT_EQ(fast_kind, FastReduceKind::kKRK);
+    ASSERT_EQ(fast_shape, expected_fast_shape);
+    ASSERT_EQ(fast_output_shape, expected_fast_output_shape);
+    ASSERT_EQ(fast_axes, expected_fast_axes);
+  }
+
+  // a new shape replaces the cached plan
+  fast_kind = cache.GetFastReduceShapes(std::vector<int64_t>{10, 11, 12}, std::vector<int64_t>{1, 2},
+                                        fast_shape, fast_output_shape, fast_axes, false, false);
+  expected_fast_shape = {10, 132};
+  expected_fast_output_shape = {10};
+  expected_fast_axes = {1};
+  ASSERT_EQ(fast_kind, FastReduceKind::kKR);
+  ASSERT_EQ(fast_shape, expected_fast_shape);
+  ASSERT_EQ(fast_output_shape, expected_fast_output_shape);
+  ASSERT_EQ(fast_axes, expected_fast_axes);
+
+  // the indices of the generic loops are computed once per shape
+  const TensorShape shape({2, 3, 4, 5});
+  const std::vector<int64_t> axes{0, 2};
+  auto results = cache.GetPrepareForReduceResults(shape, axes);
+  ASSERT_EQ(results, cache.GetPrepareForReduceResults(shape, axes));
+  ASSERT_EQ(results->last_loop_red_size, 4);
+  ASSERT_EQ(results->last_loop_size, 5);
+  ASSERT_EQ(results->projected_index.size(), 2U);
+  ASSERT_NE(results, cache.GetPrepareForReduceResults(TensorShape({2, 3, 4, 6}), axes));
+}
+
+// Reductions over a contiguous range of axes in the middle or at the end of the shape, with reduced sizes larger
+// than a block of threads.
+TEST(ReductionOpTest, ReduceContiguousAxes_LargeReducedSize) {
+  struct TestCase {
+    std::vector<int64_t> dims;
+    std::vector<int64_t> axes;
+  };
+  const std::vector<TestCase> test_cases{
+      {{3, 70, 5}, {1}},
+      {{2, 3, 300}, {2}},
+      {{4, 17, 33, 3}, {1, 2}},
+  };
+
+  for (const auto& test_case : test_cases) {
+    const int64_t size = TensorShape(test_case.dims).Size();
+    const int64_t outer = TensorShape(test_case.dims).SizeToDimension(test_case.axes.front());
+    const int64_t inner = TensorShape(test_case.dims).SizeFromDimension(test_case.axes.back() + 1);
+    const int64_t reduce = size / (outer * inner);
+
+    std::default_random_engine generator(static_cast<unsigned>(size));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+    std::vector<float> data(static_cast<size_t>(size));
+    std::generate(data.begin(), data.end(), [&]() { return distribution(generator); });
+
+    std::vector<int64_t> output_dims(test_case.dims);
+    for (const auto axis : test_case.axes) {
+      output_dims[static_cast<size_t>(axis)] = 1;
+    }
+
+    for (const std::string op : {"ReduceMax", "ReduceMin", "ReduceL1", "ReduceL2", "ReduceMean", "ReduceSumSquare"}) {
+      std::vector<float> expected(static_cast<size_t>(outer * inner));
+      for (int64_t o = 0; o < outer; ++o) {
+        for (int64_t i = 0; i < inner; ++i) {
+          double value = op == "ReduceMax" ? -1e9 : (op == "ReduceMin" ? 1e9 : 0.0);
+          for (int64_t r = 0; r < reduce; ++r) {
+            const double x = data[static_cast<size_t>((o * reduce + r) * inner + i)];
+            if (op == "ReduceMax") {
+              value = std::max(value, x);
+            } else if (op == "ReduceMin") {
+              value = std::min(value, x);
+            } else if (op == "ReduceL1") {
+              value += std::fabs(x);
+            } else if (op == "ReduceMean") {
+              value += x / reduce;
+            } else {
+              value += x * x;
+            }
+          }
+          expected[static_cast<size_t>(o * inner + i)] =
+              static_cast<float>(op == "ReduceL2" ? std::sqrt(value) : value);
+        }
+      }
+
+      OpTester test(op.c_str());
+      test.AddAttribute("axes", test_case.axes);
+      test.AddAttribute("keepdims", static_cast<int64_t>(1));
+      test.AddInput<float>("data", test_case.dims, data);
+      test.AddOutput<float>("reduced", output_dims, expected, false, 1e-4f, 1e-4f);
+      test.Run();
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -373,5 +373,36 @@ TEST(GatherElementsOpTest, BigIndices) {
   test1.Run();
 }
 
+TEST(GatherElementsOpTest, MiddleAxis3D) {
+  // indices smaller than the input along the outer axes, with negative indices
+  OpTester test("GatherElements", 13);
+  test.AddAttribute<int64_t>("axis", 1LL);
+  test.AddInput<float>("data", {2, 3, 2},
+                       {0.f, 1.f, 2.f, 3.f, 4.f, 5.f,
+                        6.f, 7.f, 8.f, 9.f, 10.f, 11.f});
+  test.AddInput<int64_t>("indices", {2, 2, 2},
+                         {2, 0, -1, 1,
+                          1, 1, 0, -3});
+  test.AddOutput<float>("output", {2, 2, 2},
+                        {4.f, 1.f, 4.f, 3.f,
+                         8.f, 9.f, 6.f, 7.f});
+  test.Run();
+}
+
+TEST(GatherElementsOpTest, InnermostAxisInt8) {
+  OpTester test("GatherElements", 13);
+  test.AddAttribute<int64_t>("axis", -1LL);
+  test.AddInput<int8_t>("data", {2, 4},
+                        {1, 2, 3, 4,
+                         5, 6, 7, 8});
+  test.AddInput<int32_t>("indices", {2, 3},
+                         {3, -4, 1,
+                          0, 0, -1});
+  test.AddOutput<int8_t>("output", {2, 3},
+                         {4, 1, 2,
+                          5, 5, 8});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -337,5 +337,29 @@ TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
 
 }
 
+TEST(GatherOpTest, Gather_axis0_embedding_rows) {
+  // rows of 64 floats gathered from a table, which are prefetched ahead of the copy
+  constexpr int64_t kNumRows = 100;
+  constexpr int64_t kRowSize = 64;
+  std::vector<float> data(kNumRows * kRowSize);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+
+  std::vector<int64_t> indices{97, 3, 50, -1, 0, 12, 12, 64, 31, 88, -100, 7};
+  std::vector<float> output;
+  for (int64_t index : indices) {
+    const int64_t row = index < 0 ? index + kNumRows : index;
+    output.insert(output.end(), data.begin() + row * kRowSize, data.begin() + (row + 1) * kRowSize);
+  }
+
+  OpTester test("Gather", 13);
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<float>("data", {kNumRows, kRowSize}, data);
+  test.AddInput<int64_t>("indices", {3, 4}, indices);
+  test.AddOutput<float>("output", {3, 4, kRowSize}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -254,6 +254,48 @@ TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_asymmetric) {
   run_test(true);
 }
 
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_asymmetric_NHWC) {
+  // the images of ResizeOpLinearUpSampleTest_4DBilinear_asymmetric as the 2 channels of a NHWC input
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 2.0f, 4.0f, 1.0f};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  constexpr int64_t N = 1, H = 2, W = 2, C = 2;
+  std::vector<float> X = {1.0f, 6.0f, 3.0f, 2.0f,
+                          4.0f, 7.0f, 8.0f, 11.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y_channels[C] = {
+      {1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 3.0f, 3.0f, 3.0f,
+       2.5f, 3.25f, 4.0f, 4.75f, 5.5f, 5.5f, 5.5f, 5.5f,
+       4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 8.0f, 8.0f, 8.0f,
+       4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 8.0f, 8.0f, 8.0f},
+      {6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 2.0f, 2.0f, 2.0f,
+       6.5f, 6.5f, 6.5f, 6.5f, 6.5f, 6.5f, 6.5f, 6.5f,
+       7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 11.0f, 11.0f, 11.0f,
+       7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 11.0f, 11.0f, 11.0f}};
+
+  std::vector<float> Y;
+  for (size_t i = 0; i < Y_channels[0].size(); i++) {
+    for (int64_t c = 0; c < C; c++) {
+      Y.push_back(Y_channels[c][i]);
+    }
+  }
+
+  test.AddOutput<float>("Y", {N, static_cast<int64_t>(H * scales[1]), static_cast<int64_t>(W * scales[2]), C}, Y);
+  // other providers only support the scales of the outermost 2 dimensions being 1
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider,
+                                                        kNnapiExecutionProvider, kCoreMLExecutionProvider,
+                                                        kRocmExecutionProvider, kDmlExecutionProvider,
+                                                        kOpenVINOExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_2DBilinear_align_corners) {
   OpTester test("Resize", 13);
   std::vector<float> roi{};
@@ -947,6 +989,40 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_uint8) {
+  // the interpolated values overshoot around the edges and are saturated
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+
+  constexpr int64_t N = 1, C = 1, H = 4, W = 4;
+  std::vector<uint8_t> X = {
+      0, 0, 255, 255,
+      0, 0, 255, 255,
+      255, 255, 0, 0,
+      255, 255, 0, 0};
+
+  test.AddInput<uint8_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<uint8_t> Y = {0, 0, 0, 58, 197, 255, 255, 255,
+                            0, 0, 0, 53, 202, 255, 255, 255,
+                            0, 0, 0, 43, 212, 255, 255, 255,
+                            58, 53, 43, 89, 166, 212, 202, 197,
+                            197, 202, 212, 166, 89, 43, 53, 58,
+                            255, 255, 255, 212, 43, 0, 0, 0,
+                            255, 255, 255, 202, 53, 0, 0, 0,
+                            255, 255, 255, 197, 58, 0, 0, 0};
+
+  test.AddOutput<uint8_t>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider,
+                                                        kRocmExecutionProvider, kDmlExecutionProvider,
+                                                        kOpenVINOExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   OpTester test("Resize", 13);
   std::vector<float> scales{};
@@ -180,5 +180,24 @@ TEST(ScatterNDOpTest, ScatterND_batched_3tensor_int64) {
   test3.Run();
 }
 
+TEST(ScatterNDOpTest, ScatterND_reduction_add_duplicate_indices) {
+  // many updates of the same slices, which must not be applied concurrently
+  constexpr int64_t kNumRows = 10;
+  constexpr int64_t kNumUpdates = 2000;
+  std::vector<int64_t> indices(kNumUpdates);
+  for (int64_t i = 0; i < kNumUpdates; ++i) {
+    indices[i] = i % kNumRows;
+  }
+
+  OpTester test("ScatterND", 16);
+  test.AddAttribute<std::string>("reduction", "add");
+  test.AddInput<float>("data", {kNumRows, 4}, std::vector<float>(kNumRows * 4, 1.0f));
+  test.AddInput<int64_t>("indices", {kNumUpdates, 1}, indices);
+  test.AddInput<float>("updates", {kNumUpdates, 4}, std::vector<float>(kNumUpdates * 4, 1.0f));
+  test.AddOutput<float>("output", {kNumRows, 4},
+                        std::vector<float>(kNumRows * 4, 1.0f + kNumUpdates / kNumRows));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
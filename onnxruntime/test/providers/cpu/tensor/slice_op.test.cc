@@ -3,6 +3,15 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#ifdef ENABLE_TRAINING
+#include <numeric>
+
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -649,5 +658,53 @@ TEST(SliceTest, EmptyDim) {
                       {0, 6},
                       {});
 }
+
+#ifdef ENABLE_TRAINING
+// Concat accepts strided inputs, so the output of Slice is a view of its input instead of a copy.
+TEST(SliceTest, StridedOutputConsumedByConcat) {
+  Model model("SliceStridedOutput", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  ModelTestBuilder helper(model.MainGraph());
+
+  std::vector<float> input(4 * 6);
+  std::iota(input.begin(), input.end(), 0.f);
+  auto* input_arg = helper.MakeInput<float>({4, 6}, input);
+  auto* other_arg = helper.MakeInput<float>({2, 2}, {100.f, 101.f, 102.f, 103.f});
+  auto* slice_out = helper.MakeIntermediate();
+  auto* output_arg = helper.MakeOutput();
+
+  // rows 3 and 1, columns 1, 3 and 5
+  helper.AddNode("Slice", {input_arg, helper.Make1DInitializer<int64_t>({3, 1}),
+                           helper.Make1DInitializer<int64_t>({-10, 6}), helper.Make1DInitializer<int64_t>({0, 1}),
+                           helper.Make1DInitializer<int64_t>({-2, 2})},
+                 {slice_out});
+  helper.AddNode("Concat", {slice_out, other_arg}, {output_arg}).AddAttribute("axis", int64_t(1));
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(model.MainGraph().Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  SessionOptions so;
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const auto& session_state = session.GetSessionState();
+  int slice_out_index = -1;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx(slice_out->Name(), slice_out_index));
+  EXPECT_EQ(session_state.GetExecutionPlan()->allocation_plan[slice_out_index].alloc_kind, AllocKind::kReuse);
+
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions{}, helper.feeds_, helper.output_names_, &fetches));
+
+  const std::vector<float> expected{19.f, 21.f, 23.f, 100.f, 101.f,
+                                    7.f, 9.f, 11.f, 102.f, 103.f};
+  const auto& output = fetches[0].Get<Tensor>();
+  EXPECT_EQ(output.Shape(), TensorShape({2, 5}));
+  EXPECT_EQ(std::vector<float>(output.Data<float>(), output.Data<float>() + output.Shape().Size()), expected);
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
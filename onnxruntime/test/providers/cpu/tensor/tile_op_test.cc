@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -165,6 +167,49 @@ void RunTestWrapper<bool>() {
                 {4, 2, 3});
 }
 
+// The memcpy paths double the first copies into a block and fill the rest of the output with copies of the block in
+// parallel, so use outputs of several blocks with a partial block at the end.
+TEST(TensorOpTest, TileMemcpyLargeOutput) {
+  auto run_test = [](const std::vector<int64_t>& input_dims, const std::vector<int64_t>& repeats) {
+    std::vector<int64_t> output_dims(input_dims.size());
+    for (size_t axis = 0; axis < input_dims.size(); ++axis) {
+      output_dims[axis] = input_dims[axis] * repeats[axis];
+    }
+
+    std::vector<int32_t> input(TensorShape(input_dims).Size());
+    std::iota(input.begin(), input.end(), 0);
+
+    // the input is tiled along the last two axes, and the output row of an input row is its index modulo the rows.
+    const int64_t rows = input_dims[input_dims.size() - 2];
+    const int64_t columns = input_dims.back();
+    const int64_t output_rows = output_dims[output_dims.size() - 2];
+    const int64_t output_columns = output_dims.back();
+    const int64_t output_batches = TensorShape(output_dims).SizeToDimension(output_dims.size() - 2);
+    const int64_t input_batches = TensorShape(input_dims).SizeToDimension(input_dims.size() - 2);
+    std::vector<int32_t> output;
+    output.reserve(TensorShape(output_dims).Size());
+    for (int64_t b = 0; b < output_batches; ++b) {
+      for (int64_t r = 0; r < output_rows; ++r) {
+        for (int64_t c = 0; c < output_columns; ++c) {
+          output.push_back(input[((b % input_batches) * rows + r % rows) * columns + c % columns]);
+        }
+      }
+    }
+
+    OpTester test("Tile");
+    test.AddInput<int32_t>("input", input_dims, input);
+    test.AddInput<int64_t>("repeats", {static_cast<int64_t>(repeats.size())}, repeats);
+    test.AddOutput<int32_t>("output", output_dims, output);
+    test.Run();
+  };
+
+  // copies of the whole input
+  run_test({1, 7, 33}, {1, 1001, 1});
+  // copies of each batch, and copies of the batches
+  run_test({3, 5, 17}, {1, 2003, 1});
+  run_test({3, 5, 17}, {2, 1999, 1});
+}
+
 TEST(TensorOpTest, TileFloatType) {
   RunTestWrapper<float>();
 }
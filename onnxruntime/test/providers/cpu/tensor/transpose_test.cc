@@ -595,6 +595,52 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+// Permutations that move the innermost axis and more than one other axis use the blocked transpose.
+template <typename T>
+static void TestBlockedTranspose(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  std::vector<int64_t> output_shape(rank);
+  std::vector<size_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * static_cast<size_t>(input_shape[i]);
+  }
+  for (size_t i = 0; i < rank; ++i) {
+    output_shape[i] = input_shape[perm[i]];
+  }
+
+  const size_t size = input_strides[0] * static_cast<size_t>(input_shape[0]);
+  std::vector<T> input_vals(size);
+  for (size_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i % 127);
+  }
+
+  std::vector<T> expected_vals(size);
+  for (size_t i = 0; i < size; ++i) {
+    size_t remainder = i;
+    size_t offset = 0;
+    for (size_t axis = rank; axis > 0; --axis) {
+      const auto dim = static_cast<size_t>(output_shape[axis - 1]);
+      offset += (remainder % dim) * input_strides[perm[axis - 1]];
+      remainder /= dim;
+    }
+    expected_vals[i] = input_vals[offset];
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", output_shape, expected_vals);
+  test.Run();
+}
+
+TEST(TransposeOpTest, BlockedTranspose) {
+  // tiles are partial in both directions and the axes 1 and 2 are merged
+  TestBlockedTranspose<uint8_t>({3, 20, 5, 70}, {3, 1, 2, 0});
+  TestBlockedTranspose<int16_t>({3, 20, 5, 70}, {3, 1, 2, 0});
+  TestBlockedTranspose<float>({2, 33, 1, 17, 9}, {4, 0, 2, 3, 1});
+  TestBlockedTranspose<int64_t>({2, 33, 1, 17, 9}, {1, 4, 0, 2, 3});
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
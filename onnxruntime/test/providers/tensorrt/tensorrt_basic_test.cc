@@ -9,6 +9,7 @@
 #include "test/util/include/scoped_env_vars.h"
 #include "core/providers/tensorrt/tensorrt_provider_options.h"
 #include "core/providers/tensorrt/tensorrt_execution_provider_utils.h"
+#include <cstdio>
 #include <string>
 #include <thread>
 
@@ -452,12 +453,37 @@ TEST_P(TensorrtExecutionProviderCacheTest, Run) {
       }
     }
   } else if (cache_type.compare("timing") == 0) {
-     // add test code here
+
+    /* Following code block tests the functionality of timing cache of ORT TRT, including:
+     * - timing cache serialization when the engine is built
+     * - one timing cache per GPU, shared by the engines
+     *
+     */
+
+    params.trt_timing_cache_enable = 1;
+    std::unique_ptr<IExecutionProvider> execution_provider = TensorrtExecutionProviderWithOptions(&params);
+    EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+    auto status = session_object.Load(model_name);
+    ASSERT_TRUE(status.IsOK());
+    status = session_object.Initialize();
+    ASSERT_TRUE(status.IsOK());
+
+    // run inference
+    // TRT engine will be created with the timing cache, which is saved afterwards
+    status = session_object.Run(run_options, feeds, output_names, &fetches);
+    ASSERT_TRUE(status.IsOK());
+    VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
+    ASSERT_TRUE(IsCacheExistedByType("./", ".timing"));
+    ASSERT_EQ(GetCachesByType("./", ".timing").size(), 1);
+
+    // engine cache isn't enabled
+    ASSERT_TRUE(!IsCacheExistedByType("./", ".engine"));
   }
 
   // clean up caches
   RemoveCachesByType("./", ".engine");
   RemoveCachesByType("./", ".profile");
+  RemoveCachesByType("./", ".timing");
 }
 
 /*
@@ -470,13 +496,210 @@ TEST_P(TensorrtExecutionProviderCacheTest, Run) {
  * We have following test parameters:
  * - engine_static: engine cache enabled with non-dynamic input shape
  * - engine_dynamic: engine cache enabled with dynamic input shape
- * - timing_static: will be added
- * - timing_dynamic: will be added
+ * - timing_static: timing cache enabled with non-dynamic input shape
+ * - timing_dynamic: timing cache enabled with dynamic input shape
  */
 INSTANTIATE_TEST_SUITE_P(TensorrtExecutionProviderCacheTests, TensorrtExecutionProviderCacheTest, testing::Values("engine_static",
-                                                                                                                  "engine_dynamic"),
+                                                                                                                  "engine_dynamic",
+                                                                                                                  "timing_static",
+                                                                                                                  "timing_dynamic"),
                                                                                                   [](const ::testing::TestParamInfo<TensorrtExecutionProviderCacheTest::ParamType>& info) {return info.param;});
 
+TEST(TensorrtExecutionProviderTest, ParseProfileShapes) {
+  std::unordered_map<std::string, std::vector<int64_t>> shape_map;
+  ASSERT_TRUE(ParseProfileShapes("input_ids:1x128,scope:mask:4", shape_map));
+  ASSERT_EQ(shape_map.size(), 2);
+  ASSERT_EQ(shape_map["input_ids"], std::vector<int64_t>({1, 128}));
+  ASSERT_EQ(shape_map["scope:mask"], std::vector<int64_t>({4}));
+
+  ASSERT_TRUE(ParseProfileShapes("", shape_map));
+  ASSERT_TRUE(shape_map.empty());
+
+  ASSERT_FALSE(ParseProfileShapes("input_ids", shape_map));
+  ASSERT_FALSE(ParseProfileShapes("input_ids:1x", shape_map));
+  ASSERT_FALSE(ParseProfileShapes("input_ids:1x-1", shape_map));
+}
+
+TEST(TensorrtExecutionProviderTest, DeclaredProfileShapes) {
+  std::string model_name = "trt_execution_provider_declared_profile_test.onnx";
+  CreateBaseModel(model_name, "declaredprofiletest", {1, -1, -1});
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderDeclaredProfileTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  InferenceSession session_object{so, GetEnvironment()};
+  auto allocator_manager = session_object.GetAllocatorManager();
+  auto cuda_provider = DefaultCudaExecutionProvider();
+  cuda_provider->RegisterAllocator(allocator_manager);
+  auto cpu_allocator = cuda_provider->GetAllocator(0, OrtMemTypeCPU);
+
+  OrtTensorRTProviderOptionsV2 params{
+      0,
+      0,
+      nullptr,
+      1000,
+      1,
+      1 << 30,
+      0,
+      0,
+      nullptr,
+      0,
+      0,
+      0,
+      0,
+      0,
+      nullptr,
+      0,
+      nullptr,
+      0};
+  params.trt_engine_cache_enable = 1;
+  params.trt_profile_min_shapes = "X:1x1x1,Y:1x1x1,Z:1x1x1";
+  params.trt_profile_max_shapes = "X:1x3x6,Y:1x3x6,Z:1x3x6";
+  params.trt_profile_opt_shapes = "X:1x3x2,Y:1x3x2,Z:1x3x2";
+  std::unique_ptr<IExecutionProvider> execution_provider = TensorrtExecutionProviderWithOptions(&params);
+  EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+  ASSERT_TRUE(session_object.Load(model_name).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // the engine is built with the declared profile before the first run
+  ASSERT_TRUE(IsCacheExistedByType("./", ".engine"));
+  auto check_profile = [](){
+    auto profile_files = GetCachesByType("./", ".profile");
+    ASSERT_EQ(profile_files.size(), 1);
+    std::ifstream profile_file(profile_files[0], std::ios::binary | std::ios::in);
+    auto shape_ranges = DeserializeProfile(profile_file);
+    ASSERT_EQ(shape_ranges.size(), 3);
+    for (auto it = shape_ranges.cbegin(); it != shape_ranges.cend(); ++it) {
+      auto ranges = it->second;
+      ASSERT_EQ(ranges.size(), 2);
+      ASSERT_EQ(ranges[1], std::make_pair(int64_t{1}, int64_t{3}));
+      ASSERT_EQ(ranges[2], std::make_pair(int64_t{1}, int64_t{6}));
+    }
+  };
+  check_profile();
+
+  // inputs within the declared ranges don't update the engine and profile
+  std::vector<int64_t> dims_mul_x = {1, 3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value_x;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_x);
+  OrtValue ml_value_y;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_y);
+  OrtValue ml_value_z;
+  CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_z);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+  feeds.insert(std::make_pair("Y", ml_value_y));
+  feeds.insert(std::make_pair("Z", ml_value_z));
+  std::vector<std::string> output_names;
+  output_names.push_back("M");
+  std::vector<float> expected_values_mul_m = {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f};
+  RunSession(session_object, run_options, feeds, output_names, dims_mul_x, expected_values_mul_m);
+  check_profile();
+
+  RemoveCachesByType("./", ".engine");
+  RemoveCachesByType("./", ".profile");
+}
+
+TEST(TensorrtExecutionProviderTest, ParseLayerPrecisions) {
+  std::unordered_map<std::string, nvinfer1::DataType> precision_map;
+  ASSERT_TRUE(ParseLayerPrecisions("Conv_12:fp32,scope:MatMul:fp16,Conv_7:int8", precision_map));
+  ASSERT_EQ(precision_map.size(), 3);
+  ASSERT_EQ(precision_map["Conv_12"], nvinfer1::DataType::kFLOAT);
+  ASSERT_EQ(precision_map["scope:MatMul"], nvinfer1::DataType::kHALF);
+  ASSERT_EQ(precision_map["Conv_7"], nvinfer1::DataType::kINT8);
+
+  ASSERT_TRUE(ParseLayerPrecisions("", precision_map));
+  ASSERT_TRUE(precision_map.empty());
+
+  ASSERT_FALSE(ParseLayerPrecisions("Conv_12", precision_map));
+  ASSERT_FALSE(ParseLayerPrecisions("Conv_12:fp64", precision_map));
+  ASSERT_FALSE(ParseLayerPrecisions(":fp16", precision_map));
+}
+
+TEST(TensorrtExecutionProviderTest, Int8CalibrationAndLayerPrecisions) {
+  std::string model_name = "trt_execution_provider_int8_calibration_test.onnx";
+  std::string calibration_table_name = "trt_execution_provider_int8_calibration_test.flatbuffers";
+  std::vector<int64_t> dims_mul_x = {1, 3, 2};
+  CreateBaseModel(model_name, "int8calibrationtest", {1, 3, 2});
+  std::remove(calibration_table_name.c_str());
+
+  auto run_session = [&](OrtTensorRTProviderOptionsV2& params, bool verify_outputs) {
+    SessionOptions so;
+    so.session_logid = "TensorrtExecutionProviderInt8CalibrationTest";
+    RunOptions run_options;
+    run_options.run_tag = so.session_logid;
+    InferenceSession session_object{so, GetEnvironment()};
+    auto allocator_manager = session_object.GetAllocatorManager();
+    auto cuda_provider = DefaultCudaExecutionProvider();
+    cuda_provider->RegisterAllocator(allocator_manager);
+    auto cpu_allocator = cuda_provider->GetAllocator(0, OrtMemTypeCPU);
+
+    std::unique_ptr<IExecutionProvider> execution_provider = TensorrtExecutionProviderWithOptions(&params);
+    EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(execution_provider)).IsOK());
+    ASSERT_TRUE(session_object.Load(model_name).IsOK());
+    ASSERT_TRUE(session_object.Initialize().IsOK());
+
+    std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    OrtValue ml_value_x;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_x);
+    OrtValue ml_value_y;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_y);
+    OrtValue ml_value_z;
+    CreateMLValue<float>(cpu_allocator, dims_mul_x, values_mul_x, &ml_value_z);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value_x));
+    feeds.insert(std::make_pair("Y", ml_value_y));
+    feeds.insert(std::make_pair("Z", ml_value_z));
+    std::vector<std::string> output_names;
+    output_names.push_back("M");
+    std::vector<OrtValue> fetches;
+    ASSERT_TRUE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+    if (verify_outputs) {
+      VerifyOutputs(fetches, dims_mul_x, {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f});
+    }
+  };
+
+  OrtTensorRTProviderOptionsV2 params{
+      0,
+      0,
+      nullptr,
+      1000,
+      1,
+      1 << 30,
+      0,
+      0,
+      nullptr,
+      0,
+      0,
+      0,
+      0,
+      0,
+      nullptr,
+      0,
+      nullptr,
+      0};
+  params.trt_int8_calibration_table_name = calibration_table_name.c_str();
+
+  // the calibration session runs in FP32 and writes the table when it is released
+  params.trt_int8_calibration_enable = 1;
+  run_session(params, true);
+  std::unordered_map<std::string, float> dynamic_range_map;
+  ASSERT_TRUE(ReadDynamicRange(calibration_table_name, false, dynamic_range_map));
+  ASSERT_EQ(dynamic_range_map["X"], 6.0f);
+  ASSERT_EQ(dynamic_range_map["node_1_out_1"], 12.0f);
+  ASSERT_EQ(dynamic_range_map["M"], 18.0f);
+
+  // the table is used by INT8 sessions, with the last node kept in FP32
+  params.trt_int8_calibration_enable = 0;
+  params.trt_int8_enable = 1;
+  params.trt_layer_precisions = "node_2:fp32";
+  run_session(params, false);
+
+  std::remove(calibration_table_name.c_str());
+}
+
 TEST(TensorrtExecutionProviderTest, FunctionTest) {
   onnxruntime::Model model("functiontest", false, DefaultLoggingManager().DefaultLogger());
   auto& graph = model.MainGraph();
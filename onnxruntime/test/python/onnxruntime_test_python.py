@@ -106,6 +106,10 @@ class TestInferenceSession(unittest.TestCase):
             self.assertIn('trt_engine_cache_enable', option)
             self.assertIn('trt_engine_cache_path', option)
             self.assertIn('trt_force_sequential_engine_build', option)
+            self.assertIn('trt_timing_cache_enable', option)
+            self.assertIn('trt_engine_build_async', option)
+            self.assertIn('trt_int8_calibration_enable', option)
+            self.assertIn('trt_layer_precisions', option)
 
             max_partition_iterations = option['trt_max_partition_iterations']
             new_max_partition_iterations = int(max_partition_iterations) + 1
@@ -345,6 +349,76 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelAsync(self):
+        so = onnxrt.SessionOptions()
+        # the run needs a thread of the intra op thread pool
+        so.intra_op_num_threads = 2
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), sess_options=so, providers=available_providers)
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        input_name = sess.get_inputs()[0].name
+        output_name = sess.get_outputs()[0].name
+
+        done = threading.Event()
+        result = {}
+
+        def callback(outputs, user_data, err):
+            user_data["outputs"] = outputs
+            user_data["err"] = err
+            done.set()
+
+        sess.run_async([output_name], {input_name: x}, callback, result)
+        self.assertTrue(done.wait(60))
+        self.assertEqual(result["err"], "")
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, result["outputs"][0], rtol=1e-05, atol=1e-08)
+
+    def testRunModelAsyncFuture(self):
+        so = onnxrt.SessionOptions()
+        so.intra_op_num_threads = 2
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), sess_options=so, providers=available_providers)
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        futures = [sess.run_async(["Y"], {"X": x * i}) for i in range(4)]
+        for i, future in enumerate(futures):
+            output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32) * i * i
+            np.testing.assert_allclose(output_expected, future.result(timeout=60)[0], rtol=1e-05, atol=1e-08)
+
+        future = sess.run_async(["Y"], {"X": np.zeros((3, 3), dtype=np.float32)})
+        with self.assertRaises(RuntimeError):
+            future.result(timeout=60)
+
+    def testRunModelZeroCopyOutputs(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=['CPUExecutionProvider'])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["Y"], {"X": x}, zero_copy_outputs=True)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+        # the array doesn't own its memory, the OrtValue does
+        self.assertFalse(res[0].flags.owndata)
+        self.assertIsNotNone(res[0].base)
+        # the memory outlives the session
+        view = res[0][1:]
+        del sess
+        del res
+        np.testing.assert_allclose(output_expected[1:], view, rtol=1e-05, atol=1e-08)
+
+    def testRunModelPreallocatedOutputs(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=['CPUExecutionProvider'])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        y = np.zeros((3, 2), dtype=np.float32)
+        res = sess.run(["Y"], {"X": x}, outputs=[y])
+        self.assertIs(res[0], y)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+
+        # None lets the session allocate the output
+        res = sess.run(["Y"], {"X": x}, outputs=[None])
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        with self.assertRaises(RuntimeError):
+            sess.run(["Y"], {"X": x}, outputs=[np.zeros((3, 2), dtype=np.float64)])
+        with self.assertRaises(RuntimeError):
+            sess.run(["Y"], {"X": x}, outputs=[np.zeros((2, 3), dtype=np.float32).T])
+
     def testRunModelFromBytes(self):
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -913,6 +987,18 @@ class TestInferenceSession(unittest.TestCase):
             # The constructed OrtValue should still be valid after being used in a session
             self.assertTrue(np.array_equal(ortvalue2.numpy(), numpy_arr_input))
 
+    def testOrtValueDLPack(self):
+        numpy_arr_input = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(numpy_arr_input)
+        if not hasattr(ortvalue._ortvalue, 'to_dlpack'):
+            # build without DLPack support
+            return
+
+        ortvalue_from_dlpack = onnxrt.OrtValue.ortvalue_from_dlpack(ortvalue.to_dlpack())
+        self.assertEqual(ortvalue_from_dlpack.data_ptr(), ortvalue.data_ptr())
+        self.assertEqual(ortvalue_from_dlpack.shape(), [3, 2])
+        self.assertTrue(np.array_equal(ortvalue_from_dlpack.numpy(), numpy_arr_input))
+
     def testOrtValue_ghIssue9799(self):
         if 'CUDAExecutionProvider' in onnxrt.get_available_providers():
             session = onnxrt.InferenceSession(get_name("identity_9799.onnx"),
@@ -0,0 +1,61 @@
+#!/usr/bin/env python
+# coding: utf-8
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+
+import unittest
+import onnx
+import numpy as np
+from onnx import helper, numpy_helper, TensorProto
+from onnxruntime.quantization import quantize_matmul_nbits
+from op_test_utils import check_model_correctness, check_op_type_count
+
+
+class TestOpMatMulNBits(unittest.TestCase):
+    def construct_model_matmul(self, output_model_path, k, n):
+        #      (input)
+        #         |
+        #      MatMul
+        #         |
+        #      (output)
+        np.random.seed(1)
+        input_tensor = helper.make_tensor_value_info('input', TensorProto.FLOAT, [2, 3, k])
+        output_tensor = helper.make_tensor_value_info('output', TensorProto.FLOAT, [2, 3, n])
+        weight = numpy_helper.from_array(np.random.uniform(-0.1, 0.1, (k, n)).astype(np.float32), 'weight')
+        matmul_node = helper.make_node('MatMul', ['input', 'weight'], ['output'], name='MatMulNode')
+
+        graph = helper.make_graph([matmul_node], 'TestOpMatMulNBits_test_model',
+                                  [input_tensor], [output_tensor], initializer=[weight])
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+        model.ir_version = 7  # use stable onnx ir version
+
+        onnx.save(model, output_model_path)
+
+    def quantize_matmul_test(self, bits, block_size, is_symmetric, atol):
+        k, n = 100, 40
+        model_fp32_path = 'matmul_fp32.onnx'
+        model_quant_path = 'matmul_{}bits_{}{}.onnx'.format(bits, block_size, '_symmetric' if is_symmetric else '')
+        self.construct_model_matmul(model_fp32_path, k, n)
+
+        quantize_matmul_nbits(model_fp32_path, model_quant_path, block_size=block_size, bits=bits,
+                              is_symmetric=is_symmetric)
+
+        check_op_type_count(self, model_quant_path, MatMul=0, MatMulNBits=1)
+        inputs = {'input': np.random.uniform(-1.0, 1.0, (2, 3, k)).astype(np.float32)}
+        check_model_correctness(self, model_fp32_path, model_quant_path, inputs, atol=atol)
+
+    def test_quantize_matmul_4bits(self):
+        for block_size in [16, 32, 64]:
+            self.quantize_matmul_test(4, block_size, False, 0.1)
+            self.quantize_matmul_test(4, block_size, True, 0.1)
+
+    def test_quantize_matmul_8bits(self):
+        self.quantize_matmul_test(8, 32, False, 0.01)
+        self.quantize_matmul_test(8, 128, True, 0.01)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -49,6 +49,30 @@ void MyCustomKernel::Compute(OrtKernelContext* context) {
 #endif
 }
 
+int MyCustomOpWithParallelFor::infer_output_shape_calls = 0;
+
+void MyCustomKernelWithParallelFor::Compute(OrtKernelContext* context) {
+  const float* X = ort_.GetTensorData<float>(ort_.KernelContext_GetInput(context, 0));
+  const float* Y = ort_.GetTensorData<float>(ort_.KernelContext_GetInput(context, 1));
+
+  OrtTensorDimensions dimensions(ort_, ort_.KernelContext_GetInput(context, 0));
+  OrtValue* output = ort_.KernelContext_GetOutput(context, 0, dimensions.data(), dimensions.size());
+  float* out = ort_.GetTensorMutableData<float>(output);
+
+  size_t size = 1;
+  for (auto dim : dimensions) {
+    size *= static_cast<size_t>(dim);
+  }
+
+  // one batch per element to check that the batches cover all the iterations exactly once
+  auto add = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      out[i] = X[i] + Y[i];
+    }
+  };
+  ort_.KernelContext_ParallelFor(context, size, size, add);
+}
+
 void MyCustomKernelMultipleDynamicInputs::Compute(OrtKernelContext* context) {
   // Setup inputs
   const OrtValue* input_X = ort_.KernelContext_GetInput(context, 0);
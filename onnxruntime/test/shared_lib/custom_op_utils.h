@@ -55,6 +55,50 @@ struct MyCustomOp : Ort::CustomOpBase<MyCustomOp, MyCustomKernel> {
   void* compute_stream_;
 };
 
+// Adds its inputs on the intra op thread pool
+struct MyCustomKernelWithParallelFor {
+  MyCustomKernelWithParallelFor(Ort::CustomOpApi ort, const OrtKernelInfo* /*info*/) : ort_(ort) {}
+
+  void Compute(OrtKernelContext* context);
+
+ private:
+  Ort::CustomOpApi ort_;
+};
+
+// Same as MyCustomOp on CPU, with the shape of its output inferred from the first input at model load
+struct MyCustomOpWithParallelFor : Ort::CustomOpBase<MyCustomOpWithParallelFor, MyCustomKernelWithParallelFor> {
+  MyCustomOpWithParallelFor() {
+    OrtCustomOp::InferOutputShape = [](const OrtCustomOp* /*op*/, size_t /*output_index*/,
+                                       const OrtTensorTypeAndShapeInfo* const* input_shapes, size_t /*input_count*/,
+                                       OrtTensorTypeAndShapeInfo* output_shape, int* is_inferred) -> OrtStatusPtr {
+      ++infer_output_shape_calls;
+      *is_inferred = 0;
+      if (input_shapes[0] != nullptr) {
+        const OrtApi& api = Ort::GetApi();
+        size_t rank = 0;
+        OrtStatusPtr status = api.GetDimensionsCount(input_shapes[0], &rank);
+        std::vector<int64_t> dims(rank);
+        if (status == nullptr) status = api.GetDimensions(input_shapes[0], dims.data(), rank);
+        if (status == nullptr) status = api.SetDimensions(output_shape, dims.data(), rank);
+        *is_inferred = status == nullptr;
+        return status;
+      }
+      return nullptr;
+    };
+  }
+
+  void* CreateKernel(Ort::CustomOpApi api, const OrtKernelInfo* info) const { return new MyCustomKernelWithParallelFor(api, info); };
+  const char* GetName() const { return "Foo"; };
+
+  size_t GetInputTypeCount() const { return 2; };
+  ONNXTensorElementDataType GetInputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  size_t GetOutputTypeCount() const { return 1; };
+  ONNXTensorElementDataType GetOutputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  static int infer_output_shape_calls;
+};
+
 struct MyCustomKernelMultipleDynamicInputs {
   MyCustomKernelMultipleDynamicInputs(Ort::CustomOpApi ort, const OrtKernelInfo* /*info*/, void* compute_stream)
       : ort_(ort), compute_stream_(compute_stream) {
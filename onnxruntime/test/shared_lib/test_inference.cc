@@ -9,6 +9,7 @@
 #include <atomic>
 #include <mutex>
 #include <algorithm>
+#include <future>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -405,6 +406,26 @@ TEST(CApiTest, custom_op_handler) {
 #endif
 }
 
+TEST(CApiTest, custom_op_parallel_for_and_shape_inference) {
+  std::vector<Input> inputs(1);
+  Input& input = inputs[0];
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f};
+
+  MyCustomOpWithParallelFor custom_op;
+  Ort::CustomOpDomain custom_op_domain("");
+  custom_op_domain.Add(&custom_op);
+
+  MyCustomOpWithParallelFor::infer_output_shape_calls = 0;
+  TestInference<float>(*ort_env, CUSTOM_OP_MODEL_URI, inputs, "Y", expected_dims_y, expected_values_y, 0,
+                       custom_op_domain, nullptr);
+  ASSERT_GT(MyCustomOpWithParallelFor::infer_output_shape_calls, 0);
+}
+
 #ifdef ENABLE_EXTENSION_CUSTOM_OPS
 // test enabled ort-customops negpos
 TEST(CApiTest, test_enable_ort_customops_negpos) {
@@ -927,6 +948,60 @@ TEST(CApiTest, get_allocator_cpu) {
   ASSERT_EQ(1024U, mem_allocation.size());
 }
 
+TEST(CApiTest, run_async) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<float> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> x_dims = {3, 2};
+  Ort::Value input = Ort::Value::CreateTensor<float>(info_cpu, x_values.data(), x_values.size(),
+                                                     x_dims.data(), x_dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value output{nullptr};
+
+  struct CallbackResult {
+    std::promise<void> done;
+    std::vector<float> y_values;
+    OrtErrorCode error_code = ORT_OK;
+  } result;
+
+  auto callback = [](void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+    auto& callback_result = *reinterpret_cast<CallbackResult*>(user_data);
+    if (status != nullptr) {
+      callback_result.error_code = Ort::GetApi().GetErrorCode(status);
+    } else if (num_outputs == 1) {
+      Ort::Unowned<Ort::Value> y{outputs[0]};
+      const float* y_data = y.GetTensorData<float>();
+      callback_result.y_values.assign(y_data, y_data + y.GetTensorTypeAndShapeInfo().GetElementCount());
+    }
+    callback_result.done.set_value();
+  };
+
+  Ort::RunOptions run_options;
+  session.RunAsync(run_options, input_names, &input, 1, output_names, &output, 1, callback, &result);
+  result.done.get_future().wait();
+
+  ASSERT_EQ(result.error_code, ORT_OK);
+  ASSERT_EQ(result.y_values, (std::vector<float>{1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f}));
+  ASSERT_TRUE(output.IsTensor());
+
+  // the run needs a thread of the intra op thread pool
+  Ort::SessionOptions single_thread_options;
+  single_thread_options.SetIntraOpNumThreads(1);
+  Ort::Session single_thread_session(*ort_env, MODEL_URI, single_thread_options);
+  Ort::Value single_thread_output{nullptr};
+  try {
+    single_thread_session.RunAsync(run_options, input_names, &input, 1, output_names, &single_thread_output, 1,
+                                   callback, &result);
+    FAIL() << "RunAsync should have failed without intra op threads";
+  } catch (const Ort::Exception& e) {
+    ASSERT_EQ(e.GetOrtErrorCode(), ORT_INVALID_ARGUMENT);
+  }
+}
+
 #ifdef USE_CUDA
 TEST(CApiTest, get_allocator_cuda) {
   Ort::SessionOptions session_options;
@@ -1223,6 +1298,47 @@ TEST(CApiTest, cuda_graph) {
   binding.ClearBoundInputs();
   binding.ClearBoundOutputs();
 }
+
+TEST(CApiTest, cuda_graph_shape_cache) {
+  const auto& api = Ort::GetApi();
+
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)> rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"enable_cuda_graph"};
+  std::vector<const char*> values{"1"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(
+                  rel_cuda_options.get(), keys.data(), values.data(), 1) == nullptr);
+
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry(kOrtSessionOptionsConfigGraphCaptureShapeCacheSize, "2");
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                  static_cast<OrtSessionOptions*>(session_options),
+                  rel_cuda_options.get()) == nullptr);
+
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+  // The feeds and fetches are in CPU memory with new addresses in every run, the session stages them for the graph.
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  auto run = [&](std::array<float, 3 * 2> x_values) {
+    Ort::Value x = Ort::Value::CreateTensor<float>(info_cpu, x_values.data(), x_values.size(), x_shape.data(),
+                                                   x_shape.size());
+    auto y = session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+    const float* y_values = y[0].GetTensorData<float>();
+    return std::vector<float>(y_values, y_values + y[0].GetTensorTypeAndShapeInfo().GetElementCount());
+  };
+
+  // The first run captures the graph, the following ones replay it.
+  ASSERT_EQ(run({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}),
+            (std::vector<float>{1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f}));
+  ASSERT_EQ(run({10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f}),
+            (std::vector<float>{10.0f, 40.0f, 90.0f, 160.0f, 250.0f, 360.0f}));
+  ASSERT_EQ(run({2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f}),
+            (std::vector<float>{2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f}));
+}
 #endif
 
 TEST(CApiTest, create_tensor) {
@@ -1852,6 +1968,31 @@ TEST(CApiTest, AllocateInitializersFromNonArenaMemory) {
 
 #ifdef USE_CUDA
 
+TEST(CApiTest, OffloadCudaInitializersToHostMemory) {
+  Ort::SessionOptions session_options;
+  Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CUDA(session_options, 0));
+
+  // the sole initializer of the model is read by the CUDA Mul kernel from pinned host memory
+  session_options.AddConfigEntry(kOrtSessionOptionsOffloadInitializersToHostMemory, "1");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+  Ort::Value input = Ort::Value::CreateTensor<float>(info_cpu, values.data(), values.size(), dims.data(), dims.size());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  auto outputs = session.Run(Ort::RunOptions{nullptr}, input_names, &input, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1u);
+
+  std::vector<float> expected_values_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  const float* y = outputs[0].GetTensorData<float>();
+  for (size_t i = 0; i < expected_values_y.size(); ++i) {
+    ASSERT_EQ(y[i], expected_values_y[i]);
+  }
+}
+
 // Usage example showing how to use CreateArenaCfgV2() API to configure the default memory CUDA arena allocator
 TEST(CApiTest, ConfigureCudaArenaAndDemonstrateMemoryArenaShrinkage) {
   const auto& api = Ort::GetApi();
@@ -1977,6 +2118,9 @@ TEST(CApiTest, TestConfigureCUDAProviderOptions) {
   ASSERT_TRUE(s.find("do_copy_in_default_stream=1") != std::string::npos);
   ASSERT_TRUE(s.find("cudnn_conv_use_max_workspace=1") != std::string::npos);
   ASSERT_TRUE(s.find("cudnn_conv1d_pad_to_nc1d") != std::string::npos);
+  ASSERT_TRUE(s.find("enable_pinned_io_staging=0") != std::string::npos);
+  ASSERT_TRUE(s.find("num_compute_streams=1") != std::string::npos);
+  ASSERT_TRUE(s.find("use_mem_pool=0") != std::string::npos);
 
   ASSERT_TRUE(api.AllocatorFree(allocator, (void*)cuda_options_str) == nullptr);
 
@@ -1988,6 +2132,127 @@ TEST(CApiTest, TestConfigureCUDAProviderOptions) {
   Ort::Session session(*ort_env, model_uri.c_str(), session_options);
 }
 
+// Runs the model with pageable CPU inputs/outputs so the copies go through the pinned staging buffers
+TEST(CApiTest, TestCUDAPinnedIoStaging) {
+  const auto& api = Ort::GetApi();
+
+  for (const char* copy_in_default_stream : {"1", "0"}) {
+    OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+    ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+    std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)> rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+
+    std::vector<const char*> keys{"enable_pinned_io_staging", "do_copy_in_default_stream"};
+    std::vector<const char*> values{"1", copy_in_default_stream};
+    ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), keys.size()) == nullptr);
+
+    Ort::SessionOptions session_options;
+    ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(static_cast<OrtSessionOptions*>(session_options), rel_cuda_options.get()) == nullptr);
+    Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::array<int64_t, 2> x_shape{3, 2};
+    const char* input_names[] = {"X"};
+    const char* output_names[] = {"Y"};
+
+    // run a few times so the staging buffers get reused while the source is overwritten in between
+    std::array<float, 6> x_values;
+    for (int run = 0; run < 3; ++run) {
+      for (size_t i = 0; i < x_values.size(); ++i) {
+        x_values[i] = static_cast<float>(i + 1 + run);
+      }
+      Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                     x_shape.data(), x_shape.size());
+      auto outputs = session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+      ASSERT_EQ(outputs.size(), 1u);
+      const float* y = outputs[0].GetTensorData<float>();
+      for (size_t i = 0; i < x_values.size(); ++i) {
+        const float expected = static_cast<float>(i + 1 + run);
+        ASSERT_EQ(y[i], expected * expected);
+      }
+    }
+  }
+}
+
+TEST(CApiTest, TestCUDAMultipleComputeStreams) {
+  const auto& api = Ort::GetApi();
+
+  for (ExecutionMode execution_mode : {ORT_SEQUENTIAL, ORT_PARALLEL}) {
+    OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+    ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+    std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)> rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+
+    std::vector<const char*> keys{"num_compute_streams"};
+    std::vector<const char*> values{"2"};
+    ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), keys.size()) == nullptr);
+
+    Ort::SessionOptions session_options;
+    session_options.SetExecutionMode(execution_mode);
+    ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(static_cast<OrtSessionOptions*>(session_options), rel_cuda_options.get()) == nullptr);
+    Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::array<int64_t, 2> x_shape{3, 2};
+    std::array<float, 6> x_values{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    const char* input_names[] = {"X"};
+    const char* output_names[] = {"Y"};
+    Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                   x_shape.data(), x_shape.size());
+    auto outputs = session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+    ASSERT_EQ(outputs.size(), 1u);
+    const float* y = outputs[0].GetTensorData<float>();
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      ASSERT_EQ(y[i], x_values[i] * x_values[i]);
+    }
+  }
+
+  // the number of streams must be positive
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)> rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"num_compute_streams"};
+  std::vector<const char*> values{"0"};
+  OrtStatus* status = api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), keys.size());
+  ASSERT_TRUE(status != nullptr);
+  api.ReleaseStatus(status);
+}
+
+// Runs two sessions that allocate device memory from the shared CUDA memory pool
+TEST(CApiTest, TestCUDAMemPool) {
+  const auto& api = Ort::GetApi();
+
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)> rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+
+  std::vector<const char*> keys{"use_mem_pool", "mem_pool_release_threshold"};
+  std::vector<const char*> values{"1", "67108864"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), keys.size()) == nullptr);
+
+  Ort::SessionOptions session_options;
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(static_cast<OrtSessionOptions*>(session_options), rel_cuda_options.get()) == nullptr);
+  Ort::Session session_1(*ort_env, MODEL_URI, session_options);
+  Ort::Session session_2(*ort_env, MODEL_URI, session_options);
+
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::array<int64_t, 2> x_shape{3, 2};
+  std::array<float, 6> x_values{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value x = Ort::Value::CreateTensor<float>(memory_info, x_values.data(), x_values.size(),
+                                                 x_shape.data(), x_shape.size());
+
+  for (int run = 0; run < 3; ++run) {
+    for (Ort::Session* session : {&session_1, &session_2}) {
+      auto outputs = session->Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+      ASSERT_EQ(outputs.size(), 1u);
+      const float* y = outputs[0].GetTensorData<float>();
+      for (size_t i = 0; i < x_values.size(); ++i) {
+        ASSERT_EQ(y[i], x_values[i] * x_values[i]);
+      }
+    }
+  }
+}
+
 #endif
 
 namespace TestPerSessionCustomThreadHooks {
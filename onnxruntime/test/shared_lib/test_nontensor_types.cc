@@ -923,4 +923,31 @@ TEST(CApiTest, SparseTensorFillSparseFormatStringsAPI) {
     }
   }
 }
-#endif  // !defined(DISABLE_SPARSE_TENSORS)
\ No newline at end of file
+#endif  // !defined(DISABLE_SPARSE_TENSORS)
+#if defined(ENABLE_DLPACK)
+TEST(CApiTest, DLPackRoundTrip) {
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<float> vals{1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+  std::vector<int64_t> dims{2, 3};
+
+  DLManagedTensor* dlpack_tensor = nullptr;
+  {
+    Ort::Value tensor = Ort::Value::CreateTensor(info, vals.data(), vals.size(), dims.data(), dims.size());
+    dlpack_tensor = tensor.GetDLPack();
+    // the DLPack tensor keeps the data alive after the Value is released
+  }
+  ASSERT_NE(dlpack_tensor, nullptr);
+
+  // the Value takes ownership of the DLPack tensor and calls its deleter
+  Ort::Value round_trip = Ort::Value::CreateTensorFromDLPack(dlpack_tensor);
+  ASSERT_TRUE(round_trip.IsTensor());
+
+  auto type_shape = round_trip.GetTensorTypeAndShapeInfo();
+  ASSERT_EQ(ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, type_shape.GetElementType());
+  ASSERT_EQ(dims, type_shape.GetShape());
+
+  // no copy was made
+  const float* data = round_trip.GetTensorData<float>();
+  ASSERT_EQ(vals.data(), data);
+}
+#endif  // defined(ENABLE_DLPACK)
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -42,33 +43,35 @@ PathString GetCheckpointPropertiesFilePath(const PathString& checkpoint_director
   return ConcatPathComponent<PathChar>(checkpoint_directory, k_properties_file_name);
 }
 
+// The tensors and properties of a checkpoint, with the tensor data in host memory.
+struct CheckpointSnapshot {
+  // The tensor protos without their data, in the order of tensor_data.
+  std::vector<ONNX_NAMESPACE::TensorProto> tensor_protos;
+  std::vector<std::vector<char>> tensor_data;
+  std::unordered_map<std::string, std::string> properties;
+};
+
 Status SaveRuntimeTensor(
-    const std::string& tensor_name,
-    const Tensor& tensor,
     gsl::span<const char> tensor_data,
     const PathString& relative_data_path,
     std::ofstream& data_file,
     ONNX_NAMESPACE::TensorProto& tensor_proto) {
-  ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>(), "tensor.DataType() is std::string");
-
-  VLOGS_DEFAULT(1) << "Saving tensor " << tensor_name;
-
-  ONNX_NAMESPACE::TensorProto saved_tensor_proto{};
-
-  for (const auto dim : tensor.Shape().GetDims()) {
-    saved_tensor_proto.add_dims(dim);
-  }
+  VLOGS_DEFAULT(1) << "Saving tensor " << tensor_proto.name();
 
-  saved_tensor_proto.set_data_type(tensor.GetElementType());
-
-  saved_tensor_proto.set_name(tensor_name);
-
-  auto add_external_data = [&saved_tensor_proto](const std::string& key, const std::string& value) {
-    auto* kvp = saved_tensor_proto.add_external_data();
+  auto add_external_data = [&tensor_proto](const std::string& key, const std::string& value) {
+    auto* kvp = tensor_proto.add_external_data();
     kvp->set_key(key);
     kvp->set_value(value);
   };
 
+  // pad the data file so that the tensor data is aligned
+  constexpr std::streamoff alignment = static_cast<std::streamoff>(k_checkpoint_tensor_data_alignment);
+  const std::streamoff padding = (alignment - static_cast<std::streamoff>(data_file.tellp()) % alignment) % alignment;
+  static const char zeros[k_checkpoint_tensor_data_alignment]{};
+  ORT_RETURN_IF_NOT(
+      data_file.write(zeros, padding),
+      "Failed to write to data file: ", ToUTF8String(relative_data_path));
+
   // TODO is the encoding correct? https://github.com/onnx/onnx/issues/2392
   add_external_data("location", ToUTF8String(relative_data_path));
   const std::streamoff offset = data_file.tellp();
@@ -76,7 +79,7 @@ Status SaveRuntimeTensor(
   const auto length = tensor_data.size_bytes();
   add_external_data("length", std::to_string(length));
 
-  saved_tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
   // TODO need to ensure the data is written in little-endian format...
   // e.g., with endian_utils.h:WriteLittleEndian()
@@ -89,7 +92,6 @@ Status SaveRuntimeTensor(
       data_file.write(tensor_data.data(), length),
       "Failed to write to data file: ", ToUTF8String(relative_data_path));
 
-  tensor_proto = std::move(saved_tensor_proto);
   return Status::OK();
 }
 
@@ -125,35 +127,53 @@ std::vector<std::string> GetOrderedOrtValueNames(const NameMLValMap& name_to_val
   return ordered_names;
 }
 
-Status SaveRuntimeTensors(
-    const PathString& tensors_path,
-    const PathString& tensors_data_path,
+Status SnapshotRuntimeTensors(
     const DataTransferManager& data_transfer_manager,
-    const NameMLValMap& ort_values) {
-  // just write data file basename to TensorProto - this will get overwritten
-  //   with the actual path when loading the checkpoint
-  const PathString tensors_data_relative_path = GetLastComponent(tensors_data_path);
-
+    const NameMLValMap& ort_values,
+    CheckpointSnapshot& snapshot) {
   const std::vector<std::string> ordered_tensor_names = GetOrderedOrtValueNames(ort_values);
-  std::vector<char> tensor_data_buffer{};
   static const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
-  std::vector<ONNX_NAMESPACE::TensorProto> saved_tensor_protos{};
-  saved_tensor_protos.reserve(ordered_tensor_names.size());
-  std::ofstream tensors_data_file{tensors_data_path};
+  snapshot.tensor_protos.reserve(ordered_tensor_names.size());
+  snapshot.tensor_data.reserve(ordered_tensor_names.size());
 
   for (const auto& tensor_name : ordered_tensor_names) {
     const OrtValue& ort_value = ort_values.at(tensor_name);
     ORT_RETURN_IF_NOT(ort_value.IsTensor(), "ort_value.IsTensor() was false");
     const Tensor& tensor = ort_value.Get<Tensor>();
+    ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>(), "tensor.DataType() is std::string");
 
-    tensor_data_buffer.resize(tensor.SizeInBytes());
+    ONNX_NAMESPACE::TensorProto tensor_proto{};
+    for (const auto dim : tensor.Shape().GetDims()) {
+      tensor_proto.add_dims(dim);
+    }
+    tensor_proto.set_data_type(tensor.GetElementType());
+    tensor_proto.set_name(tensor_name);
+
+    std::vector<char> tensor_data(tensor.SizeInBytes());
     ORT_RETURN_IF_ERROR(CopyTensorDataToByteSpan(
-        data_transfer_manager, tensor, cpu_alloc_info, gsl::make_span(tensor_data_buffer)));
+        data_transfer_manager, tensor, cpu_alloc_info, gsl::make_span(tensor_data)));
 
-    saved_tensor_protos.emplace_back();
+    snapshot.tensor_protos.emplace_back(std::move(tensor_proto));
+    snapshot.tensor_data.emplace_back(std::move(tensor_data));
+  }
+
+  return Status::OK();
+}
+
+Status SaveRuntimeTensors(
+    const PathString& tensors_path,
+    const PathString& tensors_data_path,
+    CheckpointSnapshot& snapshot) {
+  // just write data file basename to TensorProto - this will get overwritten
+  //   with the actual path when loading the checkpoint
+  const PathString tensors_data_relative_path = GetLastComponent(tensors_data_path);
+
+  std::vector<ONNX_NAMESPACE::TensorProto>& saved_tensor_protos = snapshot.tensor_protos;
+  std::ofstream tensors_data_file{tensors_data_path, std::ios::binary};
+
+  for (size_t i = 0; i < saved_tensor_protos.size(); ++i) {
     ORT_RETURN_IF_ERROR(SaveRuntimeTensor(
-        tensor_name, tensor, tensor_data_buffer, tensors_data_relative_path,
-        tensors_data_file, saved_tensor_protos.back()));
+        snapshot.tensor_data[i], tensors_data_relative_path, tensors_data_file, saved_tensor_protos[i]));
   }
 
   ORT_RETURN_IF_ERROR(WithOpenFile(
@@ -200,15 +220,10 @@ Status SaveProperties(
   return Status::OK();
 }
 
-}  // namespace
 
-Status SaveModelCheckpoint(
+Status WriteModelCheckpoint(
     const PathString& checkpoint_path,
-    const DataTransferManager& data_transfer_manager,
-    const NameMLValMap& runtime_tensors,
-    const std::unordered_map<std::string, std::string>& properties) {
-  LOGS_DEFAULT(INFO) << "Saving model checkpoint files to " << ToUTF8String(checkpoint_path);
-
+    CheckpointSnapshot& snapshot) {
   LOGS_DEFAULT_IF(Env::Default().FolderExists(checkpoint_path), WARNING)
       << "Checkpoint directory exists - data may be overwritten.";
 
@@ -218,17 +233,71 @@ Status SaveModelCheckpoint(
   ORT_RETURN_IF_ERROR(SaveRuntimeTensors(
       GetCheckpointTensorsFilePath(checkpoint_path),
       GetCheckpointTensorsDataFilePath(checkpoint_path),
-      data_transfer_manager, runtime_tensors));
+      snapshot));
 
   // write properties file
   ORT_RETURN_IF_ERROR(SaveProperties(
-      GetCheckpointPropertiesFilePath(checkpoint_path), properties));
+      GetCheckpointPropertiesFilePath(checkpoint_path), snapshot.properties));
 
   LOGS_DEFAULT(INFO) << "Model checkpoint saved successfully.";
 
   return Status::OK();
 }
 
+}  // namespace
+
+Status SaveModelCheckpoint(
+    const PathString& checkpoint_path,
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties) {
+  LOGS_DEFAULT(INFO) << "Saving model checkpoint files to " << ToUTF8String(checkpoint_path);
+
+  CheckpointSnapshot snapshot{};
+  ORT_RETURN_IF_ERROR(SnapshotRuntimeTensors(data_transfer_manager, runtime_tensors, snapshot));
+  snapshot.properties = properties;
+
+  return WriteModelCheckpoint(checkpoint_path, snapshot);
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+  const Status status = Wait();
+  LOGS_DEFAULT_IF(!status.IsOK(), ERROR) << "Failed to save model checkpoint: " << status.ErrorMessage();
+}
+
+Status AsyncCheckpointWriter::Save(
+    const PathString& checkpoint_path,
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties) {
+  ORT_RETURN_IF_ERROR(Wait());
+
+  LOGS_DEFAULT(INFO) << "Saving model checkpoint files to " << ToUTF8String(checkpoint_path) << " in the background";
+
+  auto snapshot = std::make_shared<CheckpointSnapshot>();
+  ORT_RETURN_IF_ERROR(SnapshotRuntimeTensors(data_transfer_manager, runtime_tensors, *snapshot));
+  snapshot->properties = properties;
+
+  thread_ = std::thread([this, checkpoint_path, snapshot]() {
+    try {
+      status_ = WriteModelCheckpoint(checkpoint_path, *snapshot);
+    } catch (const std::exception& e) {
+      status_ = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+    }
+  });
+
+  return Status::OK();
+}
+
+Status AsyncCheckpointWriter::Wait() {
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  Status status = status_;
+  status_ = Status::OK();
+  return status;
+}
+
 namespace {
 Status UpdateTensorsExternalDataLocations(
     const PathString& external_data_path,
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "core/common/common.h"
 #include "core/common/path_string.h"
 #include "core/common/status.h"
 #include "core/framework/data_transfer_manager.h"
@@ -22,8 +24,14 @@ namespace training {
  *   tensors.pbseq - tensor protobuf messages
  *   tensors.bin - tensor binary data
  *   properties.pbseq - property protobuf messages
+ *
+ * The data of each tensor starts at an offset of tensors.bin aligned to
+ * k_checkpoint_tensor_data_alignment bytes, so that the file can be memory
+ * mapped and the tensors used in place.
  */
 
+constexpr size_t k_checkpoint_tensor_data_alignment = 64;
+
 /**
  * Saves a model checkpoint in the specified location.
  *
@@ -54,5 +62,47 @@ common::Status LoadModelCheckpoint(
     std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
     std::unordered_map<std::string, std::string>& properties);
 
+/**
+ * Saves model checkpoints in the background.
+ *
+ * Save() only copies the tensors to host memory before it returns, so the
+ * caller may keep updating them while the checkpoint files are written by a
+ * separate thread. At most one checkpoint is written at a time.
+ */
+class AsyncCheckpointWriter {
+ public:
+  AsyncCheckpointWriter() = default;
+  ~AsyncCheckpointWriter();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncCheckpointWriter);
+
+  /**
+   * Starts saving a model checkpoint in the specified location, after waiting
+   * for the previous one.
+   *
+   * @param checkpoint_path The checkpoint location.
+   * @param data_transfer_manager The DataTransferManager instance.
+   * @param runtime_tensors The tensors to persist.
+   * @param properties The properties to persist.
+   * @return The status of the previous save and of the copy of the tensors.
+   */
+  common::Status Save(
+      const PathString& checkpoint_path,
+      const DataTransferManager& data_transfer_manager,
+      const NameMLValMap& runtime_tensors,
+      const std::unordered_map<std::string, std::string>& properties);
+
+  /**
+   * Waits for the checkpoint being saved, if any.
+   *
+   * @return The status of the save.
+   */
+  common::Status Wait();
+
+ private:
+  std::thread thread_;
+  common::Status status_;
+};
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -3,6 +3,11 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <numeric>
+
+#include "core/framework/session_options.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -19,7 +24,10 @@ static bool IsNcclAvailable() {
 static Status AddNcclAllReduceForGradients(
     std::vector<ArgDef>& gradient_argdefs,
     std::vector<ArgDef>& input_gradient_argdef,
-    GraphAugmenter::GraphDefs& graph_defs) {
+    GraphAugmenter::GraphDefs& graph_defs,
+    bool compress,
+    const std::string& node_name = "NcclAllReduce",
+    int priority = 0) {
   std::vector<ArgDef> allreduce_outputs(gradient_argdefs.size());
   for (size_t i = 0; i < gradient_argdefs.size(); i++) {
     TypeProto* allreduced_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
@@ -29,18 +37,80 @@ static Status AddNcclAllReduceForGradients(
     allreduce_outputs[i] = ArgDef(gradient_argdefs[i].name + "_AllReduce_Out", allreduced_gradient_type_proto);
   }
 
+  std::vector<ONNX_NAMESPACE::AttributeProto> attributes{
+      ONNX_NAMESPACE::MakeAttribute("group_type", static_cast<int64_t>(WorkerGroupType::DataParallel))};
+  if (compress) {
+    attributes.push_back(ONNX_NAMESPACE::MakeAttribute("compression", static_cast<int64_t>(1)));
+  }
+
   // Add NCCL Allreduce node.
   graph_defs.AddNodeDefs({NodeDef(OpDef{"NcclAllReduce", kMSDomain, 1},
                                   input_gradient_argdef,
                                   allreduce_outputs,
-                                  {ONNX_NAMESPACE::MakeAttribute("group_type",
-                                                                 static_cast<int64_t>(WorkerGroupType::DataParallel))},
-                                  "NcclAllReduce")});
+                                  attributes,
+                                  node_name,
+                                  priority)});
 
   gradient_argdefs = allreduce_outputs;
   return Status::OK();
 }
 
+// Returns the number of elements of the weight, or 0 if its shape is not fully known.
+static int64_t GetElementCount(const ArgDef& weight_argdef) {
+  if (weight_argdef.type_proto == nullptr || !weight_argdef.type_proto->tensor_type().has_shape()) {
+    return 0;
+  }
+  const auto& shape = weight_argdef.type_proto->tensor_type().shape();
+  for (const auto& dim : shape.dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return 0;
+    }
+  }
+  return utils::GetTensorShapeFromTensorShapeProto(shape).Size();
+}
+
+// Splits the gradients into buckets of at least bucket_size bytes once scaled to the all-reduce type, in the order
+// the backward pass produces them. Each bucket holds the indices of its gradients.
+static std::vector<std::vector<size_t>> GetGradientBuckets(const Graph& graph,
+                                                           const std::vector<std::string>& gradient_names,
+                                                           const std::vector<ArgDef>& weight_argdefs,
+                                                           size_t element_size,
+                                                           int64_t bucket_size) {
+  GraphViewer graph_viewer(graph);
+  const auto& node_indices = graph_viewer.GetNodesInTopologicalOrder();
+  std::unordered_map<NodeIndex, size_t> topological_order;
+  for (size_t i = 0; i < node_indices.size(); ++i) {
+    topological_order[node_indices[i]] = i;
+  }
+
+  // Gradients without a producer, e.g. graph inputs, are available from the start.
+  std::vector<size_t> production_order(gradient_names.size(), 0);
+  for (size_t i = 0; i < gradient_names.size(); ++i) {
+    const Node* producer = graph.GetProducerNode(gradient_names[i]);
+    if (producer != nullptr) {
+      production_order[i] = topological_order[producer->Index()];
+    }
+  }
+
+  std::vector<size_t> gradient_order(gradient_names.size());
+  std::iota(gradient_order.begin(), gradient_order.end(), 0);
+  std::stable_sort(gradient_order.begin(), gradient_order.end(),
+                   [&](size_t a, size_t b) { return production_order[a] < production_order[b]; });
+
+  std::vector<std::vector<size_t>> buckets;
+  int64_t current_bucket_bytes = 0;
+  for (size_t i : gradient_order) {
+    if (buckets.empty() || current_bucket_bytes >= bucket_size) {
+      buckets.emplace_back();
+      current_bucket_bytes = 0;
+    }
+    buckets.back().push_back(i);
+    current_bucket_bytes += GetElementCount(weight_argdefs[i]) * static_cast<int64_t>(element_size);
+  }
+
+  return buckets;
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -80,10 +150,46 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
-
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  const auto allreduce_type = opt_graph_config_.AllReduceDataType();
+  if (opt_graph_config_.allreduce_bucket_size > 0) {
+    // Scale and all-reduce each bucket on its own, with a high priority, so that the all-reduce of the gradients
+    // produced first does not wait for the end of the backward pass.
+    const size_t element_size = allreduce_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT ? 4 : 2;
+    const auto buckets = GetGradientBuckets(graph, gradient_names_, weight_argdefs, element_size,
+                                            opt_graph_config_.allreduce_bucket_size);
+    const int priority = static_cast<int>(ExecutionPriority::LOCAL_HIGH);
+    std::vector<ArgDef> allreduced_gradient_argdefs(gradient_argdefs.size());
+    for (size_t bucket_index = 0; bucket_index < buckets.size(); ++bucket_index) {
+      const auto& bucket = buckets[bucket_index];
+      std::vector<ArgDef> bucket_gradient_argdefs;
+      bucket_gradient_argdefs.reserve(bucket.size());
+      for (size_t i : bucket) {
+        bucket_gradient_argdefs.push_back(gradient_argdefs[i]);
+      }
+
+      std::vector<ArgDef> bucket_output_gradient_argdef;
+      ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, bucket_gradient_argdefs,
+                                                  bucket_output_gradient_argdef, graph_defs, allreduce_type));
+      graph_defs.NodeDefs().back().priority = priority;
+
+      ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(bucket_gradient_argdefs, bucket_output_gradient_argdef,
+                                                       graph_defs,
+                                                       opt_graph_config_.compress_allreduce,
+                                                       "NcclAllReduce_" + std::to_string(bucket_index),
+                                                       priority));
+
+      for (size_t j = 0; j < bucket.size(); ++j) {
+        allreduced_gradient_argdefs[bucket[j]] = bucket_gradient_argdefs[j];
+      }
+    }
+    gradient_argdefs = std::move(allreduced_gradient_argdefs);
+  } else {
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef,
+                                                graph_defs, allreduce_type));
+
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs,
+                                                     opt_graph_config_.compress_allreduce));
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
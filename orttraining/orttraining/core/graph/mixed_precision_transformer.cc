@@ -25,6 +25,10 @@ namespace training {
 // Currently, this information is hard-coded via the stage1_fp32_node_args parameter below.
 // The choice for (b) is supplied via the stage2_fp32_node_args parameter below.
 
+// Beyond these built-in lists, TransformGraphForMixedPrecision can keep individual nodes in FP32 for (b):
+// nodes of user supplied op types, and, for FP16, nodes whose outputs exceeded the FP16 safe range in an
+// FP32 profiling run. BFloat16 shares the FP32 exponent range, so profiling is not needed there.
+
 // Functions introduce further choices in terms of the precision we use for function parameters.
 // We handle functions just like ops: if we want a function to use FP32 parameters, it should
 // be indicated using stage2_fp32_node_args.
@@ -64,6 +68,10 @@ bool IsFP32(const std::unordered_map<std::string, std::vector<int>>& map, std::s
 
 static const std::string loss_scale_input = "loss_scale";
 
+// Largest profiled absolute value of an output that still allows a node to run in FP16. It leaves one
+// binade of headroom below the FP16 maximum of 65504 for activations that grow over the course of training.
+static constexpr float fp16_safe_max_abs = 32768.0f;
+
 static const std::unordered_set<std::string> loss_subgraph_entry_nodes = {
     "SparseSoftmaxCrossEntropy",
     "SoftmaxCrossEntropyLoss",
@@ -390,17 +398,26 @@ Status TransformConstants(Graph& graph,
 // as SparseSoftmaxCrossEntropy where FP32 precision is required.
 // Converts fp16/bf16 tensor --> Op --> fp16/bf16 tensor to
 // fp16/bf16 tensor --> Cast --> fp32 tensor --> Op --> fp32 tensor --> Cast --> fp16/bf16 tensor
+// The nodes in `fp32_nodes` are handled the same way as the ones in FP32_Nodes; their input slots are expected
+// in `fp32_node_args_by_node`. Inputs produced by another FP32 node are passed through without casts.
 Status TransformStage2(Graph& graph,
                        ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
-                       const std::unordered_map<Node*, std::vector<int>>& loss_subgraph_fp32_node_args = {}) {
+                       const std::unordered_map<Node*, std::vector<int>>& fp32_node_args_by_node = {},
+                       const std::unordered_set<const Node*>& fp32_nodes = {}) {
   // This pass does not require topological sort order: okay to visit nodes in any order.
   std::unordered_set<NodeArg*> to_mixed_precision_type, toFP32;
   for (auto& node : graph.Nodes()) {
-    if (IsFP32Node(&node)) {
+    if (IsFP32Node(&node) || fp32_nodes.find(&node) != fp32_nodes.cend()) {
       for (NodeArg* input : node.MutableInputDefs()) {
         // TODO: Shouldn't we check stage2_fp32_node_args to conditionally transform this?
-        if (input->TypeAsProto()->tensor_type().elem_type() == mixed_precision_type)
+        if (input->TypeAsProto()->tensor_type().elem_type() != mixed_precision_type) {
+          continue;
+        }
+
+        const Node* producer_node = graph.GetProducerNode(input->Name());
+        if (producer_node == nullptr || fp32_nodes.find(producer_node) == fp32_nodes.cend()) {
           toFP32.insert(input);
+        }
       }
 
       for (NodeArg* output : node.MutableOutputDefs()) {
@@ -413,19 +430,20 @@ Status TransformStage2(Graph& graph,
   for (auto* tensor : toFP32)
     ORT_RETURN_IF_ERROR(CastNodeArg(graph,
                                     stage2_fp32_node_args,
-                                    loss_subgraph_fp32_node_args,
+                                    fp32_node_args_by_node,
                                     tensor,
                                     ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
   for (auto* tensor : to_mixed_precision_type)
     ORT_RETURN_IF_ERROR(CastNodeArg(graph,
                                     stage2_fp32_node_args,
-                                    loss_subgraph_fp32_node_args,
+                                    fp32_node_args_by_node,
                                     tensor,
                                     mixed_precision_type));
   return Status::OK();
 }
 
-static Status HandleFunctionCalls(Graph& graph, ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type, LossSubgraph* p_loss_subgraph = nullptr);
+static Status HandleFunctionCalls(Graph& graph, ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type, LossSubgraph* p_loss_subgraph = nullptr,
+                                  const std::unordered_set<const Node*>& fp32_nodes = {});
 
 // TODO: Ideally, we should not need to transform a function-body here.
 // Ideally, for any full-precision function F, there should be a corresponding 16-bit precision
@@ -492,13 +510,14 @@ static Status HandleFunctionBody(const Function& node_func, ONNX_NAMESPACE::Tens
   return status;
 }
 
-static Status HandleFunctionCalls(Graph& graph, ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type, LossSubgraph* p_loss_subgraph) {
+static Status HandleFunctionCalls(Graph& graph, ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type, LossSubgraph* p_loss_subgraph,
+                                  const std::unordered_set<const Node*>& fp32_nodes) {
   GraphViewer graph_viewer(graph);
   const auto& order = graph_viewer.GetNodesInTopologicalOrder();
   for (auto index : order) {
     Node* node = graph.GetNode(index);
     // Bodies of FP32 Functions are not transformed.
-    if (IsFP32Node(node) ||
+    if (IsFP32Node(node) || fp32_nodes.find(node) != fp32_nodes.cend() ||
         (p_loss_subgraph != nullptr && p_loss_subgraph->Contains(node))) {
       continue;
     }
@@ -512,6 +531,47 @@ static Status HandleFunctionCalls(Graph& graph, ONNX_NAMESPACE::TensorProto_Data
   return Status::OK();
 }
 
+// Select the nodes outside of the loss subgraph that are kept in FP32: those with an op type in `fp32_op_types`
+// and, for FP16, those with a float output whose profiled max absolute value exceeds fp16_safe_max_abs.
+static std::unordered_set<const Node*> SelectFP32Nodes(Graph& graph,
+                                                       ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
+                                                       const std::unordered_set<std::string>& fp32_op_types,
+                                                       const std::unordered_map<std::string, float>& activation_max_abs,
+                                                       LossSubgraph& loss_subgraph) {
+  std::unordered_set<const Node*> fp32_nodes;
+  const bool use_profile = mixed_precision_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16 &&
+                           !activation_max_abs.empty();
+  for (auto& node : graph.Nodes()) {
+    if (loss_subgraph.Contains(&node) || node.OpType() == "Cast") {
+      continue;
+    }
+
+    if (fp32_op_types.find(node.OpType()) != fp32_op_types.cend()) {
+      fp32_nodes.insert(&node);
+      continue;
+    }
+
+    if (!use_profile) {
+      continue;
+    }
+
+    for (const NodeArg* output : node.OutputDefs()) {
+      if (!output->Exists() ||
+          output->TypeAsProto()->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+        continue;
+      }
+
+      auto it = activation_max_abs.find(output->Name());
+      if (it != activation_max_abs.cend() && it->second > fp16_safe_max_abs) {
+        fp32_nodes.insert(&node);
+        break;
+      }
+    }
+  }
+
+  return fp32_nodes;
+}
+
 // Create FP16/BFloat16 NodeArg and update the consumers of arg with new FP16/BFloat16 NodeArg.
 static NodeArg* CreateMixedPrecisionNodeArgAndUpdateConsumers(Graph& graph,
                                                               const std::unordered_map<std::string, std::vector<int>>& fp32_node_args_by_op_type,
@@ -547,7 +607,9 @@ Status TransformGraphForMixedPrecision(Graph& graph,
                                        bool use_mixed_precision_initializer,
                                        ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
                                        std::unordered_map<std::string, NodeArg*>& fp32_weight_name_to_mixed_precision_node_arg,
-                                       bool layernorm_stash_as_fp32) {
+                                       bool layernorm_stash_as_fp32,
+                                       const std::unordered_set<std::string>& fp32_op_types,
+                                       const std::unordered_map<std::string, float>& activation_max_abs) {
   //Only fp16 and bfloat16 supported for now.
   ORT_ENFORCE(mixed_precision_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16 ||
               mixed_precision_type == ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16);
@@ -555,6 +617,10 @@ Status TransformGraphForMixedPrecision(Graph& graph,
   // Stag 0: Initialize loss subgraph.
   LossSubgraph loss_subgraph(graph);
 
+  // Nodes that are converted along with the rest of the graph in stage 1 and restored to FP32 in stage 2.
+  const std::unordered_set<const Node*> fp32_nodes =
+      SelectFP32Nodes(graph, mixed_precision_type, fp32_op_types, activation_max_abs, loss_subgraph);
+
   // Stage 1: Convert whole graph including forward and backward to FP16/BF16
   // Insert Cast node to convert inputs from FP32 to FP16/BF16
   // If all consumers are from loss graph, don't convert it, and remove it from To-32 loss graph inputs.
@@ -650,7 +716,7 @@ Status TransformGraphForMixedPrecision(Graph& graph,
   ORT_RETURN_IF_ERROR(TransformConstants(graph, mixed_precision_type, &loss_subgraph));
 
   // Handle function body
-  ORT_RETURN_IF_ERROR(HandleFunctionCalls(graph, mixed_precision_type, &loss_subgraph));
+  ORT_RETURN_IF_ERROR(HandleFunctionCalls(graph, mixed_precision_type, &loss_subgraph, fp32_nodes));
 
   // Handle loss graph inputs and outputs.
   ORT_RETURN_IF_ERROR(loss_subgraph.CastInputsToFP32(graph));
@@ -663,7 +729,16 @@ Status TransformGraphForMixedPrecision(Graph& graph,
 
   ORT_RETURN_IF_ERROR(graph.Resolve(options));
 
-  ORT_RETURN_IF_ERROR(TransformStage2(graph, mixed_precision_type, loss_subgraph.GetFP32NodeArgs()));
+  // All inputs of the selected FP32 nodes keep FP32, as the loss subgraph inputs do.
+  std::unordered_map<Node*, std::vector<int>> stage2_fp32_node_args_by_node = loss_subgraph.GetFP32NodeArgs();
+  for (const Node* fp32_node : fp32_nodes) {
+    std::vector<int>& slots = stage2_fp32_node_args_by_node[graph.GetNode(fp32_node->Index())];
+    for (int i = 0; i < static_cast<int>(fp32_node->InputDefs().size()); ++i) {
+      slots.push_back(i);
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(TransformStage2(graph, mixed_precision_type, stage2_fp32_node_args_by_node, fp32_nodes));
 
   ORT_RETURN_IF_ERROR(graph.Resolve(options));
 
@@ -19,6 +19,11 @@ namespace training {
  * @param fp32_weight_name_to_mixed_precision_node_arg Mapping from the original FP32
  *        weight name to the mixed precision NodeArg corresponding to the added mixed precision
  *        initializer. This will be empty if use_mixed_precision_initializer is false.
+ * @param layernorm_stash_as_fp32 Whether LayerNormalization stashes its mean and inverse std dev in FP32.
+ * @param fp32_op_types Op types that are kept in FP32 in addition to the built-in list.
+ * @param activation_max_abs Max absolute value of each tensor observed in an FP32 profiling run, keyed by
+ *        tensor name. With FP16, nodes producing a tensor above the FP16 safe range are kept in FP32.
+ *        It is not used with BFloat16, which has the same exponent range as FP32.
  *
  * @return The status of the operation.
  */
@@ -27,7 +32,9 @@ Status TransformGraphForMixedPrecision(Graph& graph,
                                        bool use_mixed_precision_initializer,
                                        ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
                                        std::unordered_map<std::string, NodeArg*>& fp32_weight_name_to_mixed_precision_node_arg,
-                                       bool layernorm_stash_as_fp32);
+                                       bool layernorm_stash_as_fp32,
+                                       const std::unordered_set<std::string>& fp32_op_types = {},
+                                       const std::unordered_map<std::string, float>& activation_max_abs = {});
 
 /**
  * Checks if a node is an fp32-only node.
@@ -37,6 +37,9 @@ Status AdamOptimizerBuilder::Build(
 
     // In distributed training, some weights may not be updated by all ranks.
     if (opt_configs[i].enabled) {
+      const bool offload_states = opt_configs[i].offload_states;
+      ORT_RETURN_IF(offload_states && (!opt_configs[i].update_weight || opt_configs[i].use_mixed_precision_moments),
+                    "Offloaded optimizer states require weight updates and FP32 moments: ", weight_name);
       weight_to_opt_mapping[weight_name] = {};
       // The type proto initializer for Update Count
       const std::string update_count_string = ADAM_UC_PREFIX + "_" + weight_name;  // per weight optimizer requires a per weight update count
@@ -122,7 +125,8 @@ Status AdamOptimizerBuilder::Build(
         output_args.push_back(output_gradient_argdef);  // g_new
       }
 
-      if (opt_configs[i].update_weight && opt_configs[i].mixed_precision_weight_arg != nullptr) {
+      // Offloaded optimizers do not update the mixed precision weight themselves, see below.
+      if (opt_configs[i].update_weight && opt_configs[i].mixed_precision_weight_arg != nullptr && !offload_states) {
         input_args.push_back(ArgDef(opt_configs[i].mixed_precision_weight_arg->Name(), opt_configs[i].mixed_precision_weight_arg->TypeAsProto()));
         std::string output_name = opt_configs[i].mixed_precision_weight_arg->Name() + "_Adam_out";
         output_weight_argdef = ArgDef(output_name, opt_configs[i].mixed_precision_weight_arg->TypeAsProto());
@@ -156,6 +160,41 @@ Status AdamOptimizerBuilder::Build(
                                       output_args,
                                       BuildAttributeProto(opt_configs[i]),
                                       OptimizerNodeName(weight_name))});
+
+      if (offload_states) {
+        // The optimizer node is placed on CPU by the training session, where it updates the FP32 weight in place.
+        // Only the new weight, in the mixed precision type if used, goes back to the device, where it overwrites the
+        // weight used by the forward and backward pass in place. The reset is ordered after the optimizer.
+        const ArgDef new_weight_argdef = output_args[3];
+        ArgDef device_weight_argdef = weight_argdefs[i];
+        ArgDef new_device_weight_argdef = new_weight_argdef;
+        if (opt_configs[i].mixed_precision_weight_arg != nullptr) {
+          const NodeArg* mixed_precision_weight_arg = opt_configs[i].mixed_precision_weight_arg;
+          device_weight_argdef = ArgDef(mixed_precision_weight_arg->Name(), mixed_precision_weight_arg->TypeAsProto());
+          new_device_weight_argdef = ArgDef(new_weight_argdef.name + "_Cast", mixed_precision_weight_arg->TypeAsProto());
+          graph_defs.AddNodeDefs({NodeDef(OpDef{"Cast"},
+                                          {new_weight_argdef},
+                                          {new_device_weight_argdef},
+                                          {ONNX_NAMESPACE::MakeAttribute(
+                                              "to",
+                                              static_cast<int64_t>(
+                                                  mixed_precision_weight_arg->TypeAsProto()->tensor_type().elem_type()))},
+                                          OptimizerNodeName(weight_name) + "_Offload_Cast")});
+        }
+
+        const ArgDef zeroed_weight_argdef(device_weight_argdef.name + "_Offload_Zeroed", device_weight_argdef.type_proto);
+        output_weight_argdef = ArgDef(device_weight_argdef.name + "_Offload_Out", device_weight_argdef.type_proto);
+        graph_defs.AddNodeDefs({NodeDef(OpDef{"ZeroGradient", kMSDomain, 1},
+                                        {device_weight_argdef, output_args[0]},
+                                        {zeroed_weight_argdef},
+                                        NodeAttributes(),
+                                        OptimizerNodeName(weight_name) + "_Offload_Reset"),
+                                NodeDef(OpDef{"InPlaceAccumulator", kMSDomain, 1},
+                                        {zeroed_weight_argdef, new_device_weight_argdef},
+                                        {output_weight_argdef},
+                                        NodeAttributes(),
+                                        OptimizerNodeName(weight_name) + "_Offload_Copy")});
+      }
     }
 
     output_weight_argdefs.push_back(output_weight_argdef);
@@ -3,6 +3,7 @@
 
 #include "orttraining/core/graph/optimizer/sgd_optimizer_builder.h"
 #include "orttraining/core/graph/graph_augmenter.h"
+#include "onnx/defs/attr_proto_util.h"
 
 namespace onnxruntime {
 namespace training {
@@ -60,5 +61,127 @@ Status SGDOptimizerBuilder::Build(
   return Status::OK();
 }
 
+Status SGDV2OptimizerBuilder::Build(
+    const OptimizerBuilderConfig& config,
+    GraphAugmenter::GraphDefs& graph_defs,
+    std::vector<TensorProto>& /* new_external_initializers */,
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& /* weight_to_opt_mapping */,
+    std::vector<ArgDef>& output_weight_argdefs,
+    std::vector<ArgDef>& output_gradient_argdefs) const {
+  const auto& weight_argdefs = config.weight_argdefs;
+  const auto& gradient_argdefs = config.gradient_argdefs;
+  const auto& opt_configs = config.opt_configs;
+
+  // gradient clipping is disabled by default for SGD.
+  bool enable_grad_clipping = config.enable_grad_clipping.has_value() ? *config.enable_grad_clipping : false;
+
+  // Indicator of finite gradient norm, loss scale, gradient norm and learning rate, shared by all the nodes.
+  std::vector<ArgDef> non_grouped_input_argdefs;
+  non_grouped_input_argdefs.push_back(config.gradient_norm_finite_argdef ? *config.gradient_norm_finite_argdef : ArgDef());
+  if (!opt_configs[0].loss_scale_input_name.empty()) {
+    non_grouped_input_argdefs.emplace_back(ArgDef(opt_configs[0].loss_scale_input_name, graph_defs.CreateTypeProto(std::array<const int64_t, 1>{1}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT)));
+  } else {
+    non_grouped_input_argdefs.emplace_back(ArgDef());
+  }
+  if (config.gradient_norm_argdef && enable_grad_clipping) {
+    non_grouped_input_argdefs.push_back(*config.gradient_norm_argdef);
+  } else if (!config.gradient_norm_argdef && enable_grad_clipping) {
+    ORT_THROW("Gradient clipping is enabled but gradient norm is not given.");
+  } else {
+    non_grouped_input_argdefs.push_back(ArgDef());
+  }
+  non_grouped_input_argdefs.emplace_back(ArgDef(opt_configs[0].lr_feed_name, CreateLearningRateTypeProto(graph_defs)));
+  graph_defs.AddGraphInputs({opt_configs[0].lr_feed_name});
+
+  float max_norm_clip = 1.0f;
+  {
+    const auto& attrs = opt_configs.front().attributes;
+    auto max_norm_clip_iter = attrs.find("max_norm_clip");
+    if (max_norm_clip_iter != attrs.end())
+      max_norm_clip = max_norm_clip_iter->second;
+  }
+
+  // A node updates at most 1024 weights, as many as its schema has input groups.
+  constexpr size_t max_group_count = 1024;
+  std::vector<ArgDef> input_argdefs;
+  std::vector<ArgDef> output_argdefs;
+  size_t group_count = 0;
+  int node_count = 0;
+  auto add_node = [&]() {
+    graph_defs.AddNodeDefs({NodeDef(OpDefinition(),
+                                    input_argdefs,
+                                    output_argdefs,
+                                    {ONNX_NAMESPACE::MakeAttribute("max_norm_clip", max_norm_clip)},
+                                    OptimizerNodeName("AllWeights_" + std::to_string(node_count++)))});
+    input_argdefs.clear();
+    output_argdefs.clear();
+    group_count = 0;
+  };
+
+  for (size_t i = 0; i < weight_argdefs.size(); ++i) {
+    const std::string& weight_name = weight_argdefs[i].name;
+    const std::string& gradient_name = gradient_argdefs[i].name;
+
+    // Return either the input gradient/weight/mixed-precision-weight or updated gradient/weight/mixed-precision-weight.
+    ArgDef output_gradient_argdef = gradient_argdefs[i];
+    ArgDef output_weight_argdef = weight_argdefs[i];
+    if (opt_configs[i].mixed_precision_weight_arg != nullptr)
+      output_weight_argdef = ArgDef(opt_configs[i].mixed_precision_weight_arg->Name(), opt_configs[i].mixed_precision_weight_arg->TypeAsProto());
+
+    // In distributed training, some weights may not be updated by all ranks.
+    if (opt_configs[i].enabled) {
+      ORT_RETURN_IF_NOT(opt_configs[i].lr_feed_name == opt_configs[0].lr_feed_name &&
+                            opt_configs[i].loss_scale_input_name == opt_configs[0].loss_scale_input_name,
+                        "SGDOptimizerV2 requires all the weights to share the learning rate and the loss scale.");
+
+      if (input_argdefs.empty()) {
+        input_argdefs = non_grouped_input_argdefs;
+      }
+
+      // w & g
+      input_argdefs.push_back(weight_argdefs[i]);
+      input_argdefs.push_back(gradient_argdefs[i]);
+
+      // Output either w_new or g_new based on config.
+      if (opt_configs[i].update_weight) {
+        output_weight_argdef = ArgDef(weight_name + "_SGD_out", weight_argdefs[i].type_proto);
+        output_argdefs.push_back(output_weight_argdef);  // w_new
+        output_argdefs.push_back(ArgDef());              // g_new
+      } else {
+        output_gradient_argdef = ArgDef(gradient_name + "_SGD_out", gradient_argdefs[i].type_proto);
+        output_argdefs.push_back(ArgDef());                // w_new
+        output_argdefs.push_back(output_gradient_argdef);  // g_new
+      }
+
+      // w_mixed_precision & w_mixed_precision_new
+      if (opt_configs[i].update_weight && opt_configs[i].mixed_precision_weight_arg != nullptr) {
+        input_argdefs.emplace_back(ArgDef(
+            opt_configs[i].mixed_precision_weight_arg->Name(),
+            opt_configs[i].mixed_precision_weight_arg->TypeAsProto()));
+        output_weight_argdef = ArgDef(
+            opt_configs[i].mixed_precision_weight_arg->Name() + "_SGD_out",
+            opt_configs[i].mixed_precision_weight_arg->TypeAsProto());
+        output_argdefs.push_back(output_weight_argdef);
+      } else {
+        input_argdefs.emplace_back(ArgDef());
+        output_argdefs.emplace_back(ArgDef());
+      }
+
+      if (++group_count == max_group_count) {
+        add_node();
+      }
+    }
+
+    output_weight_argdefs.push_back(output_weight_argdef);
+    output_gradient_argdefs.push_back(output_gradient_argdef);
+  }
+
+  if (group_count > 0) {
+    add_node();
+  }
+
+  return Status::OK();
+}
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -21,5 +21,20 @@ class SGDOptimizerBuilder final : public OptimizerBuilder {
       std::vector<ArgDef>& output_gradient_argdefs) const override;
 };
 
+// Builds SGDOptimizerV2 nodes, which update up to 1024 weights each with a few multi-tensor kernel launches,
+// instead of one SGDOptimizer node per weight.
+class SGDV2OptimizerBuilder final : public OptimizerBuilder {
+ public:
+  SGDV2OptimizerBuilder() : OptimizerBuilder(OpDef{"SGDOptimizerV2", kMSDomain, 1}) {}
+
+  virtual Status Build(
+      const OptimizerBuilderConfig& config,
+      GraphAugmenter::GraphDefs& graph_defs,
+      std::vector<TensorProto>& /* new_external_initializers */,
+      std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& /*weight_to_opt_mapping*/,
+      std::vector<ArgDef>& output_weight_argdefs,
+      std::vector<ArgDef>& output_gradient_argdefs) const override;
+};
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -14,6 +14,7 @@ void OptimizerBuilderRegistry::RegisterBuilders() {
   GetInstance().Register<AdamOptimizerBuilder>("AdamOptimizer");
   GetInstance().Register<LambOptimizerBuilder>("LambOptimizer");
   GetInstance().Register<SGDOptimizerBuilder>("SGDOptimizer");
+  GetInstance().Register<SGDV2OptimizerBuilder>("SGDOptimizerV2");
 }
 
 Status IsMatchingTypeAndShape(
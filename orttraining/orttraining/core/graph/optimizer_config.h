@@ -30,8 +30,8 @@ enum MixedPrecisionDataType {
 };
 
 // Configuration for the DeepSpeed ZeRO technique.  Currently only the stage
-// setting is supported, and only with stages 0 (disabled) and 1 (optimizer
-// state partitioning).
+// setting is supported, with stages 0 (disabled), 1 (optimizer state
+// partitioning) and 2 (optimizer state and accumulated gradient partitioning).
 
 struct ZeROConfig {
   // Default configuration
@@ -56,6 +56,9 @@ struct OptimizerNodeConfig {
   bool use_mixed_precision_moments{false};
   bool update_weight{true};  // indicates whether Optimizer should do weight update, or output new gradient
   bool enabled{true};        // indicates whether this weight is included in the Optimizer
+  // indicates whether the optimizer states and FP32 weight live in CPU memory and are updated there,
+  // with only the new (mixed precision) weight copied back to the device
+  bool offload_states{false};
 };
 
 // configuration for optimizer portion of graph
@@ -73,6 +76,11 @@ struct OptimizerGraphConfig {
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
   AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
   bool enable_grad_norm_clip{true};
+  // Size in bytes of the buckets of gradients all-reduced together, in the order the backward pass produces them.
+  // 0 all-reduces all the gradients at once.
+  int64_t allreduce_bucket_size{0};
+  // Whether to all-reduce the gradients as int8 with error feedback, see the compression attribute of NcclAllReduce.
+  bool compress_allreduce{false};
 
   NameMLValMap shared_optimizer_states{};  // initial states for shared params, eg. 'Step' for lamb
 
@@ -431,7 +431,8 @@ Status OptimizerGraphBuilder::Build(
   ORT_RETURN_IF_ERROR(GetArgDefsFromGraph(graph, weight_names_, weight_argdefs));
   ORT_RETURN_IF_ERROR(GetArgDefsFromGraph(graph, gradient_names_, gradient_argdefs));
 
-  const bool is_gradient_accumulation_enabled = opt_graph_config_.gradient_accumulation_steps > 1;
+  const bool is_gradient_accumulation_enabled =
+      opt_graph_config_.gradient_accumulation_steps > 1 && !AccumulatesGradientsInBuildInternal();
 
   // add gradient accumulation
   std::vector<ArgDef> gradient_accumulation_buffers;
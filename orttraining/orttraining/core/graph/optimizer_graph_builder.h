@@ -30,6 +30,15 @@ ArgDef BuildGradientAccumulationNode(const NodeArgNameGeneratorFn& nodearg_name_
                                      GraphAugmenter::GraphDefs& graph_defs,
                                      bool add_accumulate_buffer_as_initializers = true);
 
+ArgDef BuildGroupNode(const std::string& group_output_name,
+                      const std::vector<ArgDef>& input_argdefs,
+                      GraphAugmenter::GraphDefs& graph_defs);
+
+Status AddZeroGradientNodes(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                            const std::vector<ArgDef>& control_signals,
+                            std::vector<ArgDef>& gradient_argdefs,  // update argdefs in place
+                            GraphAugmenter::GraphDefs& graph_defs);
+
 /**
  * Builds the optimizer components on top of an existing training graph.
  * The optimizers used are determined by the weight_names_to_opt_configs parameter
@@ -80,6 +89,10 @@ class OptimizerGraphBuilder {
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs);
 
+  // Returns whether BuildInternal() adds the gradient accumulation and the zeroing of its buffers. Otherwise Build()
+  // accumulates the full gradients before calling BuildInternal().
+  virtual bool AccumulatesGradientsInBuildInternal() const { return false; }
+
   Status AddGradientPassThroughNode(
       const NodeArgNameGeneratorFn& nodearg_name_generator,
       std::vector<ArgDef>& gradient_argdefs,  // update argdefs in place
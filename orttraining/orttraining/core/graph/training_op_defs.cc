@@ -573,6 +573,115 @@ OpSchema& RegisterLambOpSchema(OpSchema&& op_schema) {
   return op_schema;
 }
 
+OpSchema& RegisterSGDV2OpSchema(OpSchema&& op_schema) {
+  op_schema
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(
+          "Multi-tensor version of SGDOptimizer. All the weights are updated by a few kernel launches, with the "
+          "gradients unscaled by the loss scale and clipped by their global norm, and the mixed precision "
+          "weights refreshed from the updated weights.")
+      .Attr(
+          "max_norm_clip",
+          "clip threshold of the global norm of the gradients.",
+          AttributeProto::FLOAT,
+          1.0f)
+      .TypeConstraint(
+          "T1",
+          {"tensor(float)"},
+          "Constrain learning rate to float.")
+      .TypeConstraint(
+          "T2",
+          {"tensor(float)"},
+          "Constrain weights and loss scale to float tensors.")
+      .TypeConstraint(
+          "T3",
+          {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+          "Constrain gradients to float tensors.")
+      .TypeConstraint(
+          "T_MIXED_PRECISION_FP",
+          {"tensor(float16)", "tensor(bfloat16)"},
+          "Constrain input types to float16 or bfloat16 tensors.")
+      .TypeConstraint(
+          "T_GRAD_NORM",
+          {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T_BOOL",
+          {"tensor(bool)"},
+          "Constrain types to boolean tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // The first 4 inputs don't affect output shape.
+        for (size_t i = 4; i < ctx.getNumInputs(); ++i) {
+          const size_t output_index = i - 4;
+          if (output_index < ctx.getNumOutputs() && ctx.getInputType(i) != nullptr) {
+            propagateElemTypeFromInputToOutput(ctx, i, output_index);
+            if (hasInputShape(ctx, i)) {
+              propagateShapeFromInputToOutput(ctx, i, output_index);
+            }
+          }
+        }
+      });
+
+  op_schema
+      .Input(
+          0,
+          "update_signal",
+          "This signal indicates if weight tensors should be updated.",
+          "T_BOOL",
+          OpSchema::Optional)
+      .Input(
+          1,
+          "loss_scale",
+          "Loss scale for mixed precision training.",
+          "T2",
+          OpSchema::Optional)
+      .Input(
+          2,
+          "gradient_norm",
+          "Norm of global gradient, which enables gradient clipping when given.",
+          "T_GRAD_NORM",
+          OpSchema::Optional)
+      .Input(
+          3,
+          "ETA",
+          "Learning rate.",
+          "T1",
+          OpSchema::Optional);
+
+  AddRepeatedInputs(
+      op_schema,
+      4,
+      1024,
+      {"weights",
+       "gradients",
+       "mixed_precision_weights"},
+      {"weights to optimize.",
+       "gradients computed in this iteration.",
+       "FP16 or BF16 weights to optimize."},
+      {"T2",
+       "T3",
+       "T_MIXED_PRECISION_FP"},
+      OpSchema::Optional);
+
+  AddRepeatedOutputs(
+      op_schema,
+      0,
+      1024,
+      {"new_weights",
+       "new_gradients",
+       "new_mixed_precision_weights"},
+      {"New weights",
+       "New gradients, which are the weight updates",
+       "New FP16 or BF16 weights"},
+      {"T2",
+       "T3",
+       "T_MIXED_PRECISION_FP"},
+      OpSchema::Optional);
+
+  return op_schema;
+}
+
 void RegisterTrainingOpSchemas() {
   ONNX_CONTRIB_OPERATOR_SCHEMA(ReluGrad)
       .SetDomain(kMSDomain)
@@ -872,7 +981,7 @@ void RegisterTrainingOpSchemas() {
       });
 
   // TODO: Move this to the right location. Its only here for quick experimentation.
-  // TODO: Use the mutli weight / grad version.
+  // SGDOptimizerV2 is the multi weight / grad version.
   ONNX_CONTRIB_OPERATOR_SCHEMA(SGDOptimizer)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1049,6 +1158,8 @@ void RegisterTrainingOpSchemas() {
 
   ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(LambOptimizer, RegisterLambOpSchema);
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(SGDOptimizerV2, RegisterSGDV2OpSchema);
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(InPlaceAccumulator)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1271,6 +1382,12 @@ Example 4:
             "4 - horozontal parallel, 5 - model parallel.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("compression",
+            "0 - none, 1 - int8 with a scale per block of 256 elements. The int8 reduction keeps the quantization "
+            "error of each call, in a float buffer as large as the inputs, and adds it to the inputs of the next "
+            "call. Only float and float16 tensors are compressed.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "tensors to be reduced", "T", OpSchema::Variadic)
       .Output(0, "output", "reduced tensors", "T", OpSchema::Variadic)
       .TypeConstraint(
@@ -1687,7 +1804,8 @@ Example 4:
       .AllowUncheckedAttributes()
       .Input(0, "dy", "The gradient tensor from output.", "T")
       .Input(1, "mask",
-             "The mask output of the dropout. ", "T2")
+             "The mask output of the dropout. If it is not specified, philox_state must be.", "T2",
+             OpSchema::Optional)
       .Input(2, "ratio",
              "Same value as the ratio input supplied to the dropout op with value in [0, 1). "
              "If this input is not specified, a default value of 0.5 is used.",
@@ -1698,6 +1816,10 @@ Example 4:
              "If this input is not specified, a default value of false is used.",
              "T2",
              OpSchema::Optional)
+      .Input(4, "philox_state",
+             "The philox_state output of the BiasDropout op. Used to regenerate the mask if mask is not specified.",
+             "tensor(int64)",
+             OpSchema::Optional)
       .Output(0, "dx", "Gradient of the input.", "T")
       .TypeConstraint(
           "T",
@@ -1729,6 +1851,10 @@ Example 4:
               return false;
             auto elem_type = (ONNX_NAMESPACE::TensorProto_DataType)tp->tensor_type().elem_type();
 
+            // A mask regenerated from the philox state cannot be expressed with ONNX ops.
+            if (!ctx.hasInput(1))
+              return false;
+
             FunctionBuilder builder(functionProto);
             builder
                 .AddOpset("", 16)
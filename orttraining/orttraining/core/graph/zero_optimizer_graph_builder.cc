@@ -435,6 +435,12 @@ ZeROOptimizerGraphBuilder::ZeROOptimizerGraphBuilder(
   ORT_ENFORCE(opt_graph_config.data_parallel_group_size > 1, "ZeRO optimizer graph builder can only be used for distributed training.");
   ORT_ENFORCE(opt_graph_config.use_nccl, "Distributed training with ZeRO is only supported with NCCL.");
   ORT_ENFORCE(IsNcclAvailable(), "Distributed training with NCCL is not supported, as NCCL is not enabled in this build.");
+  ORT_ENFORCE(opt_graph_config.deepspeed_zero.stage <= 2,
+              "ZeRO stage ", opt_graph_config.deepspeed_zero.stage, " is not supported. Supported stages are 1 and 2.");
+}
+
+bool ZeROOptimizerGraphBuilder::AccumulatesGradientsInBuildInternal() const {
+  return opt_graph_config_.deepspeed_zero.stage >= 2 && opt_graph_config_.gradient_accumulation_steps > 1;
 }
 
 Status ZeROOptimizerGraphBuilder::BuildInternal(
@@ -465,6 +471,29 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
   // add Reducescatter for gradients
   ORT_RETURN_IF_ERROR(AddNcclReduceScatterForGradients(gradient_argdefs, graph_defs));
 
+  // With ZeRO stage 2, the gradients are reduced at every step, and only the partitions this rank updates are
+  // accumulated. The accumulation buffers then take 1 / data_parallel_group_size of the memory of the full gradients.
+  std::vector<size_t> accumulated_indices;
+  std::vector<ArgDef> gradient_accumulation_buffers;
+  if (AccumulatesGradientsInBuildInternal()) {
+    for (size_t i = 0; i < gradient_argdefs.size(); i++) {
+      if (opt_configs_[i].enabled) {
+        accumulated_indices.push_back(i);
+        gradient_accumulation_buffers.emplace_back();
+        gradient_argdefs[i] = BuildGradientAccumulationNode(
+            nodearg_name_generator, gradient_argdefs[i], gradient_accumulation_buffers.back(), graph_defs);
+      }
+    }
+
+    // The group depends on all the reduced gradients, so that every rank takes part in the ReduceScatter of each
+    // accumulation step, including the ranks without any partition to accumulate.
+    ArgDef group_accumulate_gradient_output = BuildGroupNode(nodearg_name_generator("Group_Accumulated_Gradients"),
+                                                             gradient_argdefs,
+                                                             graph_defs);
+    graph_defs.AddGraphOutputs({group_accumulate_gradient_output.name});
+    optimizer_graph_outputs[OptimizerOutputKey::GradientAccumulation] = group_accumulate_gradient_output.name;
+  }
+
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
   ArgDef global_grad_norm_finite_argdef;
@@ -494,6 +523,16 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
   // add Allgather for weights
   ORT_RETURN_IF_ERROR(AddNcclAllGatherForWeights(weight_argdefs, graph_defs));
 
+  // zero the accumulated partitions once their weights are updated
+  if (AccumulatesGradientsInBuildInternal()) {
+    std::vector<ArgDef> control_signals;
+    for (size_t index : accumulated_indices) {
+      control_signals.push_back(weight_argdefs[index]);
+    }
+    ORT_RETURN_IF_ERROR(AddZeroGradientNodes(
+        nodearg_name_generator, control_signals, gradient_accumulation_buffers, graph_defs));
+  }
+
   return Status::OK();
 }
 
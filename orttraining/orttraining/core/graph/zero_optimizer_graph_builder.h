@@ -27,6 +27,9 @@ class ZeROOptimizerGraphBuilder : public OptimizerGraphBuilder {
       std::vector<ArgDef>& gradient_argdefs,
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& optimizer_state_initializer_names,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) override;
+
+  // ZeRO stage 2 accumulates the partitions of the gradients after they are reduced.
+  bool AccumulatesGradientsInBuildInternal() const override;
 };
 
  /**
@@ -6,6 +6,9 @@
 #include "core/optimizer/rewrite_rule.h"
 #include "orttraining/core/optimizer/gist_encode_decode.h"
 #include "core/graph/graph_utils.h"
+#include "core/framework/tensorprotoutils.h"
+
+#include <algorithm>
 
 namespace onnxruntime {
 struct GraphEdgeHelper {
@@ -37,6 +40,60 @@ struct GraphEdgeHelper {
   }
 };
 
+std::string GistEncodeDecode::SelectAutoCompressionType(const NodeArg& stashed_arg,
+                                                        const std::vector<std::pair<Node*, int>>& dst_nodes) {
+  const ONNX_NAMESPACE::TypeProto* type = stashed_arg.TypeAsProto();
+  const ONNX_NAMESPACE::TensorShapeProto* shape = stashed_arg.Shape();
+  if (type == nullptr || !type->has_tensor_type() || shape == nullptr || shape->dim_size() == 0) {
+    return "";
+  }
+  const auto elem_type = type->tensor_type().elem_type();
+  if (elem_type == ONNX_NAMESPACE::TensorProto_DataType_BOOL) {
+    return "GistPack1";
+  }
+  const bool is_float16 = elem_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16;
+  const bool is_float = elem_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+
+  // ReluGrad only reads the sign of the Relu output, so binarizing it is lossless.
+  if ((is_float16 || is_float || elem_type == ONNX_NAMESPACE::TensorProto_DataType_DOUBLE) &&
+      std::all_of(dst_nodes.begin(), dst_nodes.end(),
+                  [](const std::pair<Node*, int>& dst) { return dst.first->OpType() == "ReluGrad"; })) {
+    return "GistBinarize";
+  }
+
+  if (!is_float16 && !is_float) {
+    return "";
+  }
+
+  // Activations with symbolic dimensions scale with the batch, so they are treated as large.
+  bool is_large = false;
+  int64_t num_elements = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      is_large = true;
+      break;
+    }
+    num_elements *= dim.dim_value();
+  }
+  is_large = is_large || num_elements * (is_float ? 4 : 2) >= GIST_AUTO_LARGE_ACTIVATION_BYTES;
+
+  if (is_float16) {
+    return is_large ? "GistPack8" : "";
+  }
+
+  if (!is_large) {
+    return "GistPack16";
+  }
+
+  // MSFP15 keeps 6 mantissa bits with an exponent shared along the last dimension, at the same size as the
+  // 2 mantissa bits of GistPack8, but needs whole tiles.
+  const auto& last_dim = shape->dim(shape->dim_size() - 1);
+  if (utils::HasDimValue(last_dim) && last_dim.dim_value() % GIST_MSFP15_TILE_SIZE == 0) {
+    return "GistPackMsfp15";
+  }
+  return "GistPack8";
+}
+
 static std::vector<GraphEdgeHelper> GetNodeOutputEdges(const Node& node) {
   std::vector<GraphEdgeHelper> output_edges;
   for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
@@ -73,13 +130,25 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
   }
 
   std::string user_compression_type = compression_type;
+  bool applied = false;
 
   // Each element in map corresponds to a stash activation
   for (auto& st_act : decode_map) {
     // Create compressed tensor
     NodeArg* curr_node_output_arg = curr_node.MutableOutputDefs()[st_act.first];
+    if (curr_node_output_arg->Shape() == nullptr) {
+      continue;
+    }
     ONNX_NAMESPACE::TypeProto compressed_tensor;
     compression_type = user_compression_type;
+    if (compression_type == "GistAuto") {
+      compression_type = SelectAutoCompressionType(*curr_node_output_arg, st_act.second);
+      if (compression_type.empty()) {
+        continue;
+      }
+      LOGS(logger, INFO) << "GistAuto selected compression type " << compression_type
+                         << " for tensor: " << curr_node_output_arg->Name();
+    }
 
     // Override compression_type for lossless compression case(s) (eg. bool -> Pack1)
     ONNX_NAMESPACE::DataType type_string = curr_node_output_arg->Type();
@@ -146,9 +215,10 @@ bool GistEncodeDecode::AddEncodeDecode(Graph& graph, Node& curr_node, std::strin
     for (auto& dest_pair : st_act.second) {
       graph.AddEdge(decode.Index(), dest_pair.first->Index(), 0, dest_pair.second);
     }
+    applied = true;
   }
 
-  return true;
+  return applied;
 }
 
 std::vector<std::string> GistEncodeDecode::TargetOpTypes() const noexcept {
@@ -178,7 +248,14 @@ std::vector<std::string> GistEncodeDecode::TargetOpTypes() const noexcept {
       return {"Relu"};
       break;
     case 9:
-      return {"Softmax", "Transpose", "Reshape", "Add", "Dropout", "LayerNormalization", "MatMul", "Relu"};
+      return {"Softmax", "Transpose", "Reshape", "Add", "Dropout", "LayerNormalization", "MatMul", "Relu",
+              "Gelu", "FastGelu", "BiasGelu", "SimplifiedLayerNormalization"};
+      break;
+    case 10:
+      return {"Gelu", "FastGelu", "BiasGelu"};
+      break;
+    case 11:
+      return {"SimplifiedLayerNormalization"};
       break;
     default:
       return {};
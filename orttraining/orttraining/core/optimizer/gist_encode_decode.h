@@ -18,18 +18,28 @@ class GistEncodeDecode : public RewriteRule {
 
   static constexpr int GIST_PACK1_FACTOR = 8;
 
+  // GistAuto compresses stashed float activations of at least this size (or of unknown size) 4x, and smaller ones 2x.
+  static constexpr int64_t GIST_AUTO_LARGE_ACTIVATION_BYTES = 1 << 20;
+
+  // GistPackMsfp15 shares an exponent between this many consecutive elements of the last dimension.
+  static constexpr int64_t GIST_MSFP15_TILE_SIZE = 8;
+
   mutable int priority_generator_ = INT32_MAX;
 
   // map stores GIST signature - source operator type to destination operator type(s)
   typedef std::vector<std::string> vector_t;
   const std::unordered_map<std::string, vector_t> PATTERN_MAP = {
-      {"Softmax", {"SoftmaxGrad"}},
+      {"Softmax", {"SoftmaxGrad", "SoftmaxGrad_13"}},
       {"Transpose", {"Transpose"}},
       {"Reshape", {"Reshape"}},
-      {"Add", {"LayerNormalizationGrad"}},
+      {"Add", {"LayerNormalizationGrad", "SimplifiedLayerNormalizationGrad", "GeluGrad", "FastGeluGrad"}},
       {"Dropout", {"Transpose", "Reshape", "DropoutGrad"}},
-      {"LayerNormalization", {"Reshape", "Shape", "LayerNormalizationGrad"}},
-      {"MatMul", {"Shape"}},
+      {"LayerNormalization", {"Reshape", "Shape", "LayerNormalizationGrad", "InvertibleLayerNormalizationGrad"}},
+      {"SimplifiedLayerNormalization", {"Reshape", "Shape", "SimplifiedLayerNormalizationGrad"}},
+      {"MatMul", {"Shape", "GeluGrad", "FastGeluGrad", "BiasGeluGrad_dX", "BiasFastGeluGrad_dX"}},
+      {"Gelu", {"Reshape", "Shape"}},
+      {"FastGelu", {"Reshape", "Shape"}},
+      {"BiasGelu", {"Reshape", "Shape"}},
       {"Relu", {"ReluGrad", "Shape", "Reshape"}}};
 
   GistEncodeDecode() noexcept : RewriteRule("GistEncodeDecode"), compression_type_() {}
@@ -41,6 +51,8 @@ class GistEncodeDecode : public RewriteRule {
   bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
   Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
   bool AddEncodeDecode(Graph& graph, Node& curr_node, std::string compression_type, const logging::Logger& logger) const;
+  // Picks the compression type of a stashed activation for GistAuto. Returns an empty string to leave it uncompressed.
+  static std::string SelectAutoCompressionType(const NodeArg& stashed_arg, const std::vector<std::pair<Node*, int>>& dst_nodes);
 
   const std::string compression_type_;
 };
@@ -21,6 +21,9 @@ struct TrainingGraphTransformerConfiguration : public GraphTransformerConfigurat
   bool transformer_layer_recompute{false};
   // Number of layers to apply recompute
   int number_recompute_layers{0};
+  // Budget in bytes of the activations stashed for the backward pass. When positive, activations are picked for
+  // recompute by their estimated recompute cost until the estimated stashed memory fits the budget.
+  int64_t recompute_memory_budget{0};
   bool allow_layer_norm_mod_precision{false};
 };
 
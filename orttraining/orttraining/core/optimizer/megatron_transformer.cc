@@ -29,10 +29,12 @@ struct OpInfo {
   size_t output_count;
 };
 
+const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v1 = {1};
 const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v1_13 = {1, 13};
 const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v1_11_13 = {1, 11, 13};
 const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v2_11_13 = {2, 11, 13};
 const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v5_13 = {5, 13};
+const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v6_13_14 = {6, 13, 14};
 const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v1_6_7_13_14 = {1, 6, 7, 13, 14};
 const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v7_13_14 = {7, 13, 14};
 const std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> opset_v9 = {9};
@@ -49,6 +51,10 @@ const OpInfo sub_info = OpInfo("Sub", opset_v7_13_14);
 const OpInfo softmax_info = OpInfo("Softmax", opset_v1_11_13);
 const OpInfo dropout_info = OpInfo("Dropout", opset_v12_13);
 const OpInfo where_info = OpInfo("Where", opset_v9);
+const OpInfo relu_info = OpInfo("Relu", opset_v6_13_14);
+const OpInfo gelu_info = OpInfo("Gelu", opset_v1, kMSDomain);
+const OpInfo fast_gelu_info = OpInfo("FastGelu", opset_v1, kMSDomain);
+const OpInfo bias_gelu_info = OpInfo("BiasGelu", opset_v1, kMSDomain);
 
 struct NodeInfo {
   NodeInfo(const std::vector<OpInfo>& op_infos,
@@ -102,6 +108,29 @@ static bool MatchLinearPattern(Graph& graph,
   return true;
 }
 
+// Walk up from the Reshape of a K/V head split to the projection MatMul, through the bias Add if there is one.
+// Returns nullptr if the producers don't match. Visited nodes are pushed back to sub_graph_node_ptrs, and the bias
+// Add to bias_add_node_ptrs.
+static Node* GetProjectionMatMul(Graph& graph,
+                                 const Node& reshape_node,
+                                 ProviderType provider_type,
+                                 InlinedVector<Node*>& sub_graph_node_ptrs,
+                                 InlinedVector<Node*>& bias_add_node_ptrs) {
+  Node* producer_ptr = const_cast<Node*>(graph.GetProducerNode(reshape_node.InputDefs()[0]->Name()));
+  if (producer_ptr != nullptr && IsExpectedOpAndProvider(*producer_ptr, add_info, provider_type)) {
+    sub_graph_node_ptrs.push_back(producer_ptr);
+    bias_add_node_ptrs.push_back(producer_ptr);
+    producer_ptr = const_cast<Node*>(graph.GetProducerNode(producer_ptr->InputDefs()[0]->Name()));
+  }
+
+  if (producer_ptr == nullptr || !IsExpectedOpAndProvider(*producer_ptr, matmul_info, provider_type)) {
+    return nullptr;
+  }
+
+  sub_graph_node_ptrs.push_back(producer_ptr);
+  return producer_ptr;
+}
+
 // std::hash only guarantee deterministic value in single execution of a program.
 // So use this simple hash to generate dropout seed by name.
 static uint32_t HashName(const std::string& name) {
@@ -383,92 +412,109 @@ bool MegatronTransformer::PartitionWeightByRow(const Graph& graph, const NodeArg
   return true;
 }
 
-Status MegatronTransformer::TransformGPT2MLP(Graph& graph, bool& modified,
-                                             InlinedVector<Node*>& nodes_to_clear_shape,
-                                             int32_t& counter,
-                                             NodeIndex node_index) const {
-  auto skip_status = common::Status(common::ONNXRUNTIME, common::NOT_IMPLEMENTED, "Skip BART Attention megatron transformation");
+// MLP sub-graph. The bias Adds and the Dropout are optional, and the activation may take the bias of the first
+// MatMul itself (BiasGelu, FastGelu), so that GPT2, GPT-NeoX and bias free T5 MLPs all match.
+// MatMul->[Add]->Gelu/FastGelu/BiasGelu/Relu->[Dropout]->MatMul->[Add]
+Status MegatronTransformer::TransformMLP(Graph& graph, bool& modified,
+                                         InlinedVector<Node*>& nodes_to_clear_shape,
+                                         InlinedHashSet<Node*>& dropout_nodes_to_transform,
+                                         int32_t& counter,
+                                         NodeIndex node_index) const {
+  auto skip_status = common::Status(common::ONNXRUNTIME, common::NOT_IMPLEMENTED, "Skip MLP megatron transformation");
 
   auto& node = *graph.GetNode(node_index);
 
-  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {9, 13}) ||
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", opset_v9_13) ||
       !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
       node.GetOutputEdgesCount() != 1) {
     return skip_status;
   }
 
-  if (node.GetInputEdgesCount() > 0) {
-    Node& matmul_input_node = const_cast<Node&>(*(node.InputNodesBegin()));
-    if (matmul_input_node.OpType().compare("MegatronF") == 0) {
-      return skip_status;
-    }
-  }
-
-  Node& add_node = *graph.GetNode(node.OutputNodesBegin()->Index());
-  if (!graph_utils::IsSupportedOptypeVersionAndDomain(add_node, "Add", {7, 13}) ||
-      add_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
-      add_node.GetOutputEdgesCount() != 1) {
+  if (node.GetInputEdgesCount() > 0 && node.InputNodesBegin()->OpType().compare("MegatronF") == 0) {
     return skip_status;
   }
 
-  Node& gelu_node = *graph.GetNode(add_node.OutputNodesBegin()->Index());
-  if (!(graph_utils::IsSupportedOptypeVersionAndDomain(gelu_node, "Gelu", {1}, kMSDomain) ||
-        graph_utils::IsSupportedOptypeVersionAndDomain(gelu_node, "FastGelu", {1}, kMSDomain)) ||
-      gelu_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
-      gelu_node.GetOutputEdgesCount() != 1) {
-    return skip_status;
-  }
+  InlinedVector<Node*> sub_graph_node_ptrs;
+  sub_graph_node_ptrs.push_back(&node);
+  ProviderType provider_type = node.GetExecutionProviderType();
 
-  Node& matmul2_node = *graph.GetNode(gelu_node.OutputNodesBegin()->Index());
-  if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul2_node, "MatMul", {9, 13}) ||
-      matmul2_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
-      matmul2_node.GetOutputEdgesCount() != 1) {
+  std::vector<NodeInfo> linear_pattern = {
+      NodeInfo({add_info}, false),  // -4
+      NodeInfo({gelu_info, fast_gelu_info, bias_gelu_info, relu_info}),
+      NodeInfo({dropout_info}, false),
+      NodeInfo({matmul_info})};  // -1
+  if (!MatchLinearPattern(graph, &node, provider_type, linear_pattern, sub_graph_node_ptrs)) {
     return skip_status;
   }
 
-  Node& add2_node = *graph.GetNode(matmul2_node.OutputNodesBegin()->Index());
-  if (!graph_utils::IsSupportedOptypeVersionAndDomain(add2_node, "Add", {7, 13}) ||
-      add2_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
-      add2_node.GetOutputEdgesCount() != 1) {
+  Node* add_node_ptr = sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 4];
+  Node& act_node = *sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 3];
+  Node* dropout_node_ptr = sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 2];
+  Node& matmul2_node = *sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 1];
+
+  // Weights behind a Transpose are left to the BART pattern.
+  auto a_weight_arg = node.MutableInputDefs()[1];
+  auto b_weight_arg = matmul2_node.MutableInputDefs()[1];
+  if (!graph_utils::IsInitializer(graph, a_weight_arg->Name(), true) ||
+      !graph_utils::IsInitializer(graph, b_weight_arg->Name(), true)) {
     return skip_status;
   }
 
-  nodes_to_clear_shape.insert(nodes_to_clear_shape.end(), {&node, &add_node, &gelu_node,
-                                                           &matmul2_node});
+  // The bias of the first MatMul, either added explicitly or fused into the activation.
+  InlinedVector<std::pair<Node*, NodeArg*>> a_bias_args;
+  if (add_node_ptr != nullptr) {
+    a_bias_args.push_back({add_node_ptr, add_node_ptr->MutableInputDefs()[1]});
+  }
+  if (act_node.InputDefs().size() > 1 && act_node.InputDefs()[1]->Exists()) {
+    a_bias_args.push_back({&act_node, act_node.MutableInputDefs()[1]});
+  }
 
-  auto a_weight_arg = node.MutableInputDefs()[1];
+  // Partition weights. If any of them fails, skip transforming this sub-graph.
   ONNX_NAMESPACE::TensorProto a_weight_initializer_partition;
   if (!PartitionWeightByColumn(graph, *a_weight_arg, a_weight_initializer_partition)) {
     return skip_status;
   }
 
-  auto a_bias_arg = add_node.MutableInputDefs()[1];
-  ONNX_NAMESPACE::TensorProto a_bias_initializer_partition;
-  if (!PartitionWeightByColumn(graph, *a_bias_arg, a_bias_initializer_partition)) {
-    return skip_status;
+  std::vector<ONNX_NAMESPACE::TensorProto> a_bias_initializer_partitions(a_bias_args.size());
+  for (size_t i = 0; i < a_bias_args.size(); ++i) {
+    if (!PartitionWeightByColumn(graph, *a_bias_args[i].second, a_bias_initializer_partitions[i])) {
+      return skip_status;
+    }
   }
 
-  auto b_weight_arg = matmul2_node.MutableInputDefs()[1];
   ONNX_NAMESPACE::TensorProto b_weight_initializer_partition;
   if (!PartitionWeightByRow(graph, *b_weight_arg, b_weight_initializer_partition)) {
     return skip_status;
   }
 
+  // Ready to transform the sub-graph when reach here.
+  // It's possible that the node vector contains nullptr due to some optinal node infos during linear pattern matching.
+  std::copy_if(sub_graph_node_ptrs.begin(), sub_graph_node_ptrs.end(),
+               std::back_inserter(nodes_to_clear_shape),
+               [](Node* node_ptr) { return node_ptr != nullptr; });
+
   NodeArg& a_weight_partition_arg = graph_utils::AddInitializer(graph, a_weight_initializer_partition);
   graph_utils::ReplaceNodeInput(node, 1, a_weight_partition_arg);
   updated_weight_names_.insert({a_weight_arg->Name(), a_weight_partition_arg.Name()});
+  graph.RemoveInitializedTensor(a_weight_arg->Name());
 
-  NodeArg& a_bias_partition_arg = graph_utils::AddInitializer(graph, a_bias_initializer_partition);
-  graph_utils::ReplaceNodeInput(add_node, 1, a_bias_partition_arg);
-  updated_weight_names_.insert({b_weight_arg->Name(), a_bias_partition_arg.Name()});
+  for (size_t i = 0; i < a_bias_args.size(); ++i) {
+    auto bias_name = a_bias_args[i].second->Name();
+    NodeArg& a_bias_partition_arg = graph_utils::AddInitializer(graph, a_bias_initializer_partitions[i]);
+    graph_utils::ReplaceNodeInput(*a_bias_args[i].first, 1, a_bias_partition_arg);
+    updated_weight_names_.insert({bias_name, a_bias_partition_arg.Name()});
+    graph.RemoveInitializedTensor(bias_name);
+  }
 
   NodeArg& b_weight_partition_arg = graph_utils::AddInitializer(graph, b_weight_initializer_partition);
   graph_utils::ReplaceNodeInput(matmul2_node, 1, b_weight_partition_arg);
-  updated_weight_names_.insert({a_bias_arg->Name(), b_weight_partition_arg.Name()});
-
-  graph.RemoveInitializedTensor(a_weight_arg->Name());
+  updated_weight_names_.insert({b_weight_arg->Name(), b_weight_partition_arg.Name()});
   graph.RemoveInitializedTensor(b_weight_arg->Name());
-  graph.RemoveInitializedTensor(a_bias_arg->Name());
+
+  // The Dropout runs on this rank's slice of the hidden units, so every rank needs its own seed.
+  if (dropout_node_ptr != nullptr) {
+    dropout_nodes_to_transform.insert(dropout_node_ptr);
+  }
 
   const std::array mlp_f_input_defs{node.MutableInputDefs()[0]};
   auto mlp_f_type_info = *node.MutableInputDefs()[0]->TypeAsProto();
@@ -662,8 +708,8 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
                                                    NodeIndex node_index) const {
   auto skip_status = common::Status(common::ONNXRUNTIME, common::NOT_IMPLEMENTED, "Skip BART Attention megatron transformation");
 
-  // Self attention sub-graph.
-  // MatMul->Add->Split->Reshape->Transpose->MatMul->Div->Mul->Sub->Softmax->Dropout->MatMul->Transpose->Reshape->MatMul->Add
+  // Self attention sub-graph, with the fused QKV projection optionally bias free.
+  // MatMul->[Add]->Split->Reshape->Transpose->MatMul->Div->Mul->Sub->Softmax->Dropout->MatMul->Transpose->Reshape->MatMul->Add
   //                  |->Reshape->Transpose->|                                        |
   //                  |->Reshape->Transpose------------------------------------------>|
 
@@ -683,7 +729,7 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
   ProviderType provider_type = node.GetExecutionProviderType();
 
   std::vector<NodeInfo> linear_pattern = {
-      NodeInfo({add_info}),  // -15
+      NodeInfo({add_info}, false),  // -15
       NodeInfo({split_info}),
       NodeInfo({reshape_info}),
       NodeInfo({transpose_info}),
@@ -703,7 +749,7 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
   }
 
   // Get all useful nodes here as more vector push back below will change the index.
-  Node& add_node = *sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 15];
+  Node* add_node_ptr = sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 15];
   Node& split_node = *sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 14];
   Node& k_transpose_after_reshape_node = *sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 12];
   Node* matmul_node_ptr = sub_graph_node_ptrs[sub_graph_node_ptrs.size() - 11];
@@ -757,9 +803,9 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
     return skip_status;
   }
 
-  auto qkv_bias_arg = add_node.MutableInputDefs()[1];
+  NodeArg* qkv_bias_arg = add_node_ptr != nullptr ? add_node_ptr->MutableInputDefs()[1] : nullptr;
   ONNX_NAMESPACE::TensorProto qkv_bias_initializer_partition;
-  if (!PartitionWeightByColumn(graph, *qkv_bias_arg, qkv_bias_initializer_partition, 3)) {
+  if (qkv_bias_arg != nullptr && !PartitionWeightByColumn(graph, *qkv_bias_arg, qkv_bias_initializer_partition, 3)) {
     return skip_status;
   }
 
@@ -819,16 +865,18 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
   graph_utils::ReplaceNodeInput(node, 1, qkv_weight_partition_arg);
   updated_weight_names_.insert({qkv_weight_arg->Name(), qkv_weight_partition_arg.Name()});
 
-  NodeArg& qkv_bias_partition_arg = graph_utils::AddInitializer(graph, qkv_bias_initializer_partition);
-  graph_utils::ReplaceNodeInput(add_node, 1, qkv_bias_partition_arg);
-  updated_weight_names_.insert({qkv_bias_arg->Name(), qkv_bias_partition_arg.Name()});
+  if (qkv_bias_arg != nullptr) {
+    NodeArg& qkv_bias_partition_arg = graph_utils::AddInitializer(graph, qkv_bias_initializer_partition);
+    graph_utils::ReplaceNodeInput(*add_node_ptr, 1, qkv_bias_partition_arg);
+    updated_weight_names_.insert({qkv_bias_arg->Name(), qkv_bias_partition_arg.Name()});
+    graph.RemoveInitializedTensor(qkv_bias_arg->Name());
+  }
 
   NodeArg& dense_weight_partition_arg = graph_utils::AddInitializer(graph, dense_weight_initializer_partition);
   graph_utils::ReplaceNodeInput(matmul_node, 1, dense_weight_partition_arg);
   updated_weight_names_.insert({dense_weight_arg->Name(), dense_weight_partition_arg.Name()});
 
   graph.RemoveInitializedTensor(qkv_weight_arg->Name());
-  graph.RemoveInitializedTensor(qkv_bias_arg->Name());
   graph.RemoveInitializedTensor(dense_weight_arg->Name());
 
   // Change the constant for the reshape nodes.
@@ -901,11 +949,12 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
                                                    NodeIndex node_index) const {
   auto skip_status = common::Status(common::ONNXRUNTIME, common::NOT_IMPLEMENTED, "Skip BART Attention megatron transformation");
 
-  // Self/Enc-Dec Attention sub-graph.
+  // Self/Enc-Dec Attention sub-graph. The Q/K/V bias Adds and the query scaling are optional, so that attention
+  // with bias free projections matches as well.
   //
-  // MatMul->Add->Mul->Reshape->Transpose->MatMul->Reshape->Where->Reshape->Softmax->Dropout->MatMul->Transpose->Reshape->MatMul->Add->Droupout
-  // MatMul->Add->Reshape->Transpose-------> |                                                  |
-  // MatMul->Add->Reshape->Transpose----------------------------------------------------------> |
+  // MatMul->[Add]->[Mul]->Reshape->Transpose->MatMul->Reshape->Where->Reshape->Softmax->Dropout->MatMul->Transpose->Reshape->MatMul->Add->Droupout
+  // MatMul->[Add]->Reshape->Transpose-------> |                                                  |
+  // MatMul->[Add]->Reshape->Transpose----------------------------------------------------------> |
   auto& node = *graph.GetNode(node_index);
 
   if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", opset_v9_13) ||
@@ -923,8 +972,8 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
   ProviderType provider_type = node.GetExecutionProviderType();
 
   std::vector<NodeInfo> linear_pattern = {
-      NodeInfo({add_info}),
-      NodeInfo({mul_info}),
+      NodeInfo({add_info}, false),  // -18
+      NodeInfo({mul_info}, false),
       NodeInfo({reshape_info}),
       NodeInfo({transpose_info}),
       NodeInfo({matmul_info}),
@@ -977,7 +1026,9 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
   }
   weight_transpose_node_ptrs.push_back(q_transpose_ptr);
   sub_graph_node_ptrs.push_back(q_transpose_ptr);
-  bias_add_node_ptrs.push_back(q_biasadd_node_ptr);
+  if (q_biasadd_node_ptr != nullptr) {
+    bias_add_node_ptrs.push_back(q_biasadd_node_ptr);
+  }
 
   Node* k_transpose_ptr = const_cast<Node*>(graph.GetProducerNode(qk_matmul_node_ptr->MutableInputDefs()[1]->Name()));
   if (k_transpose_ptr == nullptr || !IsExpectedOpAndProvider(*k_transpose_ptr, transpose_info, provider_type)) {
@@ -992,15 +1043,8 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
   reshape_node_ptrs[k_reshape_ptr] = 1;
   sub_graph_node_ptrs.push_back(k_reshape_ptr);
 
-  Node* k_add_ptr = const_cast<Node*>(graph.GetProducerNode(k_reshape_ptr->MutableInputDefs()[0]->Name()));
-  if (k_add_ptr == nullptr || !IsExpectedOpAndProvider(*k_add_ptr, add_info, provider_type)) {
-    return skip_status;
-  }
-  sub_graph_node_ptrs.push_back(k_add_ptr);
-  bias_add_node_ptrs.push_back(k_add_ptr);
-
-  Node* k_matmul_ptr = const_cast<Node*>(graph.GetProducerNode(k_add_ptr->MutableInputDefs()[0]->Name()));
-  if (k_matmul_ptr == nullptr || !IsExpectedOpAndProvider(*k_matmul_ptr, matmul_info, provider_type)) {
+  Node* k_matmul_ptr = GetProjectionMatMul(graph, *k_reshape_ptr, provider_type, sub_graph_node_ptrs, bias_add_node_ptrs);
+  if (k_matmul_ptr == nullptr) {
     return skip_status;
   }
   sub_graph_node_ptrs.push_back(k_matmul_ptr);
@@ -1025,15 +1069,8 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
   reshape_node_ptrs[v_reshape_ptr] = 1;
   sub_graph_node_ptrs.push_back(v_reshape_ptr);
 
-  Node* v_add_ptr = const_cast<Node*>(graph.GetProducerNode(v_reshape_ptr->MutableInputDefs()[0]->Name()));
-  if (v_add_ptr == nullptr || !IsExpectedOpAndProvider(*v_add_ptr, add_info, provider_type)) {
-    return skip_status;
-  }
-  sub_graph_node_ptrs.push_back(v_add_ptr);
-  bias_add_node_ptrs.push_back(v_add_ptr);
-
-  Node* v_matmul_ptr = const_cast<Node*>(graph.GetProducerNode(v_add_ptr->MutableInputDefs()[0]->Name()));
-  if (k_matmul_ptr == nullptr || !IsExpectedOpAndProvider(*k_matmul_ptr, matmul_info, provider_type)) {
+  Node* v_matmul_ptr = GetProjectionMatMul(graph, *v_reshape_ptr, provider_type, sub_graph_node_ptrs, bias_add_node_ptrs);
+  if (v_matmul_ptr == nullptr) {
     return skip_status;
   }
   sub_graph_node_ptrs.push_back(v_matmul_ptr);
@@ -1285,7 +1322,8 @@ Status MegatronTransformer::DoTransform(Graph& graph, bool& modified, int graph_
       continue;
     }
 
-    ret = TransformGPT2MLP(graph, modified, nodes_to_clear_shape, counters[i++], node_index);
+    ret = TransformMLP(graph, modified, nodes_to_clear_shape,
+                       dropout_nodes_to_transform, counters[i++], node_index);
     if (ret.Code() != common::NOT_IMPLEMENTED) {
       ORT_ENFORCE(ret.IsOK());
       continue;
@@ -1308,7 +1346,7 @@ Status MegatronTransformer::DoTransform(Graph& graph, bool& modified, int graph_
 
   LOGS_DEFAULT(WARNING) << "Megatron transformer result : Partitioned "
                         << counters[0] << " GPT2 Attention Blocks, "
-                        << counters[1] << " GPT2 MLP Blocks, "
+                        << counters[1] << " MLP Blocks, "
                         << counters[2] << " BART Attention Blocks, "
                         << counters[3] << " BART MLP Blocks.";
 
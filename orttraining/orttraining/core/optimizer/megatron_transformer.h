@@ -31,12 +31,14 @@ class MegatronTransformer : public GraphTransformer {
                    const logging::Logger& logger) const override;
 
  private:
-  // GPT2 Pattern Match
-  Status TransformGPT2MLP(Graph& graph, bool& modified,
-                          InlinedVector<Node*>& nodes_to_clear_shape,
-                          int32_t& counter,
-                          NodeIndex node_index) const;
+  // MLP Pattern Match, covering GPT2, GPT-NeoX and T5 style MLPs
+  Status TransformMLP(Graph& graph, bool& modified,
+                      InlinedVector<Node*>& nodes_to_clear_shape,
+                      InlinedHashSet<Node*>& dropout_nodes_to_transform,
+                      int32_t& counter,
+                      NodeIndex node_index) const;
 
+  // GPT2 Pattern Match
   Status TransformGPT2Attention(Graph& graph, bool& modified,
                                 InlinedVector<Node*>& nodes_to_clear_shape,
                                 InlinedHashSet<Node*>& dropout_nodes_to_transform,
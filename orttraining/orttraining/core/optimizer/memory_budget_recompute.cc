@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "orttraining/core/graph/recompute_graph_utils.h"
+#include "orttraining/core/optimizer/dropout_recompute.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+struct RecomputableOp {
+  std::string_view domain;
+  // Relative cost of recomputing one element of the output.
+  int64_t cost;
+};
+
+// Ops whose first output can be recomputed from their inputs. Dropout is recomputed from its mask with DropoutGrad.
+const InlinedHashMap<std::string_view, RecomputableOp>& RecomputableOps() {
+  static const InlinedHashMap<std::string_view, RecomputableOp> ops = {
+      {"Add", {kOnnxDomain, 1}},
+      {"Sub", {kOnnxDomain, 1}},
+      {"Mul", {kOnnxDomain, 1}},
+      {"Div", {kOnnxDomain, 1}},
+      {"Cast", {kOnnxDomain, 1}},
+      {"Relu", {kOnnxDomain, 1}},
+      {"Dropout", {kOnnxDomain, 1}},
+      {"Sigmoid", {kOnnxDomain, 2}},
+      {"Tanh", {kOnnxDomain, 2}},
+      {"Gelu", {kMSDomain, 4}},
+      {"FastGelu", {kMSDomain, 4}},
+      {"BiasGelu", {kMSDomain, 4}},
+  };
+  return ops;
+}
+
+// Ops whose gradient reads their inputs, so an activation consumed by one of them is stashed for the backward pass.
+bool IsInputStashingOp(const Node& node) {
+  static const InlinedHashSet<std::string_view> op_types = {
+      "MatMul", "FusedMatMul", "Gemm", "Conv", "Mul", "Div",
+      "LayerNormalization", "SimplifiedLayerNormalization", "Gelu", "FastGelu", "BiasGelu"};
+  return op_types.find(node.OpType()) != op_types.end();
+}
+
+// Returns the number of elements of the tensor, or -1 if its shape is not fully known.
+int64_t GetElementCount(const NodeArg& node_arg) {
+  const TensorShapeProto* shape = node_arg.Shape();
+  if (shape == nullptr) {
+    return -1;
+  }
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return -1;
+    }
+  }
+  return utils::GetTensorShapeFromTensorShapeProto(*shape).Size();
+}
+
+// Returns the size in bytes of the tensor, or -1 if its type or shape is not known.
+int64_t GetSizeInBytes(const NodeArg& node_arg) {
+  const TypeProto* type = node_arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() ||
+      type->tensor_type().elem_type() == TensorProto_DataType_UNDEFINED) {
+    return -1;
+  }
+
+  const int64_t element_count = GetElementCount(node_arg);
+  if (element_count < 0) {
+    return -1;
+  }
+
+  const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType();
+  return element_count * static_cast<int64_t>(element_type->Size());
+}
+
+bool CanRecompute(const Graph& graph, const Node& node) {
+  auto op = RecomputableOps().find(node.OpType());
+  if (op == RecomputableOps().end() || op->second.domain != node.Domain() || !node.ImplicitInputDefs().empty()) {
+    return false;
+  }
+
+  // InsertDropoutRecompute() needs the ratio, the training mode and the mask.
+  if (node.OpType() == "Dropout" &&
+      (node.InputDefs().size() < 3 || node.OutputDefs().size() < 2 || !node.OutputDefs()[1]->Exists())) {
+    return false;
+  }
+
+  const NodeArg* output = node.OutputDefs()[0];
+  if (graph.IsOutput(output) || graph.GetNodeArg(graph_utils::RecomputeName(output->Name())) != nullptr) {
+    return false;
+  }
+
+  const auto consumers = graph.GetConsumerNodes(output->Name());
+  return std::any_of(consumers.begin(), consumers.end(),
+                     [](const Node* consumer) { return IsInputStashingOp(*consumer); });
+}
+
+}  // namespace
+
+Status MemoryBudgetRecompute::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                        const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_ids = graph_viewer.GetNodesInTopologicalOrder();
+
+  struct Candidate {
+    size_t order;
+    Node* node;
+    int64_t bytes;
+    double cost_per_byte;
+  };
+
+  // Every activation consumed by another node is counted as stashed for the backward pass. This overestimates the
+  // memory of the activations that no gradient reads, which only makes the plan more conservative.
+  int64_t activation_bytes = 0;
+  std::vector<Candidate> candidates;
+  for (size_t i = 0; i < node_ids.size(); ++i) {
+    Node* node = graph.GetNode(node_ids[i]);
+    if (node == nullptr) {
+      continue;
+    }
+
+    for (const NodeArg* output : node->OutputDefs()) {
+      if (!output->Exists() || graph.IsOutput(output) || graph.GetConsumerNodes(output->Name()).empty() ||
+          graph.GetNodeArg(graph_utils::RecomputeName(output->Name())) != nullptr) {
+        continue;
+      }
+      const int64_t bytes = GetSizeInBytes(*output);
+      if (bytes > 0) {
+        activation_bytes += bytes;
+      }
+    }
+
+    if (!CanRecompute(graph, *node)) {
+      continue;
+    }
+
+    const NodeArg& output = *node->OutputDefs()[0];
+    const int64_t bytes = GetSizeInBytes(output);
+    if (bytes <= 0) {
+      continue;
+    }
+    const int64_t cost = GetElementCount(output) * RecomputableOps().at(node->OpType()).cost;
+    candidates.push_back({i, node, bytes, static_cast<double>(cost) / static_cast<double>(bytes)});
+  }
+
+  if (activation_bytes <= memory_budget_) {
+    LOGS(logger, INFO) << "MemoryBudgetRecompute: the estimated " << activation_bytes
+                       << " bytes of stashed activations fit the budget of " << memory_budget_ << " bytes";
+    return Status::OK();
+  }
+
+  // The cheapest activations to recompute per byte saved go first. The stable sort keeps ties in topological order.
+  std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    return a.cost_per_byte < b.cost_per_byte;
+  });
+
+  // The recompute nodes read the original inputs, which are therefore stashed. Recomputing one of them would save
+  // nothing, and a recompute node cannot read the output of another one, which does not exist yet.
+  InlinedHashSet<const NodeArg*> recompute_inputs;
+  InlinedHashSet<const NodeArg*> recomputed_outputs;
+  std::vector<const Candidate*> selected;
+  for (const auto& candidate : candidates) {
+    if (activation_bytes <= memory_budget_) {
+      break;
+    }
+
+    const NodeArg* output = candidate.node->OutputDefs()[0];
+    const auto& inputs = candidate.node->InputDefs();
+    if (recompute_inputs.count(output) > 0 ||
+        std::any_of(inputs.begin(), inputs.end(),
+                    [&](const NodeArg* input) { return recomputed_outputs.count(input) > 0; })) {
+      continue;
+    }
+
+    recompute_inputs.insert(inputs.begin(), inputs.end());
+    recomputed_outputs.insert(output);
+    selected.push_back(&candidate);
+    activation_bytes -= candidate.bytes;
+  }
+
+  // Add the recompute nodes from the bottom of the graph, so that the ones of lower layers are executed earlier.
+  std::sort(selected.begin(), selected.end(),
+            [](const Candidate* a, const Candidate* b) { return a->order > b->order; });
+
+  for (const Candidate* candidate : selected) {
+    Node& node = *candidate->node;
+    if (node.OpType() == "Dropout") {
+      Node& recompute_node = InsertDropoutRecompute(graph, node, /*use_original_input*/ true);
+      recompute_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+    } else {
+      const auto& output = node.OutputDefs()[0];
+      auto& recomputed_output = graph.GetOrCreateNodeArg(graph_utils::RecomputeName(output->Name()),
+                                                         output->TypeAsProto());
+
+      Node& recompute_node = graph.AddNode(node.Name() + "_recompute",
+                                           node.OpType(),
+                                           "Recompute of " + node.Name(),
+                                           node.MutableInputDefs(),
+                                           {&recomputed_output},
+                                           &node.GetAttributes(),
+                                           node.Domain());
+      recompute_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+    }
+
+    modified = true;
+  }
+
+  if (activation_bytes > memory_budget_) {
+    LOGS(logger, WARNING) << "MemoryBudgetRecompute: recomputing " << selected.size()
+                          << " activations leaves an estimated " << activation_bytes
+                          << " bytes of stashed activations, which exceeds the budget of " << memory_budget_
+                          << " bytes";
+  } else {
+    LOGS(logger, INFO) << "MemoryBudgetRecompute: recomputing " << selected.size()
+                       << " activations brings the estimated stashed activations to " << activation_bytes
+                       << " bytes, within the budget of " << memory_budget_ << " bytes";
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MemoryBudgetRecompute
+
+Plans which activations to recompute in the backward pass so that the activations kept for it fit a memory budget.
+
+The memory of each activation stashed for the backward pass and the cost of recomputing it are estimated from its
+shape, so the graph must have concrete shapes, as ORTModule graphs do. Recomputable activations are then picked by
+increasing recompute cost per byte until the estimated stashed memory is within the budget. The recompute nodes
+produce the graph_utils::RecomputeName() of the activations, which the gradient builders use in their place, so
+this transformer must run before the gradient graph is built.
+
+*/
+class MemoryBudgetRecompute : public GraphTransformer {
+ public:
+  // memory_budget is in bytes.
+  explicit MemoryBudgetRecompute(int64_t memory_budget) noexcept
+      : GraphTransformer("MemoryBudgetRecompute"), memory_budget_(memory_budget) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  int64_t memory_budget_;
+};
+
+}  // namespace onnxruntime
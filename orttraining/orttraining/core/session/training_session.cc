@@ -6,6 +6,7 @@
 #include "core/framework/data_transfer_utils.h"
 #include "core/graph/model.h"
 #include "core/session/IOBinding.h"
+#include "core/optimizer/propagate_cast_ops.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
@@ -54,6 +55,8 @@ Status SetupOptimizerParams(
     std::unordered_map<std::string, std::string>& weight_name_map_after_graph_transform) {
   ORT_RETURN_IF_NOT(config.optimizer_config.has_value(), "config.optimizer_config.has_value() was false");
   const auto& optimizer_config = config.optimizer_config.value();
+  ORT_RETURN_IF(optimizer_config.offload_optimizer_states && optimizer_config.name != "AdamOptimizer",
+                "Offloading the optimizer states is only supported with AdamOptimizer.");
 
   // This is the mapping from the new weight name to the original weight name
   // It is required to look up the optimizer config for the original weight
@@ -88,6 +91,7 @@ Status SetupOptimizerParams(
     opt_node_config.loss_scale_input_name =
         loss_scale_input_name.has_value() ? loss_scale_input_name.value() : "";
     opt_node_config.use_mixed_precision_moments = optimizer_config.use_mixed_precision_moments;
+    opt_node_config.offload_states = optimizer_config.offload_optimizer_states;
 
     const auto mixed_precision_weight_name_it = fp32_weight_names_to_mixed_precision_node_args.find(weight_name);
     if (mixed_precision_weight_name_it != fp32_weight_names_to_mixed_precision_node_args.end()) {
@@ -122,6 +126,8 @@ Status SetupOptimizerParams(
   opt_graph_config.adasum_reduction_type = optimizer_config.adasum_reduction_type;
   opt_graph_config.enable_grad_norm_clip = optimizer_config.enable_grad_norm_clip;
   opt_graph_config.deepspeed_zero = optimizer_config.deepspeed_zero;
+  opt_graph_config.allreduce_bucket_size = optimizer_config.allreduce_bucket_size;
+  opt_graph_config.compress_allreduce = optimizer_config.compress_allreduce;
 
   // check if shared initial optimizer states have been provided
   const auto optim_state_it = init_optimizer_states.find(onnxruntime::training::SHARED_OPTIMIZER_STATES_KEY);
@@ -459,6 +465,7 @@ Status TrainingSession::ConfigureForTraining(
     const auto& mixed_precision_config = config.mixed_precision_config.value();
     ORT_RETURN_IF_ERROR(EnableMixedPrecision(weight_names_to_train,
                                              mixed_precision_config,
+                                             config.graph_transformer_config.propagate_cast_ops_config,
                                              fp32_weight_name_to_mixed_precision_node_arg));
   }
 
@@ -871,6 +878,7 @@ Status TrainingSession::ConfigureLossFunction(
 Status TrainingSession::EnableMixedPrecision(
     const std::unordered_set<std::string>& weights_to_train,
     const TrainingConfiguration::MixedPrecisionConfiguration& mixed_precision_config,
+    const GraphTransformerConfiguration::PropagateCastOpsConfiguration& propagate_cast_ops_config,
     std::unordered_map<std::string, NodeArg*>& fp32_weight_name_to_mixed_precision_node_arg) {
   ORT_RETURN_IF_ERROR(TransformGraphForMixedPrecision(
       model_->MainGraph(),
@@ -878,7 +886,20 @@ Status TrainingSession::EnableMixedPrecision(
       mixed_precision_config.use_mixed_precision_initializers,
       mixed_precision_config.TensorProtoDataType(),
       fp32_weight_name_to_mixed_precision_node_arg,
-      mixed_precision_config.layernorm_stash_as_fp32));
+      mixed_precision_config.layernorm_stash_as_fp32,
+      mixed_precision_config.fp32_op_types,
+      mixed_precision_config.activation_max_abs));
+
+  // The pre-training PropagateCastOps pass runs before the casts above exist, so run it again to move and remove
+  // them. Nodes are not assigned to execution providers yet, hence no compatible provider filter.
+  if (mixed_precision_config.propagate_cast_ops && propagate_cast_ops_config.level >= 0 &&
+      mixed_precision_config.mixed_precision_type == MixedPrecisionDataType::FP16) {
+    PropagateCastOps propagate_cast_ops(propagate_cast_ops_config.strategy,
+                                        static_cast<size_t>(propagate_cast_ops_config.level),
+                                        propagate_cast_ops_config.allow);
+    bool modified = false;
+    ORT_RETURN_IF_ERROR(propagate_cast_ops.Apply(model_->MainGraph(), modified, *session_logger_));
+  }
 
   std::unordered_map<std::string, std::string> weight_to_mixed_precision_map{};
   std::transform(
@@ -949,6 +970,26 @@ Status TrainingSession::BuildOptimizer(
                                              weight_partition_info_,
                                              weight_to_opt_mapping_));
 
+  // Offloaded optimizers, and the casts of their new weights, run on CPU next to their states.
+  // The partitioner keeps these assignments and the memcpy transformer adds the copies from and to the device.
+  const bool offload_optimizer_states =
+      std::any_of(opt_configs_.cbegin(), opt_configs_.cend(),
+                  [](const std::pair<const std::string, OptimizerNodeConfig>& kv) { return kv.second.offload_states; });
+  if (offload_optimizer_states) {
+    for (auto& node : model_->MainGraph().Nodes()) {
+      if (node.OpType() != "AdamOptimizer") {
+        continue;
+      }
+
+      node.SetExecutionProviderType(kCpuExecutionProvider);
+      for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+        if (it->OpType() == "Cast") {
+          model_->MainGraph().GetNode(it->Index())->SetExecutionProviderType(kCpuExecutionProvider);
+        }
+      }
+    }
+  }
+
   return DoPostLoadProcessing(*model_);
 }
 
@@ -116,6 +116,17 @@ class TrainingSession : public InferenceSession {
 
       bool layernorm_stash_as_fp32{true};
 
+      // Op types to keep in FP32 in addition to the built-in ones, e.g. {"Softmax", "ReduceSum"}.
+      std::unordered_set<std::string> fp32_op_types{};
+
+      // Max absolute value per tensor name from an FP32 profiling run. With FP16, nodes whose outputs
+      // exceed the FP16 safe range are kept in FP32. Not used with BF16, which has the FP32 exponent range.
+      std::unordered_map<std::string, float> activation_max_abs{};
+
+      // Whether to run PropagateCastOps with the graph transformer configuration's settings on the transformed
+      // graph, to fuse and remove the inserted casts. FP16 only.
+      bool propagate_cast_ops{false};
+
       ONNX_NAMESPACE::TensorProto_DataType TensorProtoDataType() const {
         switch (mixed_precision_type) {
           case MixedPrecisionDataType::FP16:
@@ -145,9 +156,11 @@ class TrainingSession : public InferenceSession {
 
     struct GistConfiguration {
       // The operator type to which GIST is applied. Valid Values - 1 (Softmax), 2 (Transpose), 3 (Reshape),
-      // 4 (Add), 5 (Dropout), 6 (LayerNormalization), 7 (MatMul), 8 (Relu), 9 (All the above)
+      // 4 (Add), 5 (Dropout), 6 (LayerNormalization), 7 (MatMul), 8 (Relu), 9 (All operator types),
+      // 10 (Gelu, FastGelu, BiasGelu), 11 (SimplifiedLayerNormalization)
       int op_type{};
-      // The compression type used for GIST. Valid values - GistBinarize, GistPack1, GistPack8, GistPack16, GistPackMsfp15
+      // The compression type used for GIST. Valid values - GistBinarize, GistPack1, GistPack8, GistPack16, GistPackMsfp15,
+      // GistAuto (picked per stashed activation from its consumers, element type and size)
       std::string compr_type{};
     };
     // The GIST configuration.
@@ -192,6 +205,13 @@ class TrainingSession : public InferenceSession {
       AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
       // Whether to enable gradient clipping.
       bool enable_grad_norm_clip{true};
+      // Size in bytes of the buckets of gradients to all-reduce together. 0 all-reduces all the gradients at once.
+      int64_t allreduce_bucket_size{0};
+      // Whether to all-reduce the gradients as int8 with error feedback.
+      bool compress_allreduce{false};
+      // Whether to keep the moments and FP32 weights in CPU memory and update them with the CPU optimizer kernel.
+      // Only the new weights are copied back to the device. Supported with AdamOptimizer.
+      bool offload_optimizer_states{false};
     };
     // The optimizer configuration.
     // If not provided, no optimizer is added.
@@ -534,6 +554,7 @@ class TrainingSession : public InferenceSession {
   */
   common::Status EnableMixedPrecision(const std::unordered_set<std::string>& weights_to_train,
                                       const TrainingConfiguration::MixedPrecisionConfiguration& mixed_precision_config,
+                                      const GraphTransformerConfiguration::PropagateCastOpsConfiguration& propagate_cast_ops_config,
                                       std::unordered_map<std::string, NodeArg*>& fp32_weight_name_to_mixed_precision_node_arg);
 
   /** Discover all trainable initializers by reverse DFS starting from a given tensor (for example, the loss value)
@@ -132,6 +132,8 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("checkpoint_period", "How many weight-update steps to run before saving a model checkpoint.", cxxopts::value<size_t>()->default_value("1000"))
       ("max_num_checkpoints", "Maximum number of checkpoint files to maintain.",
         cxxopts::value<size_t>()->default_value("10"))
+      ("async_checkpoint", "Whether to write the checkpoint files in the background while training continues.",
+        cxxopts::value<bool>()->default_value("false"))
       ("gradient_accumulation_steps_phase2", "The number of gradient accumulation steps before performing a backward/update pass in phase 2.",
         cxxopts::value<int>()->default_value("1"))
       ("iterations_per_loop", "How many steps to make in each estimator call.", cxxopts::value<int>()->default_value("1000"))
@@ -286,6 +288,7 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     params.display_loss_steps = flags["display_loss_steps"].as<size_t>();
     params.checkpoint_period = flags["checkpoint_period"].as<size_t>();
     params.max_num_checkpoints = flags["max_num_checkpoints"].as<size_t>();
+    params.async_checkpoint = flags["async_checkpoint"].as<bool>();
 
     params.use_nccl = flags["use_nccl"].as<bool>();
     params.enable_adasum = flags["enable_adasum"].as<bool>();
@@ -891,6 +891,9 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
           PathString new_checkpoint_path, old_checkpoint_path;
           bool should_remove_old_checkpoint;
 
+          // the previous checkpoint may still be written, and may be the one to replace
+          ORT_RETURN_IF_ERROR(checkpoint_writer_.Wait());
+
           ORT_RETURN_IF_ERROR(checkpoint_registry_->AddCheckpoint(
               weight_update_step_count_, new_checkpoint_path,
               should_remove_old_checkpoint, old_checkpoint_path));
@@ -922,6 +925,7 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
 
     ++epoch;
   }
+  ORT_RETURN_IF_ERROR(checkpoint_writer_.Wait());
   auto all_steps_time_end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> all_steps_duration_seconds = all_steps_time_end - all_steps_time_start;
 
@@ -1212,9 +1216,15 @@ Status TrainingRunner::SaveCheckpoint(const PathString& checkpoint_path) {
   std::unordered_map<std::string, std::string> checkpointed_properties{};
   ORT_RETURN_IF_ERROR(SaveCheckpointProperties(checkpointed_properties));
 
-  ORT_RETURN_IF_ERROR(SaveModelCheckpoint(
-      checkpoint_path, session_.GetDataTransferManager(),
-      checkpointed_tensors, checkpointed_properties));
+  if (params_.async_checkpoint) {
+    ORT_RETURN_IF_ERROR(checkpoint_writer_.Save(
+        checkpoint_path, session_.GetDataTransferManager(),
+        checkpointed_tensors, checkpointed_properties));
+  } else {
+    ORT_RETURN_IF_ERROR(SaveModelCheckpoint(
+        checkpoint_path, session_.GetDataTransferManager(),
+        checkpointed_tensors, checkpointed_properties));
+  }
 
   return Status::OK();
 }
@@ -87,6 +87,10 @@ struct TrainingParameters {
   bool use_fp16_moments = false;
 
   bool use_mixed_precision = false;
+  bool use_bfloat16 = false;
+  std::unordered_set<std::string> mixed_precision_fp32_op_types;
+  std::unordered_map<std::string, float> mixed_precision_activation_max_abs;
+  bool mixed_precision_propagate_cast_ops = false;
   bool allreduce_post_accumulation = false;
   float loss_scale = 0.0f;
   int world_rank = 0;
@@ -100,6 +104,9 @@ struct TrainingParameters {
   int num_pipeline_micro_batches = 1;
   int deepspeed_zero_stage = 0;
   bool enable_grad_norm_clip = true;
+  int64_t allreduce_bucket_size = 0;
+  bool compress_allreduce = false;
+  bool offload_optimizer_states = false;
   bool set_gradients_as_graph_outputs = false;
   bool use_memory_efficient_gradient = false;
 
@@ -180,6 +187,11 @@ TrainingConfigurationResult ConfigureSessionForTraining(
   if (parameters.use_mixed_precision) {
     training::PipelineTrainingSession::TrainingConfiguration::MixedPrecisionConfiguration mp{};
     mp.use_mixed_precision_initializers = true;
+    mp.mixed_precision_type = parameters.use_bfloat16 ? training::MixedPrecisionDataType::BF16
+                                                      : training::MixedPrecisionDataType::FP16;
+    mp.fp32_op_types = parameters.mixed_precision_fp32_op_types;
+    mp.activation_max_abs = parameters.mixed_precision_activation_max_abs;
+    mp.propagate_cast_ops = parameters.mixed_precision_propagate_cast_ops;
 
     config.mixed_precision_config = mp;
   }
@@ -266,6 +278,9 @@ TrainingConfigurationResult ConfigureSessionForTraining(
     opt.use_nccl = parameters.allreduce_post_accumulation;
     opt.deepspeed_zero = onnxruntime::training::ZeROConfig(parameters.deepspeed_zero_stage);
     opt.enable_grad_norm_clip = parameters.enable_grad_norm_clip;
+    opt.allreduce_bucket_size = parameters.allreduce_bucket_size;
+    opt.compress_allreduce = parameters.compress_allreduce;
+    opt.offload_optimizer_states = parameters.offload_optimizer_states;
 
     // TODO reduction types
     if (parameters.enable_adasum) {
@@ -418,6 +433,10 @@ void addObjectMethodsForTraining(py::module& m, ExecutionProviderRegistrationFn
       .def_readwrite("sliced_axes", &TrainingParameters::sliced_axes)
       .def_readwrite("use_fp16_moments", &TrainingParameters::use_fp16_moments)
       .def_readwrite("use_mixed_precision", &TrainingParameters::use_mixed_precision)
+      .def_readwrite("use_bfloat16", &TrainingParameters::use_bfloat16)
+      .def_readwrite("mixed_precision_fp32_op_types", &TrainingParameters::mixed_precision_fp32_op_types)
+      .def_readwrite("mixed_precision_activation_max_abs", &TrainingParameters::mixed_precision_activation_max_abs)
+      .def_readwrite("mixed_precision_propagate_cast_ops", &TrainingParameters::mixed_precision_propagate_cast_ops)
       .def_readwrite("allreduce_post_accumulation", &TrainingParameters::allreduce_post_accumulation)
       .def_readwrite("loss_scale", &TrainingParameters::loss_scale)
       .def_readwrite("world_rank", &TrainingParameters::world_rank)
@@ -430,6 +449,9 @@ void addObjectMethodsForTraining(py::module& m, ExecutionProviderRegistrationFn
       .def_readwrite("gradient_accumulation_steps", &TrainingParameters::gradient_accumulation_steps)
       .def_readwrite("deepspeed_zero_stage", &TrainingParameters::deepspeed_zero_stage)
       .def_readwrite("enable_grad_norm_clip", &TrainingParameters::enable_grad_norm_clip)
+      .def_readwrite("allreduce_bucket_size", &TrainingParameters::allreduce_bucket_size)
+      .def_readwrite("compress_allreduce", &TrainingParameters::compress_allreduce)
+      .def_readwrite("offload_optimizer_states", &TrainingParameters::offload_optimizer_states)
       .def_readwrite("set_gradients_as_graph_outputs", &TrainingParameters::set_gradients_as_graph_outputs)
       .def_readwrite("use_memory_efficient_gradient", &TrainingParameters::use_memory_efficient_gradient)
       .def_readwrite("attn_dropout_recompute", &TrainingParameters::attn_dropout_recompute)
@@ -702,6 +724,7 @@ void addObjectMethodsForTraining(py::module& m, ExecutionProviderRegistrationFn
       .def_readwrite("gelu_recompute", &TrainingGraphTransformerConfiguration::gelu_recompute)
       .def_readwrite("transformer_layer_recompute", &TrainingGraphTransformerConfiguration::transformer_layer_recompute)
       .def_readwrite("number_recompute_layers", &TrainingGraphTransformerConfiguration::number_recompute_layers)
+      .def_readwrite("recompute_memory_budget", &TrainingGraphTransformerConfiguration::recompute_memory_budget)
       .def_readwrite("allow_layer_norm_mod_precision", &TrainingGraphTransformerConfiguration::allow_layer_norm_mod_precision)
       .def_readwrite("propagate_cast_ops_config", &TrainingGraphTransformerConfiguration::GraphTransformerConfiguration::propagate_cast_ops_config);
 
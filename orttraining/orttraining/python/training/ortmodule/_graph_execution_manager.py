@@ -126,6 +126,12 @@ class GraphExecutionManager(GraphExecutionInterface):
         self._propagate_cast_ops_allow = []
         # Whether allow fusion of layer norm subgraph if doing so will cause modified precision.
         self._allow_layer_norm_mod_precision = False
+        # Budget in bytes of the activations stashed for the backward pass. When positive, activations that are cheap
+        # to recompute are recomputed in the backward pass until the estimated stashed memory fits the budget.
+        self._recompute_memory_budget = ortmodule._defined_from_envvar('ORTMODULE_RECOMPUTE_MEMORY_BUDGET', 0)
+        # Whether DropoutGrad regenerates dropout masks from the random generator state of the forward pass
+        # instead of the masks being stashed for the backward pass.
+        self._dropout_mask_recompute = ortmodule._defined_from_envvar('ORTMODULE_DROPOUT_MASK_RECOMPUTE', 0) == 1
 
         # Value can be either torch.onnx.TrainingMode.TRAINING or torch.onnx.TrainingMode.EVAL
         # To be instantiated in the concrete implementation of GraphExecutionManager
@@ -135,6 +141,11 @@ class GraphExecutionManager(GraphExecutionInterface):
         # It cannot overlap with required/immutable arguments (validated in runtime)
         self._export_extra_kwargs = {}
 
+        # Directory of the exported models shared across processes, keyed by _utils.get_export_cache_key.
+        # Processes exporting the same model for the same inputs, e.g. the ranks of a distributed job or a restarted
+        # job, load the model exported by the first one instead of exporting it again. Disabled when empty.
+        self._export_cache_dir = ortmodule._defined_from_envvar('ORTMODULE_EXPORT_CACHE_DIR', '')
+
         # Related to training graph shape inference
         self._current_input_shape = None
         # default execution order is priority-based for both dynamic/static shape input for now
@@ -290,6 +301,8 @@ class GraphExecutionManager(GraphExecutionInterface):
         # 0:Verbose, 1:Info, 2:Warning. 3:Error, 4:Fatal. Default is 2.
         session_options.log_severity_level = int(
             self._debug_options.logging.log_level)
+        if self._dropout_mask_recompute:
+            session_options.add_session_config_entry('optimization.dropout_mask_recompute', '1')
 
         if self._debug_options.save_onnx_models.save:
             session_options.optimized_model_filepath = \
@@ -323,26 +336,67 @@ class GraphExecutionManager(GraphExecutionInterface):
             return False
 
         self._set_device_from_module(inputs, kwargs)
-        self._onnx_models.exported_model = self._get_exported_model(
+        self._onnx_models.exported_model, cache_path = self._get_exported_model(
             schema, *inputs, **kwargs)
         if self._debug_options.save_onnx_models.save:
             self._onnx_models.save_exported_model(self._debug_options.save_onnx_models.path,
                                                   self._debug_options.save_onnx_models.name_prefix,
                                                   self._export_mode)
 
-        if self._run_symbolic_shape_infer:
-            self._onnx_models.exported_model = SymbolicShapeInference.infer_shapes(self._onnx_models.exported_model,
-                                                                                   auto_merge=True, guess_output_rank=True)
+        # Models loaded from the export cache were saved after shape inference
+        if cache_path is None:
+            if self._run_symbolic_shape_infer:
+                self._onnx_models.exported_model = SymbolicShapeInference.infer_shapes(
+                    self._onnx_models.exported_model, auto_merge=True, guess_output_rank=True)
+            if self._export_cache_dir:
+                self._save_exported_model_to_cache(schema, inputs, kwargs)
 
         # Restore the recorded random states
         _utils.set_random_states(random_states)
 
         return True
 
+    def _get_export_cache_path(self, input_schema, inputs, kwargs):
+        '''Returns the path of the exported model for the inputs in the export cache directory'''
+
+        sample_inputs = self._input_info.flatten(list(inputs), dict(kwargs), self._device)
+        export_settings = {'mode': str(self._export_mode),
+                           'opset_version': ortmodule.ONNX_OPSET_VERSION,
+                           'extra_kwargs': repr(self._export_extra_kwargs),
+                           'custom_autograd_function': self._enable_custom_autograd_function,
+                           'symbolic_shape_infer': self._run_symbolic_shape_infer}
+        key = _utils.get_export_cache_key(self._original_module, input_schema, sample_inputs, export_settings)
+        return os.path.join(self._export_cache_dir, f'{key}.onnx')
+
+    def _save_exported_model_to_cache(self, input_schema, inputs, kwargs):
+        '''Saves the exported model to the export cache directory, so other processes can load it'''
+
+        # PythonOp nodes refer to autograd functions registered while exporting, which a process loading the
+        # model from the cache wouldn't have registered
+        if any(node.op_type == 'PythonOp' for node in self._onnx_models.exported_model.graph.node):
+            return
+
+        cache_path = self._get_export_cache_path(input_schema, inputs, kwargs)
+        try:
+            os.makedirs(self._export_cache_dir, exist_ok=True)
+            # Write to a file of this process, then rename it, so that processes exporting the same model concurrently
+            # never load a partially written model
+            temp_path = f'{cache_path}.{os.getpid()}.tmp'
+            onnx.save_model(self._onnx_models.exported_model, temp_path)
+            os.replace(temp_path, cache_path)
+        except OSError as e:
+            if self._debug_options.logging.log_level <= LogLevel.WARNING:
+                warnings.warn(f'Unable to save the exported model to the export cache {cache_path}: {e}',
+                              UserWarning)
+
     def _get_exported_model(self, input_schema, *inputs, **kwargs):
         '''Exports PyTorch `self._flattened_module` to ONNX for inferencing or training, using `*inputs` and `**kwargs` as input
 
-        TODO: How to support dynamic axes? Dimensions are determined by samples
+        Returns the exported model and, if the model was loaded from the export cache instead, the path of the
+        cached model.
+
+        Inputs are exported with dynamic axes, so the model is only exported again when the input schema changes
+        and not when the shapes of the inputs do.
         '''
 
         # Setup dynamic axes for onnx model
@@ -359,6 +413,11 @@ class GraphExecutionManager(GraphExecutionInterface):
         # FlattenedModule needs _InputInfo to expand user input from *args to *args + **kwargs
         self._flattened_module._input_info = self._input_info
 
+        if self._export_cache_dir:
+            cache_path = self._get_export_cache_path(input_schema, inputs, kwargs)
+            if os.path.exists(cache_path):
+                return onnx.load_model(cache_path), cache_path
+
         # Export torch.nn.Module to ONNX
         f = io.BytesIO()
 
@@ -405,7 +464,7 @@ class GraphExecutionManager(GraphExecutionInterface):
                                                     self._enable_custom_autograd_function,
                                                     self._debug_options.logging.log_level)
 
-        return exported_model
+        return exported_model, None
 
     def _set_device_from_module(self, inputs, kwargs):
         """Get the device from the module and save it to self._device"""
@@ -425,6 +484,7 @@ class GraphExecutionManager(GraphExecutionInterface):
         graph_transformer_config.propagate_cast_ops_config.allow = self._propagate_cast_ops_allow
         graph_transformer_config.propagate_cast_ops_config.strategy = self._propagate_cast_ops_strategy
         graph_transformer_config.allow_layer_norm_mod_precision = self._allow_layer_norm_mod_precision
+        graph_transformer_config.recompute_memory_budget = self._recompute_memory_budget
         return graph_transformer_config
 
     def _initialize_graph_builder(self, training):
@@ -17,7 +17,9 @@ from .torch_cpp_extensions.cpu.aten_op_executor import load_aten_op_executor_cpp
 import os
 import copy
 import functools
+import hashlib
 import inspect
+import onnxruntime
 import torch
 from torch.utils.dlpack import from_dlpack, to_dlpack
 import traceback
@@ -265,6 +267,39 @@ def parse_os_env_skip_check_flags(env_name):
 
     return os.getenv(env_name).split('|')
 
+def get_export_cache_key(module, input_schema, sample_inputs, export_settings):
+    """Returns a key identifying the ONNX export of module for the given inputs and exporter settings.
+
+    The key covers the source code of every module class used by module, the names, shapes, dtypes and
+    requires_grad flags of its parameters and buffers, the input schema, the shapes of the sample inputs
+    (tracing may specialize the graph on them), and the torch and onnxruntime versions.
+    """
+
+    key = hashlib.sha256()
+
+    def update(value):
+        key.update(repr(value).encode('utf-8'))
+        key.update(b'\0')
+
+    for module_type in sorted({type(m) for m in module.modules()}, key=lambda t: f'{t.__module__}.{t.__qualname__}'):
+        update(f'{module_type.__module__}.{module_type.__qualname__}')
+        try:
+            update(inspect.getsource(module_type))
+        except (OSError, TypeError):
+            # Classes defined interactively have no source, their name has to do
+            pass
+
+    for name, param in module.named_parameters():
+        update((name, tuple(param.shape), str(param.dtype), param.requires_grad))
+    for name, buffer in module.named_buffers():
+        update((name, tuple(buffer.shape), str(buffer.dtype)))
+
+    update(input_schema)
+    update([tuple(value.shape) if isinstance(value, torch.Tensor) else value for value in sample_inputs])
+    update(sorted(export_settings.items()))
+    update((torch.__version__, onnxruntime.__version__))
+    return key.hexdigest()
+
 def get_exception_as_string(exception):
     assert isinstance(exception, Exception), 'exception must be a `Exception`'
 
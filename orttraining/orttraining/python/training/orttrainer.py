@@ -631,6 +631,8 @@ class ORTTrainer(object):
         ort_parameters.enable_adasum = self.options.distributed.enable_adasum
         ort_parameters.deepspeed_zero_stage = self.options.distributed.deepspeed_zero_optimization.stage
         ort_parameters.enable_grad_norm_clip = self.options.utils.grad_norm_clip
+        ort_parameters.allreduce_bucket_size = self.options.distributed.allreduce_bucket_size
+        ort_parameters.compress_allreduce = self.options.distributed.compress_allreduce
         ort_parameters.set_gradients_as_graph_outputs = False
         ort_parameters.use_memory_efficient_gradient = self.options.utils.memory_efficient_gradient
         ort_parameters.training_optimizer_name = self.optim_config.name
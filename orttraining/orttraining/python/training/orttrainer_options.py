@@ -128,6 +128,15 @@ class ORTTrainerOptions(object):
                             'type': 'boolean',
                             'default': False
                         },
+                        'allreduce_bucket_size': {
+                            'type': 'integer',
+                            'min': 0,
+                            'default': 0
+                        },
+                        'compress_allreduce': {
+                            'type': 'boolean',
+                            'default': False
+                        },
                         'deepspeed_zero_optimization': {
                             'type': 'dict',
                             'default': {},
@@ -136,7 +145,7 @@ class ORTTrainerOptions(object):
                                 'stage': {
                                     'type': 'integer',
                                     'min': 0,
-                                    'max': 1,
+                                    'max': 2,
                                     'default': 0
                                 },
                             }
@@ -348,10 +357,19 @@ class ORTTrainerOptions(object):
         distributed.allreduce_post_accumulation (bool, default is False):
             True enables overlap of AllReduce with computation, while False,
             postpone AllReduce until all gradients are ready
+        distributed.allreduce_bucket_size (int, default is 0):
+            size in bytes of the buckets of gradients to AllReduce together, in the order the backward pass
+            produces them, so that the AllReduce of a bucket can start before the backward pass ends.
+            0 means a single AllReduce of all the gradients
+        distributed.compress_allreduce (bool, default is False):
+            True quantizes the float and float16 gradients to int8 with a scale per block of 256 elements for the
+            NCCL AllReduce, carrying the quantization error over to the next step, which cuts the traffic to about
+            2 bytes per element at the cost of some precision. Adasum reduction is not compressed
         distributed.deepspeed_zero_optimization:
             DeepSpeed ZeRO options.
         distributed.deepspeed_zero_optimization.stage (int, default is 0):
-            select which stage of DeepSpeed ZeRO to use. Stage 0 means disabled.
+            select which stage of DeepSpeed ZeRO to use. Stage 0 means disabled. Stage 1 partitions the optimizer
+            states between the data parallel ranks, and stage 2 also partitions the accumulated gradients.
         distributed.enable_adasum (bool, default is False):
             enable `Adasum <https://arxiv.org/abs/2006.02924>`_
             algorithm for AllReduce
@@ -652,6 +670,15 @@ _ORTTRAINER_OPTIONS_SCHEMA = {
                 'type': 'boolean',
                 'default': False
             },
+            'allreduce_bucket_size': {
+                'type': 'integer',
+                'min': 0,
+                'default': 0
+            },
+            'compress_allreduce': {
+                'type': 'boolean',
+                'default': False
+            },
             'deepspeed_zero_optimization': {
                 'type': 'dict',
                 'default_setter': lambda _: {},
@@ -660,7 +687,7 @@ _ORTTRAINER_OPTIONS_SCHEMA = {
                     'stage': {
                         'type': 'integer',
                         'min': 0,
-                        'max': 1,
+                        'max': 2,
                         'default': 0
                     },
                 }
@@ -3,6 +3,7 @@
 
 #include "orttraining/core/framework/checkpointing.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -137,6 +138,68 @@ TEST(CheckpointingTest, SaveAndLoad) {
       model_path, name_to_ort_value, name_to_loaded_tensor_proto);
 }
 
+TEST(CheckpointingTest, AsyncSaveAndLoad) {
+  std::unordered_map<std::string, OrtValueTensorData> name_to_ort_value_data{
+      {"first", {{3}, {1.0f, 2.0f, 3.0f}}},
+      {"second", {{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}}},
+  };
+  std::unordered_map<std::string, OrtValueTensorData> name_to_expected_ort_value_data{name_to_ort_value_data};
+
+  NameMLValMap name_to_ort_value{}, name_to_expected_ort_value{};
+  for (auto& name_and_ort_value_data : name_to_ort_value_data) {
+    name_to_ort_value.emplace(
+        name_and_ort_value_data.first, name_and_ort_value_data.second.GetOrtValue());
+  }
+  for (auto& name_and_ort_value_data : name_to_expected_ort_value_data) {
+    name_to_expected_ort_value.emplace(
+        name_and_ort_value_data.first, name_and_ort_value_data.second.GetOrtValue());
+  }
+
+  std::unordered_map<std::string, std::string> properties{{"one", "1"}};
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_checkpoint"))};
+  PathString model_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_model.onnx"))};
+
+  DataTransferManager data_transfer{};
+  ASSERT_STATUS_OK(data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>()));
+
+  AsyncCheckpointWriter writer{};
+  ASSERT_STATUS_OK(writer.Save(checkpoint_path, data_transfer, name_to_ort_value, properties));
+
+  // the checkpoint has the values at the time of Save()
+  for (auto& name_and_ort_value : name_to_ort_value) {
+    Tensor* tensor = name_and_ort_value.second.GetMutable<Tensor>();
+    std::fill_n(tensor->MutableData<float>(), tensor->Shape().Size(), 0.0f);
+  }
+
+  ASSERT_STATUS_OK(writer.Wait());
+
+  std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
+  std::unordered_map<std::string, std::string> loaded_properties{};
+
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      checkpoint_path, model_path, loaded_tensor_protos, loaded_properties));
+
+  ASSERT_EQ(loaded_properties, properties);
+
+  std::unordered_map<std::string, ONNX_NAMESPACE::TensorProto> name_to_loaded_tensor_proto{};
+  for (const auto& tensor_proto : loaded_tensor_protos) {
+    for (const auto& entry : tensor_proto.external_data()) {
+      if (entry.key() == "offset") {
+        ASSERT_EQ(std::stoull(entry.value()) % k_checkpoint_tensor_data_alignment, 0u);
+      }
+    }
+    name_to_loaded_tensor_proto.emplace(tensor_proto.name(), tensor_proto);
+  }
+
+  CompareOrtValuesToTensorProtoValues(
+      model_path, name_to_expected_ort_value, name_to_loaded_tensor_proto);
+}
+
 }  // namespace test
 }  // namespace training
 }  // namespace onnxruntime
@@ -403,6 +403,35 @@ TEST(OptimizerTest, AdamOptimizerMixPrecision_FP16Weight_SkipUpdate_Test) {
   test.Run();
 }
 
+// FP32 states with FP16 gradients and weights, as used when the optimizer states are offloaded to CPU.
+TEST(OptimizerTest, AdamOptimizerMixPrecision_FP32Moments_Test) {
+  OpTester test("AdamOptimizer", 1, onnxruntime::kMSDomain);
+  AdamOptimizerInputOutput data;
+
+  test.AddInput<float>("ETA", {}, data.eta);
+  test.AddInput<int64_t>("Update_Count", {}, {3});
+  test.AddInput<float>("W", {3}, data.w);
+  test.AddInput<MLFloat16>("G", {3}, data.g_half);
+  test.AddInput<float>("Moment_1", {3}, data.m1);
+  test.AddInput<float>("Moment_2", {3}, data.m2);
+  test.AddInput<MLFloat16>("FP16_W", {3}, data.w_half);
+  test.AddInput<float>("loss_scale", {1}, {1.0f});
+  // grad clipping should not take effect because default max_norm is 1.0f
+  test.AddInput<float>("grad_norm", {1}, {0.01f});
+
+  // Verify AdamOptimizer outputs
+  test.AddOutput<int64_t>("Update_Count_Out", {}, {4});
+  test.AddOutput<float>("Moment_1_Out", {3}, data.m1_new);
+  test.AddOutput<float>("Moment_2_Out", {3}, data.m2_new);
+  test.AddOutput<float>("W_Out", {3}, data.w_new);
+  test.AddOptionalOutputEdge<MLFloat16>();
+  test.AddOutput<MLFloat16>("FP16_W_Out", {3}, data.w_new_half);
+
+  test.AddAttribute("do_bias_correction", static_cast<int64_t>(0));
+  test.AddAttribute("weight_decay_mode", static_cast<int64_t>(0));
+  test.Run();
+}
+
 TEST(OptimizerTest, AdamOptimizerMixPrecisionTestFloatEta) {
   OpTester test("AdamOptimizer", 1, onnxruntime::kMSDomain);
   AdamOptimizerInputOutput data;
@@ -1640,6 +1669,62 @@ TEST(OptimizerTest, LambOptimizerMultiTensorRatio) {
       lambdas, alphas, betas, epsilons, max_norms,
       step, loss_scale, &scaled_g_norm);
 }
+
+#ifdef USE_CUDA
+TEST(OptimizerTest, SGDOptimizerV2_MultipleWeights) {
+  OpTester test("SGDOptimizerV2", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("max_norm_clip", 1.0f);
+
+  // The gradients are scaled by 2, and their scaled norm of 10 exceeds 2 x max_norm_clip, so they are
+  // divided by 10 / max_norm_clip = 10 instead.
+  test.AddOptionalInputEdge<bool>();
+  test.AddInput<float>("loss_scale", {1}, {2.f});
+  test.AddInput<float>("gradient_norm", {}, {10.f});
+  test.AddInput<float>("ETA", {}, {0.5f});
+
+  test.AddInput<float>("W1", {3}, {1.f, 2.f, 3.f});
+  test.AddInput<float>("G1", {3}, {4.f, 5.f, 6.f});
+  test.AddOptionalInputEdge<MLFloat16>();
+  test.AddInput<float>("W2", {2}, {-1.f, 0.5f});
+  test.AddInput<float>("G2", {2}, {2.f, -4.f});
+  test.AddInput<MLFloat16>("W2_FP16", {2}, {MLFloat16(-1.f), MLFloat16(0.5f)});
+
+  test.AddOutput<float>("W1_Out", {3}, {0.8f, 1.75f, 2.7f});
+  test.AddOptionalOutputEdge<float>();
+  test.AddOptionalOutputEdge<MLFloat16>();
+  test.AddOutput<float>("W2_Out", {2}, {-1.1f, 0.7f});
+  test.AddOptionalOutputEdge<float>();
+  test.AddOutput<MLFloat16>("W2_FP16_Out", {2}, {MLFloat16(-1.1f), MLFloat16(0.7f)});
+  test.Run();
+}
+
+TEST(OptimizerTest, SGDOptimizerV2_Gradient) {
+  OpTester test("SGDOptimizerV2", 1, onnxruntime::kMSDomain);
+  test.AddOptionalInputEdge<bool>();
+  test.AddOptionalInputEdge<float>();
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("ETA", {}, {0.5f});
+  test.AddInput<float>("W", {3}, {1.f, 2.f, 3.f});
+  test.AddInput<MLFloat16>("G", {3}, {MLFloat16(4.f), MLFloat16(5.f), MLFloat16(6.f)});
+  test.AddOptionalInputEdge<MLFloat16>();
+  test.AddOptionalOutputEdge<float>();
+  test.AddOutput<MLFloat16>("G_Out", {3}, {MLFloat16(-2.f), MLFloat16(-2.5f), MLFloat16(-3.f)});
+  test.Run();
+}
+
+TEST(OptimizerTest, SGDOptimizerV2_SkipUpdate) {
+  OpTester test("SGDOptimizerV2", 1, onnxruntime::kMSDomain);
+  test.AddInput<bool>("update_signal", {}, {false});
+  test.AddOptionalInputEdge<float>();
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("ETA", {}, {0.5f});
+  test.AddInput<float>("W", {3}, {1.f, 2.f, 3.f});
+  test.AddInput<float>("G", {3}, {4.f, 5.f, 6.f});
+  test.AddOptionalInputEdge<MLFloat16>();
+  test.AddOutput<float>("W_Out", {3}, {1.f, 2.f, 3.f});
+  test.Run();
+}
+#endif
 #endif
 }  // namespace
 }  // namespace test
@@ -41,6 +41,7 @@ const std::vector<const char*> k_weight_names{"weight_1", "weight_2"};
 constexpr const char* const k_loss_scaling_factor_name = "loss_scaling_factor";
 constexpr const char* const k_adam_optimizer_op_name = "AdamOptimizer";
 constexpr const char* const k_lamb_optimizer_op_name = "LambOptimizer";
+constexpr const char* const k_sgd_v2_optimizer_op_name = "SGDOptimizerV2";
 constexpr const char* const k_all_reduce_op_name = "NcclAllReduce";
 constexpr const char* const k_all_gather_op_name = "NcclAllGather";
 constexpr const char* const k_reduce_scatter_op_name = "NcclReduceScatter";
@@ -320,6 +321,68 @@ TEST_F(OptimizerGraphBuilderTest, Default_WithGradientAccumulation_WithMixedPrec
   TestDefaultOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Default_OffloadedStates) {
+  OptimizerGraphConfig config;
+  auto opt_configs = GetOptInfoMap();
+  for (auto& kv : opt_configs) {
+    kv.second.offload_states = true;
+  }
+
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  OptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, opt_configs, updated_weight_names_map, weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  // each new weight overwrites the device copy of the weight once the optimizer is done
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_zero_gradient_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_inplace_accumulator_op_name), k_weight_names.size());
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_zero_gradient_op_name) {
+      const Node* optimizer = graph_.GetProducerNode(node.InputDefs()[1]->Name());
+      ASSERT_NE(optimizer, nullptr);
+      ASSERT_EQ(optimizer->OpType(), k_adam_optimizer_op_name);
+      ASSERT_EQ(node.InputDefs()[0], optimizer->InputDefs()[2]);
+    } else if (node.OpType() == k_inplace_accumulator_op_name) {
+      const Node* optimizer = graph_.GetProducerNode(node.InputDefs()[1]->Name());
+      ASSERT_NE(optimizer, nullptr);
+      ASSERT_EQ(optimizer->OpType(), k_adam_optimizer_op_name);
+    }
+  }
+}
+
+TEST_F(OptimizerGraphBuilderTest, Default_SGDOptimizerV2_WithMixedPrecision) {
+  OptimizerGraphConfig config;
+  config.use_mixed_precision = true;
+  config.loss_scale_input_name = k_loss_scaling_factor_name;
+
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  OptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(k_sgd_v2_optimizer_op_name), updated_weight_names_map,
+      weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  // a single node updates all the weights, with the finite gradient check and the gradient clipping
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_sgd_v2_optimizer_op_name), 1);
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_sgd_v2_optimizer_op_name) {
+      ASSERT_EQ(node.InputDefs().size(), 4 + 3 * k_weight_names.size());
+      ASSERT_TRUE(node.InputDefs()[0]->Exists());
+      ASSERT_TRUE(node.InputDefs()[2]->Exists());
+    }
+  }
+}
+
 #if defined(ORT_USE_NCCL)
 static void TestAllreduceOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
@@ -477,6 +540,48 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_Bucketed) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  // Each weight has a single float element, so a bucket holds two gradients.
+  config.allreduce_bucket_size = 8;
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  const int bucket_count = static_cast<int>((k_weight_names.size() + 1) / 2);
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), bucket_count);
+  ASSERT_EQ(GetOpCount(op_counts, k_unscale_op_name), bucket_count);
+
+  // every optimizer updates its weight with an all-reduced gradient
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_adam_optimizer_op_name) {
+      const Node* gradient_producer = graph_.GetProducerNode(node.InputDefs()[3]->Name());
+      ASSERT_NE(gradient_producer, nullptr);
+      ASSERT_EQ(gradient_producer->OpType(), k_all_reduce_op_name);
+    }
+  }
+}
+
+TEST_F(OptimizerGraphBuilderTest, Allreduce_Compressed) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.compress_allreduce = true;
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), 1);
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_all_reduce_op_name) {
+      const auto& attributes = node.GetAttributes();
+      auto compression = attributes.find("compression");
+      ASSERT_NE(compression, attributes.end());
+      ASSERT_EQ(compression->second.i(), 1);
+    }
+  }
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
@@ -495,6 +600,17 @@ static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& gr
     ASSERT_EQ(GetOpCount(op_counts, k_inplace_accumulator_op_name), k_weight_names.size());
     ASSERT_EQ(GetOpCount(op_counts, k_zero_gradient_op_name), k_weight_names.size());
     ASSERT_GT(opt_graph_outputs.count(OptimizerOutputKey::GradientAccumulation), 0);
+
+    // with ZeRO stage 2, the gradients are accumulated after they are reduced
+    if (config.deepspeed_zero.stage >= 2) {
+      for (const auto& node : graph.Nodes()) {
+        if (node.OpType() == k_inplace_accumulator_op_name) {
+          const Node* producer = graph.GetProducerNode(node.InputDefs()[1]->Name());
+          ASSERT_NE(producer, nullptr);
+          ASSERT_EQ(producer->OpType(), k_reduce_scatter_op_name);
+        }
+      }
+    }
   }
 
   // verify mixed precision operations exist
@@ -554,6 +670,27 @@ TEST_F(OptimizerGraphBuilderTest, ZeRO_WithGradientAccumulation_WithMixedPrecisi
   TestZeROOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, ZeROStage2_WithGradientAccumulation_NoMixedPrecision) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{2};
+  config.gradient_accumulation_steps = 10;
+  config.use_mixed_precision = false;
+  TestZeROOptimizerGraphBuilder(config, graph_);
+}
+
+TEST_F(OptimizerGraphBuilderTest, ZeROStage2_WithGradientAccumulation_WithMixedPrecision) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{2};
+  config.gradient_accumulation_steps = 10;
+  config.use_mixed_precision = true;
+  config.loss_scale_input_name = k_loss_scaling_factor_name;
+  TestZeROOptimizerGraphBuilder(config, graph_);
+}
+
 #endif  // ORT_USE_NCCL
 
 }  // namespace test
@@ -13,17 +13,22 @@
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/gelu_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
+#include "core/optimizer/dropout_mask_recompute.h"
 #include "orttraining/core/optimizer/gist_encode_decode.h"
 #include "orttraining/core/optimizer/megatron_transformer.h"
 #include "orttraining/core/optimizer/concat_replacement.h"
 #include "orttraining/core/optimizer/batchnorm_replacement.h"
 #include "orttraining/core/optimizer/localized_recompute.h"
+#include "orttraining/core/graph/recompute_graph_utils.h"
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
+#include "test/optimizer/graph_transform_test_builder.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
 #include "orttraining/test/optimizer/horizontal_parallel_test_utils.h"
 #include "orttraining/core/session/training_session.h"
 #include "orttraining/core/optimizer/loss_rewriter.h"
+#include "orttraining/core/graph/mixed_precision_transformer.h"
 
 #include <random>
 
@@ -536,6 +541,242 @@ TEST_F(GraphTransformationTests, MegatronSelfAttentionPartitionRank1) {
   }
 }
 
+// T5 style MLP without biases: MatMul -> Relu -> Dropout -> MatMul -> Add (residual).
+TEST_F(GraphTransformationTests, MegatronBiasFreeMLPPartition) {
+  Model model("MegatronBiasFreeMLP", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMSDomain, 1}}, {}, *logger_);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder helper(graph);
+
+  auto* input = helper.MakeInput<float>({4, 8}, -1.0f, 1.0f);
+  auto* w1 = helper.MakeInitializer<float>({8, 16}, -1.0f, 1.0f);
+  auto* w2 = helper.MakeInitializer<float>({16, 8}, -1.0f, 1.0f);
+  auto* matmul_out = helper.MakeIntermediate();
+  auto* relu_out = helper.MakeIntermediate();
+  auto* dropout_out = helper.MakeIntermediate();
+  auto* matmul2_out = helper.MakeIntermediate();
+  auto* output = helper.MakeOutput();
+  Node& matmul_node = helper.AddNode("MatMul", {input, w1}, {matmul_out});
+  helper.AddNode("Relu", {matmul_out}, {relu_out});
+  Node& dropout_node = helper.AddNode("Dropout", {relu_out}, {dropout_out});
+  Node& matmul2_node = helper.AddNode("MatMul", {dropout_out, w2}, {matmul2_out});
+  helper.AddNode("Add", {matmul2_out, input}, {output});
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  std::unordered_map<std::string, std::string> updated_weight_names;
+  std::unordered_set<std::string> weights_to_train;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  training::TrainingSession::OptimizerState init_optim_state;
+  IExecutionProvider* e = TestCPUExecutionProvider();
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<MegatronTransformer>(0, 2, updated_weight_names, weights_to_train, weight_partition_info,
+                                            init_optim_state, *e),
+      TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["com.microsoft.MegatronF"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.MegatronG"], 1);
+  ASSERT_EQ(updated_weight_names.size(), 2u);
+
+  for (Node* node : {&matmul_node, &matmul2_node}) {
+    std::vector<float> actual_val;
+    std::vector<int64_t> actual_shape;
+    ASSERT_STATUS_OK(horizontal_parallel_test_utils::GetDataAndShapeFromTensorProto(
+        graph, node->MutableInputDefs()[1], actual_val, actual_shape));
+    ASSERT_EQ(actual_shape, (std::vector<int64_t>{8, 8}));
+  }
+
+  // The Dropout works on this rank's half of the hidden units, so it gets its own seed.
+  ASSERT_NE(graph_utils::GetNodeAttribute(dropout_node, "seed"), nullptr);
+}
+
+// Dropout -> DropoutGrad, with the mask optionally also being a graph output.
+static void RunDropoutMaskRecomputeTest(bool mask_is_graph_output, const logging::Logger& logger) {
+  Model model("DropoutMaskRecompute", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMSDomain, 1}}, {}, logger);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder helper(graph);
+
+  auto* input = helper.MakeInput<float>({4, 16}, -1.0f, 1.0f);
+  auto* dy = helper.MakeInput<float>({4, 16}, -1.0f, 1.0f);
+  auto* ratio = helper.MakeScalarInitializer<float>(0.1f);
+  auto* training_mode = helper.MakeInput<bool>({}, std::vector<bool>{true});
+  auto* output = helper.MakeOutput();
+  auto* mask = mask_is_graph_output ? helper.MakeOutput() : helper.MakeIntermediate();
+  auto* dx = helper.MakeOutput();
+  Node& dropout_node = helper.AddNode("Dropout", {input, ratio, training_mode}, {output, mask});
+  dropout_node.AddAttribute("seed", static_cast<int64_t>(42));
+  helper.AddNode("DropoutGrad", {dy, mask, ratio, training_mode}, {dx}, kMSDomain);
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<DropoutMaskRecompute>(InlinedHashSet<std::string_view>{kCudaExecutionProvider}),
+      TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, logger));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Dropout"], mask_is_graph_output ? 1 : 0);
+  ASSERT_EQ(op_to_count["com.microsoft.BiasDropout"], mask_is_graph_output ? 0 : 1);
+  ASSERT_EQ(op_to_count["com.microsoft.DropoutGrad"], 1);
+  if (mask_is_graph_output) {
+    return;
+  }
+
+  const Node* bias_dropout_node = nullptr;
+  const Node* dropout_grad_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "BiasDropout") {
+      bias_dropout_node = &node;
+    } else if (node.OpType() == "DropoutGrad") {
+      dropout_grad_node = &node;
+    }
+  }
+  ASSERT_NE(bias_dropout_node, nullptr);
+  ASSERT_NE(dropout_grad_node, nullptr);
+  ASSERT_EQ(bias_dropout_node->GetExecutionProviderType(), kCudaExecutionProvider);
+  ASSERT_NE(graph_utils::GetNodeAttribute(*bias_dropout_node, "seed"), nullptr);
+
+  // BiasDropout(X, , , ratio, training_mode) -> (Y, , philox_state)
+  const auto& dropout_inputs = bias_dropout_node->InputDefs();
+  ASSERT_EQ(dropout_inputs.size(), 5u);
+  ASSERT_EQ(dropout_inputs[0], input);
+  ASSERT_FALSE(dropout_inputs[1]->Exists());
+  ASSERT_FALSE(dropout_inputs[2]->Exists());
+  ASSERT_EQ(dropout_inputs[3], ratio);
+  ASSERT_EQ(dropout_inputs[4], training_mode);
+  const auto& dropout_outputs = bias_dropout_node->OutputDefs();
+  ASSERT_EQ(dropout_outputs.size(), 3u);
+  ASSERT_EQ(dropout_outputs[0], output);
+  ASSERT_FALSE(dropout_outputs[1]->Exists());
+
+  // DropoutGrad(dY, , ratio, training_mode, philox_state)
+  const auto& grad_inputs = dropout_grad_node->InputDefs();
+  ASSERT_EQ(grad_inputs.size(), 5u);
+  ASSERT_EQ(grad_inputs[0], dy);
+  ASSERT_FALSE(grad_inputs[1]->Exists());
+  ASSERT_EQ(grad_inputs[4], dropout_outputs[2]);
+  ASSERT_EQ(dropout_grad_node->OutputDefs()[0], dx);
+}
+
+TEST_F(GraphTransformationTests, DropoutMaskRecompute) {
+  RunDropoutMaskRecomputeTest(false, *logger_);
+}
+
+TEST_F(GraphTransformationTests, DropoutMaskRecompute_MaskIsGraphOutput) {
+  RunDropoutMaskRecomputeTest(true, *logger_);
+}
+
+TEST_F(GraphTransformationTests, GistAutoCompressionType) {
+  Model model("GistAuto", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMSDomain, 1}}, {}, *logger_);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder helper(graph);
+
+  // Activations with a symbolic batch dimension are large, the Softmax one is small.
+  TypeProto batch_type;
+  batch_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  batch_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  batch_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+  auto* input = &graph.GetOrCreateNodeArg("input", &batch_type);
+  auto* d_gelu = &graph.GetOrCreateNodeArg("d_gelu", &batch_type);
+  auto* d_relu = &graph.GetOrCreateNodeArg("d_relu", &batch_type);
+  auto* weight = helper.MakeInitializer<float>({64, 64}, -1.0f, 1.0f);
+  auto* small_input = helper.MakeInput<float>({2, 8}, -1.0f, 1.0f);
+  auto* d_softmax = helper.MakeInput<float>({2, 8}, -1.0f, 1.0f);
+
+  auto* matmul_out = helper.MakeIntermediate();
+  auto* relu_out = helper.MakeIntermediate();
+  auto* softmax_out = helper.MakeIntermediate();
+  helper.AddNode("MatMul", {input, weight}, {matmul_out});
+  helper.AddNode("Gelu", {matmul_out}, {helper.MakeOutput()}, kMSDomain);
+  helper.AddNode("Relu", {input}, {relu_out});
+  helper.AddNode("Softmax", {small_input}, {softmax_out});
+  graph.AddNode("gelu_grad", "GeluGrad", "Backward pass", {d_gelu, matmul_out}, {helper.MakeOutput()}, nullptr,
+                kMSDomain);
+  graph.AddNode("relu_grad", "ReluGrad", "Backward pass", {d_relu, relu_out}, {helper.MakeOutput()}, nullptr,
+                kMSDomain);
+  graph.AddNode("softmax_grad", "SoftmaxGrad_13", "Backward pass", {d_softmax, softmax_out}, {helper.MakeOutput()},
+                nullptr, kMSDomain);
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto rule_transformer_L1 = std::make_unique<RuleBasedGraphTransformer>("RuleGistTransformer1");
+  ASSERT_STATUS_OK(rule_transformer_L1->Register(std::make_unique<GistEncodeDecode>(9, "GistAuto")));
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(rule_transformer_L1), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  // The Gelu input has whole MSFP tiles, ReluGrad only needs the sign, and the small Softmax output is kept at 16 bits.
+  ASSERT_EQ(op_to_count["com.microsoft.GistPackMsfp15Encoder"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.GistPackMsfp15Decoder"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.GistBinarizeEncoder"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.GistBinarizeDecoder"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.GistPack16Encoder"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.GistPack16Decoder"], 1);
+}
+
+static void TestMixedPrecisionFP32NodeSelection(ONNX_NAMESPACE::TensorProto_DataType mixed_precision_type,
+                                                bool expect_profiled_node_fp32, const logging::Logger& logger) {
+  Model model("MixedPrecisionFP32Nodes", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}}, {}, logger);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder helper(graph);
+
+  auto* input = helper.MakeInput<float>({2, 8}, -1.0f, 1.0f);
+  auto* weight = helper.MakeInitializer<float>({8, 8}, -1.0f, 1.0f);
+  auto* matmul_out = helper.MakeIntermediate();
+  auto* softmax_out = helper.MakeIntermediate();
+  auto* exp_out = helper.MakeIntermediate();
+  Node& matmul = helper.AddNode("MatMul", {input, weight}, {matmul_out});
+  Node& softmax = helper.AddNode("Softmax", {matmul_out}, {softmax_out});
+  Node& exp = helper.AddNode("Exp", {softmax_out}, {exp_out});
+  Node& add = helper.AddNode("Add", {exp_out, matmul_out}, {helper.MakeOutput()});
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // Softmax is denied by op type, Exp by the profiled range of its output.
+  const std::unordered_set<std::string> fp32_op_types{"Softmax"};
+  const std::unordered_map<std::string, float> activation_max_abs{{matmul_out->Name(), 12.0f},
+                                                                  {exp_out->Name(), 1.0e5f}};
+  std::unordered_map<std::string, NodeArg*> fp32_weight_name_to_mixed_precision_node_arg;
+  ASSERT_STATUS_OK(training::TransformGraphForMixedPrecision(graph, {weight->Name()}, true, mixed_precision_type,
+                                                             fp32_weight_name_to_mixed_precision_node_arg, true,
+                                                             fp32_op_types, activation_max_abs));
+
+  auto elem_type = [](const Node& node, size_t input_index) {
+    return node.InputDefs()[input_index]->TypeAsProto()->tensor_type().elem_type();
+  };
+  ASSERT_EQ(elem_type(matmul, 0), mixed_precision_type);
+  ASSERT_EQ(elem_type(matmul, 1), mixed_precision_type);
+  ASSERT_EQ(elem_type(softmax, 0), TensorProto_DataType_FLOAT);
+  ASSERT_EQ(elem_type(add, 1), mixed_precision_type);
+  if (expect_profiled_node_fp32) {
+    // The FP32 Softmax output feeds the FP32 Exp without a cast in between.
+    ASSERT_EQ(exp.InputDefs()[0], softmax.OutputDefs()[0]);
+    ASSERT_EQ(elem_type(add, 0), mixed_precision_type);
+  } else {
+    ASSERT_EQ(elem_type(exp, 0), mixed_precision_type);
+  }
+}
+
+TEST_F(GraphTransformationTests, MixedPrecisionFP32Nodes_FP16) {
+  TestMixedPrecisionFP32NodeSelection(TensorProto_DataType_FLOAT16, true, *logger_);
+}
+
+// BFloat16 has the FP32 exponent range, so the profile does not keep any node in FP32.
+TEST_F(GraphTransformationTests, MixedPrecisionFP32Nodes_BF16) {
+  TestMixedPrecisionFP32NodeSelection(TensorProto_DataType_BFLOAT16, false, *logger_);
+}
+
 TEST_F(GraphTransformationTests, BiasGeluRecomputeTest) {
   auto model_uri = MODEL_FOLDER "fusion/bias_gelu_fusion_recompute.onnx";
   std::shared_ptr<Model> p_model;
@@ -562,6 +803,55 @@ TEST_F(GraphTransformationTests, BiasGeluRecomputeTest) {
   }
 }
 
+// MatMul -> Add -> Gelu -> MatMul, where each of the three activations takes 4 x 16 x 4 = 256 bytes.
+// Gelu and the second MatMul stash their inputs, and the Add is the cheapest to recompute.
+static void RunMemoryBudgetRecomputeTest(int64_t memory_budget, bool expect_add_recompute,
+                                         const logging::Logger& logger) {
+  Model model("MemoryBudgetRecompute", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}, {kMSDomain, 1}}, {}, logger);
+  Graph& graph = model.MainGraph();
+  ModelTestBuilder helper(graph);
+
+  auto* input = helper.MakeInput<float>({4, 16}, -1.0f, 1.0f);
+  auto* w1 = helper.MakeInitializer<float>({16, 16}, -1.0f, 1.0f);
+  auto* b1 = helper.MakeInitializer<float>({16}, -1.0f, 1.0f);
+  auto* w2 = helper.MakeInitializer<float>({16, 16}, -1.0f, 1.0f);
+  auto* matmul_out = helper.MakeIntermediate();
+  auto* add_out = helper.MakeIntermediate();
+  auto* gelu_out = helper.MakeIntermediate();
+  auto* output = helper.MakeOutput();
+  helper.AddNode("MatMul", {input, w1}, {matmul_out});
+  helper.AddNode("Add", {matmul_out, b1}, {add_out});
+  helper.AddNode("Gelu", {add_out}, {gelu_out}, kMSDomain);
+  helper.AddNode("MatMul", {gelu_out, w2}, {output});
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<MemoryBudgetRecompute>(memory_budget),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, logger));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Add"], expect_add_recompute ? 2 : 1);
+  // Gelu reads the output of the Add, so it is never recomputed once the Add is.
+  ASSERT_EQ(op_to_count["com.microsoft.Gelu"], 1);
+  ASSERT_EQ(graph.GetNodeArg(graph_utils::RecomputeName(add_out->Name())) != nullptr, expect_add_recompute);
+  ASSERT_EQ(graph.GetNodeArg(graph_utils::RecomputeName(gelu_out->Name())), nullptr);
+}
+
+TEST_F(GraphTransformationTests, MemoryBudgetRecompute_WithinBudget) {
+  RunMemoryBudgetRecomputeTest(768, false, *logger_);
+}
+
+TEST_F(GraphTransformationTests, MemoryBudgetRecompute_CheapestFirst) {
+  RunMemoryBudgetRecomputeTest(512, true, *logger_);
+}
+
+TEST_F(GraphTransformationTests, MemoryBudgetRecompute_BudgetNotReached) {
+  RunMemoryBudgetRecomputeTest(256, true, *logger_);
+}
+
 TEST_F(GraphTransformationTests, SoftmaxCrossEntropyLossInternalFusionWithoutCast) {
   Model model("SoftmaxCrossEntropyLossInternalFusion", true, ModelMetaData(), PathString(),
               IOnnxRuntimeOpSchemaRegistryList(), {{"", 12}, {"com.microsoft", 1}}, {}, *logger_);
@@ -3,9 +3,14 @@
 
 #include "orttraining/training_ops/cpu/optimizer/optimizers.h"
 
+#include <cstring>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -43,6 +48,34 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     SGDOptimizer<float>);
 
+namespace {
+// The number the scaled gradients are divided by before the update, as computed by the CUDA optimizers:
+// the loss scale, or the scaled gradient norm over max_norm if it exceeds the scaled max_norm.
+float ComputeGradScale(const Tensor* loss_scale_tensor, const Tensor* gradient_norm_tensor, float max_norm) {
+  const float scale = loss_scale_tensor != nullptr ? *loss_scale_tensor->Data<float>() : 1.f;
+  if (gradient_norm_tensor == nullptr) {
+    return scale;
+  }
+
+  const float scaled_g_norm = gradient_norm_tensor->IsDataType<MLFloat16>()
+                                  ? math::halfToFloat(gradient_norm_tensor->Data<MLFloat16>()->val)
+                                  : *gradient_norm_tensor->Data<float>();
+  return scaled_g_norm > scale * max_norm ? scaled_g_norm / max_norm : scale;
+}
+
+void CopyIfNotSameBuffer(const Tensor& source, Tensor& target) {
+  if (source.DataRaw() != target.DataRaw()) {
+    memcpy(target.MutableDataRaw(), source.DataRaw(), source.SizeInBytes());
+  }
+}
+
+void ConvertToHalf(const float* source, MLFloat16* target, std::ptrdiff_t count) {
+  for (std::ptrdiff_t i = 0; i < count; ++i) {
+    target[i] = MLFloat16(math::floatToHalf(source[i]));
+  }
+}
+}  // namespace
+
 template <typename T>
 Status AdamOptimizer<T>::Compute(OpKernelContext* ctx) const {
   const Tensor& ETA = *ctx->Input<Tensor>(0);
@@ -51,72 +84,118 @@ Status AdamOptimizer<T>::Compute(OpKernelContext* ctx) const {
   const Tensor& G = *ctx->Input<Tensor>(3);
   const Tensor& M1 = *ctx->Input<Tensor>(4);
   const Tensor& M2 = *ctx->Input<Tensor>(5);
+  const Tensor* W_MIXED_FP = ctx->Input<Tensor>(6);
+  const Tensor* loss_scale_tensor = ctx->Input<Tensor>(7);
+  const Tensor* gradient_norm_tensor = ctx->Input<Tensor>(8);
+  const Tensor* do_update_tensor = ctx->Input<Tensor>(9);
 
   Tensor& NS = *ctx->Output(0, S.Shape());
   Tensor& NM1 = *ctx->Output(1, M1.Shape());
   Tensor& NM2 = *ctx->Output(2, M2.Shape());
   Tensor* NW = ctx->Output(3, W.Shape());
   Tensor* NG = ctx->Output(4, G.Shape());
+  Tensor* NW_MIXED_FP = W_MIXED_FP != nullptr ? ctx->Output(5, W_MIXED_FP->Shape()) : nullptr;
 
   const float eta = *ETA.template Data<float>();
   const int64_t step = *S.template Data<int64_t>();
 
-  // Update exponentially-averaged historical gradient
-  MakeEigenArrayMap<T>(NM1) = alpha_ * MakeEigenArrayMap<T>(M1) + ((1 - alpha_) * MakeEigenArrayMap<T>(G));
+  if (do_update_tensor != nullptr && !*do_update_tensor->Data<bool>()) {
+    CopyIfNotSameBuffer(M1, NM1);
+    CopyIfNotSameBuffer(M2, NM2);
+    if (NW != nullptr) {
+      CopyIfNotSameBuffer(W, *NW);
+    }
+    if (NG != nullptr) {
+      CopyIfNotSameBuffer(G, *NG);
+    }
+    if (NW_MIXED_FP != nullptr) {
+      CopyIfNotSameBuffer(*W_MIXED_FP, *NW_MIXED_FP);
+    }
 
-  // Update exponentially-averaged historical squared gradient
-  MakeEigenArrayMap<T>(NM2) = beta_ * MakeEigenArrayMap<T>(M2) + ((1 - beta_) * MakeEigenArrayMap<T>(G) * MakeEigenArrayMap<T>(G));
+    *NS.template MutableData<int64_t>() = step;
+    return Status::OK();
+  }
 
+  const float scale = ComputeGradScale(loss_scale_tensor, gradient_norm_tensor, max_norm_clip_);
   const float alpha_correction = do_bias_correction_ ?
     compute_bias_correction_coefficient(alpha_, step) : 1.f;
   const float beta_correction = do_bias_correction_ ?
     compute_bias_correction_coefficient(beta_, step) : 1.f;
-
-  // Currently two modes of Adamw are supported:
-  // Mode 0: Pytorch https://pytorch.org/docs/stable/_modules/torch/optim/adamw.html#AdamW,
-  //         bias correction is applied on m and v individually,
-  //         weight decay is applied before weight is updated.
-  // Mode 1: Huggingface https://huggingface.co/transformers/_modules/transformers/optimization.html#AdamW.,
-  //         bias correction is applied on learning rate,
-  //         weight decay is applied after weight is updated.
-  if(weight_decay_mode_ == 0) {
-    // Compute weight update.
-    const auto& denom = (MakeEigenArrayMap<T>(NM2) / beta_correction).sqrt() + epsilon_;
-    const auto& update = ( (MakeEigenArrayMap<T>(NM1) / alpha_correction) / denom) + (lambda_ * MakeEigenArrayMap<T>(W));
-    const auto& delta = -eta * update;
-
-    // Weight, gradient, and step update.
-    if (NG != nullptr) {
-      MakeEigenArrayMap<T>(*NG) = delta;
+  const bool fp16_gradients = G.IsDataType<MLFloat16>();
+
+  // Each element is updated independently, so the tensor is split into ranges that the operator thread pool
+  // updates in parallel, each with vectorized Eigen expressions. This is what makes the update of large
+  // optimizer states offloaded from the GPU affordable.
+  auto update_range = [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    const std::ptrdiff_t count = end - begin;
+
+    std::vector<float> fp32_gradients;
+    const float* gradients = nullptr;
+    if (fp16_gradients) {
+      fp32_gradients.resize(count);
+      MlasConvertHalfToFloatBuffer(&G.Data<MLFloat16>()[begin].val, fp32_gradients.data(), count);
+      gradients = fp32_gradients.data();
+    } else {
+      gradients = G.Data<float>() + begin;
     }
-    if (NW != nullptr) {
-      MakeEigenArrayMap<T>(*NW) = MakeEigenArrayMap<T>(W) + delta;
+
+    ConstEigenVectorArrayMap<float> g(gradients, count);
+    ConstEigenVectorArrayMap<T> w(W.template Data<T>() + begin, count);
+    ConstEigenVectorArrayMap<T> m1(M1.template Data<T>() + begin, count);
+    ConstEigenVectorArrayMap<T> m2(M2.template Data<T>() + begin, count);
+    EigenVectorArrayMap<T> nm1(NM1.template MutableData<T>() + begin, count);
+    EigenVectorArrayMap<T> nm2(NM2.template MutableData<T>() + begin, count);
+
+    // Update exponentially-averaged historical gradient
+    nm1 = alpha_ * m1 + ((1 - alpha_) * g / scale);
+
+    // Update exponentially-averaged historical squared gradient
+    nm2 = beta_ * m2 + ((1 - beta_) * (g / scale) * (g / scale));
+
+    // Currently two modes of Adamw are supported:
+    // Mode 0: Pytorch https://pytorch.org/docs/stable/_modules/torch/optim/adamw.html#AdamW,
+    //         bias correction is applied on m and v individually,
+    //         weight decay is applied before weight is updated.
+    // Mode 1: Huggingface https://huggingface.co/transformers/_modules/transformers/optimization.html#AdamW.,
+    //         bias correction is applied on learning rate,
+    //         weight decay is applied after weight is updated.
+    std::vector<float> delta_buffer(count);
+    EigenVectorArrayMap<float> delta(delta_buffer.data(), count);
+    if (weight_decay_mode_ == 0) {
+      delta = -eta * (((nm1 / alpha_correction) / ((nm2 / beta_correction).sqrt() + epsilon_)) + (lambda_ * w));
+    } else {
+      const float step_size = eta * std::sqrt(beta_correction) / alpha_correction;
+
+      // Huggingface updates weights in the following logic:
+      // param' = param - step_size * m1o / denom
+      // param_out = param' - original_lr * lambda * param'
+      // then param_out = param - step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
+      // so delta = -step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
+      delta = -step_size * nm1 / (nm2.sqrt() + epsilon_);
+      delta -= eta * lambda_ * (w + delta);
     }
-  }
-  else if (weight_decay_mode_ == 1) {
-    const auto& denom = MakeEigenArrayMap<T>(NM2).sqrt() + epsilon_;
-    const auto& step_size = eta * std::sqrt(beta_correction) / alpha_correction;
-
-    // Huggingface updates weights in the following logic:
-    // param' = param - step_size * m1o / denom
-    // param_out = param' - original_lr * lambda * param'
-    // then param_out = param - step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
-    // so delta = -step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
-    const auto& delta = -step_size * MakeEigenArrayMap<T>(NM1) / denom
-                        - eta * lambda_ * (MakeEigenArrayMap<T>(W) - step_size * MakeEigenArrayMap<T>(NM1) / denom);
-
-    // Weight, gradient, and step update.
+
+    // Weight and gradient update.
     if (NG != nullptr) {
-      MakeEigenArrayMap<T>(*NG) = delta;
+      if (fp16_gradients) {
+        ConvertToHalf(delta_buffer.data(), NG->MutableData<MLFloat16>() + begin, count);
+      } else {
+        EigenVectorArrayMap<float>(NG->MutableData<float>() + begin, count) = delta;
+      }
     }
     if (NW != nullptr) {
-      MakeEigenArrayMap<T>(*NW) = MakeEigenArrayMap<T>(W) + delta;
+      T* new_weights = NW->template MutableData<T>() + begin;
+      EigenVectorArrayMap<T>(new_weights, count) = w + delta;
+      if (NW_MIXED_FP != nullptr) {
+        ConvertToHalf(new_weights, NW_MIXED_FP->MutableData<MLFloat16>() + begin, count);
+      }
     }
-  }
-  else {
-    // Shouldn't reach here
-    ORT_THROW("Unsupported Adamw optimizer mode.");
-  }
+  };
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(W.Shape().Size()),
+      TensorOpCost{static_cast<double>(4 * sizeof(float)), static_cast<double>(4 * sizeof(float)), 32.0},
+      update_range);
 
   *NS.template MutableData<int64_t>() = step + 1;
   return Status::OK();
@@ -138,7 +217,10 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T2", DataTypeImpl::GetTensorType<int64_t>())
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("T4", DataTypeImpl::GetTensorType<float>())
-        .TypeConstraint("T_GRAD", DataTypeImpl::GetTensorType<float>()),
+        .TypeConstraint("T_GRAD", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<MLFloat16>()})
+        .TypeConstraint("T_GRAD_NORM", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<MLFloat16>()})
+        .TypeConstraint("T_MIXED_PRECISION_FP", DataTypeImpl::GetTensorType<MLFloat16>())
+        .TypeConstraint("T_BOOL", DataTypeImpl::GetTensorType<bool>()),
     AdamOptimizer<float>);
 }  // namespace contrib
 }  // namespace onnxruntime
\ No newline at end of file
@@ -26,10 +26,12 @@ class AdamOptimizer final : public OpKernel {
     info.GetAttrOrDefault("beta", &beta_, 0.999f);
     info.GetAttrOrDefault("lambda", &lambda_, 0.0f);
     info.GetAttrOrDefault("epsilon", &epsilon_, 1e-8f);
+    info.GetAttrOrDefault("max_norm_clip", &max_norm_clip_, 1.0f);
     ORT_ENFORCE(alpha_ >= 0);
     ORT_ENFORCE(beta_ >= 0);
     ORT_ENFORCE(lambda_ >= 0);
     ORT_ENFORCE(epsilon_ >= 0);
+    ORT_ENFORCE(max_norm_clip_ != 0, "max_norm_clip must NOT be 0.");
     int64_t tmp_flag = static_cast<int64_t>(0);
     ORT_ENFORCE(info.GetAttr<int64_t>("do_bias_correction", &tmp_flag).IsOK(), "Missing/Invalid do_bias_correction");
     ORT_ENFORCE(tmp_flag == 0 || tmp_flag == 1, "do_bias_correction must be either 0 or 1.");
@@ -45,6 +47,7 @@ class AdamOptimizer final : public OpKernel {
   float beta_;
   float lambda_;
   float epsilon_;
+  float max_norm_clip_;
   bool do_bias_correction_;
   int64_t weight_decay_mode_;
 };
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "nccl_compression_impl.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cu_inc/common.cuh"
+
+namespace onnxruntime {
+namespace cuda {
+
+// One thread block per quantization block, and one thread per element.
+template <typename T>
+__global__ void _QuantizeBlocks(
+    const T* input,
+    float* residual,
+    int8_t* quantized,
+    float* scales,
+    CUDA_LONG count) {
+  __shared__ float max_abs[kCompressionBlockSize];
+
+  const CUDA_LONG id = static_cast<CUDA_LONG>(blockIdx.x) * kCompressionBlockSize + threadIdx.x;
+  float value = 0.0f;
+  if (id < count) {
+    value = static_cast<float>(input[id]);
+    if (residual != nullptr) {
+      value += residual[id];
+    }
+  }
+
+  max_abs[threadIdx.x] = fabsf(value);
+  __syncthreads();
+  for (int stride = kCompressionBlockSize / 2; stride > 0; stride /= 2) {
+    if (threadIdx.x < stride) {
+      max_abs[threadIdx.x] = fmaxf(max_abs[threadIdx.x], max_abs[threadIdx.x + stride]);
+    }
+    __syncthreads();
+  }
+
+  const float scale = max_abs[0] / 127.0f;
+  const float q = scale > 0.0f ? fminf(fmaxf(rintf(value / scale), -127.0f), 127.0f) : 0.0f;
+  quantized[id] = static_cast<int8_t>(q);
+  if (threadIdx.x == 0) {
+    scales[blockIdx.x] = scale;
+  }
+  if (residual != nullptr && id < count) {
+    residual[id] = value - q * scale;
+  }
+}
+
+template <typename T>
+void QuantizeBlocksImpl(
+    cudaStream_t stream,
+    const T* input,
+    float* residual,
+    int8_t* quantized,
+    float* scales,
+    size_t count,
+    size_t padded_count) {
+  if (padded_count == 0) {
+    return;
+  }
+  const int blocksPerGrid = static_cast<int>(padded_count / kCompressionBlockSize);
+  _QuantizeBlocks<T><<<blocksPerGrid, kCompressionBlockSize, 0, stream>>>(
+      input, residual, quantized, scales, static_cast<CUDA_LONG>(count));
+}
+
+__global__ void _DequantizeAndSumShards(
+    const int8_t* quantized,
+    const float* scales,
+    int rank_count,
+    CUDA_LONG shard_count,
+    float* output) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, shard_count);
+  const CUDA_LONG shard_block_count = shard_count / kCompressionBlockSize;
+  const CUDA_LONG block = id / kCompressionBlockSize;
+  float sum = 0.0f;
+  for (int r = 0; r < rank_count; r++) {
+    sum += static_cast<float>(quantized[r * shard_count + id]) * scales[r * shard_block_count + block];
+  }
+  output[id] = sum;
+}
+
+void DequantizeAndSumShardsImpl(
+    cudaStream_t stream,
+    const int8_t* quantized,
+    const float* scales,
+    int rank_count,
+    size_t shard_count,
+    float* output) {
+  if (shard_count == 0) {
+    return;
+  }
+  const int blocksPerGrid = static_cast<int>(CeilDiv(shard_count, GridDim::maxThreadsPerBlock));
+  _DequantizeAndSumShards<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      quantized, scales, rank_count, static_cast<CUDA_LONG>(shard_count), output);
+}
+
+template <typename T>
+__global__ void _DequantizeBlocks(
+    const int8_t* quantized,
+    const float* scales,
+    T* output,
+    CUDA_LONG count) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, count);
+  output[id] = static_cast<T>(static_cast<float>(quantized[id]) * scales[id / kCompressionBlockSize]);
+}
+
+template <typename T>
+void DequantizeBlocksImpl(
+    cudaStream_t stream,
+    const int8_t* quantized,
+    const float* scales,
+    T* output,
+    size_t count) {
+  if (count == 0) {
+    return;
+  }
+  const int blocksPerGrid = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock));
+  _DequantizeBlocks<T><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      quantized, scales, output, static_cast<CUDA_LONG>(count));
+}
+
+#define SPECIALIZED_COMPRESSION_IMPL(T)                                                                   \
+  template void QuantizeBlocksImpl<T>(cudaStream_t stream, const T* input, float* residual,              \
+                                      int8_t* quantized, float* scales, size_t count, size_t padded_count); \
+  template void DequantizeBlocksImpl<T>(cudaStream_t stream, const int8_t* quantized, const float* scales, \
+                                        T* output, size_t count);
+
+SPECIALIZED_COMPRESSION_IMPL(float)
+SPECIALIZED_COMPRESSION_IMPL(half)
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <stdint.h>
+#include <cuda_runtime.h>
+
+namespace onnxruntime {
+namespace cuda {
+
+// Number of consecutive elements sharing one scale in the int8 compressed all-reduce.
+constexpr int kCompressionBlockSize = 256;
+
+// Quantizes input[0:count] to int8 with one scale per kCompressionBlockSize elements. padded_count must be a multiple
+// of the block size, and the elements from count to padded_count are quantized as zeros.
+// If residual is not null, it is added to the input before quantizing and receives the new quantization error, so
+// that the error of a step is fed back into the next one.
+template <typename T>
+void QuantizeBlocksImpl(
+    cudaStream_t stream,
+    const T* input,
+    float* residual,
+    int8_t* quantized,
+    float* scales,
+    size_t count,
+    size_t padded_count);
+
+// Sums the rank_count shards of shard_count int8 elements, dequantized with their block scales, into output.
+void DequantizeAndSumShardsImpl(
+    cudaStream_t stream,
+    const int8_t* quantized,
+    const float* scales,
+    int rank_count,
+    size_t shard_count,
+    float* output);
+
+// Dequantizes quantized[0:count] with its block scales into output.
+template <typename T>
+void DequantizeBlocksImpl(
+    cudaStream_t stream,
+    const int8_t* quantized,
+    const float* scales,
+    T* output,
+    size_t count);
+
+}  // namespace cuda
+}  // namespace onnxruntime
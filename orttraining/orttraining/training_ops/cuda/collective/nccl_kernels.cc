@@ -2,11 +2,72 @@
 // Licensed under the MIT License.
 
 #include "nccl_kernels.h"
+#include "nccl_compression_impl.h"
 
 namespace onnxruntime {
 namespace cuda {
 
 NcclAllReduce::NcclAllReduce(const OpKernelInfo& info) : NcclKernel(info) {
+  compression_ = info.GetAttrOrDefault<int64_t>("compression", 0) == 1;
+}
+
+template <typename T>
+Status NcclAllReduce::CompressedAllReduce(const T* input_data, T* output_data, size_t count, ncclComm_t comm) const {
+  const int rank = nccl_->Rank(group_type_);
+  const int size = nccl_->Size(group_type_);
+
+  // Each rank reduces one shard made of whole quantization blocks.
+  const size_t shard_block_count = (count + size * kCompressionBlockSize - 1) / (size * kCompressionBlockSize);
+  const size_t shard_count = shard_block_count * kCompressionBlockSize;
+  const size_t padded_count = shard_count * size;
+
+  std::lock_guard<std::mutex> lock(residual_mutex_);
+  if (residual_count_ != count) {
+    residual_ = IAllocator::MakeUniquePtr<float>(Info().GetAllocator(0, OrtMemTypeDefault), count);
+    CUDA_RETURN_IF_ERROR(cudaMemsetAsync(residual_.get(), 0, count * sizeof(float), Stream()));
+    residual_count_ = count;
+  }
+
+  auto quantized = GetScratchBuffer<int8_t>(padded_count);
+  auto scales = GetScratchBuffer<float>(padded_count / kCompressionBlockSize);
+  QuantizeBlocksImpl(Stream(), input_data, residual_.get(), quantized.get(), scales.get(), count, padded_count);
+
+  // Reduce-scatter: shard r of every rank is sent to rank r, which sums them.
+  auto received_quantized = GetScratchBuffer<int8_t>(padded_count);
+  auto received_scales = GetScratchBuffer<float>(padded_count / kCompressionBlockSize);
+#ifdef ORT_USE_NCCL
+  NCCL_RETURN_IF_ERROR(ncclGroupStart());
+  for (int peer = 0; peer < size; peer++) {
+    NCCL_RETURN_IF_ERROR(ncclSend(quantized.get() + peer * shard_count, shard_count, ncclInt8, peer, comm,
+                                  Stream()));
+    NCCL_RETURN_IF_ERROR(ncclSend(scales.get() + peer * shard_block_count, shard_block_count, ncclFloat32, peer,
+                                  comm, Stream()));
+    NCCL_RETURN_IF_ERROR(ncclRecv(received_quantized.get() + peer * shard_count, shard_count, ncclInt8, peer, comm,
+                                  Stream()));
+    NCCL_RETURN_IF_ERROR(ncclRecv(received_scales.get() + peer * shard_block_count, shard_block_count, ncclFloat32,
+                                  peer, comm, Stream()));
+  }
+  NCCL_RETURN_IF_ERROR(ncclGroupEnd());
+#endif
+
+  auto shard_sum = GetScratchBuffer<float>(shard_count);
+  DequantizeAndSumShardsImpl(Stream(), received_quantized.get(), received_scales.get(), size, shard_count,
+                             shard_sum.get());
+
+  // All-gather the re-quantized sums in place.
+  int8_t* rank_quantized = quantized.get() + rank * shard_count;
+  float* rank_scales = scales.get() + rank * shard_block_count;
+  QuantizeBlocksImpl<float>(Stream(), shard_sum.get(), nullptr, rank_quantized, rank_scales, shard_count,
+                            shard_count);
+#ifdef ORT_USE_NCCL
+  NCCL_RETURN_IF_ERROR(ncclGroupStart());
+  NCCL_RETURN_IF_ERROR(ncclAllGather(rank_quantized, quantized.get(), shard_count, ncclInt8, comm, Stream()));
+  NCCL_RETURN_IF_ERROR(ncclAllGather(rank_scales, scales.get(), shard_block_count, ncclFloat32, comm, Stream()));
+  NCCL_RETURN_IF_ERROR(ncclGroupEnd());
+#endif
+
+  DequantizeBlocksImpl(Stream(), quantized.get(), scales.get(), output_data, count);
+  return Status::OK();
 }
 
 Status NcclAllReduce::ComputeInternal(OpKernelContext* context) const {
@@ -29,6 +90,18 @@ Status NcclAllReduce::ComputeInternal(OpKernelContext* context) const {
     context->Output(i, context->Input<Tensor>(i)->Shape());
   }
 
+  // Compression only pays off when there is something to send. Double tensors are always reduced exactly.
+  if (compression_ && nccl_->Size(group_type_) > 1) {
+    if (onnx_type == DataTypeImpl::GetType<float>()) {
+      return CompressedAllReduce(static_cast<const float*>(input_data), static_cast<float*>(output_data),
+                                 input_count, comm);
+    }
+    if (onnx_type == DataTypeImpl::GetType<MLFloat16>()) {
+      return CompressedAllReduce(static_cast<const half*>(input_data), static_cast<half*>(output_data),
+                                 input_count, comm);
+    }
+  }
+
   ncclDataType_t dtype = GetNcclDataType(onnx_type);
 #ifdef ORT_USE_NCCL
   NCCL_RETURN_IF_ERROR(ncclAllReduce(input_data, output_data, input_count, dtype, ncclSum, comm, Stream()));
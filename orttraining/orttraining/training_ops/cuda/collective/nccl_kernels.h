@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "nccl_common.h"
 
 namespace onnxruntime {
@@ -13,6 +15,19 @@ class NcclAllReduce final : public NcclKernel {
   explicit NcclAllReduce(const OpKernelInfo& info);
 
   Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  // Sums the int8 quantized inputs of all the ranks with a reduce-scatter through ncclSend/ncclRecv followed by an
+  // all-gather, so each rank moves about 2 bytes per element instead of twice the element size.
+  template <typename T>
+  Status CompressedAllReduce(const T* input_data, T* output_data, size_t count, ncclComm_t comm) const;
+
+  bool compression_;
+
+  // Quantization error of the previous step, added to the input of the next one.
+  mutable std::mutex residual_mutex_;
+  mutable IAllocatorUniquePtr<float> residual_;
+  mutable size_t residual_count_ = 0;
 };
 
 class NcclAllGather final : public NcclKernel {
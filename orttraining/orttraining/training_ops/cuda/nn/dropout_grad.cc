@@ -14,22 +14,30 @@ ONNX_OPERATOR_KERNEL_EX(DropoutGrad, kMSDomain, 1, kCudaExecutionProvider,
                             .TypeConstraint("T", BuildKernelDefConstraints<MLFloat16, float, double, BFloat16>())
                             .TypeConstraint("T1", BuildKernelDefConstraints<MLFloat16, float, double, BFloat16>())
                             .TypeConstraint("T2", DataTypeImpl::GetTensorType<bool>())
-                            .InputMemoryType(OrtMemTypeCPUInput, 2),
+                            .InputMemoryType(OrtMemTypeCPUInput, 2)
+                            .InputMemoryType(OrtMemTypeCPUInput, 3)
+                            .InputMemoryType(OrtMemTypeCPUInput, 4),
                         DropoutGrad);
 
 template <typename T>
 struct DropoutGradComputeImpl {
-  void operator()(cudaStream_t stream,
+  void operator()(const cudaDeviceProp& prop,
+                  cudaStream_t stream,
                   const int64_t N,
                   const Tensor& dY,
                   const bool* mask_data,
+                  const std::pair<uint64_t, uint64_t>& seeds,
                   const float ratio_data,
                   Tensor& dX) const {
     typedef typename ToCudaType<T>::MappedType CudaT;
 
     const CudaT* dY_data = reinterpret_cast<const CudaT*>(dY.template Data<T>());
     CudaT* dX_data = reinterpret_cast<CudaT*>(dX.template MutableData<T>());
-    DropoutGradientKernelImpl<CudaT>(stream, N, dY_data, mask_data, ratio_data, dX_data);
+    if (mask_data) {
+      DropoutGradientKernelImpl<CudaT>(stream, N, dY_data, mask_data, ratio_data, dX_data);
+    } else {
+      DropoutGradientKernelImpl<CudaT>(prop, stream, N, dY_data, seeds, ratio_data, dX_data);
+    }
   }
 };
 
@@ -38,9 +46,20 @@ Status DropoutGrad::ComputeInternal(OpKernelContext* context) const {
   const TensorShape& shape = dY->Shape();
   const int64_t N = shape.Size();
 
+  // Either the mask, or the philox state of the dropout to regenerate the mask from.
+  const bool* mask_data = nullptr;
+  std::pair<uint64_t, uint64_t> seeds{0, 0};
   auto mask = context->Input<Tensor>(1);
-  ORT_ENFORCE(mask->Shape().Size() == N);
-  const bool* mask_data = mask->template Data<bool>();
+  if (mask) {
+    ORT_ENFORCE(mask->Shape().Size() == N);
+    mask_data = mask->template Data<bool>();
+  } else {
+    auto philox_state = context->Input<Tensor>(4);
+    ORT_RETURN_IF_NOT(philox_state && philox_state->Shape().Size() == 2,
+                      "DropoutGrad requires either the mask or the philox_state input.");
+    const int64_t* philox_state_data = philox_state->template Data<int64_t>();
+    seeds = std::make_pair(static_cast<uint64_t>(philox_state_data[0]), static_cast<uint64_t>(philox_state_data[1]));
+  }
 
   //Get the ratio_data
   float ratio_data = default_ratio_;
@@ -50,10 +69,18 @@ Status DropoutGrad::ComputeInternal(OpKernelContext* context) const {
     t_disp.Invoke<GetRatioDataImpl>(ratio, ratio_data);
   }
 
+  // A regenerated mask must use the ratio the dropout ran with, which is 0 outside of training mode.
+  if (!mask_data) {
+    auto training_mode = context->Input<Tensor>(3);
+    if (training_mode == nullptr || !*(training_mode->template Data<bool>())) {
+      ratio_data = 0.0f;
+    }
+  }
+
   auto dX = context->Output(0, shape);
 
   utils::MLTypeCallDispatcher<float, MLFloat16, double, BFloat16> t_disp(dY->GetElementType());
-  t_disp.Invoke<DropoutGradComputeImpl>(Stream(), N, *dY, mask_data, ratio_data, *dX);
+  t_disp.Invoke<DropoutGradComputeImpl>(GetDeviceProp(), Stream(), N, *dY, mask_data, seeds, ratio_data, *dX);
 
   return Status::OK();
 }
@@ -18,6 +18,7 @@
 
 #include "core/providers/cuda/cu_inc/common.cuh"
 #include "orttraining/training_ops/cuda/nn/dropout_grad_impl.h"
+#include "core/providers/cuda/nn/dropout_impl.h"
 #include <curand_kernel.h>
 #include <algorithm>
 
@@ -85,6 +86,42 @@ __global__ void DropoutGradientVectorizedKernel(
 
 }
 
+// Must generate its random numbers exactly like DropoutKernel and BiasDropoutKernel, so it is launched with the
+// same grid and draws one float4 per thread for every UNROLL elements.
+template <typename T>
+__global__ void DropoutGradientRecomputeKernel(
+    const int64_t N,
+    const T* dY_data,
+    const float ratio,
+    const std::pair<uint64_t, uint64_t> seeds,
+    T* dX_data) {
+  const float p = 1.0f - ratio;
+  const float scale = 1.0f / p;
+
+  CUDA_LONG idx = blockDim.x * blockIdx.x + threadIdx.x;
+  CUDA_LONG step_size = gridDim.x * blockDim.x * UNROLL;
+
+  curandStatePhilox4_32_10_t state;
+  curand_init(seeds.first, idx, seeds.second, &state);
+
+  float4 rand;
+
+  for (CUDA_LONG id = idx * UNROLL; id < N; id += step_size) {
+    rand = curand_uniform4(&state);
+
+    #pragma unroll
+    for (int i = 0; i < UNROLL; i++) {
+      CUDA_LONG li = id + i;
+      if (li < N) {
+        const bool mask = (&rand.x)[i] < p;
+        dX_data[li] = T(float(dY_data[li]) * mask * scale);
+      }
+    }
+
+    __syncthreads();
+  }
+}
+
 template <typename T>
 void DropoutGradientKernelImpl(
     cudaStream_t stream,
@@ -111,6 +148,26 @@ void DropoutGradientKernelImpl(
   }
 }
 
+template <typename T>
+void DropoutGradientKernelImpl(
+    const cudaDeviceProp& prop,
+    cudaStream_t stream,
+    const int64_t N,
+    const T* dY_data,
+    const std::pair<uint64_t, uint64_t>& seeds,
+    const float ratio,
+    T* dX_data) {
+  if (ratio == 0.0f) {
+    if (dY_data != dX_data) {
+      CUDA_CALL_THROW(cudaMemcpyAsync(dX_data, dY_data, N * sizeof(T), cudaMemcpyDeviceToDevice, stream));
+    }
+  } else {
+    static_assert(UNROLL == kDropoutUnroll, "The mask must be regenerated with the unroll of the dropout kernels.");
+    DropoutGradientRecomputeKernel<T><<<DropoutGridSize(prop, N), kDropoutBlockSize, 0, stream>>>(
+        N, dY_data, ratio, seeds, dX_data);
+  }
+}
+
 #define SPECIALIZED_DROPOUT_GRAD_IMPL(T)   \
   template void DropoutGradientKernelImpl( \
       cudaStream_t stream,           \
@@ -118,6 +175,14 @@ void DropoutGradientKernelImpl(
       const T* dY_data,                    \
       const bool* mask_data,               \
       const float scale,                   \
+      T* dX_data);                         \
+  template void DropoutGradientKernelImpl( \
+      const cudaDeviceProp& prop,          \
+      cudaStream_t stream,                 \
+      const int64_t N,                     \
+      const T* dY_data,                    \
+      const std::pair<uint64_t, uint64_t>& seeds, \
+      const float ratio,                   \
       T* dX_data);
 
 SPECIALIZED_DROPOUT_GRAD_IMPL(float)
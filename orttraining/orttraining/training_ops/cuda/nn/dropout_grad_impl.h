@@ -17,5 +17,16 @@ void DropoutGradientKernelImpl(
   const float ratio,
   T* dX_data);
 
+// Regenerates the mask from the Philox seed and offset of the dropout launch instead of reading it.
+template <typename T>
+void DropoutGradientKernelImpl(
+  const cudaDeviceProp& prop,
+  cudaStream_t stream,
+  const int64_t N,
+  const T* dY_data,
+  const std::pair<uint64_t, uint64_t>& seeds,
+  const float ratio,
+  T* dX_data);
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -61,6 +61,7 @@ Status ZeroGradient<T>::ComputeInternal(OpKernelContext* ctx) const {
       ZeroGradient<T>);
 REGISTER_ZERO_GRADIENT_TYPED(float)
 REGISTER_ZERO_GRADIENT_TYPED(MLFloat16)
+REGISTER_ZERO_GRADIENT_TYPED(BFloat16)
 
 template <typename T, typename T_GRAD>
 Status InPlaceAccumulator<T, T_GRAD>::ComputeInternal(OpKernelContext* ctx) const {
@@ -6,6 +6,7 @@
 
 #include "core/providers/cuda/reduction/reduction_functions.h"
 #include "core/providers/cuda/math/binary_elementwise_ops.h"
+#include "orttraining/training_ops/cuda/optimizer/common.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -42,5 +43,141 @@ Status SGDOptimizer::ComputeInternal(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+// Inputs are update_signal, loss_scale, gradient_norm and ETA, followed by groups of [w, g, w_mixed_precision].
+// Outputs are groups of [w_new, g_new, w_mixed_precision_new].
+constexpr int kSGDV2NonGroupedInputCount = 4;
+constexpr int kSGDV2GroupSize = 3;
+constexpr int kSGDV2MaxGroupCount = 1024;
+
+std::vector<std::pair<int, int>> GenerateSGDV2AliasMapping() {
+  std::vector<std::pair<int, int>> alias_pairs{};
+  for (int i = 0; i < kSGDV2MaxGroupCount; ++i) {
+    const int input = kSGDV2NonGroupedInputCount + i * kSGDV2GroupSize;
+    const int output = i * kSGDV2GroupSize;
+    // w --> w_new
+    alias_pairs.emplace_back(std::make_pair(input, output));
+    // g --> g_new
+    alias_pairs.emplace_back(std::make_pair(input + 1, output + 1));
+    // w_mixed_precision --> w_mixed_precision_new
+    alias_pairs.emplace_back(std::make_pair(input + 2, output + 2));
+  }
+  return alias_pairs;
+}
+
+#define REGISTER_SGD_V2_KERNEL_TYPED(T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP)                        \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                       \
+      SGDOptimizerV2,                                                                                  \
+      kMSDomain,                                                                                       \
+      1,                                                                                               \
+      T_GRAD##_##T_GRAD_NORM##_##T_MIXED_PRECISION_FP,                                                 \
+      kCudaExecutionProvider,                                                                          \
+      (*KernelDefBuilder::Create())                                                                    \
+          .Alias(GenerateSGDV2AliasMapping())                                                          \
+          .InputMemoryType(OrtMemTypeCPUInput, 0) /* Keep do_update in CPU */                          \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())                                  \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<float>())                                  \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<T_GRAD>())                                 \
+          .TypeConstraint("T_MIXED_PRECISION_FP", DataTypeImpl::GetTensorType<T_MIXED_PRECISION_FP>()) \
+          .TypeConstraint("T_GRAD_NORM", DataTypeImpl::GetTensorType<T_GRAD_NORM>()),                  \
+      SGDOptimizerV2<T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>);
+
+REGISTER_SGD_V2_KERNEL_TYPED(float, float, MLFloat16)
+REGISTER_SGD_V2_KERNEL_TYPED(MLFloat16, float, MLFloat16)
+REGISTER_SGD_V2_KERNEL_TYPED(MLFloat16, MLFloat16, MLFloat16)
+REGISTER_SGD_V2_KERNEL_TYPED(float, float, BFloat16)
+REGISTER_SGD_V2_KERNEL_TYPED(BFloat16, float, BFloat16)
+REGISTER_SGD_V2_KERNEL_TYPED(BFloat16, BFloat16, BFloat16)
+
+template <typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+Status SGDOptimizerV2<T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::ComputeInternal(OpKernelContext* ctx) const {
+  typedef typename ToCudaType<T_GRAD>::MappedType CudaT_GRAD;
+  typedef typename ToCudaType<T_GRAD_NORM>::MappedType CudaT_GRAD_NORM;
+  typedef typename ToCudaType<T_MIXED_PRECISION_FP>::MappedType CudaT_MIXED_PRECISION_FP;
+
+  const int grouped_input_tensor_count = ctx->InputCount() - kSGDV2NonGroupedInputCount;
+  ORT_ENFORCE(grouped_input_tensor_count > 0 && grouped_input_tensor_count % kSGDV2GroupSize == 0,
+              "Input count must be ", kSGDV2NonGroupedInputCount, " + ", kSGDV2GroupSize,
+              " x (number of weights to optimize).");
+  ORT_ENFORCE(ctx->OutputCount() == grouped_input_tensor_count,
+              "Input and output tensor counts are not aligned. Please check SGDOptimizerV2's input and output lists.");
+  const int group_count = grouped_input_tensor_count / kSGDV2GroupSize;
+
+  // If gradient norm is not finite, the weights are kept as they are.
+  bool update_signal = true;
+  if (ctx->Input<Tensor>(0)) {
+    update_signal = *ctx->Input<Tensor>(0)->template Data<bool>();
+  }
+
+  const float* loss_scale_data = ctx->Input<Tensor>(1) ? ctx->Input<Tensor>(1)->template Data<float>() : nullptr;
+  const CudaT_GRAD_NORM* g_norm_data =
+      ctx->Input<Tensor>(2)
+          ? reinterpret_cast<const CudaT_GRAD_NORM*>(ctx->Input<Tensor>(2)->template Data<T_GRAD_NORM>())
+          : nullptr;
+  ORT_ENFORCE(ctx->Input<Tensor>(3), "Learning rate tensor should not be null.");
+  const float* eta_data = ctx->Input<Tensor>(3)->template Data<float>();
+
+  std::vector<int> tensor_sizes;
+  std::vector<std::vector<void*>> tensor_pointers;
+  tensor_sizes.reserve(group_count);
+  tensor_pointers.reserve(group_count);
+  for (int group_index = 0; group_index < group_count; ++group_index) {
+    const int input_start_index = kSGDV2NonGroupedInputCount + group_index * kSGDV2GroupSize;
+    const int output_start_index = group_index * kSGDV2GroupSize;
+    const Tensor* w = ctx->Input<Tensor>(input_start_index);
+    const Tensor* g = ctx->Input<Tensor>(input_start_index + 1);
+    const Tensor* w_mixed_precision = ctx->Input<Tensor>(input_start_index + 2);
+    ORT_ENFORCE(w, "Weight tensor should not be null.");
+    ORT_ENFORCE(g, "Gradient tensor should not be null.");
+    ORT_ENFORCE(w->Shape() == g->Shape());
+
+    Tensor* w_new = ctx->Output(output_start_index, w->Shape());
+    Tensor* g_new = ctx->Output(output_start_index + 1, g->Shape());
+    Tensor* w_mixed_precision_new =
+        w_mixed_precision != nullptr ? ctx->Output(output_start_index + 2, w_mixed_precision->Shape()) : nullptr;
+    if (w_mixed_precision_new != nullptr) {
+      ORT_ENFORCE(w_mixed_precision->Shape() == w->Shape());
+    }
+
+    if (!update_signal) {
+      if (w_new != nullptr) {
+        ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<float>(Stream(), *w, *w_new));
+      }
+      if (g_new != nullptr) {
+        ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T_GRAD>(Stream(), *g, *g_new));
+      }
+      if (w_mixed_precision_new != nullptr) {
+        ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T_MIXED_PRECISION_FP>(Stream(), *w_mixed_precision, *w_mixed_precision_new));
+      }
+      continue;
+    }
+
+    if (w->Shape().Size() == 0) {
+      continue;
+    }
+
+    tensor_sizes.push_back(static_cast<int>(w->Shape().Size()));
+    tensor_pointers.push_back({
+        const_cast<float*>(w->template Data<float>()),
+        const_cast<T_GRAD*>(g->template Data<T_GRAD>()),
+        w_new != nullptr ? w_new->template MutableData<float>() : nullptr,
+        g_new != nullptr ? g_new->template MutableData<T_GRAD>() : nullptr,
+        w_mixed_precision_new != nullptr ? w_mixed_precision_new->template MutableData<T_MIXED_PRECISION_FP>() : nullptr,
+    });
+  }
+
+  if (tensor_sizes.empty()) {
+    return Status::OK();
+  }
+
+  typedef SGDMultiTensorFunctor<CudaT_GRAD, CudaT_GRAD_NORM, CudaT_MIXED_PRECISION_FP> TFunctor;
+  TFunctor functor;
+  const int chunk_size = 2048 * 32;
+  launch_multi_tensor_functor<5, TFunctor>(
+      Stream(), chunk_size, tensor_sizes, tensor_pointers, functor,
+      eta_data, loss_scale_data, g_norm_data, max_norm_clip_);
+
+  return Status::OK();
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -15,5 +15,20 @@ class SGDOptimizer final : public CudaKernel {
   Status ComputeInternal(OpKernelContext* context) const override;
 };
 
+// Multi-tensor SGD, which updates all the weights of its [w, g, w_mixed_precision] groups with a few launches.
+template <typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+class SGDOptimizerV2 final : public CudaKernel {
+ public:
+  SGDOptimizerV2(const OpKernelInfo& info) : CudaKernel(info) {
+    max_norm_clip_ = info.GetAttrOrDefault("max_norm_clip", 1.0f);
+    ORT_ENFORCE(max_norm_clip_ != 0, "max_norm_clip must NOT be 0.");
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  float max_norm_clip_;
+};
+
 }  // namespace cuda
 }  // namespace onnxruntime
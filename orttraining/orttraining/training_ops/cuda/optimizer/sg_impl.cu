@@ -5,6 +5,7 @@
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
 #include "core/providers/cuda/atomic/common.cuh"
+#include "orttraining/training_ops/cuda/optimizer/common.cuh"
 
 namespace onnxruntime {
 namespace cuda {
@@ -61,5 +62,79 @@ void SGDOptimizerImpl(
 
 SPECIALIZED_IMPL__SGDOptimizerImpl(float)
 
+template <typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+__global__ void SGDMultiTensorImpl(
+    ChunkGroup<5> chunk_group,
+    const float* eta,
+    const float* loss_scale,
+    const T_GRAD_NORM* grad_norm,
+    const float max_norm) {
+  const int group_index = chunk_group.block_index_to_tensor_group_index[blockIdx.x];
+  const int tensor_size = chunk_group.tensor_sizes[group_index];
+  const int chunk_size = chunk_group.chunk_size;
+  const int chunk_start = chunk_group.block_index_to_chunk_start_index[blockIdx.x];
+
+  const float* w = reinterpret_cast<const float*>(chunk_group.tensor_ptrs[0][group_index]) + chunk_start;
+  const T_GRAD* g = reinterpret_cast<const T_GRAD*>(chunk_group.tensor_ptrs[1][group_index]) + chunk_start;
+  float* w_new = chunk_group.tensor_ptrs[2][group_index] != nullptr ? reinterpret_cast<float*>(chunk_group.tensor_ptrs[2][group_index]) + chunk_start : nullptr;
+  T_GRAD* g_new = chunk_group.tensor_ptrs[3][group_index] != nullptr ? reinterpret_cast<T_GRAD*>(chunk_group.tensor_ptrs[3][group_index]) + chunk_start : nullptr;
+  T_MIXED_PRECISION_FP* w_mixed_precision_new = chunk_group.tensor_ptrs[4][group_index] != nullptr ? reinterpret_cast<T_MIXED_PRECISION_FP*>(chunk_group.tensor_ptrs[4][group_index]) + chunk_start : nullptr;
+
+  // The gradients are divided by the loss scale, and by their global norm over max_norm when it is larger.
+  const float g_scale = _ComputeGradScale<float, T_GRAD_NORM, float>(loss_scale, grad_norm, max_norm);
+  const float step = -(*eta) / g_scale;
+
+  for (int i = threadIdx.x; i < chunk_size && i + chunk_start < tensor_size; i += blockDim.x) {
+    const float delta = step * static_cast<float>(g[i]);
+    if (g_new != nullptr) {
+      g_new[i] = static_cast<T_GRAD>(delta);
+    }
+    if (w_new != nullptr || w_mixed_precision_new != nullptr) {
+      const float w_updated = w[i] + delta;
+      if (w_new != nullptr) {
+        w_new[i] = w_updated;
+      }
+      if (w_mixed_precision_new != nullptr) {
+        w_mixed_precision_new[i] = static_cast<T_MIXED_PRECISION_FP>(w_updated);
+      }
+    }
+  }
+}
+
+template <typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+void SGDMultiTensorFunctor<T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::operator()(
+    cudaStream_t stream,
+    ChunkGroup<5> chunk_group,
+    const float* eta,
+    const float* loss_scale,
+    const T_GRAD_NORM* grad_norm,
+    const float max_norm) {
+  const int thread_count = ChunkGroup<5>::thread_count_per_block;
+  const int block_count = chunk_group.chunk_count;
+
+  SGDMultiTensorImpl<T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP><<<block_count, thread_count, 0, stream>>>(
+      chunk_group,
+      eta,
+      loss_scale,
+      grad_norm,
+      max_norm);
+}
+
+#define INSTANTIATE_SGD_MULTI_TENSOR_FUNCTOR(T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP)      \
+  template void SGDMultiTensorFunctor<T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::operator()( \
+      cudaStream_t stream,                                                                  \
+      ChunkGroup<5> chunk_group,                                                            \
+      const float* eta,                                                                     \
+      const float* loss_scale,                                                              \
+      const T_GRAD_NORM* grad_norm,                                                         \
+      const float max_norm);
+
+INSTANTIATE_SGD_MULTI_TENSOR_FUNCTOR(float, float, half)
+INSTANTIATE_SGD_MULTI_TENSOR_FUNCTOR(half, float, half)
+INSTANTIATE_SGD_MULTI_TENSOR_FUNCTOR(half, half, half)
+INSTANTIATE_SGD_MULTI_TENSOR_FUNCTOR(float, float, BFloat16)
+INSTANTIATE_SGD_MULTI_TENSOR_FUNCTOR(BFloat16, float, BFloat16)
+INSTANTIATE_SGD_MULTI_TENSOR_FUNCTOR(BFloat16, BFloat16, BFloat16)
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cuda_runtime.h>
+#include "core/providers/cuda/multi_tensor/common.cuh"
 
 namespace onnxruntime {
 namespace cuda {
@@ -16,5 +17,30 @@ void SGDOptimizerImpl(
     T* weight_out,
     T* gradients_out,
     size_t count);
+
+// SGDOptimizerV2 maps [w, g] to [w_new, g_new, w_mixed_precision_new] where
+//  w: weight tensor
+//  g: gradient tensor
+//  w_new: updated weight tensor
+//  g_new: weight update, -eta * g once unscaled and clipped
+//  w_mixed_precision_new: updated weight tensor of mixed-precision type
+// There are 5 distinct tensors in total and therefore the type of chunk_group is ChunkGroup<5>.
+//
+// Tensor pointers associated with the i-th tensor in this chunk:
+//  w: chunk_group.tensor_ptrs[0][i]
+//  g: chunk_group.tensor_ptrs[1][i]
+//  w_new: chunk_group.tensor_ptrs[2][i]
+//  g_new: chunk_group.tensor_ptrs[3][i]
+//  w_mixed_precision_new: chunk_group.tensor_ptrs[4][i]
+template <typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+struct SGDMultiTensorFunctor {
+  void operator()(
+      cudaStream_t stream,
+      ChunkGroup<5> chunk_group,
+      const float* eta,
+      const float* loss_scale,
+      const T_GRAD_NORM* grad_norm,
+      const float max_norm);
+};
 }
 }  // namespace onnxruntime
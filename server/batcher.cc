@@ -0,0 +1,334 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <string>
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+
+static size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128:
+      return 16;
+    default:
+      // strings and undefined types can't be batched
+      return 0;
+  }
+}
+
+// Returns true if two tensors can be concatenated along dimension 0.
+static bool HaveSameInnerShape(const Ort::Value& a, const Ort::Value& b) {
+  auto a_info = a.GetTensorTypeAndShapeInfo();
+  auto b_info = b.GetTensorTypeAndShapeInfo();
+  if (a_info.GetElementType() != b_info.GetElementType()) {
+    return false;
+  }
+
+  auto a_shape = a_info.GetShape();
+  auto b_shape = b_info.GetShape();
+  return a_shape.size() == b_shape.size() && std::equal(a_shape.begin() + 1, a_shape.end(), b_shape.begin() + 1);
+}
+
+Ort::Value ConcatenateAlongBatchDimension(const std::vector<const Ort::Value*>& values) {
+  auto info = values.front()->GetTensorTypeAndShapeInfo();
+  auto element_type = info.GetElementType();
+  auto shape = info.GetShape();
+  size_t element_size = GetElementSize(element_type);
+  if (element_size == 0) {
+    throw Ort::Exception("Tensors of this element type can't be concatenated.", ORT_INVALID_ARGUMENT);
+  }
+
+  shape[0] = 0;
+  for (const auto* value : values) {
+    shape[0] += value->GetTensorTypeAndShapeInfo().GetShape()[0];
+  }
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto result = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), element_type);
+  auto* dst = static_cast<uint8_t*>(result.GetTensorMutableData<void>());
+  for (const auto* value : values) {
+    size_t num_bytes = value->GetTensorTypeAndShapeInfo().GetElementCount() * element_size;
+    if (num_bytes > 0) {
+      std::memcpy(dst, const_cast<Ort::Value*>(value)->GetTensorMutableData<void>(), num_bytes);
+      dst += num_bytes;
+    }
+  }
+
+  return result;
+}
+
+std::vector<Ort::Value> SplitAlongBatchDimension(const Ort::Value& value, const std::vector<size_t>& batch_sizes) {
+  auto info = value.GetTensorTypeAndShapeInfo();
+  auto element_type = info.GetElementType();
+  auto shape = info.GetShape();
+  size_t element_size = GetElementSize(element_type);
+  if (element_size == 0) {
+    throw Ort::Exception("Tensors of this element type can't be split.", ORT_INVALID_ARGUMENT);
+  }
+
+  if (shape.empty() ||
+      shape[0] != static_cast<int64_t>(std::accumulate(batch_sizes.begin(), batch_sizes.end(), size_t{0}))) {
+    throw Ort::Exception("Dimension 0 of the tensor doesn't match the total batch size.", ORT_INVALID_ARGUMENT);
+  }
+
+  size_t item_bytes = element_size * std::accumulate(shape.begin() + 1, shape.end(), size_t{1},
+                                                     [](size_t a, int64_t b) { return a * static_cast<size_t>(b); });
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  const auto* src = static_cast<const uint8_t*>(const_cast<Ort::Value&>(value).GetTensorMutableData<void>());
+  std::vector<Ort::Value> results;
+  results.reserve(batch_sizes.size());
+  for (auto batch_size : batch_sizes) {
+    shape[0] = static_cast<int64_t>(batch_size);
+    auto result = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), element_type);
+    size_t num_bytes = batch_size * item_bytes;
+    if (num_bytes > 0) {
+      std::memcpy(result.GetTensorMutableData<void>(), src, num_bytes);
+      src += num_bytes;
+    }
+    results.push_back(std::move(result));
+  }
+
+  return results;
+}
+
+Batcher::Batcher(RunFunction run, const BatchingOptions& options) : run_(std::move(run)),
+                                                                    options_(options) {
+  for (size_t i = 0; i < std::max<size_t>(options_.max_concurrent_batches, 1); ++i) {
+    workers_.emplace_back(&Batcher::WorkerLoop, this);
+  }
+}
+
+Batcher::~Batcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t Batcher::GetBatchSize(const std::vector<Ort::Value>& input_values) const {
+  if (input_values.empty()) {
+    return 0;
+  }
+
+  int64_t batch_size = -1;
+  for (const auto& value : input_values) {
+    if (!value.IsTensor()) {
+      return 0;
+    }
+
+    auto info = value.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    if (shape.empty() || GetElementSize(info.GetElementType()) == 0 ||
+        (batch_size != -1 && shape[0] != batch_size)) {
+      return 0;
+    }
+
+    batch_size = shape[0];
+  }
+
+  return batch_size > 0 && static_cast<size_t>(batch_size) < options_.max_batch_size
+             ? static_cast<size_t>(batch_size)
+             : 0;
+}
+
+std::vector<Ort::Value> Batcher::Run(const Ort::RunOptions& run_options,
+                                     const std::vector<std::string>& input_names,
+                                     const std::vector<Ort::Value>& input_values,
+                                     const std::vector<std::string>& output_names) {
+  size_t batch_size = GetBatchSize(input_values);
+  if (batch_size == 0) {
+    return run_(run_options, input_names, input_values, output_names);
+  }
+
+  auto request = std::make_unique<Request>();
+  request->run_options = &run_options;
+  request->input_names = &input_names;
+  request->input_values = &input_values;
+  request->output_names = &output_names;
+  request->batch_size = batch_size;
+  request->enqueue_time = std::chrono::steady_clock::now();
+  auto result = request->result.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(request));
+    queued_batch_size_ += batch_size;
+  }
+  cv_.notify_all();
+
+  return result.get();
+}
+
+static bool CanBatchTogether(const std::vector<std::string>& a_input_names,
+                             const std::vector<Ort::Value>& a_input_values,
+                             const std::vector<std::string>& a_output_names,
+                             const std::vector<std::string>& b_input_names,
+                             const std::vector<Ort::Value>& b_input_values,
+                             const std::vector<std::string>& b_output_names) {
+  if (a_input_names != b_input_names || a_output_names != b_output_names) {
+    return false;
+  }
+
+  // runs on a worker thread, so a tensor that can't be inspected is treated as not batchable rather than thrown
+  try {
+    for (size_t i = 0; i < a_input_values.size(); ++i) {
+      if (!HaveSameInnerShape(a_input_values[i], b_input_values[i])) {
+        return false;
+      }
+    }
+  } catch (...) {
+    return false;
+  }
+
+  return true;
+}
+
+void Batcher::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      // stop_ is set and all requests have been run
+      return;
+    }
+
+    // wait for more requests until the batch is full or the first request has waited long enough.
+    // Another worker may take the queued requests meanwhile, so check the queue again after waiting.
+    auto deadline = queue_.front()->enqueue_time + options_.max_queue_delay;
+    if (!stop_ && queued_batch_size_ < options_.max_batch_size && std::chrono::steady_clock::now() < deadline) {
+      cv_.wait_until(lock, deadline);
+      continue;
+    }
+
+    std::vector<std::unique_ptr<Request>> batch;
+    batch.push_back(std::move(queue_.front()));
+    queue_.pop_front();
+    size_t total_batch_size = batch.front()->batch_size;
+
+    const Request& first = *batch.front();
+    for (auto it = queue_.begin(); it != queue_.end() && total_batch_size < options_.max_batch_size;) {
+      const Request& candidate = **it;
+      if (total_batch_size + candidate.batch_size <= options_.max_batch_size &&
+          CanBatchTogether(*first.input_names, *first.input_values, *first.output_names,
+                           *candidate.input_names, *candidate.input_values, *candidate.output_names)) {
+        total_batch_size += candidate.batch_size;
+        batch.push_back(std::move(*it));
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    queued_batch_size_ -= total_batch_size;
+
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+void Batcher::RunBatch(std::vector<std::unique_ptr<Request>>& batch) {
+  if (batch.size() == 1) {
+    auto& request = *batch.front();
+    try {
+      request.result.set_value(
+          run_(*request.run_options, *request.input_names, *request.input_values, *request.output_names));
+    } catch (...) {
+      request.result.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  const auto& input_names = *batch.front()->input_names;
+  const auto& output_names = *batch.front()->output_names;
+
+  std::vector<size_t> batch_sizes;
+  batch_sizes.reserve(batch.size());
+  for (const auto& request : batch) {
+    batch_sizes.push_back(request->batch_size);
+  }
+
+  std::vector<std::vector<Ort::Value>> request_outputs(batch.size());
+  try {
+    std::vector<Ort::Value> batched_inputs;
+    batched_inputs.reserve(input_names.size());
+    for (size_t i = 0; i < input_names.size(); ++i) {
+      std::vector<const Ort::Value*> values;
+      values.reserve(batch.size());
+      for (const auto& request : batch) {
+        values.push_back(&(*request->input_values)[i]);
+      }
+      batched_inputs.push_back(ConcatenateAlongBatchDimension(values));
+    }
+
+    Ort::RunOptions run_options;
+    int verbosity_level = 0;
+    int severity_level = ORT_LOGGING_LEVEL_FATAL;
+    std::string run_tag;
+    for (const auto& request : batch) {
+      verbosity_level = std::max(verbosity_level, request->run_options->GetRunLogVerbosityLevel());
+      severity_level = std::min(severity_level, request->run_options->GetRunLogSeverityLevel());
+      const char* request_run_tag = request->run_options->GetRunTag();
+      if (request_run_tag != nullptr && *request_run_tag != '\0') {
+        run_tag += run_tag.empty() ? request_run_tag : std::string(",") + request_run_tag;
+      }
+    }
+    run_options.SetRunLogVerbosityLevel(verbosity_level);
+    run_options.SetRunLogSeverityLevel(severity_level);
+    run_options.SetRunTag(run_tag.c_str());
+
+    auto batched_outputs = run_(run_options, input_names, batched_inputs, output_names);
+
+    for (auto& batched_output : batched_outputs) {
+      auto outputs = SplitAlongBatchDimension(batched_output, batch_sizes);
+      for (size_t r = 0; r < batch.size(); ++r) {
+        request_outputs[r].push_back(std::move(outputs[r]));
+      }
+    }
+  } catch (...) {
+    // The model may not be batchable after all, e.g. if an output doesn't have the batch dimension, or the batch
+    // may be too large to concatenate or to run. Run the requests one by one so that each gets its own result or
+    // error, as nothing may escape the worker thread.
+    for (auto& request : batch) {
+      std::vector<std::unique_ptr<Request>> single;
+      single.push_back(std::move(request));
+      RunBatch(single);
+    }
+    return;
+  }
+
+  for (size_t r = 0; r < batch.size(); ++r) {
+    batch[r]->result.set_value(std::move(request_outputs[r]));
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
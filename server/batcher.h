@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+struct BatchingOptions {
+  // Maximum number of items along the batch dimension in one Session::Run. A value of 1 disables batching.
+  size_t max_batch_size = 1;
+
+  // Maximum time the first request of a batch waits for more requests before the batch is run.
+  std::chrono::microseconds max_queue_delay{1000};
+
+  // Maximum number of batches run at the same time. Requests that can't be batched together keep running
+  // concurrently instead of waiting for each other.
+  size_t max_concurrent_batches = 4;
+};
+
+// Coalesces concurrent requests for one model along the batch dimension (dimension 0) and runs them with a single
+// Session::Run, then splits the outputs back per request.
+//
+// Requests are batched together if they have the same input names, output names, element types and dimensions
+// other than the batch dimension. Requests that can't be batched, e.g. because they have string inputs or are larger
+// than the maximum batch size, are run directly on the calling thread.
+//
+// A request that runs on its own uses its own run options. A batched run logs at the most verbose level of its
+// requests and is tagged with all their run tags.
+class Batcher {
+ public:
+  using RunFunction = std::function<std::vector<Ort::Value>(const Ort::RunOptions& run_options,
+                                                            const std::vector<std::string>& input_names,
+                                                            const std::vector<Ort::Value>& input_values,
+                                                            const std::vector<std::string>& output_names)>;
+
+  Batcher(RunFunction run, const BatchingOptions& options);
+  ~Batcher();
+  Batcher(const Batcher&) = delete;
+  Batcher& operator=(const Batcher&) = delete;
+
+  // Runs a request, possibly as part of a batch. Blocks until the outputs are available.
+  // Throws the exception of the run on failure, Ort::Exception for errors of the session.
+  std::vector<Ort::Value> Run(const Ort::RunOptions& run_options,
+                              const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+ private:
+  struct Request {
+    const Ort::RunOptions* run_options;
+    const std::vector<std::string>* input_names;
+    const std::vector<Ort::Value>* input_values;
+    const std::vector<std::string>* output_names;
+    size_t batch_size;
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::promise<std::vector<Ort::Value>> result;
+  };
+
+  // Returns the batch size of the request, or 0 if it can't be batched.
+  size_t GetBatchSize(const std::vector<Ort::Value>& input_values) const;
+
+  void WorkerLoop();
+  void RunBatch(std::vector<std::unique_ptr<Request>>& batch);
+
+  const RunFunction run_;
+  const BatchingOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Request>> queue_;
+  size_t queued_batch_size_ = 0;
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
+
+// Concatenates tensors with the same element type and the same dimensions other than dimension 0 along
+// dimension 0.
+Ort::Value ConcatenateAlongBatchDimension(const std::vector<const Ort::Value*>& values);
+
+// Splits a tensor along dimension 0 into tensors with the given sizes of dimension 0.
+std::vector<Ort::Value> SplitAlongBatchDimension(const Ort::Value& value, const std::vector<size_t>& batch_sizes);
+
+}  // namespace server
+}  // namespace onnxruntime
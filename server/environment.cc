@@ -1,9 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
 #include <memory>
 #include "environment.h"
+#include "executor.h"
 #include "onnxruntime_cxx_api.h"
+#include "onnxruntime_session_options_config_keys.h"
 
 #ifdef USE_DNNL
 
@@ -56,14 +59,54 @@ void ORT_API_CALL Log(void* param, OrtLoggingLevel severity, const char* categor
   return;
 }
 
-ServerEnvironment::ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink) : severity_(severity),
-                                                                                               logger_id_("ServerApp"),
-                                                                                               sink_(sink),
-                                                                                               default_logger_(std::make_shared<spdlog::logger>(logger_id_, sink)),
-                                                                                               runtime_environment_(severity, logger_id_.c_str(), Log, default_logger_.get()) {
+static Ort::Env CreateRuntimeEnvironment(OrtLoggingLevel severity, const std::string& logger_id, spdlog::logger* logger,
+                                         bool use_global_thread_pools) {
+  if (!use_global_thread_pools) {
+    return Ort::Env(severity, logger_id.c_str(), Log, logger);
+  }
+
+  // Default sized pools shared by all the sessions instead of a pair of pools per session
+  OrtThreadingOptions* threading_options = nullptr;
+  Ort::ThrowOnError(Ort::GetApi().CreateThreadingOptions(&threading_options));
+  Ort::Env env{nullptr};
+  try {
+    env = Ort::Env(threading_options, Log, logger, severity, logger_id.c_str());
+  } catch (...) {
+    Ort::GetApi().ReleaseThreadingOptions(threading_options);
+    throw;
+  }
+  Ort::GetApi().ReleaseThreadingOptions(threading_options);
+  return env;
+}
+
+ServerEnvironment::ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink,
+                                     const ModelRepositoryOptions& repository_options) : severity_(severity),
+                                                                                         logger_id_("ServerApp"),
+                                                                                         sink_(sink),
+                                                                                         default_logger_(std::make_shared<spdlog::logger>(logger_id_, sink)),
+                                                                                         repository_options_(repository_options),
+                                                                                         runtime_environment_(CreateRuntimeEnvironment(severity, logger_id_, default_logger_.get(), !repository_options.path.empty())) {
   spdlog::set_automatic_registration(false);
   spdlog::set_level(Convert(severity_));
   spdlog::initialize_logger(default_logger_);
+
+  if (!repository_options_.path.empty()) {
+    options_.DisablePerSessionThreads();
+
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    Ort::ArenaCfg arena_cfg{0, -1, -1, -1};
+    runtime_environment_.CreateAndRegisterAllocator(memory_info, arena_cfg);
+    options_.AddConfigEntry(kOrtSessionOptionsConfigUseEnvAllocators, "1");
+
+    Ort::ThrowOnError(Ort::GetApi().CreatePrepackedWeightsContainer(&prepacked_weights_container_));
+  }
+}
+
+ServerEnvironment::~ServerEnvironment() {
+  sessions_.clear();
+  if (prepacked_weights_container_ != nullptr) {
+    Ort::GetApi().ReleasePrepackedWeightsContainer(prepacked_weights_container_);
+  }
 }
 
 void ServerEnvironment::RegisterExecutionProviders(){
@@ -87,46 +130,155 @@ void ServerEnvironment::RegisterExecutionProviders(){
 }
 
 void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
-  RegisterExecutionProviders();
-  auto result = sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(model_name, model_version), std::forward_as_tuple(runtime_environment_, model_path.c_str(), options_));
+  auto model = LoadModel(model_path, model_name, model_version);
 
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  auto result = sessions_.emplace(std::make_pair(model_name, model_version), std::move(model));
   if (!result.second) {
     throw Ort::Exception("Model of that name already loaded.", ORT_INVALID_ARGUMENT);
   }
+}
 
-  auto iterator = result.first;
-  auto output_count = (iterator->second).session.GetOutputCount();
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::LoadModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
+  std::call_once(execution_providers_registered_, [this]() { RegisterExecutionProviders(); });
+  auto model = std::make_shared<SessionHolder>(runtime_environment_, model_path, options_, prepacked_weights_container_);
+  auto output_count = model->session.GetOutputCount();
 
   Ort::AllocatorWithDefaultOptions allocator;
   for (size_t i = 0; i < output_count; i++) {
-    auto name = (iterator->second).session.GetOutputName(i, allocator);
-    (iterator->second).output_names.push_back(name);
+    auto name = model->session.GetOutputName(i, allocator);
+    model->output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (batching_options_.max_batch_size > 1) {
+    // Requests can only be batched if all inputs are tensors with a dynamic batch dimension
+    const auto& session = model->session;
+    bool batchable = true;
+    for (size_t i = 0, input_count = session.GetInputCount(); i < input_count && batchable; i++) {
+      auto type_info = session.GetInputTypeInfo(i);
+      batchable = type_info.GetONNXType() == ONNX_TYPE_TENSOR &&
+                  type_info.GetTensorTypeAndShapeInfo().GetDimensionsCount() > 0 &&
+                  type_info.GetTensorTypeAndShapeInfo().GetShape()[0] < 0;
+    }
+
+    if (batchable) {
+      auto run = [&session](const Ort::RunOptions& run_options,
+                            const std::vector<std::string>& input_names,
+                            const std::vector<Ort::Value>& input_values,
+                            const std::vector<std::string>& output_names) {
+        return Run(session, run_options, input_names, input_values, output_names);
+      };
+      model->batcher = std::make_unique<Batcher>(run, batching_options_);
+      default_logger_->info("Batching requests for model {} version {} up to a batch size of {}",
+                            model_name, model_version, batching_options_.max_batch_size);
+    } else {
+      default_logger_->info("Not batching requests for model {} version {} as not all inputs have a dynamic batch dimension",
+                            model_name, model_version);
+    }
+  }
+
+  return model;
 }
 
-const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::AcquireModel(const std::string& model_name, const std::string& model_version) {
   auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
+  {
+    std::lock_guard<std::mutex> lock(models_mutex_);
+    auto it = sessions_.find(identifier);
+    if (it != sessions_.end()) {
+      auto last_use = repository_last_use_.find(identifier);
+      if (last_use != repository_last_use_.end()) {
+        last_use->second = ++use_counter_;
+      }
+      return it->second;
+    }
+  }
+
+  if (repository_options_.path.empty()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  if (model_name.find("..") != std::string::npos || model_version.find("..") != std::string::npos) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+  const std::string model_path = repository_options_.path + "/" + model_name + "/" + model_version + "/model.onnx";
+  std::ifstream model_file(model_path, std::ios::binary | std::ios::ate);
+  if (!model_file.good()) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
+  auto size_in_bytes = static_cast<size_t>(model_file.tellg());
+  model_file.close();
 
-  return it->second.output_names;
+  // The model is loaded without holding the lock so that the other models keep serving requests meanwhile.
+  default_logger_->info("Loading model {} version {} from the model repository", model_name, model_version);
+  auto model = LoadModel(model_path, model_name, model_version);
+  model->size_in_bytes = size_in_bytes;
+
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  auto result = sessions_.emplace(identifier, model);
+  if (!result.second) {
+    // Loaded by a concurrent request meanwhile
+    return result.first->second;
+  }
+  repository_last_use_[identifier] = ++use_counter_;
+  repository_bytes_ += size_in_bytes;
+  EvictModels();
+  return model;
 }
 
-OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
-  return severity_;
+void ServerEnvironment::EvictModels() {
+  if (repository_options_.memory_budget_bytes == 0) {
+    return;
+  }
+
+  // The most recently used model is always kept, even if it doesn't fit in the budget by itself
+  while (repository_bytes_ > repository_options_.memory_budget_bytes && repository_last_use_.size() > 1) {
+    auto least_recently_used = repository_last_use_.begin();
+    for (auto it = repository_last_use_.begin(); it != repository_last_use_.end(); ++it) {
+      if (it->second < least_recently_used->second) {
+        least_recently_used = it;
+      }
+    }
+
+    auto model = sessions_.find(least_recently_used->first);
+    default_logger_->info("Unloading model {} version {} to stay under the model repository memory budget",
+                          model->first.first, model->first.second);
+    repository_bytes_ -= model->second->size_in_bytes;
+    // Requests still running the model keep it alive until they complete
+    sessions_.erase(model);
+    repository_last_use_.erase(least_recently_used);
+  }
 }
 
-const Ort::Session& ServerEnvironment::GetSession(const std::string& model_name, const std::string& model_version) const {
-  auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::FindModel(const std::string& model_name, const std::string& model_version) const {
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  auto it = sessions_.find(std::make_pair(model_name, model_version));
   if (it == sessions_.end()) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
 
-  return it->second.session;
+  return it->second;
+}
+
+void ServerEnvironment::SetBatchingOptions(const BatchingOptions& options) {
+  batching_options_ = options;
+}
+
+Batcher* ServerEnvironment::GetBatcher(const std::string& model_name, const std::string& model_version) const {
+  return FindModel(model_name, model_version)->batcher.get();
+}
+
+const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
+  return FindModel(model_name, model_version)->output_names;
+}
+
+OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
+  return severity_;
+}
+
+const Ort::Session& ServerEnvironment::GetSession(const std::string& model_name, const std::string& model_version) const {
+  return FindModel(model_name, model_version)->session;
 }
 
 std::shared_ptr<spdlog::logger> ServerEnvironment::GetLogger(const std::string& request_id) const {
@@ -141,11 +293,17 @@ std::shared_ptr<spdlog::logger> ServerEnvironment::GetAppLogger() const {
 
 void ServerEnvironment::UnloadModel(const std::string& model_name, const std::string& model_version) {
   auto identifier = std::make_pair(model_name, model_version);
+  std::lock_guard<std::mutex> lock(models_mutex_);
   auto it = sessions_.find(identifier);
   if (it == sessions_.end()) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
 
+  auto last_use = repository_last_use_.find(identifier);
+  if (last_use != repository_last_use_.end()) {
+    repository_bytes_ -= it->second->size_in_bytes;
+    repository_last_use_.erase(last_use);
+  }
   sessions_.erase(it);
 }
 
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"
+#include "batcher.h"
 #include <spdlog/spdlog.h>
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
@@ -14,14 +16,50 @@
 namespace onnxruntime {
 namespace server {
 
+// Options of the model repository mode, in which a model is loaded from <path>/<name>/<version>/model.onnx on its
+// first request, and the loaded models are unloaded in least recently used order to stay under the memory budget.
+// The sessions of a repository share the thread pools and the CPU allocator of the environment, and their
+// prepacked weights.
+struct ModelRepositoryOptions {
+  std::string path;
+  // Budget for the models loaded from the repository, measured by the size of their model files. 0 means no limit.
+  size_t memory_budget_bytes = 0;
+};
+
 class ServerEnvironment {
  public:
-  explicit ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink);
-  ~ServerEnvironment() = default;
+  explicit ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink,
+                             const ModelRepositoryOptions& repository_options = {});
+  ~ServerEnvironment();
   ServerEnvironment(const ServerEnvironment&) = delete;
 
+  struct SessionHolder {
+    Ort::Session session;
+    std::vector<std::string> output_names;
+    std::unique_ptr<Batcher> batcher;
+    // Size of the model file, for models loaded from the repository.
+    size_t size_in_bytes = 0;
+    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options,
+                           OrtPrepackedWeightsContainer* prepacked_weights_container) : session(nullptr) {
+      if (prepacked_weights_container != nullptr) {
+        session = Ort::Session(env, path.c_str(), options, prepacked_weights_container);
+      } else {
+        session = Ort::Session(env, path.c_str(), options);
+      }
+    };
+    ~SessionHolder() = default;
+    SessionHolder(const SessionHolder&) = delete;
+    SessionHolder(const SessionHolder&&) = delete;
+    SessionHolder& operator=(const SessionHolder&) = delete;
+  };
+
   OrtLoggingLevel GetLogSeverity() const;
 
+  // Returns the model, loading it from the model repository if it isn't loaded yet.
+  // The model stays usable through the returned pointer even if it is unloaded meanwhile.
+  // Throws Ort::Exception with ORT_NO_MODEL if there is no such model.
+  std::shared_ptr<SessionHolder> AcquireModel(const std::string& model_name, const std::string& model_version);
+
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
   void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
@@ -30,28 +68,38 @@ class ServerEnvironment {
   void UnloadModel(const std::string& model_name, const std::string& model_version);
   void RegisterExecutionProviders();
 
+  // Sets the options for batching the requests of models initialized afterwards.
+  void SetBatchingOptions(const BatchingOptions& options);
+  // Returns the batcher of the model, or nullptr if the requests of the model aren't batched.
+  Batcher* GetBatcher(const std::string& model_name, const std::string& model_version) const;
+
  private:
+  using ModelKey = std::pair<std::string, std::string>;
+
+  std::shared_ptr<SessionHolder> LoadModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
+  std::shared_ptr<SessionHolder> FindModel(const std::string& model_name, const std::string& model_version) const;
+  // Unloads the least recently used models of the repository until the loaded ones fit in the memory budget.
+  // Must be called with models_mutex_ held.
+  void EvictModels();
+
   const OrtLoggingLevel severity_;
   const std::string logger_id_;
   const std::vector<spdlog::sink_ptr> sink_;
   const std::shared_ptr<spdlog::logger> default_logger_;
+  const ModelRepositoryOptions repository_options_;
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  OrtPrepackedWeightsContainer* prepacked_weights_container_ = nullptr;
+  BatchingOptions batching_options_;
+  std::once_flag execution_providers_registered_;
 
-  struct SessionHolder {
-    Ort::Session session;
-    std::vector<std::string> output_names;
-    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
-      session = Ort::Session(env, path.c_str(), options);
-    };
-    ~SessionHolder() = default;
-    SessionHolder(const SessionHolder&) = delete;
-    SessionHolder(const SessionHolder&&) = delete;
-    SessionHolder& operator=(const SessionHolder&) = delete;
-  };
-
-  std::unordered_map<std::pair<std::string, std::string>, ServerEnvironment::SessionHolder, boost::hash<std::pair<std::string, std::string>>> sessions_;
+  mutable std::mutex models_mutex_;
+  std::unordered_map<ModelKey, std::shared_ptr<SessionHolder>, boost::hash<ModelKey>> sessions_;
+  // Last use of each model loaded from the repository, as a value of use_counter_.
+  std::unordered_map<ModelKey, uint64_t, boost::hash<ModelKey>> repository_last_use_;
+  uint64_t use_counter_ = 0;
+  size_t repository_bytes_ = 0;
 };
 
 }  // namespace server
@@ -101,8 +101,6 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
                                        const std::string& model_version,
                                        const onnxruntime::server::PredictRequest& request,
                                        /* out */ onnxruntime::server::PredictResponse& response) {
-  auto logger = env_->GetLogger(request_id_);
-
   // Convert PredictRequest to NameMLValMap
   MemBufferArray buffer_array;
   std::vector<std::string> input_names;
@@ -112,30 +110,59 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
     return conversion_status;
   }
 
-  Ort::RunOptions run_options{};
-  run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
-  run_options.SetRunTag(request_id_.c_str());
-
   // Prepare the output names
   std::vector<std::string> output_names;
-
-  if (!request.output_filter().empty()) {
-    output_names.reserve(request.output_filter_size());
-    for (const auto& name : request.output_filter()) {
-      output_names.push_back(name);
-    }
-  } else {
-    output_names = env_->GetModelOutputNames(model_name, model_version);
+  output_names.reserve(request.output_filter_size());
+  for (const auto& name : request.output_filter()) {
+    output_names.push_back(name);
   }
 
   std::vector<Ort::Value> outputs;
+  auto run_status = RunModel(model_name, model_version, input_names, input_values, output_names, outputs);
+  if (run_status != protobufutil::Status::OK) {
+    return run_status;
+  }
+
+  return BuildResponse(output_names, outputs, response);
+}
+
+protobufutil::Status Executor::RunModel(const std::string& model_name,
+                                        const std::string& model_version,
+                                        const std::vector<std::string>& input_names,
+                                        const std::vector<Ort::Value>& input_values,
+                                        /* in, out */ std::vector<std::string>& output_names,
+                                        /* out */ std::vector<Ort::Value>& outputs) {
+  Ort::RunOptions run_options{};
+  run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
+  run_options.SetRunTag(request_id_.c_str());
+
   try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    // Keeps the model alive for the run even if it gets unloaded from the model repository meanwhile
+    auto model = env_->AcquireModel(model_name, model_version);
+    if (output_names.empty()) {
+      output_names = model->output_names;
+    }
+
+    if (model->batcher != nullptr) {
+      outputs = model->batcher->Run(run_options, input_names, input_values, output_names);
+    } else {
+      outputs = Run(model->session, run_options, input_names, input_values, output_names);
+    }
   } catch (const Ort::Exception& e) {
     return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  } catch (const std::exception& e) {
+    // e.g. std::bad_alloc while batching, passed back from the batcher
+    return GenerateProtobufStatus(ORT_FAIL, e.what());
   }
 
-  // Build the response
+  return protobufutil::Status::OK;
+}
+
+protobufutil::Status Executor::BuildResponse(const std::vector<std::string>& output_names,
+                                             std::vector<Ort::Value>& outputs,
+                                             /* out */ onnxruntime::server::PredictResponse& response) {
+  auto logger = env_->GetLogger(request_id_);
+
   for (size_t i = 0, sz = outputs.size(); i < sz; ++i) {
     onnx::TensorProto output_tensor{};
     try {
@@ -13,6 +13,11 @@
 namespace onnxruntime {
 namespace server {
 
+// Runs the session with the given inputs and returns the requested outputs.
+std::vector<Ort::Value> Run(const Ort::Session& session, const Ort::RunOptions& options,
+                            const std::vector<std::string>& input_names, const std::vector<Ort::Value>& input_values,
+                            const std::vector<std::string>& output_names);
+
 class Executor {
  public:
   Executor(ServerEnvironment* server_env, std::string request_id) : env_(server_env),
@@ -25,6 +30,20 @@ class Executor {
                                          const onnxruntime::server::PredictRequest& request,
                                          /* out */ onnxruntime::server::PredictResponse& response);
 
+  // Runs the model on inputs which are already OrtValues.
+  // All the outputs of the model are returned if output_names is empty.
+  google::protobuf::util::Status RunModel(const std::string& model_name,
+                                          const std::string& model_version,
+                                          const std::vector<std::string>& input_names,
+                                          const std::vector<Ort::Value>& input_values,
+                                          /* in, out */ std::vector<std::string>& output_names,
+                                          /* out */ std::vector<Ort::Value>& outputs);
+
+  // Converts the outputs of RunModel to a PredictResponse.
+  google::protobuf::util::Status BuildResponse(const std::vector<std::string>& output_names,
+                                               std::vector<Ort::Value>& outputs,
+                                               /* out */ onnxruntime::server::PredictResponse& response);
+
  private:
   ServerEnvironment* env_;
   const std::string request_id_;
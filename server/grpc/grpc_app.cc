@@ -9,20 +9,102 @@ namespace onnx_grpc = onnxruntime::server::grpc;
 
 namespace onnxruntime {
 namespace server {
-GRPCApp::GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port) : prediction_service_implementation_(env) {
+
+// A slot for one Predict call at a time on a completion queue. The slot asks for a new call once the previous
+// one is finished, so the number of slots bounds the calls in flight.
+class PredictCall {
+ public:
+  PredictCall(PredictionService::AsyncService* service, ::grpc::ServerCompletionQueue* completion_queue,
+              onnx_grpc::PredictionServiceImpl* implementation, const std::atomic<bool>& shutting_down)
+      : service_(service), completion_queue_(completion_queue), implementation_(implementation), shutting_down_(shutting_down) {}
+
+  void Start() {
+    state_ = State::WaitingForRequest;
+    context_ = std::make_unique<::grpc::ServerContext>();
+    responder_ = std::make_unique<::grpc::ServerAsyncResponseWriter<PredictResponse>>(context_.get());
+    request_.Clear();
+    response_.Clear();
+    service_->RequestPredict(context_.get(), &request_, responder_.get(), completion_queue_, completion_queue_, this);
+  }
+
+  // Advances the call when its pending operation completed. ok is false if the operation didn't happen because the
+  // server is shutting down.
+  void Proceed(bool ok) {
+    if (state_ == State::WaitingForRequest && ok) {
+      auto status = implementation_->Predict(context_.get(), &request_, &response_);
+      state_ = State::Finishing;
+      responder_->Finish(response_, status, this);
+    } else if (!shutting_down_) {
+      Start();
+    }
+  }
+
+ private:
+  enum class State {
+    WaitingForRequest,
+    Finishing
+  };
+
+  PredictionService::AsyncService* service_;
+  ::grpc::ServerCompletionQueue* completion_queue_;
+  onnx_grpc::PredictionServiceImpl* implementation_;
+  const std::atomic<bool>& shutting_down_;
+
+  State state_ = State::WaitingForRequest;
+  std::unique_ptr<::grpc::ServerContext> context_;
+  std::unique_ptr<::grpc::ServerAsyncResponseWriter<PredictResponse>> responder_;
+  PredictRequest request_;
+  PredictResponse response_;
+};
+
+GRPCApp::GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port,
+                 int num_threads, int max_calls_per_thread) : prediction_service_implementation_(env) {
   ::grpc::EnableDefaultHealthCheckService(true);
   ::grpc::channelz::experimental::InitChannelzService();
   ::grpc::reflection::InitProtoReflectionServerBuilderPlugin();
   ::grpc::ServerBuilder builder;
-  builder.RegisterService(&prediction_service_implementation_);
+  builder.RegisterService(&async_service_);
   builder.AddListeningPort(host + ":" + std::to_string(port), ::grpc::InsecureServerCredentials());
+  for (int i = 0; i < num_threads; ++i) {
+    completion_queues_.push_back(builder.AddCompletionQueue());
+  }
 
   server_ = builder.BuildAndStart();
   server_->GetHealthCheckService()->SetServingStatus(PredictionService::service_full_name(), true);
+
+  for (auto& completion_queue : completion_queues_) {
+    for (int i = 0; i < max_calls_per_thread; ++i) {
+      calls_.push_back(std::make_unique<PredictCall>(&async_service_, completion_queue.get(),
+                                                     &prediction_service_implementation_, shutting_down_));
+      calls_.back()->Start();
+    }
+  }
+  for (auto& completion_queue : completion_queues_) {
+    threads_.emplace_back(&GRPCApp::HandleCalls, this, completion_queue.get());
+  }
+}
+
+GRPCApp::~GRPCApp() {
+  shutting_down_ = true;
+  server_->Shutdown();
+  for (auto& completion_queue : completion_queues_) {
+    completion_queue->Shutdown();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void GRPCApp::HandleCalls(::grpc::ServerCompletionQueue* completion_queue) {
+  void* tag = nullptr;
+  bool ok = false;
+  while (completion_queue->Next(&tag, &ok)) {
+    static_cast<PredictCall*>(tag)->Proceed(ok);
+  }
 }
 
 void GRPCApp::Run() {
   server_->Wait();
 }
 }  // namespace server
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
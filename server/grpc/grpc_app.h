@@ -2,16 +2,29 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include <grpcpp/grpcpp.h>
 #include "prediction_service_impl.h"
 #include "environment.h"
 
 namespace onnxruntime {
 namespace server {
+class PredictCall;
+
+// Serves the PredictionService with the asynchronous GRPC API.
+// Each thread polls its own completion queue and runs the calls it accepts, so a call never moves between threads
+// and the model runs on the thread which received the call, using the thread pools of the session for its ops.
+// A completion queue accepts at most max_calls_per_thread calls at once; further calls wait in the GRPC transport,
+// whose flow control pushes back on the clients instead of spawning more threads.
 class GRPCApp {
  public:
-  GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port);
-  ~GRPCApp() = default;
+  GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port,
+          int num_threads, int max_calls_per_thread);
+  ~GRPCApp();
   GRPCApp(const GRPCApp& other) = delete;
   GRPCApp(GRPCApp&& other) = delete;
 
@@ -21,8 +34,15 @@ class GRPCApp {
   void Run();
 
  private:
+  void HandleCalls(::grpc::ServerCompletionQueue* completion_queue);
+
   grpc::PredictionServiceImpl prediction_service_implementation_;
+  PredictionService::AsyncService async_service_;
   std::unique_ptr<::grpc::Server> server_;
+  std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> completion_queues_;
+  std::vector<std::unique_ptr<PredictCall>> calls_;
+  std::vector<std::thread> threads_;
+  std::atomic<bool> shutting_down_{false};
 };
 }  // namespace server
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -10,7 +10,8 @@
 namespace onnxruntime {
 namespace server {
 namespace grpc {
-class PredictionServiceImpl final : public onnxruntime::server::PredictionService::Service {
+// Serves the Predict calls accepted by the asynchronous PredictionService of GRPCApp.
+class PredictionServiceImpl final {
  public:
   PredictionServiceImpl(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env);
   ::grpc::Status Predict(::grpc::ServerContext* context, const ::onnxruntime::server::PredictRequest* request, ::onnxruntime::server::PredictResponse* response);
@@ -0,0 +1,208 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+
+#include <google/protobuf/stubs/status.h>
+
+#include "onnxruntime_cxx_api.h"
+
+#include "binary_tensors.h"
+#include "../util.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace protobufutil = google::protobuf::util;
+
+static const char kMagic[4] = {'O', 'R', 'T', 'T'};
+static const size_t kDataAlignment = 8;
+
+static size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+static size_t AlignOffset(size_t offset) {
+  return (offset + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+}
+
+// Reads sequential fields of a payload, failing instead of reading past its end.
+class PayloadReader {
+ public:
+  explicit PayloadReader(std::string& payload) : payload_(payload) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    if (payload_.size() - offset_ < sizeof(T)) {
+      return false;
+    }
+    memcpy(&value, payload_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool Read(size_t length, /* out */ char*& data) {
+    if (payload_.size() - offset_ < length) {
+      return false;
+    }
+    data = &payload_[offset_];
+    offset_ += length;
+    return true;
+  }
+
+  bool Align() {
+    size_t aligned = AlignOffset(offset_);
+    if (aligned > payload_.size()) {
+      return false;
+    }
+    offset_ = aligned;
+    return true;
+  }
+
+ private:
+  std::string& payload_;
+  size_t offset_ = 0;
+};
+
+static protobufutil::Status InvalidPayload(const std::string& message) {
+  return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "Invalid binary tensors payload: " + message);
+}
+
+protobufutil::Status ParseBinaryTensors(std::string& payload, const OrtMemoryInfo* memory_info,
+                                        MemBufferArray& buffers,
+                                        std::vector<std::string>& names,
+                                        std::vector<Ort::Value>& values) {
+  PayloadReader reader(payload);
+
+  char* magic = nullptr;
+  uint32_t tensor_count = 0;
+  if (!reader.Read(sizeof(kMagic), magic) || memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.Read(tensor_count)) {
+    return InvalidPayload("missing header");
+  }
+
+  names.reserve(tensor_count);
+  values.reserve(tensor_count);
+  for (uint32_t i = 0; i < tensor_count; ++i) {
+    uint32_t name_length = 0;
+    char* name = nullptr;
+    int32_t element_type = 0;
+    uint32_t rank = 0;
+    if (!reader.Read(name_length) || !reader.Read(name_length, name) ||
+        !reader.Read(element_type) || !reader.Read(rank)) {
+      return InvalidPayload("truncated tensor header");
+    }
+
+    std::vector<int64_t> shape(rank);
+    size_t element_count = 1;
+    for (auto& dim : shape) {
+      if (!reader.Read(dim)) {
+        return InvalidPayload("truncated tensor shape");
+      }
+      if (dim < 0) {
+        return InvalidPayload("negative dim");
+      }
+      element_count *= static_cast<size_t>(dim);
+    }
+
+    auto type = static_cast<ONNXTensorElementDataType>(element_type);
+    size_t element_size = GetElementSize(type);
+    if (element_size == 0) {
+      return InvalidPayload("unsupported element type " + std::to_string(element_type));
+    }
+
+    uint64_t data_length = 0;
+    char* data = nullptr;
+    if (!reader.Read(data_length) || !reader.Align() || !reader.Read(static_cast<size_t>(data_length), data)) {
+      return InvalidPayload("truncated tensor data");
+    }
+    if (data_length != element_count * element_size) {
+      return InvalidPayload("data length of tensor " + std::string(name, name_length) + " doesn't match its shape");
+    }
+
+    // The payload is only 8-byte aligned relative to its start, so copy the data if the buffer itself isn't aligned.
+    void* tensor_data = data;
+    if (reinterpret_cast<uintptr_t>(data) % element_size != 0) {
+      tensor_data = buffers.AllocNewBuffer(static_cast<size_t>(data_length));
+      memcpy(tensor_data, data, static_cast<size_t>(data_length));
+    }
+
+    try {
+      values.push_back(Ort::Value::CreateTensor(memory_info, tensor_data, static_cast<size_t>(data_length),
+                                                shape.data(), shape.size(), type));
+    } catch (const Ort::Exception& e) {
+      return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+    }
+    names.emplace_back(name, name_length);
+  }
+
+  return protobufutil::Status::OK;
+}
+
+template <typename T>
+static void Append(std::string& payload, const T& value) {
+  payload.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+protobufutil::Status WriteBinaryTensors(const std::vector<std::string>& names,
+                                        std::vector<Ort::Value>& values,
+                                        std::string& payload) {
+  payload.clear();
+  payload.append(kMagic, sizeof(kMagic));
+  Append(payload, static_cast<uint32_t>(values.size()));
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    auto& value = values[i];
+    if (!value.IsTensor()) {
+      return protobufutil::Status(protobufutil::error::Code::UNIMPLEMENTED, "Don't support Non-Tensor values");
+    }
+    auto info = value.GetTensorTypeAndShapeInfo();
+    auto type = info.GetElementType();
+    size_t element_size = GetElementSize(type);
+    if (element_size == 0) {
+      return protobufutil::Status(protobufutil::error::Code::UNIMPLEMENTED,
+                                  "Output " + names[i] + " has an element type not supported by binary tensors");
+    }
+    auto shape = info.GetShape();
+    uint64_t data_length = info.GetElementCount() * element_size;
+
+    Append(payload, static_cast<uint32_t>(names[i].size()));
+    payload.append(names[i]);
+    Append(payload, static_cast<int32_t>(type));
+    Append(payload, static_cast<uint32_t>(shape.size()));
+    for (auto dim : shape) {
+      Append(payload, dim);
+    }
+    Append(payload, data_length);
+    payload.resize(AlignOffset(payload.size()), '\0');
+    payload.append(value.GetTensorMutableData<char>(), static_cast<size_t>(data_length));
+  }
+
+  return protobufutil::Status::OK;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
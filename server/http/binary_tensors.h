@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <google/protobuf/stubs/status.h>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+class MemBufferArray;
+
+// Content type of the binary tensor wire format.
+//
+// The payload is a list of tensors, all integers being little-endian:
+//   char[4] magic "ORTT", uint32 tensor count, then for each tensor:
+//   uint32 name length, name bytes, int32 element type (ONNXTensorElementDataType, same values as
+//   TensorProto.DataType), uint32 rank, int64 dims[rank], uint64 data length, zero padding up to the next
+//   multiple of 8 bytes from the start of the payload, and the raw tensor data.
+// String tensors are not supported.
+constexpr const char* kBinaryTensorsContentType = "application/vnd.onnxruntime.tensors";
+
+// Wraps the tensors of a binary payload as OrtValues without copying their data, so the payload must outlive
+// the values. A tensor whose data is not aligned to its element size is copied into a buffer of buffers instead.
+google::protobuf::util::Status ParseBinaryTensors(std::string& payload, const OrtMemoryInfo* memory_info,
+                                                  MemBufferArray& buffers,
+                                                  /* out */ std::vector<std::string>& names,
+                                                  /* out */ std::vector<Ort::Value>& values);
+
+// Serializes the tensors into a binary payload.
+google::protobuf::util::Status WriteBinaryTensors(const std::vector<std::string>& names,
+                                                  std::vector<Ort::Value>& values,
+                                                  /* out */ std::string& payload);
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include "environment.h"
 #include "http_server.h"
 #include "json_handling.h"
+#include "binary_tensors.h"
 #include "executor.h"
 #include "util.h"
 
@@ -53,29 +54,66 @@ void Predict(const std::string& name,
     GenerateErrorResponse(logger, http::status::bad_request, "Unknown 'Accept' header field in the request", context);
   }
 
-  // Deserialize the payload
-  auto body = context.request.body();
-  PredictRequest predict_request{};
-  http::status error_code;
-  std::string error_message;
-  bool parse_succeeded = ParseRequestPayload(context, request_type, predict_request, error_code, error_message);
-  if (!parse_succeeded) {
-    GenerateErrorResponse(logger, error_code, error_message, context);
-    return;
-  }
-
-  // Run Prediction
   Executor executor(env.get(), context.request_id);
   PredictResponse predict_response{};
-  auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
-  if (!status.ok()) {
-    GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
-    return;
+  std::string response_body{};
+  protobufutil::Status status;
+
+  if (request_type == SupportedContentType::BinaryTensors) {
+    // The tensors of a binary request are run in place, without going through a PredictRequest
+    MemBufferArray buffers;
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::vector<std::string> input_names;
+    std::vector<Ort::Value> input_values;
+    status = ParseBinaryTensors(context.request.body(), memory_info, buffers, input_names, input_values);
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode(status), status.error_message(), context);
+      return;
+    }
+
+    std::vector<std::string> output_names;
+    std::vector<Ort::Value> outputs;
+    status = executor.RunModel(effective_name, effective_version, input_names, input_values, output_names, outputs);
+    if (status.ok()) {
+      if (response_type == SupportedContentType::BinaryTensors) {
+        status = WriteBinaryTensors(output_names, outputs, response_body);
+      } else {
+        status = executor.BuildResponse(output_names, outputs, predict_response);
+      }
+    }
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode(status), status.error_message(), context);
+      return;
+    }
+  } else {
+    if (response_type == SupportedContentType::BinaryTensors) {
+      GenerateErrorResponse(logger, http::status::bad_request,
+                            std::string("'Accept: ") + kBinaryTensorsContentType + "' requires a request of the same content type", context);
+      return;
+    }
+
+    // Deserialize the payload
+    PredictRequest predict_request{};
+    http::status error_code;
+    std::string error_message;
+    bool parse_succeeded = ParseRequestPayload(context, request_type, predict_request, error_code, error_message);
+    if (!parse_succeeded) {
+      GenerateErrorResponse(logger, error_code, error_message, context);
+      return;
+    }
+
+    // Run Prediction
+    status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
+      return;
+    }
   }
 
   // Serialize to proper output format
-  std::string response_body{};
-  if (response_type == SupportedContentType::Json) {
+  if (response_type == SupportedContentType::BinaryTensors) {
+    context.response.set(http::field::content_type, kBinaryTensorsContentType);
+  } else if (response_type == SupportedContentType::Json) {
     status = GenerateResponseInJson(predict_response, response_body);
     if (!status.ok()) {
       GenerateErrorResponse(logger, http::status::internal_server_error, status.error_message(), context);
@@ -96,12 +134,12 @@ void Predict(const std::string& name,
   if (!context.client_request_id.empty()) {
     context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
   }
-  context.response.body() = response_body;
+  context.response.body() = std::move(response_body);
   context.response.result(http::status::ok);
 };
 
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   protobufutil::Status status;
   switch (request_type) {
     case SupportedContentType::Json: {
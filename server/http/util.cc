@@ -8,6 +8,7 @@
 
 #include "context.h"
 #include "util.h"
+#include "binary_tensors.h"
 
 namespace protobufutil = google::protobuf::util;
 namespace onnxruntime {
@@ -58,6 +59,8 @@ SupportedContentType GetRequestContentType(const HttpContext& context) {
   if (context.request.find("Content-Type") != context.request.end()) {
     if (context.request["Content-Type"] == "application/json") {
       return SupportedContentType::Json;
+    } else if (context.request["Content-Type"] == kBinaryTensorsContentType) {
+      return SupportedContentType::BinaryTensors;
     } else if (protobuf_mime_types.find(context.request["Content-Type"].to_string()) != protobuf_mime_types.end()) {
       return SupportedContentType::PbByteArray;
     }
@@ -70,6 +73,8 @@ SupportedContentType GetResponseContentType(const HttpContext& context) {
   if (context.request.find("Accept") != context.request.end()) {
     if (context.request["Accept"] == "application/json") {
       return SupportedContentType::Json;
+    } else if (context.request["Accept"] == kBinaryTensorsContentType) {
+      return SupportedContentType::BinaryTensors;
     } else if (context.request["Accept"] == "*/*" || protobuf_mime_types.find(context.request["Accept"].to_string()) != protobuf_mime_types.end()) {
       return SupportedContentType::PbByteArray;
     }
@@ -58,25 +58,40 @@ int main(int argc, char* argv[]) {
     exit(EXIT_FAILURE);
   }
 
-  const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()});
+  server::ModelRepositoryOptions repository_options{};
+  repository_options.path = config.model_repository;
+  repository_options.memory_budget_bytes = static_cast<size_t>(config.model_repository_memory_mb) * 1024 * 1024;
+
+  const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()}, repository_options);
   auto logger = env->GetAppLogger();
-  logger->info("Model path: {}, ", config.model_path);
-  logger->info("Model name: {}", config.model_name);
-  logger->info("Model version: {}", config.model_version);
-
-  try {
-    env->InitializeModel(config.model_path, config.model_name, config.model_version);
-    logger->debug("Initialize Model Successfully!");
-  } catch (const Ort::Exception& ex) {
-    logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
-    exit(EXIT_FAILURE);
+  if (!config.model_repository.empty()) {
+    logger->info("Model repository: {}", config.model_repository);
+  }
+
+  server::BatchingOptions batching_options{};
+  batching_options.max_batch_size = static_cast<size_t>(config.max_batch_size);
+  batching_options.max_queue_delay = std::chrono::microseconds(config.max_queue_delay_us);
+  batching_options.max_concurrent_batches = static_cast<size_t>(config.max_concurrent_batches);
+  env->SetBatchingOptions(batching_options);
+
+  if (!config.model_path.empty()) {
+    logger->info("Model path: {}, ", config.model_path);
+    logger->info("Model name: {}", config.model_name);
+    logger->info("Model version: {}", config.model_version);
+    try {
+      env->InitializeModel(config.model_path, config.model_name, config.model_version);
+      logger->debug("Initialize Model Successfully!");
+    } catch (const Ort::Exception& ex) {
+      logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
+      exit(EXIT_FAILURE);
+    }
   }
 
   //Setup GRPC Server
   auto const grpc_address = config.address;
   auto const grpc_port = config.grpc_port;
 
-  server::GRPCApp grpc_app{env, grpc_address, grpc_port};
+  server::GRPCApp grpc_app{env, grpc_address, grpc_port, config.num_grpc_threads, config.max_grpc_calls_per_thread};
 
   logger->info("GRPC Listening at: {}:{}", grpc_address, grpc_port);
 
@@ -39,24 +39,38 @@ class ServerConfiguration {
  public:
   const std::string full_desc = "ONNX Server: host an ONNX model with ONNX Runtime";
   std::string model_path;
+  std::string model_repository;
+  int model_repository_memory_mb = 0;
   std::string model_name = "default";
   std::string model_version = "1";
   std::string address = "0.0.0.0";
   unsigned short http_port = 8001;
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
+  int num_grpc_threads = std::thread::hardware_concurrency();
+  int max_grpc_calls_per_thread = 16;
+  int max_batch_size = 1;
+  int max_queue_delay_us = 1000;
+  int max_concurrent_batches = 4;
   OrtLoggingLevel logging_level{};
 
   ServerConfiguration() {
     desc.add_options()("help,h", "Shows a help message and exits");
     desc.add_options()("log_level", po::value(&log_level_str)->default_value(log_level_str), "Logging level. Allowed options (case sensitive): verbose, info, warning, error, fatal");
-    desc.add_options()("model_path", po::value(&model_path)->required(), "Path to ONNX model");
+    desc.add_options()("model_path", po::value(&model_path), "Path to ONNX model");
+    desc.add_options()("model_repository", po::value(&model_repository), "Directory of models loaded on their first request, from <model_repository>/<model_name>/<model_version>/model.onnx");
+    desc.add_options()("model_repository_memory_mb", po::value(&model_repository_memory_mb)->default_value(model_repository_memory_mb), "Size of the model files loaded from the model repository above which the least recently used models are unloaded. 0 means no limit");
     desc.add_options()("model_name", po::value(&model_name)->default_value(model_name), "ONNX model name");
     desc.add_options()("model_version", po::value(&model_version)->default_value(model_version), "ONNX model version");
     desc.add_options()("address", po::value(&address)->default_value(address), "The base HTTP address");
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("num_grpc_threads", po::value(&num_grpc_threads)->default_value(num_grpc_threads), "Number of GRPC threads, each polling its own completion queue");
+    desc.add_options()("max_grpc_calls_per_thread", po::value(&max_grpc_calls_per_thread)->default_value(max_grpc_calls_per_thread), "Maximum number of GRPC calls accepted at once by a GRPC thread. Further calls wait in the GRPC transport");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Maximum batch size of requests batched into one run. 1 disables batching");
+    desc.add_options()("max_queue_delay_us", po::value(&max_queue_delay_us)->default_value(max_queue_delay_us), "Maximum time in microseconds a request waits for other requests to batch with");
+    desc.add_options()("max_concurrent_batches", po::value(&max_concurrent_batches)->default_value(max_concurrent_batches), "Maximum number of batches of a model run at the same time");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,9 +117,30 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
-    } else if (!file_exists(model_path)) {
+    } else if (num_grpc_threads <= 0) {
+      PrintHelp(std::cerr, "num_grpc_threads must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_grpc_calls_per_thread <= 0) {
+      PrintHelp(std::cerr, "max_grpc_calls_per_thread must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_batch_size <= 0) {
+      PrintHelp(std::cerr, "max_batch_size must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_queue_delay_us < 0) {
+      PrintHelp(std::cerr, "max_queue_delay_us must not be negative");
+      return Result::ExitFailure;
+    } else if (max_concurrent_batches <= 0) {
+      PrintHelp(std::cerr, "max_concurrent_batches must be greater than 0");
+      return Result::ExitFailure;
+    } else if (model_path.empty() && model_repository.empty()) {
+      PrintHelp(std::cerr, "one of model_path or model_repository is required");
+      return Result::ExitFailure;
+    } else if (!model_path.empty() && !file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
+    } else if (model_repository_memory_mb < 0) {
+      PrintHelp(std::cerr, "model_repository_memory_mb must not be negative");
+      return Result::ExitFailure;
     } else {
       return Result::ContinueSuccess;
     }
@@ -0,0 +1,330 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+static Ort::Value CreateFloatTensor(const std::vector<int64_t>& shape, const std::vector<float>& data) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto value = Ort::Value::CreateTensor<float>(allocator, shape.data(), shape.size());
+  std::copy(data.begin(), data.end(), value.GetTensorMutableData<float>());
+  return value;
+}
+
+static std::vector<float> GetFloatData(const Ort::Value& value) {
+  const float* data = value.GetTensorData<float>();
+  return std::vector<float>(data, data + value.GetTensorTypeAndShapeInfo().GetElementCount());
+}
+
+TEST(BatcherTests, ConcatenateAndSplit) {
+  auto a = CreateFloatTensor({1, 2}, {1, 2});
+  auto b = CreateFloatTensor({2, 2}, {3, 4, 5, 6});
+
+  auto batched = ConcatenateAlongBatchDimension({&a, &b});
+  EXPECT_EQ(batched.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{3, 2}));
+  EXPECT_EQ(GetFloatData(batched), (std::vector<float>{1, 2, 3, 4, 5, 6}));
+
+  auto split = SplitAlongBatchDimension(batched, {1, 2});
+  ASSERT_EQ(split.size(), 2u);
+  EXPECT_EQ(split[0].GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{1, 2}));
+  EXPECT_EQ(GetFloatData(split[0]), (std::vector<float>{1, 2}));
+  EXPECT_EQ(split[1].GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{2, 2}));
+  EXPECT_EQ(GetFloatData(split[1]), (std::vector<float>{3, 4, 5, 6}));
+
+  EXPECT_THROW(SplitAlongBatchDimension(batched, {1, 1}), Ort::Exception);
+}
+
+// Doubles the input and records the batch size of each run.
+class DoublingRunner {
+ public:
+  Batcher::RunFunction GetRunFunction() {
+    return [this](const Ort::RunOptions&, const std::vector<std::string>&,
+                  const std::vector<Ort::Value>& input_values, const std::vector<std::string>&) {
+      auto shape = input_values[0].GetTensorTypeAndShapeInfo().GetShape();
+      auto data = GetFloatData(input_values[0]);
+      for (auto& x : data) {
+        x *= 2;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch_sizes_.push_back(shape[0]);
+      }
+
+      std::vector<Ort::Value> outputs;
+      outputs.push_back(CreateFloatTensor(shape, data));
+      return outputs;
+    };
+  }
+
+  std::vector<int64_t> GetBatchSizes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batch_sizes_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<int64_t> batch_sizes_;
+};
+
+TEST(BatcherTests, BatchesConcurrentRequests) {
+  DoublingRunner runner;
+  BatchingOptions options{};
+  options.max_batch_size = 4;
+  // long enough that the batch is always full before it runs
+  options.max_queue_delay = std::chrono::seconds(10);
+  Batcher batcher(runner.GetRunFunction(), options);
+
+  Ort::RunOptions run_options;
+  const std::vector<std::string> input_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<std::thread> threads;
+  std::atomic<int> num_correct{0};
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&, i]() {
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(CreateFloatTensor({1, 2}, {static_cast<float>(i), static_cast<float>(i + 1)}));
+      auto outputs = batcher.Run(run_options, input_names, inputs, output_names);
+      if (outputs.size() == 1 &&
+          outputs[0].GetTensorTypeAndShapeInfo().GetShape() == std::vector<int64_t>{1, 2} &&
+          GetFloatData(outputs[0]) == std::vector<float>{2.f * i, 2.f * (i + 1)}) {
+        ++num_correct;
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_correct, 4);
+  EXPECT_EQ(runner.GetBatchSizes(), (std::vector<int64_t>{4}));
+}
+
+TEST(BatcherTests, RunsRequestAloneAfterDelay) {
+  DoublingRunner runner;
+  BatchingOptions options{};
+  options.max_batch_size = 4;
+  options.max_queue_delay = std::chrono::microseconds(100);
+  Batcher batcher(runner.GetRunFunction(), options);
+
+  Ort::RunOptions run_options;
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateFloatTensor({2, 1}, {1, 2}));
+  auto outputs = batcher.Run(run_options, {"X"}, inputs, {"Y"});
+  ASSERT_EQ(outputs.size(), 1u);
+  EXPECT_EQ(GetFloatData(outputs[0]), (std::vector<float>{2, 4}));
+
+  // a request at the maximum batch size doesn't wait for others
+  inputs.clear();
+  inputs.push_back(CreateFloatTensor({4, 1}, {1, 2, 3, 4}));
+  outputs = batcher.Run(run_options, {"X"}, inputs, {"Y"});
+  ASSERT_EQ(outputs.size(), 1u);
+  EXPECT_EQ(GetFloatData(outputs[0]), (std::vector<float>{2, 4, 6, 8}));
+
+  EXPECT_EQ(runner.GetBatchSizes(), (std::vector<int64_t>{2, 4}));
+}
+
+TEST(BatcherTests, FallsBackToSingleRunsForUnbatchableOutputs) {
+  std::atomic<int> num_runs{0};
+  // returns an output without the batch dimension
+  auto run = [&num_runs](const Ort::RunOptions&, const std::vector<std::string>&, const std::vector<Ort::Value>&,
+                         const std::vector<std::string>&) {
+    ++num_runs;
+    std::vector<Ort::Value> outputs;
+    outputs.push_back(CreateFloatTensor({1}, {42}));
+    return outputs;
+  };
+
+  BatchingOptions options{};
+  options.max_batch_size = 2;
+  options.max_queue_delay = std::chrono::seconds(10);
+  Batcher batcher(run, options);
+
+  Ort::RunOptions run_options;
+  const std::vector<std::string> input_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<std::thread> threads;
+  std::atomic<int> num_correct{0};
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&]() {
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(CreateFloatTensor({1, 1}, {1}));
+      auto outputs = batcher.Run(run_options, input_names, inputs, output_names);
+      if (outputs.size() == 1 && GetFloatData(outputs[0]) == std::vector<float>{42}) {
+        ++num_correct;
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_correct, 2);
+  // one batched run that couldn't be split, then one run per request
+  EXPECT_EQ(num_runs, 3);
+}
+
+TEST(BatcherTests, FallsBackToSingleRunsForAnyBatchedRunError) {
+  std::atomic<int> num_runs{0};
+  // fails for a batch with something else than an Ort::Exception, and doubles the input of a single request
+  auto run = [&num_runs](const Ort::RunOptions&, const std::vector<std::string>&,
+                         const std::vector<Ort::Value>& input_values, const std::vector<std::string>&) {
+    ++num_runs;
+    auto shape = input_values[0].GetTensorTypeAndShapeInfo().GetShape();
+    if (shape[0] > 1) {
+      throw std::bad_alloc();
+    }
+
+    auto data = GetFloatData(input_values[0]);
+    if (data[0] < 0) {
+      throw std::runtime_error("negative input");
+    }
+
+    std::vector<Ort::Value> outputs;
+    outputs.push_back(CreateFloatTensor(shape, {2 * data[0]}));
+    return outputs;
+  };
+
+  BatchingOptions options{};
+  options.max_batch_size = 2;
+  options.max_queue_delay = std::chrono::seconds(10);
+  Batcher batcher(run, options);
+
+  Ort::RunOptions run_options;
+  const std::vector<std::string> input_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::atomic<int> num_correct{0};
+  std::atomic<int> num_failed{0};
+  std::vector<std::thread> threads;
+  for (float x : {3.f, -1.f}) {
+    threads.emplace_back([&, x]() {
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(CreateFloatTensor({1, 1}, {x}));
+      try {
+        auto outputs = batcher.Run(run_options, input_names, inputs, output_names);
+        if (outputs.size() == 1 && GetFloatData(outputs[0]) == std::vector<float>{2 * x}) {
+          ++num_correct;
+        }
+      } catch (const std::runtime_error&) {
+        ++num_failed;
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // the batched run failed, then each request got its own result or error
+  EXPECT_EQ(num_correct, 1);
+  EXPECT_EQ(num_failed, 1);
+  EXPECT_EQ(num_runs, 3);
+}
+
+TEST(BatcherTests, PassesRunOptions) {
+  std::mutex mutex;
+  std::vector<std::string> run_tags;
+  auto run = [&](const Ort::RunOptions& run_options, const std::vector<std::string>&,
+                 const std::vector<Ort::Value>& input_values, const std::vector<std::string>&) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      run_tags.push_back(run_options.GetRunTag());
+    }
+    auto shape = input_values[0].GetTensorTypeAndShapeInfo().GetShape();
+    std::vector<Ort::Value> outputs;
+    outputs.push_back(CreateFloatTensor(shape, GetFloatData(input_values[0])));
+    return outputs;
+  };
+
+  BatchingOptions options{};
+  options.max_batch_size = 2;
+  options.max_queue_delay = std::chrono::seconds(10);
+  Batcher batcher(run, options);
+
+  const std::vector<std::string> input_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+
+  // a request that can't be batched runs with its own run options
+  Ort::RunOptions single_run_options;
+  single_run_options.SetRunTag("single");
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateFloatTensor({2, 1}, {1, 2}));
+  batcher.Run(single_run_options, input_names, inputs, output_names);
+
+  // a batched run is tagged with the tags of its requests
+  std::vector<std::thread> threads;
+  for (const char* tag : {"a", "b"}) {
+    threads.emplace_back([&, tag]() {
+      Ort::RunOptions run_options;
+      run_options.SetRunTag(tag);
+      std::vector<Ort::Value> request_inputs;
+      request_inputs.push_back(CreateFloatTensor({1, 1}, {1}));
+      batcher.Run(run_options, input_names, request_inputs, output_names);
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(run_tags.size(), 2u);
+  EXPECT_EQ(run_tags[0], "single");
+  EXPECT_TRUE(run_tags[1] == "a,b" || run_tags[1] == "b,a") << run_tags[1];
+}
+
+TEST(BatcherTests, RunsBatchesConcurrently) {
+  // each run waits until another run has started, which only happens if two batches run at the same time
+  std::mutex mutex;
+  std::condition_variable cv;
+  int num_started = 0;
+  auto run = [&](const Ort::RunOptions&, const std::vector<std::string>&,
+                 const std::vector<Ort::Value>& input_values, const std::vector<std::string>&) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++num_started;
+    cv.notify_all();
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(10), [&]() { return num_started >= 2; }));
+    std::vector<Ort::Value> outputs;
+    outputs.push_back(CreateFloatTensor(input_values[0].GetTensorTypeAndShapeInfo().GetShape(),
+                                        GetFloatData(input_values[0])));
+    return outputs;
+  };
+
+  BatchingOptions options{};
+  options.max_batch_size = 4;
+  options.max_queue_delay = std::chrono::microseconds(100);
+  options.max_concurrent_batches = 2;
+  Batcher batcher(run, options);
+
+  Ort::RunOptions run_options;
+  std::vector<std::thread> threads;
+  // the requests have different inner dimensions, so they can't be batched together
+  for (int64_t inner_dim : {1, 2}) {
+    threads.emplace_back([&, inner_dim]() {
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(CreateFloatTensor({1, inner_dim}, std::vector<float>(static_cast<size_t>(inner_dim), 1.f)));
+      batcher.Run(run_options, {"X"}, inputs, {"Y"});
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_started, 2);
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <google/protobuf/stubs/status.h>
+
+#include "gtest/gtest.h"
+
+#include "onnxruntime_cxx_api.h"
+#include "executor.h"
+#include "http/binary_tensors.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+namespace protobufutil = google::protobuf::util;
+
+TEST(BinaryTensorsTests, RoundTrip) {
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<float> x_data{1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+  std::vector<int64_t> x_shape{2, 3};
+  std::vector<int64_t> y_data{42};
+  std::vector<int64_t> y_shape{};
+
+  std::vector<std::string> names{"X", "index"};
+  std::vector<Ort::Value> values;
+  values.push_back(Ort::Value::CreateTensor<float>(memory_info, x_data.data(), x_data.size(), x_shape.data(), x_shape.size()));
+  values.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, y_data.data(), y_data.size(), y_shape.data(), y_shape.size()));
+
+  std::string payload;
+  auto status = WriteBinaryTensors(names, values, payload);
+  ASSERT_EQ(protobufutil::error::OK, status.error_code()) << status.error_message();
+
+  MemBufferArray buffers;
+  std::vector<std::string> parsed_names;
+  std::vector<Ort::Value> parsed_values;
+  status = ParseBinaryTensors(payload, memory_info, buffers, parsed_names, parsed_values);
+  ASSERT_EQ(protobufutil::error::OK, status.error_code()) << status.error_message();
+
+  ASSERT_EQ(names, parsed_names);
+  ASSERT_EQ(2u, parsed_values.size());
+
+  auto x_info = parsed_values[0].GetTensorTypeAndShapeInfo();
+  EXPECT_EQ(ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, x_info.GetElementType());
+  EXPECT_EQ(x_shape, x_info.GetShape());
+  const float* x = parsed_values[0].GetTensorMutableData<float>();
+  EXPECT_EQ(x_data, std::vector<float>(x, x + x_data.size()));
+
+  auto y_info = parsed_values[1].GetTensorTypeAndShapeInfo();
+  EXPECT_EQ(ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, y_info.GetElementType());
+  EXPECT_EQ(0u, y_info.GetShape().size());
+  EXPECT_EQ(42, *parsed_values[1].GetTensorMutableData<int64_t>());
+}
+
+TEST(BinaryTensorsTests, TruncatedPayload) {
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<float> x_data{1.f, 2.f, 3.f};
+  std::vector<int64_t> x_shape{3};
+  std::vector<std::string> names{"X"};
+  std::vector<Ort::Value> values;
+  values.push_back(Ort::Value::CreateTensor<float>(memory_info, x_data.data(), x_data.size(), x_shape.data(), x_shape.size()));
+
+  std::string payload;
+  ASSERT_EQ(protobufutil::error::OK, WriteBinaryTensors(names, values, payload).error_code());
+  payload.resize(payload.size() - 1);
+
+  MemBufferArray buffers;
+  std::vector<std::string> parsed_names;
+  std::vector<Ort::Value> parsed_values;
+  auto status = ParseBinaryTensors(payload, memory_info, buffers, parsed_names, parsed_values);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+  EXPECT_EQ("Invalid binary tensors payload: truncated tensor data", status.error_message());
+}
+
+TEST(BinaryTensorsTests, InvalidHeader) {
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::string payload = "{\"inputs\":{}}";
+
+  MemBufferArray buffers;
+  std::vector<std::string> names;
+  std::vector<Ort::Value> values;
+  auto status = ParseBinaryTensors(payload, memory_info, buffers, names, values);
+  EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, status.error_code());
+  EXPECT_EQ("Invalid binary tensors payload: missing header", status.error_message());
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -71,6 +71,20 @@ TEST(ConfigParsingTests, NoModelArg) {
   EXPECT_EQ(res, Result::ExitFailure);
 }
 
+TEST(ConfigParsingTests, ModelRepositoryArgs) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_repository"), const_cast<char*>("testdata"),
+      const_cast<char*>("--model_repository_memory_mb"), const_cast<char*>("512")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(5, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.model_path, "");
+  EXPECT_EQ(config.model_repository, "testdata");
+  EXPECT_EQ(config.model_repository_memory_mb, 512);
+}
+
 TEST(ConfigParsingTests, ModelNotFound) {
   char* test_argv[] = {
       const_cast<char*>("/path/to/binary"),
@@ -84,6 +98,44 @@ TEST(ConfigParsingTests, ModelNotFound) {
   EXPECT_EQ(res, Result::ExitFailure);
 }
 
+TEST(ConfigParsingTests, BatchingArgs) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("8"),
+      const_cast<char*>("--max_queue_delay_us"), const_cast<char*>("500"),
+      const_cast<char*>("--max_concurrent_batches"), const_cast<char*>("2")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(9, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.max_batch_size, 8);
+  EXPECT_EQ(config.max_queue_delay_us, 500);
+  EXPECT_EQ(config.max_concurrent_batches, 2);
+}
+
+TEST(ConfigParsingTests, WrongMaxBatchSize) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_batch_size"), const_cast<char*>("0")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(5, test_argv);
+  EXPECT_EQ(res, Result::ExitFailure);
+}
+
+TEST(ConfigParsingTests, WrongMaxConcurrentBatches) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--max_concurrent_batches"), const_cast<char*>("0")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(5, test_argv);
+  EXPECT_EQ(res, Result::ExitFailure);
+}
+
 TEST(ConfigParsingTests, WrongLoggingLevel) {
   char* test_argv[] = {
       const_cast<char*>("/path/to/binary"),
@@ -17,13 +17,14 @@ training_ops_path = 'orttraining/orttraining/training_ops'
 contrib_ops_excluded_files = [
                     'bert/attention.cc',
                     'bert/attention_impl.cu',
+                    'bert/attention_memory_efficient.cu',
                     'bert/attention_softmax.h',
                     'bert/decoder_attention.h',
                     'bert/decoder_attention.cc',
-                    'bert/embed_layer_norm.cc',
-                    'bert/embed_layer_norm.h',
-                    'bert/embed_layer_norm_impl.cu',
-                    'bert/embed_layer_norm_impl.h',
+                    'bert/decoder_masked_self_attention.cc',
+                    'bert/decoder_masked_self_attention.h',
+                    'bert/decoder_masked_self_attention_impl.cu',
+                    'bert/decoder_masked_self_attention_impl.h',
                     'bert/fast_gelu_impl.cu',
                     'bert/layer_norm.cuh',
                     'bert/longformer_attention.cc',
@@ -34,7 +35,13 @@ contrib_ops_excluded_files = [
                     'bert/longformer_attention_impl.h',
                     'bert/longformer_global_impl.cu',
                     'bert/longformer_global_impl.h',
+                    'bert/matmul_fast_gelu.cc',
+                    'bert/matmul_fast_gelu.h',
+                    'bert/packed_attention.cc',
+                    'bert/packed_attention.h',
                     'bert/transformer_cuda_common.h',
+                    'collective/nccl_kernels.cc',
+                    'collective/nccl_kernels.h',
                     'math/bias_softmax.cc',
                     'math/bias_softmax.h',
                     'math/bias_softmax_impl.cu',
@@ -86,6 +93,8 @@ provider_excluded_files = [
                 'controlflow/scan.cc',
                 'controlflow/scan.h',
                 'cu_inc/common.cuh',
+                'math/cublas_lt_gemm.cc',
+                'math/cublas_lt_gemm.h',
                 'math/einsum_utils/einsum_auxiliary_ops.cc',
                 'math/einsum_utils/einsum_auxiliary_ops.h',
                 'math/einsum_utils/einsum_auxiliary_ops_diagonal.cu',
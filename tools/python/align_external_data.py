@@ -0,0 +1,128 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+# This script saves an onnx model with its large initializers in a single external data file, with the data of
+# each initializer starting at a page aligned offset.
+# ONNX Runtime can use such initializers in place from a read-only memory mapping of the file when the session
+# config option "session.use_mmap_for_external_initializers" is set to "1", so that sessions in one or several
+# processes share the page cache instead of each holding a private copy of the weights.
+
+import argparse
+import logging
+import os
+import sys
+from typing import List
+
+import onnx
+from onnx import ModelProto, TensorProto, numpy_helper
+
+logger = logging.getLogger(__name__)
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--input', required=True, type=str, help='input model path')
+    parser.add_argument('--output', required=True, type=str, help='output model path')
+    parser.add_argument('--data_file', required=False, type=str,
+                        help='name of the external data file written next to the output model. '
+                             'defaults to the output model file name with a .data suffix')
+    parser.add_argument('--alignment', required=False, type=int, default=4096,
+                        help='alignment of the data of each initializer in the external data file. '
+                             'must be a multiple of 4096')
+    parser.add_argument('--size_threshold', required=False, type=int, default=1024,
+                        help='initializers smaller than this many bytes are kept in the model')
+    parser.add_argument('--verbose', required=False, action='store_true')
+    parser.set_defaults(verbose=False)
+    args = parser.parse_args()
+    return args
+
+
+def setup_logging(verbose):  # type: (bool)  -> None
+    log_handler = logging.StreamHandler(sys.stdout)
+    if verbose:
+        log_handler.setFormatter(logging.Formatter('[%(filename)s:%(lineno)s - %(funcName)20s()] %(message)s'))
+        logging_level = logging.DEBUG
+    else:
+        log_handler.setFormatter(logging.Formatter('%(filename)20s: %(message)s'))
+        logging_level = logging.INFO
+    log_handler.setLevel(logging_level)
+    logger.addHandler(log_handler)
+    logger.setLevel(logging_level)
+
+
+def get_all_initializers(graph):  # type: (onnx.GraphProto) -> List[TensorProto]
+    """ returns the initializers of the graph and all of its subgraphs
+    """
+    initializers = list(graph.initializer)
+    for node in graph.node:
+        for attr in node.attribute:
+            if attr.type == onnx.AttributeProto.GRAPH:
+                initializers += get_all_initializers(attr.g)
+            elif attr.type == onnx.AttributeProto.GRAPHS:
+                for subgraph in attr.graphs:
+                    initializers += get_all_initializers(subgraph)
+    return initializers
+
+
+def set_external_data(tensor, location, offset, length):  # type: (TensorProto, str, int, int) -> None
+    del tensor.external_data[:]
+    for key, value in (('location', location), ('offset', str(offset)), ('length', str(length))):
+        entry = tensor.external_data.add()
+        entry.key = key
+        entry.value = value
+    tensor.data_location = TensorProto.EXTERNAL
+    tensor.ClearField('raw_data')
+
+
+def align_external_data(model, data_path, alignment, size_threshold):  # type: (ModelProto, str, int, int) -> int
+    """ moves the data of large initializers to data_path, each at an offset that is a multiple of alignment.
+        returns the number of initializers moved.
+    """
+    location = os.path.basename(data_path)
+    num_moved = 0
+    with open(data_path, 'wb') as data_file:
+        for tensor in get_all_initializers(model.graph):
+            if tensor.data_type == TensorProto.STRING or not tensor.HasField('raw_data'):
+                continue
+
+            data = tensor.raw_data
+            if len(data) < size_threshold:
+                continue
+
+            offset = (data_file.tell() + alignment - 1) // alignment * alignment
+            data_file.write(b'\0' * (offset - data_file.tell()))
+            data_file.write(data)
+            set_external_data(tensor, location, offset, len(data))
+            num_moved += 1
+            logger.debug(f'Moved {tensor.name} ({len(data)} bytes) to offset {offset}')
+
+    return num_moved
+
+
+def main():
+    args = parse_arguments()
+    setup_logging(args.verbose)
+
+    if args.alignment <= 0 or args.alignment % 4096 != 0:
+        raise ValueError('alignment must be a positive multiple of 4096')
+
+    # loading the external data converts all initializers to raw_data so they can be written out again
+    model = onnx.load(args.input, load_external_data=True)
+
+    # tensors stored in other formats than raw_data are converted first so all large tensors can be moved
+    for tensor in get_all_initializers(model.graph):
+        if tensor.data_type != TensorProto.STRING and not tensor.HasField('raw_data'):
+            array = numpy_helper.to_array(tensor)
+            tensor.CopyFrom(numpy_helper.from_array(array, tensor.name))
+
+    data_file_name = args.data_file if args.data_file else os.path.basename(args.output) + '.data'
+    data_path = os.path.join(os.path.dirname(os.path.abspath(args.output)), data_file_name)
+
+    num_moved = align_external_data(model, data_path, args.alignment, args.size_threshold)
+    onnx.save(model, args.output)
+    logger.info(f'Saved {args.output} with {num_moved} initializers in {data_path} aligned to {args.alignment} bytes')
+
+
+if __name__ == "__main__":
+    main()
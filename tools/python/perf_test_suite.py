@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""
+Runs the models of a manifest with onnxruntime_perf_test on several execution providers, collects their latency and
+memory metrics in a JSON file and compares them with a stored baseline.
+
+The manifest is a JSON file:
+
+    {
+      "defaults": {"providers": ["cpu"], "runs": 200, "warmup": 10, "repetitions": 3, "args": ["-x", "4"]},
+      "thresholds": {"latency_ms.p50": 0.05, "latency_ms.p99": 0.10, "peak_working_set_bytes": 0.10},
+      "models": [
+        {"name": "resnet50", "path": "resnet50/model.onnx", "providers": ["cpu", "cuda"]},
+        {"name": "bert_squad", "path": "bert/model.onnx", "shapes": "bert/shapes.txt", "runs": 500}
+      ]
+    }
+
+Relative paths are resolved against the directory of the manifest. Each model entry may override any of the
+defaults. 'shapes' is a shape distribution file for perf_test's -D option, 'free_dims' a map of free dimension names
+to values for its -f option, and 'args' extra perf_test arguments. A model is run 'repetitions' times on each
+provider, and the median of each metric is kept to reduce the noise between runs.
+
+A threshold is the relative increase of a metric over the baseline that is reported as a regression. Metrics without
+a threshold are reported but never fail the comparison.
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+
+DEFAULT_THRESHOLDS = {
+    "latency_ms.p50": 0.05,
+    "latency_ms.p99": 0.10,
+    "peak_working_set_bytes": 0.10,
+    "peak_arena_bytes": 0.05,
+}
+
+REPORTED_METRICS = [
+    "latency_ms.average",
+    "latency_ms.p50",
+    "latency_ms.p90",
+    "latency_ms.p99",
+    "inferences_per_second",
+    "session_creation_s",
+    "peak_working_set_bytes",
+    "peak_arena_bytes",
+]
+
+
+def _get_metric(result, metric):
+    value = result
+    for key in metric.split("."):
+        value = value[key]
+    return value
+
+
+def _set_metric(result, metric, value):
+    keys = metric.split(".")
+    for key in keys[:-1]:
+        result = result.setdefault(key, {})
+    result[keys[-1]] = value
+
+
+def _run_perf_test(perf_test, model_path, provider, config, manifest_dir):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        json_path = os.path.join(tmp_dir, "result.json")
+        cmd = [perf_test, "-e", provider, "-m", "times", "-r", str(config["runs"]), "-W", str(config["warmup"]),
+               "-J", json_path]
+        if "shapes" in config:
+            cmd += ["-D", os.path.join(manifest_dir, config["shapes"])]
+        for name, value in config.get("free_dims", {}).items():
+            cmd += ["-f", "{}:{}".format(name, value)]
+        cmd += [str(arg) for arg in config.get("args", [])]
+        cmd += [model_path, os.path.join(tmp_dir, "result.txt")]
+
+        subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+        with open(json_path) as f:
+            return json.load(f)
+
+
+def run_suite(perf_test, manifest_path):
+    with open(manifest_path) as f:
+        manifest = json.load(f)
+
+    manifest_dir = os.path.dirname(os.path.abspath(manifest_path))
+    defaults = {"providers": ["cpu"], "runs": 100, "warmup": 5, "repetitions": 3}
+    defaults.update(manifest.get("defaults", {}))
+
+    results = {}
+    for model in manifest["models"]:
+        config = dict(defaults)
+        config.update(model)
+        model_path = os.path.join(manifest_dir, config["path"])
+
+        for provider in config["providers"]:
+            key = "{}/{}".format(config["name"], provider)
+            print("Running {} ...".format(key), flush=True)
+            try:
+                repetitions = [_run_perf_test(perf_test, model_path, provider, config, manifest_dir)
+                               for _ in range(config["repetitions"])]
+            except subprocess.CalledProcessError as e:
+                print("  failed with exit code {}".format(e.returncode))
+                results[key] = {"error": "perf_test exited with code {}".format(e.returncode)}
+                continue
+
+            result = repetitions[0]
+            for metric in REPORTED_METRICS:
+                _set_metric(result, metric, statistics.median(_get_metric(r, metric) for r in repetitions))
+            result["repetitions"] = len(repetitions)
+            results[key] = result
+
+    return {"thresholds": manifest.get("thresholds", DEFAULT_THRESHOLDS), "results": results}
+
+
+def compare(suite, baseline):
+    """Prints the change of each metric from the baseline and returns the list of regressions."""
+    thresholds = suite["thresholds"]
+    regressions = []
+    for key, result in suite["results"].items():
+        if "error" in result:
+            regressions.append("{}: {}".format(key, result["error"]))
+            continue
+        base = baseline["results"].get(key)
+        if base is None or "error" in base:
+            print("{}: no baseline".format(key))
+            continue
+
+        print(key)
+        for metric in REPORTED_METRICS:
+            current = _get_metric(result, metric)
+            previous = _get_metric(base, metric)
+            change = (current - previous) / previous if previous else 0.0
+            # a higher throughput is better, every other metric is better when lower
+            if metric == "inferences_per_second":
+                change = -change
+            threshold = thresholds.get(metric)
+            regressed = threshold is not None and change > threshold
+            print("  {:<24} {:>16.4f} {:>16.4f} {:>+8.1%}{}".format(metric, previous, current, change,
+                                                                    "  REGRESSION" if regressed else ""))
+            if regressed:
+                regressions.append("{}: {} {:+.1%} (threshold {:.1%})".format(key, metric, change, threshold))
+
+    return regressions
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--perf_test", required=True, help="Path of the onnxruntime_perf_test executable.")
+    parser.add_argument("--manifest", required=True, help="JSON manifest of the models to run.")
+    parser.add_argument("--output", default="perf_test_suite_results.json", help="File to write the results to.")
+    parser.add_argument("--baseline", help="Results of a previous run to compare with.")
+    parser.add_argument("--update_baseline", action="store_true",
+                        help="Write the results to the baseline file instead of comparing with it.")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_arguments()
+
+    suite = run_suite(args.perf_test, args.manifest)
+    with open(args.output, "w") as f:
+        json.dump(suite, f, indent=2)
+    print("Results written to {}".format(args.output))
+
+    if not args.baseline:
+        return 0
+
+    if args.update_baseline or not os.path.exists(args.baseline):
+        with open(args.baseline, "w") as f:
+            json.dump(suite, f, indent=2)
+        print("Baseline written to {}".format(args.baseline))
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+
+    regressions = compare(suite, baseline)
+    if regressions:
+        print("\n{} regression(s):".format(len(regressions)))
+        for regression in regressions:
+            print("  " + regression)
+        return 1
+
+    print("\nNo regressions.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
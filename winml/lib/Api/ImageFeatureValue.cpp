@@ -311,6 +311,29 @@ static void GPUTensorize(
   }
 }
 
+static bool CanReuseValue(
+    _winml::IValue* value,
+    const _winml::ImageTensorDescription& tensorDescriptor,
+    winml::TensorKind tensorKind,
+    bool isCpuDevice) {
+  if (value == nullptr) {
+    return false;
+  }
+
+  bool isOfType = false;
+  bool isCpu = false;
+  std::vector<int64_t> shape;
+  if (FAILED(value->IsOfTensorType(tensorKind, &isOfType)) || !isOfType ||
+      FAILED(value->IsCpu(&isCpu)) || isCpu != isCpuDevice ||
+      FAILED(value->GetTensorShape(shape))) {
+    return false;
+  }
+
+  return std::equal(
+      std::begin(shape), std::end(shape),
+      std::begin(tensorDescriptor.sizes), std::end(tensorDescriptor.sizes));
+}
+
 std::optional<ImageFeatureValue::ImageResourceMetadata> ImageFeatureValue::GetInputMetadata(const _winml::BindingContext& context) {
   uint32_t descriptorWidth;
   uint32_t descriptorHeight;
@@ -438,14 +461,21 @@ HRESULT ImageFeatureValue::GetValue(_winml::BindingContext& context, _winml::IVa
   auto spDevice = spSession->Device().as<LearningModelDevice>();
   auto engine = spSession->GetEngine();
 
-  // create the OrtValue
+  auto tensorKind = resourceMetadata.TensorDescriptor.dataType == _winml::ImageTensorDataType::kImageTensorDataTypeFloat32 ?
+                        winml::TensorKind::Float : winml::TensorKind::Float16;
+
+  // create the OrtValue, or tensorize into the one bound last time if it still fits
   winrt::com_ptr<_winml::IValue> value;
-  RETURN_IF_FAILED(engine->CreateTensorValue(
-      resourceMetadata.TensorDescriptor.sizes,
-      sizeof(resourceMetadata.TensorDescriptor.sizes) / sizeof(resourceMetadata.TensorDescriptor.sizes[0]),
-      resourceMetadata.TensorDescriptor.dataType == _winml::ImageTensorDataType::kImageTensorDataTypeFloat32 ?
-        winml::TensorKind::Float : winml::TensorKind::Float16,
-      value.put()));
+  if (context.type == _winml::BindingType::kInput &&
+      CanReuseValue(context.previous_value.get(), resourceMetadata.TensorDescriptor, tensorKind, spDevice->IsCpuDevice())) {
+    value = context.previous_value;
+  } else {
+    RETURN_IF_FAILED(engine->CreateTensorValue(
+        resourceMetadata.TensorDescriptor.sizes,
+        sizeof(resourceMetadata.TensorDescriptor.sizes) / sizeof(resourceMetadata.TensorDescriptor.sizes[0]),
+        tensorKind,
+        value.put()));
+  }
 
   // Get the tensor raw data
   _winml::Resource void_resource;
@@ -98,6 +98,13 @@ std::tuple<std::string, winrt::com_ptr<_winml::IValue>, _winml::BindingType> Lea
       {}  // SubresourceId is set by callee
   };
 
+  // Rebinding a variable lets the feature value reuse the allocation made by the previous bind, so that
+  // binding a new frame every evaluation does not allocate a new tensor every evaluation.
+  auto previous_provider = m_providers.find(name);
+  if (previous_provider != std::end(m_providers)) {
+    context.previous_value = previous_provider->second.Value;
+  }
+
   // Get the bound tensor
   winrt::com_ptr<_winml::IValue> value;
 
@@ -136,7 +143,8 @@ std::tuple<std::string, winrt::com_ptr<_winml::IValue>, _winml::BindingType> Lea
   }
 
   // Hold onto the input output providers so that our memory doesnt get destroyed!
-  auto providerInfo = ProviderInfo{inspectable, spLotusValueProvider, context};
+  context.previous_value = nullptr;
+  auto providerInfo = ProviderInfo{inspectable, spLotusValueProvider, context, value};
   CacheProvider(name, providerInfo);
   
   return std::make_tuple(name, value, bindingType);
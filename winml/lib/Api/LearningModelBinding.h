@@ -15,6 +15,7 @@ struct LearningModelBinding : LearningModelBindingT<LearningModelBinding, ILearn
     wf::IInspectable CallerSpecifiedFeatureValue = nullptr;
     winrt::com_ptr<_winml::ILotusValueProviderPrivate> Provider = nullptr;
     _winml::BindingContext Context = {};
+    winrt::com_ptr<_winml::IValue> Value = nullptr;
   };
 
  public:
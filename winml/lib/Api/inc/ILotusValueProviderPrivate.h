@@ -21,6 +21,9 @@ struct BindingContext {
   winml::ILearningModelFeatureDescriptor descriptor = nullptr;
   wfc::IPropertySet properties = nullptr;
   std::shared_ptr<PoolObjectWrapper> converter;
+  // Value previously bound to the same variable, which providers may write into instead of allocating a new one
+  // when its type and shape still match.
+  winrt::com_ptr<_winml::IValue> previous_value;
 };
 
 struct __declspec(uuid("27e2f437-0112-4693-849e-e04323a620fb")) __declspec(novtable) ILotusValueProviderPrivate : IUnknown {